@@ -0,0 +1,425 @@
+/**
+ * @file    sedml_bench.cpp
+ * @brief   Times reading, writing, copying and searching synthetic SED-ML documents.
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <sys/time.h>
+#endif
+
+#include <sedml/SedTypes.h>
+#include <sbml/math/FormulaParser.h>
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/*
+ * Size of the synthetic document.
+ */
+struct BenchConfig
+{
+  unsigned int models;
+  unsigned int tasks;
+  unsigned int dataGenerators;
+  unsigned int plots;
+  unsigned int curves;
+  unsigned int iterations;
+};
+
+
+/*
+ * Timings of one benchmark, in milliseconds.
+ */
+struct BenchResult
+{
+  std::string  name;
+  unsigned int iterations;
+  double       total;
+  double       min;
+  double       max;
+};
+
+
+/*
+ * @return wall clock time in milliseconds.
+ */
+static double
+now ()
+{
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return 1000.0 * (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return 1000.0 * tv.tv_sec + tv.tv_usec / 1000.0;
+#endif
+}
+
+
+static std::string
+makeId (const char* prefix, unsigned int n)
+{
+  ostringstream id;
+  id << prefix << n;
+  return id.str();
+}
+
+
+/*
+ * Builds a document with the configured numbers of models, tasks, data
+ * generators (each with two variables and some MathML) and plots.
+ */
+static SedDocument*
+createDocument (const BenchConfig& config)
+{
+  SedDocument* doc = new SedDocument(1, 1);
+
+  for (unsigned int i = 0; i < config.models; ++i)
+  {
+    SedModel* model = doc->createModel();
+    model->setId(makeId("model", i));
+    model->setSource(i == 0 ? std::string("file.xml") : std::string("model0"));
+    model->setLanguage("urn:sedml:sbml");
+
+    SedChangeAttribute* change = model->createChangeAttribute();
+    change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='"
+                      + makeId("k", i) + "']/@value");
+    change->setNewValue("0.1");
+  }
+
+  SedUniformTimeCourse* tc = doc->createUniformTimeCourse();
+  tc->setId("sim0");
+  tc->setInitialTime(0.0);
+  tc->setOutputStartTime(0.0);
+  tc->setOutputEndTime(10.0);
+  tc->setNumberOfPoints(1000);
+  tc->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int i = 0; i < config.tasks; ++i)
+  {
+    SedTask* task = doc->createTask();
+    task->setId(makeId("task", i));
+    task->setModelReference(makeId("model", config.models > 0 ? i % config.models : 0));
+    task->setSimulationReference("sim0");
+  }
+
+  for (unsigned int i = 0; i < config.dataGenerators; ++i)
+  {
+    const std::string id = makeId("dg", i);
+    const std::string taskId = makeId("task", config.tasks > 0 ? i % config.tasks : 0);
+
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId(id);
+    dg->setName(id);
+
+    SedVariable* var = dg->createVariable();
+    var->setId(makeId("x", i));
+    var->setTaskReference(taskId);
+    var->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='"
+                   + makeId("S", i) + "']");
+
+    var = dg->createVariable();
+    var->setId(makeId("t", i));
+    var->setTaskReference(taskId);
+    var->setSymbol("urn:sedml:symbol:time");
+
+    const std::string formula = makeId("x", i) + " * 2 / (1 + " + makeId("t", i) + ")";
+    ASTNode* math = SBML_parseFormula(formula.c_str());
+    dg->setMath(math);
+    delete math;
+  }
+
+  for (unsigned int i = 0; i < config.plots; ++i)
+  {
+    SedPlot2D* plot = doc->createPlot2D();
+    plot->setId(makeId("plot", i));
+
+    for (unsigned int j = 0; j < config.curves; ++j)
+    {
+      unsigned int n = i * config.curves + j;
+      SedCurve* curve = plot->createCurve();
+      curve->setId(makeId("curve", n));
+      curve->setLogX(false);
+      curve->setLogY(false);
+      curve->setXDataReference(makeId("dg", config.dataGenerators > 0 ? n % config.dataGenerators : 0));
+      curve->setYDataReference(makeId("dg", config.dataGenerators > 0 ? (n + 1) % config.dataGenerators : 0));
+    }
+  }
+
+  return doc;
+}
+
+
+/*
+ * Counts the objects a SedVisitor is shown.
+ */
+class CountingVisitor : public SedVisitor
+{
+public:
+
+  CountingVisitor () : mCount(0) { }
+
+  virtual void visit (const SedDocument&)       { ++mCount; }
+  virtual void visit (const SedListOf&, int)     { ++mCount; }
+  virtual bool visit (const SedBase&)            { ++mCount; return true; }
+
+  unsigned long mCount;
+};
+
+
+/*
+ * Runs one benchmark and records its timings.  The functions below each
+ * time a single iteration.
+ */
+typedef double (*BenchFunc) (SedDocument* doc, const std::string& xml);
+
+static void
+runBenchmark (std::vector<BenchResult>& results, const char* name,
+              BenchFunc func, SedDocument* doc, const std::string& xml,
+              unsigned int iterations)
+{
+  BenchResult result;
+  result.name       = name;
+  result.iterations = iterations;
+  result.total      = 0;
+  result.min        = 0;
+  result.max        = 0;
+
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    double ms = func(doc, xml);
+    result.total += ms;
+    if (i == 0 || ms < result.min) result.min = ms;
+    if (i == 0 || ms > result.max) result.max = ms;
+  }
+
+  results.push_back(result);
+  cerr << name << ": " << result.total / iterations << " ms" << endl;
+}
+
+
+static double
+benchRead (SedDocument*, const std::string& xml)
+{
+  SedReader reader;
+  double start = now();
+  SedDocument* d = reader.readSedMLFromString(xml);
+  double ms = now() - start;
+  delete d;
+  return ms;
+}
+
+
+static double
+benchWrite (SedDocument* doc, const std::string&)
+{
+  SedWriter writer;
+  double start = now();
+  char* xml = writer.writeSedMLToString(doc);
+  double ms = now() - start;
+  free(xml);
+  return ms;
+}
+
+
+static double
+benchClone (SedDocument* doc, const std::string&)
+{
+  double start = now();
+  SedDocument* copy = doc->clone();
+  double ms = now() - start;
+  delete copy;
+  return ms;
+}
+
+
+static double
+benchVisit (SedDocument* doc, const std::string&)
+{
+  CountingVisitor v;
+  double start = now();
+  doc->accept(v);
+  return now() - start;
+}
+
+
+static double
+benchAllElements (SedDocument* doc, const std::string&)
+{
+  double start = now();
+  List* all = doc->getAllElements();
+  double ms = now() - start;
+  delete all;
+  return ms;
+}
+
+
+static double
+benchIdLookup (SedDocument* doc, const std::string&)
+{
+  const unsigned int lookups = 1000;
+  const unsigned int count = doc->getNumDataGenerators();
+
+  double start = now();
+  for (unsigned int i = 0; i < lookups && count > 0; ++i)
+  {
+    doc->getElementBySId(makeId("dg", (i * 7919) % count));
+  }
+  return now() - start;
+}
+
+
+static void
+writeJson (std::ostream& out, const BenchConfig& config, size_t xmlSize,
+           const std::vector<BenchResult>& results)
+{
+  out << "{" << endl
+      << "  \"libsedml_version\": \"" << getLibSEDMLDottedVersion() << "\"," << endl
+      << "  \"config\": {" << endl
+      << "    \"models\": "         << config.models         << "," << endl
+      << "    \"tasks\": "          << config.tasks          << "," << endl
+      << "    \"dataGenerators\": " << config.dataGenerators << "," << endl
+      << "    \"plots\": "          << config.plots          << "," << endl
+      << "    \"curves\": "         << config.curves         << "," << endl
+      << "    \"xmlBytes\": "       << xmlSize               << endl
+      << "  }," << endl
+      << "  \"results\": [" << endl;
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchResult& r = results[i];
+    out << "    { \"name\": \"" << r.name << "\""
+        << ", \"iterations\": " << r.iterations
+        << ", \"mean_ms\": " << r.total / r.iterations
+        << ", \"min_ms\": " << r.min
+        << ", \"max_ms\": " << r.max
+        << " }" << (i + 1 < results.size() ? "," : "") << endl;
+  }
+
+  out << "  ]" << endl
+      << "}" << endl;
+}
+
+
+static void
+usage ()
+{
+  cout << endl
+       << "Usage: sedml_bench [-models N] [-tasks M] [-datagenerators K]" << endl
+       << "                   [-plots P] [-curves C] [-iterations I] [-o file.json]"
+       << endl << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  BenchConfig config;
+  config.models         = 10;
+  config.tasks          = 100;
+  config.dataGenerators = 1000;
+  config.plots          = 10;
+  config.curves         = 20;
+  config.iterations     = 10;
+
+  const char* output = NULL;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (i + 1 >= argc)
+    {
+      usage();
+      return 2;
+    }
+
+    const char* option = argv[i];
+    const char* value  = argv[++i];
+    unsigned int n     = (unsigned int)atoi(value);
+
+    if      (!strcmp(option, "-models"))         config.models         = n;
+    else if (!strcmp(option, "-tasks"))          config.tasks          = n;
+    else if (!strcmp(option, "-datagenerators")) config.dataGenerators = n;
+    else if (!strcmp(option, "-plots"))          config.plots          = n;
+    else if (!strcmp(option, "-curves"))         config.curves         = n;
+    else if (!strcmp(option, "-iterations"))     config.iterations     = n;
+    else if (!strcmp(option, "-o"))              output                = value;
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  if (config.iterations == 0) config.iterations = 1;
+
+  SedDocument* doc = createDocument(config);
+
+  char* text = writeSedMLToString(doc);
+  const std::string xml = (text != NULL) ? text : "";
+  free(text);
+
+  std::vector<BenchResult> results;
+  runBenchmark(results, "readSedMLFromString", benchRead,        doc, xml, config.iterations);
+  runBenchmark(results, "writeSedMLToString",  benchWrite,       doc, xml, config.iterations);
+  runBenchmark(results, "clone",               benchClone,       doc, xml, config.iterations);
+  runBenchmark(results, "visitor",             benchVisit,       doc, xml, config.iterations);
+  runBenchmark(results, "getAllElements",      benchAllElements, doc, xml, config.iterations);
+  runBenchmark(results, "getElementBySId",     benchIdLookup,    doc, xml, config.iterations);
+
+  if (output != NULL)
+  {
+    std::ofstream out(output);
+    writeJson(out, config, xml.size(), results);
+  }
+  else
+  {
+    writeJson(cout, config, xml.size(), results);
+  }
+
+  delete doc;
+  return 0;
+}
@@ -0,0 +1,584 @@
+/**
+ * @file    sedml_scaling.cpp
+ * @brief   Fits how the time of reading, writing, copying, searching and
+ *          validating SED-ML documents grows with their size.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <sys/time.h>
+#endif
+
+#include <sedml/SedTypes.h>
+#include <sbml/math/FormulaParser.h>
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/*
+ * Range of document sizes and what counts as too steep a growth.
+ */
+struct ScalingConfig
+{
+  unsigned int minSize;
+  unsigned int maxSize;
+  unsigned int maxNested;
+  unsigned int iterations;
+  double       minMs;
+  double       maxExponent;
+};
+
+
+/*
+ * Timings of one operation on one kind of document, by size, and the
+ * exponent fitted to them.
+ */
+struct Series
+{
+  std::string               shape;
+  std::string               name;
+  std::vector<unsigned int> sizes;
+  std::vector<double>       ms;
+  unsigned int              fitted;
+  double                    exponent;
+};
+
+
+/*
+ * @return wall clock time in milliseconds.
+ */
+static double
+now ()
+{
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return 1000.0 * (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return 1000.0 * tv.tv_sec + tv.tv_usec / 1000.0;
+#endif
+}
+
+
+static std::string
+makeId (const char* prefix, unsigned int n)
+{
+  ostringstream id;
+  id << prefix << n;
+  return id.str();
+}
+
+
+/*
+ * Adds the model, simulation and task the data generators refer to.
+ */
+static void
+addTask (SedDocument* doc)
+{
+  SedModel* model = doc->createModel();
+  model->setId("model0");
+  model->setSource("file.xml");
+  model->setLanguage("urn:sedml:sbml");
+
+  SedUniformTimeCourse* tc = doc->createUniformTimeCourse();
+  tc->setId("sim0");
+  tc->setInitialTime(0.0);
+  tc->setOutputStartTime(0.0);
+  tc->setOutputEndTime(10.0);
+  tc->setNumberOfPoints(100);
+  tc->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc->createTask();
+  task->setId("task0");
+  task->setModelReference("model0");
+  task->setSimulationReference("sim0");
+}
+
+
+/*
+ * A document with n valid data generators side by side.
+ */
+static SedDocument*
+createSiblings (unsigned int n)
+{
+  SedDocument* doc = new SedDocument(1, 1);
+  addTask(doc);
+
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId(makeId("dg", i));
+
+    SedVariable* var = dg->createVariable();
+    var->setId(makeId("x", i));
+    var->setTaskReference("task0");
+    var->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='"
+                   + makeId("S", i) + "']");
+
+    ASTNode* math = SBML_parseFormula(makeId("x", i).c_str());
+    dg->setMath(math);
+    delete math;
+  }
+
+  return doc;
+}
+
+
+/*
+ * A document with n data generators that each lack their id, and each
+ * with a variable lacking its task, so that reading and validating it
+ * log errors in proportion to its size.
+ */
+static SedDocument*
+createErrors (unsigned int n)
+{
+  SedDocument* doc = new SedDocument(1, 1);
+  addTask(doc);
+
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setName(makeId("dg", i));
+
+    SedVariable* var = dg->createVariable();
+    var->setId(makeId("x", i));
+    var->setSymbol("urn:sedml:symbol:time");
+  }
+
+  return doc;
+}
+
+
+/*
+ * The serialised form of a small document whose annotation nests n
+ * levels deep.  It is built as text, as the parser of XMLNode that
+ * setAnnotation() uses is itself recursive.
+ */
+static std::string
+createNestedXml (unsigned int n)
+{
+  SedDocument* doc = new SedDocument(1, 1);
+  addTask(doc);
+  char* text = writeSedMLToString(doc);
+  std::string xml = (text != NULL) ? text : "";
+  free(text);
+  delete doc;
+
+  std::string annotation = "<annotation>";
+  for (unsigned int i = 0; i < n; ++i)
+    annotation += "<n:e xmlns:n=\"urn:sedml:scaling\">";
+  for (unsigned int i = 0; i < n; ++i)
+    annotation += "</n:e>";
+  annotation += "</annotation>";
+
+  // the annotation goes first in the sedML element
+  size_t start = xml.find("<sedML");
+  size_t end   = (start != std::string::npos) ? xml.find('>', start) : start;
+  if (end != std::string::npos) xml.insert(end + 1, annotation);
+
+  return xml;
+}
+
+
+/*
+ * The functions below each time a single iteration of one operation; the
+ * size is the number of siblings, errors or levels of the document.
+ */
+typedef double (*ScaleFunc) (SedDocument* doc, const std::string& xml,
+                             unsigned int n);
+
+
+static SedDocument*
+readUnlimited (const std::string& xml)
+{
+  SedReader reader;
+  reader.setMaxXMLDepth(0);
+  return reader.readSedMLFromString(xml);
+}
+
+
+static double
+scaleRead (SedDocument*, const std::string& xml, unsigned int)
+{
+  double start = now();
+  SedDocument* d = readUnlimited(xml);
+  double ms = now() - start;
+  delete d;
+  return ms;
+}
+
+
+static double
+scaleWrite (SedDocument* doc, const std::string&, unsigned int)
+{
+  SedWriter writer;
+  double start = now();
+  char* xml = writer.writeSedMLToString(doc);
+  double ms = now() - start;
+  free(xml);
+  return ms;
+}
+
+
+static double
+scaleClone (SedDocument* doc, const std::string&, unsigned int)
+{
+  double start = now();
+  SedDocument* copy = doc->clone();
+  double ms = now() - start;
+  delete copy;
+  return ms;
+}
+
+
+/*
+ * n lookups by id, so that a lookup that is linear in the size of the
+ * document shows up as quadratic growth.
+ */
+static double
+scaleDocumentLookup (SedDocument* doc, const std::string&, unsigned int n)
+{
+  std::vector<std::string> ids;
+  for (unsigned int i = 0; i < n; ++i)
+    ids.push_back(makeId("dg", (unsigned int)(((unsigned long)i * 7919) % n)));
+
+  double start = now();
+  for (unsigned int i = 0; i < n; ++i)
+    doc->getElementBySId(ids[i]);
+  return now() - start;
+}
+
+
+static double
+scaleListLookup (SedDocument* doc, const std::string&, unsigned int n)
+{
+  std::vector<std::string> ids;
+  for (unsigned int i = 0; i < n; ++i)
+    ids.push_back(makeId("dg", (unsigned int)(((unsigned long)i * 7919) % n)));
+
+  const SedListOfDataGenerators* list = doc->getListOfDataGenerators();
+  double start = now();
+  for (unsigned int i = 0; i < n; ++i)
+    list->get(ids[i]);
+  return now() - start;
+}
+
+
+/*
+ * Validates a copy, so that the errors logged do not pile up in the
+ * document shared by the iterations.
+ */
+static double
+scaleValidate (SedDocument* doc, const std::string&, unsigned int)
+{
+  SedDocument* copy = doc->clone();
+  SedIncrementalValidator validator;
+  double start = now();
+  validator.validate(copy);
+  double ms = now() - start;
+  delete copy;
+  return ms;
+}
+
+
+/*
+ * @return the fastest of the iterations, which is the least disturbed by
+ * the rest of the machine.
+ */
+static double
+measure (ScaleFunc func, SedDocument* doc, const std::string& xml,
+         unsigned int n, unsigned int iterations)
+{
+  double best = 0;
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    double ms = func(doc, xml, n);
+    if (i == 0 || ms < best) best = ms;
+  }
+  return best;
+}
+
+
+static Series&
+getSeries (std::vector<Series>& series, const char* shape, const char* name)
+{
+  for (size_t i = 0; i < series.size(); ++i)
+  {
+    if (series[i].shape == shape && series[i].name == name)
+      return series[i];
+  }
+
+  Series s;
+  s.shape    = shape;
+  s.name     = name;
+  s.fitted   = 0;
+  s.exponent = 0;
+  series.push_back(s);
+  return series.back();
+}
+
+
+static void
+record (std::vector<Series>& series, const char* shape, const char* name,
+        ScaleFunc func, SedDocument* doc, const std::string& xml,
+        unsigned int n, const ScalingConfig& config)
+{
+  double ms = measure(func, doc, xml, n, config.iterations);
+
+  Series& s = getSeries(series, shape, name);
+  s.sizes.push_back(n);
+  s.ms.push_back(ms);
+
+  cerr << shape << " " << name << " n=" << n << ": " << ms << " ms" << endl;
+}
+
+
+/*
+ * Fits time = c * n^k to the timings of s by least squares on their
+ * logarithms.  Timings below config.minMs are mostly timer resolution
+ * and are left out.
+ */
+static void
+fit (Series& s, const ScalingConfig& config)
+{
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  unsigned int count = 0;
+
+  for (size_t i = 0; i < s.sizes.size(); ++i)
+  {
+    if (s.ms[i] < config.minMs) continue;
+
+    double x = log((double)s.sizes[i]);
+    double y = log(s.ms[i]);
+    sx  += x;
+    sy  += y;
+    sxx += x * x;
+    sxy += x * y;
+    ++count;
+  }
+
+  s.fitted   = count;
+  s.exponent = 0;
+
+  double denominator = count * sxx - sx * sx;
+  if (count >= 3 && denominator > 0)
+    s.exponent = (count * sxy - sx * sy) / denominator;
+}
+
+
+static void
+writeJson (std::ostream& out, const ScalingConfig& config,
+           const std::vector<Series>& series)
+{
+  out << "{" << endl
+      << "  \"libsedml_version\": \"" << getLibSEDMLDottedVersion() << "\"," << endl
+      << "  \"config\": {" << endl
+      << "    \"minSize\": "     << config.minSize     << "," << endl
+      << "    \"maxSize\": "     << config.maxSize     << "," << endl
+      << "    \"maxNested\": "   << config.maxNested   << "," << endl
+      << "    \"iterations\": "  << config.iterations  << "," << endl
+      << "    \"minMs\": "       << config.minMs       << "," << endl
+      << "    \"maxExponent\": " << config.maxExponent << endl
+      << "  }," << endl
+      << "  \"results\": [" << endl;
+
+  for (size_t i = 0; i < series.size(); ++i)
+  {
+    const Series& s = series[i];
+    out << "    { \"shape\": \"" << s.shape << "\""
+        << ", \"name\": \"" << s.name << "\""
+        << ", \"fitted\": " << s.fitted
+        << ", \"exponent\": " << s.exponent
+        << ", \"pass\": " << (s.exponent <= config.maxExponent ? "true" : "false")
+        << ", \"sizes\": [";
+    for (size_t j = 0; j < s.sizes.size(); ++j)
+      out << (j > 0 ? ", " : "") << s.sizes[j];
+    out << "], \"ms\": [";
+    for (size_t j = 0; j < s.ms.size(); ++j)
+      out << (j > 0 ? ", " : "") << s.ms[j];
+    out << "] }" << (i + 1 < series.size() ? "," : "") << endl;
+  }
+
+  out << "  ]" << endl
+      << "}" << endl;
+}
+
+
+static void
+usage ()
+{
+  cout << endl
+       << "Usage: sedml_scaling [-min N] [-max N] [-nested N] [-iterations I]" << endl
+       << "                     [-minms T] [-exponent K] [-o file.json]"
+       << endl << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  ScalingConfig config;
+  config.minSize     = 100;
+  config.maxSize     = 100000;
+  config.maxNested   = 10000;
+  config.iterations  = 3;
+  config.minMs       = 1.0;
+  // n log n fitted over 10^2..10^6 gives an exponent of about 1.15, a
+  // quadratic path one of 2
+  config.maxExponent = 1.3;
+
+  const char* output = NULL;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if (i + 1 >= argc)
+    {
+      usage();
+      return 2;
+    }
+
+    const char* option = argv[i];
+    const char* value  = argv[++i];
+    unsigned int n     = (unsigned int)atoi(value);
+
+    if      (!strcmp(option, "-min"))        config.minSize     = n;
+    else if (!strcmp(option, "-max"))        config.maxSize     = n;
+    else if (!strcmp(option, "-nested"))     config.maxNested   = n;
+    else if (!strcmp(option, "-iterations")) config.iterations  = n;
+    else if (!strcmp(option, "-minms"))      config.minMs       = atof(value);
+    else if (!strcmp(option, "-exponent"))   config.maxExponent = atof(value);
+    else if (!strcmp(option, "-o"))          output             = value;
+    else
+    {
+      usage();
+      return 2;
+    }
+  }
+
+  if (config.iterations == 0) config.iterations = 1;
+  if (config.minSize == 0)    config.minSize = 1;
+
+  std::vector<Series> series;
+
+  // sizes of 1, 2 and 5 times each power of ten
+  std::vector<unsigned int> sizes;
+  for (unsigned long decade = 1; decade <= config.maxSize; decade *= 10)
+  {
+    const unsigned int steps[] = { 1, 2, 5 };
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      unsigned long n = decade * steps[j];
+      if (n >= config.minSize && n <= config.maxSize)
+        sizes.push_back((unsigned int)n);
+    }
+  }
+
+  for (size_t i = 0; i < sizes.size(); ++i)
+  {
+    const unsigned int n = sizes[i];
+
+    SedDocument* doc = createSiblings(n);
+    char* text = writeSedMLToString(doc);
+    std::string xml = (text != NULL) ? text : "";
+    free(text);
+
+    record(series, "siblings", "readSedMLFromString", scaleRead,           doc, xml, n, config);
+    record(series, "siblings", "writeSedMLToString",  scaleWrite,          doc, xml, n, config);
+    record(series, "siblings", "clone",               scaleClone,          doc, xml, n, config);
+    record(series, "siblings", "getElementBySId",     scaleDocumentLookup, doc, xml, n, config);
+    record(series, "siblings", "SedListOf::get",      scaleListLookup,     doc, xml, n, config);
+    record(series, "siblings", "validate",            scaleValidate,       doc, xml, n, config);
+    delete doc;
+
+    doc = createErrors(n);
+    text = writeSedMLToString(doc);
+    xml = (text != NULL) ? text : "";
+    free(text);
+
+    record(series, "errors", "readSedMLFromString", scaleRead,     doc, xml, n, config);
+    record(series, "errors", "validate",            scaleValidate, doc, xml, n, config);
+    delete doc;
+
+    // XMLNode copies and destroys its children recursively, which bounds
+    // the depth the nested documents can be taken to
+    if (n <= config.maxNested)
+    {
+      xml = createNestedXml(n);
+      doc = readUnlimited(xml);
+
+      record(series, "nested", "readSedMLFromString", scaleRead,  doc, xml, n, config);
+      record(series, "nested", "writeSedMLToString",  scaleWrite, doc, xml, n, config);
+      record(series, "nested", "clone",               scaleClone, doc, xml, n, config);
+      delete doc;
+    }
+  }
+
+  unsigned int failed = 0;
+  for (size_t i = 0; i < series.size(); ++i)
+  {
+    Series& s = series[i];
+    fit(s, config);
+
+    const bool pass = s.exponent <= config.maxExponent;
+    if (!pass) ++failed;
+
+    cerr << (pass ? "ok      " : "FAILED  ") << s.shape << " " << s.name
+         << ": n^" << s.exponent << " over " << s.fitted << " sizes" << endl;
+  }
+
+  if (output != NULL)
+  {
+    std::ofstream out(output);
+    writeJson(out, config, series);
+  }
+  else
+  {
+    writeJson(cout, config, series);
+  }
+
+  return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file    sedml_write.cpp
+ * @brief   Times writing a SED-ML document in the default and compact form.
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <sedml/SedTypes.h>
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+/*
+ * Builds a document with the given number of data generators, each with
+ * one variable, plus a report referencing all of them.
+ */
+static SedDocument*
+createDocument (unsigned int size)
+{
+  SedDocument* doc = new SedDocument(1, 1);
+
+  SedModel* model = doc->createModel();
+  model->setId("model1");
+  model->setSource("file.xml");
+  model->setLanguage("urn:sedml:sbml");
+
+  SedUniformTimeCourse* tc = doc->createUniformTimeCourse();
+  tc->setId("sim1");
+  tc->setInitialTime(0.0);
+  tc->setOutputStartTime(0.0);
+  tc->setOutputEndTime(10.0);
+  tc->setNumberOfPoints(1000);
+  tc->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc->createTask();
+  task->setId("task1");
+  task->setModelReference("model1");
+  task->setSimulationReference("sim1");
+
+  SedReport* report = doc->createReport();
+  report->setId("r1");
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    ostringstream id;
+    id << "S" << i;
+
+    SedDataGenerator* dg = doc->createDataGenerator();
+    dg->setId(id.str());
+    dg->setName(id.str());
+
+    SedVariable* var = dg->createVariable();
+    var->setId("v" + id.str());
+    var->setTaskReference("task1");
+    var->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='"
+                   + id.str() + "']");
+
+    SedDataSet* set = report->createDataSet();
+    set->setId("ds" + id.str());
+    set->setLabel(id.str());
+    set->setDataReference(id.str());
+  }
+
+  return doc;
+}
+
+
+/*
+ * Writes doc repeatedly and prints the time per write and the size.
+ */
+static void
+timeWrite (const char* label, SedWriter& writer, const SedDocument* doc,
+           unsigned int repeats)
+{
+  size_t size = 0;
+  clock_t start = clock();
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    ostringstream stream;
+    writer.writeSedML(doc, stream);
+    size = stream.str().size();
+  }
+
+  double ms = 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC / repeats;
+  cout << label << ": " << ms << " ms per write, " << size << " bytes" << endl;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: sedml_write [input-filename [repeats]]"
+         << endl << endl;
+    return 2;
+  }
+
+  SedDocument* doc = NULL;
+  if (argc > 1)
+  {
+    doc = readSedML(argv[1]);
+    if (doc->getErrorLog()->getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) > 0)
+    {
+      cout << doc->getErrorLog()->toString();
+      delete doc;
+      return 1;
+    }
+  }
+  else
+  {
+    doc = createDocument(10000);
+  }
+
+  unsigned int repeats = (argc > 2) ? (unsigned int)atoi(argv[2]) : 20;
+  if (repeats == 0) repeats = 1;
+
+  SedWriter writer;
+  timeWrite("default", writer, doc, repeats);
+
+  writer.setCompact(true);
+  timeWrite("compact", writer, doc, repeats);
+
+  delete doc;
+  return 0;
+}
@@ -284,3 +284,20 @@ char* convertUTF8ToACP(const char* src_str)
 
 #endif // WIN32
 
+
+
+/**
+ * The ids of the columns of a SedResults, handed to C# in one call as a
+ * single string with one id per line; see SedResults in local.i.
+ */
+static std::string
+JoinSedColumnIds (const SedResults* results)
+{
+  std::string ids;
+  for (unsigned int n = 0; n < results->getNumColumns(); ++n)
+  {
+    if (n > 0) ids += '\n';
+    ids += results->getColumnId(n);
+  }
+  return ids;
+}
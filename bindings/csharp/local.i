@@ -190,9 +190,11 @@ SWIGEXPORT void SWIGSTDCALL SWIGRegisterWStringCallback_$module(SWIG_CSharpWStri
 	{
 		if (cPtr.Equals(IntPtr.Zero)) return null;
 		
-		SedBase sb = new SedBase(cPtr, false);
+		// the type codes are read through the native methods
+		// directly, without a temporary proxy for every element returned
+		HandleRef sb = new HandleRef(null, cPtr);
 		{
-			switch( sb.getTypeCode() )
+			switch( libsedmlPINVOKE.SedBase_getTypeCode(sb) )
 			{
 				case (int) libsedml.SEDML_DOCUMENT:
 					return new SedDocument(cPtr, owner);
@@ -252,57 +254,35 @@ SWIGEXPORT void SWIGSTDCALL SWIGRegisterWStringCallback_$module(SWIG_CSharpWStri
 					return new SedUniformTimeCourse(cPtr, owner);
 					
 				case (int) libsedml.SEDML_LIST_OF:
-					string name = sb.getElementName();
-					if(name == "listOf")
+					// the lists are told apart by the type code of their items, not
+					// by comparing element names
+					switch( libsedmlPINVOKE.SedListOf_getItemTypeCode(sb) )
 					{
-						return new SedListOf(cPtr, owner);
+						case (int) libsedml.SEDML_MODEL:
+							return new SedListOfModels(cPtr, owner);
+						case (int) libsedml.SEDML_CHANGE:
+							return new SedListOfChanges(cPtr, owner);
+						case (int) libsedml.SEDML_SIMULATION:
+							return new SedListOfSimulations(cPtr, owner);
+						case (int) libsedml.SEDML_TASK:
+							return new SedListOfTasks(cPtr, owner);
+						case (int) libsedml.SEDML_DATAGENERATOR:
+							return new SedListOfDataGenerators(cPtr, owner);
+						case (int) libsedml.SEDML_OUTPUT:
+							return new SedListOfOutputs(cPtr, owner);
+						case (int) libsedml.SEDML_OUTPUT_CURVE:
+							return new SedListOfCurves(cPtr, owner);
+						case (int) libsedml.SEDML_OUTPUT_SURFACE:
+							return new SedListOfSurfaces(cPtr, owner);
+						case (int) libsedml.SEDML_OUTPUT_DATASET:
+							return new SedListOfDataSets(cPtr, owner);
+						case (int) libsedml.SEDML_PARAMETER:
+							return new SedListOfParameters(cPtr, owner);
+						case (int) libsedml.SEDML_VARIABLE:
+							return new SedListOfVariables(cPtr, owner);
+						default:
+							return new SedListOf(cPtr, owner);
 					}
-					else if(name == "listOfModels")
-					{
-						return new SedListOfModels(cPtr, owner);
-					}
-					else if(name == "listOfChanges")
-					{
-						return new SedListOfChanges(cPtr, owner);
-					}
-					else if(name == "listOfSimulations")
-					{
-						return new SedListOfSimulations(cPtr, owner);
-					}
-					else if(name == "listOfTasks")
-					{
-						return new SedListOfTasks(cPtr, owner);
-					}
-					else if(name == "listOfDataGenerators")
-					{
-						return new SedListOfDataGenerators(cPtr, owner);
-					}
-					else if(name == "listOfOutputs")
-					{
-						return new SedListOfOutputs(cPtr, owner);
-					}
-					else if(name == "listOfCurves")
-					{
-						return new SedListOfCurves(cPtr, owner);
-					}
-					else if(name == "listOfSurfaces")
-					{
-						return new SedListOfSurfaces(cPtr, owner);
-					}
-					else if(name == "listOfDataSets")
-					{
-						return new SedListOfDataSets(cPtr, owner);
-					}
-					else if(name == "listOfParameters")
-					{
-						return new SedListOfParameters(cPtr, owner);
-					}
-					else if(name == "listOfVariables")
-					{
-						return new SedListOfVariables(cPtr, owner);
-					}
-					
-					return new SedListOf(cPtr, owner);				
 					
 				default:
 					return new SedBase(cPtr, owner);
@@ -363,6 +343,143 @@ SWIGEXPORT void SWIGSTDCALL SWIGRegisterWStringCallback_$module(SWIG_CSharpWStri
 }
 
 
+
+/**
+ * SedListOf objects can be used in foreach loops.
+ */
+%typemap("csinterfaces")         SedListOf "IDisposable, System.Collections.Generic.IEnumerable<SedBase>"
+%typemap("csinterfaces_derived") SedListOf "System.Collections.Generic.IEnumerable<SedBase>"
+
+%typemap("cscode") SedListOf
+%{
+  /**
+   * Returns an enumerator over the items of this list, in order.
+   *
+   * The enumerator walks the list by index; items added or removed while
+   * it is in use are not guaranteed to be visited.
+   */
+  public System.Collections.Generic.IEnumerator<SedBase> GetEnumerator()
+  {
+    long n = size();
+    for (long i = 0; i < n; ++i)
+    {
+      yield return get(i);
+    }
+  }
+
+  System.Collections.IEnumerator System.Collections.IEnumerable.GetEnumerator()
+  {
+    return GetEnumerator();
+  }
+%}
+
+
+/**
+ * SedResults hands out its columns over its own memory, as Span<double>
+ * when built with WITH_CSHARP_SPAN, and otherwise copied into a double[]
+ * in one call, and the ids of its columns as one string[], instead of
+ * through the raw pointers of the C++ API.
+ */
+%extend SedResults
+{
+  long long _getColumnAddress(const std::string& id)
+  {
+    return (long long)(size_t)self->getColumn(id);
+  }
+
+  long long _getConstColumnAddress(const std::string& id)
+  {
+    return (long long)(size_t)static_cast<const SedResults*>(self)->getColumn(id);
+  }
+
+  long long _addColumnAddress(const std::string& id, long long length)
+  {
+    return (length < 0) ? 0 : (long long)(size_t)self->addColumn(id, (size_t)length);
+  }
+
+  long long _getColumnCount(const std::string& id)
+  {
+    return (long long)self->getColumnLength(id);
+  }
+
+  std::string _getColumnIds()
+  {
+    return JoinSedColumnIds(self);
+  }
+}
+
+%typemap("cscode") SedResults
+%{
+  /**
+   * Returns the ids of the columns, in the order they were added.
+   */
+  public string[] GetColumnIds()
+  {
+    string ids = _getColumnIds();
+    return (ids.Length == 0) ? new string[0] : ids.Split('\n');
+  }
+
+  /**
+   * Returns a copy of the values of the column with the given id, made
+   * in one call, or null if there is no such column.
+   */
+  public double[] GetColumnValues(string id)
+  {
+    if (!hasColumn(id)) return null;
+    long address = _getConstColumnAddress(id);
+    double[] values = new double[checked((int)_getColumnCount(id))];
+    if (address != 0 && values.Length > 0)
+    {
+      System.Runtime.InteropServices.Marshal.Copy(new IntPtr(address), values, 0, values.Length);
+    }
+    return values;
+  }
+
+#if LIBSEDML_SPAN
+  /**
+   * Returns the column with the given id as a span over the memory of
+   * this SedResults, without copying; writes to it change the column.
+   * The span is empty if there is no such column.
+   *
+   * The span does not keep this SedResults alive: keep a reference to it,
+   * and do not dispose of it, while the span is in use; the span is also
+   * invalidated when the column is removed or resized.
+   */
+  public unsafe System.Span<double> GetColumnSpan(string id)
+  {
+    long address = _getColumnAddress(id);
+    if (address == 0) return System.Span<double>.Empty;
+    return new System.Span<double>((void*)address, checked((int)_getColumnCount(id)));
+  }
+
+  /**
+   * Returns the column with the given id as GetColumnSpan() does, but
+   * read-only; a column that aliases values of another is not copied.
+   */
+  public unsafe System.ReadOnlySpan<double> GetReadOnlyColumnSpan(string id)
+  {
+    long address = _getConstColumnAddress(id);
+    if (address == 0) return System.ReadOnlySpan<double>.Empty;
+    return new System.ReadOnlySpan<double>((void*)address, checked((int)_getColumnCount(id)));
+  }
+
+  /**
+   * Creates the column with the given id with room for the given number
+   * of values, all zero, resizing and clearing an existing one, and
+   * returns its values as GetColumnSpan() does, so that they can be
+   * filled in place.
+   */
+  public unsafe System.Span<double> AddColumnSpan(string id, int length)
+  {
+    long address = _addColumnAddress(id, length);
+    if (address == 0) return System.Span<double>.Empty;
+    return new System.Span<double>((void*)address, length);
+  }
+#endif
+%}
+
+
+
 /**
  * getCPtrAndDisown() is like getCPtr() but it also sets the SWIG memory
  * ownsership flag to false.
@@ -288,3 +288,21 @@ char* convertUTF8ToACP(const char* src_str)
 }
 
 #endif // WIN32
+
+
+/**
+ * Memory of a SedResults handed to Java as a direct java.nio.ByteBuffer,
+ * and the ids of its columns handed over as a String[]; see SedResults in
+ * local.i.
+ */
+
+#include <string>
+#include <vector>
+
+struct SedDirectBuffer
+{
+  void*  data;
+  size_t size;
+};
+
+typedef std::vector<std::string> SedStringArray;
@@ -429,9 +429,11 @@ XMLCONSTRUCTOR_EXCEPTION(XMLTripple)
   {
     if (cPtr == 0) return null;
 
-    SedBase sb = new SedBase(cPtr,false);
+    // the type codes are read through the native methods
+    // directly: a temporary proxy for them would cost one more finalizable
+    // object for every element returned
     
-	switch( sb.getTypeCode() )
+	switch( libsedmlJNI.SedBase_getTypeCode(cPtr, null) )
 	{
 		case (int) libsedml.SEDML_DOCUMENT:
 			return new SedDocument(cPtr, owner);
@@ -491,57 +493,35 @@ XMLCONSTRUCTOR_EXCEPTION(XMLTripple)
 			return new SedUniformTimeCourse(cPtr, owner);
 			
 		case (int) libsedml.SEDML_LIST_OF:
-			String name = sb.getElementName();
-			if(name.equals("listOf"))
+			// the lists are told apart by the type code of their items, not
+			// by comparing element names
+			switch( libsedmlJNI.SedListOf_getItemTypeCode(cPtr, null) )
 			{
-				return new SedListOf(cPtr, owner);
+				case (int) libsedml.SEDML_MODEL:
+					return new SedListOfModels(cPtr, owner);
+				case (int) libsedml.SEDML_CHANGE:
+					return new SedListOfChanges(cPtr, owner);
+				case (int) libsedml.SEDML_SIMULATION:
+					return new SedListOfSimulations(cPtr, owner);
+				case (int) libsedml.SEDML_TASK:
+					return new SedListOfTasks(cPtr, owner);
+				case (int) libsedml.SEDML_DATAGENERATOR:
+					return new SedListOfDataGenerators(cPtr, owner);
+				case (int) libsedml.SEDML_OUTPUT:
+					return new SedListOfOutputs(cPtr, owner);
+				case (int) libsedml.SEDML_OUTPUT_CURVE:
+					return new SedListOfCurves(cPtr, owner);
+				case (int) libsedml.SEDML_OUTPUT_SURFACE:
+					return new SedListOfSurfaces(cPtr, owner);
+				case (int) libsedml.SEDML_OUTPUT_DATASET:
+					return new SedListOfDataSets(cPtr, owner);
+				case (int) libsedml.SEDML_PARAMETER:
+					return new SedListOfParameters(cPtr, owner);
+				case (int) libsedml.SEDML_VARIABLE:
+					return new SedListOfVariables(cPtr, owner);
+				default:
+					return new SedListOf(cPtr, owner);
 			}
-			else if(name.equals("listOfModels"))
-			{
-				return new SedListOfModels(cPtr, owner);
-			}
-			else if(name.equals("listOfChanges"))
-			{
-				return new SedListOfChanges(cPtr, owner);
-			}
-			else if(name.equals("listOfSimulations"))
-			{
-				return new SedListOfSimulations(cPtr, owner);
-			}
-			else if(name.equals("listOfTasks"))
-			{
-				return new SedListOfTasks(cPtr, owner);
-			}
-			else if(name.equals("listOfDataGenerators"))
-			{
-				return new SedListOfDataGenerators(cPtr, owner);
-			}
-			else if(name.equals("listOfOutputs"))
-			{
-				return new SedListOfOutputs(cPtr, owner);
-			}
-			else if(name.equals("listOfCurves"))
-			{
-				return new SedListOfCurves(cPtr, owner);
-			}
-			else if(name.equals("listOfSurfaces"))
-			{
-				return new SedListOfSurfaces(cPtr, owner);
-			}
-			else if(name.equals("listOfDataSets"))
-			{
-				return new SedListOfDataSets(cPtr, owner);
-			}
-			else if(name.equals("listOfParameters"))
-			{
-				return new SedListOfParameters(cPtr, owner);
-			}
-			else if(name.equals("listOfVariables"))
-			{
-				return new SedListOfVariables(cPtr, owner);
-			}
-			
-			return new SedListOf(cPtr, owner);				
 			
 		default:
 			return new SedBase(cPtr, owner);
@@ -600,6 +580,159 @@ XMLCONSTRUCTOR_EXCEPTION(XMLTripple)
 
 
 
+/**
+ * SedListOf objects can be used in for-each loops.
+ */
+%typemap("javainterfaces") SedListOf "Iterable<SedBase>"
+
+%typemap("javacode") SedListOf
+%{
+  /**
+   * Returns an iterator over the items of this list, in order.
+   * <p>
+   * The iterator walks the list by index; items added or removed while
+   * it is in use are not guaranteed to be visited.
+   */
+  public java.util.Iterator<SedBase> iterator()
+  {
+    return new java.util.Iterator<SedBase>()
+    {
+      private final long mSize = size();
+      private long mIndex = 0;
+
+      public boolean hasNext()
+      {
+        return mIndex < mSize;
+      }
+
+      public SedBase next()
+      {
+        if (mIndex >= mSize) throw new java.util.NoSuchElementException();
+        return get(mIndex++);
+      }
+
+      public void remove()
+      {
+        throw new UnsupportedOperationException();
+      }
+    };
+  }
+%}
+
+
+
+/**
+ * SedResults hands out its columns as direct java.nio buffers over its own
+ * memory, and the ids of its columns as one String[], instead of through
+ * the raw pointers of the C++ API, so that reading a column costs one JNI
+ * call whatever its length.
+ */
+%typemap(jni)     SedDirectBuffer "jobject"
+%typemap(jtype)   SedDirectBuffer "java.nio.ByteBuffer"
+%typemap(jstype)  SedDirectBuffer "java.nio.ByteBuffer"
+%typemap(javaout) SedDirectBuffer { return $jnicall; }
+%typemap(out)     SedDirectBuffer
+{
+  $result = ($1.data != NULL && $1.size > 0)
+          ? jenv->NewDirectByteBuffer($1.data, (jlong)$1.size) : NULL;
+}
+
+%typemap(jni)     SedStringArray "jobjectArray"
+%typemap(jtype)   SedStringArray "String[]"
+%typemap(jstype)  SedStringArray "String[]"
+%typemap(javaout) SedStringArray { return $jnicall; }
+%typemap(out)     SedStringArray
+{
+  jclass stringClass = jenv->FindClass("java/lang/String");
+  $result = jenv->NewObjectArray((jsize)$1.size(), stringClass, NULL);
+  for (size_t i = 0; i < $1.size(); ++i)
+  {
+    jstring id = jenv->NewStringUTF($1[i].c_str());
+    jenv->SetObjectArrayElement($result, (jsize)i, id);
+    jenv->DeleteLocalRef(id);
+  }
+}
+
+%extend SedResults
+{
+  SedDirectBuffer _getColumnBuffer(const std::string& id)
+  {
+    SedDirectBuffer buffer;
+    buffer.data = self->getColumn(id);
+    buffer.size = (buffer.data != NULL) ? self->getColumnLength(id) * sizeof(double) : 0;
+    return buffer;
+  }
+
+  SedDirectBuffer _addColumnBuffer(const std::string& id, long long length)
+  {
+    // a negative Java length would otherwise become a huge size_t
+    SedDirectBuffer buffer;
+    buffer.data = (length < 0) ? NULL : self->addColumn(id, (size_t)length);
+    buffer.size = (buffer.data != NULL) ? (size_t)length * sizeof(double) : 0;
+    return buffer;
+  }
+
+  SedStringArray getColumnIds()
+  {
+    SedStringArray ids;
+    for (unsigned int n = 0; n < self->getNumColumns(); ++n)
+    {
+      ids.push_back(self->getColumnId(n));
+    }
+    return ids;
+  }
+}
+
+%typemap("javacode") SedResults
+%{
+  /**
+   * Returns the column with the given id as a DoubleBuffer over the memory
+   * of this SedResults, without copying; writes to it change the column.
+   * <p>
+   * The buffer does not keep this SedResults alive: it is only valid
+   * while this object is reachable and has not been deleted, and until
+   * the column is removed or resized.
+   *
+   * @param id the id of the column
+   *
+   * @return the values of the column, or <code>null</code> if there is
+   * no column with that id
+   */
+  public java.nio.DoubleBuffer getColumnBuffer(String id)
+  {
+    if (!hasColumn(id)) return null;
+    java.nio.ByteBuffer bytes = _getColumnBuffer(id);
+    if (bytes == null) return java.nio.DoubleBuffer.allocate(0);
+    return bytes.order(java.nio.ByteOrder.nativeOrder()).asDoubleBuffer();
+  }
+
+  /**
+   * Creates the column with the given id with room for the given number
+   * of values, all zero, resizing and clearing an existing one, and
+   * returns its values as getColumnBuffer() does, so that they can be
+   * filled in place.
+   *
+   * @param id the id of the column
+   * @param length the number of values of the column
+   *
+   * @return the values of the column, or <code>null</code> if it could not
+   * be allocated
+   *
+   * @throws IllegalArgumentException if <code>length</code> is negative
+   */
+  public java.nio.DoubleBuffer addColumnBuffer(String id, long length)
+  {
+    if (length < 0)
+      throw new IllegalArgumentException("negative column length: " + length);
+    java.nio.ByteBuffer bytes = _addColumnBuffer(id, length);
+    if (bytes == null)
+      return hasColumn(id) ? java.nio.DoubleBuffer.allocate(0) : null;
+    return bytes.order(java.nio.ByteOrder.nativeOrder()).asDoubleBuffer();
+  }
+%}
+
+
+
 /**
  * getCPtrAndDisown() is like getCPtr() but it also sets the SWIG memory
  * ownsership flag to false.
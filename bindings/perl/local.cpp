@@ -39,8 +39,6 @@ GetDowncastSwigType (SedBase* sb)
 {
   if (sb == 0) return SWIGTYPE_p_SedBase;
   
-  std::string name;
-
     switch (sb->getTypeCode())
     {
       case SEDML_DOCUMENT:
@@ -101,55 +99,35 @@ GetDowncastSwigType (SedBase* sb)
         return SWIGTYPE_p_SedUniformTimeCourse;
 		
       case SEDML_LIST_OF:
-        name = sb->getElementName();
-        if(name == "listOf"){
-          return SWIGTYPE_p_SedListOf;
+        // the lists are told apart by the type code of their items, not
+        // by comparing element names
+        switch (static_cast<SedListOf*>(sb)->getItemTypeCode())
+        {
+          case SEDML_MODEL:
+            return SWIGTYPE_p_SedListOfModels;
+          case SEDML_CHANGE:
+            return SWIGTYPE_p_SedListOfChanges;
+          case SEDML_SIMULATION:
+            return SWIGTYPE_p_SedListOfSimulations;
+          case SEDML_TASK:
+            return SWIGTYPE_p_SedListOfTasks;
+          case SEDML_DATAGENERATOR:
+            return SWIGTYPE_p_SedListOfDataGenerators;
+          case SEDML_OUTPUT:
+            return SWIGTYPE_p_SedListOfOutputs;
+          case SEDML_OUTPUT_CURVE:
+            return SWIGTYPE_p_SedListOfCurves;
+          case SEDML_OUTPUT_SURFACE:
+            return SWIGTYPE_p_SedListOfSurfaces;
+          case SEDML_OUTPUT_DATASET:
+            return SWIGTYPE_p_SedListOfDataSets;
+          case SEDML_PARAMETER:
+            return SWIGTYPE_p_SedListOfParameters;
+          case SEDML_VARIABLE:
+            return SWIGTYPE_p_SedListOfVariables;
+          default:
+            return SWIGTYPE_p_SedListOf;
         }
-        else if(name == "listOfModels")
-		{
-			return SWIGTYPE_p_SedListOfModels;
-		}
-		else if(name == "listOfChanges")
-		{
-			return SWIGTYPE_p_SedListOfChanges;
-		}
-		else if(name == "listOfSimulations")
-		{
-			return SWIGTYPE_p_SedListOfSimulations;
-		}
-		else if(name == "listOfTasks")
-		{
-			return SWIGTYPE_p_SedListOfTasks;
-		}
-		else if(name == "listOfDataGenerators")
-		{
-			return SWIGTYPE_p_SedListOfDataGenerators;
-		}
-		else if(name == "listOfOutputs")
-		{
-			return SWIGTYPE_p_SedListOfOutputs;
-		}
-		else if(name == "listOfCurves")
-		{
-			return SWIGTYPE_p_SedListOfCurves;
-		}
-		else if(name == "listOfSurfaces")
-		{
-			return SWIGTYPE_p_SedListOfSurfaces;
-		}
-		else if(name == "listOfDataSets")
-		{
-			return SWIGTYPE_p_SedListOfDataSets;
-		}
-		else if(name == "listOfParameters")
-		{
-			return SWIGTYPE_p_SedListOfParameters;
-		}
-		else if(name == "listOfVariables")
-		{
-			return SWIGTYPE_p_SedListOfVariables;
-		}
-		return SWIGTYPE_p_SedListOf;
       
       default:
         return SWIGTYPE_p_SedBase;
@@ -27,6 +27,8 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <cstddef>
+#include <cstdlib>
+#include <limits>
 #include "sedml/SedBase.h"
 
 
@@ -39,8 +41,6 @@ GetDowncastSwigType (SedBase* sb)
 {
   if (sb == 0) return SWIGTYPE_p_SedBase;
   
-  std::string name;
-
     switch (sb->getTypeCode())
     {
       case SEDML_DOCUMENT:
@@ -101,55 +101,35 @@ GetDowncastSwigType (SedBase* sb)
         return SWIGTYPE_p_SedUniformTimeCourse;
 		
       case SEDML_LIST_OF:
-        name = sb->getElementName();
-        if(name == "listOf"){
-          return SWIGTYPE_p_SedListOf;
+        // the lists are told apart by the type code of their items, not
+        // by comparing element names
+        switch (static_cast<SedListOf*>(sb)->getItemTypeCode())
+        {
+          case SEDML_MODEL:
+            return SWIGTYPE_p_SedListOfModels;
+          case SEDML_CHANGE:
+            return SWIGTYPE_p_SedListOfChanges;
+          case SEDML_SIMULATION:
+            return SWIGTYPE_p_SedListOfSimulations;
+          case SEDML_TASK:
+            return SWIGTYPE_p_SedListOfTasks;
+          case SEDML_DATAGENERATOR:
+            return SWIGTYPE_p_SedListOfDataGenerators;
+          case SEDML_OUTPUT:
+            return SWIGTYPE_p_SedListOfOutputs;
+          case SEDML_OUTPUT_CURVE:
+            return SWIGTYPE_p_SedListOfCurves;
+          case SEDML_OUTPUT_SURFACE:
+            return SWIGTYPE_p_SedListOfSurfaces;
+          case SEDML_OUTPUT_DATASET:
+            return SWIGTYPE_p_SedListOfDataSets;
+          case SEDML_PARAMETER:
+            return SWIGTYPE_p_SedListOfParameters;
+          case SEDML_VARIABLE:
+            return SWIGTYPE_p_SedListOfVariables;
+          default:
+            return SWIGTYPE_p_SedListOf;
         }
-        else if(name == "listOfModels")
-		{
-			return SWIGTYPE_p_SedListOfModels;
-		}
-		else if(name == "listOfChanges")
-		{
-			return SWIGTYPE_p_SedListOfChanges;
-		}
-		else if(name == "listOfSimulations")
-		{
-			return SWIGTYPE_p_SedListOfSimulations;
-		}
-		else if(name == "listOfTasks")
-		{
-			return SWIGTYPE_p_SedListOfTasks;
-		}
-		else if(name == "listOfDataGenerators")
-		{
-			return SWIGTYPE_p_SedListOfDataGenerators;
-		}
-		else if(name == "listOfOutputs")
-		{
-			return SWIGTYPE_p_SedListOfOutputs;
-		}
-		else if(name == "listOfCurves")
-		{
-			return SWIGTYPE_p_SedListOfCurves;
-		}
-		else if(name == "listOfSurfaces")
-		{
-			return SWIGTYPE_p_SedListOfSurfaces;
-		}
-		else if(name == "listOfDataSets")
-		{
-			return SWIGTYPE_p_SedListOfDataSets;
-		}
-		else if(name == "listOfParameters")
-		{
-			return SWIGTYPE_p_SedListOfParameters;
-		}
-		else if(name == "listOfVariables")
-		{
-			return SWIGTYPE_p_SedListOfVariables;
-		}
-		return SWIGTYPE_p_SedListOf;
       
       default:
         return SWIGTYPE_p_SedBase;
@@ -158,9 +138,487 @@ GetDowncastSwigType (SedBase* sb)
   return SWIGTYPE_p_SedBase;
 }
 
+
+/**
+ * @return a Python list of proxies for the items of @p list, in order;
+ * see SedListOf.__iter__() in local.i.
+ *
+ * The items of a SedListOf mostly share one type, so the Swig type of the
+ * previous item is reused as long as the type code does not change; only
+ * lists nested in a list, whose type depends on their items, are
+ * always looked up.
+ */
+static PyObject*
+GetListOfItems (SedListOf* list)
+{
+  const unsigned int size = list->size();
+  PyObject* result = PyList_New(size);
+
+  int lastTypeCode = SEDML_UNKNOWN;
+  struct swig_type_info* lastType = SWIGTYPE_p_SedBase;
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    SedBase* item = list->get(i);
+    const int typeCode = (item != NULL) ? item->getTypeCode() : SEDML_UNKNOWN;
+
+    if (typeCode != lastTypeCode || typeCode == SEDML_LIST_OF)
+    {
+      lastType     = GetDowncastSwigType(item);
+      lastTypeCode = typeCode;
+    }
+
+    PyList_SET_ITEM(result, i,
+                    SWIG_NewPointerObj(SWIG_as_voidptr(item), lastType, 0));
+  }
+
+  return result;
+}
+
 /* Compatibility bug fix for swig 2.0.7 and Python 3. 
  * See http://patch-tracker.debian.org/patch/series/view/swig2.0/2.0.7-3/pyint_fromsize_t.diff
  */
 #if (PY_MAJOR_VERSION >= 3)
 #define PyInt_FromSize_t(x) PyLong_FromSize_t(x)
 #endif
+
+
+/**
+ * Bulk access to the attributes of the items of a SedListOf; see
+ * SedListOf.to_records() in local.i.  One call collects a column per
+ * attribute, so Python code does not pay a wrapper round trip for every
+ * attribute of every item.
+ */
+
+#if (PY_MAJOR_VERSION >= 3)
+#define SedRecord_FromString(s) PyUnicode_FromStringAndSize((s).data(), (s).size())
+#else
+#define SedRecord_FromString(s) PyString_FromStringAndSize((s).data(), (s).size())
+#endif
+
+
+/* NumPy type strings of the values of a column */
+static const char* const SED_RECORD_STRING = "U";
+static const char* const SED_RECORD_DOUBLE = "f8";
+static const char* const SED_RECORD_INT    = "i4";
+static const char* const SED_RECORD_BOOL   = "?";
+
+
+struct SedRecordField
+{
+  const char* name;
+  const char* kind;
+};
+
+
+static const SedRecordField sModelFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "language",        SED_RECORD_STRING }
+  , { "source",          SED_RECORD_STRING }
+};
+
+static const SedRecordField sChangeFields[] =
+{
+    { "element",         SED_RECORD_STRING }
+  , { "target",          SED_RECORD_STRING }
+  , { "newValue",        SED_RECORD_STRING }
+};
+
+static const SedRecordField sSimulationFields[] =
+{
+    { "element",         SED_RECORD_STRING }
+  , { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "kisaoID",         SED_RECORD_STRING }
+  , { "initialTime",     SED_RECORD_DOUBLE }
+  , { "outputStartTime", SED_RECORD_DOUBLE }
+  , { "outputEndTime",   SED_RECORD_DOUBLE }
+  , { "numberOfPoints",  SED_RECORD_INT    }
+};
+
+static const SedRecordField sTaskFields[] =
+{
+    { "id",                  SED_RECORD_STRING }
+  , { "name",                SED_RECORD_STRING }
+  , { "modelReference",      SED_RECORD_STRING }
+  , { "simulationReference", SED_RECORD_STRING }
+};
+
+static const SedRecordField sDataGeneratorFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "math",            SED_RECORD_STRING }
+};
+
+static const SedRecordField sVariableFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "symbol",          SED_RECORD_STRING }
+  , { "target",          SED_RECORD_STRING }
+  , { "taskReference",   SED_RECORD_STRING }
+  , { "modelReference",  SED_RECORD_STRING }
+};
+
+static const SedRecordField sParameterFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "value",           SED_RECORD_DOUBLE }
+};
+
+static const SedRecordField sOutputFields[] =
+{
+    { "element",         SED_RECORD_STRING }
+  , { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+};
+
+static const SedRecordField sDataSetFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "label",           SED_RECORD_STRING }
+  , { "dataReference",   SED_RECORD_STRING }
+};
+
+/* the fields of a surface are those of a curve followed by two more */
+static const SedRecordField sSurfaceFields[] =
+{
+    { "id",              SED_RECORD_STRING }
+  , { "name",            SED_RECORD_STRING }
+  , { "logX",            SED_RECORD_BOOL   }
+  , { "logY",            SED_RECORD_BOOL   }
+  , { "xDataReference",  SED_RECORD_STRING }
+  , { "yDataReference",  SED_RECORD_STRING }
+  , { "logZ",            SED_RECORD_BOOL   }
+  , { "zDataReference",  SED_RECORD_STRING }
+};
+
+static const SedRecordField sElementFields[] =
+{
+    { "element",         SED_RECORD_STRING }
+  , { "id",              SED_RECORD_STRING }
+};
+
+#define SED_RECORD_FIELDS(FIELDS) \
+  (numFields = sizeof(FIELDS) / sizeof(FIELDS[0]), FIELDS)
+
+
+/**
+ * @return the fields of the records of a list of items of the given type.
+ */
+static const SedRecordField*
+GetRecordFields (int itemTypeCode, unsigned int& numFields)
+{
+  switch (itemTypeCode)
+  {
+    case SEDML_MODEL:          return SED_RECORD_FIELDS(sModelFields);
+    case SEDML_CHANGE:         return SED_RECORD_FIELDS(sChangeFields);
+    case SEDML_SIMULATION:     return SED_RECORD_FIELDS(sSimulationFields);
+    case SEDML_TASK:           return SED_RECORD_FIELDS(sTaskFields);
+    case SEDML_DATAGENERATOR:  return SED_RECORD_FIELDS(sDataGeneratorFields);
+    case SEDML_VARIABLE:       return SED_RECORD_FIELDS(sVariableFields);
+    case SEDML_PARAMETER:      return SED_RECORD_FIELDS(sParameterFields);
+    case SEDML_OUTPUT:         return SED_RECORD_FIELDS(sOutputFields);
+    case SEDML_OUTPUT_DATASET: return SED_RECORD_FIELDS(sDataSetFields);
+    case SEDML_OUTPUT_SURFACE: return SED_RECORD_FIELDS(sSurfaceFields);
+
+    case SEDML_OUTPUT_CURVE:
+      numFields = 6;
+      return sSurfaceFields;
+
+    default:                   return SED_RECORD_FIELDS(sElementFields);
+  }
+}
+
+#undef SED_RECORD_FIELDS
+
+
+/**
+ * Appends the value of @p field of @p item to @p column.
+ */
+static void
+AppendRecordValue (PyObject* column, const SedBase* item,
+                   const SedRecordField& field)
+{
+  const std::string name(field.name);
+  const int type = item->getTypeCode();
+
+  std::string text;
+  double      number  = std::numeric_limits<double>::quiet_NaN();
+  long        integer = -1;
+  bool        flag    = false;
+
+  if (name == "element")
+  {
+    text = item->getElementName();
+  }
+  else if (name == "id")
+  {
+    text = item->getId();
+  }
+  else if (name == "name")
+  {
+    text = item->getName();
+  }
+  else
+  {
+    switch (type)
+    {
+      case SEDML_MODEL:
+      {
+        const SedModel* model = static_cast<const SedModel*>(item);
+        if      (name == "language") text = model->getLanguage();
+        else if (name == "source")   text = model->getSource();
+        break;
+      }
+
+      case SEDML_CHANGE_ATTRIBUTE:
+        if (name == "newValue")
+        {
+          text = static_cast<const SedChangeAttribute*>(item)->getNewValue();
+          break;
+        }
+        // fall through
+      case SEDML_CHANGE:
+      case SEDML_CHANGE_REMOVEXML:
+      case SEDML_CHANGE_COMPUTECHANGE:
+        if (name == "target")
+        {
+          text = static_cast<const SedChange*>(item)->getTarget();
+        }
+        break;
+
+      case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+      {
+        const SedUniformTimeCourse* utc =
+          static_cast<const SedUniformTimeCourse*>(item);
+        if      (name == "initialTime")     number = utc->getInitialTime();
+        else if (name == "outputStartTime") number = utc->getOutputStartTime();
+        else if (name == "outputEndTime")   number = utc->getOutputEndTime();
+        else if (name == "numberOfPoints" && utc->isSetNumberOfPoints())
+        {
+          integer = utc->getNumberOfPoints();
+        }
+      }
+        // fall through
+      case SEDML_SIMULATION:
+        if (name == "kisaoID")
+        {
+          const SedAlgorithm* algorithm =
+            static_cast<const SedSimulation*>(item)->getAlgorithm();
+          if (algorithm != NULL) text = algorithm->getKisaoID();
+        }
+        break;
+
+      case SEDML_TASK:
+      {
+        const SedTask* task = static_cast<const SedTask*>(item);
+        if      (name == "modelReference")      text = task->getModelReference();
+        else if (name == "simulationReference") text = task->getSimulationReference();
+        break;
+      }
+
+      case SEDML_DATAGENERATOR:
+        if (name == "math")
+        {
+          const ASTNode* math =
+            static_cast<const SedDataGenerator*>(item)->getMath();
+          char* formula = (math != NULL) ? SBML_formulaToString(math) : NULL;
+          if (formula != NULL) text = formula;
+          free(formula);
+        }
+        break;
+
+      case SEDML_VARIABLE:
+      {
+        const SedVariable* var = static_cast<const SedVariable*>(item);
+        if      (name == "symbol")         text = var->getSymbol();
+        else if (name == "target")         text = var->getTarget();
+        else if (name == "taskReference")  text = var->getTaskReference();
+        else if (name == "modelReference") text = var->getModelReference();
+        break;
+      }
+
+      case SEDML_PARAMETER:
+        if (name == "value")
+        {
+          number = static_cast<const SedParameter*>(item)->getValue();
+        }
+        break;
+
+      case SEDML_OUTPUT_DATASET:
+      {
+        const SedDataSet* ds = static_cast<const SedDataSet*>(item);
+        if      (name == "label")         text = ds->getLabel();
+        else if (name == "dataReference") text = ds->getDataReference();
+        break;
+      }
+
+      case SEDML_OUTPUT_SURFACE:
+      {
+        const SedSurface* surface = static_cast<const SedSurface*>(item);
+        if (name == "logZ")
+        {
+          flag = surface->getLogZ();
+          break;
+        }
+        else if (name == "zDataReference")
+        {
+          text = surface->getZDataReference();
+          break;
+        }
+      }
+        // fall through
+      case SEDML_OUTPUT_CURVE:
+      {
+        const SedCurve* curve = static_cast<const SedCurve*>(item);
+        if      (name == "logX")           flag = curve->getLogX();
+        else if (name == "logY")           flag = curve->getLogY();
+        else if (name == "xDataReference") text = curve->getXDataReference();
+        else if (name == "yDataReference") text = curve->getYDataReference();
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
+
+  PyObject* value = NULL;
+  if (field.kind == SED_RECORD_DOUBLE)
+  {
+    value = PyFloat_FromDouble(number);
+  }
+  else if (field.kind == SED_RECORD_INT)
+  {
+    value = PyLong_FromLong(integer);
+  }
+  else if (field.kind == SED_RECORD_BOOL)
+  {
+    value = PyBool_FromLong(flag ? 1 : 0);
+  }
+  else
+  {
+    value = SedRecord_FromString(text);
+  }
+
+  PyList_Append(column, value);
+  Py_XDECREF(value);
+}
+
+
+/**
+ * @return a tuple (names, kinds, columns) holding the field names of the
+ * records of @p list, their NumPy type strings, and a list of values per
+ * field, in the order of the items.
+ */
+static PyObject*
+GetRecordColumns (const SedListOf* list)
+{
+  unsigned int numFields = 0;
+  const SedRecordField* fields = GetRecordFields(list->getItemTypeCode(),
+                                                 numFields);
+
+  PyObject* names   = PyTuple_New(numFields);
+  PyObject* kinds   = PyTuple_New(numFields);
+  PyObject* columns = PyList_New(numFields);
+
+  for (unsigned int f = 0; f < numFields; ++f)
+  {
+    PyTuple_SET_ITEM(names, f, SedRecord_FromString(std::string(fields[f].name)));
+    PyTuple_SET_ITEM(kinds, f, SedRecord_FromString(std::string(fields[f].kind)));
+    PyList_SET_ITEM(columns, f, PyList_New(0));
+  }
+
+  for (unsigned int i = 0; i < list->size(); ++i)
+  {
+    const SedBase* item = list->get(i);
+    for (unsigned int f = 0; f < numFields; ++f)
+    {
+      AppendRecordValue(PyList_GET_ITEM(columns, f), item, fields[f]);
+    }
+  }
+
+  PyObject* result = PyTuple_Pack(3, names, kinds, columns);
+  Py_DECREF(names);
+  Py_DECREF(kinds);
+  Py_DECREF(columns);
+  return result;
+}
+
+
+/**
+ * Pickling of documents and their elements; see SedDocument.__reduce__()
+ * and SedBase.__reduce__() in local.i.  Both travel as the
+ * SedBinaryCodec::encodeObject() encoding of the object and everything
+ * below it, with its namespaces.
+ */
+
+#if (PY_MAJOR_VERSION >= 3)
+#define SedPickle_FromString(s) PyBytes_FromStringAndSize((s).data(), (s).size())
+#else
+#define SedPickle_FromString(s) PyString_FromStringAndSize((s).data(), (s).size())
+#endif
+
+
+/**
+ * @return the encoding of @p object as a bytes object, or None if it
+ * cannot be encoded.
+ */
+static PyObject*
+EncodeSedObject (const SedBase* object)
+{
+  const std::string data = SedBinaryCodec::encodeObject(object);
+  if (data.empty())
+  {
+    Py_INCREF(Py_None);
+    return Py_None;
+  }
+  return SedPickle_FromString(data);
+}
+
+
+/**
+ * Reads the bytes of @p data, any object exposing them through the buffer
+ * protocol, a memoryview of shared memory included, in place.
+ *
+ * @return the object encoded in them, or @c NULL if they are not an
+ * encoding.
+ */
+static SedBase*
+DecodeSedObject (PyObject* data)
+{
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) != 0)
+  {
+    PyErr_Clear();
+    return NULL;
+  }
+
+  SedBase* object = SedBinaryCodec::decodeObject(
+    static_cast<const char*>(view.buf), (size_t)view.len);
+  PyBuffer_Release(&view);
+  return object;
+}
+
+
+/**
+ * @return the document encoded in @p data, read as DecodeSedObject()
+ * reads it, or @c NULL if it is not the encoding of a document.
+ */
+static SedDocument*
+DecodeSedDocument (PyObject* data)
+{
+  SedBase* object = DecodeSedObject(data);
+  if (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+  {
+    delete object;
+    return NULL;
+  }
+  return static_cast<SedDocument*>(object);
+}
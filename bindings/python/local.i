@@ -234,8 +234,7 @@ namespace std
 
 
     def __iter__(self):
-      for i in range(self.size()):
-        yield self[i]
+      return iter(self._getItems())
 
 
     def __repr__(self):
@@ -244,6 +243,241 @@ namespace std
 
     def __str__(self):
       return repr(self)
+
+
+    def to_columns(self):
+      """
+      Returns the attributes of the items of this list as a dict mapping
+      each attribute name to a list of values, one per item, in order.
+      The attributes depend on the type of the items: for variables, for
+      instance, they are id, name, symbol, target, taskReference and
+      modelReference.  Unset strings are empty, unset numbers NaN.
+      """
+      names, kinds, columns = self._getRecordColumns()
+      return dict(zip(names, columns))
+
+
+    def to_records(self):
+      """
+      Returns the attributes of the items of this list, as described for
+      to_columns(), as a NumPy record array with one record per item.
+      """
+      import numpy
+      names, kinds, columns = self._getRecordColumns()
+      arrays = [numpy.array(c, dtype=k) for c, k in zip(columns, kinds)]
+      return numpy.rec.fromarrays(arrays, names=list(names))
+  }
+
+  PyObject* _getItems()
+  {
+    return GetListOfItems(self);
+  }
+
+  PyObject* _getRecordColumns()
+  {
+    return GetRecordColumns(self);
+  }
+}
+
+
+/**
+ * SedResults hands out its columns as NumPy arrays sharing their memory
+ * instead of through the raw pointers of the C++ API.
+ */
+%extend SedResults
+{
+  size_t _getColumnAddress(const std::string& id)
+  {
+    return (size_t)self->getColumn(id);
+  }
+
+  int _setColumnFromAddress(const std::string& id, size_t address, size_t length)
+  {
+    return self->setColumn(id, (const double*)address, length);
+  }
+
+  %pythoncode
+  {
+    def column(self, id):
+      """
+      Returns the column with the given id as a one-dimensional NumPy
+      array of float64 that shares the memory of this SedResults, without
+      copying; the array keeps this SedResults alive.  It is only valid
+      until the column is removed or resized.  Returns None if there is
+      no such column.
+      """
+      if not self.hasColumn(id):
+        return None
+      import numpy
+      length = self.getColumnLength(id)
+      if length == 0:
+        return numpy.zeros(0, dtype=numpy.float64)
+      return numpy.asarray(_SedColumnBuffer(self, self._getColumnAddress(id), length))
+
+
+    def columns(self):
+      """
+      Returns a dict mapping the id of each column to column(id).
+      """
+      result = {}
+      for n in range(self.getNumColumns()):
+        id = self.getColumnId(n)
+        result[id] = self.column(id)
+      return result
+
+
+    def set_column(self, id, values):
+      """
+      Replaces the values of the column with the given id, adding it if
+      needed, by those of any sequence or array convertible to float64.
+      """
+      import numpy
+      values = numpy.ascontiguousarray(values, dtype=numpy.float64).ravel()
+      return self._setColumnFromAddress(id, values.ctypes.data, values.size)
+  }
+}
+
+%pythoncode
+%{
+class _SedColumnBuffer(object):
+  """
+  Exposes the memory of a column of a SedResults through the NumPy array
+  interface; internal to SedResults.column().
+  """
+  def __init__(self, owner, address, length):
+    import numpy
+    self._owner = owner
+    self.__array_interface__ = {
+      'shape'   : (length,),
+      'typestr' : numpy.dtype(numpy.float64).str,
+      'data'    : (address, False),
+      'version' : 3,
+    }
+%}
+
+
+/**
+ * Documents and their elements can be pickled, and so handed to the
+ * workers of multiprocessing, as their SedBinaryCodec encoding rather
+ * than as XML; decoding it costs far less than parsing.  Large documents
+ * can also be handed over in shared memory, which every worker decodes in
+ * place.
+ */
+%newobject _decodeSedDocument;
+%newobject _decodeSedElement;
+
+%inline
+%{
+SedDocument* _decodeSedDocument(PyObject* data)
+{
+  return DecodeSedDocument(data);
+}
+
+SedBase* _decodeSedElement(PyObject* data)
+{
+  return DecodeSedObject(data);
+}
+%}
+
+%pythoncode
+%{
+def _unpickleSedDocument(data):
+  doc = _decodeSedDocument(data)
+  if doc is None:
+    import pickle
+    raise pickle.UnpicklingError("not an encoded SedDocument")
+  return doc
+
+
+def _unpickleSedElement(data):
+  element = _decodeSedElement(data)
+  if element is None:
+    import pickle
+    raise pickle.UnpicklingError("not an encoded SedDocument element")
+  return element
+%}
+
+%extend SedDocument
+{
+  PyObject* _encode()
+  {
+    return EncodeSedObject(self);
+  }
+
+  %pythoncode
+  {
+    def __reduce__(self):
+      """
+      Pickles this document as its binary encoding.
+      """
+      data = self._encode()
+      if data is None:
+        import pickle
+        raise pickle.PicklingError("the SedDocument cannot be encoded")
+      return (_unpickleSedDocument, (data,))
+
+
+    def to_shared_memory(self):
+      """
+      Returns a new multiprocessing.shared_memory.SharedMemory holding the
+      binary encoding of this document, preceded by its length.  Pass its
+      name to SedDocument.from_shared_memory() in the workers; the caller
+      closes and unlinks it once they are done.  Requires Python 3.8.
+      """
+      import struct
+      from multiprocessing import shared_memory
+      data = self._encode()
+      if data is None:
+        raise ValueError("the SedDocument cannot be encoded")
+      shm = shared_memory.SharedMemory(create=True, size=len(data) + 8)
+      shm.buf[:8] = struct.pack("<Q", len(data))
+      shm.buf[8:8 + len(data)] = data
+      return shm
+
+
+    @staticmethod
+    def from_shared_memory(name):
+      """
+      Returns a new SedDocument decoded in place from the shared memory of
+      the given name, as filled by to_shared_memory().
+      """
+      import struct
+      from multiprocessing import shared_memory
+      shm = shared_memory.SharedMemory(name=name)
+      try:
+        buf = shm.buf
+        length = struct.unpack("<Q", bytes(buf[:8]))[0]
+        view = buf[8:8 + length]
+        try:
+          return _unpickleSedDocument(view)
+        finally:
+          view.release()
+          buf.release()
+      finally:
+        shm.close()
+  }
+}
+
+%extend SedBase
+{
+  PyObject* _encode()
+  {
+    return EncodeSedObject(self);
+  }
+
+  %pythoncode
+  {
+    def __reduce__(self):
+      """
+      Pickles this element as the binary encoding of itself, everything
+      below it and its namespaces, whether or not it is in a document; it
+      unpickles as a copy of the element on its own.
+      """
+      data = self._encode()
+      if data is None:
+        import pickle
+        raise pickle.PicklingError("the element cannot be encoded")
+      return (_unpickleSedElement, (data,))
   }
 }
 
@@ -869,4 +1103,31 @@ SedNamespaces::getSupportedNamespaces
 #endif
                                SWIG_POINTER_OWN |  0 );
 }
+
+
+/**
+ * The TYPENAMEList classes iterate like Python sequences.
+ */
+%pythoncode
+%{
+def _ListWrapper_iter(self):
+  for i in range(self.getSize()):
+    yield self.get(i)
+
+def _ListWrapper_getitem(self, key):
+  if key < 0:
+    key += self.getSize()
+  if key < 0 or key >= self.getSize():
+    raise IndexError(key)
+  return self.get(key)
+
+for _name in ('ModelCreatorList', 'DateList', 'CVTermList', 'ASTNodeList',
+              'SedNamespacesList', 'SBaseList'):
+  _cls = globals().get(_name)
+  if _cls is not None:
+    _cls.__iter__    = _ListWrapper_iter
+    _cls.__getitem__ = _ListWrapper_getitem
+    _cls.__len__     = _cls.getSize
+del _name, _cls
+%}
  
\ No newline at end of file
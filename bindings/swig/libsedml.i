@@ -25,7 +25,11 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#ifdef SWIGPYTHON
+%module(directors="1", threads="1") libsedml
+#else
 %module(directors="1") libsedml
+#endif
 
 //#pragma SWIG nowarn=473,401,844
 
@@ -51,6 +55,34 @@
 public class"
 
 
+/**
+ * Release the Python interpreter lock while documents are read or
+ * written, so that other Python threads run in the meantime.  All other
+ * calls keep it: they are short, and some of them, such as those local.i
+ * adds, use the Python API
+ */
+#ifdef SWIGPYTHON
+%nothread;
+%thread SedReader::readSedML;
+%thread SedReader::readSedMLFromFile;
+%thread SedReader::readSedMLFromString;
+%thread SedReader::readSedMLFromBuffer;
+%thread SedReader::readSedMLFromMappedFile;
+%thread SedBatchReader::readFiles;
+%thread SedBatchReader::readStrings;
+%thread SedWriter::writeSedML;
+%thread SedWriter::writeToString;
+%thread SedWriter::writeSedMLToFile;
+%thread SedWriter::writeSedMLToString;
+%thread readSedML;
+%thread readSedMLFromFile;
+%thread readSedMLFromString;
+%thread writeSedML;
+%thread writeSedMLToFile;
+%thread writeSedMLToString;
+#endif
+
+
 %{
 #include "libsedml.h"
 
@@ -176,6 +208,21 @@ LIBSEDML_CPP_NAMESPACE_USE
 %ignore SEDMLExternalValidator::setArguments;
 
 
+/**
+ * Ignore the methods of SedResults dealing in raw pointers; the local.i of
+ * each language wraps its columns instead, as NumPy arrays in Python,
+ * direct DoubleBuffers in Java and spans in C#
+ */
+%ignore SedResults::addColumn;
+%ignore SedResults::getColumn;
+%ignore SedResults::setColumn;
+%ignore SedResults::getView;
+%ignore SedResults::getXView;
+%ignore SedResults::getYView;
+%ignore SedResults::getZView;
+%ignore SedColumnView;
+
+
 /**
  * Ignore 'static ParentMap mParent;' in SBO.h
  */
@@ -300,6 +347,24 @@ LIBSEDML_CPP_NAMESPACE_USE
 %newobject UnitDefinition::convertToSI;
 %newobject UnitDefinition::combine;
 
+/**
+ * The math of SedDataGenerator and SedComputeChange is interned by
+ * SedMathCache, shared with every object with equal math and never to be
+ * changed; the wrapped languages get a copy they own instead.
+ */
+%newobject SedDataGenerator::getMath;
+%newobject SedComputeChange::getMath;
+
+%feature("action") SedDataGenerator::getMath
+{
+  result = (arg1->getMath() != NULL) ? arg1->getMath()->deepCopy() : NULL;
+}
+
+%feature("action") SedComputeChange::getMath
+{
+  result = (arg1->getMath() != NULL) ? arg1->getMath()->deepCopy() : NULL;
+}
+
 
 /**
  * In the wrapped languages, these methods will appear as:
@@ -407,6 +472,7 @@ LIBSEDML_CPP_NAMESPACE_USE
 %include <sedml/SedDataGenerator.h>
 %include <sedml/SedTask.h>
 %include <sedml/SedDocument.h>
+%include <sedml/SedResults.h>
 
 %include <sedml/SedConstructorException.h>
 
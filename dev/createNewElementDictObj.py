@@ -9,6 +9,7 @@ import sys
 
 import writeCode
 import writeHeader
+import writeTypeTraits
 
 def createElements():
   elements = [ createSedDocument(), 
@@ -34,6 +35,7 @@ def createElements():
   for element in elements:
     writeCode.createCode(element)
     writeHeader.createHeader(element)
+  writeTypeTraits.createTypeTraits(elements)
 
 
 def createSedDocument() :
@@ -245,26 +245,26 @@ def writeWriteElementsCPPCode(outFile, element, attributes, hasChildren=False, h
     for i in range(0, len(attributes)):
       if attributes[i]['type'] == 'element' and attributes[i]['name'] == 'Math' or attributes[i]['name'] == 'math':
         outFile.write('\tif (isSet{0}() == true)\n'.format('Math'))
-        outFile.write('\t{\n\t\twriteMathML(getMath(), stream, NULL);\n\t}\n')
+        outFile.write('\t{\n\t\tSedMathCache::write(getMath(), stream);\n\t}\n')
   outFile.write('}\n\n\n')
   writeInternalEnd(outFile)
 
 def writeAcceptHeader(outFile):
   writeInternalStart(outFile)
   outFile.write('\t/**\n')
-  outFile.write('\t * Accepts the given SedVisitor.\n')
+  outFile.write('\t * Shows this object, but not its children, to the given SedVisitor.\n')
   outFile.write('\t */\n')
-  outFile.write('\tvirtual bool accept (SedVisitor& v) const;\n\n\n')
+  outFile.write('\tvirtual bool dispatch (SedVisitor& v) const;\n\n\n')
   writeInternalEnd(outFile)
 
 def writeAcceptCPPCode(outFile, element):
   writeInternalStart(outFile)
   outFile.write('/*\n')
-  outFile.write(' * Accepts the given SedVisitor.\n')
+  outFile.write(' * Shows this object to the given SedVisitor.\n')
   outFile.write(' */\n')
-  outFile.write('bool\n{0}::accept (SedVisitor& v) const\n'.format(element))
+  outFile.write('bool\n{0}::dispatch (SedVisitor& v) const\n'.format(element))
   outFile.write('{\n')
-  outFile.write('\treturn false;\n\n')
+  outFile.write('\treturn v.visit(*this);\n')
   outFile.write('}\n\n\n')
   writeInternalEnd(outFile)
 
@@ -359,7 +359,7 @@ def writeReadAttributesHeader(outFile):
   outFile.write('\t                             const ExpectedAttributes& expectedAttributes);\n\n\n')
   writeInternalEnd(outFile)
 
-def writeReadAttribute(output, attrib, element):
+def writeReadAttribute(output, attrib, element, index):
   attName = attrib['name']
   capAttName = strFunctions.cap(attName)
   if attrib['reqd'] == True:
@@ -369,7 +369,7 @@ def writeReadAttribute(output, attrib, element):
   if attrib['type'] == 'SId':
     output.write('\t//\n\t// {0} SId'.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tassigned = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tassigned = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -387,7 +387,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'SIdRef':
     output.write('\t//\n\t// {0} SIdRef '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tassigned = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tassigned = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -405,7 +405,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'UnitSIdRef':
     output.write('\t//\n\t// {0} UnitSIdRef '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tassigned = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tassigned = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -423,7 +423,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'UnitSId':
     output.write('\t//\n\t// {0} UnitSId '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tassigned = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tassigned = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -441,7 +441,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'string':
     output.write('\t//\n\t// {0} string '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tassigned = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tassigned = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -457,7 +457,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'double':
     output.write('\t//\n\t// {0} double '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tmIsSet{1} = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tmIsSet{1} = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -465,7 +465,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'int':
     output.write('\t//\n\t// {0} int '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tmIsSet{1} = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tmIsSet{1} = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -473,7 +473,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'uint':
     output.write('\t//\n\t// {0} unsigned int '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tmIsSet{1} = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tmIsSet{1} = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -481,7 +481,7 @@ def writeReadAttribute(output, attrib, element):
   elif attrib['type'] == 'bool':
     output.write('\t//\n\t// {0} bool '.format(attName))
     output.write('  ( use = "{0}" )\n\t//\n'.format(use))
-    output.write('\tmIsSet{1} = attributes.readInto("{0}", m{1}, getErrorLog(), '.format(attName, capAttName))
+    output.write('\tmIsSet{1} = readAttribute(attributes, index[{2}], "{0}", m{1}, '.format(attName, capAttName, index))
     if use == 'required':
       output.write('true);\n\n')
     else:
@@ -493,6 +493,40 @@ def writeReadAttribute(output, attrib, element):
     attTypeCode = 'FIX ME'
     num = False
 	
+def elementNameHash(name):
+  # the 32-bit FNV-1a hash of SedBase::getElementNameHash()
+  hash = 2166136261
+  for c in name:
+    hash = ((hash ^ ord(c)) * 16777619) & 0xffffffff
+  return hash
+
+def writeNameDispatch(outFile, cases):
+  # cases are (element name, body lines) pairs; several names get a switch
+  # on their hash, then a single comparison to rule out other names
+  if len(cases) == 1:
+    outFile.write('\tif (name == "{0}")\n'.format(cases[0][0]))
+    outFile.write('\t{\n')
+    for line in cases[0][1]:
+      outFile.write('\t\t{0}\n'.format(line))
+    outFile.write('\t}\n\n')
+    return
+  hashes = [elementNameHash(name) for (name, lines) in cases]
+  if len(set(hashes)) != len(hashes):
+    raise Exception('element names with the same hash: {0}'.format([name for (name, lines) in cases]))
+  outFile.write('\tswitch (getElementNameHash(name))\n')
+  outFile.write('\t{\n')
+  for i in range (0, len(cases)):
+    if i > 0:
+      outFile.write('\n')
+    outFile.write('\tcase 0x{0:08x}u:\n'.format(hashes[i]))
+    outFile.write('\t\tif (name == "{0}")\n'.format(cases[i][0]))
+    outFile.write('\t\t{\n')
+    for line in cases[i][1]:
+      outFile.write('\t\t\t{0}\n'.format(line))
+    outFile.write('\t\t}\n')
+    outFile.write('\t\tbreak;\n')
+  outFile.write('\t}\n\n')
+
 def writeCreateObject(outFile, element, sbmltypecode, attribs, isSedListOf, hasChildren=False, hasMath=False,baseClass='SedBase'):  
   if (isSedListOf == True or hasChildren == False) and baseClass  == 'SedBase':
     return;
@@ -506,20 +540,19 @@ def writeCreateObject(outFile, element, sbmltypecode, attribs, isSedListOf, hasC
   else:
     outFile.write('\tSedBase* object = {0}::createObject(stream);\n\n'.format(baseClass))
   outFile.write('\tconst string& name   = stream.peek().getName();\n\n')
-  outFile.write('\t{0}::connectToChild();\n\n'.format(baseClass))
+  # the children are connected by SedBase::read(), once each
+  cases = []
   for i in range (0, len(attribs)):
     current = attribs[i]
     if current['type'] == 'lo_element':
-      outFile.write('\tif (name == "listOf{0}s")\n'.format(strFunctions.cap(current['name'])))	
-      outFile.write('\t{\n')	
-      outFile.write('\t\tobject = &m{0};\n'.format(strFunctions.cap(current['name'])))	
-      outFile.write('\t}\n\n')
+      cases.append(('listOf{0}s'.format(strFunctions.cap(current['name'])),
+                    ['object = &m{0};'.format(strFunctions.cap(current['name']))]))
     elif current['type'] == 'element' and (current['name'] !='Math' and current['name'] != 'math'):
-      outFile.write('\tif (name == "{0}")\n'.format(current['name']))	
-      outFile.write('\t{\n')	
-      outFile.write('\t\tm{0}= new {1}();\n'.format(strFunctions.cap(current['name']), current['element']))	
-      outFile.write('\t\tobject = m{0};\n'.format(strFunctions.cap(current['name'])))	
-      outFile.write('\t}\n\n')
+      cases.append((current['name'],
+                    ['m{0}= new (getArena()) {1}();'.format(strFunctions.cap(current['name']), current['element']),
+                     'object = m{0};'.format(strFunctions.cap(current['name']))]))
+  if len(cases) > 0:
+    writeNameDispatch(outFile, cases)
   outFile.write('\treturn object;\n')  
   outFile.write('}\n\n\n')  
 
@@ -549,8 +582,21 @@ def writeReadAttributesCPPCode(outFile, element, attribs, baseClass):
   outFile.write('{\n')
   outFile.write('\t{0}::readAttributes(attributes, expectedAttributes);\n\n'.format(baseClass))
   outFile.write('\tbool assigned = false;\n\n')
+  read = []
   for i in range (0, len(attribs)):
-    writeReadAttribute(outFile, attribs[i], element)
+    if attribs[i]['type'] in ('SId', 'SIdRef', 'UnitSIdRef', 'UnitSId', 'string', 'double', 'int', 'uint', 'bool'):
+      read.append(attribs[i])
+  if len(read) > 0:
+    outFile.write('\t// look for all attributes in one pass\n')
+    outFile.write('\tstatic const AttributeName names[] =\n\t{\n')
+    entries = []
+    for attrib in read:
+      entries.append('\t\t{{ "{0}", 0x{1:08x}u }}'.format(attrib['name'], elementNameHash(attrib['name'])))
+    outFile.write(',\n'.join(entries) + '\n\t};\n')
+    outFile.write('\tint index[{0}];\n'.format(len(read)))
+    outFile.write('\tfindAttributes(attributes, names, {0}, index);\n\n'.format(len(read)))
+  for i in range (0, len(read)):
+    writeReadAttribute(outFile, read[i], element, i)
   outFile.write('}\n\n\n')
   writeInternalEnd(outFile)
 
@@ -560,9 +606,28 @@ def writeWriteAttributesHeader(outFile):
   outFile.write('\t * Write values of XMLAttributes to the output stream.\n')
   outFile.write('\t */\n')
   outFile.write('\tvirtual void writeAttributes (XMLOutputStream& stream) const;\n\n\n')
+  outFile.write('\t/**\n')
+  outFile.write('\t * Adds the values of the attributes to attributes, as writeAttributes()\n')
+  outFile.write('\t * writes them.\n')
+  outFile.write('\t */\n')
+  outFile.write('\tvirtual void addAttributes (XMLAttributes& attributes) const;\n\n\n')
   writeInternalEnd(outFile)
   
 def writeWriteAttributesCPPCode(outFile, element, attribs, baseClass='SedBase'):
+  written = []
+  numeric = []
+  boolean = []
+  for i in range (0, len(attribs)):
+    if attribs[i]['type'] != 'element' and attribs[i]['type'] != 'lo_element':
+      written.append(attribs[i]['name'])
+      if attribs[i]['type'] in ('double', 'int', 'uint'):
+        numeric.append(attribs[i]['name'])
+      elif attribs[i]['type'] == 'bool':
+        boolean.append(attribs[i]['name'])
+  for name in written:
+    outFile.write('static const std::string s{0}Attribute("{1}");\n'.format(strFunctions.cap(name), name))
+  if len(written) > 0:
+    outFile.write('\n\n')
   writeInternalStart(outFile)
   outFile.write('/*\n')
   outFile.write(' * Write values of XMLAttributes to the output stream.\n')
@@ -570,10 +635,32 @@ def writeWriteAttributesCPPCode(outFile, element, attribs, baseClass='SedBase'):
   outFile.write('\tvoid\n{0}::writeAttributes (XMLOutputStream& stream) const\n'.format(element))
   outFile.write('{\n')
   outFile.write('\t{0}::writeAttributes(stream);\n\n'.format(baseClass))
-  for i in range (0, len(attribs)):
-    if attribs[i]['type'] != 'element' and attribs[i]['type'] != 'lo_element':
-      outFile.write('\tif (isSet{0}() == true)\n'.format(strFunctions.cap(attribs[i]['name'])))
-      outFile.write('\t\tstream.writeAttribute("{0}", getPrefix(), m{1});\n\n'.format(attribs[i]['name'], strFunctions.cap(attribs[i]['name'])))	 
+  if len(written) > 0:
+    outFile.write('\tconst std::string prefix = getPrefix();\n\n')
+  for name in written:
+    outFile.write('\tif (isSet{0}() == true)\n'.format(strFunctions.cap(name)))
+    if name in numeric:
+      outFile.write('\t\tstream.writeAttribute(s{0}Attribute, prefix, SedNumber::toString(m{0}));\n\n'.format(strFunctions.cap(name)))
+    else:
+      outFile.write('\t\tstream.writeAttribute(s{0}Attribute, prefix, m{0});\n\n'.format(strFunctions.cap(name)))
+  outFile.write('}\n\n\n')
+  outFile.write('/*\n')
+  outFile.write(' * Adds the values of the attributes, as writeAttributes() writes them, to\n')
+  outFile.write(' * attributes.\n')
+  outFile.write(' */\n')
+  outFile.write('void\n{0}::addAttributes (XMLAttributes& attributes) const\n'.format(element))
+  outFile.write('{\n')
+  outFile.write('\t{0}::addAttributes(attributes);\n\n'.format(baseClass))
+  if len(written) > 0:
+    outFile.write('\tconst std::string prefix = getPrefix();\n\n')
+  for name in written:
+    outFile.write('\tif (isSet{0}() == true)\n'.format(strFunctions.cap(name)))
+    if name in numeric:
+      outFile.write('\t\taddAttribute(attributes, s{0}Attribute, prefix, SedNumber::toString(m{0}));\n\n'.format(strFunctions.cap(name)))
+    elif name in boolean:
+      outFile.write('\t\taddAttribute(attributes, s{0}Attribute, prefix, m{0} ? "true" : "false");\n\n'.format(strFunctions.cap(name)))
+    else:
+      outFile.write('\t\taddAttribute(attributes, s{0}Attribute, prefix, m{0});\n\n'.format(strFunctions.cap(name)))
   outFile.write('}\n\n\n')
   writeInternalEnd(outFile)
   
@@ -589,19 +676,20 @@ def writeGetElementNameHeader(outFile, element, isSedListOf):
   outFile.write('\tvirtual const std::string& getElementName () const;\n\n\n')
 
 def writeGetElementNameCPPCode(outFile, element, isSedListOf=False, dict=None):
+  if dict != None and dict.has_key('elementName'):
+    if isSedListOf:
+      name = 'listOf{0}s'.format(strFunctions.cap(dict['elementName']))
+    else:
+      name = dict['elementName']
+  else:
+    name = strFunctions.lowerFirst(element)
+  outFile.write('static const std::string s{0}Name("{1}");\n\n\n'.format(element, name))
   outFile.write('/*\n')
   outFile.write(' * Returns the XML element name of this object\n')
   outFile.write(' */\n')
   outFile.write('const std::string&\n{0}::getElementName () const\n'.format(element))
   outFile.write('{\n')
-  if dict != None and dict.has_key('elementName'):
-    if isSedListOf:
-      outFile.write('\tstatic const string name = "listOf{0}s";\n'.format(strFunctions.cap(dict['elementName'])))
-    else:
-      outFile.write('\tstatic const string name = "{0}";\n'.format(dict['elementName']))
-  else:
-    outFile.write('\tstatic const string name = "{0}";\n'.format(strFunctions.lowerFirst(element)))
-  outFile.write('\treturn name;\n')
+  outFile.write('\treturn s{0}Name;\n'.format(element))
   outFile.write('}\n\n\n')
   
 
@@ -691,8 +779,8 @@ def writeReadOtherXMLCPPCode(outFile, element, baseClass='SedBase'):
   outFile.write('\t\tconst std::string prefix = checkMathMLNamespace(elem);\n\n')
   #outFile.write('\t\tif (stream.getSedNamespaces() == NULL)\n\t\t{\n')
   #outFile.write('\t\t\tstream.setSedNamespaces(new SedNamespaces(getLevel(), getVersion()));\n\t\t}\n\n')
-  outFile.write('\t\tdelete mMath;\n')
-  outFile.write('\t\tmMath = readMathML(stream, prefix);\n')
+  outFile.write('\t\tSedMathCache::release(mMath);\n')
+  outFile.write('\t\tmMath = SedMathCache::intern(readMathML(stream, prefix));\n')
   #outFile.write('\t\tif (mMath != NULL)\n\t\t{\n\t\t\tmMath->setParentSEDMLObject(this);\n\t\t}\n')
   outFile.write('\t\tread = true;\n\t}\n\n')
   outFile.write('\tif ({0}::readOtherXML(stream))\n'.format(baseClass))
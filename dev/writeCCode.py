@@ -179,16 +179,30 @@ def writeGetFunction(attrib, output, element):
     elif attType == 'boolean':
       output.write('\treturn ({0} != NULL) ? static_cast<int>({0}->get{1}()) : 0;\n'.format(varname, capAttName))
     output.write('}\n\n\n')
+    if attType == 'string':
+      # the same value borrowed from the object, without a copy to free
+      output.write('/**\n')
+      output.write(' * write comments\n')
+      output.write(' */\n')
+      output.write('LIBSEDML_EXTERN\n')
+      output.write('const char *\n')
+      output.write('{0}_get{1}View'.format(element, capAttName))
+      output.write('(const {0}_t * {1})\n'.format(element, varname))
+      output.write('{\n')
+      output.write('\tif ({0} == NULL)\n'.format(varname))
+      output.write('\t\treturn NULL;\n\n')
+      output.write('\treturn {0}->get{1}().empty() ? NULL : {0}->get{1}().c_str();\n'.format(varname, capAttName))
+      output.write('}\n\n\n')
   elif attrib['type'] == 'element':
     if attrib['name'] == 'Math' or attrib['name'] == 'math':
       output.write('LIBSEDML_EXTERN\n')
-      output.write('ASTNode_t*\n')
+      output.write('const ASTNode_t*\n')
       output.write('{0}_get{1}'.format(element, capAttName))
-      output.write('({0}_t * {1})\n'.format(element, varname))
+      output.write('(const {0}_t * {1})\n'.format(element, varname))
       output.write('{\n')
       output.write('\tif ({0} == NULL)\n'.format(varname))
       output.write('\t\treturn NULL;\n\n')
-      output.write('\treturn (ASTNode_t*){0}->get{1}();\n'.format(varname, capAttName))
+      output.write('\treturn {0}->get{1}();\n'.format(varname, capAttName))
       output.write('}\n\n\n')
     else:
       output.write('LIBSEDML_EXTERN\n')
@@ -104,12 +104,17 @@ def writeGetFunction(attrib, output, element):
     output.write('{0}\n'.format(attTypeCode))
     output.write('{0}_get{1}'.format(element, capAttName))
     output.write('({0}_t * {1});\n\n\n'.format(element, strFunctions.objAbbrev(element)))
+    if attType == 'string':
+      output.write('LIBSEDML_EXTERN\n')
+      output.write('const char *\n')
+      output.write('{0}_get{1}View'.format(element, capAttName))
+      output.write('(const {0}_t * {1});\n\n\n'.format(element, strFunctions.objAbbrev(element)))
   elif attrib['type'] == 'element':
     if attrib['name'] == 'Math' or attrib['name'] == 'math':
       output.write('LIBSEDML_EXTERN\n')
-      output.write('ASTNode_t*\n')
+      output.write('const ASTNode_t*\n')
       output.write('{0}_getMath'.format(element))
-      output.write('({0}_t * {1});\n\n\n'.format(element, strFunctions.objAbbrev(element)))
+      output.write('(const {0}_t * {1});\n\n\n'.format(element, strFunctions.objAbbrev(element)))
     else:
       output.write('LIBSEDML_EXTERN\n')
       output.write('{0}_t*\n'.format(strFunctions.cap(attrib['element'])))
@@ -22,6 +22,7 @@ def writeIncludes(fileOut, element, pkg, hasMath=False):
   if hasMath == True:
     fileOut.write('#include <sbml/math/MathML.h>\n')
     fileOut.write('#include <sbml/math/ASTNode.h>\n')
+    fileOut.write('#include <sedml/SedMathCache.h>\n')
   fileOut.write('\n\n');
 #  fileOut.write('#if WIN32 && !defined(CYGWIN)\n')
 #  fileOut.write('\t#define isnan _isnan\n')
@@ -32,10 +33,23 @@ def writeIncludes(fileOut, element, pkg, hasMath=False):
   fileOut.write('LIBSEDML_CPP_NAMESPACE_BEGIN\n')
   fileOut.write('\n\n');
 
+def isSetFlagged(atttype):
+  return atttype == 'double' or atttype == 'int' or atttype == 'uint' or atttype == 'bool'
+
 # writes list of attributes
 def writeAttributes(attrs, output, constType=0, pkg=""):
+  # the packed isSet flags follow the last numeric or boolean attribute,
+  # as they are declared
+  last = -1
+  for i in range(0, len(attrs)):
+    if isSetFlagged(attrs[i]['type']):
+      last = i
   for i in range(0, len(attrs)):
     writeAtt(attrs[i]['type'], attrs[i]['name'], output, constType, pkg)
+    if i == last:
+      for j in range(0, len(attrs)):
+        if isSetFlagged(attrs[j]['type']):
+          output.write('\t, mIsSet{0} (false)\n'.format(strFunctions.cap(attrs[j]['name'])))
   output.write('\n')
 
 def writeAtt(atttype, name, output, constType, pkg):
@@ -53,23 +67,25 @@ def writeAtt(atttype, name, output, constType, pkg):
       output.write('{0}ns)\n'.format(pkg))
   elif atttype == 'double':
     output.write('\t, m{0} (numeric_limits<double>::quiet_NaN())\n'.format(strFunctions.cap(name)))
-    output.write('\t, mIsSet{0} (false)\n'.format(strFunctions.cap(name)))
   elif atttype == 'int' or atttype == 'uint':
     output.write('\t, m{0} (SEDML_INT_MAX)\n'.format(strFunctions.cap(name)))
-    output.write('\t, mIsSet{0} (false)\n'.format(strFunctions.cap(name)))
   elif atttype == 'bool':
     output.write('\t, m{0} (false)\n'.format(strFunctions.cap(name)))
-    output.write('\t, mIsSet{0} (false)\n'.format(strFunctions.cap(name)))
   else:
     output.write('\tFIX ME   {0};\n'.format(name))
 
 
-def writeCopyAttributes(attrs, output, tabs, name):
+def writeCopyAttributes(attrs, output, tabs, name, assign=False):
   for i in range(0, len(attrs)):
     attName = strFunctions.cap(attrs[i]['name'])
     atttype = attrs[i]['type']
+    # the copy constructor copies the lists in its initialiser list
+    if atttype == 'lo_element' and assign == False:
+      continue
     if atttype == 'element' and attName == 'Math':
-      output.write('{0}m{1}  = {2}.m{1} != NULL ? {2}.m{1}->deepCopy() : NULL;\n'.format(tabs, strFunctions.cap(attrs[i]['name']), name))
+      if assign == True:
+        output.write('{0}SedMathCache::release(m{1});\n'.format(tabs, attName))
+      output.write('{0}m{1}  = SedMathCache::acquire({2}.m{1});\n'.format(tabs, attName, name))
     else:
       output.write('{0}m{1}  = {2}.m{1};\n'.format(tabs, strFunctions.cap(attrs[i]['name']), name))
     if atttype == 'double' or atttype == 'int' or atttype == 'uint' or atttype == 'bool':
@@ -110,6 +126,9 @@ def writeConstructors(element, package, output, attrs, hasChildren=False, hasMat
   output.write(' * Copy constructor for {0}.\n */\n'.format(element))
   output.write('{0}::{0} (const {0}& orig)\n'.format(element, package, package.lower()))
   output.write('\t: {0}(orig)\n'.format(baseClass))
+  for i in range(0, len(attrs)):
+    if attrs[i]['type'] == 'lo_element':
+      output.write('\t, m{0} (orig.m{0})\n'.format(strFunctions.cap(attrs[i]['name'])))
   output.write('{\n')
   output.write('\tif (&orig == NULL)\n')
   output.write('\t{\n')
@@ -134,7 +153,7 @@ def writeConstructors(element, package, output, attrs, hasChildren=False, hasMat
   output.write('\telse if (&rhs != this)\n')
   output.write('\t{\n')
   output.write('\t\t{0}::operator=(rhs);\n'.format(baseClass))
-  writeCopyAttributes(attrs, output, '\t\t', 'rhs')
+  writeCopyAttributes(attrs, output, '\t\t', 'rhs', True)
   if hasChildren == True:
     output.write('\n\t\t// connect to child objects\n')
     output.write('\t\tconnectToChild();\n')
@@ -151,6 +170,8 @@ def writeConstructors(element, package, output, attrs, hasChildren=False, hasMat
   output.write(' * Destructor for {0}.\n */\n'.format(element))
   output.write('{0}::~{0} ()\n'.format(element))
   output.write('{\n')
+  if hasMath == True:
+    output.write('\tSedMathCache::release(mMath);\n')
   output.write('}\n\n\n')
 
 
@@ -180,7 +201,7 @@ def writeGetCode(attrib, output, element):
     output.write('{0}\n'.format(attTypeCode))
     output.write('{0}::create{1}()\n'.format(element, capAttName))
     output.write('{\n')
-    output.write('\tm{0} = new {1}();\n'.format(capAttName, attrib['element']))
+    output.write('\tm{0} = new (getArena()) {1}();\n'.format(capAttName, attrib['element']))
     output.write('\treturn m{0};\n'.format(capAttName))
     output.write('}\n\n\n')
 
@@ -230,9 +251,12 @@ def writeSetCode(attrib, output, element):
   output.write('int\n')
   output.write('{0}::set{1}({2} {3})\n'.format(element, capAttName, attTypeCode, attName))
   output.write('{\n')
+  output.write('\tmarkDirty();\n')
   if attType == 'string':
     if attName == 'id':
-      output.write('\treturn SyntaxChecker::checkAndSetSId({0}, m{1});\n'.format(attName, capAttName ))
+      output.write('\tint result = checkAndSetSId({0}, m{1});\n'.format(attName, capAttName ))
+      output.write('\tnotifyIdChanged();\n')
+      output.write('\treturn result;\n')
     else:
       output.write('\tif (&({0}) == NULL)\n'.format(attName))
       output.write('\t{\n\t\treturn LIBSEDML_INVALID_ATTRIBUTE_VALUE;\n\t}\n')
@@ -255,19 +279,27 @@ def writeSetCode(attrib, output, element):
     output.write('\t{\n\t\treturn LIBSEDML_OPERATION_SUCCESS;\n\t}\n')
     output.write('\telse if ({0} == NULL)\n'.format(attName))
     output.write('\t{\n')
-    output.write('\t\tdelete m{0};\n'.format(capAttName))
+    if attTypeCode == 'ASTNode*':
+      output.write('\t\tSedMathCache::release(m{0});\n'.format(capAttName))
+    else:
+      output.write('\t\tdelete m{0};\n'.format(capAttName))
     output.write('\t\tm{0} = NULL;\n'.format(capAttName))
     output.write('\t\treturn LIBSEDML_OPERATION_SUCCESS;\n\t}\n')
     if attTypeCode == 'ASTNode*':
       output.write('\telse if (!({0}->isWellFormedASTNode()))\n'.format(attName))
       output.write('\t{\n\t\treturn LIBSEDML_INVALID_OBJECT;\n\t}\n')
     output.write('\telse\n\t{\n')
+    if attTypeCode == 'ASTNode*':
+      # math is shared, so it is replaced rather than changed
+      output.write('\t\tconst ASTNode* shared = SedMathCache::intern({0}->deepCopy());\n'.format(attName))
+      output.write('\t\tSedMathCache::release(m{0});\n'.format(capAttName))
+      output.write('\t\tm{0} = shared;\n'.format(capAttName))
+      output.write('\t\treturn LIBSEDML_OPERATION_SUCCESS;\n\t}\n')
+      output.write('}\n\n\n')
+      return
     output.write('\t\tdelete m{0};\n'.format(capAttName))
     output.write('\t\tm{0} = ({1} != NULL) ?\n'.format(capAttName, attName))
-    if attTypeCode == 'ASTNode*':
-      output.write('\t\t\t{0}->deepCopy() : NULL;\n'.format(attName))
-    else:
-      output.write('\t\t\tstatic_cast<{0}*>({1}->clone()) : NULL;\n'.format(attrib['element'], attName))
+    output.write('\t\t\tstatic_cast<{0}*>({1}->clone()) : NULL;\n'.format(attrib['element'], attName))
     output.write('\t\tif (m{0} != NULL)\n'.format(capAttName))
     output.write('\t\t{\n')
     #if attTypeCode == 'ASTNode*':
@@ -297,8 +329,12 @@ def writeUnsetCode(attrib, output, element):
   output.write('int\n')
   output.write('{0}::unset{1}()\n'.format(element, capAttName))
   output.write('{\n')
+  output.write('\tmarkDirty();\n')
   if attType == 'string':
-    output.write('\tm{0}.erase();\n\n'.format(capAttName))
+    output.write('\tm{0}.erase();\n'.format(capAttName))
+    if attName == 'id':
+      output.write('\tnotifyIdChanged();\n')
+    output.write('\n')
     output.write('\tif (m{0}.empty() == true)\n'.format(capAttName))
     output.write('\t{\n\t\treturn LIBSEDML_OPERATION_SUCCESS;\n\t}\n')
     output.write('\telse\n\t{\n')
@@ -318,7 +354,10 @@ def writeUnsetCode(attrib, output, element):
     output.write('\tmIsSet{0} = false;\n'.format(capAttName))
     output.write('\treturn LIBSEDML_OPERATION_SUCCESS;\n')
   elif attType == 'element':
-    output.write('\tdelete m{0};\n'.format(capAttName))
+    if attTypeCode == 'ASTNode*':
+      output.write('\tSedMathCache::release(m{0});\n'.format(capAttName))
+    else:
+      output.write('\tdelete m{0};\n'.format(capAttName))
     output.write('\tm{0} = NULL;\n'.format(capAttName))
     output.write('\treturn LIBSEDML_OPERATION_SUCCESS;\n')
   output.write('}\n\n\n')
@@ -375,10 +414,19 @@ def writeListOfSubFunctions(attrib, output, element):
   output.write('int\n')
   output.write('{0}::add{1}(const {2}* {3})\n'.format(element, strFunctions.cap(attrib['name']), attrib['element'], strFunctions.objAbbrev(attrib['element'])))
   output.write('{\n')
-  output.write('\tif({0} == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;\n'.format(strFunctions.objAbbrev(attrib['element'])))
+  output.write('\tif({0} == NULL) return LIBSEDML_INVALID_OBJECT;\n'.format(strFunctions.objAbbrev(attrib['element'])))
   output.write('\tm{0}.append({1});\n'.format(strFunctions.cap(attrib['name']),strFunctions.objAbbrev(attrib['element'])))
   output.write('\treturn LIBSEDML_OPERATION_SUCCESS;\n')
   output.write('}\n\n\n')
+  output.write('/*\n')
+  output.write(' * Adds the given {0} to this {1}, which takes ownership of it.\n'.format(attrib['element'], element))
+  output.write(' */\n')
+  output.write('int\n')
+  output.write('{0}::add{1}AndOwn({2}* {3})\n'.format(element, strFunctions.cap(attrib['name']), attrib['element'], strFunctions.objAbbrev(attrib['element'])))
+  output.write('{\n')
+  output.write('\tif({0} == NULL) return LIBSEDML_INVALID_OBJECT;\n'.format(strFunctions.objAbbrev(attrib['element'])))
+  output.write('\treturn m{0}.appendAndOwn({1});\n'.format(strFunctions.cap(attrib['name']),strFunctions.objAbbrev(attrib['element'])))
+  output.write('}\n\n\n')
   output.write('/**\n')
   output.write(' * Get the number of {0} objects in this {1}.\n'.format(attrib['element'], element))
   output.write(' *\n')
@@ -401,7 +449,7 @@ def writeListOfSubFunctions(attrib, output, element):
     output.write('{0}* \n'.format(attrib['element']))
     output.write('{0}::create{1}()\n'.format(element, strFunctions.cap(attrib['name'])))
     output.write('{\n')
-    output.write('\t{0} *temp = new {0}();\n'.format(attrib['element']))
+    output.write('\t{0} *temp = new (getArena()) {0}();\n'.format(attrib['element']))
     output.write('\tif (temp != NULL) m{0}.appendAndOwn(temp);\n'.format(strFunctions.cap(attrib['name'])))
     output.write('\treturn temp;\n')
     output.write('}\n\n')
@@ -418,7 +466,7 @@ def writeListOfSubFunctions(attrib, output, element):
       output.write('{0}* \n'.format(elem['element']))
       output.write('{0}::create{1}()\n'.format(element, strFunctions.cap(elem['name'])))
       output.write('{\n')
-      output.write('\t{0} *temp = new {0}();\n'.format(elem['element']))
+      output.write('\t{0} *temp = new (getArena()) {0}();\n'.format(elem['element']))
       output.write('\tif (temp != NULL) m{0}.appendAndOwn(temp);\n'.format(strFunctions.cap(attrib['name'])))
       output.write('\treturn temp;\n')
       output.write('}\n\n')
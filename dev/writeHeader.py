@@ -76,11 +76,17 @@ def writeAtt(attrib, output):
   attType = att[2]
   attTypeCode = att[3]
   num = att[4]
-  if attType == 'string':
+  if attType == 'string' and attName == 'name' and attrib['reqd'] == False:
+    # most elements have no name, which then costs a pointer only
+    output.write('\tSedOptionalString   m{0};\n'.format(capAttName))
+  elif attType == 'string' and attrib['type'] in ('SId', 'SIdRef'):
+    # ids and references share one interned copy of their text
+    output.write('\tSedSymbol   m{0};\n'.format(capAttName))
+  elif attType == 'string':
     output.write('\tstd::string   m{0};\n'.format(capAttName))
   elif attType == 'element':    
     if attTypeCode == 'ASTNode*' or attName== 'Math':
-      output.write('\tASTNode*      m{0};\n'.format(capAttName))
+      output.write('\tconst ASTNode* m{0};\n'.format(capAttName))
     else:
       output.write('\t{0}*      m{1};\n'.format(attrib['element'], capAttName))
       return
@@ -90,10 +96,8 @@ def writeAtt(attrib, output):
     while len(attTypeCode) < 13:
       attTypeCode = attTypeCode + ' '
     output.write('\t{1} m{0};\n'.format(capAttName, attTypeCode))
-    output.write('\tbool          mIsSet{0};\n'.format(capAttName))
   elif attType == 'boolean':
     output.write('\tbool          m{0};\n'.format(capAttName))
-    output.write('\tbool          mIsSet{0};\n'.format(capAttName))
   else:
     output.write('\tFIX ME   {0};\n'.format(attName))
 
@@ -104,10 +108,25 @@ def writeAdditionalIncludes (attrs, output, elementDict):
     writeInclude(attrs[i], output)  
   output.write('\n\n')
 
+def writeIsSetFlags(attrs, output):
+  # the isSet flags of all numeric and boolean attributes are packed into
+  # bits, next to the last of them
+  for i in range(0, len(attrs)):
+    att = generalFunctions.parseAttribute(attrs[i])
+    if att[4] == True or att[2] == 'boolean':
+      output.write('\tbool          mIsSet{0} : 1;\n'.format(att[1]))
+
 def writeAttributes(attrs, output):
   output.write('protected:\n\n')
+  last = -1
+  for i in range(0, len(attrs)):
+    att = generalFunctions.parseAttribute(attrs[i])
+    if att[4] == True or att[2] == 'boolean':
+      last = i
   for i in range(0, len(attrs)):
     writeAtt(attrs[i], output)  
+    if i == last:
+      writeIsSetFlags(attrs, output)
   output.write('\n\n')
 
 def writeGetFunction(attrib, output, element):
@@ -307,6 +326,21 @@ def writeListOfSubFunctions(attrib, output, element, elementDict):
   output.write('\t */\n')
   output.write('\tint add{0}(const {1}* {2});\n\n\n'.format(strFunctions.cap(attrib['name']), attrib['element'], strFunctions.objAbbrev(attrib['element'])))
   output.write('\t/**\n')
+  output.write('\t * Adds the given \"{0}\" to this {1} without copying it;\n'.format(attrib['element'], element))
+  output.write('\t * this {0} takes ownership of @p {1} and will delete it.\n'.format(element, strFunctions.objAbbrev(attrib['element'])))
+  output.write('\t *\n')
+  output.write('\t * @param {0} the {1} object to add.\n'.format(strFunctions.objAbbrev(attrib['element']), attrib['element']))
+  output.write('\t *\n')
+  output.write('\t * @return integer value indicating success/failure of the\n')
+  output.write('\t * function.  @if clike The value is drawn from the\n')
+  output.write('\t * enumeration #OperationReturnValues_t. @endif The possible values\n')
+  output.write('\t * returned by this function are:\n')
+  output.write('\t * @li LIBSEDML_OPERATION_SUCCESS\n')
+  output.write('\t * @li LIBSEDML_INVALID_OBJECT if @p {0} is @c NULL, already has a parent\n'.format(strFunctions.objAbbrev(attrib['element'])))
+  output.write('\t * or cannot be added, in which case the caller still owns it\n')
+  output.write('\t */\n')
+  output.write('\tint add{0}AndOwn({1}* {2});\n\n\n'.format(strFunctions.cap(attrib['name']), attrib['element'], strFunctions.objAbbrev(attrib['element'])))
+  output.write('\t/**\n')
   output.write('\t * Get the number of {0} objects in this {1}.\n'.format(attrib['element'], element))
   output.write('\t *\n')
   output.write('\t * @return the number of {0} objects in this {1}\n'.format(attrib['element'], element))
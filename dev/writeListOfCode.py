@@ -109,9 +109,7 @@ def writeGetFunctions(output, element, type, subelement=False, topelement="", na
     output.write('const {0}*\n'.format(type))
     output.write('{0}::get(const std::string& sid) const\n'.format(listOf))
     output.write('{\n' )
-    output.write('\tvector<SedBase*>::const_iterator result;\n\n')
-    output.write('\tresult = find_if( mItems.begin(), mItems.end(), IdEq<{0}>(sid) );\n'.format(type))
-    output.write('\treturn (result == mItems.end()) ? 0 : static_cast <{0}*> (*result);\n'.format(type))
+    output.write('\treturn static_cast <const {0}*> (getItemById(sid));\n'.format(type))
     output.write('}\n\n\n')
      
 def writeRemoveFunctions(output, element, type, subelement=False, topelement="", name=""):
@@ -146,13 +144,7 @@ def writeRemoveFunctions(output, element, type, subelement=False, topelement="",
     output.write(' */\n')
     output.write('{0}*\n{1}::remove(const std::string& sid)\n'.format(type, listOf))
     output.write('{\n' )
-    output.write('\tSedBase* item = NULL;\n')
-    output.write('\tvector<SedBase*>::iterator result;\n\n')
-    output.write('\tresult = find_if( mItems.begin(), mItems.end(), IdEq<{0}>(sid) );\n\n'.format(type))
-    output.write('\tif (result != mItems.end())\n\t{\n')
-    output.write('\t\titem = *result;\n')
-    output.write('\t\tmItems.erase(result);\n\t}\n\n')
-    output.write('\treturn static_cast <{0}*> (item);\n'.format(type))
+    output.write('\treturn static_cast <{0}*> (removeItemById(sid));\n'.format(type))
     output.write('}\n\n\n')
      
   
@@ -174,16 +166,16 @@ def writeProtectedFunctions(output, element, package, name, elementDict):
   output.write('\tconst std::string& name   = stream.peek().getName();\n')
   output.write('\tSedBase* object = NULL;\n\n')
   if elementDict == None or elementDict.has_key('abstract') == False or (elementDict.has_key('abstract') and elementDict['abstract'] == False):
-    output.write('\tif (name == "{0}")\n'.format(name))
-    output.write('\t{\n')
-    output.write('\t\tobject = new {0}(getSedNamespaces());\n'.format(element))
-    output.write('\t\tappendAndOwn(object);\n\t}\n\n')
+    generalFunctions.writeNameDispatch(output, [(name,
+      ['object = new (getArena()) {0}(getSedNamespaces());'.format(element),
+       'appendAndOwn(object);'])])
   elif elementDict != None and elementDict.has_key('concrete'):
+    cases = []
     for elem in elementDict['concrete']:
-      output.write('\tif (name == "{0}")\n'.format(elem['name']))
-      output.write('\t{\n')
-      output.write('\t\tobject = new {0}(getSedNamespaces());\n'.format(elem['element']))
-      output.write('\t\tappendAndOwn(object);\n\t}\n\n')
+      cases.append((elem['name'],
+        ['object = new (getArena()) {0}(getSedNamespaces());'.format(elem['element']),
+         'appendAndOwn(object);']))
+    generalFunctions.writeNameDispatch(output, cases)
   output.write('\treturn object;\n')
   output.write('}\n\n\n')
   generalFunctions.writeInternalEnd(output)
@@ -197,7 +189,8 @@ def writeProtectedFunctions(output, element, package, name, elementDict):
   output.write('\tstd::string prefix = getPrefix();\n\n')
   output.write('\tif (prefix.empty())\n')
   output.write('\t{\n')
-  output.write('\t\tif (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))\n')
+  output.write('\t\tif (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)\n')
+  output.write('\t\t    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))\n')
   output.write('\t\t{\n')
   output.write('\t\t\txmlns.add(SEDML_XMLNS_L1,prefix);\n')
   output.write('\t\t}\n')
@@ -233,10 +226,19 @@ def createCode(element, code):
   code.write('int\n')
   code.write('{0}::add{1}(const {2}* {3})\n'.format(listOf, strFunctions.cap(name), type, strFunctions.objAbbrev(type)))
   code.write('{\n')
-  code.write('\tif({0} == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;\n'.format(strFunctions.objAbbrev(type)))
+  code.write('\tif({0} == NULL) return LIBSEDML_INVALID_OBJECT;\n'.format(strFunctions.objAbbrev(type)))
   code.write('\tappend({0});\n'.format(strFunctions.objAbbrev(type)))
   code.write('\treturn LIBSEDML_OPERATION_SUCCESS;\n')
   code.write('}\n\n\n')
+  code.write('/*\n')
+  code.write(' * Adds the given {0} to this {1}, which takes ownership of it.\n'.format(type, listOf))
+  code.write(' */\n')
+  code.write('int\n')
+  code.write('{0}::add{1}AndOwn({2}* {3})\n'.format(listOf, strFunctions.cap(name), type, strFunctions.objAbbrev(type)))
+  code.write('{\n')
+  code.write('\tif({0} == NULL) return LIBSEDML_INVALID_OBJECT;\n'.format(strFunctions.objAbbrev(type)))
+  code.write('\treturn appendAndOwn({0});\n'.format(strFunctions.objAbbrev(type)))
+  code.write('}\n\n\n')
   code.write('/**\n')
   code.write(' * Get the number of {0} objects in this {1}.\n'.format(type, listOf))
   code.write(' *\n')
@@ -259,7 +261,7 @@ def createCode(element, code):
     code.write('{0}* \n'.format(type))
     code.write('{0}::create{1}()\n'.format(listOf, strFunctions.cap(name)))
     code.write('{\n')
-    code.write('\t{0} *temp = new {0}();\n'.format(type))
+    code.write('\t{0} *temp = new (getArena()) {0}();\n'.format(type))
     code.write('\tif (temp != NULL) appendAndOwn(temp);\n')
     code.write('\treturn temp;\n')
     code.write('}\n\n')
@@ -276,7 +278,7 @@ def createCode(element, code):
       code.write('{0}* \n'.format(elem['element']))
       code.write('{0}::create{1}()\n'.format(listOf, strFunctions.cap(elem['name'])))
       code.write('{\n')
-      code.write('\t{0} *temp = new {0}();\n'.format(elem['element']))
+      code.write('\t{0} *temp = new (getArena()) {0}();\n'.format(elem['element']))
       code.write('\tif (temp != NULL) appendAndOwn(temp);\n')
       code.write('\treturn temp;\n')
       code.write('}\n\n')
@@ -209,6 +209,21 @@ def writeClass(header, nameOfElement, typeOfElement, nameOfPackage, elementDict)
   header.write('\t */\n')
   header.write('\tint add{0}(const {1}* {2});\n\n\n'.format(nameOfElement, typeOfElement, strFunctions.objAbbrev(nameOfElement)))
   header.write('\t/**\n')
+  header.write('\t * Adds the given \"{0}\" to this {1} without copying it;\n'.format(typeOfElement, generalFunctions.writeListOf(nameOfElement)))
+  header.write('\t * this {0} takes ownership of @p {1} and will delete it.\n'.format(generalFunctions.writeListOf(nameOfElement), strFunctions.objAbbrev(nameOfElement)))
+  header.write('\t *\n')
+  header.write('\t * @param {0} the {1} object to add.\n'.format(strFunctions.objAbbrev(nameOfElement), typeOfElement))
+  header.write('\t *\n')
+  header.write('\t * @return integer value indicating success/failure of the\n')
+  header.write('\t * function.  @if clike The value is drawn from the\n')
+  header.write('\t * enumeration #OperationReturnValues_t. @endif The possible values\n')
+  header.write('\t * returned by this function are:\n')
+  header.write('\t * @li LIBSEDML_OPERATION_SUCCESS\n')
+  header.write('\t * @li LIBSEDML_INVALID_OBJECT if @p {0} is @c NULL, already has a parent\n'.format(strFunctions.objAbbrev(nameOfElement)))
+  header.write('\t * or cannot be added, in which case the caller still owns it\n')
+  header.write('\t */\n')
+  header.write('\tint add{0}AndOwn({1}* {2});\n\n\n'.format(nameOfElement, typeOfElement, strFunctions.objAbbrev(nameOfElement)))
+  header.write('\t/**\n')
   header.write('\t * Get the number of {0} objects in this {1}.\n'.format(nameOfElement, generalFunctions.writeListOf(nameOfElement)))
   header.write('\t *\n')
   header.write('\t * @return the number of {0} objects in this {1}\n'.format(nameOfElement, generalFunctions.writeListOf(nameOfElement)))
@@ -0,0 +1,276 @@
+#!/usr/bin/env python
+#
+# @file   writeTypeTraits.py
+# @brief  Create SedTypeTraits.h from the element descriptions
+#
+
+import sys
+import generalFunctions
+
+
+def isDerivedFrom(element, base, elements):
+  while element.has_key('baseClass'):
+    if element['baseClass'] == base:
+      return True
+    parent = None
+    for e in elements:
+      if e['name'] == element['baseClass']:
+        parent = e
+    if parent == None:
+      return False
+    element = parent
+  return False
+
+
+def getDerivedCodes(base, elements):
+  codes = []
+  for element in elements:
+    if isDerivedFrom(element, base['name'], elements):
+      codes.append(element['typecode'])
+  return codes
+
+
+def writeBaseTraits(output, element, codes):
+  output.write('template <> struct SedTypeTraits<{0}>\n'.format(element['name']))
+  output.write('{\n')
+  output.write('  enum {{ typeCode = {0} }};\n'.format(element['typecode']))
+  output.write('  static bool is (const SedBase* x)\n')
+  output.write('  {\n')
+  output.write('    if (x == NULL) return false;\n')
+  output.write('    const int tc = x->getTypeCode();\n')
+  output.write('    return tc == {0}'.format(element['typecode']))
+  for code in codes:
+    output.write('\n        || tc == {0}'.format(code))
+  output.write(';\n')
+  output.write('  }\n')
+  output.write('};\n\n\n')
+
+
+def createTypeTraits(elements):
+  output = open('SedTypeTraits.h', 'w')
+  output.write(PREAMBLE)
+  output.write('#include <sedml/SedBase.h>\n')
+  output.write('#include <sedml/SedListOf.h>\n')
+  for element in elements:
+    output.write('#include <sedml/{0}.h>\n'.format(element['name']))
+  output.write(MIDDLE)
+  # base classes accept the type codes of the classes derived from them
+  for element in elements:
+    codes = getDerivedCodes(element, elements)
+    if len(codes) > 0:
+      writeBaseTraits(output, element, codes)
+  for element in elements:
+    if len(getDerivedCodes(element, elements)) == 0:
+      name = '{0},'.format(element['name'])
+      output.write('SEDML_TYPE_TRAITS({0:<21} {1})\n'.format(name, element['typecode']))
+  output.write('\n')
+  for element in elements:
+    if element['hasSedListOf'] == True:
+      name = '{0},'.format(generalFunctions.writeListOf(element['name'][3:]))
+      output.write('SEDML_LIST_TYPE_TRAITS({0:<25} {1})\n'.format(name, element['typecode']))
+  output.write('\n')
+  output.write(TAIL_START)
+  for element in elements:
+    output.write('  case {0}:\n'.format(element['typecode']))
+    output.write('    return f(static_cast<const {0}&>(x));\n'.format(element['name']))
+  output.write(TAIL_END)
+  output.close()
+
+
+PREAMBLE = r'''/**
+ * @file    SedTypeTraits.h
+ * @brief   Compile-time type codes and checked downcasts for Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTypeTraits
+ * @ingroup Core
+ * @brief Maps each Sed class to its type code at compile time.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedTypeTraits<T>::typeCode is the type code (see #SedTypeCode_t) of
+ * the objects of class @p T, and SedTypeTraits<T>::is() tells whether an
+ * object is a @p T, comparing type codes rather than using run-time type
+ * information.  For a base class such as SedChange, SedOutput,
+ * SedSimulation or SedCurve, is() accepts the type codes of the derived
+ * classes as well; the lists are told apart by the type code of their
+ * items (see SedListOf::getItemTypeCode()).  Classes that are not Sed
+ * objects have no SedTypeTraits, so using them is a compile error.
+ *
+ * sedml_cast<T>() builds on it: it returns its argument as a @p T, or
+ * @c NULL if it is not one, like @c dynamic_cast but with a virtual call
+ * and a comparison:
+ *
+ * @code{.cpp}
+if (const SedTask* task = sedml_cast<SedTask>(element))
+{
+  ...
+}
+@endcode
+ *
+ * sedml_visitByType() calls the overload of a function object for the
+ * concrete class of an object, through one switch on its type code, which
+ * compilers turn into a jump table:
+ *
+ * @code{.cpp}
+struct CountTasks
+{
+  unsigned int count;
+  template <class T> void operator() (const T&) { }
+  void operator() (const SedTask&) { ++count; }
+};
+
+CountTasks counter = { 0 };
+sedml_visitByType(*element, counter);
+@endcode
+ */
+
+#ifndef SedTypeTraits_h
+#define SedTypeTraits_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedTypeCodes.h>
+
+
+#ifdef __cplusplus
+
+
+'''
+
+MIDDLE = r'''
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+template <class T> struct SedTypeTraits;
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Traits of a class whose objects all have the one type code CODE.
+ */
+#define SEDML_TYPE_TRAITS(CLASS, CODE)                                 \
+template <> struct SedTypeTraits<CLASS>                                \
+{                                                                      \
+  enum { typeCode = CODE };                                            \
+  static bool is (const SedBase* x)                                    \
+  { return x != NULL && x->getTypeCode() == CODE; }                    \
+};
+
+/*
+ * Traits of a list class, whose items have the type code ITEM.
+ */
+#define SEDML_LIST_TYPE_TRAITS(CLASS, ITEM)                            \
+template <> struct SedTypeTraits<CLASS>                                \
+{                                                                      \
+  enum { typeCode = SEDML_LIST_OF, itemTypeCode = ITEM };              \
+  static bool is (const SedBase* x)                                    \
+  {                                                                    \
+    return x != NULL && x->getTypeCode() == SEDML_LIST_OF              \
+      && static_cast<const SedListOf*>(x)->getItemTypeCode() == ITEM;  \
+  }                                                                    \
+};
+
+/** @endcond */
+
+
+template <> struct SedTypeTraits<SedBase>
+{
+  enum { typeCode = SEDML_UNKNOWN };
+  static bool is (const SedBase* x) { return x != NULL; }
+};
+
+
+template <> struct SedTypeTraits<SedListOf>
+{
+  enum { typeCode = SEDML_LIST_OF };
+  static bool is (const SedBase* x)
+  { return x != NULL && x->getTypeCode() == SEDML_LIST_OF; }
+};
+
+
+'''
+
+TAIL_START = r'''#undef SEDML_TYPE_TRAITS
+#undef SEDML_LIST_TYPE_TRAITS
+
+
+/**
+ * Returns @p x as a @p T, or @c NULL if it is not one.
+ */
+template <class T>
+inline T*
+sedml_cast (SedBase* x)
+{
+  return SedTypeTraits<T>::is(x) ? static_cast<T*>(x) : NULL;
+}
+
+
+/**
+ * Returns @p x as a @p T, or @c NULL if it is not one.
+ */
+template <class T>
+inline const T*
+sedml_cast (const SedBase* x)
+{
+  return SedTypeTraits<T>::is(x) ? static_cast<const T*>(x) : NULL;
+}
+
+
+/**
+ * Calls @p f with @p x as an object of its concrete class, chosen by its
+ * type code.  Lists are passed as SedListOf, and objects of unknown type
+ * codes as SedBase.
+ *
+ * @return what @p f returns.
+ */
+template <class R, class F>
+inline R
+sedml_visitByType (const SedBase& x, F& f)
+{
+  switch (x.getTypeCode())
+  {
+'''
+
+TAIL_END = r'''  case SEDML_LIST_OF:
+    return f(static_cast<const SedListOf&>(x));
+  default:
+    return f(x);
+  }
+}
+
+
+/**
+ * Calls @p f with @p x as an object of its concrete class, chosen by its
+ * type code, for function objects returning nothing.
+ */
+template <class F>
+inline void
+sedml_visitByType (const SedBase& x, F& f)
+{
+  sedml_visitByType<void>(x, f);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTypeTraits_h */
+'''
@@ -0,0 +1,102 @@
+/**
+ * @file    compare_sedml_results.cpp
+ * @brief   Compares reports against reference reports.
+ * @author  Frank T. Bergmann
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann  
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met: 
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer. 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sedml/SedTypes.h>
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+int
+main (int argc, char* argv[])
+{
+  SedResultsComparison comparison;
+
+  int first = 1;
+  for (; first + 1 < argc && argv[first][0] == '-'; first += 2)
+  {
+    const string option = argv[first];
+    const double value = atof(argv[first + 1]);
+    if (option == "-a")
+    {
+      comparison.setAbsoluteTolerance(value);
+    }
+    else if (option == "-r")
+    {
+      comparison.setRelativeTolerance(value);
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if (argc - first < 2 || (argc - first) % 2 != 0)
+  {
+    cout << endl << "Usage: compare_sedml_results [-a absolute-tolerance]"
+         << " [-r relative-tolerance]" << endl
+         << "         expected.csv actual.csv [expected.csv actual.csv ...]"
+         << endl << endl;
+    return 2;
+  }
+
+  // every pair of reports is compared; the exit code says whether all
+  // of them matched
+  int numFailed = 0;
+  int numErrors = 0;
+  for (int i = first; i + 1 < argc; i += 2)
+  {
+    const int result = comparison.compareReports(argv[i], argv[i + 1]);
+    if (result == LIBSEDML_OPERATION_SUCCESS) continue;
+
+    if (result == LIBSEDML_INVALID_OBJECT)
+    {
+      cout << argv[i + 1] << ": cannot be read" << endl;
+      ++numErrors;
+    }
+    else
+    {
+      cout << argv[i + 1] << ":" << endl << comparison.getSummary();
+      ++numFailed;
+    }
+  }
+
+  cout << (argc - first) / 2 << " reports compared, " << numFailed
+       << " differ, " << numErrors << " unreadable" << endl;
+
+  return (numErrors > 0) ? 2 : (numFailed > 0) ? 1 : 0;
+}
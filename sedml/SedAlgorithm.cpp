@@ -35,6 +35,7 @@
 
 #include <sedml/SedAlgorithm.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedKisao.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -50,6 +51,7 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 SedAlgorithm::SedAlgorithm (unsigned int level, unsigned int version)
 	: SedBase(level, version)
 	, mKisaoID ("")
+	, mKisaoIndex (SED_KISAO_UNKNOWN)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -63,6 +65,7 @@ SedAlgorithm::SedAlgorithm (unsigned int level, unsigned int version)
 SedAlgorithm::SedAlgorithm (SedNamespaces* sedns)
 	: SedBase(sedns)
 	, mKisaoID ("")
+	, mKisaoIndex (SED_KISAO_UNKNOWN)
 
 {
 	// set the element namespace of this object
@@ -83,6 +86,7 @@ SedAlgorithm::SedAlgorithm (const SedAlgorithm& orig)
 	else
 	{
 		mKisaoID  = orig.mKisaoID;
+		mKisaoIndex  = orig.mKisaoIndex;
 	}
 }
 
@@ -101,6 +105,7 @@ SedAlgorithm::operator=(const SedAlgorithm& rhs)
 	{
 		SedBase::operator=(rhs);
 		mKisaoID  = rhs.mKisaoID;
+		mKisaoIndex  = rhs.mKisaoIndex;
 	}
 	return *this;
 }
@@ -150,6 +155,8 @@ SedAlgorithm::isSetKisaoID() const
 int
 SedAlgorithm::setKisaoID(const std::string& kisaoID)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(kisaoID) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -157,6 +164,7 @@ SedAlgorithm::setKisaoID(const std::string& kisaoID)
 	else
 	{
 		mKisaoID = kisaoID;
+		mKisaoIndex = SedKisao::getIndex(mKisaoID);
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -168,7 +176,10 @@ SedAlgorithm::setKisaoID(const std::string& kisaoID)
 int
 SedAlgorithm::unsetKisaoID()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mKisaoID.erase();
+	mKisaoIndex = SED_KISAO_UNKNOWN;
 
 	if (mKisaoID.empty() == true)
 	{
@@ -181,14 +192,36 @@ SedAlgorithm::unsetKisaoID()
 }
 
 
+/*
+ * Returns the registry index of kisaoID.
+ */
+int
+SedAlgorithm::getKisaoIndex() const
+{
+	return mKisaoIndex;
+}
+
+
+/*
+ * Returns true if the algorithm has all of the capabilities flags.
+ */
+bool
+SedAlgorithm::hasKisaoCapabilities(unsigned int flags) const
+{
+	return SedKisao::hasCapabilities(mKisaoIndex, flags);
+}
+
+
+static const std::string sSedAlgorithmName("algorithm");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedAlgorithm::getElementName () const
 {
-	static const string name = "algorithm";
-	return name;
+	return sSedAlgorithmName;
 }
 
 
@@ -235,13 +268,12 @@ SedAlgorithm::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedAlgorithm::accept (SedVisitor& v) const
+SedAlgorithm::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -293,10 +325,19 @@ SedAlgorithm::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "kisaoID", 0xfe8d185bu }
+	};
+	int index[1];
+	findAttributes(attributes, names, 1, index);
+
 	//
 	// kisaoID string   ( use = "required" )
 	//
-	assigned = attributes.readInto("kisaoID", mKisaoID, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "kisaoID", mKisaoID, true);
+	mKisaoIndex = SedKisao::getIndex(mKisaoID);
 
 	if (assigned == true)
 	{
@@ -314,6 +355,9 @@ SedAlgorithm::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sKisaoIDAttribute("kisaoID");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -324,8 +368,27 @@ SedAlgorithm::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetKisaoID() == true)
-		stream.writeAttribute("kisaoID", getPrefix(), mKisaoID);
+		stream.writeAttribute(sKisaoIDAttribute, prefix, mKisaoID);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedAlgorithm::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetKisaoID() == true)
+		addAttribute(attributes, sKisaoIDAttribute, prefix, mKisaoID);
 
 }
 
@@ -388,6 +451,20 @@ SedAlgorithm_getKisaoID(SedAlgorithm_t * sa)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedAlgorithm_getKisaoIDView(const SedAlgorithm_t * sa)
+{
+	if (sa == NULL)
+		return NULL;
+
+	return sa->getKisaoID().empty() ? NULL : sa->getKisaoID().c_str();
+}
+
+
 /**
  * write comments
  */
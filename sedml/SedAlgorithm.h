@@ -63,6 +63,7 @@ class LIBSEDML_EXTERN SedAlgorithm : public SedBase
 protected:
 
 	std::string   mKisaoID;
+	int           mKisaoIndex;
 
 
 public:
@@ -165,6 +166,31 @@ public:
 	virtual int unsetKisaoID();
 
 
+	/**
+	 * Returns the index of the "kisaoID" attribute of this SedAlgorithm in
+	 * the built-in registry of KiSAO algorithms, looked up when it is set.
+	 *
+	 * @return the #SedKisaoAlgorithm_t of the algorithm, or
+	 * #SED_KISAO_UNKNOWN if it is not set or not in the registry.
+	 *
+	 * @see SedKisao
+	 */
+	int getKisaoIndex() const;
+
+
+	/**
+	 * Predicate returning @c true if the algorithm of this SedAlgorithm is
+	 * in the built-in registry of KiSAO algorithms and has all of the
+	 * #SedKisaoCapability_t @p flags, such as #SED_KISAO_STOCHASTIC.
+	 *
+	 * @param flags; the capabilities or-ed together
+	 *
+	 * @return @c true if the algorithm has all capabilities, otherwise
+	 * @c false is returned.
+	 */
+	bool hasKisaoCapabilities(unsigned int flags) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedAlgorithm, is
 	 * always @c "sedAlgorithm".
@@ -236,9 +262,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -288,6 +314,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -325,6 +358,11 @@ char *
 SedAlgorithm_getKisaoID(SedAlgorithm_t * sa);
 
 
+LIBSEDML_EXTERN
+const char *
+SedAlgorithm_getKisaoIDView(const SedAlgorithm_t * sa);
+
+
 LIBSEDML_EXTERN
 int
 SedAlgorithm_isSetKisaoID(SedAlgorithm_t * sa);
@@ -0,0 +1,479 @@
+/**
+ * @file    SedAnnotationIndex.cpp
+ * @brief   Index of the RDF annotations of SED-ML documents
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedAnnotationIndex.h>
+#include <sedml/SedDocument.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const char* const RDF_NS =
+  "http://www.w3.org/1999/02/22-rdf-syntax-ns#";
+static const char* const BQBIOL_NS =
+  "http://biomodels.net/biology-qualifiers/";
+static const char* const BQMODEL_NS =
+  "http://biomodels.net/model-qualifiers/";
+
+
+/*
+ * Returns the name a qualifier element is indexed under.
+ */
+static std::string
+getQualifierName (const XMLNode& qualifier)
+{
+  const std::string& uri = qualifier.getURI();
+  if (uri == BQBIOL_NS)  return "bqbiol:" + qualifier.getName();
+  if (uri == BQMODEL_NS) return "bqmodel:" + qualifier.getName();
+  return uri + qualifier.getName();
+}
+
+
+/*
+ * Appends the rdf:resource attributes of node and everything below it to
+ * resources.
+ */
+static void
+collectResources (const XMLNode& node, std::vector<std::string>& resources)
+{
+  if (!node.isElement()) return;
+
+  const std::string resource = node.getAttrValue("resource", RDF_NS);
+  if (!resource.empty()) resources.push_back(resource);
+
+  for (unsigned int i = 0; i < node.getNumChildren(); i++)
+  {
+    collectResources(node.getChild(i), resources);
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedAnnotationIndex.
+ */
+SedAnnotationIndex::SedAnnotationIndex ()
+  : mNumIndexed (0)
+{
+}
+
+
+/*
+ * Destroys this SedAnnotationIndex.
+ */
+SedAnnotationIndex::~SedAnnotationIndex ()
+{
+}
+
+
+/*
+ * Adds the annotations of document to this index.
+ */
+int
+SedAnnotationIndex::addDocument (const SedDocument* document)
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mDocuments.push_back(document);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Removes all documents and statements from this index.
+ */
+void
+SedAnnotationIndex::clear ()
+{
+  mDocuments.clear();
+  mNumIndexed = 0;
+  mStrings.clear();
+  mStringIds.clear();
+  mStatements.clear();
+  mByQualifiedResource.clear();
+  mByResource.clear();
+  mByQualifiedMetaId.clear();
+  mByMetaId.clear();
+}
+
+
+/*
+ * Returns the number of statements in this index.
+ */
+unsigned int
+SedAnnotationIndex::getNumStatements ()
+{
+  update();
+  return (unsigned int)mStatements.size();
+}
+
+
+/*
+ * Returns the number of elements annotated with qualifier pointing to
+ * resource.
+ */
+unsigned int
+SedAnnotationIndex::getNumElements (const std::string& qualifier,
+                                    const std::string& resource)
+{
+  const StatementList* list = findByResource(qualifier, resource);
+  return (list != NULL) ? (unsigned int)list->size() : 0;
+}
+
+
+/*
+ * Returns the n-th element annotated with qualifier pointing to resource.
+ */
+const SedBase*
+SedAnnotationIndex::getElement (const std::string& qualifier,
+                                const std::string& resource,
+                                unsigned int n)
+{
+  const StatementList* list = findByResource(qualifier, resource);
+  if (list == NULL || n >= list->size()) return NULL;
+
+  return mStatements[(*list)[n]].element;
+}
+
+
+/*
+ * Returns the document of the n-th element annotated with qualifier
+ * pointing to resource.
+ */
+const SedDocument*
+SedAnnotationIndex::getDocument (const std::string& qualifier,
+                                 const std::string& resource,
+                                 unsigned int n)
+{
+  const StatementList* list = findByResource(qualifier, resource);
+  if (list == NULL || n >= list->size()) return NULL;
+
+  return mStatements[(*list)[n]].document;
+}
+
+
+/*
+ * Returns the number of resources the element with metaid points to with
+ * qualifier.
+ */
+unsigned int
+SedAnnotationIndex::getNumResources (const std::string& metaid,
+                                     const std::string& qualifier)
+{
+  const StatementList* list = findByMetaId(metaid, qualifier);
+  return (list != NULL) ? (unsigned int)list->size() : 0;
+}
+
+
+/*
+ * Returns the n-th resource the element with metaid points to with
+ * qualifier.
+ */
+std::string
+SedAnnotationIndex::getResource (const std::string& metaid,
+                                 const std::string& qualifier,
+                                 unsigned int n)
+{
+  const StatementList* list = findByMetaId(metaid, qualifier);
+  if (list == NULL || n >= list->size()) return "";
+
+  return mStrings[mStatements[(*list)[n]].resource];
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Reads the documents added since the last query.
+ */
+void
+SedAnnotationIndex::update ()
+{
+  for (; mNumIndexed < mDocuments.size(); ++mNumIndexed)
+  {
+    const SedDocument* document = mDocuments[mNumIndexed];
+    indexElement(document, document);
+
+    List* elements = const_cast<SedDocument*>(document)->getAllElements();
+    for (unsigned int i = 0; i < elements->getSize(); i++)
+    {
+      indexElement(document, static_cast<const SedBase*>(elements->get(i)));
+    }
+    delete elements;
+  }
+}
+
+
+/*
+ * Adds the statements in the annotation of element.
+ */
+void
+SedAnnotationIndex::indexElement (const SedDocument* document,
+                                  const SedBase* element)
+{
+  if (!element->isSetAnnotation()) return;
+
+  const XMLNode* annotation = element->getAnnotation();
+  if (annotation == NULL) return;
+
+  for (unsigned int i = 0; i < annotation->getNumChildren(); i++)
+  {
+    const XMLNode& rdf = annotation->getChild(i);
+    if (rdf.getName() != "RDF" || rdf.getURI() != RDF_NS) continue;
+
+    for (unsigned int j = 0; j < rdf.getNumChildren(); j++)
+    {
+      const XMLNode& description = rdf.getChild(j);
+      if (description.getName() == "Description"
+        && description.getURI() == RDF_NS)
+      {
+        indexDescription(document, element, description);
+      }
+    }
+  }
+}
+
+
+/*
+ * Adds the statements of one rdf:Description.
+ */
+void
+SedAnnotationIndex::indexDescription (const SedDocument* document,
+                                      const SedBase* element,
+                                      const XMLNode& description)
+{
+  std::string about = description.getAttrValue("about", RDF_NS);
+  if (!about.empty() && about[0] == '#') about.erase(0, 1);
+  if (about.empty() && element->isSetMetaId()) about = element->getMetaId();
+
+  const unsigned int metaid = intern(about);
+
+  std::vector<std::string> resources;
+  for (unsigned int i = 0; i < description.getNumChildren(); i++)
+  {
+    const XMLNode& qualifier = description.getChild(i);
+    if (!qualifier.isElement()) continue;
+
+    resources.clear();
+    collectResources(qualifier, resources);
+    if (resources.empty()) continue;
+
+    const unsigned int name = intern(getQualifierName(qualifier));
+    for (size_t r = 0; r < resources.size(); r++)
+    {
+      addStatement(document, element, metaid, name, resources[r]);
+    }
+  }
+}
+
+
+/*
+ * Stores one statement and files it in the indices.
+ */
+void
+SedAnnotationIndex::addStatement (const SedDocument* document,
+                                  const SedBase* element,
+                                  unsigned int metaid, unsigned int qualifier,
+                                  const std::string& resource)
+{
+  Statement statement;
+  statement.document  = document;
+  statement.element   = element;
+  statement.metaid    = metaid;
+  statement.qualifier = qualifier;
+  statement.resource  = intern(resource);
+
+  const unsigned int index = (unsigned int)mStatements.size();
+  mStatements.push_back(statement);
+
+  mByQualifiedResource[Pair(qualifier, statement.resource)].push_back(index);
+  mByResource[statement.resource].push_back(index);
+  mByQualifiedMetaId[Pair(metaid, qualifier)].push_back(index);
+  mByMetaId[metaid].push_back(index);
+}
+
+
+/*
+ * Returns the number standing for value, so that each metaid, qualifier
+ * and resource is stored once.
+ */
+unsigned int
+SedAnnotationIndex::intern (const std::string& value)
+{
+  StringIds::const_iterator it = mStringIds.find(value);
+  if (it != mStringIds.end()) return it->second;
+
+  const unsigned int id = (unsigned int)mStrings.size();
+  mStrings.push_back(value);
+  mStringIds.insert(std::make_pair(value, id));
+  return id;
+}
+
+
+/*
+ * Sets id to the number standing for value, if there is one.
+ */
+bool
+SedAnnotationIndex::lookup (const std::string& value, unsigned int& id) const
+{
+  StringIds::const_iterator it = mStringIds.find(value);
+  if (it == mStringIds.end()) return false;
+
+  id = it->second;
+  return true;
+}
+
+
+/*
+ * Returns the statements with qualifier and resource, or NULL.
+ */
+const SedAnnotationIndex::StatementList*
+SedAnnotationIndex::findByResource (const std::string& qualifier,
+                                    const std::string& resource)
+{
+  update();
+
+  unsigned int resourceId;
+  if (!lookup(resource, resourceId)) return NULL;
+
+  if (qualifier.empty())
+  {
+    SingleIndex::const_iterator it = mByResource.find(resourceId);
+    return (it != mByResource.end()) ? &it->second : NULL;
+  }
+
+  unsigned int qualifierId;
+  if (!lookup(qualifier, qualifierId)) return NULL;
+
+  PairIndex::const_iterator it =
+    mByQualifiedResource.find(Pair(qualifierId, resourceId));
+  return (it != mByQualifiedResource.end()) ? &it->second : NULL;
+}
+
+
+/*
+ * Returns the statements with metaid and qualifier, or NULL.
+ */
+const SedAnnotationIndex::StatementList*
+SedAnnotationIndex::findByMetaId (const std::string& metaid,
+                                  const std::string& qualifier)
+{
+  update();
+
+  unsigned int metaidId;
+  if (!lookup(metaid, metaidId)) return NULL;
+
+  if (qualifier.empty())
+  {
+    SingleIndex::const_iterator it = mByMetaId.find(metaidId);
+    return (it != mByMetaId.end()) ? &it->second : NULL;
+  }
+
+  unsigned int qualifierId;
+  if (!lookup(qualifier, qualifierId)) return NULL;
+
+  PairIndex::const_iterator it =
+    mByQualifiedMetaId.find(Pair(metaidId, qualifierId));
+  return (it != mByQualifiedMetaId.end()) ? &it->second : NULL;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedAnnotationIndex and returns it.
+ */
+LIBSEDML_EXTERN
+SedAnnotationIndex_t *
+SedAnnotationIndex_create ()
+{
+  return new (nothrow) SedAnnotationIndex();
+}
+
+
+/**
+ * Frees the given SedAnnotationIndex.
+ */
+LIBSEDML_EXTERN
+void
+SedAnnotationIndex_free (SedAnnotationIndex_t *sai)
+{
+  delete sai;
+}
+
+
+/**
+ * Adds the annotations of document to sai.
+ */
+LIBSEDML_EXTERN
+int
+SedAnnotationIndex_addDocument (SedAnnotationIndex_t *sai,
+                                const SedDocument_t *document)
+{
+  return (sai != NULL) ? sai->addDocument(document) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of elements annotated with qualifier pointing to
+ * resource.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedAnnotationIndex_getNumElements (SedAnnotationIndex_t *sai,
+                                   const char *qualifier,
+                                   const char *resource)
+{
+  if (sai == NULL || resource == NULL) return 0;
+  return sai->getNumElements(qualifier != NULL ? qualifier : "", resource);
+}
+
+
+/**
+ * Returns the n-th element annotated with qualifier pointing to resource.
+ */
+LIBSEDML_EXTERN
+const SedBase_t *
+SedAnnotationIndex_getElement (SedAnnotationIndex_t *sai,
+                               const char *qualifier,
+                               const char *resource, unsigned int n)
+{
+  if (sai == NULL || resource == NULL) return NULL;
+  return sai->getElement(qualifier != NULL ? qualifier : "", resource, n);
+}
+
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
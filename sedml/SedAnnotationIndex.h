@@ -0,0 +1,293 @@
+/**
+ * @file    SedAnnotationIndex.h
+ * @brief   Index of the RDF annotations of SED-ML documents
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedAnnotationIndex
+ * @ingroup Core
+ * @brief Answers provenance queries on the RDF annotations of documents.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedAnnotationIndex reads the RDF in the annotations of every element
+ * of the documents added to it and keeps each statement as a
+ * (metaid, qualifier, resource) triple, indexed both by qualifier and
+ * resource and by metaid.  Questions such as "which elements are
+ * annotated as bqbiol:is some resource" then cost a lookup, not a walk
+ * over every annotation of every document:
+ *
+ * @code{.cpp}
+SedAnnotationIndex index;
+for (size_t i = 0; i < corpus.size(); ++i) index.addDocument(corpus[i]);
+
+const std::string go = "http://identifiers.org/GO:0006915";
+for (unsigned int n = 0; n < index.getNumElements("bqbiol:is", go); ++n)
+{
+  const SedBase* element = index.getElement("bqbiol:is", go, n);
+  ...
+}
+@endcode
+ *
+ * Documents are only read on the first query after they were added, so
+ * adding a corpus costs nothing until it is asked about; documents whose
+ * notes and annotations are deferred (see
+ * SedDocument::setDeferNotesAndAnnotations()) have them parsed then.
+ *
+ * Statements are found in @em rdf:Description elements of an
+ * @em rdf:RDF element at the top of an annotation.  The metaid is the
+ * @em rdf:about attribute without its leading @em #; each child of the
+ * description is a qualifier, and every @em rdf:resource attribute below
+ * it, usually on the @em rdf:li items of an @em rdf:Bag, a resource.
+ * Qualifiers of the BioModels biology and model qualifier namespaces are
+ * named @em bqbiol:name and @em bqmodel:name, others by their namespace
+ * URI followed by their name.
+ *
+ * The index reflects the annotations as they were when the documents were
+ * read; after changing them, clear() the index and add the documents
+ * again.  A SedAnnotationIndex is not thread-safe.
+ */
+
+#ifndef SedAnnotationIndex_h
+#define SedAnnotationIndex_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+class XMLNode;
+
+
+class LIBSEDML_EXTERN SedAnnotationIndex
+{
+public:
+
+  /**
+   * Creates a new, empty SedAnnotationIndex.
+   */
+  SedAnnotationIndex ();
+
+
+  /**
+   * Destroys this SedAnnotationIndex.
+   */
+  virtual ~SedAnnotationIndex ();
+
+
+  /**
+   * Adds the annotations of @p document, and of all its elements, to this
+   * index.  The document is read on the next query, and must not be
+   * deleted while it is in the index.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if @p document is @c NULL
+   */
+  int addDocument (const SedDocument* document);
+
+
+  /**
+   * Removes all documents and statements from this index.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of statements in this index.
+   */
+  unsigned int getNumStatements ();
+
+
+  /**
+   * @return the number of elements annotated with @p qualifier pointing
+   * to @p resource; an empty @p qualifier matches any.  An element is
+   * counted once for each of its statements that match.
+   */
+  unsigned int getNumElements (const std::string& qualifier,
+                               const std::string& resource);
+
+
+  /**
+   * @return the @p n-th element annotated with @p qualifier pointing to
+   * @p resource, in the order the documents were added, or @c NULL if
+   * @p n is out of range.
+   */
+  const SedBase* getElement (const std::string& qualifier,
+                             const std::string& resource,
+                             unsigned int n);
+
+
+  /**
+   * @return the document of the @p n-th element annotated with
+   * @p qualifier pointing to @p resource, or @c NULL.
+   */
+  const SedDocument* getDocument (const std::string& qualifier,
+                                  const std::string& resource,
+                                  unsigned int n);
+
+
+  /**
+   * @return the number of resources the element with metaid @p metaid
+   * points to with @p qualifier; an empty @p qualifier matches any.
+   */
+  unsigned int getNumResources (const std::string& metaid,
+                                const std::string& qualifier);
+
+
+  /**
+   * @return the @p n-th resource the element with metaid @p metaid points
+   * to with @p qualifier, or an empty string if @p n is out of range.
+   */
+  std::string getResource (const std::string& metaid,
+                           const std::string& qualifier,
+                           unsigned int n);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Statement
+  {
+    const SedDocument*  document;
+    const SedBase*      element;
+    unsigned int        metaid;
+    unsigned int        qualifier;
+    unsigned int        resource;
+  };
+
+  typedef std::vector<unsigned int>                   StatementList;
+  typedef std::map<std::string, unsigned int>         StringIds;
+  typedef std::pair<unsigned int, unsigned int>       Pair;
+  typedef std::map<Pair, StatementList>               PairIndex;
+  typedef std::map<unsigned int, StatementList>       SingleIndex;
+
+  void update ();
+
+  void indexElement (const SedDocument* document, const SedBase* element);
+
+  void indexDescription (const SedDocument* document, const SedBase* element,
+                         const XMLNode& description);
+
+  void addStatement (const SedDocument* document, const SedBase* element,
+                     unsigned int metaid, unsigned int qualifier,
+                     const std::string& resource);
+
+  unsigned int intern (const std::string& value);
+
+  bool lookup (const std::string& value, unsigned int& id) const;
+
+  const StatementList* findByResource (const std::string& qualifier,
+                                       const std::string& resource);
+
+  const StatementList* findByMetaId (const std::string& metaid,
+                                     const std::string& qualifier);
+
+  std::vector<const SedDocument*>  mDocuments;
+  size_t                           mNumIndexed;
+
+  std::vector<std::string>         mStrings;
+  StringIds                        mStringIds;
+
+  std::vector<Statement>           mStatements;
+  PairIndex                        mByQualifiedResource;
+  SingleIndex                      mByResource;
+  PairIndex                        mByQualifiedMetaId;
+  SingleIndex                      mByMetaId;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedAnnotationIndex and returns it.
+ */
+LIBSEDML_EXTERN
+SedAnnotationIndex_t *
+SedAnnotationIndex_create ();
+
+
+/**
+ * Frees the given SedAnnotationIndex.
+ */
+LIBSEDML_EXTERN
+void
+SedAnnotationIndex_free (SedAnnotationIndex_t *sai);
+
+
+/**
+ * Adds the annotations of @p document to @p sai.
+ */
+LIBSEDML_EXTERN
+int
+SedAnnotationIndex_addDocument (SedAnnotationIndex_t *sai,
+                                const SedDocument_t *document);
+
+
+/**
+ * @return the number of elements annotated with @p qualifier (@c NULL
+ * for any) pointing to @p resource.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedAnnotationIndex_getNumElements (SedAnnotationIndex_t *sai,
+                                   const char *qualifier,
+                                   const char *resource);
+
+
+/**
+ * @return the @p n-th element annotated with @p qualifier (@c NULL for
+ * any) pointing to @p resource, or @c NULL.
+ */
+LIBSEDML_EXTERN
+const SedBase_t *
+SedAnnotationIndex_getElement (SedAnnotationIndex_t *sai,
+                               const char *qualifier,
+                               const char *resource, unsigned int n);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedAnnotationIndex_h */
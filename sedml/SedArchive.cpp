@@ -0,0 +1,1000 @@
+/**
+ * @file    SedArchive.cpp
+ * @brief   Reads the SED-ML documents and models of a COMBINE archive
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedArchive.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedReader.h>
+#include <sedml/common/threads.h>
+
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLToken.h>
+
+#include <cstring>
+#include <fstream>
+#include <new>
+
+#ifdef USE_ZLIB
+#  include <zlib.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The signatures and fixed sizes of the zip records read.
+ */
+static const unsigned long sEndOfDirectory   = 0x06054b50UL;
+static const unsigned long sDirectoryEntry   = 0x02014b50UL;
+static const unsigned long sLocalHeader      = 0x04034b50UL;
+
+static const size_t sEndOfDirectorySize      = 22;
+static const size_t sDirectoryEntrySize      = 46;
+static const size_t sLocalHeaderSize         = 30;
+
+static const unsigned int sMethodStored      = 0;
+static const unsigned int sMethodDeflated    = 8;
+
+static const char* sSedMLFormat =
+  "http://identifiers.org/combine.specifications/sed-ml";
+
+
+static unsigned int
+read16 (const std::string& data, size_t offset)
+{
+  const unsigned char* p = (const unsigned char*)data.data() + offset;
+  return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+
+static unsigned long
+read32 (const std::string& data, size_t offset)
+{
+  const unsigned char* p = (const unsigned char*)data.data() + offset;
+  return (unsigned long)p[0]         | ((unsigned long)p[1] << 8)
+       | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+
+static bool
+endsWith (const std::string& text, const char* suffix)
+{
+  const size_t n = strlen(suffix);
+  return text.size() >= n && text.compare(text.size() - n, n, suffix) == 0;
+}
+
+
+/*
+ * State shared by the threads decoding the entries of one archive.
+ * Entries are claimed one at a time through next; each entry is written
+ * by the thread that claimed it only.
+ */
+struct SedArchiveJob
+{
+  SedArchive*                      archive;
+  const std::vector<unsigned int>* indices;
+  unsigned int                     next;
+  SedMutex                         mutex;
+
+  static void run (SedArchiveJob* job);
+};
+
+
+void
+SedArchiveJob::run (SedArchiveJob* job)
+{
+  SedReader reader(job->archive->mReader);
+  const unsigned int size = (unsigned int)job->indices->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int index = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (index >= size) break;
+
+    SedArchive::Entry& entry = job->archive->mEntries[(*job->indices)[index]];
+    try
+    {
+      job->archive->decode(entry);
+      if (SedArchive::isSedMLFormat(entry.format))
+      {
+        job->archive->readDocument(entry, reader);
+      }
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the entry yields nothing
+      entry.valid    = false;
+      entry.document = NULL;
+    }
+  }
+}
+
+
+/*
+ * Entry point of the worker threads.
+ */
+static void
+archiveThreadMain (void* arg)
+{
+  SedArchiveJob::run(static_cast<SedArchiveJob*>(arg));
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedArchive.
+ */
+SedArchive::SedArchive (unsigned int numThreads)
+  : mNumThreads (numThreads)
+  , mReader ()
+  , mData ()
+  , mEntries ()
+  , mSedDocuments ()
+{
+}
+
+
+/*
+ * Destroys this SedArchive and the documents it read.
+ */
+SedArchive::~SedArchive ()
+{
+  clear();
+}
+
+
+/*
+ * Sets the number of threads used.
+ */
+void
+SedArchive::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next read will use at most.
+ */
+unsigned int
+SedArchive::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Returns the SedReader whose options are used for every SED-ML entry.
+ */
+SedReader&
+SedArchive::getReader ()
+{
+  return mReader;
+}
+
+
+/*
+ * Reads the archive in the given file.
+ */
+bool
+SedArchive::readFromFile (const std::string& filename)
+{
+  clear();
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file) return false;
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff length = file.tellg();
+  if (length <= 0) return false;
+  file.seekg(0, std::ios::beg);
+
+  mData.resize((size_t)length);
+  if (!file.read(&mData[0], (std::streamsize)length))
+  {
+    mData.clear();
+    return false;
+  }
+
+  return readArchive();
+}
+
+
+/*
+ * Reads the archive in the given bytes.
+ */
+bool
+SedArchive::readFromBuffer (const char* data, size_t length)
+{
+  clear();
+
+  if (data == NULL) return false;
+
+  mData.assign(data, length);
+  return readArchive();
+}
+
+
+/*
+ * Forgets the archive read and deletes its documents.
+ */
+void
+SedArchive::clear ()
+{
+  for (unsigned int i = 0; i < mEntries.size(); i++)
+  {
+    delete mEntries[i].document;
+  }
+
+  mEntries.clear();
+  mSedDocuments.clear();
+  std::string().swap(mData);
+}
+
+
+/*
+ * Returns the number of entries.
+ */
+unsigned int
+SedArchive::getNumEntries () const
+{
+  return (unsigned int)mEntries.size();
+}
+
+
+/*
+ * Returns the location of the nth entry.
+ */
+const std::string&
+SedArchive::getLocation (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mEntries.size()) ? mEntries[n].location : empty;
+}
+
+
+/*
+ * Returns the format of the nth entry.
+ */
+const std::string&
+SedArchive::getFormat (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mEntries.size()) ? mEntries[n].format : empty;
+}
+
+
+/*
+ * Returns true if the nth entry is a master file.
+ */
+bool
+SedArchive::isMaster (unsigned int n) const
+{
+  return n < mEntries.size() && mEntries[n].master;
+}
+
+
+/*
+ * Returns the index of the entry at location, or -1.
+ */
+int
+SedArchive::getEntryIndex (const std::string& location) const
+{
+  const std::string name = normalize(location);
+  if (name.empty()) return -1;
+
+  for (unsigned int i = 0; i < mEntries.size(); i++)
+  {
+    if (mEntries[i].location == name) return (int)i;
+  }
+
+  return -1;
+}
+
+
+/*
+ * Returns the decompressed contents of the nth entry.
+ */
+const std::string*
+SedArchive::getContents (unsigned int n)
+{
+  if (n >= mEntries.size()) return NULL;
+
+  Entry& entry = mEntries[n];
+  if (!entry.decoded) decode(entry);
+
+  return entry.valid ? &entry.contents : NULL;
+}
+
+
+/*
+ * Returns the number of SED-ML entries.
+ */
+unsigned int
+SedArchive::getNumSedDocuments () const
+{
+  return (unsigned int)mSedDocuments.size();
+}
+
+
+/*
+ * Returns the document read from the nth SED-ML entry.
+ */
+SedDocument*
+SedArchive::getSedDocument (unsigned int n)
+{
+  if (n >= mSedDocuments.size()) return NULL;
+
+  return mEntries[mSedDocuments[n]].document;
+}
+
+
+/*
+ * Returns the location of the nth SED-ML entry.
+ */
+const std::string&
+SedArchive::getSedDocumentLocation (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mSedDocuments.size()) ? mEntries[mSedDocuments[n]].location
+                                    : empty;
+}
+
+
+/*
+ * Returns the document of the master SED-ML entry, or of the first one.
+ */
+SedDocument*
+SedArchive::getMasterSedDocument ()
+{
+  for (unsigned int i = 0; i < mSedDocuments.size(); i++)
+  {
+    if (mEntries[mSedDocuments[i]].master) return getSedDocument(i);
+  }
+
+  return getSedDocument(0);
+}
+
+
+/*
+ * Returns the index of the entry the model source names, or -1.
+ */
+int
+SedArchive::findSource (const std::string& source,
+                        const std::string& base) const
+{
+  if (source.empty()) return -1;
+
+  const std::string baseName = normalize(base);
+  const size_t slash = baseName.rfind('/');
+  if (slash != std::string::npos && source[0] != '/')
+  {
+    int index = getEntryIndex(baseName.substr(0, slash + 1) + source);
+    if (index >= 0) return index;
+  }
+
+  return getEntryIndex(source);
+}
+
+
+/*
+ * Returns true if format is that of SED-ML.
+ */
+bool
+SedArchive::isSedMLFormat (const std::string& format)
+{
+  // http://identifiers.org/combine.specifications/sed-ml, with or without
+  // a level and version, and the older spelling without the dash
+  return format.find("combine.specifications/sed-ml") != std::string::npos
+      || format.find("combine.specifications/sedml")  != std::string::npos;
+}
+
+
+/*
+ * Returns true if format is that of a model.
+ */
+bool
+SedArchive::isModelFormat (const std::string& format)
+{
+  return format.find("combine.specifications/sbml")    != std::string::npos
+      || format.find("combine.specifications/cellml")  != std::string::npos
+      || format.find("combine.specifications/neuroml") != std::string::npos;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Finds the entries, reads the manifest and decodes the SED-ML and model
+ * entries.
+ */
+bool
+SedArchive::readArchive ()
+{
+  if (!readCentralDirectory())
+  {
+    clear();
+    return false;
+  }
+
+  readManifest();
+  decodeEntries();
+
+  for (unsigned int i = 0; i < mEntries.size(); i++)
+  {
+    if (isSedMLFormat(mEntries[i].format)) mSedDocuments.push_back(i);
+  }
+
+  return true;
+}
+
+
+/*
+ * Reads the central directory at the end of the zip file.  Each entry
+ * is checked against its local header, so that decode() only needs the
+ * offset of its data.
+ */
+bool
+SedArchive::readCentralDirectory ()
+{
+  if (mData.size() < sEndOfDirectorySize) return false;
+
+  // the end of central directory record is followed by a comment of at
+  // most 65535 bytes
+  size_t end = mData.size() - sEndOfDirectorySize;
+  const size_t stop = (end > 0xFFFF) ? end - 0xFFFF : 0;
+  for (;;)
+  {
+    if (read32(mData, end) == sEndOfDirectory) break;
+    if (end == stop) return false;
+    --end;
+  }
+
+  const unsigned int  numEntries = read16(mData, end + 10);
+  const unsigned long size       = read32(mData, end + 12);
+  const unsigned long offset     = read32(mData, end + 16);
+
+  // zip64 archives say so with the largest values of these fields
+  if (numEntries == 0xFFFF || size == 0xFFFFFFFFUL || offset == 0xFFFFFFFFUL)
+  {
+    return false;
+  }
+  if (offset + size > end) return false;
+
+  size_t p = offset;
+  for (unsigned int i = 0; i < numEntries; i++)
+  {
+    if (p + sDirectoryEntrySize > end
+      || read32(mData, p) != sDirectoryEntry)
+    {
+      return false;
+    }
+
+    const unsigned int  flags          = read16(mData, p + 8);
+    const unsigned int  method         = read16(mData, p + 10);
+    const unsigned long crc            = read32(mData, p + 16);
+    const unsigned long compressedSize = read32(mData, p + 20);
+    const unsigned long fileSize       = read32(mData, p + 24);
+    const unsigned int  nameLength     = read16(mData, p + 28);
+    const unsigned int  extraLength    = read16(mData, p + 30);
+    const unsigned int  commentLength  = read16(mData, p + 32);
+    const unsigned long localOffset    = read32(mData, p + 42);
+
+    const size_t next = p + sDirectoryEntrySize
+                      + nameLength + extraLength + commentLength;
+    if (next > end) return false;
+
+    const std::string name(mData, p + sDirectoryEntrySize, nameLength);
+    p = next;
+
+    // directories have no contents; encrypted entries cannot be read
+    if (name.empty() || name[name.size() - 1] == '/' || (flags & 1) != 0)
+    {
+      continue;
+    }
+    if (compressedSize == 0xFFFFFFFFUL || fileSize == 0xFFFFFFFFUL
+      || localOffset == 0xFFFFFFFFUL)
+    {
+      return false;
+    }
+
+    if (localOffset + sLocalHeaderSize > mData.size()
+      || read32(mData, localOffset) != sLocalHeader)
+    {
+      continue;
+    }
+
+    // the local header has an extra field of its own
+    const size_t dataOffset = localOffset + sLocalHeaderSize
+                            + read16(mData, localOffset + 26)
+                            + read16(mData, localOffset + 28);
+    if (dataOffset + compressedSize > mData.size()) continue;
+
+    addEntry(name, method, crc, dataOffset, compressedSize, fileSize);
+  }
+
+  return true;
+}
+
+
+/*
+ * Appends an entry to mEntries.
+ */
+void
+SedArchive::addEntry (const std::string& location, unsigned int method,
+                      unsigned long crc, size_t offset,
+                      size_t compressedSize, size_t size)
+{
+  Entry entry;
+  entry.location       = normalize(location);
+  entry.master         = false;
+  entry.method         = method;
+  entry.crc            = crc;
+  entry.offset         = offset;
+  entry.compressedSize = compressedSize;
+  entry.size           = size;
+  entry.decoded        = false;
+  entry.valid          = false;
+  entry.document       = NULL;
+
+  if (endsWith(entry.location, ".sedml"))
+  {
+    // the format an archive without a manifest has it in
+    entry.format = sSedMLFormat;
+  }
+
+  mEntries.push_back(entry);
+}
+
+
+/*
+ * Reads the format and master attributes of the content elements of the
+ * manifest into the entries they locate.
+ */
+void
+SedArchive::readManifest ()
+{
+  const int index = getEntryIndex("manifest.xml");
+  if (index < 0) return;
+
+  const std::string* contents = getContents((unsigned int)index);
+  if (contents == NULL) return;
+
+  std::vector<std::string> formats(mEntries.size());
+  std::vector<bool>        masters(mEntries.size(), false);
+  bool                     found = false;
+
+  XMLInputStream stream(contents->c_str(), false,
+                        SedReader::getDefaultXMLParser(), NULL);
+  while (stream.isGood())
+  {
+    const XMLToken token = stream.next();
+    if (stream.isEOF()) break;
+    if (!token.isStart() || token.getName() != "content") continue;
+
+    const int n = getEntryIndex(token.getAttrValue("location"));
+    if (n < 0) continue;
+
+    formats[n] = token.getAttrValue("format");
+    masters[n] = (token.getAttrValue("master") == "true");
+    found = true;
+  }
+  if (stream.isError() || !found) return;
+
+  // a manifest replaces what the names of the entries suggested
+  for (unsigned int i = 0; i < mEntries.size(); i++)
+  {
+    mEntries[i].format = formats[i];
+    mEntries[i].master = masters[i];
+  }
+}
+
+
+/*
+ * Decodes the SED-ML and model entries, reading the SED-ML documents, on
+ * several threads.
+ */
+void
+SedArchive::decodeEntries ()
+{
+  std::vector<unsigned int> indices;
+  bool hasSedML = false;
+  for (unsigned int i = 0; i < mEntries.size(); i++)
+  {
+    const std::string& format = mEntries[i].format;
+    if (isSedMLFormat(format))
+    {
+      indices.push_back(i);
+      hasSedML = true;
+    }
+    else if (isModelFormat(format) && !mEntries[i].decoded)
+    {
+      indices.push_back(i);
+    }
+  }
+
+  if (indices.empty()) return;
+
+  unsigned int numThreads = getNumThreads();
+  if (numThreads > indices.size()) numThreads = (unsigned int)indices.size();
+
+  if (numThreads > 1 && hasSedML)
+  {
+    // let the XML parser and the reader do any initialisation of their
+    // own on this thread, before several threads parse at once
+    delete mReader.readSedMLFromString(
+      "<sedML xmlns=\"http://sed-ml.org/\" level=\"1\" version=\"1\"/>");
+  }
+
+  SedArchiveJob job;
+  job.archive = this;
+  job.indices = &indices;
+  job.next    = 0;
+  mutexInit(&job.mutex);
+
+  // the calling thread is one of the workers, as in SedBatchReader
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, archiveThreadMain, &job)) break;
+    threads.push_back(thread);
+  }
+
+  SedArchiveJob::run(&job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+
+  mutexFree(&job.mutex);
+}
+
+
+/*
+ * Decompresses the contents of entry, checking their size and checksum.
+ */
+bool
+SedArchive::decode (Entry& entry) const
+{
+  if (entry.decoded) return entry.valid;
+
+  entry.decoded = true;
+  entry.valid   = false;
+
+  const char* data = mData.data() + entry.offset;
+
+  if (entry.method == sMethodStored)
+  {
+    if (entry.compressedSize != entry.size) return false;
+    entry.contents.assign(data, entry.size);
+  }
+#ifdef USE_ZLIB
+  else if (entry.method == sMethodDeflated)
+  {
+    entry.contents.resize(entry.size);
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // a negative window asks zlib for raw deflate data, without header
+    if (inflateInit2(&stream, -15) != Z_OK) return false;
+
+    stream.next_in   = (Bytef*)data;
+    stream.avail_in  = (uInt)entry.compressedSize;
+    stream.next_out  = (Bytef*)(entry.size > 0 ? &entry.contents[0] : NULL);
+    stream.avail_out = (uInt)entry.size;
+
+    const int result = inflate(&stream, Z_FINISH);
+    const size_t written = (size_t)stream.total_out;
+    inflateEnd(&stream);
+
+    if (result != Z_STREAM_END || written != entry.size)
+    {
+      std::string().swap(entry.contents);
+      return false;
+    }
+  }
+#endif
+  else
+  {
+    return false;
+  }
+
+#ifdef USE_ZLIB
+  const uLong crc = crc32(0L, (const Bytef*)entry.contents.data(),
+                          (uInt)entry.contents.size());
+  if ((crc & 0xFFFFFFFFUL) != entry.crc)
+  {
+    std::string().swap(entry.contents);
+    return false;
+  }
+#endif
+
+  entry.valid = true;
+  return true;
+}
+
+
+/*
+ * Reads the document of a decoded SED-ML entry.
+ */
+void
+SedArchive::readDocument (Entry& entry, SedReader& reader) const
+{
+  if (!entry.valid || entry.document != NULL) return;
+
+  // the terminating NUL is part of the buffer, so that a document with an
+  // XML declaration is parsed in place
+  entry.document = reader.readSedMLFromBuffer(entry.contents.c_str(),
+                                              entry.contents.size() + 1);
+}
+
+
+/*
+ * Returns location relative to the root of the archive, without "./"
+ * and "/" at its start and with its "." and ".." segments resolved, or an
+ * empty string if it leads out of the archive.
+ */
+std::string
+SedArchive::normalize (const std::string& location)
+{
+  std::vector<std::string> segments;
+
+  size_t start = 0;
+  while (start <= location.size())
+  {
+    size_t end = location.find('/', start);
+    if (end == std::string::npos) end = location.size();
+
+    const std::string segment = location.substr(start, end - start);
+    if (segment == "..")
+    {
+      if (segments.empty()) return "";
+      segments.pop_back();
+    }
+    else if (!segment.empty() && segment != ".")
+    {
+      segments.push_back(segment);
+    }
+
+    start = end + 1;
+  }
+
+  std::string result;
+  for (unsigned int i = 0; i < segments.size(); i++)
+  {
+    if (i > 0) result += '/';
+    result += segments[i];
+  }
+
+  return result;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedArchivePreparer.
+ */
+SedArchivePreparer::SedArchivePreparer (SedArchive& archive,
+                                        SedModelPreparer& preparer,
+                                        const std::string& base)
+  : mArchive (archive)
+  , mPreparer (preparer)
+  , mBase (base)
+  , mLock (NULL)
+{
+  SedMutex* lock = new SedMutex;
+  mutexInit(lock);
+  mLock = lock;
+}
+
+
+/*
+ * Destroys this SedArchivePreparer.
+ */
+SedArchivePreparer::~SedArchivePreparer ()
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexFree(lock);
+  delete lock;
+}
+
+
+/*
+ * Loads source from the archive if it names one of its entries.
+ */
+void*
+SedArchivePreparer::loadSource (const std::string& source,
+                                const std::string& language)
+{
+  const int index = mArchive.findSource(source, mBase);
+  if (index < 0) return mPreparer.loadSource(source, language);
+
+  // a SedModelCache calls the preparer from several threads, and entries
+  // not decoded with the archive are decoded here
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+  const std::string* contents = mArchive.getContents((unsigned int)index);
+  mutexUnlock(lock);
+
+  if (contents == NULL) return NULL;
+
+  return mPreparer.loadContents(*contents, mArchive.getLocation(index),
+                                language);
+}
+
+
+/*
+ * Applies the changes with the preparer wrapped.
+ */
+void*
+SedArchivePreparer::applyChanges (const void* model, const SedModel* sedModel)
+{
+  return mPreparer.applyChanges(model, sedModel);
+}
+
+
+/*
+ * Releases model with the preparer wrapped.
+ */
+void
+SedArchivePreparer::freeModel (void* model)
+{
+  mPreparer.freeModel(model);
+}
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedArchive and returns it.
+ */
+LIBSEDML_EXTERN
+SedArchive_t *
+SedArchive_create (unsigned int numThreads)
+{
+  return new (nothrow) SedArchive(numThreads);
+}
+
+
+/**
+ * Frees the given SedArchive.
+ */
+LIBSEDML_EXTERN
+void
+SedArchive_free (SedArchive_t *sa)
+{
+  delete sa;
+}
+
+
+/**
+ * Reads the archive in the given file.
+ */
+LIBSEDML_EXTERN
+int
+SedArchive_readFromFile (SedArchive_t *sa, const char *filename)
+{
+  if (sa == NULL || filename == NULL) return 0;
+
+  return sa->readFromFile(filename) ? 1 : 0;
+}
+
+
+/**
+ * Reads the archive in the given bytes.
+ */
+LIBSEDML_EXTERN
+int
+SedArchive_readFromBuffer (SedArchive_t *sa, const char *data, size_t length)
+{
+  if (sa == NULL) return 0;
+
+  return sa->readFromBuffer(data, length) ? 1 : 0;
+}
+
+
+/**
+ * Returns the number of entries of the archive.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedArchive_getNumEntries (const SedArchive_t *sa)
+{
+  return (sa != NULL) ? sa->getNumEntries() : 0;
+}
+
+
+/**
+ * Returns the location of the nth entry.
+ */
+LIBSEDML_EXTERN
+const char *
+SedArchive_getLocation (const SedArchive_t *sa, unsigned int n)
+{
+  if (sa == NULL || n >= sa->getNumEntries()) return NULL;
+
+  return sa->getLocation(n).c_str();
+}
+
+
+/**
+ * Returns the contents of the nth entry.
+ */
+LIBSEDML_EXTERN
+const char *
+SedArchive_getContents (SedArchive_t *sa, unsigned int n, size_t *length)
+{
+  const std::string* contents = (sa != NULL) ? sa->getContents(n) : NULL;
+
+  if (length != NULL) *length = (contents != NULL) ? contents->size() : 0;
+
+  return (contents != NULL) ? contents->c_str() : NULL;
+}
+
+
+/**
+ * Returns the number of SED-ML entries of the archive.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedArchive_getNumSedDocuments (const SedArchive_t *sa)
+{
+  return (sa != NULL) ? sa->getNumSedDocuments() : 0;
+}
+
+
+/**
+ * Returns the document of the nth SED-ML entry.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedArchive_getSedDocument (SedArchive_t *sa, unsigned int n)
+{
+  return (sa != NULL) ? sa->getSedDocument(n) : NULL;
+}
+
+
+/**
+ * Returns the document of the master SED-ML entry.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedArchive_getMasterSedDocument (SedArchive_t *sa)
+{
+  return (sa != NULL) ? sa->getMasterSedDocument() : NULL;
+}
+
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,463 @@
+/**
+ * @file    SedArchive.h
+ * @brief   Reads the SED-ML documents and models of a COMBINE archive
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedArchive
+ * @ingroup Core
+ * @brief Reads a COMBINE archive (OMEX file) without extracting it.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A COMBINE archive is a zip file with a <code>manifest.xml</code> listing
+ * its entries and their formats.  SedArchive finds the entries in the
+ * central directory of the zip file and reads the manifest; the entries
+ * are then decompressed in memory, never written to disk.  The SED-ML
+ * entries and the model entries are decompressed in parallel, on a pool
+ * of threads like that of SedBatchReader, and each SED-ML entry is read
+ * into a SedDocument with SedReader::readSedMLFromBuffer() on the same
+ * thread.  Other entries are decompressed when getContents() first asks
+ * for them.  An archive without a manifest has its entries ending in
+ * <code>.sedml</code> taken for SED-ML.
+ *
+ * Entries compressed with deflate can only be read if libSEDML was built
+ * with zlib (see SedGzipSink::isAvailable()); stored entries always can.
+ * Encrypted entries and zip64 archives are not supported.
+ *
+ * The models of the archive are made available to a SedModelCache by a
+ * SedArchivePreparer: the source of a SedModel naming an entry of the
+ * archive, as <code>source="model.xml"</code> or
+ * <code>source="./models/model.xml"</code>, is handed to
+ * SedModelPreparer::loadContents() instead of being loaded as a file.
+ *
+ * A SedArchive owns the documents it read.  It must not be used from two
+ * threads at the same time.
+ */
+
+#ifndef SedArchive_h
+#define SedArchive_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedModelCache.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedArchive
+{
+public:
+
+  /**
+   * Creates a new, empty SedArchive decoding entries with @p numThreads
+   * threads.  A value of zero uses one thread per available processor.
+   */
+  SedArchive (unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedArchive and the documents it read.
+   */
+  virtual ~SedArchive ();
+
+
+  /**
+   * Sets the number of threads used; zero means one per processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next read will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Returns the SedReader whose options are used for every SED-ML entry
+   * read, so that they can be changed.
+   */
+  SedReader& getReader ();
+
+
+  /**
+   * Reads the archive in the file @p filename, replacing what this
+   * SedArchive held.
+   *
+   * @return @c true if the file is a zip file whose entries could be
+   * found; entries that cannot be decoded are reported by
+   * getContents() and getSedDocument() returning nothing.
+   */
+  bool readFromFile (const std::string& filename);
+
+
+  /**
+   * Reads the archive in the @p length bytes at @p data, which are
+   * copied, replacing what this SedArchive held.
+   *
+   * @return @c true if the data are a zip file whose entries could be
+   * found.
+   */
+  bool readFromBuffer (const char* data, size_t length);
+
+
+  /**
+   * Forgets the archive read and deletes its documents.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of entries, the files of the zip file in the order
+   * of its central directory.
+   */
+  unsigned int getNumEntries () const;
+
+
+  /**
+   * @return the location of the <em>n</em>th entry, without a leading
+   * <code>./</code>, or an empty string if there is no such entry.
+   */
+  const std::string& getLocation (unsigned int n) const;
+
+
+  /**
+   * @return the format of the <em>n</em>th entry, as given by the
+   * manifest, or an empty string.
+   */
+  const std::string& getFormat (unsigned int n) const;
+
+
+  /**
+   * @return @c true if the manifest marks the <em>n</em>th entry as a
+   * master file.
+   */
+  bool isMaster (unsigned int n) const;
+
+
+  /**
+   * @return the index of the entry at @p location, which may start with
+   * <code>./</code> or <code>/</code> and have <code>..</code> segments,
+   * or @c -1 if there is none.
+   */
+  int getEntryIndex (const std::string& location) const;
+
+
+  /**
+   * Returns the decompressed contents of the <em>n</em>th entry,
+   * decompressing it if this was not done yet.
+   *
+   * @return the contents, or @c NULL if there is no such entry or it
+   * cannot be decoded.
+   */
+  const std::string* getContents (unsigned int n);
+
+
+  /**
+   * @return the number of SED-ML entries.
+   */
+  unsigned int getNumSedDocuments () const;
+
+
+  /**
+   * @return the document read from the <em>n</em>th SED-ML entry, owned
+   * by this SedArchive, or @c NULL if there is no such entry or it could
+   * not be decoded.
+   */
+  SedDocument* getSedDocument (unsigned int n);
+
+
+  /**
+   * @return the location of the <em>n</em>th SED-ML entry, or an empty
+   * string.
+   */
+  const std::string& getSedDocumentLocation (unsigned int n) const;
+
+
+  /**
+   * @return the document of the first SED-ML entry marked as a master
+   * file, or else of the first SED-ML entry, or @c NULL if there is none.
+   */
+  SedDocument* getMasterSedDocument ();
+
+
+  /**
+   * Returns the index of the entry the model source @p source names,
+   * relative to the directory of the entry @p base if it is given: a
+   * source naming no entry relative to it is looked for from the root
+   * of the archive.
+   *
+   * @return the index, or @c -1 if @p source names no entry, as for
+   * a URN or a URL.
+   */
+  int findSource (const std::string& source,
+                  const std::string& base = "") const;
+
+
+  /**
+   * Returns @c true if @p format, a format of the manifest, is that of
+   * SED-ML.
+   */
+  static bool isSedMLFormat (const std::string& format);
+
+
+  /**
+   * Returns @c true if @p format is that of a model, such as SBML or
+   * CellML, decoded in parallel with the SED-ML entries.
+   */
+  static bool isModelFormat (const std::string& format);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Entry
+  {
+    std::string   location;
+    std::string   format;
+    bool          master;
+    unsigned int  method;
+    unsigned long crc;
+    size_t        offset;
+    size_t        compressedSize;
+    size_t        size;
+    std::string   contents;
+    bool          decoded;
+    bool          valid;
+    SedDocument*  document;
+  };
+
+  bool readArchive ();
+
+  bool readCentralDirectory ();
+
+  void readManifest ();
+
+  void decodeEntries ();
+
+  bool decode (Entry& entry) const;
+
+  void readDocument (Entry& entry, SedReader& reader) const;
+
+  void addEntry (const std::string& location, unsigned int method,
+                 unsigned long crc, size_t offset, size_t compressedSize,
+                 size_t size);
+
+  static std::string normalize (const std::string& location);
+
+  friend struct SedArchiveJob;
+
+  unsigned int               mNumThreads;
+  SedReader                  mReader;
+  std::string                mData;
+  std::vector<Entry>         mEntries;
+  std::vector<unsigned int>  mSedDocuments;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedArchive (const SedArchive&);
+  SedArchive& operator= (const SedArchive&);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedArchivePreparer : public SedModelPreparer
+{
+public:
+
+  /**
+   * Creates a SedArchivePreparer loading the sources that name entries
+   * of @p archive, relative to the entry @p base if it is given, from
+   * those entries with SedModelPreparer::loadContents() of
+   * @p preparer, and all other sources with @p preparer itself.
+   * Neither argument is owned.
+   */
+  SedArchivePreparer (SedArchive& archive, SedModelPreparer& preparer,
+                      const std::string& base = "");
+
+
+  /**
+   * Destroys this SedArchivePreparer.
+   */
+  virtual ~SedArchivePreparer ();
+
+
+  /**
+   * Loads @p source from the archive if it names one of its entries.
+   */
+  virtual void* loadSource (const std::string& source,
+                            const std::string& language);
+
+
+  /**
+   * Applies the changes with the preparer wrapped.
+   */
+  virtual void* applyChanges (const void* model, const SedModel* sedModel);
+
+
+  /**
+   * Releases @p model with the preparer wrapped.
+   */
+  virtual void freeModel (void* model);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedArchive&       mArchive;
+  SedModelPreparer& mPreparer;
+  std::string       mBase;
+  void*             mLock;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedArchivePreparer (const SedArchivePreparer&);
+  SedArchivePreparer& operator= (const SedArchivePreparer&);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedArchive using @p numThreads threads (zero for
+ * one per processor) and returns it.
+ */
+LIBSEDML_EXTERN
+SedArchive_t *
+SedArchive_create (unsigned int numThreads);
+
+
+/**
+ * Frees the given SedArchive and the documents it read.
+ */
+LIBSEDML_EXTERN
+void
+SedArchive_free (SedArchive_t *sa);
+
+
+/**
+ * Reads the archive in the file @p filename.
+ *
+ * @return 1 if the entries of the archive could be found, 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedArchive_readFromFile (SedArchive_t *sa, const char *filename);
+
+
+/**
+ * Reads the archive in the @p length bytes at @p data.
+ *
+ * @return 1 if the entries of the archive could be found, 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedArchive_readFromBuffer (SedArchive_t *sa, const char *data,
+                           size_t length);
+
+
+/**
+ * @return the number of entries of the archive.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedArchive_getNumEntries (const SedArchive_t *sa);
+
+
+/**
+ * @return the location of the <em>n</em>th entry, which the caller must
+ * not free, or @c NULL.
+ */
+LIBSEDML_EXTERN
+const char *
+SedArchive_getLocation (const SedArchive_t *sa, unsigned int n);
+
+
+/**
+ * Returns the contents of the <em>n</em>th entry, which the caller must
+ * not free, and sets @p length to their length.
+ *
+ * @return the contents, or @c NULL if they cannot be decoded.
+ */
+LIBSEDML_EXTERN
+const char *
+SedArchive_getContents (SedArchive_t *sa, unsigned int n, size_t *length);
+
+
+/**
+ * @return the number of SED-ML entries of the archive.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedArchive_getNumSedDocuments (const SedArchive_t *sa);
+
+
+/**
+ * @return the document of the <em>n</em>th SED-ML entry, owned by the
+ * archive, or @c NULL.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedArchive_getSedDocument (SedArchive_t *sa, unsigned int n);
+
+
+/**
+ * @return the document of the master SED-ML entry, owned by the archive,
+ * or @c NULL.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedArchive_getMasterSedDocument (SedArchive_t *sa);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedArchive_h */
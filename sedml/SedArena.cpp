@@ -0,0 +1,169 @@
+/**
+ * @file    SedArena.cpp
+ * @brief   Chunked memory arena for the objects of one SedDocument
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedArena.h>
+
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Every block is rounded up to a multiple of this, so that the next block
+ * starts suitably aligned for any type.
+ */
+static const size_t SED_ARENA_ALIGN = 2 * sizeof(double) > sizeof(void*)
+                                    ? 2 * sizeof(double) : sizeof(void*);
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedArena.
+ */
+SedArena::SedArena (size_t chunkSize)
+  : mCurrent (NULL)
+  , mRemaining (0)
+  , mChunkSize (chunkSize)
+  , mBytesAllocated (0)
+  , mRefCount (1)
+{
+}
+
+
+/*
+ * Frees all chunks of this SedArena.
+ */
+SedArena::~SedArena ()
+{
+  for (size_t i = 0; i < mChunks.size(); ++i)
+  {
+    ::operator delete(mChunks[i]);
+  }
+}
+
+
+/*
+ * Returns size bytes from the current chunk, starting a new one if needed.
+ */
+void*
+SedArena::allocate (size_t size)
+{
+  size = (size + SED_ARENA_ALIGN - 1) & ~(SED_ARENA_ALIGN - 1);
+
+  if (size > mChunkSize / 4)
+  {
+    // large blocks get a chunk of their own so they do not waste the
+    // remainder of the current one
+    char* chunk = static_cast<char*>(::operator new(size));
+    mChunks.push_back(chunk);
+    mBytesAllocated += size;
+    ++mRefCount;
+    return chunk;
+  }
+
+  if (size > mRemaining)
+  {
+    mCurrent   = static_cast<char*>(::operator new(mChunkSize));
+    mRemaining = mChunkSize;
+    mChunks.push_back(mCurrent);
+  }
+
+  void* block = mCurrent;
+  mCurrent   += size;
+  mRemaining -= size;
+  mBytesAllocated += size;
+  ++mRefCount;
+  return block;
+}
+
+
+/*
+ * Makes room for count blocks of size bytes in the current chunk.
+ */
+void
+SedArena::reserve (size_t count, size_t size)
+{
+  size = (size + SED_ARENA_ALIGN - 1) & ~(SED_ARENA_ALIGN - 1);
+
+  // larger blocks get chunks of their own whatever is reserved
+  if (count == 0 || size > mChunkSize / 4) return;
+  if (count > ((size_t)-1) / size) return;
+
+  const size_t needed = count * size;
+  if (needed <= mRemaining) return;
+
+  const size_t chunkSize = (needed > mChunkSize) ? needed : mChunkSize;
+  mCurrent   = static_cast<char*>(::operator new(chunkSize));
+  mRemaining = chunkSize;
+  mChunks.push_back(mCurrent);
+}
+
+
+/*
+ * Takes a reference to this SedArena.
+ */
+void
+SedArena::retain ()
+{
+  ++mRefCount;
+}
+
+
+/*
+ * Gives up a reference to this SedArena.
+ */
+void
+SedArena::release ()
+{
+  if (--mRefCount == 0)
+  {
+    delete this;
+  }
+}
+
+
+/*
+ * Returns the number of bytes handed out.
+ */
+size_t
+SedArena::getBytesAllocated () const
+{
+  return mBytesAllocated;
+}
+
+
+/*
+ * Returns the number of chunks obtained from the heap.
+ */
+unsigned int
+SedArena::getNumChunks () const
+{
+  return (unsigned int)mChunks.size();
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
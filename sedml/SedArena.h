@@ -0,0 +1,130 @@
+/**
+ * @file    SedArena.h
+ * @brief   Chunked memory arena for the objects of one SedDocument
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedArena
+ * @ingroup Core
+ * @brief Memory arena shared by the objects of a SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedArena hands out memory by bumping a pointer through large chunks,
+ * so creating the thousands of small objects of a document costs a
+ * handful of heap allocations.  Individual blocks are never returned to
+ * the arena; instead the arena counts the blocks that are still alive and
+ * frees all of its chunks at once when the last of them, and its owner,
+ * let go of it.  Objects removed from a document therefore stay valid
+ * after the document itself has been deleted.
+ *
+ * SedArena objects are created and owned by SedDocument (see
+ * SedDocument::setUseArena()); they are not meant to be used directly.
+ * A SedArena is not thread-safe, in the same way that a SedDocument is
+ * not.
+ */
+
+#ifndef SedArena_h
+#define SedArena_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedArena
+{
+public:
+
+  /**
+   * Creates a new SedArena allocating chunks of @p chunkSize bytes.  The
+   * creator holds the first reference and gives it up with release().
+   */
+  SedArena (size_t chunkSize = 64 * 1024);
+
+
+  /**
+   * Returns @p size bytes of memory, suitably aligned for any object,
+   * and takes a reference on behalf of the block.
+   */
+  void* allocate (size_t size);
+
+
+  /**
+   * Makes sure that the next @p count blocks of @p size bytes are handed
+   * out from one chunk, back to back, starting a chunk large enough for
+   * them if the current one is not.
+   */
+  void reserve (size_t count, size_t size);
+
+
+  /**
+   * Takes a reference to this SedArena.
+   */
+  void retain ();
+
+
+  /**
+   * Gives up a reference to this SedArena; when the last reference goes
+   * all chunks are freed and the arena deletes itself.
+   */
+  void release ();
+
+
+  /**
+   * @return the number of bytes handed out by allocate().
+   */
+  size_t getBytesAllocated () const;
+
+
+  /**
+   * @return the number of chunks obtained from the heap.
+   */
+  unsigned int getNumChunks () const;
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  ~SedArena ();
+
+  SedArena (const SedArena& orig);
+  SedArena& operator= (const SedArena& rhs);
+
+  std::vector<char*> mChunks;
+  char*              mCurrent;
+  size_t             mRemaining;
+  size_t             mChunkSize;
+  size_t             mBytesAllocated;
+  unsigned long      mRefCount;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedArena_h */
@@ -25,6 +25,7 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <map>
 #include <sstream>
 #include <vector>
 
@@ -42,6 +43,15 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedBase.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedWriteCache.h>
+#include <sedml/SedProfiler.h>
+#include <sedml/SedMemoryUsage.h>
+#include <sedml/SedVisitor.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedXMLTree.h>
+#include <sedml/common/threads.h>
 
 
 //#include <sbml/validator/constraints/IdList.h>
@@ -56,11 +66,133 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * The change stamp of objects that have not changed in a document, which
+ * counts as later than any generation.
+ */
+static const unsigned long SED_UNSTAMPED = (unsigned long)-1;
+
+
+/*
+ * Notes or an annotation shared, read-only, by an object and the copies
+ * made of it while SedDocument::setShareNotesAndAnnotations() is on.
+ * Each sharer holds one reference; the first to modify them takes a copy
+ * of its own (see SedBase::expandDeferredNotes()).
+ */
+struct SedSharedXMLNode
+{
+  XMLNode*      node;
+  unsigned int  refs;
+  SedMutex      mutex;
+};
+
+
+/*
+ * Moves node into a new SedSharedXMLNode held by shared, unless it is
+ * shared already.
+ */
+static void
+shareXMLNode (XMLNode*& node, SedSharedXMLNode*& shared)
+{
+  if (node == NULL || shared != NULL) return;
+
+  shared = new SedSharedXMLNode;
+  shared->node = node;
+  shared->refs = 1;
+  mutexInit(&shared->mutex);
+
+  node = NULL;
+}
+
+
+/*
+ * Adds a reference to shared, which may be NULL, and returns it.
+ */
+static SedSharedXMLNode*
+acquireXMLNode (SedSharedXMLNode* shared)
+{
+  if (shared == NULL) return NULL;
+
+  mutexLock(&shared->mutex);
+  ++shared->refs;
+  mutexUnlock(&shared->mutex);
+
+  return shared;
+}
+
+
+/*
+ * Drops the reference held by shared, deleting the node with the last one.
+ */
+static void
+releaseXMLNode (SedSharedXMLNode*& shared)
+{
+  if (shared == NULL) return;
+
+  mutexLock(&shared->mutex);
+  const bool last = (--shared->refs == 0);
+  mutexUnlock(&shared->mutex);
+
+  if (last)
+  {
+    delete shared->node;
+    mutexFree(&shared->mutex);
+    delete shared;
+  }
+
+  shared = NULL;
+}
+
+
+/*
+ * Drops the reference held by shared and returns a node of the caller's
+ * own: the shared one if no one else holds it, otherwise a copy.
+ */
+static XMLNode*
+unshareXMLNode (SedSharedXMLNode*& shared)
+{
+  if (shared == NULL) return NULL;
+
+  XMLNode* node = NULL;
+
+  mutexLock(&shared->mutex);
+  const bool last = (shared->refs == 1);
+  if (!last)
+  {
+    node = new XMLNode(*shared->node);
+    --shared->refs;
+  }
+  mutexUnlock(&shared->mutex);
+
+  if (last)
+  {
+    node = shared->node;
+    mutexFree(&shared->mutex);
+    delete shared;
+  }
+
+  shared = NULL;
+  return node;
+}
+/** @endcond */
+
+
 
 SedBase*
 SedBase::getElementBySId(std::string id)
 {
   if (id.empty()) return NULL;
+
+  SedElementIterator it = begin();
+  for (++it; it != end(); ++it)
+  {
+    if (it->isSetId() && it->getId() == id)
+    {
+      return const_cast<SedBase*>(&*it);
+    }
+  }
+
   return NULL;
 }
 
@@ -69,15 +201,265 @@ SedBase*
 SedBase::getElementByMetaId(std::string metaid)
 {
   if (metaid.empty()) return NULL;
+
+  SedElementIterator it = begin();
+  for (++it; it != end(); ++it)
+  {
+    if (it->getMetaId() == metaid)
+    {
+      return const_cast<SedBase*>(&*it);
+    }
+  }
+
   return NULL;
 }
 
 List*
 SedBase::getAllElements()
+{
+  return new List();
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Adds the given child and all of its descendants to elements.
+ * Empty SedListOf children are skipped.
+ */
+void
+SedBase::addAllElements(List* elements, SedBase* child)
+{
+  if (elements == NULL || child == NULL) return;
+
+  if (child->getTypeCode() == SEDML_LIST_OF
+    && static_cast<SedListOf*>(child)->size() == 0)
+  {
+    return;
+  }
+
+  elements->add(child);
+
+  List* sublist = child->getAllElements();
+  if (sublist != NULL)
+  {
+    elements->transferFrom(sublist);
+    delete sublist;
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * An object whose children accept() is visiting, and the next of them.
+ */
+struct AcceptFrame
+{
+  const SedBase* element;
+  unsigned int   next;
+};
+/** @endcond */
+
+
+/*
+ * Shows this object and everything below it to the given SedVisitor.
+ */
+bool
+SedBase::accept (SedVisitor& v) const
+{
+  const bool result = dispatch(v);
+  if (!result || getNumChildElements() == 0)
+  {
+    leaveElement(v);
+    return result;
+  }
+
+  std::vector<AcceptFrame> stack;
+  AcceptFrame root = { this, 0 };
+  stack.push_back(root);
+
+  while (!stack.empty())
+  {
+    const SedBase* parent = stack.back().element;
+    const unsigned int n = stack.back().next;
+
+    if (n >= parent->getNumChildElements())
+    {
+      stack.pop_back();
+      parent->leaveElement(v);
+      continue;
+    }
+
+    ++stack.back().next;
+
+    const SedBase* child = parent->getChildElement(n);
+    if (child == NULL) continue;
+
+    if (child->dispatch(v) && child->getNumChildElements() > 0)
+    {
+      AcceptFrame frame = { child, 0 };
+      stack.push_back(frame);
+    }
+    else
+    {
+      child->leaveElement(v);
+    }
+  }
+
+  return result;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Shows this object, but not its children, to the given SedVisitor.
+ */
+bool
+SedBase::dispatch (SedVisitor& v) const
+{
+  return v.visit(*this);
+}
+
+
+/*
+ * Adds what this object holds beyond its own members to the given
+ * SedMemoryVisitor.  Shared notes, annotations and namespaces are counted
+ * once, for the first object met holding them.
+ */
+void
+SedBase::addMemoryUsage (SedMemoryVisitor& v) const
+{
+  const int type = getTypeCode();
+
+  v.addString(type, mMetaId);
+  v.addString(type, mURI);
+
+  v.addXMLNode(type, mNotes, SED_MEMORY_NOTES);
+  v.addString(type, mDeferredNotes, SED_MEMORY_NOTES);
+  if (mSharedNotes != NULL && mSharedNotes->node != NULL)
+  {
+    v.addShared(type, mSharedNotes, sizeof(SedSharedXMLNode)
+                + SedMemoryVisitor::getXMLNodeSize(*mSharedNotes->node),
+                SED_MEMORY_NOTES);
+  }
+
+  v.addXMLNode(type, mAnnotation, SED_MEMORY_ANNOTATIONS);
+  v.addString(type, mDeferredAnnotation, SED_MEMORY_ANNOTATIONS);
+  if (mSharedAnnotation != NULL && mSharedAnnotation->node != NULL)
+  {
+    v.addShared(type, mSharedAnnotation, sizeof(SedSharedXMLNode)
+                + SedMemoryVisitor::getXMLNodeSize(*mSharedAnnotation->node),
+                SED_MEMORY_ANNOTATIONS);
+  }
+
+  if (mSedNamespaces != NULL)
+  {
+    size_t size = sizeof(SedNamespaces);
+    const XMLNamespaces* xmlns = mSedNamespaces->getNamespaces();
+    if (xmlns != NULL) size += SedMemoryVisitor::getNamespacesSize(*xmlns);
+
+    v.addShared(type, mSedNamespaces, size, SED_MEMORY_NAMESPACES);
+  }
+
+  v.addString(type, mCachedXML, SED_MEMORY_CACHES);
+}
+
+
+/*
+ * Calls the leave() method of the given SedVisitor for this object.
+ */
+void
+SedBase::leaveElement (SedVisitor& v) const
+{
+  switch (getTypeCode())
+  {
+  case SEDML_DOCUMENT:
+    v.leave(static_cast<const SedDocument&>(*this));
+    break;
+  case SEDML_LIST_OF:
+    {
+      const SedListOf& list = static_cast<const SedListOf&>(*this);
+      v.leave(list, list.getItemTypeCode());
+    }
+    break;
+  default:
+    v.leave(*this);
+    break;
+  }
+}
+/** @endcond */
+
+
+/*
+ * Returns the number of elements directly contained in this object.
+ */
+unsigned int
+SedBase::getNumChildElements () const
+{
+  return 0;
+}
+
+
+/*
+ * Returns the nth element directly contained in this object.
+ */
+const SedBase*
+SedBase::getChildElement (unsigned int n) const
 {
   return NULL;
 }
 
+
+/*
+ * Returns an iterator over this object and everything below it.
+ */
+SedElementIterator
+SedBase::begin () const
+{
+  return SedElementIterator(this);
+}
+
+
+/*
+ * Returns the iterator past the end of the traversal begun by begin().
+ */
+SedElementIterator
+SedBase::end () const
+{
+  return SedElementIterator();
+}
+
+
+/*
+ * Returns an iterator over the objects of the given type below this one.
+ */
+SedElementIterator
+SedBase::beginOfType (int typeCode) const
+{
+  return SedElementIterator(this, typeCode);
+}
+
+
+/*
+ * Calls callback for each object of the given type below this one.
+ */
+unsigned int
+SedBase::forEachOfType (int typeCode,
+                        bool (*callback)(const SedBase*, void*),
+                        void* userData) const
+{
+  if (callback == NULL) return 0;
+
+  unsigned int count = 0;
+  for (SedElementIterator it = beginOfType(typeCode); it != end(); ++it)
+  {
+    ++count;
+    if (!callback(&*it, userData)) break;
+  }
+
+  return count;
+}
+
 /** @cond doxygen-libsbml-internal */
 /*
  * Creates a new SedBase object with the given level and version.
@@ -86,13 +468,24 @@ SedBase::getAllElements()
 SedBase::SedBase (unsigned int level, unsigned int version) :
    mNotes     ( NULL )
  , mAnnotation( NULL )
+ , mSharedNotes ( NULL )
+ , mSharedAnnotation ( NULL )
  , mSed      ( NULL )
  , mSedNamespaces (NULL)
  , mUserData(NULL)
  , mLine      ( 0 )
  , mColumn    ( 0 )
  , mParentSedObject (NULL)
+ , mResolvedDocument (NULL)
+ , mResolvedGeneration (0)
+ , mCachedAncestor (NULL)
+ , mCachedAncestorType (SEDML_UNKNOWN)
+ , mCachedAncestorGeneration (0)
  , mHasBeenDeleted (false)
+ , mDirty (true)
+ , mCachedDepth (0)
+ , mCachedCompact (false)
+ , mChangeStamp (SED_UNSTAMPED)
  , mEmptyString ("")
  , mURI("")
 {
@@ -115,13 +508,24 @@ SedBase::SedBase (unsigned int level, unsigned int version) :
 SedBase::SedBase (SedNamespaces *sbmlns) :
    mNotes     ( NULL )
  , mAnnotation( NULL )
+ , mSharedNotes ( NULL )
+ , mSharedAnnotation ( NULL )
  , mSed      ( NULL )
  , mSedNamespaces (NULL)
  , mUserData(NULL)
  , mLine      ( 0 )
  , mColumn    ( 0 )
  , mParentSedObject (NULL)
+ , mResolvedDocument (NULL)
+ , mResolvedGeneration (0)
+ , mCachedAncestor (NULL)
+ , mCachedAncestorType (SEDML_UNKNOWN)
+ , mCachedAncestorGeneration (0)
  , mHasBeenDeleted (false)
+ , mDirty (true)
+ , mCachedDepth (0)
+ , mCachedCompact (false)
+ , mChangeStamp (SED_UNSTAMPED)
  , mEmptyString ("")
  , mURI("")
 {
@@ -130,7 +534,19 @@ SedBase::SedBase (SedNamespaces *sbmlns) :
     std::string err("SedBase::SedBase(SedNamespaces*) : SedNamespaces is null");
     throw SedConstructorException(err);
   }
-  mSedNamespaces = sbmlns->clone();
+
+  // a set that is already shared was checked and interned by a document,
+  // as those createObject() passes on are, and is shared the same way
+  // rather than copied; the set of the caller is copied
+  if (sbmlns->isShared())
+  {
+    sbmlns->retain();
+    mSedNamespaces = sbmlns;
+  }
+  else
+  {
+    mSedNamespaces = sbmlns->clone();
+  }
 
   //
   // Sets the XMLNS URI of corresponding Sed Level/Version to
@@ -145,7 +561,7 @@ SedBase::SedBase (SedNamespaces *sbmlns) :
     cout << "[DEBUG] SedBase::SedBase(SedNamespaces*,...) " << static_cast<SedNamespaces>(*mSedNamespaces).getURI() << endl;
 #endif
 
-  setElementNamespace(static_cast<SedNamespaces>(*mSedNamespaces).getURI());
+  setElementNamespace(mSedNamespaces->getURI());
 }
 /** @endcond */
 
@@ -162,8 +578,21 @@ SedBase::SedBase(const SedBase& orig)
   }
   this->mMetaId = orig.mMetaId;
 
+  /* with sharing on, the notes and annotation of orig move into shared
+   * nodes, which the copy references instead of copying them
+   */
+  if (const_cast<SedBase&>(orig).isSharingNotesAndAnnotations())
+  {
+    SedBase& source = const_cast<SedBase&>(orig);
+    shareXMLNode(source.mNotes, source.mSharedNotes);
+    shareXMLNode(source.mAnnotation, source.mSharedAnnotation);
+  }
+
+  this->mSharedNotes      = acquireXMLNode(orig.mSharedNotes);
+  this->mSharedAnnotation = acquireXMLNode(orig.mSharedAnnotation);
+
   if(orig.mNotes != NULL) 
-    this->mNotes = new XMLNode(*const_cast<SedBase&>(orig).getNotes());
+    this->mNotes = new XMLNode(*orig.mNotes);
   else
     this->mNotes = NULL;
   
@@ -171,6 +600,9 @@ SedBase::SedBase(const SedBase& orig)
     this->mAnnotation = new XMLNode(*const_cast<SedBase&>(orig).mAnnotation);
   else
     this->mAnnotation = NULL;
+
+  this->mDeferredNotes      = orig.mDeferredNotes;
+  this->mDeferredAnnotation = orig.mDeferredAnnotation;
  
   /* the copy does not contain a pointer to the document since technically
    * a copy is not part of the document
@@ -181,19 +613,40 @@ SedBase::SedBase(const SedBase& orig)
   this->mParentSedObject = NULL;
   this->mUserData   = orig.mUserData;
 
+  this->mResolvedDocument   = NULL;
+  this->mResolvedGeneration = 0;
+
+  this->mCachedAncestor           = NULL;
+  this->mCachedAncestorType       = SEDML_UNKNOWN;
+  this->mCachedAncestorGeneration = 0;
+
   /* if the object belongs to document that has had the level/version reset
    * the copy will end up with the wrong namespace information
    * need to use the default namespace NOT the namespace local to the object
    */
-  if(orig.getSedNamespaces() != NULL)
-    this->mSedNamespaces = 
-    new SedNamespaces(*const_cast<SedBase&>(orig).getSedNamespaces());
-  else
-    this->mSedNamespaces = NULL;
+  /* the namespaces are shared with the original until either side
+   * changes them (see unshareSedNamespaces())
+   */
+  this->mSedNamespaces = orig.mSedNamespaces;
+  if (this->mSedNamespaces != NULL)
+  {
+    // the count of a frozen document's namespaces is not to be touched
+    // by the threads copying from it
+    if (orig.isFrozen())
+      this->mSedNamespaces = orig.mSedNamespaces->clone();
+    else
+      this->mSedNamespaces->retain();
+  }
 
   
   this->mHasBeenDeleted = false;
 
+  // the copy has not been written yet
+  this->mDirty         = true;
+  this->mCachedDepth   = 0;
+  this->mCachedCompact = false;
+  this->mChangeStamp   = SED_UNSTAMPED;
+
   this->mURI = orig.mURI;
 }
   
@@ -201,6 +654,94 @@ SedBase::SedBase(const SedBase& orig)
 /** @endcond */
 
 
+/** @cond doxygen-libsbml-internal */
+/*
+ * Header in front of every SedBase object; the union keeps the object
+ * that follows it aligned for any type.
+ */
+union SedAllocHeader
+{
+  SedArena*   arena;
+  double      alignDouble;
+  long double alignLongDouble;
+  void*       alignPointer;
+};
+
+
+void*
+SedBase::operator new (size_t size)
+{
+  SedAllocHeader* header = static_cast<SedAllocHeader*>
+    (::operator new(sizeof(SedAllocHeader) + size));
+  header->arena = NULL;
+  return header + 1;
+}
+
+
+void*
+SedBase::operator new (size_t size, const std::nothrow_t&) throw()
+{
+  SedAllocHeader* header = static_cast<SedAllocHeader*>
+    (::operator new(sizeof(SedAllocHeader) + size, std::nothrow));
+  if (header == NULL) return NULL;
+  header->arena = NULL;
+  return header + 1;
+}
+
+
+void*
+SedBase::operator new (size_t size, SedArena* arena)
+{
+  if (arena == NULL) return SedBase::operator new(size);
+
+  SedAllocHeader* header = static_cast<SedAllocHeader*>
+    (arena->allocate(sizeof(SedAllocHeader) + size));
+  header->arena = arena;
+  return header + 1;
+}
+
+
+void
+SedBase::operator delete (void* ptr)
+{
+  if (ptr == NULL) return;
+
+  SedAllocHeader* header = static_cast<SedAllocHeader*>(ptr) - 1;
+
+  if (header->arena != NULL)
+  {
+    // arena memory is reclaimed in bulk once nothing uses it any more
+    header->arena->release();
+  }
+  else
+  {
+    ::operator delete(header);
+  }
+}
+
+
+void
+SedBase::operator delete (void* ptr, const std::nothrow_t&) throw()
+{
+  SedBase::operator delete(ptr);
+}
+
+
+void
+SedBase::operator delete (void* ptr, SedArena*)
+{
+  SedBase::operator delete(ptr);
+}
+
+
+size_t
+SedBase::getAllocationSize (size_t size)
+{
+  return sizeof(SedAllocHeader) + size;
+}
+/** @endcond */
+
+
 /*
  * Destroy this SedBase object.
  */
@@ -208,7 +749,9 @@ SedBase::~SedBase ()
 {
   if (mNotes != NULL)       delete mNotes;
   if (mAnnotation != NULL)  delete mAnnotation;
-  if (mSedNamespaces != NULL)  delete mSedNamespaces;
+  releaseXMLNode(mSharedNotes);
+  releaseXMLNode(mSharedAnnotation);
+  if (mSedNamespaces != NULL)  mSedNamespaces->release();
 
 }
 
@@ -225,10 +768,24 @@ SedBase& SedBase::operator=(const SedBase& rhs)
   {
     this->mMetaId = rhs.mMetaId;
 
+    if (const_cast<SedBase&>(rhs).isSharingNotesAndAnnotations())
+    {
+      SedBase& source = const_cast<SedBase&>(rhs);
+      shareXMLNode(source.mNotes, source.mSharedNotes);
+      shareXMLNode(source.mAnnotation, source.mSharedAnnotation);
+    }
+
+    SedSharedXMLNode* sharedNotes      = acquireXMLNode(rhs.mSharedNotes);
+    SedSharedXMLNode* sharedAnnotation = acquireXMLNode(rhs.mSharedAnnotation);
+    releaseXMLNode(this->mSharedNotes);
+    releaseXMLNode(this->mSharedAnnotation);
+    this->mSharedNotes      = sharedNotes;
+    this->mSharedAnnotation = sharedAnnotation;
+
     delete this->mNotes;
 
     if(rhs.mNotes != NULL) 
-      this->mNotes = new XMLNode(*const_cast<SedBase&>(rhs).getNotes());
+      this->mNotes = new XMLNode(*rhs.mNotes);
     else
       this->mNotes = NULL;
 
@@ -239,23 +796,39 @@ SedBase& SedBase::operator=(const SedBase& rhs)
     else
       this->mAnnotation = NULL;
 
+    this->mDeferredNotes      = rhs.mDeferredNotes;
+    this->mDeferredAnnotation = rhs.mDeferredAnnotation;
+
     this->mSed       = rhs.mSed;
     this->mLine       = rhs.mLine;
     this->mColumn     = rhs.mColumn;
     this->mParentSedObject = rhs.mParentSedObject;
     this->mUserData   = rhs.mUserData;
+    this->mCachedAncestorType = SEDML_UNKNOWN;
 
-    delete this->mSedNamespaces;
+    invalidateReferences();
 
-    if(rhs.mSedNamespaces != NULL)
-      this->mSedNamespaces = 
-      new SedNamespaces(*const_cast<SedBase&>(rhs).mSedNamespaces);
-    else
-      this->mSedNamespaces = NULL;
+    SedNamespaces* sedns = rhs.mSedNamespaces;
+    if (sedns != NULL)
+    {
+      if (rhs.isFrozen())
+        sedns = sedns->clone();
+      else
+        sedns->retain();
+    }
+
+    if(this->mSedNamespaces != NULL)
+      this->mSedNamespaces->release();
+
+    this->mSedNamespaces = sedns;
 
 
     this->mURI = rhs.mURI;
 
+    this->mCachedXML.clear();
+    this->mCachedDepth = 0;
+    markDirty();
+
   }
 
   return *this;
@@ -316,6 +889,15 @@ SedBase::getName () const
 XMLNode*
 SedBase::getNotes()
 {
+  // the notes of a frozen document are only read, so shared ones are
+  // returned as they are; freeze() parsed the deferred ones
+  if (isFrozen())
+  {
+    return (mSharedNotes != NULL) ? mSharedNotes->node : mNotes;
+  }
+
+  expandDeferredNotes();
+
   return mNotes;
 }
 
@@ -323,7 +905,7 @@ SedBase::getNotes()
 XMLNode*
 SedBase::getNotes() const
 {
-  return mNotes;
+  return const_cast<SedBase *>(this)->getNotes();
 }
 
 
@@ -333,14 +915,14 @@ SedBase::getNotes() const
 std::string
 SedBase::getNotesString() 
 {
-  return XMLNode::convertXMLNodeToString(mNotes);
+  return XMLNode::convertXMLNodeToString(getNotes());
 }
 
 
 std::string
 SedBase::getNotesString() const
 {
-  return XMLNode::convertXMLNodeToString(mNotes);
+  return XMLNode::convertXMLNodeToString(getNotes());
 }
 
 
@@ -350,6 +932,12 @@ SedBase::getNotesString() const
 XMLNode* 
 SedBase::getAnnotation ()
 {
+  if (isFrozen())
+  {
+    return (mSharedAnnotation != NULL) ? mSharedAnnotation->node
+                                       : mAnnotation;
+  }
+
   syncAnnotation();
 
   return mAnnotation;
@@ -416,10 +1004,8 @@ SedBase::setUserData(void *userData)
 XMLNamespaces*
 SedBase::getNamespaces() const
 {
-  if (mSed != NULL)
-    return mSed->getSedNamespaces()->getNamespaces();
-  else
-    return mSedNamespaces->getNamespaces();
+  // the namespaces of the element itself, which it may declare on its own
+  return mSedNamespaces->getNamespaces();
 }
 
 
@@ -606,7 +1192,7 @@ SedBase::isSetName () const
 bool
 SedBase::isSetNotes () const
 {
-  return (mNotes != NULL);
+  return (mNotes != NULL || mSharedNotes != NULL || !mDeferredNotes.empty());
 }
 
 
@@ -617,6 +1203,8 @@ SedBase::isSetNotes () const
 bool
 SedBase::isSetAnnotation () const
 {
+  if (!mDeferredAnnotation.empty() || mSharedAnnotation != NULL) return true;
+
   const_cast <SedBase *> (this)->syncAnnotation();
   return (mAnnotation != NULL);
 }
@@ -630,6 +1218,9 @@ SedBase::isSetAnnotation () const
 int
 SedBase::setMetaId (const std::string& metaid)
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+
   if (&(metaid) == NULL)
   {
     return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -641,6 +1232,7 @@ SedBase::setMetaId (const std::string& metaid)
   else if (metaid.empty())
   {
     mMetaId.erase();
+    notifyIdChanged();
     return LIBSEDML_OPERATION_SUCCESS;
   }
   else if (!(SyntaxChecker::isValidXMLID(metaid)))
@@ -650,6 +1242,7 @@ SedBase::setMetaId (const std::string& metaid)
   else
   {
     mMetaId = metaid;
+    notifyIdChanged();
     return LIBSEDML_OPERATION_SUCCESS;
   }
 }
@@ -696,6 +1289,11 @@ SedBase::setAnnotation (const XMLNode* annotation)
   // 
   // 
 
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+  mDeferredAnnotation.clear();
+  releaseXMLNode(mSharedAnnotation);
+
   if (annotation == NULL)
   {
     delete mAnnotation;
@@ -820,6 +1418,9 @@ SedBase::appendAnnotation (const XMLNode* annotation)
   int success = LIBSEDML_OPERATION_FAILED;
   unsigned int duplicates = 0;
 
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  expandDeferredAnnotation();
+
 
   if(annotation == NULL) 
     return LIBSEDML_OPERATION_SUCCESS;
@@ -933,6 +1534,9 @@ SedBase::removeTopLevelAnnotationElement(const std::string elementName,
 {
   
   int success = LIBSEDML_OPERATION_FAILED;
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+  expandDeferredAnnotation();
   if (mAnnotation == NULL)
   {
     success = LIBSEDML_OPERATION_SUCCESS;
@@ -1042,6 +1646,11 @@ SedBase::replaceTopLevelAnnotationElement(const std::string& annotation)
 int 
 SedBase::setNotes(const XMLNode* notes)
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+  mDeferredNotes.clear();
+  releaseXMLNode(mSharedNotes);
+
   if (mNotes == notes) 
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -1196,6 +1805,9 @@ int
 SedBase::appendNotes(const XMLNode* notes)
 {
   int success = LIBSEDML_OPERATION_FAILED;
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+  expandDeferredNotes();
   if(notes == NULL) 
   {
     return LIBSEDML_OPERATION_SUCCESS;
@@ -1587,15 +2199,43 @@ SedBase::setSedDocument (SedDocument* d)
 void 
 SedBase::connectToParent (SedBase* parent)
 {
-  mParentSedObject = parent;
-  if (mParentSedObject)
+  mParentSedObject    = parent;
+  mCachedAncestorType = SEDML_UNKNOWN;
+
+  // the document of an element is that of its parent, or the parent
+  SedDocument* doc = NULL;
+  if (parent != NULL)
   {
-    setSedDocument(mParentSedObject->getSedDocument());
+    doc = (parent->getTypeCode() == SEDML_DOCUMENT)
+        ? static_cast<SedDocument*>(parent) : parent->mSed;
   }
-  else
+
+  if (doc != mSed)
   {
-    setSedDocument(0);
+    setSedDocument(doc);
+    setDocumentOfChildren(doc);
   }
+
+  if (doc != NULL && doc != this)
+  {
+    doc->addToElementIndex(this);
+    internSedNamespaces();
+  }
+
+  // the new parent has a child to write, and this object may be written
+  // with other namespace declarations or at another depth
+  markDirty();
+}
+
+
+/*
+ * Forgets the parent of this Sed object.
+ */
+void
+SedBase::disconnectFromParent ()
+{
+  mParentSedObject    = NULL;
+  mCachedAncestorType = SEDML_UNKNOWN;
 }
 
 
@@ -1621,43 +2261,29 @@ SedBase::getAncestorOfType(int type, const std::string pkgName)
   if (pkgName == "core" && type ==SEDML_DOCUMENT)
     return getSedDocument();
 
-  SedBase *child = this;
-  SedBase *parent = getParentSedObject();
-
-  while ( parent != NULL && 
-          !( parent->getTypeCode() ==SEDML_DOCUMENT )
-        )
+  // an element keeps the ancestor it last found, until it or the shape of
+  // its document changes
+  SedDocument* doc = getSedDocument();
+  if (doc != NULL && mCachedAncestorType != SEDML_UNKNOWN
+    && type == mCachedAncestorType
+    && doc->getElementIndexGeneration() == mCachedAncestorGeneration)
   {
-    if (parent->getTypeCode() == type )
-      return parent;
-    else
-    {
-      child = parent;
-      parent = child->getParentSedObject();
-    }
-  }
-
-  // if we get here we havent found an ancestor of this type
-  return NULL;
-
-}
-
-
-const SedBase* 
-SedBase::getAncestorOfType(int type, const std::string pkgName) const
-{
-  if (pkgName == "core" && type ==SEDML_DOCUMENT)
-    return getSedDocument();
+    return mCachedAncestor;
+  }
 
-  const SedBase *child = this;
-  const SedBase *parent = getParentSedObject();
+  SedBase *child = this;
+  SedBase *parent = getParentSedObject();
+  SedBase *found = NULL;
 
   while ( parent != NULL && 
           !( parent->getTypeCode() ==SEDML_DOCUMENT )
         )
   {
     if (parent->getTypeCode() == type )
-      return parent;
+    {
+      found = parent;
+      break;
+    }
     else
     {
       child = parent;
@@ -1665,9 +2291,25 @@ SedBase::getAncestorOfType(int type, const std::string pkgName) const
     }
   }
 
-  // if we get here we havent found an ancestor of this type
-  return NULL;
+  // the elements of a frozen document are read by many threads at once,
+  // and keep nothing
+  if (doc != NULL && !doc->isFrozen())
+  {
+    mCachedAncestor           = found;
+    mCachedAncestorType       = type;
+    mCachedAncestorGeneration = doc->getElementIndexGeneration();
+  }
+
+  // NULL if we havent found an ancestor of this type
+  return found;
+
+}
 
+
+const SedBase* 
+SedBase::getAncestorOfType(int type, const std::string pkgName) const
+{
+  return const_cast<SedBase*>(this)->getAncestorOfType(type, pkgName);
 }
 
 /*
@@ -1678,16 +2320,30 @@ SedBase::getAncestorOfType(int type, const std::string pkgName) const
 int 
 SedBase::setNamespaces(XMLNamespaces* xmlns)
 {
-  if (xmlns == NULL)
-  {
-    mSedNamespaces->setNamespaces(NULL);
-    return LIBSEDML_OPERATION_SUCCESS;
-  }
-  else
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+
+  SedDocument* doc = getRootDocument();
+
+  if (doc != NULL && doc != this)
   {
-    mSedNamespaces->setNamespaces(xmlns);
-    return LIBSEDML_OPERATION_SUCCESS;
+    // most elements of a document carry the same namespaces, so share
+    // an equal set the document already holds rather than keep a copy
+    SedNamespaces* interned = doc->getInternedSedNamespaces(
+      mSedNamespaces->getLevel(), mSedNamespaces->getVersion(), xmlns);
+
+    if (interned != NULL)
+    {
+      mSedNamespaces->release();
+      mSedNamespaces = interned;
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
   }
+
+  unshareSedNamespaces();
+  mSedNamespaces->setNamespaces(xmlns);
+  internSedNamespaces();
+
+  return LIBSEDML_OPERATION_SUCCESS;
 }
 
 
@@ -1698,6 +2354,9 @@ SedBase::setNamespaces(XMLNamespaces* xmlns)
 int
 SedBase::unsetMetaId ()
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+
   /* only in L2 onwards */
   if (getLevel() < 2)
   {
@@ -1705,6 +2364,7 @@ SedBase::unsetMetaId ()
   }
 
   mMetaId.erase();
+  notifyIdChanged();
 
   if (mMetaId.empty())
   {
@@ -1743,6 +2403,10 @@ SedBase::unsetName ()
 int
 SedBase::unsetNotes ()
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+  markDirty();
+  mDeferredNotes.clear();
+  releaseXMLNode(mSharedNotes);
   delete mNotes;
   mNotes = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -2017,7 +2681,7 @@ SedBase::setSedNamespaces(SedNamespaces * sbmlns)
 void
 SedBase::setSedNamespacesAndOwn(SedNamespaces * sbmlns)
 {
-  delete mSedNamespaces;
+  if (mSedNamespaces != NULL) mSedNamespaces->release();
   mSedNamespaces = sbmlns;
 
   if(sbmlns != NULL)
@@ -2029,9 +2693,7 @@ SedBase::setSedNamespacesAndOwn(SedNamespaces * sbmlns)
 SedNamespaces *
 SedBase::getSedNamespaces() const
 {
-  if (mSed != NULL)
-    return mSed->mSedNamespaces;
-  else if (mSedNamespaces != NULL)
+  if (mSedNamespaces != NULL)
     return mSedNamespaces;
   else
     return new SedNamespaces();
@@ -2057,6 +2719,22 @@ SedBase::toSed ()
 
 
 /** @cond doxygen-libsbml-internal */
+/*
+ * Returns true if text is made of XML white space only.
+ */
+static bool
+isWhiteSpace (const std::string& text)
+{
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    const char c = text[i];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return false;
+  }
+
+  return true;
+}
+
+
 /*
  * Reads (initializes) this Sed object by reading from XMLInputStream.
  */
@@ -2065,14 +2743,25 @@ SedBase::read (XMLInputStream& stream)
 {
   if ( !stream.peek().isStart() ) return;
 
+#ifdef USE_PROFILING
+  // counts this element and the time it takes, without its children
+  SedDocument* profiled = getRootDocument();
+  SedProfileRecorder* recorder =
+    (profiled != NULL) ? profiled->getProfileRecorder() : NULL;
+  SedProfileScope profile(recorder, SedProfileRecorder::READ, getTypeCode());
+#endif
+
   const XMLToken  element  = stream.next();
   int             position =  0;
 
   setSedBaseFields( element );
 
-  ExpectedAttributes expectedAttributes;
-  addExpectedAttributes(expectedAttributes);
-  readAttributes( element.getAttributes(), expectedAttributes );
+  readAttributes( element.getAttributes(), getExpectedAttributes() );
+
+  /* readAttributes sets the id directly, after this object has already
+   * been added to its parent list
+   */
+  notifyIdChanged();
 
   /* if we are reading a document pass the
    * Sed Namespace information to the input stream object
@@ -2123,8 +2812,7 @@ SedBase::read (XMLInputStream& stream)
        
         if (error == true && errorLoggedAlready == false)
         {
-          static ostringstream errMsg;
-          errMsg.str("");
+          ostringstream errMsg;
           errMsg << "The prefix for the <sbml> element does not match "
             << "the prefix for the Sed namespace.  This means that "
             << "the <sbml> element in not in the SedNamespace."<< endl;
@@ -2140,31 +2828,53 @@ SedBase::read (XMLInputStream& stream)
   {
     //
     // checks if the given default namespace (if any) is a valid
-    // Sed namespace
+    // Sed namespace; the sets a document shares between its elements are
+    // checked once
     //
-    checkDefaultNamespace(mSedNamespaces->getNamespaces(), element.getName());
+    SedDocument* doc = getRootDocument();
+    const bool shared = (doc != NULL && doc != this);
+    if (!shared || !doc->isCheckedNamespace(mSedNamespaces, mURI))
+    {
+      if (checkDefaultNamespace(mSedNamespaces->getNamespaces(),
+                                element.getName()) && shared)
+      {
+        doc->addCheckedNamespace(mSedNamespaces, mURI);
+      }
+    }
+
+    // a prefixed element is in the namespace bound to its prefix
     if (!element.getPrefix().empty())
     {
-      XMLNamespaces * prefixedNS = new XMLNamespaces();
-      prefixedNS->add(element.getURI(), element.getPrefix());
-      checkDefaultNamespace(prefixedNS, element.getName(), element.getPrefix());
-      delete prefixedNS;
+      checkNamespaceURI(element.getURI(), element.getName());
     }
   }
 
   if ( element.isEnd() ) return;
 
+  // when only the structure is read, MathML, notes and annotations are
+  // skipped, as is everything nested deeper than the depth asked for
+  const unsigned int structureOnly = getStructureOnlyDepth();
+  const unsigned int depth = (structureOnly != 0) ? getElementDepth() : 0;
+
   while ( stream.isGood() )
   {
-    // this used to skip the text
-    //    stream.skipText();
-    // instead, read text and store in variable
+    // stop reading hostile input once the error log is full, if asked to
+    if (getErrorLog() != NULL && getErrorLog()->isStopped()) break;
+
+    // the text between children is nearly always white space, which is
+    // skipped without being copied; other text, from its first character
+    // that is not white space on, is given to setElementText()
     std::string text;
     while(stream.isGood() && stream.peek().isText())
     {
-      text += stream.next().getCharacters(); 
+      const std::string& characters = stream.peek().getCharacters();
+      if (!text.empty() || !isWhiteSpace(characters))
+      {
+        text += characters;
+      }
+      stream.next();
     }
-    setElementText(text);
+    if (!text.empty()) setElementText(text);
 
     const XMLToken& next = stream.peek();
 
@@ -2176,11 +2886,17 @@ SedBase::read (XMLInputStream& stream)
       stream.next();
       break;
     }
+    else if ( next.isStart() && structureOnly != 0
+              && (depth >= structureOnly || next.getName() == "math"
+                  || next.getName() == "notes"
+                  || next.getName() == "annotation") )
+    {
+      stream.skipPastEnd( stream.next() );
+    }
     else if ( next.isStart() )
     {
-      const std::string nextName = next.getName();
 #if 0
-      cout << "[DEBUG] SedBase::read " << nextName << " uri "
+      cout << "[DEBUG] SedBase::read " << next.getName() << " uri "
            << stream.peek().getURI() << endl;
 #endif
 
@@ -2188,22 +2904,43 @@ SedBase::read (XMLInputStream& stream)
       
       if (object != NULL)
       {
+#ifdef USE_PROFILING
+        if (recorder != NULL) ++recorder->mCounters.numAllocations;
+#endif
+
         checkOrderAndLogError(object, position);
         position = object->getElementPosition();
 
-        object->connectToParent(static_cast <SedBase*>(this));
+        // items of lists were connected when created, and need not be
+        // connected again
+        if (object->getParentSedObject() != this
+            || object->getSedDocument() != getSedDocument())
+        {
+          object->connectToParent(static_cast <SedBase*>(this));
+        }
 
         object->read(stream);
 
         if ( !stream.isGood() ) break;
 
         checkListOfPopulated(object);
+
+        // the required attributes were checked as they were read; the
+        // required elements can be checked only if children were read
+        if (structureOnly != 0 && depth + 1 < structureOnly
+            && !object->hasRequiredElements())
+        {
+          logError(NotSchemaConformant, getLevel(), getVersion(),
+                   "The <" + object->getElementName() + "> element lacks "
+                   "a required element.");
+        }
       }
       else if ( !( readOtherXML(stream)
                    || readAnnotation(stream)
                    || readNotes(stream) ))
       {
-        logUnknownElement(nextName, getLevel(), getVersion());
+        // nothing above consumed the element, which is still at the head
+        logUnknownElement(stream.peek().getName(), getLevel(), getVersion());
         stream.skipPastEnd( stream.next() );
       }
     }
@@ -2245,6 +2982,29 @@ SedBase::write (XMLOutputStream& stream) const
   
   }
 
+  // while SedWriter writes incrementally, unchanged objects reuse the XML
+  // they were written as last time
+  const SedDocument* doc = const_cast<SedBase*>(this)->getRootDocument();
+  SedWriteCache* cache = (doc != NULL) ? doc->getWriteCache() : NULL;
+  const size_t start = (cache != NULL) ? cache->beginElement() : 0;
+
+#ifdef USE_PROFILING
+  SedProfileScope profile(doc != NULL ? doc->getProfileRecorder() : NULL,
+                          SedProfileRecorder::WRITE, getTypeCode());
+#endif
+
+  if (cache != NULL && !mDirty && mCachedDepth == cache->getDepth()
+    && mCachedCompact == cache->getCompact())
+  {
+    // an empty element leaves the stream as the cached one would
+    stream.startElement( getElementName(), getPrefix() );
+    stream.endElement( getElementName(), getPrefix() );
+
+    cache->replace(start, mCachedXML);
+    cache->endElement();
+    return;
+  }
+
   stream.startElement( getElementName(), getPrefix() );
 
   writeXMLNS     ( stream );
@@ -2253,6 +3013,14 @@ SedBase::write (XMLOutputStream& stream) const
 
   stream.endElement( getElementName(), getPrefix() );
 
+  if (cache != NULL)
+  {
+    mCachedXML     = cache->extract(start);
+    mCachedDepth   = cache->getDepth();
+    mCachedCompact = cache->getCompact();
+    mDirty         = false;
+    cache->endElement();
+  }
 }
 /** @endcond */
 
@@ -2266,14 +3034,30 @@ SedBase::write (XMLOutputStream& stream) const
 void
 SedBase::writeElements (XMLOutputStream& stream) const
 {
-  if ( mNotes != NULL ) stream << *mNotes;
+  // shared notes and annotations are written without taking a copy
+  if (mSharedNotes != NULL)
+  {
+    SedXMLTree::write(*mSharedNotes->node, stream);
+  }
+  else
+  {
+    const_cast <SedBase *> (this)->expandDeferredNotes();
+    if ( mNotes != NULL ) SedXMLTree::write(*mNotes, stream);
+  }
 
   /*
    * NOTE: CVTerms on a model have already been dealt with
    */
 
-  const_cast <SedBase *> (this)->syncAnnotation();
-  if (mAnnotation != NULL) stream << *mAnnotation;
+  if (mSharedAnnotation != NULL)
+  {
+    SedXMLTree::write(*mSharedAnnotation->node, stream);
+  }
+  else
+  {
+    const_cast <SedBase *> (this)->syncAnnotation();
+    if (mAnnotation != NULL) SedXMLTree::write(*mAnnotation, stream);
+  }
 }
 
 /** @endcond */
@@ -2295,6 +3079,21 @@ SedBase::createObject (XMLInputStream& stream)
 }
 
 
+/*
+ * Returns the hash createObject() dispatches on (32-bit FNV-1a).
+ */
+unsigned int
+SedBase::getElementNameHash (const std::string& name)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < name.size(); ++i)
+  {
+    hash = ((hash ^ (unsigned char)name[i]) * 16777619u) & 0xffffffffu;
+  }
+  return hash;
+}
+
+
 /** @endcond */
 
 
@@ -2341,7 +3140,7 @@ SedBase::readAnnotation (XMLInputStream& stream)
     // If an annotation already exists, log it as an error and replace
     // the content of the existing annotation with the new one.
 
-    if (mAnnotation != NULL)
+    if (mAnnotation != NULL || !mDeferredAnnotation.empty())
     {
       if (getLevel() < 3) 
       {
@@ -2356,81 +3155,319 @@ SedBase::readAnnotation (XMLInputStream& stream)
     }
 
     delete mAnnotation;
-    mAnnotation = new XMLNode(stream);
-    checkAnnotation();
+
+    if (isDeferringNotesAndAnnotations())
+    {
+      // keep the raw XML only; it is parsed and checked the first time
+      // the annotation is asked for (see expandDeferredAnnotation())
+      mAnnotation = NULL;
+      mDeferredAnnotation = readRawSubtree(stream, getMaxXMLDepth());
+      if (mDeferredAnnotation.empty()) logXMLNestedTooDeeply("annotation");
+      return true;
+    }
+
+    mDeferredAnnotation.clear();
+    mAnnotation = readXMLTree(stream);
+    if (mAnnotation != NULL) checkAnnotation();
+    return true;
+  }
+
+  return false;
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return true if read a <notes> element from the stream
+ */
+bool
+SedBase::readNotes (XMLInputStream& stream)
+{
+  const string& name = stream.peek().getName();
+
+  if (name == "notes")
+  {
+    // If this is a level 1 document then notes are not allowed on
+    // the sbml container
+    if (getLevel() == 1 && getTypeCode() ==SEDML_DOCUMENT)
+    {
+      logError(AnnotationNotesNotAllowedLevel1);
+    }
+
+    // If a notes element already exists, then it is an error.
+    // If an annotation element already exists, then the ordering is wrong.
+    // In either case, replace existing content with the new notes read.
+
+    if (mNotes != NULL || !mDeferredNotes.empty())
+    {
+      if (getLevel() < 3)
+      {
+        logError(NotSchemaConformant, getLevel(), getVersion(),
+                "Only one <notes> element is permitted inside a "
+	            "particular containing element.");
+      }
+      else
+      {
+        logError(OnlyOneNotesElementAllowed, getLevel(), getVersion());
+      }
+    }
+    else if (mAnnotation != NULL || !mDeferredAnnotation.empty())
+    {
+      logError(NotSchemaConformant, getLevel(), getVersion(),
+               "Incorrect ordering of <annotation> and <notes> elements -- "
+               "<notes> must come before <annotation> due to the way that "
+               "the XML Schema for Sed is defined.");
+    }
+
+    delete mNotes;
+
+    if (isDeferringNotesAndAnnotations())
+    {
+      mNotes = NULL;
+      mDeferredNotes = readRawSubtree(stream, getMaxXMLDepth());
+      if (mDeferredNotes.empty()) logXMLNestedTooDeeply("notes");
+      return true;
+    }
+
+    mDeferredNotes.clear();
+    mNotes = readXMLTree(stream);
+    if (mNotes == NULL) return true;
+
+    //
+    // checks if the given default namespace (if any) is a valid
+    // Sed namespace
+    //
+    const XMLNamespaces &xmlns = mNotes->getNamespaces();
+    checkDefaultNamespace(&xmlns,"notes");
+
+    if (getSedDocument() != NULL)
+    {
+      //if (getSedDocument()->getNumErrors() == 0)
+      //{
+      //  checkXHTML(mNotes);
+      //}
+    }
     return true;
   }
 
   return false;
 }
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return true if the document this object is being read into asked for
+ * notes and annotations to be kept as raw XML until first accessed.
+ */
+bool
+SedBase::isDeferringNotesAndAnnotations ()
+{
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL && doc->getDeferNotesAndAnnotations());
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return true if the document this object belongs to shares notes and
+ * annotations with the copies made of its objects.
+ */
+bool
+SedBase::isSharingNotesAndAnnotations ()
+{
+  // moving the notes of a frozen object into shared nodes would change
+  // it, so its copies get copies of their own
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL && doc->getShareNotesAndAnnotations()
+          && !doc->isFrozen());
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return the depth to which the document is read, or 0 for all of it.
+ */
+unsigned int
+SedBase::getStructureOnlyDepth ()
+{
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL) ? doc->getStructureOnlyDepth() : 0;
+}
+
+
+/*
+ * @return the number of levels notes and annotations may nest, or 0.
+ */
+unsigned int
+SedBase::getMaxXMLDepth ()
+{
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL) ? doc->getMaxXMLDepth()
+                       : SedXMLTree::DEFAULT_MAX_DEPTH;
+}
+
+
+/*
+ * Reads notes or an annotation, logging an error if they nest too deeply.
+ */
+XMLNode*
+SedBase::readXMLTree (XMLInputStream& stream)
+{
+  const std::string name = stream.peek().getName();
+
+  XMLNode* node = SedXMLTree::read(stream, getMaxXMLDepth());
+  if (node == NULL) logXMLNestedTooDeeply(name);
+  return node;
+}
+
+
+/*
+ * @return the number of elements this object is nested in.
+ */
+unsigned int
+SedBase::getElementDepth () const
+{
+  unsigned int depth = 0;
+  for (const SedBase* parent = mParentSedObject; parent != NULL;
+       parent = parent->mParentSedObject)
+  {
+    ++depth;
+  }
+  return depth;
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Consumes the element at the head of the stream and returns it, with
+ * everything it contains, as an XML string.  No XMLNode tree is built.
+ */
+std::string
+SedBase::readRawSubtree (XMLInputStream& stream, unsigned int maxDepth)
+{
+  std::ostringstream raw;
+  XMLOutputStream    out(raw, "UTF-8", false);
+  out.setAutoIndent(false);
+
+  const XMLToken element = stream.next();
+  element.write(out);
+
+  unsigned int depth = element.isEnd() ? 0 : 1;
+
+  while (depth > 0 && stream.isGood())
+  {
+    const XMLToken next = stream.next();
+
+    if (next.isEOF()) break;
+
+    if (next.isStart() && maxDepth != 0 && depth >= maxDepth)
+    {
+      // the raw XML would be parsed into a tree this deep later on; the
+      // rest of the element is skipped token by token instead
+      if (!next.isEnd()) ++depth;
+      while (depth > 0 && stream.isGood())
+      {
+        const XMLToken skipped = stream.next();
+        if (skipped.isEOF()) break;
+
+        if (skipped.isStart() && !skipped.isEnd())
+          ++depth;
+        else if (skipped.isEnd() && !skipped.isStart())
+          --depth;
+      }
+      return "";
+    }
+
+    next.write(out);
+
+    if (next.isStart() && !next.isEnd())
+      ++depth;
+    else if (next.isEnd() && !next.isStart())
+      --depth;
+  }
+
+  return raw.str();
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Returns the namespaces used to interpret deferred notes and annotations,
+ * i.e. those in scope on the document they were read from.
+ */
+const XMLNamespaces*
+SedBase::getDeferredNamespaces ()
+{
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL) ? doc->getNamespaces() : getNamespaces();
+}
 /** @endcond */
 
 
 /** @cond doxygen-libsbml-internal */
 /*
- * @return true if read a <notes> element from the stream
+ * Parses deferred notes into mNotes.
  */
-bool
-SedBase::readNotes (XMLInputStream& stream)
+void
+SedBase::expandDeferredNotes ()
 {
-  const string& name = stream.peek().getName();
-
-  if (name == "notes")
+  if (mSharedNotes != NULL)
   {
-    // If this is a level 1 document then notes are not allowed on
-    // the sbml container
-    if (getLevel() == 1 && getTypeCode() ==SEDML_DOCUMENT)
-    {
-      logError(AnnotationNotesNotAllowedLevel1);
-    }
+    delete mNotes;
+    mNotes = unshareXMLNode(mSharedNotes);
+    return;
+  }
 
-    // If a notes element already exists, then it is an error.
-    // If an annotation element already exists, then the ordering is wrong.
-    // In either case, replace existing content with the new notes read.
+  if (mDeferredNotes.empty()) return;
 
-    if (mNotes != NULL)
-    {
-      if (getLevel() < 3)
-      {
-        logError(NotSchemaConformant, getLevel(), getVersion(),
-                "Only one <notes> element is permitted inside a "
-	            "particular containing element.");
-      }
-      else
-      {
-        logError(OnlyOneNotesElementAllowed, getLevel(), getVersion());
-      }
-    }
-    else if (mAnnotation != NULL)
-    {
-      logError(NotSchemaConformant, getLevel(), getVersion(),
-               "Incorrect ordering of <annotation> and <notes> elements -- "
-               "<notes> must come before <annotation> due to the way that "
-               "the XML Schema for Sed is defined.");
-    }
+  std::string raw;
+  raw.swap(mDeferredNotes);
 
-    delete mNotes;
-    mNotes = new XMLNode(stream);
+  delete mNotes;
+  mNotes = XMLNode::convertStringToXMLNode(raw, getDeferredNamespaces());
 
-    //
-    // checks if the given default namespace (if any) is a valid
-    // Sed namespace
-    //
+  if (mNotes != NULL)
+  {
     const XMLNamespaces &xmlns = mNotes->getNamespaces();
     checkDefaultNamespace(&xmlns,"notes");
+  }
+}
+/** @endcond */
 
-    if (getSedDocument() != NULL)
-    {
-      //if (getSedDocument()->getNumErrors() == 0)
-      //{
-      //  checkXHTML(mNotes);
-      //}
-    }
-    return true;
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Parses a deferred annotation into mAnnotation.
+ */
+void
+SedBase::expandDeferredAnnotation ()
+{
+  if (mSharedAnnotation != NULL)
+  {
+    delete mAnnotation;
+    mAnnotation = unshareXMLNode(mSharedAnnotation);
+    return;
   }
 
-  return false;
+  if (mDeferredAnnotation.empty()) return;
+
+  std::string raw;
+  raw.swap(mDeferredAnnotation);
+
+  delete mAnnotation;
+  mAnnotation = XMLNode::convertStringToXMLNode(raw, getDeferredNamespaces());
+
+  if (mAnnotation != NULL)
+  {
+    checkAnnotation();
+  }
 }
+/** @endcond */
+
 
 bool
 SedBase::getHasBeenDeleted() const
@@ -2463,7 +3500,8 @@ SedBase::getElementPosition () const
 SedErrorLog*
 SedBase::getErrorLog ()
 {
-  return (mSed != NULL) ? mSed->getErrorLog() : NULL;
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL) ? doc->getErrorLog() : NULL;
 }
 /** @endcond */
 
@@ -2489,7 +3527,7 @@ SedBase::logUnknownAttribute( const string& attribute,
   /* Akiya made this note - so it needs checking BUT if it can crash due to no
    * SedDocument object then it can crash whatever level - so I put the catch outside
    */
-  if (mSed)
+  if (getErrorLog() != NULL)
   {
       getErrorLog()->logError(NotSchemaConformant,
   			    level, version, msg.str(), getLine(), getColumn());
@@ -2519,7 +3557,7 @@ SedBase::logUnknownElement( const string& element,
     msg << "Element '" << element << "' is not part of the definition of "
         << "Sed Level " << level << " Version " << version << ".";
       
-    if (mSed != NULL)
+    if (getErrorLog() != NULL)
     {
       getErrorLog()->logError(UnrecognizedElement,
 			      level, version, msg.str(), getLine(), getColumn());
@@ -2550,7 +3588,7 @@ SedBase::logEmptyString( const string& attribute,
   // (TODO) Needs to be fixed so that error can be added when
   // no SedDocument attached.
   //
-  if (mSed != NULL)
+  if (getErrorLog() != NULL)
     getErrorLog()->logError(NotSchemaConformant,
                             level, version, msg.str(), getLine(), getColumn());
 }
@@ -2574,9 +3612,23 @@ SedBase::logError (  unsigned int       id
   // (TODO) Needs to be fixed so that error can be added when
   // no SedDocument attached.
   //
-  if ( SedBase::getErrorLog() != NULL && mSed != NULL) 
+  if ( getErrorLog() != NULL ) 
     getErrorLog()->logError(id, getLevel(), getVersion(), details, getLine(), getColumn());
 }
+
+
+/*
+ * Helper to log notes or annotations nesting too deeply.
+ */
+void
+SedBase::logXMLNestedTooDeeply (const std::string& element)
+{
+  std::ostringstream msg;
+  msg << "The <" << element << "> element on the <" << getElementName()
+      << "> element nests more than " << getMaxXMLDepth()
+      << " levels deep and has been skipped.";
+  logError(XMLNestedTooDeeply, getLevel(), getVersion(), msg.str());
+}
 /** @endcond */
 
 
@@ -2614,14 +3666,18 @@ SedBase::readAttributes (const XMLAttributes& attributes,
   const unsigned int level   = getLevel  ();
   const unsigned int version = getVersion();
 
+  // the metaid is found by the same pass over the attributes
+  int metaIdIndex = -1;
+
   //
   // check that all attributes are expected
   //
   for (int i = 0; i < attributes.getLength(); i++)
   {
-    std::string name   = attributes.getName(i);
-    std::string uri    = attributes.getURI(i);
-    std::string prefix = attributes.getPrefix(i);
+    const std::string name   = attributes.getName(i);
+    const std::string prefix = attributes.getPrefix(i);
+
+    if (metaIdIndex < 0 && name == "metaid") metaIdIndex = i;
 
     //
     // To allow prefixed attribute whose namespace doesn't belong to
@@ -2635,45 +3691,325 @@ SedBase::readAttributes (const XMLAttributes& attributes,
     }
    
 
-    //
-    // Checks if there are attributes of unknown package extensions
-    //
-    // if we happen to be on the sbml element (document) then
-    // getPrefix() and mURI have not been set and just return defaults
-    // thus a prefix does not appear to come from the right place !!!
-    if (!prefix.empty() && getElementName() == "sbml")
+    //
+    // Checks if there are attributes of unknown package extensions
+    //
+    // if we happen to be on the sbml element (document) then
+    // getPrefix() and mURI have not been set and just return defaults
+    // thus a prefix does not appear to come from the right place !!!
+    if (!prefix.empty() && getElementName() == "sbml")
+    {
+      if (!expectedAttributes.hasAttribute(name))
+      {
+        logUnknownAttribute(name, level, version, getElementName());
+      }    
+    }
+    else if (!expectedAttributes.hasAttribute(name))
+    {
+      logUnknownAttribute(name, level, version, getElementName(), prefix);
+    }
+  }
+
+  if (level > 1)
+  {
+    bool assigned = readAttribute(attributes, metaIdIndex, "metaid", mMetaId,
+                                  false);
+  
+    if (assigned && mMetaId.empty())
+    {
+      logEmptyString("metaid", level, version,
+                     SedTypeCode_toString(getTypeCode()));
+    }
+
+    if (isSetMetaId())
+    {
+      if (!SyntaxChecker::isValidXMLID(mMetaId))
+      {
+        logError(InvalidMetaidSyntax, getLevel(), getVersion());
+      }
+    }
+  }
+
+  
+}
+
+/*
+ * The expected attributes of each type code, element name and level.
+ */
+typedef std::pair<std::pair<int, unsigned int>, std::string>
+  SedExpectedAttributesKey;
+
+struct SedExpectedAttributesTable
+{
+  std::map<SedExpectedAttributesKey, ExpectedAttributes*>  sets;
+  SedMutex                                                 mutex;
+};
+
+
+static SedExpectedAttributesTable*
+createExpectedAttributesTable ()
+{
+  SedExpectedAttributesTable* table = new SedExpectedAttributesTable;
+  mutexInit(&table->mutex);
+  return table;
+}
+
+
+/*
+ * The table, which lives as long as the process, so that the sets may be
+ * held on to.
+ */
+static SedExpectedAttributesTable* sExpectedAttributesTable = NULL;
+
+
+static SedExpectedAttributesTable*
+getExpectedAttributesTable ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sExpectedAttributesTable == NULL)
+  {
+    sExpectedAttributesTable = createExpectedAttributesTable();
+  }
+  return sExpectedAttributesTable;
+}
+
+
+/*
+ * Creates the table before main() rather than on first use, when several
+ * threads could be creating it at once.
+ */
+static SedExpectedAttributesTable* const sExpectedAttributesTableCreated =
+  getExpectedAttributesTable();
+
+
+/*
+ * Returns the attributes expected on this element, built once.
+ */
+const ExpectedAttributes&
+SedBase::getExpectedAttributes ()
+{
+  SedExpectedAttributesTable* table = getExpectedAttributesTable();
+
+  const SedExpectedAttributesKey key(
+    std::make_pair(getTypeCode(), getLevel()), getElementName());
+
+  mutexLock(&table->mutex);
+
+  ExpectedAttributes*& expected = table->sets[key];
+  if (expected == NULL)
+  {
+    expected = new ExpectedAttributes();
+    addExpectedAttributes(*expected);
+  }
+
+  mutexUnlock(&table->mutex);
+
+  return *expected;
+}
+
+
+/*
+ * Finds the first attribute of each of the given names.
+ */
+void
+SedBase::findAttributes (const XMLAttributes& attributes,
+                         const AttributeName* names, unsigned int numNames,
+                         int* index)
+{
+  for (unsigned int n = 0; n < numNames; ++n)
+  {
+    index[n] = -1;
+  }
+
+  for (int i = 0; i < attributes.getLength(); ++i)
+  {
+    const std::string name = attributes.getName(i);
+    const unsigned int hash = getElementNameHash(name);
+
+    for (unsigned int n = 0; n < numNames; ++n)
+    {
+      if (names[n].hash == hash && index[n] < 0 && name == names[n].name)
+      {
+        index[n] = i;
+        break;
+      }
+    }
+  }
+}
+
+
+/*
+ * Reads the string attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, std::string& value, bool required)
+{
+  if (index >= 0)
+  {
+    // the value is returned by value; its buffer is taken, not copied
+    attributes.getValue(index).swap(value);
+    return true;
+  }
+
+  // readInto() logs the missing attribute
+  if (required) attributes.readInto(name, value, getErrorLog(), true);
+  return false;
+}
+
+
+/*
+ * Reads the optional string attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, SedOptionalString& value,
+                        bool required)
+{
+  if (index >= 0)
+  {
+    std::string read = attributes.getValue(index);
+    value.swap(read);
+    return true;
+  }
+
+  if (required)
+  {
+    std::string missing;
+    attributes.readInto(name, missing, getErrorLog(), true);
+  }
+  return false;
+}
+
+
+/*
+ * Reads the interned string attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, SedSymbol& value, bool required)
+{
+  if (index >= 0)
+  {
+    value = attributes.getValue(index);
+    return true;
+  }
+
+  if (required)
+  {
+    std::string missing;
+    attributes.readInto(name, missing, getErrorLog(), true);
+  }
+  return false;
+}
+
+
+/*
+ * Reads the double attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, double& value, bool required)
+{
+  if (index >= 0)
+  {
+    // plain numbers are read exactly, in any locale, without the stream
+    if (SedNumber::parse(attributes.getValue(index), value)) return true;
+  }
+  else if (!required)
+  {
+    return false;
+  }
+
+  return attributes.readInto(name, value, getErrorLog(), required);
+}
+
+
+/*
+ * Reads the int attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, int& value, bool required)
+{
+  if (index >= 0)
+  {
+    // plain numbers are read exactly, in any locale, without the stream
+    if (SedNumber::parse(attributes.getValue(index), value)) return true;
+  }
+  else if (!required)
+  {
+    return false;
+  }
+
+  return attributes.readInto(name, value, getErrorLog(), required);
+}
+
+
+/*
+ * Reads the unsigned int attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, unsigned int& value, bool required)
+{
+  if (index >= 0)
+  {
+    // plain numbers are read exactly, in any locale, without the stream
+    if (SedNumber::parse(attributes.getValue(index), value)) return true;
+  }
+  else if (!required)
+  {
+    return false;
+  }
+
+  return attributes.readInto(name, value, getErrorLog(), required);
+}
+
+
+/*
+ * Reads the bool attribute at index.
+ */
+bool
+SedBase::readAttribute (const XMLAttributes& attributes, int index,
+                        const char* name, bool& value, bool required)
+{
+  if (index >= 0)
+  {
+    const std::string text = attributes.getValue(index);
+    if (text == "true" || text == "1")
     {
-      if (!expectedAttributes.hasAttribute(name))
-      {
-        logUnknownAttribute(name, level, version, getElementName());
-      }    
+      value = true;
+      return true;
     }
-    else if (!expectedAttributes.hasAttribute(name))
+    if (text == "false" || text == "0")
     {
-      logUnknownAttribute(name, level, version, getElementName(), prefix);
+      value = false;
+      return true;
     }
   }
-
-  if (level > 1)
+  else if (!required)
   {
-    bool assigned = attributes.readInto("metaid", mMetaId, getErrorLog(), false, getLine(), getColumn());
-  
-    if (assigned && mMetaId.empty())
-    {
-      logEmptyString("metaid", level, version,
-                     SedTypeCode_toString(getTypeCode()));
-    }
+    return false;
+  }
 
-    if (isSetMetaId())
-    {
-      if (!SyntaxChecker::isValidXMLID(mMetaId))
-      {
-        logError(InvalidMetaidSyntax, getLevel(), getVersion());
-      }
-    }
+  return attributes.readInto(name, value, getErrorLog(), required);
+}
+
+
+/*
+ * Sets value to id if id is a valid SId.
+ */
+int
+SedBase::checkAndSetSId (const std::string& id, SedSymbol& value)
+{
+  if (!SyntaxChecker::isValidSBMLSId(id))
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
   }
 
-  
+  value = id;
+  return LIBSEDML_OPERATION_SUCCESS;
 }
 
 /** @endcond */
@@ -2690,11 +4026,12 @@ SedBase::getPrefix() const
 {
   std::string prefix = "";
 
+  // getPrefix() is called for every element and attribute written, so
+  // the URI is only looked up when it is needed
   XMLNamespaces *xmlns = getNamespaces();
-  string uri = getURI();
   if(xmlns && mSed && false)//!mSed->isEnabledDefaultNS(uri))
   {
-    prefix = xmlns->getPrefix(uri);  
+    prefix = xmlns->getPrefix(getURI());  
 #if 0
     std::cout << "[DEBUG] SedBase::getPrefix() " << prefix << " URI " << mURI 
               << " element " << getElementName() << std::endl;
@@ -2768,6 +4105,275 @@ SedBase::getRootElement()
 }
 
 
+/*
+ * Returns the SedDocument at the root of the tree this element is
+ * connected to, following parent pointers.
+ */
+SedDocument*
+SedBase::getRootDocument()
+{
+  // connectToParent() keeps mSed the document at the root of the tree
+  if (mSed != NULL) return mSed;
+
+  return (mParentSedObject == NULL && getTypeCode() == SEDML_DOCUMENT)
+    ? static_cast<SedDocument*>(this) : NULL;
+}
+
+
+/*
+ * Sets the document of everything below this element to doc.
+ */
+void
+SedBase::setDocumentOfChildren(SedDocument* doc)
+{
+  SedElementIterator it = begin();
+  for (++it; it != end(); ++it)
+  {
+    SedBase* element = const_cast<SedBase*>(&*it);
+    element->mSed                = doc;
+    element->mCachedAncestorType = SEDML_UNKNOWN;
+  }
+}
+
+
+/*
+ * Returns true if the SedDocument containing this element declares the
+ * namespace uri with the given prefix.
+ */
+bool
+SedBase::isDeclaredByDocument(const std::string& uri,
+                              const std::string& prefix) const
+{
+  // the document itself has no mSed
+  if (mSed == NULL) return false;
+
+  XMLNamespaces* xmlns = mSed->getNamespaces();
+  return (xmlns != NULL && xmlns->hasNS(uri, prefix));
+}
+
+
+/*
+ * Replaces the namespaces of this element by an equal set held by the
+ * containing SedDocument, or hands them to the document for sharing.
+ */
+void
+SedBase::internSedNamespaces()
+{
+  SedDocument* doc = getRootDocument();
+  if (doc == NULL || doc == this || mSedNamespaces == NULL) return;
+
+  // created from the namespaces of its parent, which are interned already
+  if (doc->isInternedSedNamespaces(mSedNamespaces)) return;
+
+  SedNamespaces* interned = doc->getInternedSedNamespaces(
+    mSedNamespaces->getLevel(), mSedNamespaces->getVersion(),
+    mSedNamespaces->getNamespaces());
+
+  if (interned == NULL)
+  {
+    doc->addInternedSedNamespaces(mSedNamespaces);
+  }
+  else
+  {
+    mSedNamespaces->release();
+    mSedNamespaces = interned;
+  }
+}
+
+
+/*
+ * Gives this element its own copy of its namespaces if they are shared,
+ * before they are modified.
+ */
+void
+SedBase::unshareSedNamespaces()
+{
+  if (mSedNamespaces != NULL && mSedNamespaces->isShared())
+  {
+    SedNamespaces* own = mSedNamespaces->clone();
+    mSedNamespaces->release();
+    mSedNamespaces = own;
+  }
+}
+
+
+/*
+ * Returns the arena of the containing SedDocument, if any.
+ */
+SedArena*
+SedBase::getArena()
+{
+  SedDocument* doc = getRootDocument();
+  return (doc != NULL) ? doc->getArena() : NULL;
+}
+
+
+/*
+ * Resolves the typed reference links of this element again if the
+ * document it belongs to has changed since they were last resolved.
+ */
+void
+SedBase::updateReferences()
+{
+  SedDocument* doc = getRootDocument();
+
+  if (doc != NULL && doc == mResolvedDocument
+    && doc->getElementIndexGeneration() == mResolvedGeneration)
+  {
+    return;
+  }
+
+  lookupReferences(doc);
+
+  mResolvedDocument   = doc;
+  mResolvedGeneration = (doc != NULL) ? doc->getElementIndexGeneration() : 0;
+}
+
+
+/*
+ * Elements without reference attributes have nothing to resolve.
+ */
+void
+SedBase::lookupReferences(SedDocument*)
+{
+}
+
+
+/*
+ * Forces the typed reference links to be resolved on next use.
+ */
+void
+SedBase::invalidateReferences()
+{
+  mResolvedDocument   = NULL;
+  mResolvedGeneration = 0;
+}
+
+
+/*
+ * Forces the typed reference links to be resolved on next use, and tells
+ * the SedDocument that the references of this element have changed.
+ */
+void
+SedBase::notifyReferencesChanged()
+{
+  invalidateReferences();
+
+  SedDocument* doc = getRootDocument();
+  if (doc != NULL)
+  {
+    doc->updateReferrer(this);
+  }
+}
+
+
+/*
+ * Lets the parent SedListOf (if any) and the SedDocument know that the
+ * id or metaid of this element has changed.
+ */
+void
+SedBase::notifyIdChanged()
+{
+  if (mParentSedObject != NULL
+    && mParentSedObject->getTypeCode() == SEDML_LIST_OF)
+  {
+    static_cast<SedListOf*>(mParentSedObject)->invalidateIdIndex();
+  }
+
+  SedDocument* doc = getRootDocument();
+  if (doc != NULL)
+  {
+    // the references of the other elements are unchanged
+    doc->invalidateElementIndex(true);
+  }
+}
+
+
+/*
+ * Returns true if this object has changed since an incremental SedWriter
+ * last wrote it.
+ */
+bool
+SedBase::isDirty () const
+{
+  return mDirty;
+}
+
+
+/*
+ * Marks this object and its ancestors dirty, and stamps them with the
+ * current change generation of their document.
+ */
+void
+SedBase::markDirty ()
+{
+  SedDocument* doc = getRootDocument();
+  const unsigned long stamp =
+    (doc != NULL) ? doc->getChangeGeneration() : SED_UNSTAMPED;
+
+  // the ancestors of a dirty object are dirty and stamped alike, so the
+  // walk stops at the first one that is
+  for (SedBase* element = this; element != NULL
+       && (!element->mDirty || element->mChangeStamp != stamp);
+       element = element->mParentSedObject)
+  {
+    element->mDirty       = true;
+    element->mChangeStamp = stamp;
+  }
+}
+
+
+/*
+ * Returns the change generation this object last changed in.
+ */
+unsigned long
+SedBase::getChangeStamp () const
+{
+  return mChangeStamp;
+}
+
+
+/*
+ * Returns true if this object belongs to a frozen SedDocument.
+ */
+bool
+SedBase::isFrozen () const
+{
+  // as in getRootDocument(), a document is the root of its own tree
+  const SedDocument* doc = mSed;
+  if (doc == NULL && mParentSedObject == NULL
+    && getTypeCode() == SEDML_DOCUMENT)
+  {
+    doc = static_cast<const SedDocument*>(this);
+  }
+
+  return (doc != NULL && doc->isFrozen());
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Parses what was deferred, resolves the reference links and drops the
+ * XML kept for incremental writes, which a frozen document never does.
+ */
+void
+SedBase::prepareToFreeze ()
+{
+  if (mSharedNotes == NULL) expandDeferredNotes();
+  if (mSharedAnnotation == NULL) syncAnnotation();
+
+  updateReferences();
+
+  mDirty = true;
+  std::string().swap(mCachedXML);
+  mCachedDepth = 0;
+}
+/** @endcond */
+
+
+static const std::string sMetaIdAttribute("metaid");
+
+
 /*
  * Subclasses should override this method to write their XML attributes
  * to the XMLOutputStream.  Be sure to call your parents implementation
@@ -2780,18 +4386,44 @@ SedBase::writeAttributes (XMLOutputStream& stream) const
 //  {
 //    if (this->getNamespaces()) stream << *(this->getNamespaces());
 //  }
-  unsigned int level   = getLevel();
-  unsigned int version = getVersion();
-  string sbmlPrefix    = getSedPrefix();
-  if ( level > 1 && !mMetaId.empty() )
+  if ( getLevel() > 1 && !mMetaId.empty() )
   {
-    stream.writeAttribute("metaid", sbmlPrefix, mMetaId);
+    stream.writeAttribute(sMetaIdAttribute, getSedPrefix(), mMetaId);
   }
 
   
 }
 
 
+/*
+ * Adds the attributes writeAttributes() writes to attributes.
+ */
+void
+SedBase::addAttributes (XMLAttributes& attributes) const
+{
+  if ( getLevel() > 1 && !mMetaId.empty() )
+  {
+    addAttribute(attributes, sMetaIdAttribute, getSedPrefix(), mMetaId);
+  }
+}
+
+
+/*
+ * Adds the attribute name with the given prefix and value to attributes.
+ */
+void
+SedBase::addAttribute (XMLAttributes& attributes, const std::string& name,
+                       const std::string& prefix,
+                       const std::string& value) const
+{
+  const XMLNamespaces* xmlns = getNamespaces();
+  const std::string    uri   = (prefix.empty() || xmlns == NULL)
+                               ? std::string() : xmlns->getURI(prefix);
+
+  attributes.add(name, value, uri, prefix);
+}
+
+
 /*
  *
  * Subclasses should override this method to write their xmlns attriubutes
@@ -2816,15 +4448,10 @@ SedBase::writeXMLNS (XMLOutputStream& stream) const
 void
 SedBase::syncAnnotation ()
 {
+  expandDeferredAnnotation();
 
-  if (mAnnotation == NULL)
-  {
-    XMLToken ann_token = XMLToken(XMLTriple("annotation", "", ""), 
-                                      XMLAttributes());
-    mAnnotation = new XMLNode(ann_token);
-  }
-
-  // if annotation still empty delete the annotation
+  // an empty annotation is dropped; with none there is nothing to do, so
+  // that a synced annotation is only read (see freeze())
   if (mAnnotation != NULL && mAnnotation->getNumChildren() == 0)
   {
     delete mAnnotation;
@@ -2966,7 +4593,7 @@ SedBase::checkMathMLNamespace(const XMLToken elem)
 
 /** @cond doxygen-libsbml-internal */
 
-void 
+bool
 SedBase::checkDefaultNamespace(const XMLNamespaces* xmlns, 
                              const std::string& elementName,
                              const std::string& prefix)
@@ -2977,17 +4604,28 @@ SedBase::checkDefaultNamespace(const XMLNamespaces* xmlns,
   //
   if (xmlns != NULL && xmlns->getLength() > 0)
   {
-    const std::string defaultURI = xmlns->getURI(prefix);
-    if (!defaultURI.empty() && mURI != defaultURI)
-    {
-      static ostringstream errMsg;
-      errMsg.str("");
-      errMsg << "xmlns=\"" << defaultURI << "\" in <" << elementName
-             << "> element is an invalid namespace." << endl;
-      
-      logError(NotSchemaConformant, getLevel(), getVersion(), errMsg.str());
-    }
+    return checkNamespaceURI(xmlns->getURI(prefix), elementName);
   }
+
+  return true;
+}
+
+
+/*
+ * Checks that uri is empty or the namespace of this object.
+ */
+bool
+SedBase::checkNamespaceURI(const std::string& uri,
+                           const std::string& elementName)
+{
+  if (uri.empty() || mURI == uri) return true;
+
+  ostringstream errMsg;
+  errMsg << "xmlns=\"" << uri << "\" in <" << elementName
+         << "> element is an invalid namespace." << endl;
+
+  logError(NotSchemaConformant, getLevel(), getVersion(), errMsg.str());
+  return false;
 }
 
 /*
@@ -3328,10 +4966,11 @@ SedBase::setSedBaseFields (const XMLToken& element)
   mLine   = element.getLine  ();
   mColumn = element.getColumn();
 
+  // setNamespaces() shares or clones the namespaces it is given, so the
+  // token's own are handed over without a copy of their own
   if (element.getNamespaces().getLength() > 0)
   {
-    XMLNamespaces tmpxmlns(element.getNamespaces());
-    setNamespaces(&tmpxmlns);
+    setNamespaces(const_cast<XMLNamespaces*>(&element.getNamespaces()));
   }
   else
   {
@@ -3387,6 +5026,42 @@ SedBase_getMetaId (SedBase_t *sb)
 }
 
 
+/**
+ * Returns the value of the "id" attribute of the given SedBase_t
+ * structure, which stays valid until the id is changed or @p sb is
+ * freed and must not be freed by the caller.
+ *
+ * @param sb the SedBase_t structure
+ * 
+ * @return the value of the "id" attribute of @p sb, or @c NULL if it has
+ * none
+ */
+LIBSEDML_EXTERN
+const char *
+SedBase_getIdView (const SedBase_t *sb)
+{
+  return (sb != NULL && !sb->getId().empty()) ? sb->getId().c_str() : NULL;
+}
+
+
+/**
+ * Returns the value of the "name" attribute of the given SedBase_t
+ * structure, which stays valid until the name is changed or @p sb is
+ * freed and must not be freed by the caller.
+ *
+ * @param sb the SedBase_t structure
+ * 
+ * @return the value of the "name" attribute of @p sb, or @c NULL if it
+ * has none
+ */
+LIBSEDML_EXTERN
+const char *
+SedBase_getNameView (const SedBase_t *sb)
+{
+  return (sb != NULL && !sb->getName().empty()) ? sb->getName().c_str() : NULL;
+}
+
+
 ///**
 // * Returns the value of the "id" attribute of the given SedBase_t
 // * structure.
@@ -141,14 +141,24 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <new>
 
 #include <sedml/SedErrorLog.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedOptionalString.h>
+#include <sedml/SedSymbol.h>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 //class SedErrorLog;
 class SedVisitor;
+class SedElementIterator;
 class SedDocument;
+class SedArena;
+class SedWriteCache;
+class SedProfileRecorder;
+class SedMemoryVisitor;
+struct SedSharedXMLNode;
 class Model;
 
 class List;
@@ -185,14 +195,151 @@ public:
   SedBase& operator=(const SedBase& rhs);
 
 
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * Every SedBase object is preceded by a small header recording the
+   * SedArena its memory came from, if any, so that @c delete releases it
+   * correctly in either case.  Objects are placed in an arena with
+   * <code>new (arena) SedX(...)</code>; a NULL arena means the heap.
+   */
+  void* operator new (size_t size);
+  void* operator new (size_t size, const std::nothrow_t&) throw();
+  void* operator new (size_t size, SedArena* arena);
+  void  operator delete (void* ptr);
+  void  operator delete (void* ptr, const std::nothrow_t&) throw();
+  void  operator delete (void* ptr, SedArena* arena);
+
+  /*
+   * Returns the number of bytes operator new takes from an arena for an
+   * object of @p size bytes, header included.
+   */
+  static size_t getAllocationSize (size_t size);
+
+  /** @endcond */
+
+
   /**
-   * Accepts the given SedVisitor for this SedBase object.
+   * Accepts the given SedVisitor for this SedBase object and everything
+   * below it.
+   *
+   * This object and its descendants are shown to @p v in document order,
+   * each through the <code>visit()</code> method for its own class, and
+   * each is left through <code>leave()</code> after its children.  When a
+   * <code>visit()</code> returns @c false, the children of that object
+   * are skipped.  The traversal keeps its own stack rather than
+   * recursing, so arbitrarily deep documents can be visited.
    *
    * @param v the SedVisitor instance to be used
    *
-   * @return the result of calling <code>v.visit()</code>.
+   * @return the result of showing this object to <code>v.visit()</code>.
+   */
+  virtual bool accept (SedVisitor& v) const;
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Shows this object, but not its children, to the given SedVisitor,
+   * through the <code>visit()</code> method for its class.
+   *
+   * @return whether the children of this object are to be visited.
+   */
+  virtual bool dispatch (SedVisitor& v) const;
+
+
+  /**
+   * Adds what this object holds beyond its own members, such as its
+   * notes, annotation, namespaces and cached XML, to the given
+   * SedMemoryVisitor, for the type code of this object.  Subclasses with
+   * containers or indexes of their own override this and call it.
+   */
+  virtual void addMemoryUsage (SedMemoryVisitor& v) const;
+
+
+  /**
+   * Brings everything this object computes on first use up to date, and
+   * drops what a frozen document has no use for, so that its const
+   * methods only read from then on; see SedDocument::freeze().
+   * Subclasses with lazy state of their own override this and call it.
+   */
+  virtual void prepareToFreeze ();
+
+  /** @endcond */
+
+
+  /**
+   * Returns the number of elements directly contained in this object,
+   * such as the SedListOf objects of a SedModel or the items of a
+   * SedListOf.
+   *
+   * @return the number of child elements.
    */
-  virtual bool accept (SedVisitor& v) const = 0;
+  virtual unsigned int getNumChildElements () const;
+
+
+  /**
+   * Returns the <i>n</i>th element directly contained in this object.
+   *
+   * @param n the index of the child, counted from 0.
+   *
+   * @return the child, or @c NULL if @p n is out of range.
+   */
+  virtual const SedBase* getChildElement (unsigned int n) const;
+
+
+  /**
+   * Returns an iterator over this object and everything below it, in
+   * document order (pre-order), positioned at this object.  The iterator
+   * keeps an explicit stack instead of recursing.
+   *
+   * @return the iterator.
+   *
+   * @see end()
+   */
+  SedElementIterator begin () const;
+
+
+  /**
+   * @return the iterator past the last element of the traversal begun by
+   * begin().
+   */
+  SedElementIterator end () const;
+
+
+  /**
+   * Returns an iterator over the objects of type @p typeCode among this
+   * object and everything below it, in document order, positioned at the
+   * first of them.  Subtrees that cannot contain such an object, a
+   * SedListOf of tasks when looking for SEDML_VARIABLE for instance, are
+   * not walked, and no List is allocated.
+   *
+   * @param typeCode the type code of the objects to iterate over; codes
+   * such as SEDML_CHANGE or SEDML_OUTPUT also match the classes derived
+   * from those classes.
+   *
+   * @return the iterator, which equals end() once it has passed the last
+   * object of that type.
+   *
+   * @see getAllElements()
+   */
+  SedElementIterator beginOfType (int typeCode) const;
+
+
+  /**
+   * Calls @p callback for each object of type @p typeCode among this object
+   * and everything below it, in document order, as beginOfType() does.
+   *
+   * @param typeCode the type code of the objects to call @p callback for.
+   * @param callback the function to call, with the object and @p userData;
+   * the iteration stops early if it returns @c false.
+   * @param userData passed to @p callback unchanged.
+   *
+   * @return the number of objects @p callback was called for.
+   */
+  unsigned int forEachOfType (int typeCode,
+                              bool (*callback)(const SedBase*, void*),
+                              void* userData = NULL) const;
 
 
   /**
@@ -722,6 +869,10 @@ public:
    * information.  It is used to communicate the Sed Level, Version, and
    * (in Sed Level&nbsp;3) packages used in addition to Sed Level&nbsp;3
    * Core.
+   *
+   * Elements of a SedDocument with equal namespaces share a single
+   * SedNamespaces object, so the object returned must not be modified
+   * except on the SedDocument itself; use setNamespaces() instead.
    * 
    * @return the XML Namespaces associated with this Sed object
    *
@@ -835,7 +986,9 @@ public:
    * This method searches the tree of objects that are parents of this
    * object, and returns the first one that has the given Sed type code.
    * If the optional argument @p pkgName is given, it will cause the search
-   * to be limited to the Sed Level&nbsp;3 package given.
+   * to be limited to the Sed Level&nbsp;3 package given.  An object in a
+   * SedDocument remembers the ancestor it found until an element of the
+   * document is added, removed or given another id.
    *
    * @param type the Sed type code of the object sought
    *
@@ -1767,6 +1920,14 @@ s.setNotes("<body xmlns='http://www.w3.org/1999/xhtml'><p>here is my note</p></b
   virtual void connectToParent (SedBase* parent);
 
 
+  /**
+   * Forgets the parent of this Sed object, when its parent lets go of it
+   * without deleting it, so that it can be added elsewhere.  The document
+   * is kept until it is connected to another parent.
+   */
+  void disconnectFromParent ();
+
+
   /**
    * Sets this Sed object to child Sed objects (if any).
    * (Creates a child-parent relationship by the parent)
@@ -2235,13 +2396,71 @@ s.setNotes("<body xmlns='http://www.w3.org/1999/xhtml'><p>here is my note</p></b
    */
   virtual SedErrorLog* getErrorLog ();
 
+
+  /**
+   * Predicate returning @c true if this object, or anything below it, has
+   * changed since an incremental SedWriter last wrote it (see
+   * SedWriter::setIncremental()).  Objects that have never been written
+   * that way are dirty.
+   *
+   * @return @c true if this object needs to be serialized again.
+   */
+  bool isDirty () const;
+
+
+  /**
+   * Marks this object and its ancestors dirty, so that the next
+   * incremental write serializes them again.
+   *
+   * The setters, add, create and remove methods of libSEDML call this
+   * themselves; it only needs to be called after changing an object by
+   * other means, for instance through the XMLNode returned by getNotes().
+   */
+  void markDirty ();
+
+
+  /**
+   * Returns the change generation of the SedDocument this object belongs
+   * to (see SedDocument::getChangeGeneration()) in which it, or anything
+   * below it, last changed.  An object that has not changed in a
+   * document since it was created, or that changed outside one, has the
+   * largest stamp there is, so that it always counts as changed.
+   *
+   * markDirty() stamps the object and its ancestors; SedIncrementalValidator
+   * only looks below objects stamped later than its last run.
+   */
+  unsigned long getChangeStamp () const;
+
+
+  /**
+   * Predicate returning @c true if this object belongs to a SedDocument
+   * that has been frozen (see SedDocument::freeze()).
+   *
+   * The setters, add, create and remove methods of a frozen object change
+   * nothing, and return @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED@endlink
+   * or @c NULL.
+   *
+   * @return @c true if this object can no longer be changed.
+   */
+  bool isFrozen () const;
+
   
 protected:
 
+  /** @cond doxygen-libsbml-internal */
+  // reads and writes attributes and creates children when diffing and
+  // patching documents
+  friend class SedDocumentPatch;
+  // reads and writes attributes when encoding and decoding documents
+  friend class SedBinaryCodec;
+  /** @endcond */
+
   
   /** 
    * When overridden allows SedBase elements to use the text included in between
-   * the elements tags. The default implementation does nothing.
+   * the elements tags. The default implementation does nothing.  It is not
+   * called for text that is white space only, and leading white space is
+   * not passed on.
    * 
    * @param text the text string found between the element tags.
    */ 
@@ -2289,6 +2508,16 @@ protected:
   virtual SedBase* createObject (XMLInputStream& stream);
 
 
+  /**
+   * Returns the hash createObject() dispatches on, and findAttributes()
+   * compares attribute names by: the 32-bit FNV-1a hash of @p name.  The
+   * generated code switches on its values for the element names a class
+   * reads, which are distinct for each class, and so compares the name with
+   * one candidate only.
+   */
+  static unsigned int getElementNameHash (const std::string& name);
+
+
   /**
    * Predicate returning @c true if this
    * object's level/version and namespace values correspond to a valid
@@ -2344,6 +2573,13 @@ protected:
                  , const std::string& details = "" );
 
 
+  /**
+   * Helper to log notes or annotations nesting more deeply than
+   * getMaxXMLDepth() allows.
+   */
+  void logXMLNestedTooDeeply (const std::string& element);
+
+
   /**
    * Helper to log a common type of error.
    */
@@ -2387,6 +2623,80 @@ protected:
                                const ExpectedAttributes& expectedAttributes);
 
 
+  /**
+   * Returns the attributes expected on this element: the set
+   * addExpectedAttributes() builds, built once for each type code, element
+   * name and level and shared by all objects reading them.
+   */
+  const ExpectedAttributes& getExpectedAttributes ();
+
+
+  /*
+   * A name readAttributes() looks for, with its getElementNameHash().
+   */
+  struct AttributeName
+  {
+    const char*  name;
+    unsigned int hash;
+  };
+
+
+  /**
+   * Sets @p index[i] to the index in @p attributes of the first attribute
+   * named @p names[i], or to -1 if there is none, looking at each
+   * attribute once.
+   */
+  static void findAttributes (const XMLAttributes& attributes,
+                              const AttributeName* names,
+                              unsigned int numNames, int* index);
+
+
+  /**
+   * Reads the attribute at @p index of @p attributes, as found by
+   * findAttributes(), into @p value the way XMLAttributes::readInto()
+   * reads the attribute @p name, numbers with SedNumber::parse().  Missing
+   * required attributes and values that are not plain numbers are handed
+   * to readInto(), which logs the errors.
+   *
+   * @return @c true if @p value was assigned.
+   */
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, std::string& value, bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, SedOptionalString& value,
+                      bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, SedSymbol& value, bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, double& value, bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, int& value, bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, unsigned int& value, bool required);
+
+  bool readAttribute (const XMLAttributes& attributes, int index,
+                      const char* name, bool& value, bool required);
+
+
+  /**
+   * Sets @p value to @p id if @p id is a valid SId, the way
+   * SyntaxChecker::checkAndSetSId() sets a std::string.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_ATTRIBUTE_VALUE
+   */
+  static int checkAndSetSId (const std::string& id, SedSymbol& value);
+
+
   /**
    * Subclasses should override this method to write their XML attributes
    * to the XMLOutputStream.  Be sure to call your parents implementation
@@ -2404,6 +2714,28 @@ protected:
   virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+  /**
+   * Subclasses overriding writeAttributes() should override this method
+   * too, adding the same attributes with the same values, so that
+   * SedBinaryCodec encodes them, and call their parents implementation
+   * of it as well.  For example:
+   *
+   *   SedBase::addAttributes(attributes);
+   *   addAttribute(attributes, "id", prefix, mId);
+   *   ...
+   */
+  virtual void addAttributes (XMLAttributes& attributes) const;
+
+
+  /**
+   * Adds the attribute @p name with the given @p prefix and @p value to
+   * @p attributes, as XMLOutputStream::writeAttribute() writes it.
+   */
+  void addAttribute (XMLAttributes& attributes, const std::string& name,
+                     const std::string& prefix,
+                     const std::string& value) const;
+
+
   /**
    *
    * Subclasses should override this method to write their xmlns attriubutes
@@ -2442,10 +2774,21 @@ protected:
   /**
    * Checks that the given default namespace in the given element is valid.
    * If the given default namespace is not valid, an error is logged.
+   *
+   * @return @c true if it is valid.
    */
-  void checkDefaultNamespace(const XMLNamespaces* xmlns, 
+  bool checkDefaultNamespace(const XMLNamespaces* xmlns, 
     const std::string& elementName, const std::string& prefix = "");
 
+  /**
+   * Checks that @p uri, the namespace of the given element, is empty or
+   * the namespace of this object, and logs an error if it is not.
+   *
+   * @return @c true if it is valid.
+   */
+  bool checkNamespaceURI(const std::string& uri,
+                         const std::string& elementName);
+
   /**
    * Checks the annotation does not declare an sbml namespace.
    * If the annotation declares an sbml namespace an error is logged.
@@ -2525,12 +2868,126 @@ protected:
   SedBase* getRootElement();
 
 
+  /**
+   * Tells the parent and the SedDocument of this element that its id or
+   * metaid has changed.
+   *
+   * Subclasses that store an id must call this from setId() and
+   * unsetId(), so that the id indexes kept by the containing SedListOf
+   * and by the SedDocument stay correct.
+   */
+  void notifyIdChanged();
+
+
+  /**
+   * Returns the SedDocument at the root of the tree this element is
+   * connected to, this element if it is a SedDocument, or @c NULL if the
+   * root is not a SedDocument.  connectToParent() keeps the document of
+   * every element up to date, so that no parent pointers are followed.
+   */
+  SedDocument* getRootDocument();
+
+
+  /**
+   * Sets the document of every element below this one to @p doc, when
+   * connectToParent() moves this element to another document.
+   */
+  void setDocumentOfChildren(SedDocument* doc);
+
+
+  /**
+   * Returns @c true if the namespace @p uri is declared with @p prefix by
+   * the SedDocument this element belongs to.  Elements written inside
+   * that document need not declare it again in writeXMLNS().
+   */
+  bool isDeclaredByDocument(const std::string& uri,
+                            const std::string& prefix) const;
+
+
+  /**
+   * Returns the SedArena of the SedDocument this element belongs to, or
+   * @c NULL if it has none; new children are allocated from it.
+   */
+  SedArena* getArena();
+
+
+  /**
+   * Shares the namespaces of this element with the other elements of its
+   * SedDocument that have equal ones.
+   */
+  void internSedNamespaces();
+
+
+  /**
+   * Makes the namespaces of this element private to it, copying them if
+   * they are shared.  Must be called before modifying mSedNamespaces.
+   */
+  void unshareSedNamespaces();
+
+
+  /**
+   * Makes sure the typed reference links of this element (for example
+   * SedTask::getReferencedModel()) are current, calling lookupReferences()
+   * if the document has changed since they were last resolved.
+   */
+  void updateReferences();
+
+
+  /**
+   * Resolves the reference attributes of this element against @p doc.
+   * Elements that refer to other elements override this; @p doc may be
+   * @c NULL, in which case every link must be cleared.
+   */
+  virtual void lookupReferences(SedDocument* doc);
+
+
+  /**
+   * Forces the typed reference links to be resolved again on next use.
+   * notifyReferencesChanged() calls this.
+   */
+  void invalidateReferences();
+
+
+  /**
+   * Forces the typed reference links to be resolved again, and files this
+   * element afresh in the reverse-reference index of its SedDocument.
+   * Setters of reference attributes call this.
+   */
+  void notifyReferencesChanged();
+
+
+  /**
+   * Adds @p child and everything below it to @p elements.  Used by
+   * getAllElements() overrides; empty SedListOf children are skipped.
+   */
+  void addAllElements(List* elements, SedBase* child);
+
+
+  /**
+   * Calls the <code>leave()</code> method of @p v for this object.
+   */
+  void leaveElement(SedVisitor& v) const;
+
+
   // ------------------------------------------------------------------
 
 
   std::string     mMetaId;
   XMLNode*        mNotes;
   XMLNode*        mAnnotation;
+
+  /* raw XML of notes/annotation read but not yet parsed into mNotes and
+   * mAnnotation; see SedDocument::setDeferNotesAndAnnotations()
+   */
+  std::string     mDeferredNotes;
+  std::string     mDeferredAnnotation;
+
+  /* notes/annotation shared with the object this one was copied from, or
+   * with its copies, until either side modifies them; see
+   * SedDocument::setShareNotesAndAnnotations()
+   */
+  SedSharedXMLNode* mSharedNotes;
+  SedSharedXMLNode* mSharedAnnotation;
   SedDocument*   mSed;
   SedNamespaces* mSedNamespaces;
   void*           mUserData;
@@ -2541,11 +2998,35 @@ protected:
   /* store the parent Sed object */
   SedBase* mParentSedObject;
 
+  /* document and index generation the reference links were resolved for */
+  SedDocument*   mResolvedDocument;
+  unsigned long  mResolvedGeneration;
+
+  /* the ancestor getAncestorOfType() last found, the type code it looked
+   * for and the index generation of the document it was found in
+   */
+  SedBase*       mCachedAncestor;
+  int            mCachedAncestorType;
+  unsigned long  mCachedAncestorGeneration;
+
   /* flag that allows object to know its been deleted
    * for OS where the memory is still readable after a delete
    */
   bool mHasBeenDeleted;
 
+  /* cleared once an incremental SedWriter has kept the XML of this object,
+   * with the depth and form it was written at (a depth of 0 means none),
+   * and set again by markDirty(); see SedWriter::setIncremental()
+   */
+  mutable bool          mDirty;
+  mutable std::string   mCachedXML;
+  mutable unsigned int  mCachedDepth;
+  mutable bool          mCachedCompact;
+
+  /* the change generation of the document this object, or anything below
+   * it, last changed in; see getChangeStamp() */
+  unsigned long         mChangeStamp;
+
   std::string mEmptyString;
 
   //
@@ -2592,6 +3073,81 @@ private:
   bool readNotes (XMLInputStream& stream);
 
 
+  /**
+   * @return true if notes and annotations read into this object should be
+   * kept as raw XML and only parsed when first accessed.
+   */
+  bool isDeferringNotesAndAnnotations ();
+
+
+  /**
+   * @return true if the notes and annotations of this object are to be
+   * shared with the copies made of it.
+   */
+  bool isSharingNotesAndAnnotations ();
+
+
+  /**
+   * @return the depth to which the document this object is read into is
+   * read, or 0 if it is read in full.
+   *
+   * @see SedDocument::setStructureOnlyDepth(unsigned int depth)
+   */
+  unsigned int getStructureOnlyDepth ();
+
+
+  /**
+   * @return the number of levels the notes and annotations of the
+   * document this object is read into may nest, or 0 for no limit.
+   *
+   * @see SedDocument::setMaxXMLDepth(unsigned int depth)
+   */
+  unsigned int getMaxXMLDepth ();
+
+
+  /**
+   * Reads notes or an annotation at the head of @p stream with
+   * SedXMLTree::read(), logging an error if they nest too deeply.
+   *
+   * @return the tree read, or @c NULL if it nests too deeply.
+   */
+  XMLNode* readXMLTree (XMLInputStream& stream);
+
+
+  /**
+   * @return the number of elements this object is nested in.
+   */
+  unsigned int getElementDepth () const;
+
+
+  /**
+   * Reads the element at the head of @p stream, including its content,
+   * into a string without building an XMLNode.  An element nesting more
+   * than @p maxDepth levels, unless that is 0, is skipped and an empty
+   * string returned.
+   */
+  static std::string readRawSubtree (XMLInputStream& stream,
+                                     unsigned int maxDepth = 0);
+
+
+  /**
+   * @return the namespaces deferred notes and annotations are parsed with.
+   */
+  const XMLNamespaces* getDeferredNamespaces ();
+
+
+  /**
+   * Parses the deferred notes, if any, into mNotes.
+   */
+  void expandDeferredNotes ();
+
+
+  /**
+   * Parses the deferred annotation, if any, into mAnnotation.
+   */
+  void expandDeferredAnnotation ();
+
+
   /** @endcond */
 };
 
@@ -2616,6 +3172,16 @@ const char *
 SedBase_getMetaId (SedBase_t *sb);
 
 
+LIBSEDML_EXTERN
+const char *
+SedBase_getIdView (const SedBase_t *sb);
+
+
+LIBSEDML_EXTERN
+const char *
+SedBase_getNameView (const SedBase_t *sb);
+
+
 
 
 LIBSEDML_EXTERN
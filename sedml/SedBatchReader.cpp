@@ -0,0 +1,343 @@
+/**
+ * @file    SedBatchReader.cpp
+ * @brief   Reads many SED-ML documents using several threads
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedBatchReader.h>
+#include <sedml/SedDocument.h>
+#include <sedml/common/threads.h>
+
+#include <cstdlib>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * State shared by the threads reading one batch.  Inputs are claimed one
+ * at a time through mNext; each result slot is written by one thread only.
+ */
+struct SedBatchJob
+{
+  const std::vector<std::string>* inputs;
+  bool                            isFile;
+  const SedReader*                reader;
+  std::vector<SedDocument*>*      results;
+  SedBatchReadHandler*            handler;
+  unsigned int                    next;
+  SedMutex                        mutex;
+};
+
+
+static void
+runBatchJob (SedBatchJob* job)
+{
+  SedReader reader(*job->reader);
+  const unsigned int size = (unsigned int)job->inputs->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int index = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (index >= size) break;
+
+    SedDocument* d = NULL;
+    try
+    {
+      const std::string& input = (*job->inputs)[index];
+      d = job->isFile ? reader.readSedML(input)
+                      : reader.readSedMLFromString(input);
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the input yields no document
+      d = NULL;
+    }
+
+    if (job->handler != NULL)
+    {
+      mutexLock(&job->mutex);
+      job->handler->documentRead(index, d);
+      mutexUnlock(&job->mutex);
+    }
+    else
+    {
+      (*job->results)[index] = d;
+    }
+  }
+}
+
+
+/*
+ * Entry point of the worker threads.
+ */
+static void
+batchThreadMain (void* arg)
+{
+  runBatchJob(static_cast<SedBatchJob*>(arg));
+}
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedBatchReadHandler.
+ */
+SedBatchReadHandler::~SedBatchReadHandler ()
+{
+}
+
+
+/*
+ * Creates a new SedBatchReader.
+ */
+SedBatchReader::SedBatchReader (unsigned int numThreads)
+  : mNumThreads (numThreads)
+  , mReader ()
+{
+}
+
+
+/*
+ * Destroys this SedBatchReader.
+ */
+SedBatchReader::~SedBatchReader ()
+{
+}
+
+
+/*
+ * Sets the number of threads used.
+ */
+void
+SedBatchReader::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next read will use at most.
+ */
+unsigned int
+SedBatchReader::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Returns the SedReader whose options are used for every document read.
+ */
+SedReader&
+SedBatchReader::getReader ()
+{
+  return mReader;
+}
+
+
+/*
+ * Reads each of the given files.
+ */
+std::vector<SedDocument*>
+SedBatchReader::readFiles (const std::vector<std::string>& filenames)
+{
+  std::vector<SedDocument*> results(filenames.size(), (SedDocument*)NULL);
+  readInternal(filenames, true, &results, NULL);
+  return results;
+}
+
+
+/*
+ * Reads each of the given files, passing the documents to handler.
+ */
+void
+SedBatchReader::readFiles (const std::vector<std::string>& filenames,
+                           SedBatchReadHandler& handler)
+{
+  readInternal(filenames, true, NULL, &handler);
+}
+
+
+/*
+ * Reads each of the given XML strings.
+ */
+std::vector<SedDocument*>
+SedBatchReader::readStrings (const std::vector<std::string>& xml)
+{
+  std::vector<SedDocument*> results(xml.size(), (SedDocument*)NULL);
+  readInternal(xml, false, &results, NULL);
+  return results;
+}
+
+
+/*
+ * Reads each of the given XML strings, passing the documents to handler.
+ */
+void
+SedBatchReader::readStrings (const std::vector<std::string>& xml,
+                             SedBatchReadHandler& handler)
+{
+  readInternal(xml, false, NULL, &handler);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Used by readFiles() and readStrings().
+ */
+void
+SedBatchReader::readInternal (const std::vector<std::string>& inputs,
+                              bool isFile,
+                              std::vector<SedDocument*>* results,
+                              SedBatchReadHandler* handler)
+{
+  if (inputs.empty()) return;
+
+  unsigned int numThreads = getNumThreads();
+  if (numThreads > inputs.size()) numThreads = (unsigned int)inputs.size();
+
+  if (numThreads > 1)
+  {
+    // let the XML parser and the reader do any initialisation of their
+    // own on this thread, before several threads parse at once
+    delete mReader.readSedMLFromString(
+      "<sedML xmlns=\"http://sed-ml.org/\" level=\"1\" version=\"1\"/>");
+  }
+
+  SedBatchJob job;
+  job.inputs  = &inputs;
+  job.isFile  = isFile;
+  job.reader  = &mReader;
+  job.results = results;
+  job.handler = handler;
+  job.next    = 0;
+  mutexInit(&job.mutex);
+
+  // the calling thread is one of the workers, so numThreads - 1 are
+  // started; if some cannot be started the remaining ones do their share
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, batchThreadMain, &job)) break;
+    threads.push_back(thread);
+  }
+
+  runBatchJob(&job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+
+  mutexFree(&job.mutex);
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedBatchReader and returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchReader_t *
+SedBatchReader_create (unsigned int numThreads)
+{
+  return new (nothrow) SedBatchReader(numThreads);
+}
+
+
+/**
+ * Frees the given SedBatchReader.
+ */
+LIBSEDML_EXTERN
+void
+SedBatchReader_free (SedBatchReader_t *sbr)
+{
+  delete sbr;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+static SedDocument_t **
+readBatch (SedBatchReader_t *sbr, const char **inputs, unsigned int length,
+           bool isFile)
+{
+  if (sbr == NULL || (inputs == NULL && length > 0)) return NULL;
+
+  std::vector<std::string> in;
+  for (unsigned int i = 0; i < length; i++)
+  {
+    in.push_back(inputs[i] != NULL ? inputs[i] : "");
+  }
+
+  std::vector<SedDocument*> docs = isFile ? sbr->readFiles(in)
+                                          : sbr->readStrings(in);
+
+  SedDocument_t ** result =
+    (SedDocument_t**)malloc(sizeof(SedDocument_t*) * (length > 0 ? length : 1));
+  if (result == NULL) return NULL;
+
+  for (unsigned int i = 0; i < length; i++)
+  {
+    result[i] = docs[i];
+  }
+
+  return result;
+}
+/** @endcond */
+
+
+/**
+ * Reads the given files.
+ */
+LIBSEDML_EXTERN
+SedDocument_t **
+SedBatchReader_readFiles (SedBatchReader_t *sbr, const char **filenames,
+                          unsigned int length)
+{
+  return readBatch(sbr, filenames, length, true);
+}
+
+
+/**
+ * Reads the given XML strings.
+ */
+LIBSEDML_EXTERN
+SedDocument_t **
+SedBatchReader_readStrings (SedBatchReader_t *sbr, const char **xml,
+                            unsigned int length)
+{
+  return readBatch(sbr, xml, length, false);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
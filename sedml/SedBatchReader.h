@@ -0,0 +1,236 @@
+/**
+ * @file    SedBatchReader.h
+ * @brief   Reads many SED-ML documents using several threads
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedBatchReader
+ * @ingroup Core
+ * @brief Reads a list of SED-ML files or strings in parallel.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedBatchReader reads each input into its own SedDocument, exactly as
+ * SedReader::readSedML() or SedReader::readSedMLFromString() would, but
+ * spreads the inputs over a pool of threads.  Every document carries its
+ * own SedErrorLog, so failures of one input do not affect the others.
+ * Results are returned either as a vector in input order or, one by one
+ * as they complete, through a SedBatchReadHandler.
+ *
+ * The reader options (see getReader()) apply to every document read.
+ *
+ * @section batch-threads Thread safety
+ *
+ * Each input is parsed by a separate SedReader and XMLInputStream into a
+ * separate SedDocument; no Sed object is ever touched by two threads.
+ * Before starting the threads, the batch reader parses a small document
+ * on the calling thread so that any one-time initialisation done by the
+ * underlying XML parser happens before parsing becomes concurrent.
+ * Calls to SedBatchReadHandler::documentRead() are serialised, but are
+ * made from the worker threads.  A SedBatchReader itself must not be used
+ * from two threads at the same time.
+ */
+
+#ifndef SedBatchReader_h
+#define SedBatchReader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedReader.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedBatchReadHandler
+{
+public:
+
+  /**
+   * Destroys this SedBatchReadHandler.
+   */
+  virtual ~SedBatchReadHandler ();
+
+
+  /**
+   * Called once for each input when it has been read.  Calls are
+   * serialised but come from the worker threads, in no particular order.
+   *
+   * @param index the position of the input in the list given to the
+   * SedBatchReader.
+   * @param document the SedDocument read; the handler takes ownership.
+   */
+  virtual void documentRead (unsigned int index, SedDocument* document) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedBatchReader
+{
+public:
+
+  /**
+   * Creates a new SedBatchReader using @p numThreads threads.  A value of
+   * zero uses one thread per available processor.
+   */
+  SedBatchReader (unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedBatchReader.
+   */
+  virtual ~SedBatchReader ();
+
+
+  /**
+   * Sets the number of threads used; zero means one per processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next read will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Returns the SedReader whose options are used for every document
+   * read, so that they can be changed.
+   */
+  SedReader& getReader ();
+
+
+  /**
+   * Reads each of the given files.
+   *
+   * @return the documents read, in the order of @p filenames; the caller
+   * owns them.
+   */
+  std::vector<SedDocument*> readFiles (const std::vector<std::string>& filenames);
+
+
+  /**
+   * Reads each of the given files, passing the documents to @p handler
+   * as they complete.
+   */
+  void readFiles (const std::vector<std::string>& filenames,
+                  SedBatchReadHandler& handler);
+
+
+  /**
+   * Reads each of the given XML strings.
+   *
+   * @return the documents read, in the order of @p xml; the caller owns
+   * them.
+   */
+  std::vector<SedDocument*> readStrings (const std::vector<std::string>& xml);
+
+
+  /**
+   * Reads each of the given XML strings, passing the documents to
+   * @p handler as they complete.
+   */
+  void readStrings (const std::vector<std::string>& xml,
+                    SedBatchReadHandler& handler);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Used by readFiles() and readStrings().
+   */
+  void readInternal (const std::vector<std::string>& inputs, bool isFile,
+                     std::vector<SedDocument*>* results,
+                     SedBatchReadHandler* handler);
+
+
+  unsigned int mNumThreads;
+  SedReader    mReader;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedBatchReader using @p numThreads threads (zero for one
+ * per processor) and returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchReader_t *
+SedBatchReader_create (unsigned int numThreads);
+
+
+/**
+ * Frees the given SedBatchReader.
+ */
+LIBSEDML_EXTERN
+void
+SedBatchReader_free (SedBatchReader_t *sbr);
+
+
+/**
+ * Reads the @p length files named in @p filenames.
+ *
+ * @return an array of @p length documents in input order, which the
+ * caller must free with free() after freeing the documents, or NULL if
+ * the arguments are invalid.
+ */
+LIBSEDML_EXTERN
+SedDocument_t **
+SedBatchReader_readFiles (SedBatchReader_t *sbr, const char **filenames,
+                          unsigned int length);
+
+
+/**
+ * Reads the @p length XML strings in @p xml.
+ *
+ * @return an array of @p length documents in input order, which the
+ * caller must free with free() after freeing the documents, or NULL if
+ * the arguments are invalid.
+ */
+LIBSEDML_EXTERN
+SedDocument_t **
+SedBatchReader_readStrings (SedBatchReader_t *sbr, const char **xml,
+                            unsigned int length);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedBatchReader_h */
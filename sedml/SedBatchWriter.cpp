@@ -0,0 +1,582 @@
+/**
+ * @file    SedBatchWriter.cpp
+ * @brief   Writes many SED-ML documents to files in parallel
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedBatchWriter.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedErrorLog.h>
+#include <sedml/SedOutputSink.h>
+#include <sedml/common/threads.h>
+
+#include <deque>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The size of the chunks documents are serialised in.
+ */
+static const size_t SED_BATCH_CHUNK = 64 * 1024;
+
+
+/*
+ * How a file is compressed, as its name tells.
+ */
+enum SedBatchCompression
+{
+  SED_BATCH_PLAIN,
+  SED_BATCH_GZIP,
+  SED_BATCH_ZSTD,
+  SED_BATCH_OTHER
+};
+
+
+/*
+ * Sink collecting a serialised document in memory.
+ */
+class SedBatchBufferSink : public SedOutputSink
+{
+public:
+
+  SedBatchBufferSink (std::string& buffer)
+    : mBuffer (buffer)
+  {
+  }
+
+  virtual bool write (const char* data, size_t length)
+  {
+    mBuffer.append(data, length);
+    return true;
+  }
+
+private:
+
+  std::string& mBuffer;
+};
+
+
+/*
+ * A serialised document waiting for a compressing thread.
+ */
+struct SedBatchBuffer
+{
+  unsigned int  index;
+  std::string*  data;
+};
+
+
+/*
+ * State shared by the threads writing one batch.  Documents are claimed
+ * one at a time through next; serialised ones wait in pending, of at most
+ * maxPending buffers.  Each result is written by one thread only.
+ */
+struct SedBatchWriteJob
+{
+  const std::vector<const SedDocument*>*  documents;
+  const std::vector<std::string>*         filenames;
+  const SedWriter*                        writer;
+  std::vector<char>*                      results;
+  unsigned int                            next;
+  unsigned int                            numSerialising;
+  unsigned int                            maxPending;
+  bool                                    pipelined;
+  std::deque<SedBatchBuffer>              pending;
+  SedMutex                                mutex;
+  SedCondition                            notFull;
+  SedCondition                            notEmpty;
+};
+
+
+/*
+ * Returns how filename is to be compressed.
+ */
+static SedBatchCompression
+getCompression (const std::string& filename)
+{
+  const size_t length = filename.length();
+  if (length >= 3 && filename.compare(length - 3, 3, ".gz") == 0)
+  {
+    return SedGzipSink::isAvailable() ? SED_BATCH_GZIP : SED_BATCH_OTHER;
+  }
+  if (length >= 4 && filename.compare(length - 4, 4, ".zst") == 0)
+  {
+    return SedZstdSink::isAvailable() ? SED_BATCH_ZSTD : SED_BATCH_OTHER;
+  }
+  if ((length >= 4 && filename.compare(length - 4, 4, ".bz2") == 0)
+    || (length >= 4 && filename.compare(length - 4, 4, ".zip") == 0))
+  {
+    return SED_BATCH_OTHER;
+  }
+  return SED_BATCH_PLAIN;
+}
+
+
+/*
+ * Logs error in the log of d, unless d is frozen.
+ */
+static void
+logWriteError (const SedDocument* d, unsigned int error)
+{
+  if (d == NULL || d->isFrozen()) return;
+  const_cast<SedDocument*>(d)->getErrorLog()->logError(error);
+}
+
+
+/*
+ * Writes the serialised document data to filename, compressed as its name
+ * tells.
+ */
+static bool
+writeBuffer (const std::string& data, const std::string& filename,
+             const SedDocument* d)
+{
+  SedFileSink file(filename);
+  if (!file.isOpen())
+  {
+    logWriteError(d, XMLFileUnwritable);
+    return false;
+  }
+
+  bool result = false;
+  switch (getCompression(filename))
+  {
+  case SED_BATCH_GZIP:
+  {
+    SedGzipSink gzip(file);
+    result = gzip.write(data.data(), data.size());
+    result = gzip.finish() && result;
+    break;
+  }
+  case SED_BATCH_ZSTD:
+  {
+    SedZstdSink zstd(file);
+    result = zstd.write(data.data(), data.size());
+    result = zstd.finish() && result;
+    break;
+  }
+  default:
+    result = file.write(data.data(), data.size());
+    result = file.finish() && result;
+    break;
+  }
+
+  if (!result) logWriteError(d, XMLFileOperationError);
+  return result;
+}
+
+
+/*
+ * Hands buffer on to the compressing threads, waiting while the queue is
+ * full.
+ */
+static void
+pushBuffer (SedBatchWriteJob* job, const SedBatchBuffer& buffer)
+{
+  mutexLock(&job->mutex);
+  while (job->pending.size() >= job->maxPending)
+  {
+    conditionWait(&job->notFull, &job->mutex);
+  }
+  job->pending.push_back(buffer);
+  conditionBroadcast(&job->notEmpty);
+  mutexUnlock(&job->mutex);
+}
+
+
+static void
+runSerialiseJob (SedBatchWriteJob* job)
+{
+  SedWriter writer(*job->writer);
+  const unsigned int size = (unsigned int)job->documents->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int index = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (index >= size) break;
+
+    const SedDocument* d        = (*job->documents)[index];
+    const std::string& filename = (*job->filenames)[index];
+
+    if (d == NULL)
+    {
+      (*job->results)[index] = false;
+      continue;
+    }
+
+    if (!job->pipelined || getCompression(filename) == SED_BATCH_OTHER)
+    {
+      try
+      {
+        (*job->results)[index] = writer.writeSedML(d, filename);
+      }
+      catch (...)
+      {
+        // nothing may escape a worker thread; the document is not written
+        (*job->results)[index] = false;
+      }
+      continue;
+    }
+
+    std::string* data = new (nothrow) std::string();
+    bool written = false;
+    if (data != NULL)
+    {
+      try
+      {
+        SedBatchBufferSink sink(*data);
+        written = writer.writeSedML(d, sink, SED_BATCH_CHUNK);
+      }
+      catch (...)
+      {
+        // nothing may escape a worker thread; the document is not written
+        written = false;
+      }
+    }
+
+    if (!written)
+    {
+      delete data;
+      (*job->results)[index] = false;
+      continue;
+    }
+
+    SedBatchBuffer buffer;
+    buffer.index = index;
+    buffer.data  = data;
+    pushBuffer(job, buffer);
+  }
+
+  // the last serialising thread to finish wakes the compressing threads
+  // waiting for buffers that will not come
+  mutexLock(&job->mutex);
+  --job->numSerialising;
+  conditionBroadcast(&job->notEmpty);
+  mutexUnlock(&job->mutex);
+}
+
+
+static void
+runCompressJob (SedBatchWriteJob* job)
+{
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    while (job->pending.empty() && job->numSerialising > 0)
+    {
+      conditionWait(&job->notEmpty, &job->mutex);
+    }
+    if (job->pending.empty())
+    {
+      mutexUnlock(&job->mutex);
+      break;
+    }
+    SedBatchBuffer buffer = job->pending.front();
+    job->pending.pop_front();
+    conditionBroadcast(&job->notFull);
+    mutexUnlock(&job->mutex);
+
+    const SedDocument* d = (*job->documents)[buffer.index];
+    bool result = false;
+    try
+    {
+      result = writeBuffer(*buffer.data, (*job->filenames)[buffer.index], d);
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the document is not written
+      result = false;
+    }
+
+    delete buffer.data;
+    (*job->results)[buffer.index] = result;
+  }
+}
+
+
+/*
+ * Entry points of the worker threads.
+ */
+static void
+serialiseThreadMain (void* arg)
+{
+  runSerialiseJob(static_cast<SedBatchWriteJob*>(arg));
+}
+
+
+static void
+compressThreadMain (void* arg)
+{
+  runCompressJob(static_cast<SedBatchWriteJob*>(arg));
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedBatchWriter.
+ */
+SedBatchWriter::SedBatchWriter (unsigned int numThreads,
+                                unsigned int numCompressors)
+  : mNumThreads (numThreads)
+  , mNumCompressors (numCompressors)
+  , mMaxPending (0)
+  , mWriter ()
+{
+}
+
+
+/*
+ * Destroys this SedBatchWriter.
+ */
+SedBatchWriter::~SedBatchWriter ()
+{
+}
+
+
+/*
+ * Sets the number of serialising threads.
+ */
+void
+SedBatchWriter::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of serialising threads the next batch will use.
+ */
+unsigned int
+SedBatchWriter::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Sets the number of compressing threads.
+ */
+void
+SedBatchWriter::setNumCompressors (unsigned int numCompressors)
+{
+  mNumCompressors = numCompressors;
+}
+
+
+/*
+ * Returns the number of compressing threads the next batch will use.
+ */
+unsigned int
+SedBatchWriter::getNumCompressors () const
+{
+  if (mNumCompressors > 0) return mNumCompressors;
+
+  const unsigned int half = getNumProcessors() / 2;
+  return (half > 0) ? half : 1;
+}
+
+
+/*
+ * Sets how many serialised documents may wait at most.
+ */
+void
+SedBatchWriter::setMaxPending (unsigned int maxPending)
+{
+  mMaxPending = maxPending;
+}
+
+
+/*
+ * Returns how many serialised documents may wait at most.
+ */
+unsigned int
+SedBatchWriter::getMaxPending () const
+{
+  return (mMaxPending == 0) ? 2 * getNumCompressors() : mMaxPending;
+}
+
+
+/*
+ * Returns the SedWriter whose options are used for every document.
+ */
+SedWriter&
+SedBatchWriter::getWriter ()
+{
+  return mWriter;
+}
+
+
+/*
+ * Writes each document to its file.
+ */
+std::vector<bool>
+SedBatchWriter::writeFiles (const std::vector<const SedDocument*>& documents,
+                            const std::vector<std::string>& filenames)
+{
+  std::vector<bool> written(documents.size(), false);
+  if (documents.empty() || documents.size() != filenames.size())
+  {
+    return written;
+  }
+
+  std::vector<char> results(documents.size(), 0);
+
+  unsigned int numThreads = getNumThreads();
+  if (numThreads > documents.size())
+  {
+    numThreads = (unsigned int)documents.size();
+  }
+
+  SedBatchWriteJob job;
+  job.documents      = &documents;
+  job.filenames      = &filenames;
+  job.writer         = &mWriter;
+  job.results        = &results;
+  job.next           = 0;
+  job.numSerialising = numThreads;
+  job.maxPending     = getMaxPending();
+  job.pipelined      = false;
+  mutexInit(&job.mutex);
+  conditionInit(&job.notFull);
+  conditionInit(&job.notEmpty);
+
+  // the compressing threads start first: without any, the serialising
+  // threads write the files themselves rather than wait for them
+  std::vector<SedThread> compressors;
+  const unsigned int numCompressors = getNumCompressors();
+  for (unsigned int i = 0; i < numCompressors; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, compressThreadMain, &job)) break;
+    compressors.push_back(thread);
+  }
+
+  job.pipelined = !compressors.empty();
+
+  // the calling thread is one of the serialising threads, so
+  // numThreads - 1 are started; if some cannot be started the remaining
+  // ones do their share
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, serialiseThreadMain, &job))
+    {
+      mutexLock(&job.mutex);
+      job.numSerialising -= numThreads - i;
+      mutexUnlock(&job.mutex);
+      break;
+    }
+    threads.push_back(thread);
+  }
+
+  runSerialiseJob(&job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+  for (unsigned int i = 0; i < compressors.size(); i++)
+  {
+    joinThread(compressors[i]);
+  }
+
+  conditionFree(&job.notEmpty);
+  conditionFree(&job.notFull);
+  mutexFree(&job.mutex);
+
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    written[i] = (results[i] != 0);
+  }
+  return written;
+}
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedBatchWriter and returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchWriter_t *
+SedBatchWriter_create (unsigned int numThreads, unsigned int numCompressors)
+{
+  return new (nothrow) SedBatchWriter(numThreads, numCompressors);
+}
+
+
+/**
+ * Frees the given SedBatchWriter.
+ */
+LIBSEDML_EXTERN
+void
+SedBatchWriter_free (SedBatchWriter_t *sbw)
+{
+  delete sbw;
+}
+
+
+/**
+ * Writes the given documents to the given files.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedBatchWriter_writeFiles (SedBatchWriter_t *sbw,
+                           const SedDocument_t **documents,
+                           const char **filenames, unsigned int length)
+{
+  if (sbw == NULL || ((documents == NULL || filenames == NULL) && length > 0))
+  {
+    return length;
+  }
+
+  std::vector<const SedDocument*> docs(documents, documents + length);
+  std::vector<std::string> names;
+  for (unsigned int i = 0; i < length; i++)
+  {
+    names.push_back(filenames[i] != NULL ? filenames[i] : "");
+  }
+
+  std::vector<bool> written = sbw->writeFiles(docs, names);
+
+  unsigned int numFailed = 0;
+  for (unsigned int i = 0; i < length; i++)
+  {
+    if (!written[i]) ++numFailed;
+  }
+  return numFailed;
+}
+
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
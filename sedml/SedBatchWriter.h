@@ -0,0 +1,220 @@
+/**
+ * @file    SedBatchWriter.h
+ * @brief   Writes many SED-ML documents to files in parallel
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedBatchWriter
+ * @ingroup Core
+ * @brief Writes a list of SedDocument objects to files in parallel.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedBatchWriter writes each document to its file as
+ * SedWriter::writeSedML() would, in two stages running at the same time:
+ *
+ * @li the serialising threads, the calling thread and
+ * getNumThreads() - 1 others, write the documents to memory with the
+ * SedWriter returned by getWriter();
+ * @li the getNumCompressors() compressing threads take the buffers in
+ * the order they were written, compress them with a SedGzipSink or a
+ * SedZstdSink if the file name ends in @em .gz or @em .zst, and write
+ * them to their files with a SedFileSink.
+ *
+ * At most getMaxPending() buffers wait for the compressing threads; a
+ * serialising thread with a buffer to hand on while that many are
+ * waiting waits itself, so that a slow disk or slow compression holds
+ * the serialising back instead of filling the memory.  Files ending in
+ * @em .bz2 or @em .zip, and @em .gz or @em .zst files when libSEDML has
+ * not been built with the library, are written by the serialising threads
+ * with SedWriter::writeSedML() directly, as are all files if no
+ * compressing thread can be started.
+ *
+ * Failures are logged, as SedWriter logs them, in the SedErrorLog of the
+ * document that failed, unless it is frozen.
+ *
+ * @section batch-writer-threads Thread safety
+ *
+ * Every document is written by one serialising thread and its buffer
+ * compressed by one compressing thread, never by two threads at once; a
+ * document may only appear in the batch more than once if it is frozen
+ * (see SedDocument::freeze()).  No other thread may change the documents
+ * while they are written.  A SedBatchWriter itself must not be used from
+ * two threads at the same time.
+ */
+
+#ifndef SedBatchWriter_h
+#define SedBatchWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedWriter.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedBatchWriter
+{
+public:
+
+  /**
+   * Creates a new SedBatchWriter serialising with @p numThreads threads
+   * and compressing with @p numCompressors threads.  A value of zero uses
+   * one thread per available processor for serialising, and half as many,
+   * but at least one, for compressing.
+   */
+  SedBatchWriter (unsigned int numThreads = 0,
+                  unsigned int numCompressors = 0);
+
+
+  /**
+   * Destroys this SedBatchWriter.
+   */
+  virtual ~SedBatchWriter ();
+
+
+  /**
+   * Sets the number of serialising threads; zero means one per
+   * processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of serialising threads the next batch will use at
+   * most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Sets the number of compressing threads; zero means half the number
+   * of processors, but at least one.
+   */
+  void setNumCompressors (unsigned int numCompressors);
+
+
+  /**
+   * @return the number of compressing threads the next batch will use at
+   * most.
+   */
+  unsigned int getNumCompressors () const;
+
+
+  /**
+   * Sets how many serialised documents may wait for the compressing
+   * threads at most; zero means twice the number of compressing threads.
+   */
+  void setMaxPending (unsigned int maxPending);
+
+
+  /**
+   * @return how many serialised documents may wait for the compressing
+   * threads at most.
+   */
+  unsigned int getMaxPending () const;
+
+
+  /**
+   * Returns the SedWriter whose options are used for every document
+   * written, so that they can be changed.
+   */
+  SedWriter& getWriter ();
+
+
+  /**
+   * Writes each of @p documents to the file of the same index in
+   * @p filenames.
+   *
+   * @return for each document, @c true if it was written; all are
+   * @c false if the two lists differ in length.
+   */
+  std::vector<bool> writeFiles (const std::vector<const SedDocument*>& documents,
+                                const std::vector<std::string>& filenames);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  unsigned int mNumThreads;
+  unsigned int mNumCompressors;
+  unsigned int mMaxPending;
+  SedWriter    mWriter;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedBatchWriter using @p numThreads serialising and
+ * @p numCompressors compressing threads (zero for the defaults) and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedBatchWriter_t *
+SedBatchWriter_create (unsigned int numThreads, unsigned int numCompressors);
+
+
+/**
+ * Frees the given SedBatchWriter.
+ */
+LIBSEDML_EXTERN
+void
+SedBatchWriter_free (SedBatchWriter_t *sbw);
+
+
+/**
+ * Writes the @p length documents in @p documents to the files named in
+ * @p filenames.
+ *
+ * @return the number of documents that could not be written, or
+ * @p length if the arguments are invalid.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedBatchWriter_writeFiles (SedBatchWriter_t *sbw,
+                           const SedDocument_t **documents,
+                           const char **filenames, unsigned int length);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedBatchWriter_h */
@@ -0,0 +1,1131 @@
+/**
+ * @file    SedBinaryCodec.cpp
+ * @brief   Compact binary encoding of SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedBinaryCodec.h>
+#include <sedml/SedTypes.h>
+
+#include <sbml/xml/XMLNode.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/util/util.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const char         sMagic[]       = { 'S', 'E', 'D', 'B' };
+static const size_t       sMagicLength   = sizeof(sMagic);
+static const unsigned int sFormatVersion = 2;
+
+/* the kinds of XML nodes */
+static const unsigned int XML_ELEMENT    = 0;
+static const unsigned int XML_TEXT       = 1;
+
+/* bits of the byte telling what an ASTNode carries besides its type */
+static const unsigned int AST_HAS_NAME   = 0x1;
+static const unsigned int AST_IS_BVAR    = 0x2;
+
+
+/*
+ * Appends the parts of an encoding to a string; the strings written are
+ * collected in a table shared by all Outputs of one encoding.
+ */
+class SedBinaryCodec::Output
+{
+public:
+
+  typedef std::map<std::string, unsigned long> StringTable;
+
+  Output (std::string& data, StringTable& strings)
+    : mData (data)
+    , mStrings (strings)
+  {
+  }
+
+  StringTable& getStrings ()
+  {
+    return mStrings;
+  }
+
+  void writeBytes (const char* bytes, size_t length)
+  {
+    mData.append(bytes, length);
+  }
+
+  void writeUnsigned (unsigned long value)
+  {
+    while (value >= 0x80)
+    {
+      mData += static_cast<char>((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    mData += static_cast<char>(value);
+  }
+
+  void writeSigned (long value)
+  {
+    // zigzag: small negative numbers get small codes as well
+    const unsigned long bits = static_cast<unsigned long>(value);
+    writeUnsigned((value < 0) ? ~(bits << 1) : (bits << 1));
+  }
+
+  void writeFixed32 (unsigned long value)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      mData += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+  }
+
+  void writeDouble (double value)
+  {
+    unsigned char bytes[sizeof(double)];
+    memcpy(bytes, &value, sizeof(double));
+    if (!isLittleEndian()) reverse(bytes);
+    writeBytes(reinterpret_cast<const char*>(bytes), sizeof(double));
+  }
+
+  /*
+   * Writes the index of value in the string table, adding it if needed.
+   */
+  void writeString (const std::string& value)
+  {
+    StringTable::const_iterator it = mStrings.find(value);
+    if (it == mStrings.end())
+    {
+      const unsigned long index = static_cast<unsigned long>(mStrings.size());
+      it = mStrings.insert(std::make_pair(value, index)).first;
+    }
+
+    writeUnsigned(it->second);
+  }
+
+  /*
+   * Writes the length of body followed by body.
+   */
+  void writeBlock (const std::string& body)
+  {
+    writeUnsigned(static_cast<unsigned long>(body.size()));
+    mData += body;
+  }
+
+  static bool isLittleEndian ()
+  {
+    const unsigned int one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 1;
+  }
+
+  static void reverse (unsigned char* bytes)
+  {
+    for (size_t i = 0; i < sizeof(double) / 2; ++i)
+    {
+      const unsigned char c = bytes[i];
+      bytes[i] = bytes[sizeof(double) - 1 - i];
+      bytes[sizeof(double) - 1 - i] = c;
+    }
+  }
+
+private:
+
+  std::string&  mData;
+  StringTable&  mStrings;
+};
+
+/** @endcond */
+
+
+/*
+ * Creates an Input that has nothing to read.
+ */
+SedBinaryCodec::Input::Input ()
+  : mPos (NULL)
+  , mEnd (NULL)
+  , mFailed (true)
+  , mOffsets (NULL)
+  , mStrings (NULL)
+  , mNumStrings (0)
+  , mStringsLength (0)
+{
+}
+
+
+/*
+ * Creates an Input reading the length bytes at data.
+ */
+SedBinaryCodec::Input::Input (const char* data, size_t length)
+  : mPos (reinterpret_cast<const unsigned char*>(data))
+  , mEnd (reinterpret_cast<const unsigned char*>(data) + length)
+  , mFailed (data == NULL)
+  , mOffsets (NULL)
+  , mStrings (NULL)
+  , mNumStrings (0)
+  , mStringsLength (0)
+{
+}
+
+
+/*
+ * Reads the magic bytes, format version and string table.
+ */
+bool
+SedBinaryCodec::Input::readHeader ()
+{
+  if (!isGood() || static_cast<size_t>(mEnd - mPos) < sMagicLength
+      || memcmp(mPos, sMagic, sMagicLength) != 0)
+  {
+    fail();
+    return false;
+  }
+  mPos += sMagicLength;
+
+  if (readUnsigned() != sFormatVersion)
+  {
+    fail();
+    return false;
+  }
+
+  const unsigned long numStrings    = readUnsigned();
+  const unsigned long stringsLength = readUnsigned();
+  if (!isGood()
+      || numStrings > static_cast<unsigned long>(mEnd - mPos) / 4)
+  {
+    fail();
+    return false;
+  }
+
+  const unsigned char* offsets = mPos;
+  mPos += 4 * numStrings;
+
+  // every string is followed by a NUL, so that they can be handed out
+  // as C strings; ending the data with one is enough for that to be safe
+  if (stringsLength > static_cast<unsigned long>(mEnd - mPos)
+      || (numStrings > 0 && (stringsLength == 0 || mPos[stringsLength - 1] != 0)))
+  {
+    fail();
+    return false;
+  }
+
+  mOffsets       = offsets;
+  mStrings       = reinterpret_cast<const char*>(mPos);
+  mNumStrings    = numStrings;
+  mStringsLength = stringsLength;
+  mPos += stringsLength;
+
+  return true;
+}
+
+
+bool
+SedBinaryCodec::Input::isGood () const
+{
+  return !mFailed;
+}
+
+
+bool
+SedBinaryCodec::Input::atEnd () const
+{
+  return mPos == mEnd;
+}
+
+
+void
+SedBinaryCodec::Input::fail ()
+{
+  mFailed = true;
+  mPos = mEnd;
+}
+
+
+/*
+ * Returns an Input reading the next length bytes, which this one skips.
+ */
+SedBinaryCodec::Input
+SedBinaryCodec::Input::readBlock ()
+{
+  const unsigned long length = readUnsigned();
+
+  Input block(*this);
+  if (!isGood() || length > static_cast<unsigned long>(mEnd - mPos))
+  {
+    fail();
+    block.fail();
+    return block;
+  }
+
+  block.mEnd = mPos + length;
+  mPos += length;
+  return block;
+}
+
+
+unsigned long
+SedBinaryCodec::Input::readUnsigned ()
+{
+  unsigned long value = 0;
+  for (unsigned int shift = 0; shift < 8 * sizeof(unsigned long); shift += 7)
+  {
+    if (mPos == mEnd) break;
+
+    const unsigned char byte = *mPos++;
+    value |= static_cast<unsigned long>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+
+  fail();
+  return 0;
+}
+
+
+long
+SedBinaryCodec::Input::readSigned ()
+{
+  const unsigned long bits = readUnsigned();
+  return static_cast<long>((bits & 1) ? ~(bits >> 1) : (bits >> 1));
+}
+
+
+double
+SedBinaryCodec::Input::readDouble ()
+{
+  unsigned char bytes[sizeof(double)];
+  double value = 0;
+
+  if (static_cast<size_t>(mEnd - mPos) < sizeof(double))
+  {
+    fail();
+    return value;
+  }
+
+  memcpy(bytes, mPos, sizeof(double));
+  mPos += sizeof(double);
+
+  if (!Output::isLittleEndian()) Output::reverse(bytes);
+  memcpy(&value, bytes, sizeof(double));
+  return value;
+}
+
+
+/*
+ * Reads a count of items each taking at least one byte, so that a corrupt
+ * count cannot make the reader loop or allocate for long.
+ */
+unsigned long
+SedBinaryCodec::Input::readCount ()
+{
+  const unsigned long count = readUnsigned();
+  if (count > static_cast<unsigned long>(mEnd - mPos))
+  {
+    fail();
+    return 0;
+  }
+  return count;
+}
+
+
+/*
+ * Reads the index of a string and returns the string, which lives as long
+ * as the data read.
+ */
+const char*
+SedBinaryCodec::Input::readString ()
+{
+  const unsigned long index = readUnsigned();
+  if (!isGood() || index >= mNumStrings)
+  {
+    fail();
+    return "";
+  }
+
+  const unsigned char* bytes = mOffsets + 4 * index;
+  const unsigned long offset = static_cast<unsigned long>(bytes[0])
+                             | static_cast<unsigned long>(bytes[1]) << 8
+                             | static_cast<unsigned long>(bytes[2]) << 16
+                             | static_cast<unsigned long>(bytes[3]) << 24;
+  if (offset >= mStringsLength)
+  {
+    fail();
+    return "";
+  }
+
+  return mStrings + offset;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+static void
+encodeAttributes (SedBinaryCodec::Output& out, const XMLAttributes& attributes)
+{
+  out.writeUnsigned(static_cast<unsigned long>(attributes.getLength()));
+  for (int i = 0; i < attributes.getLength(); ++i)
+  {
+    out.writeString(attributes.getName(i));
+    out.writeString(attributes.getPrefix(i));
+    out.writeString(attributes.getURI(i));
+    out.writeString(attributes.getValue(i));
+  }
+}
+
+
+static void
+decodeAttributes (SedBinaryCodec::Input& in, XMLAttributes& attributes)
+{
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    const std::string name   = in.readString();
+    const std::string prefix = in.readString();
+    const std::string uri    = in.readString();
+    const std::string value  = in.readString();
+
+    attributes.add(name, value, uri, prefix);
+  }
+}
+
+
+static void
+encodeNamespaces (SedBinaryCodec::Output& out, const XMLNamespaces* xmlns)
+{
+  const int count = (xmlns != NULL) ? xmlns->getLength() : 0;
+
+  out.writeUnsigned(static_cast<unsigned long>(count));
+  for (int i = 0; i < count; ++i)
+  {
+    out.writeString(xmlns->getPrefix(i));
+    out.writeString(xmlns->getURI(i));
+  }
+}
+
+
+static void
+decodeNamespaces (SedBinaryCodec::Input& in, XMLNamespaces& xmlns)
+{
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    const std::string prefix = in.readString();
+    const std::string uri    = in.readString();
+
+    xmlns.add(uri, prefix);
+  }
+}
+
+
+static void
+encodeXMLNode (SedBinaryCodec::Output& out, const XMLNode& node)
+{
+  if (node.isText())
+  {
+    out.writeUnsigned(XML_TEXT);
+    out.writeString(node.getCharacters());
+    return;
+  }
+
+  out.writeUnsigned(XML_ELEMENT);
+  out.writeString(node.getName());
+  out.writeString(node.getPrefix());
+  out.writeString(node.getURI());
+  encodeAttributes(out, node.getAttributes());
+  encodeNamespaces(out, &node.getNamespaces());
+
+  out.writeUnsigned(node.getNumChildren());
+  for (unsigned int i = 0; i < node.getNumChildren(); ++i)
+  {
+    encodeXMLNode(out, node.getChild(i));
+  }
+}
+
+
+/*
+ * Returns the node read, which the caller owns, or NULL.
+ */
+static XMLNode*
+decodeXMLNode (SedBinaryCodec::Input& in, unsigned int depth = 0)
+{
+  // encodings are trusted no more than XML input: bound the recursion
+  if (depth > 1000)
+  {
+    in.fail();
+    return NULL;
+  }
+
+  const unsigned long kind = in.readUnsigned();
+  if (kind == XML_TEXT)
+  {
+    const std::string characters = in.readString();
+    return in.isGood() ? new XMLNode(characters) : NULL;
+  }
+  else if (kind != XML_ELEMENT)
+  {
+    in.fail();
+    return NULL;
+  }
+
+  const std::string name   = in.readString();
+  const std::string prefix = in.readString();
+  const std::string uri    = in.readString();
+
+  XMLAttributes attributes;
+  decodeAttributes(in, attributes);
+
+  XMLNamespaces xmlns;
+  decodeNamespaces(in, xmlns);
+
+  if (!in.isGood()) return NULL;
+
+  XMLNode* node = new XMLNode(XMLTriple(name, uri, prefix), attributes, xmlns);
+
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    XMLNode* child = decodeXMLNode(in, depth + 1);
+    if (child != NULL) node->addChild(*child);
+    delete child;
+  }
+
+  if (!in.isGood())
+  {
+    delete node;
+    return NULL;
+  }
+
+  return node;
+}
+
+
+static void
+encodeMath (SedBinaryCodec::Output& out, const ASTNode& node)
+{
+  const ASTNodeType_t type = node.getType();
+  const bool hasName = (node.isName() || type == AST_FUNCTION
+                        || type == AST_FUNCTION_DELAY)
+                       && node.getName() != NULL;
+
+  out.writeSigned(static_cast<long>(type));
+  out.writeUnsigned((hasName ? AST_HAS_NAME : 0)
+                    | (node.isBvar() ? AST_IS_BVAR : 0));
+
+  if (hasName) out.writeString(node.getName());
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    out.writeSigned(node.getInteger());
+    break;
+  case AST_REAL:
+    out.writeDouble(node.getReal());
+    break;
+  case AST_REAL_E:
+    out.writeDouble(node.getMantissa());
+    out.writeSigned(node.getExponent());
+    break;
+  case AST_RATIONAL:
+    out.writeSigned(node.getNumerator());
+    out.writeSigned(node.getDenominator());
+    break;
+  default:
+    break;
+  }
+
+  out.writeUnsigned(node.getNumChildren());
+  for (unsigned int i = 0; i < node.getNumChildren(); ++i)
+  {
+    encodeMath(out, *node.getChild(i));
+  }
+}
+
+
+/*
+ * Returns the tree read, which the caller owns, or NULL.
+ */
+static ASTNode*
+decodeMath (SedBinaryCodec::Input& in, unsigned int depth = 0)
+{
+  if (depth > 1000)
+  {
+    in.fail();
+    return NULL;
+  }
+
+  const ASTNodeType_t type  = static_cast<ASTNodeType_t>(in.readSigned());
+  const unsigned long flags = in.readUnsigned();
+
+  ASTNode* node = new ASTNode(type);
+
+  if (flags & AST_HAS_NAME) node->setName(in.readString());
+  if (flags & AST_IS_BVAR)  node->setBvar();
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    node->setValue(in.readSigned());
+    break;
+  case AST_REAL:
+    node->setValue(in.readDouble());
+    break;
+  case AST_REAL_E:
+    {
+      const double mantissa = in.readDouble();
+      node->setValue(mantissa, in.readSigned());
+    }
+    break;
+  case AST_RATIONAL:
+    {
+      const long numerator = in.readSigned();
+      node->setValue(numerator, in.readSigned());
+    }
+    break;
+  default:
+    break;
+  }
+
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    ASTNode* child = decodeMath(in, depth + 1);
+    if (child != NULL) node->addChild(child);
+  }
+
+  if (!in.isGood())
+  {
+    delete node;
+    return NULL;
+  }
+
+  return node;
+}
+
+
+static const ASTNode*
+getMath (const SedBase* element)
+{
+  switch (element->getTypeCode())
+  {
+  case SEDML_DATAGENERATOR:
+    return static_cast<const SedDataGenerator*>(element)->getMath();
+  case SEDML_CHANGE_COMPUTECHANGE:
+    return static_cast<const SedComputeChange*>(element)->getMath();
+  default:
+    return NULL;
+  }
+}
+
+
+static int
+setMath (SedBase* element, const ASTNode* math)
+{
+  switch (element->getTypeCode())
+  {
+  case SEDML_DATAGENERATOR:
+    return static_cast<SedDataGenerator*>(element)->setMath(math);
+  case SEDML_CHANGE_COMPUTECHANGE:
+    return static_cast<SedComputeChange*>(element)->setMath(math);
+  default:
+    return LIBSEDML_INVALID_OBJECT;
+  }
+}
+
+
+/*
+ * Returns a new item of a SedListOf named name, or NULL.
+ */
+static SedBase*
+createItem (const std::string& name, SedNamespaces* sedns)
+{
+  if      (name == "model")             return new SedModel(sedns);
+  else if (name == "changeAttribute")   return new SedChangeAttribute(sedns);
+  else if (name == "removeXML")         return new SedRemoveXML(sedns);
+  else if (name == "computeChange")     return new SedComputeChange(sedns);
+  else if (name == "uniformTimeCourse") return new SedUniformTimeCourse(sedns);
+  else if (name == "task")              return new SedTask(sedns);
+  else if (name == "dataGenerator")     return new SedDataGenerator(sedns);
+  else if (name == "variable")          return new SedVariable(sedns);
+  else if (name == "parameter")         return new SedParameter(sedns);
+  else if (name == "report")            return new SedReport(sedns);
+  else if (name == "plot2D")            return new SedPlot2D(sedns);
+  else if (name == "plot3D")            return new SedPlot3D(sedns);
+  else if (name == "dataSet")           return new SedDataSet(sedns);
+  else if (name == "curve")             return new SedCurve(sedns);
+  else if (name == "surface")           return new SedSurface(sedns);
+
+  return NULL;
+}
+
+
+/** @endcond */
+
+
+/*
+ * Returns the version of the format encode() writes.
+ */
+unsigned int
+SedBinaryCodec::getFormatVersion ()
+{
+  return sFormatVersion;
+}
+
+
+/*
+ * Returns the encoding of doc, or an empty string if it cannot be encoded.
+ */
+std::string
+SedBinaryCodec::encode (const SedDocument* doc)
+{
+  return encodeObject(doc);
+}
+
+
+/*
+ * Returns the encoding of element and everything below it, or an empty
+ * string if it cannot be encoded.
+ */
+std::string
+SedBinaryCodec::encodeObject (const SedBase* element)
+{
+  std::string data;
+  if (element == NULL) return data;
+
+  Output::StringTable strings;
+
+  std::string body;
+  Output out(body, strings);
+  out.writeUnsigned(element->getLevel());
+  out.writeUnsigned(element->getVersion());
+  encodeNamespaces(out, element->getNamespaces());
+  out.writeUnsigned(static_cast<unsigned long>(element->getTypeCode()));
+  out.writeString(element->getElementName());
+
+  std::string elementBody;
+  Output elementOut(elementBody, strings);
+  if (!encodeElement(elementOut, element)) return data;
+  out.writeBlock(elementBody);
+
+  // the string table goes first, so that a reader can look strings up
+  // by index wherever it starts reading
+  std::vector<const std::string*> ordered(strings.size());
+  for (Output::StringTable::const_iterator it = strings.begin();
+       it != strings.end(); ++it)
+  {
+    ordered[it->second] = &it->first;
+  }
+
+  Output::StringTable unused;
+  Output header(data, unused);
+  header.writeBytes(sMagic, sMagicLength);
+  header.writeUnsigned(sFormatVersion);
+  header.writeUnsigned(static_cast<unsigned long>(ordered.size()));
+
+  std::string characters;
+  for (size_t i = 0; i < ordered.size(); ++i)
+  {
+    characters.append(ordered[i]->c_str(), ordered[i]->size() + 1);
+  }
+  header.writeUnsigned(static_cast<unsigned long>(characters.size()));
+
+  unsigned long offset = 0;
+  for (size_t i = 0; i < ordered.size(); ++i)
+  {
+    header.writeFixed32(offset);
+    offset += static_cast<unsigned long>(ordered[i]->size() + 1);
+  }
+
+  data += characters;
+  data += body;
+
+  return data;
+}
+
+
+/*
+ * Returns a new SedDocument built from data.
+ */
+SedDocument*
+SedBinaryCodec::decode (const std::string& data)
+{
+  return decode(data.data(), data.size());
+}
+
+
+/*
+ * Returns a new SedDocument built from the length bytes at data.
+ */
+SedDocument*
+SedBinaryCodec::decode (const char* data, size_t length)
+{
+  SedBase* object = decodeObject(data, length);
+  if (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+  {
+    delete object;
+    return NULL;
+  }
+
+  return static_cast<SedDocument*>(object);
+}
+
+
+/*
+ * Returns a new object built from data.
+ */
+SedBase*
+SedBinaryCodec::decodeObject (const std::string& data)
+{
+  return decodeObject(data.data(), data.size());
+}
+
+
+/*
+ * Returns a new object built from the length bytes at data.
+ */
+SedBase*
+SedBinaryCodec::decodeObject (const char* data, size_t length)
+{
+  Input in(data, length);
+  if (!in.readHeader()) return NULL;
+
+  const unsigned long level   = in.readUnsigned();
+  const unsigned long version = in.readUnsigned();
+
+  XMLNamespaces xmlns;
+  decodeNamespaces(in, xmlns);
+
+  const unsigned long typeCode = in.readUnsigned();
+  const std::string   name     = in.readString();
+
+  if (!in.isGood()) return NULL;
+
+  SedBase* object = createObject(static_cast<unsigned int>(level),
+                                 static_cast<unsigned int>(version),
+                                 xmlns, name);
+  if (object == NULL) return NULL;
+
+  Input body = in.readBlock();
+  if (static_cast<unsigned long>(object->getTypeCode()) != typeCode
+      || !decodeElement(body, object))
+  {
+    delete object;
+    return NULL;
+  }
+
+  return object;
+}
+
+
+/*
+ * Returns true if data starts with the magic bytes of the encoding.
+ */
+bool
+SedBinaryCodec::isEncoded (const char* data, size_t length)
+{
+  return data != NULL && length >= sMagicLength
+    && memcmp(data, sMagic, sMagicLength) == 0;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Writes element, which the caller has written the type code and name
+ * of, and everything below it; the caller writes the result as a block.
+ * Returns false if any of it cannot be encoded.
+ */
+bool
+SedBinaryCodec::encodeElement (Output& out, const SedBase* element)
+{
+  XMLAttributes attributes;
+  element->addAttributes(attributes);
+  encodeAttributes(out, attributes);
+
+  const XMLNode* notes      = element->isSetNotes()
+                              ? element->getNotes() : NULL;
+  const XMLNode* annotation = element->isSetAnnotation()
+                              ? element->getAnnotation() : NULL;
+
+  // deferred notes and annotations are parsed here; those that do not
+  // parse would be lost
+  if ((element->isSetNotes() && notes == NULL)
+      || (element->isSetAnnotation() && annotation == NULL))
+  {
+    return false;
+  }
+
+  const ASTNode* math       = getMath(element);
+
+  out.writeUnsigned((notes      != NULL ? HAS_NOTES      : 0)
+                    | (annotation != NULL ? HAS_ANNOTATION : 0)
+                    | (math       != NULL ? HAS_MATH       : 0));
+
+  // notes, annotation and math are written as blocks, so that views can
+  // skip them
+  std::string block;
+  Output blockOut(block, out.getStrings());
+
+  if (notes != NULL)
+  {
+    encodeXMLNode(blockOut, *notes);
+    out.writeBlock(block);
+    block.clear();
+  }
+
+  if (annotation != NULL)
+  {
+    encodeXMLNode(blockOut, *annotation);
+    out.writeBlock(block);
+    block.clear();
+  }
+
+  if (math != NULL)
+  {
+    encodeMath(blockOut, *math);
+    out.writeBlock(block);
+    block.clear();
+  }
+
+  // children are written with their slot, the index getChildElement()
+  // returns them for, as objects that are not lists may leave slots empty
+  const unsigned int numSlots = element->getNumChildElements();
+
+  unsigned int numChildren = 0;
+  for (unsigned int n = 0; n < numSlots; ++n)
+  {
+    if (element->getChildElement(n) != NULL) ++numChildren;
+  }
+
+  out.writeUnsigned(numChildren);
+  for (unsigned int n = 0; n < numSlots; ++n)
+  {
+    const SedBase* child = element->getChildElement(n);
+    if (child == NULL) continue;
+
+    out.writeUnsigned(n);
+    out.writeUnsigned(static_cast<unsigned long>(child->getTypeCode()));
+    out.writeString(child->getElementName());
+
+    std::string body;
+    Output bodyOut(body, out.getStrings());
+    if (!encodeElement(bodyOut, child)) return false;
+    out.writeBlock(body);
+  }
+
+  return true;
+}
+
+
+/*
+ * Reads element, which the caller has created from its type code and
+ * name, and everything below it from in, the block of the element.
+ */
+bool
+SedBinaryCodec::decodeElement (Input& in, SedBase* element)
+{
+  XMLAttributes attributes;
+  decodeAttributes(in, attributes);
+  if (!in.isGood()) return false;
+
+  element->readAttributes(attributes, element->getExpectedAttributes());
+  element->notifyIdChanged();
+
+  const unsigned long flags = in.readUnsigned();
+
+  if (flags & HAS_NOTES)
+  {
+    Input block = in.readBlock();
+    XMLNode* notes = decodeXMLNode(block);
+    if (notes != NULL) element->setNotes(notes);
+    delete notes;
+  }
+
+  if (flags & HAS_ANNOTATION)
+  {
+    Input block = in.readBlock();
+    XMLNode* annotation = decodeXMLNode(block);
+    if (annotation != NULL) element->setAnnotation(annotation);
+    delete annotation;
+  }
+
+  if (flags & HAS_MATH)
+  {
+    Input block = in.readBlock();
+    ASTNode* math = decodeMath(block);
+    if (math != NULL) setMath(element, math);
+    delete math;
+  }
+
+  const unsigned long numChildren = in.readCount();
+
+  // the count is known up front, so lists make room for their items, in
+  // one piece of the arena for lists of one type
+  if (element->getTypeCode() == SEDML_LIST_OF && in.isGood())
+  {
+    static_cast<SedListOf*>(element)->reserve(
+      static_cast<unsigned int>(numChildren));
+  }
+
+  for (unsigned long i = 0; i < numChildren && in.isGood(); ++i)
+  {
+    const unsigned long slot     = in.readUnsigned();
+    const unsigned long typeCode = in.readUnsigned();
+    const std::string   name     = in.readString();
+    if (!in.isGood()) break;
+
+    SedBase* child = createChild(element, static_cast<unsigned int>(slot),
+                                 name);
+    Input body = in.readBlock();
+    if (child == NULL
+        || static_cast<unsigned long>(child->getTypeCode()) != typeCode
+        || !decodeElement(body, child))
+    {
+      in.fail();
+    }
+  }
+
+  return in.isGood();
+}
+
+
+/*
+ * Returns a new object named name, on its own, with the given level,
+ * version and namespaces, or NULL.
+ */
+SedBase*
+SedBinaryCodec::createObject (unsigned int level, unsigned int version,
+                              XMLNamespaces& xmlns, const std::string& name)
+{
+  if (name == "sedML")
+  {
+    SedDocument* doc = new SedDocument(level, version);
+    doc->setNamespaces((xmlns.getLength() > 0) ? &xmlns : NULL);
+    return doc;
+  }
+
+  SedNamespaces sedns(level, version);
+  if (xmlns.getLength() > 0) sedns.setNamespaces(&xmlns);
+
+  SedBase* item = createItem(name, &sedns);
+  if (item != NULL) return item;
+
+  if      (name == "algorithm")            return new SedAlgorithm(&sedns);
+  else if (name == "listOfModels")         return new SedListOfModels(&sedns);
+  else if (name == "listOfChanges")        return new SedListOfChanges(&sedns);
+  else if (name == "listOfSimulations")    return new SedListOfSimulations(&sedns);
+  else if (name == "listOfTasks")          return new SedListOfTasks(&sedns);
+  else if (name == "listOfDataGenerators") return new SedListOfDataGenerators(&sedns);
+  else if (name == "listOfVariables")      return new SedListOfVariables(&sedns);
+  else if (name == "listOfParameters")     return new SedListOfParameters(&sedns);
+  else if (name == "listOfOutputs")        return new SedListOfOutputs(&sedns);
+  else if (name == "listOfDataSets")       return new SedListOfDataSets(&sedns);
+  else if (name == "listOfCurves")         return new SedListOfCurves(&sedns);
+  else if (name == "listOfSurfaces")       return new SedListOfSurfaces(&sedns);
+
+  return NULL;
+}
+
+
+/*
+ * Returns the child of parent named name: the item appended to it if it
+ * is a list, or else the object in the given slot of getChildElement(),
+ * created if need be.
+ */
+SedBase*
+SedBinaryCodec::createChild (SedBase* parent, unsigned int slot,
+                             const std::string& name)
+{
+  if (parent->getTypeCode() != SEDML_LIST_OF)
+  {
+    SedBase* child = const_cast<SedBase*>(parent->getChildElement(slot));
+
+    if (child == NULL && name == "algorithm"
+        && (parent->getTypeCode() == SEDML_SIMULATION
+            || parent->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE))
+    {
+      child = static_cast<SedSimulation*>(parent)->createAlgorithm();
+    }
+
+    return (child != NULL && child->getElementName() == name) ? child : NULL;
+  }
+
+  SedListOf* list = static_cast<SedListOf*>(parent);
+  SedBase*   item = createItem(name, list->getSedNamespaces());
+
+  if (item == NULL) return NULL;
+
+  if (list->appendAndOwn(item) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    delete item;
+    return NULL;
+  }
+
+  return item;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+char *
+SedBinaryCodec_encode (const SedDocument_t *doc, size_t *length)
+{
+  if (doc == NULL) return NULL;
+
+  const std::string data = SedBinaryCodec::encode(doc);
+  if (data.empty()) return NULL;
+
+  char* result = static_cast<char*>(safe_malloc(data.size()));
+  memcpy(result, data.data(), data.size());
+  if (length != NULL) *length = data.size();
+
+  return result;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedBinaryCodec_decode (const char *data, size_t length)
+{
+  return SedBinaryCodec::decode(data, length);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedBinaryCodec_isEncoded (const char *data, size_t length)
+{
+  return SedBinaryCodec::isEncoded(data, length) ? 1 : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
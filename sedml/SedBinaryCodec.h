@@ -0,0 +1,276 @@
+/**
+ * @file    SedBinaryCodec.h
+ * @brief   Compact binary encoding of SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedBinaryCodec
+ * @ingroup Core
+ * @brief Encodes SedDocuments in a compact binary form and decodes them.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Processes that receive the same document again and again, from a cache
+ * or another process, can exchange it in this form rather than as XML:
+ * decode() builds the tree directly from the encoded attributes, without
+ * any XML parsing, and writing the decoded document with SedWriter gives
+ * the same output as writing the original.
+ *
+ * @code{.cpp}
+std::string data = SedBinaryCodec::encode(doc);
+...
+SedDocument* copy = SedBinaryCodec::decode(data);
+@endcode
+ *
+ * encodeObject() and decodeObject() do the same for any element and
+ * everything below it, such as a single SedDataGenerator, which need not
+ * be in a document.
+ *
+ * The encoding starts with the magic bytes @c SEDB and the version of the
+ * format, getFormatVersion(); decode() refuses any other version.  Next
+ * comes the table of all strings, as their number, the length of their
+ * characters, a 4-byte little-endian offset per string and the characters
+ * of each string followed by a NUL; elsewhere strings are referred to by
+ * their index in the table.  Then come the level, version and namespaces
+ * of the document, or of the element encoded, and then it and the
+ * elements below it, each one as its type code (see SedTypeCodes.h),
+ * element name and, as a block, its attributes, notes, annotation, math
+ * and children.  A block is its length followed by its bytes, so that it
+ * can be skipped, which SedDocumentView relies on.  Numbers and lengths
+ * are varints, that is 7 bits per byte with the high bit set on all bytes
+ * but the last, signed ones being zigzag encoded first, and doubles are 8
+ * bytes in IEEE 754 little-endian order.  Notes
+ * and annotations are encoded as trees of XML nodes and math as a tree of
+ * ASTNode types, names and values, so that they need no parsing either;
+ * the @c id, @c class and @c style attributes and the semantics of MathML
+ * elements are not kept.
+ */
+
+#ifndef SedBinaryCodec_h
+#define SedBinaryCodec_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <string>
+
+#include <sbml/xml/XMLNamespaces.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedBinaryCodec
+{
+public:
+
+  /**
+   * @return the version of the format encode() writes; incremented
+   * whenever the format changes.
+   */
+  static unsigned int getFormatVersion ();
+
+
+  /**
+   * @return the encoding of @p doc, or an empty string if @p doc is
+   * @c NULL or holds anything that cannot be encoded without loss, such as
+   * deferred notes or annotations that do not parse.
+   */
+  static std::string encode (const SedDocument* doc);
+
+
+  /**
+   * @return a new SedDocument built from @p data, an encoding returned by
+   * encode(), or @c NULL if @p data is not such an encoding, has another
+   * version of the format or is truncated.  The caller owns the document.
+   */
+  static SedDocument* decode (const std::string& data);
+
+
+  /**
+   * @return a new SedDocument built from the @p length bytes at @p data;
+   * see decode(const std::string&).
+   */
+  static SedDocument* decode (const char* data, size_t length);
+
+
+  /**
+   * @return the encoding of @p element and everything below it, together
+   * with its level, version and namespaces, or an empty string if
+   * @p element is @c NULL or cannot be encoded; see encode().  The element
+   * need not be in a document, and a SedDocument is encoded just as
+   * encode() encodes it.
+   */
+  static std::string encodeObject (const SedBase* element);
+
+
+  /**
+   * @return a new object built from @p data, an encoding returned by
+   * encodeObject() or encode(), or @c NULL if @p data is not such an
+   * encoding.  An object other than a SedDocument is on its own, in no
+   * document.  The caller owns the object.
+   */
+  static SedBase* decodeObject (const std::string& data);
+
+
+  /**
+   * @return a new object built from the @p length bytes at @p data; see
+   * decodeObject(const std::string&).
+   */
+  static SedBase* decodeObject (const char* data, size_t length);
+
+
+  /**
+   * @return @c true if the @p length bytes at @p data start with the
+   * magic bytes of the encoding, whatever the version of the format.
+   */
+  static bool isEncoded (const char* data, size_t length);
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  /* bits telling what an element carries besides attributes */
+  enum ElementFlags
+  {
+    HAS_NOTES      = 0x1
+  , HAS_ANNOTATION = 0x2
+  , HAS_MATH       = 0x4
+  };
+
+  /* writes the parts of an encoding */
+  class Output;
+
+  /*
+   * Reads the parts of an encoding, also for SedDocumentView; once
+   * anything cannot be read it fails, and returns zeros and empty strings
+   * from then on.  Copies read on independently.
+   */
+  class LIBSEDML_EXTERN Input
+  {
+  public:
+
+    Input ();
+
+    Input (const char* data, size_t length);
+
+    /* reads the magic bytes, format version and string table */
+    bool readHeader ();
+
+    bool isGood () const;
+
+    bool atEnd () const;
+
+    void fail ();
+
+    /* reads a length and returns an Input over that many bytes */
+    Input readBlock ();
+
+    unsigned long readUnsigned ();
+
+    long readSigned ();
+
+    double readDouble ();
+
+    unsigned long readCount ();
+
+    const char* readString ();
+
+  private:
+
+    const unsigned char*  mPos;
+    const unsigned char*  mEnd;
+    bool                  mFailed;
+    const unsigned char*  mOffsets;
+    const char*           mStrings;
+    unsigned long         mNumStrings;
+    unsigned long         mStringsLength;
+  };
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  static bool encodeElement (Output& out, const SedBase* element);
+
+  static bool decodeElement (Input& in, SedBase* element);
+
+  static SedBase* createObject (unsigned int level, unsigned int version,
+                                XMLNamespaces& xmlns,
+                                const std::string& name);
+
+  static SedBase* createChild (SedBase* parent, unsigned int slot,
+                               const std::string& name);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Encodes @p doc and returns the encoding, which the caller must free, or
+ * @c NULL if @p doc is @c NULL or cannot be encoded; its size is stored in
+ * @p length.
+ */
+LIBSEDML_EXTERN
+char *
+SedBinaryCodec_encode (const SedDocument_t *doc, size_t *length);
+
+
+/**
+ * Decodes the @p length bytes at @p data and returns the new document, or
+ * @c NULL if they are not an encoding of one.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedBinaryCodec_decode (const char *data, size_t length);
+
+
+/**
+ * Returns 1 if the @p length bytes at @p data start with the magic bytes
+ * of the encoding, 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedBinaryCodec_isEncoded (const char *data, size_t length);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedBinaryCodec_h */
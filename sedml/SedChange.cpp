@@ -150,6 +150,8 @@ SedChange::isSetTarget() const
 int
 SedChange::setTarget(const std::string& target)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(target) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -168,6 +170,8 @@ SedChange::setTarget(const std::string& target)
 int
 SedChange::unsetTarget()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mTarget.erase();
 
 	if (mTarget.empty() == true)
@@ -181,14 +185,16 @@ SedChange::unsetTarget()
 }
 
 
+static const std::string sSedChangeName("change");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedChange::getElementName () const
 {
-	static const string name = "change";
-	return name;
+	return sSedChangeName;
 }
 
 
@@ -235,13 +241,12 @@ SedChange::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedChange::accept (SedVisitor& v) const
+SedChange::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -293,10 +298,18 @@ SedChange::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "target", 0x32608848u }
+	};
+	int index[1];
+	findAttributes(attributes, names, 1, index);
+
 	//
 	// target string   ( use = "required" )
 	//
-	assigned = attributes.readInto("target", mTarget, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "target", mTarget, true);
 
 	if (assigned == true)
 	{
@@ -314,6 +327,9 @@ SedChange::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sTargetAttribute("target");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -324,8 +340,27 @@ SedChange::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetTarget() == true)
-		stream.writeAttribute("target", getPrefix(), mTarget);
+		stream.writeAttribute(sTargetAttribute, prefix, mTarget);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedChange::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetTarget() == true)
+		addAttribute(attributes, sTargetAttribute, prefix, mTarget);
 
 }
 
@@ -401,10 +436,7 @@ SedListOfChanges::get(const std::string& sid)
 const SedChange*
 SedListOfChanges::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedChange>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedChange*> (*result);
+	return static_cast <const SedChange*> (getItemById(sid));
 }
 
 
@@ -429,6 +461,17 @@ SedListOfChanges::addChange(const SedChange* sc)
 }
 
 
+/*
+ * Adds the given SedChange to this SedListOfChanges, which takes ownership of it.
+ */
+int
+SedListOfChanges::addChangeAndOwn(SedChange* sc)
+{
+	if(sc == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sc);
+}
+
+
 /**
  * Get the number of SedChange objects in this SedListOfChanges.
  *
@@ -451,7 +494,8 @@ SedListOfChanges::getNumChanges() const
 SedRemoveXML* 
 SedListOfChanges::createRemoveXML()
 {
-	SedRemoveXML *temp = new SedRemoveXML();
+	if (isFrozen()) return NULL;
+	SedRemoveXML *temp = new (getArena()) SedRemoveXML();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -467,7 +511,8 @@ SedListOfChanges::createRemoveXML()
 SedChangeAttribute* 
 SedListOfChanges::createChangeAttribute()
 {
-	SedChangeAttribute *temp = new SedChangeAttribute();
+	if (isFrozen()) return NULL;
+	SedChangeAttribute *temp = new (getArena()) SedChangeAttribute();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -483,7 +528,8 @@ SedListOfChanges::createChangeAttribute()
 SedComputeChange* 
 SedListOfChanges::createComputeChange()
 {
-	SedComputeChange *temp = new SedComputeChange();
+	if (isFrozen()) return NULL;
+	SedComputeChange *temp = new (getArena()) SedComputeChange();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -504,19 +550,11 @@ SedListOfChanges::remove(unsigned int n)
 SedChange*
 SedListOfChanges::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
+	return static_cast <SedChange*> (removeItemById(sid));
+}
 
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedChange>(sid) );
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
-
-	return static_cast <SedChange*> (item);
-}
+static const std::string sSedListOfChangesName("listOfChanges");
 
 
 /*
@@ -525,8 +563,7 @@ SedListOfChanges::remove(const std::string& sid)
 const std::string&
 SedListOfChanges::getElementName () const
 {
-	static const string name = "listOfChanges";
-	return name;
+	return sSedListOfChangesName;
 }
 
 
@@ -561,22 +598,31 @@ SedListOfChanges::createObject(XMLInputStream& stream)
 	const std::string& name   = stream.peek().getName();
 	SedBase* object = NULL;
 
-	if (name == "removeXML")
+	switch (getElementNameHash(name))
 	{
-		object = new SedRemoveXML(getSedNamespaces());
-		appendAndOwn(object);
-	}
+	case 0x37aabaceu:
+		if (name == "removeXML")
+		{
+			object = new (getArena()) SedRemoveXML(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 
-	if (name == "changeAttribute")
-	{
-		object = new SedChangeAttribute(getSedNamespaces());
-		appendAndOwn(object);
-	}
+	case 0x1fdd66a7u:
+		if (name == "changeAttribute")
+		{
+			object = new (getArena()) SedChangeAttribute(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 
-	if (name == "computeChange")
-	{
-		object = new SedComputeChange(getSedNamespaces());
-		appendAndOwn(object);
+	case 0xc34bf26eu:
+		if (name == "computeChange")
+		{
+			object = new (getArena()) SedComputeChange(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 	}
 
 	return object;
@@ -600,7 +646,8 @@ SedListOfChanges::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -668,6 +715,20 @@ SedChange_getTarget(SedChange_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedChange_getTargetView(const SedChange_t * sc)
+{
+	if (sc == NULL)
+		return NULL;
+
+	return sc->getTarget().empty() ? NULL : sc->getTarget().c_str();
+}
+
+
 /**
  * write comments
  */
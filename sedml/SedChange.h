@@ -236,9 +236,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -288,6 +288,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -402,6 +409,25 @@ public:
 	int addChange(const SedChange* c);
 
 
+	/**
+	 * Adds the given "SedChange" to this SedListOfChanges without copying it; this
+	 * SedListOfChanges takes ownership of @p c and will delete it.
+	 *
+	 * @param c the SedChange object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p c is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addChange(const SedChange* c)
+	 */
+	int addChangeAndOwn(SedChange* c);
+
+
 	/**
 	 * Get the number of Change objects in this SedListOfChanges.
 	 *
@@ -606,6 +632,11 @@ char *
 SedChange_getTarget(SedChange_t * sc);
 
 
+LIBSEDML_EXTERN
+const char *
+SedChange_getTargetView(const SedChange_t * sc);
+
+
 LIBSEDML_EXTERN
 int
 SedChange_isSetTarget(SedChange_t * sc);
@@ -0,0 +1,432 @@
+/**
+ * @file    SedChangeApplier.cpp
+ * @brief   Applies the changes of a SedModel to its XML in place
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedChangeApplier.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChange.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedReader.h>
+#include <sedml/common/operationReturnValues.h>
+#include <sedml/common/threads.h>
+
+#include <sbml/xml/XMLInputStream.h>
+
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates a new SedChangeApplier.
+ */
+SedChangeApplier::SedChangeApplier ()
+  : mXPath ()
+  , mNumFailed (0)
+{
+}
+
+
+/*
+ * Destroys this SedChangeApplier.
+ */
+SedChangeApplier::~SedChangeApplier ()
+{
+}
+
+
+/*
+ * Declares the namespace uri for prefix in targets.
+ */
+int
+SedChangeApplier::addNamespace (const std::string& prefix,
+                                const std::string& uri)
+{
+  return mXPath.addNamespace(prefix, uri);
+}
+
+
+/*
+ * Applies the changes of model to root.
+ */
+int
+SedChangeApplier::apply (XMLNode* root, const SedModel* model)
+{
+  if (model == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return apply(root, model->getListOfChanges());
+}
+
+
+/*
+ * Applies changes to root.
+ */
+int
+SedChangeApplier::apply (XMLNode* root, const SedListOfChanges* changes)
+{
+  mNumFailed = 0;
+  if (root == NULL || changes == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const unsigned int numChanges = changes->size();
+
+  // every target is resolved before the tree is changed, each shared
+  // prefix once; the tree is ours to change, the cache only reads it
+  mXPath.setDocument(root);
+
+  std::vector<Resolved> resolved(numChanges);
+  for (unsigned int i = 0; i < numChanges; i++)
+  {
+    const SedChange* change = changes->get(i);
+    Resolved& r = resolved[i];
+
+    r.target = mXPath.compile(change);
+    r.node   = const_cast<XMLNode*>(mXPath.resolve(r.target));
+    r.parent = NULL;
+
+    if (change->getTypeCode() == SEDML_CHANGE_REMOVEXML)
+    {
+      r.parent = const_cast<XMLNode*>(mXPath.resolveParent(r.target));
+    }
+    else if (change->getTypeCode() == SEDML_CHANGE_COMPUTECHANGE)
+    {
+      const SedComputeChange* cc =
+        static_cast<const SedComputeChange*>(change);
+      for (unsigned int v = 0; v < cc->getNumVariables(); v++)
+      {
+        const int target = mXPath.compile(cc->getVariable(v));
+        r.variableTargets.push_back(target);
+        r.variables.push_back(const_cast<XMLNode*>(mXPath.resolve(target)));
+      }
+    }
+  }
+
+  mXPath.setDocument(NULL);
+
+  // resolved nodes stay where they are while attributes change
+  for (unsigned int i = 0; i < numChanges; i++)
+  {
+    const SedChange* change = changes->get(i);
+    const Resolved&  r      = resolved[i];
+    const std::string& attribute = mXPath.getAttributeName(r.target);
+
+    switch (change->getTypeCode())
+    {
+    case SEDML_CHANGE_ATTRIBUTE:
+    {
+      const SedChangeAttribute* ca =
+        static_cast<const SedChangeAttribute*>(change);
+      if (!setAttribute(r.node, attribute, ca->getNewValue())) mNumFailed++;
+      break;
+    }
+
+    case SEDML_CHANGE_COMPUTECHANGE:
+    {
+      const SedComputeChange* cc =
+        static_cast<const SedComputeChange*>(change);
+      SedCompiledMath math;
+
+      std::vector<double> values(r.variables.size() + 1, 0.0);
+      bool valid = (math.compile(cc) == LIBSEDML_OPERATION_SUCCESS);
+      for (unsigned int v = 0; valid && v < r.variables.size(); v++)
+      {
+        const std::string& name =
+          mXPath.getAttributeName(r.variableTargets[v]);
+        valid = r.variables[v] != NULL && !name.empty()
+             && SedNumber::parse(r.variables[v]->getAttrValue(name),
+                                 values[v]);
+      }
+
+      if (!valid || !setAttribute(r.node, attribute,
+                                  SedNumber::toString(math.evaluate(&values[0]))))
+      {
+        mNumFailed++;
+      }
+      break;
+    }
+
+    case SEDML_CHANGE_REMOVEXML:
+      // removed below
+      break;
+
+    default:
+      mNumFailed++;
+      break;
+    }
+  }
+
+  // removals go last; the elements are detached first and deleted once
+  // all are, so that removing an element and, by another change, one of
+  // its descendants leaves no dangling pointer
+  std::vector<XMLNode*> removed;
+  for (unsigned int i = 0; i < numChanges; i++)
+  {
+    if (changes->get(i)->getTypeCode() != SEDML_CHANGE_REMOVEXML) continue;
+
+    const Resolved& r = resolved[i];
+    const std::string& attribute = mXPath.getAttributeName(r.target);
+
+    bool done = false;
+    if (r.node != NULL && !attribute.empty())
+    {
+      // a target ending in an attribute step removes the attribute
+      done = r.node->hasAttr(attribute)
+          && r.node->removeAttr(attribute) == LIBSBML_OPERATION_SUCCESS;
+    }
+    else if (r.node != NULL && r.parent != NULL)
+    {
+      XMLNode* child = removeChild(r.parent, r.node);
+      if (child != NULL) removed.push_back(child);
+      done = (child != NULL);
+    }
+
+    if (!done) mNumFailed++;
+  }
+
+  for (unsigned int i = 0; i < removed.size(); i++)
+  {
+    delete removed[i];
+  }
+
+  return (mNumFailed == 0) ? LIBSEDML_OPERATION_SUCCESS
+                           : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the number of changes the last apply() could not apply.
+ */
+unsigned int
+SedChangeApplier::getNumFailed () const
+{
+  return mNumFailed;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Sets the attribute name of node to value.
+ */
+bool
+SedChangeApplier::setAttribute (XMLNode* node, const std::string& name,
+                                const std::string& value)
+{
+  if (node == NULL || name.empty() || !node->isStart()) return false;
+
+  return node->addAttr(name, value) == LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Detaches child from parent and returns it, or NULL if it is not one of
+ * its children.
+ */
+XMLNode*
+SedChangeApplier::removeChild (XMLNode* parent, const XMLNode* child)
+{
+  for (unsigned int i = 0; i < parent->getNumChildren(); i++)
+  {
+    if (&parent->getChild(i) == child) return parent->removeChild(i);
+  }
+
+  return NULL;
+}
+/** @endcond */
+
+
+/*
+ * Creates a SedXMLModelPreparer.
+ */
+SedXMLModelPreparer::SedXMLModelPreparer ()
+  : mApplier ()
+  , mLock (NULL)
+{
+  SedMutex* lock = new SedMutex;
+  mutexInit(lock);
+  mLock = lock;
+}
+
+
+/*
+ * Destroys this SedXMLModelPreparer.
+ */
+SedXMLModelPreparer::~SedXMLModelPreparer ()
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexFree(lock);
+  delete lock;
+}
+
+
+/*
+ * Returns the SedChangeApplier used.
+ */
+SedChangeApplier&
+SedXMLModelPreparer::getApplier ()
+{
+  return mApplier;
+}
+
+
+/*
+ * Reads the file source into an XMLNode tree.
+ */
+void*
+SedXMLModelPreparer::loadSource (const std::string& source,
+                                 const std::string&)
+{
+  return read(source.c_str(), true);
+}
+
+
+/*
+ * Reads contents into an XMLNode tree.
+ */
+void*
+SedXMLModelPreparer::loadContents (const std::string& contents,
+                                   const std::string&, const std::string&)
+{
+  return read(contents.c_str(), false);
+}
+
+
+/*
+ * Returns a copy of model with the changes of sedModel applied.
+ */
+void*
+SedXMLModelPreparer::applyChanges (const void* model,
+                                   const SedModel* sedModel)
+{
+  if (model == NULL) return NULL;
+
+  XMLNode* copy = new XMLNode(*static_cast<const XMLNode*>(model));
+
+  // a SedModelCache calls the preparer from several threads
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+  const int result = mApplier.apply(copy, sedModel);
+  mutexUnlock(lock);
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+  {
+    delete copy;
+    return NULL;
+  }
+
+  return copy;
+}
+
+
+/*
+ * Deletes the XMLNode tree model.
+ */
+void
+SedXMLModelPreparer::freeModel (void* model)
+{
+  delete static_cast<XMLNode*>(model);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Reads the top-level element of a file or a string into a tree.
+ */
+void*
+SedXMLModelPreparer::read (const char* content, bool isFile)
+{
+  XMLInputStream stream(content, isFile, SedReader::getDefaultXMLParser(),
+                        NULL);
+  if (!stream.isGood()) return NULL;
+
+  XMLNode* node = new XMLNode(stream);
+  if (stream.isError() || !node->isStart())
+  {
+    delete node;
+    return NULL;
+  }
+
+  return node;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedChangeApplier and returns it.
+ */
+LIBSEDML_EXTERN
+SedChangeApplier_t *
+SedChangeApplier_create ()
+{
+  return new (nothrow) SedChangeApplier();
+}
+
+
+/**
+ * Frees the given SedChangeApplier.
+ */
+LIBSEDML_EXTERN
+void
+SedChangeApplier_free (SedChangeApplier_t *sca)
+{
+  delete sca;
+}
+
+
+/**
+ * Declares the namespace uri for prefix in targets.
+ */
+LIBSEDML_EXTERN
+int
+SedChangeApplier_addNamespace (SedChangeApplier_t *sca, const char *prefix,
+                               const char *uri)
+{
+  if (sca == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return sca->addNamespace(prefix != NULL ? prefix : "",
+                           uri != NULL ? uri : "");
+}
+
+
+/**
+ * Applies the changes of model to root.
+ */
+LIBSEDML_EXTERN
+int
+SedChangeApplier_apply (SedChangeApplier_t *sca, XMLNode_t *root,
+                        const SedModel_t *model)
+{
+  if (sca == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return sca->apply(root, model);
+}
+
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
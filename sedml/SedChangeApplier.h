@@ -0,0 +1,298 @@
+/**
+ * @file    SedChangeApplier.h
+ * @brief   Applies the changes of a SedModel to its XML in place
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedChangeApplier
+ * @ingroup Core
+ * @brief Applies a SedListOfChanges to an XMLNode tree in one pass.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * apply() edits the XMLNode tree of a model, such as an SBML model, as
+ * the changes of a SedModel describe, without writing it out and reading
+ * it back for each change:
+ *
+ * @li the targets of all changes, and of the variables of every
+ * SedComputeChange, are compiled and resolved first with a
+ * SedXPathCache, so that targets sharing a prefix, as the parameters of
+ * one listOfParameters do, resolve it once;
+ * @li a SedChangeAttribute sets the attribute it targets to its new
+ * value;
+ * @li a SedComputeChange evaluates its math, compiled with
+ * SedCompiledMath, with its variables taken from the attributes they
+ * target as earlier changes left them, and sets the attribute it targets
+ * to the result;
+ * @li a SedRemoveXML removes the element, or the attribute, it targets.
+ * Removals are done last, so that the elements the other changes resolved
+ * to stay where they are; positional targets such as
+ * <code>species[2]</code> therefore count the elements of the unchanged
+ * model.
+ *
+ * A SedXMLModelPreparer loads models as XMLNode trees and applies the
+ * changes with a SedChangeApplier, so that a SedModelCache hands the
+ * changed tree on as it is.
+ *
+ * apply() changes the applier, so one applier must not be used by
+ * several threads at the same time.
+ */
+
+#ifndef SedChangeApplier_h
+#define SedChangeApplier_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedModelCache.h>
+#include <sedml/SedXPathCache.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedModel;
+class SedListOfChanges;
+
+
+class LIBSEDML_EXTERN SedChangeApplier
+{
+public:
+
+  /**
+   * Creates a new SedChangeApplier.
+   */
+  SedChangeApplier ();
+
+
+  /**
+   * Destroys this SedChangeApplier.
+   */
+  virtual ~SedChangeApplier ();
+
+
+  /**
+   * Declares the namespace @p uri for @p prefix in targets, as
+   * SedXPathCache::addNamespace().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   */
+  int addNamespace (const std::string& prefix, const std::string& uri);
+
+
+  /**
+   * Applies the changes of @p model to the tree @p root, the top-level
+   * element or a node containing it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int apply (XMLNode* root, const SedModel* model);
+
+
+  /**
+   * Applies @p changes to the tree @p root.  Changes that cannot be
+   * applied, because their target selects nothing, their math cannot be
+   * compiled or a variable has no numeric value, are skipped, and
+   * @c LIBSEDML_OPERATION_FAILED is returned once the others have been
+   * applied.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int apply (XMLNode* root, const SedListOfChanges* changes);
+
+
+  /**
+   * @return the number of changes the last apply() could not apply.
+   */
+  unsigned int getNumFailed () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Resolved
+  {
+    int                    target;
+    XMLNode*               node;
+    XMLNode*               parent;
+    std::vector<int>       variableTargets;
+    std::vector<XMLNode*>  variables;
+  };
+
+  static bool setAttribute (XMLNode* node, const std::string& name,
+                            const std::string& value);
+
+  static XMLNode* removeChild (XMLNode* parent, const XMLNode* child);
+
+  SedXPathCache  mXPath;
+  unsigned int   mNumFailed;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedChangeApplier (const SedChangeApplier& orig);
+  SedChangeApplier& operator= (const SedChangeApplier& rhs);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedXMLModelPreparer : public SedModelPreparer
+{
+public:
+
+  /**
+   * Creates a SedXMLModelPreparer, whose models are XMLNode trees.
+   */
+  SedXMLModelPreparer ();
+
+
+  /**
+   * Destroys this SedXMLModelPreparer.
+   */
+  virtual ~SedXMLModelPreparer ();
+
+
+  /**
+   * Returns the SedChangeApplier used, so that namespaces can be
+   * declared.
+   */
+  SedChangeApplier& getApplier ();
+
+
+  /**
+   * Reads the file @p source into an XMLNode tree.
+   */
+  virtual void* loadSource (const std::string& source,
+                            const std::string& language);
+
+
+  /**
+   * Reads @p contents into an XMLNode tree.
+   */
+  virtual void* loadContents (const std::string& contents,
+                              const std::string& source,
+                              const std::string& language);
+
+
+  /**
+   * Returns a copy of the XMLNode tree @p model with the changes of
+   * @p sedModel applied, or @c NULL if one cannot be applied.
+   */
+  virtual void* applyChanges (const void* model, const SedModel* sedModel);
+
+
+  /**
+   * Deletes the XMLNode tree @p model.
+   */
+  virtual void freeModel (void* model);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  void* read (const char* content, bool isFile);
+
+  SedChangeApplier mApplier;
+  void*            mLock;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedXMLModelPreparer (const SedXMLModelPreparer& orig);
+  SedXMLModelPreparer& operator= (const SedXMLModelPreparer& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedChangeApplier and returns it.
+ */
+LIBSEDML_EXTERN
+SedChangeApplier_t *
+SedChangeApplier_create ();
+
+
+/**
+ * Frees the given SedChangeApplier.
+ */
+LIBSEDML_EXTERN
+void
+SedChangeApplier_free (SedChangeApplier_t *sca);
+
+
+/**
+ * Declares the namespace @p uri for @p prefix in targets.
+ */
+LIBSEDML_EXTERN
+int
+SedChangeApplier_addNamespace (SedChangeApplier_t *sca, const char *prefix,
+                               const char *uri);
+
+
+/**
+ * Applies the changes of @p model to the tree @p root.
+ */
+LIBSEDML_EXTERN
+int
+SedChangeApplier_apply (SedChangeApplier_t *sca, XMLNode_t *root,
+                        const SedModel_t *model);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedChangeApplier_h */
@@ -150,6 +150,8 @@ SedChangeAttribute::isSetNewValue() const
 int
 SedChangeAttribute::setNewValue(const std::string& newValue)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(newValue) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -168,6 +170,8 @@ SedChangeAttribute::setNewValue(const std::string& newValue)
 int
 SedChangeAttribute::unsetNewValue()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mNewValue.erase();
 
 	if (mNewValue.empty() == true)
@@ -181,14 +185,16 @@ SedChangeAttribute::unsetNewValue()
 }
 
 
+static const std::string sSedChangeAttributeName("changeAttribute");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedChangeAttribute::getElementName () const
 {
-	static const string name = "changeAttribute";
-	return name;
+	return sSedChangeAttributeName;
 }
 
 
@@ -202,8 +208,6 @@ SedChangeAttribute::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedChange::connectToChild();
-
 	return object;
 }
 
@@ -251,13 +255,12 @@ SedChangeAttribute::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedChangeAttribute::accept (SedVisitor& v) const
+SedChangeAttribute::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -309,10 +312,18 @@ SedChangeAttribute::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "newValue", 0x8532283eu }
+	};
+	int index[1];
+	findAttributes(attributes, names, 1, index);
+
 	//
 	// newValue string   ( use = "required" )
 	//
-	assigned = attributes.readInto("newValue", mNewValue, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "newValue", mNewValue, true);
 
 	if (assigned == true)
 	{
@@ -330,6 +341,9 @@ SedChangeAttribute::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sNewValueAttribute("newValue");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -340,8 +354,27 @@ SedChangeAttribute::writeAttributes (XMLOutputStream& stream) const
 {
 	SedChange::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetNewValue() == true)
-		stream.writeAttribute("newValue", getPrefix(), mNewValue);
+		stream.writeAttribute(sNewValueAttribute, prefix, mNewValue);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedChangeAttribute::addAttributes (XMLAttributes& attributes) const
+{
+	SedChange::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetNewValue() == true)
+		addAttribute(attributes, sNewValueAttribute, prefix, mNewValue);
 
 }
 
@@ -404,6 +437,20 @@ SedChangeAttribute_getNewValue(SedChangeAttribute_t * sca)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedChangeAttribute_getNewValueView(const SedChangeAttribute_t * sca)
+{
+	if (sca == NULL)
+		return NULL;
+
+	return sca->getNewValue().empty() ? NULL : sca->getNewValue().c_str();
+}
+
+
 /**
  * write comments
  */
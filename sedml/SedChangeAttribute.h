@@ -237,9 +237,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -300,6 +300,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -337,6 +344,11 @@ char *
 SedChangeAttribute_getNewValue(SedChangeAttribute_t * sca);
 
 
+LIBSEDML_EXTERN
+const char *
+SedChangeAttribute_getNewValueView(const SedChangeAttribute_t * sca);
+
+
 LIBSEDML_EXTERN
 int
 SedChangeAttribute_isSetNewValue(SedChangeAttribute_t * sca);
@@ -0,0 +1,411 @@
+/**
+ * @file    SedCheckpoint.cpp
+ * @brief   Records the progress of a SedExecutor so that it can resume
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedCheckpoint.h>
+#include <sedml/common/threads.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const char JOURNAL_NAME[] = "checkpoint.log";
+
+
+/*
+ * Returns name in directory.
+ */
+static std::string
+joinPath (const std::string& directory, const std::string& name)
+{
+  std::string path = directory;
+  if (!path.empty() && path[path.size() - 1] != '/'
+      && path[path.size() - 1] != '\\')
+  {
+    path += '/';
+  }
+
+  return path + name;
+}
+
+
+/*
+ * Returns true if value can be written as (the end of) a record.
+ */
+static bool
+isRecordValue (const std::string& value)
+{
+  return !value.empty() && value.find('\n') == std::string::npos;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedCheckpoint keeping its files in directory.
+ */
+SedCheckpoint::SedCheckpoint (const std::string& directory)
+  : SedDirectoryResultCache (directory)
+  , mJournal (NULL)
+{
+  readJournal();
+}
+
+
+/*
+ * Destroys this SedCheckpoint.
+ */
+SedCheckpoint::~SedCheckpoint ()
+{
+  if (mJournal != NULL) fclose(mJournal);
+}
+
+
+/*
+ * Writes results to the file of fingerprint and records the file.
+ */
+bool
+SedCheckpoint::store (const std::string& fingerprint,
+                      const SedResults& results)
+{
+  if (!SedDirectoryResultCache::store(fingerprint, results)) return false;
+
+  // the file is recorded by its name, so that clear() finds it from
+  // another working directory
+  const std::string filename = getFilename(fingerprint);
+  const std::string name =
+    filename.substr(filename.find_last_of("/\\") + 1);
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  const bool recorded = mResultFiles.find(name) != mResultFiles.end()
+                     || (appendRecord("results " + name)
+                         && mResultFiles.insert(name).second);
+
+  mutexUnlock(mutex);
+  return recorded;
+}
+
+
+/*
+ * Removes the results and the records of this checkpoint.
+ */
+void
+SedCheckpoint::clear ()
+{
+  SedDirectoryResultCache::clear();
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  std::set<std::string>::const_iterator it;
+  for (it = mResultFiles.begin(); it != mResultFiles.end(); ++it)
+  {
+    remove(joinPath(mDirectory, *it).c_str());
+  }
+
+  if (mJournal != NULL) fclose(mJournal);
+  mJournal = NULL;
+  remove(getJournalFilename().c_str());
+
+  mOutputs.clear();
+  mRows.clear();
+  mResultFiles.clear();
+
+  mutexUnlock(mutex);
+}
+
+
+/*
+ * Returns true if the output outputId has been recorded as done.
+ */
+bool
+SedCheckpoint::isOutputDone (const std::string& outputId) const
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  const bool done = mOutputs.find(outputId) != mOutputs.end();
+
+  mutexUnlock(mutex);
+  return done;
+}
+
+
+/*
+ * Returns the number of outputs recorded as done.
+ */
+unsigned int
+SedCheckpoint::getNumOutputsDone () const
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  const unsigned int numDone = (unsigned int)mOutputs.size();
+
+  mutexUnlock(mutex);
+  return numDone;
+}
+
+
+/*
+ * Records the output outputId as done.
+ */
+int
+SedCheckpoint::setOutputDone (const std::string& outputId)
+{
+  if (!isRecordValue(outputId)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  const bool recorded = mOutputs.find(outputId) != mOutputs.end()
+                     || (appendRecord("output " + outputId)
+                         && mOutputs.insert(outputId).second);
+
+  mutexUnlock(mutex);
+  return recorded ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the number of rows recorded for the stream name.
+ */
+size_t
+SedCheckpoint::getNumRows (const std::string& name) const
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  std::map<std::string, size_t>::const_iterator it = mRows.find(name);
+  const size_t numRows = (it != mRows.end()) ? it->second : 0;
+
+  mutexUnlock(mutex);
+  return numRows;
+}
+
+
+/*
+ * Records that the stream name holds numRows rows.
+ */
+int
+SedCheckpoint::setNumRows (const std::string& name, size_t numRows)
+{
+  if (!isRecordValue(name)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  char count[32];
+  sprintf(count, "rows %lu ", (unsigned long)numRows);
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  const bool recorded = appendRecord(count + name);
+  if (recorded) mRows[name] = numRows;
+
+  mutexUnlock(mutex);
+  return recorded ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the name of the file the records are kept in.
+ */
+std::string
+SedCheckpoint::getJournalFilename () const
+{
+  return joinPath(mDirectory, JOURNAL_NAME);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Reads the records of earlier runs.  A last line without its line break
+ * was cut short; it is removed, so that the next record does not run
+ * into it.
+ */
+void
+SedCheckpoint::readJournal ()
+{
+  const std::string filename = getJournalFilename();
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file == NULL) return;
+
+  std::string data;
+  char block[4096];
+  size_t n;
+  while ((n = fread(block, 1, sizeof(block), file)) > 0)
+  {
+    data.append(block, n);
+  }
+  fclose(file);
+
+  size_t start = 0;
+  size_t end;
+  while ((end = data.find('\n', start)) != std::string::npos)
+  {
+    const std::string line = data.substr(start, end - start);
+    start = end + 1;
+
+    if (line.compare(0, 7, "output ") == 0)
+    {
+      mOutputs.insert(line.substr(7));
+    }
+    else if (line.compare(0, 8, "results ") == 0)
+    {
+      mResultFiles.insert(line.substr(8));
+    }
+    else if (line.compare(0, 5, "rows ") == 0)
+    {
+      // later records of a stream replace earlier ones
+      char* next = NULL;
+      const unsigned long numRows = strtoul(line.c_str() + 5, &next, 10);
+      if (next != line.c_str() + 5 && *next == ' ')
+      {
+        mRows[std::string(next + 1)] = (size_t)numRows;
+      }
+    }
+  }
+
+  if (start == data.size()) return;
+
+  const std::string temporary = filename + ".tmp";
+  FILE* copy = fopen(temporary.c_str(), "wb");
+  bool ok = copy != NULL && fwrite(data.data(), 1, start, copy) == start;
+  if (copy != NULL) ok = (fclose(copy) == 0) && ok;
+
+#ifdef _WIN32
+  // rename does not replace existing files on Windows
+  if (ok) ok = remove(filename.c_str()) == 0;
+#endif
+
+  if (!ok || rename(temporary.c_str(), filename.c_str()) != 0)
+  {
+    remove(temporary.c_str());
+  }
+}
+
+
+/*
+ * Appends record as a line of the journal and flushes it; the lock is
+ * held.
+ */
+bool
+SedCheckpoint::appendRecord (const std::string& record)
+{
+  if (mJournal == NULL)
+  {
+    mJournal = fopen(getJournalFilename().c_str(), "ab");
+    if (mJournal == NULL) return false;
+  }
+
+  const std::string line = record + '\n';
+  return fwrite(line.data(), 1, line.size(), mJournal) == line.size()
+      && fflush(mJournal) == 0;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedCheckpoint keeping its files in directory.
+ */
+LIBSEDML_EXTERN
+SedCheckpoint_t *
+SedCheckpoint_create (const char *directory)
+{
+  if (directory == NULL) return NULL;
+  return new (nothrow) SedCheckpoint(directory);
+}
+
+
+/**
+ * Frees the given SedCheckpoint.
+ */
+LIBSEDML_EXTERN
+void
+SedCheckpoint_free (SedCheckpoint_t *sc)
+{
+  delete sc;
+}
+
+
+/**
+ * Removes everything recorded in the directory of the given SedCheckpoint.
+ */
+LIBSEDML_EXTERN
+void
+SedCheckpoint_clear (SedCheckpoint_t *sc)
+{
+  if (sc != NULL) sc->clear();
+}
+
+
+/**
+ * Returns non-zero if the output outputId has been recorded as done.
+ */
+LIBSEDML_EXTERN
+int
+SedCheckpoint_isOutputDone (const SedCheckpoint_t *sc, const char *outputId)
+{
+  if (sc == NULL || outputId == NULL) return 0;
+  return sc->isOutputDone(outputId) ? 1 : 0;
+}
+
+
+/**
+ * Returns the number of rows recorded for the stream name.
+ */
+LIBSEDML_EXTERN
+size_t
+SedCheckpoint_getNumRows (const SedCheckpoint_t *sc, const char *name)
+{
+  if (sc == NULL || name == NULL) return 0;
+  return sc->getNumRows(name);
+}
+
+
+/**
+ * Records that the stream name holds numRows rows.
+ */
+LIBSEDML_EXTERN
+int
+SedCheckpoint_setNumRows (SedCheckpoint_t *sc, const char *name,
+                          size_t numRows)
+{
+  if (sc == NULL) return LIBSEDML_INVALID_OBJECT;
+  return sc->setNumRows(name != NULL ? name : "", numRows);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,251 @@
+/**
+ * @file    SedCheckpoint.h
+ * @brief   Records the progress of a SedExecutor so that it can resume
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedCheckpoint
+ * @ingroup Core
+ * @brief Keeps what a run has done in a directory, for a later run to
+ * skip.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedExecutor given a SedCheckpoint (see SedExecutor::setCheckpoint())
+ * stores the results of every task and sweep point it simulates in it,
+ * like a SedDirectoryResultCache, and records every output it has handed
+ * to its SedOutputHandler.  When a run that was stopped is started again
+ * with the same document and a SedCheckpoint on the same directory, the
+ * executor
+ *
+ * @li skips the outputs recorded as done, and the data generators and
+ * tasks no other output needs;
+ * @li takes the results of the tasks that were simulated from the
+ * checkpoint, without loading their models unless a task that was not
+ * simulated needs them;
+ * @li runs what is left.
+ *
+ * Results are keyed by the fingerprints of the tasks, so a task that
+ * changed is simulated again; outputs are recorded by id, so the
+ * checkpoint must be cleared when the outputs or data generators of the
+ * document change.
+ *
+ * Besides, an output handler streaming a report with SedReportWriter can
+ * record how many of its rows are in the file with setNumRows() after
+ * SedReportWriter::flush(), and continue a restarted run with
+ * SedReportWriter::resume() from getNumRows().
+ *
+ * The records are appended to the file @c checkpoint.log of the directory
+ * one line at a time, and handed to the operating system before the call
+ * returns, so a process that dies loses at most the record it was
+ * writing; a line cut short is ignored when the file is read again.
+ */
+
+#ifndef SedCheckpoint_h
+#define SedCheckpoint_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedResultCache.h>
+
+#include <stddef.h>
+#include <stdio.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedCheckpoint : public SedDirectoryResultCache
+{
+public:
+
+  /**
+   * Creates a new SedCheckpoint keeping its files in the existing
+   * directory @p directory, and reads what earlier runs recorded there.
+   */
+  SedCheckpoint (const std::string& directory);
+
+
+  /**
+   * Destroys this SedCheckpoint; its files are kept.
+   */
+  virtual ~SedCheckpoint ();
+
+
+  /**
+   * Writes @p results to the file of @p fingerprint, as
+   * SedDirectoryResultCache::store() does, and records the file.
+   */
+  virtual bool store (const std::string& fingerprint,
+                      const SedResults& results);
+
+
+  /**
+   * Removes the results recorded by this checkpoint or earlier ones on
+   * its directory, and the records; a run afterwards starts over.
+   */
+  virtual void clear ();
+
+
+  /**
+   * @return @c true if the output @p outputId has been recorded as done.
+   */
+  bool isOutputDone (const std::string& outputId) const;
+
+
+  /**
+   * @return the number of outputs recorded as done.
+   */
+  unsigned int getNumOutputsDone () const;
+
+
+  /**
+   * Records the output @p outputId as done.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p outputId is empty or holds a line break
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the record cannot be written
+   */
+  int setOutputDone (const std::string& outputId);
+
+
+  /**
+   * @return the number of rows recorded for the stream @p name, or 0.
+   */
+  size_t getNumRows (const std::string& name) const;
+
+
+  /**
+   * Records that the stream @p name, such as the file of a report, holds
+   * @p numRows rows.
+   *
+   * @copydetails setOutputDone()
+   */
+  int setNumRows (const std::string& name, size_t numRows);
+
+
+  /**
+   * @return the name of the file the records are kept in.
+   */
+  std::string getJournalFilename () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  void readJournal ();
+
+  bool appendRecord (const std::string& record);
+
+  FILE*                          mJournal;
+  std::set<std::string>          mOutputs;
+  std::map<std::string, size_t>  mRows;
+  std::set<std::string>          mResultFiles;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedCheckpoint (const SedCheckpoint& orig);
+  SedCheckpoint& operator= (const SedCheckpoint& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedCheckpoint keeping its files in @p directory and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedCheckpoint_t *
+SedCheckpoint_create (const char *directory);
+
+
+/**
+ * Frees the given SedCheckpoint.
+ */
+LIBSEDML_EXTERN
+void
+SedCheckpoint_free (SedCheckpoint_t *sc);
+
+
+/**
+ * Removes everything recorded in the directory of the given SedCheckpoint.
+ */
+LIBSEDML_EXTERN
+void
+SedCheckpoint_clear (SedCheckpoint_t *sc);
+
+
+/**
+ * Returns non-zero if the output @p outputId has been recorded as done.
+ */
+LIBSEDML_EXTERN
+int
+SedCheckpoint_isOutputDone (const SedCheckpoint_t *sc, const char *outputId);
+
+
+/**
+ * Returns the number of rows recorded for the stream @p name.
+ */
+LIBSEDML_EXTERN
+size_t
+SedCheckpoint_getNumRows (const SedCheckpoint_t *sc, const char *name);
+
+
+/**
+ * Records that the stream @p name holds @p numRows rows.
+ */
+LIBSEDML_EXTERN
+int
+SedCheckpoint_setNumRows (SedCheckpoint_t *sc, const char *name,
+                          size_t numRows);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedCheckpoint_h */
@@ -0,0 +1,1644 @@
+/**
+ * @file    SedCompiledMath.cpp
+ * @brief   Evaluates the math of a SedDataGenerator over whole columns
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Number of samples every instruction is applied to at once; the stack
+ * holds this many values per slot.
+ */
+static const size_t SED_MATH_BLOCK = 256;
+
+
+/*
+ * The instructions of the stack machine.  Binary operators replace the
+ * two topmost slots by their result; functions work on the topmost slot.
+ */
+enum SedMathOp
+{
+    SED_OP_CONST      /* push mConstants[arg]            */
+  , SED_OP_VAR        /* push column arg                 */
+  , SED_OP_ADD
+  , SED_OP_SUB
+  , SED_OP_MUL
+  , SED_OP_DIV
+  , SED_OP_POW
+  , SED_OP_EQ
+  , SED_OP_NEQ
+  , SED_OP_LT
+  , SED_OP_LEQ
+  , SED_OP_GT
+  , SED_OP_GEQ
+  , SED_OP_AND
+  , SED_OP_OR
+  , SED_OP_XOR
+  , SED_OP_SELECT     /* [r, v, c] -> c != 0 ? v : r     */
+  , SED_OP_NEG
+  , SED_OP_NOT
+  , SED_OP_ABS
+  , SED_OP_FLOOR
+  , SED_OP_CEIL
+  , SED_OP_FUNC       /* SED_MATH_FUNCS[arg]             */
+};
+
+
+static double sedCot   (double x) { return 1.0 / tan(x); }
+static double sedSec   (double x) { return 1.0 / cos(x); }
+static double sedCsc   (double x) { return 1.0 / sin(x); }
+static double sedCoth  (double x) { return 1.0 / tanh(x); }
+static double sedSech  (double x) { return 1.0 / cosh(x); }
+static double sedCsch  (double x) { return 1.0 / sinh(x); }
+static double sedAcot  (double x) { return atan(1.0 / x); }
+static double sedAsec  (double x) { return acos(1.0 / x); }
+static double sedAcsc  (double x) { return asin(1.0 / x); }
+static double sedAsinh (double x) { return log(x + sqrt(x * x + 1.0)); }
+static double sedAcosh (double x) { return log(x + sqrt(x * x - 1.0)); }
+static double sedAtanh (double x) { return 0.5 * log((1.0 + x) / (1.0 - x)); }
+static double sedAcoth (double x) { return 0.5 * log((x + 1.0) / (x - 1.0)); }
+static double sedAsech (double x) { return sedAcosh(1.0 / x); }
+static double sedAcsch (double x) { return sedAsinh(1.0 / x); }
+static double sedExp   (double x) { return exp(x); }
+static double sedLn    (double x) { return log(x); }
+static double sedLog10 (double x) { return log10(x); }
+static double sedSqrt  (double x) { return sqrt(x); }
+static double sedSin   (double x) { return sin(x); }
+static double sedCos   (double x) { return cos(x); }
+static double sedTan   (double x) { return tan(x); }
+static double sedSinh  (double x) { return sinh(x); }
+static double sedCosh  (double x) { return cosh(x); }
+static double sedTanh  (double x) { return tanh(x); }
+static double sedAsin  (double x) { return asin(x); }
+static double sedAcos  (double x) { return acos(x); }
+static double sedAtan  (double x) { return atan(x); }
+
+
+/*
+ * The functions of one argument reached through SED_OP_FUNC.
+ */
+static const struct
+{
+  int    type;
+  double (*func) (double);
+} SED_MATH_FUNCS[] =
+{
+    { AST_FUNCTION_EXP    , sedExp   }
+  , { AST_FUNCTION_LN     , sedLn    }
+  , { AST_FUNCTION_LOG    , sedLog10 }
+  , { AST_FUNCTION_ROOT   , sedSqrt  }
+  , { AST_FUNCTION_SIN    , sedSin   }
+  , { AST_FUNCTION_COS    , sedCos   }
+  , { AST_FUNCTION_TAN    , sedTan   }
+  , { AST_FUNCTION_SEC    , sedSec   }
+  , { AST_FUNCTION_CSC    , sedCsc   }
+  , { AST_FUNCTION_COT    , sedCot   }
+  , { AST_FUNCTION_SINH   , sedSinh  }
+  , { AST_FUNCTION_COSH   , sedCosh  }
+  , { AST_FUNCTION_TANH   , sedTanh  }
+  , { AST_FUNCTION_SECH   , sedSech  }
+  , { AST_FUNCTION_CSCH   , sedCsch  }
+  , { AST_FUNCTION_COTH   , sedCoth  }
+  , { AST_FUNCTION_ARCSIN , sedAsin  }
+  , { AST_FUNCTION_ARCCOS , sedAcos  }
+  , { AST_FUNCTION_ARCTAN , sedAtan  }
+  , { AST_FUNCTION_ARCSEC , sedAsec  }
+  , { AST_FUNCTION_ARCCSC , sedAcsc  }
+  , { AST_FUNCTION_ARCCOT , sedAcot  }
+  , { AST_FUNCTION_ARCSINH, sedAsinh }
+  , { AST_FUNCTION_ARCCOSH, sedAcosh }
+  , { AST_FUNCTION_ARCTANH, sedAtanh }
+  , { AST_FUNCTION_ARCSECH, sedAsech }
+  , { AST_FUNCTION_ARCCSCH, sedAcsch }
+  , { AST_FUNCTION_ARCCOTH, sedAcoth }
+};
+
+static const unsigned int NUM_SED_MATH_FUNCS =
+  sizeof(SED_MATH_FUNCS) / sizeof(SED_MATH_FUNCS[0]);
+
+
+/*
+ * @return the index of type in SED_MATH_FUNCS, or NUM_SED_MATH_FUNCS.
+ */
+static unsigned int
+getMathFunc (int type)
+{
+  unsigned int i = 0;
+  while (i < NUM_SED_MATH_FUNCS && SED_MATH_FUNCS[i].type != type) ++i;
+  return i;
+}
+
+
+/*
+ * @return the binary instruction for an operator or relation, or -1.
+ */
+static int
+getBinaryOp (int type)
+{
+  switch (type)
+  {
+  case AST_PLUS:             return SED_OP_ADD;
+  case AST_MINUS:            return SED_OP_SUB;
+  case AST_TIMES:            return SED_OP_MUL;
+  case AST_DIVIDE:           return SED_OP_DIV;
+  case AST_POWER:
+  case AST_FUNCTION_POWER:   return SED_OP_POW;
+  case AST_RELATIONAL_EQ:    return SED_OP_EQ;
+  case AST_RELATIONAL_NEQ:   return SED_OP_NEQ;
+  case AST_RELATIONAL_LT:    return SED_OP_LT;
+  case AST_RELATIONAL_LEQ:   return SED_OP_LEQ;
+  case AST_RELATIONAL_GT:    return SED_OP_GT;
+  case AST_RELATIONAL_GEQ:   return SED_OP_GEQ;
+  case AST_LOGICAL_AND:      return SED_OP_AND;
+  case AST_LOGICAL_OR:       return SED_OP_OR;
+  case AST_LOGICAL_XOR:      return SED_OP_XOR;
+  default:                   return -1;
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedCompiledMath.
+ */
+SedCompiledMath::SedCompiledMath ()
+  : mNumVariables (0)
+  , mMaxDepth (0)
+  , mCompiled (false)
+{
+}
+
+
+/*
+ * Destroys this SedCompiledMath.
+ */
+SedCompiledMath::~SedCompiledMath ()
+{
+}
+
+
+/*
+ * Compiles the math of dg.
+ */
+int
+SedCompiledMath::compile (const SedDataGenerator* dg, bool bindParameters)
+{
+  SedVariableList  variables;
+  SedParameterList parameters;
+
+  if (dg == NULL) return compileMath(NULL, variables, parameters, false);
+
+  for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+  {
+    variables.push_back(dg->getVariable(i));
+  }
+
+  for (unsigned int i = 0; i < dg->getNumParameters(); ++i)
+  {
+    parameters.push_back(dg->getParameter(i));
+  }
+
+  return compileMath(dg->getMath(), variables, parameters, bindParameters);
+}
+
+
+/*
+ * Compiles the math of cc.
+ */
+int
+SedCompiledMath::compile (const SedComputeChange* cc, bool bindParameters)
+{
+  SedVariableList  variables;
+  SedParameterList parameters;
+
+  if (cc == NULL) return compileMath(NULL, variables, parameters, false);
+
+  for (unsigned int i = 0; i < cc->getNumVariables(); ++i)
+  {
+    variables.push_back(cc->getVariable(i));
+  }
+
+  for (unsigned int i = 0; i < cc->getNumParameters(); ++i)
+  {
+    parameters.push_back(cc->getParameter(i));
+  }
+
+  return compileMath(cc->getMath(), variables, parameters, bindParameters);
+}
+
+
+/*
+ * Returns true if compile() succeeded last time it was called.
+ */
+bool
+SedCompiledMath::isCompiled () const
+{
+  return mCompiled;
+}
+
+
+/*
+ * Returns the number of input columns.
+ */
+unsigned int
+SedCompiledMath::getNumInputs () const
+{
+  return (unsigned int)mInputs.size();
+}
+
+
+/*
+ * Returns the id of the variable or parameter read from column n.
+ */
+const std::string&
+SedCompiledMath::getInputId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mInputs.size()) ? mInputs[n] : empty;
+}
+
+
+/*
+ * Returns the number of input columns holding variables.
+ */
+unsigned int
+SedCompiledMath::getNumVariables () const
+{
+  return mNumVariables;
+}
+
+
+/*
+ * Returns the id of the variable read from column n.
+ */
+const std::string&
+SedCompiledMath::getVariableId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mNumVariables) ? mInputs[n] : empty;
+}
+
+
+/*
+ * Returns the number of instructions the math was compiled to.
+ */
+unsigned int
+SedCompiledMath::getNumInstructions () const
+{
+  return (unsigned int)mCode.size();
+}
+
+
+/*
+ * Evaluates the compiled math for length samples.
+ */
+int
+SedCompiledMath::evaluate (const double* const* columns, size_t length,
+                           double* result) const
+{
+  if (!mCompiled || result == NULL || (columns == NULL && !mInputs.empty()))
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  for (size_t i = 0; i < mInputs.size(); ++i)
+  {
+    if (columns[i] == NULL) return LIBSEDML_INVALID_OBJECT;
+  }
+
+  std::vector<double> stack(mMaxDepth * SED_MATH_BLOCK);
+
+  for (size_t offset = 0; offset < length; offset += SED_MATH_BLOCK)
+  {
+    size_t block = (length - offset < SED_MATH_BLOCK)
+                 ? length - offset : SED_MATH_BLOCK;
+    evaluateBlock(columns, offset, block, &stack[0], result + offset);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Evaluates the compiled math for a single sample.
+ */
+double
+SedCompiledMath::evaluate (const double* values) const
+{
+  if (!mCompiled || (values == NULL && !mInputs.empty()))
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  std::vector<const double*> columns(mInputs.size() + 1);
+  for (size_t i = 0; i < mInputs.size(); ++i)
+  {
+    columns[i] = values + i;
+  }
+
+  double result = 0;
+  evaluate(&columns[0], 1, &result);
+  return result;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Compiles math reading the variables, and the parameters as well if
+ * bindParameters is true, from columns; other parameters are folded in.
+ */
+int
+SedCompiledMath::compileMath (const ASTNode* math,
+                              const SedVariableList& variables,
+                              const SedParameterList& parameters,
+                              bool bindParameters)
+{
+  mCode.clear();
+  mConstants.clear();
+  mInputs.clear();
+  mNumVariables = 0;
+  mMaxDepth = 0;
+  mCompiled = false;
+
+  if (math == NULL)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  for (unsigned int i = 0; i < variables.size(); ++i)
+  {
+    mInputs.push_back(variables[i]->getId());
+  }
+  mNumVariables = (unsigned int)mInputs.size();
+
+  SedParameterList folded;
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    if (bindParameters)
+      mInputs.push_back(parameters[i]->getId());
+    else
+      folded.push_back(parameters[i]);
+  }
+
+  if (!compileNode(math, folded, 0))
+  {
+    mCode.clear();
+    mConstants.clear();
+    mInputs.clear();
+    mNumVariables = 0;
+    mMaxDepth = 0;
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Appends an instruction that leaves depth slots on the stack.
+ */
+void
+SedCompiledMath::emit (int op, unsigned int arg, unsigned int depth)
+{
+  Instruction instruction;
+  instruction.op  = op;
+  instruction.arg = arg;
+  mCode.push_back(instruction);
+
+  if (depth > mMaxDepth) mMaxDepth = depth;
+}
+
+
+/*
+ * Compiles node so that its value ends up in stack slot depth.
+ */
+bool
+SedCompiledMath::compileNode (const ASTNode* node,
+                              const SedParameterList& parameters,
+                              unsigned int depth)
+{
+  if (node == NULL) return false;
+
+  const int type = node->getType();
+  const unsigned int numChildren = node->getNumChildren();
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    mConstants.push_back((double)node->getInteger());
+    emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+    return true;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+    mConstants.push_back(node->getReal());
+    emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+    return true;
+
+  case AST_CONSTANT_E:
+  case AST_CONSTANT_PI:
+  case AST_CONSTANT_TRUE:
+  case AST_CONSTANT_FALSE:
+    mConstants.push_back(type == AST_CONSTANT_E    ? exp(1.0)
+                       : type == AST_CONSTANT_PI   ? 4.0 * atan(1.0)
+                       : type == AST_CONSTANT_TRUE ? 1.0 : 0.0);
+    emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+    return true;
+
+  case AST_NAME:
+  {
+    const char* name = node->getName();
+    if (name == NULL) return false;
+
+    for (unsigned int i = 0; i < mInputs.size(); ++i)
+    {
+      if (mInputs[i] == name)
+      {
+        emit(SED_OP_VAR, i, depth + 1);
+        return true;
+      }
+    }
+
+    // parameters that are not read from a column are folded in
+    for (unsigned int i = 0; i < parameters.size(); ++i)
+    {
+      const SedParameter* p = parameters[i];
+      if (p->getId() == name)
+      {
+        mConstants.push_back(p->getValue());
+        emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0), parameters, depth)) return false;
+      emit(SED_OP_NEG, 0, depth + 1);
+      return true;
+    }
+    break;
+
+  case AST_LOGICAL_NOT:
+    if (numChildren != 1 || !compileNode(node->getChild(0), parameters, depth))
+      return false;
+    emit(SED_OP_NOT, 0, depth + 1);
+    return true;
+
+  case AST_FUNCTION_ABS:
+  case AST_FUNCTION_FLOOR:
+  case AST_FUNCTION_CEILING:
+    if (numChildren != 1 || !compileNode(node->getChild(0), parameters, depth))
+      return false;
+    emit(type == AST_FUNCTION_ABS   ? SED_OP_ABS
+       : type == AST_FUNCTION_FLOOR ? SED_OP_FLOOR : SED_OP_CEIL, 0, depth + 1);
+    return true;
+
+  case AST_FUNCTION_LOG:
+  case AST_FUNCTION_ROOT:
+    if (numChildren == 2)
+    {
+      // log(b, x) = ln(x) / ln(b) and root(n, x) = x ^ (1 / n)
+      if (type == AST_FUNCTION_LOG)
+      {
+        if (!compileNode(node->getChild(1), parameters, depth)) return false;
+        emit(SED_OP_FUNC, getMathFunc(AST_FUNCTION_LN), depth + 1);
+        if (!compileNode(node->getChild(0), parameters, depth + 1)) return false;
+        emit(SED_OP_FUNC, getMathFunc(AST_FUNCTION_LN), depth + 2);
+        emit(SED_OP_DIV, 0, depth + 1);
+      }
+      else
+      {
+        if (!compileNode(node->getChild(1), parameters, depth)) return false;
+        mConstants.push_back(1.0);
+        emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 2);
+        if (!compileNode(node->getChild(0), parameters, depth + 2)) return false;
+        emit(SED_OP_DIV, 0, depth + 2);
+        emit(SED_OP_POW, 0, depth + 1);
+      }
+      return true;
+    }
+    break;
+
+  case AST_FUNCTION_PIECEWISE:
+  {
+    // start from the otherwise value and let each piece, from the last to
+    // the first, replace it where its condition holds
+    const unsigned int numPieces = numChildren / 2;
+    if (numChildren % 2 == 1)
+    {
+      if (!compileNode(node->getChild(numChildren - 1), parameters, depth))
+        return false;
+    }
+    else
+    {
+      mConstants.push_back(numeric_limits<double>::quiet_NaN());
+      emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+    }
+
+    for (unsigned int i = numPieces; i > 0; --i)
+    {
+      if (!compileNode(node->getChild(2 * i - 2), parameters, depth + 1)) return false;
+      if (!compileNode(node->getChild(2 * i - 1), parameters, depth + 2)) return false;
+      emit(SED_OP_SELECT, 0, depth + 1);
+    }
+    return true;
+  }
+
+  default:
+    break;
+  }
+
+  // functions of one argument
+  unsigned int func = getMathFunc(type);
+  if (func < NUM_SED_MATH_FUNCS)
+  {
+    if (numChildren != 1 || !compileNode(node->getChild(0), parameters, depth))
+      return false;
+    emit(SED_OP_FUNC, func, depth + 1);
+    return true;
+  }
+
+  // operators and relations
+  const int op = getBinaryOp(type);
+  if (op < 0) return false;
+
+  if (numChildren == 0)
+  {
+    // the empty sum and disjunction are 0, the empty product and
+    // conjunction 1; nothing else may be empty
+    if (op != SED_OP_ADD && op != SED_OP_MUL && op != SED_OP_AND
+      && op != SED_OP_OR && op != SED_OP_XOR)
+      return false;
+
+    mConstants.push_back((op == SED_OP_MUL || op == SED_OP_AND) ? 1.0 : 0.0);
+    emit(SED_OP_CONST, (unsigned int)mConstants.size() - 1, depth + 1);
+    return true;
+  }
+
+  const bool isRelation = (op >= SED_OP_EQ && op <= SED_OP_GEQ);
+
+  if (numChildren == 1)
+  {
+    if (isRelation || op == SED_OP_DIV || op == SED_OP_POW) return false;
+    if (!compileNode(node->getChild(0), parameters, depth)) return false;
+    if (op == SED_OP_AND || op == SED_OP_OR || op == SED_OP_XOR)
+    {
+      // make the operand a truth value, as the operator would
+      emit(SED_OP_NOT, 0, depth + 1);
+      emit(SED_OP_NOT, 0, depth + 1);
+    }
+    return true;
+  }
+
+  if ((op == SED_OP_NEQ || op == SED_OP_DIV || op == SED_OP_POW)
+    && numChildren != 2)
+  {
+    return false;
+  }
+
+  if (!compileNode(node->getChild(0), parameters, depth)) return false;
+
+  for (unsigned int i = 1; i < numChildren; ++i)
+  {
+    if (isRelation)
+    {
+      // a < b < c means a < b and b < c
+      if (i > 1 && !compileNode(node->getChild(i - 1), parameters, depth + 1))
+        return false;
+      unsigned int slot = (i > 1) ? depth + 1 : depth;
+      if (!compileNode(node->getChild(i), parameters, slot + 1)) return false;
+      emit(op, 0, slot + 1);
+      if (i > 1) emit(SED_OP_AND, 0, depth + 1);
+    }
+    else
+    {
+      if (!compileNode(node->getChild(i), parameters, depth + 1)) return false;
+      emit(op, 0, depth + 1);
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Runs the instructions over length samples starting at offset.
+ */
+void
+SedCompiledMath::evaluateBlock (const double* const* columns, size_t offset,
+                                size_t length, double* stack,
+                                double* result) const
+{
+  const size_t B = SED_MATH_BLOCK;
+
+  // number of occupied stack slots; slot k starts at stack + k * B
+  size_t sp = 0;
+
+  for (size_t pc = 0; pc < mCode.size(); ++pc)
+  {
+    const Instruction& in = mCode[pc];
+    double* x = (sp > 0) ? stack + (sp - 1) * B : stack;
+    double* a = (sp > 1) ? x - B : stack;
+    size_t i;
+
+    switch (in.op)
+    {
+    case SED_OP_CONST:
+    {
+      double* top = stack + sp++ * B;
+      const double c = mConstants[in.arg];
+      for (i = 0; i < length; ++i) top[i] = c;
+      break;
+    }
+    case SED_OP_VAR:
+      memcpy(stack + sp++ * B, columns[in.arg] + offset, length * sizeof(double));
+      break;
+
+    case SED_OP_ADD: for (i = 0; i < length; ++i) a[i] += x[i];       --sp; break;
+    case SED_OP_SUB: for (i = 0; i < length; ++i) a[i] -= x[i];       --sp; break;
+    case SED_OP_MUL: for (i = 0; i < length; ++i) a[i] *= x[i];       --sp; break;
+    case SED_OP_DIV: for (i = 0; i < length; ++i) a[i] /= x[i];       --sp; break;
+    case SED_OP_POW: for (i = 0; i < length; ++i) a[i] = pow(a[i], x[i]); --sp; break;
+
+    case SED_OP_EQ:  for (i = 0; i < length; ++i) a[i] = (a[i] == x[i]) ? 1.0 : 0.0; --sp; break;
+    case SED_OP_NEQ: for (i = 0; i < length; ++i) a[i] = (a[i] != x[i]) ? 1.0 : 0.0; --sp; break;
+    case SED_OP_LT:  for (i = 0; i < length; ++i) a[i] = (a[i] <  x[i]) ? 1.0 : 0.0; --sp; break;
+    case SED_OP_LEQ: for (i = 0; i < length; ++i) a[i] = (a[i] <= x[i]) ? 1.0 : 0.0; --sp; break;
+    case SED_OP_GT:  for (i = 0; i < length; ++i) a[i] = (a[i] >  x[i]) ? 1.0 : 0.0; --sp; break;
+    case SED_OP_GEQ: for (i = 0; i < length; ++i) a[i] = (a[i] >= x[i]) ? 1.0 : 0.0; --sp; break;
+
+    case SED_OP_AND:
+      for (i = 0; i < length; ++i) a[i] = (a[i] != 0 && x[i] != 0) ? 1.0 : 0.0;
+      --sp;
+      break;
+    case SED_OP_OR:
+      for (i = 0; i < length; ++i) a[i] = (a[i] != 0 || x[i] != 0) ? 1.0 : 0.0;
+      --sp;
+      break;
+    case SED_OP_XOR:
+      for (i = 0; i < length; ++i) a[i] = ((a[i] != 0) != (x[i] != 0)) ? 1.0 : 0.0;
+      --sp;
+      break;
+
+    case SED_OP_SELECT:
+    {
+      double* r = a - B;
+      for (i = 0; i < length; ++i) r[i] = (x[i] != 0) ? a[i] : r[i];
+      sp -= 2;
+      break;
+    }
+
+    case SED_OP_NEG:   for (i = 0; i < length; ++i) x[i] = -x[i];                  break;
+    case SED_OP_NOT:   for (i = 0; i < length; ++i) x[i] = (x[i] == 0) ? 1.0 : 0.0; break;
+    case SED_OP_ABS:   for (i = 0; i < length; ++i) x[i] = fabs(x[i]);             break;
+    case SED_OP_FLOOR: for (i = 0; i < length; ++i) x[i] = floor(x[i]);            break;
+    case SED_OP_CEIL:  for (i = 0; i < length; ++i) x[i] = ceil(x[i]);             break;
+
+    case SED_OP_FUNC:
+    {
+      double (*func) (double) = SED_MATH_FUNCS[in.arg].func;
+      for (i = 0; i < length; ++i) x[i] = func(x[i]);
+      break;
+    }
+    }
+  }
+
+  memcpy(result, stack, length * sizeof(double));
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return the number of operations op is applied to.
+ */
+static unsigned int
+getNumArgs (int op)
+{
+  switch (op)
+  {
+  case SED_OP_CONST:
+  case SED_OP_VAR:
+    return 0;
+
+  case SED_OP_NEG:
+  case SED_OP_NOT:
+  case SED_OP_ABS:
+  case SED_OP_FLOOR:
+  case SED_OP_CEIL:
+  case SED_OP_FUNC:
+    return 1;
+
+  case SED_OP_SELECT:
+    return 3;
+
+  default:
+    return 2;
+  }
+}
+
+
+/*
+ * Orders operations by their instruction, then by their operands.
+ */
+bool
+SedCompiledMathSet::Operation::operator< (const Operation& rhs) const
+{
+  if (op  != rhs.op)  return op < rhs.op;
+  if (arg != rhs.arg) return arg < rhs.arg;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (args[i] != rhs.args[i]) return args[i] < rhs.args[i];
+  }
+  return false;
+}
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedCompiledMathSet.
+ */
+SedCompiledMathSet::SedCompiledMathSet ()
+  : mNumSlots (0)
+{
+}
+
+
+/*
+ * Destroys this SedCompiledMathSet.
+ */
+SedCompiledMathSet::~SedCompiledMathSet ()
+{
+}
+
+
+/*
+ * Adds the math of dg to the data generators compiled.
+ */
+int
+SedCompiledMathSet::add (const SedDataGenerator* dg)
+{
+  if (dg == NULL || dg->getMath() == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const size_t numOperations = mOperations.size();
+  const size_t numConstants  = mConstants.size();
+  const size_t numInputs     = mInputs.size();
+
+  // the variables are bound by what they refer to, not by their ids,
+  // which are only unique within their data generator
+  std::map<std::string, unsigned int> names;
+  for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+  {
+    const SedVariable* variable = dg->getVariable(i);
+
+    const std::string binding = variable->getTaskReference() + '\n'
+      + variable->getModelReference() + '\n' + variable->getTarget() + '\n'
+      + variable->getSymbol();
+
+    std::map<std::string, unsigned int>::const_iterator it =
+      mInputIndex.find(binding);
+    unsigned int input = 0;
+    if (it != mInputIndex.end())
+    {
+      input = it->second;
+    }
+    else
+    {
+      Input added;
+      added.id            = variable->getId();
+      added.taskReference = variable->getTaskReference();
+      input = (unsigned int)mInputs.size();
+      mInputIndex[binding] = input;
+      mInputs.push_back(added);
+    }
+
+    // the first of several variables of the same id is the one used
+    if (names.find(variable->getId()) == names.end())
+    {
+      names[variable->getId()] = addOperation(SED_OP_VAR, input);
+    }
+  }
+
+  SedParameterList parameters;
+  for (unsigned int i = 0; i < dg->getNumParameters(); ++i)
+  {
+    parameters.push_back(dg->getParameter(i));
+  }
+
+  unsigned int root = 0;
+  if (!compileNode(dg->getMath(), parameters, names, root))
+  {
+    // what this data generator added is taken out again
+    for (size_t k = numOperations; k < mOperations.size(); ++k)
+    {
+      mOperationIndex.erase(mOperations[k]);
+    }
+    mOperations.resize(numOperations);
+
+    for (size_t k = numConstants; k < mConstants.size(); ++k)
+    {
+      mConstantIndex.erase(std::string((const char*)&mConstants[k],
+                                       sizeof(double)));
+    }
+    mConstants.resize(numConstants);
+
+    std::map<std::string, unsigned int>::iterator it = mInputIndex.begin();
+    while (it != mInputIndex.end())
+    {
+      if (it->second >= numInputs)
+        mInputIndex.erase(it++);
+      else
+        ++it;
+    }
+    mInputs.resize(numInputs);
+
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mIds.push_back(dg->getId());
+  mRoots.push_back(root);
+  schedule();
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Removes all data generators compiled.
+ */
+void
+SedCompiledMathSet::clear ()
+{
+  mOperations.clear();
+  mOperationIndex.clear();
+  mConstants.clear();
+  mConstantIndex.clear();
+  mInputs.clear();
+  mInputIndex.clear();
+  mIds.clear();
+  mRoots.clear();
+  mSlots.clear();
+  mNumSlots = 0;
+}
+
+
+/*
+ * Returns the number of data generators added.
+ */
+unsigned int
+SedCompiledMathSet::getNumDataGenerators () const
+{
+  return (unsigned int)mIds.size();
+}
+
+
+/*
+ * Returns the id of the n-th data generator added.
+ */
+const std::string&
+SedCompiledMathSet::getDataGeneratorId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mIds.size()) ? mIds[n] : empty;
+}
+
+
+/*
+ * Returns the number of input columns.
+ */
+unsigned int
+SedCompiledMathSet::getNumInputs () const
+{
+  return (unsigned int)mInputs.size();
+}
+
+
+/*
+ * Returns the id of the first variable bound to column n.
+ */
+const std::string&
+SedCompiledMathSet::getInputId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mInputs.size()) ? mInputs[n].id : empty;
+}
+
+
+/*
+ * Returns the task reference of the variables bound to column n.
+ */
+const std::string&
+SedCompiledMathSet::getInputTaskReference (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mInputs.size()) ? mInputs[n].taskReference : empty;
+}
+
+
+/*
+ * Returns the number of distinct operations of the graph.
+ */
+unsigned int
+SedCompiledMathSet::getNumOperations () const
+{
+  return (unsigned int)mOperations.size();
+}
+
+
+/*
+ * Evaluates the math of all data generators for length samples.
+ */
+int
+SedCompiledMathSet::evaluate (const double* const* columns, size_t length,
+                              double* const* results) const
+{
+  if ((columns == NULL && !mInputs.empty())
+      || (results == NULL && !mRoots.empty()))
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  for (size_t i = 0; i < mInputs.size(); ++i)
+  {
+    if (columns[i] == NULL) return LIBSEDML_INVALID_OBJECT;
+  }
+
+  for (size_t i = 0; i < mRoots.size(); ++i)
+  {
+    if (results[i] == NULL) return LIBSEDML_INVALID_OBJECT;
+  }
+
+  const size_t B = SED_MATH_BLOCK;
+  std::vector<double> stack(mNumSlots * B + 1);
+  std::vector<const double*> values(mOperations.size());
+
+  for (size_t offset = 0; offset < length; offset += B)
+  {
+    const size_t block = (length - offset < B) ? length - offset : B;
+
+    for (size_t k = 0; k < mOperations.size(); ++k)
+    {
+      const Operation& o = mOperations[k];
+      if (o.op == SED_OP_VAR)
+      {
+        // inputs are read where they are
+        values[k] = columns[o.arg] + offset;
+        continue;
+      }
+
+      double* r = &stack[mSlots[k] * B];
+      const double* a = values[o.args[0]];
+      const double* b = values[o.args[1]];
+      const double* c = values[o.args[2]];
+      size_t i;
+
+      switch (o.op)
+      {
+      case SED_OP_CONST:
+      {
+        const double value = mConstants[o.arg];
+        for (i = 0; i < block; ++i) r[i] = value;
+        break;
+      }
+
+      case SED_OP_ADD: for (i = 0; i < block; ++i) r[i] = a[i] + b[i];     break;
+      case SED_OP_SUB: for (i = 0; i < block; ++i) r[i] = a[i] - b[i];     break;
+      case SED_OP_MUL: for (i = 0; i < block; ++i) r[i] = a[i] * b[i];     break;
+      case SED_OP_DIV: for (i = 0; i < block; ++i) r[i] = a[i] / b[i];     break;
+      case SED_OP_POW: for (i = 0; i < block; ++i) r[i] = pow(a[i], b[i]); break;
+
+      case SED_OP_EQ:  for (i = 0; i < block; ++i) r[i] = (a[i] == b[i]) ? 1.0 : 0.0; break;
+      case SED_OP_NEQ: for (i = 0; i < block; ++i) r[i] = (a[i] != b[i]) ? 1.0 : 0.0; break;
+      case SED_OP_LT:  for (i = 0; i < block; ++i) r[i] = (a[i] <  b[i]) ? 1.0 : 0.0; break;
+      case SED_OP_LEQ: for (i = 0; i < block; ++i) r[i] = (a[i] <= b[i]) ? 1.0 : 0.0; break;
+      case SED_OP_GT:  for (i = 0; i < block; ++i) r[i] = (a[i] >  b[i]) ? 1.0 : 0.0; break;
+      case SED_OP_GEQ: for (i = 0; i < block; ++i) r[i] = (a[i] >= b[i]) ? 1.0 : 0.0; break;
+
+      case SED_OP_AND:
+        for (i = 0; i < block; ++i) r[i] = (a[i] != 0 && b[i] != 0) ? 1.0 : 0.0;
+        break;
+      case SED_OP_OR:
+        for (i = 0; i < block; ++i) r[i] = (a[i] != 0 || b[i] != 0) ? 1.0 : 0.0;
+        break;
+      case SED_OP_XOR:
+        for (i = 0; i < block; ++i) r[i] = ((a[i] != 0) != (b[i] != 0)) ? 1.0 : 0.0;
+        break;
+
+      case SED_OP_SELECT:
+        for (i = 0; i < block; ++i) r[i] = (c[i] != 0) ? b[i] : a[i];
+        break;
+
+      case SED_OP_NEG:   for (i = 0; i < block; ++i) r[i] = -a[i];                  break;
+      case SED_OP_NOT:   for (i = 0; i < block; ++i) r[i] = (a[i] == 0) ? 1.0 : 0.0; break;
+      case SED_OP_ABS:   for (i = 0; i < block; ++i) r[i] = fabs(a[i]);             break;
+      case SED_OP_FLOOR: for (i = 0; i < block; ++i) r[i] = floor(a[i]);            break;
+      case SED_OP_CEIL:  for (i = 0; i < block; ++i) r[i] = ceil(a[i]);             break;
+
+      case SED_OP_FUNC:
+      {
+        double (*func) (double) = SED_MATH_FUNCS[o.arg].func;
+        for (i = 0; i < block; ++i) r[i] = func(a[i]);
+        break;
+      }
+      }
+
+      values[k] = r;
+    }
+
+    for (size_t n = 0; n < mRoots.size(); ++n)
+    {
+      memcpy(results[n] + offset, values[mRoots[n]], block * sizeof(double));
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Compiles node into operations of the graph, setting result to the one
+ * computing its value.
+ */
+bool
+SedCompiledMathSet::compileNode (const ASTNode* node,
+                                 const SedParameterList& parameters,
+                                 const std::map<std::string, unsigned int>& names,
+                                 unsigned int& result)
+{
+  if (node == NULL) return false;
+
+  const int type = node->getType();
+  const unsigned int numChildren = node->getNumChildren();
+  unsigned int a = 0;
+  unsigned int b = 0;
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    result = addConstant((double)node->getInteger());
+    return true;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+    result = addConstant(node->getReal());
+    return true;
+
+  case AST_CONSTANT_E:
+  case AST_CONSTANT_PI:
+  case AST_CONSTANT_TRUE:
+  case AST_CONSTANT_FALSE:
+    result = addConstant(type == AST_CONSTANT_E    ? exp(1.0)
+                       : type == AST_CONSTANT_PI   ? 4.0 * atan(1.0)
+                       : type == AST_CONSTANT_TRUE ? 1.0 : 0.0);
+    return true;
+
+  case AST_NAME:
+  {
+    const char* name = node->getName();
+    if (name == NULL) return false;
+
+    std::map<std::string, unsigned int>::const_iterator it = names.find(name);
+    if (it != names.end())
+    {
+      result = it->second;
+      return true;
+    }
+
+    for (unsigned int i = 0; i < parameters.size(); ++i)
+    {
+      if (parameters[i]->getId() == name)
+      {
+        result = addConstant(parameters[i]->getValue());
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      if (!compileNode(node->getChild(0), parameters, names, a)) return false;
+      result = addOperation(SED_OP_NEG, 0, a);
+      return true;
+    }
+    break;
+
+  case AST_LOGICAL_NOT:
+  case AST_FUNCTION_ABS:
+  case AST_FUNCTION_FLOOR:
+  case AST_FUNCTION_CEILING:
+    if (numChildren != 1 || !compileNode(node->getChild(0), parameters, names, a))
+      return false;
+    result = addOperation(type == AST_LOGICAL_NOT    ? SED_OP_NOT
+                        : type == AST_FUNCTION_ABS   ? SED_OP_ABS
+                        : type == AST_FUNCTION_FLOOR ? SED_OP_FLOOR
+                                                     : SED_OP_CEIL, 0, a);
+    return true;
+
+  case AST_FUNCTION_LOG:
+  case AST_FUNCTION_ROOT:
+    if (numChildren == 2)
+    {
+      // log(b, x) = ln(x) / ln(b) and root(n, x) = x ^ (1 / n)
+      if (!compileNode(node->getChild(0), parameters, names, a)) return false;
+      if (!compileNode(node->getChild(1), parameters, names, b)) return false;
+
+      if (type == AST_FUNCTION_LOG)
+      {
+        const unsigned int ln = getMathFunc(AST_FUNCTION_LN);
+        result = addBinary(SED_OP_DIV, addOperation(SED_OP_FUNC, ln, b),
+                                       addOperation(SED_OP_FUNC, ln, a));
+      }
+      else
+      {
+        result = addBinary(SED_OP_POW, b,
+                           addBinary(SED_OP_DIV, addConstant(1.0), a));
+      }
+      return true;
+    }
+    break;
+
+  case AST_FUNCTION_PIECEWISE:
+  {
+    // start from the otherwise value and let each piece, from the last to
+    // the first, replace it where its condition holds
+    const unsigned int numPieces = numChildren / 2;
+    if (numChildren % 2 == 1)
+    {
+      if (!compileNode(node->getChild(numChildren - 1), parameters, names,
+                       result))
+        return false;
+    }
+    else
+    {
+      result = addConstant(numeric_limits<double>::quiet_NaN());
+    }
+
+    for (unsigned int i = numPieces; i > 0; --i)
+    {
+      if (!compileNode(node->getChild(2 * i - 2), parameters, names, a)) return false;
+      if (!compileNode(node->getChild(2 * i - 1), parameters, names, b)) return false;
+      result = addOperation(SED_OP_SELECT, 0, result, a, b);
+    }
+    return true;
+  }
+
+  default:
+    break;
+  }
+
+  // functions of one argument
+  unsigned int func = getMathFunc(type);
+  if (func < NUM_SED_MATH_FUNCS)
+  {
+    if (numChildren != 1 || !compileNode(node->getChild(0), parameters, names, a))
+      return false;
+    result = addOperation(SED_OP_FUNC, func, a);
+    return true;
+  }
+
+  // operators and relations
+  const int op = getBinaryOp(type);
+  if (op < 0) return false;
+
+  if (numChildren == 0)
+  {
+    if (op != SED_OP_ADD && op != SED_OP_MUL && op != SED_OP_AND
+      && op != SED_OP_OR && op != SED_OP_XOR)
+      return false;
+
+    result = addConstant((op == SED_OP_MUL || op == SED_OP_AND) ? 1.0 : 0.0);
+    return true;
+  }
+
+  const bool isRelation = (op >= SED_OP_EQ && op <= SED_OP_GEQ);
+
+  if (numChildren == 1)
+  {
+    if (isRelation || op == SED_OP_DIV || op == SED_OP_POW) return false;
+    if (!compileNode(node->getChild(0), parameters, names, result)) return false;
+    if (op == SED_OP_AND || op == SED_OP_OR || op == SED_OP_XOR)
+    {
+      result = addOperation(SED_OP_NOT, 0, addOperation(SED_OP_NOT, 0, result));
+    }
+    return true;
+  }
+
+  if ((op == SED_OP_NEQ || op == SED_OP_DIV || op == SED_OP_POW)
+    && numChildren != 2)
+  {
+    return false;
+  }
+
+  if (!compileNode(node->getChild(0), parameters, names, a)) return false;
+
+  for (unsigned int i = 1; i < numChildren; ++i)
+  {
+    if (!compileNode(node->getChild(i), parameters, names, b)) return false;
+
+    if (isRelation)
+    {
+      // a < b < c means a < b and b < c
+      const unsigned int relation = addBinary(op, a, b);
+      result = (i > 1) ? addBinary(SED_OP_AND, result, relation) : relation;
+      a = b;
+    }
+    else
+    {
+      a = addBinary(op, a, b);
+      result = a;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns the operation pushing value, adding it if it is new.
+ */
+unsigned int
+SedCompiledMathSet::addConstant (double value)
+{
+  // constants are told apart by their bits, so that NaN and -0 are too
+  const std::string key((const char*)&value, sizeof(double));
+
+  std::map<std::string, unsigned int>::const_iterator it =
+    mConstantIndex.find(key);
+  if (it != mConstantIndex.end()) return addOperation(SED_OP_CONST, it->second);
+
+  const unsigned int index = (unsigned int)mConstants.size();
+  mConstants.push_back(value);
+  mConstantIndex[key] = index;
+  return addOperation(SED_OP_CONST, index);
+}
+
+
+/*
+ * Returns the operation applying op to a, b and c, adding it if it is new.
+ */
+unsigned int
+SedCompiledMathSet::addOperation (int op, unsigned int arg, unsigned int a,
+                                  unsigned int b, unsigned int c)
+{
+  Operation operation;
+  operation.op      = op;
+  operation.arg     = arg;
+  operation.args[0] = a;
+  operation.args[1] = b;
+  operation.args[2] = c;
+
+  std::map<Operation, unsigned int>::const_iterator it =
+    mOperationIndex.find(operation);
+  if (it != mOperationIndex.end()) return it->second;
+
+  const unsigned int index = (unsigned int)mOperations.size();
+  mOperations.push_back(operation);
+  mOperationIndex[operation] = index;
+  return index;
+}
+
+
+/*
+ * Returns the operation applying the binary op to a and b in canonical
+ * form, adding it if it is new.
+ */
+unsigned int
+SedCompiledMathSet::addBinary (int op, unsigned int a, unsigned int b)
+{
+  // a > b is b < a, even for NaN
+  if (op == SED_OP_GT || op == SED_OP_GEQ)
+  {
+    op = (op == SED_OP_GT) ? SED_OP_LT : SED_OP_LEQ;
+    std::swap(a, b);
+  }
+
+  // operands of commutative operations are ordered, which changes no bit
+  // of the result as each application has just two of them
+  const bool commutative = (op == SED_OP_ADD || op == SED_OP_MUL
+    || op == SED_OP_EQ || op == SED_OP_NEQ || op == SED_OP_AND
+    || op == SED_OP_OR || op == SED_OP_XOR);
+  if (commutative && b < a) std::swap(a, b);
+
+  return addOperation(op, 0, a, b);
+}
+
+
+/*
+ * Assigns every operation a block of the stack, reusing the blocks of
+ * operations whose value is no longer needed.
+ */
+void
+SedCompiledMathSet::schedule ()
+{
+  const unsigned int total = (unsigned int)mOperations.size();
+
+  // the last operation using each one; results are kept to the end
+  std::vector<unsigned int> lastUse(total);
+  for (unsigned int k = 0; k < total; ++k)
+  {
+    lastUse[k] = k;
+    for (unsigned int j = 0; j < getNumArgs(mOperations[k].op); ++j)
+    {
+      lastUse[mOperations[k].args[j]] = k;
+    }
+  }
+  for (unsigned int n = 0; n < mRoots.size(); ++n)
+  {
+    lastUse[mRoots[n]] = total;
+  }
+
+  mSlots.assign(total, 0);
+  mNumSlots = 0;
+  std::vector<unsigned int> released;
+
+  for (unsigned int k = 0; k < total; ++k)
+  {
+    const Operation& o = mOperations[k];
+    if (o.op == SED_OP_VAR) continue;
+
+    // an operation may write over the block of an operand it is the last
+    // to use, as it reads each sample before writing it
+    const unsigned int numArgs = getNumArgs(o.op);
+    for (unsigned int j = 0; j < numArgs; ++j)
+    {
+      const unsigned int d = o.args[j];
+      bool repeated = false;
+      for (unsigned int i = 0; i < j; ++i) repeated |= (o.args[i] == d);
+
+      if (!repeated && lastUse[d] == k && mOperations[d].op != SED_OP_VAR)
+      {
+        released.push_back(mSlots[d]);
+      }
+    }
+
+    if (released.empty())
+    {
+      mSlots[k] = mNumSlots++;
+    }
+    else
+    {
+      mSlots[k] = released.back();
+      released.pop_back();
+    }
+
+    if (lastUse[k] == k) released.push_back(mSlots[k]);
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedCompiledMath and returns it.
+ */
+LIBSEDML_EXTERN
+SedCompiledMath_t *
+SedCompiledMath_create ()
+{
+  return new (nothrow) SedCompiledMath;
+}
+
+
+/**
+ * Frees the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+void
+SedCompiledMath_free (SedCompiledMath_t *scm)
+{
+  delete scm;
+}
+
+
+/**
+ * Compiles the math of the given SedDataGenerator.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_compile (SedCompiledMath_t *scm, const SedDataGenerator_t *dg)
+{
+  return (scm != NULL) ? scm->compile(dg) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Compiles the math of the given SedComputeChange.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_compileComputeChange (SedCompiledMath_t *scm,
+                                      const SedComputeChange_t *cc,
+                                      int bindParameters)
+{
+  return (scm != NULL) ? scm->compile(cc, bindParameters != 0)
+                       : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of variables of the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMath_getNumVariables (const SedCompiledMath_t *scm)
+{
+  return (scm != NULL) ? scm->getNumVariables() : 0;
+}
+
+
+/**
+ * Returns the id of the variable read from column n.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMath_getVariableId (const SedCompiledMath_t *scm, unsigned int n)
+{
+  if (scm == NULL || n >= scm->getNumVariables()) return NULL;
+  return scm->getVariableId(n).c_str();
+}
+
+
+/**
+ * Returns the number of input columns of the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMath_getNumInputs (const SedCompiledMath_t *scm)
+{
+  return (scm != NULL) ? scm->getNumInputs() : 0;
+}
+
+
+/**
+ * Returns the id of the variable or parameter read from column n.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMath_getInputId (const SedCompiledMath_t *scm, unsigned int n)
+{
+  if (scm == NULL || n >= scm->getNumInputs()) return NULL;
+  return scm->getInputId(n).c_str();
+}
+
+
+/**
+ * Evaluates the compiled math for length samples of the given columns.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_evaluate (const SedCompiledMath_t *scm,
+                          const double *const *columns, size_t length,
+                          double *result)
+{
+  return (scm != NULL) ? scm->evaluate(columns, length, result)
+                       : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Creates a new, empty SedCompiledMathSet and returns it.
+ */
+LIBSEDML_EXTERN
+SedCompiledMathSet_t *
+SedCompiledMathSet_create ()
+{
+  return new (nothrow) SedCompiledMathSet;
+}
+
+
+/**
+ * Frees the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+void
+SedCompiledMathSet_free (SedCompiledMathSet_t *scms)
+{
+  delete scms;
+}
+
+
+/**
+ * Adds the math of the given SedDataGenerator.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMathSet_add (SedCompiledMathSet_t *scms, const SedDataGenerator_t *dg)
+{
+  return (scms != NULL) ? scms->add(dg) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of data generators of the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMathSet_getNumDataGenerators (const SedCompiledMathSet_t *scms)
+{
+  return (scms != NULL) ? scms->getNumDataGenerators() : 0;
+}
+
+
+/**
+ * Returns the number of input columns of the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMathSet_getNumInputs (const SedCompiledMathSet_t *scms)
+{
+  return (scms != NULL) ? scms->getNumInputs() : 0;
+}
+
+
+/**
+ * Returns the id of the first variable bound to column n.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMathSet_getInputId (const SedCompiledMathSet_t *scms,
+                               unsigned int n)
+{
+  if (scms == NULL || n >= scms->getNumInputs()) return NULL;
+  return scms->getInputId(n).c_str();
+}
+
+
+/**
+ * Returns the task reference of the variables bound to column n.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMathSet_getInputTaskReference (const SedCompiledMathSet_t *scms,
+                                          unsigned int n)
+{
+  if (scms == NULL || n >= scms->getNumInputs()) return NULL;
+  return scms->getInputTaskReference(n).c_str();
+}
+
+
+/**
+ * Evaluates the math of all data generators for length samples.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMathSet_evaluate (const SedCompiledMathSet_t *scms,
+                             const double *const *columns, size_t length,
+                             double *const *results)
+{
+  return (scms != NULL) ? scms->evaluate(columns, length, results)
+                        : LIBSEDML_INVALID_OBJECT;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,600 @@
+/**
+ * @file    SedCompiledMath.h
+ * @brief   Evaluates data generator and compute change math over columns
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedCompiledMath
+ * @ingroup Core
+ * @brief The math of a SedDataGenerator or SedComputeChange translated for
+ * fast evaluation.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * compile() translates the math of a SedDataGenerator or a
+ * SedComputeChange into a flat list of instructions for a stack machine.
+ * Each of its variables becomes an input column, in the order of its
+ * SedListOfVariables.  The values of its parameters are folded in as
+ * constants, unless compile() is asked to bind them: then each parameter
+ * becomes another input column, after the variables, so that a parameter
+ * scan evaluates a whole sweep of parameter values in one call instead of
+ * recompiling for every point.  evaluate() then runs the instructions over whole columns of samples:
+ * every instruction is a tight loop over a block of samples, which the
+ * compiler can vectorise, rather than one walk over the ASTNode tree per
+ * sample.
+ *
+ * Supported are numbers, the constants @em pi, @em exponentiale, @em true
+ * and @em false, the arithmetic operators, @em power, @em root, @em exp,
+ * @em ln, @em log, @em abs, @em floor, @em ceiling, the trigonometric and
+ * hyperbolic functions and their inverses, the relational and logical
+ * operators, and @em piecewise.  Relational and logical operators yield
+ * 1 or 0.  compile() fails for anything else, for instance for calls of
+ * user-defined functions or for names that are neither a variable nor a
+ * parameter of the element compiled.
+ *
+ * A SedCompiledMath does not refer to the element compiled after
+ * compile() returns, and evaluate() does not change it, so one compiled
+ * object can be used by several threads at the same time.
+ */
+
+#ifndef SedCompiledMath_h
+#define SedCompiledMath_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+class SedComputeChange;
+class SedVariable;
+class SedParameter;
+
+
+class LIBSEDML_EXTERN SedCompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty SedCompiledMath.
+   */
+  SedCompiledMath ();
+
+
+  /**
+   * Destroys this SedCompiledMath.
+   */
+  virtual ~SedCompiledMath ();
+
+
+  /**
+   * Compiles the math of @p dg, replacing what was compiled before.
+   *
+   * @param dg the data generator.
+   * @param bindParameters if @c true, the parameters of @p dg are read
+   * from the columns after its variables rather than folded in.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p dg is @c NULL or has no math
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math uses something that cannot be compiled
+   */
+  int compile (const SedDataGenerator* dg, bool bindParameters = false);
+
+
+  /**
+   * Compiles the math of @p cc, replacing what was compiled before.
+   *
+   * @param cc the compute change.
+   * @param bindParameters if @c true, the parameters of @p cc are read
+   * from the columns after its variables rather than folded in.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p cc is @c NULL or has no math
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math uses something that cannot be compiled
+   */
+  int compile (const SedComputeChange* cc, bool bindParameters = false);
+
+
+  /**
+   * @return @c true if compile() succeeded last time it was called.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * @return the number of input columns: the variables of the element
+   * compiled, followed by its parameters if they were bound.
+   */
+  unsigned int getNumInputs () const;
+
+
+  /**
+   * @return the id of the variable or parameter read from column @p n, or
+   * an empty string if @p n is out of range.
+   */
+  const std::string& getInputId (unsigned int n) const;
+
+
+  /**
+   * @return the number of variables of the element compiled; they are
+   * read from the first getNumVariables() columns.
+   */
+  unsigned int getNumVariables () const;
+
+
+  /**
+   * @return the id of the variable read from column @p n, or an empty
+   * string if @p n is not the column of a variable.
+   */
+  const std::string& getVariableId (unsigned int n) const;
+
+
+  /**
+   * @return the number of instructions the math was compiled to.
+   */
+  unsigned int getNumInstructions () const;
+
+
+  /**
+   * Evaluates the compiled math for @p length samples.
+   *
+   * @param columns an array of getNumInputs() pointers, the n-th of
+   * which points to the @p length values of the input getInputId(n).
+   * @param length the number of samples.
+   * @param result receives the @p length results; it may be one of the
+   * columns.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if nothing has been compiled or a pointer is @c NULL
+   */
+  int evaluate (const double* const* columns, size_t length,
+                double* result) const;
+
+
+  /**
+   * Evaluates the compiled math for a single sample.
+   *
+   * @param values the getNumInputs() values of the inputs.
+   *
+   * @return the result, or NaN if nothing has been compiled.
+   */
+  double evaluate (const double* values) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Instruction
+  {
+    int          op;
+    unsigned int arg;
+  };
+
+  typedef std::vector<const SedVariable*>  SedVariableList;
+  typedef std::vector<const SedParameter*> SedParameterList;
+
+  int compileMath (const ASTNode* math, const SedVariableList& variables,
+                   const SedParameterList& parameters, bool bindParameters);
+
+  bool compileNode (const ASTNode* node, const SedParameterList& parameters,
+                    unsigned int depth);
+
+  void emit (int op, unsigned int arg, unsigned int depth);
+
+  void evaluateBlock (const double* const* columns, size_t offset,
+                      size_t length, double* stack, double* result) const;
+
+
+  std::vector<Instruction> mCode;
+  std::vector<double>      mConstants;
+  std::vector<std::string> mInputs;
+  unsigned int             mNumVariables;
+  unsigned int             mMaxDepth;
+  bool                     mCompiled;
+
+  /** @endcond */
+};
+
+/**
+ * @class SedCompiledMathSet
+ * @ingroup Core
+ * @brief The math of several SedDataGenerator objects translated together,
+ * so that what they have in common is evaluated once.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The data generators of a document often compute overlapping
+ * expressions over the same variables, such as species concentrations
+ * that are all divided by the same total.  add() compiles the math of
+ * each SedDataGenerator into one graph of operations shared by all those
+ * added before it:
+ *
+ * @li variables of different data generators that refer to the same
+ * task, model, target and symbol are bound to the same input column, so
+ * only one of them needs to be extracted from the results of the task;
+ * @li the math is put into a canonical form first: parameters are folded
+ * in as constants, the operands of @em plus, @em times, @em eq, @em neq,
+ * @em and, @em or and @em xor are sorted, and @em gt and @em geq become
+ * @em lt and @em leq with their operands swapped;
+ * @li every operation on the same operands, within a data generator or
+ * across several of them, appears once in the graph.
+ *
+ * Operators of more than two operands are applied from left to right, as
+ * SedCompiledMath does, and only the operands of each application are
+ * sorted, so the results are the same, to the last bit, as those of
+ * SedCompiledMath compiling each data generator on its own.
+ *
+ * evaluate() computes every operation of the graph once per block of
+ * samples, keeping only the intermediate values that are still needed,
+ * and copies the values of each data generator to its result column.
+ * Like a SedCompiledMath, a SedCompiledMathSet does not refer to the data
+ * generators added to it, and evaluate() can be called by several threads
+ * at the same time.
+ */
+class LIBSEDML_EXTERN SedCompiledMathSet
+{
+public:
+
+  /**
+   * Creates a new, empty SedCompiledMathSet.
+   */
+  SedCompiledMathSet ();
+
+
+  /**
+   * Destroys this SedCompiledMathSet.
+   */
+  virtual ~SedCompiledMathSet ();
+
+
+  /**
+   * Adds the math of @p dg to the data generators compiled.
+   *
+   * @param dg the data generator.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p dg is @c NULL or has no math
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math uses something that cannot be compiled, in which case
+   * this SedCompiledMathSet is left as it was
+   */
+  int add (const SedDataGenerator* dg);
+
+
+  /**
+   * Removes all data generators compiled.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of data generators added.
+   */
+  unsigned int getNumDataGenerators () const;
+
+
+  /**
+   * @return the id of the n-th data generator added, or an empty string
+   * if @p n is out of range.
+   */
+  const std::string& getDataGeneratorId (unsigned int n) const;
+
+
+  /**
+   * @return the number of input columns, one for each distinct variable
+   * binding of the data generators added.
+   */
+  unsigned int getNumInputs () const;
+
+
+  /**
+   * @return the id of the first variable bound to column @p n, or an
+   * empty string if @p n is out of range.
+   */
+  const std::string& getInputId (unsigned int n) const;
+
+
+  /**
+   * @return the task reference of the variables bound to column @p n, or
+   * an empty string if @p n is out of range.
+   */
+  const std::string& getInputTaskReference (unsigned int n) const;
+
+
+  /**
+   * @return the number of distinct operations of the graph, constants
+   * and inputs included.
+   */
+  unsigned int getNumOperations () const;
+
+
+  /**
+   * Evaluates the math of all data generators for @p length samples.
+   *
+   * @param columns an array of getNumInputs() pointers, the n-th of
+   * which points to the @p length values of the input getInputId(n).
+   * @param length the number of samples.
+   * @param results an array of getNumDataGenerators() pointers, the n-th
+   * of which receives the @p length values of getDataGeneratorId(n).
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a pointer is @c NULL
+   */
+  int evaluate (const double* const* columns, size_t length,
+                double* const* results) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * An operation of the graph; args are the indices of the operations
+   * it is applied to, unused ones are 0.
+   */
+  struct Operation
+  {
+    int          op;
+    unsigned int arg;
+    unsigned int args[3];
+
+    bool operator< (const Operation& rhs) const;
+  };
+
+  struct Input
+  {
+    std::string id;
+    std::string taskReference;
+  };
+
+  typedef std::vector<const SedParameter*> SedParameterList;
+
+  bool compileNode (const ASTNode* node, const SedParameterList& parameters,
+                    const std::map<std::string, unsigned int>& names,
+                    unsigned int& result);
+
+  unsigned int addConstant (double value);
+
+  unsigned int addOperation (int op, unsigned int arg, unsigned int a = 0,
+                             unsigned int b = 0, unsigned int c = 0);
+
+  unsigned int addBinary (int op, unsigned int a, unsigned int b);
+
+  void schedule ();
+
+
+  std::vector<Operation>                  mOperations;
+  std::map<Operation, unsigned int>       mOperationIndex;
+  std::vector<double>                     mConstants;
+  std::map<std::string, unsigned int>     mConstantIndex;
+  std::vector<Input>                      mInputs;
+  std::map<std::string, unsigned int>     mInputIndex;
+  std::vector<std::string>                mIds;
+  std::vector<unsigned int>               mRoots;
+
+  // the block of the stack each operation writes to, and the number of
+  // blocks needed
+  std::vector<unsigned int>               mSlots;
+  unsigned int                            mNumSlots;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedCompiledMath and returns it.
+ */
+LIBSEDML_EXTERN
+SedCompiledMath_t *
+SedCompiledMath_create ();
+
+
+/**
+ * Frees the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+void
+SedCompiledMath_free (SedCompiledMath_t *scm);
+
+
+/**
+ * Compiles the math of the given SedDataGenerator.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_compile (SedCompiledMath_t *scm, const SedDataGenerator_t *dg);
+
+
+/**
+ * Compiles the math of the given SedComputeChange; if @p bindParameters
+ * is non-zero, its parameters are read from the columns after its
+ * variables.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_compileComputeChange (SedCompiledMath_t *scm,
+                                      const SedComputeChange_t *cc,
+                                      int bindParameters);
+
+
+/**
+ * Returns the number of variables of the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMath_getNumVariables (const SedCompiledMath_t *scm);
+
+
+/**
+ * Returns the id of the variable read from column @p n; the string is
+ * owned by the SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMath_getVariableId (const SedCompiledMath_t *scm, unsigned int n);
+
+
+/**
+ * Returns the number of input columns of the given SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMath_getNumInputs (const SedCompiledMath_t *scm);
+
+
+/**
+ * Returns the id of the variable or parameter read from column @p n; the
+ * string is owned by the SedCompiledMath.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMath_getInputId (const SedCompiledMath_t *scm, unsigned int n);
+
+
+/**
+ * Evaluates the compiled math for @p length samples of the given columns.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMath_evaluate (const SedCompiledMath_t *scm,
+                          const double *const *columns, size_t length,
+                          double *result);
+
+
+/**
+ * Creates a new, empty SedCompiledMathSet and returns it.
+ */
+LIBSEDML_EXTERN
+SedCompiledMathSet_t *
+SedCompiledMathSet_create ();
+
+
+/**
+ * Frees the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+void
+SedCompiledMathSet_free (SedCompiledMathSet_t *scms);
+
+
+/**
+ * Adds the math of the given SedDataGenerator to those compiled.
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMathSet_add (SedCompiledMathSet_t *scms, const SedDataGenerator_t *dg);
+
+
+/**
+ * Returns the number of data generators of the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMathSet_getNumDataGenerators (const SedCompiledMathSet_t *scms);
+
+
+/**
+ * Returns the number of input columns of the given SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedCompiledMathSet_getNumInputs (const SedCompiledMathSet_t *scms);
+
+
+/**
+ * Returns the id of the first variable bound to column @p n; the string
+ * is owned by the SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMathSet_getInputId (const SedCompiledMathSet_t *scms,
+                               unsigned int n);
+
+
+/**
+ * Returns the task reference of the variables bound to column @p n; the
+ * string is owned by the SedCompiledMathSet.
+ */
+LIBSEDML_EXTERN
+const char *
+SedCompiledMathSet_getInputTaskReference (const SedCompiledMathSet_t *scms,
+                                          unsigned int n);
+
+
+/**
+ * Evaluates the math of all data generators for @p length samples of the
+ * given columns, writing the values of the n-th data generator to
+ * @p results[n].
+ */
+LIBSEDML_EXTERN
+int
+SedCompiledMathSet_evaluate (const SedCompiledMathSet_t *scms,
+                             const double *const *columns, size_t length,
+                             double *const *results);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedCompiledMath_h */
@@ -38,6 +38,7 @@
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
+#include <sedml/SedMathCache.h>
 
 
 using namespace std;
@@ -87,6 +88,8 @@ SedComputeChange::SedComputeChange (SedNamespaces* sedns)
  */
 SedComputeChange::SedComputeChange (const SedComputeChange& orig)
 	: SedChange(orig)
+	, mVariable (orig.mVariable)
+	, mParameter (orig.mParameter)
 {
 	if (&orig == NULL)
 	{
@@ -94,9 +97,7 @@ SedComputeChange::SedComputeChange (const SedComputeChange& orig)
 	}
 	else
 	{
-		mVariable  = orig.mVariable;
-		mParameter  = orig.mParameter;
-		mMath  = orig.mMath != NULL ? orig.mMath->deepCopy() : NULL;
+		mMath  = SedMathCache::acquire(orig.mMath);
 
 		// connect to child objects
 		connectToChild();
@@ -119,7 +120,8 @@ SedComputeChange::operator=(const SedComputeChange& rhs)
 		SedChange::operator=(rhs);
 		mVariable  = rhs.mVariable;
 		mParameter  = rhs.mParameter;
-		mMath  = rhs.mMath != NULL ? rhs.mMath->deepCopy() : NULL;
+		SedMathCache::release(mMath);
+		mMath  = SedMathCache::acquire(rhs.mMath);
 
 		// connect to child objects
 		connectToChild();
@@ -143,6 +145,7 @@ SedComputeChange::clone () const
  */
 SedComputeChange::~SedComputeChange ()
 {
+	SedMathCache::release(mMath);
 }
 
 
@@ -172,13 +175,15 @@ SedComputeChange::isSetMath() const
 int
 SedComputeChange::setMath(ASTNode* math)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (mMath == math)
 	{
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 	else if (math == NULL)
 	{
-		delete mMath;
+		SedMathCache::release(mMath);
 		mMath = NULL;
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
@@ -188,12 +193,9 @@ SedComputeChange::setMath(ASTNode* math)
 	}
 	else
 	{
-		delete mMath;
-		mMath = (math != NULL) ?
-			math->deepCopy() : NULL;
-		if (mMath != NULL)
-		{
-		}
+		const ASTNode* shared = SedMathCache::intern(math->deepCopy());
+		SedMathCache::release(mMath);
+		mMath = shared;
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -205,7 +207,9 @@ SedComputeChange::setMath(ASTNode* math)
 int
 SedComputeChange::unsetMath()
 {
-	delete mMath;
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	SedMathCache::release(mMath);
 	mMath = NULL;
 	return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -302,6 +306,17 @@ SedComputeChange::addVariable(const SedVariable* sv)
 }
 
 
+/*
+ * Adds the given SedVariable to this SedComputeChange, which takes ownership of it.
+ */
+int
+SedComputeChange::addVariableAndOwn(SedVariable* sv)
+{
+	if(sv == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mVariable.appendAndOwn(sv);
+}
+
+
 /**
  * Get the number of SedVariable objects in this SedComputeChange.
  *
@@ -324,7 +339,8 @@ SedComputeChange::getNumVariables() const
 SedVariable* 
 SedComputeChange::createVariable()
 {
-	SedVariable *temp = new SedVariable();
+	if (isFrozen()) return NULL;
+	SedVariable *temp = new (getArena()) SedVariable();
 	if (temp != NULL) mVariable.appendAndOwn(temp);
 	return temp;
 }
@@ -420,6 +436,17 @@ SedComputeChange::addParameter(const SedParameter* sp)
 }
 
 
+/*
+ * Adds the given SedParameter to this SedComputeChange, which takes ownership of it.
+ */
+int
+SedComputeChange::addParameterAndOwn(SedParameter* sp)
+{
+	if(sp == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mParameter.appendAndOwn(sp);
+}
+
+
 /**
  * Get the number of SedParameter objects in this SedComputeChange.
  *
@@ -442,19 +469,22 @@ SedComputeChange::getNumParameters() const
 SedParameter* 
 SedComputeChange::createParameter()
 {
-	SedParameter *temp = new SedParameter();
+	if (isFrozen()) return NULL;
+	SedParameter *temp = new (getArena()) SedParameter();
 	if (temp != NULL) mParameter.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedComputeChangeName("computeChange");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedComputeChange::getElementName () const
 {
-	static const string name = "computeChange";
-	return name;
+	return sSedComputeChangeName;
 }
 
 
@@ -468,16 +498,21 @@ SedComputeChange::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedChange::connectToChild();
-
-	if (name == "listOfVariables")
+	switch (getElementNameHash(name))
 	{
-		object = &mVariable;
-	}
+	case 0x6190ecddu:
+		if (name == "listOfVariables")
+		{
+			object = &mVariable;
+		}
+		break;
 
-	if (name == "listOfParameters")
-	{
-		object = &mParameter;
+	case 0x4d047f28u:
+		if (name == "listOfParameters")
+		{
+			object = &mParameter;
+		}
+		break;
 	}
 
 	return object;
@@ -497,6 +532,50 @@ SedComputeChange::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedComputeChange::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mVariable);
+	addAllElements(ret, &mParameter);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this ComputeChange.
+ */
+unsigned int
+SedComputeChange::getNumChildElements () const
+{
+	return 2;
+}
+
+
+/*
+ * Returns the nth element directly contained in this ComputeChange.
+ */
+const SedBase*
+SedComputeChange::getChildElement (unsigned int n) const
+{
+	switch (n)
+	{
+	case 0:
+		return &mVariable;
+	case 1:
+		return &mParameter;
+	default:
+		return NULL;
+	}
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -550,7 +629,12 @@ SedComputeChange::writeElements (XMLOutputStream& stream) const
 	}
 	if (isSetMath() == true)
 	{
-		writeMathML(getMath(), stream, NULL);
+#ifdef USE_PROFILING
+		const SedDocument* doc = getSedDocument();
+		SedProfileScope profile(doc != NULL ? doc->getProfileRecorder() : NULL,
+		                        SedProfileRecorder::MATH_WRITE);
+#endif
+		SedMathCache::write(getMath(), stream);
 	}
 }
 
@@ -561,13 +645,12 @@ SedComputeChange::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedComputeChange::accept (SedVisitor& v) const
+SedComputeChange::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -637,8 +720,15 @@ SedComputeChange::readOtherXML (XMLInputStream& stream)
 		const XMLToken elem = stream.peek();
 		const std::string prefix = checkMathMLNamespace(elem);
 
-		delete mMath;
-		mMath = readMathML(stream, prefix);
+		SedMathCache::release(mMath);
+		{
+#ifdef USE_PROFILING
+			const SedDocument* doc = getSedDocument();
+			SedProfileScope profile(doc != NULL ? doc->getProfileRecorder() : NULL,
+			                        SedProfileRecorder::MATH_READ);
+#endif
+			mMath = SedMathCache::intern(readMathML(stream, prefix));
+		}
 		read = true;
 	}
 
@@ -666,6 +756,18 @@ SedComputeChange::writeAttributes (XMLOutputStream& stream) const
 }
 
 
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedComputeChange::addAttributes (XMLAttributes& attributes) const
+{
+	SedChange::addAttributes(attributes);
+
+}
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -714,13 +816,13 @@ SedComputeChange_clone(SedComputeChange_t * scc)
  * write comments
  */
 LIBSEDML_EXTERN
-ASTNode_t*
-SedComputeChange_getMath(SedComputeChange_t * scc)
+const ASTNode_t*
+SedComputeChange_getMath(const SedComputeChange_t * scc)
 {
 	if (scc == NULL)
 		return NULL;
 
-	return (ASTNode_t*)scc->getMath();
+	return scc->getMath();
 }
 
 
@@ -764,6 +866,13 @@ SedComputeChange_addVariable(SedComputeChange_t * scc, SedVariable_t * sv)
 	return  (scc != NULL) ? scc->addVariable(sv) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedComputeChange_addVariableAndOwn(SedComputeChange_t * scc, SedVariable_t * sv)
+{
+	return  (scc != NULL) ? scc->addVariableAndOwn(sv) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedVariable_t *
 SedComputeChange_createVariable(SedComputeChange_t * scc)
@@ -820,6 +929,13 @@ SedComputeChange_addParameter(SedComputeChange_t * scc, SedParameter_t * sp)
 	return  (scc != NULL) ? scc->addParameter(sp) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedComputeChange_addParameterAndOwn(SedComputeChange_t * scc, SedParameter_t * sp)
+{
+	return  (scc != NULL) ? scc->addParameterAndOwn(sp) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedParameter_t *
 SedComputeChange_createParameter(SedComputeChange_t * scc)
@@ -67,7 +67,7 @@ protected:
 
 	SedListOfVariables   mVariable;
 	SedListOfParameters   mParameter;
-	ASTNode*      mMath;
+	const ASTNode* mMath;
 
 
 public:
@@ -253,6 +253,25 @@ public:
 	int addVariable(const SedVariable* sv);
 
 
+	/**
+	 * Adds the given "SedVariable" to this SedComputeChange without copying it; this
+	 * SedComputeChange takes ownership of @p sv and will delete it.
+	 *
+	 * @param sv the SedVariable object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sv is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addVariable(const SedVariable* sv)
+	 */
+	int addVariableAndOwn(SedVariable* sv);
+
+
 	/**
 	 * Get the number of SedVariable objects in this SedComputeChange.
 	 *
@@ -384,6 +403,25 @@ public:
 	int addParameter(const SedParameter* sp);
 
 
+	/**
+	 * Adds the given "SedParameter" to this SedComputeChange without copying it; this
+	 * SedComputeChange takes ownership of @p sp and will delete it.
+	 *
+	 * @param sp the SedParameter object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sp is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addParameter(const SedParameter* sp)
+	 */
+	int addParameterAndOwn(SedParameter* sp);
+
+
 	/**
 	 * Get the number of SedParameter objects in this SedComputeChange.
 	 *
@@ -432,6 +470,33 @@ public:
 	SedParameter* removeParameter(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedComputeChange.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedComputeChange.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedComputeChange, is
 	 * always @c "sedComputeChange".
@@ -514,9 +579,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -601,6 +666,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -634,8 +706,8 @@ SedComputeChange_clone(SedComputeChange_t * scc);
 
 
 LIBSEDML_EXTERN
-ASTNode_t*
-SedComputeChange_getMath(SedComputeChange_t * scc);
+const ASTNode_t*
+SedComputeChange_getMath(const SedComputeChange_t * scc);
 
 
 LIBSEDML_EXTERN
@@ -658,6 +730,11 @@ int
 SedComputeChange_addVariable(SedComputeChange_t * scc, SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+int
+SedComputeChange_addVariableAndOwn(SedComputeChange_t * scc, SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 SedVariable_t *
 SedComputeChange_createVariable(SedComputeChange_t * scc);
@@ -698,6 +775,11 @@ int
 SedComputeChange_addParameter(SedComputeChange_t * scc, SedParameter_t * sp);
 
 
+LIBSEDML_EXTERN
+int
+SedComputeChange_addParameterAndOwn(SedComputeChange_t * scc, SedParameter_t * sp);
+
+
 LIBSEDML_EXTERN
 SedParameter_t *
 SedComputeChange_createParameter(SedComputeChange_t * scc);
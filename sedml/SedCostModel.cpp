@@ -0,0 +1,600 @@
+/**
+ * @file    SedCostModel.cpp
+ * @brief   Estimates how long tasks take, learned from earlier runs
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedCostModel.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/threads.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The first line of a file written by SedCostModel::save().
+ */
+static const char* SED_COST_MODEL_HEADER = "sedml-cost-model 1";
+
+
+/*
+ * Holds the lock of a SedCostModel while in scope.
+ */
+class SedCostModelLock
+{
+public:
+
+  SedCostModelLock (void* lock)
+    : mMutex (static_cast<SedMutex*>(lock))
+  {
+    mutexLock(mMutex);
+  }
+
+  ~SedCostModelLock ()
+  {
+    mutexUnlock(mMutex);
+  }
+
+private:
+
+  SedMutex* mMutex;
+};
+
+
+/*
+ * Writes fit to file as one line tagged with name.
+ */
+static bool
+writeFit (FILE* file, const char* tag, const std::string& name,
+          const double n, const double xx[3][3], const double xy[3],
+          const double sumY, const double sumWork)
+{
+  if (fprintf(file, "%s %s %.17g %.17g %.17g", tag,
+              name.empty() ? "-" : name.c_str(), n, sumY, sumWork) < 0)
+  {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      if (fprintf(file, " %.17g", xx[i][j]) < 0) return false;
+    }
+  }
+
+  return fprintf(file, " %.17g %.17g %.17g\n", xy[0], xy[1], xy[2]) >= 0;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedCostModel that has observed nothing.
+ */
+SedCostModel::SedCostModel ()
+  : mLock (NULL)
+{
+  clear(mAll);
+
+  SedMutex* mutex = new SedMutex;
+  mutexInit(mutex);
+  mLock = mutex;
+}
+
+
+/*
+ * Copy constructor.
+ */
+SedCostModel::SedCostModel (const SedCostModel& orig)
+  : mLock (NULL)
+{
+  SedMutex* mutex = new SedMutex;
+  mutexInit(mutex);
+  mLock = mutex;
+
+  SedCostModelLock lock(orig.mLock);
+  mFits       = orig.mFits;
+  mAll        = orig.mAll;
+  mModelSizes = orig.mModelSizes;
+}
+
+
+/*
+ * Assignment operator.
+ */
+SedCostModel&
+SedCostModel::operator= (const SedCostModel& rhs)
+{
+  if (&rhs != this)
+  {
+    SedCostModel copy(rhs);
+
+    SedCostModelLock lock(mLock);
+    mFits       = copy.mFits;
+    mAll        = copy.mAll;
+    mModelSizes = copy.mModelSizes;
+  }
+
+  return *this;
+}
+
+
+/*
+ * Destroys this SedCostModel.
+ */
+SedCostModel::~SedCostModel ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexFree(mutex);
+  delete mutex;
+}
+
+
+/*
+ * Sets the size of the models with the source of model.
+ */
+void
+SedCostModel::setModelSize (const SedModel* model, double size)
+{
+  if (model == NULL) return;
+
+  SedCostModelLock lock(mLock);
+  if (size > 0)
+  {
+    mModelSizes[model->getSource()] = size;
+  }
+  else
+  {
+    mModelSizes.erase(model->getSource());
+  }
+}
+
+
+/*
+ * Returns the size set for the source of model, or 1.
+ */
+double
+SedCostModel::getModelSize (const SedModel* model) const
+{
+  if (model == NULL) return 1;
+
+  SedCostModelLock lock(mLock);
+  std::map<std::string, double>::const_iterator it =
+    mModelSizes.find(model->getSource());
+  return (it != mModelSizes.end()) ? it->second : 1;
+}
+
+
+/*
+ * Returns the number of seconds task is expected to take.
+ */
+double
+SedCostModel::estimate (const SedTask*, const SedModel* model,
+                        const SedSimulation* simulation) const
+{
+  double x[3];
+  getRegressors(simulation, getModelSize(model), x);
+
+  SedCostModelLock lock(mLock);
+
+  std::map<std::string, Fit>::const_iterator it =
+    mFits.find(getKisaoID(simulation));
+  const Fit* fit = (it != mFits.end()) ? &it->second : NULL;
+
+  double y = 0;
+  if ((fit != NULL && predict(*fit, x, y)) || predict(mAll, x, y))
+  {
+    return y;
+  }
+
+  // too few tasks for a fit: the seconds per unit of work of those seen,
+  // or the work itself if none were
+  if (fit == NULL || fit->sumWork <= 0) fit = &mAll;
+  if (fit->sumWork <= 0) return x[1];
+
+  return x[1] * fit->sumY / fit->sumWork;
+}
+
+
+/*
+ * Learns that task took seconds to simulate.
+ */
+void
+SedCostModel::observe (const SedTask*, const SedModel* model,
+                       const SedSimulation* simulation, double seconds)
+{
+  if (!(seconds >= 0) || seconds > 1e300) return;
+
+  double x[3];
+  getRegressors(simulation, getModelSize(model), x);
+
+  const std::string& kisao = getKisaoID(simulation);
+
+  SedCostModelLock lock(mLock);
+
+  std::map<std::string, Fit>::iterator it = mFits.find(kisao);
+  if (it == mFits.end())
+  {
+    Fit fit;
+    clear(fit);
+    it = mFits.insert(std::make_pair(kisao, fit)).first;
+  }
+
+  add(it->second, x, seconds);
+  add(mAll, x, seconds);
+}
+
+
+/*
+ * Returns the number of tasks observed.
+ */
+unsigned int
+SedCostModel::getNumObservations () const
+{
+  SedCostModelLock lock(mLock);
+  return (unsigned int)mAll.n;
+}
+
+
+/*
+ * Forgets all that was observed, and the model sizes.
+ */
+void
+SedCostModel::clear ()
+{
+  SedCostModelLock lock(mLock);
+  mFits.clear();
+  clear(mAll);
+  mModelSizes.clear();
+}
+
+
+/*
+ * Writes what was observed to the file filename.
+ */
+int
+SedCostModel::save (const std::string& filename) const
+{
+  FILE* file = fopen(filename.c_str(), "w");
+  if (file == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  bool ok = fprintf(file, "%s\n", SED_COST_MODEL_HEADER) >= 0;
+  {
+    SedCostModelLock lock(mLock);
+
+    std::map<std::string, Fit>::const_iterator it;
+    for (it = mFits.begin(); ok && it != mFits.end(); ++it)
+    {
+      const Fit& fit = it->second;
+      ok = writeFit(file, "kisao", it->first, fit.n, fit.xx, fit.xy,
+                    fit.sumY, fit.sumWork);
+    }
+  }
+
+  if (fclose(file) != 0) ok = false;
+  return ok ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Adds what the model saved to filename observed.
+ */
+int
+SedCostModel::load (const std::string& filename)
+{
+  FILE* file = fopen(filename.c_str(), "r");
+  if (file == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  char line[256];
+  bool ok = fgets(line, sizeof(line), file) != NULL
+    && strncmp(line, SED_COST_MODEL_HEADER,
+               strlen(SED_COST_MODEL_HEADER)) == 0;
+
+  std::map<std::string, Fit> fits;
+
+  while (ok)
+  {
+    char tag[16];
+    char name[128];
+    Fit fit;
+
+    const int read = fscanf(file, "%15s %127s %lg %lg %lg"
+                            " %lg %lg %lg %lg %lg %lg %lg %lg %lg"
+                            " %lg %lg %lg",
+                            tag, name, &fit.n, &fit.sumY, &fit.sumWork,
+                            &fit.xx[0][0], &fit.xx[0][1], &fit.xx[0][2],
+                            &fit.xx[1][0], &fit.xx[1][1], &fit.xx[1][2],
+                            &fit.xx[2][0], &fit.xx[2][1], &fit.xx[2][2],
+                            &fit.xy[0], &fit.xy[1], &fit.xy[2]);
+    if (read == EOF) break;
+
+    ok = (read == 17 && strcmp(tag, "kisao") == 0 && fit.n >= 0);
+    if (ok)
+    {
+      const std::string kisao = (strcmp(name, "-") == 0) ? "" : name;
+      fits[kisao] = fit;
+    }
+  }
+
+  fclose(file);
+  if (!ok) return LIBSEDML_OPERATION_FAILED;
+
+  SedCostModelLock lock(mLock);
+
+  std::map<std::string, Fit>::const_iterator it;
+  for (it = fits.begin(); it != fits.end(); ++it)
+  {
+    std::map<std::string, Fit>::iterator found = mFits.find(it->first);
+    if (found == mFits.end())
+    {
+      mFits.insert(*it);
+    }
+    else
+    {
+      add(found->second, it->second);
+    }
+    add(mAll, it->second);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Sets x to the regressors of a task of simulation on a model of size.
+ */
+void
+SedCostModel::getRegressors (const SedSimulation* simulation, double size,
+                             double x[3])
+{
+  double points = 0;
+  double span   = 0;
+
+  if (simulation != NULL
+      && simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+  {
+    const SedUniformTimeCourse* utc =
+      static_cast<const SedUniformTimeCourse*>(simulation);
+
+    if (utc->getNumberOfPoints() > 0) points = utc->getNumberOfPoints();
+
+    const double start = (utc->isSetInitialTime()) ? utc->getInitialTime()
+                                                   : utc->getOutputStartTime();
+    span = fabs(utc->getOutputEndTime() - start);
+    if (!(span < 1e300)) span = 0;
+  }
+
+  x[0] = 1;
+  x[1] = (points + 1) * size;
+  x[2] = span * size;
+}
+
+
+/*
+ * Returns the KiSAO id of the algorithm of simulation, or an empty string.
+ */
+const std::string&
+SedCostModel::getKisaoID (const SedSimulation* simulation)
+{
+  static const std::string empty;
+
+  const SedAlgorithm* algorithm = (simulation != NULL)
+                                ? simulation->getAlgorithm() : NULL;
+  return (algorithm != NULL) ? algorithm->getKisaoID() : empty;
+}
+
+
+/*
+ * Sets all sums of fit to 0.
+ */
+void
+SedCostModel::clear (Fit& fit)
+{
+  memset(&fit, 0, sizeof(fit));
+}
+
+
+/*
+ * Adds the observation of y at x to fit.
+ */
+void
+SedCostModel::add (Fit& fit, const double x[3], double y)
+{
+  fit.n       += 1;
+  fit.sumY    += y;
+  fit.sumWork += x[1];
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      fit.xx[i][j] += x[i] * x[j];
+    }
+    fit.xy[i] += x[i] * y;
+  }
+}
+
+
+/*
+ * Adds the observations of other to fit.
+ */
+void
+SedCostModel::add (Fit& fit, const Fit& other)
+{
+  fit.n       += other.n;
+  fit.sumY    += other.sumY;
+  fit.sumWork += other.sumWork;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      fit.xx[i][j] += other.xx[i][j];
+    }
+    fit.xy[i] += other.xy[i];
+  }
+}
+
+
+/*
+ * Sets y to the value predicted at x by the least-squares fit.
+ *
+ * @return false if fit has seen fewer than three tasks, or predicts no
+ * positive time at x.
+ */
+bool
+SedCostModel::predict (const Fit& fit, const double x[3], double& y)
+{
+  if (fit.n < 3) return false;
+
+  // the normal equations, with a little ridge so that regressors that
+  // always grow together, such as points and span, do not make them
+  // singular
+  double a[3][4];
+  const double trace = fit.xx[0][0] + fit.xx[1][1] + fit.xx[2][2];
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      a[i][j] = fit.xx[i][j];
+    }
+    a[i][i] += 1e-9 * trace / 3;
+    a[i][3] = fit.xy[i];
+  }
+
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    unsigned int pivot = k;
+    for (unsigned int i = k + 1; i < 3; ++i)
+    {
+      if (fabs(a[i][k]) > fabs(a[pivot][k])) pivot = i;
+    }
+    if (!(fabs(a[pivot][k]) > 0)) return false;
+
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+      const double t = a[k][j];
+      a[k][j] = a[pivot][j];
+      a[pivot][j] = t;
+    }
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (i == k) continue;
+      const double f = a[i][k] / a[k][k];
+      for (unsigned int j = k; j < 4; ++j)
+      {
+        a[i][j] -= f * a[k][j];
+      }
+    }
+  }
+
+  y = 0;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    y += x[i] * a[i][3] / a[i][i];
+  }
+
+  return (y > 0 && y < 1e300);
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedCostModel that has observed nothing and returns it.
+ */
+LIBSEDML_EXTERN
+SedCostModel_t *
+SedCostModel_create (void)
+{
+  return new (nothrow) SedCostModel();
+}
+
+
+/**
+ * Frees the given SedCostModel.
+ */
+LIBSEDML_EXTERN
+void
+SedCostModel_free (SedCostModel_t *scm)
+{
+  delete scm;
+}
+
+
+/**
+ * Returns the number of seconds task is expected to take.
+ */
+LIBSEDML_EXTERN
+double
+SedCostModel_estimate (const SedCostModel_t *scm, const SedTask_t *task,
+                       const SedModel_t *model,
+                       const SedSimulation_t *simulation)
+{
+  return (scm != NULL) ? scm->estimate(task, model, simulation) : 0;
+}
+
+
+/**
+ * Writes what the given SedCostModel observed to the file filename.
+ */
+LIBSEDML_EXTERN
+int
+SedCostModel_save (const SedCostModel_t *scm, const char *filename)
+{
+  if (scm == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (filename == NULL) return LIBSEDML_OPERATION_FAILED;
+  return scm->save(filename);
+}
+
+
+/**
+ * Adds what the model saved to filename observed to the given
+ * SedCostModel.
+ */
+LIBSEDML_EXTERN
+int
+SedCostModel_load (SedCostModel_t *scm, const char *filename)
+{
+  if (scm == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (filename == NULL) return LIBSEDML_OPERATION_FAILED;
+  return scm->load(filename);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
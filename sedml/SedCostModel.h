@@ -0,0 +1,269 @@
+/**
+ * @file    SedCostModel.h
+ * @brief   Estimates how long tasks take, learned from earlier runs
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedCostModel
+ * @ingroup Core
+ * @brief Predicts the time a SedTask takes to simulate.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedExecutor with a SedCostModel (see SedExecutor::setCostModel())
+ * starts the tasks it expects to take longest first, and deals the ready
+ * tasks out so that every worker has about as much work queued; the time
+ * each task took to simulate is then given back to the model with
+ * observe(), so that the estimates of the following runs improve.
+ *
+ * A task is described by the number of points of its SedUniformTimeCourse
+ * and the time span from its initial to its output end time, both
+ * weighted by the size of its model, and by the KiSAO id of the
+ * SedAlgorithm of the simulation.  The size of a model is what
+ * SedSimulator::getModelSize() tells once the model is loaded; models of
+ * unknown size count as 1.  For every algorithm, and for all algorithms
+ * together, the model keeps a least-squares fit of the seconds observed
+ * against
+ *
+ * <code>c0 + c1 * (points + 1) * size + c2 * span * size</code>
+ *
+ * which is used once it has seen three tasks; before that the estimate is
+ * proportional to <code>(points + 1) * size</code>, which orders tasks
+ * correctly even if their time is not known yet.
+ *
+ * What was learned can be kept across processes with save() and load().
+ * All methods may be called by several threads at once.
+ */
+
+#ifndef SedCostModel_h
+#define SedCostModel_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedTask;
+class SedModel;
+class SedSimulation;
+
+
+class LIBSEDML_EXTERN SedCostModel
+{
+public:
+
+  /**
+   * Creates a new SedCostModel that has observed nothing.
+   */
+  SedCostModel ();
+
+
+  /**
+   * Copy constructor; copies what @p orig has learned.
+   */
+  SedCostModel (const SedCostModel& orig);
+
+
+  /**
+   * Assignment operator; copies what @p rhs has learned.
+   */
+  SedCostModel& operator= (const SedCostModel& rhs);
+
+
+  /**
+   * Destroys this SedCostModel.
+   */
+  virtual ~SedCostModel ();
+
+
+  /**
+   * Sets the size of the models with the source of @p model, in whatever
+   * unit the simulator measures it, such as its number of state
+   * variables; a size that is not positive is forgotten.
+   */
+  void setModelSize (const SedModel* model, double size);
+
+
+  /**
+   * @return the size set for the source of @p model, or 1 if none was.
+   */
+  double getModelSize (const SedModel* model) const;
+
+
+  /**
+   * @return the number of seconds @p task, of @p model and @p simulation,
+   * is expected to take; the larger of two estimates is the task expected
+   * to take longer, even though nothing has been observed yet.
+   */
+  virtual double estimate (const SedTask* task, const SedModel* model,
+                           const SedSimulation* simulation) const;
+
+
+  /**
+   * Learns that @p task, of @p model and @p simulation, took @p seconds
+   * to simulate.
+   */
+  virtual void observe (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation, double seconds);
+
+
+  /**
+   * @return the number of tasks observed.
+   */
+  unsigned int getNumObservations () const;
+
+
+  /**
+   * Forgets all that was observed, and the model sizes.
+   */
+  void clear ();
+
+
+  /**
+   * Writes what was observed to the file @p filename.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be written
+   */
+  int save (const std::string& filename) const;
+
+
+  /**
+   * Adds what was observed by the model saved to @p filename to what this
+   * model observed.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be read or was not written by save(), in which
+   * case this model is left as it was
+   */
+  int load (const std::string& filename);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * The sums of a least-squares fit of the seconds y against the
+   * regressors x = (1, (points + 1) * size, span * size).
+   */
+  struct Fit
+  {
+    double  n;
+    double  xx[3][3];
+    double  xy[3];
+    double  sumY;
+    double  sumWork;
+  };
+
+  static void getRegressors (const SedSimulation* simulation, double size,
+                             double x[3]);
+
+  static const std::string& getKisaoID (const SedSimulation* simulation);
+
+  static void clear (Fit& fit);
+
+  static void add (Fit& fit, const double x[3], double y);
+
+  static void add (Fit& fit, const Fit& other);
+
+  static bool predict (const Fit& fit, const double x[3], double& y);
+
+  std::map<std::string, Fit>     mFits;
+  Fit                            mAll;
+  std::map<std::string, double>  mModelSizes;
+  void*                          mLock;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedCostModel that has observed nothing and returns it.
+ */
+LIBSEDML_EXTERN
+SedCostModel_t *
+SedCostModel_create (void);
+
+
+/**
+ * Frees the given SedCostModel.
+ */
+LIBSEDML_EXTERN
+void
+SedCostModel_free (SedCostModel_t *scm);
+
+
+/**
+ * Returns the number of seconds @p task is expected to take.
+ */
+LIBSEDML_EXTERN
+double
+SedCostModel_estimate (const SedCostModel_t *scm, const SedTask_t *task,
+                       const SedModel_t *model,
+                       const SedSimulation_t *simulation);
+
+
+/**
+ * Writes what the given SedCostModel observed to the file @p filename.
+ */
+LIBSEDML_EXTERN
+int
+SedCostModel_save (const SedCostModel_t *scm, const char *filename);
+
+
+/**
+ * Adds what the model saved to @p filename observed to the given
+ * SedCostModel.
+ */
+LIBSEDML_EXTERN
+int
+SedCostModel_load (SedCostModel_t *scm, const char *filename);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedCostModel_h */
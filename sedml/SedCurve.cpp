@@ -52,11 +52,13 @@ SedCurve::SedCurve (unsigned int level, unsigned int version)
 	, mId ("")
 	, mName ("")
 	, mLogX (false)
-	, mIsSetLogX (false)
 	, mLogY (false)
+	, mIsSetLogX (false)
 	, mIsSetLogY (false)
 	, mXDataReference ("")
 	, mYDataReference ("")
+	, mReferencedXDataGenerator (NULL)
+	, mReferencedYDataGenerator (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -72,11 +74,13 @@ SedCurve::SedCurve (SedNamespaces* sedns)
 	, mId ("")
 	, mName ("")
 	, mLogX (false)
-	, mIsSetLogX (false)
 	, mLogY (false)
+	, mIsSetLogX (false)
 	, mIsSetLogY (false)
 	, mXDataReference ("")
 	, mYDataReference ("")
+	, mReferencedXDataGenerator (NULL)
+	, mReferencedYDataGenerator (NULL)
 
 {
 	// set the element namespace of this object
@@ -103,7 +107,9 @@ SedCurve::SedCurve (const SedCurve& orig)
 		mLogY  = orig.mLogY;
 		mIsSetLogY  = orig.mIsSetLogY;
 		mXDataReference  = orig.mXDataReference;
+		mReferencedXDataGenerator  = NULL;
 		mYDataReference  = orig.mYDataReference;
+		mReferencedYDataGenerator  = NULL;
 	}
 }
 
@@ -128,7 +134,9 @@ SedCurve::operator=(const SedCurve& rhs)
 		mLogY  = rhs.mLogY;
 		mIsSetLogY  = rhs.mIsSetLogY;
 		mXDataReference  = rhs.mXDataReference;
+		mReferencedXDataGenerator  = NULL;
 		mYDataReference  = rhs.mYDataReference;
+		mReferencedYDataGenerator  = NULL;
 	}
 	return *this;
 }
@@ -278,7 +286,11 @@ SedCurve::isSetYDataReference() const
 int
 SedCurve::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -288,6 +300,8 @@ SedCurve::setId(const std::string& id)
 int
 SedCurve::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -306,6 +320,8 @@ SedCurve::setName(const std::string& name)
 int
 SedCurve::setLogX(bool logX)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogX = logX;
 	mIsSetLogX = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -318,6 +334,8 @@ SedCurve::setLogX(bool logX)
 int
 SedCurve::setLogY(bool logY)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogY = logY;
 	mIsSetLogY = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -330,6 +348,8 @@ SedCurve::setLogY(bool logY)
 int
 SedCurve::setXDataReference(const std::string& xDataReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(xDataReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -341,6 +361,7 @@ SedCurve::setXDataReference(const std::string& xDataReference)
 	else
 	{
 		mXDataReference = xDataReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -352,6 +373,8 @@ SedCurve::setXDataReference(const std::string& xDataReference)
 int
 SedCurve::setYDataReference(const std::string& yDataReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(yDataReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -363,6 +386,7 @@ SedCurve::setYDataReference(const std::string& yDataReference)
 	else
 	{
 		mYDataReference = yDataReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -374,7 +398,10 @@ SedCurve::setYDataReference(const std::string& yDataReference)
 int
 SedCurve::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -393,6 +420,8 @@ SedCurve::unsetId()
 int
 SedCurve::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -412,6 +441,8 @@ SedCurve::unsetName()
 int
 SedCurve::unsetLogX()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogX = false;
 	mIsSetLogX = false;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -424,6 +455,8 @@ SedCurve::unsetLogX()
 int
 SedCurve::unsetLogY()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogY = false;
 	mIsSetLogY = false;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -436,7 +469,10 @@ SedCurve::unsetLogY()
 int
 SedCurve::unsetXDataReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mXDataReference.erase();
+	notifyReferencesChanged();
 
 	if (mXDataReference.empty() == true)
 	{
@@ -455,7 +491,10 @@ SedCurve::unsetXDataReference()
 int
 SedCurve::unsetYDataReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mYDataReference.erase();
+	notifyReferencesChanged();
 
 	if (mYDataReference.empty() == true)
 	{
@@ -468,14 +507,56 @@ SedCurve::unsetYDataReference()
 }
 
 
+/*
+ * Returns the SedDataGenerator referenced by the "xDataReference" attribute.
+ */
+SedDataGenerator*
+SedCurve::getReferencedXDataGenerator()
+{
+	updateReferences();
+	return mReferencedXDataGenerator;
+}
+
+
+/*
+ * Returns the SedDataGenerator referenced by the "yDataReference" attribute.
+ */
+SedDataGenerator*
+SedCurve::getReferencedYDataGenerator()
+{
+	updateReferences();
+	return mReferencedYDataGenerator;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Resolves the reference attributes of this SedCurve against the document.
+ */
+void
+SedCurve::lookupReferences(SedDocument* doc)
+{
+	mReferencedXDataGenerator = (doc != NULL && isSetXDataReference())
+		? doc->getDataGenerator(mXDataReference) : NULL;
+	mReferencedYDataGenerator = (doc != NULL && isSetYDataReference())
+		? doc->getDataGenerator(mYDataReference) : NULL;
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sSedCurveName("curve");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedCurve::getElementName () const
 {
-	static const string name = "curve";
-	return name;
+	return sSedCurveName;
 }
 
 
@@ -531,13 +612,12 @@ SedCurve::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedCurve::accept (SedVisitor& v) const
+SedCurve::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -594,10 +674,23 @@ SedCurve::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u },
+		{ "logX", 0xb602912bu },
+		{ "logY", 0xb5028f98u },
+		{ "xDataReference", 0x022632dcu },
+		{ "yDataReference", 0x78a13611u }
+	};
+	int index[6];
+	findAttributes(attributes, names, 6, index);
+
 	//
 	// id SId  ( use = "optional" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[0], "id", mId, false);
 
 	if (assigned == true)
 	{
@@ -616,7 +709,7 @@ SedCurve::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -631,17 +724,17 @@ SedCurve::readAttributes (const XMLAttributes& attributes,
 	//
 	// logX bool   ( use = "required" )
 	//
-	mIsSetLogX = attributes.readInto("logX", mLogX, getErrorLog(), true);
+	mIsSetLogX = readAttribute(attributes, index[2], "logX", mLogX, true);
 
 	//
 	// logY bool   ( use = "required" )
 	//
-	mIsSetLogY = attributes.readInto("logY", mLogY, getErrorLog(), true);
+	mIsSetLogY = readAttribute(attributes, index[3], "logY", mLogY, true);
 
 	//
 	// xDataReference SIdRef   ( use = "required" )
 	//
-	assigned = attributes.readInto("xDataReference", mXDataReference, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[4], "xDataReference", mXDataReference, true);
 
 	if (assigned == true)
 	{
@@ -660,7 +753,7 @@ SedCurve::readAttributes (const XMLAttributes& attributes,
 	//
 	// yDataReference SIdRef   ( use = "required" )
 	//
-	assigned = attributes.readInto("yDataReference", mYDataReference, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[5], "yDataReference", mYDataReference, true);
 
 	if (assigned == true)
 	{
@@ -682,6 +775,14 @@ SedCurve::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sLogXAttribute("logX");
+static const std::string sLogYAttribute("logY");
+static const std::string sXDataReferenceAttribute("xDataReference");
+static const std::string sYDataReferenceAttribute("yDataReference");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -692,23 +793,57 @@ SedCurve::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		stream.writeAttribute(sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		stream.writeAttribute(sNameAttribute, prefix, mName);
+
+	if (isSetLogX() == true)
+		stream.writeAttribute(sLogXAttribute, prefix, mLogX);
+
+	if (isSetLogY() == true)
+		stream.writeAttribute(sLogYAttribute, prefix, mLogY);
+
+	if (isSetXDataReference() == true)
+		stream.writeAttribute(sXDataReferenceAttribute, prefix, mXDataReference);
+
+	if (isSetYDataReference() == true)
+		stream.writeAttribute(sYDataReferenceAttribute, prefix, mYDataReference);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedCurve::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		addAttribute(attributes, sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		addAttribute(attributes, sNameAttribute, prefix, mName);
 
 	if (isSetLogX() == true)
-		stream.writeAttribute("logX", getPrefix(), mLogX);
+		addAttribute(attributes, sLogXAttribute, prefix, mLogX ? "true" : "false");
 
 	if (isSetLogY() == true)
-		stream.writeAttribute("logY", getPrefix(), mLogY);
+		addAttribute(attributes, sLogYAttribute, prefix, mLogY ? "true" : "false");
 
 	if (isSetXDataReference() == true)
-		stream.writeAttribute("xDataReference", getPrefix(), mXDataReference);
+		addAttribute(attributes, sXDataReferenceAttribute, prefix, mXDataReference);
 
 	if (isSetYDataReference() == true)
-		stream.writeAttribute("yDataReference", getPrefix(), mYDataReference);
+		addAttribute(attributes, sYDataReferenceAttribute, prefix, mYDataReference);
 
 }
 
@@ -784,10 +919,7 @@ SedListOfCurves::get(const std::string& sid)
 const SedCurve*
 SedListOfCurves::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedCurve>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedCurve*> (*result);
+	return static_cast <const SedCurve*> (getItemById(sid));
 }
 
 
@@ -812,6 +944,17 @@ SedListOfCurves::addCurve(const SedCurve* sc)
 }
 
 
+/*
+ * Adds the given SedCurve to this SedListOfCurves, which takes ownership of it.
+ */
+int
+SedListOfCurves::addCurveAndOwn(SedCurve* sc)
+{
+	if(sc == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sc);
+}
+
+
 /**
  * Get the number of SedCurve objects in this SedListOfCurves.
  *
@@ -834,7 +977,8 @@ SedListOfCurves::getNumCurves() const
 SedCurve* 
 SedListOfCurves::createCurve()
 {
-	SedCurve *temp = new SedCurve();
+	if (isFrozen()) return NULL;
+	SedCurve *temp = new (getArena()) SedCurve();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -855,19 +999,11 @@ SedListOfCurves::remove(unsigned int n)
 SedCurve*
 SedListOfCurves::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedCurve>(sid) );
+	return static_cast <SedCurve*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedCurve*> (item);
-}
+static const std::string sSedListOfCurvesName("listOfCurves");
 
 
 /*
@@ -876,8 +1012,7 @@ SedListOfCurves::remove(const std::string& sid)
 const std::string&
 SedListOfCurves::getElementName () const
 {
-	static const string name = "listOfCurves";
-	return name;
+	return sSedListOfCurvesName;
 }
 
 
@@ -903,6 +1038,16 @@ SedListOfCurves::getItemTypeCode () const
 
 /** @cond doxygen-libsbml-internal */
 
+/*
+ * Returns the size of a SedCurve.
+ */
+size_t
+SedListOfCurves::getItemSize () const
+{
+	return sizeof(SedCurve);
+}
+
+
 /*
  * Creates a new SedCurve in this SedListOfCurves
  */
@@ -914,7 +1059,7 @@ SedListOfCurves::createObject(XMLInputStream& stream)
 
 	if (name == "curve")
 	{
-		object = new SedCurve(getSedNamespaces());
+		object = new (getArena()) SedCurve(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -939,7 +1084,8 @@ SedListOfCurves::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -1007,6 +1153,20 @@ SedCurve_getId(SedCurve_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedCurve_getIdView(const SedCurve_t * sc)
+{
+	if (sc == NULL)
+		return NULL;
+
+	return sc->getId().empty() ? NULL : sc->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1021,6 +1181,20 @@ SedCurve_getName(SedCurve_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedCurve_getNameView(const SedCurve_t * sc)
+{
+	if (sc == NULL)
+		return NULL;
+
+	return sc->getName().empty() ? NULL : sc->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1057,6 +1231,20 @@ SedCurve_getXDataReference(SedCurve_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedCurve_getXDataReferenceView(const SedCurve_t * sc)
+{
+	if (sc == NULL)
+		return NULL;
+
+	return sc->getXDataReference().empty() ? NULL : sc->getXDataReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1071,6 +1259,20 @@ SedCurve_getYDataReference(SedCurve_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedCurve_getYDataReferenceView(const SedCurve_t * sc)
+{
+	if (sc == NULL)
+		return NULL;
+
+	return sc->getYDataReference().empty() ? NULL : sc->getYDataReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1269,6 +1471,28 @@ SedCurve_unsetYDataReference(SedCurve_t * sc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedCurve_getReferencedXDataGenerator(SedCurve_t * sc)
+{
+	return (sc != NULL) ? sc->getReferencedXDataGenerator() : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedCurve_getReferencedYDataGenerator(SedCurve_t * sc)
+{
+	return (sc != NULL) ? sc->getReferencedYDataGenerator() : NULL;
+}
+
+
 /**
  * write comments
  */
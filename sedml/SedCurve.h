@@ -62,14 +62,16 @@ class LIBSEDML_EXTERN SedCurve : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	bool          mLogX;
-	bool          mIsSetLogX;
 	bool          mLogY;
-	bool          mIsSetLogY;
-	std::string   mXDataReference;
-	std::string   mYDataReference;
+	bool          mIsSetLogX : 1;
+	bool          mIsSetLogY : 1;
+	SedSymbol   mXDataReference;
+	SedSymbol   mYDataReference;
+	SedDataGenerator*   mReferencedXDataGenerator;
+	SedDataGenerator*   mReferencedYDataGenerator;
 
 
 public:
@@ -402,6 +404,30 @@ public:
 	virtual int unsetYDataReference();
 
 
+	/**
+	 * Returns the SedDataGenerator that the "xDataReference" attribute of this SedCurve
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedDataGenerator.
+	 */
+	SedDataGenerator* getReferencedXDataGenerator();
+
+
+	/**
+	 * Returns the SedDataGenerator that the "yDataReference" attribute of this SedCurve
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedDataGenerator.
+	 */
+	SedDataGenerator* getReferencedYDataGenerator();
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedCurve, is
 	 * always @c "sedCurve".
@@ -476,9 +502,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -497,6 +523,17 @@ public:
 
 protected:
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Resolves the reference attributes of this SedCurve against @p doc.
+	 */
+	virtual void lookupReferences(SedDocument* doc);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 /** @cond doxygen-libsbml-internal */
 
 	/**
@@ -528,6 +565,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -642,6 +686,25 @@ public:
 	int addCurve(const SedCurve* c);
 
 
+	/**
+	 * Adds the given "SedCurve" to this SedListOfCurves without copying it; this
+	 * SedListOfCurves takes ownership of @p c and will delete it.
+	 *
+	 * @param c the SedCurve object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p c is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addCurve(const SedCurve* c)
+	 */
+	int addCurveAndOwn(SedCurve* c);
+
+
 	/**
 	 * Get the number of Curve objects in this SedListOfCurves.
 	 *
@@ -776,6 +839,12 @@ protected:
 	virtual SedBase* createObject(XMLInputStream& stream);
 
 
+	/**
+	 * Returns the size of a SedCurve, the type of all items of this list.
+	 */
+	virtual size_t getItemSize () const;
+
+
 	/** @endcond doxygen-libsbml-internal */
 
 
@@ -824,11 +893,21 @@ char *
 SedCurve_getId(SedCurve_t * sc);
 
 
+LIBSEDML_EXTERN
+const char *
+SedCurve_getIdView(const SedCurve_t * sc);
+
+
 LIBSEDML_EXTERN
 char *
 SedCurve_getName(SedCurve_t * sc);
 
 
+LIBSEDML_EXTERN
+const char *
+SedCurve_getNameView(const SedCurve_t * sc);
+
+
 LIBSEDML_EXTERN
 int
 SedCurve_getLogX(SedCurve_t * sc);
@@ -844,11 +923,21 @@ char *
 SedCurve_getXDataReference(SedCurve_t * sc);
 
 
+LIBSEDML_EXTERN
+const char *
+SedCurve_getXDataReferenceView(const SedCurve_t * sc);
+
+
 LIBSEDML_EXTERN
 char *
 SedCurve_getYDataReference(SedCurve_t * sc);
 
 
+LIBSEDML_EXTERN
+const char *
+SedCurve_getYDataReferenceView(const SedCurve_t * sc);
+
+
 LIBSEDML_EXTERN
 int
 SedCurve_isSetId(SedCurve_t * sc);
@@ -939,6 +1028,16 @@ int
 SedCurve_unsetYDataReference(SedCurve_t * sc);
 
 
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedCurve_getReferencedXDataGenerator(SedCurve_t * sc);
+
+
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedCurve_getReferencedYDataGenerator(SedCurve_t * sc);
+
+
 LIBSEDML_EXTERN
 int
 SedCurve_hasRequiredAttributes(SedCurve_t * sc);
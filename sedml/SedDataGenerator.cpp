@@ -38,6 +38,7 @@
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
+#include <sedml/SedMathCache.h>
 
 
 using namespace std;
@@ -91,6 +92,8 @@ SedDataGenerator::SedDataGenerator (SedNamespaces* sedns)
  */
 SedDataGenerator::SedDataGenerator (const SedDataGenerator& orig)
 	: SedBase(orig)
+	, mVariable (orig.mVariable)
+	, mParameter (orig.mParameter)
 {
 	if (&orig == NULL)
 	{
@@ -100,9 +103,7 @@ SedDataGenerator::SedDataGenerator (const SedDataGenerator& orig)
 	{
 		mId  = orig.mId;
 		mName  = orig.mName;
-		mVariable  = orig.mVariable;
-		mParameter  = orig.mParameter;
-		mMath  = orig.mMath != NULL ? orig.mMath->deepCopy() : NULL;
+		mMath  = SedMathCache::acquire(orig.mMath);
 
 		// connect to child objects
 		connectToChild();
@@ -127,7 +128,8 @@ SedDataGenerator::operator=(const SedDataGenerator& rhs)
 		mName  = rhs.mName;
 		mVariable  = rhs.mVariable;
 		mParameter  = rhs.mParameter;
-		mMath  = rhs.mMath != NULL ? rhs.mMath->deepCopy() : NULL;
+		SedMathCache::release(mMath);
+		mMath  = SedMathCache::acquire(rhs.mMath);
 
 		// connect to child objects
 		connectToChild();
@@ -151,6 +153,7 @@ SedDataGenerator::clone () const
  */
 SedDataGenerator::~SedDataGenerator ()
 {
+	SedMathCache::release(mMath);
 }
 
 
@@ -214,13 +217,51 @@ SedDataGenerator::isSetMath() const
 }
 
 
+/*
+ * Returns true if math is just the ci of the variable variableId.
+ */
+bool
+SedDataGenerator::isIdentityOf(const std::string& variableId) const
+{
+	const SedVariable* variable = getIdentityVariable();
+	return (variable != NULL && variable->getId() == variableId);
+}
+
+
+/*
+ * Returns the variable math is just the ci of, or NULL.
+ */
+const SedVariable*
+SedDataGenerator::getIdentityVariable() const
+{
+	if (mMath == NULL || mMath->getType() != AST_NAME
+		|| mMath->getNumChildren() != 0 || mMath->getName() == NULL)
+	{
+		return NULL;
+	}
+
+	// a parameter of the same id would make the name ambiguous
+	const std::string name = mMath->getName();
+	if (getParameter(name) != NULL)
+	{
+		return NULL;
+	}
+
+	return getVariable(name);
+}
+
+
 /*
  * Sets id and returns value indicating success.
  */
 int
 SedDataGenerator::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -230,6 +271,8 @@ SedDataGenerator::setId(const std::string& id)
 int
 SedDataGenerator::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -248,13 +291,15 @@ SedDataGenerator::setName(const std::string& name)
 int
 SedDataGenerator::setMath(ASTNode* math)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (mMath == math)
 	{
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 	else if (math == NULL)
 	{
-		delete mMath;
+		SedMathCache::release(mMath);
 		mMath = NULL;
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
@@ -264,12 +309,9 @@ SedDataGenerator::setMath(ASTNode* math)
 	}
 	else
 	{
-		delete mMath;
-		mMath = (math != NULL) ?
-			math->deepCopy() : NULL;
-		if (mMath != NULL)
-		{
-		}
+		const ASTNode* shared = SedMathCache::intern(math->deepCopy());
+		SedMathCache::release(mMath);
+		mMath = shared;
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -281,7 +323,10 @@ SedDataGenerator::setMath(ASTNode* math)
 int
 SedDataGenerator::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -300,6 +345,8 @@ SedDataGenerator::unsetId()
 int
 SedDataGenerator::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -319,7 +366,9 @@ SedDataGenerator::unsetName()
 int
 SedDataGenerator::unsetMath()
 {
-	delete mMath;
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	SedMathCache::release(mMath);
 	mMath = NULL;
 	return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -416,6 +465,17 @@ SedDataGenerator::addVariable(const SedVariable* sv)
 }
 
 
+/*
+ * Adds the given SedVariable to this SedDataGenerator, which takes ownership of it.
+ */
+int
+SedDataGenerator::addVariableAndOwn(SedVariable* sv)
+{
+	if(sv == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mVariable.appendAndOwn(sv);
+}
+
+
 /**
  * Get the number of SedVariable objects in this SedDataGenerator.
  *
@@ -438,7 +498,8 @@ SedDataGenerator::getNumVariables() const
 SedVariable* 
 SedDataGenerator::createVariable()
 {
-	SedVariable *temp = new SedVariable();
+	if (isFrozen()) return NULL;
+	SedVariable *temp = new (getArena()) SedVariable();
 	if (temp != NULL) mVariable.appendAndOwn(temp);
 	return temp;
 }
@@ -534,6 +595,17 @@ SedDataGenerator::addParameter(const SedParameter* sp)
 }
 
 
+/*
+ * Adds the given SedParameter to this SedDataGenerator, which takes ownership of it.
+ */
+int
+SedDataGenerator::addParameterAndOwn(SedParameter* sp)
+{
+	if(sp == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mParameter.appendAndOwn(sp);
+}
+
+
 /**
  * Get the number of SedParameter objects in this SedDataGenerator.
  *
@@ -556,19 +628,22 @@ SedDataGenerator::getNumParameters() const
 SedParameter* 
 SedDataGenerator::createParameter()
 {
-	SedParameter *temp = new SedParameter();
+	if (isFrozen()) return NULL;
+	SedParameter *temp = new (getArena()) SedParameter();
 	if (temp != NULL) mParameter.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedDataGeneratorName("dataGenerator");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedDataGenerator::getElementName () const
 {
-	static const string name = "dataGenerator";
-	return name;
+	return sSedDataGeneratorName;
 }
 
 
@@ -582,16 +657,21 @@ SedDataGenerator::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
-	if (name == "listOfVariables")
+	switch (getElementNameHash(name))
 	{
-		object = &mVariable;
-	}
+	case 0x6190ecddu:
+		if (name == "listOfVariables")
+		{
+			object = &mVariable;
+		}
+		break;
 
-	if (name == "listOfParameters")
-	{
-		object = &mParameter;
+	case 0x4d047f28u:
+		if (name == "listOfParameters")
+		{
+			object = &mParameter;
+		}
+		break;
 	}
 
 	return object;
@@ -611,6 +691,50 @@ SedDataGenerator::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedDataGenerator::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mVariable);
+	addAllElements(ret, &mParameter);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this DataGenerator.
+ */
+unsigned int
+SedDataGenerator::getNumChildElements () const
+{
+	return 2;
+}
+
+
+/*
+ * Returns the nth element directly contained in this DataGenerator.
+ */
+const SedBase*
+SedDataGenerator::getChildElement (unsigned int n) const
+{
+	switch (n)
+	{
+	case 0:
+		return &mVariable;
+	case 1:
+		return &mParameter;
+	default:
+		return NULL;
+	}
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -667,7 +791,12 @@ SedDataGenerator::writeElements (XMLOutputStream& stream) const
 	}
 	if (isSetMath() == true)
 	{
-		writeMathML(getMath(), stream, NULL);
+#ifdef USE_PROFILING
+		const SedDocument* doc = getSedDocument();
+		SedProfileScope profile(doc != NULL ? doc->getProfileRecorder() : NULL,
+		                        SedProfileRecorder::MATH_WRITE);
+#endif
+		SedMathCache::write(getMath(), stream);
 	}
 }
 
@@ -678,13 +807,12 @@ SedDataGenerator::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedDataGenerator::accept (SedVisitor& v) const
+SedDataGenerator::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -737,10 +865,19 @@ SedDataGenerator::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u }
+	};
+	int index[2];
+	findAttributes(attributes, names, 2, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -759,7 +896,7 @@ SedDataGenerator::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -790,8 +927,15 @@ SedDataGenerator::readOtherXML (XMLInputStream& stream)
 		const XMLToken elem = stream.peek();
 		const std::string prefix = checkMathMLNamespace(elem);
 
-		delete mMath;
-		mMath = readMathML(stream, prefix);
+		SedMathCache::release(mMath);
+		{
+#ifdef USE_PROFILING
+			const SedDocument* doc = getSedDocument();
+			SedProfileScope profile(doc != NULL ? doc->getProfileRecorder() : NULL,
+			                        SedProfileRecorder::MATH_READ);
+#endif
+			mMath = SedMathCache::intern(readMathML(stream, prefix));
+		}
 		read = true;
 	}
 
@@ -806,6 +950,10 @@ SedDataGenerator::readOtherXML (XMLInputStream& stream)
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -816,11 +964,33 @@ SedDataGenerator::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		stream.writeAttribute(sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		stream.writeAttribute(sNameAttribute, prefix, mName);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedDataGenerator::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		addAttribute(attributes, sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		addAttribute(attributes, sNameAttribute, prefix, mName);
 
 }
 
@@ -896,10 +1066,7 @@ SedListOfDataGenerators::get(const std::string& sid)
 const SedDataGenerator*
 SedListOfDataGenerators::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedDataGenerator>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedDataGenerator*> (*result);
+	return static_cast <const SedDataGenerator*> (getItemById(sid));
 }
 
 
@@ -924,6 +1091,17 @@ SedListOfDataGenerators::addDataGenerator(const SedDataGenerator* sdg)
 }
 
 
+/*
+ * Adds the given SedDataGenerator to this SedListOfDataGenerators, which takes ownership of it.
+ */
+int
+SedListOfDataGenerators::addDataGeneratorAndOwn(SedDataGenerator* sdg)
+{
+	if(sdg == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sdg);
+}
+
+
 /**
  * Get the number of SedDataGenerator objects in this SedListOfDataGenerators.
  *
@@ -946,7 +1124,8 @@ SedListOfDataGenerators::getNumDataGenerators() const
 SedDataGenerator* 
 SedListOfDataGenerators::createDataGenerator()
 {
-	SedDataGenerator *temp = new SedDataGenerator();
+	if (isFrozen()) return NULL;
+	SedDataGenerator *temp = new (getArena()) SedDataGenerator();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -967,19 +1146,11 @@ SedListOfDataGenerators::remove(unsigned int n)
 SedDataGenerator*
 SedListOfDataGenerators::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedDataGenerator>(sid) );
+	return static_cast <SedDataGenerator*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedDataGenerator*> (item);
-}
+static const std::string sSedListOfDataGeneratorsName("listOfDataGenerators");
 
 
 /*
@@ -988,8 +1159,7 @@ SedListOfDataGenerators::remove(const std::string& sid)
 const std::string&
 SedListOfDataGenerators::getElementName () const
 {
-	static const string name = "listOfDataGenerators";
-	return name;
+	return sSedListOfDataGeneratorsName;
 }
 
 
@@ -1026,7 +1196,7 @@ SedListOfDataGenerators::createObject(XMLInputStream& stream)
 
 	if (name == "dataGenerator")
 	{
-		object = new SedDataGenerator(getSedNamespaces());
+		object = new (getArena()) SedDataGenerator(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -1051,7 +1221,8 @@ SedListOfDataGenerators::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -1119,6 +1290,20 @@ SedDataGenerator_getId(SedDataGenerator_t * sdg)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedDataGenerator_getIdView(const SedDataGenerator_t * sdg)
+{
+	if (sdg == NULL)
+		return NULL;
+
+	return sdg->getId().empty() ? NULL : sdg->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1137,13 +1322,27 @@ SedDataGenerator_getName(SedDataGenerator_t * sdg)
  * write comments
  */
 LIBSEDML_EXTERN
-ASTNode_t*
-SedDataGenerator_getMath(SedDataGenerator_t * sdg)
+const char *
+SedDataGenerator_getNameView(const SedDataGenerator_t * sdg)
 {
 	if (sdg == NULL)
 		return NULL;
 
-	return (ASTNode_t*)sdg->getMath();
+	return sdg->getName().empty() ? NULL : sdg->getName().c_str();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const ASTNode_t*
+SedDataGenerator_getMath(const SedDataGenerator_t * sdg)
+{
+	if (sdg == NULL)
+		return NULL;
+
+	return sdg->getMath();
 }
 
 
@@ -1180,6 +1379,29 @@ SedDataGenerator_isSetMath(SedDataGenerator_t * sdg)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDataGenerator_isIdentityOf(SedDataGenerator_t * sdg, const char * variableId)
+{
+	return (sdg != NULL && variableId != NULL) ?
+		static_cast<int>(sdg->isIdentityOf(variableId)) : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const SedVariable_t *
+SedDataGenerator_getIdentityVariable(SedDataGenerator_t * sdg)
+{
+	return (sdg != NULL) ? sdg->getIdentityVariable() : NULL;
+}
+
+
 /**
  * write comments
  */
@@ -1253,6 +1475,13 @@ SedDataGenerator_addVariable(SedDataGenerator_t * sdg, SedVariable_t * sv)
 	return  (sdg != NULL) ? sdg->addVariable(sv) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDataGenerator_addVariableAndOwn(SedDataGenerator_t * sdg, SedVariable_t * sv)
+{
+	return  (sdg != NULL) ? sdg->addVariableAndOwn(sv) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedVariable_t *
 SedDataGenerator_createVariable(SedDataGenerator_t * sdg)
@@ -1309,6 +1538,13 @@ SedDataGenerator_addParameter(SedDataGenerator_t * sdg, SedParameter_t * sp)
 	return  (sdg != NULL) ? sdg->addParameter(sp) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDataGenerator_addParameterAndOwn(SedDataGenerator_t * sdg, SedParameter_t * sp)
+{
+	return  (sdg != NULL) ? sdg->addParameterAndOwn(sp) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedParameter_t *
 SedDataGenerator_createParameter(SedDataGenerator_t * sdg)
@@ -64,11 +64,11 @@ class LIBSEDML_EXTERN SedDataGenerator : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	SedListOfVariables   mVariable;
 	SedListOfParameters   mParameter;
-	ASTNode*      mMath;
+	const ASTNode* mMath;
 
 
 public:
@@ -235,6 +235,28 @@ public:
 	virtual bool isSetMath() const;
 
 
+	/**
+	 * Predicate returning @c true if the "math" element of this
+	 * SedDataGenerator is just <code>&lt;ci&gt;</code> @p variableId
+	 * <code>&lt;/ci&gt;</code> and @p variableId is the id of one of its
+	 * variables, so that its values are those of the variable.
+	 *
+	 * @see getIdentityVariable()
+	 */
+	bool isIdentityOf(const std::string& variableId) const;
+
+
+	/**
+	 * Returns the variable the values of this SedDataGenerator are those
+	 * of, if its "math" element is just the <code>&lt;ci&gt;</code> of one
+	 * of its variables; evaluators can then use the values of the variable
+	 * without computing anything.
+	 *
+	 * @return the variable, or @c NULL if the math is anything else.
+	 */
+	const SedVariable* getIdentityVariable() const;
+
+
 	/**
 	 * Sets the "math" element of this SedDataGenerator.
 	 *
@@ -346,6 +368,25 @@ public:
 	int addVariable(const SedVariable* sv);
 
 
+	/**
+	 * Adds the given "SedVariable" to this SedDataGenerator without copying it; this
+	 * SedDataGenerator takes ownership of @p sv and will delete it.
+	 *
+	 * @param sv the SedVariable object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sv is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addVariable(const SedVariable* sv)
+	 */
+	int addVariableAndOwn(SedVariable* sv);
+
+
 	/**
 	 * Get the number of SedVariable objects in this SedDataGenerator.
 	 *
@@ -477,6 +518,25 @@ public:
 	int addParameter(const SedParameter* sp);
 
 
+	/**
+	 * Adds the given "SedParameter" to this SedDataGenerator without copying it; this
+	 * SedDataGenerator takes ownership of @p sp and will delete it.
+	 *
+	 * @param sp the SedParameter object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sp is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addParameter(const SedParameter* sp)
+	 */
+	int addParameterAndOwn(SedParameter* sp);
+
+
 	/**
 	 * Get the number of SedParameter objects in this SedDataGenerator.
 	 *
@@ -525,6 +585,33 @@ public:
 	SedParameter* removeParameter(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedDataGenerator.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedDataGenerator.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedDataGenerator, is
 	 * always @c "sedDataGenerator".
@@ -608,9 +695,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -695,6 +782,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -809,6 +903,25 @@ public:
 	int addDataGenerator(const SedDataGenerator* dg);
 
 
+	/**
+	 * Adds the given "SedDataGenerator" to this SedListOfDataGenerators without copying it; this
+	 * SedListOfDataGenerators takes ownership of @p dg and will delete it.
+	 *
+	 * @param dg the SedDataGenerator object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p dg is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addDataGenerator(const SedDataGenerator* dg)
+	 */
+	int addDataGeneratorAndOwn(SedDataGenerator* dg);
+
+
 	/**
 	 * Get the number of DataGenerator objects in this SedListOfDataGenerators.
 	 *
@@ -991,14 +1104,24 @@ char *
 SedDataGenerator_getId(SedDataGenerator_t * sdg);
 
 
+LIBSEDML_EXTERN
+const char *
+SedDataGenerator_getIdView(const SedDataGenerator_t * sdg);
+
+
 LIBSEDML_EXTERN
 char *
 SedDataGenerator_getName(SedDataGenerator_t * sdg);
 
 
 LIBSEDML_EXTERN
-ASTNode_t*
-SedDataGenerator_getMath(SedDataGenerator_t * sdg);
+const char *
+SedDataGenerator_getNameView(const SedDataGenerator_t * sdg);
+
+
+LIBSEDML_EXTERN
+const ASTNode_t*
+SedDataGenerator_getMath(const SedDataGenerator_t * sdg);
 
 
 LIBSEDML_EXTERN
@@ -1016,6 +1139,16 @@ int
 SedDataGenerator_isSetMath(SedDataGenerator_t * sdg);
 
 
+LIBSEDML_EXTERN
+int
+SedDataGenerator_isIdentityOf(SedDataGenerator_t * sdg, const char * variableId);
+
+
+LIBSEDML_EXTERN
+const SedVariable_t *
+SedDataGenerator_getIdentityVariable(SedDataGenerator_t * sdg);
+
+
 LIBSEDML_EXTERN
 int
 SedDataGenerator_setId(SedDataGenerator_t * sdg, const char * id);
@@ -1051,6 +1184,11 @@ int
 SedDataGenerator_addVariable(SedDataGenerator_t * sdg, SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+int
+SedDataGenerator_addVariableAndOwn(SedDataGenerator_t * sdg, SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 SedVariable_t *
 SedDataGenerator_createVariable(SedDataGenerator_t * sdg);
@@ -1091,6 +1229,11 @@ int
 SedDataGenerator_addParameter(SedDataGenerator_t * sdg, SedParameter_t * sp);
 
 
+LIBSEDML_EXTERN
+int
+SedDataGenerator_addParameterAndOwn(SedDataGenerator_t * sdg, SedParameter_t * sp);
+
+
 LIBSEDML_EXTERN
 SedParameter_t *
 SedDataGenerator_createParameter(SedDataGenerator_t * sdg);
@@ -53,6 +53,7 @@ SedDataSet::SedDataSet (unsigned int level, unsigned int version)
 	, mLabel ("")
 	, mName ("")
 	, mDataReference ("")
+	, mReferencedDataGenerator (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -69,6 +70,7 @@ SedDataSet::SedDataSet (SedNamespaces* sedns)
 	, mLabel ("")
 	, mName ("")
 	, mDataReference ("")
+	, mReferencedDataGenerator (NULL)
 
 {
 	// set the element namespace of this object
@@ -92,6 +94,7 @@ SedDataSet::SedDataSet (const SedDataSet& orig)
 		mLabel  = orig.mLabel;
 		mName  = orig.mName;
 		mDataReference  = orig.mDataReference;
+		mReferencedDataGenerator  = NULL;
 	}
 }
 
@@ -113,6 +116,7 @@ SedDataSet::operator=(const SedDataSet& rhs)
 		mLabel  = rhs.mLabel;
 		mName  = rhs.mName;
 		mDataReference  = rhs.mDataReference;
+		mReferencedDataGenerator  = NULL;
 	}
 	return *this;
 }
@@ -222,7 +226,11 @@ SedDataSet::isSetDataReference() const
 int
 SedDataSet::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -232,6 +240,8 @@ SedDataSet::setId(const std::string& id)
 int
 SedDataSet::setLabel(const std::string& label)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(label) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -250,6 +260,8 @@ SedDataSet::setLabel(const std::string& label)
 int
 SedDataSet::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -268,6 +280,8 @@ SedDataSet::setName(const std::string& name)
 int
 SedDataSet::setDataReference(const std::string& dataReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(dataReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -279,6 +293,7 @@ SedDataSet::setDataReference(const std::string& dataReference)
 	else
 	{
 		mDataReference = dataReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -290,7 +305,10 @@ SedDataSet::setDataReference(const std::string& dataReference)
 int
 SedDataSet::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -309,6 +327,8 @@ SedDataSet::unsetId()
 int
 SedDataSet::unsetLabel()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLabel.erase();
 
 	if (mLabel.empty() == true)
@@ -328,6 +348,8 @@ SedDataSet::unsetLabel()
 int
 SedDataSet::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -347,7 +369,10 @@ SedDataSet::unsetName()
 int
 SedDataSet::unsetDataReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mDataReference.erase();
+	notifyReferencesChanged();
 
 	if (mDataReference.empty() == true)
 	{
@@ -360,14 +385,43 @@ SedDataSet::unsetDataReference()
 }
 
 
+/*
+ * Returns the SedDataGenerator referenced by the "dataReference" attribute.
+ */
+SedDataGenerator*
+SedDataSet::getReferencedDataGenerator()
+{
+	updateReferences();
+	return mReferencedDataGenerator;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Resolves the reference attributes of this SedDataSet against the document.
+ */
+void
+SedDataSet::lookupReferences(SedDocument* doc)
+{
+	mReferencedDataGenerator = (doc != NULL && isSetDataReference())
+		? doc->getDataGenerator(mDataReference) : NULL;
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sSedDataSetName("dataSet");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedDataSet::getElementName () const
 {
-	static const string name = "dataSet";
-	return name;
+	return sSedDataSetName;
 }
 
 
@@ -420,13 +474,12 @@ SedDataSet::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedDataSet::accept (SedVisitor& v) const
+SedDataSet::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -481,10 +534,21 @@ SedDataSet::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "label", 0xf69717fdu },
+		{ "name", 0x8d39bde6u },
+		{ "dataReference", 0xceb89f5au }
+	};
+	int index[4];
+	findAttributes(attributes, names, 4, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -503,7 +567,7 @@ SedDataSet::readAttributes (const XMLAttributes& attributes,
 	//
 	// label string   ( use = "required" )
 	//
-	assigned = attributes.readInto("label", mLabel, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[1], "label", mLabel, true);
 
 	if (assigned == true)
 	{
@@ -518,7 +582,7 @@ SedDataSet::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[2], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -533,7 +597,7 @@ SedDataSet::readAttributes (const XMLAttributes& attributes,
 	//
 	// dataReference SIdRef   ( use = "required" )
 	//
-	assigned = attributes.readInto("dataReference", mDataReference, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[3], "dataReference", mDataReference, true);
 
 	if (assigned == true)
 	{
@@ -555,6 +619,12 @@ SedDataSet::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sLabelAttribute("label");
+static const std::string sNameAttribute("name");
+static const std::string sDataReferenceAttribute("dataReference");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -565,17 +635,45 @@ SedDataSet::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		stream.writeAttribute(sIdAttribute, prefix, mId);
 
 	if (isSetLabel() == true)
-		stream.writeAttribute("label", getPrefix(), mLabel);
+		stream.writeAttribute(sLabelAttribute, prefix, mLabel);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		stream.writeAttribute(sNameAttribute, prefix, mName);
 
 	if (isSetDataReference() == true)
-		stream.writeAttribute("dataReference", getPrefix(), mDataReference);
+		stream.writeAttribute(sDataReferenceAttribute, prefix, mDataReference);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedDataSet::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		addAttribute(attributes, sIdAttribute, prefix, mId);
+
+	if (isSetLabel() == true)
+		addAttribute(attributes, sLabelAttribute, prefix, mLabel);
+
+	if (isSetName() == true)
+		addAttribute(attributes, sNameAttribute, prefix, mName);
+
+	if (isSetDataReference() == true)
+		addAttribute(attributes, sDataReferenceAttribute, prefix, mDataReference);
 
 }
 
@@ -651,10 +749,7 @@ SedListOfDataSets::get(const std::string& sid)
 const SedDataSet*
 SedListOfDataSets::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedDataSet>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedDataSet*> (*result);
+	return static_cast <const SedDataSet*> (getItemById(sid));
 }
 
 
@@ -679,6 +774,17 @@ SedListOfDataSets::addDataSet(const SedDataSet* sds)
 }
 
 
+/*
+ * Adds the given SedDataSet to this SedListOfDataSets, which takes ownership of it.
+ */
+int
+SedListOfDataSets::addDataSetAndOwn(SedDataSet* sds)
+{
+	if(sds == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sds);
+}
+
+
 /**
  * Get the number of SedDataSet objects in this SedListOfDataSets.
  *
@@ -701,7 +807,8 @@ SedListOfDataSets::getNumDataSets() const
 SedDataSet* 
 SedListOfDataSets::createDataSet()
 {
-	SedDataSet *temp = new SedDataSet();
+	if (isFrozen()) return NULL;
+	SedDataSet *temp = new (getArena()) SedDataSet();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -722,19 +829,11 @@ SedListOfDataSets::remove(unsigned int n)
 SedDataSet*
 SedListOfDataSets::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
+	return static_cast <SedDataSet*> (removeItemById(sid));
+}
 
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedDataSet>(sid) );
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
-
-	return static_cast <SedDataSet*> (item);
-}
+static const std::string sSedListOfDataSetsName("listOfDataSets");
 
 
 /*
@@ -743,8 +842,7 @@ SedListOfDataSets::remove(const std::string& sid)
 const std::string&
 SedListOfDataSets::getElementName () const
 {
-	static const string name = "listOfDataSets";
-	return name;
+	return sSedListOfDataSetsName;
 }
 
 
@@ -770,6 +868,16 @@ SedListOfDataSets::getItemTypeCode () const
 
 /** @cond doxygen-libsbml-internal */
 
+/*
+ * Returns the size of a SedDataSet.
+ */
+size_t
+SedListOfDataSets::getItemSize () const
+{
+	return sizeof(SedDataSet);
+}
+
+
 /*
  * Creates a new SedDataSet in this SedListOfDataSets
  */
@@ -781,7 +889,7 @@ SedListOfDataSets::createObject(XMLInputStream& stream)
 
 	if (name == "dataSet")
 	{
-		object = new SedDataSet(getSedNamespaces());
+		object = new (getArena()) SedDataSet(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -806,7 +914,8 @@ SedListOfDataSets::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -874,6 +983,20 @@ SedDataSet_getId(SedDataSet_t * sds)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getIdView(const SedDataSet_t * sds)
+{
+	if (sds == NULL)
+		return NULL;
+
+	return sds->getId().empty() ? NULL : sds->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -888,6 +1011,20 @@ SedDataSet_getLabel(SedDataSet_t * sds)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getLabelView(const SedDataSet_t * sds)
+{
+	if (sds == NULL)
+		return NULL;
+
+	return sds->getLabel().empty() ? NULL : sds->getLabel().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -902,6 +1039,20 @@ SedDataSet_getName(SedDataSet_t * sds)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getNameView(const SedDataSet_t * sds)
+{
+	if (sds == NULL)
+		return NULL;
+
+	return sds->getName().empty() ? NULL : sds->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -916,6 +1067,20 @@ SedDataSet_getDataReference(SedDataSet_t * sds)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getDataReferenceView(const SedDataSet_t * sds)
+{
+	if (sds == NULL)
+		return NULL;
+
+	return sds->getDataReference().empty() ? NULL : sds->getDataReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1048,6 +1213,17 @@ SedDataSet_unsetDataReference(SedDataSet_t * sds)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedDataSet_getReferencedDataGenerator(SedDataSet_t * sds)
+{
+	return (sds != NULL) ? sds->getReferencedDataGenerator() : NULL;
+}
+
+
 /**
  * write comments
  */
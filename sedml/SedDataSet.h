@@ -62,10 +62,11 @@ class LIBSEDML_EXTERN SedDataSet : public SedBase
 
 protected:
 
-	std::string   mId;
+	SedSymbol   mId;
 	std::string   mLabel;
-	std::string   mName;
-	std::string   mDataReference;
+	SedOptionalString   mName;
+	SedSymbol   mDataReference;
+	SedDataGenerator*   mReferencedDataGenerator;
 
 
 public:
@@ -306,6 +307,18 @@ public:
 	virtual int unsetDataReference();
 
 
+	/**
+	 * Returns the SedDataGenerator that the "dataReference" attribute of this SedDataSet
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedDataGenerator.
+	 */
+	SedDataGenerator* getReferencedDataGenerator();
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedDataSet, is
 	 * always @c "sedDataSet".
@@ -379,9 +392,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -400,6 +413,17 @@ public:
 
 protected:
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Resolves the reference attributes of this SedDataSet against @p doc.
+	 */
+	virtual void lookupReferences(SedDocument* doc);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 /** @cond doxygen-libsbml-internal */
 
 	/**
@@ -431,6 +455,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -545,6 +576,25 @@ public:
 	int addDataSet(const SedDataSet* ds);
 
 
+	/**
+	 * Adds the given "SedDataSet" to this SedListOfDataSets without copying it; this
+	 * SedListOfDataSets takes ownership of @p ds and will delete it.
+	 *
+	 * @param ds the SedDataSet object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p ds is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addDataSet(const SedDataSet* ds)
+	 */
+	int addDataSetAndOwn(SedDataSet* ds);
+
+
 	/**
 	 * Get the number of DataSet objects in this SedListOfDataSets.
 	 *
@@ -679,6 +729,12 @@ protected:
 	virtual SedBase* createObject(XMLInputStream& stream);
 
 
+	/**
+	 * Returns the size of a SedDataSet, the type of all items of this list.
+	 */
+	virtual size_t getItemSize () const;
+
+
 	/** @endcond doxygen-libsbml-internal */
 
 
@@ -727,21 +783,41 @@ char *
 SedDataSet_getId(SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getIdView(const SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 char *
 SedDataSet_getLabel(SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getLabelView(const SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 char *
 SedDataSet_getName(SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getNameView(const SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 char *
 SedDataSet_getDataReference(SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+const char *
+SedDataSet_getDataReferenceView(const SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 int
 SedDataSet_isSetId(SedDataSet_t * sds);
@@ -802,6 +878,11 @@ int
 SedDataSet_unsetDataReference(SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedDataSet_getReferencedDataGenerator(SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 int
 SedDataSet_hasRequiredAttributes(SedDataSet_t * sds);
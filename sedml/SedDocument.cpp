@@ -35,8 +35,11 @@
 
 #include <sedml/SedDocument.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedArena.h>
 #include <sbml/xml/XMLInputStream.h>
 
+#include <algorithm>
+
 
 using namespace std;
 
@@ -50,14 +53,27 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 SedDocument::SedDocument (unsigned int level, unsigned int version)
 	: SedBase(level, version)
 	, mLevel (SEDML_INT_MAX)
-	, mIsSetLevel (false)
 	, mVersion (SEDML_INT_MAX)
+	, mIsSetLevel (false)
 	, mIsSetVersion (false)
 	, mSimulation (level, version)
 	, mModel (level, version)
 	, mTask (level, version)
 	, mDataGenerator (level, version)
 	, mOutput (level, version)
+	, mElementIndexValid (false)
+	, mElementIndexGeneration (0)
+	, mReferrerIndexValid (false)
+	, mChangeGeneration (0)
+	, mDeferNotesAndAnnotations (false)
+	, mShareNotesAndAnnotations (false)
+	, mStructureOnlyDepth (0)
+	, mMaxXMLDepth (SedXMLTree::DEFAULT_MAX_DEPTH)
+	, mArena (NULL)
+	, mWriteCache (NULL)
+	, mProfileRecorder (NULL)
+	, mFrozen (false)
+	, mNumDanglingReferences (0)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -74,14 +90,27 @@ SedDocument::SedDocument (unsigned int level, unsigned int version)
 SedDocument::SedDocument (SedNamespaces* sedns)
 	: SedBase(sedns)
 	, mLevel (SEDML_INT_MAX)
-	, mIsSetLevel (false)
 	, mVersion (SEDML_INT_MAX)
+	, mIsSetLevel (false)
 	, mIsSetVersion (false)
 	, mSimulation (sedns)
 	, mModel (sedns)
 	, mTask (sedns)
 	, mDataGenerator (sedns)
 	, mOutput (sedns)
+	, mElementIndexValid (false)
+	, mElementIndexGeneration (0)
+	, mReferrerIndexValid (false)
+	, mChangeGeneration (0)
+	, mDeferNotesAndAnnotations (false)
+	, mShareNotesAndAnnotations (false)
+	, mStructureOnlyDepth (0)
+	, mMaxXMLDepth (SedXMLTree::DEFAULT_MAX_DEPTH)
+	, mArena (NULL)
+	, mWriteCache (NULL)
+	, mProfileRecorder (NULL)
+	, mFrozen (false)
+	, mNumDanglingReferences (0)
 
 {
 	// set the element namespace of this object
@@ -97,6 +126,24 @@ SedDocument::SedDocument (SedNamespaces* sedns)
  */
 SedDocument::SedDocument (const SedDocument& orig)
 	: SedBase(orig)
+	, mSimulation (orig.mSimulation)
+	, mModel (orig.mModel)
+	, mTask (orig.mTask)
+	, mDataGenerator (orig.mDataGenerator)
+	, mOutput (orig.mOutput)
+	, mElementIndexValid (false)
+	, mElementIndexGeneration (0)
+	, mReferrerIndexValid (false)
+	, mChangeGeneration (0)
+	, mDeferNotesAndAnnotations (orig.mDeferNotesAndAnnotations)
+	, mShareNotesAndAnnotations (orig.mShareNotesAndAnnotations)
+	, mStructureOnlyDepth (orig.mStructureOnlyDepth)
+	, mMaxXMLDepth (orig.mMaxXMLDepth)
+	, mArena (NULL)
+	, mWriteCache (NULL)
+	, mProfileRecorder (NULL)
+	, mFrozen (false)
+	, mNumDanglingReferences (0)
 {
 	if (&orig == NULL)
 	{
@@ -108,11 +155,8 @@ SedDocument::SedDocument (const SedDocument& orig)
 		mIsSetLevel  = orig.mIsSetLevel;
 		mVersion  = orig.mVersion;
 		mIsSetVersion  = orig.mIsSetVersion;
-		mSimulation  = orig.mSimulation;
-		mModel  = orig.mModel;
-		mTask  = orig.mTask;
-		mDataGenerator  = orig.mDataGenerator;
-		mOutput  = orig.mOutput;
+
+		setUseArena(orig.getUseArena());
 
 		// connect to child objects
 		connectToChild();
@@ -142,6 +186,12 @@ SedDocument::operator=(const SedDocument& rhs)
 		mTask  = rhs.mTask;
 		mDataGenerator  = rhs.mDataGenerator;
 		mOutput  = rhs.mOutput;
+		mDeferNotesAndAnnotations  = rhs.mDeferNotesAndAnnotations;
+		mShareNotesAndAnnotations  = rhs.mShareNotesAndAnnotations;
+		mStructureOnlyDepth  = rhs.mStructureOnlyDepth;
+		mMaxXMLDepth         = rhs.mMaxXMLDepth;
+
+		invalidateElementIndex();
 
 		// connect to child objects
 		connectToChild();
@@ -165,6 +215,13 @@ SedDocument::clone () const
  */
 SedDocument::~SedDocument ()
 {
+	for (unsigned int i = 0; i < mInternedNamespaces.size(); i++)
+	{
+		mInternedNamespaces[i]->release();
+	}
+
+	// the arena goes once the elements allocated from it have been deleted
+	if (mArena != NULL) mArena->release();
 }
 
 
@@ -214,6 +271,8 @@ SedDocument::isSetVersion() const
 int
 SedDocument::setLevel(int level)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLevel = level;
 	mIsSetLevel = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -226,6 +285,8 @@ SedDocument::setLevel(int level)
 int
 SedDocument::setVersion(int version)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mVersion = version;
 	mIsSetVersion = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -238,6 +299,8 @@ SedDocument::setVersion(int version)
 int
 SedDocument::unsetLevel()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLevel = SEDML_INT_MAX;
 	mIsSetLevel = false;
 
@@ -258,6 +321,8 @@ SedDocument::unsetLevel()
 int
 SedDocument::unsetVersion()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mVersion = SEDML_INT_MAX;
 	mIsSetVersion = false;
 
@@ -363,6 +428,17 @@ SedDocument::addSimulation(const SedSimulation* ss)
 }
 
 
+/*
+ * Adds the given SedSimulation to this SedDocument, which takes ownership of it.
+ */
+int
+SedDocument::addSimulationAndOwn(SedSimulation* ss)
+{
+	if(ss == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mSimulation.appendAndOwn(ss);
+}
+
+
 /**
  * Get the number of SedSimulation objects in this SedDocument.
  *
@@ -385,7 +461,8 @@ SedDocument::getNumSimulations() const
 SedUniformTimeCourse* 
 SedDocument::createUniformTimeCourse()
 {
-	SedUniformTimeCourse *temp = new SedUniformTimeCourse();
+	if (isFrozen()) return NULL;
+	SedUniformTimeCourse *temp = new (getArena()) SedUniformTimeCourse();
 	if (temp != NULL) mSimulation.appendAndOwn(temp);
 	return temp;
 }
@@ -481,6 +558,17 @@ SedDocument::addModel(const SedModel* sm)
 }
 
 
+/*
+ * Adds the given SedModel to this SedDocument, which takes ownership of it.
+ */
+int
+SedDocument::addModelAndOwn(SedModel* sm)
+{
+	if(sm == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mModel.appendAndOwn(sm);
+}
+
+
 /**
  * Get the number of SedModel objects in this SedDocument.
  *
@@ -503,7 +591,8 @@ SedDocument::getNumModels() const
 SedModel* 
 SedDocument::createModel()
 {
-	SedModel *temp = new SedModel();
+	if (isFrozen()) return NULL;
+	SedModel *temp = new (getArena()) SedModel();
 	if (temp != NULL) mModel.appendAndOwn(temp);
 	return temp;
 }
@@ -599,6 +688,17 @@ SedDocument::addTask(const SedTask* st)
 }
 
 
+/*
+ * Adds the given SedTask to this SedDocument, which takes ownership of it.
+ */
+int
+SedDocument::addTaskAndOwn(SedTask* st)
+{
+	if(st == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mTask.appendAndOwn(st);
+}
+
+
 /**
  * Get the number of SedTask objects in this SedDocument.
  *
@@ -621,7 +721,8 @@ SedDocument::getNumTasks() const
 SedTask* 
 SedDocument::createTask()
 {
-	SedTask *temp = new SedTask();
+	if (isFrozen()) return NULL;
+	SedTask *temp = new (getArena()) SedTask();
 	if (temp != NULL) mTask.appendAndOwn(temp);
 	return temp;
 }
@@ -717,6 +818,17 @@ SedDocument::addDataGenerator(const SedDataGenerator* sdg)
 }
 
 
+/*
+ * Adds the given SedDataGenerator to this SedDocument, which takes ownership of it.
+ */
+int
+SedDocument::addDataGeneratorAndOwn(SedDataGenerator* sdg)
+{
+	if(sdg == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mDataGenerator.appendAndOwn(sdg);
+}
+
+
 /**
  * Get the number of SedDataGenerator objects in this SedDocument.
  *
@@ -739,7 +851,8 @@ SedDocument::getNumDataGenerators() const
 SedDataGenerator* 
 SedDocument::createDataGenerator()
 {
-	SedDataGenerator *temp = new SedDataGenerator();
+	if (isFrozen()) return NULL;
+	SedDataGenerator *temp = new (getArena()) SedDataGenerator();
 	if (temp != NULL) mDataGenerator.appendAndOwn(temp);
 	return temp;
 }
@@ -835,6 +948,17 @@ SedDocument::addOutput(const SedOutput* so)
 }
 
 
+/*
+ * Adds the given SedOutput to this SedDocument, which takes ownership of it.
+ */
+int
+SedDocument::addOutputAndOwn(SedOutput* so)
+{
+	if(so == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mOutput.appendAndOwn(so);
+}
+
+
 /**
  * Get the number of SedOutput objects in this SedDocument.
  *
@@ -857,7 +981,8 @@ SedDocument::getNumOutputs() const
 SedReport* 
 SedDocument::createReport()
 {
-	SedReport *temp = new SedReport();
+	if (isFrozen()) return NULL;
+	SedReport *temp = new (getArena()) SedReport();
 	if (temp != NULL) mOutput.appendAndOwn(temp);
 	return temp;
 }
@@ -873,7 +998,8 @@ SedDocument::createReport()
 SedPlot2D* 
 SedDocument::createPlot2D()
 {
-	SedPlot2D *temp = new SedPlot2D();
+	if (isFrozen()) return NULL;
+	SedPlot2D *temp = new (getArena()) SedPlot2D();
 	if (temp != NULL) mOutput.appendAndOwn(temp);
 	return temp;
 }
@@ -889,19 +1015,22 @@ SedDocument::createPlot2D()
 SedPlot3D* 
 SedDocument::createPlot3D()
 {
-	SedPlot3D *temp = new SedPlot3D();
+	if (isFrozen()) return NULL;
+	SedPlot3D *temp = new (getArena()) SedPlot3D();
 	if (temp != NULL) mOutput.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedDocumentName("sedML");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedDocument::getElementName () const
 {
-	static const string name = "sedML";
-	return name;
+	return sSedDocumentName;
 }
 
 
@@ -915,31 +1044,42 @@ SedDocument::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
-	if (name == "listOfSimulations")
-	{
-		object = &mSimulation;
-	}
-
-	if (name == "listOfModels")
-	{
-		object = &mModel;
-	}
-
-	if (name == "listOfTasks")
-	{
-		object = &mTask;
-	}
-
-	if (name == "listOfDataGenerators")
-	{
-		object = &mDataGenerator;
-	}
-
-	if (name == "listOfOutputs")
+	switch (getElementNameHash(name))
 	{
-		object = &mOutput;
+	case 0x32431a30u:
+		if (name == "listOfSimulations")
+		{
+			object = &mSimulation;
+		}
+		break;
+
+	case 0x1a482706u:
+		if (name == "listOfModels")
+		{
+			object = &mModel;
+		}
+		break;
+
+	case 0x276c6856u:
+		if (name == "listOfTasks")
+		{
+			object = &mTask;
+		}
+		break;
+
+	case 0x7c83ab16u:
+		if (name == "listOfDataGenerators")
+		{
+			object = &mDataGenerator;
+		}
+		break;
+
+	case 0xed8b182eu:
+		if (name == "listOfOutputs")
+		{
+			object = &mOutput;
+		}
+		break;
 	}
 
 	return object;
@@ -963,234 +1103,1182 @@ SedDocument::connectToChild ()
 
 
 /*
- * Returns the libSEDML type code for this SEDML object.
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
  */
-int
-SedDocument::getTypeCode () const
+List*
+SedDocument::getAllElements()
 {
-	return SEDML_DOCUMENT;
+	List* ret = new List();
+
+	addAllElements(ret, &mSimulation);
+	addAllElements(ret, &mModel);
+	addAllElements(ret, &mTask);
+	addAllElements(ret, &mDataGenerator);
+	addAllElements(ret, &mOutput);
+
+	return ret;
 }
 
 
 /*
- * check if all the required attributes are set
+ * Returns the number of elements directly contained in this Document.
  */
-bool
-SedDocument::hasRequiredAttributes () const
+unsigned int
+SedDocument::getNumChildElements () const
 {
-	bool allPresent = true;
-
-	if (isSetLevel() == false)
-		allPresent = false;
+	return 5;
+}
 
-	if (isSetVersion() == false)
-		allPresent = false;
 
-	return allPresent;
+/*
+ * Returns the nth element directly contained in this Document.
+ */
+const SedBase*
+SedDocument::getChildElement (unsigned int n) const
+{
+	switch (n)
+	{
+	case 0:
+		return &mSimulation;
+	case 1:
+		return &mModel;
+	case 2:
+		return &mTask;
+	case 3:
+		return &mDataGenerator;
+	case 4:
+		return &mOutput;
+	default:
+		return NULL;
+	}
 }
 
 
 /*
- * check if all the required elements are set
+ * Returns the first element with the given id, using the id index.
  */
-bool
-SedDocument::hasRequiredElements () const
+SedBase*
+SedDocument::getElementBySId(std::string id)
 {
-	bool allPresent = true;
+	if (id.empty()) return NULL;
 
-	return allPresent;
-}
+	if (!mElementIndexValid) rebuildElementIndex();
 
+	ElementIndex::iterator it = mSIdIndex.find(id);
+	return (it == mSIdIndex.end()) ? NULL : it->second;
+}
 
-/** @cond doxygen-libsbml-internal */
 
 /*
- * write contained elements
+ * Returns the first element with the given metaid, using the metaid index.
  */
-void
-SedDocument::writeElements (XMLOutputStream& stream) const
+SedBase*
+SedDocument::getElementByMetaId(std::string metaid)
 {
-	SedBase::writeElements(stream);
-	if (getNumSimulations() > 0)
-	{
-		mSimulation.write(stream);
-	}
-	if (getNumModels() > 0)
-	{
-		mModel.write(stream);
-	}
-	if (getNumTasks() > 0)
-	{
-		mTask.write(stream);
-	}
-	if (getNumDataGenerators() > 0)
-	{
-		mDataGenerator.write(stream);
-	}
-	if (getNumOutputs() > 0)
-	{
-		mOutput.write(stream);
-	}
+	if (metaid.empty()) return NULL;
+
+	if (!mElementIndexValid) rebuildElementIndex();
+
+	ElementIndex::iterator it = mMetaIdIndex.find(metaid);
+	return (it == mMetaIdIndex.end()) ? NULL : it->second;
 }
 
 
-/** @endcond doxygen-libsbml-internal */
+/*
+ * Sets whether notes and annotations are parsed on first access.
+ */
+int
+SedDocument::setDeferNotesAndAnnotations(bool defer)
+{
+	if (mFrozen) return LIBSEDML_OPERATION_FAILED;
 
+	mDeferNotesAndAnnotations = defer;
+	return LIBSEDML_OPERATION_SUCCESS;
+}
 
-/** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Returns whether notes and annotations are parsed on first access.
  */
 bool
-SedDocument::accept (SedVisitor& v) const
+SedDocument::getDeferNotesAndAnnotations() const
 {
-	return false;
-
+	return mDeferNotesAndAnnotations;
 }
 
 
-/** @endcond doxygen-libsbml-internal */
+/*
+ * Sets whether copies share notes and annotations until modified.
+ */
+int
+SedDocument::setShareNotesAndAnnotations(bool share)
+{
+	if (mFrozen) return LIBSEDML_OPERATION_FAILED;
 
+	mShareNotesAndAnnotations = share;
+	return LIBSEDML_OPERATION_SUCCESS;
+}
 
-/** @cond doxygen-libsbml-internal */
 
 /*
- * Sets the parent SedDocument.
+ * Returns whether copies share notes and annotations until modified.
  */
-void
-SedDocument::setSedDocument (SedDocument* d)
+bool
+SedDocument::getShareNotesAndAnnotations() const
 {
-	SedBase::setSedDocument(d);
+	return mShareNotesAndAnnotations;
 }
 
 
-/** @endcond doxygen-libsbml-internal */
+/*
+ * Sets the depth to which documents are read.
+ */
+int
+SedDocument::setStructureOnlyDepth(unsigned int depth)
+{
+	if (mFrozen) return LIBSEDML_OPERATION_FAILED;
 
+	mStructureOnlyDepth = depth;
+	return LIBSEDML_OPERATION_SUCCESS;
+}
 
-/** @cond doxygen-libsbml-internal */
 
 /*
- * Get the list of expected attributes for this element.
+ * Returns the depth to which documents are read.
  */
-void
-SedDocument::addExpectedAttributes(ExpectedAttributes& attributes)
+unsigned int
+SedDocument::getStructureOnlyDepth() const
 {
-	SedBase::addExpectedAttributes(attributes);
-
-	attributes.add("level");
-	attributes.add("version");
+	return mStructureOnlyDepth;
 }
 
 
-/** @endcond doxygen-libsbml-internal */
+/*
+ * Sets how deeply notes and annotations may nest.
+ */
+int
+SedDocument::setMaxXMLDepth(unsigned int depth)
+{
+	if (mFrozen) return LIBSEDML_OPERATION_FAILED;
 
+	mMaxXMLDepth = depth;
+	return LIBSEDML_OPERATION_SUCCESS;
+}
 
-/** @cond doxygen-libsbml-internal */
 
 /*
- * Read values from the given XMLAttributes set into their specific fields.
+ * Returns how deeply notes and annotations may nest.
  */
-void
-SedDocument::readAttributes (const XMLAttributes& attributes,
-                             const ExpectedAttributes& expectedAttributes)
+unsigned int
+SedDocument::getMaxXMLDepth() const
 {
-	SedBase::readAttributes(attributes, expectedAttributes);
+	return mMaxXMLDepth;
+}
 
-	bool assigned = false;
 
-	//
-	// level int   ( use = "required" )
-	//
-	mIsSetLevel = attributes.readInto("level", mLevel, getErrorLog(), true);
+/*
+ * Sets whether new elements are allocated from an arena.
+ */
+int
+SedDocument::setUseArena(bool useArena)
+{
+	if (mFrozen) return LIBSEDML_OPERATION_FAILED;
 
-	//
-	// version int   ( use = "required" )
-	//
-	mIsSetVersion = attributes.readInto("version", mVersion, getErrorLog(), true);
+	if (useArena && mArena == NULL)
+	{
+		mArena = new SedArena();
+	}
+	else if (!useArena && mArena != NULL)
+	{
+		mArena->release();
+		mArena = NULL;
+	}
 
+	return LIBSEDML_OPERATION_SUCCESS;
 }
 
 
-/** @endcond doxygen-libsbml-internal */
+/*
+ * Returns whether new elements are allocated from an arena.
+ */
+bool
+SedDocument::getUseArena() const
+{
+	return (mArena != NULL);
+}
 
 
-/** @cond doxygen-libsbml-internal */
+/*
+ * Estimates the memory this document and its elements take.
+ */
+SedMemoryUsage
+SedDocument::getMemoryUsage() const
+{
+	SedMemoryVisitor visitor;
+	accept(visitor);
+
+	return visitor.getUsage();
+}
+
 
 /*
- * Write values of XMLAttributes to the output stream.
+ * Makes this document read-only, with everything computed on first use
+ * computed now.
  */
-	void
-SedDocument::writeAttributes (XMLOutputStream& stream) const
+int
+SedDocument::freeze()
 {
-	SedBase::writeAttributes(stream);
+	if (mFrozen) return LIBSEDML_OPERATION_SUCCESS;
 
-	if (isSetLevel() == true)
-		stream.writeAttribute("level", getPrefix(), mLevel);
+	// a document being written or read is not frozen under the writer
+	if (mWriteCache != NULL || mProfileRecorder != NULL)
+	{
+		return LIBSEDML_OPERATION_FAILED;
+	}
 
-	if (isSetVersion() == true)
-		stream.writeAttribute("version", getPrefix(), mVersion);
+	if (!mElementIndexValid) rebuildElementIndex();
+	if (!mReferrerIndexValid) rebuildReferrerIndex();
 
-}
+	mNumDanglingReferences = resolveReferences();
+
+	for (SedElementIterator it = begin(); it != end(); ++it)
+	{
+		const_cast<SedBase&>(*it).prepareToFreeze();
+	}
 
+	// the error log counts errors by severity on first use
+	getErrorLog()->getNumFailsWithSeverity(LIBSEDML_SEV_ERROR);
 
-/** @endcond doxygen-libsbml-internal */
+	// only reading uses the checked namespaces
+	std::vector<std::pair<const SedNamespaces*, std::string> >()
+	  .swap(mCheckedNamespaces);
+	std::vector<SedNamespaces*>(mInternedNamespaces)
+	  .swap(mInternedNamespaces);
 
+	mFrozen = true;
 
+	return LIBSEDML_OPERATION_SUCCESS;
+}
 
 
 /*
- * @return the nth error encountered during the parse of this
- * SedDocument or @c NULL if n > getNumErrors() - 1.
+ * Returns true if this document has been frozen.
  */
-const SedError*
-SedDocument::getError (unsigned int n) const
+bool
+SedDocument::isFrozen() const
 {
-  return mErrorLog.getError(n);
+	return mFrozen;
 }
 
 
 /*
- * @return the number of errors encountered during the parse of this
- * SedDocument.
+ * Resolves all reference attributes and logs the dangling ones.
  */
 unsigned int
-SedDocument::getNumErrors () const
+SedDocument::resolveReferences()
 {
-  return mErrorLog.getNumErrors();
-}
+	// a frozen document was resolved, and its dangling references logged,
+	// by freeze()
+	if (mFrozen) return mNumDanglingReferences;
 
+	unsigned int numDangling = 0;
+	std::vector<SedError> errors;
 
-unsigned int 
-SedDocument::getNumErrors (unsigned int severity) const
-{
-  return getErrorLog()->getNumFailsWithSeverity(severity);
+	List* elements = getAllElements();
+	for (unsigned int i = 0; i < elements->getSize(); i++)
+	{
+		numDangling += checkReferences(static_cast<SedBase*>(elements->get(i)),
+		                               errors);
+	}
+	delete elements;
+
+	mErrorLog.add(errors);
+
+	return numDangling;
 }
 
 
 /*
- * @return the SedErrorLog used to log errors during while reading and
- * validating Sed.
+ * Returns the number of elements referring to id.
  */
-SedErrorLog*
-SedDocument::getErrorLog ()
+unsigned int
+SedDocument::getNumReferrers(const std::string& id) const
 {
-  return &mErrorLog;
+	// a frozen document built the index in freeze(), and is not written to
+	if (!mFrozen && !mReferrerIndexValid) rebuildReferrerIndex();
+
+	ReferrerIndex::const_iterator it = mReferrerIndex.find(id);
+	return (it == mReferrerIndex.end()) ? 0 : (unsigned int)it->second.size();
 }
 
 
 /*
- * @return the SedErrorLog used to log errors during while reading and
- * validating Sed.
+ * Returns the n-th element referring to id.
  */
-const SedErrorLog*
-SedDocument::getErrorLog () const
+SedBase*
+SedDocument::getReferrer(const std::string& id, unsigned int n) const
 {
-  return &mErrorLog;
+	if (!mFrozen && !mReferrerIndexValid) rebuildReferrerIndex();
+
+	ReferrerIndex::const_iterator it = mReferrerIndex.find(id);
+	if (it == mReferrerIndex.end() || n >= it->second.size()) return NULL;
+	return it->second[n];
 }
 
-/*
- *
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Marks the id/metaid index as stale.
+ */
+void
+SedDocument::invalidateElementIndex (bool keepReferrers)
+{
+	mElementIndexValid = false;
+	if (!keepReferrers) mReferrerIndexValid = false;
+	mElementIndexGeneration++;
+}
+
+
+/*
+ * Files element in the reverse-reference index under its references.
+ */
+void
+SedDocument::updateReferrer (SedBase* element)
+{
+	// an element the index does not hold is not in this document, or
+	// has no reference attributes
+	if (!mReferrerIndexValid
+	  || mReferencesOf.find(element) == mReferencesOf.end())
+	{
+		return;
+	}
+
+	indexReferrer(element);
+}
+
+
+/*
+ * Adds a DanglingSedReference error to errors for each reference attribute
+ * of element that is set but does not resolve.
+ */
+unsigned int
+SedDocument::checkReferences (SedBase* element, std::vector<SedError>& errors)
+{
+	unsigned int numDangling = 0;
+
+	switch (element->getTypeCode())
+	{
+	case SEDML_TASK:
+	{
+		SedTask* task = static_cast<SedTask*>(element);
+		if (task->isSetModelReference() && task->getReferencedModel() == NULL)
+		{
+			logDanglingReference(task, "modelReference", task->getModelReference(),
+			                     errors);
+			numDangling++;
+		}
+		if (task->isSetSimulationReference()
+		  && task->getReferencedSimulation() == NULL)
+		{
+			logDanglingReference(task, "simulationReference",
+			                     task->getSimulationReference(), errors);
+			numDangling++;
+		}
+		break;
+	}
+	case SEDML_VARIABLE:
+	{
+		SedVariable* var = static_cast<SedVariable*>(element);
+		if (var->isSetTaskReference() && var->getReferencedTask() == NULL)
+		{
+			logDanglingReference(var, "taskReference", var->getTaskReference(),
+			                     errors);
+			numDangling++;
+		}
+		if (var->isSetModelReference() && var->getReferencedModel() == NULL)
+		{
+			logDanglingReference(var, "modelReference", var->getModelReference(),
+			                     errors);
+			numDangling++;
+		}
+		break;
+	}
+	case SEDML_OUTPUT_SURFACE:
+	{
+		SedSurface* surface = static_cast<SedSurface*>(element);
+		if (surface->isSetZDataReference()
+		  && surface->getReferencedZDataGenerator() == NULL)
+		{
+			logDanglingReference(surface, "zDataReference",
+			                     surface->getZDataReference(), errors);
+			numDangling++;
+		}
+	}
+	// a surface has the x and y references of a curve as well
+	case SEDML_OUTPUT_CURVE:
+	{
+		SedCurve* curve = static_cast<SedCurve*>(element);
+		if (curve->isSetXDataReference()
+		  && curve->getReferencedXDataGenerator() == NULL)
+		{
+			logDanglingReference(curve, "xDataReference",
+			                     curve->getXDataReference(), errors);
+			numDangling++;
+		}
+		if (curve->isSetYDataReference()
+		  && curve->getReferencedYDataGenerator() == NULL)
+		{
+			logDanglingReference(curve, "yDataReference",
+			                     curve->getYDataReference(), errors);
+			numDangling++;
+		}
+		break;
+	}
+	case SEDML_OUTPUT_DATASET:
+	{
+		SedDataSet* dataSet = static_cast<SedDataSet*>(element);
+		if (dataSet->isSetDataReference()
+		  && dataSet->getReferencedDataGenerator() == NULL)
+		{
+			logDanglingReference(dataSet, "dataReference",
+			                     dataSet->getDataReference(), errors);
+			numDangling++;
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	return numDangling;
+}
+
+
+/*
+ * Returns the current generation of the id/metaid index.
+ */
+unsigned long
+SedDocument::getElementIndexGeneration () const
+{
+	return mElementIndexGeneration;
+}
+
+
+/*
+ * Returns the generation elements changed now are stamped with.
+ */
+unsigned long
+SedDocument::getChangeGeneration () const
+{
+	return mChangeGeneration;
+}
+
+
+/*
+ * Starts a new change generation and returns the previous one.
+ */
+unsigned long
+SedDocument::nextChangeGeneration ()
+{
+	return mChangeGeneration++;
+}
+
+
+/*
+ * Returns the arena new elements are allocated from.
+ */
+SedArena*
+SedDocument::getArena () const
+{
+	return mArena;
+}
+
+
+/*
+ * Returns the buffer of the incremental write in progress, if any.
+ */
+SedWriteCache*
+SedDocument::getWriteCache () const
+{
+	return mWriteCache;
+}
+
+
+/*
+ * Sets the buffer of the incremental write in progress.
+ */
+void
+SedDocument::setWriteCache (SedWriteCache* cache)
+{
+	mWriteCache = cache;
+}
+
+
+/*
+ * Returns the counters of the profiled read or write in progress, if any.
+ */
+SedProfileRecorder*
+SedDocument::getProfileRecorder () const
+{
+	return mProfileRecorder;
+}
+
+
+/*
+ * Sets the counters of the profiled read or write in progress.
+ */
+void
+SedDocument::setProfileRecorder (SedProfileRecorder* recorder)
+{
+	mProfileRecorder = recorder;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * @return true if both sets hold the same namespaces in the same order.
+ */
+static bool
+equalNamespaces (const XMLNamespaces* a, const XMLNamespaces* b)
+{
+	if (a == NULL || b == NULL) return (a == b);
+	if (a->getLength() != b->getLength()) return false;
+
+	for (int i = 0; i < a->getLength(); i++)
+	{
+		if (a->getURI(i) != b->getURI(i) || a->getPrefix(i) != b->getPrefix(i))
+			return false;
+	}
+
+	return true;
+}
+/** @endcond */
+
+
+/*
+ * Returns an equal interned namespace set, retained for the caller.
+ */
+SedNamespaces*
+SedDocument::getInternedSedNamespaces (unsigned int level,
+                                       unsigned int version,
+                                       const XMLNamespaces* xmlns)
+{
+	for (unsigned int i = 0; i < mInternedNamespaces.size(); i++)
+	{
+		SedNamespaces* sedns = mInternedNamespaces[i];
+
+		if (sedns->getLevel() == level && sedns->getVersion() == version
+			&& equalNamespaces(sedns->getNamespaces(), xmlns))
+		{
+			sedns->retain();
+			return sedns;
+		}
+	}
+
+	return NULL;
+}
+
+
+/*
+ * Returns true if sedns is one of the sets shared by the elements of this
+ * document.
+ */
+bool
+SedDocument::isInternedSedNamespaces (const SedNamespaces* sedns) const
+{
+	for (unsigned int i = 0; i < mInternedNamespaces.size(); i++)
+	{
+		if (mInternedNamespaces[i] == sedns) return true;
+	}
+
+	return false;
+}
+
+
+/*
+ * Makes sedns available for sharing by the elements of this document.
+ */
+void
+SedDocument::addInternedSedNamespaces (SedNamespaces* sedns)
+{
+	// documents hardly ever use more than a couple of distinct sets; past
+	// this many, elements simply keep their own copies
+	if (sedns == NULL || mInternedNamespaces.size() >= 8) return;
+
+	sedns->retain();
+	mInternedNamespaces.push_back(sedns);
+}
+
+
+/*
+ * Returns true if the default namespace of sedns was found valid for uri.
+ */
+bool
+SedDocument::isCheckedNamespace (const SedNamespaces* sedns,
+                                 const std::string& uri) const
+{
+	for (unsigned int i = 0; i < mCheckedNamespaces.size(); i++)
+	{
+		if (mCheckedNamespaces[i].first == sedns
+			&& mCheckedNamespaces[i].second == uri)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/*
+ * Records that the default namespace of sedns is valid for uri.
+ */
+void
+SedDocument::addCheckedNamespace (const SedNamespaces* sedns,
+                                  const std::string& uri)
+{
+	// interned sets are not changed while they are shared, and live as
+	// long as the document, so their pointers stay meaningful
+	for (unsigned int i = 0; i < mInternedNamespaces.size(); i++)
+	{
+		if (mInternedNamespaces[i] == sedns)
+		{
+			if (!isCheckedNamespace(sedns, uri))
+			{
+				mCheckedNamespaces.push_back(std::make_pair(sedns, uri));
+			}
+			return;
+		}
+	}
+}
+
+
+/*
+ * Adds a newly connected element (and its children) to the index.  If one
+ * of their ids is already taken, the index is rebuilt on the next lookup
+ * so that the first element in document order still wins.
+ */
+void
+SedDocument::addToElementIndex (SedBase* element)
+{
+	if (element == NULL) return;
+
+	// a new element may be the target of a previously dangling reference
+	mElementIndexGeneration++;
+
+	if (!mElementIndexValid && !mReferrerIndexValid) return;
+
+	if (mElementIndexValid && !indexElement(element))
+	{
+		mElementIndexValid = false;
+	}
+	if (mReferrerIndexValid) indexReferrer(element);
+
+	List* elements = element->getAllElements();
+	for (unsigned int i = 0; elements != NULL && i < elements->getSize(); i++)
+	{
+		SedBase* child = static_cast<SedBase*>(elements->get(i));
+		if (mElementIndexValid && !indexElement(child))
+		{
+			mElementIndexValid = false;
+		}
+		if (mReferrerIndexValid) indexReferrer(child);
+	}
+	delete elements;
+}
+
+
+/*
+ * Records the id and metaid of the given element.
+ */
+bool
+SedDocument::indexElement (SedBase* element)
+{
+	bool unique = true;
+
+	if (element->isSetId())
+	{
+		unique = mSIdIndex.insert(
+		  ElementIndex::value_type(element->getId(), element)).second;
+	}
+
+	if (element->isSetMetaId())
+	{
+		unique = mMetaIdIndex.insert(
+		  ElementIndex::value_type(element->getMetaId(), element)).second
+		  && unique;
+	}
+
+	return unique;
+}
+
+
+/*
+ * Adds a DanglingSedReference error for the given attribute to errors.
+ */
+void
+SedDocument::logDanglingReference (const SedBase* element,
+                                   const std::string& attribute,
+                                   const std::string& reference,
+                                   std::vector<SedError>& errors)
+{
+	std::string details = "The '" + attribute + "' attribute of the <"
+	  + element->getElementName() + "> element";
+	if (element->isSetId())
+	{
+		details += " with id '" + element->getId() + "'";
+	}
+	details += " refers to '" + reference + "', which does not exist.";
+
+	errors.push_back(SedError(DanglingSedReference, getLevel(), getVersion(),
+	                          details, element->getLine(), element->getColumn()));
+}
+
+
+/*
+ * Rebuilds the id/metaid index from the whole document.
+ */
+void
+SedDocument::rebuildElementIndex ()
+{
+	mSIdIndex.clear();
+	mMetaIdIndex.clear();
+
+	List* elements = getAllElements();
+	for (unsigned int i = 0; i < elements->getSize(); i++)
+	{
+		indexElement(static_cast<SedBase*>(elements->get(i)));
+	}
+	delete elements;
+
+	mElementIndexValid = true;
+}
+
+
+/*
+ * Adds the ids the reference attributes of element are set to, each once,
+ * to references, and returns false if element has no reference
+ * attributes.
+ */
+static bool
+getReferences (const SedBase* element, std::vector<std::string>& references)
+{
+	std::vector<const std::string*> ids;
+
+	switch (element->getTypeCode())
+	{
+	case SEDML_TASK:
+	{
+		const SedTask* task = static_cast<const SedTask*>(element);
+		if (task->isSetModelReference()) ids.push_back(&task->getModelReference());
+		if (task->isSetSimulationReference())
+			ids.push_back(&task->getSimulationReference());
+		break;
+	}
+	case SEDML_VARIABLE:
+	{
+		const SedVariable* var = static_cast<const SedVariable*>(element);
+		if (var->isSetTaskReference()) ids.push_back(&var->getTaskReference());
+		if (var->isSetModelReference()) ids.push_back(&var->getModelReference());
+		break;
+	}
+	case SEDML_OUTPUT_SURFACE:
+	{
+		const SedSurface* surface = static_cast<const SedSurface*>(element);
+		if (surface->isSetZDataReference())
+			ids.push_back(&surface->getZDataReference());
+	}
+	// a surface has the x and y references of a curve as well
+	case SEDML_OUTPUT_CURVE:
+	{
+		const SedCurve* curve = static_cast<const SedCurve*>(element);
+		if (curve->isSetXDataReference())
+			ids.push_back(&curve->getXDataReference());
+		if (curve->isSetYDataReference())
+			ids.push_back(&curve->getYDataReference());
+		break;
+	}
+	case SEDML_OUTPUT_DATASET:
+	{
+		const SedDataSet* dataSet = static_cast<const SedDataSet*>(element);
+		if (dataSet->isSetDataReference())
+			ids.push_back(&dataSet->getDataReference());
+		break;
+	}
+	default:
+		return false;
+	}
+
+	references.clear();
+	for (size_t i = 0; i < ids.size(); i++)
+	{
+		if (std::find(references.begin(), references.end(), *ids[i])
+		  == references.end())
+		{
+			references.push_back(*ids[i]);
+		}
+	}
+
+	return true;
+}
+
+
+/*
+ * Files element under the ids it refers to, in place of those it was
+ * filed under before.
+ */
+void
+SedDocument::indexReferrer (SedBase* element) const
+{
+	std::vector<std::string> references;
+	if (!getReferences(element, references)) return;
+
+	std::vector<std::string>& previous = mReferencesOf[element];
+	for (size_t i = 0; i < previous.size(); i++)
+	{
+		ReferrerIndex::iterator it = mReferrerIndex.find(previous[i]);
+		if (it == mReferrerIndex.end()) continue;
+
+		std::vector<SedBase*>& referrers = it->second;
+		referrers.erase(std::remove(referrers.begin(), referrers.end(), element),
+		                referrers.end());
+		if (referrers.empty()) mReferrerIndex.erase(it);
+	}
+
+	for (size_t i = 0; i < references.size(); i++)
+	{
+		mReferrerIndex[references[i]].push_back(element);
+	}
+	previous.swap(references);
+}
+
+
+/*
+ * Rebuilds the reverse-reference index from the whole document.
+ */
+void
+SedDocument::rebuildReferrerIndex () const
+{
+	mReferrerIndex.clear();
+	mReferencesOf.clear();
+
+	List* elements = const_cast<SedDocument*>(this)->getAllElements();
+	for (unsigned int i = 0; i < elements->getSize(); i++)
+	{
+		indexReferrer(static_cast<SedBase*>(elements->get(i)));
+	}
+	delete elements;
+
+	mReferrerIndexValid = true;
+}
+
+/** @endcond */
+
+
+/*
+ * Returns the libSEDML type code for this SEDML object.
+ */
+int
+SedDocument::getTypeCode () const
+{
+	return SEDML_DOCUMENT;
+}
+
+
+/*
+ * check if all the required attributes are set
+ */
+bool
+SedDocument::hasRequiredAttributes () const
+{
+	bool allPresent = true;
+
+	if (isSetLevel() == false)
+		allPresent = false;
+
+	if (isSetVersion() == false)
+		allPresent = false;
+
+	return allPresent;
+}
+
+
+/*
+ * check if all the required elements are set
+ */
+bool
+SedDocument::hasRequiredElements () const
+{
+	bool allPresent = true;
+
+	return allPresent;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * write contained elements
+ */
+void
+SedDocument::writeElements (XMLOutputStream& stream) const
+{
+	SedBase::writeElements(stream);
+	if (getNumSimulations() > 0)
+	{
+		mSimulation.write(stream);
+	}
+	if (getNumModels() > 0)
+	{
+		mModel.write(stream);
+	}
+	if (getNumTasks() > 0)
+	{
+		mTask.write(stream);
+	}
+	if (getNumDataGenerators() > 0)
+	{
+		mDataGenerator.write(stream);
+	}
+	if (getNumOutputs() > 0)
+	{
+		mOutput.write(stream);
+	}
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Shows this object to the given SedVisitor.
+ */
+bool
+SedDocument::dispatch (SedVisitor& v) const
+{
+	v.visit(*this);
+	return true;
+}
+
+
+/*
+ * Adds the element indexes and shared namespace sets of this SedDocument
+ * to the given SedMemoryVisitor.
+ */
+void
+SedDocument::addMemoryUsage (SedMemoryVisitor& v) const
+{
+	SedBase::addMemoryUsage(v);
+
+	const int type = getTypeCode();
+	const size_t nodeSize =
+	  SedMemoryVisitor::getTreeNodeSize(sizeof(ElementIndex::value_type));
+
+	ElementIndex::const_iterator it;
+	for (it = mSIdIndex.begin(); it != mSIdIndex.end(); ++it)
+	{
+		v.add(type, SED_MEMORY_CACHES, nodeSize);
+		v.addString(type, it->first, SED_MEMORY_CACHES);
+	}
+
+	for (it = mMetaIdIndex.begin(); it != mMetaIdIndex.end(); ++it)
+	{
+		v.add(type, SED_MEMORY_CACHES, nodeSize);
+		v.addString(type, it->first, SED_MEMORY_CACHES);
+	}
+
+	v.add(type, SED_MEMORY_NAMESPACES,
+	      mInternedNamespaces.capacity() * sizeof(SedNamespaces*));
+
+	v.add(type, SED_MEMORY_CACHES, mCheckedNamespaces.capacity()
+	      * sizeof(std::pair<const SedNamespaces*, std::string>));
+	for (size_t i = 0; i < mCheckedNamespaces.size(); ++i)
+	{
+		v.addString(type, mCheckedNamespaces[i].second, SED_MEMORY_CACHES);
+	}
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Sets the parent SedDocument.
+ */
+void
+SedDocument::setSedDocument (SedDocument* d)
+{
+	SedBase::setSedDocument(d);
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Get the list of expected attributes for this element.
+ */
+void
+SedDocument::addExpectedAttributes(ExpectedAttributes& attributes)
+{
+	SedBase::addExpectedAttributes(attributes);
+
+	attributes.add("level");
+	attributes.add("version");
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Read values from the given XMLAttributes set into their specific fields.
+ */
+void
+SedDocument::readAttributes (const XMLAttributes& attributes,
+                             const ExpectedAttributes& expectedAttributes)
+{
+	SedBase::readAttributes(attributes, expectedAttributes);
+
+	bool assigned = false;
+
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "level", 0x9b99e7ddu },
+		{ "version", 0x4671ae97u }
+	};
+	int index[2];
+	findAttributes(attributes, names, 2, index);
+
+	//
+	// level int   ( use = "required" )
+	//
+	mIsSetLevel = readAttribute(attributes, index[0], "level", mLevel, true);
+
+	//
+	// version int   ( use = "required" )
+	//
+	mIsSetVersion = readAttribute(attributes, index[1], "version", mVersion, true);
+
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sLevelAttribute("level");
+static const std::string sVersionAttribute("version");
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Write values of XMLAttributes to the output stream.
+ */
+	void
+SedDocument::writeAttributes (XMLOutputStream& stream) const
+{
+	SedBase::writeAttributes(stream);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetLevel() == true)
+		stream.writeAttribute(sLevelAttribute, prefix, SedNumber::toString(mLevel));
+
+	if (isSetVersion() == true)
+		stream.writeAttribute(sVersionAttribute, prefix, SedNumber::toString(mVersion));
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedDocument::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetLevel() == true)
+		addAttribute(attributes, sLevelAttribute, prefix, SedNumber::toString(mLevel));
+
+	if (isSetVersion() == true)
+		addAttribute(attributes, sVersionAttribute, prefix, SedNumber::toString(mVersion));
+
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+
+
+/*
+ * @return the nth error encountered during the parse of this
+ * SedDocument or @c NULL if n > getNumErrors() - 1.
+ */
+const SedError*
+SedDocument::getError (unsigned int n) const
+{
+  return mErrorLog.getError(n);
+}
+
+
+/*
+ * @return the number of errors encountered during the parse of this
+ * SedDocument.
+ */
+unsigned int
+SedDocument::getNumErrors () const
+{
+  return mErrorLog.getNumErrors();
+}
+
+
+unsigned int 
+SedDocument::getNumErrors (unsigned int severity) const
+{
+  return getErrorLog()->getNumFailsWithSeverity(severity);
+}
+
+
+/*
+ * @return the SedErrorLog used to log errors during while reading and
+ * validating Sed.
+ */
+SedErrorLog*
+SedDocument::getErrorLog ()
+{
+  return &mErrorLog;
+}
+
+
+/*
+ * @return the SedErrorLog used to log errors during while reading and
+ * validating Sed.
+ */
+const SedErrorLog*
+SedDocument::getErrorLog () const
+{
+  return &mErrorLog;
+}
+
+/*
+ *
  * Subclasses should override this method to write their xmlns attriubutes
  * (if any) to the XMLOutputStream.  Be sure to call your parents implementation
  * of this method as well.
@@ -1254,6 +2342,9 @@ SedDocument::writeXMLNS (XMLOutputStream& stream) const
 XMLNamespaces* 
 SedDocument::getNamespaces() const
 {
+  // the namespaces of the document may be modified through the returned
+  // object, so they must not be shared with a copy of the document
+  const_cast<SedDocument*>(this)->unshareSedNamespaces();
   return mSedNamespaces->getNamespaces();
 }/**
  * write comments
@@ -1391,6 +2482,13 @@ SedDocument_addSimulation(SedDocument_t * sd, SedSimulation_t * ss)
 	return  (sd != NULL) ? sd->addSimulation(ss) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDocument_addSimulationAndOwn(SedDocument_t * sd, SedSimulation_t * ss)
+{
+	return  (sd != NULL) ? sd->addSimulationAndOwn(ss) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedUniformTimeCourse_t *
 SedDocument_createUniformTimeCourse(SedDocument_t * sd)
@@ -1447,6 +2545,13 @@ SedDocument_addModel(SedDocument_t * sd, SedModel_t * sm)
 	return  (sd != NULL) ? sd->addModel(sm) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDocument_addModelAndOwn(SedDocument_t * sd, SedModel_t * sm)
+{
+	return  (sd != NULL) ? sd->addModelAndOwn(sm) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedModel_t *
 SedDocument_createModel(SedDocument_t * sd)
@@ -1503,6 +2608,13 @@ SedDocument_addTask(SedDocument_t * sd, SedTask_t * st)
 	return  (sd != NULL) ? sd->addTask(st) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDocument_addTaskAndOwn(SedDocument_t * sd, SedTask_t * st)
+{
+	return  (sd != NULL) ? sd->addTaskAndOwn(st) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedTask_t *
 SedDocument_createTask(SedDocument_t * sd)
@@ -1559,6 +2671,13 @@ SedDocument_addDataGenerator(SedDocument_t * sd, SedDataGenerator_t * sdg)
 	return  (sd != NULL) ? sd->addDataGenerator(sdg) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDocument_addDataGeneratorAndOwn(SedDocument_t * sd, SedDataGenerator_t * sdg)
+{
+	return  (sd != NULL) ? sd->addDataGeneratorAndOwn(sdg) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedDataGenerator_t *
 SedDocument_createDataGenerator(SedDocument_t * sd)
@@ -1615,6 +2734,13 @@ SedDocument_addOutput(SedDocument_t * sd, SedOutput_t * so)
 	return  (sd != NULL) ? sd->addOutput(so) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedDocument_addOutputAndOwn(SedDocument_t * sd, SedOutput_t * so)
+{
+	return  (sd != NULL) ? sd->addOutputAndOwn(so) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedReport_t *
 SedDocument_createReport(SedDocument_t * sd)
@@ -1700,6 +2826,171 @@ SedDocument_hasRequiredElements(SedDocument_t * sd)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_resolveReferences(SedDocument_t * sd)
+{
+	return (sd != NULL) ? sd->resolveReferences() : 0;
+}
+
+
+/**
+ * Returns the number of elements referring to id.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getNumReferrers(const SedDocument_t * sd, const char * id)
+{
+	return (sd != NULL && id != NULL) ? sd->getNumReferrers(id) : 0;
+}
+
+
+/**
+ * Returns the n-th element referring to id.
+ */
+LIBSEDML_EXTERN
+SedBase_t *
+SedDocument_getReferrer(const SedDocument_t * sd, const char * id, unsigned int n)
+{
+	return (sd != NULL && id != NULL) ? sd->getReferrer(id, n) : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setDeferNotesAndAnnotations(SedDocument_t * sd, int defer)
+{
+	return (sd != NULL) ? sd->setDeferNotesAndAnnotations(defer != 0) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_getDeferNotesAndAnnotations(SedDocument_t * sd)
+{
+	return (sd != NULL) ? static_cast<int>(sd->getDeferNotesAndAnnotations()) : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setShareNotesAndAnnotations(SedDocument_t * sd, int share)
+{
+	return (sd != NULL) ? sd->setShareNotesAndAnnotations(share != 0) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_getShareNotesAndAnnotations(SedDocument_t * sd)
+{
+	return (sd != NULL) ? static_cast<int>(sd->getShareNotesAndAnnotations()) : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setStructureOnlyDepth(SedDocument_t * sd, unsigned int depth)
+{
+	return (sd != NULL) ? sd->setStructureOnlyDepth(depth) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getStructureOnlyDepth(SedDocument_t * sd)
+{
+	return (sd != NULL) ? sd->getStructureOnlyDepth() : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setMaxXMLDepth(SedDocument_t * sd, unsigned int depth)
+{
+	return (sd != NULL) ? sd->setMaxXMLDepth(depth) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getMaxXMLDepth(SedDocument_t * sd)
+{
+	return (sd != NULL) ? sd->getMaxXMLDepth() : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_setUseArena(SedDocument_t * sd, int useArena)
+{
+	return (sd != NULL) ? sd->setUseArena(useArena != 0) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_getUseArena(SedDocument_t * sd)
+{
+	return (sd != NULL) ? static_cast<int>(sd->getUseArena()) : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_freeze(SedDocument_t * sd)
+{
+	return (sd != NULL) ? sd->freeze() : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_isFrozen(const SedDocument_t * sd)
+{
+	return (sd != NULL) ? static_cast<int>(sd->isFrozen()) : 0;
+}
+
+
 
 
 LIBSEDML_CPP_NAMESPACE_END
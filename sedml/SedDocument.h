@@ -45,11 +45,14 @@
 
 
 #include <string>
+#include <map>
+#include <vector>
 
 
 #include <sedml/SedBase.h>
 #include <sedml/SedListOf.h>
 #include <sedml/SedNamespaces.h>
+#include <sedml/SedMemoryUsage.h>
 
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
@@ -68,15 +71,60 @@ class LIBSEDML_EXTERN SedDocument : public SedBase
 protected:
 
 	int           mLevel;
-	bool          mIsSetLevel;
 	int           mVersion;
-	bool          mIsSetVersion;
+	bool          mIsSetLevel : 1;
+	bool          mIsSetVersion : 1;
 	SedListOfSimulations   mSimulation;
 	SedListOfModels   mModel;
 	SedListOfTasks   mTask;
 	SedListOfDataGenerators   mDataGenerator;
 	SedListOfOutputs   mOutput;
 
+	typedef std::map<std::string, SedBase*> ElementIndex;
+
+	ElementIndex  mSIdIndex;
+	ElementIndex  mMetaIdIndex;
+	bool          mElementIndexValid;
+	unsigned long mElementIndexGeneration;
+
+	typedef std::map<std::string, std::vector<SedBase*> > ReferrerIndex;
+	typedef std::map<const SedBase*, std::vector<std::string> > ReferenceList;
+
+	mutable ReferrerIndex mReferrerIndex;
+	mutable ReferenceList mReferencesOf;
+	mutable bool          mReferrerIndexValid;
+
+	/* what SedBase::markDirty() stamps the elements it marks with, moved
+	 * on by nextChangeGeneration() */
+	unsigned long mChangeGeneration;
+
+	bool          mDeferNotesAndAnnotations;
+	bool          mShareNotesAndAnnotations;
+	unsigned int  mStructureOnlyDepth;
+	unsigned int  mMaxXMLDepth;
+
+	SedArena*     mArena;
+
+	/* set while SedWriter writes this document incrementally */
+	SedWriteCache* mWriteCache;
+
+	/* set while a SedReader or SedWriter given a SedProfiler reads or
+	 * writes this document */
+	SedProfileRecorder* mProfileRecorder;
+
+	/* set by freeze(), with the result of resolveReferences() then */
+	bool          mFrozen;
+	unsigned int  mNumDanglingReferences;
+
+	/* namespace sets shared by the elements of this document; each entry
+	 * holds one reference */
+	std::vector<SedNamespaces*> mInternedNamespaces;
+
+	/* interned namespace sets whose default namespace SedBase::read found
+	 * valid, with the element URI they were checked for */
+	std::vector<std::pair<const SedNamespaces*, std::string> >
+	  mCheckedNamespaces;
+
 
 public:
 
@@ -307,6 +355,25 @@ public:
 	int addSimulation(const SedSimulation* ss);
 
 
+	/**
+	 * Adds the given "SedSimulation" to this SedDocument without copying it; this
+	 * SedDocument takes ownership of @p ss and will delete it.
+	 *
+	 * @param ss the SedSimulation object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p ss is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addSimulation(const SedSimulation* ss)
+	 */
+	int addSimulationAndOwn(SedSimulation* ss);
+
+
 	/**
 	 * Get the number of SedSimulation objects in this SedDocument.
 	 *
@@ -438,6 +505,25 @@ public:
 	int addModel(const SedModel* sm);
 
 
+	/**
+	 * Adds the given "SedModel" to this SedDocument without copying it; this
+	 * SedDocument takes ownership of @p sm and will delete it.
+	 *
+	 * @param sm the SedModel object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sm is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addModel(const SedModel* sm)
+	 */
+	int addModelAndOwn(SedModel* sm);
+
+
 	/**
 	 * Get the number of SedModel objects in this SedDocument.
 	 *
@@ -569,6 +655,25 @@ public:
 	int addTask(const SedTask* st);
 
 
+	/**
+	 * Adds the given "SedTask" to this SedDocument without copying it; this
+	 * SedDocument takes ownership of @p st and will delete it.
+	 *
+	 * @param st the SedTask object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p st is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addTask(const SedTask* st)
+	 */
+	int addTaskAndOwn(SedTask* st);
+
+
 	/**
 	 * Get the number of SedTask objects in this SedDocument.
 	 *
@@ -700,6 +805,25 @@ public:
 	int addDataGenerator(const SedDataGenerator* sdg);
 
 
+	/**
+	 * Adds the given "SedDataGenerator" to this SedDocument without copying it; this
+	 * SedDocument takes ownership of @p sdg and will delete it.
+	 *
+	 * @param sdg the SedDataGenerator object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sdg is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addDataGenerator(const SedDataGenerator* sdg)
+	 */
+	int addDataGeneratorAndOwn(SedDataGenerator* sdg);
+
+
 	/**
 	 * Get the number of SedDataGenerator objects in this SedDocument.
 	 *
@@ -831,6 +955,25 @@ public:
 	int addOutput(const SedOutput* so);
 
 
+	/**
+	 * Adds the given "SedOutput" to this SedDocument without copying it; this
+	 * SedDocument takes ownership of @p so and will delete it.
+	 *
+	 * @param so the SedOutput object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p so is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addOutput(const SedOutput* so)
+	 */
+	int addOutputAndOwn(SedOutput* so);
+
+
 	/**
 	 * Get the number of SedOutput objects in this SedDocument.
 	 *
@@ -901,6 +1044,337 @@ public:
 	SedOutput* removeOutput(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedDocument.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedDocument.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
+	/**
+	 * Returns the first element in this SedDocument with the given @p id,
+	 * or @c NULL if no such element exists.
+	 *
+	 * The lookup goes through an index of every id in the document, which
+	 * is built on first use and kept up to date as elements are added,
+	 * removed or renamed.
+	 *
+	 * @param id string representing the id of the element to find.
+	 *
+	 * @return pointer to the first element found with the given @p id.
+	 */
+	virtual SedBase* getElementBySId(std::string id);
+
+
+	/**
+	 * Returns the first element in this SedDocument with the given
+	 * @p metaid, or @c NULL if no such element exists.
+	 *
+	 * @param metaid string representing the metaid of the element to find.
+	 *
+	 * @return pointer to the first element found with the given @p metaid.
+	 *
+	 * @see getElementBySId(std::string id)
+	 */
+	virtual SedBase* getElementByMetaId(std::string metaid);
+
+
+	/**
+	 * Resolves every reference attribute in this SedDocument in one pass.
+	 *
+	 * This fills the cached links returned by SedTask::getReferencedModel(),
+	 * SedTask::getReferencedSimulation(), SedVariable::getReferencedTask(),
+	 * SedVariable::getReferencedModel(), SedCurve::getReferencedXDataGenerator(),
+	 * SedCurve::getReferencedYDataGenerator(),
+	 * SedSurface::getReferencedZDataGenerator() and
+	 * SedDataSet::getReferencedDataGenerator(), and logs a
+	 * @c DanglingSedReference error for each reference that is set but does
+	 * not resolve.
+	 *
+	 * @return the number of dangling references found.
+	 */
+	unsigned int resolveReferences();
+
+
+	/**
+	 * Returns the number of elements in this SedDocument with a reference
+	 * attribute set to @p id: the @c modelReference and
+	 * @c simulationReference of a SedTask, the @c taskReference and
+	 * @c modelReference of a SedVariable, the data references of a
+	 * SedCurve or SedSurface, and the @c dataReference of a SedDataSet.
+	 *
+	 * The elements are looked up in a reverse-reference index, which is
+	 * built on first use and then kept up to date by the setters of these
+	 * attributes and as elements are added.  Removing elements has it
+	 * rebuilt by the next lookup.  Renaming a SedDataGenerator or SedTask
+	 * and updating its referrers thus costs time in the number of
+	 * referrers, not in the size of the document.  freeze() builds the
+	 * index, so that a frozen document is only read by lookups from any
+	 * number of threads.
+	 *
+	 * @param id the id referred to.
+	 *
+	 * @return the number of elements referring to @p id, each counted
+	 * once even if several of its attributes do.
+	 */
+	unsigned int getNumReferrers(const std::string& id) const;
+
+
+	/**
+	 * Returns the n-th element in this SedDocument with a reference
+	 * attribute set to @p id, in the order they were indexed, or @c NULL
+	 * if @p n is out of range.
+	 *
+	 * @param id the id referred to.
+	 * @param n the index of the referrer, counted from 0.
+	 *
+	 * @see getNumReferrers(const std::string& id)
+	 */
+	SedBase* getReferrer(const std::string& id, unsigned int n) const;
+
+
+	/**
+	 * Sets whether notes and annotations read into this SedDocument are
+	 * kept as raw XML and only parsed into XMLNode trees the first time
+	 * they are asked for (through getNotes(), getAnnotation() and
+	 * friends), rather than while reading.
+	 *
+	 * Deferring saves the time and memory of building XMLNode trees for
+	 * notes and annotations that are never looked at.  The checks done on
+	 * their content are deferred along with them.
+	 *
+	 * @param defer @c true to defer parsing, @c false to parse eagerly.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a frozen document, LIBSEDML_OPERATION_FAILED.
+	 *
+	 * @see SedReader::setDeferNotesAndAnnotations(bool defer)
+	 */
+	int setDeferNotesAndAnnotations(bool defer);
+
+
+	/**
+	 * Returns whether notes and annotations read into this SedDocument are
+	 * only parsed when first accessed.
+	 *
+	 * @return @c true if parsing is deferred, @c false otherwise.
+	 */
+	bool getDeferNotesAndAnnotations() const;
+
+
+	/**
+	 * Sets whether copies of the objects of this SedDocument, including
+	 * clone() of the whole document, share their notes and annotations
+	 * with the original instead of copying them.
+	 *
+	 * A shared XMLNode is copied only when the original or a copy first
+	 * changes it, or asks for it through getNotes(), getAnnotation() and
+	 * friends, which return modifiable nodes; writing a document out does
+	 * not copy it.  Cloning a template document for each point of a
+	 * parameter sweep and changing a few attributes thus costs memory for
+	 * the attributes, not for the notes and annotations.  Copies inherit
+	 * the setting.
+	 *
+	 * The counts of the shared nodes, and of the SedNamespaces copies
+	 * share in any case, are guarded by mutexes: once made, the copies of
+	 * a template may be changed and destroyed on different threads.  The
+	 * copies themselves are to be made on one thread, as copying an
+	 * object first moves its own nodes into shared ones.
+	 *
+	 * @param share @c true to share, @c false to copy eagerly.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a frozen document, LIBSEDML_OPERATION_FAILED.
+	 */
+	int setShareNotesAndAnnotations(bool share);
+
+
+	/**
+	 * Returns whether copies of the objects of this SedDocument share
+	 * their notes and annotations until they are modified.
+	 *
+	 * @return @c true if they are shared, @c false otherwise.
+	 */
+	bool getShareNotesAndAnnotations() const;
+
+
+	/**
+	 * Sets whether only the structure of documents read into this
+	 * SedDocument is read, for a quick check that a document is well-formed
+	 * SED-ML rather than a full parse.
+	 *
+	 * With a depth of @em n, MathML, notes and annotations are skipped,
+	 * and so are all elements nested more than @em n levels below the
+	 * sedML element: a depth of 1 reads the attributes of the document and
+	 * which of its top-level lists are present, and a depth of 2 also the
+	 * attributes of the elements of those lists.  The required attributes
+	 * of the elements read are checked, and the required elements of those
+	 * whose children are read.
+	 *
+	 * @param depth the number of levels to read, or 0 to read everything,
+	 * which is the default.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a frozen document, LIBSEDML_OPERATION_FAILED.
+	 *
+	 * @see SedReader::setStructureOnlyDepth(unsigned int depth)
+	 */
+	int setStructureOnlyDepth(unsigned int depth);
+
+
+	/**
+	 * Returns the number of levels read of documents read into this
+	 * SedDocument, or 0 if they are read in full.
+	 */
+	unsigned int getStructureOnlyDepth() const;
+
+
+	/**
+	 * Sets how many levels of elements the notes and annotations of
+	 * documents read into this SedDocument may nest.  Deeper notes and
+	 * annotations are skipped, with an XMLNestedTooDeeply error in the
+	 * log, so that hostile input does not exhaust the stack.
+	 *
+	 * @param depth the number of levels allowed, counting the notes or
+	 * annotation element as one, or 0 for no limit; the default is
+	 * SedXMLTree::DEFAULT_MAX_DEPTH.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a frozen document, LIBSEDML_OPERATION_FAILED.
+	 *
+	 * @see SedReader::setMaxXMLDepth(unsigned int depth)
+	 */
+	int setMaxXMLDepth(unsigned int depth);
+
+
+	/**
+	 * Returns the number of levels the notes and annotations of documents
+	 * read into this SedDocument may nest, or 0 for no limit.
+	 */
+	unsigned int getMaxXMLDepth() const;
+
+
+	/**
+	 * Sets whether the elements subsequently created in or read into this
+	 * SedDocument are allocated from a memory arena owned by the document.
+	 *
+	 * With an arena, the objects of a document come from a few large
+	 * chunks instead of one heap allocation each, and the chunks are freed
+	 * all at once when the document and every object removed from it have
+	 * been deleted.  Elements that already exist are not moved.
+	 *
+	 * @param useArena @c true to allocate new elements from an arena,
+	 * @c false to go back to the heap.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a frozen document, LIBSEDML_OPERATION_FAILED.
+	 *
+	 * @see SedReader::setUseArena(bool useArena)
+	 */
+	int setUseArena(bool useArena);
+
+
+	/**
+	 * Returns whether new elements of this SedDocument are allocated from
+	 * an arena.
+	 *
+	 * @return @c true if an arena is used, @c false otherwise.
+	 */
+	bool getUseArena() const;
+
+
+	/**
+	 * Estimates the memory this SedDocument and its elements take, by type
+	 * code and by category: the objects themselves, their strings, notes,
+	 * annotations, math and namespaces, and the indexes and XML kept to
+	 * speed up lookups and writes.
+	 *
+	 * Ids, math and namespaces shared between elements are counted once;
+	 * SedMemoryUsage::getSharedBytes() tells how much copies of them would
+	 * have taken.
+	 *
+	 * @return the estimate, which SedMemoryVisitor can also give for any
+	 * part of the document.
+	 */
+	SedMemoryUsage getMemoryUsage() const;
+
+
+	/**
+	 * Freezes this SedDocument, making it read-only so that any number of
+	 * threads can read it at once without locks.
+	 *
+	 * The const methods of a SedDocument and its elements look like reads,
+	 * but some compute and keep things on first use: the indexes behind
+	 * getElementBySId() and SedListOf::get(const std::string&), the links
+	 * behind SedTask::getReferencedModel() and the like, and deferred
+	 * notes and annotations (see setDeferNotesAndAnnotations()).  freeze()
+	 * does all of that now, resolving the references (as
+	 * resolveReferences(), logging the dangling ones) and parsing what
+	 * was deferred, and gives back the room kept for growth and for
+	 * incremental writes.  From then on:
+	 *
+	 * @li every const method of the document and its elements, and the
+	 * getters returning non-const elements, only read, and may be called
+	 * from any number of threads at once;
+	 * @li the setters, add, create and remove methods of the document and
+	 * its elements change nothing, and return
+	 * @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED@endlink
+	 * or @c NULL, as do SedDocumentPatch::apply() and the setters of this
+	 * class;
+	 * @li a SedWriter writes the document without keeping XML in it
+	 * (see SedWriter::setIncremental()), so several can write it at once;
+	 * @li copies, made with clone() or copy constructors, are not frozen,
+	 * and are the way to get a document to change.
+	 *
+	 * A document cannot be thawed.  The XMLNode objects returned by
+	 * getNotes() and getAnnotation(), and the error log, are not guarded,
+	 * and must not be changed once readers run; neither may the document
+	 * be assigned to or deleted while they do.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  The possible values are LIBSEDML_OPERATION_SUCCESS and,
+	 * for a document that a SedReader or SedWriter is using at the time,
+	 * LIBSEDML_OPERATION_FAILED.
+	 *
+	 * @see isFrozen()
+	 */
+	int freeze();
+
+
+	/**
+	 * Predicate returning @c true if freeze() was called on this
+	 * SedDocument.
+	 *
+	 * @return @c true if this document is read-only.
+	 */
+	bool isFrozen() const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedDocument, is
 	 * always @c "sedDocument".
@@ -985,9 +1459,16 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
+	 */
+	virtual bool dispatch (SedVisitor& v) const;
+
+
+	/**
+	 * Adds the element indexes and shared namespace sets of this
+	 * SedDocument to the given SedMemoryVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual void addMemoryUsage (SedMemoryVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -1015,6 +1496,144 @@ public:
 /** @endcond doxygen-libsbml-internal */
 
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Marks the id/metaid index of this SedDocument as stale, so that it is
+	 * rebuilt by the next lookup, and unless @p keepReferrers is @c true
+	 * the reverse-reference index as well.  Renaming an element leaves the
+	 * latter valid, as it is keyed by the ids referred to.
+	 */
+	void invalidateElementIndex (bool keepReferrers = false);
+
+
+	/**
+	 * Files @p element in the reverse-reference index under the ids its
+	 * reference attributes are now set to, if the index is built and
+	 * holds the element.  Setters of reference attributes call this.
+	 */
+	void updateReferrer (SedBase* element);
+
+
+	/**
+	 * Adds to @p errors a @c DanglingSedReference error for each reference
+	 * attribute of @p element that is set but does not resolve, as
+	 * resolveReferences() logs them for the whole document.
+	 *
+	 * @return the number of dangling references of @p element.
+	 */
+	unsigned int checkReferences (SedBase* element,
+	                              std::vector<SedError>& errors);
+
+
+	/**
+	 * Adds @p element and everything below it to the id/metaid index, if
+	 * the index is currently built.
+	 */
+	void addToElementIndex (SedBase* element);
+
+
+	/**
+	 * Returns a counter that changes whenever elements are added to,
+	 * removed from or renamed in this SedDocument.  Cached reference links
+	 * are only valid for the generation they were resolved in.
+	 */
+	unsigned long getElementIndexGeneration () const;
+
+
+	/**
+	 * Returns the generation that elements of this SedDocument changed now
+	 * are stamped with (see SedBase::getChangeStamp()).
+	 */
+	unsigned long getChangeGeneration () const;
+
+
+	/**
+	 * Starts a new change generation, and returns the one before it: an
+	 * element stamped with a later generation has changed since.
+	 */
+	unsigned long nextChangeGeneration ();
+
+
+	/**
+	 * Returns the arena new elements of this SedDocument are allocated
+	 * from, or @c NULL.
+	 */
+	SedArena* getArena () const;
+
+
+	/**
+	 * Returns the buffer of the incremental SedWriter call writing this
+	 * SedDocument, or @c NULL if none is.
+	 */
+	SedWriteCache* getWriteCache () const;
+
+
+	/**
+	 * Sets the buffer of the incremental SedWriter call writing this
+	 * SedDocument, or @c NULL once it is done.
+	 */
+	void setWriteCache (SedWriteCache* cache);
+
+
+	/**
+	 * Returns the counters of the profiled SedReader or SedWriter call
+	 * reading or writing this SedDocument, or @c NULL if none is.
+	 */
+	SedProfileRecorder* getProfileRecorder () const;
+
+
+	/**
+	 * Sets the counters of the profiled SedReader or SedWriter call
+	 * reading or writing this SedDocument, or @c NULL once it is done.
+	 */
+	void setProfileRecorder (SedProfileRecorder* recorder);
+
+
+	/**
+	 * Returns a namespace set of this document equal to the given level,
+	 * version and namespaces, with a reference taken for the caller, or
+	 * @c NULL if there is none.
+	 */
+	SedNamespaces* getInternedSedNamespaces (unsigned int level,
+	                                         unsigned int version,
+	                                         const XMLNamespaces* xmlns);
+
+
+	/**
+	 * Makes @p sedns available for sharing by the elements of this
+	 * document.
+	 */
+	void addInternedSedNamespaces (SedNamespaces* sedns);
+
+
+	/**
+	 * Returns @c true if @p sedns is one of the namespace sets shared by
+	 * the elements of this document.
+	 */
+	bool isInternedSedNamespaces (const SedNamespaces* sedns) const;
+
+
+	/**
+	 * Returns @c true if the default namespace of @p sedns, a set this
+	 * document interns, was found valid for elements of @p uri.
+	 */
+	bool isCheckedNamespace (const SedNamespaces* sedns,
+	                         const std::string& uri) const;
+
+
+	/**
+	 * Records that the default namespace of @p sedns is valid for
+	 * elements of @p uri, if @p sedns is interned by this document; other
+	 * sets may change or go, and are checked every time.
+	 */
+	void addCheckedNamespace (const SedNamespaces* sedns,
+	                          const std::string& uri);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 protected:
 
 /** @cond doxygen-libsbml-internal */
@@ -1059,6 +1678,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -1146,6 +1772,23 @@ protected:
   virtual void writeXMLNS (XMLOutputStream& stream) const;  
 private: 
 
+	/**
+	 * Records the id and metaid of @p element, keeping any entry already
+	 * present.  Returns @c false if either was already in the index.
+	 */
+	bool indexElement (SedBase* element);
+
+	void rebuildElementIndex ();
+
+	void indexReferrer (SedBase* element) const;
+
+	void rebuildReferrerIndex () const;
+
+	void logDanglingReference (const SedBase* element,
+	                           const std::string& attribute,
+	                           const std::string& reference,
+	                           std::vector<SedError>& errors);
+
 	SedErrorLog mErrorLog;
 
 };
@@ -1221,6 +1864,11 @@ int
 SedDocument_addSimulation(SedDocument_t * sd, SedSimulation_t * ss);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_addSimulationAndOwn(SedDocument_t * sd, SedSimulation_t * ss);
+
+
 LIBSEDML_EXTERN
 SedUniformTimeCourse_t *
 SedDocument_createUniformTimeCourse(SedDocument_t * sd);
@@ -1261,6 +1909,11 @@ int
 SedDocument_addModel(SedDocument_t * sd, SedModel_t * sm);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_addModelAndOwn(SedDocument_t * sd, SedModel_t * sm);
+
+
 LIBSEDML_EXTERN
 SedModel_t *
 SedDocument_createModel(SedDocument_t * sd);
@@ -1301,6 +1954,11 @@ int
 SedDocument_addTask(SedDocument_t * sd, SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_addTaskAndOwn(SedDocument_t * sd, SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 SedTask_t *
 SedDocument_createTask(SedDocument_t * sd);
@@ -1341,6 +1999,11 @@ int
 SedDocument_addDataGenerator(SedDocument_t * sd, SedDataGenerator_t * sdg);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_addDataGeneratorAndOwn(SedDocument_t * sd, SedDataGenerator_t * sdg);
+
+
 LIBSEDML_EXTERN
 SedDataGenerator_t *
 SedDocument_createDataGenerator(SedDocument_t * sd);
@@ -1381,6 +2044,11 @@ int
 SedDocument_addOutput(SedDocument_t * sd, SedOutput_t * so);
 
 
+LIBSEDML_EXTERN
+int
+SedDocument_addOutputAndOwn(SedDocument_t * sd, SedOutput_t * so);
+
+
 LIBSEDML_EXTERN
 SedReport_t *
 SedDocument_createReport(SedDocument_t * sd);
@@ -1436,6 +2104,81 @@ int
 SedDocument_hasRequiredElements(SedDocument_t * sd);
 
 
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_resolveReferences(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getNumReferrers(const SedDocument_t * sd, const char * id);
+
+
+LIBSEDML_EXTERN
+SedBase_t *
+SedDocument_getReferrer(const SedDocument_t * sd, const char * id, unsigned int n);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setDeferNotesAndAnnotations(SedDocument_t * sd, int defer);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_getDeferNotesAndAnnotations(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setShareNotesAndAnnotations(SedDocument_t * sd, int share);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_getShareNotesAndAnnotations(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setStructureOnlyDepth(SedDocument_t * sd, unsigned int depth);
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getStructureOnlyDepth(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setMaxXMLDepth(SedDocument_t * sd, unsigned int depth);
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedDocument_getMaxXMLDepth(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_setUseArena(SedDocument_t * sd, int useArena);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_getUseArena(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_freeze(SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_isFrozen(const SedDocument_t * sd);
+
+
 
 
 END_C_DECLS
@@ -0,0 +1,551 @@
+/**
+ * @file    SedDocumentMerger.cpp
+ * @brief   Merges many SED-ML documents into one
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedDocumentMerger.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedTypeCodes.h>
+
+#include <sbml/util/util.h>
+
+#include <new>
+#include <sstream>
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Predicate taking every item out of a SedListOf.
+ */
+static int
+takeAll (const SedBase_t*, void*)
+{
+  return 1;
+}
+
+
+/*
+ * Takes the items out of list, without deleting them, and returns them in
+ * their order.
+ */
+static void
+takeItems (const SedListOf* list, std::vector<SedBase*>& items)
+{
+  SedListOf* mutableList = const_cast<SedListOf*>(list);
+
+  items.clear();
+  items.reserve(mutableList->size());
+  for (unsigned int i = 0; i < mutableList->size(); i++)
+  {
+    items.push_back(mutableList->get(i));
+  }
+  mutableList->removeIf(takeAll, NULL, false);
+}
+
+
+/*
+ * Points the reference attributes of element that name oldId at newId.
+ */
+static void
+renameReferences (SedBase* element, const std::string& oldId,
+                  const std::string& newId)
+{
+  switch (element->getTypeCode())
+  {
+  case SEDML_TASK:
+  {
+    SedTask* task = static_cast<SedTask*>(element);
+    if (task->getModelReference() == oldId) task->setModelReference(newId);
+    if (task->getSimulationReference() == oldId)
+      task->setSimulationReference(newId);
+    break;
+  }
+  case SEDML_VARIABLE:
+  {
+    SedVariable* var = static_cast<SedVariable*>(element);
+    if (var->getTaskReference() == oldId) var->setTaskReference(newId);
+    if (var->getModelReference() == oldId) var->setModelReference(newId);
+    break;
+  }
+  case SEDML_OUTPUT_SURFACE:
+  {
+    SedSurface* surface = static_cast<SedSurface*>(element);
+    if (surface->getZDataReference() == oldId)
+      surface->setZDataReference(newId);
+  }
+  // a surface has the x and y references of a curve as well
+  case SEDML_OUTPUT_CURVE:
+  {
+    SedCurve* curve = static_cast<SedCurve*>(element);
+    if (curve->getXDataReference() == oldId) curve->setXDataReference(newId);
+    if (curve->getYDataReference() == oldId) curve->setYDataReference(newId);
+    break;
+  }
+  case SEDML_OUTPUT_DATASET:
+  {
+    SedDataSet* dataSet = static_cast<SedDataSet*>(element);
+    if (dataSet->getDataReference() == oldId) dataSet->setDataReference(newId);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Returns the data generator or compute change whose math may refer to
+ * the variable or parameter element, or NULL.
+ */
+static SedBase*
+getMathOwner (SedBase* element)
+{
+  const int type = element->getTypeCode();
+  if (type != SEDML_VARIABLE && type != SEDML_PARAMETER) return NULL;
+
+  SedBase* list = element->getParentSedObject();
+  if (list == NULL) return NULL;
+
+  SedBase* owner = list->getParentSedObject();
+  if (owner == NULL) return NULL;
+
+  switch (owner->getTypeCode())
+  {
+  case SEDML_DATAGENERATOR:
+  case SEDML_CHANGE_COMPUTECHANGE:
+    return owner;
+  default:
+    return NULL;
+  }
+}
+
+
+/*
+ * Renames the identifiers in the math of owner.  The math is shared
+ * through SedMathCache, so a renamed copy replaces it.
+ */
+static void
+renameMath (SedBase* owner,
+            const std::vector<std::pair<std::string, std::string> >& renames)
+{
+  const ASTNode* math = (owner->getTypeCode() == SEDML_DATAGENERATOR)
+                      ? static_cast<SedDataGenerator*>(owner)->getMath()
+                      : static_cast<SedComputeChange*>(owner)->getMath();
+  if (math == NULL) return;
+
+  ASTNode* renamed = math->deepCopy();
+  for (size_t i = 0; i < renames.size(); i++)
+  {
+    renamed->renameSIdRefs(renames[i].first, renames[i].second);
+  }
+
+  if (owner->getTypeCode() == SEDML_DATAGENERATOR)
+  {
+    static_cast<SedDataGenerator*>(owner)->setMath(renamed);
+  }
+  else
+  {
+    static_cast<SedComputeChange*>(owner)->setMath(renamed);
+  }
+  delete renamed;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedDocumentMerger moving elements into target.
+ */
+SedDocumentMerger::SedDocumentMerger (SedDocument* target)
+  : mTarget (target)
+  , mCollected (false)
+{
+}
+
+
+/*
+ * Destroys this SedDocumentMerger.
+ */
+SedDocumentMerger::~SedDocumentMerger ()
+{
+}
+
+
+/*
+ * Returns the document elements are moved into.
+ */
+SedDocument*
+SedDocumentMerger::getTarget () const
+{
+  return mTarget;
+}
+
+
+/*
+ * Moves the content of source into the target.
+ */
+int
+SedDocumentMerger::merge (SedDocument* source)
+{
+  if (mTarget == NULL || source == NULL || source == mTarget)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  if (source->getLevel() != mTarget->getLevel())
+  {
+    return LIBSEDML_LEVEL_MISMATCH;
+  }
+  if (source->getVersion() != mTarget->getVersion())
+  {
+    return LIBSEDML_VERSION_MISMATCH;
+  }
+  if (source->isFrozen() || mTarget->isFrozen())
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  if (!mCollected) collectTargetIds();
+  mRenamed.clear();
+
+  // the ids of the source are collected first, so that no id is renamed
+  // to one still to come
+  std::vector<SedBase*> elements;
+  std::set<std::string> sourceIds;
+  std::set<std::string> sourceMetaIds;
+  std::map<std::string, std::vector<SedModel*> > derived;
+
+  List* all = source->getAllElements();
+  elements.reserve(all->getSize());
+  for (unsigned int i = 0; i < all->getSize(); i++)
+  {
+    SedBase* element = static_cast<SedBase*>(all->get(i));
+    elements.push_back(element);
+    if (element->isSetId()) sourceIds.insert(element->getId());
+    if (element->isSetMetaId()) sourceMetaIds.insert(element->getMetaId());
+
+    if (element->getTypeCode() == SEDML_MODEL)
+    {
+      SedModel* model = static_cast<SedModel*>(element);
+      const std::string& from = model->getSource();
+      if (!from.empty())
+      {
+        derived[(from[0] == '#') ? from.substr(1) : from].push_back(model);
+      }
+    }
+  }
+  delete all;
+
+  std::vector<SedBase*> renamedElements;
+  std::vector<std::pair<SedBase*, std::string> > renamedMetaIds;
+
+  for (size_t i = 0; i < elements.size(); i++)
+  {
+    SedBase* element = elements[i];
+
+    if (element->isSetId())
+    {
+      const std::string& id = element->getId();
+      if (mIds.find(id) == mIds.end())
+      {
+        mIds.insert(id);
+      }
+      else
+      {
+        const std::string newId = getFreeId(id, mIds, sourceIds);
+        mIds.insert(newId);
+        mRenamed[id] = newId;
+        renamedElements.push_back(element);
+      }
+    }
+
+    if (element->isSetMetaId())
+    {
+      const std::string& metaid = element->getMetaId();
+      if (mMetaIds.find(metaid) == mMetaIds.end())
+      {
+        mMetaIds.insert(metaid);
+      }
+      else
+      {
+        const std::string newMetaId =
+          getFreeId(metaid, mMetaIds, sourceMetaIds);
+        mMetaIds.insert(newMetaId);
+        renamedMetaIds.push_back(std::make_pair(element, newMetaId));
+      }
+    }
+  }
+
+  // the referrers of each renamed id are found through the
+  // reverse-reference index of the source, and the math of data
+  // generators and compute changes renamed once for all their variables
+  // and parameters
+  typedef std::vector<std::pair<std::string, std::string> > RenameList;
+  std::map<SedBase*, RenameList> mathRenames;
+
+  for (size_t i = 0; i < renamedElements.size(); i++)
+  {
+    SedBase* element = renamedElements[i];
+    const std::string oldId = element->getId();
+    const std::string& newId = mRenamed[oldId];
+
+    std::vector<SedBase*> referrers;
+    const unsigned int numReferrers = source->getNumReferrers(oldId);
+    for (unsigned int n = 0; n < numReferrers; n++)
+    {
+      referrers.push_back(source->getReferrer(oldId, n));
+    }
+
+    element->setId(newId);
+    for (size_t n = 0; n < referrers.size(); n++)
+    {
+      renameReferences(referrers[n], oldId, newId);
+    }
+
+    if (element->getTypeCode() == SEDML_MODEL)
+    {
+      std::map<std::string, std::vector<SedModel*> >::iterator it =
+        derived.find(oldId);
+      if (it != derived.end())
+      {
+        for (size_t n = 0; n < it->second.size(); n++)
+        {
+          SedModel* model = it->second[n];
+          model->setSource((model->getSource()[0] == '#') ? "#" + newId : newId);
+        }
+      }
+    }
+
+    SedBase* owner = getMathOwner(element);
+    if (owner != NULL)
+    {
+      mathRenames[owner].push_back(std::make_pair(oldId, newId));
+    }
+  }
+
+  std::map<SedBase*, RenameList>::const_iterator m;
+  for (m = mathRenames.begin(); m != mathRenames.end(); ++m)
+  {
+    renameMath(m->first, m->second);
+  }
+
+  for (size_t i = 0; i < renamedMetaIds.size(); i++)
+  {
+    renamedMetaIds[i].first->setMetaId(renamedMetaIds[i].second);
+  }
+
+  // the top-level elements are taken out of the source in one pass per
+  // list and handed to the target as they are
+  std::vector<SedBase*> items;
+
+  takeItems(source->getListOfSimulations(), items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    mTarget->addSimulationAndOwn(static_cast<SedSimulation*>(items[i]));
+  }
+
+  takeItems(source->getListOfModels(), items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    mTarget->addModelAndOwn(static_cast<SedModel*>(items[i]));
+  }
+
+  takeItems(source->getListOfTasks(), items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    mTarget->addTaskAndOwn(static_cast<SedTask*>(items[i]));
+  }
+
+  takeItems(source->getListOfDataGenerators(), items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    mTarget->addDataGeneratorAndOwn(static_cast<SedDataGenerator*>(items[i]));
+  }
+
+  takeItems(source->getListOfOutputs(), items);
+  for (size_t i = 0; i < items.size(); i++)
+  {
+    mTarget->addOutputAndOwn(static_cast<SedOutput*>(items[i]));
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of ids renamed by the last merge().
+ */
+unsigned int
+SedDocumentMerger::getNumRenamed () const
+{
+  return (unsigned int)mRenamed.size();
+}
+
+
+/*
+ * Returns the id id was renamed to by the last merge().
+ */
+std::string
+SedDocumentMerger::getRenamedId (const std::string& id) const
+{
+  RenameMap::const_iterator it = mRenamed.find(id);
+  return (it != mRenamed.end()) ? it->second : id;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Collects the ids and metaids in use in the target.
+ */
+void
+SedDocumentMerger::collectTargetIds ()
+{
+  mIds.clear();
+  mMetaIds.clear();
+  mNextSuffix.clear();
+
+  if (mTarget->isSetId()) mIds.insert(mTarget->getId());
+  if (mTarget->isSetMetaId()) mMetaIds.insert(mTarget->getMetaId());
+
+  List* all = mTarget->getAllElements();
+  for (unsigned int i = 0; i < all->getSize(); i++)
+  {
+    const SedBase* element = static_cast<const SedBase*>(all->get(i));
+    if (element->isSetId()) mIds.insert(element->getId());
+    if (element->isSetMetaId()) mMetaIds.insert(element->getMetaId());
+  }
+  delete all;
+
+  mCollected = true;
+}
+
+
+/*
+ * Returns the first of id_2, id_3, ... neither in used nor in reserved.
+ * The suffix to try next is remembered per id, so that renaming the same
+ * id in many documents does not try the same suffixes again.
+ */
+std::string
+SedDocumentMerger::getFreeId (const std::string& id,
+                              const std::set<std::string>& used,
+                              const std::set<std::string>& reserved)
+{
+  unsigned int& next = mNextSuffix[id];
+  if (next < 2) next = 2;
+
+  for (;; ++next)
+  {
+    std::ostringstream oss;
+    oss << id << '_' << next;
+    const std::string candidate = oss.str();
+    if (used.find(candidate) == used.end()
+      && reserved.find(candidate) == reserved.end())
+    {
+      ++next;
+      return candidate;
+    }
+  }
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedDocumentMerger moving elements into target.
+ */
+LIBSEDML_EXTERN
+SedDocumentMerger_t *
+SedDocumentMerger_create (SedDocument_t *target)
+{
+  if (target == NULL) return NULL;
+  return new (nothrow) SedDocumentMerger(target);
+}
+
+
+/**
+ * Frees the given SedDocumentMerger.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentMerger_free (SedDocumentMerger_t *sdm)
+{
+  delete sdm;
+}
+
+
+/**
+ * Moves the content of source into the target of sdm.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentMerger_merge (SedDocumentMerger_t *sdm, SedDocument_t *source)
+{
+  return (sdm != NULL) ? sdm->merge(source) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of ids renamed by the last merge of sdm.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentMerger_getNumRenamed (const SedDocumentMerger_t *sdm)
+{
+  return (sdm != NULL) ? sdm->getNumRenamed() : 0;
+}
+
+
+/**
+ * Returns the id id was renamed to by the last merge of sdm.
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentMerger_getRenamedId (const SedDocumentMerger_t *sdm,
+                                const char *id)
+{
+  if (sdm == NULL || id == NULL) return NULL;
+  return safe_strdup(sdm->getRenamedId(id).c_str());
+}
+
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
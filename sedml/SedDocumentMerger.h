@@ -0,0 +1,220 @@
+/**
+ * @file    SedDocumentMerger.h
+ * @brief   Merges many SED-ML documents into one
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDocumentMerger
+ * @ingroup Core
+ * @brief Moves the content of many SedDocument objects into one.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * merge() moves the simulations, models, tasks, data generators and
+ * outputs of a source document into the target document, rather than
+ * adding clones of them, and leaves the source empty:
+ *
+ * @code{.cpp}
+SedDocumentMerger merger(combined);
+for (size_t i = 0; i < documents.size(); ++i)
+{
+  merger.merge(documents[i]);
+  delete documents[i];
+}
+@endcode
+ *
+ * The ids and metaids in use in the target are collected once, by the
+ * first merge, and then kept up to date as elements are moved in, so that
+ * each merge costs time in the size of its source only, not in the size
+ * the target has grown to.
+ *
+ * An id of the source already in use in the target is renamed to the
+ * first free one of @em id_2, @em id_3 and so on, before the elements are
+ * moved.  Every reference to it is renamed with it: the reference
+ * attributes of the elements found through the reverse-reference index of
+ * the source (see SedDocument::getNumReferrers()), the @c source of models
+ * derived from a renamed model, and the math of the data generator or
+ * compute change a renamed variable or parameter belongs to.  Conflicting
+ * metaids are renamed in the same way; annotations referring to them are
+ * left as they are.
+ *
+ * A SedDocumentMerger is not thread-safe, and the target must not be
+ * changed other than through merge() while it is used.
+ */
+
+#ifndef SedDocumentMerger_h
+#define SedDocumentMerger_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDocumentMerger
+{
+public:
+
+  /**
+   * Creates a new SedDocumentMerger moving elements into @p target.
+   */
+  SedDocumentMerger (SedDocument* target);
+
+
+  /**
+   * Destroys this SedDocumentMerger.
+   */
+  virtual ~SedDocumentMerger ();
+
+
+  /**
+   * @return the document elements are moved into.
+   */
+  SedDocument* getTarget () const;
+
+
+  /**
+   * Moves all simulations, models, tasks, data generators and outputs of
+   * @p source into the target, renaming the ids and metaids that are in
+   * use there already.
+   *
+   * @param source the document to merge; it is left without any of these
+   * elements but is still owned by the caller.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_INVALID_OBJECT, if @p source is @c NULL or the target
+   * itself
+   * @li LIBSEDML_LEVEL_MISMATCH
+   * @li LIBSEDML_VERSION_MISMATCH
+   * @li LIBSEDML_OPERATION_FAILED, if either document is frozen
+   */
+  int merge (SedDocument* source);
+
+
+  /**
+   * @return the number of ids renamed by the last merge().
+   */
+  unsigned int getNumRenamed () const;
+
+
+  /**
+   * @return the id @p id of the source of the last merge() was renamed
+   * to, or @p id itself if it was kept.
+   */
+  std::string getRenamedId (const std::string& id) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  typedef std::map<std::string, std::string> RenameMap;
+
+  void collectTargetIds ();
+
+  std::string getFreeId (const std::string& id,
+                         const std::set<std::string>& used,
+                         const std::set<std::string>& reserved);
+
+  SedDocument*                         mTarget;
+  bool                                 mCollected;
+  std::set<std::string>                mIds;
+  std::set<std::string>                mMetaIds;
+  std::map<std::string, unsigned int>  mNextSuffix;
+  RenameMap                            mRenamed;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedDocumentMerger moving elements into @p target and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedDocumentMerger_t *
+SedDocumentMerger_create (SedDocument_t *target);
+
+
+/**
+ * Frees the given SedDocumentMerger.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentMerger_free (SedDocumentMerger_t *sdm);
+
+
+/**
+ * Moves the content of @p source into the target of @p sdm.
+ *
+ * @return a @link OperationReturnValues_t return code@endlink, as
+ * SedDocumentMerger::merge() does.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentMerger_merge (SedDocumentMerger_t *sdm, SedDocument_t *source);
+
+
+/**
+ * @return the number of ids renamed by the last merge of @p sdm.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentMerger_getNumRenamed (const SedDocumentMerger_t *sdm);
+
+
+/**
+ * @return the id @p id was renamed to by the last merge of @p sdm, as a
+ * string owned by the caller, or @c NULL if @p sdm or @p id is @c NULL.
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentMerger_getRenamedId (const SedDocumentMerger_t *sdm,
+                                const char *id);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedDocumentMerger_h */
@@ -0,0 +1,835 @@
+/**
+ * @file    SedDocumentPatch.cpp
+ * @brief   Structural differences between two SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedDocumentPatch.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedTypeCodes.h>
+
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/math/MathML.h>
+#include <sbml/util/util.h>
+
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <sstream>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const char* const sOperationNames[] =
+{
+    "setAttributes"
+  , "setNotes"
+  , "setAnnotation"
+  , "setMath"
+  , "remove"
+  , "insert"
+};
+
+static const unsigned int sNumOperationNames =
+  sizeof(sOperationNames) / sizeof(sOperationNames[0]);
+
+
+/*
+ * Returns the names, with their prefixes, of the attributes of node.
+ */
+static std::set<std::string>
+getAttributeNames (const XMLNode* node)
+{
+  std::set<std::string> names;
+  if (node == NULL) return names;
+
+  const XMLAttributes& attributes = node->getAttributes();
+  for (int i = 0; i < attributes.getLength(); ++i)
+  {
+    names.insert(attributes.getPrefix(i) + ":" + attributes.getName(i));
+  }
+
+  return names;
+}
+
+
+/*
+ * Returns the key list items are matched by: the type code and id of item,
+ * and how many items with the same type code and id precede it.
+ */
+static std::string
+getMatchKey (const SedBase* item, std::map<std::string, unsigned int>& seen)
+{
+  std::ostringstream key;
+  key << item->getTypeCode() << ':' << (item->isSetId() ? item->getId() : "");
+
+  const unsigned int occurrence = seen[key.str()]++;
+  key << '#' << occurrence;
+
+  return key.str();
+}
+
+
+/*
+ * Removes the XML declaration some libSBML writers put in front of a
+ * fragment.
+ */
+static std::string
+stripXMLDeclaration (const std::string& xml)
+{
+  if (xml.compare(0, 5, "<?xml") != 0) return xml;
+
+  std::string::size_type end = xml.find("?>");
+  if (end == std::string::npos) return xml;
+
+  end = xml.find_first_not_of(" \t\r\n", end + 2);
+  return (end == std::string::npos) ? std::string() : xml.substr(end);
+}
+
+
+/*
+ * Finds the element named name in node or among its children; parsing a
+ * string may wrap the top-level element in a dummy node.
+ */
+static const XMLNode*
+findTopElement (const XMLNode* node, const std::string& name)
+{
+  if (node == NULL) return NULL;
+  if (node->isElement() && node->getName() == name) return node;
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    const XMLNode& child = node->getChild(i);
+    if (child.isElement() && child.getName() == name) return &child;
+  }
+
+  return NULL;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedDocumentPatch.
+ */
+SedDocumentPatch::SedDocumentPatch ()
+{
+}
+
+
+/*
+ * Destroys this SedDocumentPatch.
+ */
+SedDocumentPatch::~SedDocumentPatch ()
+{
+}
+
+
+/*
+ * Replaces the operations of this patch by those turning from into to.
+ */
+int
+SedDocumentPatch::diff (const SedDocument* from, const SedDocument* to)
+{
+  clear();
+
+  if (from == NULL || to == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  OperationList ops;
+  if (!diffElement(from, to, ops)) return LIBSEDML_OPERATION_FAILED;
+
+  mOperations.swap(ops);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Applies the operations of this patch to doc.
+ */
+int
+SedDocumentPatch::apply (SedDocument* doc) const
+{
+  if (doc == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (doc->isFrozen()) return LIBSEDML_OPERATION_FAILED;
+
+  int result = LIBSEDML_OPERATION_SUCCESS;
+  for (OperationList::const_iterator it = mOperations.begin();
+       it != mOperations.end() && result == LIBSEDML_OPERATION_SUCCESS; ++it)
+  {
+    result = applyOperation(doc, *it);
+  }
+
+  // attributes were read directly, so ids may have changed
+  doc->invalidateElementIndex();
+
+  return result;
+}
+
+
+/*
+ * Returns the operations of this patch as an XML string.
+ */
+std::string
+SedDocumentPatch::toString () const
+{
+  std::string xml("<sedPatch>\n");
+
+  for (OperationList::const_iterator it = mOperations.begin();
+       it != mOperations.end(); ++it)
+  {
+    const char* name = sOperationNames[it->kind];
+
+    std::ostringstream path;
+    for (size_t i = 0; i < it->path.size(); ++i)
+    {
+      if (i > 0) path << '/';
+      path << it->path[i];
+    }
+
+    xml += "  <";
+    xml += name;
+    xml += " path=\"" + path.str() + "\" element=\"" + it->element + "\"";
+
+    if (it->content.empty())
+    {
+      xml += "/>\n";
+    }
+    else
+    {
+      xml += ">" + it->content + "</" + name + ">\n";
+    }
+  }
+
+  xml += "</sedPatch>\n";
+  return xml;
+}
+
+
+/*
+ * Replaces the operations of this patch by those of the given XML string.
+ */
+int
+SedDocumentPatch::readFromString (const std::string& xml)
+{
+  clear();
+
+  XMLNode* node = XMLNode::convertStringToXMLNode(xml);
+  const XMLNode* root = findTopElement(node, "sedPatch");
+  if (root == NULL)
+  {
+    delete node;
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  OperationList ops;
+  bool valid = true;
+
+  for (unsigned int i = 0; valid && i < root->getNumChildren(); ++i)
+  {
+    const XMLNode& child = root->getChild(i);
+    if (!child.isElement()) continue;
+
+    Operation op;
+
+    unsigned int kind = 0;
+    while (kind < sNumOperationNames && child.getName() != sOperationNames[kind])
+    {
+      ++kind;
+    }
+    if (kind == sNumOperationNames)
+    {
+      valid = false;
+      break;
+    }
+    op.kind = static_cast<OperationKind>(kind);
+
+    const std::string path = child.getAttrValue("path");
+    std::string::size_type pos = 0;
+    while (pos < path.size())
+    {
+      std::string::size_type end = path.find('/', pos);
+      if (end == std::string::npos) end = path.size();
+
+      const std::string step = path.substr(pos, end - pos);
+      char* rest = NULL;
+      const unsigned long index = strtoul(step.c_str(), &rest, 10);
+      if (step.empty() || *rest != '\0')
+      {
+        valid = false;
+        break;
+      }
+
+      op.path.push_back(static_cast<unsigned int>(index));
+      pos = end + 1;
+    }
+
+    op.element = child.getAttrValue("element");
+
+    for (unsigned int c = 0; c < child.getNumChildren(); ++c)
+    {
+      if (child.getChild(c).isElement())
+      {
+        op.content = XMLNode::convertXMLNodeToString(&child.getChild(c));
+        break;
+      }
+    }
+
+    ops.push_back(op);
+  }
+
+  delete node;
+
+  if (!valid) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mOperations.swap(ops);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of operations in this patch.
+ */
+unsigned int
+SedDocumentPatch::getNumOperations () const
+{
+  return (unsigned int)mOperations.size();
+}
+
+
+/*
+ * Returns true if this patch has no operations.
+ */
+bool
+SedDocumentPatch::isEmpty () const
+{
+  return mOperations.empty();
+}
+
+
+/*
+ * Removes all operations from this patch.
+ */
+void
+SedDocumentPatch::clear ()
+{
+  mOperations.clear();
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Adds to ops the operations turning from into to, with paths relative to
+ * from.  Returns false if from has to be replaced by to as a whole, in
+ * which case ops may hold partial operations.
+ */
+bool
+SedDocumentPatch::diffElement (const SedBase* from, const SedBase* to,
+                               OperationList& ops)
+{
+  if (from->getTypeCode() != to->getTypeCode()
+    || from->getElementName() != to->getElementName())
+  {
+    return false;
+  }
+
+  if (from->getTypeCode() == SEDML_LIST_OF
+    && static_cast<const SedListOf*>(from)->getItemTypeCode()
+       != static_cast<const SedListOf*>(to)->getItemTypeCode())
+  {
+    return false;
+  }
+
+  const std::string fromAttributes = getAttributesString(from);
+  const std::string toAttributes   = getAttributesString(to);
+  if (fromAttributes != toAttributes)
+  {
+    // readAttributes() cannot unset an attribute, so an element that
+    // lost one is replaced
+    XMLNode* fromNode = XMLNode::convertStringToXMLNode(fromAttributes);
+    XMLNode* toNode   = XMLNode::convertStringToXMLNode(toAttributes);
+    const std::set<std::string> fromNames = getAttributeNames(fromNode);
+    const std::set<std::string> toNames   = getAttributeNames(toNode);
+    const bool parsed = (fromNode != NULL && toNode != NULL);
+    delete fromNode;
+    delete toNode;
+
+    if (!parsed) return false;
+
+    for (std::set<std::string>::const_iterator it = fromNames.begin();
+         it != fromNames.end(); ++it)
+    {
+      if (toNames.find(*it) == toNames.end()) return false;
+    }
+
+    addOperation(ops, SET_ATTRIBUTES, to, toAttributes);
+  }
+
+  const std::string fromNotes = from->isSetNotes() ? from->getNotesString() : "";
+  const std::string toNotes   = to->isSetNotes()   ? to->getNotesString()   : "";
+  if (fromNotes != toNotes) addOperation(ops, SET_NOTES, to, toNotes);
+
+  const std::string fromAnnotation =
+    from->isSetAnnotation() ? from->getAnnotationString() : "";
+  const std::string toAnnotation =
+    to->isSetAnnotation()   ? to->getAnnotationString()   : "";
+  if (fromAnnotation != toAnnotation)
+  {
+    addOperation(ops, SET_ANNOTATION, to, toAnnotation);
+  }
+
+  const std::string fromMath = getMathString(from);
+  const std::string toMath   = getMathString(to);
+  if (fromMath != toMath) addOperation(ops, SET_MATH, to, toMath);
+
+  if (from->getTypeCode() == SEDML_LIST_OF)
+  {
+    diffList(from, to, ops);
+    return true;
+  }
+
+  // outside of lists the children have fixed places and are matched by
+  // them
+  const unsigned int numChildren = from->getNumChildElements();
+  if (numChildren != to->getNumChildElements()) return false;
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    const SedBase* fromChild = from->getChildElement(i);
+    const SedBase* toChild   = to->getChildElement(i);
+
+    if ((fromChild == NULL) != (toChild == NULL)) return false;
+    if (fromChild == NULL) continue;
+
+    const size_t first = ops.size();
+    if (!diffElement(fromChild, toChild, ops)) return false;
+    prefixPaths(ops, first, i);
+  }
+
+  return true;
+}
+
+
+/*
+ * Adds to ops the operations turning the items of the SedListOf from into
+ * those of to: removals in descending order, then the changes of matched
+ * items, then insertions in ascending order, so that each operation
+ * addresses the list as the ones before it left it.
+ */
+void
+SedDocumentPatch::diffList (const SedBase* from, const SedBase* to,
+                            OperationList& ops)
+{
+  const unsigned int numFrom = from->getNumChildElements();
+  const unsigned int numTo   = to->getNumChildElements();
+
+  std::map<std::string, unsigned int> fromIndex;
+  std::map<std::string, unsigned int> seen;
+  for (unsigned int i = 0; i < numFrom; ++i)
+  {
+    fromIndex.insert(std::make_pair(getMatchKey(from->getChildElement(i), seen), i));
+  }
+
+  // match in order, so that the items kept need not be moved
+  std::vector<int>            matchOf(numTo, -1);
+  std::vector<bool>           isMatched(numFrom, false);
+  std::vector<OperationList>  itemOps(numTo);
+  int last = -1;
+
+  seen.clear();
+  for (unsigned int j = 0; j < numTo; ++j)
+  {
+    const SedBase* toItem = to->getChildElement(j);
+
+    std::map<std::string, unsigned int>::const_iterator it =
+      fromIndex.find(getMatchKey(toItem, seen));
+    if (it == fromIndex.end() || (int)it->second <= last) continue;
+
+    const unsigned int i = it->second;
+    if (diffElement(from->getChildElement(i), toItem, itemOps[j]))
+    {
+      matchOf[j]   = (int)i;
+      isMatched[i] = true;
+      last         = (int)i;
+    }
+    else
+    {
+      itemOps[j].clear();
+    }
+  }
+
+  for (unsigned int i = numFrom; i-- > 0; )
+  {
+    if (isMatched[i]) continue;
+
+    addOperation(ops, REMOVE, from->getChildElement(i), "");
+    ops.back().path.push_back(i);
+  }
+
+  // after the removals a matched item is at its rank among those kept
+  std::vector<unsigned int> rank(numFrom, 0);
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < numFrom; ++i)
+  {
+    if (isMatched[i]) rank[i] = kept++;
+  }
+
+  for (unsigned int j = 0; j < numTo; ++j)
+  {
+    if (matchOf[j] < 0) continue;
+
+    const size_t first = ops.size();
+    ops.insert(ops.end(), itemOps[j].begin(), itemOps[j].end());
+    prefixPaths(ops, first, rank[matchOf[j]]);
+  }
+
+  for (unsigned int j = 0; j < numTo; ++j)
+  {
+    if (matchOf[j] >= 0) continue;
+
+    SedBase* toItem = const_cast<SedBase*>(to->getChildElement(j));
+    char* xml = toItem->toSed();
+
+    addOperation(ops, INSERT, toItem, (xml != NULL) ? xml : "");
+    ops.back().path.push_back(j);
+
+    safe_free(xml);
+  }
+}
+
+
+/*
+ * Adds an operation on element, with an empty path, to ops.
+ */
+void
+SedDocumentPatch::addOperation (OperationList& ops, OperationKind kind,
+                                const SedBase* element,
+                                const std::string& content)
+{
+  Operation op;
+  op.kind    = kind;
+  op.element = element->getElementName();
+  op.content = content;
+
+  ops.push_back(op);
+}
+
+
+/*
+ * Prepends index to the paths of the operations from first on.
+ */
+void
+SedDocumentPatch::prefixPaths (OperationList& ops, size_t first,
+                               unsigned int index)
+{
+  for (size_t k = first; k < ops.size(); ++k)
+  {
+    ops[k].path.insert(ops[k].path.begin(), index);
+  }
+}
+
+
+/*
+ * Returns an empty element named like element, carrying its attributes.
+ */
+std::string
+SedDocumentPatch::getAttributesString (const SedBase* element)
+{
+  std::ostringstream os;
+  XMLOutputStream stream(os, "UTF-8", false);
+
+  stream.startElement(element->getElementName(), element->getPrefix());
+  element->writeAttributes(stream);
+  stream.endElement(element->getElementName(), element->getPrefix());
+
+  return os.str();
+}
+
+
+/*
+ * Returns the MathML of element, or an empty string if it has none.
+ */
+std::string
+SedDocumentPatch::getMathString (const SedBase* element)
+{
+  const ASTNode* math = NULL;
+
+  switch (element->getTypeCode())
+  {
+  case SEDML_DATAGENERATOR:
+    math = static_cast<const SedDataGenerator*>(element)->getMath();
+    break;
+  case SEDML_CHANGE_COMPUTECHANGE:
+    math = static_cast<const SedComputeChange*>(element)->getMath();
+    break;
+  default:
+    break;
+  }
+
+  if (math == NULL) return "";
+
+  char* xml = writeMathMLToString(math);
+  const std::string result = stripXMLDeclaration((xml != NULL) ? xml : "");
+  free(xml);
+
+  return result;
+}
+
+
+/*
+ * Returns the element the first length steps of path lead to from root.
+ */
+SedBase*
+SedDocumentPatch::resolve (SedBase* root,
+                           const std::vector<unsigned int>& path,
+                           size_t length)
+{
+  SedBase* element = root;
+  for (size_t k = 0; element != NULL && k < length; ++k)
+  {
+    element = const_cast<SedBase*>(element->getChildElement(path[k]));
+  }
+
+  return element;
+}
+
+
+/*
+ * Applies a single operation to doc.
+ */
+int
+SedDocumentPatch::applyOperation (SedDocument* doc, const Operation& op)
+{
+  if (op.kind == REMOVE || op.kind == INSERT)
+  {
+    if (op.path.empty()) return LIBSEDML_INVALID_OBJECT;
+
+    SedBase* parent = resolve(doc, op.path, op.path.size() - 1);
+    if (parent == NULL || parent->getTypeCode() != SEDML_LIST_OF)
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+    SedListOf* list = static_cast<SedListOf*>(parent);
+    const unsigned int index = op.path.back();
+
+    if (op.kind == REMOVE)
+    {
+      if (index >= list->size()
+        || list->get(index)->getElementName() != op.element)
+      {
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+      delete list->remove(index);
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+    if (index > list->size()) return LIBSEDML_INVALID_OBJECT;
+
+    const std::string xml =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" + op.content;
+    XMLInputStream stream(xml.c_str(), false,
+                          SedReader::getDefaultXMLParser(),
+                          doc->getErrorLog());
+
+    if (!stream.peek().isStart() || stream.peek().getName() != op.element)
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+    // the list appends the object it creates
+    SedBase* item = parent->createObject(stream);
+    if (item == NULL) return LIBSEDML_INVALID_OBJECT;
+
+    item->read(stream);
+
+    if (index + 1 < list->size())
+    {
+      list->remove(list->size() - 1);
+      return list->insertAndOwn((int)index, item);
+    }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  SedBase* element = resolve(doc, op.path, op.path.size());
+  if (element == NULL || element->getElementName() != op.element)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  if (op.content.empty())
+  {
+    switch (op.kind)
+    {
+    case SET_NOTES:
+      return element->unsetNotes();
+    case SET_ANNOTATION:
+      return element->unsetAnnotation();
+    case SET_MATH:
+      break;
+    default:
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+  }
+
+  if (op.kind == SET_MATH)
+  {
+    ASTNode* math = op.content.empty()
+      ? NULL : readMathMLFromString(op.content.c_str());
+    if (math == NULL && !op.content.empty())
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+    int result = LIBSEDML_INVALID_OBJECT;
+    switch (element->getTypeCode())
+    {
+    case SEDML_DATAGENERATOR:
+      result = static_cast<SedDataGenerator*>(element)->setMath(math);
+      break;
+    case SEDML_CHANGE_COMPUTECHANGE:
+      result = static_cast<SedComputeChange*>(element)->setMath(math);
+      break;
+    default:
+      break;
+    }
+
+    delete math;
+    return result;
+  }
+
+  XMLNode* node = XMLNode::convertStringToXMLNode(op.content);
+  if (node == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  int result = LIBSEDML_OPERATION_SUCCESS;
+  switch (op.kind)
+  {
+  case SET_ATTRIBUTES:
+    element->readAttributes(node->getAttributes(),
+                            element->getExpectedAttributes());
+    element->markDirty();
+    break;
+  case SET_NOTES:
+    result = element->setNotes(node);
+    break;
+  case SET_ANNOTATION:
+    result = element->setAnnotation(node);
+    break;
+  default:
+    result = LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    break;
+  }
+
+  delete node;
+  return result;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDocumentPatch_t *
+SedDocumentPatch_create ()
+{
+  return new(std::nothrow) SedDocumentPatch();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentPatch_free (SedDocumentPatch_t *sdp)
+{
+  delete sdp;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_diff (SedDocumentPatch_t *sdp,
+                       const SedDocument_t *from, const SedDocument_t *to)
+{
+  return (sdp != NULL) ? sdp->diff(from, to) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_apply (const SedDocumentPatch_t *sdp, SedDocument_t *doc)
+{
+  return (sdp != NULL) ? sdp->apply(doc) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentPatch_toString (const SedDocumentPatch_t *sdp)
+{
+  return (sdp != NULL) ? safe_strdup(sdp->toString().c_str()) : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_readFromString (SedDocumentPatch_t *sdp, const char *xml)
+{
+  if (sdp == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (xml == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  return sdp->readFromString(xml);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentPatch_getNumOperations (const SedDocumentPatch_t *sdp)
+{
+  return (sdp != NULL) ? sdp->getNumOperations() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
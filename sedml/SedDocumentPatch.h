@@ -0,0 +1,302 @@
+/**
+ * @file    SedDocumentPatch.h
+ * @brief   Structural differences between two SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDocumentPatch
+ * @ingroup Core
+ * @brief The edits that turn one SedDocument into another.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * diff() compares two documents element by element and records the
+ * operations that turn the first into the second; apply() performs them
+ * on a document equal to the first.  Replicas of a long-lived document can
+ * thus be kept in sync by exchanging patches, serialized with toString()
+ * and read back with readFromString(), instead of whole documents:
+ *
+ * @code{.cpp}
+SedDocumentPatch patch;
+patch.diff(before, after);
+std::string text = patch.toString();   // a few hundred bytes for small edits
+...
+SedDocumentPatch received;
+received.readFromString(text);
+received.apply(replica);                // replica now equals after
+@endcode
+ *
+ * The items of each SedListOf are matched by type code and id, and those
+ * without an id by their order; matched elements are compared attribute
+ * by attribute and by their notes, annotation and math.  A patch consists
+ * of these operations, each addressing an element by its position, the
+ * indices of getChildElement() from the document down:
+ *
+ * @li @em setAttributes gives a matched element the attributes of its
+ * counterpart;
+ * @li @em setNotes, @em setAnnotation and @em setMath replace (or unset)
+ * its notes, annotation or math;
+ * @li @em remove deletes an item of a SedListOf;
+ * @li @em insert adds an element, with everything below it, to a
+ * SedListOf.
+ *
+ * An element that lost an attribute, or whose children are not matched
+ * one to one outside of SedListOf objects (a simulation that lost its
+ * algorithm, for instance), is removed and inserted again as a whole.
+ */
+
+#ifndef SedDocumentPatch_h
+#define SedDocumentPatch_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDocumentPatch
+{
+public:
+
+  /**
+   * Creates a new, empty SedDocumentPatch.
+   */
+  SedDocumentPatch ();
+
+
+  /**
+   * Destroys this SedDocumentPatch.
+   */
+  virtual ~SedDocumentPatch ();
+
+
+  /**
+   * Replaces the operations of this patch by those turning @p from into
+   * @p to.  Neither document is changed.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if either document is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the documents cannot be matched at the top level
+   */
+  int diff (const SedDocument* from, const SedDocument* to);
+
+
+  /**
+   * Applies the operations of this patch, in order, to @p doc, which
+   * should equal the @em from document of diff().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p doc is @c NULL, or an operation addresses an element @p doc
+   * does not have; the operations before it have been applied
+   */
+  int apply (SedDocument* doc) const;
+
+
+  /**
+   * @return the operations of this patch as an XML string.
+   */
+  std::string toString () const;
+
+
+  /**
+   * Replaces the operations of this patch by those of @p xml, a string
+   * returned by toString().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p xml is not a patch; this patch is then empty
+   */
+  int readFromString (const std::string& xml);
+
+
+  /**
+   * @return the number of operations in this patch.
+   */
+  unsigned int getNumOperations () const;
+
+
+  /**
+   * @return @c true if this patch has no operations, that is if the
+   * documents it was computed from are equal.
+   */
+  bool isEmpty () const;
+
+
+  /**
+   * Removes all operations from this patch.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  enum OperationKind
+  {
+      SET_ATTRIBUTES
+    , SET_NOTES
+    , SET_ANNOTATION
+    , SET_MATH
+    , REMOVE
+    , INSERT
+  };
+
+  /*
+   * One operation; path holds the getChildElement() indices leading from
+   * the document to the element changed, removed or inserted, whose element
+   * name is element.  content is the XML the operation needs: a start tag
+   * carrying the attributes, the notes, annotation or math (empty to
+   * unset them), or the element inserted.
+   */
+  struct Operation
+  {
+    OperationKind              kind;
+    std::vector<unsigned int>  path;
+    std::string                element;
+    std::string                content;
+  };
+
+  typedef std::vector<Operation> OperationList;
+
+  static bool diffElement (const SedBase* from, const SedBase* to,
+                           OperationList& ops);
+
+  static void diffList (const SedBase* from, const SedBase* to,
+                        OperationList& ops);
+
+  static void addOperation (OperationList& ops, OperationKind kind,
+                            const SedBase* element,
+                            const std::string& content);
+
+  static void prefixPaths (OperationList& ops, size_t first,
+                           unsigned int index);
+
+  static std::string getAttributesString (const SedBase* element);
+
+  static std::string getMathString (const SedBase* element);
+
+  static SedBase* resolve (SedBase* root,
+                           const std::vector<unsigned int>& path,
+                           size_t length);
+
+  static int applyOperation (SedDocument* doc, const Operation& op);
+
+
+  OperationList  mOperations;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedDocumentPatch and returns it.
+ */
+LIBSEDML_EXTERN
+SedDocumentPatch_t *
+SedDocumentPatch_create ();
+
+
+/**
+ * Frees the given SedDocumentPatch.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentPatch_free (SedDocumentPatch_t *sdp);
+
+
+/**
+ * Replaces the operations of @p sdp by those turning @p from into @p to.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_diff (SedDocumentPatch_t *sdp,
+                       const SedDocument_t *from, const SedDocument_t *to);
+
+
+/**
+ * Applies @p sdp to @p doc.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_apply (const SedDocumentPatch_t *sdp, SedDocument_t *doc);
+
+
+/**
+ * Returns @p sdp as an XML string, which the caller must free, or @c NULL
+ * if @p sdp is @c NULL.
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentPatch_toString (const SedDocumentPatch_t *sdp);
+
+
+/**
+ * Replaces the operations of @p sdp by those of @p xml.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentPatch_readFromString (SedDocumentPatch_t *sdp, const char *xml);
+
+
+/**
+ * Returns the number of operations in @p sdp.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentPatch_getNumOperations (const SedDocumentPatch_t *sdp);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedDocumentPatch_h */
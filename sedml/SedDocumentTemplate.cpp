@@ -0,0 +1,578 @@
+/**
+ * @file    SedDocumentTemplate.cpp
+ * @brief   A document serialised once, with holes for values that vary
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedDocumentTemplate.h>
+#include <sedml/SedTypes.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedOutputSink.h>
+#include <sedml/SedWriter.h>
+#include <sedml/common/common.h>
+
+#include <algorithm>
+#include <new>
+#include <sstream>
+#include <utility>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns the marker compile() puts into hole n of the given type.  The
+ * numbers are ones no sweep would use: a negative number of points and a
+ * tiny negative parameter value.
+ */
+static std::string
+getMarker (unsigned int n, SedTemplateHoleType_t type)
+{
+  switch (type)
+  {
+  case SEDML_HOLE_DOUBLE:
+    return SedNumber::toString(-1.2345678901234567e-301 * (n + 1));
+  case SEDML_HOLE_INT:
+    return SedNumber::toString(-2000000000 + (int)n);
+  default:
+    return "SedDocumentTemplate-hole-" + SedNumber::toString(n);
+  }
+}
+
+
+/*
+ * Returns the value, as written, of the attribute of element a hole of
+ * the given type is, after setting it to value if set is true; numbers
+ * are written as SedNumber parses them back, so the values round-trip.
+ */
+static std::string
+accessValue (SedBase* element, SedTemplateHoleType_t type, bool set,
+             const std::string& value)
+{
+  switch (type)
+  {
+  case SEDML_HOLE_DOUBLE:
+  {
+    SedParameter* parameter = static_cast<SedParameter*>(element);
+    double number = 0;
+    if (set && SedNumber::parse(value, number)) parameter->setValue(number);
+    return SedNumber::toString(parameter->getValue());
+  }
+  case SEDML_HOLE_INT:
+  {
+    SedUniformTimeCourse* tc = static_cast<SedUniformTimeCourse*>(element);
+    int number = 0;
+    if (set && SedNumber::parse(value, number)) tc->setNumberOfPoints(number);
+    return SedNumber::toString(tc->getNumberOfPoints());
+  }
+  default:
+  {
+    SedChangeAttribute* change = static_cast<SedChangeAttribute*>(element);
+    if (set) change->setNewValue(value);
+    return change->getNewValue();
+  }
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedDocumentTemplate.
+ */
+SedDocumentTemplate::SedDocumentTemplate ()
+  : mSegmentsLength (0)
+  , mCompiled (false)
+{
+}
+
+
+/*
+ * Destroys this SedDocumentTemplate.
+ */
+SedDocumentTemplate::~SedDocumentTemplate ()
+{
+}
+
+
+/*
+ * Makes the new value of change a hole.
+ */
+int
+SedDocumentTemplate::addHole (SedChangeAttribute* change)
+{
+  if (change == NULL || !change->isSetNewValue())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  return addHole(change, SEDML_HOLE_STRING);
+}
+
+
+/*
+ * Makes the value of parameter a hole.
+ */
+int
+SedDocumentTemplate::addHole (SedParameter* parameter)
+{
+  if (parameter == NULL || !parameter->isSetValue())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  return addHole(parameter, SEDML_HOLE_DOUBLE);
+}
+
+
+/*
+ * Makes the number of points of timeCourse a hole.
+ */
+int
+SedDocumentTemplate::addHole (SedUniformTimeCourse* timeCourse)
+{
+  if (timeCourse == NULL || !timeCourse->isSetNumberOfPoints())
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  return addHole(timeCourse, SEDML_HOLE_INT);
+}
+
+
+/*
+ * Writes doc and cuts it into segments and holes.
+ */
+int
+SedDocumentTemplate::compile (SedDocument* doc, SedWriter* writer)
+{
+  if (mCompiled) return LIBSEDML_OPERATION_FAILED;
+  if (doc == NULL || doc->isFrozen()) return LIBSEDML_INVALID_OBJECT;
+
+  for (size_t i = 0; i < mHoles.size(); ++i)
+  {
+    if (mHoles[i].element->getSedDocument() != doc)
+    {
+      return LIBSEDML_INVALID_OBJECT;
+    }
+  }
+
+  // the markers go in, the document is written, the values go back
+  std::vector<std::string> markers(mHoles.size());
+  for (unsigned int i = 0; i < mHoles.size(); ++i)
+  {
+    Hole& hole = mHoles[i];
+    markers[i]    = getMarker(i, hole.type);
+    hole.original = accessValue(hole.element, hole.type, false, "");
+    accessValue(hole.element, hole.type, true, markers[i]);
+  }
+
+  SedWriter defaultWriter;
+  std::ostringstream stream;
+  const bool written =
+    (writer != NULL ? writer : &defaultWriter)->writeSedML(doc, stream);
+
+  for (unsigned int i = 0; i < mHoles.size(); ++i)
+  {
+    accessValue(mHoles[i].element, mHoles[i].type, true,
+                mHoles[i].original);
+  }
+
+  if (!written) return LIBSEDML_OPERATION_FAILED;
+
+  // every marker must be the whole value of exactly one attribute
+  const std::string xml = stream.str();
+  std::vector<std::pair<size_t, unsigned int> > positions;
+  for (unsigned int i = 0; i < mHoles.size(); ++i)
+  {
+    const std::string quoted = "\"" + markers[i] + "\"";
+    const size_t found = xml.find(quoted);
+    if (found == std::string::npos
+      || xml.find(quoted, found + 1) != std::string::npos)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+    positions.push_back(std::make_pair(found + 1, i));
+  }
+  std::sort(positions.begin(), positions.end());
+
+  mSegments.clear();
+  mOrder.clear();
+  mSegmentsLength = xml.size();
+
+  size_t begin = 0;
+  for (size_t k = 0; k < positions.size(); ++k)
+  {
+    const unsigned int n = positions[k].second;
+    mSegments.push_back(xml.substr(begin, positions[k].first - begin));
+    mOrder.push_back(n);
+    begin = positions[k].first + markers[n].size();
+    mSegmentsLength -= markers[n].size();
+  }
+  mSegments.push_back(xml.substr(begin));
+
+  // the holes no longer refer to the document
+  for (size_t i = 0; i < mHoles.size(); ++i)
+  {
+    mHoles[i].element = NULL;
+  }
+
+  mCompiled = true;
+  resetValues();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true once compile() has succeeded.
+ */
+bool
+SedDocumentTemplate::isCompiled () const
+{
+  return mCompiled;
+}
+
+
+/*
+ * Returns the number of holes.
+ */
+unsigned int
+SedDocumentTemplate::getNumHoles () const
+{
+  return (unsigned int)mHoles.size();
+}
+
+
+/*
+ * Returns the type of hole n.
+ */
+SedTemplateHoleType_t
+SedDocumentTemplate::getHoleType (unsigned int n) const
+{
+  return (n < mHoles.size()) ? mHoles[n].type : SEDML_HOLE_STRING;
+}
+
+
+/*
+ * Sets hole n to the string value.
+ */
+int
+SedDocumentTemplate::setString (unsigned int n, const std::string& value)
+{
+  if (n >= mValues.size()) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  if (mHoles[n].type != SEDML_HOLE_STRING)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mValues[n] = escape(value);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets hole n to the number value.
+ */
+int
+SedDocumentTemplate::setDouble (unsigned int n, double value)
+{
+  if (n >= mValues.size()) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+  if (mHoles[n].type == SEDML_HOLE_INT)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  // a number needs no escaping
+  mValues[n] = SedNumber::toString(value);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets hole n to the integer value.
+ */
+int
+SedDocumentTemplate::setInt (unsigned int n, int value)
+{
+  if (n >= mValues.size()) return LIBSEDML_INDEX_EXCEEDS_SIZE;
+
+  mValues[n] = SedNumber::toString(value);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets every hole back to the value it has in the document.
+ */
+void
+SedDocumentTemplate::resetValues ()
+{
+  if (!mCompiled) return;
+
+  mValues.resize(mHoles.size());
+  for (size_t i = 0; i < mHoles.size(); ++i)
+  {
+    mValues[i] = (mHoles[i].type == SEDML_HOLE_STRING)
+               ? escape(mHoles[i].original)
+               : mHoles[i].original;
+  }
+}
+
+
+/*
+ * Writes the variant into out.
+ */
+bool
+SedDocumentTemplate::write (std::string& out) const
+{
+  out.clear();
+  if (!mCompiled) return false;
+
+  size_t length = mSegmentsLength;
+  for (size_t i = 0; i < mValues.size(); ++i)
+  {
+    length += mValues[i].size();
+  }
+  out.reserve(length);
+
+  out += mSegments[0];
+  for (size_t k = 0; k < mOrder.size(); ++k)
+  {
+    out += mValues[mOrder[k]];
+    out += mSegments[k + 1];
+  }
+  return true;
+}
+
+
+/*
+ * Returns the variant.
+ */
+std::string
+SedDocumentTemplate::write () const
+{
+  std::string out;
+  write(out);
+  return out;
+}
+
+
+/*
+ * Writes the variant to sink and finishes it.
+ */
+bool
+SedDocumentTemplate::write (SedOutputSink& sink) const
+{
+  if (!mCompiled) return false;
+
+  bool result = sink.write(mSegments[0].data(), mSegments[0].size());
+  for (size_t k = 0; result && k < mOrder.size(); ++k)
+  {
+    const std::string& value   = mValues[mOrder[k]];
+    const std::string& segment = mSegments[k + 1];
+    result = sink.write(value.data(), value.size())
+          && sink.write(segment.data(), segment.size());
+  }
+
+  // the sink may release what it holds even after a failure
+  return sink.finish() && result;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Adds a hole of the given type for element.
+ */
+int
+SedDocumentTemplate::addHole (SedBase* element, SedTemplateHoleType_t type)
+{
+  if (mCompiled) return LIBSEDML_OPERATION_FAILED;
+
+  Hole hole;
+  hole.type    = type;
+  hole.element = element;
+  mHoles.push_back(hole);
+  return (int)mHoles.size() - 1;
+}
+
+
+/*
+ * Returns value escaped as XMLOutputStream escapes attribute values: an
+ * ampersand starting a character or entity reference is left as it is.
+ */
+std::string
+SedDocumentTemplate::escape (const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    const char c = value[i];
+    switch (c)
+    {
+    case '&':
+    {
+      const size_t end = value.find(';', i);
+      bool reference = false;
+      if (end != std::string::npos)
+      {
+        const std::string name = value.substr(i + 1, end - i - 1);
+        reference = name == "amp" || name == "lt" || name == "gt"
+                 || name == "quot" || name == "apos"
+                 || (name.size() > 1 && name[0] == '#');
+      }
+      escaped += reference ? "&" : "&amp;";
+      break;
+    }
+    case '<':  escaped += "&lt;";   break;
+    case '>':  escaped += "&gt;";   break;
+    case '"':  escaped += "&quot;"; break;
+    case '\'': escaped += "&apos;"; break;
+    default:   escaped += c;        break;
+    }
+  }
+
+  return escaped;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedDocumentTemplate and returns it.
+ */
+LIBSEDML_EXTERN
+SedDocumentTemplate_t *
+SedDocumentTemplate_create ()
+{
+  return new (nothrow) SedDocumentTemplate();
+}
+
+
+/**
+ * Frees the given SedDocumentTemplate.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentTemplate_free (SedDocumentTemplate_t *sdt)
+{
+  delete sdt;
+}
+
+
+/**
+ * Makes the new value of change a hole.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addChangeHole (SedDocumentTemplate_t *sdt,
+                                   SedChangeAttribute_t *change)
+{
+  return (sdt != NULL) ? sdt->addHole(change) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Makes the value of parameter a hole.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addParameterHole (SedDocumentTemplate_t *sdt,
+                                      SedParameter_t *parameter)
+{
+  return (sdt != NULL) ? sdt->addHole(parameter) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Makes the number of points of timeCourse a hole.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addTimeCourseHole (SedDocumentTemplate_t *sdt,
+                                       SedUniformTimeCourse_t *timeCourse)
+{
+  return (sdt != NULL) ? sdt->addHole(timeCourse) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Writes doc and cuts it into segments and holes.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_compile (SedDocumentTemplate_t *sdt, SedDocument_t *doc)
+{
+  return (sdt != NULL) ? sdt->compile(doc) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Sets hole n to the string value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setString (SedDocumentTemplate_t *sdt, unsigned int n,
+                               const char *value)
+{
+  if (sdt == NULL) return LIBSEDML_INVALID_OBJECT;
+  return sdt->setString(n, value != NULL ? value : "");
+}
+
+
+/**
+ * Sets hole n to the number value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setDouble (SedDocumentTemplate_t *sdt, unsigned int n,
+                               double value)
+{
+  return (sdt != NULL) ? sdt->setDouble(n, value) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Sets hole n to the integer value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setInt (SedDocumentTemplate_t *sdt, unsigned int n,
+                            int value)
+{
+  return (sdt != NULL) ? sdt->setInt(n, value) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the variant with the values of the holes.
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentTemplate_writeToString (const SedDocumentTemplate_t *sdt)
+{
+  if (sdt == NULL || !sdt->isCompiled()) return NULL;
+  return safe_strdup(sdt->write().c_str());
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
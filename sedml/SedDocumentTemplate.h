@@ -0,0 +1,394 @@
+/**
+ * @file    SedDocumentTemplate.h
+ * @brief   A document serialised once, with holes for values that vary
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDocumentTemplate
+ * @ingroup Core
+ * @brief Writes variants of a SedDocument that differ only in a few
+ * attribute values, without writing the document again.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A sweep often writes thousands of documents that differ only in the new
+ * value of a SedChangeAttribute, the value of a SedParameter or the number
+ * of points of a SedUniformTimeCourse.  Instead of changing and writing
+ * the whole document for each, a SedDocumentTemplate writes it once:
+ * addHole() selects the attributes that vary, and compile() writes the
+ * document with SedWriter and cuts the XML into the text between those
+ * attributes, the segments, and the attribute values, the holes.  A
+ * variant is then written by setting the values of the holes and calling
+ * write(), which only joins the segments and the values.
+ *
+ * @code{.cpp}
+ * SedDocumentTemplate sweep;
+ * int k = sweep.addHole(doc->getModel(0)->getChange(0));
+ * sweep.compile(doc);
+ * std::string xml;
+ * for (unsigned int i = 0; i < n; ++i)
+ * {
+ *   sweep.setDouble(k, values[i]);
+ *   sweep.write(xml);
+ *   ...
+ * }
+ * @endcode
+ *
+ * Values are formatted as SedWriter formats them, numbers with
+ * SedNumber::toString() and strings escaped as XML attribute values, so a
+ * variant is the XML SedWriter would write for the document with those
+ * values.  Holes not set keep the values of the document.
+ *
+ * To find the holes, compile() writes the document with a marker value in
+ * each of them and puts the original values back; it fails if a marker
+ * cannot be found exactly once, as when the document contains the marker
+ * itself.  The document is only changed while compile() runs, and the
+ * template does not refer to it afterwards.
+ *
+ * A template holds the values of its holes, so one template must not be
+ * used by several threads at the same time; copies of it may.
+ */
+
+#ifndef SedDocumentTemplate_h
+#define SedDocumentTemplate_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+/**
+ * @enum SedTemplateHoleType_t
+ * The kinds of value a hole of a SedDocumentTemplate holds.
+ */
+typedef enum
+{
+    SEDML_HOLE_STRING   /*!< A string, as the new value of a change. */
+  , SEDML_HOLE_DOUBLE   /*!< A number, as the value of a parameter. */
+  , SEDML_HOLE_INT      /*!< An integer, as a number of points. */
+} SedTemplateHoleType_t;
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedChangeAttribute;
+class SedParameter;
+class SedUniformTimeCourse;
+class SedWriter;
+class SedOutputSink;
+
+
+class LIBSEDML_EXTERN SedDocumentTemplate
+{
+public:
+
+  /**
+   * Creates a new SedDocumentTemplate without holes.
+   */
+  SedDocumentTemplate ();
+
+
+  /**
+   * Destroys this SedDocumentTemplate.
+   */
+  virtual ~SedDocumentTemplate ();
+
+
+  /**
+   * Makes the new value of @p change a hole, of type
+   * @c SEDML_HOLE_STRING.
+   *
+   * @return the index of the hole, or @c LIBSEDML_INVALID_OBJECT if
+   * @p change is @c NULL or has no new value, or
+   * @c LIBSEDML_OPERATION_FAILED if the template is compiled already.
+   */
+  int addHole (SedChangeAttribute* change);
+
+
+  /**
+   * Makes the value of @p parameter a hole, of type
+   * @c SEDML_HOLE_DOUBLE.
+   *
+   * @return the index of the hole, or @c LIBSEDML_INVALID_OBJECT if
+   * @p parameter is @c NULL or has no value, or
+   * @c LIBSEDML_OPERATION_FAILED if the template is compiled already.
+   */
+  int addHole (SedParameter* parameter);
+
+
+  /**
+   * Makes the number of points of @p timeCourse a hole, of type
+   * @c SEDML_HOLE_INT.
+   *
+   * @return the index of the hole, or @c LIBSEDML_INVALID_OBJECT if
+   * @p timeCourse is @c NULL or has no number of points, or
+   * @c LIBSEDML_OPERATION_FAILED if the template is compiled already.
+   */
+  int addHole (SedUniformTimeCourse* timeCourse);
+
+
+  /**
+   * Writes @p doc, which the elements of the holes must belong to, with
+   * @p writer, or a default SedWriter if it is @c NULL, and cuts it into
+   * segments and holes.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p doc is @c NULL or frozen, or a hole belongs to another document
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the template is compiled already, the document cannot be written
+   * or a hole cannot be found in it
+   */
+  int compile (SedDocument* doc, SedWriter* writer = NULL);
+
+
+  /**
+   * @return @c true once compile() has succeeded.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * @return the number of holes.
+   */
+  unsigned int getNumHoles () const;
+
+
+  /**
+   * @return the type of hole @p n, @c SEDML_HOLE_STRING if there is none.
+   */
+  SedTemplateHoleType_t getHoleType (unsigned int n) const;
+
+
+  /**
+   * Sets hole @p n, of type @c SEDML_HOLE_STRING, to @p value.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INDEX_EXCEEDS_SIZE LIBSEDML_INDEX_EXCEEDS_SIZE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the hole is of another type
+   */
+  int setString (unsigned int n, const std::string& value);
+
+
+  /**
+   * Sets hole @p n, of type @c SEDML_HOLE_DOUBLE or @c SEDML_HOLE_STRING,
+   * to @p value.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INDEX_EXCEEDS_SIZE LIBSEDML_INDEX_EXCEEDS_SIZE @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the hole is of type @c SEDML_HOLE_INT
+   */
+  int setDouble (unsigned int n, double value);
+
+
+  /**
+   * Sets hole @p n, of any type, to @p value.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INDEX_EXCEEDS_SIZE LIBSEDML_INDEX_EXCEEDS_SIZE @endlink
+   */
+  int setInt (unsigned int n, int value);
+
+
+  /**
+   * Sets every hole back to the value it has in the document.
+   */
+  void resetValues ();
+
+
+  /**
+   * Writes the variant with the values of the holes into @p out,
+   * replacing its contents; reusing @p out for the next variant saves
+   * allocating it again.
+   *
+   * @return @c false if the template is not compiled.
+   */
+  bool write (std::string& out) const;
+
+
+  /**
+   * @return the variant with the values of the holes, or an empty string
+   * if the template is not compiled.
+   */
+  std::string write () const;
+
+
+  /**
+   * Writes the variant with the values of the holes to @p sink and
+   * finishes it.
+   *
+   * @return @c false if the template is not compiled or the sink fails.
+   */
+  bool write (SedOutputSink& sink) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Hole
+  {
+    SedTemplateHoleType_t  type;
+    SedBase*               element;
+    std::string            original;
+  };
+
+  int addHole (SedBase* element, SedTemplateHoleType_t type);
+
+  static std::string escape (const std::string& value);
+
+  std::vector<Hole>         mHoles;
+
+  // mSegments has one more element than mHoles once compiled; the hole
+  // n lies between segments n and n + 1 of the text, which is in the
+  // order of the holes in the XML, given by mOrder
+  std::vector<std::string>  mSegments;
+  std::vector<unsigned int> mOrder;
+  std::vector<std::string>  mValues;
+  size_t                    mSegmentsLength;
+  bool                      mCompiled;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedDocumentTemplate without holes and returns it.
+ */
+LIBSEDML_EXTERN
+SedDocumentTemplate_t *
+SedDocumentTemplate_create ();
+
+
+/**
+ * Frees the given SedDocumentTemplate.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentTemplate_free (SedDocumentTemplate_t *sdt);
+
+
+/**
+ * Makes the new value of @p change a hole and returns its index.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addChangeHole (SedDocumentTemplate_t *sdt,
+                                   SedChangeAttribute_t *change);
+
+
+/**
+ * Makes the value of @p parameter a hole and returns its index.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addParameterHole (SedDocumentTemplate_t *sdt,
+                                      SedParameter_t *parameter);
+
+
+/**
+ * Makes the number of points of @p timeCourse a hole and returns its
+ * index.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_addTimeCourseHole (SedDocumentTemplate_t *sdt,
+                                       SedUniformTimeCourse_t *timeCourse);
+
+
+/**
+ * Writes @p doc with a default SedWriter and cuts it into segments and
+ * holes.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_compile (SedDocumentTemplate_t *sdt, SedDocument_t *doc);
+
+
+/**
+ * Sets hole @p n to the string @p value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setString (SedDocumentTemplate_t *sdt, unsigned int n,
+                               const char *value);
+
+
+/**
+ * Sets hole @p n to the number @p value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setDouble (SedDocumentTemplate_t *sdt, unsigned int n,
+                               double value);
+
+
+/**
+ * Sets hole @p n to the integer @p value.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentTemplate_setInt (SedDocumentTemplate_t *sdt, unsigned int n,
+                            int value);
+
+
+/**
+ * Returns the variant with the values of the holes, to be freed by the
+ * caller, or @c NULL if the template is not compiled.
+ */
+LIBSEDML_EXTERN
+char *
+SedDocumentTemplate_writeToString (const SedDocumentTemplate_t *sdt);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedDocumentTemplate_h */
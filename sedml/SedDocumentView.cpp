@@ -0,0 +1,827 @@
+/**
+ * @file    SedDocumentView.cpp
+ * @brief   Read-only views of binary encoded SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedDocumentView.h>
+#include <sedml/SedTypes.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates an invalid SedElementView.
+ */
+SedElementView::SedElementView ()
+  : mValid (false)
+  , mTypeCode (SEDML_UNKNOWN)
+  , mName ("")
+{
+}
+
+
+bool
+SedElementView::isValid () const
+{
+  return mValid;
+}
+
+
+int
+SedElementView::getTypeCode () const
+{
+  return mTypeCode;
+}
+
+
+const char*
+SedElementView::getElementName () const
+{
+  return mName;
+}
+
+
+/*
+ * Returns the value of the attribute name, or an empty string.
+ */
+const char*
+SedElementView::getAttribute (const std::string& name) const
+{
+  Input in = mBody;
+
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    const char* attributeName = in.readString();
+    in.readString();
+    in.readString();
+    const char* value = in.readString();
+
+    if (in.isGood() && name == attributeName) return value;
+  }
+
+  return "";
+}
+
+
+/*
+ * Returns true if the element has the attribute name.
+ */
+bool
+SedElementView::isSetAttribute (const std::string& name) const
+{
+  Input in = mBody;
+
+  const unsigned long count = in.readCount();
+  for (unsigned long i = 0; i < count && in.isGood(); ++i)
+  {
+    const char* attributeName = in.readString();
+    in.readString();
+    in.readString();
+    in.readString();
+
+    if (in.isGood() && name == attributeName) return true;
+  }
+
+  return false;
+}
+
+
+double
+SedElementView::getAttributeAsDouble (const std::string& name) const
+{
+  if (!isSetAttribute(name)) return std::numeric_limits<double>::quiet_NaN();
+  return strtod(getAttribute(name), NULL);
+}
+
+
+int
+SedElementView::getAttributeAsInt (const std::string& name) const
+{
+  return static_cast<int>(strtol(getAttribute(name), NULL, 10));
+}
+
+
+bool
+SedElementView::getAttributeAsBool (const std::string& name) const
+{
+  const char* value = getAttribute(name);
+  return strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+}
+
+
+const char*
+SedElementView::getId () const
+{
+  return getAttribute("id");
+}
+
+
+const char*
+SedElementView::getName () const
+{
+  return getAttribute("name");
+}
+
+
+const char*
+SedElementView::getMetaId () const
+{
+  return getAttribute("metaid");
+}
+
+
+const char*
+SedElementView::getSource () const
+{
+  return getAttribute("source");
+}
+
+
+const char*
+SedElementView::getLanguage () const
+{
+  return getAttribute("language");
+}
+
+
+const char*
+SedElementView::getTarget () const
+{
+  return getAttribute("target");
+}
+
+
+const char*
+SedElementView::getSymbol () const
+{
+  return getAttribute("symbol");
+}
+
+
+const char*
+SedElementView::getModelReference () const
+{
+  return getAttribute("modelReference");
+}
+
+
+const char*
+SedElementView::getSimulationReference () const
+{
+  return getAttribute("simulationReference");
+}
+
+
+const char*
+SedElementView::getTaskReference () const
+{
+  return getAttribute("taskReference");
+}
+
+
+const char*
+SedElementView::getDataReference () const
+{
+  return getAttribute("dataReference");
+}
+
+
+const char*
+SedElementView::getKisaoID () const
+{
+  return getAttribute("kisaoID");
+}
+
+
+bool
+SedElementView::isSetNotes () const
+{
+  Input in = mBody;
+  return (readFlags(in) & SedBinaryCodec::HAS_NOTES) != 0;
+}
+
+
+bool
+SedElementView::isSetAnnotation () const
+{
+  Input in = mBody;
+  return (readFlags(in) & SedBinaryCodec::HAS_ANNOTATION) != 0;
+}
+
+
+bool
+SedElementView::isSetMath () const
+{
+  Input in = mBody;
+  return (readFlags(in) & SedBinaryCodec::HAS_MATH) != 0;
+}
+
+
+/*
+ * Returns the number of elements directly contained in the element.
+ */
+unsigned int
+SedElementView::getNumChildElements () const
+{
+  unsigned long numChildren = 0;
+  getChildren(numChildren);
+  return static_cast<unsigned int>(numChildren);
+}
+
+
+/*
+ * Returns the nth element directly contained in the element.
+ */
+SedElementView
+SedElementView::getChildElement (unsigned int n) const
+{
+  SedElementView child = getFirstChild();
+  for (unsigned int i = 0; i < n && child.isValid(); ++i)
+  {
+    child = child.getNextSibling();
+  }
+  return child;
+}
+
+
+/*
+ * Returns the first element directly contained in the element.
+ */
+SedElementView
+SedElementView::getFirstChild () const
+{
+  unsigned long numChildren = 0;
+  Input in = getChildren(numChildren);
+  return (numChildren > 0) ? readEntry(in, true) : SedElementView();
+}
+
+
+/*
+ * Returns the element following this one in its parent; the children of
+ * an element are the last thing in its block, so they end with it.
+ */
+SedElementView
+SedElementView::getNextSibling () const
+{
+  if (!mValid || mFollowing.atEnd()) return SedElementView();
+
+  Input in = mFollowing;
+  return readEntry(in, true);
+}
+
+
+/*
+ * Returns the first element directly contained in the element whose
+ * element name is name.
+ */
+SedElementView
+SedElementView::getChild (const std::string& name) const
+{
+  for (SedElementView child = getFirstChild(); child.isValid();
+       child = child.getNextSibling())
+  {
+    if (name == child.getElementName()) return child;
+  }
+  return SedElementView();
+}
+
+
+/*
+ * Returns the first element directly contained in the element whose id
+ * is id.
+ */
+SedElementView
+SedElementView::getChildById (const std::string& id) const
+{
+  for (SedElementView child = getFirstChild(); child.isValid();
+       child = child.getNextSibling())
+  {
+    if (id == child.getId()) return child;
+  }
+  return SedElementView();
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Reads an element as SedBinaryCodec writes it: its slot, if it is a
+ * child, type code, element name and block.
+ */
+SedElementView
+SedElementView::readEntry (Input& in, bool hasSlot)
+{
+  if (hasSlot) in.readUnsigned();
+
+  SedElementView view;
+  const unsigned long typeCode = in.readUnsigned();
+  const char*         name     = in.readString();
+  Input               body     = in.readBlock();
+
+  if (!in.isGood()) return SedElementView();
+
+  view.mValid     = true;
+  view.mTypeCode  = static_cast<int>(typeCode);
+  view.mName      = name;
+  view.mBody      = body;
+  view.mFollowing = in;
+
+  return view;
+}
+
+
+/*
+ * Skips the attributes of the element in body and reads its flags.
+ */
+unsigned long
+SedElementView::readFlags (Input& body) const
+{
+  const unsigned long count = body.readCount();
+  for (unsigned long i = 0; i < 4 * count && body.isGood(); ++i)
+  {
+    body.readUnsigned();
+  }
+
+  return body.readUnsigned();
+}
+
+
+/*
+ * Returns an input positioned at the first child entry of the element,
+ * storing the number of children in numChildren.
+ */
+SedBinaryCodec::Input
+SedElementView::getChildren (unsigned long& numChildren) const
+{
+  Input in = mBody;
+
+  const unsigned long flags = readFlags(in);
+  if (flags & SedBinaryCodec::HAS_NOTES)      in.readBlock();
+  if (flags & SedBinaryCodec::HAS_ANNOTATION) in.readBlock();
+  if (flags & SedBinaryCodec::HAS_MATH)       in.readBlock();
+
+  numChildren = in.readCount();
+  if (!in.isGood()) numChildren = 0;
+
+  return in;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a SedDocumentView that is not open.
+ */
+SedDocumentView::SedDocumentView ()
+  : mData (NULL)
+  , mLength (0)
+  , mMapped (false)
+  , mLevel (0)
+  , mVersion (0)
+{
+}
+
+
+/*
+ * Destroys this SedDocumentView.
+ */
+SedDocumentView::~SedDocumentView ()
+{
+  close();
+}
+
+
+/*
+ * Maps the file filename into memory and opens it.
+ */
+int
+SedDocumentView::openFile (const std::string& filename)
+{
+  close();
+
+  const char* view = NULL;
+  size_t      size = 0;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+      && (unsigned long long)fileSize.QuadPart < (size_t)-1)
+    {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping != NULL)
+      {
+        // the view keeps the mapping alive once both handles are closed
+        view = static_cast<const char*>
+          (MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        size = (size_t)fileSize.QuadPart;
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+  }
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      size = (size_t)st.st_size;
+
+      void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapped != MAP_FAILED) view = static_cast<const char*>(mapped);
+    }
+    ::close(fd);
+  }
+#endif
+
+  if (view == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  mData   = view;
+  mLength = size;
+  mMapped = true;
+
+  return readDocument();
+}
+
+
+/*
+ * Opens the length bytes at data, without copying them.
+ */
+int
+SedDocumentView::setBuffer (const char* data, size_t length)
+{
+  close();
+
+  if (data == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mData   = data;
+  mLength = length;
+
+  return readDocument();
+}
+
+
+/*
+ * Closes this view.
+ */
+void
+SedDocumentView::close ()
+{
+  unmap();
+
+  mData     = NULL;
+  mLength   = 0;
+  mLevel    = 0;
+  mVersion  = 0;
+  mDocument = SedElementView();
+}
+
+
+bool
+SedDocumentView::isOpen () const
+{
+  return mDocument.isValid();
+}
+
+
+/*
+ * Returns a new SedDocument decoded from the encoding.
+ */
+SedDocument*
+SedDocumentView::toDocument () const
+{
+  return isOpen() ? SedBinaryCodec::decode(mData, mLength) : NULL;
+}
+
+
+unsigned int
+SedDocumentView::getLevel () const
+{
+  return mLevel;
+}
+
+
+unsigned int
+SedDocumentView::getVersion () const
+{
+  return mVersion;
+}
+
+
+SedElementView
+SedDocumentView::getDocumentElement () const
+{
+  return mDocument;
+}
+
+
+SedElementView
+SedDocumentView::getListOfSimulations () const
+{
+  return mDocument.getChild("listOfSimulations");
+}
+
+
+unsigned int
+SedDocumentView::getNumSimulations () const
+{
+  return getListOfSimulations().getNumChildElements();
+}
+
+
+SedElementView
+SedDocumentView::getSimulation (unsigned int n) const
+{
+  return getListOfSimulations().getChildElement(n);
+}
+
+
+SedElementView
+SedDocumentView::getSimulation (const std::string& sid) const
+{
+  return getListOfSimulations().getChildById(sid);
+}
+
+
+SedElementView
+SedDocumentView::getListOfModels () const
+{
+  return mDocument.getChild("listOfModels");
+}
+
+
+unsigned int
+SedDocumentView::getNumModels () const
+{
+  return getListOfModels().getNumChildElements();
+}
+
+
+SedElementView
+SedDocumentView::getModel (unsigned int n) const
+{
+  return getListOfModels().getChildElement(n);
+}
+
+
+SedElementView
+SedDocumentView::getModel (const std::string& sid) const
+{
+  return getListOfModels().getChildById(sid);
+}
+
+
+SedElementView
+SedDocumentView::getListOfTasks () const
+{
+  return mDocument.getChild("listOfTasks");
+}
+
+
+unsigned int
+SedDocumentView::getNumTasks () const
+{
+  return getListOfTasks().getNumChildElements();
+}
+
+
+SedElementView
+SedDocumentView::getTask (unsigned int n) const
+{
+  return getListOfTasks().getChildElement(n);
+}
+
+
+SedElementView
+SedDocumentView::getTask (const std::string& sid) const
+{
+  return getListOfTasks().getChildById(sid);
+}
+
+
+SedElementView
+SedDocumentView::getListOfDataGenerators () const
+{
+  return mDocument.getChild("listOfDataGenerators");
+}
+
+
+unsigned int
+SedDocumentView::getNumDataGenerators () const
+{
+  return getListOfDataGenerators().getNumChildElements();
+}
+
+
+SedElementView
+SedDocumentView::getDataGenerator (unsigned int n) const
+{
+  return getListOfDataGenerators().getChildElement(n);
+}
+
+
+SedElementView
+SedDocumentView::getDataGenerator (const std::string& sid) const
+{
+  return getListOfDataGenerators().getChildById(sid);
+}
+
+
+SedElementView
+SedDocumentView::getListOfOutputs () const
+{
+  return mDocument.getChild("listOfOutputs");
+}
+
+
+unsigned int
+SedDocumentView::getNumOutputs () const
+{
+  return getListOfOutputs().getNumChildElements();
+}
+
+
+SedElementView
+SedDocumentView::getOutput (unsigned int n) const
+{
+  return getListOfOutputs().getChildElement(n);
+}
+
+
+SedElementView
+SedDocumentView::getOutput (const std::string& sid) const
+{
+  return getListOfOutputs().getChildById(sid);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Reads the header of the encoding and the entry of the document, closing
+ * this view if they cannot be read.
+ */
+int
+SedDocumentView::readDocument ()
+{
+  SedBinaryCodec::Input in(mData, mLength);
+  if (in.readHeader())
+  {
+    mLevel   = static_cast<unsigned int>(in.readUnsigned());
+    mVersion = static_cast<unsigned int>(in.readUnsigned());
+
+    const unsigned long numNamespaces = in.readCount();
+    for (unsigned long i = 0; i < numNamespaces && in.isGood(); ++i)
+    {
+      in.readString();
+      in.readString();
+    }
+
+    mDocument = SedElementView::readEntry(in, false);
+  }
+
+  if (mDocument.getTypeCode() != SEDML_DOCUMENT)
+  {
+    close();
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+void
+SedDocumentView::unmap ()
+{
+  if (!mMapped) return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(mData);
+#else
+  munmap(const_cast<char*>(mData), mLength);
+#endif
+
+  mMapped = false;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDocumentView_t *
+SedDocumentView_create ()
+{
+  return new SedDocumentView();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentView_free (SedDocumentView_t *sdv)
+{
+  delete sdv;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_openFile (SedDocumentView_t *sdv, const char *filename)
+{
+  if (sdv == NULL) return LIBSEDML_INVALID_OBJECT;
+  return (filename != NULL) ? sdv->openFile(filename)
+                            : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_setBuffer (SedDocumentView_t *sdv, const char *data,
+                           size_t length)
+{
+  return (sdv != NULL) ? sdv->setBuffer(data, length)
+                       : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentView_close (SedDocumentView_t *sdv)
+{
+  if (sdv != NULL) sdv->close();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_isOpen (const SedDocumentView_t *sdv)
+{
+  return (sdv != NULL && sdv->isOpen()) ? 1 : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocumentView_toDocument (const SedDocumentView_t *sdv)
+{
+  return (sdv != NULL) ? sdv->toDocument() : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,508 @@
+/**
+ * @file    SedDocumentView.h
+ * @brief   Read-only views of binary encoded SedDocuments
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedDocumentView
+ * @ingroup Core
+ * @brief A read-only view of a document encoded by SedBinaryCodec.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedDocumentView reads an encoding in place, typically a file it maps
+ * into memory with openFile(), without building a SedDocument: opening
+ * one costs next to nothing whatever the size of the document, and the
+ * pages of a file mapped by several processes are shared between them.
+ * Its accessors mirror those of SedDocument, and return SedElementView
+ * objects whose own accessors mirror those of the other classes:
+ *
+ * @code{.cpp}
+SedDocumentView view;
+if (view.openFile("experiment.sedb") == LIBSEDML_OPERATION_SUCCESS)
+{
+  for (unsigned int n = 0; n < view.getNumTasks(); ++n)
+  {
+    std::cout << view.getTask(n).getModelReference() << std::endl;
+  }
+}
+@endcode
+ *
+ * Every string a view returns points into the encoding, and every
+ * SedElementView reads from it: they are valid until the SedDocumentView
+ * is closed or destroyed.  A corrupt encoding does not make a view read
+ * out of bounds; the elements it cannot read are simply invalid.
+ *
+ * The nth item of a list is found by skipping the n before it; to go
+ * through a long list use SedElementView::getFirstChild() and
+ * SedElementView::getNextSibling() on getListOfTasks() and the like.
+ *
+ * @class SedElementView
+ * @ingroup Core
+ * @brief A read-only view of an element of a SedDocumentView.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedElementView objects are small values, cheap to copy.  An invalid
+ * view, returned for elements that do not exist, has type code
+ * @link SedTypeCode_t#SEDML_UNKNOWN SEDML_UNKNOWN@endlink, no attributes
+ * and no children.
+ */
+
+#ifndef SedDocumentView_h
+#define SedDocumentView_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedBinaryCodec.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedElementView
+{
+public:
+
+  /**
+   * Creates an invalid SedElementView.
+   */
+  SedElementView ();
+
+
+  /**
+   * @return @c true if this view refers to an element.
+   */
+  bool isValid () const;
+
+
+  /**
+   * @return the type code of the element, as SedBase::getTypeCode()
+   * would return it.
+   */
+  int getTypeCode () const;
+
+
+  /**
+   * @return the element name of the element, as SedBase::getElementName()
+   * would return it.
+   */
+  const char* getElementName () const;
+
+
+  /**
+   * @return the value of the attribute @p name of the element, or an
+   * empty string if it has none.
+   */
+  const char* getAttribute (const std::string& name) const;
+
+
+  /**
+   * @return @c true if the element has the attribute @p name.
+   */
+  bool isSetAttribute (const std::string& name) const;
+
+
+  /**
+   * @return the value of the attribute @p name as a double, or NaN if it
+   * is not set.
+   */
+  double getAttributeAsDouble (const std::string& name) const;
+
+
+  /**
+   * @return the value of the attribute @p name as an integer, or 0 if it
+   * is not set.
+   */
+  int getAttributeAsInt (const std::string& name) const;
+
+
+  /**
+   * @return the value of the attribute @p name as a boolean, that is
+   * @c true if it is @c "true" or @c "1".
+   */
+  bool getAttributeAsBool (const std::string& name) const;
+
+
+  /** @return the @c id attribute. */
+  const char* getId () const;
+
+  /** @return the @c name attribute. */
+  const char* getName () const;
+
+  /** @return the @c metaid attribute. */
+  const char* getMetaId () const;
+
+  /** @return the @c source attribute of a model. */
+  const char* getSource () const;
+
+  /** @return the @c language attribute of a model. */
+  const char* getLanguage () const;
+
+  /** @return the @c target attribute of a change or variable. */
+  const char* getTarget () const;
+
+  /** @return the @c symbol attribute of a variable. */
+  const char* getSymbol () const;
+
+  /** @return the @c modelReference attribute of a task or variable. */
+  const char* getModelReference () const;
+
+  /** @return the @c simulationReference attribute of a task. */
+  const char* getSimulationReference () const;
+
+  /** @return the @c taskReference attribute of a variable. */
+  const char* getTaskReference () const;
+
+  /** @return the @c dataReference attribute of a data set. */
+  const char* getDataReference () const;
+
+  /** @return the @c kisaoID attribute of an algorithm. */
+  const char* getKisaoID () const;
+
+
+  /**
+   * @return @c true if the element has notes.
+   */
+  bool isSetNotes () const;
+
+
+  /**
+   * @return @c true if the element has an annotation.
+   */
+  bool isSetAnnotation () const;
+
+
+  /**
+   * @return @c true if the element has math.
+   */
+  bool isSetMath () const;
+
+
+  /**
+   * @return the number of elements directly contained in the element: the
+   * items of a list, or the lists and other objects of anything else.
+   */
+  unsigned int getNumChildElements () const;
+
+
+  /**
+   * @return the nth element directly contained in the element.
+   */
+  SedElementView getChildElement (unsigned int n) const;
+
+
+  /**
+   * @return the first element directly contained in the element.
+   */
+  SedElementView getFirstChild () const;
+
+
+  /**
+   * @return the element following this one in its parent.
+   */
+  SedElementView getNextSibling () const;
+
+
+  /**
+   * @return the first element directly contained in the element whose
+   * element name is @p name, such as @c "listOfVariables" or
+   * @c "algorithm".
+   */
+  SedElementView getChild (const std::string& name) const;
+
+
+  /**
+   * @return the first element directly contained in the element whose
+   * @c id is @p id, such as the item of a list with that id.
+   */
+  SedElementView getChildById (const std::string& id) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  friend class SedDocumentView;
+
+  typedef SedBinaryCodec::Input Input;
+
+  /* reads the element in the child entry in starts at */
+  static SedElementView readEntry (Input& in, bool hasSlot);
+
+  /* returns an input positioned at the first child entry */
+  Input getChildren (unsigned long& numChildren) const;
+
+  unsigned long readFlags (Input& body) const;
+
+
+  bool         mValid;
+  int          mTypeCode;
+  const char*  mName;
+  Input        mBody;
+  Input        mFollowing;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedDocumentView
+{
+public:
+
+  /**
+   * Creates a SedDocumentView that is not open.
+   */
+  SedDocumentView ();
+
+
+  /**
+   * Destroys this SedDocumentView, closing it.
+   */
+  virtual ~SedDocumentView ();
+
+
+  /**
+   * Maps the file @p filename, written from the result of
+   * SedBinaryCodec::encode(), into memory read-only and opens it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be mapped
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if it is not an encoding of a document in this version of the format
+   */
+  int openFile (const std::string& filename);
+
+
+  /**
+   * Opens the @p length bytes at @p data, which must stay unchanged for as
+   * long as this view is open; they are not copied.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if they are not an encoding of a document in this version of the
+   * format
+   */
+  int setBuffer (const char* data, size_t length);
+
+
+  /**
+   * Closes this view, unmapping its file if it has one.
+   */
+  void close ();
+
+
+  /**
+   * @return @c true if this view is open.
+   */
+  bool isOpen () const;
+
+
+  /**
+   * @return a new SedDocument decoded from the encoding, or @c NULL if
+   * this view is not open; the caller owns it.
+   */
+  SedDocument* toDocument () const;
+
+
+  /** @return the SED-ML level of the document. */
+  unsigned int getLevel () const;
+
+  /** @return the SED-ML version of the document. */
+  unsigned int getVersion () const;
+
+  /** @return the view of the @c sedML element itself. */
+  SedElementView getDocumentElement () const;
+
+
+  /** @return the view of the listOfSimulations. */
+  SedElementView getListOfSimulations () const;
+
+  /** @return the number of simulations. */
+  unsigned int getNumSimulations () const;
+
+  /** @return the nth simulation. */
+  SedElementView getSimulation (unsigned int n) const;
+
+  /** @return the simulation with the given id. */
+  SedElementView getSimulation (const std::string& sid) const;
+
+
+  /** @return the view of the listOfModels. */
+  SedElementView getListOfModels () const;
+
+  /** @return the number of models. */
+  unsigned int getNumModels () const;
+
+  /** @return the nth model. */
+  SedElementView getModel (unsigned int n) const;
+
+  /** @return the model with the given id. */
+  SedElementView getModel (const std::string& sid) const;
+
+
+  /** @return the view of the listOfTasks. */
+  SedElementView getListOfTasks () const;
+
+  /** @return the number of tasks. */
+  unsigned int getNumTasks () const;
+
+  /** @return the nth task. */
+  SedElementView getTask (unsigned int n) const;
+
+  /** @return the task with the given id. */
+  SedElementView getTask (const std::string& sid) const;
+
+
+  /** @return the view of the listOfDataGenerators. */
+  SedElementView getListOfDataGenerators () const;
+
+  /** @return the number of data generators. */
+  unsigned int getNumDataGenerators () const;
+
+  /** @return the nth data generator. */
+  SedElementView getDataGenerator (unsigned int n) const;
+
+  /** @return the data generator with the given id. */
+  SedElementView getDataGenerator (const std::string& sid) const;
+
+
+  /** @return the view of the listOfOutputs. */
+  SedElementView getListOfOutputs () const;
+
+  /** @return the number of outputs. */
+  unsigned int getNumOutputs () const;
+
+  /** @return the nth output. */
+  SedElementView getOutput (unsigned int n) const;
+
+  /** @return the output with the given id. */
+  SedElementView getOutput (const std::string& sid) const;
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedDocumentView (const SedDocumentView& orig);
+  SedDocumentView& operator= (const SedDocumentView& rhs);
+
+  int readDocument ();
+
+  void unmap ();
+
+
+  const char*     mData;
+  size_t          mLength;
+  bool            mMapped;
+
+  unsigned int    mLevel;
+  unsigned int    mVersion;
+  SedElementView  mDocument;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedDocumentView that is not open and returns it.
+ */
+LIBSEDML_EXTERN
+SedDocumentView_t *
+SedDocumentView_create ();
+
+
+/**
+ * Frees the given SedDocumentView, closing it.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentView_free (SedDocumentView_t *sdv);
+
+
+/**
+ * Maps the file @p filename into memory and opens it in @p sdv.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_openFile (SedDocumentView_t *sdv, const char *filename);
+
+
+/**
+ * Opens the @p length bytes at @p data in @p sdv, without copying them.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_setBuffer (SedDocumentView_t *sdv, const char *data,
+                           size_t length);
+
+
+/**
+ * Closes @p sdv.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentView_close (SedDocumentView_t *sdv);
+
+
+/**
+ * Returns 1 if @p sdv is open, 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedDocumentView_isOpen (const SedDocumentView_t *sdv);
+
+
+/**
+ * Returns a new SedDocument decoded from the encoding @p sdv views.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocumentView_toDocument (const SedDocumentView_t *sdv);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedDocumentView_h */
@@ -0,0 +1,327 @@
+/**
+ * @file    SedElementIterator.cpp
+ * @brief   Iterates over a tree of Sed objects without recursion
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedBase.h>
+#include <sedml/SedListOf.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates an iterator past the end of any traversal.
+ */
+SedElementIterator::SedElementIterator ()
+  : mSkipChildren (false)
+  , mType (SEDML_UNKNOWN)
+{
+}
+
+
+/*
+ * Creates an iterator positioned at root.
+ */
+SedElementIterator::SedElementIterator (const SedBase* root)
+  : mSkipChildren (false)
+  , mType (SEDML_UNKNOWN)
+{
+  if (root != NULL) push(root, 0);
+}
+
+
+/*
+ * Creates an iterator walking root and stopping at objects of the given
+ * type only.
+ */
+SedElementIterator::SedElementIterator (const SedBase* root, int typeCode)
+  : mSkipChildren (false)
+  , mType (typeCode)
+{
+  if (root == NULL) return;
+
+  push(root, 0);
+  if (!isOfType(root->getTypeCode(), mType)) ++(*this);
+}
+
+
+/*
+ * Returns the current object.
+ */
+const SedBase&
+SedElementIterator::operator* () const
+{
+  return *mStack.back().element;
+}
+
+
+/*
+ * Returns the current object.
+ */
+const SedBase*
+SedElementIterator::operator-> () const
+{
+  return mStack.back().element;
+}
+
+
+/*
+ * Moves to the next object in document order.
+ */
+SedElementIterator&
+SedElementIterator::operator++ ()
+{
+  advance();
+
+  if (mType == SEDML_UNKNOWN) return *this;
+
+  while (!mStack.empty()
+    && !isOfType(mStack.back().element->getTypeCode(), mType))
+  {
+    advance();
+  }
+
+  return *this;
+}
+
+
+/*
+ * Moves to the next object in document order, returning the iterator
+ * before it moved.
+ */
+SedElementIterator
+SedElementIterator::operator++ (int)
+{
+  SedElementIterator before(*this);
+  ++(*this);
+  return before;
+}
+
+
+/*
+ * Returns true if both iterators are at the same position.
+ */
+bool
+SedElementIterator::operator== (const SedElementIterator& rhs) const
+{
+  if (mStack.empty() || rhs.mStack.empty())
+  {
+    return mStack.empty() && rhs.mStack.empty();
+  }
+
+  return mStack.size() == rhs.mStack.size()
+      && mStack.back().element == rhs.mStack.back().element;
+}
+
+
+/*
+ * Returns true if the iterators are at different positions.
+ */
+bool
+SedElementIterator::operator!= (const SedElementIterator& rhs) const
+{
+  return !(*this == rhs);
+}
+
+
+/*
+ * Returns the depth of the current object below the first one.
+ */
+unsigned int
+SedElementIterator::getDepth () const
+{
+  return mStack.empty() ? 0 : (unsigned int)(mStack.size() - 1);
+}
+
+
+/*
+ * Makes the next increment skip the children of the current object.
+ */
+void
+SedElementIterator::skipChildren ()
+{
+  mSkipChildren = true;
+}
+
+
+/*
+ * Returns true if an object of type typeCode is also of type type.
+ */
+bool
+SedElementIterator::isOfType (int typeCode, int type)
+{
+  if (typeCode == type || type == SEDML_UNKNOWN) return true;
+
+  switch (type)
+  {
+  case SEDML_CHANGE:
+    return typeCode == SEDML_CHANGE_ATTRIBUTE
+        || typeCode == SEDML_CHANGE_REMOVEXML
+        || typeCode == SEDML_CHANGE_COMPUTECHANGE;
+  case SEDML_OUTPUT:
+    return typeCode == SEDML_OUTPUT_REPORT
+        || typeCode == SEDML_OUTPUT_PLOT2D
+        || typeCode == SEDML_OUTPUT_PLOT3D;
+  case SEDML_SIMULATION:
+    return typeCode == SEDML_SIMULATION_UNIFORMTIMECOURSE;
+  case SEDML_OUTPUT_CURVE:
+    return typeCode == SEDML_OUTPUT_SURFACE;
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Returns false if neither an object of type typeCode nor anything it
+ * contains can be of type type.
+ */
+bool
+SedElementIterator::mayContain (int typeCode, int type)
+{
+  if (type == SEDML_UNKNOWN || isOfType(typeCode, type)) return true;
+
+  switch (typeCode)
+  {
+  case SEDML_MODEL:
+  case SEDML_CHANGE:
+  case SEDML_CHANGE_COMPUTECHANGE:
+  case SEDML_DATAGENERATOR:
+    // a model holds changes, and a computeChange and a dataGenerator hold
+    // variables and parameters
+    return type == SEDML_LIST_OF
+        || (typeCode != SEDML_DATAGENERATOR && isOfType(type, SEDML_CHANGE))
+        || type == SEDML_VARIABLE
+        || type == SEDML_PARAMETER;
+
+  case SEDML_OUTPUT:
+  case SEDML_OUTPUT_REPORT:
+  case SEDML_OUTPUT_PLOT2D:
+  case SEDML_OUTPUT_PLOT3D:
+    return type == SEDML_LIST_OF
+        || type == SEDML_OUTPUT_DATASET
+        || type == SEDML_OUTPUT_CURVE
+        || type == SEDML_OUTPUT_SURFACE;
+
+  case SEDML_SIMULATION:
+  case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+    return type == SEDML_SIMULATION_ALGORITHM;
+
+  case SEDML_CHANGE_ATTRIBUTE:
+  case SEDML_CHANGE_REMOVEXML:
+  case SEDML_VARIABLE:
+  case SEDML_PARAMETER:
+  case SEDML_TASK:
+  case SEDML_OUTPUT_DATASET:
+  case SEDML_OUTPUT_CURVE:
+  case SEDML_OUTPUT_SURFACE:
+  case SEDML_SIMULATION_ALGORITHM:
+    return false;
+
+  default:
+    // the document, and lists of unknown items
+    return true;
+  }
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Moves to the next object in document order, whatever its type, without
+ * descending into objects that cannot contain one of the type looked for.
+ */
+void
+SedElementIterator::advance ()
+{
+  if (mStack.empty()) return;
+
+  // the first child of the current object, unless it is to be skipped
+  const SedBase* current = mStack.back().element;
+  const unsigned int numChildren =
+    (mSkipChildren || isPruned(current)) ? 0 : current->getNumChildElements();
+  mSkipChildren = false;
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    const SedBase* child = current->getChildElement(i);
+    if (child != NULL)
+    {
+      push(child, i);
+      return;
+    }
+  }
+
+  // otherwise the next sibling of the current object or of the nearest of
+  // its ancestors that has one
+  while (mStack.size() > 1)
+  {
+    const unsigned int index = mStack.back().index;
+    mStack.pop_back();
+
+    const SedBase* parent = mStack.back().element;
+    const unsigned int numSiblings = parent->getNumChildElements();
+
+    for (unsigned int i = index + 1; i < numSiblings; ++i)
+    {
+      const SedBase* sibling = parent->getChildElement(i);
+      if (sibling != NULL)
+      {
+        push(sibling, i);
+        return;
+      }
+    }
+  }
+
+  mStack.clear();
+}
+
+
+/*
+ * Returns true if nothing below element can be of the type looked for.
+ */
+bool
+SedElementIterator::isPruned (const SedBase* element) const
+{
+  if (mType == SEDML_UNKNOWN) return false;
+
+  const int typeCode = element->getTypeCode();
+  if (typeCode == SEDML_LIST_OF)
+  {
+    const int itemType = static_cast<const SedListOf*>(element)->getItemTypeCode();
+    return itemType != SEDML_UNKNOWN && !mayContain(itemType, mType);
+  }
+
+  return !mayContain(typeCode, mType);
+}
+
+
+/*
+ * Makes element, the index-th child of the current object, current.
+ */
+void
+SedElementIterator::push (const SedBase* element, unsigned int index)
+{
+  Frame frame;
+  frame.element = element;
+  frame.index   = index;
+  mStack.push_back(frame);
+}
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,199 @@
+/**
+ * @file    SedElementIterator.h
+ * @brief   Iterates over a tree of Sed objects without recursion
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedElementIterator
+ * @ingroup Core
+ * @brief Walks a Sed object and everything below it in document order.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedElementIterator is obtained from SedBase::begin(), usually that of
+ * a SedDocument, and visits that object and then, in pre-order, every
+ * object below it that SedBase::getChildElement() returns, including the
+ * SedListOf objects; it equals SedBase::end() when it has passed the last
+ * of them:
+ *
+ * @code{.cpp}
+for (SedElementIterator it = doc->begin(); it != doc->end(); ++it)
+{
+  if (it->getTypeCode() == SEDML_TASK) ...
+}
+@endcode
+ *
+ * An iterator obtained from SedBase::beginOfType() only stops at objects
+ * of the given type code, or of a class derived from the class it stands
+ * for (SEDML_CHANGE also matches a SedChangeAttribute, SEDML_OUTPUT a
+ * SedPlot2D, and so on).  It does not descend into objects, SedListOf
+ * objects included, that cannot contain an object of that type, so finding
+ * all SedVariable objects of a document never walks its tasks or outputs:
+ *
+ * @code{.cpp}
+for (SedElementIterator it = doc->beginOfType(SEDML_VARIABLE);
+     it != doc->end(); ++it)
+{
+  const SedVariable& var = static_cast<const SedVariable&>(*it);
+  ...
+}
+@endcode
+ *
+ * The position in the tree is kept on an explicit stack, so documents of
+ * any depth can be walked without recursion and without allocating a List
+ * of their objects.  The objects walked must not be added or removed while
+ * an iterator is in use.
+ */
+
+#ifndef SedElementIterator_h
+#define SedElementIterator_h
+
+
+#include <sedml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+
+
+class LIBSEDML_EXTERN SedElementIterator
+{
+public:
+
+  /**
+   * Creates an iterator past the end of any traversal.
+   */
+  SedElementIterator ();
+
+
+  /**
+   * Creates an iterator positioned at @p root, walking @p root and
+   * everything below it.
+   */
+  explicit SedElementIterator (const SedBase* root);
+
+
+  /**
+   * Creates an iterator walking @p root and everything below it, stopping
+   * only at objects of type @p typeCode, and positioned at the first of
+   * them.
+   *
+   * @param root the object to begin at.
+   * @param typeCode the type code (e.g., SEDML_VARIABLE) to look for;
+   * SEDML_UNKNOWN stops at every object.
+   */
+  SedElementIterator (const SedBase* root, int typeCode);
+
+
+  /**
+   * @return the current object.
+   */
+  const SedBase& operator* () const;
+
+
+  /**
+   * @return the current object.
+   */
+  const SedBase* operator-> () const;
+
+
+  /**
+   * Moves to the next object in document order.
+   */
+  SedElementIterator& operator++ ();
+
+
+  /**
+   * Moves to the next object in document order.
+   *
+   * @return the iterator before it moved.
+   */
+  SedElementIterator operator++ (int);
+
+
+  /**
+   * @return @c true if both iterators are at the same position.
+   */
+  bool operator== (const SedElementIterator& rhs) const;
+
+
+  /**
+   * @return @c true if the iterators are at different positions.
+   */
+  bool operator!= (const SedElementIterator& rhs) const;
+
+
+  /**
+   * @return how far below the object the traversal began at the current
+   * object is; the first object is at depth 0.
+   */
+  unsigned int getDepth () const;
+
+
+  /**
+   * Makes the next increment skip the children of the current object.
+   */
+  void skipChildren ();
+
+
+  /**
+   * @return @c true if an object of type @p typeCode is also of type
+   * @p type, that is if the codes are equal or @p type is that of a class
+   * @p typeCode is derived from.
+   */
+  static bool isOfType (int typeCode, int type);
+
+
+  /**
+   * @return @c false if neither an object of type @p typeCode nor anything
+   * it contains can be of type @p type.  For a SedListOf, @p typeCode is
+   * its item type code.
+   */
+  static bool mayContain (int typeCode, int type);
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Frame
+  {
+    const SedBase* element;
+    unsigned int   index;
+  };
+
+  void push (const SedBase* element, unsigned int index);
+
+  void advance ();
+
+  bool isPruned (const SedBase* element) const;
+
+  std::vector<Frame>  mStack;
+  bool                mSkipChildren;
+  int                 mType;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedElementIterator_h */
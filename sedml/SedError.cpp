@@ -98,37 +98,56 @@ std::string SedError::stringForSeverity(unsigned int code) const
 }
 
 /*
- * Table of strings corresponding to the values from SedErrorCategory_t.
- * The enumeration starts at a number higher than 0, so each entry is keyed
- * by its enum value.
- *
- * A similar table for severity strings is currently unnecessary because
- * libSed never returns anything more than the XMLSeverityCode_t values.
+ * @return the index of the entry for code in errorTable, whose entries
+ * are in increasing order of their codes, or 0 (the entry of UnknownError)
+ * if there is none.
  */
-static struct sbmlCategoryString {
-  unsigned int catCode;
-  const char * catString;
-} sbmlCategoryStringTable[] = {
-  { LIBSEDML_CAT_SEDML,                   "General Sed conformance"    },
-  { LIBSEDML_CAT_GENERAL_CONSISTENCY,	"Sed component consistency"  },
-  { LIBSEDML_CAT_IDENTIFIER_CONSISTENCY,	"Sed identifier consistency" },
-  { LIBSEDML_CAT_MATHML_CONSISTENCY,     "MathML consistency"          },
-  { LIBSEDML_CAT_INTERNAL_CONSISTENCY,   "Internal consistency"        }
-};
-
-static unsigned int sbmlCategoryStringTableSize
-  = sizeof(sbmlCategoryStringTable)/sizeof(sbmlCategoryStringTable[0]);
+static unsigned int
+getErrorTableIndex(unsigned int code)
+{
+  unsigned int low  = 0;
+  unsigned int high = sizeof(errorTable)/sizeof(errorTable[0]);
+
+  while (low < high)
+  {
+    unsigned int middle = low + (high - low) / 2;
+
+    if (errorTable[middle].code < code)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  if (low < sizeof(errorTable)/sizeof(errorTable[0])
+      && errorTable[low].code == code)
+    return low;
+
+  return 0;
+}
+
 
 /*
  * @return the category as a string for the given @n code.
+ *
+ * A similar table for severity strings is currently unnecessary because
+ * libSed never returns anything more than the XMLSeverityCode_t values.
  */
 std::string SedError::stringForCategory(unsigned int code) const
 {
-  if ( code >= LIBSEDML_CAT_SEDML )
+  switch (code)
   {
-    for ( unsigned int i = 0; i < sbmlCategoryStringTableSize; i++ )
-      if ( sbmlCategoryStringTable[i].catCode == code )
-        return sbmlCategoryStringTable[i].catString;
+    case LIBSEDML_CAT_SEDML:
+      return "General Sed conformance";
+    case LIBSEDML_CAT_GENERAL_CONSISTENCY:
+      return "Sed component consistency";
+    case LIBSEDML_CAT_IDENTIFIER_CONSISTENCY:
+      return "Sed identifier consistency";
+    case LIBSEDML_CAT_MATHML_CONSISTENCY:
+      return "MathML consistency";
+    case LIBSEDML_CAT_INTERNAL_CONSISTENCY:
+      return "Internal consistency";
+    default:
+      break;
   }
 
   return XMLError::stringForCategory(code);
@@ -162,17 +181,7 @@ SedError::SedError (  const unsigned int errorId
   else if ( mErrorId > XMLErrorCodesUpperBound
             && mErrorId < SedCodesUpperBound )
   {
-    unsigned int tableSize = sizeof(errorTable)/sizeof(errorTable[0]);
-    unsigned int index = 0;
-
-    for ( unsigned int i = 0; i < tableSize; i++ )
-    {
-      if ( mErrorId == errorTable[i].code )
-      {
-        index = i;
-        break;
-      }
-    }
+    unsigned int index = getErrorTableIndex(mErrorId);
 
     if ( index == 0 && mErrorId != UnknownError )
     {
@@ -205,7 +214,10 @@ SedError::SedError (  const unsigned int errorId
       mErrorId = InconsistentArgUnits;
     }
 
-    ostringstream newMsg;
+    // the message is assembled in a string, not a stream: constructing an
+    // ostringstream for every error logged dominates validating a batch
+    // of broken documents
+    std::string newMsg;
     mSeverity = getSeverityForEntry(index, level, version);
 
     if (mValidError == false)
@@ -226,7 +238,8 @@ SedError::SedError (  const unsigned int errorId
 
       mErrorId  = NotSchemaConformant;
       mSeverity = LIBSEDML_SEV_ERROR;
-      newMsg << errorTable[3].message << " "; // FIXME
+      newMsg += errorTable[3].message; // FIXME
+      newMsg += " ";
     }
     else if (mSeverity == LIBSEDML_SEV_GENERAL_WARNING)
     {
@@ -237,25 +250,28 @@ SedError::SedError (  const unsigned int errorId
       // and then here we translate them into regular warnings.
 
       mSeverity = LIBSEDML_SEV_WARNING;
-      newMsg << "[Although Sed Level " << level
-             << " Version " << version << " does not explicitly define the "
-             << "following as an error, other Levels and/or Versions "
-             << "of Sed do.] " << endl;
+      ostringstream warning;
+      warning << "[Although Sed Level " << level
+              << " Version " << version << " does not explicitly define the "
+              << "following as an error, other Levels and/or Versions "
+              << "of Sed do.] " << endl;
+      newMsg += warning.str();
     }
 
     // Finish updating the (full) error message.
 
-    newMsg << errorTable[index].message;
+    newMsg += errorTable[index].message;
     
     // look for individual references
     // if the code for this error does not yet exist skip
 
     if (!details.empty())
     {
-      newMsg << " " << details;
+      newMsg += " ";
+      newMsg += details;
     }      
-    newMsg << endl;
-    mMessage  = newMsg.str();
+    newMsg += "\n";
+    mMessage  = newMsg;
 
     // We mucked around with the severity code and (maybe) category code
     // after creating the XMLError object, so we may have to update the
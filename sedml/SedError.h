@@ -807,6 +807,13 @@ typedef enum
 , NoTimeSymbolInFunctionDef             = 99301 /*!< Use of <code>&lt;csymbol&gt;</code> for 'time' not allowed within FunctionDefinition objects. */
 , NoBodyInFunctionDef                   = 99302 /*!< There must be a <code>&lt;lambda&gt;</code> body within the <code>&lt;math&gt;</code> element of a FunctionDefinition object. */
 , DanglingUnitSIdRef                    = 99303 /*!< Units must refer to valid unit or unitDefinition. */
+, DanglingSedReference                  = 99304 /*!< A reference attribute does not refer to an existing Sed object. */
+, MissingRequiredSedAttribute           = 99305 /*!< An Sed object lacks an attribute it must have. */
+, MissingRequiredSedElement             = 99306 /*!< An Sed object lacks a child element it must have. */
+, UnboundSedMathSymbol                  = 99307 /*!< A name in the math of an Sed object is none of its variables or parameters. */
+, InconsistentSedTimeCourse             = 99308 /*!< The times of a uniform time course are out of order. */
+, UnresolvedSedTarget                   = 99309 /*!< The target of a variable or change selects nothing in its model. */
+, XMLNestedTooDeeply                    = 99310 /*!< Notes or an annotation nest more deeply than the document allows. */
 , RDFMissingAboutTag                    = 99401 /*!< RDF missing the <code>&lt;about&gt;</code> tag.. */
 , RDFEmptyAboutTag                      = 99402 /*!< RDF empty <code>&lt;about&gt;</code> tag.. */
 , RDFAboutTagNotMetaid                  = 99403 /*!< RDF <code>&lt;about&gt;</code> tag is not metaid.. */
@@ -52,6 +52,12 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new empty SedErrorLog.
  */
 SedErrorLog::SedErrorLog ()
+  : mNumCounted (0)
+  , mLastCounted (NULL)
+  , mMaxErrorsPerId (0)
+  , mMaxErrors (0)
+  , mStopAtLimit (false)
+  , mNumSuppressed (0)
 {
 }
 
@@ -136,7 +142,7 @@ SedErrorLog::logPackageError ( const std::string& package
 void
 SedErrorLog::add (const SedError& error)
 {
-  if (error.getSeverity() != LIBSEDML_SEV_NOT_APPLICABLE)
+  if (error.getSeverity() != LIBSEDML_SEV_NOT_APPLICABLE && !suppress(error))
     XMLErrorLog::add(error);
 }
 
@@ -154,7 +160,7 @@ SedErrorLog::add (const std::list<SedError>& errors)
   list<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add( *iter );
+    if (!suppress(*iter)) XMLErrorLog::add( *iter );
 }
 
 /*
@@ -170,7 +176,7 @@ SedErrorLog::add (const std::vector<SedError>& errors)
   vector<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add( *iter );
+    if (!suppress(*iter)) XMLErrorLog::add( *iter );
 }
 
 /*
@@ -220,11 +226,82 @@ SedErrorLog::remove (const unsigned int errorId)
 
   if ( delIter != mErrors.end() )
   {
+    unsigned int index = (unsigned int)(delIter - mErrors.begin());
+    if (index < mNumCounted)
+    {
+      --mSeverityCounts[(*delIter)->getSeverity()];
+      --mNumCounted;
+    }
+
     // deletes (invoke delete operator for the matched item) and erases (removes
     // the pointer from mErrors) the matched item (if any)
     delete *delIter;
     mErrors.erase(delIter);
+
+    mLastCounted = (mNumCounted > 0) ? mErrors[mNumCounted - 1] : NULL;
+  }
+}
+
+
+/*
+ * Removes every error for which predicate returns true.
+ */
+unsigned int
+SedErrorLog::removeIf (bool (*predicate) (const SedError* error,
+                                          void* userData),
+                       void* userData)
+{
+  if (predicate == NULL) return 0;
+
+  // the survivors are moved down over the removed errors in one pass, and
+  // counted on the way, rather than erasing the errors one at a time
+  mSeverityCounts.clear();
+
+  size_t kept = 0;
+  for (size_t i = 0; i < mErrors.size(); ++i)
+  {
+    XMLError* error = mErrors[i];
+    if (predicate(static_cast<const SedError*>(error), userData))
+    {
+      delete error;
+      continue;
+    }
+
+    unsigned int severity = error->getSeverity();
+    if (severity >= mSeverityCounts.size())
+      mSeverityCounts.resize(severity + 1, 0);
+    ++mSeverityCounts[severity];
+
+    mErrors[kept++] = error;
   }
+
+  unsigned int removed = (unsigned int)(mErrors.size() - kept);
+  mErrors.resize(kept);
+
+  mNumCounted  = (unsigned int)kept;
+  mLastCounted = (kept > 0) ? mErrors[kept - 1] : NULL;
+
+  return removed;
+}
+
+
+/*
+ * Helper function used by SedErrorLog::removeWithSeverity.
+ */
+static bool
+hasSeverity (const SedError* error, void* severity)
+{
+  return error->getSeverity() == *static_cast<unsigned int*>(severity);
+}
+
+
+/*
+ * Removes every error with the given severity code.
+ */
+unsigned int
+SedErrorLog::removeWithSeverity (unsigned int severity)
+{
+  return removeIf(hasSeverity, &severity);
 }
 
 
@@ -249,23 +326,71 @@ SedErrorLog::contains (const unsigned int errorId)
 
 
 /*
- * Helper class used by
- * SedErrorLog::getNumFailsWithSeverity(SedErrorSeverity_t).
+ * Returns whether error is only to be counted, because of the limits on
+ * the errors kept, and counts it if so.
  */
-class MatchSeverity
+bool
+SedErrorLog::suppress (const XMLError& error)
 {
-public:
-  MatchSeverity(const unsigned int s) : severity(s) {};
+  if (mMaxErrors == 0 && mMaxErrorsPerId == 0) return false;
 
-  bool operator() (XMLError* e) const
+  const unsigned int errorId = error.getErrorId();
+
+  bool suppressed = (mMaxErrors != 0 && mErrors.size() >= mMaxErrors);
+
+  if (!suppressed && mMaxErrorsPerId != 0)
   {
-    return e->getSeverity() == severity;
-  };
+    unsigned int& kept = mNumKept[errorId];
+    if (kept >= mMaxErrorsPerId)
+      suppressed = true;
+    else
+      ++kept;
+  }
 
-private:
-  unsigned int severity;
-};
+  if (suppressed)
+  {
+    ++mNumSuppressed;
+    ++mNumSuppressedById[errorId];
+  }
+
+  return suppressed;
+}
+
+
+/*
+ * Brings the counts of errors of each severity up to date.
+ */
+void
+SedErrorLog::countSeverities () const
+{
+  // XMLErrorLog only ever appends errors, so only the errors after those
+  // counted before need counting; if the log changed otherwise, as with
+  // clearLog(), everything is counted afresh; counts that are up to date
+  // are only read, so that a frozen document's log can be asked from
+  // several threads
+  if (mNumCounted == mErrors.size()
+      && (mNumCounted == 0 || mErrors[mNumCounted - 1] == mLastCounted))
+  {
+    return;
+  }
+
+  if (mNumCounted > mErrors.size()
+      || (mNumCounted > 0 && mErrors[mNumCounted - 1] != mLastCounted))
+  {
+    mSeverityCounts.clear();
+    mNumCounted = 0;
+  }
+
+  for (; mNumCounted < mErrors.size(); ++mNumCounted)
+  {
+    unsigned int severity = mErrors[mNumCounted]->getSeverity();
+    if (severity >= mSeverityCounts.size())
+      mSeverityCounts.resize(severity + 1, 0);
+    ++mSeverityCounts[severity];
+  }
 
+  mLastCounted = (mNumCounted > 0) ? mErrors[mNumCounted - 1] : NULL;
+}
 
 
 /** @endcond */
@@ -273,16 +398,8 @@ private:
 unsigned int 
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 {
-  int n = 0;
-
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
-
-  return n;
+  countSeverities();
+  return (severity < mSeverityCounts.size()) ? mSeverityCounts[severity] : 0;
 }
 
 /*
@@ -291,16 +408,110 @@ SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 unsigned int
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity)
 {
-  int n = 0;
+  countSeverities();
+  return (severity < mSeverityCounts.size()) ? mSeverityCounts[severity] : 0;
+}
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
 
-  return n;
+/*
+ * Sets how many errors with the same id this log keeps.
+ */
+void
+SedErrorLog::setMaxErrorsPerId (unsigned int maxErrors)
+{
+  mMaxErrorsPerId = maxErrors;
+}
+
+
+/*
+ * Returns how many errors with the same id this log keeps.
+ */
+unsigned int
+SedErrorLog::getMaxErrorsPerId () const
+{
+  return mMaxErrorsPerId;
+}
+
+
+/*
+ * Sets how many errors this log keeps.
+ */
+void
+SedErrorLog::setMaxErrors (unsigned int maxErrors)
+{
+  mMaxErrors = maxErrors;
+}
+
+
+/*
+ * Returns how many errors this log keeps.
+ */
+unsigned int
+SedErrorLog::getMaxErrors () const
+{
+  return mMaxErrors;
+}
+
+
+/*
+ * Sets whether reading stops once the error limit is reached.
+ */
+void
+SedErrorLog::setStopAtLimit (bool stop)
+{
+  mStopAtLimit = stop;
+}
+
+
+/*
+ * Returns whether reading stops once the error limit is reached.
+ */
+bool
+SedErrorLog::getStopAtLimit () const
+{
+  return mStopAtLimit;
+}
+
+
+/*
+ * Returns whether this log holds as many errors as it may.
+ */
+bool
+SedErrorLog::isLimitReached () const
+{
+  return mMaxErrors != 0 && mErrors.size() >= mMaxErrors;
+}
+
+
+/*
+ * Returns whether reading is to stop.
+ */
+bool
+SedErrorLog::isStopped () const
+{
+  return mStopAtLimit && isLimitReached();
+}
+
+
+/*
+ * Returns the number of errors that were only counted.
+ */
+unsigned int
+SedErrorLog::getNumSuppressed () const
+{
+  return mNumSuppressed;
+}
+
+
+/*
+ * Returns the number of errors with errorId that were only counted.
+ */
+unsigned int
+SedErrorLog::getNumSuppressed (unsigned int errorId) const
+{
+  std::map<unsigned int, unsigned int>::const_iterator found =
+    mNumSuppressedById.find(errorId);
+  return (found != mNumSuppressedById.end()) ? found->second : 0;
 }
 
 
@@ -61,6 +61,14 @@
  * If you wish to simply print the error strings for a human to read, an
  * easier and more direct way might be to use SedDocument::printErrors().
  *
+ * A log reading untrusted input can be bounded: setMaxErrorsPerId() keeps
+ * only the first errors of each error id and setMaxErrors() only the
+ * first errors in all, the others just being counted (see
+ * getNumSuppressed()); with setStopAtLimit(), reading stops altogether
+ * once the log is full.  The limits apply to errors added through
+ * SedErrorLog; errors the XML parser adds through XMLErrorLog are always
+ * kept.
+ *
  * @see SedError
  * @see XMLErrorLog
  * @see XMLError
@@ -78,6 +86,7 @@
 
 #ifdef __cplusplus
 
+#include <map>
 #include <vector>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
@@ -164,6 +173,85 @@ public:
   unsigned int getNumFailsWithSeverity(unsigned int severity) const;
 
 
+  /**
+   * Sets how many errors with the same error id this log keeps; further
+   * errors with that id are only counted.  Zero, the default, keeps all.
+   *
+   * @param maxErrors the number of errors kept per error id.
+   *
+   * @see getNumSuppressed()
+   */
+  void setMaxErrorsPerId (unsigned int maxErrors);
+
+
+  /**
+   * @return the number of errors with the same error id this log keeps,
+   * or zero if it keeps all.
+   */
+  unsigned int getMaxErrorsPerId () const;
+
+
+  /**
+   * Sets how many errors this log keeps in all; further errors are only
+   * counted.  Zero, the default, keeps all.
+   *
+   * @param maxErrors the number of errors kept.
+   *
+   * @see isLimitReached()
+   */
+  void setMaxErrors (unsigned int maxErrors);
+
+
+  /**
+   * @return the number of errors this log keeps, or zero if it keeps all.
+   */
+  unsigned int getMaxErrors () const;
+
+
+  /**
+   * Sets whether a document reading into this log stops once the limit
+   * set with setMaxErrors() is reached, leaving the rest of its input
+   * unread.  This is off by default.
+   *
+   * @param stop @c true to stop reading at the limit.
+   */
+  void setStopAtLimit (bool stop);
+
+
+  /**
+   * @return @c true if reading stops once the error limit is reached.
+   */
+  bool getStopAtLimit () const;
+
+
+  /**
+   * @return @c true if this log holds as many errors as setMaxErrors()
+   * allows.
+   */
+  bool isLimitReached () const;
+
+
+  /**
+   * @return @c true if the error limit is reached and reading is to stop
+   * there.
+   */
+  bool isStopped () const;
+
+
+  /**
+   * @return the number of errors that were only counted, because of the
+   * limits set with setMaxErrorsPerId() and setMaxErrors().
+   */
+  unsigned int getNumSuppressed () const;
+
+
+  /**
+   * @return the number of errors with the id @p errorId that were only
+   * counted.
+   */
+  unsigned int getNumSuppressed (unsigned int errorId) const;
+
+
   /** @cond doxygen-libsbml-internal */
 
   /**
@@ -274,6 +362,31 @@ public:
   void remove (const unsigned int errorId);
 
 
+  /**
+   * Removes, in one pass over the log, every error for which
+   * @p predicate returns @c true.
+   *
+   * @param predicate the function called for each error, with
+   * @p userData.
+   * @param userData passed to @p predicate.
+   *
+   * @return the number of errors removed.
+   */
+  unsigned int removeIf (bool (*predicate) (const SedError* error,
+                                            void* userData),
+                         void* userData = NULL);
+
+
+  /**
+   * Removes every error with the given severity code.
+   *
+   * @param severity the severity of the errors to be removed.
+   *
+   * @return the number of errors removed.
+   */
+  unsigned int removeWithSeverity (unsigned int severity);
+
+
   /**
    * Returns true if SedErrorLog contains an errorId
    *
@@ -282,6 +395,35 @@ public:
   bool contains (const unsigned int errorId);
 
 
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  void countSeverities () const;
+
+  bool suppress (const XMLError& error);
+
+  /*
+   * The number of errors of each severity among the first mNumCounted
+   * errors of the log, the last of which is mLastCounted; errors added
+   * after them are counted the next time a count is asked for.
+   */
+  mutable std::vector<unsigned int>  mSeverityCounts;
+  mutable unsigned int               mNumCounted;
+  mutable const XMLError*            mLastCounted;
+
+  /*
+   * The limits on the errors kept, how many errors of each id were kept
+   * since a limit was set, and how many were only counted.
+   */
+  unsigned int                             mMaxErrorsPerId;
+  unsigned int                             mMaxErrors;
+  bool                                     mStopAtLimit;
+  std::map<unsigned int, unsigned int>     mNumKept;
+  std::map<unsigned int, unsigned int>     mNumSuppressedById;
+  unsigned int                             mNumSuppressed;
+
   /** @endcond */
 };
 
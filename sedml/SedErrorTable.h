@@ -51,6 +51,10 @@ typedef struct {
 } sbmlErrorTableEntry;
 
 
+/*
+ * Entries must be kept in increasing order of their codes: SedError finds
+ * them by binary search.
+ */
 static const sbmlErrorTableEntry errorTable[] =
 {
   // 10000
@@ -9112,6 +9116,87 @@ static const sbmlErrorTableEntry errorTable[] =
 //    "supported."
 //  },
 
+  //99304
+  {
+    DanglingSedReference,
+    "Reference to a non-existent Sed object",
+    LIBSEDML_CAT_IDENTIFIER_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "Reference attributes such as 'modelReference', 'taskReference' or "
+    "'dataReference' must contain the id of an existing object of the "
+    "expected kind in the same Sed document.",
+    {""}
+  },
+
+  //99305
+  {
+    MissingRequiredSedAttribute,
+    "Missing required attribute",
+    LIBSEDML_CAT_GENERAL_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "Every Sed object must have the attributes its class requires, such "
+    "as the 'id' and 'source' of a <model> or the 'kisaoID' of an "
+    "<algorithm>.",
+    {""}
+  },
+
+  //99306
+  {
+    MissingRequiredSedElement,
+    "Missing required element",
+    LIBSEDML_CAT_GENERAL_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "Every Sed object must have the child elements its class "
+    "requires.",
+    {""}
+  },
+
+  //99307
+  {
+    UnboundSedMathSymbol,
+    "Unbound name in math",
+    LIBSEDML_CAT_MATHML_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "Every <ci> in the <math> of a <dataGenerator> or <computeChange> "
+    "must be the id of one of its <variable> or <parameter> children.",
+    {""}
+  },
+
+  //99308
+  {
+    InconsistentSedTimeCourse,
+    "Inconsistent uniform time course",
+    LIBSEDML_CAT_GENERAL_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "The 'initialTime', 'outputStartTime' and 'outputEndTime' of a "
+    "<uniformTimeCourse> must be finite and in that order, and its "
+    "'numberOfPoints' must be positive.",
+    {""}
+  },
+
+  //99309
+  {
+    UnresolvedSedTarget,
+    "Target selects nothing in its model",
+    LIBSEDML_CAT_GENERAL_CONSISTENCY,
+    LIBSEDML_SEV_ERROR,
+    "The 'target' of a <variable> or a change must select an element, or "
+    "an attribute of an element, of the model it applies to.",
+    {""}
+  },
+
+  //99310
+  {
+    XMLNestedTooDeeply,
+    "XML nested too deeply",
+    LIBSEDML_CAT_SEDML,
+    LIBSEDML_SEV_ERROR,
+    "The XML content of <notes> and <annotation> elements may not nest "
+    "more deeply than the limit set with SedDocument::setMaxXMLDepth(); "
+    "content that does is skipped.",
+    {""}
+  },
+
   /* --------------------------------------------------------------------------
    * Boundary marker.  Application-specific codes should begin at 100000.
    * ----------------------------------------------------------------------- */
@@ -0,0 +1,407 @@
+/**
+ * @file    SedEventReader.cpp
+ * @brief   Streams the elements of a SED-ML file to a callback handler
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/xml/XMLError.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLToken.h>
+#include <sbml/util/util.h>
+
+#include <sedml/SedEventReader.h>
+#include <sedml/SedNamespaces.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedTypeCodes.h>
+
+#include <cstring>
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Element names of SED-ML and their type codes, sorted by name.
+ */
+static const struct
+{
+  const char* name;
+  int         typeCode;
+} SED_ELEMENT_TYPES[] =
+{
+    { "algorithm"           , SEDML_SIMULATION_ALGORITHM         }
+  , { "change"              , SEDML_CHANGE                       }
+  , { "changeAttribute"     , SEDML_CHANGE_ATTRIBUTE             }
+  , { "computeChange"       , SEDML_CHANGE_COMPUTECHANGE         }
+  , { "curve"               , SEDML_OUTPUT_CURVE                 }
+  , { "dataGenerator"       , SEDML_DATAGENERATOR                }
+  , { "dataSet"             , SEDML_OUTPUT_DATASET               }
+  , { "listOfChanges"       , SEDML_LIST_OF                      }
+  , { "listOfCurves"        , SEDML_LIST_OF                      }
+  , { "listOfDataGenerators", SEDML_LIST_OF                      }
+  , { "listOfDataSets"      , SEDML_LIST_OF                      }
+  , { "listOfModels"        , SEDML_LIST_OF                      }
+  , { "listOfOutputs"       , SEDML_LIST_OF                      }
+  , { "listOfParameters"    , SEDML_LIST_OF                      }
+  , { "listOfSimulations"   , SEDML_LIST_OF                      }
+  , { "listOfSurfaces"      , SEDML_LIST_OF                      }
+  , { "listOfTasks"         , SEDML_LIST_OF                      }
+  , { "listOfVariables"     , SEDML_LIST_OF                      }
+  , { "model"               , SEDML_MODEL                        }
+  , { "output"              , SEDML_OUTPUT                       }
+  , { "parameter"           , SEDML_PARAMETER                    }
+  , { "plot2D"              , SEDML_OUTPUT_PLOT2D                }
+  , { "plot3D"              , SEDML_OUTPUT_PLOT3D                }
+  , { "removeXML"           , SEDML_CHANGE_REMOVEXML             }
+  , { "report"              , SEDML_OUTPUT_REPORT                }
+  , { "sedML"               , SEDML_DOCUMENT                     }
+  , { "simulation"          , SEDML_SIMULATION                   }
+  , { "surface"             , SEDML_OUTPUT_SURFACE               }
+  , { "task"                , SEDML_TASK                         }
+  , { "uniformTimeCourse"   , SEDML_SIMULATION_UNIFORMTIMECOURSE }
+  , { "variable"            , SEDML_VARIABLE                     }
+};
+
+static const int NUM_SED_ELEMENT_TYPES =
+  sizeof(SED_ELEMENT_TYPES) / sizeof(SED_ELEMENT_TYPES[0]);
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedElementHandler.
+ */
+SedElementHandler::~SedElementHandler ()
+{
+}
+
+
+/*
+ * Called when the start tag of an element has been read.
+ */
+bool
+SedElementHandler::startElement (const std::string&, int,
+                                 const XMLAttributes&, unsigned int)
+{
+  return true;
+}
+
+
+/*
+ * Called when an element has been closed.
+ */
+void
+SedElementHandler::endElement (const std::string&, int, unsigned int)
+{
+}
+
+
+/*
+ * Creates a new SedEventReader and returns it.
+ */
+SedEventReader::SedEventReader ()
+  : mXMLParser (SedReader::getDefaultXMLParser())
+{
+}
+
+
+/*
+ * Destroys this SedEventReader.
+ */
+SedEventReader::~SedEventReader ()
+{
+}
+
+
+/*
+ * Streams the SED-ML file filename to handler.
+ */
+int
+SedEventReader::parseFile (const std::string& filename,
+                           SedElementHandler& handler)
+{
+  return parseInternal(filename.c_str(), true, handler);
+}
+
+
+/*
+ * Streams the SED-ML content in xml to handler.
+ */
+int
+SedEventReader::parseString (const std::string& xml,
+                             SedElementHandler& handler)
+{
+  const char* dummy_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+  if (!strncmp(xml.c_str(), dummy_xml, 14))
+  {
+    return parseInternal(xml.c_str(), false, handler);
+  }
+  else
+  {
+    const std::string temp = (dummy_xml + xml);
+    return parseInternal(temp.c_str(), false, handler);
+  }
+}
+
+
+/*
+ * Returns the log of the errors encountered by the last parse.
+ */
+SedErrorLog*
+SedEventReader::getErrorLog ()
+{
+  return &mErrorLog;
+}
+
+
+/*
+ * Sets the XML parser content is parsed with.
+ */
+void
+SedEventReader::setXMLParser (const std::string& parser)
+{
+  mXMLParser = parser;
+}
+
+
+/*
+ * Returns the XML parser content is parsed with.
+ */
+const std::string&
+SedEventReader::getXMLParser () const
+{
+  return mXMLParser;
+}
+
+
+/*
+ * Returns the type code of the SED-ML element with the given name.
+ */
+int
+SedEventReader::getTypeCodeForElement (const std::string& name)
+{
+  int lo = 0;
+  int hi = NUM_SED_ELEMENT_TYPES - 1;
+
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+    int cmp = strcmp(name.c_str(), SED_ELEMENT_TYPES[mid].name);
+
+    if (cmp == 0)
+      return SED_ELEMENT_TYPES[mid].typeCode;
+    else if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
+  }
+
+  return SEDML_UNKNOWN;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Used by parseFile() and parseString().
+ */
+int
+SedEventReader::parseInternal (const char* content, bool isFile,
+                               SedElementHandler& handler)
+{
+  mErrorLog.clearLog();
+
+  if (isFile && content != NULL && (util_file_exists(content) == false))
+  {
+    mErrorLog.logError(XMLFileUnreadable);
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  XMLInputStream stream(content, isFile, mXMLParser, &mErrorLog);
+
+  // type codes of the open elements whose children are being reported;
+  // this is the only state kept, so memory is bounded by the depth
+  std::vector<int> open;
+
+  while (stream.isGood())
+  {
+    const XMLToken token = stream.next();
+
+    if (token.isEOF())
+    {
+      break;
+    }
+    else if (token.isStart())
+    {
+      const std::string& name = token.getName();
+      const unsigned int depth = (unsigned int)open.size();
+      const int typeCode = SedNamespaces::isSedNamespace(token.getURI())
+                         ? getTypeCodeForElement(name) : SEDML_UNKNOWN;
+
+      bool descend = handler.startElement(name, typeCode,
+                                          token.getAttributes(), depth);
+
+      if (token.isEnd())
+      {
+        handler.endElement(name, typeCode, depth);
+      }
+      else if (descend)
+      {
+        open.push_back(typeCode);
+      }
+      else
+      {
+        stream.skipPastEnd(token);
+        handler.endElement(name, typeCode, depth);
+      }
+    }
+    else if (token.isEnd())
+    {
+      if (open.empty()) break;
+
+      int typeCode = open.back();
+      open.pop_back();
+      handler.endElement(token.getName(), typeCode,
+                         (unsigned int)open.size());
+    }
+  }
+
+  return (stream.isError() || !open.empty())
+         ? LIBSEDML_OPERATION_FAILED : LIBSEDML_OPERATION_SUCCESS;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Forwards the events of a SedEventReader to C function pointers.
+ */
+class SedCallbackElementHandler : public SedElementHandler
+{
+public:
+
+  SedCallbackElementHandler (SedEventReader_startElementFunc startFunc,
+                             SedEventReader_endElementFunc endFunc,
+                             void* userData)
+    : mStart(startFunc)
+    , mEnd(endFunc)
+    , mUserData(userData)
+  {
+  }
+
+  virtual bool startElement (const std::string& name, int typeCode,
+                             const XMLAttributes& attributes,
+                             unsigned int depth)
+  {
+    if (mStart == NULL) return true;
+    return mStart(name.c_str(), typeCode, &attributes, depth, mUserData) != 0;
+  }
+
+  virtual void endElement (const std::string& name, int typeCode,
+                           unsigned int depth)
+  {
+    if (mEnd != NULL) mEnd(name.c_str(), typeCode, depth, mUserData);
+  }
+
+private:
+
+  SedEventReader_startElementFunc mStart;
+  SedEventReader_endElementFunc   mEnd;
+  void*                           mUserData;
+};
+/** @endcond */
+
+
+/**
+ * Creates a new SedEventReader and returns it.
+ */
+LIBSEDML_EXTERN
+SedEventReader_t *
+SedEventReader_create ()
+{
+  return new (nothrow) SedEventReader;
+}
+
+
+/**
+ * Frees the given SedEventReader.
+ */
+LIBSEDML_EXTERN
+void
+SedEventReader_free (SedEventReader_t *ser)
+{
+  delete ser;
+}
+
+
+/**
+ * Streams the SED-ML file filename to the given callbacks.
+ */
+LIBSEDML_EXTERN
+int
+SedEventReader_parseFile (SedEventReader_t *ser, const char *filename,
+                          SedEventReader_startElementFunc startElement,
+                          SedEventReader_endElementFunc endElement,
+                          void *userData)
+{
+  if (ser == NULL || filename == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedCallbackElementHandler handler(startElement, endElement, userData);
+  return ser->parseFile(filename, handler);
+}
+
+
+/**
+ * Streams the SED-ML content in xml to the given callbacks.
+ */
+LIBSEDML_EXTERN
+int
+SedEventReader_parseString (SedEventReader_t *ser, const char *xml,
+                            SedEventReader_startElementFunc startElement,
+                            SedEventReader_endElementFunc endElement,
+                            void *userData)
+{
+  if (ser == NULL || xml == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedCallbackElementHandler handler(startElement, endElement, userData);
+  return ser->parseString(xml, handler);
+}
+
+
+/**
+ * Returns the error log of the given SedEventReader.
+ */
+LIBSEDML_EXTERN
+XMLErrorLog_t *
+SedEventReader_getErrorLog (SedEventReader_t *ser)
+{
+  return (ser != NULL) ? ser->getErrorLog() : NULL;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,309 @@
+/**
+ * @file    SedEventReader.h
+ * @brief   Streams the elements of a SED-ML file to a callback handler
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedEventReader
+ * @ingroup Core
+ * @brief Event based reading of SED-ML without building a SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The SedEventReader class walks over SED-ML content and reports every
+ * element it encounters to a SedElementHandler, in document order.  No
+ * SedDocument is constructed: only the current element and the stack of
+ * its open ancestors are held in memory, so arbitrarily large files (for
+ * example those with tens of thousands of dataGenerators) can be scanned
+ * in memory bounded by the nesting depth of the document.
+ *
+ * Elements in the SED-ML namespace are reported together with their
+ * libSEDML type code (e.g. SEDML_DATAGENERATOR), so that handlers can
+ * filter on the kind of element without comparing names.  Elements of
+ * other namespaces (notes, annotations, XML inside a change) are reported
+ * with the type code SEDML_UNKNOWN.  Returning @c false from
+ * SedElementHandler::startElement() skips the subtree of that element
+ * entirely.
+ *
+ * Low level XML problems are recorded in the SedErrorLog returned by
+ * getErrorLog(); SED-ML level validation is not performed.
+ *
+ * @class SedElementHandler
+ * @ingroup Core
+ * @brief Callback interface used by SedEventReader.
+ */
+
+#ifndef SedEventReader_h
+#define SedEventReader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedErrorLog.h>
+#include <sbml/xml/XMLAttributes.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedElementHandler
+{
+public:
+
+  /**
+   * Destroys this SedElementHandler.
+   */
+  virtual ~SedElementHandler ();
+
+
+  /**
+   * Called when the start tag of an element has been read.
+   *
+   * @param name the local name of the element.
+   * @param typeCode the libSEDML type code of the element, or
+   * SEDML_UNKNOWN if it is not a SED-ML element.
+   * @param attributes the attributes of the start tag.
+   * @param depth the nesting depth of the element, the root being 0.
+   *
+   * @return @c true to receive the children of this element, @c false
+   * to skip its whole subtree.  The default implementation returns
+   * @c true.
+   */
+  virtual bool startElement (const std::string& name, int typeCode,
+                             const XMLAttributes& attributes,
+                             unsigned int depth);
+
+
+  /**
+   * Called when an element has been closed, including elements whose
+   * subtree was skipped.
+   *
+   * @param name the local name of the element.
+   * @param typeCode the libSEDML type code of the element, or
+   * SEDML_UNKNOWN if it is not a SED-ML element.
+   * @param depth the nesting depth of the element, the root being 0.
+   */
+  virtual void endElement (const std::string& name, int typeCode,
+                           unsigned int depth);
+};
+
+
+class LIBSEDML_EXTERN SedEventReader
+{
+public:
+
+  /**
+   * Creates a new SedEventReader and returns it.
+   */
+  SedEventReader ();
+
+
+  /**
+   * Destroys this SedEventReader.
+   */
+  virtual ~SedEventReader ();
+
+
+  /**
+   * Streams the SED-ML file @p filename to @p handler.
+   *
+   * Compressed files are handled in the same way as by
+   * SedReader::readSedML().
+   *
+   * @return integer value indicating success/failure of the
+   * operation. @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif@~ The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  int parseFile (const std::string& filename, SedElementHandler& handler);
+
+
+  /**
+   * Streams the SED-ML content in @p xml to @p handler.
+   *
+   * If the string does not begin with an XML declaration, one will be
+   * prepended.
+   *
+   * @return integer value indicating success/failure of the
+   * operation. @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif@~ The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED
+   */
+  int parseString (const std::string& xml, SedElementHandler& handler);
+
+
+  /**
+   * Returns the log of the errors encountered by the last parse.
+   *
+   * @return the SedErrorLog of this SedEventReader.
+   */
+  SedErrorLog* getErrorLog ();
+
+
+  /**
+   * Sets the XML parser of libSBML content is parsed with: "expat",
+   * "libxml" or "xerces", as libSBML was built with them, or an empty
+   * string for the libSBML default.  The default is
+   * SedReader::getDefaultXMLParser().
+   */
+  void setXMLParser (const std::string& parser);
+
+
+  /**
+   * @return the XML parser of libSBML content is parsed with, or an empty
+   * string for the libSBML default.
+   */
+  const std::string& getXMLParser () const;
+
+
+  /**
+   * Returns the libSEDML type code of the SED-ML element with the given
+   * local name.
+   *
+   * @param name the element name, e.g. "dataGenerator".
+   *
+   * @return the type code of the element, or SEDML_UNKNOWN if @p name is
+   * not the name of a SED-ML element.
+   */
+  static int getTypeCodeForElement (const std::string& name);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /**
+   * Used by parseFile() and parseString().
+   */
+  int parseInternal (const char* content, bool isFile,
+                     SedElementHandler& handler);
+
+
+  SedErrorLog mErrorLog;
+  std::string mXMLParser;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedEventReader (const SedEventReader& orig);
+  SedEventReader& operator= (const SedEventReader& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Callback invoked by SedEventReader_parseFile() and
+ * SedEventReader_parseString() for each start tag.  Return @c non-zero to
+ * descend into the element, @c zero to skip its subtree.
+ */
+typedef int (*SedEventReader_startElementFunc) (const char *name,
+                                                int typeCode,
+                                                const XMLAttributes_t *attributes,
+                                                unsigned int depth,
+                                                void *userData);
+
+/**
+ * Callback invoked by SedEventReader_parseFile() and
+ * SedEventReader_parseString() for each closed element.
+ */
+typedef void (*SedEventReader_endElementFunc) (const char *name,
+                                               int typeCode,
+                                               unsigned int depth,
+                                               void *userData);
+
+
+/**
+ * Creates a new SedEventReader and returns it.
+ */
+LIBSEDML_EXTERN
+SedEventReader_t *
+SedEventReader_create (void);
+
+
+/**
+ * Frees the given SedEventReader.
+ */
+LIBSEDML_EXTERN
+void
+SedEventReader_free (SedEventReader_t *ser);
+
+
+/**
+ * Streams the SED-ML file @p filename to the given callbacks.  Either
+ * callback may be NULL.
+ *
+ * @return LIBSEDML_OPERATION_SUCCESS, LIBSEDML_OPERATION_FAILED or
+ * LIBSEDML_INVALID_OBJECT if @p ser or the content is NULL.
+ */
+LIBSEDML_EXTERN
+int
+SedEventReader_parseFile (SedEventReader_t *ser, const char *filename,
+                          SedEventReader_startElementFunc startElement,
+                          SedEventReader_endElementFunc endElement,
+                          void *userData);
+
+
+/**
+ * Streams the SED-ML content in @p xml to the given callbacks.  Either
+ * callback may be NULL.
+ *
+ * @return LIBSEDML_OPERATION_SUCCESS, LIBSEDML_OPERATION_FAILED or
+ * LIBSEDML_INVALID_OBJECT if @p ser or the content is NULL.
+ */
+LIBSEDML_EXTERN
+int
+SedEventReader_parseString (SedEventReader_t *ser, const char *xml,
+                            SedEventReader_startElementFunc startElement,
+                            SedEventReader_endElementFunc endElement,
+                            void *userData);
+
+
+/**
+ * Returns the error log of the given SedEventReader.
+ */
+LIBSEDML_EXTERN
+XMLErrorLog_t *
+SedEventReader_getErrorLog (SedEventReader_t *ser);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedEventReader_h */
@@ -0,0 +1,2200 @@
+/**
+ * @file    SedExecutor.cpp
+ * @brief   Runs the tasks of a SedDocument in dependency order on a pool
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedExecutor.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedSweep.h>
+#include <sedml/SedResultCache.h>
+#include <sedml/SedCheckpoint.h>
+#include <sedml/SedProfiler.h>
+#include <sedml/SedCostModel.h>
+#include <sedml/SedKisao.h>
+#include <sedml/SedRandomStream.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/operationReturnValues.h>
+#include <sedml/common/threads.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <new>
+#include <set>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The kinds of the steps of a run.
+ */
+enum
+{
+    SED_STEP_MODEL
+  , SED_STEP_TASK
+  , SED_STEP_DATAGENERATOR
+  , SED_STEP_OUTPUT
+  , SED_STEP_SWEEP
+};
+
+
+/*
+ * The ready steps of one worker.  The owner takes from the back; other
+ * workers steal from the front or, with a cost model, where the queue is
+ * kept in increasing priority, from the back too.  load is the expected
+ * seconds of the tasks queued.
+ */
+struct SedExecutorWorker
+{
+  std::deque<unsigned int> queue;
+  SedMutex                 mutex;
+  double                   load;
+};
+
+
+/*
+ * The group of a step that is in none.
+ */
+static const unsigned int SED_NO_GROUP = (unsigned int)-1;
+
+
+/*
+ * The state of a group of data generators in one run: the first of its
+ * steps to run evaluates the whole group, and the others find the result.
+ */
+struct SedExecutorGroup
+{
+  SedMutex  mutex;
+  bool      evaluated;
+  bool      succeeded;
+};
+
+
+/*
+ * State shared by the threads of one run.  mutex guards the counters, the
+ * remaining and failed fields of the steps, the results of the executor
+ * and the calls of the output handler.
+ */
+struct SedExecutor::Run
+{
+  SedExecutor*        executor;
+  const SedDocument*  document;
+  SedExecutorWorker*  workers;
+  unsigned int        numWorkers;
+  unsigned int        numQueued;
+  unsigned int        numDone;
+  SedMutex            mutex;
+  SedCondition        condition;
+  SedExecutorGroup*   groups;
+  bool                balanced;
+  std::vector<double> priorities;
+#ifdef USE_PROFILING
+  std::vector<double> readyTimes;
+#endif
+};
+
+
+/*
+ * Arguments of a worker thread.
+ */
+struct SedExecutorThread
+{
+  SedExecutor::Run* run;
+  unsigned int      worker;
+};
+
+
+/*
+ * Returns the expected seconds of the step of the given priority that
+ * count towards the load of a worker; models count for nothing.
+ */
+static double
+getLoad (double priority)
+{
+  return (priority < HUGE_VAL) ? priority : 0;
+}
+
+
+/*
+ * Returns the worker with the least load, worker itself if no other has
+ * less.
+ */
+static unsigned int
+getLeastLoaded (SedExecutor::Run& run, unsigned int worker)
+{
+  unsigned int best = worker;
+  double       least = HUGE_VAL;
+
+  for (unsigned int i = 0; i < run.numWorkers; ++i)
+  {
+    const unsigned int k = (worker + i) % run.numWorkers;
+    SedExecutorWorker& w = run.workers[k];
+
+    mutexLock(&w.mutex);
+    const double load = w.load;
+    mutexUnlock(&w.mutex);
+
+    if (load < least)
+    {
+      least = load;
+      best  = k;
+    }
+  }
+
+  return best;
+}
+
+
+/*
+ * Adds step n to the queue of worker or, with a cost model, of the worker
+ * with the least load, after the steps of lower priority; the caller
+ * holds run.mutex.
+ */
+static void
+pushStep (SedExecutor::Run& run, unsigned int worker, unsigned int n)
+{
+#ifdef USE_PROFILING
+  if (run.executor->getProfiler() != NULL)
+  {
+    run.readyTimes[n] = SedProfiler::getTime();
+  }
+#endif
+
+  if (!run.balanced)
+  {
+    SedExecutorWorker& w = run.workers[worker];
+    mutexLock(&w.mutex);
+    w.queue.push_back(n);
+    mutexUnlock(&w.mutex);
+    ++run.numQueued;
+    return;
+  }
+
+  const double priority = run.executor->getPriority(n);
+  run.priorities[n] = priority;
+
+  SedExecutorWorker& w = run.workers[getLeastLoaded(run, worker)];
+  mutexLock(&w.mutex);
+
+  std::deque<unsigned int>::iterator it = w.queue.end();
+  while (it != w.queue.begin() && run.priorities[*(it - 1)] > priority)
+  {
+    --it;
+  }
+  w.queue.insert(it, n);
+  w.load += getLoad(priority);
+
+  mutexUnlock(&w.mutex);
+  ++run.numQueued;
+}
+
+
+/*
+ * Takes the step of the highest priority, the last one, from the queue of
+ * w, which the caller has locked.
+ */
+static unsigned int
+takeLast (SedExecutor::Run& run, SedExecutorWorker& w)
+{
+  const unsigned int n = w.queue.back();
+  w.queue.pop_back();
+
+  if (run.balanced)
+  {
+    w.load = w.queue.empty() ? 0 : w.load - getLoad(run.priorities[n]);
+  }
+  return n;
+}
+
+
+/*
+ * Takes the newest step of worker or, failing that, the oldest step of
+ * another worker.  With a cost model, the step of the highest priority
+ * is taken instead, from the worker with the most load if not from
+ * worker itself.
+ */
+static bool
+popStep (SedExecutor::Run& run, unsigned int worker, unsigned int& n)
+{
+  SedExecutorWorker& own = run.workers[worker];
+  mutexLock(&own.mutex);
+  bool found = !own.queue.empty();
+  if (found) n = takeLast(run, own);
+  mutexUnlock(&own.mutex);
+
+  while (!found && run.balanced)
+  {
+    unsigned int best = worker;
+    double       most = -1;
+
+    for (unsigned int i = 1; i < run.numWorkers; ++i)
+    {
+      const unsigned int k = (worker + i) % run.numWorkers;
+      SedExecutorWorker& other = run.workers[k];
+
+      mutexLock(&other.mutex);
+      if (!other.queue.empty() && other.load > most)
+      {
+        most = other.load;
+        best = k;
+      }
+      mutexUnlock(&other.mutex);
+    }
+    if (best == worker) return false;
+
+    // the queue may have been emptied since; the search is then repeated
+    SedExecutorWorker& other = run.workers[best];
+    mutexLock(&other.mutex);
+    found = !other.queue.empty();
+    if (found) n = takeLast(run, other);
+    mutexUnlock(&other.mutex);
+  }
+
+  for (unsigned int i = 1; !found && i < run.numWorkers; ++i)
+  {
+    SedExecutorWorker& other = run.workers[(worker + i) % run.numWorkers];
+    mutexLock(&other.mutex);
+    found = !other.queue.empty();
+    if (found)
+    {
+      n = other.queue.front();
+      other.queue.pop_front();
+    }
+    mutexUnlock(&other.mutex);
+  }
+
+  return found;
+}
+
+
+/*
+ * Orders steps by decreasing priority.
+ */
+struct SedExecutorPriorityOrder
+{
+  const SedExecutor* executor;
+
+  bool operator() (unsigned int a, unsigned int b) const
+  {
+    return executor->getPriority(a) > executor->getPriority(b);
+  }
+};
+
+
+/*
+ * A simulator calling a C function, used by SedExecutor_setSimulator().
+ */
+class SedCallbackSimulator : public SedSimulator
+{
+public:
+
+  SedCallbackSimulator (SedExecutor_simulateFunc func, void* userData)
+    : mFunc (func)
+    , mUserData (userData)
+  {
+  }
+
+  virtual int simulate (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation,
+                        const std::vector<const SedVariable*>& variables,
+                        SedResults& results)
+  {
+    return mFunc(task, model, simulation,
+                 variables.empty() ? NULL : &variables[0],
+                 (unsigned int)variables.size(), &results, mUserData);
+  }
+
+private:
+
+  SedExecutor_simulateFunc mFunc;
+  void*                    mUserData;
+};
+
+
+/*
+ * Gives results the columns of the variables step was not asked for, as
+ * aliases of the columns of the variables they refer to the same thing as.
+ */
+static void
+addAliases (const SedExecutor::Step& step, SedResults& results)
+{
+  for (unsigned int i = 0; i < step.aliases.size(); ++i)
+  {
+    const std::string& id     = step.aliases[i].first;
+    const std::string& target = step.aliases[i].second;
+
+    const double* values = results.getColumn(target);
+    if (values != NULL && !results.hasColumn(id))
+    {
+      results.setColumnAlias(id, values, results.getColumnLength(target));
+    }
+  }
+}
+
+
+/*
+ * Loads the results of fingerprint from cache into results, keeping them
+ * only if they have every column step wants.
+ */
+static bool
+loadResults (SedResultCache* cache, const std::string& fingerprint,
+             const SedExecutor::Step& step, SedResults& results)
+{
+  if (cache->load(fingerprint, results))
+  {
+    bool complete = true;
+    for (unsigned int i = 0; complete && i < step.variables.size(); ++i)
+    {
+      complete = results.hasColumn(step.variables[i]->getId());
+    }
+    if (complete)
+    {
+      addAliases(step, results);
+      return true;
+    }
+  }
+
+  results.clear();
+  return false;
+}
+
+
+/*
+ * Adds variable to those task is asked for, unless a variable referring
+ * to the same model, target and symbol of the task is there already, in
+ * which case its column is to be an alias of the column of that one.
+ */
+static void
+addTaskVariable (SedExecutor::Step& task, const SedVariable* variable,
+                 std::map<std::string, const SedVariable*>& bound)
+{
+  const std::string binding = variable->getTaskReference() + '\n'
+    + variable->getModelReference() + '\n' + variable->getTarget() + '\n'
+    + variable->getSymbol();
+
+  std::map<std::string, const SedVariable*>::const_iterator it =
+    bound.find(binding);
+  if (it == bound.end())
+  {
+    bound[binding] = variable;
+    task.variables.push_back(variable);
+  }
+  else if (it->second->getId() != variable->getId())
+  {
+    task.aliases.push_back(std::make_pair(variable->getId(),
+                                          it->second->getId()));
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedSimulator.
+ */
+SedSimulator::~SedSimulator ()
+{
+}
+
+
+/*
+ * Returns the size of model, by default 0 for not known.
+ */
+double
+SedSimulator::getModelSize (const SedModel*)
+{
+  return 0;
+}
+
+
+/*
+ * Returns the algorithms this simulator implements, by default NULL for
+ * not known.
+ */
+const SedAlgorithmSupport*
+SedSimulator::getAlgorithmSupport () const
+{
+  return NULL;
+}
+
+
+/*
+ * Called once for every model in the language of this simulator.
+ */
+int
+SedSimulator::loadModel (const SedModel*)
+{
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Simulates a point of a sweep, by default on a changed copy of model.
+ */
+int
+SedSimulator::simulatePoint (const SedTask* task, const SedModel* model,
+                             const SedSimulation* simulation,
+                             const SedSweepPoint& point,
+                             const std::vector<const SedVariable*>& variables,
+                             SedResults& results)
+{
+  SedModel variant(*model);
+
+  for (unsigned int i = 0; i < point.getNumChanges(); ++i)
+  {
+    SedChangeAttribute* change = variant.createChangeAttribute();
+    if (change == NULL
+        || change->setTarget(point.getTarget(i)) != LIBSEDML_OPERATION_SUCCESS
+        || change->setNewValue(SedNumber::toString(point.getValue(i)))
+           != LIBSEDML_OPERATION_SUCCESS)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  }
+
+  return simulate(task, &variant, simulation, variables, results);
+}
+
+
+/*
+ * Simulates task, or point of a sweep over it, with random; by default
+ * without it.
+ */
+int
+SedSimulator::simulateStochastic (const SedTask* task, const SedModel* model,
+                                  const SedSimulation* simulation,
+                                  const SedSweepPoint* point,
+                                  SedRandomStream&,
+                                  const std::vector<const SedVariable*>&
+                                    variables,
+                                  SedResults& results)
+{
+  return (point != NULL)
+    ? simulatePoint(task, model, simulation, *point, variables, results)
+    : simulate(task, model, simulation, variables, results);
+}
+
+
+/*
+ * Destroys this SedOutputHandler.
+ */
+SedOutputHandler::~SedOutputHandler ()
+{
+}
+
+
+/*
+ * Creates a new SedExecutor.
+ */
+SedExecutor::SedExecutor (unsigned int numThreads)
+  : mNumThreads (numThreads)
+  , mOutputHandler (NULL)
+  , mResultCache (NULL)
+  , mCheckpoint (NULL)
+  , mProfiler (NULL)
+  , mCostModel (NULL)
+  , mSeed (0)
+  , mMemoryBudget (0)
+  , mFirstSweepStep (0)
+{
+}
+
+
+/*
+ * Destroys this SedExecutor.
+ */
+SedExecutor::~SedExecutor ()
+{
+  for (unsigned int i = 0; i < mOwnedSimulators.size(); ++i)
+  {
+    delete mOwnedSimulators[i];
+  }
+}
+
+
+/*
+ * Sets the number of threads used.
+ */
+void
+SedExecutor::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next run will use at most.
+ */
+unsigned int
+SedExecutor::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Registers simulator for language.
+ */
+void
+SedExecutor::setSimulator (const std::string& language,
+                           SedSimulator* simulator)
+{
+  if (simulator == NULL)
+    mSimulators.erase(language);
+  else
+    mSimulators[language] = simulator;
+}
+
+
+/*
+ * Returns the simulator used for models in language.
+ */
+SedSimulator*
+SedExecutor::getSimulator (const std::string& language) const
+{
+  std::map<std::string, SedSimulator*>::const_iterator it =
+    mSimulators.find(language);
+  if (it == mSimulators.end()) it = mSimulators.find("");
+
+  return (it != mSimulators.end()) ? it->second : NULL;
+}
+
+
+/*
+ * Sets the handler told about every output.
+ */
+void
+SedExecutor::setOutputHandler (SedOutputHandler* handler)
+{
+  mOutputHandler = handler;
+}
+
+
+/*
+ * Sets the cache consulted before every simulation.
+ */
+void
+SedExecutor::setResultCache (SedResultCache* cache)
+{
+  mResultCache = cache;
+}
+
+
+/*
+ * Returns the cache consulted before every simulation.
+ */
+SedResultCache*
+SedExecutor::getResultCache () const
+{
+  return mResultCache;
+}
+
+
+/*
+ * Sets the checkpoint recording the progress of every run.
+ */
+void
+SedExecutor::setCheckpoint (SedCheckpoint* checkpoint)
+{
+  mCheckpoint = checkpoint;
+}
+
+
+/*
+ * Returns the checkpoint recording the progress of the runs.
+ */
+SedCheckpoint*
+SedExecutor::getCheckpoint () const
+{
+  return mCheckpoint;
+}
+
+
+/*
+ * Sets the profiler recording every step.
+ */
+void
+SedExecutor::setProfiler (SedProfiler* profiler)
+{
+  mProfiler = profiler;
+}
+
+
+/*
+ * Returns the profiler recording every step.
+ */
+SedProfiler*
+SedExecutor::getProfiler () const
+{
+  return mProfiler;
+}
+
+
+/*
+ * Sets the SedCostModel ordering the ready steps.
+ */
+void
+SedExecutor::setCostModel (SedCostModel* costModel)
+{
+  mCostModel = costModel;
+}
+
+
+/*
+ * Returns the SedCostModel ordering the ready steps.
+ */
+SedCostModel*
+SedExecutor::getCostModel () const
+{
+  return mCostModel;
+}
+
+
+/*
+ * Sets the seed the random streams of stochastic tasks are derived from.
+ */
+void
+SedExecutor::setSeed (unsigned long long seed)
+{
+  mSeed = seed;
+}
+
+
+/*
+ * Returns the seed the random streams of stochastic tasks are derived
+ * from.
+ */
+unsigned long long
+SedExecutor::getSeed () const
+{
+  return mSeed;
+}
+
+
+/*
+ * Returns the random stream of task, or of point of a sweep over it.
+ */
+SedRandomStream
+SedExecutor::getRandomStream (const SedDocument* document,
+                              const SedTask* task,
+                              const SedSweepPoint* point) const
+{
+  // without the variables, so that the data generators asked for do not
+  // change the numbers drawn; an unknown task falls back to its id
+  const std::vector<const SedVariable*> none;
+  std::string fingerprint =
+    SedResultCache::getFingerprint(document, task, none);
+  if (fingerprint.empty() && task != NULL) fingerprint = task->getId();
+
+  return SedRandomStream(SedRandomStream::deriveKey(mSeed, fingerprint),
+                         (point != NULL) ? 1 + (unsigned long long)
+                                                 point->getIndex()
+                                         : 0);
+}
+
+
+/*
+ * Sets the number of bytes the columns of each of the results may take
+ * in memory, and where those beyond it are spilled to.
+ */
+void
+SedExecutor::setMemoryBudget (size_t bytes, const std::string& directory)
+{
+  mMemoryBudget   = bytes;
+  mSpillDirectory = directory;
+
+  mResults.setMemoryBudget(bytes);
+  mResults.setSpillDirectory(directory);
+}
+
+
+/*
+ * Returns the number of bytes the columns of each of the results may take
+ * in memory.
+ */
+size_t
+SedExecutor::getMemoryBudget () const
+{
+  return mMemoryBudget;
+}
+
+
+/*
+ * Registers sweep to be run with every following run.
+ */
+int
+SedExecutor::addSweep (const SedSweep* sweep)
+{
+  if (sweep == NULL || sweep->getTask() == NULL)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  for (unsigned int i = 0; i < mSweeps.size(); ++i)
+  {
+    if (mSweeps[i] == sweep) return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  mSweeps.push_back(sweep);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Unregisters all sweeps.
+ */
+void
+SedExecutor::clearSweeps ()
+{
+  mSweeps.clear();
+}
+
+
+/*
+ * Returns the number of sweeps registered.
+ */
+unsigned int
+SedExecutor::getNumSweeps () const
+{
+  return (unsigned int)mSweeps.size();
+}
+
+
+/*
+ * Requests the output outputId.
+ */
+int
+SedExecutor::addRequestedOutput (const std::string& outputId)
+{
+  if (outputId.empty()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  for (unsigned int i = 0; i < mRequestedOutputs.size(); ++i)
+  {
+    if (mRequestedOutputs[i] == outputId) return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  mRequestedOutputs.push_back(outputId);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Withdraws all requests.
+ */
+void
+SedExecutor::clearRequestedOutputs ()
+{
+  mRequestedOutputs.clear();
+}
+
+
+/*
+ * Returns the number of outputs requested.
+ */
+unsigned int
+SedExecutor::getNumRequestedOutputs () const
+{
+  return (unsigned int)mRequestedOutputs.size();
+}
+
+
+/*
+ * Executes document.
+ */
+int
+SedExecutor::run (const SedDocument* document)
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  plan(document);
+  if (mCheckpoint != NULL) resume(document);
+
+  const unsigned int total = (unsigned int)mSteps.size();
+  unsigned int numWorkers = getNumThreads();
+  if (numWorkers > total) numWorkers = total;
+
+  if (numWorkers > 0)
+  {
+    Run run;
+    run.executor   = this;
+    run.document   = document;
+    run.workers    = new SedExecutorWorker[numWorkers];
+    run.numWorkers = numWorkers;
+    run.numQueued  = 0;
+    run.numDone    = 0;
+    run.balanced   = (mCostModel != NULL);
+    run.priorities.assign(total, 0);
+#ifdef USE_PROFILING
+    run.readyTimes.assign(total, 0);
+#endif
+    mutexInit(&run.mutex);
+    conditionInit(&run.condition);
+
+    for (unsigned int i = 0; i < numWorkers; ++i)
+    {
+      mutexInit(&run.workers[i].mutex);
+      run.workers[i].load = 0;
+    }
+
+    run.groups = new SedExecutorGroup[mGroups.size() + 1];
+    for (unsigned int i = 0; i < mGroups.size(); ++i)
+    {
+      mutexInit(&run.groups[i].mutex);
+      run.groups[i].evaluated = false;
+      run.groups[i].succeeded = false;
+    }
+
+    // the steps without dependencies are dealt out to all workers; with
+    // a cost model the longest go first, each to the least loaded worker
+    std::vector<unsigned int> ready;
+    for (unsigned int n = 0; n < total; ++n)
+    {
+      if (mSteps[n].remaining == 0) ready.push_back(n);
+    }
+
+    if (run.balanced)
+    {
+      SedExecutorPriorityOrder order;
+      order.executor = this;
+      std::stable_sort(ready.begin(), ready.end(), order);
+    }
+
+    for (unsigned int i = 0; i < ready.size(); ++i)
+    {
+      pushStep(run, i % numWorkers, ready[i]);
+    }
+
+    // the calling thread is worker 0; if some threads cannot be started
+    // the others steal their share
+    std::vector<SedExecutorThread> args(numWorkers);
+    std::vector<SedThread> threads;
+    for (unsigned int i = 1; i < numWorkers; ++i)
+    {
+      args[i].run    = &run;
+      args[i].worker = i;
+
+      SedThread thread;
+      if (!startThread(&thread, workerMain, &args[i])) break;
+      threads.push_back(thread);
+    }
+
+    runWorker(run, 0);
+
+    for (unsigned int i = 0; i < threads.size(); ++i)
+    {
+      joinThread(threads[i]);
+    }
+
+    for (unsigned int i = 0; i < numWorkers; ++i)
+    {
+      mutexFree(&run.workers[i].mutex);
+    }
+    delete [] run.workers;
+
+    for (unsigned int i = 0; i < mGroups.size(); ++i)
+    {
+      mutexFree(&run.groups[i].mutex);
+    }
+    delete [] run.groups;
+
+    conditionFree(&run.condition);
+    mutexFree(&run.mutex);
+  }
+
+  for (unsigned int n = 0; n < total; ++n)
+  {
+    if (mSteps[n].failed) mFailed.push_back(mSteps[n].id);
+  }
+
+  return mFailed.empty() ? LIBSEDML_OPERATION_SUCCESS
+                         : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the values of the data generators of the last run.
+ */
+const SedResults&
+SedExecutor::getResults () const
+{
+  return mResults;
+}
+
+
+/*
+ * Returns the results of the task taskId in the last run.
+ */
+const SedResults*
+SedExecutor::getTaskResults (const std::string& taskId) const
+{
+  std::map<std::string, unsigned int>::const_iterator it =
+    mTaskIndex.find(taskId);
+  if (it == mTaskIndex.end()) return NULL;
+
+  for (unsigned int i = 0; i < mFailed.size(); ++i)
+  {
+    if (mFailed[i] == taskId) return NULL;
+  }
+
+  return &mTaskResults[it->second];
+}
+
+
+/*
+ * Returns the results of point index of sweep in the last run.
+ */
+const SedResults*
+SedExecutor::getSweepResults (const SedSweep* sweep, size_t index) const
+{
+  std::map<const SedSweep*, unsigned int>::const_iterator it =
+    mSweepSteps.find(sweep);
+  if (it == mSweepSteps.end()) return NULL;
+
+  // the sweep may have been changed since the run
+  const size_t n = it->second + index;
+  if (index >= mSteps.size() || n >= mSteps.size()
+      || mSteps[n].sweep != sweep || mSteps[n].point != index
+      || mSteps[n].failed)
+  {
+    return NULL;
+  }
+
+  return &mSweepResults[n - mFirstSweepStep];
+}
+
+
+/*
+ * Returns the number of elements that failed in the last run.
+ */
+unsigned int
+SedExecutor::getNumFailed () const
+{
+  return (unsigned int)mFailed.size();
+}
+
+
+/*
+ * Returns the id of the n-th element that failed in the last run.
+ */
+const std::string&
+SedExecutor::getFailedId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mFailed.size()) ? mFailed[n] : empty;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Registers simulator for language and takes ownership of it.
+ */
+void
+SedExecutor::adoptSimulator (const std::string& language,
+                             SedSimulator* simulator)
+{
+  if (simulator == NULL) return;
+
+  mOwnedSimulators.push_back(simulator);
+  setSimulator(language, simulator);
+}
+
+
+/*
+ * Returns the priority of step n for the cost model.
+ */
+double
+SedExecutor::getPriority (unsigned int n) const
+{
+  const Step& step = mSteps[n];
+
+  switch (step.kind)
+  {
+  case SED_STEP_MODEL:
+    // every task waits for its model
+    return HUGE_VAL;
+
+  case SED_STEP_TASK:
+  case SED_STEP_SWEEP:
+  {
+    if (mCostModel == NULL || step.failed || step.resumed) return 0;
+
+    const SedTask* task = static_cast<const SedTask*>(step.element);
+    const SedDocument* document = task->getSedDocument();
+    if (document == NULL) return 0;
+
+    return mCostModel->estimate(task,
+             document->getModel(task->getModelReference()),
+             document->getSimulation(task->getSimulationReference()));
+  }
+
+  default:
+    return 0;
+  }
+}
+
+
+/*
+ * Builds the steps of document and the edges between them.
+ */
+void
+SedExecutor::plan (const SedDocument* document)
+{
+  mSteps.clear();
+  mTaskResults.clear();
+  mTaskIndex.clear();
+  mResults.clear();
+  mFailed.clear();
+  mSweepSteps.clear();
+  mSweepResults.clear();
+  mGroups.clear();
+
+  std::map<std::string, unsigned int> models;
+  std::map<std::string, unsigned int> tasks;
+  std::map<std::string, unsigned int> dataGenerators;
+
+  Step step;
+  step.numDependencies = 0;
+  step.remaining       = 0;
+  step.failed          = false;
+  step.sweep           = NULL;
+  step.point           = 0;
+  step.group           = SED_NO_GROUP;
+  step.resumed         = false;
+
+  for (unsigned int i = 0; i < document->getNumModels(); ++i)
+  {
+    step.kind    = SED_STEP_MODEL;
+    step.element = document->getModel(i);
+    step.id      = document->getModel(i)->getId();
+    models[step.id] = (unsigned int)mSteps.size();
+    mSteps.push_back(step);
+  }
+
+  for (unsigned int i = 0; i < document->getNumTasks(); ++i)
+  {
+    step.kind    = SED_STEP_TASK;
+    step.element = document->getTask(i);
+    step.id      = document->getTask(i)->getId();
+    tasks[step.id] = (unsigned int)mSteps.size();
+    mTaskIndex[step.id] = i;
+    mSteps.push_back(step);
+  }
+  mTaskResults.resize(document->getNumTasks());
+  for (unsigned int i = 0; i < mTaskResults.size(); ++i)
+  {
+    mTaskResults[i].setMemoryBudget(mMemoryBudget);
+    mTaskResults[i].setSpillDirectory(mSpillDirectory);
+  }
+
+  for (unsigned int i = 0; i < document->getNumDataGenerators(); ++i)
+  {
+    step.kind    = SED_STEP_DATAGENERATOR;
+    step.element = document->getDataGenerator(i);
+    step.id      = document->getDataGenerator(i)->getId();
+    dataGenerators[step.id] = (unsigned int)mSteps.size();
+    mSteps.push_back(step);
+  }
+
+  for (unsigned int i = 0; i < document->getNumOutputs(); ++i)
+  {
+    step.kind    = SED_STEP_OUTPUT;
+    step.element = document->getOutput(i);
+    step.id      = document->getOutput(i)->getId();
+    mSteps.push_back(step);
+  }
+
+  // every point of a sweep is a step of its own, sharing the model and
+  // simulation of the task; no SED-ML element is made for it
+  mFirstSweepStep = (unsigned int)mSteps.size();
+  for (unsigned int i = 0; i < mSweeps.size(); ++i)
+  {
+    const SedSweep* sweep = mSweeps[i];
+    const size_t numPoints = sweep->getNumPoints();
+    if (numPoints > (unsigned int)-1 - mSteps.size()) continue;
+
+    mSweepSteps[sweep] = (unsigned int)mSteps.size();
+    step.kind    = SED_STEP_SWEEP;
+    step.element = sweep->getTask();
+    step.sweep   = sweep;
+
+    for (size_t p = 0; p < numPoints; ++p)
+    {
+      char index[32];
+      sprintf(index, "[%lu]", (unsigned long)p);
+
+      step.id    = sweep->getTask()->getId() + index;
+      step.point = p;
+      mSteps.push_back(step);
+    }
+  }
+  mSweepResults.resize(mSteps.size() - mFirstSweepStep);
+  for (unsigned int i = 0; i < mSweepResults.size(); ++i)
+  {
+    mSweepResults[i].setMemoryBudget(mMemoryBudget);
+    mSweepResults[i].setSpillDirectory(mSpillDirectory);
+  }
+
+  std::map<std::string, unsigned int>::const_iterator it;
+  std::map<std::string, const SedVariable*> bound;
+
+  for (unsigned int n = 0; n < mSteps.size(); ++n)
+  {
+    // the references of the step, to steps of the given map
+    std::vector<std::string> references;
+    const std::map<std::string, unsigned int>* targets = &models;
+
+    switch (mSteps[n].kind)
+    {
+    case SED_STEP_MODEL:
+    {
+      // a source naming another model of the document, with or without
+      // a leading '#', makes this model depend on it
+      std::string source =
+        static_cast<const SedModel*>(mSteps[n].element)->getSource();
+      if (!source.empty() && source[0] == '#') source.erase(0, 1);
+
+      it = models.find(source);
+      if (it != models.end() && it->second != n)
+      {
+        mSteps[it->second].dependents.push_back(n);
+        ++mSteps[n].numDependencies;
+      }
+      continue;
+    }
+
+    case SED_STEP_TASK:
+    {
+      const SedTask* task = static_cast<const SedTask*>(mSteps[n].element);
+      const SedSimulation* simulation =
+        document->getSimulation(task->getSimulationReference());
+      if (simulation == NULL)
+      {
+        mSteps[n].failed = true;
+      }
+      else if (simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+      {
+        // the grid is computed here, once, rather than by the first of the
+        // simulators to ask for it on the worker threads
+        static_cast<const SedUniformTimeCourse*>(simulation)->getTimeGrid();
+      }
+      references.push_back(task->getModelReference());
+      break;
+    }
+
+    case SED_STEP_DATAGENERATOR:
+    {
+      const SedDataGenerator* dg =
+        static_cast<const SedDataGenerator*>(mSteps[n].element);
+      targets = &tasks;
+
+      for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+      {
+        const SedVariable* variable = dg->getVariable(i);
+        references.push_back(variable->getTaskReference());
+
+        // the task is asked for every variable wanted from it
+        it = tasks.find(variable->getTaskReference());
+        if (it != tasks.end())
+        {
+          addTaskVariable(mSteps[it->second], variable, bound);
+        }
+      }
+      break;
+    }
+
+    case SED_STEP_OUTPUT:
+    {
+      const SedOutput* output =
+        static_cast<const SedOutput*>(mSteps[n].element);
+      targets = &dataGenerators;
+
+      if (output->getTypeCode() == SEDML_OUTPUT_REPORT)
+      {
+        const SedReport* report = static_cast<const SedReport*>(output);
+        for (unsigned int i = 0; i < report->getNumDataSets(); ++i)
+        {
+          references.push_back(report->getDataSet(i)->getDataReference());
+        }
+      }
+      else if (output->getTypeCode() == SEDML_OUTPUT_PLOT2D)
+      {
+        const SedPlot2D* plot = static_cast<const SedPlot2D*>(output);
+        for (unsigned int i = 0; i < plot->getNumCurves(); ++i)
+        {
+          references.push_back(plot->getCurve(i)->getXDataReference());
+          references.push_back(plot->getCurve(i)->getYDataReference());
+        }
+      }
+      else if (output->getTypeCode() == SEDML_OUTPUT_PLOT3D)
+      {
+        const SedPlot3D* plot = static_cast<const SedPlot3D*>(output);
+        for (unsigned int i = 0; i < plot->getNumSurfaces(); ++i)
+        {
+          references.push_back(plot->getSurface(i)->getXDataReference());
+          references.push_back(plot->getSurface(i)->getYDataReference());
+          references.push_back(plot->getSurface(i)->getZDataReference());
+        }
+      }
+      break;
+    }
+
+    case SED_STEP_SWEEP:
+    {
+      // the points of a sweep ask for what the data generators ask of its
+      // task, whose step has been seen by now
+      const SedTask* task = static_cast<const SedTask*>(mSteps[n].element);
+      it = tasks.find(task->getId());
+      if (it == tasks.end() || document->getTask(task->getId()) != task
+          || document->getSimulation(task->getSimulationReference()) == NULL)
+      {
+        mSteps[n].failed = true;
+      }
+      else
+      {
+        mSteps[n].variables = mSteps[it->second].variables;
+        mSteps[n].aliases   = mSteps[it->second].aliases;
+      }
+      references.push_back(task->getModelReference());
+      break;
+    }
+    }
+
+    for (unsigned int i = 0; i < references.size(); ++i)
+    {
+      it = targets->find(references[i]);
+      if (it == targets->end())
+      {
+        mSteps[n].failed = true;
+        continue;
+      }
+
+      mSteps[it->second].dependents.push_back(n);
+      ++mSteps[n].numDependencies;
+    }
+  }
+
+  // models naming each other as sources would wait for each other
+  // forever; such steps are failed and started at once instead
+  std::vector<unsigned int> remaining(mSteps.size());
+  std::vector<unsigned int> ready;
+  for (unsigned int n = 0; n < mSteps.size(); ++n)
+  {
+    remaining[n] = mSteps[n].numDependencies;
+    if (remaining[n] == 0) ready.push_back(n);
+  }
+
+  for (unsigned int k = 0; k < ready.size(); ++k)
+  {
+    const std::vector<unsigned int>& dependents = mSteps[ready[k]].dependents;
+    for (unsigned int i = 0; i < dependents.size(); ++i)
+    {
+      if (--remaining[dependents[i]] == 0) ready.push_back(dependents[i]);
+    }
+  }
+
+  for (unsigned int n = 0; n < mSteps.size(); ++n)
+  {
+    if (remaining[n] > 0)
+    {
+      mSteps[n].failed    = true;
+      mSteps[n].remaining = 0;
+    }
+    else
+    {
+      mSteps[n].remaining = mSteps[n].numDependencies;
+    }
+  }
+
+  if (!mRequestedOutputs.empty()
+      || (mCheckpoint != NULL && mCheckpoint->getNumOutputsDone() > 0))
+  {
+    prune();
+  }
+
+  groupDataGenerators();
+}
+
+
+/*
+ * Drops the steps the requested outputs and the sweeps do not need, and
+ * those only the outputs the checkpoint has recorded as done need.
+ */
+void
+SedExecutor::prune ()
+{
+  const unsigned int total = (unsigned int)mSteps.size();
+
+  std::vector<std::vector<unsigned int> > dependencies(total);
+  for (unsigned int n = 0; n < total; ++n)
+  {
+    const std::vector<unsigned int>& dependents = mSteps[n].dependents;
+    for (unsigned int i = 0; i < dependents.size(); ++i)
+    {
+      dependencies[dependents[i]].push_back(n);
+    }
+  }
+
+  // the requested outputs, or without requests every step nothing
+  // depends on, and the sweeps are kept, and with them everything they
+  // depend on; outputs done before are not
+  std::vector<bool>         keep(total, false);
+  std::vector<unsigned int> pending;
+  for (unsigned int i = 0; i < mRequestedOutputs.size(); ++i)
+  {
+    bool found = false;
+    for (unsigned int n = 0; n < total; ++n)
+    {
+      if (mSteps[n].kind == SED_STEP_OUTPUT
+          && mSteps[n].id == mRequestedOutputs[i])
+      {
+        found = true;
+        if (keep[n] || (mCheckpoint != NULL
+                        && mCheckpoint->isOutputDone(mSteps[n].id)))
+        {
+          continue;
+        }
+        keep[n] = true;
+        pending.push_back(n);
+      }
+    }
+    if (!found) mFailed.push_back(mRequestedOutputs[i]);
+  }
+
+  for (unsigned int n = 0; n < mFirstSweepStep && mRequestedOutputs.empty(); ++n)
+  {
+    if (!mSteps[n].dependents.empty()) continue;
+    if (mSteps[n].kind == SED_STEP_OUTPUT && mCheckpoint != NULL
+        && mCheckpoint->isOutputDone(mSteps[n].id))
+    {
+      continue;
+    }
+
+    keep[n] = true;
+    pending.push_back(n);
+  }
+
+  for (unsigned int n = mFirstSweepStep; n < total; ++n)
+  {
+    keep[n] = true;
+    pending.push_back(n);
+  }
+
+  while (!pending.empty())
+  {
+    const unsigned int n = pending.back();
+    pending.pop_back();
+
+    for (unsigned int i = 0; i < dependencies[n].size(); ++i)
+    {
+      const unsigned int d = dependencies[n][i];
+      if (!keep[d])
+      {
+        keep[d] = true;
+        pending.push_back(d);
+      }
+    }
+  }
+
+  // the tasks kept are asked only for what the data generators kept
+  // want, if outputs were requested; the sweeps copied the variables of
+  // their tasks before.  Without requests the tasks keep asking for all,
+  // so that their fingerprints are those of the runs before
+  std::map<std::string, unsigned int> tasks;
+  for (unsigned int n = 0; n < mFirstSweepStep; ++n)
+  {
+    if (mSteps[n].kind != SED_STEP_TASK) continue;
+
+    if (!keep[n])
+    {
+      mTaskIndex.erase(mSteps[n].id);
+    }
+    else if (!mRequestedOutputs.empty())
+    {
+      tasks[mSteps[n].id] = n;
+      mSteps[n].variables.clear();
+      mSteps[n].aliases.clear();
+    }
+  }
+
+  std::map<std::string, const SedVariable*> bound;
+  for (unsigned int n = 0; n < mFirstSweepStep && !tasks.empty(); ++n)
+  {
+    if (mSteps[n].kind != SED_STEP_DATAGENERATOR || !keep[n]) continue;
+
+    const SedDataGenerator* dg =
+      static_cast<const SedDataGenerator*>(mSteps[n].element);
+    for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+    {
+      const SedVariable* variable = dg->getVariable(i);
+      std::map<std::string, unsigned int>::const_iterator it =
+        tasks.find(variable->getTaskReference());
+      if (it != tasks.end()) addTaskVariable(mSteps[it->second], variable, bound);
+    }
+  }
+
+  // the steps kept are moved down over the others; every dependency of a
+  // step kept is kept, so only the dependents need to be filtered
+  std::vector<unsigned int> index(total, total);
+  unsigned int numKept = 0;
+  for (unsigned int n = 0; n < total; ++n)
+  {
+    if (keep[n]) index[n] = numKept++;
+  }
+
+  std::vector<Step> steps;
+  steps.reserve(numKept);
+  for (unsigned int n = 0; n < total; ++n)
+  {
+    if (!keep[n]) continue;
+
+    steps.push_back(mSteps[n]);
+    std::vector<unsigned int>& dependents = steps.back().dependents;
+
+    unsigned int k = 0;
+    for (unsigned int i = 0; i < dependents.size(); ++i)
+    {
+      if (keep[dependents[i]]) dependents[k++] = index[dependents[i]];
+    }
+    dependents.resize(k);
+  }
+
+  std::map<const SedSweep*, unsigned int>::iterator it;
+  for (it = mSweepSteps.begin(); it != mSweepSteps.end(); ++it)
+  {
+    it->second = index[it->second];
+  }
+  mFirstSweepStep = numKept - (total - mFirstSweepStep);
+
+  mSteps.swap(steps);
+}
+
+
+/*
+ * Takes the results of the tasks the checkpoint has from it, and marks
+ * those tasks, and the models only they need, as done before the run.
+ */
+void
+SedExecutor::resume (const SedDocument* document)
+{
+  for (unsigned int n = 0; n < mFirstSweepStep; ++n)
+  {
+    Step& step = mSteps[n];
+    if (step.kind != SED_STEP_TASK || step.failed) continue;
+
+    const std::string fingerprint = SedResultCache::getFingerprint(document,
+      static_cast<const SedTask*>(step.element), step.variables, NULL);
+
+    step.resumed = !fingerprint.empty()
+      && loadResults(mCheckpoint, fingerprint, step,
+                     mTaskResults[mTaskIndex.find(step.id)->second]);
+  }
+
+  // a model is not loaded if all steps depending on it are done, which
+  // for a model its source names may only be known after the others
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (unsigned int n = 0; n < mFirstSweepStep; ++n)
+    {
+      Step& step = mSteps[n];
+      if (step.kind != SED_STEP_MODEL || step.failed || step.resumed
+          || step.dependents.empty())
+      {
+        continue;
+      }
+
+      bool done = true;
+      for (unsigned int i = 0; done && i < step.dependents.size(); ++i)
+      {
+        done = mSteps[step.dependents[i]].resumed;
+      }
+
+      step.resumed = done;
+      changed      = changed || done;
+    }
+  }
+}
+
+
+/*
+ * Compiles the data generators whose variables refer to the same tasks
+ * together, so that they are evaluated at once.
+ */
+void
+SedExecutor::groupDataGenerators ()
+{
+  std::map<std::string, unsigned int> groups;
+
+  for (unsigned int n = 0; n < mSteps.size(); ++n)
+  {
+    if (mSteps[n].kind != SED_STEP_DATAGENERATOR || mSteps[n].failed) continue;
+
+    // a data generator that is one of its variables gets an alias instead
+    const SedDataGenerator* dg =
+      static_cast<const SedDataGenerator*>(mSteps[n].element);
+    if (dg->getIdentityVariable() != NULL) continue;
+
+    std::set<std::string> references;
+    for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+    {
+      references.insert(dg->getVariable(i)->getTaskReference());
+    }
+
+    std::string key;
+    std::set<std::string>::const_iterator r;
+    for (r = references.begin(); r != references.end(); ++r)
+    {
+      key += *r + '\n';
+    }
+
+    std::map<std::string, unsigned int>::const_iterator it = groups.find(key);
+    unsigned int g = 0;
+    if (it != groups.end())
+    {
+      g = it->second;
+    }
+    else
+    {
+      g = (unsigned int)mGroups.size();
+      groups[key] = g;
+      mGroups.push_back(Group());
+    }
+
+    // one that cannot be compiled is left to fail on its own
+    if (mGroups[g].math.add(dg) == LIBSEDML_OPERATION_SUCCESS)
+    {
+      mGroups[g].steps.push_back(n);
+    }
+  }
+
+  // a group of one gains nothing over evaluating it alone
+  std::vector<Group> kept;
+  for (unsigned int g = 0; g < mGroups.size(); ++g)
+  {
+    if (mGroups[g].steps.size() < 2) continue;
+
+    for (unsigned int i = 0; i < mGroups[g].steps.size(); ++i)
+    {
+      mSteps[mGroups[g].steps[i]].group = (unsigned int)kept.size();
+    }
+    kept.push_back(mGroups[g]);
+  }
+  mGroups.swap(kept);
+}
+
+
+/*
+ * Runs step n.
+ *
+ * @return false if the step failed.
+ */
+bool
+SedExecutor::runStep (Run& run, unsigned int n)
+{
+  const Step& step = mSteps[n];
+
+  // models and tasks the checkpoint had are done already
+  if (step.resumed) return true;
+
+  switch (step.kind)
+  {
+  case SED_STEP_MODEL:
+  {
+    const SedModel* model = static_cast<const SedModel*>(step.element);
+    SedSimulator* simulator = getSimulator(model->getLanguage());
+
+    if (simulator == NULL
+        || simulator->loadModel(model) != LIBSEDML_OPERATION_SUCCESS)
+    {
+      return false;
+    }
+
+    if (mCostModel != NULL)
+    {
+      mCostModel->setModelSize(model, simulator->getModelSize(model));
+    }
+    return true;
+  }
+
+  case SED_STEP_TASK:
+    // each task writes only to its own results
+    return simulateTask(run, step, NULL,
+                        mTaskResults[mTaskIndex.find(step.id)->second]);
+
+  case SED_STEP_DATAGENERATOR:
+  {
+    const SedDataGenerator* dg =
+      static_cast<const SedDataGenerator*>(step.element);
+
+    // a data generator that is just one of its variables is the column
+    // of the task, with nothing to evaluate or copy
+    const SedVariable* identity = dg->getIdentityVariable();
+    if (identity != NULL)
+    {
+      const SedResults& results =
+        mTaskResults[mTaskIndex.find(identity->getTaskReference())->second];
+
+      const double* values = results.getColumn(identity->getId());
+      if (values == NULL) return false;
+
+      mutexLock(&run.mutex);
+      const int result = mResults.setColumnAlias(dg->getId(), values,
+                           results.getColumnLength(identity->getId()));
+      mutexUnlock(&run.mutex);
+
+      return result == LIBSEDML_OPERATION_SUCCESS;
+    }
+
+    // the first step of a group to run evaluates all of it; if its
+    // columns do not all have the same length, each is evaluated alone
+    if (step.group != SED_NO_GROUP)
+    {
+      SedExecutorGroup& state = run.groups[step.group];
+      mutexLock(&state.mutex);
+      if (!state.evaluated)
+      {
+        state.evaluated = true;
+        try
+        {
+          state.succeeded = evaluateGroup(run, mGroups[step.group]);
+        }
+        catch (...)
+        {
+          state.succeeded = false;
+        }
+      }
+      const bool succeeded = state.succeeded;
+      mutexUnlock(&state.mutex);
+
+      if (succeeded) return true;
+    }
+
+    SedCompiledMath math;
+    if (math.compile(dg) != LIBSEDML_OPERATION_SUCCESS) return false;
+
+    // the tasks are done, so their results are no longer written to
+    std::vector<const double*> columns(dg->getNumVariables());
+    size_t length = (columns.empty()) ? 1 : (size_t)-1;
+
+    for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+    {
+      const SedVariable* variable = dg->getVariable(i);
+      const SedResults& results =
+        mTaskResults[mTaskIndex.find(variable->getTaskReference())->second];
+
+      columns[i] = results.getColumn(variable->getId());
+      if (columns[i] == NULL) return false;
+
+      size_t n = results.getColumnLength(variable->getId());
+      if (n < length) length = n;
+    }
+
+    mutexLock(&run.mutex);
+    double* values = mResults.addColumn(dg->getId(), length);
+    mutexUnlock(&run.mutex);
+
+    // the buffer of the column stays put while other columns are added,
+    // and nothing reads it before this step is done
+    return values != NULL
+        && math.evaluate(columns.empty() ? NULL : &columns[0], length,
+                         values) == LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  case SED_STEP_SWEEP:
+  {
+    const SedSweepPoint point = step.sweep->getPoint(step.point);
+    return simulateTask(run, step, &point,
+                        mSweepResults[n - mFirstSweepStep]);
+  }
+
+  case SED_STEP_OUTPUT:
+    if (mOutputHandler != NULL)
+    {
+      mutexLock(&run.mutex);
+      mOutputHandler->outputReady(static_cast<const SedOutput*>(step.element),
+                                  mResults);
+      mutexUnlock(&run.mutex);
+
+      if (mCheckpoint != NULL) mCheckpoint->setOutputDone(step.id);
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Evaluates the data generators of group into the results.
+ *
+ * @return false if a column is missing or the columns differ in length.
+ */
+bool
+SedExecutor::evaluateGroup (Run& run, const Group& group)
+{
+  const SedCompiledMathSet& math = group.math;
+
+  // the tasks are done, so their results are no longer written to
+  std::vector<const double*> columns(math.getNumInputs());
+  size_t length = 1;
+
+  for (unsigned int i = 0; i < math.getNumInputs(); ++i)
+  {
+    const SedResults& results =
+      mTaskResults[mTaskIndex.find(math.getInputTaskReference(i))->second];
+
+    columns[i] = results.getColumn(math.getInputId(i));
+    if (columns[i] == NULL) return false;
+
+    const size_t n = results.getColumnLength(math.getInputId(i));
+    if (i > 0 && n != length) return false;
+    length = n;
+  }
+
+  std::vector<double*> values(math.getNumDataGenerators());
+
+  mutexLock(&run.mutex);
+  for (unsigned int i = 0; i < values.size(); ++i)
+  {
+    values[i] = mResults.addColumn(math.getDataGeneratorId(i), length);
+    if (values[i] == NULL) break;
+  }
+  mutexUnlock(&run.mutex);
+
+  for (unsigned int i = 0; i < values.size(); ++i)
+  {
+    if (values[i] == NULL) return false;
+  }
+
+  return math.evaluate(columns.empty() ? NULL : &columns[0], length,
+                       &values[0]) == LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Simulates the task of step, at point if that is not NULL, unless the
+ * result cache has its results.
+ *
+ * @return false if the simulation failed.
+ */
+bool
+SedExecutor::simulateTask (Run& run, const Step& step,
+                           const SedSweepPoint* point, SedResults& results)
+{
+  const SedTask* task = static_cast<const SedTask*>(step.element);
+  const SedModel* model = run.document->getModel(task->getModelReference());
+  const SedSimulation* simulation =
+    run.document->getSimulation(task->getSimulationReference());
+
+  const SedAlgorithm* algorithm = (simulation != NULL)
+                                ? simulation->getAlgorithm() : NULL;
+  const bool stochastic = algorithm != NULL
+    && algorithm->hasKisaoCapabilities(SED_KISAO_STOCHASTIC);
+
+  // cached results are only used if they have every column wanted, and
+  // those of stochastic tasks only if they were drawn with the same seed
+  std::string fingerprint;
+  if (mResultCache != NULL || mCheckpoint != NULL)
+  {
+    fingerprint = SedResultCache::getFingerprint(run.document, task,
+                                                 step.variables, point);
+    if (stochastic && !fingerprint.empty())
+    {
+      char seed[32];
+      sprintf(seed, "seed %llu\x1f", mSeed);
+      fingerprint += seed;
+    }
+    if (!fingerprint.empty()
+        && ((mResultCache != NULL
+             && loadResults(mResultCache, fingerprint, step, results))
+            || (mCheckpoint != NULL
+                && loadResults(mCheckpoint, fingerprint, step, results))))
+    {
+      return true;
+    }
+  }
+
+  SedSimulator* simulator = getSimulator(model->getLanguage());
+  if (simulator == NULL) return false;
+
+  // an algorithm the simulator cannot run, nor anything standing in for it
+  const SedAlgorithmSupport* support = simulator->getAlgorithmSupport();
+  if (support != NULL && algorithm != NULL
+      && algorithm->getKisaoIndex() != SED_KISAO_UNKNOWN
+      && support->getSubstitute(algorithm) == SED_KISAO_UNKNOWN)
+  {
+    return false;
+  }
+
+  const double started = (mCostModel != NULL) ? SedProfiler::getTime() : 0;
+
+  int result = LIBSEDML_OPERATION_FAILED;
+  if (stochastic)
+  {
+    SedRandomStream random = getRandomStream(run.document, task, point);
+    result = simulator->simulateStochastic(task, model, simulation, point,
+                                           random, step.variables, results);
+  }
+  else
+  {
+    result = (point != NULL)
+      ? simulator->simulatePoint(task, model, simulation, *point,
+                                 step.variables, results)
+      : simulator->simulate(task, model, simulation, step.variables, results);
+  }
+  if (result != LIBSEDML_OPERATION_SUCCESS) return false;
+
+  if (mCostModel != NULL)
+  {
+    mCostModel->observe(task, model, simulation,
+                        SedProfiler::getTime() - started);
+  }
+
+  if (!fingerprint.empty())
+  {
+    if (mResultCache != NULL) mResultCache->store(fingerprint, results);
+    if (mCheckpoint != NULL) mCheckpoint->store(fingerprint, results);
+  }
+  addAliases(step, results);
+  return true;
+}
+
+
+/*
+ * Runs ready steps until all steps of run are done.
+ */
+void
+SedExecutor::runWorker (Run& run, unsigned int worker)
+{
+  SedExecutor* executor = run.executor;
+  const unsigned int total = (unsigned int)executor->mSteps.size();
+
+  for (;;)
+  {
+    unsigned int n = 0;
+
+    if (!popStep(run, worker, n))
+    {
+      mutexLock(&run.mutex);
+      while (run.numQueued == 0 && run.numDone < total)
+      {
+        conditionWait(&run.condition, &run.mutex);
+      }
+      bool finished = (run.numDone >= total);
+      mutexUnlock(&run.mutex);
+
+      if (finished) return;
+      continue;
+    }
+
+    mutexLock(&run.mutex);
+    --run.numQueued;
+    mutexUnlock(&run.mutex);
+
+#ifdef USE_PROFILING
+    SedProfiler* profiler = executor->mProfiler;
+    const double started = (profiler != NULL) ? SedProfiler::getTime() : 0;
+#endif
+
+    // the failed flag of a step only changes before it becomes ready
+    Step& step = executor->mSteps[n];
+    bool ok = !step.failed;
+    if (ok)
+    {
+      try
+      {
+        ok = executor->runStep(run, n);
+      }
+      catch (...)
+      {
+        // nothing may escape a worker thread; the step fails instead
+        ok = false;
+      }
+    }
+
+#ifdef USE_PROFILING
+    if (profiler != NULL)
+    {
+      SedProfileCounters counters;
+      SedProfiler::clear(counters);
+      counters.numSteps        = 1;
+      counters.stepWaitTime    = started - run.readyTimes[n];
+      counters.maxStepWaitTime = counters.stepWaitTime;
+      counters.stepRunTime     = SedProfiler::getTime() - started;
+      profiler->record(counters);
+    }
+#endif
+
+    mutexLock(&run.mutex);
+
+    if (!ok) step.failed = true;
+
+    bool wake = false;
+    for (unsigned int i = 0; i < step.dependents.size(); ++i)
+    {
+      Step& dependent = executor->mSteps[step.dependents[i]];
+      if (!ok) dependent.failed = true;
+
+      if (dependent.remaining > 0 && --dependent.remaining == 0)
+      {
+        pushStep(run, worker, step.dependents[i]);
+        wake = true;
+      }
+    }
+
+    ++run.numDone;
+    if (wake || run.numDone >= total) conditionBroadcast(&run.condition);
+
+    mutexUnlock(&run.mutex);
+  }
+}
+
+
+/*
+ * Entry point of the worker threads.
+ */
+void
+SedExecutor::workerMain (void* arg)
+{
+  SedExecutorThread* thread = static_cast<SedExecutorThread*>(arg);
+  runWorker(*thread->run, thread->worker);
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedExecutor and returns it.
+ */
+LIBSEDML_EXTERN
+SedExecutor_t *
+SedExecutor_create (unsigned int numThreads)
+{
+  return new (nothrow) SedExecutor(numThreads);
+}
+
+
+/**
+ * Frees the given SedExecutor.
+ */
+LIBSEDML_EXTERN
+void
+SedExecutor_free (SedExecutor_t *se)
+{
+  delete se;
+}
+
+
+/**
+ * Registers func as the simulator for models in language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSimulator (SedExecutor_t *se, const char *language,
+                          SedExecutor_simulateFunc func, void *userData)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const std::string lang = (language != NULL) ? language : "";
+  if (func == NULL)
+  {
+    se->setSimulator(lang, NULL);
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  SedSimulator* simulator = new (nothrow) SedCallbackSimulator(func, userData);
+  if (simulator == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  se->adoptSimulator(lang, simulator);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Executes the given SedDocument.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_run (SedExecutor_t *se, const SedDocument_t *document)
+{
+  return (se != NULL) ? se->run(document) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the values of the data generators of the last run.
+ */
+LIBSEDML_EXTERN
+const SedResults_t *
+SedExecutor_getResults (const SedExecutor_t *se)
+{
+  return (se != NULL) ? &se->getResults() : NULL;
+}
+
+
+/**
+ * Returns the number of elements that failed in the last run.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedExecutor_getNumFailed (const SedExecutor_t *se)
+{
+  return (se != NULL) ? se->getNumFailed() : 0;
+}
+
+
+/**
+ * Sets the cache consulted before every simulation.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setResultCache (SedExecutor_t *se, SedResultCache_t *cache)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setResultCache(cache);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the checkpoint recording the progress of every run.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setCheckpoint (SedExecutor_t *se, SedCheckpoint_t *checkpoint)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setCheckpoint(checkpoint);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the profiler recording every step of the following runs.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setProfiler (SedExecutor_t *se, SedProfiler_t *profiler)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setProfiler(profiler);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the SedCostModel ordering the ready steps of the following runs.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setCostModel (SedExecutor_t *se, SedCostModel_t *costModel)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setCostModel(costModel);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the seed the random streams of the stochastic tasks of the
+ * following runs are derived from.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSeed (SedExecutor_t *se, unsigned long long seed)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setSeed(seed);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Registers sweep to be run with the document of every following run.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_addSweep (SedExecutor_t *se, const SedSweep_t *sweep)
+{
+  return (se != NULL) ? se->addSweep(sweep) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Requests the output outputId.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_addRequestedOutput (SedExecutor_t *se, const char *outputId)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return se->addRequestedOutput(outputId != NULL ? outputId : "");
+}
+
+
+/**
+ * Withdraws all requests.
+ */
+LIBSEDML_EXTERN
+void
+SedExecutor_clearRequestedOutputs (SedExecutor_t *se)
+{
+  if (se != NULL) se->clearRequestedOutputs();
+}
+
+
+/**
+ * Returns the results of point index of sweep in the last run.
+ */
+LIBSEDML_EXTERN
+const SedResults_t *
+SedExecutor_getSweepResults (const SedExecutor_t *se,
+                             const SedSweep_t *sweep, size_t index)
+{
+  return (se != NULL) ? se->getSweepResults(sweep, index) : NULL;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,804 @@
+/**
+ * @file    SedExecutor.h
+ * @brief   Runs the tasks of a SedDocument in dependency order on a pool
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedExecutor
+ * @ingroup Core
+ * @brief Executes a SedDocument with user-supplied simulators.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * run() plans the execution of a SedDocument as a graph of steps:
+ *
+ * @li every SedModel is loaded, after the model its source names if that
+ * is another model of the document;
+ * @li every SedTask is simulated once its model has been loaded;
+ * @li every SedDataGenerator is evaluated, with SedCompiledMath, once all
+ * tasks its variables refer to have been simulated; data generators whose
+ * variables refer to the same tasks are compiled together into a
+ * SedCompiledMathSet, so that the subexpressions they share are
+ * evaluated once for all of them;
+ * @li every SedOutput is handed to the SedOutputHandler once all data
+ * generators it refers to have been evaluated;
+ * @li every point of every SedSweep registered with addSweep() is
+ * simulated, like a task of its own, once the model of the base task of
+ * the sweep has been loaded.
+ *
+ * If outputs have been requested with addRequestedOutput(), only the part
+ * of the graph they need is run: the requested outputs, the data
+ * generators their curves, surfaces and data sets refer to, the tasks the
+ * variables of those refer to, and the models of those tasks, together
+ * with the sweeps and their models.  Every other step is dropped before
+ * the run, and the tasks that are run are asked only for the variables of
+ * the data generators that are.
+ *
+ * With a SedResultCache (see setResultCache()), tasks and sweep points
+ * whose fingerprint is in the cache are not simulated: their results are
+ * loaded from it instead, and the results of those that were simulated
+ * are stored in it.
+ *
+ * With a SedCheckpoint (see setCheckpoint()), a run that was stopped can
+ * be started again where it stopped: the results of the tasks and sweep
+ * points simulated are stored in the checkpoint and every output handed
+ * to the SedOutputHandler is recorded in it.  A following run of the
+ * document drops the outputs recorded, with the data generators and
+ * tasks only they need, takes the results of the tasks it finds in the
+ * checkpoint without simulating them or, if no task left needs them,
+ * loading their models, and runs only the rest of the graph.
+ *
+ * With a SedProfiler (see setProfiler()), how long every step waited in a
+ * queue once it was ready, and how long it ran, are recorded.
+ *
+ * With a SedCostModel (see setCostModel()), the ready steps are not taken
+ * newest first: models are loaded first, since every task waits for its
+ * model, then the tasks and sweep points the model expects to take
+ * longest, and every step that becomes ready goes to the worker with the
+ * least work queued; idle workers take the longest task of the worker
+ * with the most work.  The time every simulation takes is given back to
+ * the model, together with the size of the model the simulator reports.
+ *
+ * Tasks and sweep points whose algorithm is stochastic (see SedKisao)
+ * are given to SedSimulator::simulateStochastic() with a SedRandomStream
+ * of their own, derived from the seed of the executor (see setSeed()) and
+ * what the task runs, so that their results are the same whichever
+ * thread runs them, and for any number of threads.
+ *
+ * Models and tasks are not run by libSEDML itself: a SedSimulator is
+ * registered for each model language (see setSimulator()), and receives
+ * every task whose model is in that language together with the variables
+ * the data generators want from it.  Of several variables referring to
+ * the same model, target and symbol of a task only the first is asked
+ * for; the results of the task get the column of each of the others as
+ * an alias of it.  A SedSimulatorAdapter is a simulator that has the
+ * columns of those variables bound for it, and pushes the output of the
+ * solver into them as it runs.  Steps whose dependencies are done
+ * are run by a pool of threads.  Each thread keeps its own queue of ready
+ * steps and works on the most recently readied one first; a thread whose
+ * queue is empty takes the oldest step from the queue of another thread.
+ *
+ * A step fails if an element it refers to does not exist, if there is
+ * no simulator for the language of a model, if a simulator returns an
+ * error, or if one of its dependencies failed; steps depending on failed
+ * ones are skipped.  The ids of the failed elements are available after
+ * run() returns.
+ *
+ * @section executor-threads Thread safety
+ * SedSimulator::loadModel() and SedSimulator::simulate() are called from
+ * the worker threads, concurrently for different models and tasks, so a
+ * simulator registered for several of them must be thread-safe.  Calls to
+ * SedOutputHandler::outputReady() are serialised.  The document must not
+ * be changed while run() executes it.
+ */
+
+#ifndef SedExecutor_h
+#define SedExecutor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedRandomStream.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+class SedModel;
+class SedSimulation;
+class SedTask;
+class SedVariable;
+class SedOutput;
+class SedSweep;
+class SedSweepPoint;
+class SedResultCache;
+class SedCheckpoint;
+class SedProfiler;
+class SedCostModel;
+class SedAlgorithmSupport;
+
+
+class LIBSEDML_EXTERN SedSimulator
+{
+public:
+
+  /**
+   * Destroys this SedSimulator.
+   */
+  virtual ~SedSimulator ();
+
+
+  /**
+   * Called once for every model of the document in the language of this
+   * simulator, before any task using it is simulated.  The default does
+   * nothing.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value fails the model and every task using it.
+   */
+  virtual int loadModel (const SedModel* model);
+
+
+  /**
+   * Called once @p model has been loaded, if the executor has a
+   * SedCostModel, to learn how large it is, in any unit that the time to
+   * simulate it grows with, such as its number of state variables.  The
+   * default returns 0, for a size that is not known.
+   */
+  virtual double getModelSize (const SedModel* model);
+
+
+  /**
+   * Returns the KiSAO algorithms this simulator implements, if it
+   * knows them; a task whose algorithm is in the registry of SedKisao but
+   * has no substitute among them then fails without being simulated.  The
+   * default returns @c NULL, leaving every algorithm to simulate().
+   */
+  virtual const SedAlgorithmSupport* getAlgorithmSupport () const;
+
+
+  /**
+   * Simulates @p task and stores the values of @p variables in
+   * @p results, one column per variable, keyed by SedVariable::getId().
+   *
+   * @param task the task to run.
+   * @param model the model of the task.
+   * @param simulation the simulation of the task.
+   * @param variables the variables of the data generators that refer to
+   * the task.
+   * @param results the results of the task, empty on entry.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value fails the task.
+   */
+  virtual int simulate (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation,
+                        const std::vector<const SedVariable*>& variables,
+                        SedResults& results) = 0;
+
+
+  /**
+   * Simulates @p point of a SedSweep over @p task: @p task with the
+   * targets of the point set to its values, on top of the changes of
+   * @p model.  The arguments are otherwise those of simulate().
+   *
+   * The default simulates a copy of @p model with one SedChangeAttribute
+   * per target added, made for the call; simulators that can apply the
+   * values themselves should override it.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value fails the point.
+   */
+  virtual int simulatePoint (const SedTask* task, const SedModel* model,
+                             const SedSimulation* simulation,
+                             const SedSweepPoint& point,
+                             const std::vector<const SedVariable*>& variables,
+                             SedResults& results);
+
+
+  /**
+   * Simulates @p task or, if @p point is not @c NULL, that point of a
+   * SedSweep over it, drawing every random number from @p random; called
+   * instead of simulate() and simulatePoint() when the algorithm of
+   * @p simulation is stochastic.  The stream is the same in every run of
+   * the same task or point under the same seed, and differs between
+   * them.  The arguments are otherwise those of simulatePoint().
+   *
+   * The default ignores @p random and calls simulatePoint() or
+   * simulate(); simulators of stochastic algorithms should override it.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value fails the task or point.
+   */
+  virtual int simulateStochastic (const SedTask* task, const SedModel* model,
+                                  const SedSimulation* simulation,
+                                  const SedSweepPoint* point,
+                                  SedRandomStream& random,
+                                  const std::vector<const SedVariable*>&
+                                    variables,
+                                  SedResults& results);
+};
+
+
+class LIBSEDML_EXTERN SedOutputHandler
+{
+public:
+
+  /**
+   * Destroys this SedOutputHandler.
+   */
+  virtual ~SedOutputHandler ();
+
+
+  /**
+   * Called once for each output whose data generators have all been
+   * evaluated.  Calls are serialised but come from the worker threads.
+   *
+   * @param output the output.
+   * @param results the values of the data generators, keyed by their
+   * ids; see SedResults::getView() for the columns of the output.
+   */
+  virtual void outputReady (const SedOutput* output,
+                            const SedResults& results) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedExecutor
+{
+public:
+
+  /**
+   * Creates a new SedExecutor using @p numThreads threads.  A value of
+   * zero uses one thread per available processor.
+   */
+  SedExecutor (unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedExecutor.
+   */
+  virtual ~SedExecutor ();
+
+
+  /**
+   * Sets the number of threads used; zero means one per processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next run will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Registers @p simulator, which this executor does not own, for the
+   * models whose language is @p language.  A simulator registered for
+   * the empty string is used for all languages without one of their own.
+   * Passing @c NULL removes the registration.
+   */
+  void setSimulator (const std::string& language, SedSimulator* simulator);
+
+
+  /**
+   * @return the simulator used for models in @p language, or @c NULL.
+   */
+  SedSimulator* getSimulator (const std::string& language) const;
+
+
+  /**
+   * Sets the handler, which this executor does not own, told about every
+   * output once its values are known; @c NULL removes it.
+   */
+  void setOutputHandler (SedOutputHandler* handler);
+
+
+  /**
+   * Sets the cache, which this executor does not own, looked up before
+   * every task and sweep point is simulated and given the results of
+   * those that were; @c NULL removes it.
+   */
+  void setResultCache (SedResultCache* cache);
+
+
+  /**
+   * @return the cache looked up before every simulation, or @c NULL.
+   */
+  SedResultCache* getResultCache () const;
+
+
+  /**
+   * Sets the checkpoint, which this executor does not own, that records
+   * the progress of every following run, and from which a run resumes
+   * the work of the runs of the same document before it; @c NULL removes
+   * it.  Tasks and sweep points are looked up in the result cache first,
+   * then in the checkpoint, and their results are stored in both.
+   */
+  void setCheckpoint (SedCheckpoint* checkpoint);
+
+
+  /**
+   * @return the checkpoint recording the progress of the runs, or
+   * @c NULL.
+   */
+  SedCheckpoint* getCheckpoint () const;
+
+
+  /**
+   * Sets the SedProfiler, which this executor does not own, that every
+   * step of the following runs is recorded by once it is done, with the
+   * time it waited in a queue once ready and the time it ran; @c NULL,
+   * the default, removes it.  It is only used if SedProfiler::isEnabled().
+   */
+  void setProfiler (SedProfiler* profiler);
+
+
+  /**
+   * @return the SedProfiler the steps are recorded by, or @c NULL.
+   */
+  SedProfiler* getProfiler () const;
+
+
+  /**
+   * Sets the SedCostModel, which this executor does not own, that orders
+   * the ready steps of the following runs and learns from their tasks;
+   * @c NULL, the default, removes it.
+   */
+  void setCostModel (SedCostModel* costModel);
+
+
+  /**
+   * @return the SedCostModel ordering the ready steps, or @c NULL.
+   */
+  SedCostModel* getCostModel () const;
+
+
+  /**
+   * Sets the seed the random streams of the stochastic tasks of the
+   * following runs are derived from; 0 is the default.
+   */
+  void setSeed (unsigned long long seed);
+
+
+  /**
+   * @return the seed the random streams of stochastic tasks are derived
+   * from.
+   */
+  unsigned long long getSeed () const;
+
+
+  /**
+   * @return the random stream of @p task of @p document or, if @p point
+   * is not @c NULL, of that point of a sweep over it, under the seed of
+   * this executor: keyed by the seed and the fingerprint of the task
+   * without variables (see SedResultCache::getFingerprint()), with the
+   * stream number 0 for the task and 1 + its index for a point.
+   */
+  SedRandomStream getRandomStream (const SedDocument* document,
+                                   const SedTask* task,
+                                   const SedSweepPoint* point = NULL) const;
+
+
+  /**
+   * Sets the number of bytes the columns of each of the results of the
+   * following runs, those of every task and sweep point and those of the
+   * data generators, may take in memory before further columns are
+   * spilled to temporary files in @p directory; see
+   * SedResults::setMemoryBudget().  Zero, the default, keeps everything
+   * in memory.
+   */
+  void setMemoryBudget (size_t bytes, const std::string& directory = "");
+
+
+  /**
+   * @return the number of bytes the columns of each of the results may
+   * take in memory, or 0 if there is no limit.
+   */
+  size_t getMemoryBudget () const;
+
+
+  /**
+   * Registers @p sweep, which this executor does not own, to be run with
+   * the document of every following run; its task must be a task of that
+   * document.  A sweep is registered only once.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p sweep or its task is @c NULL
+   */
+  int addSweep (const SedSweep* sweep);
+
+
+  /**
+   * Unregisters all sweeps; the results of the last run stay available.
+   */
+  void clearSweeps ();
+
+
+  /**
+   * @return the number of sweeps registered.
+   */
+  unsigned int getNumSweeps () const;
+
+
+  /**
+   * Requests the output @p outputId, so that the following runs only do
+   * what the outputs requested need.  A requested output the document
+   * does not have fails the run.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p outputId is empty
+   */
+  int addRequestedOutput (const std::string& outputId);
+
+
+  /**
+   * Withdraws all requests, so that the following runs run everything.
+   */
+  void clearRequestedOutputs ();
+
+
+  /**
+   * @return the number of outputs requested.
+   */
+  unsigned int getNumRequestedOutputs () const;
+
+
+  /**
+   * Executes @p document, replacing the results of the previous run.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p document is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any step failed; see getNumFailed()
+   */
+  int run (const SedDocument* document);
+
+
+  /**
+   * @return the values of the data generators of the last run, keyed by
+   * their ids.  The columns of data generators that are just one of their
+   * variables are aliases of the columns of the task results, valid until
+   * the next run.
+   */
+  const SedResults& getResults () const;
+
+
+  /**
+   * @return the results of the task @p taskId in the last run, or
+   * @c NULL if there is no such task, it failed or no requested output
+   * needed it; a task only outputs a checkpoint recorded as done needed
+   * is not run either.
+   */
+  const SedResults* getTaskResults (const std::string& taskId) const;
+
+
+  /**
+   * @return the results of point @p index of @p sweep in the last run, or
+   * @c NULL if the sweep was not run, there is no such point or it failed.
+   * The id of a failed point is the id of the task of the sweep followed
+   * by the index in brackets, as in <code>task1[12]</code>.
+   */
+  const SedResults* getSweepResults (const SedSweep* sweep,
+                                     size_t index) const;
+
+
+  /**
+   * @return the number of elements that failed in the last run.
+   */
+  unsigned int getNumFailed () const;
+
+
+  /**
+   * @return the id of the n-th element that failed in the last run, in
+   * document order, or an empty string if @p n is out of range.
+   */
+  const std::string& getFailedId (unsigned int n) const;
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * Registers simulator for language like setSimulator(), but deletes it
+   * with this executor; used by the C API.
+   */
+  void adoptSimulator (const std::string& language, SedSimulator* simulator);
+
+
+  /*
+   * Returns the priority of step n for the cost model: the highest for
+   * models, the expected seconds for tasks and sweep points, and 0 for
+   * the other steps.
+   */
+  double getPriority (unsigned int n) const;
+
+
+  /*
+   * A model to load, a task to simulate, a data generator to evaluate or
+   * an output to report.
+   */
+  struct Step
+  {
+    int                              kind;
+    const SedBase*                   element;
+    std::string                      id;
+    std::vector<unsigned int>        dependents;
+    unsigned int                     numDependencies;
+    unsigned int                     remaining;
+    bool                             failed;
+    std::vector<const SedVariable*>  variables;
+    const SedSweep*                  sweep;
+    size_t                           point;
+    std::vector<std::pair<std::string, std::string> > aliases;
+    unsigned int                     group;
+    bool                             resumed;
+  };
+
+  /*
+   * Data generators over the same tasks, evaluated together.
+   */
+  struct Group
+  {
+    SedCompiledMathSet               math;
+    std::vector<unsigned int>        steps;
+  };
+
+  struct Run;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedExecutor (const SedExecutor& orig);
+  SedExecutor& operator= (const SedExecutor& rhs);
+
+  void plan (const SedDocument* document);
+
+  void prune ();
+
+  void resume (const SedDocument* document);
+
+  void groupDataGenerators ();
+
+  bool evaluateGroup (Run& run, const Group& group);
+
+  bool runStep (Run& run, unsigned int n);
+
+  bool simulateTask (Run& run, const Step& step, const SedSweepPoint* point,
+                     SedResults& results);
+
+  static void runWorker (Run& run, unsigned int worker);
+
+  static void workerMain (void* arg);
+
+
+  unsigned int                          mNumThreads;
+  std::map<std::string, SedSimulator*>  mSimulators;
+  SedOutputHandler*                     mOutputHandler;
+  SedResultCache*                       mResultCache;
+  SedCheckpoint*                        mCheckpoint;
+  SedProfiler*                          mProfiler;
+  SedCostModel*                         mCostModel;
+  unsigned long long                    mSeed;
+  size_t                                mMemoryBudget;
+  std::string                           mSpillDirectory;
+
+  std::vector<Step>                     mSteps;
+  std::vector<SedResults>               mTaskResults;
+  std::map<std::string, unsigned int>   mTaskIndex;
+  SedResults                            mResults;
+  std::vector<std::string>              mFailed;
+  std::vector<SedSimulator*>            mOwnedSimulators;
+
+  std::vector<std::string>              mRequestedOutputs;
+
+  std::vector<Group>                    mGroups;
+
+  std::vector<const SedSweep*>          mSweeps;
+  std::map<const SedSweep*, unsigned int> mSweepSteps;
+  std::vector<SedResults>               mSweepResults;
+  unsigned int                          mFirstSweepStep;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Function simulating a task for a SedExecutor; it stores the values of
+ * the @p numVariables @p variables in @p results and returns
+ * LIBSEDML_OPERATION_SUCCESS on success.
+ */
+typedef int (*SedExecutor_simulateFunc) (const SedTask_t *task,
+                                         const SedModel_t *model,
+                                         const SedSimulation_t *simulation,
+                                         const SedVariable_t *const *variables,
+                                         unsigned int numVariables,
+                                         SedResults_t *results,
+                                         void *userData);
+
+
+/**
+ * Creates a new SedExecutor using @p numThreads threads and returns it.
+ */
+LIBSEDML_EXTERN
+SedExecutor_t *
+SedExecutor_create (unsigned int numThreads);
+
+
+/**
+ * Frees the given SedExecutor.
+ */
+LIBSEDML_EXTERN
+void
+SedExecutor_free (SedExecutor_t *se);
+
+
+/**
+ * Registers @p func as the simulator for models in @p language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSimulator (SedExecutor_t *se, const char *language,
+                          SedExecutor_simulateFunc func, void *userData);
+
+
+/**
+ * Executes the given SedDocument.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_run (SedExecutor_t *se, const SedDocument_t *document);
+
+
+/**
+ * Returns the values of the data generators of the last run.
+ */
+LIBSEDML_EXTERN
+const SedResults_t *
+SedExecutor_getResults (const SedExecutor_t *se);
+
+
+/**
+ * Returns the number of elements that failed in the last run.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedExecutor_getNumFailed (const SedExecutor_t *se);
+
+
+/**
+ * Sets the cache, which the executor does not own, consulted before every
+ * simulation; @c NULL removes it.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setResultCache (SedExecutor_t *se, SedResultCache_t *cache);
+
+
+/**
+ * Sets the checkpoint, which the executor does not own, recording the
+ * progress of every run; @c NULL removes it.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setCheckpoint (SedExecutor_t *se, SedCheckpoint_t *checkpoint);
+
+
+/**
+ * Sets the SedProfiler, which the executor does not own, recording every
+ * step of the following runs; @c NULL removes it.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setProfiler (SedExecutor_t *se, SedProfiler_t *profiler);
+
+
+/**
+ * Sets the SedCostModel, which the executor does not own, ordering the
+ * ready steps of the following runs; @c NULL removes it.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setCostModel (SedExecutor_t *se, SedCostModel_t *costModel);
+
+
+/**
+ * Sets the seed the random streams of the stochastic tasks of the
+ * following runs are derived from.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSeed (SedExecutor_t *se, unsigned long long seed);
+
+
+/**
+ * Registers @p sweep, which the executor does not own, to be run with the
+ * document of every following run.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_addSweep (SedExecutor_t *se, const SedSweep_t *sweep);
+
+
+/**
+ * Returns the results of point @p index of @p sweep in the last run, or
+ * @c NULL.
+ */
+LIBSEDML_EXTERN
+const SedResults_t *
+SedExecutor_getSweepResults (const SedExecutor_t *se,
+                             const SedSweep_t *sweep, size_t index);
+
+
+/**
+ * Requests the output @p outputId, so that the following runs only do
+ * what the outputs requested need.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_addRequestedOutput (SedExecutor_t *se, const char *outputId);
+
+
+/**
+ * Withdraws all requests, so that the following runs run everything.
+ */
+LIBSEDML_EXTERN
+void
+SedExecutor_clearRequestedOutputs (SedExecutor_t *se);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedExecutor_h */
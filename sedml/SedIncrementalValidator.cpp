@@ -0,0 +1,392 @@
+/**
+ * @file    SedIncrementalValidator.cpp
+ * @brief   Validates only what has changed in a document since the last run
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedIncrementalValidator.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedErrorLog.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns true for the errors a SedIncrementalValidator logs.
+ */
+static bool
+isValidationError (const SedError* error, void*)
+{
+  const unsigned int id = error->getErrorId();
+  return id == MissingRequiredSedAttribute
+    || id == MissingRequiredSedElement
+    || id == DanglingSedReference;
+}
+
+
+/*
+ * Orders errors by where they were read from.
+ */
+static bool
+precedes (const SedError& a, const SedError& b)
+{
+  if (a.getLine() != b.getLine()) return a.getLine() < b.getLine();
+  return a.getColumn() < b.getColumn();
+}
+
+
+/*
+ * Returns the error errorId for element, described as lacking what.
+ */
+static SedError
+makeError (const SedDocument* doc, const SedBase* element,
+           unsigned int errorId, const std::string& what)
+{
+  std::string details = "The <" + element->getElementName() + "> element";
+  if (element->isSetId())
+  {
+    details += " with id '" + element->getId() + "'";
+  }
+  details += " lacks " + what + " it requires.";
+
+  return SedError(errorId, doc->getLevel(), doc->getVersion(), details,
+                  element->getLine(), element->getColumn());
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedIncrementalValidator.
+ */
+SedIncrementalValidator::SedIncrementalValidator ()
+  : mDocument (NULL)
+  , mGeneration (0)
+  , mRound (0)
+  , mNumErrors (0)
+  , mNumChecked (0)
+{
+}
+
+
+/*
+ * Destroys this SedIncrementalValidator.
+ */
+SedIncrementalValidator::~SedIncrementalValidator ()
+{
+}
+
+
+/*
+ * Validates what changed in doc since the last call.
+ */
+int
+SedIncrementalValidator::validate (SedDocument* doc)
+{
+  if (doc == NULL || doc->isFrozen()) return LIBSEDML_INVALID_OBJECT;
+
+  // only this document can have moved the generation on since the last
+  // call; if it has not, it is another one at the same address
+  if (doc != mDocument || doc->getChangeGeneration() <= mGeneration)
+  {
+    clear();
+    mDocument = doc;
+  }
+
+  const unsigned long since = mGeneration;
+  mGeneration = doc->nextChangeGeneration();
+  ++mRound;
+  mNumChecked = 0;
+
+  std::vector<std::string>     ids;
+  std::vector<const SedBase*>  gone;
+
+  SedElementIterator end = doc->end();
+  for (SedElementIterator it = doc->begin(); it != end; ++it)
+  {
+    SedBase* element = const_cast<SedBase*>(&*it);
+
+    RecordMap::iterator found = mRecords.find(element);
+    if (found != mRecords.end() && element->getChangeStamp() <= since)
+    {
+      // nothing below an element changed after it did
+      found->second.seen = mRound;
+      it.skipChildren();
+      continue;
+    }
+
+    const std::string id = element->isSetId() ? element->getId() : "";
+    if (found == mRecords.end())
+    {
+      found = mRecords.insert(RecordMap::value_type(element, Record())).first;
+      if (!id.empty()) ids.push_back(id);
+    }
+    else if (found->second.id != id)
+    {
+      if (!found->second.id.empty()) ids.push_back(found->second.id);
+      if (!id.empty()) ids.push_back(id);
+    }
+
+    Record& record = found->second;
+    std::vector<const SedBase*> previous;
+    previous.swap(record.children);
+
+    check(element, record);
+
+    // the children it had before and has no longer
+    if (!previous.empty())
+    {
+      std::vector<const SedBase*> current(record.children);
+      std::sort(previous.begin(), previous.end());
+      std::sort(current.begin(), current.end());
+      std::set_difference(previous.begin(), previous.end(),
+                          current.begin(), current.end(),
+                          std::back_inserter(gone));
+    }
+  }
+
+  // an element may only have moved, and then has been seen where it is
+  for (size_t i = 0; i < gone.size(); ++i)
+  {
+    drop(gone[i], ids);
+  }
+
+  // the elements referring to ids that appeared or disappeared
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    const unsigned int numReferrers = doc->getNumReferrers(ids[i]);
+    for (unsigned int n = 0; n < numReferrers; ++n)
+    {
+      SedBase* referrer = doc->getReferrer(ids[i], n);
+
+      RecordMap::iterator found = mRecords.find(referrer);
+      if (found == mRecords.end() || found->second.checked == mRound)
+      {
+        continue;
+      }
+
+      check(referrer, found->second);
+    }
+  }
+
+  logErrors();
+
+  return (mNumErrors == 0) ? LIBSEDML_OPERATION_SUCCESS
+                           : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Forgets the document validated last.
+ */
+void
+SedIncrementalValidator::clear ()
+{
+  mDocument   = NULL;
+  mGeneration = 0;
+  mRecords.clear();
+  mWithErrors.clear();
+  mNumErrors  = 0;
+  mNumChecked = 0;
+}
+
+
+/*
+ * Returns the number of errors found by the last validate().
+ */
+unsigned int
+SedIncrementalValidator::getNumErrors () const
+{
+  return mNumErrors;
+}
+
+
+/*
+ * Returns the number of elements the last validate() checked.
+ */
+unsigned int
+SedIncrementalValidator::getNumChecked () const
+{
+  return mNumChecked;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Checks element itself, replacing what record held.
+ */
+void
+SedIncrementalValidator::check (SedBase* element, Record& record)
+{
+  record.id = element->isSetId() ? element->getId() : std::string();
+  record.seen    = mRound;
+  record.checked = mRound;
+
+  record.children.clear();
+  const unsigned int numChildren = element->getNumChildElements();
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    const SedBase* child = element->getChildElement(i);
+    if (child != NULL) record.children.push_back(child);
+  }
+
+  record.errors.clear();
+  if (!element->hasRequiredAttributes())
+  {
+    record.errors.push_back(makeError(mDocument, element,
+                                      MissingRequiredSedAttribute,
+                                      "an attribute"));
+  }
+  if (!element->hasRequiredElements())
+  {
+    record.errors.push_back(makeError(mDocument, element,
+                                      MissingRequiredSedElement,
+                                      "a child element"));
+  }
+  mDocument->checkReferences(element, record.errors);
+
+  if (record.errors.empty())
+    mWithErrors.erase(element);
+  else
+    mWithErrors.insert(element);
+
+  ++mNumChecked;
+}
+
+
+/*
+ * Forgets element and everything below it, unless it was seen in this
+ * run, adding their ids to ids.
+ */
+void
+SedIncrementalValidator::drop (const SedBase* element,
+                               std::vector<std::string>& ids)
+{
+  // the records are walked rather than the elements, which may have been
+  // deleted
+  std::vector<const SedBase*> stack(1, element);
+  while (!stack.empty())
+  {
+    const SedBase* current = stack.back();
+    stack.pop_back();
+
+    RecordMap::iterator found = mRecords.find(current);
+    if (found == mRecords.end() || found->second.seen == mRound) continue;
+
+    const Record& record = found->second;
+    if (!record.id.empty()) ids.push_back(record.id);
+    stack.insert(stack.end(), record.children.begin(), record.children.end());
+
+    mWithErrors.erase(current);
+    mRecords.erase(found);
+  }
+}
+
+
+/*
+ * Replaces the errors of the document's log this validator owns with
+ * those it holds.
+ */
+void
+SedIncrementalValidator::logErrors ()
+{
+  std::vector<SedError> errors;
+
+  std::set<const SedBase*>::const_iterator it;
+  for (it = mWithErrors.begin(); it != mWithErrors.end(); ++it)
+  {
+    const std::vector<SedError>& held = mRecords[*it].errors;
+    errors.insert(errors.end(), held.begin(), held.end());
+  }
+  std::stable_sort(errors.begin(), errors.end(), precedes);
+
+  SedErrorLog* log = mDocument->getErrorLog();
+  log->removeIf(isValidationError);
+  log->add(errors);
+
+  mNumErrors = (unsigned int)errors.size();
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedIncrementalValidator and returns it.
+ */
+LIBSEDML_EXTERN
+SedIncrementalValidator_t *
+SedIncrementalValidator_create ()
+{
+  return new (nothrow) SedIncrementalValidator();
+}
+
+
+/**
+ * Frees the given SedIncrementalValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedIncrementalValidator_free (SedIncrementalValidator_t *siv)
+{
+  delete siv;
+}
+
+
+/**
+ * Validates what changed in doc since the given SedIncrementalValidator
+ * last validated it.
+ */
+LIBSEDML_EXTERN
+int
+SedIncrementalValidator_validate (SedIncrementalValidator_t *siv,
+                                  SedDocument_t *doc)
+{
+  return (siv != NULL) ? siv->validate(doc) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of errors found by the last validation.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedIncrementalValidator_getNumErrors (const SedIncrementalValidator_t *siv)
+{
+  return (siv != NULL) ? siv->getNumErrors() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
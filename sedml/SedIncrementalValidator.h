@@ -0,0 +1,219 @@
+/**
+ * @file    SedIncrementalValidator.h
+ * @brief   Validates only what has changed in a document since the last run
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedIncrementalValidator
+ * @ingroup Core
+ * @brief Revalidates the parts of a SedDocument changed since it last ran.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * validate() checks every element of a SedDocument for the attributes and
+ * child elements it requires (SedBase::hasRequiredAttributes() and
+ * SedBase::hasRequiredElements()) and for reference attributes that do
+ * not resolve, as SedDocument::resolveReferences() does, and logs a
+ * @c MissingRequiredSedAttribute, @c MissingRequiredSedElement or
+ * @c DanglingSedReference error for each problem in the SedErrorLog of the
+ * document.
+ *
+ * The errors of every element are kept.  A later call on the same
+ * document only checks the elements that changed since, found from the
+ * change stamps SedBase::markDirty() leaves on an element and its
+ * ancestors (see SedBase::getChangeStamp()), so that the walk does not
+ * enter subtrees that did not change.  Elements that were added, removed
+ * or renamed have the elements that refer to their ids, found through the
+ * reverse-reference index of the document (see
+ * SedDocument::getReferrer()), checked again as well.  Revalidating after
+ * an edit thus costs time in the size of the edit, and in the number of
+ * errors held, not in the size of the document; only the first lookup
+ * in the reverse-reference index after elements were removed walks the
+ * document, to rebuild it.
+ *
+ * Before logging the errors, validate() removes every error with one of
+ * those three codes from the log, so that the validator owns them; the
+ * errors of elements that were not checked again are logged as kept.
+ */
+
+#ifndef SedIncrementalValidator_h
+#define SedIncrementalValidator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sedml/SedError.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedIncrementalValidator
+{
+public:
+
+  /**
+   * Creates a new SedIncrementalValidator that has not validated any
+   * document yet.
+   */
+  SedIncrementalValidator ();
+
+
+  /**
+   * Destroys this SedIncrementalValidator.
+   */
+  virtual ~SedIncrementalValidator ();
+
+
+  /**
+   * Validates @p doc, checking every element the first time and, on the
+   * same document again, only the elements changed since and those
+   * referring to the ids of elements added, removed or renamed.  The
+   * errors found, and those kept for the unchanged elements, replace
+   * those this validator logged before in the SedErrorLog of @p doc.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if no errors were found
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any were
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p doc is @c NULL or frozen, in which case nothing is validated
+   */
+  int validate (SedDocument* doc);
+
+
+  /**
+   * Forgets the document validated last and the errors kept for it, so
+   * that the next validate() checks every element.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of errors found by the last validate(), those kept
+   * for unchanged elements included.
+   */
+  unsigned int getNumErrors () const;
+
+
+  /**
+   * @return the number of elements the last validate() checked.
+   */
+  unsigned int getNumChecked () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Record
+  {
+    Record () : seen (0), checked (0) { }
+
+    std::string                   id;
+    std::vector<SedError>         errors;
+    std::vector<const SedBase*>   children;
+    unsigned long                 seen;
+    unsigned long                 checked;
+  };
+
+  typedef std::map<const SedBase*, Record> RecordMap;
+
+  void check (SedBase* element, Record& record);
+
+  void drop (const SedBase* element, std::vector<std::string>& ids);
+
+  void logErrors ();
+
+
+  SedDocument*              mDocument;
+  unsigned long             mGeneration;
+  unsigned long             mRound;
+  RecordMap                 mRecords;
+  std::set<const SedBase*>  mWithErrors;
+  unsigned int              mNumErrors;
+  unsigned int              mNumChecked;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedIncrementalValidator and returns it.
+ */
+LIBSEDML_EXTERN
+SedIncrementalValidator_t *
+SedIncrementalValidator_create ();
+
+
+/**
+ * Frees the given SedIncrementalValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedIncrementalValidator_free (SedIncrementalValidator_t *siv);
+
+
+/**
+ * Validates what changed in @p doc since the given SedIncrementalValidator
+ * last validated it.
+ */
+LIBSEDML_EXTERN
+int
+SedIncrementalValidator_validate (SedIncrementalValidator_t *siv,
+                                  SedDocument_t *doc);
+
+
+/**
+ * Returns the number of errors found by the last validation.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedIncrementalValidator_getNumErrors (const SedIncrementalValidator_t *siv);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedIncrementalValidator_h */
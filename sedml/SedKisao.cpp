@@ -0,0 +1,413 @@
+/**
+ * @file    SedKisao.cpp
+ * @brief   Built-in registry of the KiSAO algorithms simulators dispatch on
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedKisao.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstring>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * An algorithm of the registry.
+ */
+struct SedKisaoEntry
+{
+  unsigned long  number;
+  const char*    id;
+  const char*    name;
+  unsigned int   capabilities;
+  int            fallback;
+};
+
+
+#define SED_KISAO_ODE_SOLVER     (SED_KISAO_DETERMINISTIC | SED_KISAO_ODE)
+#define SED_KISAO_STIFF_SOLVER   (SED_KISAO_ODE_SOLVER | SED_KISAO_STIFF \
+                                  | SED_KISAO_ADAPTIVE_STEP)
+
+/*
+ * The registry, in the order of SedKisaoAlgorithm_t and so of the KiSAO
+ * numbers, which getIndex() searches.  The fallbacks only lead to
+ * algorithms that do not lead back.
+ */
+static const SedKisaoEntry sKisaoEntries[SED_KISAO_NUM_ALGORITHMS] =
+{
+  {  19, "KISAO:0000019", "CVODE",
+     SED_KISAO_STIFF_SOLVER,
+     SED_KISAO_UNKNOWN },
+  {  27, "KISAO:0000027", "Gibson-Bruck next reaction method",
+     SED_KISAO_STOCHASTIC | SED_KISAO_EXACT,
+     SED_KISAO_GILLESPIE_DIRECT },
+  {  29, "KISAO:0000029", "Gillespie direct method",
+     SED_KISAO_STOCHASTIC | SED_KISAO_EXACT,
+     SED_KISAO_UNKNOWN },
+  {  30, "KISAO:0000030", "Euler forward method",
+     SED_KISAO_ODE_SOLVER,
+     SED_KISAO_RUNGE_KUTTA_4 },
+  {  32, "KISAO:0000032", "explicit fourth-order Runge-Kutta method",
+     SED_KISAO_ODE_SOLVER,
+     SED_KISAO_FEHLBERG },
+  {  39, "KISAO:0000039", "tau-leaping method",
+     SED_KISAO_STOCHASTIC,
+     SED_KISAO_GILLESPIE_DIRECT },
+  {  64, "KISAO:0000064", "Runge-Kutta based method",
+     SED_KISAO_ODE_SOLVER,
+     SED_KISAO_RUNGE_KUTTA_4 },
+  {  86, "KISAO:0000086", "Fehlberg method",
+     SED_KISAO_ODE_SOLVER | SED_KISAO_ADAPTIVE_STEP,
+     SED_KISAO_DORMAND_PRINCE },
+  {  87, "KISAO:0000087", "Dormand-Prince method",
+     SED_KISAO_ODE_SOLVER | SED_KISAO_ADAPTIVE_STEP,
+     SED_KISAO_CVODE },
+  {  88, "KISAO:0000088", "LSODA",
+     SED_KISAO_STIFF_SOLVER,
+     SED_KISAO_CVODE },
+  {  94, "KISAO:0000094", "Livermore solver",
+     SED_KISAO_STIFF_SOLVER,
+     SED_KISAO_LSODA },
+  { 241, "KISAO:0000241", "Gillespie-like method",
+     SED_KISAO_STOCHASTIC,
+     SED_KISAO_GILLESPIE_DIRECT },
+  { 282, "KISAO:0000282", "KINSOL",
+     SED_KISAO_DETERMINISTIC | SED_KISAO_STEADY_STATE,
+     SED_KISAO_UNKNOWN },
+  { 283, "KISAO:0000283", "IDA",
+     SED_KISAO_DETERMINISTIC | SED_KISAO_DAE | SED_KISAO_STIFF
+     | SED_KISAO_ADAPTIVE_STEP,
+     SED_KISAO_UNKNOWN },
+  { 437, "KISAO:0000437", "flux balance analysis",
+     SED_KISAO_DETERMINISTIC | SED_KISAO_FLUX_BALANCE_MODEL,
+     SED_KISAO_UNKNOWN },
+  { 568, "KISAO:0000568", "NLEQ1",
+     SED_KISAO_DETERMINISTIC | SED_KISAO_STEADY_STATE,
+     SED_KISAO_NLEQ2 },
+  { 569, "KISAO:0000569", "NLEQ2",
+     SED_KISAO_DETERMINISTIC | SED_KISAO_STEADY_STATE,
+     SED_KISAO_KINSOL }
+};
+
+#undef SED_KISAO_STIFF_SOLVER
+#undef SED_KISAO_ODE_SOLVER
+
+
+static bool
+isIndex (int index)
+{
+  return index >= 0 && index < SED_KISAO_NUM_ALGORITHMS;
+}
+
+
+/*
+ * Reads the number of the KiSAO id kisaoID: the digits after the last
+ * "KISAO" and the ':' or '_' following it.
+ */
+static bool
+parseNumber (const char* kisaoID, unsigned long& number)
+{
+  const char* start = NULL;
+  for (const char* p = strstr(kisaoID, "KISAO"); p != NULL;
+       p = strstr(p + 1, "KISAO"))
+  {
+    start = p + 5;
+  }
+  if (start == NULL || (*start != ':' && *start != '_')) return false;
+
+  const char* p = ++start;
+  number = 0;
+  while (*p >= '0' && *p <= '9' && p - start < 9)
+  {
+    number = number * 10 + (unsigned long)(*p - '0');
+    ++p;
+  }
+  return p != start && *p == '\0';
+}
+
+/** @endcond */
+
+
+/*
+ * Returns the index of the algorithm with the KiSAO id kisaoID.
+ */
+int
+SedKisao::getIndex (const std::string& kisaoID)
+{
+  return getIndex(kisaoID.c_str());
+}
+
+
+/*
+ * Returns the index of the algorithm with the KiSAO id kisaoID.
+ */
+int
+SedKisao::getIndex (const char* kisaoID)
+{
+  unsigned long number = 0;
+  if (kisaoID == NULL || !parseNumber(kisaoID, number))
+  {
+    return SED_KISAO_UNKNOWN;
+  }
+
+  int lo = 0;
+  int hi = SED_KISAO_NUM_ALGORITHMS;
+  while (lo < hi)
+  {
+    const int mid = (lo + hi) / 2;
+    if (sKisaoEntries[mid].number < number)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return (lo < SED_KISAO_NUM_ALGORITHMS && sKisaoEntries[lo].number == number)
+       ? lo : SED_KISAO_UNKNOWN;
+}
+
+
+/*
+ * Returns the KiSAO id of the algorithm with the index index.
+ */
+const char*
+SedKisao::getID (int index)
+{
+  return isIndex(index) ? sKisaoEntries[index].id : NULL;
+}
+
+
+/*
+ * Returns the name of the algorithm with the index index.
+ */
+const char*
+SedKisao::getName (int index)
+{
+  return isIndex(index) ? sKisaoEntries[index].name : NULL;
+}
+
+
+/*
+ * Returns the capabilities of the algorithm with the index index.
+ */
+unsigned int
+SedKisao::getCapabilities (int index)
+{
+  return isIndex(index) ? sKisaoEntries[index].capabilities : 0;
+}
+
+
+/*
+ * Returns true if the algorithm with the index index has all of flags.
+ */
+bool
+SedKisao::hasCapabilities (int index, unsigned int flags)
+{
+  return isIndex(index) && (sKisaoEntries[index].capabilities & flags) == flags;
+}
+
+
+/*
+ * Returns the index of the algorithm that may stand in for the one with
+ * the index index.
+ */
+int
+SedKisao::getFallback (int index)
+{
+  return isIndex(index) ? sKisaoEntries[index].fallback : SED_KISAO_UNKNOWN;
+}
+
+
+/*
+ * Creates a new SedAlgorithmSupport implementing no algorithm.
+ */
+SedAlgorithmSupport::SedAlgorithmSupport ()
+{
+  for (int i = 0; i < SED_KISAO_NUM_ALGORITHMS; ++i)
+  {
+    mSupported[i] = false;
+  }
+  update();
+}
+
+
+/*
+ * Adds the algorithm with the index index to those implemented.
+ */
+int
+SedAlgorithmSupport::addAlgorithm (int index)
+{
+  if (!isIndex(index)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mSupported[index] = true;
+  update();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Adds the algorithm with the KiSAO id kisaoID to those implemented.
+ */
+int
+SedAlgorithmSupport::addAlgorithm (const std::string& kisaoID)
+{
+  return addAlgorithm(SedKisao::getIndex(kisaoID));
+}
+
+
+/*
+ * Removes the algorithm with the index index from those implemented.
+ */
+int
+SedAlgorithmSupport::removeAlgorithm (int index)
+{
+  if (!isIndex(index)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mSupported[index] = false;
+  update();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if the algorithm with the index index is implemented.
+ */
+bool
+SedAlgorithmSupport::isSupported (int index) const
+{
+  return isIndex(index) && mSupported[index];
+}
+
+
+/*
+ * Returns the implemented algorithm that runs in place of the one with
+ * the index index.
+ */
+int
+SedAlgorithmSupport::getSubstitute (int index) const
+{
+  return isIndex(index) ? mSubstitutes[index] : SED_KISAO_UNKNOWN;
+}
+
+
+/*
+ * Returns the implemented algorithm that runs in place of algorithm.
+ */
+int
+SedAlgorithmSupport::getSubstitute (const SedAlgorithm* algorithm) const
+{
+  return (algorithm != NULL) ? getSubstitute(algorithm->getKisaoIndex())
+                             : SED_KISAO_UNKNOWN;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Works out the substitute of every algorithm.
+ */
+void
+SedAlgorithmSupport::update ()
+{
+  for (int i = 0; i < SED_KISAO_NUM_ALGORITHMS; ++i)
+  {
+    // the chain is no longer than the registry, which also guards against
+    // a cycle slipping into the table
+    int k = i;
+    for (int steps = 0; k != SED_KISAO_UNKNOWN && !mSupported[k]; ++steps)
+    {
+      k = (steps < SED_KISAO_NUM_ALGORITHMS) ? sKisaoEntries[k].fallback
+                                             : SED_KISAO_UNKNOWN;
+    }
+    mSubstitutes[i] = k;
+  }
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Returns the index of the algorithm with the KiSAO id kisaoID.
+ */
+LIBSEDML_EXTERN
+int
+SedKisao_getIndex (const char *kisaoID)
+{
+  return SedKisao::getIndex(kisaoID);
+}
+
+
+/**
+ * Returns the KiSAO id of the algorithm with the index index.
+ */
+LIBSEDML_EXTERN
+const char *
+SedKisao_getID (int index)
+{
+  return SedKisao::getID(index);
+}
+
+
+/**
+ * Returns the name of the algorithm with the index index.
+ */
+LIBSEDML_EXTERN
+const char *
+SedKisao_getName (int index)
+{
+  return SedKisao::getName(index);
+}
+
+
+/**
+ * Returns the capabilities of the algorithm with the index index.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedKisao_getCapabilities (int index)
+{
+  return SedKisao::getCapabilities(index);
+}
+
+
+/**
+ * Returns the index of the algorithm that may stand in for the one with
+ * the index index.
+ */
+LIBSEDML_EXTERN
+int
+SedKisao_getFallback (int index)
+{
+  return SedKisao::getFallback(index);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
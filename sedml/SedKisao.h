@@ -0,0 +1,303 @@
+/**
+ * @file    SedKisao.h
+ * @brief   Built-in registry of the KiSAO algorithms simulators dispatch on
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedKisao
+ * @ingroup Core
+ * @brief Maps KiSAO ids to small integers with what the algorithms can do.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedAlgorithm names its algorithm by a KiSAO id such as
+ * <code>KISAO:0000019</code>.  The algorithms simulators commonly
+ * implement are numbered 0 to #SED_KISAO_NUM_ALGORITHMS - 1 by the
+ * #SedKisaoAlgorithm_t enumeration, each with the capabilities of
+ * #SedKisaoCapability_t it has, and with a fallback: the algorithm that
+ * may stand in for it, which does the same with fewer assumptions or a
+ * more general method.  Following the fallbacks always ends, at an
+ * algorithm without one.
+ *
+ * The table is constant and compiled in, sorted by KiSAO number; a
+ * SedAlgorithm looks its id up once, when it is set, so that
+ * SedAlgorithm::getKisaoIndex() and the questions asked with it are array
+ * lookups.  The forms <code>KISAO:0000019</code>,
+ * <code>KISAO_0000019</code> and the URNs and URLs ending in either are
+ * understood.  Ids not in the table have the index #SED_KISAO_UNKNOWN.
+ *
+ * @class SedAlgorithmSupport
+ * @ingroup Core
+ * @brief The KiSAO algorithms a simulator implements, and what it runs for
+ * the others.
+ *
+ * A simulator adds the algorithms it implements, and may then ask
+ * getSubstitute() which one runs a SedAlgorithm: the algorithm itself if
+ * it is implemented, or the first implemented one along its fallbacks.
+ * The substitutes of all algorithms are worked out as algorithms are
+ * added, so that asking is an array lookup.  A SedSimulator returning one
+ * from SedSimulator::getAlgorithmSupport() lets the SedExecutor fail the
+ * tasks whose known algorithm has no substitute without running them.
+ */
+
+#ifndef SedKisao_h
+#define SedKisao_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * The KiSAO algorithms of the built-in registry, in the order of their
+ * KiSAO numbers.
+ */
+typedef enum
+{
+    SED_KISAO_UNKNOWN            = -1 /*!< Not in the registry */
+  , SED_KISAO_CVODE              =  0 /*!< KISAO:0000019 CVODE */
+  , SED_KISAO_GIBSON_BRUCK            /*!< KISAO:0000027 Gibson-Bruck next reaction method */
+  , SED_KISAO_GILLESPIE_DIRECT        /*!< KISAO:0000029 Gillespie direct method */
+  , SED_KISAO_EULER_FORWARD           /*!< KISAO:0000030 Euler forward method */
+  , SED_KISAO_RUNGE_KUTTA_4           /*!< KISAO:0000032 explicit fourth-order Runge-Kutta method */
+  , SED_KISAO_TAU_LEAPING             /*!< KISAO:0000039 tau-leaping method */
+  , SED_KISAO_RUNGE_KUTTA             /*!< KISAO:0000064 Runge-Kutta based method */
+  , SED_KISAO_FEHLBERG                /*!< KISAO:0000086 Fehlberg method */
+  , SED_KISAO_DORMAND_PRINCE          /*!< KISAO:0000087 Dormand-Prince method */
+  , SED_KISAO_LSODA                   /*!< KISAO:0000088 LSODA */
+  , SED_KISAO_LSODE                   /*!< KISAO:0000094 Livermore solver */
+  , SED_KISAO_GILLESPIE_LIKE          /*!< KISAO:0000241 Gillespie-like method */
+  , SED_KISAO_KINSOL                  /*!< KISAO:0000282 KINSOL */
+  , SED_KISAO_IDA                     /*!< KISAO:0000283 IDA */
+  , SED_KISAO_FLUX_BALANCE            /*!< KISAO:0000437 flux balance analysis */
+  , SED_KISAO_NLEQ1                   /*!< KISAO:0000568 NLEQ1 */
+  , SED_KISAO_NLEQ2                   /*!< KISAO:0000569 NLEQ2 */
+  , SED_KISAO_NUM_ALGORITHMS          /*!< The number of algorithms */
+} SedKisaoAlgorithm_t;
+
+
+/**
+ * What the algorithms of the registry can do, or-ed together.
+ */
+typedef enum
+{
+    SED_KISAO_DETERMINISTIC      = 0x0001 /*!< Gives the same results every time */
+  , SED_KISAO_STOCHASTIC         = 0x0002 /*!< Samples a stochastic process */
+  , SED_KISAO_EXACT              = 0x0004 /*!< Samples it without approximation */
+  , SED_KISAO_ODE                = 0x0008 /*!< Integrates ordinary differential equations */
+  , SED_KISAO_DAE                = 0x0010 /*!< Integrates differential-algebraic equations */
+  , SED_KISAO_STIFF              = 0x0020 /*!< Handles stiff systems */
+  , SED_KISAO_ADAPTIVE_STEP      = 0x0040 /*!< Chooses its step size */
+  , SED_KISAO_STEADY_STATE       = 0x0080 /*!< Finds steady states */
+  , SED_KISAO_FLUX_BALANCE_MODEL = 0x0100 /*!< Optimises constraint-based models */
+} SedKisaoCapability_t;
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedAlgorithm;
+
+
+class LIBSEDML_EXTERN SedKisao
+{
+public:
+
+  /**
+   * @return the index of the algorithm with the KiSAO id @p kisaoID, or
+   * #SED_KISAO_UNKNOWN if it is not in the registry.
+   */
+  static int getIndex (const std::string& kisaoID);
+
+  static int getIndex (const char* kisaoID);
+
+
+  /**
+   * @return the KiSAO id, in the form <code>KISAO:0000019</code>, of the
+   * algorithm with the index @p index, or @c NULL if there is none.
+   */
+  static const char* getID (int index);
+
+
+  /**
+   * @return the name of the algorithm with the index @p index, or @c NULL
+   * if there is none.
+   */
+  static const char* getName (int index);
+
+
+  /**
+   * @return the #SedKisaoCapability_t flags of the algorithm with the
+   * index @p index, or 0 if there is none.
+   */
+  static unsigned int getCapabilities (int index);
+
+
+  /**
+   * @return @c true if the algorithm with the index @p index has all of
+   * the capabilities @p flags.
+   */
+  static bool hasCapabilities (int index, unsigned int flags);
+
+
+  /**
+   * @return the index of the algorithm that may stand in for the one with
+   * the index @p index, or #SED_KISAO_UNKNOWN if there is none.
+   */
+  static int getFallback (int index);
+};
+
+
+class LIBSEDML_EXTERN SedAlgorithmSupport
+{
+public:
+
+  /**
+   * Creates a new SedAlgorithmSupport implementing no algorithm.
+   */
+  SedAlgorithmSupport ();
+
+
+  /**
+   * Adds the algorithm with the index @p index, or with the KiSAO id
+   * @p kisaoID, to those implemented.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the algorithm is not in the registry
+   */
+  int addAlgorithm (int index);
+
+  int addAlgorithm (const std::string& kisaoID);
+
+
+  /**
+   * Removes the algorithm with the index @p index from those implemented.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the algorithm is not in the registry
+   */
+  int removeAlgorithm (int index);
+
+
+  /**
+   * @return @c true if the algorithm with the index @p index is
+   * implemented.
+   */
+  bool isSupported (int index) const;
+
+
+  /**
+   * @return the index of the implemented algorithm that runs in place of
+   * the one with the index @p index, or of the algorithm of @p algorithm:
+   * the algorithm itself or the first implemented one along its
+   * fallbacks, or #SED_KISAO_UNKNOWN if there is none.
+   */
+  int getSubstitute (int index) const;
+
+  int getSubstitute (const SedAlgorithm* algorithm) const;
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  void update ();
+
+  bool  mSupported[SED_KISAO_NUM_ALGORITHMS];
+  int   mSubstitutes[SED_KISAO_NUM_ALGORITHMS];
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Returns the index of the algorithm with the KiSAO id @p kisaoID, or
+ * #SED_KISAO_UNKNOWN.
+ */
+LIBSEDML_EXTERN
+int
+SedKisao_getIndex (const char *kisaoID);
+
+
+/**
+ * Returns the KiSAO id of the algorithm with the index @p index, or
+ * @c NULL.
+ */
+LIBSEDML_EXTERN
+const char *
+SedKisao_getID (int index);
+
+
+/**
+ * Returns the name of the algorithm with the index @p index, or @c NULL.
+ */
+LIBSEDML_EXTERN
+const char *
+SedKisao_getName (int index);
+
+
+/**
+ * Returns the capabilities of the algorithm with the index @p index.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedKisao_getCapabilities (int index);
+
+
+/**
+ * Returns the index of the algorithm that may stand in for the one with
+ * the index @p index, or #SED_KISAO_UNKNOWN.
+ */
+LIBSEDML_EXTERN
+int
+SedKisao_getFallback (int index);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedKisao_h */
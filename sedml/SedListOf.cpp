@@ -30,6 +30,9 @@
 
 #include <sedml/SedVisitor.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedArena.h>
+#include <sedml/SedMemoryUsage.h>
 #include <sedml/common/common.h>
 
 /** @cond doxygen-ignored */
@@ -45,6 +48,8 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  */
 SedListOf::SedListOf (unsigned int level, unsigned int version)
 : SedBase(level,version)
+, mIdIndexValid (false)
+, mIdIndexHasDuplicates (false)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
@@ -56,7 +61,13 @@ SedListOf::SedListOf (unsigned int level, unsigned int version)
  */
 SedListOf::SedListOf (SedNamespaces* sbmlns)
 : SedBase(sbmlns)
+, mIdIndexValid (false)
+, mIdIndexHasDuplicates (false)
 {
+  // a shared set was checked when a document interned it; the member
+  // lists of elements the reader creates are given such sets
+  if (sbmlns->isShared()) return;
+
     if (!hasValidLevelVersionNamespaceCombination())
     throw SedConstructorException();
 }
@@ -71,6 +82,15 @@ struct Delete : public unary_function<SedBase*, void>
 };
 
 
+/**
+ * Used by clear() to let go of each item in mItems without deleting it.
+ */
+struct Disconnect : public unary_function<SedBase*, void>
+{
+  void operator() (SedBase* sb) { sb->disconnectFromParent(); }
+};
+
+
 /*
  * Destroys the given SedListOf and its constituent items.
  */
@@ -93,6 +113,8 @@ struct Clone : public unary_function<SedBase*, SedBase*>
  * Copy constructor. Creates a copy of this SedListOf items.
  */
 SedListOf::SedListOf (const SedListOf& orig) : SedBase(orig)
+  , mIdIndexValid (false)
+  , mIdIndexHasDuplicates (false)
 {
   mItems.resize( orig.size() );
   transform( orig.mItems.begin(), orig.mItems.end(), mItems.begin(), Clone() );
@@ -112,26 +134,88 @@ SedListOf& SedListOf::operator=(const SedListOf& rhs)
     for_each( mItems.begin(), mItems.end(), Delete() );
     mItems.resize( rhs.size() );
     transform( rhs.mItems.begin(), rhs.mItems.end(), mItems.begin(), Clone() );
+    invalidateIdIndex();
     connectToChild();
   }
 
   return *this;
 }
 
+/** @cond doxygen-libsbml-internal */
 /*
- * Accepts the given SedVisitor.
+ * Shows this SedListOf, but not its items, to the given SedVisitor.
  */
 bool
-SedListOf::accept (SedVisitor& v) const
+SedListOf::dispatch (SedVisitor& v) const
 {
   v.visit(*this, getItemTypeCode() );
-  for (unsigned int n = 0 ; n < mItems.size() && mItems[n]->accept(v); ++n) ;
-  v.leave(*this, getItemTypeCode() );
 
   return true;
 }
 
 
+/*
+ * Adds the vector of items and the id index of this SedListOf to the
+ * given SedMemoryVisitor.
+ */
+void
+SedListOf::addMemoryUsage (SedMemoryVisitor& v) const
+{
+  SedBase::addMemoryUsage(v);
+
+  const int type = getTypeCode();
+
+  v.add(type, SED_MEMORY_OBJECTS, mItems.capacity() * sizeof(SedBase*));
+
+  IdIndex::const_iterator it;
+  for (it = mIdIndex.begin(); it != mIdIndex.end(); ++it)
+  {
+    v.add(type, SED_MEMORY_CACHES,
+          SedMemoryVisitor::getTreeNodeSize(sizeof(IdIndex::value_type)));
+    v.addString(type, it->first, SED_MEMORY_CACHES);
+  }
+}
+
+
+/*
+ * Builds the id index, which lookups then only read, and gives back the
+ * room kept in the vector of items.
+ */
+void
+SedListOf::prepareToFreeze ()
+{
+  SedBase::prepareToFreeze();
+
+  if (!mIdIndexValid) rebuildIdIndex();
+
+  if (mItems.capacity() > mItems.size())
+  {
+    ListItem(mItems).swap(mItems);
+  }
+}
+/** @endcond */
+
+
+/*
+ * Returns the number of items in this SedListOf.
+ */
+unsigned int
+SedListOf::getNumChildElements () const
+{
+  return (unsigned int)mItems.size();
+}
+
+
+/*
+ * Returns the nth item of this SedListOf.
+ */
+const SedBase*
+SedListOf::getChildElement (unsigned int n) const
+{
+  return (n < mItems.size()) ? mItems[n] : NULL;
+}
+
+
 /*
  * @return a (deep) copy of this SedListOf items.
  */
@@ -148,6 +232,7 @@ SedListOf::clone () const
 int 
 SedListOf::insert(int location, const SedBase* item)
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
   return insertAndOwn(location, item->clone());
 }
 
@@ -165,10 +250,13 @@ SedListOf::isValidTypeForList(SedBase * item) const
 int 
 SedListOf::insertAndOwn(int location, SedBase* item)
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN )
   {
     mItems.insert( mItems.begin() + location, item );
+    addToIdIndex(item, false);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -179,6 +267,7 @@ SedListOf::insertAndOwn(int location, SedBase* item)
   else
   {
     mItems.insert( mItems.begin() + location, item );
+    addToIdIndex(item, false);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -191,6 +280,7 @@ SedListOf::insertAndOwn(int location, SedBase* item)
 int
 SedListOf::append (const SedBase* item)
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
   return appendAndOwn( item->clone() );
 }
 
@@ -202,10 +292,17 @@ SedListOf::append (const SedBase* item)
 int
 SedListOf::appendAndOwn (SedBase* item)
 {
+  if (item == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+
+  // an item still owned by another parent would be deleted twice
+  if (item->getParentSedObject() != NULL) return LIBSEDML_INVALID_OBJECT;
+
   /* no list elements yet */
   if (this->getItemTypeCode() == SEDML_UNKNOWN )
   {
     mItems.push_back( item );
+    addToIdIndex(item, true);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -216,6 +313,7 @@ SedListOf::appendAndOwn (SedBase* item)
   else
   {
     mItems.push_back( item );
+    addToIdIndex(item, true);
     item->connectToParent(this);
     return LIBSEDML_OPERATION_SUCCESS;
   }
@@ -224,6 +322,7 @@ SedListOf::appendAndOwn (SedBase* item)
 int SedListOf::appendFrom(const SedListOf* list)
 {
   if (list==NULL) return LIBSEDML_INVALID_OBJECT;
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
   if (getItemTypeCode() != list->getItemTypeCode()) {
     return LIBSEDML_INVALID_OBJECT;
   }
@@ -355,13 +454,28 @@ SedListOf::getAllElements()
 void
 SedListOf::clear (bool doDelete)
 {
+  if (isFrozen()) return;
+
   if (doDelete)
     for_each( mItems.begin(), mItems.end(), Delete() );
+  else
+    for_each( mItems.begin(), mItems.end(), Disconnect() );
   mItems.clear();
+
+  mIdIndex.clear();
+  mIdIndexValid         = true;
+  mIdIndexHasDuplicates = false;
+
+  markDirty();
+
+  SedDocument* doc = getRootDocument();
+  if (doc != NULL) doc->invalidateElementIndex();
 }
 
 int SedListOf::removeFromParentAndDelete()
 {
+  if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+
   clear(true);
   unsetAnnotation();
   unsetId(); //Just in case
@@ -379,12 +493,226 @@ int SedListOf::removeFromParentAndDelete()
 SedBase*
 SedListOf::remove (unsigned int n)
 {
+  if (isFrozen()) return NULL;
+
   SedBase* item = get(n);
-  if (item != NULL) mItems.erase( mItems.begin() + n );
+  if (item != NULL)
+  {
+    removeFromIdIndex(item);
+    mItems.erase( mItems.begin() + n );
+    item->disconnectFromParent();
+    markDirty();
+
+    SedDocument* doc = getRootDocument();
+    if (doc != NULL) doc->invalidateElementIndex();
+  }
   return item;
 }
 
 
+/*
+ * Removes every item predicate returns non-zero for.
+ */
+unsigned int
+SedListOf::removeIf (SedListOfPredicate_t predicate, void* data,
+                     bool doDelete)
+{
+  if (predicate == NULL || isFrozen()) return 0;
+
+  // the items kept are moved down over the removed ones, so that the
+  // list is compacted once
+  ListItemIter kept = mItems.begin();
+  for (ListItemIter it = mItems.begin(); it != mItems.end(); ++it)
+  {
+    if (predicate(*it, data) != 0)
+    {
+      if (doDelete)
+        delete *it;
+      else
+        (*it)->disconnectFromParent();
+    }
+    else
+    {
+      *kept++ = *it;
+    }
+  }
+
+  const unsigned int removed = (unsigned int)(mItems.end() - kept);
+  if (removed == 0) return 0;
+
+  mItems.erase(kept, mItems.end());
+  invalidateIdIndex();
+  markDirty();
+
+  SedDocument* doc = getRootDocument();
+  if (doc != NULL) doc->invalidateElementIndex();
+
+  return removed;
+}
+
+
+/*
+ * Makes room for n items.
+ */
+void
+SedListOf::reserve (unsigned int n)
+{
+  if (n <= mItems.size() || isFrozen()) return;
+
+  const size_t itemSize = getItemSize();
+  SedArena*    arena    = getArena();
+  if (itemSize != 0 && arena != NULL)
+  {
+    arena->reserve(n - mItems.size(), getAllocationSize(itemSize));
+  }
+
+  mItems.reserve(n);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns the size of the items of this list if they are of one type.
+ */
+size_t
+SedListOf::getItemSize () const
+{
+  return 0;
+}
+
+
+/*
+ * Returns the first item with the given id, using the id index.
+ */
+SedBase*
+SedListOf::getItemById (const std::string& sid) const
+{
+  if (sid.empty())
+  {
+    // items without an id are not indexed
+    for (unsigned int i = 0; i < mItems.size(); i++)
+    {
+      if (mItems[i]->getId().empty()) return mItems[i];
+    }
+    return NULL;
+  }
+
+  if (!mIdIndexValid) rebuildIdIndex();
+
+  IdIndex::const_iterator it = mIdIndex.find(sid);
+  return (it == mIdIndex.end()) ? NULL : it->second;
+}
+
+
+/*
+ * Removes the first item with the given id and returns it.
+ */
+SedBase*
+SedListOf::removeItemById (const std::string& sid)
+{
+  if (isFrozen()) return NULL;
+
+  SedBase* item = getItemById(sid);
+  if (item == NULL) return NULL;
+
+  ListItemIter result = find( mItems.begin(), mItems.end(), item );
+  if (result == mItems.end()) return NULL;
+
+  removeFromIdIndex(item);
+  mItems.erase(result);
+  item->disconnectFromParent();
+  markDirty();
+
+  SedDocument* doc = getRootDocument();
+  if (doc != NULL) doc->invalidateElementIndex();
+
+  return item;
+}
+
+
+/*
+ * Marks the id index as stale; it is rebuilt on the next lookup.
+ */
+void
+SedListOf::invalidateIdIndex ()
+{
+  mIdIndexValid = false;
+}
+
+
+/*
+ * Rebuilds the id index from mItems.  Only the first item with a given
+ * id is recorded, matching the order a linear search would find.
+ */
+void
+SedListOf::rebuildIdIndex () const
+{
+  mIdIndex.clear();
+  mIdIndexHasDuplicates = false;
+
+  for (unsigned int i = 0; i < mItems.size(); i++)
+  {
+    const string& id = mItems[i]->getId();
+    if (id.empty()) continue;
+
+    if (!mIdIndex.insert(IdIndex::value_type(id, mItems[i])).second)
+      mIdIndexHasDuplicates = true;
+  }
+
+  mIdIndexValid = true;
+}
+
+
+/*
+ * Records a newly added item in the id index.  If an earlier item already
+ * has the same id the index keeps that one, unless the new item was
+ * inserted somewhere other than the end, in which case the index is
+ * rebuilt lazily.
+ */
+void
+SedListOf::addToIdIndex (SedBase* item, bool atEnd)
+{
+  if (!mIdIndexValid) return;
+
+  const string& id = item->getId();
+  if (id.empty()) return;
+
+  if (!mIdIndex.insert(IdIndex::value_type(id, item)).second)
+  {
+    mIdIndexHasDuplicates = true;
+    if (!atEnd) mIdIndexValid = false;
+  }
+}
+
+
+/*
+ * Drops an item that is about to be removed from the id index.
+ */
+void
+SedListOf::removeFromIdIndex (SedBase* item)
+{
+  if (!mIdIndexValid) return;
+
+  const string& id = item->getId();
+  if (id.empty()) return;
+
+  IdIndex::iterator it = mIdIndex.find(id);
+
+  if (mIdIndexHasDuplicates || it == mIdIndex.end() || it->second != item)
+  {
+    // another item may now be the first with this id
+    mIdIndexValid = false;
+  }
+  else
+  {
+    mIdIndex.erase(it);
+  }
+}
+
+/** @endcond */
+
+
 /*
  * Removes item in this SedListOf items with the given @p id or @c NULL if no such
  * item exists.  The caller owns the returned item and is repsonsible for
@@ -490,6 +818,9 @@ SedListOf::getItemTypeCode () const
 }
 
 
+static const std::string sSedListOfName("listOf");
+
+
 /*
  * @return the name of this element ie "listOf".
  
@@ -497,8 +828,7 @@ SedListOf::getItemTypeCode () const
 const string&
 SedListOf::getElementName () const
 {
-  static const string name = "listOf";
-  return name;
+  return sSedListOfName;
 }
 
 
@@ -698,6 +1028,43 @@ SedListOf_get (SedListOf_t *lo, unsigned int n)
 }
 
 
+/**
+ * Copies the first n items in this SedListOf items to out.
+ */
+LIBSEDML_EXTERN
+size_t
+SedListOf_getItems (SedListOf_t *lo, SedBase_t **out, size_t n)
+{
+  if (lo == NULL || out == NULL) return 0;
+
+  const size_t count = (n < lo->size()) ? n : lo->size();
+  for (size_t i = 0; i < count; i++)
+  {
+    out[i] = lo->get((unsigned int)i);
+  }
+  return count;
+}
+
+
+/**
+ * Copies the ids of the first n items in this SedListOf items to out.
+ */
+LIBSEDML_EXTERN
+size_t
+SedListOf_getIds (const SedListOf_t *lo, const char **out, size_t n)
+{
+  if (lo == NULL || out == NULL) return 0;
+
+  const size_t count = (n < lo->size()) ? n : lo->size();
+  for (size_t i = 0; i < count; i++)
+  {
+    const std::string& id = lo->get((unsigned int)i)->getId();
+    out[i] = id.empty() ? NULL : id.c_str();
+  }
+  return count;
+}
+
+
 /*
  * @return item in this SedListOf items with the given @p id or @c NULL if no such
  * item exists.
@@ -741,6 +1108,29 @@ SedListOf_remove (SedListOf_t *lo, unsigned int n)
 }
 
 
+/**
+ * Removes every item predicate returns non-zero for.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedListOf_removeIf (SedListOf_t *lo, SedListOfPredicate_t predicate,
+                    void *data, int doDelete)
+{
+  return (lo != NULL) ? lo->removeIf(predicate, data, doDelete != 0) : 0;
+}
+
+
+/**
+ * Makes room for n items.
+ */
+LIBSEDML_EXTERN
+void
+SedListOf_reserve (SedListOf_t *lo, unsigned int n)
+{
+  if (lo != NULL) lo->reserve(n);
+}
+
+
 /*
  * Removes item in this SedListOf items with the given @p id or @c NULL if no such
  * item exists.  The caller owns the returned item and is repsonsible for
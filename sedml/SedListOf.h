@@ -68,10 +68,23 @@
 #include <sedml/SedTypeCodes.h>
 
 
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * A test SedListOf::removeIf() applies to items, with the data passed to
+ * it; it returns non-zero for the items to remove.
+ */
+typedef int (*SedListOfPredicate_t) (const SedBase_t *item, void *data);
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
 #ifdef __cplusplus
 
 
 #include <vector>
+#include <map>
+#include <string>
 #include <algorithm>
 #include <functional>
 
@@ -123,6 +136,9 @@ public:
    * Creates a new SedListOf with SedNamespaces object.
    *
    * @param sbmlns the set of namespaces that this SedListOf should contain.
+   *
+   * A set already shared by the elements of a document is shared rather
+   * than copied, and not checked again.
    */
   SedListOf (SedNamespaces* sbmlns);
 
@@ -147,16 +163,43 @@ public:
   SedListOf& operator=(const SedListOf& rhs);
 
 
+  /** @cond doxygen-libsbml-internal */
+
   /**
-   * Accepts the given SedVisitor.
+   * Shows this SedListOf, but not its items, to the given SedVisitor.
    *
-   * @param v the SedVisitor instance to be used.
-   * 
-   * @return the result of calling <code>v.visit()</code>, which indicates
-   * whether the Visitor would like to visit the next item in the
-   * list.
+   * @return @c true, so that the items are visited.
+   */
+  virtual bool dispatch (SedVisitor& v) const;
+
+
+  /**
+   * Adds the vector of items and the id index of this SedListOf to the
+   * given SedMemoryVisitor.
+   */
+  virtual void addMemoryUsage (SedMemoryVisitor& v) const;
+
+
+  /**
+   * Builds the id index of this SedListOf and compacts its items for
+   * SedDocument::freeze().
+   */
+  virtual void prepareToFreeze ();
+
+  /** @endcond */
+
+
+  /**
+   * @return the number of items in this SedListOf.
+   */
+  virtual unsigned int getNumChildElements () const;
+
+
+  /**
+   * @return the <i>n</i>th item in this SedListOf, or @c NULL if @p n is
+   * out of range.
    */
-  virtual bool accept (SedVisitor& v) const;
+  virtual const SedBase* getChildElement (unsigned int n) const;
 
 
   /**
@@ -188,8 +231,22 @@ public:
    * instead, it assumes ownership of it.  This means that when the SedListOf
    * is destroyed, the item will be destroyed along with it.
    *
+   * The item must not have a parent: one taken out of another list with
+   * remove() may be added, but one still in a list or held by an element
+   * is rejected.
+   *
    * @param item the item to be added to the list.
    *
+   * @return integer value indicating success/failure of the
+   * function.  @if clike The value is drawn from the
+   * enumeration #OperationReturnValues_t. @endif The possible values
+   * returned by this function are:
+   * @li LIBSEDML_OPERATION_SUCCESS
+   * @li LIBSEDML_OPERATION_FAILED if this list is frozen
+   * @li LIBSEDML_INVALID_OBJECT if @p item is @c NULL, has a parent or
+   * is not of the type of the items of this list, in which case the
+   * caller still owns it
+   *
    * @see append(const SedBase* item)
    */
   int appendAndOwn (SedBase* item);
@@ -361,6 +418,28 @@ public:
   virtual SedBase* remove (unsigned int n);
 
 
+  /**
+   * Removes every item for which @p predicate, given the item and
+   * @p data, returns non-zero, in one pass that keeps the order of the
+   * others.  Removed items are deleted if @p doDelete is @c true, and
+   * otherwise left to the caller, who must have kept pointers to them.
+   *
+   * @return the number of items removed.
+   */
+  unsigned int removeIf (SedListOfPredicate_t predicate, void* data = NULL,
+                         bool doDelete = true);
+
+
+  /**
+   * Makes room for @p n items, so that appending up to that many does not
+   * move the list.  For lists of items of one type, in a document using an
+   * arena (see SedDocument::setUseArena()), the arena also keeps room for
+   * the items themselves, so that the items created next lie next to each
+   * other in memory.
+   */
+  void reserve (unsigned int n);
+
+
 #if 0
   /**
    * Removes item in this SedListOf items with the given identifier.
@@ -411,6 +490,15 @@ public:
   virtual void connectToChild ();
 
 
+  /**
+   * Marks the id index of this SedListOf as stale.
+   *
+   * Items call this (through their parent pointer) whenever their id
+   * changes, so that the next lookup by id rebuilds the index.
+   */
+  void invalidateIdIndex ();
+
+
   /** @endcond */
 
   /**
@@ -533,8 +621,53 @@ protected:
 
   virtual bool isValidTypeForList(SedBase * item) const; 
 
+
+  /**
+   * Returns the first item in this SedListOf with the given @p sid, or
+   * @c NULL if no such item exists.
+   *
+   * Lookups go through an id index that is built on first use and kept
+   * up to date by the functions adding and removing items, so subclasses
+   * should use this rather than scanning mItems.
+   */
+  SedBase* getItemById (const std::string& sid) const;
+
+
+  /**
+   * Removes the first item in this SedListOf with the given @p sid and
+   * returns it, or @c NULL if no such item exists.  The caller owns the
+   * returned item.
+   */
+  SedBase* removeItemById (const std::string& sid);
+
+
+  /**
+   * Returns the size of the items of this list if they are all of one
+   * type, which reserve() then keeps room for in the arena, or 0.
+   */
+  virtual size_t getItemSize () const;
+
+
   ListItem mItems;
 
+  typedef std::map<std::string, SedBase*> IdIndex;
+
+  mutable IdIndex mIdIndex;
+  mutable bool    mIdIndexValid;
+  mutable bool    mIdIndexHasDuplicates;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  void rebuildIdIndex () const;
+
+  void addToIdIndex (SedBase* item, bool atEnd);
+
+  void removeFromIdIndex (SedBase* item);
+
   /** @endcond */
 };
 
@@ -618,6 +751,30 @@ LIBSEDML_EXTERN
 SedBase_t *
 SedListOf_get (SedListOf_t *lo, unsigned int n);
 
+
+/**
+ * Copies the first @p n items in this SedListOf items (or all of them if
+ * there are fewer) to @p out.  The items still belong to the SedListOf.
+ *
+ * @return the number of items copied.
+ */
+LIBSEDML_EXTERN
+size_t
+SedListOf_getItems (SedListOf_t *lo, SedBase_t **out, size_t n);
+
+
+/**
+ * Copies the ids of the first @p n items in this SedListOf items (or of
+ * all of them if there are fewer) to @p out, @c NULL for an item without
+ * an id.  The ids must not be freed, and stay valid until the item is
+ * changed or freed.
+ *
+ * @return the number of ids copied.
+ */
+LIBSEDML_EXTERN
+size_t
+SedListOf_getIds (const SedListOf_t *lo, const char **out, size_t n);
+
 #if (0)
 /**
  * @return item in this SedListOf items with the given @p sid or @c NULL if no such
@@ -644,6 +801,22 @@ LIBSEDML_EXTERN
 SedBase_t *
 SedListOf_remove (SedListOf_t *lo, unsigned int n);
 
+/**
+ * Removes, and deletes if @p doDelete is non-zero, every item for which
+ * @p predicate returns non-zero, and returns their number.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedListOf_removeIf (SedListOf_t *lo, SedListOfPredicate_t predicate,
+                    void *data, int doDelete);
+
+/**
+ * Makes room for @p n items in this SedListOf.
+ */
+LIBSEDML_EXTERN
+void
+SedListOf_reserve (SedListOf_t *lo, unsigned int n);
+
 #if (0)
 /**
  * Removes item in this SedListOf items with the given @p sid or @c NULL if no such
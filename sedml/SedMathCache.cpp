@@ -0,0 +1,539 @@
+/**
+ * @file    SedMathCache.cpp
+ * @brief   Shared, hash-consed math of SedDataGenerators and SedComputeChanges
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedMathCache.h>
+#include <sedml/SedModelCache.h>
+#include <sedml/common/threads.h>
+
+#include <sbml/math/MathML.h>
+#include <sbml/xml/XMLNode.h>
+
+#include <map>
+#include <sstream>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of tables the interned nodes are spread over, so that threads
+ * interning different math seldom contend for one lock.
+ */
+static const unsigned int NUM_SHARDS = 32;
+
+
+/*
+ * An interned node, with the number of references to it and, once it has
+ * been written, its MathML; both are guarded by the mutex of the key shard
+ * holding the entry.
+ */
+struct SedMathEntry
+{
+  std::string   key;
+  size_t        hash;
+  ASTNode*      math;
+  unsigned int  refs;
+  XMLNode*      mathML;
+  unsigned int  keyShard;
+};
+
+
+/*
+ * One table of interned nodes by key, picked by the hash of the key; math
+ * that cannot be shared is not in byKey, and is counted in the shard its
+ * address picks.
+ */
+struct SedMathKeyShard
+{
+  std::multimap<size_t, SedMathEntry*>          byKey;
+  unsigned int                                  numHits;
+  unsigned int                                  numMisses;
+  SedMutex                                      mutex;
+};
+
+
+/*
+ * One table of interned nodes by address, picked by the address.  A thread
+ * holding the mutex of a key shard may lock a node shard, never the other
+ * way round.
+ */
+struct SedMathNodeShard
+{
+  std::map<const ASTNode*, SedMathEntry*>       byNode;
+  SedMutex                                      mutex;
+};
+
+
+/*
+ * The tables, which are never freed: objects destroyed at exit, after
+ * they would have been, still release their math into them.
+ */
+static SedMathKeyShard*  sKeyShards  = NULL;
+static SedMathNodeShard* sNodeShards = NULL;
+
+
+static SedMathKeyShard*
+getKeyShards ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sKeyShards == NULL)
+  {
+    sKeyShards = new SedMathKeyShard[NUM_SHARDS];
+    for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+    {
+      sKeyShards[i].numHits   = 0;
+      sKeyShards[i].numMisses = 0;
+      mutexInit(&sKeyShards[i].mutex);
+    }
+  }
+  return sKeyShards;
+}
+
+
+static SedMathNodeShard*
+getNodeShards ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sNodeShards == NULL)
+  {
+    sNodeShards = new SedMathNodeShard[NUM_SHARDS];
+    for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+    {
+      mutexInit(&sNodeShards[i].mutex);
+    }
+  }
+  return sNodeShards;
+}
+
+
+/*
+ * Creates the tables before main() rather than on first use, when several
+ * threads could be creating them at once.
+ */
+static SedMathKeyShard*  const sKeyShardsCreated  = getKeyShards();
+static SedMathNodeShard* const sNodeShardsCreated = getNodeShards();
+
+
+/*
+ * Returns the shard of the node shards, or of the key shards for math
+ * that cannot be shared, the node belongs to.
+ */
+static unsigned int
+getShardIndex (const ASTNode* math)
+{
+  const size_t address = (size_t)math;
+  return (unsigned int)((address / sizeof(void*)) % NUM_SHARDS);
+}
+
+
+/*
+ * Returns the entry of the interned node math, or NULL.  The entry stays
+ * only as long as the caller holds a reference to math.
+ */
+static SedMathEntry*
+findEntry (const ASTNode* math)
+{
+  SedMathNodeShard& shard = getNodeShards()[getShardIndex(math)];
+  mutexLock(&shard.mutex);
+
+  std::map<const ASTNode*, SedMathEntry*>::iterator it =
+    shard.byNode.find(math);
+  SedMathEntry* entry = (it != shard.byNode.end()) ? it->second : NULL;
+
+  mutexUnlock(&shard.mutex);
+
+  return entry;
+}
+
+
+static void
+appendBytes (std::string& key, const void* bytes, size_t length)
+{
+  key.append(static_cast<const char*>(bytes), length);
+}
+
+
+static void
+appendString (std::string& key, const std::string& value)
+{
+  const size_t length = value.size();
+  appendBytes(key, &length, sizeof(length));
+  key += value;
+}
+
+
+/*
+ * Appends the description of node to key, returning false if it cannot be
+ * shared.
+ */
+static bool
+appendKey (std::string& key, const ASTNode& node)
+{
+  if (node.getNumSemanticsAnnotations() > 0) return false;
+
+  const int type = static_cast<int>(node.getType());
+  appendBytes(key, &type, sizeof(type));
+
+  const char bvar = node.isBvar() ? 1 : 0;
+  key += bvar;
+
+  appendString(key, (node.getName() != NULL) ? node.getName() : "");
+  appendString(key, node.getUnits());
+  appendString(key, node.getId());
+  appendString(key, node.getClass());
+  appendString(key, node.getStyle());
+
+  switch (node.getType())
+  {
+  case AST_INTEGER:
+    {
+      const long value = node.getInteger();
+      appendBytes(key, &value, sizeof(value));
+    }
+    break;
+  case AST_REAL:
+    {
+      const double value = node.getReal();
+      appendBytes(key, &value, sizeof(value));
+    }
+    break;
+  case AST_REAL_E:
+    {
+      const double mantissa = node.getMantissa();
+      const long   exponent = node.getExponent();
+      appendBytes(key, &mantissa, sizeof(mantissa));
+      appendBytes(key, &exponent, sizeof(exponent));
+    }
+    break;
+  case AST_RATIONAL:
+    {
+      const long numerator   = node.getNumerator();
+      const long denominator = node.getDenominator();
+      appendBytes(key, &numerator, sizeof(numerator));
+      appendBytes(key, &denominator, sizeof(denominator));
+    }
+    break;
+  default:
+    break;
+  }
+
+  const unsigned int numChildren = node.getNumChildren();
+  appendBytes(key, &numChildren, sizeof(numChildren));
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    if (!appendKey(key, *node.getChild(i))) return false;
+  }
+
+  return true;
+}
+
+/** @endcond */
+
+
+/*
+ * Takes math and returns the interned node equal to it.
+ */
+const ASTNode*
+SedMathCache::intern (ASTNode* math)
+{
+  if (math == NULL) return NULL;
+
+  SedMathEntry* entry = new SedMathEntry;
+  entry->key    = getKey(math);
+  entry->hash   = SedModelCache::getHash(entry->key);
+  entry->math   = math;
+  entry->refs   = 1;
+  entry->mathML = NULL;
+
+  const bool shareable = !entry->key.empty();
+  entry->keyShard = shareable ? (unsigned int)(entry->hash % NUM_SHARDS)
+                              : getShardIndex(math);
+
+  SedMathKeyShard& shard = getKeyShards()[entry->keyShard];
+  mutexLock(&shard.mutex);
+
+  if (shareable)
+  {
+    typedef std::multimap<size_t, SedMathEntry*>::iterator Iterator;
+    std::pair<Iterator, Iterator> range = shard.byKey.equal_range(entry->hash);
+    for (Iterator it = range.first; it != range.second; ++it)
+    {
+      if (it->second->key == entry->key)
+      {
+        SedMathEntry* found = it->second;
+        ++found->refs;
+        ++shard.numHits;
+        mutexUnlock(&shard.mutex);
+
+        delete entry;
+        delete math;
+        return found->math;
+      }
+    }
+
+    shard.byKey.insert(std::make_pair(entry->hash, entry));
+  }
+
+  ++shard.numMisses;
+
+  // indexed by address before the key shard is unlocked, so that whoever
+  // finds the entry by key next can release it
+  SedMathNodeShard& nodeShard = getNodeShards()[getShardIndex(math)];
+  mutexLock(&nodeShard.mutex);
+  nodeShard.byNode[math] = entry;
+  mutexUnlock(&nodeShard.mutex);
+
+  mutexUnlock(&shard.mutex);
+
+  return math;
+}
+
+
+/*
+ * Adds a reference to the interned node math.
+ */
+const ASTNode*
+SedMathCache::acquire (const ASTNode* math)
+{
+  if (math == NULL) return NULL;
+
+  // the caller holds a reference, so the entry stays
+  SedMathEntry* entry = findEntry(math);
+  if (entry == NULL) return intern(math->deepCopy());
+
+  SedMathKeyShard& shard = getKeyShards()[entry->keyShard];
+  mutexLock(&shard.mutex);
+  ++entry->refs;
+  mutexUnlock(&shard.mutex);
+
+  return math;
+}
+
+
+/*
+ * Drops a reference to the interned node math.
+ */
+void
+SedMathCache::release (const ASTNode* math)
+{
+  if (math == NULL) return;
+
+  SedMathEntry* entry = findEntry(math);
+  if (entry == NULL) return;
+
+  SedMathKeyShard& shard = getKeyShards()[entry->keyShard];
+  mutexLock(&shard.mutex);
+
+  const bool last = (--entry->refs == 0);
+  if (last)
+  {
+    typedef std::multimap<size_t, SedMathEntry*>::iterator Iterator;
+    std::pair<Iterator, Iterator> range = shard.byKey.equal_range(entry->hash);
+    for (Iterator k = range.first; k != range.second; ++k)
+    {
+      if (k->second == entry)
+      {
+        shard.byKey.erase(k);
+        break;
+      }
+    }
+
+    SedMathNodeShard& nodeShard = getNodeShards()[getShardIndex(math)];
+    mutexLock(&nodeShard.mutex);
+    nodeShard.byNode.erase(math);
+    mutexUnlock(&nodeShard.mutex);
+  }
+
+  mutexUnlock(&shard.mutex);
+
+  if (last)
+  {
+    delete entry->math;
+    delete entry->mathML;
+    delete entry;
+  }
+}
+
+
+/*
+ * Returns true if math is an interned node.
+ */
+bool
+SedMathCache::isInterned (const ASTNode* math)
+{
+  return findEntry(math) != NULL;
+}
+
+
+/*
+ * Writes math as MathML to stream.
+ */
+void
+SedMathCache::write (const ASTNode* math, XMLOutputStream& stream)
+{
+  if (math == NULL) return;
+
+  // the caller holds a reference, so the entry stays
+  SedMathEntry*    entry  = findEntry(math);
+  SedMathKeyShard* shard  = NULL;
+  const XMLNode*   mathML = NULL;
+
+  if (entry != NULL)
+  {
+    shard = &getKeyShards()[entry->keyShard];
+    mutexLock(&shard->mutex);
+    mathML = entry->mathML;
+    mutexUnlock(&shard->mutex);
+  }
+
+  if (entry != NULL && mathML == NULL)
+  {
+    // should another thread convert the same math meanwhile, the first
+    // result is kept
+    std::ostringstream os;
+    {
+      XMLOutputStream xos(os, "UTF-8", false);
+      xos.setAutoIndent(false);
+      writeMathML(math, xos, NULL);
+    }
+
+    XMLNode* converted = XMLNode::convertStringToXMLNode(os.str());
+
+    mutexLock(&shard->mutex);
+    if (entry->mathML == NULL)
+    {
+      entry->mathML = converted;
+      converted = NULL;
+    }
+    mathML = entry->mathML;
+    mutexUnlock(&shard->mutex);
+
+    delete converted;
+  }
+
+  if (mathML != NULL)
+  {
+    stream << *mathML;
+  }
+  else
+  {
+    writeMathML(math, stream, NULL);
+  }
+}
+
+
+/*
+ * Returns the description of math interned nodes are compared by.
+ */
+std::string
+SedMathCache::getKey (const ASTNode* math)
+{
+  std::string key;
+  if (math == NULL || !appendKey(key, *math)) key.clear();
+  return key;
+}
+
+
+unsigned int
+SedMathCache::getNumEntries ()
+{
+  SedMathNodeShard* shards = getNodeShards();
+  unsigned int numEntries = 0;
+  for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+  {
+    mutexLock(&shards[i].mutex);
+    numEntries += (unsigned int)shards[i].byNode.size();
+    mutexUnlock(&shards[i].mutex);
+  }
+
+  return numEntries;
+}
+
+
+unsigned int
+SedMathCache::getNumHits ()
+{
+  SedMathKeyShard* shards = getKeyShards();
+  unsigned int numHits = 0;
+  for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+  {
+    mutexLock(&shards[i].mutex);
+    numHits += shards[i].numHits;
+    mutexUnlock(&shards[i].mutex);
+  }
+
+  return numHits;
+}
+
+
+unsigned int
+SedMathCache::getNumMisses ()
+{
+  SedMathKeyShard* shards = getKeyShards();
+  unsigned int numMisses = 0;
+  for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+  {
+    mutexLock(&shards[i].mutex);
+    numMisses += shards[i].numMisses;
+    mutexUnlock(&shards[i].mutex);
+  }
+
+  return numMisses;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumEntries ()
+{
+  return SedMathCache::getNumEntries();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumHits ()
+{
+  return SedMathCache::getNumHits();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumMisses ()
+{
+  return SedMathCache::getNumMisses();
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
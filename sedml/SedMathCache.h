@@ -0,0 +1,177 @@
+/**
+ * @file    SedMathCache.h
+ * @brief   Shared, hash-consed math of SedDataGenerators and SedComputeChanges
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedMathCache
+ * @ingroup Core
+ * @brief Lets structurally identical math share one ASTNode.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Most data generators of a document are the same trivial
+ * <code>&lt;ci&gt;var&lt;/ci&gt;</code> or scaling expression.  The math
+ * SedDataGenerator and SedComputeChange read or are given goes through
+ * intern(), which returns the ASTNode already held for an equal tree, if
+ * there is one, and frees the new one: equal math anywhere in the process
+ * is one node, whatever document it is in, and copying an object only adds
+ * a reference to it.
+ *
+ * Interned nodes are immutable, and the getMath() methods only return them
+ * as const; setMath() and unsetMath() drop the reference of the object and
+ * setMath() interns a copy of the new math, so that changing the math of
+ * one object never changes the math of another.
+ *
+ * write() writes interned math as the MathML it was written as the first
+ * time, so that shared math is converted to MathML only once.
+ *
+ * Trees are equal when their nodes have the same types, names, values,
+ * units, ids, classes and styles; math carrying semantics annotations is
+ * never shared.  All methods may be called by several threads at once.
+ */
+
+#ifndef SedMathCache_h
+#define SedMathCache_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLOutputStream.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedMathCache
+{
+public:
+
+  /**
+   * Takes @p math and returns the interned node equal to it, which is
+   * @p math itself unless an equal node was interned before, in which case
+   * @p math is deleted.  The caller holds one reference to the result,
+   * to be dropped with release().
+   *
+   * @return the interned node, or @c NULL if @p math is @c NULL.
+   */
+  static const ASTNode* intern (ASTNode* math);
+
+
+  /**
+   * Adds a reference to the interned node @p math; a node that is not
+   * interned is copied and the copy interned.
+   *
+   * @return the interned node, or @c NULL if @p math is @c NULL.
+   */
+  static const ASTNode* acquire (const ASTNode* math);
+
+
+  /**
+   * Drops a reference to the interned node @p math, deleting it with the
+   * last one.  Nodes that are not interned, and @c NULL, are ignored.
+   */
+  static void release (const ASTNode* math);
+
+
+  /**
+   * @return @c true if @p math is an interned node.
+   */
+  static bool isInterned (const ASTNode* math);
+
+
+  /**
+   * Writes @p math as MathML to @p stream, reusing the MathML of an
+   * interned node once it has been written.
+   */
+  static void write (const ASTNode* math, XMLOutputStream& stream);
+
+
+  /**
+   * @return the description of @p math interned nodes are compared by, or
+   * an empty string if it cannot be shared.
+   */
+  static std::string getKey (const ASTNode* math);
+
+
+  /**
+   * @return the number of interned nodes.
+   */
+  static unsigned int getNumEntries ();
+
+
+  /**
+   * @return how many times intern() found an equal node.
+   */
+  static unsigned int getNumHits ();
+
+
+  /**
+   * @return how many times intern() had to add a node.
+   */
+  static unsigned int getNumMisses ();
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Returns the number of interned math nodes.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumEntries ();
+
+
+/**
+ * Returns how many times interning math found an equal node.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumHits ();
+
+
+/**
+ * Returns how many times interning math had to add a node.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathCache_getNumMisses ();
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedMathCache_h */
@@ -0,0 +1,860 @@
+/**
+ * @file    SedMemoryUsage.cpp
+ * @brief   Estimates the memory a tree of Sed objects takes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedMemoryUsage.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChange.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedParameter.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLNamespaces.h>
+#include <sbml/xml/XMLTriple.h>
+#include <sbml/math/ASTNode.h>
+
+#include <cstring>
+#include <new>
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/*
+ * Creates a new SedMemoryUsage counting nothing.
+ */
+SedMemoryUsage::SedMemoryUsage ()
+  : mEntries ()
+  , mSharedBytes (0)
+{
+}
+
+
+/*
+ * Returns the bytes counted.
+ */
+size_t
+SedMemoryUsage::getTotalBytes () const
+{
+  size_t total = 0;
+
+  map<int, Entry>::const_iterator it;
+  for (it = mEntries.begin(); it != mEntries.end(); ++it)
+  {
+    total += getBytes(it->second);
+  }
+
+  return total;
+}
+
+
+/*
+ * Returns the bytes counted for objects of the type code typeCode.
+ */
+size_t
+SedMemoryUsage::getBytes (int typeCode) const
+{
+  map<int, Entry>::const_iterator it = mEntries.find(typeCode);
+  return (it != mEntries.end()) ? getBytes(it->second) : 0;
+}
+
+
+/*
+ * Returns the bytes in category counted for objects of the type code
+ * typeCode.
+ */
+size_t
+SedMemoryUsage::getBytes (int typeCode, SedMemoryCategory_t category) const
+{
+  if (category < 0 || category >= SED_MEMORY_NUM_CATEGORIES) return 0;
+
+  map<int, Entry>::const_iterator it = mEntries.find(typeCode);
+  return (it != mEntries.end()) ? it->second.bytes[category] : 0;
+}
+
+
+/*
+ * Returns the bytes counted in category.
+ */
+size_t
+SedMemoryUsage::getCategoryBytes (SedMemoryCategory_t category) const
+{
+  if (category < 0 || category >= SED_MEMORY_NUM_CATEGORIES) return 0;
+
+  size_t total = 0;
+
+  map<int, Entry>::const_iterator it;
+  for (it = mEntries.begin(); it != mEntries.end(); ++it)
+  {
+    total += it->second.bytes[category];
+  }
+
+  return total;
+}
+
+
+/*
+ * Returns the number of objects of the type code typeCode counted.
+ */
+unsigned int
+SedMemoryUsage::getNumObjects (int typeCode) const
+{
+  map<int, Entry>::const_iterator it = mEntries.find(typeCode);
+  return (it != mEntries.end()) ? it->second.numObjects : 0;
+}
+
+
+/*
+ * Returns the number of type codes objects were counted for.
+ */
+unsigned int
+SedMemoryUsage::getNumTypeCodes () const
+{
+  return (unsigned int)mEntries.size();
+}
+
+
+/*
+ * Returns the nth of the type codes objects were counted for.
+ */
+int
+SedMemoryUsage::getTypeCode (unsigned int n) const
+{
+  map<int, Entry>::const_iterator it = mEntries.begin();
+  for (; it != mEntries.end() && n > 0; ++it, --n)
+  {
+  }
+
+  return (it != mEntries.end()) ? it->first : SEDML_UNKNOWN;
+}
+
+
+/*
+ * Returns the bytes found shared.
+ */
+size_t
+SedMemoryUsage::getSharedBytes () const
+{
+  return mSharedBytes;
+}
+
+
+/*
+ * Counts bytes in category for an object of the type code typeCode.
+ */
+void
+SedMemoryUsage::add (int typeCode, SedMemoryCategory_t category,
+                     size_t bytes)
+{
+  if (category < 0 || category >= SED_MEMORY_NUM_CATEGORIES) return;
+
+  map<int, Entry>::iterator it = mEntries.find(typeCode);
+  if (it == mEntries.end())
+  {
+    Entry entry;
+    memset(&entry, 0, sizeof(entry));
+    it = mEntries.insert(make_pair(typeCode, entry)).first;
+  }
+
+  it->second.bytes[category] += bytes;
+}
+
+
+/*
+ * Counts an object of the type code typeCode that takes bytes itself.
+ */
+void
+SedMemoryUsage::addObject (int typeCode, size_t bytes)
+{
+  add(typeCode, SED_MEMORY_OBJECTS, bytes);
+  ++mEntries[typeCode].numObjects;
+}
+
+
+/*
+ * Counts bytes found shared.
+ */
+void
+SedMemoryUsage::addShared (size_t bytes)
+{
+  mSharedBytes += bytes;
+}
+
+
+/*
+ * Forgets everything counted.
+ */
+void
+SedMemoryUsage::clear ()
+{
+  mEntries.clear();
+  mSharedBytes = 0;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+size_t
+SedMemoryUsage::getBytes (const Entry& entry) const
+{
+  size_t total = 0;
+
+  for (int i = 0; i < SED_MEMORY_NUM_CATEGORIES; ++i)
+  {
+    total += entry.bytes[i];
+  }
+
+  return total;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedMemoryVisitor with an empty usage.
+ */
+SedMemoryVisitor::SedMemoryVisitor ()
+  : SedVisitor ()
+  , mUsage ()
+  , mSeen ()
+{
+}
+
+
+/*
+ * Destroys this SedMemoryVisitor.
+ */
+SedMemoryVisitor::~SedMemoryVisitor ()
+{
+}
+
+
+/*
+ * Returns what the objects visited take.
+ */
+const SedMemoryUsage&
+SedMemoryVisitor::getUsage () const
+{
+  return mUsage;
+}
+
+
+/*
+ * Forgets the objects visited and the shared items seen.
+ */
+void
+SedMemoryVisitor::clear ()
+{
+  mUsage.clear();
+  mSeen.clear();
+}
+
+
+void
+SedMemoryVisitor::visit (const SedDocument &x)
+{
+  count(x, sizeof(SedDocument));
+}
+
+
+/*
+ * The lists are members of the objects holding them, and so take no
+ * bytes of their own beyond their items and indexes.
+ */
+void
+SedMemoryVisitor::visit (const SedListOf &x, int)
+{
+  count(x, 0);
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedBase &x)
+{
+  return count(x, sizeof(SedBase));
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedModel &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedModel));
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+  addString(type, x.getLanguage());
+  addString(type, x.getSource());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedChange &x)
+{
+  countChange(x, sizeof(SedChange));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedChangeAttribute &x)
+{
+  countChange(x, sizeof(SedChangeAttribute));
+  addString(x.getTypeCode(), x.getNewValue());
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedComputeChange &x)
+{
+  countChange(x, sizeof(SedComputeChange));
+  addMath(x.getTypeCode(), x.getMath());
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedRemoveXML &x)
+{
+  countChange(x, sizeof(SedRemoveXML));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedVariable &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedVariable));
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+  addString(type, x.getSymbol());
+  addString(type, x.getTarget());
+  addSymbol(type, x.getTaskReference());
+  addSymbol(type, x.getModelReference());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedParameter &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedParameter));
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedSimulation &x)
+{
+  countSimulation(x, sizeof(SedSimulation));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedUniformTimeCourse &x)
+{
+  countSimulation(x, sizeof(SedUniformTimeCourse));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedAlgorithm &x)
+{
+  count(x, sizeof(SedAlgorithm));
+  addString(x.getTypeCode(), x.getKisaoID());
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedTask &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedTask));
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+  addSymbol(type, x.getModelReference());
+  addSymbol(type, x.getSimulationReference());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedDataGenerator &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedDataGenerator));
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+  addMath(type, x.getMath());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedReport &x)
+{
+  countOutput(x, sizeof(SedReport));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedPlot2D &x)
+{
+  countOutput(x, sizeof(SedPlot2D));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedPlot3D &x)
+{
+  countOutput(x, sizeof(SedPlot3D));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedDataSet &x)
+{
+  const int type = x.getTypeCode();
+
+  count(x, sizeof(SedDataSet));
+  addSymbol(type, x.getId());
+  addString(type, x.getLabel());
+  addOwnedString(type, x.getName());
+  addSymbol(type, x.getDataReference());
+
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedCurve &x)
+{
+  countCurve(x, sizeof(SedCurve));
+  return true;
+}
+
+
+bool
+SedMemoryVisitor::visit (const SedSurface &x)
+{
+  countCurve(x, sizeof(SedSurface));
+  addSymbol(x.getTypeCode(), x.getZDataReference());
+  return true;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+void
+SedMemoryVisitor::add (int typeCode, SedMemoryCategory_t category,
+                       size_t bytes)
+{
+  mUsage.add(typeCode, category, bytes);
+}
+
+
+void
+SedMemoryVisitor::addString (int typeCode, const std::string& value,
+                             SedMemoryCategory_t category)
+{
+  const size_t size = getStringSize(value);
+  if (size > 0) mUsage.add(typeCode, category, size);
+}
+
+
+void
+SedMemoryVisitor::addOwnedString (int typeCode, const std::string& value)
+{
+  if (value.empty()) return;
+
+  mUsage.add(typeCode, SED_MEMORY_STRINGS,
+             sizeof(std::string) + getStringSize(value));
+}
+
+
+/*
+ * Equal symbols share one std::string in the table of SedSymbol, so its
+ * address tells whether the text was counted already.
+ */
+void
+SedMemoryVisitor::addSymbol (int typeCode, const std::string& value)
+{
+  if (value.empty()) return;
+
+  const size_t size =
+    getTreeNodeSize(sizeof(std::pair<const std::string, unsigned int>))
+    + getStringSize(value);
+
+  addShared(typeCode, &value, size, SED_MEMORY_STRINGS);
+}
+
+
+void
+SedMemoryVisitor::addShared (int typeCode, const void* key, size_t bytes,
+                             SedMemoryCategory_t category)
+{
+  if (key == NULL) return;
+
+  if (mSeen.insert(key).second)
+  {
+    mUsage.add(typeCode, category, bytes);
+  }
+  else
+  {
+    mUsage.addShared(bytes);
+  }
+}
+
+
+void
+SedMemoryVisitor::addXMLNode (int typeCode, const XMLNode* node,
+                              SedMemoryCategory_t category)
+{
+  if (node == NULL) return;
+
+  mUsage.add(typeCode, category, getXMLNodeSize(*node));
+}
+
+
+void
+SedMemoryVisitor::addMath (int typeCode, const ASTNode* math)
+{
+  if (math == NULL) return;
+
+  addShared(typeCode, math, getMathSize(*math), SED_MEMORY_MATH);
+}
+
+
+/*
+ * Strings short enough to be kept inside the std::string itself take
+ * nothing more; others take their capacity and a terminator from the
+ * heap.
+ */
+size_t
+SedMemoryVisitor::getStringSize (const std::string& value)
+{
+  if (value.capacity() < sizeof(std::string)) return 0;
+
+  return value.capacity() + 1;
+}
+
+
+/*
+ * Children are kept by value in the vector of their parent, and each of
+ * them is counted with its XMLNode.
+ */
+size_t
+SedMemoryVisitor::getXMLNodeSize (const XMLNode& node)
+{
+  size_t total = 0;
+
+  std::vector<const XMLNode*> pending;
+  pending.push_back(&node);
+
+  while (!pending.empty())
+  {
+    const XMLNode* current = pending.back();
+    pending.pop_back();
+
+    total += sizeof(XMLNode)
+           + getStringSize(current->getName())
+           + getStringSize(current->getURI())
+           + getStringSize(current->getPrefix())
+           + getStringSize(current->getCharacters());
+
+    for (int i = 0; i < current->getAttributesLength(); ++i)
+    {
+      total += sizeof(XMLTriple) + sizeof(std::string)
+             + getStringSize(current->getAttrName(i))
+             + getStringSize(current->getAttrURI(i))
+             + getStringSize(current->getAttrPrefix(i))
+             + getStringSize(current->getAttrValue(i));
+    }
+
+    for (int i = 0; i < current->getNamespacesLength(); ++i)
+    {
+      total += 2 * sizeof(std::string)
+             + getStringSize(current->getNamespacePrefix(i))
+             + getStringSize(current->getNamespaceURI(i));
+    }
+
+    for (unsigned int n = 0; n < current->getNumChildren(); ++n)
+    {
+      pending.push_back(&current->getChild(n));
+    }
+  }
+
+  return total;
+}
+
+
+size_t
+SedMemoryVisitor::getNamespacesSize (const XMLNamespaces& xmlns)
+{
+  size_t total = sizeof(XMLNamespaces);
+
+  for (int i = 0; i < xmlns.getLength(); ++i)
+  {
+    total += 2 * sizeof(std::string)
+           + getStringSize(xmlns.getPrefix(i))
+           + getStringSize(xmlns.getURI(i));
+  }
+
+  return total;
+}
+
+
+/*
+ * The children of an ASTNode are held through a List, which takes a node
+ * of two pointers for each.
+ */
+size_t
+SedMemoryVisitor::getMathSize (const ASTNode& math)
+{
+  size_t total = 0;
+
+  std::vector<const ASTNode*> pending;
+  pending.push_back(&math);
+
+  while (!pending.empty())
+  {
+    const ASTNode* current = pending.back();
+    pending.pop_back();
+
+    total += sizeof(ASTNode);
+
+    const char* name = current->getName();
+    if (name != NULL) total += strlen(name) + 1;
+
+    for (unsigned int n = 0; n < current->getNumChildren(); ++n)
+    {
+      const ASTNode* child = current->getChild(n);
+      if (child == NULL) continue;
+
+      total += 2 * sizeof(void*);
+      pending.push_back(child);
+    }
+  }
+
+  return total;
+}
+
+
+/*
+ * A node of a red-black tree keeps its colour and three links next to
+ * the value.
+ */
+size_t
+SedMemoryVisitor::getTreeNodeSize (size_t size)
+{
+  return 4 * sizeof(void*) + size;
+}
+
+
+/*
+ * Counts x as an object taking size bytes of the arena or heap, with what
+ * SedBase holds for it.
+ */
+bool
+SedMemoryVisitor::count (const SedBase& x, size_t size)
+{
+  mUsage.addObject(x.getTypeCode(),
+                   (size > 0) ? SedBase::getAllocationSize(size) : 0);
+  x.addMemoryUsage(*this);
+
+  return true;
+}
+
+
+void
+SedMemoryVisitor::countChange (const SedChange& x, size_t size)
+{
+  count(x, size);
+  addString(x.getTypeCode(), x.getTarget());
+}
+
+
+void
+SedMemoryVisitor::countSimulation (const SedSimulation& x, size_t size)
+{
+  const int type = x.getTypeCode();
+
+  count(x, size);
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+}
+
+
+void
+SedMemoryVisitor::countOutput (const SedOutput& x, size_t size)
+{
+  const int type = x.getTypeCode();
+
+  count(x, size);
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+}
+
+
+void
+SedMemoryVisitor::countCurve (const SedCurve& x, size_t size)
+{
+  const int type = x.getTypeCode();
+
+  count(x, size);
+  addSymbol(type, x.getId());
+  addOwnedString(type, x.getName());
+  addSymbol(type, x.getXDataReference());
+  addSymbol(type, x.getYDataReference());
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Estimates the memory sb and everything below it take, and returns it in
+ * a new SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+SedMemoryUsage_t *
+SedMemoryUsage_create (const SedBase_t *sb)
+{
+  if (sb == NULL) return NULL;
+
+  SedMemoryVisitor visitor;
+  sb->accept(visitor);
+
+  return new (nothrow) SedMemoryUsage(visitor.getUsage());
+}
+
+
+/**
+ * Frees the given SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_free (SedMemoryUsage_t *smu)
+{
+  delete smu;
+}
+
+
+/**
+ * Returns the bytes counted by the given SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getTotalBytes (const SedMemoryUsage_t *smu)
+{
+  return (smu != NULL) ? smu->getTotalBytes() : 0;
+}
+
+
+/**
+ * Returns the bytes counted for objects of the type code typeCode.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getBytes (const SedMemoryUsage_t *smu, int typeCode)
+{
+  return (smu != NULL) ? smu->getBytes(typeCode) : 0;
+}
+
+
+/**
+ * Returns the bytes counted in category.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getCategoryBytes (const SedMemoryUsage_t *smu,
+                                 SedMemoryCategory_t category)
+{
+  return (smu != NULL) ? smu->getCategoryBytes(category) : 0;
+}
+
+
+/**
+ * Returns the number of objects of the type code typeCode counted.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjects (const SedMemoryUsage_t *smu, int typeCode)
+{
+  return (smu != NULL) ? smu->getNumObjects(typeCode) : 0;
+}
+
+
+/**
+ * Returns the bytes found shared, and not counted again.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getSharedBytes (const SedMemoryUsage_t *smu)
+{
+  return (smu != NULL) ? smu->getSharedBytes() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
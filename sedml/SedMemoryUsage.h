@@ -0,0 +1,396 @@
+/**
+ * @file    SedMemoryUsage.h
+ * @brief   Estimates the memory a tree of Sed objects takes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedMemoryUsage
+ * @ingroup Core
+ * @brief The bytes a tree of Sed objects takes, by type code and category.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedMemoryUsage is filled by a SedMemoryVisitor, usually through
+ * SedDocument::getMemoryUsage().  Every byte is counted for the type code
+ * of the object that holds it, in one of the categories of
+ * #SedMemoryCategory_t: the objects themselves, their strings, the
+ * XMLNode trees of their notes and annotations, the ASTNode trees of their
+ * math, their namespaces, and the indexes and XML kept to speed up lookups
+ * and writes.
+ *
+ * What is shared between objects, such as interned ids, math interned by
+ * SedMathCache and namespaces and notes shared between the elements of a
+ * document, is counted once for the object it is met at first;
+ * getSharedBytes() tells how much more the objects after it would have
+ * taken with copies of their own.
+ *
+ * The counts are estimates: they take the sizes of the objects and the
+ * lengths of their strings and containers, but not the bookkeeping of the
+ * heap itself, and strings short enough to be kept inside a std::string
+ * are not counted again.
+ *
+ * @class SedMemoryVisitor
+ * @ingroup Core
+ * @brief Fills a SedMemoryUsage with the objects it visits.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedMemoryVisitor passed to SedBase::accept() of an object adds that
+ * object and everything below it to getUsage().  Items that are shared are
+ * remembered, so that several objects visited with one visitor count them
+ * once.
+ */
+
+#ifndef SedMemoryUsage_h
+#define SedMemoryUsage_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+/**
+ * @enum  SedMemoryCategory_t
+ * @brief What the bytes of a SedMemoryUsage are taken by.
+ */
+typedef enum
+{
+    SED_MEMORY_OBJECTS     = 0 /*!< The Sed objects and their lists. */
+  , SED_MEMORY_STRINGS     = 1 /*!< Ids, names, references and other attribute values. */
+  , SED_MEMORY_NOTES       = 2 /*!< Notes, parsed or not. */
+  , SED_MEMORY_ANNOTATIONS = 3 /*!< Annotations, parsed or not. */
+  , SED_MEMORY_MATH        = 4 /*!< The ASTNode trees of math. */
+  , SED_MEMORY_NAMESPACES  = 5 /*!< SedNamespaces and XMLNamespaces. */
+  , SED_MEMORY_CACHES      = 6 /*!< Id indexes and XML kept for incremental writes. */
+  , SED_MEMORY_NUM_CATEGORIES  /*!< The number of categories. */
+} SedMemoryCategory_t;
+
+
+#ifdef __cplusplus
+
+
+#include <sedml/SedVisitor.h>
+
+#include <map>
+#include <set>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class XMLNode;
+class XMLNamespaces;
+class ASTNode;
+
+
+class LIBSEDML_EXTERN SedMemoryUsage
+{
+public:
+
+  /**
+   * Creates a new SedMemoryUsage counting nothing.
+   */
+  SedMemoryUsage ();
+
+
+  /**
+   * @return the bytes counted.
+   */
+  size_t getTotalBytes () const;
+
+
+  /**
+   * @return the bytes counted for objects of the type code @p typeCode.
+   */
+  size_t getBytes (int typeCode) const;
+
+
+  /**
+   * @return the bytes in @p category counted for objects of the type code
+   * @p typeCode.
+   */
+  size_t getBytes (int typeCode, SedMemoryCategory_t category) const;
+
+
+  /**
+   * @return the bytes counted in @p category.
+   */
+  size_t getCategoryBytes (SedMemoryCategory_t category) const;
+
+
+  /**
+   * @return the number of objects of the type code @p typeCode counted.
+   */
+  unsigned int getNumObjects (int typeCode) const;
+
+
+  /**
+   * @return the number of type codes objects were counted for.
+   */
+  unsigned int getNumTypeCodes () const;
+
+
+  /**
+   * @return the <em>n</em>th of the type codes objects were counted for,
+   * in increasing order, or @c SEDML_UNKNOWN.
+   */
+  int getTypeCode (unsigned int n) const;
+
+
+  /**
+   * @return the bytes that objects found shared with an object counted
+   * before them, and so were not counted again.
+   */
+  size_t getSharedBytes () const;
+
+
+  /**
+   * Counts @p bytes in @p category for an object of the type code
+   * @p typeCode.
+   */
+  void add (int typeCode, SedMemoryCategory_t category, size_t bytes);
+
+
+  /**
+   * Counts an object of the type code @p typeCode that takes @p bytes
+   * itself.
+   */
+  void addObject (int typeCode, size_t bytes);
+
+
+  /**
+   * Counts @p bytes found shared.
+   */
+  void addShared (size_t bytes);
+
+
+  /**
+   * Forgets everything counted.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Entry
+  {
+    unsigned int  numObjects;
+    size_t        bytes[SED_MEMORY_NUM_CATEGORIES];
+  };
+
+  size_t getBytes (const Entry& entry) const;
+
+  std::map<int, Entry>  mEntries;
+  size_t                mSharedBytes;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedMemoryVisitor : public SedVisitor
+{
+public:
+
+  /**
+   * Creates a new SedMemoryVisitor with an empty usage.
+   */
+  SedMemoryVisitor ();
+
+
+  /**
+   * Destroys this SedMemoryVisitor.
+   */
+  virtual ~SedMemoryVisitor ();
+
+
+  /**
+   * @return what the objects visited take.
+   */
+  const SedMemoryUsage& getUsage () const;
+
+
+  /**
+   * Forgets the objects visited and the shared items seen.
+   */
+  void clear ();
+
+
+  virtual void visit (const SedDocument &x);
+  virtual void visit (const SedListOf &x, int type);
+  virtual bool visit (const SedBase &x);
+  virtual bool visit (const SedModel &x);
+  virtual bool visit (const SedChange &x);
+  virtual bool visit (const SedChangeAttribute &x);
+  virtual bool visit (const SedComputeChange &x);
+  virtual bool visit (const SedRemoveXML &x);
+  virtual bool visit (const SedVariable &x);
+  virtual bool visit (const SedParameter &x);
+  virtual bool visit (const SedSimulation &x);
+  virtual bool visit (const SedUniformTimeCourse &x);
+  virtual bool visit (const SedAlgorithm &x);
+  virtual bool visit (const SedTask &x);
+  virtual bool visit (const SedDataGenerator &x);
+  virtual bool visit (const SedReport &x);
+  virtual bool visit (const SedPlot2D &x);
+  virtual bool visit (const SedPlot3D &x);
+  virtual bool visit (const SedDataSet &x);
+  virtual bool visit (const SedCurve &x);
+  virtual bool visit (const SedSurface &x);
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * Used by the objects visited to count what they hold; typeCode is
+   * that of the object.
+   */
+
+  void add (int typeCode, SedMemoryCategory_t category, size_t bytes);
+
+  // the characters of value kept outside of it
+  void addString (int typeCode, const std::string& value,
+                  SedMemoryCategory_t category = SED_MEMORY_STRINGS);
+
+  // a string value of its own on the heap, as SedOptionalString keeps
+  void addOwnedString (int typeCode, const std::string& value);
+
+  // the interned text of a SedSymbol, counted once
+  void addSymbol (int typeCode, const std::string& value);
+
+  // bytes shared under key, counted once
+  void addShared (int typeCode, const void* key, size_t bytes,
+                  SedMemoryCategory_t category);
+
+  void addXMLNode (int typeCode, const XMLNode* node,
+                   SedMemoryCategory_t category);
+
+  // math is interned by SedMathCache, and counted once
+  void addMath (int typeCode, const ASTNode* math);
+
+  static size_t getStringSize (const std::string& value);
+
+  // the whole tree below node, node included
+  static size_t getXMLNodeSize (const XMLNode& node);
+
+  static size_t getNamespacesSize (const XMLNamespaces& xmlns);
+
+  // the whole tree below math, math included
+  static size_t getMathSize (const ASTNode& math);
+
+  // a node of a std::map or std::set holding a value of size bytes
+  static size_t getTreeNodeSize (size_t size);
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  bool count (const SedBase& x, size_t size);
+
+  void countChange (const SedChange& x, size_t size);
+
+  void countSimulation (const SedSimulation& x, size_t size);
+
+  void countOutput (const SedOutput& x, size_t size);
+
+  void countCurve (const SedCurve& x, size_t size);
+
+  SedMemoryUsage         mUsage;
+  std::set<const void*>  mSeen;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Estimates the memory @p sb and everything below it take, and returns it
+ * in a new SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+SedMemoryUsage_t *
+SedMemoryUsage_create (const SedBase_t *sb);
+
+
+/**
+ * Frees the given SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_free (SedMemoryUsage_t *smu);
+
+
+/**
+ * Returns the bytes counted by the given SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getTotalBytes (const SedMemoryUsage_t *smu);
+
+
+/**
+ * Returns the bytes counted for objects of the type code @p typeCode.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getBytes (const SedMemoryUsage_t *smu, int typeCode);
+
+
+/**
+ * Returns the bytes counted in @p category.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getCategoryBytes (const SedMemoryUsage_t *smu,
+                                 SedMemoryCategory_t category);
+
+
+/**
+ * Returns the number of objects of the type code @p typeCode counted.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjects (const SedMemoryUsage_t *smu, int typeCode);
+
+
+/**
+ * Returns the bytes found shared, and not counted again.
+ */
+LIBSEDML_EXTERN
+size_t
+SedMemoryUsage_getSharedBytes (const SedMemoryUsage_t *smu);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedMemoryUsage_h */
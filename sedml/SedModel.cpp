@@ -89,6 +89,7 @@ SedModel::SedModel (SedNamespaces* sedns)
  */
 SedModel::SedModel (const SedModel& orig)
 	: SedBase(orig)
+	, mChange (orig.mChange)
 {
 	if (&orig == NULL)
 	{
@@ -100,7 +101,6 @@ SedModel::SedModel (const SedModel& orig)
 		mName  = orig.mName;
 		mLanguage  = orig.mLanguage;
 		mSource  = orig.mSource;
-		mChange  = orig.mChange;
 
 		// connect to child objects
 		connectToChild();
@@ -238,7 +238,11 @@ SedModel::isSetSource() const
 int
 SedModel::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -248,6 +252,8 @@ SedModel::setId(const std::string& id)
 int
 SedModel::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -266,6 +272,8 @@ SedModel::setName(const std::string& name)
 int
 SedModel::setLanguage(const std::string& language)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(language) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -284,6 +292,8 @@ SedModel::setLanguage(const std::string& language)
 int
 SedModel::setSource(const std::string& source)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(source) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -302,7 +312,10 @@ SedModel::setSource(const std::string& source)
 int
 SedModel::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -321,6 +334,8 @@ SedModel::unsetId()
 int
 SedModel::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -340,6 +355,8 @@ SedModel::unsetName()
 int
 SedModel::unsetLanguage()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLanguage.erase();
 
 	if (mLanguage.empty() == true)
@@ -359,6 +376,8 @@ SedModel::unsetLanguage()
 int
 SedModel::unsetSource()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mSource.erase();
 
 	if (mSource.empty() == true)
@@ -463,6 +482,17 @@ SedModel::addChange(const SedChange* sc)
 }
 
 
+/*
+ * Adds the given SedChange to this SedModel, which takes ownership of it.
+ */
+int
+SedModel::addChangeAndOwn(SedChange* sc)
+{
+	if(sc == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mChange.appendAndOwn(sc);
+}
+
+
 /**
  * Get the number of SedChange objects in this SedModel.
  *
@@ -485,7 +515,8 @@ SedModel::getNumChanges() const
 SedRemoveXML* 
 SedModel::createRemoveXML()
 {
-	SedRemoveXML *temp = new SedRemoveXML();
+	if (isFrozen()) return NULL;
+	SedRemoveXML *temp = new (getArena()) SedRemoveXML();
 	if (temp != NULL) mChange.appendAndOwn(temp);
 	return temp;
 }
@@ -501,7 +532,8 @@ SedModel::createRemoveXML()
 SedChangeAttribute* 
 SedModel::createChangeAttribute()
 {
-	SedChangeAttribute *temp = new SedChangeAttribute();
+	if (isFrozen()) return NULL;
+	SedChangeAttribute *temp = new (getArena()) SedChangeAttribute();
 	if (temp != NULL) mChange.appendAndOwn(temp);
 	return temp;
 }
@@ -517,19 +549,22 @@ SedModel::createChangeAttribute()
 SedComputeChange* 
 SedModel::createComputeChange()
 {
-	SedComputeChange *temp = new SedComputeChange();
+	if (isFrozen()) return NULL;
+	SedComputeChange *temp = new (getArena()) SedComputeChange();
 	if (temp != NULL) mChange.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedModelName("model");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedModel::getElementName () const
 {
-	static const string name = "model";
-	return name;
+	return sSedModelName;
 }
 
 
@@ -543,8 +578,6 @@ SedModel::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
 	if (name == "listOfChanges")
 	{
 		object = &mChange;
@@ -566,6 +599,41 @@ SedModel::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedModel::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mChange);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this Model.
+ */
+unsigned int
+SedModel::getNumChildElements () const
+{
+	return 1;
+}
+
+
+/*
+ * Returns the nth element directly contained in this Model.
+ */
+const SedBase*
+SedModel::getChildElement (unsigned int n) const
+{
+	return (n == 0) ? &mChange : NULL;
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -628,13 +696,12 @@ SedModel::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedModel::accept (SedVisitor& v) const
+SedModel::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -689,10 +756,21 @@ SedModel::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u },
+		{ "language", 0xb9ef387bu },
+		{ "source", 0x1bcf29d8u }
+	};
+	int index[4];
+	findAttributes(attributes, names, 4, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -711,7 +789,7 @@ SedModel::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -726,7 +804,7 @@ SedModel::readAttributes (const XMLAttributes& attributes,
 	//
 	// language string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("language", mLanguage, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[2], "language", mLanguage, false);
 
 	if (assigned == true)
 	{
@@ -741,7 +819,7 @@ SedModel::readAttributes (const XMLAttributes& attributes,
 	//
 	// source string   ( use = "required" )
 	//
-	assigned = attributes.readInto("source", mSource, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[3], "source", mSource, true);
 
 	if (assigned == true)
 	{
@@ -759,6 +837,12 @@ SedModel::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sLanguageAttribute("language");
+static const std::string sSourceAttribute("source");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -769,17 +853,45 @@ SedModel::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		stream.writeAttribute(sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		stream.writeAttribute(sNameAttribute, prefix, mName);
 
 	if (isSetLanguage() == true)
-		stream.writeAttribute("language", getPrefix(), mLanguage);
+		stream.writeAttribute(sLanguageAttribute, prefix, mLanguage);
 
 	if (isSetSource() == true)
-		stream.writeAttribute("source", getPrefix(), mSource);
+		stream.writeAttribute(sSourceAttribute, prefix, mSource);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedModel::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		addAttribute(attributes, sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		addAttribute(attributes, sNameAttribute, prefix, mName);
+
+	if (isSetLanguage() == true)
+		addAttribute(attributes, sLanguageAttribute, prefix, mLanguage);
+
+	if (isSetSource() == true)
+		addAttribute(attributes, sSourceAttribute, prefix, mSource);
 
 }
 
@@ -855,10 +967,7 @@ SedListOfModels::get(const std::string& sid)
 const SedModel*
 SedListOfModels::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedModel>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedModel*> (*result);
+	return static_cast <const SedModel*> (getItemById(sid));
 }
 
 
@@ -883,6 +992,17 @@ SedListOfModels::addModel(const SedModel* sm)
 }
 
 
+/*
+ * Adds the given SedModel to this SedListOfModels, which takes ownership of it.
+ */
+int
+SedListOfModels::addModelAndOwn(SedModel* sm)
+{
+	if(sm == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sm);
+}
+
+
 /**
  * Get the number of SedModel objects in this SedListOfModels.
  *
@@ -905,7 +1025,8 @@ SedListOfModels::getNumModels() const
 SedModel* 
 SedListOfModels::createModel()
 {
-	SedModel *temp = new SedModel();
+	if (isFrozen()) return NULL;
+	SedModel *temp = new (getArena()) SedModel();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -926,19 +1047,11 @@ SedListOfModels::remove(unsigned int n)
 SedModel*
 SedListOfModels::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
+	return static_cast <SedModel*> (removeItemById(sid));
+}
 
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedModel>(sid) );
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
-
-	return static_cast <SedModel*> (item);
-}
+static const std::string sSedListOfModelsName("listOfModels");
 
 
 /*
@@ -947,8 +1060,7 @@ SedListOfModels::remove(const std::string& sid)
 const std::string&
 SedListOfModels::getElementName () const
 {
-	static const string name = "listOfModels";
-	return name;
+	return sSedListOfModelsName;
 }
 
 
@@ -985,7 +1097,7 @@ SedListOfModels::createObject(XMLInputStream& stream)
 
 	if (name == "model")
 	{
-		object = new SedModel(getSedNamespaces());
+		object = new (getArena()) SedModel(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -1010,7 +1122,8 @@ SedListOfModels::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -1078,6 +1191,20 @@ SedModel_getId(SedModel_t * sm)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedModel_getIdView(const SedModel_t * sm)
+{
+	if (sm == NULL)
+		return NULL;
+
+	return sm->getId().empty() ? NULL : sm->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1092,6 +1219,20 @@ SedModel_getName(SedModel_t * sm)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedModel_getNameView(const SedModel_t * sm)
+{
+	if (sm == NULL)
+		return NULL;
+
+	return sm->getName().empty() ? NULL : sm->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1106,6 +1247,20 @@ SedModel_getLanguage(SedModel_t * sm)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedModel_getLanguageView(const SedModel_t * sm)
+{
+	if (sm == NULL)
+		return NULL;
+
+	return sm->getLanguage().empty() ? NULL : sm->getLanguage().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1120,6 +1275,20 @@ SedModel_getSource(SedModel_t * sm)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedModel_getSourceView(const SedModel_t * sm)
+{
+	if (sm == NULL)
+		return NULL;
+
+	return sm->getSource().empty() ? NULL : sm->getSource().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1259,6 +1428,13 @@ SedModel_addChange(SedModel_t * sm, SedChange_t * sc)
 	return  (sm != NULL) ? sm->addChange(sc) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedModel_addChangeAndOwn(SedModel_t * sm, SedChange_t * sc)
+{
+	return  (sm != NULL) ? sm->addChangeAndOwn(sc) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedRemoveXML_t *
 SedModel_createRemoveXML(SedModel_t * sm)
@@ -63,8 +63,8 @@ class LIBSEDML_EXTERN SedModel : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	std::string   mLanguage;
 	std::string   mSource;
 	SedListOfChanges   mChange;
@@ -391,6 +391,25 @@ public:
 	int addChange(const SedChange* sc);
 
 
+	/**
+	 * Adds the given "SedChange" to this SedModel without copying it; this
+	 * SedModel takes ownership of @p sc and will delete it.
+	 *
+	 * @param sc the SedChange object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sc is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addChange(const SedChange* sc)
+	 */
+	int addChangeAndOwn(SedChange* sc);
+
+
 	/**
 	 * Get the number of SedChange objects in this SedModel.
 	 *
@@ -461,6 +480,33 @@ public:
 	SedChange* removeChange(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedModel.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedModel.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedModel, is
 	 * always @c "sedModel".
@@ -545,9 +591,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -619,6 +665,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -733,6 +786,25 @@ public:
 	int addModel(const SedModel* m);
 
 
+	/**
+	 * Adds the given "SedModel" to this SedListOfModels without copying it; this
+	 * SedListOfModels takes ownership of @p m and will delete it.
+	 *
+	 * @param m the SedModel object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p m is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addModel(const SedModel* m)
+	 */
+	int addModelAndOwn(SedModel* m);
+
+
 	/**
 	 * Get the number of Model objects in this SedListOfModels.
 	 *
@@ -915,21 +987,41 @@ char *
 SedModel_getId(SedModel_t * sm);
 
 
+LIBSEDML_EXTERN
+const char *
+SedModel_getIdView(const SedModel_t * sm);
+
+
 LIBSEDML_EXTERN
 char *
 SedModel_getName(SedModel_t * sm);
 
 
+LIBSEDML_EXTERN
+const char *
+SedModel_getNameView(const SedModel_t * sm);
+
+
 LIBSEDML_EXTERN
 char *
 SedModel_getLanguage(SedModel_t * sm);
 
 
+LIBSEDML_EXTERN
+const char *
+SedModel_getLanguageView(const SedModel_t * sm);
+
+
 LIBSEDML_EXTERN
 char *
 SedModel_getSource(SedModel_t * sm);
 
 
+LIBSEDML_EXTERN
+const char *
+SedModel_getSourceView(const SedModel_t * sm);
+
+
 LIBSEDML_EXTERN
 int
 SedModel_isSetId(SedModel_t * sm);
@@ -995,6 +1087,11 @@ int
 SedModel_addChange(SedModel_t * sm, SedChange_t * sc);
 
 
+LIBSEDML_EXTERN
+int
+SedModel_addChangeAndOwn(SedModel_t * sm, SedChange_t * sc);
+
+
 LIBSEDML_EXTERN
 SedRemoveXML_t *
 SedModel_createRemoveXML(SedModel_t * sm);
@@ -0,0 +1,621 @@
+/**
+ * @file    SedModelCache.cpp
+ * @brief   Caches the models of a SedDocument with their changes applied
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedModelCache.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/threads.h>
+
+#include <sbml/math/MathML.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The lock of a SedModelCache, and the condition its threads wait on for
+ * models being prepared by another thread.
+ */
+struct SedModelCacheLock
+{
+  SedMutex     mutex;
+  SedCondition condition;
+};
+
+
+/*
+ * Appends a field to a key; fields are separated by a character that
+ * cannot occur in XML, so no two different lists of fields give one key.
+ */
+static void
+appendField (std::string& key, const std::string& field)
+{
+  key += field;
+  key += '\x1f';
+}
+
+
+/*
+ * Appends a number to a key, exactly.
+ */
+static void
+appendNumber (std::string& key, double value)
+{
+  char number[32];
+  sprintf(number, "%.17g", value);
+  appendField(key, number);
+}
+
+
+/*
+ * A preparer calling C functions, used by SedModelCache_create().
+ */
+class SedCallbackModelPreparer : public SedModelPreparer
+{
+public:
+
+  SedCallbackModelPreparer (SedModelCache_loadSourceFunc loadSource,
+                            SedModelCache_applyChangesFunc applyChanges,
+                            SedModelCache_freeModelFunc freeModel,
+                            void* userData)
+    : mLoadSource (loadSource)
+    , mApplyChanges (applyChanges)
+    , mFreeModel (freeModel)
+    , mUserData (userData)
+  {
+  }
+
+  virtual void* loadSource (const std::string& source,
+                            const std::string& language)
+  {
+    if (mLoadSource == NULL) return NULL;
+    return mLoadSource(source.c_str(), language.c_str(), mUserData);
+  }
+
+  virtual void* applyChanges (const void* model, const SedModel* sedModel)
+  {
+    if (mApplyChanges == NULL) return NULL;
+    return mApplyChanges(model, sedModel, mUserData);
+  }
+
+  virtual void freeModel (void* model)
+  {
+    if (mFreeModel != NULL) mFreeModel(model, mUserData);
+  }
+
+private:
+
+  SedModelCache_loadSourceFunc   mLoadSource;
+  SedModelCache_applyChangesFunc mApplyChanges;
+  SedModelCache_freeModelFunc    mFreeModel;
+  void*                          mUserData;
+};
+
+
+/*
+ * A cache owning its preparer, returned by SedModelCache_create().
+ */
+class SedCallbackModelCache : public SedModelCache
+{
+public:
+
+  SedCallbackModelCache (SedModelCache_loadSourceFunc loadSource,
+                         SedModelCache_applyChangesFunc applyChanges,
+                         SedModelCache_freeModelFunc freeModel,
+                         void* userData)
+    : SedModelCache (mCallbacks)
+    , mCallbacks (loadSource, applyChanges, freeModel, userData)
+  {
+  }
+
+  virtual ~SedCallbackModelCache ()
+  {
+    // the models are released while the preparer still exists
+    clear();
+  }
+
+private:
+
+  SedCallbackModelPreparer mCallbacks;
+};
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedModelPreparer.
+ */
+SedModelPreparer::~SedModelPreparer ()
+{
+}
+
+
+/*
+ * Loads a model from the contents of a file; none by default.
+ */
+void*
+SedModelPreparer::loadContents (const std::string&, const std::string&,
+                                const std::string&)
+{
+  return NULL;
+}
+
+
+/*
+ * Creates a new, empty SedModelCache.
+ */
+SedModelCache::SedModelCache (SedModelPreparer& preparer)
+  : mPreparer (preparer)
+  , mNumHits (0)
+  , mNumMisses (0)
+  , mLock (NULL)
+{
+  SedModelCacheLock* lock = new SedModelCacheLock;
+  mutexInit(&lock->mutex);
+  conditionInit(&lock->condition);
+  mLock = lock;
+}
+
+
+/*
+ * Destroys this SedModelCache.
+ */
+SedModelCache::~SedModelCache ()
+{
+  clear();
+
+  SedModelCacheLock* lock = static_cast<SedModelCacheLock*>(mLock);
+  conditionFree(&lock->condition);
+  mutexFree(&lock->mutex);
+  delete lock;
+}
+
+
+/*
+ * Returns model of document prepared.
+ */
+const void*
+SedModelCache::getModel (const SedDocument* document, const SedModel* model)
+{
+  return getModel(document, model, 0);
+}
+
+
+/*
+ * Returns model of document before its own changes are applied.
+ */
+const void*
+SedModelCache::getBaseModel (const SedDocument* document,
+                             const SedModel* model)
+{
+  if (document == NULL || model == NULL) return NULL;
+  if (getKey(document, model, 0).empty()) return NULL;
+
+  const SedModel* parent = getParent(document, model);
+  if (parent != NULL) return getModel(document, parent, 1);
+
+  return getEntry(getSourceKey(model), document, model, false, 1);
+}
+
+
+/*
+ * Returns the canonical description of model the cache is keyed by.
+ */
+std::string
+SedModelCache::getKey (const SedDocument* document, const SedModel* model)
+{
+  return getKey(document, model, 0);
+}
+
+
+/*
+ * Returns the hash of key (FNV-1a).
+ */
+size_t
+SedModelCache::getHash (const std::string& key)
+{
+  size_t hash = 2166136261u;
+  for (size_t i = 0; i < key.size(); ++i)
+  {
+    hash = (hash ^ (unsigned char)key[i]) * 16777619u;
+  }
+  return hash;
+}
+
+
+/*
+ * Returns the number of models held.
+ */
+unsigned int
+SedModelCache::getNumEntries () const
+{
+  return (unsigned int)mEntries.size();
+}
+
+
+/*
+ * Returns how many times a prepared model was found.
+ */
+unsigned int
+SedModelCache::getNumHits () const
+{
+  return mNumHits;
+}
+
+
+/*
+ * Returns how many models had to be prepared.
+ */
+unsigned int
+SedModelCache::getNumMisses () const
+{
+  return mNumMisses;
+}
+
+
+/*
+ * Releases all models.
+ */
+void
+SedModelCache::clear ()
+{
+  std::multimap<size_t, Entry*>::iterator it;
+  for (it = mEntries.begin(); it != mEntries.end(); ++it)
+  {
+    if (it->second->model != NULL) mPreparer.freeModel(it->second->model);
+    delete it->second;
+  }
+
+  mEntries.clear();
+  mNumHits   = 0;
+  mNumMisses = 0;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Returns model prepared; depth counts the models followed through their
+ * sources so far.
+ */
+const void*
+SedModelCache::getModel (const SedDocument* document, const SedModel* model,
+                         unsigned int depth)
+{
+  if (document == NULL || model == NULL) return NULL;
+
+  const std::string key = getKey(document, model, depth);
+  if (key.empty()) return NULL;
+
+  const SedModel* parent = getParent(document, model);
+
+  // without changes, a model is the model its source names, or the
+  // source as loaded
+  if (model->getNumChanges() == 0)
+  {
+    if (parent != NULL) return getModel(document, parent, depth + 1);
+    return getEntry(key, document, model, false, depth);
+  }
+
+  return getEntry(key, document, model, true, depth);
+}
+
+
+/*
+ * Returns the entry key, preparing it first if there is none.
+ */
+const void*
+SedModelCache::getEntry (const std::string& key, const SedDocument* document,
+                         const SedModel* model, bool applyChanges,
+                         unsigned int depth)
+{
+  SedModelCacheLock* lock = static_cast<SedModelCacheLock*>(mLock);
+  const size_t hash = getHash(key);
+
+  mutexLock(&lock->mutex);
+
+  Entry* entry = NULL;
+  for (;;)
+  {
+    std::multimap<size_t, Entry*>::iterator it = mEntries.find(hash);
+    for (; it != mEntries.end() && it->first == hash; ++it)
+    {
+      if (it->second->key == key)
+      {
+        entry = it->second;
+        break;
+      }
+    }
+
+    if (entry == NULL || entry->ready) break;
+
+    // another thread prepares this model
+    conditionWait(&lock->condition, &lock->mutex);
+    entry = NULL;
+  }
+
+  if (entry != NULL)
+  {
+    ++mNumHits;
+    void* result = entry->model;
+    mutexUnlock(&lock->mutex);
+    return result;
+  }
+
+  entry = new Entry;
+  entry->key   = key;
+  entry->model = NULL;
+  entry->ready = false;
+  mEntries.insert(std::make_pair(hash, entry));
+  ++mNumMisses;
+
+  mutexUnlock(&lock->mutex);
+
+  void* result = NULL;
+  try
+  {
+    if (!applyChanges)
+    {
+      result = mPreparer.loadSource(model->getSource(), model->getLanguage());
+    }
+    else
+    {
+      const SedModel* parent = getParent(document, model);
+      const void* base = NULL;
+
+      if (parent != NULL)
+      {
+        base = getModel(document, parent, depth + 1);
+      }
+      else
+      {
+        base = getEntry(getSourceKey(model), document, model, false,
+                        depth + 1);
+      }
+
+      if (base != NULL) result = mPreparer.applyChanges(base, model);
+    }
+  }
+  catch (...)
+  {
+    // a failing preparer leaves a failed entry, not a waiting one
+    result = NULL;
+  }
+
+  mutexLock(&lock->mutex);
+  entry->model = result;
+  entry->ready = true;
+  conditionBroadcast(&lock->condition);
+  mutexUnlock(&lock->mutex);
+
+  return result;
+}
+
+
+/*
+ * Returns the model of document the source of model names, or NULL.
+ */
+const SedModel*
+SedModelCache::getParent (const SedDocument* document, const SedModel* model)
+{
+  const std::string& source = model->getSource();
+  if (source.empty()) return NULL;
+
+  const SedModel* parent = (source[0] == '#')
+                         ? document->getModel(source.substr(1))
+                         : document->getModel(source);
+
+  return (parent != model) ? parent : NULL;
+}
+
+
+/*
+ * Returns the key of model, or an empty string if the sources of the
+ * models form a cycle.
+ */
+std::string
+SedModelCache::getKey (const SedDocument* document, const SedModel* model,
+                       unsigned int depth)
+{
+  if (document == NULL || model == NULL) return "";
+
+  // a chain of sources longer than the number of models is a cycle
+  if (depth > document->getNumModels()) return "";
+
+  const SedModel* parent = getParent(document, model);
+
+  std::string key;
+  if (parent != NULL)
+  {
+    key = getKey(document, parent, depth + 1);
+    if (key.empty()) return "";
+  }
+  else
+  {
+    key = getSourceKey(model);
+  }
+
+  if (model->getNumChanges() > 0)
+  {
+    key += getChangesKey(model);
+  }
+
+  return key;
+}
+
+
+/*
+ * Returns the key of the source of model, as loaded.
+ */
+std::string
+SedModelCache::getSourceKey (const SedModel* model)
+{
+  std::string key;
+  appendField(key, "source");
+  appendField(key, model->getLanguage());
+  appendField(key, model->getSource());
+  return key;
+}
+
+
+/*
+ * Returns the canonical description of the changes of model.
+ */
+std::string
+SedModelCache::getChangesKey (const SedModel* model)
+{
+  std::string key;
+  appendField(key, "changes");
+
+  for (unsigned int i = 0; i < model->getNumChanges(); ++i)
+  {
+    const SedChange* change = model->getChange(i);
+    const int type = change->getTypeCode();
+
+    appendNumber(key, type);
+    appendField(key, change->getTarget());
+
+    if (type == SEDML_CHANGE_ATTRIBUTE)
+    {
+      appendField(key,
+        static_cast<const SedChangeAttribute*>(change)->getNewValue());
+    }
+    else if (type == SEDML_CHANGE_COMPUTECHANGE)
+    {
+      const SedComputeChange* cc =
+        static_cast<const SedComputeChange*>(change);
+
+      char* math = writeMathMLToString(cc->getMath());
+      appendField(key, (math != NULL) ? math : "");
+      free(math);
+
+      for (unsigned int j = 0; j < cc->getNumVariables(); ++j)
+      {
+        const SedVariable* variable = cc->getVariable(j);
+        appendField(key, variable->getId());
+        appendField(key, variable->getTarget());
+        appendField(key, variable->getSymbol());
+        appendField(key, variable->getTaskReference());
+        appendField(key, variable->getModelReference());
+      }
+
+      for (unsigned int j = 0; j < cc->getNumParameters(); ++j)
+      {
+        const SedParameter* parameter = cc->getParameter(j);
+        appendField(key, parameter->getId());
+        appendNumber(key, parameter->getValue());
+      }
+    }
+  }
+
+  return key;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedModelCache and returns it.
+ */
+LIBSEDML_EXTERN
+SedModelCache_t *
+SedModelCache_create (SedModelCache_loadSourceFunc loadSource,
+                      SedModelCache_applyChangesFunc applyChanges,
+                      SedModelCache_freeModelFunc freeModel,
+                      void *userData)
+{
+  return new (nothrow) SedCallbackModelCache(loadSource, applyChanges,
+                                             freeModel, userData);
+}
+
+
+/**
+ * Frees the given SedModelCache.
+ */
+LIBSEDML_EXTERN
+void
+SedModelCache_free (SedModelCache_t *smc)
+{
+  delete smc;
+}
+
+
+/**
+ * Returns model of document prepared.
+ */
+LIBSEDML_EXTERN
+const void *
+SedModelCache_getModel (SedModelCache_t *smc, const SedDocument_t *document,
+                        const SedModel_t *model)
+{
+  return (smc != NULL) ? smc->getModel(document, model) : NULL;
+}
+
+
+/**
+ * Returns model of document before its own changes are applied.
+ */
+LIBSEDML_EXTERN
+const void *
+SedModelCache_getBaseModel (SedModelCache_t *smc,
+                            const SedDocument_t *document,
+                            const SedModel_t *model)
+{
+  return (smc != NULL) ? smc->getBaseModel(document, model) : NULL;
+}
+
+
+/**
+ * Returns the number of models held by the given SedModelCache.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedModelCache_getNumEntries (const SedModelCache_t *smc)
+{
+  return (smc != NULL) ? smc->getNumEntries() : 0;
+}
+
+
+/**
+ * Releases all models of the given SedModelCache.
+ */
+LIBSEDML_EXTERN
+void
+SedModelCache_clear (SedModelCache_t *smc)
+{
+  if (smc != NULL) smc->clear();
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
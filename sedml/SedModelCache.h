@@ -0,0 +1,346 @@
+/**
+ * @file    SedModelCache.h
+ * @brief   Caches the models of a SedDocument with their changes applied
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedModelCache
+ * @ingroup Core
+ * @brief Prepares every distinct model of an experiment only once.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * libSEDML does not read models itself: a SedModelPreparer loads the
+ * source of a SedModel and applies its SedListOfChanges, returning the
+ * prepared model as an opaque handle, for instance an SBMLDocument.  A
+ * SedModelCache remembers these handles, keyed by the language and source
+ * of the model and a hash of a canonical description of its changes, so
+ * that models and tasks sharing a source and changes share one prepared
+ * model:
+ *
+ * @li a source file is loaded once, however many models use it;
+ * @li a model whose source names another model of the document, as
+ * <code>source="#other"</code> or <code>source="other"</code>, starts from
+ * the cached result of that model and only its own changes are applied;
+ * if it has no changes, it is the cached result of that model;
+ * @li two models with the same source and equal changes, in the same or
+ * in different documents, share one entry.
+ *
+ * The handles remain owned by the cache and are released with
+ * SedModelPreparer::freeModel() by clear() or the destructor; callers
+ * must not change them.  getModel() may be called by several threads at
+ * once, as by the simulators of a SedExecutor: a model being prepared by
+ * one thread is waited for, not prepared again, by the others.  The
+ * preparer is called outside of the cache lock, so it may run on several
+ * threads for different models.
+ */
+
+#ifndef SedModelCache_h
+#define SedModelCache_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedModel;
+
+
+class LIBSEDML_EXTERN SedModelPreparer
+{
+public:
+
+  /**
+   * Destroys this SedModelPreparer.
+   */
+  virtual ~SedModelPreparer ();
+
+
+  /**
+   * Loads the model @p source in @p language.
+   *
+   * @return the model, or @c NULL if it cannot be loaded.
+   */
+  virtual void* loadSource (const std::string& source,
+                            const std::string& language) = 0;
+
+
+  /**
+   * Loads a model in @p language from @p contents, the text of the file
+   * @p source, as was read from a COMBINE archive by a SedArchivePreparer.
+   * The default returns @c NULL: preparers reading models from memory
+   * override it.
+   *
+   * @return the model, or @c NULL if it cannot be loaded.
+   */
+  virtual void* loadContents (const std::string& contents,
+                              const std::string& source,
+                              const std::string& language);
+
+
+  /**
+   * Returns a copy of @p model with the changes of @p sedModel applied;
+   * @p model itself must not be changed.
+   *
+   * @return the changed copy, or @c NULL if a change cannot be applied.
+   */
+  virtual void* applyChanges (const void* model,
+                              const SedModel* sedModel) = 0;
+
+
+  /**
+   * Releases a model returned by loadSource() or applyChanges().
+   */
+  virtual void freeModel (void* model) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedModelCache
+{
+public:
+
+  /**
+   * Creates a new, empty SedModelCache preparing models with
+   * @p preparer, which it does not own.
+   */
+  SedModelCache (SedModelPreparer& preparer);
+
+
+  /**
+   * Destroys this SedModelCache, releasing all models.
+   */
+  virtual ~SedModelCache ();
+
+
+  /**
+   * Returns @p model of @p document prepared, loading its source and
+   * applying its changes only if no equal model has been prepared before.
+   *
+   * @return the prepared model, owned by the cache, or @c NULL if it
+   * could not be prepared or its sources form a cycle.
+   */
+  const void* getModel (const SedDocument* document, const SedModel* model);
+
+
+  /**
+   * Returns @p model of @p document as it is before its own changes are
+   * applied: the model its source names, prepared, or its source as
+   * loaded.  The targets of the changes of @p model select elements of
+   * this model.
+   *
+   * @return the model, owned by the cache, or @c NULL if it could not be
+   * prepared or its sources form a cycle.
+   */
+  const void* getBaseModel (const SedDocument* document,
+                            const SedModel* model);
+
+
+  /**
+   * Returns the canonical description of @p model of @p document the
+   * cache is keyed by: its language and source, or the description of the
+   * model its source names, followed by a description of each change.
+   *
+   * @return the description, or an empty string if the sources of the
+   * models form a cycle.
+   */
+  static std::string getKey (const SedDocument* document,
+                             const SedModel* model);
+
+
+  /**
+   * @return the hash of @p key, as used by the cache.
+   */
+  static size_t getHash (const std::string& key);
+
+
+  /**
+   * @return the number of models held.
+   */
+  unsigned int getNumEntries () const;
+
+
+  /**
+   * @return how many times getModel() or one of the models derived from
+   * it found an entry already prepared (or being prepared).
+   */
+  unsigned int getNumHits () const;
+
+
+  /**
+   * @return how many models had to be prepared.
+   */
+  unsigned int getNumMisses () const;
+
+
+  /**
+   * Releases all models.  No other thread may use the cache meanwhile.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Entry
+  {
+    std::string key;
+    void*       model;
+    bool        ready;
+  };
+
+  const void* getModel (const SedDocument* document, const SedModel* model,
+                        unsigned int depth);
+
+  const void* getEntry (const std::string& key, const SedDocument* document,
+                        const SedModel* model, bool applyChanges,
+                        unsigned int depth);
+
+  static const SedModel* getParent (const SedDocument* document,
+                                    const SedModel* model);
+
+  static std::string getKey (const SedDocument* document,
+                             const SedModel* model, unsigned int depth);
+
+  static std::string getSourceKey (const SedModel* model);
+
+  static std::string getChangesKey (const SedModel* model);
+
+
+  SedModelPreparer&                          mPreparer;
+  std::multimap<size_t, Entry*>              mEntries;
+  unsigned int                               mNumHits;
+  unsigned int                               mNumMisses;
+  void*                                      mLock;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedModelCache (const SedModelCache& orig);
+  SedModelCache& operator= (const SedModelCache& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Function loading the model @p source in @p language for a SedModelCache.
+ */
+typedef void * (*SedModelCache_loadSourceFunc) (const char *source,
+                                                const char *language,
+                                                void *userData);
+
+/**
+ * Function returning a copy of @p model with the changes of @p sedModel
+ * applied, for a SedModelCache.
+ */
+typedef void * (*SedModelCache_applyChangesFunc) (const void *model,
+                                                  const SedModel_t *sedModel,
+                                                  void *userData);
+
+/**
+ * Function releasing a model for a SedModelCache.
+ */
+typedef void (*SedModelCache_freeModelFunc) (void *model, void *userData);
+
+
+/**
+ * Creates a new, empty SedModelCache preparing models with the given
+ * functions and returns it.
+ */
+LIBSEDML_EXTERN
+SedModelCache_t *
+SedModelCache_create (SedModelCache_loadSourceFunc loadSource,
+                      SedModelCache_applyChangesFunc applyChanges,
+                      SedModelCache_freeModelFunc freeModel,
+                      void *userData);
+
+
+/**
+ * Frees the given SedModelCache, releasing all models.
+ */
+LIBSEDML_EXTERN
+void
+SedModelCache_free (SedModelCache_t *smc);
+
+
+/**
+ * Returns @p model of @p document prepared.
+ */
+LIBSEDML_EXTERN
+const void *
+SedModelCache_getModel (SedModelCache_t *smc, const SedDocument_t *document,
+                        const SedModel_t *model);
+
+
+/**
+ * Returns @p model of @p document before its own changes are applied.
+ */
+LIBSEDML_EXTERN
+const void *
+SedModelCache_getBaseModel (SedModelCache_t *smc,
+                            const SedDocument_t *document,
+                            const SedModel_t *model);
+
+
+/**
+ * Returns the number of models held by the given SedModelCache.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedModelCache_getNumEntries (const SedModelCache_t *smc);
+
+
+/**
+ * Releases all models of the given SedModelCache.
+ */
+LIBSEDML_EXTERN
+void
+SedModelCache_clear (SedModelCache_t *smc);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedModelCache_h */
@@ -34,6 +34,7 @@
 #include <sbml/util/List.h>
 #include <sedml/SedNamespaces.h>
 #include <sedml/SedConstructorException.h>
+#include <sedml/common/threads.h>
 
 /** @cond doxygen-ignored */
 
@@ -77,6 +78,7 @@ SedNamespaces::initSedNamespace()
 SedNamespaces::SedNamespaces(unsigned int level, unsigned int version)
  : mLevel(level)
   ,mVersion(version)
+  ,mRefCount(1)
 {
   initSedNamespace();
 }
@@ -92,6 +94,7 @@ SedNamespaces::~SedNamespaces()
  * Copy constructor; creates a copy of a SedNamespaces.
  */
 SedNamespaces::SedNamespaces(const SedNamespaces& orig)
+ : mRefCount(1)
 {
   if (&orig == NULL)
   {
@@ -377,6 +380,78 @@ SedNamespaces::setNamespaces(XMLNamespaces * xmlns)
   else
     mNamespaces = NULL;
 }
+
+
+/*
+ * The counts of shared SedNamespaces objects are guarded by one of a few
+ * mutexes, picked by address, so that copies of one document can be
+ * destroyed on different threads.  They are set up before main() runs.
+ */
+static const unsigned int NUM_REF_COUNT_LOCKS = 16;
+
+struct SedRefCountLocks
+{
+  SedMutex mutex[NUM_REF_COUNT_LOCKS];
+
+  SedRefCountLocks ()
+  {
+    for (unsigned int i = 0; i < NUM_REF_COUNT_LOCKS; ++i)
+      mutexInit(&mutex[i]);
+  }
+
+  ~SedRefCountLocks ()
+  {
+    for (unsigned int i = 0; i < NUM_REF_COUNT_LOCKS; ++i)
+      mutexFree(&mutex[i]);
+  }
+};
+
+static SedRefCountLocks sRefCountLocks;
+
+
+static SedMutex*
+getRefCountLock (const SedNamespaces* sn)
+{
+  const size_t address = (size_t)sn;
+  return &sRefCountLocks.mutex[(address / sizeof(void*)) % NUM_REF_COUNT_LOCKS];
+}
+
+
+void
+SedNamespaces::retain()
+{
+  SedMutex* lock = getRefCountLock(this);
+  mutexLock(lock);
+  ++mRefCount;
+  mutexUnlock(lock);
+}
+
+
+void
+SedNamespaces::release()
+{
+  SedMutex* lock = getRefCountLock(this);
+  mutexLock(lock);
+  const bool last = (--mRefCount == 0);
+  mutexUnlock(lock);
+
+  if (last)
+  {
+    delete this;
+  }
+}
+
+
+bool
+SedNamespaces::isShared() const
+{
+  SedMutex* lock = getRefCountLock(this);
+  mutexLock(lock);
+  const bool shared = (mRefCount > 1);
+  mutexUnlock(lock);
+
+  return shared;
+}
 /** @endcond */
 
 /** @cond doxygen-c-only */
@@ -449,6 +449,21 @@ else
 
 
   void setNamespaces(XMLNamespaces * xmlns);
+
+
+  /*
+   * SedNamespaces objects may be shared by several Sed objects; these
+   * count the owners.  A new object has one owner; release() deletes the
+   * object when the last owner lets go of it.  The count is guarded by a
+   * mutex, so the owners may be destroyed on different threads.
+   */
+  void retain();
+
+
+  void release();
+
+
+  bool isShared() const;
   /** @endcond */
 
 	
@@ -460,6 +475,7 @@ protected:
   unsigned int    mLevel;
   unsigned int    mVersion;
   XMLNamespaces * mNamespaces;
+  unsigned int    mRefCount;
 
   /** @endcond */
 };
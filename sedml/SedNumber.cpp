@@ -0,0 +1,416 @@
+/**
+ * @file    SedNumber.cpp
+ * @brief   Exact, locale independent conversion of numeric attributes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedNumber.h>
+
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The powers of ten a double holds exactly.
+ */
+static const double sPowersOfTen[] =
+{
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const int sMaxExactPower  = 22;
+
+/*
+ * The digits below 2^53, so that their mantissa is exact.
+ */
+static const int sMaxExactDigits = 15;
+
+
+/*
+ * Returns the decimal point of the current locale if it is not ".", or
+ * NULL.
+ */
+static const char*
+getLocalePoint ()
+{
+  const char* point = localeconv()->decimal_point;
+  if (point == NULL || (point[0] == '.' && point[1] == '\0')) return NULL;
+  return point;
+}
+
+
+/*
+ * Reads text with strtod() in the current locale, whatever its decimal
+ * point is.
+ */
+static bool
+parseWithStrtod (const std::string& text, double& value)
+{
+  std::string localized;
+  const char* point = getLocalePoint();
+  if (point != NULL)
+  {
+    localized.reserve(text.size() + 4);
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+      if (text[i] == '.')
+        localized += point;
+      else
+        localized += text[i];
+    }
+  }
+  const std::string& input = (point != NULL) ? localized : text;
+
+  char* end = NULL;
+  errno = 0;
+  const double result = strtod(input.c_str(), &end);
+  if (end != input.c_str() + input.size()) return false;
+
+  // strtod() reports a range error for subnormal results too, which are
+  // kept; only overflow and underflow to zero are out of range, parse()
+  // having already read a zero mantissa itself
+  if (errno == ERANGE &&
+      (result == 0 || result == HUGE_VAL || result == -HUGE_VAL))
+  {
+    return false;
+  }
+
+  value = result;
+  return true;
+}
+
+/** @endcond */
+
+
+/*
+ * Writes the shortest text reading back as value.
+ */
+unsigned int
+SedNumber::format (double value, char* buffer)
+{
+  if (value != value)
+  {
+    strcpy(buffer, "NaN");
+    return 3;
+  }
+  if (value > 0 && value - value != 0)
+  {
+    strcpy(buffer, "INF");
+    return 3;
+  }
+  if (value < 0 && value - value != 0)
+  {
+    strcpy(buffer, "-INF");
+    return 4;
+  }
+
+  int length = 0;
+  for (int precision = 15; precision <= 17; ++precision)
+  {
+    // the text is read back in the locale it was written in
+    length = sprintf(buffer, "%.*g", precision, value);
+    if (precision == 17 || strtod(buffer, NULL) == value) break;
+  }
+
+  const char* point = getLocalePoint();
+  if (point != NULL)
+  {
+    char* found = strstr(buffer, point);
+    if (found != NULL)
+    {
+      const size_t size = strlen(point);
+      *found = '.';
+      memmove(found + 1, found + size, strlen(found + size) + 1);
+      length -= (int)size - 1;
+    }
+  }
+
+  return (unsigned int)length;
+}
+
+
+/*
+ * Writes value in decimal.
+ */
+unsigned int
+SedNumber::format (int value, char* buffer)
+{
+  if (value >= 0) return format((unsigned int)value, buffer);
+
+  // negated as unsigned, so that INT_MIN is written too
+  buffer[0] = '-';
+  return 1 + format(0u - (unsigned int)value, buffer + 1);
+}
+
+
+/*
+ * Writes value in decimal.
+ */
+unsigned int
+SedNumber::format (unsigned int value, char* buffer)
+{
+  char digits[BUFFER_SIZE];
+  unsigned int length = 0;
+  do
+  {
+    digits[length++] = (char)('0' + value % 10);
+    value /= 10;
+  }
+  while (value != 0);
+
+  for (unsigned int i = 0; i < length; ++i)
+  {
+    buffer[i] = digits[length - 1 - i];
+  }
+  buffer[length] = '\0';
+
+  return length;
+}
+
+
+/*
+ * Returns value as format() writes it.
+ */
+std::string
+SedNumber::toString (double value)
+{
+  char buffer[BUFFER_SIZE];
+  return std::string(buffer, format(value, buffer));
+}
+
+
+/*
+ * Returns value as format() writes it.
+ */
+std::string
+SedNumber::toString (int value)
+{
+  char buffer[BUFFER_SIZE];
+  return std::string(buffer, format(value, buffer));
+}
+
+
+/*
+ * Returns value as format() writes it.
+ */
+std::string
+SedNumber::toString (unsigned int value)
+{
+  char buffer[BUFFER_SIZE];
+  return std::string(buffer, format(value, buffer));
+}
+
+
+/*
+ * Reads the plain number text.
+ */
+bool
+SedNumber::parse (const std::string& text, double& value)
+{
+  const char* p   = text.c_str();
+  const char* end = p + text.size();
+
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p++ == '-');
+  }
+
+  // the significant digits, the power of ten they are scaled by, and
+  // whether the digits dropped are all zeros
+  double mantissa  = 0;
+  int    numDigits = 0;
+  int    power     = 0;
+  bool   exact     = true;
+  bool   anyDigits = false;
+
+  for (; p < end && *p >= '0' && *p <= '9'; ++p)
+  {
+    anyDigits = true;
+    if (numDigits < sMaxExactDigits)
+    {
+      if (numDigits > 0 || *p != '0')
+      {
+        mantissa = mantissa * 10 + (*p - '0');
+        ++numDigits;
+      }
+    }
+    else
+    {
+      if (*p != '0') exact = false;
+      ++power;
+    }
+  }
+
+  if (p < end && *p == '.')
+  {
+    for (++p; p < end && *p >= '0' && *p <= '9'; ++p)
+    {
+      anyDigits = true;
+      if (numDigits < sMaxExactDigits)
+      {
+        if (numDigits > 0 || *p != '0')
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+          ++numDigits;
+        }
+        --power;
+      }
+      else if (*p != '0')
+      {
+        exact = false;
+      }
+    }
+  }
+
+  if (!anyDigits) return false;
+
+  if (p < end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+      negativeExponent = (*p++ == '-');
+    }
+
+    if (p == end || *p < '0' || *p > '9') return false;
+
+    int exponent = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+    {
+      // beyond any double either way; strtod() gives the range error
+      if (exponent < 100000) exponent = exponent * 10 + (*p - '0');
+    }
+    power += negativeExponent ? -exponent : exponent;
+  }
+
+  if (p != end) return false;
+
+  if (mantissa == 0)
+  {
+    value = negative ? -0.0 : 0.0;
+    return true;
+  }
+
+  // the mantissa and the power of ten are exact, so the one division or
+  // multiplication is correctly rounded
+  if (exact && power >= -sMaxExactPower && power <= sMaxExactPower)
+  {
+    const double result = (power < 0) ? mantissa / sPowersOfTen[-power]
+                                      : mantissa * sPowersOfTen[power];
+    value = negative ? -result : result;
+    return true;
+  }
+
+  return parseWithStrtod(text, value);
+}
+
+
+/*
+ * Reads the decimal integer text.
+ */
+bool
+SedNumber::parse (const std::string& text, int& value)
+{
+  if (text.empty()) return false;
+
+  const bool negative = (text[0] == '-');
+  const size_t start  = (text[0] == '-' || text[0] == '+') ? 1 : 0;
+
+  unsigned int magnitude = 0;
+  if (!parse(text.substr(start), magnitude)) return false;
+
+  if (negative)
+  {
+    if (magnitude > (unsigned int)INT_MAX + 1u) return false;
+    value = (magnitude == (unsigned int)INT_MAX + 1u)
+          ? INT_MIN : -(int)magnitude;
+  }
+  else
+  {
+    if (magnitude > (unsigned int)INT_MAX) return false;
+    value = (int)magnitude;
+  }
+
+  return true;
+}
+
+
+/*
+ * Reads the unsigned decimal integer text.
+ */
+bool
+SedNumber::parse (const std::string& text, unsigned int& value)
+{
+  if (text.empty()) return false;
+
+  unsigned int result = 0;
+  for (size_t i = 0; i < text.size(); ++i)
+  {
+    const char c = text[i];
+    if (c < '0' || c > '9') return false;
+
+    const unsigned int digit = (unsigned int)(c - '0');
+    if (result > (UINT_MAX - digit) / 10) return false;
+    result = result * 10 + digit;
+  }
+
+  value = result;
+  return true;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedNumber_formatDouble (double value, char *buffer)
+{
+  if (buffer == NULL) return 0;
+
+  return SedNumber::format(value, buffer);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedNumber_parseDouble (const char *text, double *value)
+{
+  if (text == NULL || value == NULL) return 0;
+
+  return SedNumber::parse(std::string(text), *value) ? 1 : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
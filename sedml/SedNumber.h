@@ -0,0 +1,169 @@
+/**
+ * @file    SedNumber.h
+ * @brief   Exact, locale independent conversion of numeric attributes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedNumber
+ * @ingroup Core
+ * @brief Converts numbers to and from the text of XML attributes.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The numeric attributes of SED-ML elements are read and written with
+ * SedNumber rather than with the stream conversions of libSBML, which
+ * depend on the locale of the process and write doubles with 15 digits.
+ * SedNumber always uses a '.' as decimal point, and writes every double
+ * with the fewest of 15, 16 or 17 significant digits that read back as
+ * exactly the same double, so that documents round-trip bit for bit.
+ *
+ * parse() accepts plain numbers only: an optional sign, digits with an
+ * optional fraction and an optional exponent, with no surrounding space.
+ * Numbers of up to 15 significant digits whose power of ten is within
+ * the range powers of ten are exact in are converted directly, which is
+ * correctly rounded; all others are left to strtod().  Text that is not a
+ * plain number, such as "INF" or "NaN", and numbers that overflow or
+ * underflow to zero are rejected, so that callers can hand them to the
+ * libSBML conversions and their error reporting; subnormal numbers are
+ * read like any other.
+ */
+
+#ifndef SedNumber_h
+#define SedNumber_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedNumber
+{
+public:
+
+  /**
+   * The size of a buffer format() can always write to.
+   */
+  static const unsigned int BUFFER_SIZE = 32;
+
+
+  /**
+   * Writes the shortest text reading back as @p value to @p buffer, of at
+   * least BUFFER_SIZE characters, as "INF", "-INF" and "NaN" for the
+   * values that are not finite.
+   *
+   * @return the number of characters written, not counting the
+   * terminating NUL.
+   */
+  static unsigned int format (double value, char* buffer);
+
+
+  /**
+   * Writes @p value in decimal to @p buffer, of at least BUFFER_SIZE
+   * characters.
+   *
+   * @return the number of characters written, not counting the
+   * terminating NUL.
+   */
+  static unsigned int format (int value, char* buffer);
+
+  static unsigned int format (unsigned int value, char* buffer);
+
+
+  /**
+   * @return @p value as format() writes it.
+   */
+  static std::string toString (double value);
+
+  static std::string toString (int value);
+
+  static std::string toString (unsigned int value);
+
+
+  /**
+   * Reads the plain number @p text into @p value.
+   *
+   * @return @c true on success, @c false if @p text is not a plain number
+   * or out of range, in which case @p value is unchanged.
+   */
+  static bool parse (const std::string& text, double& value);
+
+
+  /**
+   * Reads the decimal integer @p text, with an optional sign, into
+   * @p value.
+   *
+   * @return @c true on success, @c false if @p text is not an integer or
+   * out of range, in which case @p value is unchanged.
+   */
+  static bool parse (const std::string& text, int& value);
+
+
+  /**
+   * Reads the decimal integer @p text, with no sign, into @p value.
+   *
+   * @return @c true on success, @c false if @p text is not an unsigned
+   * integer or out of range, in which case @p value is unchanged.
+   */
+  static bool parse (const std::string& text, unsigned int& value);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Writes the shortest text reading back as @p value to @p buffer, of at
+ * least 32 characters, and returns its length.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedNumber_formatDouble (double value, char *buffer);
+
+
+/**
+ * Reads the plain number @p text into @p value.
+ *
+ * @return 1 on success, 0 if @p text is not a plain number or out of
+ * range.
+ */
+LIBSEDML_EXTERN
+int
+SedNumber_parseDouble (const char *text, double *value);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedNumber_h */
@@ -0,0 +1,188 @@
+/**
+ * @file    SedOptionalString.cpp
+ * @brief   Storage for optional string attributes that are rarely set
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedOptionalString.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The value of empty strings, which is never freed: objects destroyed at
+ * exit, after it would have been, may still be read.
+ */
+static const std::string* sEmpty = NULL;
+
+
+static const std::string*
+getEmpty ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sEmpty == NULL) sEmpty = new std::string();
+  return sEmpty;
+}
+
+
+/*
+ * Creates the empty value before main() rather than on first use, when
+ * several threads could be creating it at once.
+ */
+static const std::string* const sEmptyCreated = getEmpty();
+
+/** @endcond */
+
+
+/*
+ * Creates an empty SedOptionalString.
+ */
+SedOptionalString::SedOptionalString ()
+  : mValue (NULL)
+{
+}
+
+
+/*
+ * Creates a SedOptionalString holding value.
+ */
+SedOptionalString::SedOptionalString (const char* value)
+  : mValue ((value != NULL && *value != '\0') ? new std::string(value) : NULL)
+{
+}
+
+
+/*
+ * Creates a SedOptionalString holding value.
+ */
+SedOptionalString::SedOptionalString (const std::string& value)
+  : mValue (value.empty() ? NULL : new std::string(value))
+{
+}
+
+
+/*
+ * Copy constructor.
+ */
+SedOptionalString::SedOptionalString (const SedOptionalString& orig)
+  : mValue ((orig.mValue != NULL) ? new std::string(*orig.mValue) : NULL)
+{
+}
+
+
+/*
+ * Destroys this SedOptionalString.
+ */
+SedOptionalString::~SedOptionalString ()
+{
+  delete mValue;
+}
+
+
+/*
+ * Assignment operator.
+ */
+SedOptionalString&
+SedOptionalString::operator= (const SedOptionalString& rhs)
+{
+  if (&rhs != this) *this = rhs.str();
+  return *this;
+}
+
+
+/*
+ * Assigns value.
+ */
+SedOptionalString&
+SedOptionalString::operator= (const std::string& value)
+{
+  if (value.empty())
+  {
+    erase();
+  }
+  else if (mValue != NULL)
+  {
+    // the string held reuses its buffer
+    *mValue = value;
+  }
+  else
+  {
+    mValue = new std::string(value);
+  }
+
+  return *this;
+}
+
+
+/*
+ * Exchanges the value with value.
+ */
+void
+SedOptionalString::swap (std::string& value)
+{
+  if (mValue == NULL)
+  {
+    if (value.empty()) return;
+    mValue = new std::string();
+  }
+
+  mValue->swap(value);
+  if (mValue->empty()) erase();
+}
+
+
+/*
+ * Returns true if the value is empty.
+ */
+bool
+SedOptionalString::empty () const
+{
+  return mValue == NULL;
+}
+
+
+/*
+ * Empties the value.
+ */
+void
+SedOptionalString::erase ()
+{
+  delete mValue;
+  mValue = NULL;
+}
+
+
+/*
+ * Returns the value.
+ */
+const std::string&
+SedOptionalString::str () const
+{
+  return (mValue != NULL) ? *mValue : *getEmpty();
+}
+
+
+/*
+ * Returns the value.
+ */
+SedOptionalString::operator const std::string& () const
+{
+  return str();
+}
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,127 @@
+/**
+ * @file    SedOptionalString.h
+ * @brief   Storage for optional string attributes that are rarely set
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedOptionalString
+ * @ingroup Core
+ * @brief A string that takes the room of a pointer while it is empty.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The generated classes keep their optional "name" attribute, which most
+ * elements of large documents do not have, in a SedOptionalString rather
+ * than a std::string: an empty value is a @c NULL pointer, and only a
+ * value that is set holds a string of its own on the heap.  It converts to
+ * <code>const std::string&</code>, so that the accessors return it as
+ * before.
+ */
+
+#ifndef SedOptionalString_h
+#define SedOptionalString_h
+
+
+#include <sedml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedOptionalString
+{
+public:
+
+  /**
+   * Creates an empty SedOptionalString.
+   */
+  SedOptionalString ();
+
+
+  /**
+   * Creates a SedOptionalString holding @p value.
+   */
+  SedOptionalString (const char* value);
+
+  SedOptionalString (const std::string& value);
+
+
+  /**
+   * Copy constructor; the copy holds a string of its own.
+   */
+  SedOptionalString (const SedOptionalString& orig);
+
+
+  /**
+   * Destroys this SedOptionalString.
+   */
+  ~SedOptionalString ();
+
+
+  /**
+   * Assignment operators.
+   */
+  SedOptionalString& operator= (const SedOptionalString& rhs);
+
+  SedOptionalString& operator= (const std::string& value);
+
+
+  /**
+   * Exchanges the value with @p value, so that a string read elsewhere is
+   * taken over without copying its characters.
+   */
+  void swap (std::string& value);
+
+
+  /**
+   * @return @c true if the value is empty.
+   */
+  bool empty () const;
+
+
+  /**
+   * Empties the value, giving its string back to the heap.
+   */
+  void erase ();
+
+
+  /**
+   * @return the value, an empty string shared by all empty values if it
+   * is empty.
+   */
+  const std::string& str () const;
+
+  operator const std::string& () const;
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  std::string* mValue;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedOptionalString_h */
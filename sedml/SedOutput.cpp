@@ -186,7 +186,11 @@ SedOutput::isSetName() const
 int
 SedOutput::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -196,6 +200,8 @@ SedOutput::setId(const std::string& id)
 int
 SedOutput::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -214,7 +220,10 @@ SedOutput::setName(const std::string& name)
 int
 SedOutput::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -233,6 +242,8 @@ SedOutput::unsetId()
 int
 SedOutput::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -246,14 +257,16 @@ SedOutput::unsetName()
 }
 
 
+static const std::string sSedOutputName("output");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedOutput::getElementName () const
 {
-	static const string name = "output";
-	return name;
+	return sSedOutputName;
 }
 
 
@@ -267,8 +280,6 @@ SedOutput::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
 	return object;
 }
 
@@ -339,13 +350,12 @@ SedOutput::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedOutput::accept (SedVisitor& v) const
+SedOutput::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -398,10 +408,19 @@ SedOutput::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u }
+	};
+	int index[2];
+	findAttributes(attributes, names, 2, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -420,7 +439,7 @@ SedOutput::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -438,6 +457,10 @@ SedOutput::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -448,11 +471,33 @@ SedOutput::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		stream.writeAttribute(sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		stream.writeAttribute(sNameAttribute, prefix, mName);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedOutput::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		addAttribute(attributes, sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		addAttribute(attributes, sNameAttribute, prefix, mName);
 
 }
 
@@ -528,10 +573,7 @@ SedListOfOutputs::get(const std::string& sid)
 const SedOutput*
 SedListOfOutputs::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedOutput>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedOutput*> (*result);
+	return static_cast <const SedOutput*> (getItemById(sid));
 }
 
 
@@ -556,6 +598,17 @@ SedListOfOutputs::addOutput(const SedOutput* so)
 }
 
 
+/*
+ * Adds the given SedOutput to this SedListOfOutputs, which takes ownership of it.
+ */
+int
+SedListOfOutputs::addOutputAndOwn(SedOutput* so)
+{
+	if(so == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(so);
+}
+
+
 /**
  * Get the number of SedOutput objects in this SedListOfOutputs.
  *
@@ -578,7 +631,8 @@ SedListOfOutputs::getNumOutputs() const
 SedReport* 
 SedListOfOutputs::createReport()
 {
-	SedReport *temp = new SedReport();
+	if (isFrozen()) return NULL;
+	SedReport *temp = new (getArena()) SedReport();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -594,7 +648,8 @@ SedListOfOutputs::createReport()
 SedPlot2D* 
 SedListOfOutputs::createPlot2D()
 {
-	SedPlot2D *temp = new SedPlot2D();
+	if (isFrozen()) return NULL;
+	SedPlot2D *temp = new (getArena()) SedPlot2D();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -610,7 +665,8 @@ SedListOfOutputs::createPlot2D()
 SedPlot3D* 
 SedListOfOutputs::createPlot3D()
 {
-	SedPlot3D *temp = new SedPlot3D();
+	if (isFrozen()) return NULL;
+	SedPlot3D *temp = new (getArena()) SedPlot3D();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -631,19 +687,11 @@ SedListOfOutputs::remove(unsigned int n)
 SedOutput*
 SedListOfOutputs::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedOutput>(sid) );
+	return static_cast <SedOutput*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedOutput*> (item);
-}
+static const std::string sSedListOfOutputsName("listOfOutputs");
 
 
 /*
@@ -652,8 +700,7 @@ SedListOfOutputs::remove(const std::string& sid)
 const std::string&
 SedListOfOutputs::getElementName () const
 {
-	static const string name = "listOfOutputs";
-	return name;
+	return sSedListOfOutputsName;
 }
 
 
@@ -688,22 +735,31 @@ SedListOfOutputs::createObject(XMLInputStream& stream)
 	const std::string& name   = stream.peek().getName();
 	SedBase* object = NULL;
 
-	if (name == "report")
+	switch (getElementNameHash(name))
 	{
-		object = new SedReport(getSedNamespaces());
-		appendAndOwn(object);
-	}
+	case 0x19bb34ebu:
+		if (name == "report")
+		{
+			object = new (getArena()) SedReport(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 
-	if (name == "plot2D")
-	{
-		object = new SedPlot2D(getSedNamespaces());
-		appendAndOwn(object);
-	}
+	case 0xebdf7c1cu:
+		if (name == "plot2D")
+		{
+			object = new (getArena()) SedPlot2D(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 
-	if (name == "plot3D")
-	{
-		object = new SedPlot3D(getSedNamespaces());
-		appendAndOwn(object);
+	case 0x91e12d05u:
+		if (name == "plot3D")
+		{
+			object = new (getArena()) SedPlot3D(getSedNamespaces());
+			appendAndOwn(object);
+		}
+		break;
 	}
 
 	return object;
@@ -727,7 +783,8 @@ SedListOfOutputs::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -795,6 +852,20 @@ SedOutput_getId(SedOutput_t * so)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedOutput_getIdView(const SedOutput_t * so)
+{
+	if (so == NULL)
+		return NULL;
+
+	return so->getId().empty() ? NULL : so->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -809,6 +880,20 @@ SedOutput_getName(SedOutput_t * so)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedOutput_getNameView(const SedOutput_t * so)
+{
+	if (so == NULL)
+		return NULL;
+
+	return so->getName().empty() ? NULL : so->getName().c_str();
+}
+
+
 /**
  * write comments
  */
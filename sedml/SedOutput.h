@@ -62,8 +62,8 @@ class LIBSEDML_EXTERN SedOutput : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 
 
 public:
@@ -295,9 +295,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -369,6 +369,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -483,6 +490,25 @@ public:
 	int addOutput(const SedOutput* o);
 
 
+	/**
+	 * Adds the given "SedOutput" to this SedListOfOutputs without copying it; this
+	 * SedListOfOutputs takes ownership of @p o and will delete it.
+	 *
+	 * @param o the SedOutput object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p o is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addOutput(const SedOutput* o)
+	 */
+	int addOutputAndOwn(SedOutput* o);
+
+
 	/**
 	 * Get the number of Output objects in this SedListOfOutputs.
 	 *
@@ -687,11 +713,21 @@ char *
 SedOutput_getId(SedOutput_t * so);
 
 
+LIBSEDML_EXTERN
+const char *
+SedOutput_getIdView(const SedOutput_t * so);
+
+
 LIBSEDML_EXTERN
 char *
 SedOutput_getName(SedOutput_t * so);
 
 
+LIBSEDML_EXTERN
+const char *
+SedOutput_getNameView(const SedOutput_t * so);
+
+
 LIBSEDML_EXTERN
 int
 SedOutput_isSetId(SedOutput_t * so);
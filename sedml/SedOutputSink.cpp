@@ -0,0 +1,461 @@
+/**
+ * @file    SedOutputSink.cpp
+ * @brief   Destinations for the output of SedWriter, written in chunks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedOutputSink.h>
+
+#include <new>
+
+#ifdef USE_ZLIB
+#  include <zlib.h>
+#endif
+
+#ifdef USE_ZSTD
+#  include <zstd.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Size of the buffer the compressing sinks deflate into.
+ */
+static const size_t SED_SINK_OUT_SIZE = 16 * 1024;
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedOutputSink.
+ */
+SedOutputSink::~SedOutputSink ()
+{
+}
+
+
+/*
+ * Called after the last write() of a document.
+ */
+bool
+SedOutputSink::finish ()
+{
+  return true;
+}
+
+
+/*
+ * Creates a new SedCallbackSink.
+ */
+SedCallbackSink::SedCallbackSink (SedOutputSink_writeFunc func,
+                                  void* userData)
+  : mFunc (func)
+  , mUserData (userData)
+{
+}
+
+
+/*
+ * Passes the chunk to the function of this sink.
+ */
+bool
+SedCallbackSink::write (const char* data, size_t length)
+{
+  if (mFunc == NULL) return false;
+  return mFunc(data, length, mUserData) != 0;
+}
+
+
+/*
+ * Creates a new SedFileSink writing to filename.
+ */
+SedFileSink::SedFileSink (const std::string& filename, bool append)
+  : mFile (fopen(filename.c_str(), append ? "ab" : "wb"))
+{
+}
+
+
+/*
+ * Closes the file of this SedFileSink.
+ */
+SedFileSink::~SedFileSink ()
+{
+  if (mFile != NULL) fclose(mFile);
+}
+
+
+/*
+ * Returns true if the file could be opened.
+ */
+bool
+SedFileSink::isOpen () const
+{
+  return (mFile != NULL);
+}
+
+
+/*
+ * Writes the chunk to the file.
+ */
+bool
+SedFileSink::write (const char* data, size_t length)
+{
+  if (mFile == NULL) return false;
+  return fwrite(data, 1, length, mFile) == length;
+}
+
+
+/*
+ * Hands what has been written so far to the operating system.
+ */
+bool
+SedFileSink::flush ()
+{
+  if (mFile == NULL) return false;
+  return fflush(mFile) == 0;
+}
+
+
+/*
+ * Flushes and closes the file.
+ */
+bool
+SedFileSink::finish ()
+{
+  if (mFile == NULL) return false;
+
+  bool result = (fclose(mFile) == 0);
+  mFile = NULL;
+  return result;
+}
+
+
+/*
+ * Creates a new SedGzipSink.
+ */
+SedGzipSink::SedGzipSink (SedOutputSink& next, int level)
+  : mNext (next)
+  , mStream (NULL)
+  , mOut (SED_SINK_OUT_SIZE)
+{
+#ifdef USE_ZLIB
+  z_stream* zs = new (nothrow) z_stream;
+  if (zs == NULL) return;
+
+  zs->zalloc = Z_NULL;
+  zs->zfree  = Z_NULL;
+  zs->opaque = Z_NULL;
+
+  // a window of 15 + 16 asks zlib for a gzip header and trailer
+  if (deflateInit2(zs, level, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+  {
+    delete zs;
+    return;
+  }
+
+  mStream = zs;
+#else
+  (void)level;
+#endif
+}
+
+
+/*
+ * Destroys this SedGzipSink.
+ */
+SedGzipSink::~SedGzipSink ()
+{
+#ifdef USE_ZLIB
+  z_stream* zs = static_cast<z_stream*>(mStream);
+  if (zs != NULL)
+  {
+    deflateEnd(zs);
+    delete zs;
+  }
+#endif
+}
+
+
+/*
+ * Returns true if libSEDML was built with zlib.
+ */
+bool
+SedGzipSink::isAvailable ()
+{
+#ifdef USE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Compresses the chunk.
+ */
+bool
+SedGzipSink::write (const char* data, size_t length)
+{
+  return deflateInto(data, length, false);
+}
+
+
+/*
+ * Ends the gzip stream and finishes the next sink.
+ */
+bool
+SedGzipSink::finish ()
+{
+  bool result = deflateInto(NULL, 0, true);
+  return mNext.finish() && result;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Runs data through deflate, passing every full output buffer on.
+ */
+bool
+SedGzipSink::deflateInto (const char* data, size_t length, bool last)
+{
+#ifdef USE_ZLIB
+  z_stream* zs = static_cast<z_stream*>(mStream);
+  if (zs == NULL) return false;
+
+  // avail_in is a uInt, so very large chunks are fed in pieces
+  do
+  {
+    uInt piece = (length > 0x40000000) ? 0x40000000 : (uInt)length;
+    zs->next_in  = (Bytef*)data;
+    zs->avail_in = piece;
+    data   += piece;
+    length -= piece;
+
+    const int flush = (last && length == 0) ? Z_FINISH : Z_NO_FLUSH;
+    int status = Z_OK;
+
+    do
+    {
+      zs->next_out  = (Bytef*)&mOut[0];
+      zs->avail_out = (uInt)mOut.size();
+
+      status = deflate(zs, flush);
+      if (status == Z_STREAM_ERROR) return false;
+
+      size_t have = mOut.size() - zs->avail_out;
+      if (have > 0 && !mNext.write(&mOut[0], have)) return false;
+    }
+    while (zs->avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+  }
+  while (length > 0);
+
+  return true;
+#else
+  (void)data; (void)length; (void)last;
+  return false;
+#endif
+}
+/** @endcond */
+
+
+/*
+ * Creates a new SedZstdSink.
+ */
+SedZstdSink::SedZstdSink (SedOutputSink& next, int level)
+  : mNext (next)
+  , mContext (NULL)
+  , mOut (SED_SINK_OUT_SIZE)
+{
+#ifdef USE_ZSTD
+  ZSTD_CCtx* cctx = ZSTD_createCCtx();
+  if (cctx == NULL) return;
+
+  if (level != 0)
+  {
+    ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, level);
+  }
+
+  mContext = cctx;
+#else
+  (void)level;
+#endif
+}
+
+
+/*
+ * Destroys this SedZstdSink.
+ */
+SedZstdSink::~SedZstdSink ()
+{
+#ifdef USE_ZSTD
+  if (mContext != NULL) ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(mContext));
+#endif
+}
+
+
+/*
+ * Returns true if libSEDML was built with zstd.
+ */
+bool
+SedZstdSink::isAvailable ()
+{
+#ifdef USE_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Compresses the chunk.
+ */
+bool
+SedZstdSink::write (const char* data, size_t length)
+{
+  return compressInto(data, length, false);
+}
+
+
+/*
+ * Ends the zstd frame and finishes the next sink.
+ */
+bool
+SedZstdSink::finish ()
+{
+  bool result = compressInto(NULL, 0, true);
+  return mNext.finish() && result;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Runs data through the compressor, passing every full output buffer on.
+ */
+bool
+SedZstdSink::compressInto (const char* data, size_t length, bool last)
+{
+#ifdef USE_ZSTD
+  ZSTD_CCtx* cctx = static_cast<ZSTD_CCtx*>(mContext);
+  if (cctx == NULL) return false;
+
+  ZSTD_inBuffer in = { data, length, 0 };
+  const ZSTD_EndDirective mode = last ? ZSTD_e_end : ZSTD_e_continue;
+
+  for (;;)
+  {
+    ZSTD_outBuffer out = { &mOut[0], mOut.size(), 0 };
+
+    size_t remaining = ZSTD_compressStream2(cctx, &out, &in, mode);
+    if (ZSTD_isError(remaining)) return false;
+
+    if (out.pos > 0 && !mNext.write(&mOut[0], out.pos)) return false;
+
+    // continue until the input is consumed and, at the end, the frame
+    // has been flushed completely
+    if (last ? (remaining == 0) : (in.pos == in.size)) break;
+  }
+
+  return true;
+#else
+  (void)data; (void)length; (void)last;
+  return false;
+#endif
+}
+/** @endcond */
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Creates a SedSinkStreamBuf passing chunks of chunkSize bytes to sink.
+ */
+SedSinkStreamBuf::SedSinkStreamBuf (SedOutputSink& sink, size_t chunkSize)
+  : mSink (sink)
+  , mBuffer (chunkSize > 0 ? chunkSize : 1)
+  , mFailed (false)
+  , mWritten (0)
+{
+  setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+}
+
+
+/*
+ * Passes what is buffered on to the sink.
+ */
+bool
+SedSinkStreamBuf::flushChunk ()
+{
+  size_t length = (size_t)(pptr() - pbase());
+  if (length > 0 && !mFailed)
+  {
+    mFailed = !mSink.write(pbase(), length);
+    if (!mFailed) mWritten += length;
+  }
+  setp(&mBuffer[0], &mBuffer[0] + mBuffer.size());
+  return !mFailed;
+}
+
+
+SedSinkStreamBuf::int_type
+SedSinkStreamBuf::overflow (int_type c)
+{
+  if (!flushChunk()) return traits_type::eof();
+
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+
+int
+SedSinkStreamBuf::sync ()
+{
+  // chunks are only ever passed on when full; the last one goes out
+  // through flushChunk() once the document is complete
+  return mFailed ? -1 : 0;
+}
+
+
+SedSinkStreamBuf::pos_type
+SedSinkStreamBuf::seekoff (off_type off, std::ios_base::seekdir dir,
+                           std::ios_base::openmode which)
+{
+  // only tells the position, for tellp()
+  if (off != 0 || dir != std::ios_base::cur
+    || (which & std::ios_base::out) == 0)
+  {
+    return pos_type(off_type(-1));
+  }
+  return pos_type(off_type(mWritten + (pptr() - pbase())));
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
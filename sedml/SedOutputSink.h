@@ -0,0 +1,331 @@
+/**
+ * @file    SedOutputSink.h
+ * @brief   Destinations for the output of SedWriter, written in chunks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedOutputSink
+ * @ingroup Core
+ * @brief Receives serialised SED-ML a chunk at a time.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedWriter::writeSedML(const SedDocument*, SedOutputSink&, size_t) hands
+ * the XML to a SedOutputSink in chunks of a fixed size as the document is
+ * being written, so that at no point is the whole document held in
+ * memory.  The following sinks are provided:
+ *
+ * @li SedCallbackSink passes every chunk to a user function, for instance
+ * one writing to a socket;
+ * @li SedFileSink writes the chunks to a file;
+ * @li SedGzipSink compresses the chunks with <em>zlib</em> in @em gzip
+ * format and passes the result on to another sink;
+ * @li SedZstdSink does the same with <em>zstd</em>.
+ *
+ * The compressing sinks only work when libSEDML was built with the
+ * respective library (see SedGzipSink::isAvailable() and
+ * SedZstdSink::isAvailable()); otherwise every write to them fails.
+ */
+
+#ifndef SedOutputSink_h
+#define SedOutputSink_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+#include <stdio.h>
+
+
+/**
+ * Function receiving a chunk of output of a SedCallbackSink.
+ *
+ * @return non-zero on success; zero stops the writing.
+ */
+typedef int (*SedOutputSink_writeFunc) (const char *data, size_t length,
+                                        void *userData);
+
+
+#ifdef __cplusplus
+
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedOutputSink
+{
+public:
+
+  /**
+   * Destroys this SedOutputSink.
+   */
+  virtual ~SedOutputSink ();
+
+
+  /**
+   * Consumes the next @p length bytes of output.
+   *
+   * @return @c true on success, @c false if the output cannot be written;
+   * writing stops at the first failure.
+   */
+  virtual bool write (const char* data, size_t length) = 0;
+
+
+  /**
+   * Called once after the last write() of a document; sinks holding
+   * buffered or compressed state emit the rest of it here.
+   *
+   * @return @c true on success, @c false otherwise.
+   */
+  virtual bool finish ();
+};
+
+
+class LIBSEDML_EXTERN SedCallbackSink : public SedOutputSink
+{
+public:
+
+  /**
+   * Creates a new SedCallbackSink passing every chunk, together with
+   * @p userData, to @p func.
+   */
+  SedCallbackSink (SedOutputSink_writeFunc func, void* userData = NULL);
+
+
+  /**
+   * Passes the chunk to the function of this sink.
+   */
+  virtual bool write (const char* data, size_t length);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedOutputSink_writeFunc mFunc;
+  void*                   mUserData;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedFileSink : public SedOutputSink
+{
+public:
+
+  /**
+   * Creates a new SedFileSink writing to the file @p filename, which is
+   * created or truncated, or, if @p append is @c true, created or
+   * appended to.
+   */
+  SedFileSink (const std::string& filename, bool append = false);
+
+
+  /**
+   * Closes the file of this SedFileSink.
+   */
+  virtual ~SedFileSink ();
+
+
+  /**
+   * @return @c true if the file could be opened, @c false otherwise.
+   */
+  bool isOpen () const;
+
+
+  /**
+   * Writes the chunk to the file.
+   */
+  virtual bool write (const char* data, size_t length);
+
+
+  /**
+   * Hands what has been written so far to the operating system, so that
+   * it is in the file even if the process ends without finish().
+   *
+   * @return @c true on success, @c false otherwise.
+   */
+  bool flush ();
+
+
+  /**
+   * Flushes and closes the file.
+   */
+  virtual bool finish ();
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedFileSink (const SedFileSink& orig);
+  SedFileSink& operator= (const SedFileSink& rhs);
+
+  FILE* mFile;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedGzipSink : public SedOutputSink
+{
+public:
+
+  /**
+   * Creates a new SedGzipSink compressing at @p level (0-9, or -1 for the
+   * zlib default) and passing the @em gzip stream on to @p next, which the
+   * new sink does not own.
+   */
+  SedGzipSink (SedOutputSink& next, int level = -1);
+
+
+  /**
+   * Destroys this SedGzipSink.
+   */
+  virtual ~SedGzipSink ();
+
+
+  /**
+   * @return @c true if libSEDML was built with zlib.
+   */
+  static bool isAvailable ();
+
+
+  /**
+   * Compresses the chunk.
+   */
+  virtual bool write (const char* data, size_t length);
+
+
+  /**
+   * Ends the @em gzip stream and finishes the next sink.
+   */
+  virtual bool finish ();
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedGzipSink (const SedGzipSink& orig);
+  SedGzipSink& operator= (const SedGzipSink& rhs);
+
+  bool deflateInto (const char* data, size_t length, bool last);
+
+  SedOutputSink&    mNext;
+  void*             mStream;
+  std::vector<char> mOut;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedZstdSink : public SedOutputSink
+{
+public:
+
+  /**
+   * Creates a new SedZstdSink compressing at @p level (0 for the zstd
+   * default) and passing the frame on to @p next, which the new sink does
+   * not own.
+   */
+  SedZstdSink (SedOutputSink& next, int level = 0);
+
+
+  /**
+   * Destroys this SedZstdSink.
+   */
+  virtual ~SedZstdSink ();
+
+
+  /**
+   * @return @c true if libSEDML was built with zstd.
+   */
+  static bool isAvailable ();
+
+
+  /**
+   * Compresses the chunk.
+   */
+  virtual bool write (const char* data, size_t length);
+
+
+  /**
+   * Ends the zstd frame and finishes the next sink.
+   */
+  virtual bool finish ();
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedZstdSink (const SedZstdSink& orig);
+  SedZstdSink& operator= (const SedZstdSink& rhs);
+
+  bool compressInto (const char* data, size_t length, bool last);
+
+  SedOutputSink&    mNext;
+  void*             mContext;
+  std::vector<char> mOut;
+
+  /** @endcond */
+};
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Stream buffer passing full chunks to a SedOutputSink, which lets
+ * XMLOutputStream write into a sink through an ordinary std::ostream.
+ * Used by SedWriter and SedStreamWriter.
+ */
+class LIBSEDML_EXTERN SedSinkStreamBuf : public std::streambuf
+{
+public:
+
+  SedSinkStreamBuf (SedOutputSink& sink, size_t chunkSize);
+
+  /*
+   * Passes what is buffered on to the sink.
+   */
+  bool flushChunk ();
+
+protected:
+
+  virtual int_type overflow (int_type c);
+
+  virtual int sync ();
+
+  virtual pos_type seekoff (off_type off, std::ios_base::seekdir dir,
+                            std::ios_base::openmode which);
+
+private:
+
+  SedOutputSink&    mSink;
+  std::vector<char> mBuffer;
+  bool              mFailed;
+  size_t            mWritten;
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedOutputSink_h */
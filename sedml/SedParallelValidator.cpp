@@ -0,0 +1,566 @@
+/**
+ * @file    SedParallelValidator.cpp
+ * @brief   Checks the consistency of a whole document using several threads
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedParallelValidator.h>
+#include <sedml/SedTypes.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedNumber.h>
+#include <sedml/common/threads.h>
+
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of consecutive top-level elements a thread claims at once.
+ */
+static const unsigned int SED_VALIDATION_RUN = 32;
+
+
+/*
+ * The sorted ids of the objects of each kind a reference can name,
+ * gathered before the threads start and only read by them.
+ */
+struct SedValidationIds
+{
+  std::vector<std::string>  models;
+  std::vector<std::string>  simulations;
+  std::vector<std::string>  tasks;
+  std::vector<std::string>  dataGenerators;
+};
+
+
+/*
+ * State shared by the threads validating one document.  Runs are claimed
+ * one at a time through next; each error buffer is written by the thread
+ * that claimed its run only.
+ */
+struct SedValidationJob
+{
+  const std::vector<const SedBase*>*     items;
+  const SedValidationIds*                ids;
+  std::vector<std::vector<SedError> >*   buffers;
+  unsigned int                           level;
+  unsigned int                           version;
+  unsigned int                           next;
+  SedMutex                               mutex;
+};
+
+
+/*
+ * Adds the ids of the elements of list to ids, and sorts them.
+ */
+static void
+gatherIds (const SedListOf* list, std::vector<std::string>& ids)
+{
+  const unsigned int size = list->size();
+  ids.reserve(size);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const SedBase* element = list->get(i);
+    if (element != NULL && element->isSetId()) ids.push_back(element->getId());
+  }
+
+  std::sort(ids.begin(), ids.end());
+}
+
+
+/*
+ * Adds the elements of list to items.
+ */
+static void
+gatherItems (const SedListOf* list, std::vector<const SedBase*>& items)
+{
+  const unsigned int size = list->size();
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const SedBase* element = list->get(i);
+    if (element != NULL) items.push_back(element);
+  }
+}
+
+
+/*
+ * Returns true if value is neither NaN nor infinite.
+ */
+static bool
+isFinite (double value)
+{
+  return value - value == 0;
+}
+
+
+/*
+ * Returns the description of element for the details of an error.
+ */
+static std::string
+describe (const SedBase* element)
+{
+  std::string description = "The <" + element->getElementName() + "> element";
+  if (element->isSetId())
+  {
+    description += " with id '" + element->getId() + "'";
+  }
+  return description;
+}
+
+
+/*
+ * Adds a DanglingSedReference error to errors unless reference is one of
+ * the sorted ids.
+ */
+static void
+checkReference (const SedValidationJob& job, const SedBase* element,
+                const char* attribute, const std::string& reference,
+                const std::vector<std::string>& ids,
+                std::vector<SedError>& errors)
+{
+  if (std::binary_search(ids.begin(), ids.end(), reference)) return;
+
+  // worded as SedDocument::resolveReferences() words it
+  std::string details = "The '" + std::string(attribute)
+    + "' attribute of the <" + element->getElementName() + "> element";
+  if (element->isSetId())
+  {
+    details += " with id '" + element->getId() + "'";
+  }
+  details += " refers to '" + reference + "', which does not exist.";
+
+  errors.push_back(SedError(DanglingSedReference, job.level, job.version,
+                            details, element->getLine(),
+                            element->getColumn()));
+}
+
+
+/*
+ * Adds an UnboundSedMathSymbol error to errors for every name in math that
+ * is not one of the sorted names, once for each name.
+ */
+static void
+checkMath (const SedValidationJob& job, const SedBase* element,
+           const ASTNode* math, const std::vector<std::string>& names,
+           std::vector<SedError>& errors)
+{
+  if (math == NULL) return;
+
+  std::vector<std::string>     unbound;
+  std::vector<const ASTNode*>  stack(1, math);
+  while (!stack.empty())
+  {
+    const ASTNode* node = stack.back();
+    stack.pop_back();
+
+    if (node->getType() == AST_NAME && node->getName() != NULL)
+    {
+      const std::string name = node->getName();
+      if (!std::binary_search(names.begin(), names.end(), name)
+        && std::find(unbound.begin(), unbound.end(), name) == unbound.end())
+      {
+        unbound.push_back(name);
+      }
+    }
+
+    // pushed last first, so that the names are met in order
+    for (unsigned int i = node->getNumChildren(); i > 0; --i)
+    {
+      const ASTNode* child = node->getChild(i - 1);
+      if (child != NULL) stack.push_back(child);
+    }
+  }
+
+  for (size_t i = 0; i < unbound.size(); ++i)
+  {
+    errors.push_back(SedError(UnboundSedMathSymbol, job.level, job.version,
+                              describe(element) + " uses '" + unbound[i]
+                              + "' in its math, which is none of its "
+                              "variables or parameters.",
+                              element->getLine(), element->getColumn()));
+  }
+}
+
+
+/*
+ * Returns the sorted ids of the variables and parameters of owner, a
+ * SedDataGenerator or SedComputeChange.
+ */
+template <typename Owner>
+static std::vector<std::string>
+getBoundNames (const Owner* owner)
+{
+  std::vector<std::string> names;
+  for (unsigned int i = 0; i < owner->getNumVariables(); ++i)
+  {
+    names.push_back(owner->getVariable(i)->getId());
+  }
+  for (unsigned int i = 0; i < owner->getNumParameters(); ++i)
+  {
+    names.push_back(owner->getParameter(i)->getId());
+  }
+
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+
+/*
+ * Adds an InconsistentSedTimeCourse error to errors if the times of tc
+ * are out of order or its number of points is not positive.
+ */
+static void
+checkTimeCourse (const SedValidationJob& job,
+                 const SedUniformTimeCourse* tc,
+                 std::vector<SedError>& errors)
+{
+  const double initial = tc->getInitialTime();
+  const double start   = tc->getOutputStartTime();
+  const double end     = tc->getOutputEndTime();
+  const int    points  = tc->getNumberOfPoints();
+
+  std::string problem;
+  if (!isFinite(initial) || !isFinite(start) || !isFinite(end))
+  {
+    problem = "has times that are not finite";
+  }
+  else if (start < initial)
+  {
+    problem = "starts its output at " + SedNumber::toString(start)
+      + ", before its initial time " + SedNumber::toString(initial);
+  }
+  else if (end < start)
+  {
+    problem = "ends its output at " + SedNumber::toString(end)
+      + ", before it starts it at " + SedNumber::toString(start);
+  }
+  else if (points <= 0)
+  {
+    problem = "has no points";
+  }
+
+  if (problem.empty()) return;
+
+  errors.push_back(SedError(InconsistentSedTimeCourse, job.level, job.version,
+                            describe(tc) + " " + problem + ".",
+                            tc->getLine(), tc->getColumn()));
+}
+
+
+/*
+ * Checks element, adding the errors found to errors.
+ */
+static void
+checkElement (const SedValidationJob& job, const SedBase* element,
+              std::vector<SedError>& errors)
+{
+  const SedValidationIds& ids = *job.ids;
+
+  switch (element->getTypeCode())
+  {
+  case SEDML_TASK:
+  {
+    const SedTask* task = static_cast<const SedTask*>(element);
+    if (task->isSetModelReference())
+    {
+      checkReference(job, task, "modelReference", task->getModelReference(),
+                     ids.models, errors);
+    }
+    if (task->isSetSimulationReference())
+    {
+      checkReference(job, task, "simulationReference",
+                     task->getSimulationReference(), ids.simulations, errors);
+    }
+    break;
+  }
+  case SEDML_VARIABLE:
+  {
+    const SedVariable* var = static_cast<const SedVariable*>(element);
+    if (var->isSetTaskReference())
+    {
+      checkReference(job, var, "taskReference", var->getTaskReference(),
+                     ids.tasks, errors);
+    }
+    if (var->isSetModelReference())
+    {
+      checkReference(job, var, "modelReference", var->getModelReference(),
+                     ids.models, errors);
+    }
+    break;
+  }
+  case SEDML_OUTPUT_SURFACE:
+  {
+    const SedSurface* surface = static_cast<const SedSurface*>(element);
+    if (surface->isSetZDataReference())
+    {
+      checkReference(job, surface, "zDataReference",
+                     surface->getZDataReference(), ids.dataGenerators, errors);
+    }
+  }
+  // a surface has the x and y references of a curve as well
+  case SEDML_OUTPUT_CURVE:
+  {
+    const SedCurve* curve = static_cast<const SedCurve*>(element);
+    if (curve->isSetXDataReference())
+    {
+      checkReference(job, curve, "xDataReference",
+                     curve->getXDataReference(), ids.dataGenerators, errors);
+    }
+    if (curve->isSetYDataReference())
+    {
+      checkReference(job, curve, "yDataReference",
+                     curve->getYDataReference(), ids.dataGenerators, errors);
+    }
+    break;
+  }
+  case SEDML_OUTPUT_DATASET:
+  {
+    const SedDataSet* dataSet = static_cast<const SedDataSet*>(element);
+    if (dataSet->isSetDataReference())
+    {
+      checkReference(job, dataSet, "dataReference",
+                     dataSet->getDataReference(), ids.dataGenerators, errors);
+    }
+    break;
+  }
+  case SEDML_DATAGENERATOR:
+  {
+    const SedDataGenerator* dg = static_cast<const SedDataGenerator*>(element);
+    checkMath(job, dg, dg->getMath(), getBoundNames(dg), errors);
+    break;
+  }
+  case SEDML_CHANGE_COMPUTECHANGE:
+  {
+    const SedComputeChange* cc = static_cast<const SedComputeChange*>(element);
+    checkMath(job, cc, cc->getMath(), getBoundNames(cc), errors);
+    break;
+  }
+  case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+    checkTimeCourse(job, static_cast<const SedUniformTimeCourse*>(element),
+                    errors);
+    break;
+  default:
+    break;
+  }
+}
+
+
+static void
+runValidationJob (SedValidationJob* job)
+{
+  const unsigned int numItems = (unsigned int)job->items->size();
+  const unsigned int numRuns  = (unsigned int)job->buffers->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int run = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (run >= numRuns) break;
+
+    std::vector<SedError>& errors = (*job->buffers)[run];
+    const unsigned int first = run * SED_VALIDATION_RUN;
+    const unsigned int last  = std::min(numItems, first + SED_VALIDATION_RUN);
+
+    try
+    {
+      for (unsigned int i = first; i < last; ++i)
+      {
+        const SedBase* item = (*job->items)[i];
+        const SedElementIterator end = item->end();
+        for (SedElementIterator it = item->begin(); it != end; ++it)
+        {
+          checkElement(*job, &*it, errors);
+        }
+      }
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the run logs what it found
+    }
+  }
+}
+
+
+/*
+ * Entry point of the worker threads.
+ */
+static void
+validationThreadMain (void* arg)
+{
+  runValidationJob(static_cast<SedValidationJob*>(arg));
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedParallelValidator.
+ */
+SedParallelValidator::SedParallelValidator (unsigned int numThreads)
+  : mNumThreads (numThreads)
+{
+}
+
+
+/*
+ * Destroys this SedParallelValidator.
+ */
+SedParallelValidator::~SedParallelValidator ()
+{
+}
+
+
+/*
+ * Sets the number of threads used.
+ */
+void
+SedParallelValidator::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next validation will use at most.
+ */
+unsigned int
+SedParallelValidator::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Checks every element of doc and logs the errors found.
+ */
+unsigned int
+SedParallelValidator::validate (SedDocument* doc) const
+{
+  if (doc == NULL) return 0;
+
+  SedValidationIds ids;
+  gatherIds(doc->getListOfModels(), ids.models);
+  gatherIds(doc->getListOfSimulations(), ids.simulations);
+  gatherIds(doc->getListOfTasks(), ids.tasks);
+  gatherIds(doc->getListOfDataGenerators(), ids.dataGenerators);
+
+  // in document order, which the errors are logged in
+  std::vector<const SedBase*> items;
+  gatherItems(doc->getListOfSimulations(), items);
+  gatherItems(doc->getListOfModels(), items);
+  gatherItems(doc->getListOfTasks(), items);
+  gatherItems(doc->getListOfDataGenerators(), items);
+  gatherItems(doc->getListOfOutputs(), items);
+
+  const unsigned int numRuns =
+    ((unsigned int)items.size() + SED_VALIDATION_RUN - 1) / SED_VALIDATION_RUN;
+  std::vector<std::vector<SedError> > buffers(numRuns);
+
+  SedValidationJob job;
+  job.items   = &items;
+  job.ids     = &ids;
+  job.buffers = &buffers;
+  job.level   = doc->getLevel();
+  job.version = doc->getVersion();
+  job.next    = 0;
+  mutexInit(&job.mutex);
+
+  unsigned int numThreads = getNumThreads();
+  if (numThreads > numRuns) numThreads = numRuns;
+
+  // the calling thread is one of the workers, so numThreads - 1 are
+  // started; if some cannot be started the remaining ones do their share
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, validationThreadMain, &job)) break;
+    threads.push_back(thread);
+  }
+
+  runValidationJob(&job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+
+  mutexFree(&job.mutex);
+
+  unsigned int numErrors = 0;
+  SedErrorLog* log = doc->getErrorLog();
+  for (unsigned int i = 0; i < numRuns; ++i)
+  {
+    log->add(buffers[i]);
+    numErrors += (unsigned int)buffers[i].size();
+  }
+
+  return numErrors;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedParallelValidator and returns it.
+ */
+LIBSEDML_EXTERN
+SedParallelValidator_t *
+SedParallelValidator_create (unsigned int numThreads)
+{
+  return new (nothrow) SedParallelValidator(numThreads);
+}
+
+
+/**
+ * Frees the given SedParallelValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedParallelValidator_free (SedParallelValidator_t *spv)
+{
+  delete spv;
+}
+
+
+/**
+ * Checks every element of doc, logging the errors found, and returns
+ * their number.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedParallelValidator_validate (const SedParallelValidator_t *spv,
+                               SedDocument_t *doc)
+{
+  return (spv != NULL) ? spv->validate(doc) : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
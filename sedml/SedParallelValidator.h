@@ -0,0 +1,163 @@
+/**
+ * @file    SedParallelValidator.h
+ * @brief   Checks the consistency of a whole document using several threads
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedParallelValidator
+ * @ingroup Core
+ * @brief Checks every element of a SedDocument, on a pool of threads.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * validate() checks that
+ *
+ * @li every reference attribute of a SedTask, SedVariable, SedCurve,
+ * SedSurface and SedDataSet names an object of the kind it refers to,
+ * logging a @c DanglingSedReference error otherwise;
+ * @li every @c ci in the math of a SedDataGenerator or SedComputeChange is
+ * the id of one of its own variables or parameters, logging an
+ * @c UnboundSedMathSymbol error otherwise;
+ * @li the initial, output start and output end times of every
+ * SedUniformTimeCourse are finite and in that order, and its number of
+ * points positive, logging an @c InconsistentSedTimeCourse error
+ * otherwise.
+ *
+ * The ids of the models, simulations, tasks and data generators are
+ * gathered first, on the calling thread.  The elements of the top-level
+ * lists of the document are then split into runs of consecutive elements
+ * that the threads claim one at a time, each checking the run it claimed
+ * into an error buffer of the run's own.  When all are done the buffers
+ * are appended to the SedErrorLog of the document in the order of the
+ * runs, so that the errors logged, and their order, are the same whatever
+ * the number of threads.
+ *
+ * @section parallel-validator-threads Thread safety
+ *
+ * The threads only read the document, through the ids gathered and the
+ * const accessors of its elements; none resolves the cached reference
+ * links or the id index of the document.  Neither the document nor its
+ * error log may be used by other threads while it is validated.
+ */
+
+#ifndef SedParallelValidator_h
+#define SedParallelValidator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedParallelValidator
+{
+public:
+
+  /**
+   * Creates a new SedParallelValidator using @p numThreads threads.  A
+   * value of zero uses one thread per available processor.
+   */
+  SedParallelValidator (unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedParallelValidator.
+   */
+  virtual ~SedParallelValidator ();
+
+
+  /**
+   * Sets the number of threads used; zero means one per processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next validation will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Checks every element of @p doc and logs the errors found in its
+   * SedErrorLog, after those already there.
+   *
+   * @return the number of errors found, 0 if @p doc is @c NULL.
+   */
+  unsigned int validate (SedDocument* doc) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  unsigned int mNumThreads;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedParallelValidator using @p numThreads threads, zero
+ * meaning one per processor, and returns it.
+ */
+LIBSEDML_EXTERN
+SedParallelValidator_t *
+SedParallelValidator_create (unsigned int numThreads);
+
+
+/**
+ * Frees the given SedParallelValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedParallelValidator_free (SedParallelValidator_t *spv);
+
+
+/**
+ * Checks every element of @p doc, logging the errors found in its error
+ * log, and returns their number.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedParallelValidator_validate (const SedParallelValidator_t *spv,
+                               SedDocument_t *doc);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedParallelValidator_h */
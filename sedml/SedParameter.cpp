@@ -202,7 +202,11 @@ SedParameter::isSetValue() const
 int
 SedParameter::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -212,6 +216,8 @@ SedParameter::setId(const std::string& id)
 int
 SedParameter::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -230,6 +236,8 @@ SedParameter::setName(const std::string& name)
 int
 SedParameter::setValue(double value)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mValue = value;
 	mIsSetValue = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -242,7 +250,10 @@ SedParameter::setValue(double value)
 int
 SedParameter::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -261,6 +272,8 @@ SedParameter::unsetId()
 int
 SedParameter::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -280,6 +293,8 @@ SedParameter::unsetName()
 int
 SedParameter::unsetValue()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mValue = numeric_limits<double>::quiet_NaN();
 	mIsSetValue = false;
 
@@ -294,14 +309,16 @@ SedParameter::unsetValue()
 }
 
 
+static const std::string sSedParameterName("parameter");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedParameter::getElementName () const
 {
-	static const string name = "parameter";
-	return name;
+	return sSedParameterName;
 }
 
 
@@ -351,13 +368,12 @@ SedParameter::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedParameter::accept (SedVisitor& v) const
+SedParameter::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -411,10 +427,20 @@ SedParameter::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u },
+		{ "value", 0x425ed3cau }
+	};
+	int index[3];
+	findAttributes(attributes, names, 3, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -433,7 +459,7 @@ SedParameter::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -448,7 +474,7 @@ SedParameter::readAttributes (const XMLAttributes& attributes,
 	//
 	// value double   ( use = "required" )
 	//
-	mIsSetValue = attributes.readInto("value", mValue, getErrorLog(), true);
+	mIsSetValue = readAttribute(attributes, index[2], "value", mValue, true);
 
 }
 
@@ -456,6 +482,11 @@ SedParameter::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sValueAttribute("value");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -466,14 +497,39 @@ SedParameter::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		stream.writeAttribute(sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		stream.writeAttribute(sNameAttribute, prefix, mName);
+
+	if (isSetValue() == true)
+		stream.writeAttribute(sValueAttribute, prefix, SedNumber::toString(mValue));
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedParameter::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		addAttribute(attributes, sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		addAttribute(attributes, sNameAttribute, prefix, mName);
 
 	if (isSetValue() == true)
-		stream.writeAttribute("value", getPrefix(), mValue);
+		addAttribute(attributes, sValueAttribute, prefix, SedNumber::toString(mValue));
 
 }
 
@@ -549,10 +605,7 @@ SedListOfParameters::get(const std::string& sid)
 const SedParameter*
 SedListOfParameters::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedParameter>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedParameter*> (*result);
+	return static_cast <const SedParameter*> (getItemById(sid));
 }
 
 
@@ -577,6 +630,17 @@ SedListOfParameters::addParameter(const SedParameter* sp)
 }
 
 
+/*
+ * Adds the given SedParameter to this SedListOfParameters, which takes ownership of it.
+ */
+int
+SedListOfParameters::addParameterAndOwn(SedParameter* sp)
+{
+	if(sp == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sp);
+}
+
+
 /**
  * Get the number of SedParameter objects in this SedListOfParameters.
  *
@@ -599,7 +663,8 @@ SedListOfParameters::getNumParameters() const
 SedParameter* 
 SedListOfParameters::createParameter()
 {
-	SedParameter *temp = new SedParameter();
+	if (isFrozen()) return NULL;
+	SedParameter *temp = new (getArena()) SedParameter();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -620,19 +685,11 @@ SedListOfParameters::remove(unsigned int n)
 SedParameter*
 SedListOfParameters::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedParameter>(sid) );
+	return static_cast <SedParameter*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedParameter*> (item);
-}
+static const std::string sSedListOfParametersName("listOfParameters");
 
 
 /*
@@ -641,8 +698,7 @@ SedListOfParameters::remove(const std::string& sid)
 const std::string&
 SedListOfParameters::getElementName () const
 {
-	static const string name = "listOfParameters";
-	return name;
+	return sSedListOfParametersName;
 }
 
 
@@ -668,6 +724,16 @@ SedListOfParameters::getItemTypeCode () const
 
 /** @cond doxygen-libsbml-internal */
 
+/*
+ * Returns the size of a SedParameter.
+ */
+size_t
+SedListOfParameters::getItemSize () const
+{
+	return sizeof(SedParameter);
+}
+
+
 /*
  * Creates a new SedParameter in this SedListOfParameters
  */
@@ -679,7 +745,7 @@ SedListOfParameters::createObject(XMLInputStream& stream)
 
 	if (name == "parameter")
 	{
-		object = new SedParameter(getSedNamespaces());
+		object = new (getArena()) SedParameter(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -704,7 +770,8 @@ SedListOfParameters::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -772,6 +839,20 @@ SedParameter_getId(SedParameter_t * sp)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedParameter_getIdView(const SedParameter_t * sp)
+{
+	if (sp == NULL)
+		return NULL;
+
+	return sp->getId().empty() ? NULL : sp->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -786,6 +867,20 @@ SedParameter_getName(SedParameter_t * sp)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedParameter_getNameView(const SedParameter_t * sp)
+{
+	if (sp == NULL)
+		return NULL;
+
+	return sp->getName().empty() ? NULL : sp->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -62,10 +62,10 @@ class LIBSEDML_EXTERN SedParameter : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	double        mValue;
-	bool          mIsSetValue;
+	bool          mIsSetValue : 1;
 
 
 public:
@@ -332,9 +332,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -384,6 +384,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -498,6 +505,25 @@ public:
 	int addParameter(const SedParameter* p);
 
 
+	/**
+	 * Adds the given "SedParameter" to this SedListOfParameters without copying it; this
+	 * SedListOfParameters takes ownership of @p p and will delete it.
+	 *
+	 * @param p the SedParameter object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p p is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addParameter(const SedParameter* p)
+	 */
+	int addParameterAndOwn(SedParameter* p);
+
+
 	/**
 	 * Get the number of Parameter objects in this SedListOfParameters.
 	 *
@@ -632,6 +658,12 @@ protected:
 	virtual SedBase* createObject(XMLInputStream& stream);
 
 
+	/**
+	 * Returns the size of a SedParameter, the type of all items of this list.
+	 */
+	virtual size_t getItemSize () const;
+
+
 	/** @endcond doxygen-libsbml-internal */
 
 
@@ -680,11 +712,21 @@ char *
 SedParameter_getId(SedParameter_t * sp);
 
 
+LIBSEDML_EXTERN
+const char *
+SedParameter_getIdView(const SedParameter_t * sp);
+
+
 LIBSEDML_EXTERN
 char *
 SedParameter_getName(SedParameter_t * sp);
 
 
+LIBSEDML_EXTERN
+const char *
+SedParameter_getNameView(const SedParameter_t * sp);
+
+
 LIBSEDML_EXTERN
 double
 SedParameter_getValue(SedParameter_t * sp);
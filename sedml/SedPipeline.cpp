@@ -0,0 +1,546 @@
+/**
+ * @file    SedPipeline.cpp
+ * @brief   Evaluates data generators and writes reports as tasks output
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedPipeline.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * A task with the reports streamed while it runs.
+ */
+struct SedPipeline::Stage : public SedChunkListener
+{
+  std::string                           taskId;
+  std::vector<const SedReport*>         reports;
+  std::vector<SedReportWriter*>         writers;
+
+  // the data generators of the reports, and the variable the task is
+  // asked for for each of their inputs
+  SedCompiledMathSet                    math;
+  std::vector<const SedVariable*>       variables;
+
+  // the values of the data generators for the chunk being written
+  SedResults                            chunk;
+  std::vector<const double*>            columns;
+  std::vector<double*>                  values;
+
+  virtual int chunkWritten (const SedChunkWriter& writer, size_t offset,
+                            size_t length)
+  {
+    for (unsigned int i = 0; i < columns.size(); ++i)
+    {
+      columns[i] = writer.getColumn(i) + offset;
+    }
+
+    for (unsigned int i = 0; i < values.size(); ++i)
+    {
+      const std::string& id = math.getDataGeneratorId(i);
+      values[i] = (chunk.getColumnLength(id) >= length)
+                ? chunk.getColumn(id) : chunk.addColumn(id, length);
+      if (values[i] == NULL) return LIBSEDML_OPERATION_FAILED;
+    }
+
+    const int result =
+      math.evaluate(columns.empty() ? NULL : &columns[0], length,
+                    values.empty() ? NULL : &values[0]);
+    if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+    for (unsigned int i = 0; i < writers.size(); ++i)
+    {
+      const int written = writers[i]->writeChunk(chunk, 0, length);
+      if (written != LIBSEDML_OPERATION_SUCCESS) return written;
+    }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+};
+
+
+/*
+ * A simulator adapter calling a C function, used by SedPipeline_run().
+ */
+class SedPipelineCallbackAdapter : public SedSimulatorAdapter
+{
+public:
+
+  SedPipelineCallbackAdapter (SedSimulatorAdapter_runFunc func,
+                              void* userData)
+    : mFunc (func)
+    , mUserData (userData)
+  {
+  }
+
+  virtual int run (const SedTask* task, const SedModel* model,
+                   const SedSimulation* simulation,
+                   const SedAlgorithm* algorithm,
+                   SedChunkWriter& writer)
+  {
+    return mFunc(task, model, simulation, algorithm, &writer, mUserData);
+  }
+
+private:
+
+  SedSimulatorAdapter_runFunc mFunc;
+  void*                       mUserData;
+};
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedPipeline passing chunkSize time points at a time.
+ */
+SedPipeline::SedPipeline (size_t chunkSize)
+  : mChunkSize ((chunkSize > 0) ? chunkSize : 1)
+{
+}
+
+
+/*
+ * Destroys this SedPipeline.
+ */
+SedPipeline::~SedPipeline ()
+{
+}
+
+
+/*
+ * Sets the largest number of time points evaluated and written at a time.
+ */
+void
+SedPipeline::setChunkSize (size_t chunkSize)
+{
+  mChunkSize = (chunkSize > 0) ? chunkSize : 1;
+}
+
+
+/*
+ * Returns the largest number of time points evaluated and written at a
+ * time.
+ */
+size_t
+SedPipeline::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+/*
+ * Sets the writer the rows of the report reportId are appended to.
+ */
+int
+SedPipeline::setReportWriter (const std::string& reportId,
+                              SedReportWriter* writer)
+{
+  if (reportId.empty()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  if (writer == NULL)
+  {
+    mWriters.erase(reportId);
+  }
+  else
+  {
+    mWriters[reportId] = writer;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the writer of the report reportId.
+ */
+SedReportWriter*
+SedPipeline::getReportWriter (const std::string& reportId) const
+{
+  std::map<std::string, SedReportWriter*>::const_iterator it =
+    mWriters.find(reportId);
+  return (it != mWriters.end()) ? it->second : NULL;
+}
+
+
+/*
+ * Returns the number of reports a writer is registered for.
+ */
+unsigned int
+SedPipeline::getNumReportWriters () const
+{
+  return (unsigned int)mWriters.size();
+}
+
+
+/*
+ * Removes the writers of all reports.
+ */
+void
+SedPipeline::clearReportWriters ()
+{
+  mWriters.clear();
+}
+
+
+/*
+ * Runs the tasks the reports with a writer need, streaming their rows.
+ */
+int
+SedPipeline::run (const SedDocument* document, SedSimulatorAdapter& adapter)
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mFailed.clear();
+
+  std::map<std::string, SedReportWriter*>::const_iterator it;
+  for (it = mWriters.begin(); it != mWriters.end(); ++it)
+  {
+    const SedOutput* output = document->getOutput(it->first);
+    if (output == NULL || output->getTypeCode() != SEDML_OUTPUT_REPORT)
+    {
+      fail(it->first);
+    }
+  }
+
+  // the reports are streamed with the one task their data generators
+  // refer to, in the order of the first report of each task
+  std::vector<Stage*> stages;
+  std::map<std::string, unsigned int> stageIndex;
+
+  for (unsigned int i = 0; i < document->getNumOutputs(); ++i)
+  {
+    const SedOutput* output = document->getOutput(i);
+    if (output->getTypeCode() != SEDML_OUTPUT_REPORT) continue;
+
+    it = mWriters.find(output->getId());
+    if (it == mWriters.end()) continue;
+
+    const SedReport* report = static_cast<const SedReport*>(output);
+    std::string taskId;
+    bool streamed = (report->getNumDataSets() > 0);
+
+    for (unsigned int j = 0; streamed && j < report->getNumDataSets(); ++j)
+    {
+      const SedDataGenerator* dg =
+        document->getDataGenerator(report->getDataSet(j)->getDataReference());
+      if (dg == NULL)
+      {
+        streamed = false;
+        break;
+      }
+
+      for (unsigned int k = 0; k < dg->getNumVariables(); ++k)
+      {
+        const std::string& reference = dg->getVariable(k)->getTaskReference();
+        if (taskId.empty())
+        {
+          taskId = reference;
+        }
+        else if (reference != taskId)
+        {
+          streamed = false;
+        }
+      }
+    }
+
+    if (!streamed || taskId.empty())
+    {
+      fail(report->getId());
+      continue;
+    }
+
+    std::map<std::string, unsigned int>::const_iterator found =
+      stageIndex.find(taskId);
+    Stage* stage = NULL;
+
+    if (found != stageIndex.end())
+    {
+      stage = stages[found->second];
+    }
+    else
+    {
+      stage = new Stage;
+      stage->taskId = taskId;
+      stageIndex[taskId] = (unsigned int)stages.size();
+      stages.push_back(stage);
+    }
+
+    stage->reports.push_back(report);
+    stage->writers.push_back(it->second);
+  }
+
+  std::map<std::string, bool> loaded;
+
+  for (unsigned int i = 0; i < stages.size(); ++i)
+  {
+    Stage& stage = *stages[i];
+
+    if (!prepare(document, stage)
+        || !runStage(document, adapter, stage, loaded))
+    {
+      for (unsigned int j = 0; j < stage.reports.size(); ++j)
+      {
+        fail(stage.reports[j]->getId());
+      }
+    }
+
+    delete stages[i];
+    stages[i] = NULL;
+  }
+
+  return mFailed.empty() ? LIBSEDML_OPERATION_SUCCESS
+                         : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the number of elements that failed in the last run.
+ */
+unsigned int
+SedPipeline::getNumFailed () const
+{
+  return (unsigned int)mFailed.size();
+}
+
+
+/*
+ * Returns the id of the n-th element that failed in the last run.
+ */
+const std::string&
+SedPipeline::getFailedId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mFailed.size()) ? mFailed[n] : empty;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Records that the element id failed, once.
+ */
+void
+SedPipeline::fail (const std::string& id)
+{
+  for (unsigned int i = 0; i < mFailed.size(); ++i)
+  {
+    if (mFailed[i] == id) return;
+  }
+
+  mFailed.push_back(id);
+}
+
+
+/*
+ * Compiles the data generators of the reports of stage and finds the
+ * variables the task is asked for.
+ *
+ * @return false if the task cannot be run or a data generator cannot be
+ * compiled.
+ */
+bool
+SedPipeline::prepare (const SedDocument* document, Stage& stage)
+{
+  const SedTask* task = document->getTask(stage.taskId);
+  if (task == NULL
+      || document->getModel(task->getModelReference()) == NULL
+      || document->getSimulation(task->getSimulationReference()) == NULL)
+  {
+    fail(stage.taskId);
+    return false;
+  }
+
+  std::map<std::string, bool> added;
+  std::map<std::string, const SedVariable*> variables;
+
+  for (unsigned int i = 0; i < stage.reports.size(); ++i)
+  {
+    const SedReport* report = stage.reports[i];
+
+    for (unsigned int j = 0; j < report->getNumDataSets(); ++j)
+    {
+      const SedDataGenerator* dg =
+        document->getDataGenerator(report->getDataSet(j)->getDataReference());
+      if (added.find(dg->getId()) != added.end()) continue;
+
+      if (stage.math.add(dg) != LIBSEDML_OPERATION_SUCCESS)
+      {
+        fail(dg->getId());
+        return false;
+      }
+      added[dg->getId()] = true;
+
+      for (unsigned int k = 0; k < dg->getNumVariables(); ++k)
+      {
+        variables[dg->getVariable(k)->getId()] = dg->getVariable(k);
+      }
+    }
+  }
+
+  // the set binds variables of the same model, target and symbol of the
+  // task to one input, so the task is asked for each input once
+  for (unsigned int n = 0; n < stage.math.getNumInputs(); ++n)
+  {
+    stage.variables.push_back(variables[stage.math.getInputId(n)]);
+  }
+
+  stage.columns.resize(stage.variables.size());
+  stage.values.resize(stage.math.getNumDataGenerators());
+  for (unsigned int i = 0; i < stage.values.size(); ++i)
+  {
+    if (stage.chunk.addColumn(stage.math.getDataGeneratorId(i),
+                              mChunkSize) == NULL)
+    {
+      fail(stage.math.getDataGeneratorId(i));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Loads the model of the task of stage, unless that was done before, and
+ * runs the task with the data generators and reports of stage listening.
+ *
+ * @return false if the model or the task failed.
+ */
+bool
+SedPipeline::runStage (const SedDocument* document,
+                       SedSimulatorAdapter& adapter, Stage& stage,
+                       std::map<std::string, bool>& loaded)
+{
+  const SedTask* task = document->getTask(stage.taskId);
+  const SedModel* model = document->getModel(task->getModelReference());
+  const SedSimulation* simulation =
+    document->getSimulation(task->getSimulationReference());
+
+  std::map<std::string, bool>::iterator it = loaded.find(model->getId());
+  if (it == loaded.end())
+  {
+    const bool succeeded =
+      (adapter.loadModel(model) == LIBSEDML_OPERATION_SUCCESS);
+    it = loaded.insert(std::make_pair(model->getId(), succeeded)).first;
+    if (!succeeded) fail(model->getId());
+  }
+  if (!it->second) return false;
+
+  // the task results only ever hold the chunk being written
+  SedResults results;
+  SedChunkWriter writer(results, stage.variables, mChunkSize);
+  writer.setListener(&stage, false);
+
+  int result = adapter.run(task, model, simulation,
+                           simulation->getAlgorithm(), writer);
+  if (result == LIBSEDML_OPERATION_SUCCESS) result = writer.finish();
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+  {
+    fail(task->getId());
+    return false;
+  }
+
+  return true;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedPipeline passing chunkSize time points at a time and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedPipeline_t *
+SedPipeline_create (size_t chunkSize)
+{
+  return new (nothrow) SedPipeline(chunkSize);
+}
+
+
+/**
+ * Frees the given SedPipeline.
+ */
+LIBSEDML_EXTERN
+void
+SedPipeline_free (SedPipeline_t *sp)
+{
+  delete sp;
+}
+
+
+/**
+ * Sets the writer the rows of the report reportId are appended to.
+ */
+LIBSEDML_EXTERN
+int
+SedPipeline_setReportWriter (SedPipeline_t *sp, const char *reportId,
+                             SedReportWriter_t *writer)
+{
+  if (sp == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (reportId == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  return sp->setReportWriter(reportId, writer);
+}
+
+
+/**
+ * Runs the tasks the reports with a writer need with func, streaming the
+ * rows of the reports to their writers.
+ */
+LIBSEDML_EXTERN
+int
+SedPipeline_run (SedPipeline_t *sp, const SedDocument_t *document,
+                 SedSimulatorAdapter_runFunc func, void *userData)
+{
+  if (sp == NULL || func == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SedPipelineCallbackAdapter adapter(func, userData);
+  return sp->run(document, adapter);
+}
+
+
+/**
+ * Returns the number of elements that failed in the last run.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedPipeline_getNumFailed (const SedPipeline_t *sp)
+{
+  return (sp != NULL) ? sp->getNumFailed() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
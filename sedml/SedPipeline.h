@@ -0,0 +1,258 @@
+/**
+ * @file    SedPipeline.h
+ * @brief   Evaluates data generators and writes reports as tasks output
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedPipeline
+ * @ingroup Core
+ * @brief Streams the reports of a SedDocument while its tasks run.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedExecutor evaluates a data generator once the tasks it refers to are
+ * done, so every task result is held in full, and nothing is reported
+ * before the simulation ends.  A SedPipeline instead runs each task with
+ * a SedSimulatorAdapter and connects the SedChunkWriter of the task to
+ * what depends on it: as every chunk of time points arrives, the data
+ * generators the reports need are evaluated for it with a
+ * SedCompiledMathSet, and its rows are appended to the SedReportWriter of
+ * every report, after which the columns of the chunk are written over by
+ * the next one.  The memory used is therefore bounded by the chunk size
+ * (see setChunkSize()), however many points the simulations have, and
+ * the first rows are written as soon as the solver has them.
+ *
+ * Only the reports a writer was registered for with setReportWriter() are
+ * streamed, and only those whose data generators all refer to a single
+ * task, since the rows of different tasks do not arrive together; such
+ * reports, and those whose data generators or task cannot be run, fail,
+ * and the ids of what failed are available after run().  The tasks of the
+ * streamed reports run one after the other, each task once for all its
+ * reports, after its model has been loaded with
+ * SedSimulator::loadModel().
+ */
+
+#ifndef SedPipeline_h
+#define SedPipeline_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedSimulatorAdapter.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedReportWriter;
+
+
+class LIBSEDML_EXTERN SedPipeline
+{
+public:
+
+  /**
+   * Creates a new SedPipeline passing @p chunkSize time points at a time;
+   * zero is taken to be one.
+   */
+  SedPipeline (size_t chunkSize = 1024);
+
+
+  /**
+   * Destroys this SedPipeline.
+   */
+  virtual ~SedPipeline ();
+
+
+  /**
+   * Sets the largest number of time points evaluated and written at a
+   * time; zero is taken to be one.
+   */
+  void setChunkSize (size_t chunkSize);
+
+
+  /**
+   * @return the largest number of time points evaluated and written at a
+   * time.
+   */
+  size_t getChunkSize () const;
+
+
+  /**
+   * Sets the writer, which this pipeline does not own, the rows of the
+   * report @p reportId are appended to; it has to be open for that
+   * report when run() is called, and is neither flushed nor closed by
+   * it.  @c NULL removes the writer of the report.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p reportId is empty
+   */
+  int setReportWriter (const std::string& reportId, SedReportWriter* writer);
+
+
+  /**
+   * @return the writer of the report @p reportId, or @c NULL.
+   */
+  SedReportWriter* getReportWriter (const std::string& reportId) const;
+
+
+  /**
+   * @return the number of reports a writer is registered for.
+   */
+  unsigned int getNumReportWriters () const;
+
+
+  /**
+   * Removes the writers of all reports.
+   */
+  void clearReportWriters ();
+
+
+  /**
+   * Runs the tasks the reports with a writer need with @p adapter, and
+   * streams the rows of the reports to their writers.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p document is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any report could not be streamed; see getNumFailed()
+   */
+  int run (const SedDocument* document, SedSimulatorAdapter& adapter);
+
+
+  /**
+   * @return the number of elements that failed in the last run.
+   */
+  unsigned int getNumFailed () const;
+
+
+  /**
+   * @return the id of the n-th element that failed in the last run, or
+   * an empty string if @p n is out of range.  A report fails with its
+   * task, model or data generators, and after them.
+   */
+  const std::string& getFailedId (unsigned int n) const;
+
+
+  /** @cond doxygen-libsbml-internal */
+
+  struct Stage;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedPipeline (const SedPipeline& orig);
+  SedPipeline& operator= (const SedPipeline& rhs);
+
+  void fail (const std::string& id);
+
+  bool prepare (const SedDocument* document, Stage& stage);
+
+  bool runStage (const SedDocument* document, SedSimulatorAdapter& adapter,
+                 Stage& stage, std::map<std::string, bool>& loaded);
+
+
+  size_t                                   mChunkSize;
+  std::map<std::string, SedReportWriter*>  mWriters;
+  std::vector<std::string>                 mFailed;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedPipeline passing @p chunkSize time points at a time
+ * and returns it.
+ */
+LIBSEDML_EXTERN
+SedPipeline_t *
+SedPipeline_create (size_t chunkSize);
+
+
+/**
+ * Frees the given SedPipeline.
+ */
+LIBSEDML_EXTERN
+void
+SedPipeline_free (SedPipeline_t *sp);
+
+
+/**
+ * Sets the writer, which the pipeline does not own, the rows of the
+ * report @p reportId are appended to.
+ */
+LIBSEDML_EXTERN
+int
+SedPipeline_setReportWriter (SedPipeline_t *sp, const char *reportId,
+                             SedReportWriter_t *writer);
+
+
+/**
+ * Runs the tasks the reports with a writer need with @p func, and streams
+ * the rows of the reports to their writers.
+ */
+LIBSEDML_EXTERN
+int
+SedPipeline_run (SedPipeline_t *sp, const SedDocument_t *document,
+                 SedSimulatorAdapter_runFunc func, void *userData);
+
+
+/**
+ * Returns the number of elements that failed in the last run.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedPipeline_getNumFailed (const SedPipeline_t *sp);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedPipeline_h */
@@ -81,6 +81,7 @@ SedPlot2D::SedPlot2D (SedNamespaces* sedns)
  */
 SedPlot2D::SedPlot2D (const SedPlot2D& orig)
 	: SedOutput(orig)
+	, mCurve (orig.mCurve)
 {
 	if (&orig == NULL)
 	{
@@ -88,7 +89,6 @@ SedPlot2D::SedPlot2D (const SedPlot2D& orig)
 	}
 	else
 	{
-		mCurve  = orig.mCurve;
 
 		// connect to child objects
 		connectToChild();
@@ -227,6 +227,17 @@ SedPlot2D::addCurve(const SedCurve* sc)
 }
 
 
+/*
+ * Adds the given SedCurve to this SedPlot2D, which takes ownership of it.
+ */
+int
+SedPlot2D::addCurveAndOwn(SedCurve* sc)
+{
+	if(sc == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mCurve.appendAndOwn(sc);
+}
+
+
 /**
  * Get the number of SedCurve objects in this SedPlot2D.
  *
@@ -249,19 +260,22 @@ SedPlot2D::getNumCurves() const
 SedCurve* 
 SedPlot2D::createCurve()
 {
-	SedCurve *temp = new SedCurve();
+	if (isFrozen()) return NULL;
+	SedCurve *temp = new (getArena()) SedCurve();
 	if (temp != NULL) mCurve.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedPlot2DName("plot2D");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedPlot2D::getElementName () const
 {
-	static const string name = "plot2D";
-	return name;
+	return sSedPlot2DName;
 }
 
 
@@ -275,8 +289,6 @@ SedPlot2D::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedOutput::connectToChild();
-
 	if (name == "listOfCurves")
 	{
 		object = &mCurve;
@@ -298,6 +310,41 @@ SedPlot2D::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedPlot2D::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mCurve);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this Plot2D.
+ */
+unsigned int
+SedPlot2D::getNumChildElements () const
+{
+	return 1;
+}
+
+
+/*
+ * Returns the nth element directly contained in this Plot2D.
+ */
+const SedBase*
+SedPlot2D::getChildElement (unsigned int n) const
+{
+	return (n == 0) ? &mCurve : NULL;
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -354,13 +401,12 @@ SedPlot2D::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedPlot2D::accept (SedVisitor& v) const
+SedPlot2D::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -430,6 +476,18 @@ SedPlot2D::writeAttributes (XMLOutputStream& stream) const
 }
 
 
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedPlot2D::addAttributes (XMLAttributes& attributes) const
+{
+	SedOutput::addAttributes(attributes);
+
+}
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -481,6 +539,13 @@ SedPlot2D_addCurve(SedPlot2D_t * spd, SedCurve_t * sc)
 	return  (spd != NULL) ? spd->addCurve(sc) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedPlot2D_addCurveAndOwn(SedPlot2D_t * spd, SedCurve_t * sc)
+{
+	return  (spd != NULL) ? spd->addCurveAndOwn(sc) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedCurve_t *
 SedPlot2D_createCurve(SedPlot2D_t * spd)
@@ -81,6 +81,7 @@ SedPlot3D::SedPlot3D (SedNamespaces* sedns)
  */
 SedPlot3D::SedPlot3D (const SedPlot3D& orig)
 	: SedOutput(orig)
+	, mSurface (orig.mSurface)
 {
 	if (&orig == NULL)
 	{
@@ -88,7 +89,6 @@ SedPlot3D::SedPlot3D (const SedPlot3D& orig)
 	}
 	else
 	{
-		mSurface  = orig.mSurface;
 
 		// connect to child objects
 		connectToChild();
@@ -227,6 +227,17 @@ SedPlot3D::addSurface(const SedSurface* ss)
 }
 
 
+/*
+ * Adds the given SedSurface to this SedPlot3D, which takes ownership of it.
+ */
+int
+SedPlot3D::addSurfaceAndOwn(SedSurface* ss)
+{
+	if(ss == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mSurface.appendAndOwn(ss);
+}
+
+
 /**
  * Get the number of SedSurface objects in this SedPlot3D.
  *
@@ -249,19 +260,22 @@ SedPlot3D::getNumSurfaces() const
 SedSurface* 
 SedPlot3D::createSurface()
 {
-	SedSurface *temp = new SedSurface();
+	if (isFrozen()) return NULL;
+	SedSurface *temp = new (getArena()) SedSurface();
 	if (temp != NULL) mSurface.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedPlot3DName("plot3D");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedPlot3D::getElementName () const
 {
-	static const string name = "plot3D";
-	return name;
+	return sSedPlot3DName;
 }
 
 
@@ -275,8 +289,6 @@ SedPlot3D::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedOutput::connectToChild();
-
 	if (name == "listOfSurfaces")
 	{
 		object = &mSurface;
@@ -298,6 +310,41 @@ SedPlot3D::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedPlot3D::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mSurface);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this Plot3D.
+ */
+unsigned int
+SedPlot3D::getNumChildElements () const
+{
+	return 1;
+}
+
+
+/*
+ * Returns the nth element directly contained in this Plot3D.
+ */
+const SedBase*
+SedPlot3D::getChildElement (unsigned int n) const
+{
+	return (n == 0) ? &mSurface : NULL;
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -354,13 +401,12 @@ SedPlot3D::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedPlot3D::accept (SedVisitor& v) const
+SedPlot3D::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -430,6 +476,18 @@ SedPlot3D::writeAttributes (XMLOutputStream& stream) const
 }
 
 
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedPlot3D::addAttributes (XMLAttributes& attributes) const
+{
+	SedOutput::addAttributes(attributes);
+
+}
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -481,6 +539,13 @@ SedPlot3D_addSurface(SedPlot3D_t * spd, SedSurface_t * ss)
 	return  (spd != NULL) ? spd->addSurface(ss) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedPlot3D_addSurfaceAndOwn(SedPlot3D_t * spd, SedSurface_t * ss)
+{
+	return  (spd != NULL) ? spd->addSurfaceAndOwn(ss) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedSurface_t *
 SedPlot3D_createSurface(SedPlot3D_t * spd)
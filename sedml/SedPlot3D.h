@@ -204,6 +204,25 @@ public:
 	int addSurface(const SedSurface* ss);
 
 
+	/**
+	 * Adds the given "SedSurface" to this SedPlot3D without copying it; this
+	 * SedPlot3D takes ownership of @p ss and will delete it.
+	 *
+	 * @param ss the SedSurface object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p ss is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addSurface(const SedSurface* ss)
+	 */
+	int addSurfaceAndOwn(SedSurface* ss);
+
+
 	/**
 	 * Get the number of SedSurface objects in this SedPlot3D.
 	 *
@@ -252,6 +271,33 @@ public:
 	SedSurface* removeSurface(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedPlot3D.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedPlot3D.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedPlot3D, is
 	 * always @c "sedPlot3D".
@@ -334,9 +380,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -408,6 +454,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -445,6 +498,11 @@ int
 SedPlot3D_addSurface(SedPlot3D_t * spd, SedSurface_t * ss);
 
 
+LIBSEDML_EXTERN
+int
+SedPlot3D_addSurfaceAndOwn(SedPlot3D_t * spd, SedSurface_t * ss);
+
+
 LIBSEDML_EXTERN
 SedSurface_t *
 SedPlot3D_createSurface(SedPlot3D_t * spd);
@@ -0,0 +1,523 @@
+/**
+ * @file    SedPlotDecimator.cpp
+ * @brief   Reduces the curves of a plot to the points a display can show
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedPlotDecimator.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns the n-th point of the points chosen from, by its index in the
+ * column.
+ */
+static size_t
+getIndex (const size_t* index, size_t n)
+{
+  return (index != NULL) ? index[n] : n;
+}
+
+
+/*
+ * Returns true if value is neither NaN nor infinite.
+ */
+static bool
+isFinite (double value)
+{
+  return value - value == 0;
+}
+
+
+/*
+ * Sets out to the logarithms of the length values; the loop has no
+ * branches, so that vectorising compilers call their vector logarithm.
+ * Values that are not positive give NaN or -INF, and are dropped later.
+ */
+static void
+transformLog (const double* values, size_t length, double* out)
+{
+  for (size_t i = 0; i < length; ++i)
+  {
+    out[i] = log10(values[i]);
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedPlotDecimator.
+ */
+SedPlotDecimator::SedPlotDecimator (size_t maxPoints, int method)
+  : mMaxPoints ((maxPoints < 3) ? 3 : maxPoints)
+  , mMethod ((method == SED_DECIMATION_MINMAX) ? SED_DECIMATION_MINMAX
+                                               : SED_DECIMATION_LTTB)
+{
+}
+
+
+/*
+ * Destroys this SedPlotDecimator.
+ */
+SedPlotDecimator::~SedPlotDecimator ()
+{
+}
+
+
+/*
+ * Sets the largest number of points kept of a curve.
+ */
+void
+SedPlotDecimator::setMaxPoints (size_t maxPoints)
+{
+  mMaxPoints = (maxPoints < 3) ? 3 : maxPoints;
+}
+
+
+/*
+ * Returns the largest number of points kept of a curve.
+ */
+size_t
+SedPlotDecimator::getMaxPoints () const
+{
+  return mMaxPoints;
+}
+
+
+/*
+ * Sets the method the points are chosen by.
+ */
+int
+SedPlotDecimator::setMethod (int method)
+{
+  if (method != SED_DECIMATION_LTTB && method != SED_DECIMATION_MINMAX)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mMethod = method;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the method the points are chosen by.
+ */
+int
+SedPlotDecimator::getMethod () const
+{
+  return mMethod;
+}
+
+
+/*
+ * Chooses the points of (x, y) to keep.
+ */
+void
+SedPlotDecimator::decimate (const double* x, const double* y, size_t length,
+                            bool logX, bool logY,
+                            std::vector<size_t>& indices) const
+{
+  indices.clear();
+  if (x == NULL || y == NULL || length == 0) return;
+
+  // the columns are used as they are unless points have to be dropped or
+  // the axes are logarithmic
+  bool drawable = !logX && !logY;
+  for (size_t i = 0; drawable && i < length; ++i)
+  {
+    drawable = isFinite(x[i]) && isFinite(y[i]);
+  }
+
+  if (drawable)
+  {
+    if (mMethod == SED_DECIMATION_MINMAX)
+    {
+      chooseMinMax(x, y, NULL, length, indices);
+    }
+    else
+    {
+      chooseLTTB(x, y, NULL, length, indices);
+    }
+    return;
+  }
+
+  std::vector<double> px(x, x + length);
+  std::vector<double> py(y, y + length);
+  std::vector<size_t> index(length);
+
+  if (logX) transformLog(x, length, &px[0]);
+  if (logY) transformLog(y, length, &py[0]);
+
+  // the points that can be drawn are moved to the front
+  size_t n = 0;
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (!isFinite(px[i]) || !isFinite(py[i])) continue;
+
+    px[n]    = px[i];
+    py[n]    = py[i];
+    index[n] = i;
+    ++n;
+  }
+  if (n == 0) return;
+
+  if (mMethod == SED_DECIMATION_MINMAX)
+  {
+    chooseMinMax(&px[0], &py[0], &index[0], n, indices);
+  }
+  else
+  {
+    chooseLTTB(&px[0], &py[0], &index[0], n, indices);
+  }
+}
+
+
+/*
+ * Sets x and y to the points of curve kept.
+ */
+int
+SedPlotDecimator::decimateCurve (const SedResults& results,
+                                 const SedCurve* curve,
+                                 std::vector<double>& x,
+                                 std::vector<double>& y) const
+{
+  x.clear();
+  y.clear();
+  if (curve == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const SedColumnView xs = results.getXView(curve);
+  const SedColumnView ys = results.getYView(curve);
+  if (xs.data == NULL || ys.data == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  std::vector<size_t> indices;
+  decimate(xs.data, ys.data, (xs.length < ys.length) ? xs.length : ys.length,
+           curve->getLogX(), curve->getLogY(), indices);
+
+  x.resize(indices.size());
+  y.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    x[i] = xs.data[indices[i]];
+    y[i] = ys.data[indices[i]];
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Keeps the points of every curve of plot.
+ */
+int
+SedPlotDecimator::decimatePlot (const SedResults& results,
+                                const SedPlot2D* plot)
+{
+  mSeries.clear();
+  if (plot == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  bool ok = true;
+  mSeries.resize(plot->getNumCurves());
+  for (unsigned int i = 0; i < plot->getNumCurves(); ++i)
+  {
+    const SedCurve* curve = plot->getCurve(i);
+    mSeries[i].id = curve->getId();
+    ok = decimateCurve(results, curve, mSeries[i].x, mSeries[i].y)
+           == LIBSEDML_OPERATION_SUCCESS && ok;
+  }
+
+  return ok ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns the number of series of the last decimatePlot().
+ */
+unsigned int
+SedPlotDecimator::getNumSeries () const
+{
+  return (unsigned int)mSeries.size();
+}
+
+
+/*
+ * Returns the id of the curve of the n-th series.
+ */
+const std::string&
+SedPlotDecimator::getSeriesId (unsigned int n) const
+{
+  static const std::string empty;
+  const Series* series = getSeries(n);
+  return (series != NULL) ? series->id : empty;
+}
+
+
+/*
+ * Returns the number of points of the n-th series.
+ */
+size_t
+SedPlotDecimator::getSeriesLength (unsigned int n) const
+{
+  const Series* series = getSeries(n);
+  return (series != NULL) ? series->x.size() : 0;
+}
+
+
+/*
+ * Returns the x values of the n-th series.
+ */
+const double*
+SedPlotDecimator::getSeriesX (unsigned int n) const
+{
+  const Series* series = getSeries(n);
+  return (series != NULL && !series->x.empty()) ? &series->x[0] : NULL;
+}
+
+
+/*
+ * Returns the y values of the n-th series.
+ */
+const double*
+SedPlotDecimator::getSeriesY (unsigned int n) const
+{
+  const Series* series = getSeries(n);
+  return (series != NULL && !series->y.empty()) ? &series->y[0] : NULL;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Chooses the points of the length points (x, y) by
+ * Largest-Triangle-Three-Buckets.
+ */
+void
+SedPlotDecimator::chooseLTTB (const double* x, const double* y,
+                              const size_t* index, size_t length,
+                              std::vector<size_t>& indices) const
+{
+  if (length <= mMaxPoints)
+  {
+    for (size_t i = 0; i < length; ++i) indices.push_back(getIndex(index, i));
+    return;
+  }
+
+  // the points between the first and the last go into mMaxPoints - 2
+  // buckets, bucket b being [start(b), start(b + 1))
+  const double every = (double)(length - 2) / (double)(mMaxPoints - 2);
+  size_t kept = 0;
+  indices.push_back(getIndex(index, 0));
+
+  for (size_t b = 0; b + 2 < mMaxPoints; ++b)
+  {
+    const size_t start = (size_t)(b * every) + 1;
+    const size_t end   = (size_t)((b + 1) * every) + 1;
+
+    // the third corner is the average of the next bucket, or the last
+    // point after the last bucket
+    size_t nextStart = end;
+    size_t nextEnd   = (size_t)((b + 2) * every) + 1;
+    if (nextEnd > length) nextEnd = length;
+    if (nextStart >= nextEnd)
+    {
+      nextStart = length - 1;
+      nextEnd   = length;
+    }
+
+    double avgX = 0;
+    double avgY = 0;
+    for (size_t i = nextStart; i < nextEnd; ++i)
+    {
+      avgX += x[i];
+      avgY += y[i];
+    }
+    avgX /= (double)(nextEnd - nextStart);
+    avgY /= (double)(nextEnd - nextStart);
+
+    const double ax = x[kept];
+    const double ay = y[kept];
+    double largest = -1;
+    size_t chosen  = start;
+
+    for (size_t i = start; i < end && i < length - 1; ++i)
+    {
+      const double area = fabs((ax - avgX) * (y[i] - ay)
+                               - (ax - x[i]) * (avgY - ay));
+      if (area > largest)
+      {
+        largest = area;
+        chosen  = i;
+      }
+    }
+
+    indices.push_back(getIndex(index, chosen));
+    kept = chosen;
+  }
+
+  indices.push_back(getIndex(index, length - 1));
+}
+
+
+/*
+ * Chooses the points of the length points (x, y) of least and greatest y
+ * of every bucket.
+ */
+void
+SedPlotDecimator::chooseMinMax (const double*, const double* y,
+                                const size_t* index, size_t length,
+                                std::vector<size_t>& indices) const
+{
+  if (length <= mMaxPoints)
+  {
+    for (size_t i = 0; i < length; ++i) indices.push_back(getIndex(index, i));
+    return;
+  }
+
+  // the first and last points are kept, and two of every bucket between
+  const size_t numBuckets = (mMaxPoints - 2) / 2;
+  const size_t inner      = length - 2;
+  indices.push_back(getIndex(index, 0));
+
+  for (size_t b = 0; b < numBuckets; ++b)
+  {
+    const size_t start = 1 + (size_t)((double)b * inner / numBuckets);
+    const size_t end   = 1 + (size_t)((double)(b + 1) * inner / numBuckets);
+    if (start >= end) continue;
+
+    size_t low  = start;
+    size_t high = start;
+    for (size_t i = start + 1; i < end; ++i)
+    {
+      if (y[i] < y[low])  low  = i;
+      if (y[i] > y[high]) high = i;
+    }
+
+    const size_t first  = (low < high) ? low : high;
+    const size_t second = (low < high) ? high : low;
+    indices.push_back(getIndex(index, first));
+    if (second != first) indices.push_back(getIndex(index, second));
+  }
+
+  indices.push_back(getIndex(index, length - 1));
+}
+
+
+/*
+ * Returns the n-th series, or NULL.
+ */
+const SedPlotDecimator::Series*
+SedPlotDecimator::getSeries (unsigned int n) const
+{
+  return (n < mSeries.size()) ? &mSeries[n] : NULL;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedPlotDecimator and returns it.
+ */
+LIBSEDML_EXTERN
+SedPlotDecimator_t *
+SedPlotDecimator_create (size_t maxPoints, int method)
+{
+  return new (nothrow) SedPlotDecimator(maxPoints, method);
+}
+
+
+/**
+ * Frees the given SedPlotDecimator.
+ */
+LIBSEDML_EXTERN
+void
+SedPlotDecimator_free (SedPlotDecimator_t *spd)
+{
+  delete spd;
+}
+
+
+/**
+ * Keeps the points of every curve of plot worth drawing.
+ */
+LIBSEDML_EXTERN
+int
+SedPlotDecimator_decimatePlot (SedPlotDecimator_t *spd,
+                               const SedResults_t *results,
+                               const SedPlot2D_t *plot)
+{
+  if (spd == NULL || results == NULL) return LIBSEDML_INVALID_OBJECT;
+  return spd->decimatePlot(*results, plot);
+}
+
+
+/**
+ * Returns the number of series of the last decimation of a plot.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedPlotDecimator_getNumSeries (const SedPlotDecimator_t *spd)
+{
+  return (spd != NULL) ? spd->getNumSeries() : 0;
+}
+
+
+/**
+ * Returns a view of the x values of the n-th series.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedPlotDecimator_getSeriesX (const SedPlotDecimator_t *spd, unsigned int n)
+{
+  SedColumnView view;
+  view.data   = (spd != NULL) ? spd->getSeriesX(n) : NULL;
+  view.length = (view.data != NULL) ? spd->getSeriesLength(n) : 0;
+  return view;
+}
+
+
+/**
+ * Returns a view of the y values of the n-th series.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedPlotDecimator_getSeriesY (const SedPlotDecimator_t *spd, unsigned int n)
+{
+  SedColumnView view;
+  view.data   = (spd != NULL) ? spd->getSeriesY(n) : NULL;
+  view.length = (view.data != NULL) ? spd->getSeriesLength(n) : 0;
+  return view;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
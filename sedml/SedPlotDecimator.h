@@ -0,0 +1,303 @@
+/**
+ * @file    SedPlotDecimator.h
+ * @brief   Reduces the curves of a plot to the points a display can show
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedPlotDecimator
+ * @ingroup Core
+ * @brief Picks the points of the curves of a SedPlot2D worth drawing.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A curve of a million points is drawn on a few hundred pixels.  A
+ * SedPlotDecimator keeps at most getMaxPoints() points of every SedCurve,
+ * chosen so that the line drawn through them looks like the line through
+ * all of them:
+ *
+ * @li @c SED_DECIMATION_LTTB, Largest-Triangle-Three-Buckets, splits the
+ * points between the first and the last into buckets, and keeps of every
+ * bucket the point that makes the largest triangle with the point kept
+ * before it and the average of the next bucket;
+ * @li @c SED_DECIMATION_MINMAX splits them into half as many buckets, and
+ * keeps the points of least and greatest y of every bucket, in their
+ * order, so that no peak is lost.
+ *
+ * Areas and extremes are measured where the curve is drawn: on a
+ * logarithmic axis (see SedCurve::getLogX() and SedCurve::getLogY()), in
+ * the logarithms of the values, which are computed for a whole column at
+ * a time before the points are chosen.  Points that cannot be drawn, with
+ * a NaN value or a value that is not positive on a logarithmic axis, are
+ * dropped.  The points kept keep their values, not their logarithms.
+ *
+ * decimatePlot() keeps the series of every curve of a plot, which are
+ * then available by index until the next call.
+ */
+
+#ifndef SedPlotDecimator_h
+#define SedPlotDecimator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedResults.h>
+
+#include <stddef.h>
+
+
+/**
+ * The ways a SedPlotDecimator chooses points.
+ */
+typedef enum
+{
+    SED_DECIMATION_LTTB   = 0 /*!< Largest-Triangle-Three-Buckets */
+  , SED_DECIMATION_MINMAX = 1 /*!< The least and greatest y of every bucket */
+} SedDecimationMethod_t;
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedCurve;
+class SedPlot2D;
+
+
+class LIBSEDML_EXTERN SedPlotDecimator
+{
+public:
+
+  /**
+   * Creates a new SedPlotDecimator keeping at most @p maxPoints points of
+   * every curve, chosen by the #SedDecimationMethod_t @p method.
+   */
+  SedPlotDecimator (size_t maxPoints = 2048,
+                    int method = SED_DECIMATION_LTTB);
+
+
+  /**
+   * Destroys this SedPlotDecimator.
+   */
+  virtual ~SedPlotDecimator ();
+
+
+  /**
+   * Sets the largest number of points kept of a curve; fewer than 3 are
+   * taken to be 3.
+   */
+  void setMaxPoints (size_t maxPoints);
+
+
+  /**
+   * @return the largest number of points kept of a curve.
+   */
+  size_t getMaxPoints () const;
+
+
+  /**
+   * Sets the #SedDecimationMethod_t the points are chosen by.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p method is not a #SedDecimationMethod_t
+   */
+  int setMethod (int method);
+
+
+  /**
+   * @return the #SedDecimationMethod_t the points are chosen by.
+   */
+  int getMethod () const;
+
+
+  /**
+   * Chooses the points of the @p length points (@p x[i], @p y[i]) to
+   * keep, measured on logarithmic axes where @p logX and @p logY say, and
+   * sets @p indices to their indices, in increasing order.
+   */
+  void decimate (const double* x, const double* y, size_t length,
+                 bool logX, bool logY, std::vector<size_t>& indices) const;
+
+
+  /**
+   * Sets @p x and @p y to the points of @p curve kept, its columns taken
+   * from @p results; the points of a curve whose columns differ in length
+   * go as far as the shorter.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p curve is @c NULL or @p results lacks one of its columns
+   */
+  int decimateCurve (const SedResults& results, const SedCurve* curve,
+                     std::vector<double>& x, std::vector<double>& y) const;
+
+
+  /**
+   * Keeps the points of every curve of @p plot, replacing the series of
+   * an earlier call; a curve that cannot be decimated has an empty series.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p plot is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any curve could not be decimated
+   */
+  int decimatePlot (const SedResults& results, const SedPlot2D* plot);
+
+
+  /**
+   * @return the number of series of the last decimatePlot(), one per
+   * curve.
+   */
+  unsigned int getNumSeries () const;
+
+
+  /**
+   * @return the id of the curve of the n-th series, or an empty string if
+   * @p n is out of range.
+   */
+  const std::string& getSeriesId (unsigned int n) const;
+
+
+  /**
+   * @return the number of points of the n-th series.
+   */
+  size_t getSeriesLength (unsigned int n) const;
+
+
+  /**
+   * @return the x values of the n-th series, or @c NULL if it is empty.
+   */
+  const double* getSeriesX (unsigned int n) const;
+
+
+  /**
+   * @return the y values of the n-th series, or @c NULL if it is empty.
+   */
+  const double* getSeriesY (unsigned int n) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Series
+  {
+    std::string          id;
+    std::vector<double>  x;
+    std::vector<double>  y;
+  };
+
+  void chooseLTTB (const double* x, const double* y,
+                   const size_t* index, size_t length,
+                   std::vector<size_t>& indices) const;
+
+  void chooseMinMax (const double* x, const double* y,
+                     const size_t* index, size_t length,
+                     std::vector<size_t>& indices) const;
+
+  const Series* getSeries (unsigned int n) const;
+
+
+  size_t               mMaxPoints;
+  int                  mMethod;
+  std::vector<Series>  mSeries;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedPlotDecimator keeping at most @p maxPoints points of
+ * every curve, chosen by @p method, and returns it.
+ */
+LIBSEDML_EXTERN
+SedPlotDecimator_t *
+SedPlotDecimator_create (size_t maxPoints, int method);
+
+
+/**
+ * Frees the given SedPlotDecimator.
+ */
+LIBSEDML_EXTERN
+void
+SedPlotDecimator_free (SedPlotDecimator_t *spd);
+
+
+/**
+ * Keeps the points of every curve of @p plot worth drawing.
+ */
+LIBSEDML_EXTERN
+int
+SedPlotDecimator_decimatePlot (SedPlotDecimator_t *spd,
+                               const SedResults_t *results,
+                               const SedPlot2D_t *plot);
+
+
+/**
+ * Returns the number of series of the last decimation of a plot.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedPlotDecimator_getNumSeries (const SedPlotDecimator_t *spd);
+
+
+/**
+ * Returns a view of the x values of the n-th series.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedPlotDecimator_getSeriesX (const SedPlotDecimator_t *spd, unsigned int n);
+
+
+/**
+ * Returns a view of the y values of the n-th series.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedPlotDecimator_getSeriesY (const SedPlotDecimator_t *spd, unsigned int n);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedPlotDecimator_h */
@@ -0,0 +1,338 @@
+/**
+ * @file    SedProfiler.cpp
+ * @brief   Counts and times what reading, writing and executing do
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedProfiler.h>
+#include <sedml/common/threads.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <time.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * A profiler calling a C function, used by
+ * SedProfiler_createWithCallback().
+ */
+class SedCallbackProfiler : public SedProfiler
+{
+public:
+
+  SedCallbackProfiler (SedProfilerCallback callback, void* userData)
+    : mCallback (callback)
+    , mUserData (userData)
+  {
+  }
+
+  virtual void record (const SedProfileCounters& counters)
+  {
+    SedProfiler::record(counters);
+    mCallback(&counters, mUserData);
+  }
+
+private:
+
+  SedProfilerCallback mCallback;
+  void*               mUserData;
+};
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedProfiler with all counters 0.
+ */
+SedProfiler::SedProfiler ()
+  : mLock (NULL)
+{
+  clear(mCounters);
+
+  SedMutex* mutex = new SedMutex;
+  mutexInit(mutex);
+  mLock = mutex;
+}
+
+
+/*
+ * Destroys this SedProfiler.
+ */
+SedProfiler::~SedProfiler ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexFree(mutex);
+  delete mutex;
+}
+
+
+/*
+ * Adds counters to the totals.
+ */
+void
+SedProfiler::record (const SedProfileCounters& counters)
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+  add(mCounters, counters);
+  mutexUnlock(mutex);
+}
+
+
+/*
+ * Returns a copy of the totals.
+ */
+SedProfileCounters
+SedProfiler::getCounters () const
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+  const SedProfileCounters counters = mCounters;
+  mutexUnlock(mutex);
+
+  return counters;
+}
+
+
+/*
+ * Sets all totals to 0.
+ */
+void
+SedProfiler::reset ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+  clear(mCounters);
+  mutexUnlock(mutex);
+}
+
+
+/*
+ * Returns true if libSEDML was compiled with the counting.
+ */
+bool
+SedProfiler::isEnabled ()
+{
+#ifdef USE_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Returns a monotonic time in seconds.
+ */
+double
+SedProfiler::getTime ()
+{
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+
+/*
+ * Sets all of counters to 0.
+ */
+void
+SedProfiler::clear (SedProfileCounters& counters)
+{
+  memset(&counters, 0, sizeof(counters));
+}
+
+
+/*
+ * Adds counters to total.
+ */
+void
+SedProfiler::add (SedProfileCounters& total,
+                  const SedProfileCounters& counters)
+{
+  for (unsigned int i = 0; i < SED_PROFILE_NUM_TYPECODES; ++i)
+  {
+    total.numRead[i]    += counters.numRead[i];
+    total.readTime[i]   += counters.readTime[i];
+    total.numWritten[i] += counters.numWritten[i];
+    total.writeTime[i]  += counters.writeTime[i];
+  }
+
+  total.numMathRead    += counters.numMathRead;
+  total.mathReadTime   += counters.mathReadTime;
+  total.numMathWritten += counters.numMathWritten;
+  total.mathWriteTime  += counters.mathWriteTime;
+
+  total.numAllocations += counters.numAllocations;
+  total.bytesRead      += counters.bytesRead;
+  total.bytesWritten   += counters.bytesWritten;
+
+  total.numSteps       += counters.numSteps;
+  total.stepWaitTime   += counters.stepWaitTime;
+  total.stepRunTime    += counters.stepRunTime;
+  if (counters.maxStepWaitTime > total.maxStepWaitTime)
+  {
+    total.maxStepWaitTime = counters.maxStepWaitTime;
+  }
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Creates a new SedProfileRecorder with all counters 0.
+ */
+SedProfileRecorder::SedProfileRecorder ()
+  : mNested (0)
+{
+  SedProfiler::clear(mCounters);
+}
+
+
+/*
+ * Counts one element or piece of MathML of kind that took time.
+ */
+void
+SedProfileRecorder::add (Kind kind, int typeCode, double time)
+{
+  const int i = (typeCode > 0 && typeCode < SED_PROFILE_NUM_TYPECODES)
+              ? typeCode : 0;
+
+  switch (kind)
+  {
+  case READ:
+    ++mCounters.numRead[i];
+    mCounters.readTime[i] += time;
+    break;
+
+  case WRITE:
+    ++mCounters.numWritten[i];
+    mCounters.writeTime[i] += time;
+    break;
+
+  case MATH_READ:
+    ++mCounters.numMathRead;
+    mCounters.mathReadTime += time;
+    break;
+
+  case MATH_WRITE:
+    ++mCounters.numMathWritten;
+    mCounters.mathWriteTime += time;
+    break;
+  }
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedProfiler and returns it.
+ */
+LIBSEDML_EXTERN
+SedProfiler_t *
+SedProfiler_create (void)
+{
+  return new (nothrow) SedProfiler();
+}
+
+
+/**
+ * Creates a new SedProfiler that also passes what it records to callback.
+ */
+LIBSEDML_EXTERN
+SedProfiler_t *
+SedProfiler_createWithCallback (SedProfilerCallback callback,
+                                void *userData)
+{
+  if (callback == NULL) return NULL;
+  return new (nothrow) SedCallbackProfiler(callback, userData);
+}
+
+
+/**
+ * Frees the given SedProfiler.
+ */
+LIBSEDML_EXTERN
+void
+SedProfiler_free (SedProfiler_t *sp)
+{
+  delete sp;
+}
+
+
+/**
+ * Copies the totals of the given SedProfiler to counters.
+ */
+LIBSEDML_EXTERN
+int
+SedProfiler_getCounters (const SedProfiler_t *sp,
+                         SedProfileCounters *counters)
+{
+  if (sp == NULL || counters == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  *counters = sp->getCounters();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets all totals of the given SedProfiler to 0.
+ */
+LIBSEDML_EXTERN
+void
+SedProfiler_reset (SedProfiler_t *sp)
+{
+  if (sp != NULL) sp->reset();
+}
+
+
+/**
+ * Returns non-zero if libSEDML was compiled with the counting.
+ */
+LIBSEDML_EXTERN
+int
+SedProfiler_isEnabled (void)
+{
+  return SedProfiler::isEnabled() ? 1 : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,330 @@
+/**
+ * @file    SedProfiler.h
+ * @brief   Counts and times what reading, writing and executing do
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedProfiler
+ * @ingroup Core
+ * @brief Collects the counters of the readers, writers and executors it is
+ * given to.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedProfiler set on a SedReader, SedWriter or SedExecutor (see
+ * SedReader::setProfiler(), SedWriter::setProfiler() and
+ * SedExecutor::setProfiler()) is handed a SedProfileCounters after every
+ * document read or written and every step run, with what was counted
+ * meanwhile:
+ *
+ * @li the number of elements read and written, and the time spent on
+ * them, per type code;
+ * @li the same for MathML;
+ * @li the number of objects allocated while reading;
+ * @li the number of bytes read and written;
+ * @li the time the steps of an executor waited in its queues once they
+ * were ready, and the time they ran.
+ *
+ * record() adds them to the totals returned by getCounters(); a subclass
+ * may override it to pass them on as well, for instance to a monitoring
+ * system.  One SedProfiler can be shared by readers, writers and executors
+ * working in several threads.
+ *
+ * The counting is compiled into libSEDML only if it was configured with
+ * @c WITH_PROFILING, which isEnabled() tells; otherwise nothing is
+ * counted, there is no cost, and record() is never called.
+ */
+
+#ifndef SedProfiler_h
+#define SedProfiler_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+/**
+ * The number of type codes counted separately; larger type codes, such as
+ * those of packages, are counted as @c SEDML_UNKNOWN.
+ */
+#define SED_PROFILE_NUM_TYPECODES 128
+
+
+/**
+ * What a SedProfiler counts.  Times are in seconds; the time of an element
+ * does not include that of the elements and MathML inside it.
+ */
+typedef struct
+{
+  unsigned long numRead[SED_PROFILE_NUM_TYPECODES];
+  double        readTime[SED_PROFILE_NUM_TYPECODES];
+  unsigned long numWritten[SED_PROFILE_NUM_TYPECODES];
+  double        writeTime[SED_PROFILE_NUM_TYPECODES];
+
+  unsigned long numMathRead;
+  double        mathReadTime;
+  unsigned long numMathWritten;
+  double        mathWriteTime;
+
+  unsigned long numAllocations;
+  size_t        bytesRead;
+  size_t        bytesWritten;
+
+  unsigned long numSteps;
+  double        stepWaitTime;
+  double        maxStepWaitTime;
+  double        stepRunTime;
+} SedProfileCounters;
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedProfiler
+{
+public:
+
+  /**
+   * Creates a new SedProfiler with all counters 0.
+   */
+  SedProfiler ();
+
+
+  /**
+   * Destroys this SedProfiler.
+   */
+  virtual ~SedProfiler ();
+
+
+  /**
+   * Adds @p counters, what one read, write or step counted, to the
+   * totals.  Called from the thread that did the work.
+   */
+  virtual void record (const SedProfileCounters& counters);
+
+
+  /**
+   * @return a copy of the totals.
+   */
+  SedProfileCounters getCounters () const;
+
+
+  /**
+   * Sets all totals to 0.
+   */
+  void reset ();
+
+
+  /**
+   * @return @c true if libSEDML was compiled with the counting.
+   */
+  static bool isEnabled ();
+
+
+  /**
+   * @return a time in seconds, only meaningful relative to other values
+   * it returns.
+   */
+  static double getTime ();
+
+
+  /**
+   * Sets all of @p counters to 0.
+   */
+  static void clear (SedProfileCounters& counters);
+
+
+  /**
+   * Adds @p counters to @p total.
+   */
+  static void add (SedProfileCounters& total,
+                   const SedProfileCounters& counters);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedProfileCounters  mCounters;
+  void*               mLock;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedProfiler (const SedProfiler& orig);
+  SedProfiler& operator= (const SedProfiler& rhs);
+
+  /** @endcond */
+};
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The counters of one read or write in progress, which a SedDocument
+ * points to while it lasts; used from one thread only.  mNested is the
+ * time of the scopes inside the innermost open one.
+ */
+class LIBSEDML_EXTERN SedProfileRecorder
+{
+public:
+
+  enum Kind
+  {
+      READ
+    , WRITE
+    , MATH_READ
+    , MATH_WRITE
+  };
+
+  SedProfileRecorder ();
+
+  void add (Kind kind, int typeCode, double time);
+
+  SedProfileCounters  mCounters;
+  double              mNested;
+};
+
+
+/*
+ * Times the scope it lives in as kind for recorder, unless that is NULL.
+ */
+class SedProfileScope
+{
+public:
+
+  SedProfileScope (SedProfileRecorder* recorder,
+                   SedProfileRecorder::Kind kind, int typeCode = 0)
+    : mRecorder (recorder)
+    , mKind (kind)
+    , mTypeCode (typeCode)
+    , mStart (0)
+    , mOuter (0)
+  {
+    if (mRecorder == NULL) return;
+
+    mOuter = mRecorder->mNested;
+    mRecorder->mNested = 0;
+    mStart = SedProfiler::getTime();
+  }
+
+  ~SedProfileScope ()
+  {
+    if (mRecorder == NULL) return;
+
+    const double elapsed = SedProfiler::getTime() - mStart;
+    mRecorder->add(mKind, mTypeCode, elapsed - mRecorder->mNested);
+    mRecorder->mNested = mOuter + elapsed;
+  }
+
+private:
+
+  SedProfileRecorder*       mRecorder;
+  SedProfileRecorder::Kind  mKind;
+  int                       mTypeCode;
+  double                    mStart;
+  double                    mOuter;
+};
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * The function a SedProfiler created by SedProfiler_createWithCallback()
+ * passes the counters of every read, write and step to, with the user
+ * data given there.
+ */
+typedef void (*SedProfilerCallback) (const SedProfileCounters *counters,
+                                     void *userData);
+
+
+/**
+ * Creates a new SedProfiler and returns it.
+ */
+LIBSEDML_EXTERN
+SedProfiler_t *
+SedProfiler_create (void);
+
+
+/**
+ * Creates a new SedProfiler that also passes what it records to
+ * @p callback, and returns it.
+ */
+LIBSEDML_EXTERN
+SedProfiler_t *
+SedProfiler_createWithCallback (SedProfilerCallback callback,
+                                void *userData);
+
+
+/**
+ * Frees the given SedProfiler.
+ */
+LIBSEDML_EXTERN
+void
+SedProfiler_free (SedProfiler_t *sp);
+
+
+/**
+ * Copies the totals of the given SedProfiler to @p counters.
+ */
+LIBSEDML_EXTERN
+int
+SedProfiler_getCounters (const SedProfiler_t *sp,
+                         SedProfileCounters *counters);
+
+
+/**
+ * Sets all totals of the given SedProfiler to 0.
+ */
+LIBSEDML_EXTERN
+void
+SedProfiler_reset (SedProfiler_t *sp);
+
+
+/**
+ * Returns non-zero if libSEDML was compiled with the counting.
+ */
+LIBSEDML_EXTERN
+int
+SedProfiler_isEnabled (void);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedProfiler_h */
@@ -0,0 +1,293 @@
+/**
+ * @file    SedRandomStream.cpp
+ * @brief   Counter-based random numbers for stochastic tasks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedRandomStream.h>
+
+#include <cmath>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const unsigned int SED_PHILOX_M0 = 0xD2511F53u;
+static const unsigned int SED_PHILOX_M1 = 0xCD9E8D57u;
+static const unsigned int SED_PHILOX_W0 = 0x9E3779B9u;
+static const unsigned int SED_PHILOX_W1 = 0xBB67AE85u;
+
+
+static unsigned int
+low (unsigned long long value)
+{
+  return (unsigned int)(value & 0xFFFFFFFFu);
+}
+
+
+static unsigned int
+high (unsigned long long value)
+{
+  return (unsigned int)((value >> 32) & 0xFFFFFFFFu);
+}
+
+
+/*
+ * The finaliser of SplitMix64, which spreads every bit of value over all
+ * bits of the result.
+ */
+static unsigned long long
+mix (unsigned long long value)
+{
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ull;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBull;
+  value ^= value >> 31;
+  return value;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates the stream stream of the generator keyed key.
+ */
+SedRandomStream::SedRandomStream (unsigned long long key,
+                                  unsigned long long stream)
+  : mStream (stream)
+  , mBlock (0)
+  , mUsed (4)
+{
+  mKey[0] = low(key);
+  mKey[1] = high(key);
+}
+
+
+/*
+ * Returns the key of the runs of the task with the given fingerprint.
+ */
+unsigned long long
+SedRandomStream::deriveKey (unsigned long long seed,
+                            const std::string& fingerprint)
+{
+  // FNV-1a over the fingerprint, then mixed with the seed
+  unsigned long long hash = 0xCBF29CE484222325ull;
+  for (std::string::size_type i = 0; i < fingerprint.size(); ++i)
+  {
+    hash ^= (unsigned char)fingerprint[i];
+    hash *= 0x100000001B3ull;
+  }
+
+  return mix(mix(seed + 0x9E3779B97F4A7C15ull) ^ hash);
+}
+
+
+/*
+ * Returns the key of this stream.
+ */
+unsigned long long
+SedRandomStream::getKey () const
+{
+  return ((unsigned long long)mKey[1] << 32) | mKey[0];
+}
+
+
+/*
+ * Returns the stream number of this stream.
+ */
+unsigned long long
+SedRandomStream::getStream () const
+{
+  return mStream;
+}
+
+
+/*
+ * Returns the next 32 random bits.
+ */
+unsigned int
+SedRandomStream::nextInt ()
+{
+  if (mUsed == 4) generate();
+  return mBuffer[mUsed++];
+}
+
+
+/*
+ * Returns the next number uniform in [0, 1).
+ */
+double
+SedRandomStream::nextDouble ()
+{
+  const unsigned int a = nextInt() >> 5;
+  const unsigned int b = nextInt() >> 6;
+  return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+}
+
+
+/*
+ * Returns the next number uniform in (0, 1).
+ */
+double
+SedRandomStream::nextOpenDouble ()
+{
+  double value = 0;
+  do
+  {
+    value = nextDouble();
+  }
+  while (value == 0);
+  return value;
+}
+
+
+/*
+ * Returns the next number exponentially distributed with rate.
+ */
+double
+SedRandomStream::nextExponential (double rate)
+{
+  return -log(nextOpenDouble()) / rate;
+}
+
+
+/*
+ * Moves to the number drawn after position numbers.
+ */
+void
+SedRandomStream::seek (unsigned long long position)
+{
+  mBlock = position / 4;
+  mUsed  = 4;
+
+  const unsigned int used = (unsigned int)(position % 4);
+  if (used != 0)
+  {
+    generate();
+    mUsed = used;
+  }
+}
+
+
+/*
+ * Returns the number of numbers drawn so far.
+ */
+unsigned long long
+SedRandomStream::getPosition () const
+{
+  return mBlock * 4 - 4 + mUsed;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Computes block mBlock of the stream into mBuffer, and moves on to the
+ * next block.
+ */
+void
+SedRandomStream::generate ()
+{
+  unsigned int counter[4] =
+  {
+    low(mBlock), high(mBlock), low(mStream), high(mStream)
+  };
+  unsigned int key[2] = { mKey[0], mKey[1] };
+
+  for (int round = 0; round < 10; ++round)
+  {
+    const unsigned long long product0 =
+      (unsigned long long)SED_PHILOX_M0 * counter[0];
+    const unsigned long long product1 =
+      (unsigned long long)SED_PHILOX_M1 * counter[2];
+
+    const unsigned int next[4] =
+    {
+      high(product1) ^ counter[1] ^ key[0],
+      low(product1),
+      high(product0) ^ counter[3] ^ key[1],
+      low(product0)
+    };
+    for (int i = 0; i < 4; ++i) counter[i] = next[i];
+
+    key[0] = low((unsigned long long)key[0] + SED_PHILOX_W0);
+    key[1] = low((unsigned long long)key[1] + SED_PHILOX_W1);
+  }
+
+  for (int i = 0; i < 4; ++i) mBuffer[i] = counter[i];
+  mUsed = 0;
+  ++mBlock;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates the stream stream of the generator keyed key and returns it.
+ */
+LIBSEDML_EXTERN
+SedRandomStream_t *
+SedRandomStream_create (unsigned long long key, unsigned long long stream)
+{
+  return new (nothrow) SedRandomStream(key, stream);
+}
+
+
+/**
+ * Frees the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+void
+SedRandomStream_free (SedRandomStream_t *srs)
+{
+  delete srs;
+}
+
+
+/**
+ * Returns the next 32 random bits of the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedRandomStream_nextInt (SedRandomStream_t *srs)
+{
+  return (srs != NULL) ? srs->nextInt() : 0;
+}
+
+
+/**
+ * Returns the next number uniform in [0, 1) of the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+double
+SedRandomStream_nextDouble (SedRandomStream_t *srs)
+{
+  return (srs != NULL) ? srs->nextDouble() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
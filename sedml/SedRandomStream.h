@@ -0,0 +1,194 @@
+/**
+ * @file    SedRandomStream.h
+ * @brief   Counter-based random numbers for stochastic tasks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedRandomStream
+ * @ingroup Core
+ * @brief The random numbers of one run of a stochastic task.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedRandomStream is the Philox4x32-10 generator: the n-th block of four
+ * 32-bit numbers is a keyed bijection of the counter (n, stream), so that
+ * any number of a stream is computed from its position alone, and streams
+ * with different keys or stream numbers are independent, but nothing is
+ * shared between them.  A stream is a few words, copied freely, and needs
+ * no lock.
+ *
+ * The SedExecutor derives the key of a task from its seed (see
+ * SedExecutor::setSeed()) and the fingerprint of the task, that is the
+ * model, simulation and algorithm it runs (see
+ * SedResultCache::getFingerprint()), with deriveKey(); the points of a
+ * SedSweep over the task, its replicates, have the stream numbers 1, 2,
+ * ..., the task itself 0.  The numbers a run draws therefore depend on
+ * what it runs, never on the thread it runs on or on the order in which
+ * the runs are scheduled, and the results are the same for any number
+ * of threads.
+ */
+
+#ifndef SedRandomStream_h
+#define SedRandomStream_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedRandomStream
+{
+public:
+
+  /**
+   * Creates the stream @p stream of the generator keyed @p key, at its
+   * first number.
+   */
+  SedRandomStream (unsigned long long key = 0, unsigned long long stream = 0);
+
+
+  /**
+   * @return the key of the runs of the task with the fingerprint
+   * @p fingerprint, under @p seed.
+   */
+  static unsigned long long deriveKey (unsigned long long seed,
+                                       const std::string& fingerprint);
+
+
+  /**
+   * @return the key of this stream.
+   */
+  unsigned long long getKey () const;
+
+
+  /**
+   * @return the stream number of this stream.
+   */
+  unsigned long long getStream () const;
+
+
+  /**
+   * @return the next 32 random bits.
+   */
+  unsigned int nextInt ();
+
+
+  /**
+   * @return the next number uniform in [0, 1), with 53 random bits.
+   */
+  double nextDouble ();
+
+
+  /**
+   * @return the next number uniform in (0, 1), which may be passed to a
+   * logarithm.
+   */
+  double nextOpenDouble ();
+
+
+  /**
+   * @return the next number exponentially distributed with @p rate, such
+   * as the waiting time to the next reaction of a Gillespie method.
+   */
+  double nextExponential (double rate);
+
+
+  /**
+   * Moves to the number drawn after @p position 32-bit numbers.
+   */
+  void seek (unsigned long long position);
+
+
+  /**
+   * @return the number of 32-bit numbers drawn so far.
+   */
+  unsigned long long getPosition () const;
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  void generate ();
+
+  unsigned int        mKey[2];
+  unsigned long long  mStream;
+  unsigned long long  mBlock;
+  unsigned int        mBuffer[4];
+  unsigned int        mUsed;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates the stream @p stream of the generator keyed @p key and returns
+ * it.
+ */
+LIBSEDML_EXTERN
+SedRandomStream_t *
+SedRandomStream_create (unsigned long long key, unsigned long long stream);
+
+
+/**
+ * Frees the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+void
+SedRandomStream_free (SedRandomStream_t *srs);
+
+
+/**
+ * Returns the next 32 random bits of the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedRandomStream_nextInt (SedRandomStream_t *srs);
+
+
+/**
+ * Returns the next number uniform in [0, 1) of the given SedRandomStream.
+ */
+LIBSEDML_EXTERN
+double
+SedRandomStream_nextDouble (SedRandomStream_t *srs);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedRandomStream_h */
@@ -34,10 +34,30 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedError.h>
 #include <sedml/SedReader.h>
+#include <sedml/SedProfiler.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedXMLTree.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/InputDecompressor.h>
 
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+/* the XML parser chosen with the CMake option LIBSEDML_XML_PARSER */
+#ifndef LIBSEDML_XML_PARSER
+#  define LIBSEDML_XML_PARSER ""
+#endif
+
 /** @cond doxygen-ignored */
 
 using namespace std;
@@ -50,6 +70,15 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedReader and returns it. 
  */
 SedReader::SedReader ()
+  : mDeferNotesAndAnnotations (false)
+  , mUseArena (false)
+  , mMaxErrorsPerId (0)
+  , mMaxErrors (0)
+  , mStopAtErrorLimit (false)
+  , mStructureOnlyDepth (0)
+  , mMaxXMLDepth (SedXMLTree::DEFAULT_MAX_DEPTH)
+  , mXMLParser (LIBSEDML_XML_PARSER)
+  , mProfiler (NULL)
 {
 }
 
@@ -131,9 +160,9 @@ SedReader::readSedMLFromString (const std::string& xml)
 {
   if (&xml == NULL) return NULL;
 
-  const static string dummy_xml ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");  
+  const char* dummy_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
   
-  if (!strncmp(xml.c_str(), dummy_xml.c_str(), 14))
+  if (!strncmp(xml.c_str(), dummy_xml, 14))
   {
     return readInternal(xml.c_str(), false);
   }
@@ -147,6 +176,164 @@ SedReader::readSedMLFromString (const std::string& xml)
 }
 
 
+/*
+ * Reads an Sed document from the first length bytes of buffer.
+ */
+SedDocument*
+SedReader::readSedMLFromBuffer (const char* buffer, size_t length)
+{
+  if (buffer == NULL) return readSedMLFromString("");
+
+  const char* dummy_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+  bool hasDecl = (length >= 14 && !strncmp(buffer, dummy_xml, 14));
+
+  // XMLInputStream needs a NUL terminated string; only copy when the
+  // buffer does not provide one (or lacks the XML declaration)
+  if (hasDecl && memchr(buffer, '\0', length) != NULL)
+  {
+    return readInternal(buffer, false);
+  }
+
+  std::string temp;
+  temp.reserve(length + (hasDecl ? 0 : strlen(dummy_xml)));
+  if (!hasDecl) temp.append(dummy_xml);
+  temp.append(buffer, length);
+
+  return readInternal(temp.c_str(), false);
+}
+
+
+/*
+ * Reads the start of the given file only and fills header.
+ */
+bool
+SedReader::peek (const std::string& filename, SedDocumentHeader& header,
+                 bool countLists) const
+{
+  if (!util_file_exists(filename.c_str()))
+  {
+    peekInternal(NULL, false, header, false);
+    return false;
+  }
+
+  return peekInternal(filename.c_str(), true, header, countLists);
+}
+
+
+/*
+ * Reads the start of the given XML string only and fills header.
+ */
+bool
+SedReader::peekFromString (const std::string& xml, SedDocumentHeader& header,
+                           bool countLists) const
+{
+  const char* dummy_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+  if (!strncmp(xml.c_str(), dummy_xml, 14))
+  {
+    return peekInternal(xml.c_str(), false, header, countLists);
+  }
+
+  const std::string temp = (dummy_xml + xml);
+  return peekInternal(temp.c_str(), false, header, countLists);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+static bool
+isCompressedFileName (const std::string& filename)
+{
+  static const char* suffixes[] = { ".gz", ".zip", ".bz2" };
+
+  for (unsigned int i = 0; i < sizeof(suffixes)/sizeof(suffixes[0]); i++)
+  {
+    size_t n = strlen(suffixes[i]);
+    if (filename.size() >= n
+      && filename.compare(filename.size() - n, n, suffixes[i]) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+/** @endcond */
+
+
+/*
+ * Reads an Sed document from the given file by mapping it into memory.
+ */
+SedDocument*
+SedReader::readSedMLFromMappedFile (const std::string& filename)
+{
+  if (isCompressedFileName(filename) || !util_file_exists(filename.c_str()))
+  {
+    return readInternal(filename.c_str(), true);
+  }
+
+  SedDocument* d = NULL;
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0
+      && (unsigned long long)size.QuadPart < (size_t)-1)
+    {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping != NULL)
+      {
+        const char* view = static_cast<const char*>
+          (MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (view != NULL)
+        {
+          // as for mmap, the remainder of the last page is zero filled
+          SYSTEM_INFO info;
+          GetSystemInfo(&info);
+          size_t span = (size_t)size.QuadPart;
+          if (span % info.dwPageSize != 0) ++span;
+
+          d = readSedMLFromBuffer(view, span);
+          UnmapViewOfFile(view);
+        }
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+  }
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      // the rest of the last page reads as zeros, so unless the file ends
+      // exactly on a page boundary its terminating NUL comes for free
+      const size_t size = (size_t)st.st_size;
+      const long   page = sysconf(_SC_PAGESIZE);
+      const size_t span = (page > 0 && size % (size_t)page != 0)
+                        ? size + 1 : size;
+
+      void* view = mmap(NULL, span, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (view != MAP_FAILED)
+      {
+        d = readSedMLFromBuffer(static_cast<const char*>(view), span);
+        munmap(view, span);
+      }
+    }
+    close(fd);
+  }
+#endif
+
+  // empty or unmappable files go through the ordinary path, which also
+  // reports them the usual way
+  return (d != NULL) ? d : readInternal(filename.c_str(), true);
+}
+
+
 /*
  * Predicate returning @c true if
  * libSed is linked with zlib.
@@ -173,6 +360,166 @@ SedReader::hasBzip2()
 }
 
 
+/*
+ * Sets whether documents read defer parsing of notes and annotations.
+ */
+void
+SedReader::setDeferNotesAndAnnotations (bool defer)
+{
+  mDeferNotesAndAnnotations = defer;
+}
+
+
+/*
+ * Returns whether documents read defer parsing of notes and annotations.
+ */
+bool
+SedReader::getDeferNotesAndAnnotations () const
+{
+  return mDeferNotesAndAnnotations;
+}
+
+
+/*
+ * Sets whether documents read allocate their elements from an arena.
+ */
+void
+SedReader::setUseArena (bool useArena)
+{
+  mUseArena = useArena;
+}
+
+
+/*
+ * Returns whether documents read allocate their elements from an arena.
+ */
+bool
+SedReader::getUseArena () const
+{
+  return mUseArena;
+}
+
+
+/*
+ * Sets how many errors with the same id documents read keep.
+ */
+void
+SedReader::setMaxErrorsPerId (unsigned int maxErrors)
+{
+  mMaxErrorsPerId = maxErrors;
+}
+
+
+/*
+ * Sets how many errors documents read keep.
+ */
+void
+SedReader::setMaxErrors (unsigned int maxErrors)
+{
+  mMaxErrors = maxErrors;
+}
+
+
+/*
+ * Sets whether reading stops once the error log of a document is full.
+ */
+void
+SedReader::setStopAtErrorLimit (bool stop)
+{
+  mStopAtErrorLimit = stop;
+}
+
+
+/*
+ * Sets how many levels of documents are read.
+ */
+void
+SedReader::setStructureOnlyDepth (unsigned int depth)
+{
+  mStructureOnlyDepth = depth;
+}
+
+
+/*
+ * Returns how many levels of documents are read.
+ */
+unsigned int
+SedReader::getStructureOnlyDepth () const
+{
+  return mStructureOnlyDepth;
+}
+
+
+/*
+ * Sets how many levels notes and annotations may nest.
+ */
+void
+SedReader::setMaxXMLDepth (unsigned int depth)
+{
+  mMaxXMLDepth = depth;
+}
+
+
+/*
+ * Returns how many levels notes and annotations may nest.
+ */
+unsigned int
+SedReader::getMaxXMLDepth () const
+{
+  return mMaxXMLDepth;
+}
+
+
+/*
+ * Sets the XML parser documents are read with.
+ */
+void
+SedReader::setXMLParser (const std::string& parser)
+{
+  mXMLParser = parser;
+}
+
+
+/*
+ * Returns the XML parser documents are read with.
+ */
+const std::string&
+SedReader::getXMLParser () const
+{
+  return mXMLParser;
+}
+
+
+/*
+ * Returns the XML parser chosen when libSEDML was built.
+ */
+const char*
+SedReader::getDefaultXMLParser ()
+{
+  return LIBSEDML_XML_PARSER;
+}
+
+
+/*
+ * Sets the SedProfiler documents read are counted by.
+ */
+void
+SedReader::setProfiler (SedProfiler* profiler)
+{
+  mProfiler = profiler;
+}
+
+
+/*
+ * Returns the SedProfiler of this SedReader.
+ */
+SedProfiler*
+SedReader::getProfiler () const
+{
+  return mProfiler;
+}
+
+
 /** @cond doxygen-libsbml-internal */
 static bool
 isCriticalError(const unsigned int errorId)
@@ -203,10 +550,42 @@ isCriticalError(const unsigned int errorId)
     return false;
   }
 }
+
+
+/*
+ * Predicate for SedErrorLog::removeIf() selecting the errors that are not
+ * critical.
+ */
+static bool
+isNotCriticalError(const SedError* error, void*)
+{
+  return !isCriticalError(error->getErrorId());
+}
 /** @endcond */
 
 
 /** @cond doxygen-libsbml-internal */
+#ifdef USE_PROFILING
+/*
+ * Returns the number of bytes of the file or string content.
+ */
+static size_t
+getInputSize (const char* content, bool isFile)
+{
+  if (content == NULL) return 0;
+  if (!isFile) return strlen(content);
+
+  FILE* file = fopen(content, "rb");
+  if (file == NULL) return 0;
+
+  long size = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+  fclose(file);
+
+  return (size > 0) ? (size_t)size : 0;
+}
+#endif
+
+
 /*
  * Used by readSedML() and readSedMLFromString().
  */
@@ -214,6 +593,10 @@ SedDocument*
 SedReader::readInternal (const char* content, bool isFile)
 {
   SedDocument* d = new SedDocument();
+
+  d->getErrorLog()->setMaxErrorsPerId(mMaxErrorsPerId);
+  d->getErrorLog()->setMaxErrors(mMaxErrors);
+  d->getErrorLog()->setStopAtLimit(mStopAtErrorLimit);
   //if (isFile) {
   //  d->setURI(content);
   //}
@@ -224,9 +607,34 @@ SedReader::readInternal (const char* content, bool isFile)
   }
   else
   {
-    XMLInputStream stream(content, isFile, "", d->getErrorLog());
+    XMLInputStream stream(content, isFile, mXMLParser, d->getErrorLog());
+
+    d->setDeferNotesAndAnnotations(mDeferNotesAndAnnotations);
+    d->setUseArena(mUseArena);
+    d->setStructureOnlyDepth(mStructureOnlyDepth);
+    d->setMaxXMLDepth(mMaxXMLDepth);
+
+#ifdef USE_PROFILING
+    // the elements count into recorder while they are read; the document
+    // itself is the first allocation
+    SedProfileRecorder recorder;
+    if (mProfiler != NULL)
+    {
+      recorder.mCounters.bytesRead      = getInputSize(content, isFile);
+      recorder.mCounters.numAllocations = 1;
+      d->setProfileRecorder(&recorder);
+    }
+#endif
 
     d->read(stream);
+
+#ifdef USE_PROFILING
+    if (mProfiler != NULL)
+    {
+      d->setProfileRecorder(NULL);
+      mProfiler->record(recorder.mCounters);
+    }
+#endif
     
     if (stream.isError())
     {
@@ -244,11 +652,7 @@ SedReader::readInternal (const char* content, bool isFile)
           // If we find even one critical error, all other errors are
           // suspect and may be bogus.  Remove them.
 
-          for (int n = d->getErrorLog()->getNumErrors()-1; n >= 0; n--)      
-            if (!isCriticalError(d->getErrorLog()->getError(n)->getErrorId()))
-            {
-              d->getErrorLog()->remove(d->getErrorLog()->getError(n)->getErrorId());
-            }
+          d->getErrorLog()->removeIf(isNotCriticalError);
 
           break;
         }
@@ -281,6 +685,105 @@ SedReader::readInternal (const char* content, bool isFile)
   }
   return d;
 }
+
+
+/*
+ * Returns the counter of header for the top-level list name, or NULL.
+ */
+static unsigned int*
+getListCounter (SedDocumentHeader& header, const std::string& name)
+{
+  if (name == "listOfSimulations")    return &header.numSimulations;
+  if (name == "listOfModels")         return &header.numModels;
+  if (name == "listOfTasks")          return &header.numTasks;
+  if (name == "listOfDataGenerators") return &header.numDataGenerators;
+  if (name == "listOfOutputs")        return &header.numOutputs;
+  return NULL;
+}
+
+
+/*
+ * Used by peek() and peekFromString().  The root start tag is all that is
+ * read unless the lists are counted; their children are then skipped past
+ * token by token, without any XMLNode being built.
+ */
+bool
+SedReader::peekInternal (const char* content, bool isFile,
+                         SedDocumentHeader& header, bool countLists) const
+{
+  header.level             = 0;
+  header.version           = 0;
+  header.counted           = 0;
+  header.numSimulations    = 0;
+  header.numModels         = 0;
+  header.numTasks          = 0;
+  header.numDataGenerators = 0;
+  header.numOutputs        = 0;
+
+  if (content == NULL) return false;
+
+  XMLErrorLog log;
+  XMLInputStream stream(content, isFile, mXMLParser, &log);
+
+  while (stream.isGood() && !stream.peek().isStart())
+  {
+    stream.next();
+  }
+  if (!stream.isGood()) return false;
+
+  const XMLToken root = stream.next();
+  if (root.getName() != "sedML") return false;
+
+  const XMLAttributes& attributes = root.getAttributes();
+  SedNumber::parse(attributes.getValue("level"), header.level);
+  SedNumber::parse(attributes.getValue("version"), header.version);
+
+  if (!countLists || root.isEnd())
+  {
+    header.counted = countLists ? 1 : 0;
+    return true;
+  }
+
+  while (stream.isGood())
+  {
+    const XMLToken& next = stream.peek();
+    if (!stream.isGood() || next.isEndFor(root)) break;
+
+    if (!next.isStart())
+    {
+      stream.next();
+      continue;
+    }
+
+    const XMLToken list = stream.next();
+    unsigned int* counter = getListCounter(header, list.getName());
+    if (counter == NULL || list.isEnd())
+    {
+      stream.skipPastEnd(list);
+      continue;
+    }
+
+    while (stream.isGood())
+    {
+      const XMLToken& item = stream.peek();
+      if (!stream.isGood() || item.isEndFor(list)) break;
+
+      if (item.isStart())
+      {
+        ++*counter;
+        stream.skipPastEnd(stream.next());
+      }
+      else
+      {
+        stream.next();
+      }
+    }
+    stream.next();
+  }
+
+  header.counted = stream.isError() ? 0 : 1;
+  return true;
+}
 /** @endcond */
 
 
@@ -309,6 +812,32 @@ SedReader_free (SedReader_t *sr)
 }
 
 
+/**
+ * Peeks at the start of the given file and fills header.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_peek (const SedReader_t *sr, const char *filename,
+                SedDocumentHeader *header, int countLists)
+{
+  if (sr == NULL || filename == NULL || header == NULL) return 0;
+  return sr->peek(filename, *header, countLists != 0) ? 1 : 0;
+}
+
+
+/**
+ * Peeks at the start of the given XML string and fills header.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_peekFromString (const SedReader_t *sr, const char *xml,
+                          SedDocumentHeader *header, int countLists)
+{
+  if (sr == NULL || xml == NULL || header == NULL) return 0;
+  return sr->peekFromString(xml, *header, countLists != 0) ? 1 : 0;
+}
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -406,6 +935,33 @@ SedReader_readSedMLFromString (SedReader_t *sr, const char *xml)
 }
 
 
+/**
+ * Reads an Sed document from the first length bytes of buffer.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromBuffer (SedReader_t *sr, const char *buffer,
+                               size_t length)
+{
+  return (sr != NULL) ? sr->readSedMLFromBuffer(buffer, length) : NULL;
+}
+
+
+/**
+ * Reads an Sed document from the given file by mapping it into memory.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromMappedFile (SedReader_t *sr, const char *filename)
+{
+  if (sr != NULL)
+    return (filename != NULL) ? sr->readSedMLFromMappedFile(filename) :
+                              sr->readSedMLFromMappedFile("");
+  else
+    return NULL;
+}
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * underlying libSed is linked with zlib at compile time.
@@ -434,6 +990,107 @@ SedReader_hasBzip2 (void)
 }
 
 
+/**
+ * Sets whether documents read by the given SedReader only parse their
+ * notes and annotations when first accessed.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setDeferNotesAndAnnotations (SedReader_t *sr, int defer)
+{
+  if (sr != NULL) sr->setDeferNotesAndAnnotations(defer != 0);
+}
+
+
+/**
+ * Sets whether documents read by the given SedReader allocate their
+ * elements from a per-document arena.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseArena (SedReader_t *sr, int useArena)
+{
+  if (sr != NULL) sr->setUseArena(useArena != 0);
+}
+
+
+/**
+ * Sets how many errors with the same error id documents read keep.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxErrorsPerId (SedReader_t *sr, unsigned int maxErrors)
+{
+  if (sr != NULL) sr->setMaxErrorsPerId(maxErrors);
+}
+
+
+/**
+ * Sets how many errors documents read keep.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxErrors (SedReader_t *sr, unsigned int maxErrors)
+{
+  if (sr != NULL) sr->setMaxErrors(maxErrors);
+}
+
+
+/**
+ * Sets whether reading stops once the error log of a document is full.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setStopAtErrorLimit (SedReader_t *sr, int stop)
+{
+  if (sr != NULL) sr->setStopAtErrorLimit(stop != 0);
+}
+
+
+/**
+ * Sets how many levels of documents are read.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setStructureOnlyDepth (SedReader_t *sr, unsigned int depth)
+{
+  if (sr != NULL) sr->setStructureOnlyDepth(depth);
+}
+
+
+/**
+ * Sets how many levels notes and annotations may nest.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxXMLDepth (SedReader_t *sr, unsigned int depth)
+{
+  if (sr != NULL) sr->setMaxXMLDepth(depth);
+}
+
+
+/**
+ * Sets the XML parser documents are read with.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setXMLParser (SedReader_t *sr, const char *parser)
+{
+  if (sr != NULL) sr->setXMLParser(parser != NULL ? parser : "");
+}
+
+
+/**
+ * Sets the SedProfiler documents read are counted by.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setProfiler (SedReader_t *sr, SedProfiler_t *profiler)
+{
+  if (sr != NULL) sr->setProfiler(profiler);
+}
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -79,6 +79,27 @@
  * Support for compression is not mandated by the Sed standard, but
  * applications may find it helpful, particularly when large Sed models
  * are being communicated across data links of limited bandwidth.
+ *
+ * @section reader-threads Thread safety
+ *
+ * Reading, writing, validating and modifying are safe to do concurrently
+ * on separate SedDocument instances, each from its own thread and through
+ * its own SedReader or SedWriter.  The library keeps no mutable global or
+ * function-local static state on these paths; its only statics are
+ * constant tables and names, which are initialised before main().
+ * Concurrent parsing also requires the underlying XML parser (Expat,
+ * libxml2 or Xerces, as configured in libSBML) to have completed any
+ * one-time initialisation; parsing one document on a single thread first
+ * is sufficient, and SedBatchReader does this itself.
+ *
+ * A single SedDocument, or any object in it, must not be used from two
+ * threads at once unless every thread only calls @c const methods, and
+ * even then not methods that fill caches lazily, such as
+ * SedDocument::getElementBySId(), the getReferencedX() accessors, or
+ * getNotes() and getAnnotation() when their parsing is deferred.  Objects
+ * cloned from a document may share reference counted namespace data with
+ * it, so a clone should be used on the thread of its original, or after
+ * calling setNamespaces() on it.
  */
 
 #ifndef SedReader_h
@@ -88,6 +109,26 @@
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
 #include <sbml/util/util.h>
+#include <stddef.h>
+
+
+/**
+ * What SedReader::peek() finds at the start of a SED-ML document: the
+ * @c level and @c version attributes of its root, 0 if absent, and, if
+ * @c counted is non-zero, the number of children in each of its top-level
+ * lists.
+ */
+typedef struct
+{
+  int           level;
+  int           version;
+  int           counted;
+  unsigned int  numSimulations;
+  unsigned int  numModels;
+  unsigned int  numTasks;
+  unsigned int  numDataGenerators;
+  unsigned int  numOutputs;
+} SedDocumentHeader;
 
 
 #ifdef __cplusplus
@@ -405,6 +446,85 @@ public:
   SedDocument* readSedMLFromString (const std::string& xml);
 
 
+  /**
+   * Reads an Sed document from the first @p length bytes of @p buffer.
+   *
+   * This behaves like readSedMLFromString(), but does not need the
+   * content in a @c std::string.  If the buffer starts with an XML
+   * declaration and contains a terminating NUL character within its
+   * @p length bytes, it is parsed in place; otherwise it is copied once,
+   * with the declaration prepended if it is missing.  Parsing stops at
+   * the first NUL character.
+   *
+   * @param buffer the Sed content; it need not be NUL terminated.
+   * @param length the number of bytes in @p buffer.
+   *
+   * @return a pointer to the SedDocument read.
+   *
+   * @see readSedMLFromString(const std::string& xml)
+   */
+  SedDocument* readSedMLFromBuffer (const char* buffer, size_t length);
+
+
+  /**
+   * Reads an Sed document from the given file by mapping it into memory
+   * and parsing it in place, rather than reading it through the file
+   * interface of the XML parser.
+   *
+   * Compressed files (see readSedML()), files that cannot be mapped, and
+   * platforms without memory mapping are read as by readSedML().  Errors
+   * are reported in the same way as by readSedML().
+   *
+   * @param filename the name or full pathname of the file to be read.
+   *
+   * @return a pointer to the SedDocument read.
+   */
+  SedDocument* readSedMLFromMappedFile (const std::string& filename);
+
+
+  /**
+   * Reads the start of the given file only, up to the start tag of its
+   * root, and fills @p header with the level and version found there,
+   * without building a SedDocument.  This costs time in the size of the
+   * start of the file, not of the file, so that a document can be routed
+   * by its level and version before it is read.
+   *
+   * If @p countLists is @c true, the children of the top-level lists are
+   * counted as well.  The rest of the file is then scanned, skipping
+   * past the end of each child without building anything from it.
+   *
+   * Compressed files are peeked at as readSedML() reads them.  No errors
+   * are logged anywhere.
+   *
+   * @param filename the name or full pathname of the file to peek at.
+   * @param header the structure to fill in.
+   * @param countLists whether to count the children of the lists.
+   *
+   * @return @c true if the content has a @em sedML root element,
+   * @c false otherwise.
+   */
+  bool peek (const std::string& filename, SedDocumentHeader& header,
+             bool countLists = false) const;
+
+
+  /**
+   * Peeks at the start of the given XML string, as peek() does at the
+   * start of a file.  As with readSedMLFromString(), the XML declaration
+   * may be missing.
+   *
+   * @param xml a string containing a Sed document.
+   * @param header the structure to fill in.
+   * @param countLists whether to count the children of the lists.
+   *
+   * @return @c true if the content has a @em sedML root element,
+   * @c false otherwise.
+   *
+   * @see peek(const std::string& filename, SedDocumentHeader& header, bool countLists)
+   */
+  bool peekFromString (const std::string& xml, SedDocumentHeader& header,
+                       bool countLists = false) const;
+
+
   /**
    * Static method; returns @c true if this copy of libSed supports
    * <i>gzip</I> and <i>zip</i> format compression.
@@ -441,6 +561,152 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Sets whether documents read by this SedReader keep their notes and
+   * annotations as raw XML, parsing them only when they are first
+   * accessed.  This is off by default.
+   *
+   * @param defer @c true to defer parsing of notes and annotations.
+   *
+   * @see SedDocument::setDeferNotesAndAnnotations(bool defer)
+   */
+  void setDeferNotesAndAnnotations (bool defer);
+
+
+  /**
+   * Returns whether documents read by this SedReader defer parsing of
+   * their notes and annotations.
+   *
+   * @return @c true if parsing is deferred, @c false otherwise.
+   */
+  bool getDeferNotesAndAnnotations () const;
+
+
+  /**
+   * Sets whether documents read by this SedReader allocate their elements
+   * from a per-document arena.  This is off by default.
+   *
+   * @param useArena @c true to read into arena allocated documents.
+   *
+   * @see SedDocument::setUseArena(bool useArena)
+   */
+  void setUseArena (bool useArena);
+
+
+  /**
+   * Returns whether documents read by this SedReader use an arena.
+   *
+   * @return @c true if an arena is used, @c false otherwise.
+   */
+  bool getUseArena () const;
+
+
+  /**
+   * Sets how many errors with the same error id the documents read by
+   * this SedReader keep in their error logs; zero, the default, keeps all.
+   *
+   * @see SedErrorLog::setMaxErrorsPerId(unsigned int maxErrors)
+   */
+  void setMaxErrorsPerId (unsigned int maxErrors);
+
+
+  /**
+   * Sets how many errors the documents read by this SedReader keep in
+   * their error logs; zero, the default, keeps all.
+   *
+   * @see SedErrorLog::setMaxErrors(unsigned int maxErrors)
+   */
+  void setMaxErrors (unsigned int maxErrors);
+
+
+  /**
+   * Sets whether reading a document stops once its error log holds as
+   * many errors as setMaxErrors() allows.  This is off by default.
+   *
+   * @param stop @c true to stop reading at the limit.
+   */
+  void setStopAtErrorLimit (bool stop);
+
+
+  /**
+   * Sets whether documents read by this SedReader are only read down to
+   * @p depth levels below the sedML element, skipping MathML, notes and
+   * annotations; zero, the default, reads documents in full.
+   *
+   * @see SedDocument::setStructureOnlyDepth(unsigned int depth)
+   */
+  void setStructureOnlyDepth (unsigned int depth);
+
+
+  /**
+   * @return the number of levels of documents read, or zero if they are
+   * read in full.
+   */
+  unsigned int getStructureOnlyDepth () const;
+
+
+  /**
+   * Sets how many levels the notes and annotations of documents read by
+   * this SedReader may nest; deeper ones are skipped with an error.  Zero
+   * allows any depth; the default is SedXMLTree::DEFAULT_MAX_DEPTH.
+   *
+   * @see SedDocument::setMaxXMLDepth(unsigned int depth)
+   */
+  void setMaxXMLDepth (unsigned int depth);
+
+
+  /**
+   * @return the number of levels notes and annotations may nest, or zero
+   * for any.
+   */
+  unsigned int getMaxXMLDepth () const;
+
+
+  /**
+   * Sets the XML parser of libSBML documents are read with: "expat",
+   * "libxml" or "xerces", as libSBML was built with them, or an empty
+   * string for the libSBML default.  Expat is usually the fastest.  The
+   * default is getDefaultXMLParser().
+   *
+   * A parser libSBML was not built with cannot open any document, which
+   * is logged as an error of the document read.
+   */
+  void setXMLParser (const std::string& parser);
+
+
+  /**
+   * @return the XML parser of libSBML documents are read with, or an
+   * empty string for the libSBML default.
+   */
+  const std::string& getXMLParser () const;
+
+
+  /**
+   * @return the XML parser of libSBML new SedReader and SedEventReader
+   * objects start with, and which the rest of libSEDML reads XML with:
+   * the manifests of archives, the models changes are applied to and the
+   * elements patches insert.  It is the parser chosen with the CMake
+   * option LIBSEDML_XML_PARSER when libSEDML was built, or an empty
+   * string for the libSBML default, and never changes, so that any
+   * thread may read XML at any time.
+   */
+  static const char* getDefaultXMLParser ();
+
+
+  /**
+   * Sets the SedProfiler the counters of every document read by this
+   * SedReader are recorded by, or @c NULL, the default, for none.  The
+   * profiler is not owned, and is only used if SedProfiler::isEnabled().
+   */
+  void setProfiler (SedProfiler* profiler);
+
+
+  /**
+   * @return the SedProfiler of this SedReader, or @c NULL.
+   */
+  SedProfiler* getProfiler () const;
+
+
 protected:
   /** @cond doxygen-libsbml-internal */
 
@@ -451,6 +717,24 @@ protected:
    */
   SedDocument* readInternal (const char* content, bool isFile = true);
 
+
+  /**
+   * Used by peek() and peekFromString().
+   */
+  bool peekInternal (const char* content, bool isFile,
+                     SedDocumentHeader& header, bool countLists) const;
+
+
+  bool mDeferNotesAndAnnotations;
+  bool mUseArena;
+  unsigned int mMaxErrorsPerId;
+  unsigned int mMaxErrors;
+  bool mStopAtErrorLimit;
+  unsigned int mStructureOnlyDepth;
+  unsigned int mMaxXMLDepth;
+  std::string mXMLParser;
+  SedProfiler* mProfiler;
+
   /** @endcond */
 };
 
@@ -473,6 +757,36 @@ LIBSEDML_EXTERN
 SedReader_t *
 SedReader_create (void);
 
+
+/**
+ * Peeks at the start of the given file and fills @p header, counting the
+ * children of the top-level lists if @p countLists is non-zero.
+ *
+ * @return non-zero if the content has a @em sedML root element, zero
+ * otherwise.
+ *
+ * @see SedReader::peek()
+ */
+LIBSEDML_EXTERN
+int
+SedReader_peek (const SedReader_t *sr, const char *filename,
+                SedDocumentHeader *header, int countLists);
+
+
+/**
+ * Peeks at the start of the given XML string and fills @p header, counting
+ * the children of the top-level lists if @p countLists is non-zero.
+ *
+ * @return non-zero if the content has a @em sedML root element, zero
+ * otherwise.
+ *
+ * @see SedReader::peekFromString()
+ */
+LIBSEDML_EXTERN
+int
+SedReader_peekFromString (const SedReader_t *sr, const char *xml,
+                          SedDocumentHeader *header, int countLists);
+
 /**
  * Frees the given SedReader.
  */
@@ -560,6 +874,32 @@ SedDocument_t *
 SedReader_readSedMLFromString (SedReader_t *sr, const char *xml);
 
 
+/**
+ * Reads an Sed document from the first @p length bytes of @p buffer,
+ * parsing it in place where possible.
+ *
+ * @return a pointer to the SedDocument read.
+ *
+ * @see SedReader_readSedMLFromString()
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromBuffer (SedReader_t *sr, const char *buffer,
+                               size_t length);
+
+
+/**
+ * Reads an Sed document from the given file by mapping it into memory.
+ *
+ * @return a pointer to the SedDocument read.
+ *
+ * @see SedReader_readSedML()
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedReader_readSedMLFromMappedFile (SedReader_t *sr, const char *filename);
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * underlying libSed is linked with..
@@ -581,6 +921,88 @@ LIBSEDML_EXTERN
 int
 SedReader_hasBzip2 ();
 
+
+/**
+ * Sets whether documents read by the given SedReader only parse their
+ * notes and annotations when first accessed.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setDeferNotesAndAnnotations (SedReader_t *sr, int defer);
+
+
+/**
+ * Sets whether documents read by the given SedReader allocate their
+ * elements from a per-document arena.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setUseArena (SedReader_t *sr, int useArena);
+
+
+/**
+ * Sets how many errors with the same error id the documents read by the
+ * given SedReader keep; zero keeps all.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxErrorsPerId (SedReader_t *sr, unsigned int maxErrors);
+
+
+/**
+ * Sets how many errors the documents read by the given SedReader keep;
+ * zero keeps all.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxErrors (SedReader_t *sr, unsigned int maxErrors);
+
+
+/**
+ * Sets whether the given SedReader stops reading a document once its
+ * error log is full.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setStopAtErrorLimit (SedReader_t *sr, int stop);
+
+
+/**
+ * Sets how many levels of the documents read by the given SedReader are
+ * read; zero reads them in full.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setStructureOnlyDepth (SedReader_t *sr, unsigned int depth);
+
+
+/**
+ * Sets how many levels the notes and annotations of the documents read by
+ * the given SedReader may nest; zero allows any depth.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setMaxXMLDepth (SedReader_t *sr, unsigned int depth);
+
+
+/**
+ * Sets the XML parser of libSBML the given SedReader reads documents
+ * with: "expat", "libxml", "xerces", or @c NULL or an empty string for
+ * the libSBML default.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setXMLParser (SedReader_t *sr, const char *parser);
+
+
+/**
+ * Sets the SedProfiler the documents read by the given SedReader are
+ * counted by, or @c NULL for none.
+ */
+LIBSEDML_EXTERN
+void
+SedReader_setProfiler (SedReader_t *sr, SedProfiler_t *profiler);
+
 #endif  /* !SWIG */
 
 
@@ -0,0 +1,1027 @@
+/**
+ * @file    SedRemoteSimulator.cpp
+ * @brief   Sends the tasks of a SedExecutor to simulators on other nodes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedRemoteSimulator.h>
+#include <sedml/SedBinaryCodec.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedSourceResolver.h>
+#include <sedml/common/threads.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const char WORK_UNIT_MAGIC[] = "SEDU";
+static const char REPLY_MAGIC[]     = "SEDO";
+
+/*
+ * The id of the data generator of a work unit holding its variables.
+ */
+static const char VARIABLES_ID[] = "variables";
+
+
+static void
+appendFixed32 (std::string& data, unsigned long value)
+{
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    data += static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+
+static void
+appendBlock (std::string& data, const std::string& block)
+{
+  appendFixed32(data, static_cast<unsigned long>(block.size()));
+  data += block;
+}
+
+
+static bool
+isLittleEndian ()
+{
+  const unsigned int one = 1;
+  return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+
+static void
+reverseDouble (unsigned char* bytes)
+{
+  for (size_t i = 0; i < sizeof(double) / 2; ++i)
+  {
+    const unsigned char c = bytes[i];
+    bytes[i] = bytes[sizeof(double) - 1 - i];
+    bytes[sizeof(double) - 1 - i] = c;
+  }
+}
+
+
+/*
+ * Reads a work unit or a reply, failing rather than reading past its end.
+ */
+class SedRemoteReader
+{
+public:
+
+  SedRemoteReader (const std::string& data)
+    : mData (data)
+    , mPosition (0)
+  {
+  }
+
+  bool readMagic (const char* magic)
+  {
+    if (mData.compare(mPosition, 4, magic) != 0) return false;
+    mPosition += 4;
+    return true;
+  }
+
+  bool readFixed32 (unsigned long& value)
+  {
+    if (mData.size() - mPosition < 4) return false;
+
+    value = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      const unsigned char byte = static_cast<unsigned char>(mData[mPosition++]);
+      value |= static_cast<unsigned long>(byte) << (8 * i);
+    }
+    return true;
+  }
+
+  bool readBlock (std::string& block)
+  {
+    unsigned long length;
+    if (!readFixed32(length) || mData.size() - mPosition < length) return false;
+
+    block.assign(mData, mPosition, length);
+    mPosition += length;
+    return true;
+  }
+
+  /*
+   * Reads an 8-byte length of doubles and the doubles, into values.
+   */
+  bool readDoubles (std::vector<double>& values)
+  {
+    unsigned long low, high;
+    if (!readFixed32(low) || !readFixed32(high)) return false;
+
+    const size_t remaining = (mData.size() - mPosition) / sizeof(double);
+    if (high != 0 || low > remaining) return false;
+
+    values.resize(low);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      unsigned char bytes[sizeof(double)];
+      memcpy(bytes, mData.data() + mPosition, sizeof(double));
+      if (!isLittleEndian()) reverseDouble(bytes);
+      memcpy(&values[i], bytes, sizeof(double));
+      mPosition += sizeof(double);
+    }
+    return true;
+  }
+
+  bool atEnd () const
+  {
+    return mPosition == mData.size();
+  }
+
+private:
+
+  const std::string& mData;
+  size_t             mPosition;
+};
+
+
+static void
+appendDoubles (std::string& data, const double* values, size_t length)
+{
+  appendFixed32(data, static_cast<unsigned long>(length & 0xffffffffUL));
+  appendFixed32(data, static_cast<unsigned long>((length >> 16) >> 16));
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    unsigned char bytes[sizeof(double)];
+    memcpy(bytes, &values[i], sizeof(double));
+    if (!isLittleEndian()) reverseDouble(bytes);
+    data.append(reinterpret_cast<const char*>(bytes), sizeof(double));
+  }
+}
+
+
+/*
+ * Encodes the reply to a work unit, with the columns of results if status
+ * is success.
+ */
+static std::string
+encodeReply (int status, const SedResults* results)
+{
+  std::string reply(REPLY_MAGIC, 4);
+  appendFixed32(reply, static_cast<unsigned long>(status));
+
+  const unsigned int numColumns =
+    (results != NULL && status == LIBSEDML_OPERATION_SUCCESS)
+    ? results->getNumColumns() : 0;
+  appendFixed32(reply, numColumns);
+
+  for (unsigned int i = 0; i < numColumns; ++i)
+  {
+    const std::string& id = results->getColumnId(i);
+    appendBlock(reply, id);
+    appendDoubles(reply, results->getColumn(id), results->getColumnLength(id));
+  }
+
+  return reply;
+}
+
+
+/*
+ * Returns the id a model refers to by its source, or an empty string if
+ * its source is not a reference to another model.
+ */
+static std::string
+getReferencedModel (const SedModel* model)
+{
+  const std::string& source = model->getSource();
+  return (source.size() > 1 && source[0] == '#') ? source.substr(1) : "";
+}
+
+
+/*
+ * Returns the models the source of model leads to, nearest first, through
+ * the document of task; a cycle ends the chain.
+ */
+static std::vector<const SedModel*>
+getModelChain (const SedTask* task, const SedModel* model)
+{
+  std::vector<const SedModel*> chain;
+  const SedDocument* doc = task->getSedDocument();
+  if (doc == NULL) return chain;
+
+  std::set<std::string> visited;
+  visited.insert(model->getId());
+
+  std::string id = getReferencedModel(model);
+  while (!id.empty() && visited.insert(id).second)
+  {
+    const SedModel* next = doc->getModel(id);
+    if (next == NULL) break;
+
+    chain.push_back(next);
+    id = getReferencedModel(next);
+  }
+
+  return chain;
+}
+
+
+/*
+ * Orders models by their number of tasks, most first, then by id.
+ */
+static bool
+hasMoreTasks (const std::pair<unsigned int, std::string>& a,
+              const std::pair<unsigned int, std::string>& b)
+{
+  if (a.first != b.first) return a.first > b.first;
+  return a.second < b.second;
+}
+
+
+/*
+ * A SedTransport calling a C function.
+ */
+class SedCallbackTransport : public SedTransport
+{
+public:
+
+  SedCallbackTransport (unsigned int numNodes,
+                        SedRemoteSimulator_callFunc func, void* userData)
+    : mNumNodes (numNodes)
+    , mFunc (func)
+    , mUserData (userData)
+  {
+  }
+
+  virtual unsigned int getNumNodes () const
+  {
+    return mNumNodes;
+  }
+
+  virtual int call (unsigned int node, const std::string& request,
+                    std::string& reply)
+  {
+    char*  data   = NULL;
+    size_t length = 0;
+
+    const int result = mFunc(node, request.data(), request.size(),
+                             &data, &length, mUserData);
+    if (data != NULL)
+    {
+      reply.assign(data, length);
+      free(data);
+    }
+
+    return result;
+  }
+
+private:
+
+  unsigned int                mNumNodes;
+  SedRemoteSimulator_callFunc mFunc;
+  void*                       mUserData;
+};
+
+
+class SedCallbackRemoteSimulator : public SedRemoteSimulator
+{
+public:
+
+  SedCallbackRemoteSimulator (unsigned int numNodes,
+                              SedRemoteSimulator_callFunc func, void* userData)
+    : SedRemoteSimulator (NULL)
+    , mCallback (numNodes, func, userData)
+  {
+    if (func != NULL) setTransport(&mCallback);
+  }
+
+private:
+
+  SedCallbackTransport mCallback;
+};
+
+
+/*
+ * A SedSimulator calling a C function, for the worker of a node.
+ */
+class SedCallbackWorkerSimulator : public SedSimulator
+{
+public:
+
+  SedCallbackWorkerSimulator (SedExecutor_simulateFunc func, void* userData)
+    : mFunc (func)
+    , mUserData (userData)
+  {
+  }
+
+  virtual int simulate (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation,
+                        const std::vector<const SedVariable*>& variables,
+                        SedResults& results)
+  {
+    return mFunc(task, model, simulation,
+                 variables.empty() ? NULL : &variables[0],
+                 (unsigned int)variables.size(), &results, mUserData);
+  }
+
+private:
+
+  SedExecutor_simulateFunc mFunc;
+  void*                    mUserData;
+};
+
+
+/*
+ * Holds the simulator of a SedCallbackRemoteWorker, so that it is made
+ * before the SedRemoteWorker base referring to it.
+ */
+struct SedCallbackWorkerBase
+{
+  SedCallbackWorkerBase (SedExecutor_simulateFunc func, void* userData)
+    : mCallback (func, userData)
+  {
+  }
+
+  SedCallbackWorkerSimulator mCallback;
+};
+
+
+class SedCallbackRemoteWorker : private SedCallbackWorkerBase
+                              , public SedRemoteWorker
+{
+public:
+
+  SedCallbackRemoteWorker (SedExecutor_simulateFunc func, void* userData,
+                           SedSourceResolver* resolver)
+    : SedCallbackWorkerBase (func, userData)
+    , SedRemoteWorker (mCallback, resolver)
+  {
+  }
+};
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedTransport.
+ */
+SedTransport::~SedTransport ()
+{
+}
+
+
+/*
+ * Creates a SedRemoteSimulator sending work units through transport.
+ */
+SedRemoteSimulator::SedRemoteSimulator (SedTransport* transport)
+  : mTransport (transport)
+  , mResolver (NULL)
+  , mLock (NULL)
+{
+  SedMutex* lock = new SedMutex;
+  mutexInit(lock);
+  mLock = lock;
+
+  if (mTransport != NULL) mNumTasks.resize(mTransport->getNumNodes(), 0);
+}
+
+
+/*
+ * Destroys this SedRemoteSimulator.
+ */
+SedRemoteSimulator::~SedRemoteSimulator ()
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexFree(lock);
+  delete lock;
+}
+
+
+/*
+ * Sets the transport; the places of the models are forgotten.
+ */
+void
+SedRemoteSimulator::setTransport (SedTransport* transport)
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  mTransport = transport;
+  mNodes.clear();
+  mAssigned.clear();
+  mSent.clear();
+  mNumTasks.assign(mTransport != NULL ? mTransport->getNumNodes() : 0, 0);
+
+  mutexUnlock(lock);
+}
+
+
+/*
+ * Returns the transport.
+ */
+SedTransport*
+SedRemoteSimulator::getTransport () const
+{
+  return mTransport;
+}
+
+
+/*
+ * Has the sources of the models resolved through resolver.
+ */
+void
+SedRemoteSimulator::setSourceResolver (SedSourceResolver* resolver,
+                                       const std::string& base)
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  mResolver = resolver;
+  mBase     = base;
+  mSent.clear();
+
+  mutexUnlock(lock);
+}
+
+
+/*
+ * Places the models of document on the nodes by the number of their
+ * tasks.
+ */
+int
+SedRemoteSimulator::assign (const SedDocument* document)
+{
+  if (document == NULL || mTransport == NULL
+      || mTransport->getNumNodes() == 0)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  // the tasks of every model count for the model its source leads to
+  std::map<std::string, unsigned int> counts;
+  for (unsigned int i = 0; i < document->getNumTasks(); ++i)
+  {
+    const SedTask* task = document->getTask(i);
+    const SedModel* model = document->getModel(task->getModelReference());
+    if (model == NULL) continue;
+
+    ++counts[getRootModel(task, model)->getId()];
+  }
+
+  std::vector<std::pair<unsigned int, std::string> > models;
+  for (std::map<std::string, unsigned int>::const_iterator it = counts.begin();
+       it != counts.end(); ++it)
+  {
+    models.push_back(std::make_pair(it->second, it->first));
+  }
+  std::sort(models.begin(), models.end(), hasMoreTasks);
+
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  mNodes.clear();
+  mAssigned.clear();
+  mNumTasks.assign(mTransport->getNumNodes(), 0);
+
+  for (unsigned int i = 0; i < models.size(); ++i)
+  {
+    const unsigned int node = static_cast<unsigned int>(
+      std::min_element(mNumTasks.begin(), mNumTasks.end()) - mNumTasks.begin());
+
+    mNodes[models[i].second] = node;
+    mAssigned.insert(models[i].second);
+    mNumTasks[node] += models[i].first;
+  }
+
+  mutexUnlock(lock);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the node the tasks of the model modelId go to.
+ */
+unsigned int
+SedRemoteSimulator::getNode (const std::string& modelId) const
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  std::map<std::string, unsigned int>::const_iterator it = mNodes.find(modelId);
+  const unsigned int node =
+    (it != mNodes.end()) ? it->second : static_cast<unsigned int>(-1);
+
+  mutexUnlock(lock);
+  return node;
+}
+
+
+/*
+ * Returns the number of tasks placed on node.
+ */
+unsigned int
+SedRemoteSimulator::getNumTasks (unsigned int node) const
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  const unsigned int numTasks = (node < mNumTasks.size()) ? mNumTasks[node] : 0;
+
+  mutexUnlock(lock);
+  return numTasks;
+}
+
+
+/*
+ * Sends task to the node of its model and stores the columns it replies
+ * with in results.
+ */
+int
+SedRemoteSimulator::simulate (const SedTask* task, const SedModel* model,
+                              const SedSimulation* simulation,
+                              const std::vector<const SedVariable*>& variables,
+                              SedResults& results)
+{
+  if (task == NULL || model == NULL || simulation == NULL)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  const SedModel* root = getRootModel(task, model);
+  const std::string& source = root->getSource();
+
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  if (mTransport == NULL || mTransport->getNumNodes() == 0)
+  {
+    mutexUnlock(lock);
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  SedTransport* transport = mTransport;
+  SedSourceResolver* resolver = mResolver;
+  const unsigned int node = placeModel(root->getId());
+
+  std::string location;
+  bool sent = true;
+  if (resolver != NULL && !source.empty() && source[0] != '#')
+  {
+    location = resolver->getLocation(source, mBase);
+    sent = mSent.find(std::make_pair(node, location)) != mSent.end();
+  }
+
+  mutexUnlock(lock);
+
+  // the contents go with the work units to the node until one of them
+  // has been answered
+  std::string contents;
+  if (!sent && !resolver->getContents(source, mBase, contents))
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  const std::string request = encodeWorkUnit(task, model, simulation,
+                                             variables, location, contents);
+  if (request.empty()) return LIBSEDML_OPERATION_FAILED;
+
+  std::string reply;
+  if (transport->call(node, request, reply) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  const int result = decodeReply(reply, results);
+
+  if (!sent && result == LIBSEDML_OPERATION_SUCCESS)
+  {
+    mutexLock(lock);
+    mSent.insert(std::make_pair(node, location));
+    mutexUnlock(lock);
+  }
+
+  return result;
+}
+
+
+/*
+ * Encodes task, with model, simulation and variables, as a work unit.
+ */
+std::string
+SedRemoteSimulator::encodeWorkUnit (const SedTask* task, const SedModel* model,
+                                    const SedSimulation* simulation,
+                                    const std::vector<const SedVariable*>& variables,
+                                    const std::string& sourceLocation,
+                                    const std::string& sourceContents)
+{
+  if (task == NULL || model == NULL || simulation == NULL) return "";
+
+  const SedDocument* orig = task->getSedDocument();
+  SedDocument doc(orig != NULL ? orig->getLevel() : SEDML_DEFAULT_LEVEL,
+                  orig != NULL ? orig->getVersion() : SEDML_DEFAULT_VERSION);
+
+  // the models a model refers to come before it
+  const std::vector<const SedModel*> chain = getModelChain(task, model);
+
+  bool added = true;
+  for (size_t i = chain.size(); i-- > 0 && added; )
+  {
+    added = doc.addModel(chain[i]) == LIBSEDML_OPERATION_SUCCESS;
+  }
+  added = added && doc.addModel(model) == LIBSEDML_OPERATION_SUCCESS
+    && doc.addSimulation(simulation) == LIBSEDML_OPERATION_SUCCESS
+    && doc.addTask(task) == LIBSEDML_OPERATION_SUCCESS;
+
+  SedDataGenerator* dg = added ? doc.createDataGenerator() : NULL;
+  added = dg != NULL && dg->setId(VARIABLES_ID) == LIBSEDML_OPERATION_SUCCESS;
+  for (size_t i = 0; i < variables.size() && added; ++i)
+  {
+    added = dg->addVariable(variables[i]) == LIBSEDML_OPERATION_SUCCESS;
+  }
+  if (!added) return "";
+
+  if (!sourceLocation.empty())
+  {
+    doc.getModel(0)->setSource(sourceLocation);
+  }
+
+  const std::string encoded = SedBinaryCodec::encode(&doc);
+  if (encoded.empty()) return "";
+
+  std::string unit(WORK_UNIT_MAGIC, 4);
+  appendBlock(unit, encoded);
+  appendBlock(unit, task->getId());
+  appendBlock(unit, model->getId());
+
+  const bool hasSource = !sourceLocation.empty() && !sourceContents.empty();
+  appendFixed32(unit, hasSource ? 1 : 0);
+  if (hasSource)
+  {
+    appendBlock(unit, sourceLocation);
+    appendBlock(unit, sourceContents);
+  }
+
+  return unit;
+}
+
+
+/*
+ * Reads the reply to a work unit into results.
+ */
+int
+SedRemoteSimulator::decodeReply (const std::string& reply,
+                                 SedResults& results)
+{
+  SedRemoteReader in(reply);
+
+  unsigned long status, numColumns;
+  if (!in.readMagic(REPLY_MAGIC) || !in.readFixed32(status)
+      || !in.readFixed32(numColumns))
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  std::string id;
+  std::vector<double> values;
+  bool valid = true;
+  for (unsigned long i = 0; i < numColumns && valid; ++i)
+  {
+    valid = in.readBlock(id) && in.readDoubles(values);
+
+    double* column = valid ? results.addColumn(id, values.size()) : NULL;
+    valid = column != NULL;
+    if (valid && !values.empty())
+    {
+      memcpy(column, &values[0], values.size() * sizeof(double));
+    }
+  }
+
+  if (valid && in.atEnd()) return static_cast<int>(status);
+
+  results.clear();
+  return LIBSEDML_OPERATION_FAILED;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns the node of the model modelId, placing it on the node with the
+ * fewest tasks if it has not been placed, and counts a task on it; the
+ * lock is held.
+ */
+unsigned int
+SedRemoteSimulator::placeModel (const std::string& modelId)
+{
+  std::map<std::string, unsigned int>::iterator it = mNodes.find(modelId);
+  if (it == mNodes.end() || it->second >= mNumTasks.size())
+  {
+    const unsigned int node = static_cast<unsigned int>(
+      std::min_element(mNumTasks.begin(), mNumTasks.end()) - mNumTasks.begin());
+    it = mNodes.insert(std::make_pair(modelId, node)).first;
+    it->second = node;
+  }
+
+  // the tasks of assigned models were counted by assign()
+  if (mAssigned.find(modelId) == mAssigned.end()) ++mNumTasks[it->second];
+
+  return it->second;
+}
+
+
+/*
+ * Returns the model the source of model leads to by #id, or model.
+ */
+const SedModel*
+SedRemoteSimulator::getRootModel (const SedTask* task, const SedModel* model)
+{
+  const std::vector<const SedModel*> chain = getModelChain(task, model);
+  return chain.empty() ? model : chain.back();
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a SedRemoteWorker running work units with simulator.
+ */
+SedRemoteWorker::SedRemoteWorker (SedSimulator& simulator,
+                                  SedSourceResolver* resolver)
+  : mSimulator (simulator)
+  , mResolver (resolver)
+  , mLock (NULL)
+{
+  SedMutex* lock = new SedMutex;
+  mutexInit(lock);
+  mLock = lock;
+}
+
+
+/*
+ * Destroys this SedRemoteWorker.
+ */
+SedRemoteWorker::~SedRemoteWorker ()
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexFree(lock);
+  delete lock;
+}
+
+
+/*
+ * Runs the work unit request and sets reply to the reply to send back.
+ */
+int
+SedRemoteWorker::handle (const std::string& request, std::string& reply)
+{
+  SedRemoteReader in(request);
+
+  std::string data, taskId, modelId;
+  unsigned long numSources;
+  bool valid = in.readMagic(WORK_UNIT_MAGIC) && in.readBlock(data)
+    && in.readBlock(taskId) && in.readBlock(modelId)
+    && in.readFixed32(numSources);
+
+  std::vector<std::pair<std::string, std::string> > sources;
+  for (unsigned long i = 0; i < numSources && valid; ++i)
+  {
+    std::pair<std::string, std::string> source;
+    valid = in.readBlock(source.first) && in.readBlock(source.second);
+    if (valid) sources.push_back(source);
+  }
+
+  SedDocument* doc = (valid && in.atEnd()) ? SedBinaryCodec::decode(data) : NULL;
+
+  const SedTask* task = (doc != NULL) ? doc->getTask(taskId) : NULL;
+  const SedModel* model = (doc != NULL) ? doc->getModel(modelId) : NULL;
+  const SedSimulation* simulation = (task != NULL)
+    ? doc->getSimulation(task->getSimulationReference()) : NULL;
+  const SedDataGenerator* dg = (doc != NULL)
+    ? doc->getDataGenerator(VARIABLES_ID) : NULL;
+
+  if (task == NULL || model == NULL || simulation == NULL || dg == NULL)
+  {
+    delete doc;
+    reply = encodeReply(LIBSEDML_INVALID_OBJECT, NULL);
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  if (mResolver != NULL)
+  {
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      mResolver->addContents(sources[i].first, sources[i].second);
+    }
+  }
+
+  std::vector<const SedVariable*> variables;
+  for (unsigned int i = 0; i < dg->getNumVariables(); ++i)
+  {
+    variables.push_back(dg->getVariable(i));
+  }
+
+  // the models are loaded in the order of the document, the ones referred
+  // to first, once per id and source
+  int result = LIBSEDML_OPERATION_SUCCESS;
+
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  for (unsigned int i = 0; i < doc->getNumModels(); ++i)
+  {
+    const SedModel* loaded = doc->getModel(i);
+    const std::string key = loaded->getId() + '\n' + loaded->getSource();
+    if (mLoaded.find(key) != mLoaded.end()) continue;
+
+    try
+    {
+      result = mSimulator.loadModel(loaded);
+    }
+    catch (...)
+    {
+      result = LIBSEDML_OPERATION_FAILED;
+    }
+    if (result != LIBSEDML_OPERATION_SUCCESS) break;
+
+    mLoaded.insert(key);
+  }
+
+  mutexUnlock(lock);
+
+  SedResults results;
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+  {
+    try
+    {
+      result = mSimulator.simulate(task, model, simulation, variables, results);
+    }
+    catch (...)
+    {
+      result = LIBSEDML_OPERATION_FAILED;
+    }
+  }
+
+  reply = encodeReply(result, &results);
+  delete doc;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Forgets which models were loaded.
+ */
+void
+SedRemoteWorker::clear ()
+{
+  SedMutex* lock = static_cast<SedMutex*>(mLock);
+  mutexLock(lock);
+
+  mLoaded.clear();
+
+  mutexUnlock(lock);
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedRemoteSimulator sending work units through func.
+ */
+LIBSEDML_EXTERN
+SedRemoteSimulator_t *
+SedRemoteSimulator_create (unsigned int numNodes,
+                           SedRemoteSimulator_callFunc func, void *userData)
+{
+  return new (nothrow) SedCallbackRemoteSimulator(numNodes, func, userData);
+}
+
+
+/**
+ * Frees the given SedRemoteSimulator.
+ */
+LIBSEDML_EXTERN
+void
+SedRemoteSimulator_free (SedRemoteSimulator_t *srs)
+{
+  delete srs;
+}
+
+
+/**
+ * Has the sources of the models resolved through resolver.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteSimulator_setSourceResolver (SedRemoteSimulator_t *srs,
+                                      SedSourceResolver_t *resolver,
+                                      const char *base)
+{
+  if (srs == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  srs->setSourceResolver(resolver, base != NULL ? base : "");
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Places the models of document on the nodes by their number of tasks.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteSimulator_assign (SedRemoteSimulator_t *srs,
+                           const SedDocument_t *document)
+{
+  return (srs != NULL) ? srs->assign(document) : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Registers the given SedRemoteSimulator with se for models in language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setRemoteSimulator (SedExecutor_t *se, const char *language,
+                                SedRemoteSimulator_t *srs)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  se->setSimulator(language != NULL ? language : "", srs);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Creates a new SedRemoteWorker running work units with func.
+ */
+LIBSEDML_EXTERN
+SedRemoteWorker_t *
+SedRemoteWorker_create (SedExecutor_simulateFunc func, void *userData,
+                        SedSourceResolver_t *resolver)
+{
+  if (func == NULL) return NULL;
+  return new (nothrow) SedCallbackRemoteWorker(func, userData, resolver);
+}
+
+
+/**
+ * Frees the given SedRemoteWorker.
+ */
+LIBSEDML_EXTERN
+void
+SedRemoteWorker_free (SedRemoteWorker_t *srw)
+{
+  delete srw;
+}
+
+
+/**
+ * Runs the work unit request and sets reply to the reply.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteWorker_handle (SedRemoteWorker_t *srw, const char *request,
+                        size_t length, char **reply, size_t *replyLength)
+{
+  if (srw == NULL || reply == NULL || replyLength == NULL
+      || (request == NULL && length > 0))
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  std::string data;
+  const int result = srw->handle(std::string(request != NULL ? request : "",
+                                             length), data);
+
+  *reply = static_cast<char*>(malloc(data.size() > 0 ? data.size() : 1));
+  if (*reply == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  memcpy(*reply, data.data(), data.size());
+  *replyLength = data.size();
+  return result;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,454 @@
+/**
+ * @file    SedRemoteSimulator.h
+ * @brief   Sends the tasks of a SedExecutor to simulators on other nodes
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedRemoteSimulator
+ * @ingroup Core
+ * @brief A SedSimulator that has each task simulated on another node.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Registered with SedExecutor::setSimulator(), a SedRemoteSimulator
+ * turns every task the executor hands it into a self-contained work unit
+ * and sends it, through a SedTransport, to one of the nodes of a
+ * cluster.  There a SedRemoteWorker gives it to the simulator of that
+ * node and sends back the columns of the results.  The executor keeps
+ * scheduling the tasks as before, so it should be given as many threads
+ * as there are tasks that all nodes together can run at once; each
+ * thread waits for the reply to the work unit it sent.
+ *
+ * A work unit is a SedDocument, encoded by SedBinaryCodec, holding the
+ * model of the task, the models its source refers to by
+ * <code>#id</code>, the simulation, the task and a data generator with
+ * the variables wanted.  A sweep point arrives here as its task with a
+ * changed copy of the model, so it is sent the same way.  With
+ * setSourceResolver(), the source of the model is resolved here.  The
+ * unit then carries the location and the contents of the source, the
+ * first time it is sent to a node, and the model refers to the location.
+ * A SedRemoteWorker with a SedSourceResolver keeps those contents, so
+ * the node does not have to reach the source itself.
+ *
+ * Tasks are placed by model: all tasks of one model, and of the models
+ * deriving from it by <code>#id</code>, go to the same node, which then
+ * loads and prepares the model once.  assign() places the models of a
+ * document before it is run, the models with the most tasks first, each
+ * on the node with the fewest tasks so far.  Models not placed by then
+ * go to the node with the fewest tasks when their first task is sent.
+ *
+ * The work unit is the magic bytes @c SEDU followed by blocks, each a
+ * 4-byte little-endian length and its bytes: the encoded document, the
+ * id of the task, the id of the model, then the number of sources as
+ * 4 bytes, and the location and contents of each.  The reply is the
+ * magic bytes @c SEDO, the status returned by the simulator as 4 bytes,
+ * the number of columns as 4 bytes, and for each column its id as a
+ * block, its length as 8 bytes and its values as 8-byte IEEE 754
+ * little-endian doubles.
+ *
+ * @class SedTransport
+ * @ingroup Core
+ * @brief Carries work units to the nodes of a cluster and their replies
+ * back.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * libSEDML depends on neither MPI nor any network library, so the
+ * transport is supplied by the application: over MPI, call() would send
+ * the request to the rank of the node and receive its reply; over
+ * sockets, it would write the request as one length-prefixed message to
+ * the connection of the node and read the reply the same way.  call() is
+ * called by the threads of the executor at the same time, for the same
+ * node or different ones.
+ *
+ * @class SedRemoteWorker
+ * @ingroup Core
+ * @brief Simulates the work units a SedRemoteSimulator sends.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * Every node runs a SedRemoteWorker over its own SedSimulator and feeds
+ * it each request its transport receives; handle() decodes the work
+ * unit, loads its models the first time they are seen, simulates the
+ * task and encodes the results as the reply.  handle() may be called by
+ * several threads at the same time.
+ */
+
+#ifndef SedRemoteSimulator_h
+#define SedRemoteSimulator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedExecutor.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedSourceResolver;
+
+
+class LIBSEDML_EXTERN SedTransport
+{
+public:
+
+  /**
+   * Destroys this SedTransport.
+   */
+  virtual ~SedTransport ();
+
+
+  /**
+   * @return the number of nodes work units can be sent to; they are
+   * numbered from 0.
+   */
+  virtual unsigned int getNumNodes () const = 0;
+
+
+  /**
+   * Sends @p request to @p node and waits for the reply.
+   *
+   * @param node the node, below getNumNodes().
+   * @param request the work unit.
+   * @param reply receives what SedRemoteWorker::handle() replied on the
+   * node.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if the reply was received; any other value fails the task.
+   */
+  virtual int call (unsigned int node, const std::string& request,
+                    std::string& reply) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedRemoteSimulator : public SedSimulator
+{
+public:
+
+  /**
+   * Creates a SedRemoteSimulator sending work units through
+   * @p transport, which is not owned.
+   */
+  SedRemoteSimulator (SedTransport* transport = NULL);
+
+
+  /**
+   * Destroys this SedRemoteSimulator.
+   */
+  virtual ~SedRemoteSimulator ();
+
+
+  /**
+   * Sets the transport, which is not owned; the places of the models are
+   * forgotten.
+   */
+  void setTransport (SedTransport* transport);
+
+
+  /**
+   * @return the transport, or @c NULL.
+   */
+  SedTransport* getTransport () const;
+
+
+  /**
+   * Has the sources of the models resolved through @p resolver, which is
+   * not owned, for a document read from @p base, and sent with the work
+   * units; with @c NULL, the sources are sent as they are.
+   */
+  void setSourceResolver (SedSourceResolver* resolver,
+                          const std::string& base = "");
+
+
+  /**
+   * Places the models of @p document on the nodes of the transport by
+   * the number of their tasks, replacing the places of earlier models.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p document is @c NULL or there is no transport with nodes
+   */
+  int assign (const SedDocument* document);
+
+
+  /**
+   * @return the node the tasks of the model @p modelId go to, or
+   * <code>(unsigned int)-1</code> if it has not been placed.
+   */
+  unsigned int getNode (const std::string& modelId) const;
+
+
+  /**
+   * @return the number of tasks placed on @p node, by assign() and by the
+   * tasks sent since.
+   */
+  unsigned int getNumTasks (unsigned int node) const;
+
+
+  /**
+   * Sends @p task to the node of its model and stores the columns it
+   * replies with in @p results.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if the remote simulator succeeded, what it returned if it failed, or
+   * @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the work unit could not be made or sent, or the reply is not one.
+   */
+  virtual int simulate (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation,
+                        const std::vector<const SedVariable*>& variables,
+                        SedResults& results);
+
+
+  /**
+   * Encodes @p task, with @p model, @p simulation and @p variables, as a
+   * work unit.  If @p sourceLocation is not empty, the model the source of
+   * @p model leads to, by <code>#id</code>, refers to it instead of its
+   * source, and @p sourceContents, unless empty, are sent as its
+   * contents.
+   *
+   * @return the work unit, or an empty string if the elements do not make
+   * a valid document.
+   */
+  static std::string encodeWorkUnit (const SedTask* task,
+                                     const SedModel* model,
+                                     const SedSimulation* simulation,
+                                     const std::vector<const SedVariable*>& variables,
+                                     const std::string& sourceLocation = "",
+                                     const std::string& sourceContents = "");
+
+
+  /**
+   * Reads the reply to a work unit into @p results.
+   *
+   * @return the status of the remote simulator, or
+   * @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if @p reply is not a reply.
+   */
+  static int decodeReply (const std::string& reply, SedResults& results);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  unsigned int placeModel (const std::string& modelId);
+
+  static const SedModel* getRootModel (const SedTask* task,
+                                       const SedModel* model);
+
+  SedTransport*                        mTransport;
+  SedSourceResolver*                   mResolver;
+  std::string                          mBase;
+  std::map<std::string, unsigned int>  mNodes;
+  std::set<std::string>                mAssigned;
+  std::vector<unsigned int>            mNumTasks;
+  std::set<std::pair<unsigned int, std::string> > mSent;
+  void*                                mLock;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedRemoteSimulator (const SedRemoteSimulator&);
+  SedRemoteSimulator& operator= (const SedRemoteSimulator&);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedRemoteWorker
+{
+public:
+
+  /**
+   * Creates a SedRemoteWorker running work units with @p simulator and
+   * keeping the sources they carry in @p resolver, if not @c NULL;
+   * neither is owned.
+   */
+  SedRemoteWorker (SedSimulator& simulator,
+                   SedSourceResolver* resolver = NULL);
+
+
+  /**
+   * Destroys this SedRemoteWorker.
+   */
+  virtual ~SedRemoteWorker ();
+
+
+  /**
+   * Runs the work unit @p request and sets @p reply to the reply to send
+   * back, which holds the status of the simulator.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if @p reply was set, whatever the simulator returned
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p request is not a work unit; @p reply is then a reply with the
+   * same status
+   */
+  int handle (const std::string& request, std::string& reply);
+
+
+  /**
+   * Forgets which models were loaded, so that they are loaded again.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedSimulator&          mSimulator;
+  SedSourceResolver*     mResolver;
+  std::set<std::string>  mLoaded;
+  void*                  mLock;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedRemoteWorker (const SedRemoteWorker&);
+  SedRemoteWorker& operator= (const SedRemoteWorker&);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Function sending @p request, of @p requestLength bytes, to @p node for
+ * a SedRemoteSimulator; it sets @p reply to the reply, allocated with
+ * @c malloc() and freed by the caller, and @p replyLength to its length,
+ * and returns LIBSEDML_OPERATION_SUCCESS on success.
+ */
+typedef int (*SedRemoteSimulator_callFunc) (unsigned int node,
+                                            const char *request,
+                                            size_t requestLength,
+                                            char **reply,
+                                            size_t *replyLength,
+                                            void *userData);
+
+
+/**
+ * Creates a new SedRemoteSimulator sending work units to @p numNodes
+ * nodes through @p func and returns it.
+ */
+LIBSEDML_EXTERN
+SedRemoteSimulator_t *
+SedRemoteSimulator_create (unsigned int numNodes,
+                           SedRemoteSimulator_callFunc func, void *userData);
+
+
+/**
+ * Frees the given SedRemoteSimulator.
+ */
+LIBSEDML_EXTERN
+void
+SedRemoteSimulator_free (SedRemoteSimulator_t *srs);
+
+
+/**
+ * Has the sources of the models resolved through @p resolver, for a
+ * document read from @p base, and sent with the work units.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteSimulator_setSourceResolver (SedRemoteSimulator_t *srs,
+                                      SedSourceResolver_t *resolver,
+                                      const char *base);
+
+
+/**
+ * Places the models of @p document on the nodes by their number of tasks.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteSimulator_assign (SedRemoteSimulator_t *srs,
+                           const SedDocument_t *document);
+
+
+/**
+ * Registers the given SedRemoteSimulator, which stays owned by the caller,
+ * with @p se for models in @p language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setRemoteSimulator (SedExecutor_t *se, const char *language,
+                                SedRemoteSimulator_t *srs);
+
+
+/**
+ * Creates a new SedRemoteWorker running work units with @p func, keeping
+ * their sources in @p resolver if it is not @c NULL, and returns it.
+ */
+LIBSEDML_EXTERN
+SedRemoteWorker_t *
+SedRemoteWorker_create (SedExecutor_simulateFunc func, void *userData,
+                        SedSourceResolver_t *resolver);
+
+
+/**
+ * Frees the given SedRemoteWorker.
+ */
+LIBSEDML_EXTERN
+void
+SedRemoteWorker_free (SedRemoteWorker_t *srw);
+
+
+/**
+ * Runs the work unit @p request, of @p length bytes, and sets @p reply to
+ * the reply, allocated with @c malloc(), and @p replyLength to its length.
+ */
+LIBSEDML_EXTERN
+int
+SedRemoteWorker_handle (SedRemoteWorker_t *srw, const char *request,
+                        size_t length, char **reply, size_t *replyLength);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedRemoteSimulator_h */
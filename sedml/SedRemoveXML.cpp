@@ -120,14 +120,16 @@ SedRemoveXML::~SedRemoveXML ()
 }
 
 
+static const std::string sSedRemoveXMLName("removeXML");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedRemoveXML::getElementName () const
 {
-	static const string name = "removeXML";
-	return name;
+	return sSedRemoveXMLName;
 }
 
 
@@ -141,8 +143,6 @@ SedRemoveXML::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedChange::connectToChild();
-
 	return object;
 }
 
@@ -187,13 +187,12 @@ SedRemoveXML::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedRemoveXML::accept (SedVisitor& v) const
+SedRemoveXML::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -263,6 +262,18 @@ SedRemoveXML::writeAttributes (XMLOutputStream& stream) const
 }
 
 
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedRemoveXML::addAttributes (XMLAttributes& attributes) const
+{
+	SedChange::addAttributes(attributes);
+
+}
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -81,6 +81,7 @@ SedReport::SedReport (SedNamespaces* sedns)
  */
 SedReport::SedReport (const SedReport& orig)
 	: SedOutput(orig)
+	, mDataSet (orig.mDataSet)
 {
 	if (&orig == NULL)
 	{
@@ -88,7 +89,6 @@ SedReport::SedReport (const SedReport& orig)
 	}
 	else
 	{
-		mDataSet  = orig.mDataSet;
 
 		// connect to child objects
 		connectToChild();
@@ -227,6 +227,17 @@ SedReport::addDataSet(const SedDataSet* sds)
 }
 
 
+/*
+ * Adds the given SedDataSet to this SedReport, which takes ownership of it.
+ */
+int
+SedReport::addDataSetAndOwn(SedDataSet* sds)
+{
+	if(sds == NULL) return LIBSEDML_INVALID_OBJECT;
+	return mDataSet.appendAndOwn(sds);
+}
+
+
 /**
  * Get the number of SedDataSet objects in this SedReport.
  *
@@ -249,19 +260,22 @@ SedReport::getNumDataSets() const
 SedDataSet* 
 SedReport::createDataSet()
 {
-	SedDataSet *temp = new SedDataSet();
+	if (isFrozen()) return NULL;
+	SedDataSet *temp = new (getArena()) SedDataSet();
 	if (temp != NULL) mDataSet.appendAndOwn(temp);
 	return temp;
 }
 
+static const std::string sSedReportName("report");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedReport::getElementName () const
 {
-	static const string name = "report";
-	return name;
+	return sSedReportName;
 }
 
 
@@ -275,8 +289,6 @@ SedReport::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedOutput::connectToChild();
-
 	if (name == "listOfDataSets")
 	{
 		object = &mDataSet;
@@ -298,6 +310,41 @@ SedReport::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedReport::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, &mDataSet);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this Report.
+ */
+unsigned int
+SedReport::getNumChildElements () const
+{
+	return 1;
+}
+
+
+/*
+ * Returns the nth element directly contained in this Report.
+ */
+const SedBase*
+SedReport::getChildElement (unsigned int n) const
+{
+	return (n == 0) ? &mDataSet : NULL;
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -354,13 +401,12 @@ SedReport::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedReport::accept (SedVisitor& v) const
+SedReport::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -430,6 +476,18 @@ SedReport::writeAttributes (XMLOutputStream& stream) const
 }
 
 
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedReport::addAttributes (XMLAttributes& attributes) const
+{
+	SedOutput::addAttributes(attributes);
+
+}
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -481,6 +539,13 @@ SedReport_addDataSet(SedReport_t * sr, SedDataSet_t * sds)
 	return  (sr != NULL) ? sr->addDataSet(sds) : LIBSBML_INVALID_OBJECT;
 }
 
+LIBSEDML_EXTERN
+int
+SedReport_addDataSetAndOwn(SedReport_t * sr, SedDataSet_t * sds)
+{
+	return  (sr != NULL) ? sr->addDataSetAndOwn(sds) : LIBSEDML_INVALID_OBJECT;
+}
+
 LIBSEDML_EXTERN
 SedDataSet_t *
 SedReport_createDataSet(SedReport_t * sr)
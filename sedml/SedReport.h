@@ -204,6 +204,25 @@ public:
 	int addDataSet(const SedDataSet* sds);
 
 
+	/**
+	 * Adds the given "SedDataSet" to this SedReport without copying it; this
+	 * SedReport takes ownership of @p sds and will delete it.
+	 *
+	 * @param sds the SedDataSet object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p sds is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addDataSet(const SedDataSet* sds)
+	 */
+	int addDataSetAndOwn(SedDataSet* sds);
+
+
 	/**
 	 * Get the number of SedDataSet objects in this SedReport.
 	 *
@@ -252,6 +271,33 @@ public:
 	SedDataSet* removeDataSet(const std::string& sid);
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedReport.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedReport.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedReport, is
 	 * always @c "sedReport".
@@ -334,9 +380,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -408,6 +454,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -445,6 +498,11 @@ int
 SedReport_addDataSet(SedReport_t * sr, SedDataSet_t * sds);
 
 
+LIBSEDML_EXTERN
+int
+SedReport_addDataSetAndOwn(SedReport_t * sr, SedDataSet_t * sds);
+
+
 LIBSEDML_EXTERN
 SedDataSet_t *
 SedReport_createDataSet(SedReport_t * sr);
@@ -0,0 +1,1317 @@
+/**
+ * @file    SedReportWriter.cpp
+ * @brief   Writes the values of a SedReport to CSV, HDF5 or Arrow a chunk at a time
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedOutputSink.h>
+#include <sedml/SedNumber.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#ifdef USE_HDF5
+#  include <hdf5.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Size at which the CSV text of a chunk is passed on to the sink.
+ */
+static const size_t SED_REPORT_BUFFER_SIZE = 64 * 1024;
+
+/*
+ * Number of rows per chunk of the HDF5 dataset.
+ */
+static const size_t SED_REPORT_HDF5_CHUNK = 1024;
+
+
+/*
+ * Appends value to text as a CSV field, quoted if necessary.
+ */
+static void
+appendField (std::string& text, const std::string& value)
+{
+  if (value.find_first_of(",\"\r\n") == std::string::npos)
+  {
+    text += value;
+    return;
+  }
+
+  text += '"';
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    if (value[i] == '"') text += '"';
+    text += value[i];
+  }
+  text += '"';
+}
+
+
+#ifdef USE_HDF5
+/*
+ * The open HDF5 file and dataset of a SedReportWriter.
+ */
+struct SedReportHdf5
+{
+  hid_t file;
+  hid_t dataset;
+};
+
+
+/*
+ * Attaches the strings values to dataset as the attribute name.
+ */
+static bool
+writeStringAttribute (hid_t dataset, const char* name,
+                      const std::vector<std::string>& values)
+{
+  std::vector<const char*> strings(values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    strings[i] = values[i].c_str();
+  }
+
+  hsize_t dims[1] = { (hsize_t)values.size() };
+  hid_t space = H5Screate_simple(1, dims, NULL);
+  hid_t type  = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type, H5T_VARIABLE);
+
+  hid_t attribute = H5Acreate2(dataset, name, type, space,
+                               H5P_DEFAULT, H5P_DEFAULT);
+  bool result = attribute >= 0
+             && H5Awrite(attribute, type, &strings[0]) >= 0;
+
+  if (attribute >= 0) H5Aclose(attribute);
+  H5Tclose(type);
+  H5Sclose(space);
+  return result;
+}
+#endif
+
+
+/*
+ * Number of NaN values a SedReportWriter writes at a time for the rows
+ * an Arrow column lacks.
+ */
+static const size_t SED_REPORT_ARROW_FILL = 1024;
+
+/*
+ * The Arrow message header types and type ids used.
+ */
+static const unsigned int SED_ARROW_HEADER_SCHEMA       = 1;
+static const unsigned int SED_ARROW_HEADER_RECORD_BATCH = 3;
+static const unsigned int SED_ARROW_TYPE_FLOATING_POINT = 3;
+static const unsigned int SED_ARROW_PRECISION_DOUBLE    = 2;
+static const unsigned int SED_ARROW_METADATA_V5         = 4;
+
+
+/*
+ * Appends the bytes bytes of value to text, least significant first.
+ */
+static void
+appendInt (std::string& text, unsigned long long value, size_t bytes)
+{
+  for (size_t i = 0; i < bytes; ++i)
+  {
+    text += (char)((value >> (8 * i)) & 0xFF);
+  }
+}
+
+
+/*
+ * Builds the flatbuffer of an Arrow IPC message front to back.  Every
+ * table is preceded by its vtable, and the strings, vectors and tables
+ * it refers to are added after it, so that all offsets point forward, as
+ * flatbuffers require.  Integers are always stored little-endian.
+ */
+class SedArrowBuilder
+{
+public:
+
+  SedArrowBuilder ()
+    : mVtable (0)
+    , mTable (0)
+  {
+    // the offset of the root table, set by setRoot()
+    put(0, 4);
+  }
+
+
+  void put (unsigned long long value, size_t bytes)
+  {
+    appendInt(data, value, bytes);
+  }
+
+
+  void set (size_t pos, unsigned long long value, size_t bytes)
+  {
+    for (size_t i = 0; i < bytes; ++i)
+    {
+      data[pos + i] = (char)((value >> (8 * i)) & 0xFF);
+    }
+  }
+
+
+  /*
+   * Pads with zeros until the size plus extra is a multiple of n.
+   */
+  void align (size_t n, size_t extra = 0)
+  {
+    while ((data.size() + extra) % n != 0) data += '\0';
+  }
+
+
+  /*
+   * Starts a table of numFields fields and returns its position.
+   */
+  size_t startTable (unsigned int numFields)
+  {
+    align(2);
+    mVtable = data.size();
+    put(4 + 2 * numFields, 2);
+    put(0, 2);
+    for (unsigned int i = 0; i < numFields; ++i) put(0, 2);
+
+    align(4);
+    mTable = data.size();
+    put(mTable - mVtable, 4);
+    return mTable;
+  }
+
+
+  /*
+   * Adds the field id of the table started last, a scalar of the given
+   * size or, with the value 0 and 4 bytes, an offset to set later, and
+   * returns its position.
+   */
+  size_t addField (unsigned int id, unsigned long long value, size_t bytes)
+  {
+    align(bytes);
+    const size_t pos = data.size();
+    set(mVtable + 4 + 2 * id, pos - mTable, 2);
+    put(value, bytes);
+    return pos;
+  }
+
+
+  void endTable ()
+  {
+    set(mVtable + 2, data.size() - mTable, 2);
+  }
+
+
+  /*
+   * Points the offset at pos to the object at target, which follows it.
+   */
+  void setOffset (size_t pos, size_t target)
+  {
+    set(pos, target - pos, 4);
+  }
+
+
+  void setRoot (size_t table)
+  {
+    setOffset(0, table);
+  }
+
+
+  size_t addString (const std::string& value)
+  {
+    align(4);
+    const size_t pos = data.size();
+    put(value.size(), 4);
+    data += value;
+    data += '\0';
+    return pos;
+  }
+
+
+  /*
+   * Adds a vector of count offsets to set later; the i-th is at
+   * getElement(vector, i).
+   */
+  size_t addVector (size_t count)
+  {
+    align(4);
+    const size_t pos = data.size();
+    put(count, 4);
+    for (size_t i = 0; i < count; ++i) put(0, 4);
+    return pos;
+  }
+
+
+  static size_t getElement (size_t vector, size_t i)
+  {
+    return vector + 4 + 4 * i;
+  }
+
+
+  /*
+   * Adds a vector of count structs of two longs, which are put next.
+   */
+  size_t addPairVector (size_t count)
+  {
+    align(8, 4);
+    const size_t pos = data.size();
+    put(count, 4);
+    return pos;
+  }
+
+
+  /*
+   * Adds a vector of the key/value pairs, each a KeyValue table, and
+   * returns its position.
+   */
+  size_t addKeyValues (const std::vector<std::string>& pairs)
+  {
+    const size_t vector = addVector(pairs.size() / 2);
+    for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+    {
+      const size_t table = startTable(2);
+      const size_t key   = addField(0, 0, 4);
+      const size_t value = addField(1, 0, 4);
+      endTable();
+
+      setOffset(getElement(vector, i / 2), table);
+      setOffset(key, addString(pairs[i]));
+      setOffset(value, addString(pairs[i + 1]));
+    }
+    return vector;
+  }
+
+
+  /*
+   * Adds a Message table with the given header and body length, and
+   * returns the position of the offset of the header to set.
+   */
+  size_t addMessage (unsigned int headerType, size_t bodyLength)
+  {
+    setRoot(startTable(5));
+    addField(0, SED_ARROW_METADATA_V5, 2);
+    addField(1, headerType, 1);
+    const size_t header = addField(2, 0, 4);
+    addField(3, bodyLength, 8);
+    endTable();
+    return header;
+  }
+
+
+  /*
+   * Returns the message, framed as in an Arrow IPC stream: a continuation
+   * marker, the size of the flatbuffer padded to 8 bytes, and the padded
+   * flatbuffer; the body follows.
+   */
+  std::string getMessage ()
+  {
+    align(8);
+    std::string message;
+    appendInt(message, 0xFFFFFFFFu, 4);
+    appendInt(message, data.size(), 4);
+    return message + data;
+  }
+
+
+  std::string  data;
+
+private:
+
+  size_t       mVtable;
+  size_t       mTable;
+};
+
+
+/*
+ * Returns true if doubles are stored little-endian, as Arrow readers
+ * assume unless the schema says otherwise.
+ */
+static bool
+isLittleEndian ()
+{
+  const unsigned short probe = 1;
+  return *(const unsigned char*)&probe == 1;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedReportWriter that is not open.
+ */
+SedReportWriter::SedReportWriter ()
+  : mFormat (SED_REPORT_FORMAT_CSV)
+  , mOpen (false)
+  , mFailed (false)
+  , mNumRows (0)
+  , mSink (NULL)
+  , mOwnedSink (NULL)
+  , mHdf5 (NULL)
+{
+}
+
+
+/*
+ * Destroys this SedReportWriter.
+ */
+SedReportWriter::~SedReportWriter ()
+{
+  if (mOpen) close();
+}
+
+
+/*
+ * Starts writing report to the file filename.
+ */
+int
+SedReportWriter::open (const SedReport* report, const std::string& filename,
+                       SedReportFormat_t format)
+{
+  if (mOpen || !isFormatAvailable(format)) return LIBSEDML_OPERATION_FAILED;
+  if (!setReport(report)) return LIBSEDML_INVALID_OBJECT;
+
+  mFormat  = format;
+  mFailed  = false;
+  mNumRows = 0;
+
+  if (format == SED_REPORT_FORMAT_HDF5)
+  {
+    const std::string name = report->isSetId() ? report->getId() : "report";
+    if (!openHdf5(filename, name)) return LIBSEDML_OPERATION_FAILED;
+
+    mOpen = true;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  SedFileSink* sink = new (nothrow) SedFileSink(filename);
+  if (sink == NULL || !sink->isOpen())
+  {
+    delete sink;
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mOwnedSink = sink;
+  mSink      = sink;
+  mOpen      = true;
+
+  const bool started = (format == SED_REPORT_FORMAT_ARROW)
+                     ? writeArrowSchema(report) : writeHeader();
+  if (!started)
+  {
+    close();
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Starts writing report as CSV or Arrow to sink.
+ */
+int
+SedReportWriter::open (const SedReport* report, SedOutputSink& sink,
+                       SedReportFormat_t format)
+{
+  if (mOpen || format == SED_REPORT_FORMAT_HDF5 || !isFormatAvailable(format))
+    return LIBSEDML_OPERATION_FAILED;
+  if (!setReport(report)) return LIBSEDML_INVALID_OBJECT;
+
+  mFormat  = format;
+  mFailed  = false;
+  mNumRows = 0;
+  mSink    = &sink;
+  mOpen    = true;
+
+  const bool started = (format == SED_REPORT_FORMAT_ARROW)
+                     ? writeArrowSchema(report) : writeHeader();
+  if (!started)
+  {
+    close();
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Reopens the file filename written for report, keeping numRows rows.
+ */
+int
+SedReportWriter::resume (const SedReport* report, const std::string& filename,
+                         size_t numRows, SedReportFormat_t format)
+{
+  if (mOpen || format == SED_REPORT_FORMAT_ARROW || !isFormatAvailable(format))
+    return LIBSEDML_OPERATION_FAILED;
+  if (!setReport(report)) return LIBSEDML_INVALID_OBJECT;
+
+  mFormat  = format;
+  mFailed  = false;
+  mNumRows = numRows;
+
+  if (format == SED_REPORT_FORMAT_HDF5)
+  {
+    const std::string name = report->isSetId() ? report->getId() : "report";
+    if (!resumeHdf5(filename, name, numRows)) return LIBSEDML_OPERATION_FAILED;
+
+    mOpen = true;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  if (!resumeCsv(filename, numRows)) return LIBSEDML_OPERATION_FAILED;
+
+  SedFileSink* sink = new (nothrow) SedFileSink(filename, true);
+  if (sink == NULL || !sink->isOpen())
+  {
+    delete sink;
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  mOwnedSink = sink;
+  mSink      = sink;
+  mOpen      = true;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if this writer is open.
+ */
+bool
+SedReportWriter::isOpen () const
+{
+  return mOpen;
+}
+
+
+/*
+ * Appends the rows offset to offset + length - 1 of results.
+ */
+int
+SedReportWriter::writeChunk (const SedResults& results, size_t offset,
+                             size_t length)
+{
+  if (!mOpen || mFailed) return LIBSEDML_OPERATION_FAILED;
+  if (length == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (mFormat == SED_REPORT_FORMAT_HDF5)
+  {
+    if (!writeHdf5(results, offset, length))
+    {
+      mFailed = true;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+    mNumRows += length;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  if (mFormat == SED_REPORT_FORMAT_ARROW)
+  {
+    if (!writeArrow(results, offset, length))
+    {
+      mFailed = true;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+    mNumRows += length;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  // the views are looked up once per chunk, not once per value
+  std::vector<SedColumnView> views(mReferences.size());
+  for (size_t i = 0; i < mReferences.size(); ++i)
+  {
+    views[i] = results.getView(mReferences[i]);
+  }
+
+  char number[SedNumber::BUFFER_SIZE];
+
+  for (size_t row = offset; row < offset + length; ++row)
+  {
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+      if (i > 0) mBuffer += ',';
+      if (row < views[i].length)
+      {
+        const unsigned int n = SedNumber::format(views[i].data[row], number);
+        mBuffer.append(number, (size_t)n);
+      }
+    }
+    mBuffer += '\n';
+
+    if (!flushBuffer(false))
+    {
+      mFailed = true;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  }
+
+  mNumRows += length;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Appends all rows of results.
+ */
+int
+SedReportWriter::writeChunk (const SedResults& results)
+{
+  size_t length = 0;
+  for (size_t i = 0; i < mReferences.size(); ++i)
+  {
+    size_t n = results.getColumnLength(mReferences[i]);
+    if (n > length) length = n;
+  }
+
+  return writeChunk(results, 0, length);
+}
+
+
+/*
+ * Returns the number of rows written.
+ */
+size_t
+SedReportWriter::getNumRows () const
+{
+  return mNumRows;
+}
+
+
+/*
+ * Writes what is still buffered, so that all rows written are in the file.
+ */
+int
+SedReportWriter::flush ()
+{
+  if (!mOpen || mFailed) return LIBSEDML_OPERATION_FAILED;
+
+  bool result;
+  if (mFormat == SED_REPORT_FORMAT_HDF5)
+  {
+    result = flushHdf5();
+  }
+  else
+  {
+    result = flushBuffer(true)
+          && (mOwnedSink == NULL || mOwnedSink->flush());
+  }
+
+  if (!result) mFailed = true;
+  return result ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Writes what is still buffered and closes the output.
+ */
+int
+SedReportWriter::close ()
+{
+  if (!mOpen) return LIBSEDML_OPERATION_FAILED;
+
+  bool result = !mFailed;
+
+  if (mFormat == SED_REPORT_FORMAT_HDF5)
+  {
+    result = closeHdf5() && result;
+  }
+  else
+  {
+    if (mFormat == SED_REPORT_FORMAT_ARROW)
+    {
+      // the end-of-stream marker
+      std::string end;
+      appendInt(end, 0xFFFFFFFFu, 4);
+      appendInt(end, 0, 4);
+      mBuffer += end;
+    }
+
+    result = flushBuffer(true) && result;
+    result = mSink->finish() && result;
+    delete mOwnedSink;
+  }
+
+  mOpen      = false;
+  mSink      = NULL;
+  mOwnedSink = NULL;
+  mBuffer.clear();
+  mRows.clear();
+
+  return result ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Returns true if libSEDML was built with support for format.
+ */
+bool
+SedReportWriter::isFormatAvailable (SedReportFormat_t format)
+{
+  switch (format)
+  {
+  case SED_REPORT_FORMAT_CSV:
+  case SED_REPORT_FORMAT_ARROW:
+    return true;
+  case SED_REPORT_FORMAT_HDF5:
+#ifdef USE_HDF5
+    return true;
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Takes the data references and labels of the data sets of report.
+ */
+bool
+SedReportWriter::setReport (const SedReport* report)
+{
+  mReferences.clear();
+  mLabels.clear();
+
+  if (report == NULL || report->getNumDataSets() == 0) return false;
+
+  for (unsigned int i = 0; i < report->getNumDataSets(); ++i)
+  {
+    const SedDataSet* ds = report->getDataSet(i);
+    mReferences.push_back(ds->getDataReference());
+    mLabels.push_back(ds->isSetLabel() ? ds->getLabel() : ds->getId());
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns the CSV header line.
+ */
+std::string
+SedReportWriter::getHeader () const
+{
+  std::string header;
+  for (size_t i = 0; i < mLabels.size(); ++i)
+  {
+    if (i > 0) header += ',';
+    appendField(header, mLabels[i]);
+  }
+  header += '\n';
+
+  return header;
+}
+
+
+/*
+ * Writes the CSV header line.
+ */
+bool
+SedReportWriter::writeHeader ()
+{
+  mBuffer += getHeader();
+  return flushBuffer(false);
+}
+
+
+/*
+ * Checks that the CSV file filename starts with the header of the report
+ * and has at least numRows rows, and cuts it after them.
+ */
+bool
+SedReportWriter::resumeCsv (const std::string& filename, size_t numRows)
+{
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file == NULL) return false;
+
+  const std::string header = getHeader();
+  std::vector<char> block(SED_REPORT_BUFFER_SIZE);
+
+  // the header is matched byte by byte, then the rows are counted by
+  // their line ends; end is the size of the part kept
+  size_t matched = 0;
+  size_t rows    = 0;
+  size_t end     = 0;
+  bool   more    = false;
+  bool   ok      = true;
+
+  while (ok)
+  {
+    const size_t n = fread(&block[0], 1, block.size(), file);
+    if (n == 0) break;
+
+    size_t i = 0;
+    for (; i < n && matched < header.size(); ++i, ++matched)
+    {
+      ok = block[i] == header[matched];
+      if (!ok) break;
+    }
+
+    for (; ok && i < n && rows < numRows; ++i)
+    {
+      if (block[i] == '\n') ++rows;
+    }
+
+    end += i;
+    if (ok && matched == header.size() && rows == numRows)
+    {
+      more = i < n || fgetc(file) != EOF;
+      break;
+    }
+  }
+
+  const bool complete = ok && matched == header.size() && rows == numRows;
+  if (!complete || !more)
+  {
+    fclose(file);
+    return complete;
+  }
+
+  // rows written after the ones kept are dropped by copying the part kept
+  // to a new file that replaces the old one
+  const std::string temporary = filename + ".resume.tmp";
+  FILE* copy = fopen(temporary.c_str(), "wb");
+  ok = copy != NULL && fseek(file, 0, SEEK_SET) == 0;
+
+  for (size_t left = end; ok && left > 0; )
+  {
+    const size_t n = fread(&block[0], 1,
+                           (left < block.size()) ? left : block.size(), file);
+    ok = n > 0 && fwrite(&block[0], 1, n, copy) == n;
+    left -= n;
+  }
+
+  fclose(file);
+  if (copy != NULL) ok = (fclose(copy) == 0) && ok;
+
+#ifdef _WIN32
+  // rename does not replace existing files on Windows
+  if (ok) ok = remove(filename.c_str()) == 0;
+#endif
+
+  ok = ok && rename(temporary.c_str(), filename.c_str()) == 0;
+  if (!ok) remove(temporary.c_str());
+
+  return ok;
+}
+
+
+/*
+ * Passes the CSV text on to the sink once enough has accumulated, or at
+ * once if force is true.
+ */
+bool
+SedReportWriter::flushBuffer (bool force)
+{
+  if (mBuffer.empty() || (!force && mBuffer.size() < SED_REPORT_BUFFER_SIZE))
+  {
+    return true;
+  }
+
+  bool result = mSink->write(mBuffer.data(), mBuffer.size());
+  mBuffer.clear();
+  return result;
+}
+
+
+/*
+ * Creates the HDF5 file filename with an empty, growable dataset name.
+ */
+bool
+SedReportWriter::openHdf5 (const std::string& filename,
+                           const std::string& name)
+{
+#ifdef USE_HDF5
+  SedReportHdf5* state = new (nothrow) SedReportHdf5;
+  if (state == NULL) return false;
+
+  state->file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC,
+                          H5P_DEFAULT, H5P_DEFAULT);
+  if (state->file < 0)
+  {
+    delete state;
+    return false;
+  }
+
+  const hsize_t columns = (hsize_t)mReferences.size();
+  hsize_t dims[2]    = { 0, columns };
+  hsize_t maxDims[2] = { H5S_UNLIMITED, columns };
+  hsize_t chunk[2]   = { SED_REPORT_HDF5_CHUNK, columns };
+
+  hid_t space = H5Screate_simple(2, dims, maxDims);
+  hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(plist, 2, chunk);
+
+  state->dataset = H5Dcreate2(state->file, name.c_str(), H5T_NATIVE_DOUBLE,
+                              space, H5P_DEFAULT, plist, H5P_DEFAULT);
+  H5Pclose(plist);
+  H5Sclose(space);
+
+  if (state->dataset < 0
+   || !writeStringAttribute(state->dataset, "labels", mLabels)
+   || !writeStringAttribute(state->dataset, "dataReferences", mReferences))
+  {
+    if (state->dataset >= 0) H5Dclose(state->dataset);
+    H5Fclose(state->file);
+    delete state;
+    return false;
+  }
+
+  mHdf5 = state;
+  return true;
+#else
+  (void)filename; (void)name;
+  return false;
+#endif
+}
+
+
+/*
+ * Opens the dataset name of the HDF5 file filename and cuts it to numRows
+ * rows.
+ */
+bool
+SedReportWriter::resumeHdf5 (const std::string& filename,
+                             const std::string& name, size_t numRows)
+{
+#ifdef USE_HDF5
+  SedReportHdf5* state = new (nothrow) SedReportHdf5;
+  if (state == NULL) return false;
+
+  state->file = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  if (state->file < 0)
+  {
+    delete state;
+    return false;
+  }
+
+  state->dataset = H5Dopen2(state->file, name.c_str(), H5P_DEFAULT);
+
+  hsize_t dims[2] = { 0, 0 };
+  bool ok = state->dataset >= 0;
+  if (ok)
+  {
+    hid_t space = H5Dget_space(state->dataset);
+    ok = H5Sget_simple_extent_ndims(space) == 2
+      && H5Sget_simple_extent_dims(space, dims, NULL) == 2
+      && dims[1] == (hsize_t)mReferences.size()
+      && dims[0] >= (hsize_t)numRows;
+    H5Sclose(space);
+  }
+
+  dims[0] = (hsize_t)numRows;
+  if (!ok || H5Dset_extent(state->dataset, dims) < 0)
+  {
+    if (state->dataset >= 0) H5Dclose(state->dataset);
+    H5Fclose(state->file);
+    delete state;
+    return false;
+  }
+
+  mHdf5 = state;
+  return true;
+#else
+  (void)filename; (void)name; (void)numRows;
+  return false;
+#endif
+}
+
+
+/*
+ * Grows the HDF5 dataset by length rows and writes them.
+ */
+bool
+SedReportWriter::writeHdf5 (const SedResults& results, size_t offset,
+                            size_t length)
+{
+#ifdef USE_HDF5
+  SedReportHdf5* state = static_cast<SedReportHdf5*>(mHdf5);
+  if (state == NULL) return false;
+
+  const size_t columns = mReferences.size();
+
+  // HDF5 wants the rows of the chunk in row-major order; the buffer
+  // holds a single chunk and is reused for the next one
+  mRows.resize(length * columns);
+  for (size_t i = 0; i < columns; ++i)
+  {
+    const SedColumnView view = results.getView(mReferences[i]);
+    for (size_t row = 0; row < length; ++row)
+    {
+      mRows[row * columns + i] = (offset + row < view.length)
+                               ? view.data[offset + row]
+                               : numeric_limits<double>::quiet_NaN();
+    }
+  }
+
+  hsize_t dims[2]  = { (hsize_t)(mNumRows + length), (hsize_t)columns };
+  hsize_t start[2] = { (hsize_t)mNumRows, 0 };
+  hsize_t count[2] = { (hsize_t)length, (hsize_t)columns };
+
+  if (H5Dset_extent(state->dataset, dims) < 0) return false;
+
+  hid_t fileSpace = H5Dget_space(state->dataset);
+  hid_t memSpace  = H5Screate_simple(2, count, NULL);
+
+  bool result =
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL) >= 0
+    && H5Dwrite(state->dataset, H5T_NATIVE_DOUBLE, memSpace, fileSpace,
+                H5P_DEFAULT, &mRows[0]) >= 0;
+
+  H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+  return result;
+#else
+  (void)results; (void)offset; (void)length;
+  return false;
+#endif
+}
+
+
+/*
+ * Writes the HDF5 file out.
+ */
+bool
+SedReportWriter::flushHdf5 ()
+{
+#ifdef USE_HDF5
+  SedReportHdf5* state = static_cast<SedReportHdf5*>(mHdf5);
+  return state != NULL && H5Fflush(state->file, H5F_SCOPE_LOCAL) >= 0;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Closes the HDF5 dataset and file.
+ */
+bool
+SedReportWriter::closeHdf5 ()
+{
+#ifdef USE_HDF5
+  SedReportHdf5* state = static_cast<SedReportHdf5*>(mHdf5);
+  if (state == NULL) return false;
+
+  bool result = H5Dclose(state->dataset) >= 0;
+  result = H5Fclose(state->file) >= 0 && result;
+
+  delete state;
+  mHdf5 = NULL;
+  return result;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * Writes the schema message of the Arrow stream.
+ */
+bool
+SedReportWriter::writeArrowSchema (const SedReport* report)
+{
+  const SedDocument* doc = report->getSedDocument();
+
+  // the tasks the variables of the data generators of the report refer
+  // to, each once
+  std::string tasks;
+  std::vector<std::string> seen;
+  for (size_t i = 0; doc != NULL && i < mReferences.size(); ++i)
+  {
+    const SedDataGenerator* dg = doc->getDataGenerator(mReferences[i]);
+    for (unsigned int j = 0; dg != NULL && j < dg->getNumVariables(); ++j)
+    {
+      const std::string& task = dg->getVariable(j)->getTaskReference();
+      if (task.empty()
+          || std::find(seen.begin(), seen.end(), task) != seen.end())
+        continue;
+
+      if (!seen.empty()) tasks += ',';
+      tasks += task;
+      seen.push_back(task);
+    }
+  }
+
+  std::vector<std::string> metadata;
+  metadata.push_back("sedml:report");
+  metadata.push_back(report->getId());
+  if (doc != NULL && doc->isSetMetaId())
+  {
+    metadata.push_back("sedml:document");
+    metadata.push_back(doc->getMetaId());
+  }
+  metadata.push_back("sedml:tasks");
+  metadata.push_back(tasks);
+
+  SedArrowBuilder fb;
+  const size_t header = fb.addMessage(SED_ARROW_HEADER_SCHEMA, 0);
+
+  fb.setOffset(header, fb.startTable(4));
+  fb.addField(0, isLittleEndian() ? 0 : 1, 2);
+  const size_t fieldsField   = fb.addField(1, 0, 4);
+  const size_t metadataField = fb.addField(2, 0, 4);
+  fb.endTable();
+
+  const size_t fields = fb.addVector(mLabels.size());
+  fb.setOffset(fieldsField, fields);
+
+  for (size_t i = 0; i < mLabels.size(); ++i)
+  {
+    fb.setOffset(SedArrowBuilder::getElement(fields, i), fb.startTable(7));
+    const size_t name = fb.addField(0, 0, 4);
+    fb.addField(1, 0, 1);
+    fb.addField(2, SED_ARROW_TYPE_FLOATING_POINT, 1);
+    const size_t type          = fb.addField(3, 0, 4);
+    const size_t children      = fb.addField(5, 0, 4);
+    const size_t fieldMetadata = fb.addField(6, 0, 4);
+    fb.endTable();
+
+    fb.setOffset(name, fb.addString(mLabels[i]));
+
+    fb.setOffset(type, fb.startTable(1));
+    fb.addField(0, SED_ARROW_PRECISION_DOUBLE, 2);
+    fb.endTable();
+
+    fb.setOffset(children, fb.addVector(0));
+
+    const SedDataSet* ds = report->getDataSet((unsigned int)i);
+    std::vector<std::string> pairs;
+    pairs.push_back("sedml:dataSet");
+    pairs.push_back(ds->getId());
+    pairs.push_back("sedml:dataReference");
+    pairs.push_back(mReferences[i]);
+    fb.setOffset(fieldMetadata, fb.addKeyValues(pairs));
+  }
+
+  fb.setOffset(metadataField, fb.addKeyValues(metadata));
+
+  mBuffer += fb.getMessage();
+  return flushBuffer(true);
+}
+
+
+/*
+ * Writes the rows offset to offset + length - 1 of results as a record
+ * batch of the Arrow stream.
+ */
+bool
+SedReportWriter::writeArrow (const SedResults& results, size_t offset,
+                             size_t length)
+{
+  const size_t columns = mReferences.size();
+  const size_t bytes   = length * sizeof(double);
+
+  // every column is a field node without nulls, with an empty validity
+  // buffer and its values, which follow each other in the body
+  SedArrowBuilder fb;
+  const size_t header = fb.addMessage(SED_ARROW_HEADER_RECORD_BATCH,
+                                      columns * bytes);
+
+  fb.setOffset(header, fb.startTable(3));
+  fb.addField(0, length, 8);
+  const size_t nodesField   = fb.addField(1, 0, 4);
+  const size_t buffersField = fb.addField(2, 0, 4);
+  fb.endTable();
+
+  fb.setOffset(nodesField, fb.addPairVector(columns));
+  for (size_t i = 0; i < columns; ++i)
+  {
+    fb.put(length, 8);
+    fb.put(0, 8);
+  }
+
+  fb.setOffset(buffersField, fb.addPairVector(2 * columns));
+  for (size_t i = 0; i < columns; ++i)
+  {
+    fb.put(i * bytes, 8);
+    fb.put(0, 8);
+    fb.put(i * bytes, 8);
+    fb.put(bytes, 8);
+  }
+
+  mBuffer += fb.getMessage();
+  if (!flushBuffer(true)) return false;
+
+  // the values go to the sink straight from the columns; only the rows a
+  // column lacks are filled in, with NaN
+  if (mRows.size() != SED_REPORT_ARROW_FILL)
+  {
+    mRows.assign(SED_REPORT_ARROW_FILL, numeric_limits<double>::quiet_NaN());
+  }
+
+  for (size_t i = 0; i < columns; ++i)
+  {
+    const SedColumnView view = results.getView(mReferences[i]);
+    size_t present = (offset < view.length) ? view.length - offset : 0;
+    if (present > length) present = length;
+
+    if (present > 0
+        && !mSink->write((const char*)(view.data + offset),
+                         present * sizeof(double)))
+      return false;
+
+    for (size_t left = length - present; left > 0; )
+    {
+      const size_t n = (left < mRows.size()) ? left : mRows.size();
+      if (!mSink->write((const char*)&mRows[0], n * sizeof(double)))
+        return false;
+      left -= n;
+    }
+  }
+
+  return true;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedReportWriter and returns it.
+ */
+LIBSEDML_EXTERN
+SedReportWriter_t *
+SedReportWriter_create ()
+{
+  return new (nothrow) SedReportWriter;
+}
+
+
+/**
+ * Frees the given SedReportWriter.
+ */
+LIBSEDML_EXTERN
+void
+SedReportWriter_free (SedReportWriter_t *srw)
+{
+  delete srw;
+}
+
+
+/**
+ * Starts writing report to the file filename in format.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_open (SedReportWriter_t *srw, const SedReport_t *report,
+                      const char *filename, SedReportFormat_t format)
+{
+  if (srw == NULL || filename == NULL) return LIBSEDML_INVALID_OBJECT;
+  return srw->open(report, filename, format);
+}
+
+
+/**
+ * Reopens the file filename written for report, keeping numRows rows.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_resume (SedReportWriter_t *srw, const SedReport_t *report,
+                        const char *filename, size_t numRows,
+                        SedReportFormat_t format)
+{
+  if (srw == NULL || filename == NULL) return LIBSEDML_INVALID_OBJECT;
+  return srw->resume(report, filename, numRows, format);
+}
+
+
+/**
+ * Appends all rows of the columns of results.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_writeChunk (SedReportWriter_t *srw,
+                            const SedResults_t *results)
+{
+  if (srw == NULL || results == NULL) return LIBSEDML_INVALID_OBJECT;
+  return srw->writeChunk(*results);
+}
+
+
+/**
+ * Returns the number of rows written.
+ */
+LIBSEDML_EXTERN
+size_t
+SedReportWriter_getNumRows (const SedReportWriter_t *srw)
+{
+  return (srw != NULL) ? srw->getNumRows() : 0;
+}
+
+
+/**
+ * Writes what is still buffered, so that all rows written are in the file.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_flush (SedReportWriter_t *srw)
+{
+  return (srw != NULL) ? srw->flush() : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Writes what is still buffered and closes the output.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_close (SedReportWriter_t *srw)
+{
+  return (srw != NULL) ? srw->close() : LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if libSEDML was built with support for format.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_isFormatAvailable (SedReportFormat_t format)
+{
+  return SedReportWriter::isFormatAvailable(format) ? 1 : 0;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
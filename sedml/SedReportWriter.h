@@ -0,0 +1,383 @@
+/**
+ * @file    SedReportWriter.h
+ * @brief   Writes the values of a SedReport to CSV or HDF5 a chunk at a time
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedReportWriter
+ * @ingroup Core
+ * @brief Streams the values of a SedReport to a file.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedReportWriter writes one column per SedDataSet of a SedReport, in
+ * the order of its SedListOfDataSets, taking the values from the
+ * SedResults column the data reference of each data set names.  Rather
+ * than needing all values at once, it appends the rows of one chunk at a
+ * time: an executor fills a SedResults with the next block of samples,
+ * calls writeChunk(), and reuses the SedResults for the block after.  The
+ * memory used is therefore bounded by the size of a chunk, however many
+ * points the simulation has.
+ *
+ * Three formats are supported:
+ *
+ * @li @c SED_REPORT_FORMAT_CSV writes a header line with the label of
+ * every data set (or its id, if it has no label) followed by one line of
+ * comma-separated values per row.  Missing values are left empty.
+ * @li @c SED_REPORT_FORMAT_HDF5 writes a two-dimensional, chunked dataset
+ * named after the id of the report, which grows by the rows of every
+ * chunk; the labels and data references are stored as its attributes
+ * @c labels and @c dataReferences.  Missing values are NaN.  HDF5 output
+ * is only available when libSEDML was built with the HDF5 library (see
+ * isFormatAvailable()).
+ * @li @c SED_REPORT_FORMAT_ARROW writes an Apache Arrow IPC stream: a
+ * schema with one float64 field per data set, named by its label, and
+ * one record batch per chunk.  The values of a batch are written straight
+ * from the columns of the SedResults, without being copied; missing
+ * values are NaN.  The id of the report, the metaid of its document, if
+ * it has one, and the ids of the tasks its data generators refer to are
+ * stored as the metadata @c sedml:report, @c sedml:document and
+ * @c sedml:tasks of the schema, and the id and data reference of every
+ * data set as the metadata @c sedml:dataSet and @c sedml:dataReference
+ * of its field.  The stream can be memory-mapped and read by any Arrow
+ * implementation, for instance with @c pyarrow.ipc.open_stream.
+ *
+ * A long run can keep its reports across a restart: after flush(), every
+ * row written so far is in the file, so the number of rows can be
+ * recorded, for instance with SedCheckpoint::setNumRows().  resume()
+ * later reopens the file with that many rows, dropping any written after
+ * them, and the rows that follow are appended.  Arrow streams cannot be
+ * resumed, as their record batches need not end at the rows recorded.
+ */
+
+#ifndef SedReportWriter_h
+#define SedReportWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+/**
+ * The file formats of a SedReportWriter.
+ */
+typedef enum
+{
+    SED_REPORT_FORMAT_CSV   = 0 /*!< Comma-separated values */
+  , SED_REPORT_FORMAT_HDF5  = 1 /*!< An HDF5 file */
+  , SED_REPORT_FORMAT_ARROW = 2 /*!< An Apache Arrow IPC stream */
+} SedReportFormat_t;
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedReport;
+class SedResults;
+class SedOutputSink;
+class SedFileSink;
+
+
+class LIBSEDML_EXTERN SedReportWriter
+{
+public:
+
+  /**
+   * Creates a new SedReportWriter that is not open.
+   */
+  SedReportWriter ();
+
+
+  /**
+   * Destroys this SedReportWriter, closing it first if it is open.
+   */
+  virtual ~SedReportWriter ();
+
+
+  /**
+   * Starts writing @p report to the file @p filename, which is created or
+   * truncated.  For CSV, the header line is written at once, and for
+   * Arrow the schema.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p report is @c NULL or has no data sets
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if this writer is already open, the format is not available, or the
+   * file cannot be created
+   */
+  int open (const SedReport* report, const std::string& filename,
+            SedReportFormat_t format = SED_REPORT_FORMAT_CSV);
+
+
+  /**
+   * Starts writing @p report as CSV or Arrow to @p sink, which this writer
+   * does not own; close() finishes the sink.
+   *
+   * @copydetails open(const SedReport*, const std::string&, SedReportFormat_t)
+   */
+  int open (const SedReport* report, SedOutputSink& sink,
+            SedReportFormat_t format = SED_REPORT_FORMAT_CSV);
+
+
+  /**
+   * Reopens the file @p filename written for @p report by open() in
+   * @p format, keeping its first @p numRows rows and dropping any after
+   * them, so that the rows written next follow those.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p report is @c NULL or has no data sets
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if this writer is already open, the format is not available, or the
+   * file cannot be opened, was not written for the data sets of
+   * @p report or has fewer than @p numRows rows, or @p format is
+   * @c SED_REPORT_FORMAT_ARROW
+   */
+  int resume (const SedReport* report, const std::string& filename,
+              size_t numRows, SedReportFormat_t format = SED_REPORT_FORMAT_CSV);
+
+
+  /**
+   * @return @c true if open() succeeded and close() has not been called
+   * since.
+   */
+  bool isOpen () const;
+
+
+  /**
+   * Appends the rows @p offset to @p offset + @p length - 1 of the
+   * columns of @p results.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if this writer is not open or the output cannot be written
+   */
+  int writeChunk (const SedResults& results, size_t offset, size_t length);
+
+
+  /**
+   * Appends all rows of the columns of @p results, that is, as many as
+   * the longest column of a data set of the report has.
+   *
+   * @copydetails writeChunk(const SedResults&, size_t, size_t)
+   */
+  int writeChunk (const SedResults& results);
+
+
+  /**
+   * @return the number of rows written since open().
+   */
+  size_t getNumRows () const;
+
+
+  /**
+   * Writes what is still buffered, so that all rows written since open()
+   * are in the file; for a sink passed to open(), the rows are passed on
+   * to it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if this writer is not open or the output cannot be written
+   */
+  int flush ();
+
+
+  /**
+   * Writes what is still buffered and closes the output.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if this writer is not open or the output cannot be written
+   */
+  int close ();
+
+
+  /**
+   * @return @c true if libSEDML was built with support for @p format.
+   */
+  static bool isFormatAvailable (SedReportFormat_t format);
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedReportWriter (const SedReportWriter& orig);
+  SedReportWriter& operator= (const SedReportWriter& rhs);
+
+  bool setReport (const SedReport* report);
+
+  bool writeHeader ();
+
+  bool flushBuffer (bool force);
+
+  std::string getHeader () const;
+
+  bool resumeCsv (const std::string& filename, size_t numRows);
+
+  bool openHdf5 (const std::string& filename, const std::string& name);
+
+  bool resumeHdf5 (const std::string& filename, const std::string& name,
+                   size_t numRows);
+
+  bool flushHdf5 ();
+
+  bool writeHdf5 (const SedResults& results, size_t offset, size_t length);
+
+  bool closeHdf5 ();
+
+  bool writeArrowSchema (const SedReport* report);
+
+  bool writeArrow (const SedResults& results, size_t offset, size_t length);
+
+
+  SedReportFormat_t        mFormat;
+  bool                     mOpen;
+  bool                     mFailed;
+  size_t                   mNumRows;
+
+  std::vector<std::string> mReferences;
+  std::vector<std::string> mLabels;
+
+  SedOutputSink*           mSink;
+  SedFileSink*             mOwnedSink;
+  std::string              mBuffer;
+
+  void*                    mHdf5;
+  std::vector<double>      mRows;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedReportWriter and returns it.
+ */
+LIBSEDML_EXTERN
+SedReportWriter_t *
+SedReportWriter_create ();
+
+
+/**
+ * Frees the given SedReportWriter, closing it first if it is open.
+ */
+LIBSEDML_EXTERN
+void
+SedReportWriter_free (SedReportWriter_t *srw);
+
+
+/**
+ * Starts writing @p report to the file @p filename in @p format.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_open (SedReportWriter_t *srw, const SedReport_t *report,
+                      const char *filename, SedReportFormat_t format);
+
+
+/**
+ * Reopens the file @p filename written for @p report in @p format,
+ * keeping its first @p numRows rows.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_resume (SedReportWriter_t *srw, const SedReport_t *report,
+                        const char *filename, size_t numRows,
+                        SedReportFormat_t format);
+
+
+/**
+ * Appends all rows of the columns of @p results.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_writeChunk (SedReportWriter_t *srw,
+                            const SedResults_t *results);
+
+
+/**
+ * Returns the number of rows written since the given SedReportWriter was
+ * opened.
+ */
+LIBSEDML_EXTERN
+size_t
+SedReportWriter_getNumRows (const SedReportWriter_t *srw);
+
+
+/**
+ * Writes what is still buffered, so that all rows written are in the file.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_flush (SedReportWriter_t *srw);
+
+
+/**
+ * Writes what is still buffered and closes the output.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_close (SedReportWriter_t *srw);
+
+
+/**
+ * Returns non-zero if libSEDML was built with support for @p format.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_isFormatAvailable (SedReportFormat_t format);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedReportWriter_h */
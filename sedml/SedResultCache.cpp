@@ -0,0 +1,584 @@
+/**
+ * @file    SedResultCache.cpp
+ * @brief   Stores of task results keyed by a fingerprint of the task
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedResultCache.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedModelCache.h>
+#include <sedml/SedSweep.h>
+#include <sedml/SedTypeCodes.h>
+#include <sedml/common/threads.h>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The first bytes of a results file, and a word telling its byte order.
+ */
+static const char         RESULTS_MAGIC[8] = { 'S', 'E', 'D', 'R',
+                                               'E', 'S', '1', '\n' };
+static const unsigned int RESULTS_ORDER    = 0x01020304u;
+
+
+/*
+ * Appends a field to a fingerprint, as SedModelCache does to its keys.
+ */
+static void
+appendField (std::string& key, const std::string& field)
+{
+  key += field;
+  key += '\x1f';
+}
+
+
+/*
+ * Appends a number to a fingerprint, exactly.
+ */
+static void
+appendNumber (std::string& key, double value)
+{
+  char number[32];
+  sprintf(number, "%.17g", value);
+  appendField(key, number);
+}
+
+
+static bool
+writeBytes (FILE* file, const void* data, size_t length)
+{
+  return length == 0 || fwrite(data, 1, length, file) == length;
+}
+
+
+static bool
+readBytes (FILE* file, void* data, size_t length)
+{
+  return length == 0 || fread(data, 1, length, file) == length;
+}
+
+
+/*
+ * Sizes are stored in eight little-endian bytes whatever the size of
+ * size_t; a stored size too large for it does not read.
+ */
+static bool
+writeSize (FILE* file, size_t value)
+{
+  unsigned char bytes[8];
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    bytes[i] = (unsigned char)(value & 0xff);
+    value >>= 8;
+  }
+  return writeBytes(file, bytes, 8);
+}
+
+
+static bool
+readSize (FILE* file, size_t& value)
+{
+  unsigned char bytes[8];
+  if (!readBytes(file, bytes, 8)) return false;
+
+  size_t result = 0;
+  for (unsigned int i = 8; i-- > 0; )
+  {
+    if (result > ((size_t)-1 >> 8)) return false;
+    result = (result << 8) | bytes[i];
+  }
+
+  value = result;
+  return true;
+}
+
+
+static bool
+writeString (FILE* file, const std::string& value)
+{
+  return writeSize(file, value.size())
+      && writeBytes(file, value.data(), value.size());
+}
+
+
+/*
+ * Reads a string of at most limit bytes, so that a damaged file does not
+ * make it allocate a huge one.
+ */
+static bool
+readString (FILE* file, std::string& value, size_t limit)
+{
+  size_t length = 0;
+  if (!readSize(file, length) || length > limit) return false;
+
+  value.resize(length);
+  return length == 0 || readBytes(file, &value[0], length);
+}
+
+
+static unsigned long
+getProcessId ()
+{
+#ifdef _WIN32
+  return (unsigned long)GetCurrentProcessId();
+#else
+  return (unsigned long)getpid();
+#endif
+}
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedResultCache.
+ */
+SedResultCache::~SedResultCache ()
+{
+}
+
+
+/*
+ * Returns the fingerprint of task of document.
+ */
+std::string
+SedResultCache::getFingerprint (const SedDocument* document,
+                                const SedTask* task,
+                                const std::vector<const SedVariable*>&
+                                  variables,
+                                const SedSweepPoint* point)
+{
+  if (document == NULL || task == NULL) return "";
+
+  const SedModel* model = document->getModel(task->getModelReference());
+  const SedSimulation* simulation =
+    document->getSimulation(task->getSimulationReference());
+  if (model == NULL || simulation == NULL) return "";
+
+  std::string key = SedModelCache::getKey(document, model);
+  if (key.empty()) return "";
+
+  appendField(key, "simulation");
+  appendNumber(key, simulation->getTypeCode());
+
+  const SedAlgorithm* algorithm = simulation->getAlgorithm();
+  appendField(key, (algorithm != NULL) ? algorithm->getKisaoID() : "");
+
+  if (simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+  {
+    const SedUniformTimeCourse* utc =
+      static_cast<const SedUniformTimeCourse*>(simulation);
+    appendNumber(key, utc->getInitialTime());
+    appendNumber(key, utc->getOutputStartTime());
+    appendNumber(key, utc->getOutputEndTime());
+    appendNumber(key, utc->getNumberOfPoints());
+  }
+
+  // the variables are sorted, so that reordering the data generators of a
+  // document does not change its fingerprints
+  std::vector<std::string> descriptions;
+  for (unsigned int i = 0; i < variables.size(); ++i)
+  {
+    std::string description;
+    appendField(description, variables[i]->getId());
+    appendField(description, variables[i]->getTarget());
+    appendField(description, variables[i]->getSymbol());
+    descriptions.push_back(description);
+  }
+  sort(descriptions.begin(), descriptions.end());
+
+  appendField(key, "variables");
+  for (unsigned int i = 0; i < descriptions.size(); ++i)
+  {
+    key += descriptions[i];
+  }
+
+  if (point != NULL)
+  {
+    appendField(key, "point");
+    for (unsigned int i = 0; i < point->getNumChanges(); ++i)
+    {
+      appendField(key, point->getTarget(i));
+      appendNumber(key, point->getValue(i));
+    }
+  }
+
+  return key;
+}
+
+
+/*
+ * Creates a new, empty SedMemoryResultCache.
+ */
+SedMemoryResultCache::SedMemoryResultCache ()
+  : mLock (NULL)
+{
+  SedMutex* mutex = new SedMutex;
+  mutexInit(mutex);
+  mLock = mutex;
+}
+
+
+/*
+ * Destroys this SedMemoryResultCache.
+ */
+SedMemoryResultCache::~SedMemoryResultCache ()
+{
+  clear();
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexFree(mutex);
+  delete mutex;
+}
+
+
+/*
+ * Copies the results stored for fingerprint into results.
+ */
+bool
+SedMemoryResultCache::load (const std::string& fingerprint,
+                            SedResults& results)
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  std::map<std::string, SedResults*>::const_iterator it =
+    mEntries.find(fingerprint);
+  const bool found = (it != mEntries.end());
+  if (found) results = *it->second;
+
+  mutexUnlock(mutex);
+
+  return found;
+}
+
+
+/*
+ * Stores a copy of results.
+ */
+bool
+SedMemoryResultCache::store (const std::string& fingerprint,
+                             const SedResults& results)
+{
+  // the copy is made outside of the lock
+  SedResults* copy = new (nothrow) SedResults(results);
+  if (copy == NULL) return false;
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  SedResults*& entry = mEntries[fingerprint];
+  SedResults* previous = entry;
+  entry = copy;
+
+  mutexUnlock(mutex);
+
+  delete previous;
+  return true;
+}
+
+
+/*
+ * Removes all stored results.
+ */
+void
+SedMemoryResultCache::clear ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  std::map<std::string, SedResults*> entries;
+  entries.swap(mEntries);
+
+  mutexUnlock(mutex);
+
+  std::map<std::string, SedResults*>::iterator it;
+  for (it = entries.begin(); it != entries.end(); ++it)
+  {
+    delete it->second;
+  }
+}
+
+
+/*
+ * Returns the number of results held.
+ */
+unsigned int
+SedMemoryResultCache::getNumEntries () const
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+  const unsigned int numEntries = (unsigned int)mEntries.size();
+  mutexUnlock(mutex);
+
+  return numEntries;
+}
+
+
+/*
+ * Creates a new SedDirectoryResultCache keeping its files in directory.
+ */
+SedDirectoryResultCache::SedDirectoryResultCache (const std::string& directory)
+  : mDirectory (directory)
+  , mNumTemporaries (0)
+  , mLock (NULL)
+{
+  SedMutex* mutex = new SedMutex;
+  mutexInit(mutex);
+  mLock = mutex;
+}
+
+
+/*
+ * Destroys this SedDirectoryResultCache.
+ */
+SedDirectoryResultCache::~SedDirectoryResultCache ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexFree(mutex);
+  delete mutex;
+}
+
+
+/*
+ * Returns the directory of this cache.
+ */
+const std::string&
+SedDirectoryResultCache::getDirectory () const
+{
+  return mDirectory;
+}
+
+
+/*
+ * Reads the results stored for fingerprint from their file.
+ */
+bool
+SedDirectoryResultCache::load (const std::string& fingerprint,
+                               SedResults& results)
+{
+  FILE* file = fopen(getFilename(fingerprint).c_str(), "rb");
+  if (file == NULL) return false;
+
+  char magic[sizeof(RESULTS_MAGIC)];
+  unsigned int order = 0;
+  std::string stored;
+  size_t numColumns = 0;
+
+  // another fingerprint with the same hash, or a file of another byte
+  // order, is a miss
+  bool ok = readBytes(file, magic, sizeof(magic))
+         && equal(magic, magic + sizeof(magic), RESULTS_MAGIC)
+         && readBytes(file, &order, sizeof(order))
+         && order == RESULTS_ORDER
+         && readString(file, stored, fingerprint.size())
+         && stored == fingerprint
+         && readSize(file, numColumns);
+
+  results.clear();
+
+  for (size_t i = 0; ok && i < numColumns; ++i)
+  {
+    std::string id;
+    size_t length = 0;
+    ok = readString(file, id, 1 << 16) && readSize(file, length)
+      && length <= (size_t)-1 / sizeof(double);
+    if (!ok) break;
+
+    double* values = results.addColumn(id, length);
+    ok = (values != NULL || length == 0)
+      && readBytes(file, values, length * sizeof(double));
+  }
+
+  fclose(file);
+  return ok;
+}
+
+
+/*
+ * Writes results to the file of fingerprint.
+ */
+bool
+SedDirectoryResultCache::store (const std::string& fingerprint,
+                                const SedResults& results)
+{
+  const std::string filename = getFilename(fingerprint);
+
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+  const unsigned int number = mNumTemporaries++;
+  mutexUnlock(mutex);
+
+  // the temporary name is unique to this cache object, thread and process
+  char suffix[64];
+  sprintf(suffix, ".%lu.%lx.%u.tmp", getProcessId(),
+          (unsigned long)(size_t)this, number);
+  const std::string temporary = filename + suffix;
+
+  FILE* file = fopen(temporary.c_str(), "wb");
+  if (file == NULL) return false;
+
+  const unsigned int numColumns = results.getNumColumns();
+  bool ok = writeBytes(file, RESULTS_MAGIC, sizeof(RESULTS_MAGIC))
+         && writeBytes(file, &RESULTS_ORDER, sizeof(RESULTS_ORDER))
+         && writeString(file, fingerprint)
+         && writeSize(file, numColumns);
+
+  for (unsigned int i = 0; ok && i < numColumns; ++i)
+  {
+    const std::string& id = results.getColumnId(i);
+    const size_t length = results.getColumnLength(id);
+
+    ok = writeString(file, id) && writeSize(file, length)
+      && writeBytes(file, results.getColumn(id), length * sizeof(double));
+  }
+
+  ok = (fclose(file) == 0) && ok;
+
+#ifdef _WIN32
+  // rename does not replace existing files on Windows
+  if (ok) remove(filename.c_str());
+#endif
+
+  ok = ok && rename(temporary.c_str(), filename.c_str()) == 0;
+  if (!ok)
+  {
+    remove(temporary.c_str());
+    return false;
+  }
+
+  mutexLock(mutex);
+  if (find(mStored.begin(), mStored.end(), filename) == mStored.end())
+  {
+    mStored.push_back(filename);
+  }
+  mutexUnlock(mutex);
+
+  return true;
+}
+
+
+/*
+ * Removes the files of the fingerprints stored through this object.
+ */
+void
+SedDirectoryResultCache::clear ()
+{
+  SedMutex* mutex = static_cast<SedMutex*>(mLock);
+  mutexLock(mutex);
+
+  std::vector<std::string> stored;
+  stored.swap(mStored);
+
+  mutexUnlock(mutex);
+
+  for (unsigned int i = 0; i < stored.size(); ++i)
+  {
+    remove(stored[i].c_str());
+  }
+}
+
+
+/*
+ * Returns the name of the file the results of fingerprint are stored in.
+ */
+std::string
+SedDirectoryResultCache::getFilename (const std::string& fingerprint) const
+{
+  char name[32];
+  sprintf(name, "%016lx.sedres",
+          (unsigned long)SedModelCache::getHash(fingerprint));
+
+  std::string filename = mDirectory;
+  if (!filename.empty() && filename[filename.size() - 1] != '/'
+      && filename[filename.size() - 1] != '\\')
+  {
+    filename += '/';
+  }
+
+  return filename + name;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedResultCache_t *
+SedResultCache_createMemory ()
+{
+  return new (nothrow) SedMemoryResultCache();
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedResultCache_t *
+SedResultCache_createDirectory (const char *directory)
+{
+  if (directory == NULL) return NULL;
+
+  return new (nothrow) SedDirectoryResultCache(directory);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedResultCache_free (SedResultCache_t *src)
+{
+  delete src;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedResultCache_clear (SedResultCache_t *src)
+{
+  if (src != NULL) src->clear();
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
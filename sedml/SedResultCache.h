@@ -0,0 +1,311 @@
+/**
+ * @file    SedResultCache.h
+ * @brief   Stores of task results keyed by a fingerprint of the task
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedResultCache
+ * @ingroup Core
+ * @brief Remembers the results of simulations between runs.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedExecutor given a SedResultCache (see SedExecutor::setResultCache())
+ * looks up every task, and every point of a sweep, before simulating it,
+ * and stores the results of those it had to simulate.  The key is the
+ * fingerprint of the task, getFingerprint(): a canonical description of
+ * everything the results depend on,
+ *
+ * @li the model, as SedModelCache::getKey() describes it: its language
+ * and source, or the model its source names, and its changes;
+ * @li the simulation: its type, the KiSAO id of its algorithm and, for a
+ * SedUniformTimeCourse, its four attributes;
+ * @li the variables asked for, by id, target and symbol;
+ * @li the values of a sweep point, if any.
+ *
+ * Ids of tasks, models and simulations, and everything about data
+ * generators and outputs, are not part of it, so a document re-run with
+ * new or changed outputs finds all of its simulations in the cache.  The
+ * source of a model is described by its name only: the cache must be
+ * cleared when the model files change.
+ *
+ * Two caches are provided: SedMemoryResultCache keeps the results in
+ * memory for the lifetime of the process, and SedDirectoryResultCache
+ * keeps one file per fingerprint in a directory, so that results survive
+ * the process and are shared by processes using the same directory.
+ * load() and store() are called by the worker threads of an executor, so
+ * caches must be thread-safe.
+ */
+
+#ifndef SedResultCache_h
+#define SedResultCache_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedTask;
+class SedVariable;
+class SedSweepPoint;
+class SedResults;
+
+
+class LIBSEDML_EXTERN SedResultCache
+{
+public:
+
+  /**
+   * Destroys this SedResultCache.
+   */
+  virtual ~SedResultCache ();
+
+
+  /**
+   * Replaces @p results with the results stored for @p fingerprint.
+   *
+   * @return @c true if there were any, @c false otherwise, in which case
+   * @p results is unspecified.
+   */
+  virtual bool load (const std::string& fingerprint, SedResults& results) = 0;
+
+
+  /**
+   * Stores @p results for @p fingerprint, replacing any stored before.
+   *
+   * @return @c true on success, @c false otherwise; a cache that cannot
+   * store results only loses their reuse.
+   */
+  virtual bool store (const std::string& fingerprint,
+                      const SedResults& results) = 0;
+
+
+  /**
+   * Removes all stored results.
+   */
+  virtual void clear () = 0;
+
+
+  /**
+   * Returns the fingerprint of @p task of @p document, asked for
+   * @p variables and, if @p point is not @c NULL, at that point of a
+   * sweep over the task.
+   *
+   * @return the fingerprint, or an empty string if the model or the
+   * simulation of the task does not exist or the sources of the models
+   * form a cycle.
+   */
+  static std::string getFingerprint (const SedDocument* document,
+                                     const SedTask* task,
+                                     const std::vector<const SedVariable*>&
+                                       variables,
+                                     const SedSweepPoint* point = NULL);
+};
+
+
+class LIBSEDML_EXTERN SedMemoryResultCache : public SedResultCache
+{
+public:
+
+  /**
+   * Creates a new, empty SedMemoryResultCache.
+   */
+  SedMemoryResultCache ();
+
+
+  /**
+   * Destroys this SedMemoryResultCache and the results it holds.
+   */
+  virtual ~SedMemoryResultCache ();
+
+
+  /**
+   * Copies the results stored for @p fingerprint into @p results.
+   */
+  virtual bool load (const std::string& fingerprint, SedResults& results);
+
+
+  /**
+   * Stores a copy of @p results.
+   */
+  virtual bool store (const std::string& fingerprint,
+                      const SedResults& results);
+
+
+  /**
+   * Removes all stored results.
+   */
+  virtual void clear ();
+
+
+  /**
+   * @return the number of results held.
+   */
+  unsigned int getNumEntries () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  std::map<std::string, SedResults*>  mEntries;
+  void*                               mLock;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedMemoryResultCache (const SedMemoryResultCache& orig);
+  SedMemoryResultCache& operator= (const SedMemoryResultCache& rhs);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedDirectoryResultCache : public SedResultCache
+{
+public:
+
+  /**
+   * Creates a new SedDirectoryResultCache keeping its files in the
+   * existing directory @p directory.
+   */
+  SedDirectoryResultCache (const std::string& directory);
+
+
+  /**
+   * Destroys this SedDirectoryResultCache; its files are kept.
+   */
+  virtual ~SedDirectoryResultCache ();
+
+
+  /**
+   * @return the directory of this cache.
+   */
+  const std::string& getDirectory () const;
+
+
+  /**
+   * Reads the results stored for @p fingerprint from their file.
+   */
+  virtual bool load (const std::string& fingerprint, SedResults& results);
+
+
+  /**
+   * Writes @p results to the file of @p fingerprint.  The file is written
+   * under a temporary name and then renamed, so that other threads and
+   * processes never see it half written.
+   */
+  virtual bool store (const std::string& fingerprint,
+                      const SedResults& results);
+
+
+  /**
+   * Removes the files of the fingerprints stored through this object.
+   */
+  virtual void clear ();
+
+
+  /**
+   * @return the name of the file the results of @p fingerprint are
+   * stored in.
+   */
+  std::string getFilename (const std::string& fingerprint) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  std::string               mDirectory;
+  std::vector<std::string>  mStored;
+  unsigned int              mNumTemporaries;
+  void*                     mLock;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedDirectoryResultCache (const SedDirectoryResultCache& orig);
+  SedDirectoryResultCache& operator= (const SedDirectoryResultCache& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedMemoryResultCache and returns it.
+ */
+LIBSEDML_EXTERN
+SedResultCache_t *
+SedResultCache_createMemory ();
+
+
+/**
+ * Creates a new SedDirectoryResultCache keeping its files in
+ * @p directory and returns it.
+ */
+LIBSEDML_EXTERN
+SedResultCache_t *
+SedResultCache_createDirectory (const char *directory);
+
+
+/**
+ * Frees the given SedResultCache.
+ */
+LIBSEDML_EXTERN
+void
+SedResultCache_free (SedResultCache_t *src);
+
+
+/**
+ * Removes all results stored by the given SedResultCache.
+ */
+LIBSEDML_EXTERN
+void
+SedResultCache_clear (SedResultCache_t *src);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedResultCache_h */
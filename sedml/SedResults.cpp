@@ -0,0 +1,918 @@
+/**
+ * @file    SedResults.cpp
+ * @brief   Columnar store for the values of the data generators
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedResults.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <sys/mman.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns a view of the given column, or an empty one.
+ */
+static SedColumnView
+makeView (const double* data, size_t length)
+{
+  SedColumnView view;
+  view.data   = data;
+  view.length = (data != NULL) ? length : 0;
+  return view;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedResults.
+ */
+SedResults::SedResults ()
+  : mMemoryBudget (0)
+  , mMemoryBytes (0)
+  , mSpilledBytes (0)
+{
+}
+
+
+/*
+ * Copy constructor.
+ */
+SedResults::SedResults (const SedResults& orig)
+  : mMemoryBudget (orig.mMemoryBudget)
+  , mMemoryBytes (0)
+  , mSpilledBytes (0)
+  , mSpillDirectory (orig.mSpillDirectory)
+{
+  copyColumns(orig);
+}
+
+
+/*
+ * Assignment operator.
+ */
+SedResults&
+SedResults::operator= (const SedResults& rhs)
+{
+  if (&rhs != this)
+  {
+    clear();
+    copyColumns(rhs);
+  }
+
+  return *this;
+}
+
+
+/*
+ * Destroys this SedResults.
+ */
+SedResults::~SedResults ()
+{
+  clear();
+}
+
+
+/*
+ * Creates the column id with room for length values.
+ */
+double*
+SedResults::addColumn (const std::string& id, size_t length)
+{
+  if (id.empty()) return NULL;
+
+  Column* column = findColumn(id);
+
+  if (column == NULL)
+  {
+    Column added;
+    added.id       = id;
+    added.block    = NULL;
+    added.data     = NULL;
+    added.length   = 0;
+    added.capacity = 0;
+    added.mapped   = 0;
+
+    if (!allocate(added, length)) return NULL;
+
+    mIndex[id] = (unsigned int)mColumns.size();
+    mColumns.push_back(added);
+    column = &mColumns.back();
+  }
+  else if (!allocate(*column, length))
+  {
+    return NULL;
+  }
+
+  if (length > 0) memset(column->data, 0, length * sizeof(double));
+  return column->data;
+}
+
+
+/*
+ * Creates the column for dg with room for length values.
+ */
+double*
+SedResults::addColumn (const SedDataGenerator* dg, size_t length)
+{
+  if (dg == NULL) return NULL;
+  return addColumn(dg->getId(), length);
+}
+
+
+/*
+ * Makes the column id hold length values, keeping those it has.
+ */
+double*
+SedResults::resizeColumn (const std::string& id, size_t length)
+{
+  Column* column = findColumn(id);
+  if (column == NULL) return addColumn(id, length);
+
+  const size_t kept = (column->length < length) ? column->length : length;
+
+  if (column->block != NULL && length <= column->capacity)
+  {
+    column->length = length;
+  }
+  else
+  {
+    // allocate() frees the buffer it replaces, so the values are moved
+    // by hand; an alias has no buffer to free
+    Column resized = *column;
+    resized.block    = NULL;
+    resized.capacity = 0;
+    resized.mapped   = 0;
+    if (!allocate(resized, length)) return NULL;
+
+    if (kept > 0) memcpy(resized.data, column->data, kept * sizeof(double));
+    release(*column);
+    *column = resized;
+  }
+
+  if (length > kept)
+  {
+    memset(column->data + kept, 0, (length - kept) * sizeof(double));
+  }
+  return column->data;
+}
+
+
+/*
+ * Sets the column id to a copy of values.
+ */
+int
+SedResults::setColumn (const std::string& id, const double* values,
+                       size_t length)
+{
+  if (id.empty() || (values == NULL && length > 0))
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  double* data = addColumn(id, length);
+  if (data == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  if (length > 0) memcpy(data, values, length * sizeof(double));
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the column id to values, without copying them.
+ */
+int
+SedResults::setColumnAlias (const std::string& id, const double* values,
+                            size_t length)
+{
+  if (id.empty() || (values == NULL && length > 0))
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  Column* column = findColumn(id);
+
+  if (column == NULL)
+  {
+    Column added;
+    added.id = id;
+    mIndex[id] = (unsigned int)mColumns.size();
+    mColumns.push_back(added);
+    column = &mColumns.back();
+  }
+  else
+  {
+    release(*column);
+  }
+
+  // an alias is a column without a block of its own
+  column->block    = NULL;
+  column->data     = const_cast<double*>(values);
+  column->length   = length;
+  column->capacity = 0;
+  column->mapped   = 0;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if the column id is an alias.
+ */
+bool
+SedResults::isColumnAlias (const std::string& id) const
+{
+  const Column* column = findColumn(id);
+  return (column != NULL && column->block == NULL && column->data != NULL);
+}
+
+
+/*
+ * Returns the values of the column id, which callers may change, so that
+ * an alias is copied first.
+ */
+double*
+SedResults::getColumn (const std::string& id)
+{
+  Column* column = findColumn(id);
+  if (column == NULL) return NULL;
+
+  if (column->block == NULL && column->data != NULL)
+  {
+    const double* values = column->data;
+    const size_t  length = column->length;
+    if (!allocate(*column, length)) return NULL;
+    memcpy(column->data, values, length * sizeof(double));
+  }
+
+  return column->data;
+}
+
+
+/*
+ * Returns the values of the column id.
+ */
+const double*
+SedResults::getColumn (const std::string& id) const
+{
+  const Column* column = findColumn(id);
+  return (column != NULL) ? column->data : NULL;
+}
+
+
+/*
+ * Returns the number of values of the column id.
+ */
+size_t
+SedResults::getColumnLength (const std::string& id) const
+{
+  const Column* column = findColumn(id);
+  return (column != NULL) ? column->length : 0;
+}
+
+
+/*
+ * Returns true if there is a column id.
+ */
+bool
+SedResults::hasColumn (const std::string& id) const
+{
+  return (findColumn(id) != NULL);
+}
+
+
+/*
+ * Returns the number of columns.
+ */
+unsigned int
+SedResults::getNumColumns () const
+{
+  return (unsigned int)mColumns.size();
+}
+
+
+/*
+ * Returns the id of the n-th column.
+ */
+const std::string&
+SedResults::getColumnId (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mColumns.size()) ? mColumns[n].id : empty;
+}
+
+
+/*
+ * Removes the column id.
+ */
+int
+SedResults::removeColumn (const std::string& id)
+{
+  std::map<std::string, unsigned int>::iterator it = mIndex.find(id);
+  if (it == mIndex.end()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  const unsigned int n = it->second;
+  release(mColumns[n]);
+  mColumns.erase(mColumns.begin() + n);
+  mIndex.erase(it);
+
+  for (unsigned int i = n; i < mColumns.size(); ++i)
+  {
+    mIndex[mColumns[i].id] = i;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Removes all columns.
+ */
+void
+SedResults::clear ()
+{
+  for (unsigned int i = 0; i < mColumns.size(); ++i)
+  {
+    release(mColumns[i]);
+  }
+
+  mColumns.clear();
+  mIndex.clear();
+}
+
+
+/*
+ * Sets the number of bytes the columns may take in memory.
+ */
+void
+SedResults::setMemoryBudget (size_t bytes)
+{
+  mMemoryBudget = bytes;
+}
+
+
+/*
+ * Returns the number of bytes the columns may take in memory.
+ */
+size_t
+SedResults::getMemoryBudget () const
+{
+  return mMemoryBudget;
+}
+
+
+/*
+ * Sets the directory the temporary files of spilled columns are created
+ * in.
+ */
+void
+SedResults::setSpillDirectory (const std::string& directory)
+{
+  mSpillDirectory = directory;
+}
+
+
+/*
+ * Returns the directory the temporary files of spilled columns are
+ * created in.
+ */
+const std::string&
+SedResults::getSpillDirectory () const
+{
+  return mSpillDirectory;
+}
+
+
+/*
+ * Returns true if the column id is backed by a temporary file.
+ */
+bool
+SedResults::isColumnSpilled (const std::string& id) const
+{
+  const Column* column = findColumn(id);
+  return (column != NULL && column->mapped > 0);
+}
+
+
+/*
+ * Returns the number of bytes the columns allocated in memory take.
+ */
+size_t
+SedResults::getMemoryBytes () const
+{
+  return mMemoryBytes;
+}
+
+
+/*
+ * Returns the number of bytes of the temporary files of spilled columns.
+ */
+size_t
+SedResults::getSpilledBytes () const
+{
+  return mSpilledBytes;
+}
+
+
+/*
+ * Returns a view of the column id.
+ */
+SedColumnView
+SedResults::getView (const std::string& id) const
+{
+  const Column* column = findColumn(id);
+  if (column == NULL) return makeView(NULL, 0);
+  return makeView(column->data, column->length);
+}
+
+
+/*
+ * Returns a view of the column the data reference of ds names.
+ */
+SedColumnView
+SedResults::getView (const SedDataSet* ds) const
+{
+  if (ds == NULL) return makeView(NULL, 0);
+  return getView(ds->getDataReference());
+}
+
+
+/*
+ * Returns a view of the column the x data reference of curve names.
+ */
+SedColumnView
+SedResults::getXView (const SedCurve* curve) const
+{
+  if (curve == NULL) return makeView(NULL, 0);
+  return getView(curve->getXDataReference());
+}
+
+
+/*
+ * Returns a view of the column the y data reference of curve names.
+ */
+SedColumnView
+SedResults::getYView (const SedCurve* curve) const
+{
+  if (curve == NULL) return makeView(NULL, 0);
+  return getView(curve->getYDataReference());
+}
+
+
+/*
+ * Returns a view of the column the z data reference of surface names.
+ */
+SedColumnView
+SedResults::getZView (const SedSurface* surface) const
+{
+  if (surface == NULL) return makeView(NULL, 0);
+  return getView(surface->getZDataReference());
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Returns the column id, or NULL.
+ */
+SedResults::Column*
+SedResults::findColumn (const std::string& id)
+{
+  std::map<std::string, unsigned int>::const_iterator it = mIndex.find(id);
+  return (it != mIndex.end()) ? &mColumns[it->second] : NULL;
+}
+
+
+/*
+ * Returns the column id, or NULL.
+ */
+const SedResults::Column*
+SedResults::findColumn (const std::string& id) const
+{
+  std::map<std::string, unsigned int>::const_iterator it = mIndex.find(id);
+  return (it != mIndex.end()) ? &mColumns[it->second] : NULL;
+}
+
+
+/*
+ * Makes room for length values in column, keeping its buffer if it is
+ * large enough; the values are not preserved.  Once the columns in memory
+ * take more than the budget, the buffer is a mapped temporary file.
+ */
+bool
+SedResults::allocate (Column& column, size_t length)
+{
+  if (column.block != NULL && length <= column.capacity)
+  {
+    column.length = length;
+    return true;
+  }
+
+  if (length > ((size_t)-1 - SED_RESULTS_ALIGNMENT) / sizeof(double))
+  {
+    return false;
+  }
+
+  const size_t size = length * sizeof(double) + SED_RESULTS_ALIGNMENT;
+
+  if (mMemoryBudget > 0 && length > 0
+      && (mMemoryBytes > mMemoryBudget || size > mMemoryBudget - mMemoryBytes))
+  {
+    // mappings start on a page, so they need no moving to be aligned
+    void* block = mapFile(size);
+    if (block != NULL)
+    {
+      release(column);
+      column.block    = block;
+      column.data     = (double*)block;
+      column.length   = length;
+      column.capacity = length;
+      column.mapped   = size;
+      mSpilledBytes  += size;
+      return true;
+    }
+  }
+
+  // over-allocate so that the start can be moved to the next boundary;
+  // malloc is used rather than an aligned allocator to stay C++98
+  void* block = malloc(size);
+  if (block == NULL) return false;
+
+  const size_t address = (size_t)block;
+  const size_t offset  = (SED_RESULTS_ALIGNMENT
+                          - address % SED_RESULTS_ALIGNMENT)
+                         % SED_RESULTS_ALIGNMENT;
+
+  release(column);
+  column.block    = block;
+  column.data     = (double*)((char*)block + offset);
+  column.length   = length;
+  column.capacity = length;
+  column.mapped   = 0;
+  mMemoryBytes   += size;
+  return true;
+}
+
+
+/*
+ * Frees the buffer of column, unmapping it if it is spilled; aliases have
+ * none.
+ */
+void
+SedResults::release (Column& column)
+{
+  if (column.block == NULL) return;
+
+  if (column.mapped > 0)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(column.block);
+#else
+    munmap(column.block, column.mapped);
+#endif
+    mSpilledBytes -= column.mapped;
+  }
+  else
+  {
+    free(column.block);
+    mMemoryBytes -= column.capacity * sizeof(double) + SED_RESULTS_ALIGNMENT;
+  }
+
+  column.block    = NULL;
+  column.data     = NULL;
+  column.capacity = 0;
+  column.mapped   = 0;
+}
+
+
+/*
+ * Maps a new temporary file of size bytes, zero filled, into memory.  The
+ * file is deleted once it is unmapped.
+ *
+ * @return the mapping, or NULL if the file could not be created or mapped.
+ */
+void*
+SedResults::mapFile (size_t size) const
+{
+  std::string directory = mSpillDirectory;
+
+#ifdef _WIN32
+  if (directory.empty())
+  {
+    char path[MAX_PATH + 1];
+    const DWORD n = GetTempPathA(sizeof(path), path);
+    if (n == 0 || n > sizeof(path)) return NULL;
+    directory = path;
+  }
+
+  char name[MAX_PATH];
+  if (GetTempFileNameA(directory.c_str(), "sed", 0, name) == 0) return NULL;
+
+  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                            CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                            NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    DeleteFileA(name);
+    return NULL;
+  }
+
+  const unsigned long long bytes = (unsigned long long)size;
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                      (DWORD)(bytes >> 32),
+                                      (DWORD)(bytes & 0xffffffffUL), NULL);
+
+  // the view keeps the mapping, and so the file, alive once both handles
+  // are closed
+  void* view = (mapping != NULL)
+             ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0) : NULL;
+
+  if (mapping != NULL) CloseHandle(mapping);
+  CloseHandle(file);
+  return view;
+#else
+  if (directory.empty())
+  {
+    const char* tmpdir = getenv("TMPDIR");
+    directory = (tmpdir != NULL && *tmpdir != '\0') ? tmpdir : "/tmp";
+  }
+
+  std::string pattern = directory;
+  if (pattern[pattern.size() - 1] != '/') pattern += '/';
+  pattern += "sedml-results-XXXXXX";
+
+  std::vector<char> name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+
+  const int fd = mkstemp(&name[0]);
+  if (fd < 0) return NULL;
+
+  // the file has no name from now on, and goes once it is unmapped
+  unlink(&name[0]);
+
+  void* view = NULL;
+  if ((off_t)size > 0 && (size_t)(off_t)size == size
+      && ftruncate(fd, (off_t)size) == 0)
+  {
+    view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) view = NULL;
+  }
+
+  close(fd);
+  return view;
+#endif
+}
+
+
+/*
+ * Appends copies of the columns of orig.
+ */
+void
+SedResults::copyColumns (const SedResults& orig)
+{
+  for (unsigned int i = 0; i < orig.mColumns.size(); ++i)
+  {
+    const Column& column = orig.mColumns[i];
+    setColumn(column.id, column.data, column.length);
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedResults and returns it.
+ */
+LIBSEDML_EXTERN
+SedResults_t *
+SedResults_create ()
+{
+  return new (nothrow) SedResults;
+}
+
+
+/**
+ * Frees the given SedResults.
+ */
+LIBSEDML_EXTERN
+void
+SedResults_free (SedResults_t *sr)
+{
+  delete sr;
+}
+
+
+/**
+ * Creates the column id with room for length values.
+ */
+LIBSEDML_EXTERN
+double *
+SedResults_addColumn (SedResults_t *sr, const char *id, size_t length)
+{
+  if (sr == NULL || id == NULL) return NULL;
+  return sr->addColumn(id, length);
+}
+
+
+/**
+ * Sets the column id to a copy of values.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setColumn (SedResults_t *sr, const char *id,
+                      const double *values, size_t length)
+{
+  if (sr == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (id == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  return sr->setColumn(id, values, length);
+}
+
+
+/**
+ * Sets the column id to values, without copying them.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setColumnAlias (SedResults_t *sr, const char *id,
+                           const double *values, size_t length)
+{
+  if (sr == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (id == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  return sr->setColumnAlias(id, values, length);
+}
+
+
+/**
+ * Returns 1 if the column id is an alias.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_isColumnAlias (const SedResults_t *sr, const char *id)
+{
+  return (sr != NULL && id != NULL && sr->isColumnAlias(id)) ? 1 : 0;
+}
+
+
+/**
+ * Returns the values of the column id.
+ */
+LIBSEDML_EXTERN
+const double *
+SedResults_getColumn (const SedResults_t *sr, const char *id)
+{
+  if (sr == NULL || id == NULL) return NULL;
+  return sr->getColumn(id);
+}
+
+
+/**
+ * Returns the number of values of the column id.
+ */
+LIBSEDML_EXTERN
+size_t
+SedResults_getColumnLength (const SedResults_t *sr, const char *id)
+{
+  if (sr == NULL || id == NULL) return 0;
+  return sr->getColumnLength(id);
+}
+
+
+/**
+ * Returns the number of columns of the given SedResults.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedResults_getNumColumns (const SedResults_t *sr)
+{
+  return (sr != NULL) ? sr->getNumColumns() : 0;
+}
+
+
+/**
+ * Removes the column id.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_removeColumn (SedResults_t *sr, const char *id)
+{
+  if (sr == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (id == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  return sr->removeColumn(id);
+}
+
+
+/**
+ * Sets the number of bytes the columns may take in memory.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setMemoryBudget (SedResults_t *sr, size_t bytes)
+{
+  if (sr == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  sr->setMemoryBudget(bytes);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the directory the temporary files of spilled columns are created
+ * in.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setSpillDirectory (SedResults_t *sr, const char *directory)
+{
+  if (sr == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  sr->setSpillDirectory((directory != NULL) ? directory : "");
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Returns a view of the column the data reference of ds names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getDataSetView (const SedResults_t *sr, const SedDataSet_t *ds)
+{
+  return (sr != NULL) ? sr->getView(ds) : makeView(NULL, 0);
+}
+
+
+/**
+ * Returns a view of the column the x data reference of curve names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getXView (const SedResults_t *sr, const SedCurve_t *curve)
+{
+  return (sr != NULL) ? sr->getXView(curve) : makeView(NULL, 0);
+}
+
+
+/**
+ * Returns a view of the column the y data reference of curve names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getYView (const SedResults_t *sr, const SedCurve_t *curve)
+{
+  return (sr != NULL) ? sr->getYView(curve) : makeView(NULL, 0);
+}
+
+
+/**
+ * Returns a view of the column the z data reference of surface names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getZView (const SedResults_t *sr, const SedSurface_t *surface)
+{
+  return (sr != NULL) ? sr->getZView(surface) : makeView(NULL, 0);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,526 @@
+/**
+ * @file    SedResults.h
+ * @brief   Columnar store for the values of the data generators
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedResults
+ * @ingroup Core
+ * @brief The values computed for the data generators of a SedDocument.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedResults holds one column of @c double values per SedDataGenerator,
+ * keyed by the id of the data generator.  Every column is a single
+ * contiguous buffer aligned to SED_RESULTS_ALIGNMENT bytes, so that it
+ * can be filled directly, for instance by SedCompiledMath::evaluate(),
+ * and read by vectorised code.  Outputs do not copy the values: getView()
+ * returns a SedColumnView of the column a SedDataSet refers to, and
+ * getXView(), getYView() and getZView() do the same for the axes of a
+ * SedCurve or a SedSurface.
+ *
+ * A view stays valid until its column is removed or resized, or the
+ * SedResults is destroyed.
+ *
+ * A column may also be an alias of values held elsewhere, set with
+ * setColumnAlias(): SedExecutor uses them for data generators that are
+ * just one of their variables (see SedDataGenerator::getIdentityVariable()),
+ * whose column is then the column of the task, not a copy of it.  Copies
+ * of a SedResults copy the values of aliases.
+ *
+ * Results larger than memory can be spilled to disk: once the columns
+ * held in memory take more than the budget set with setMemoryBudget(),
+ * every column allocated after that is backed by a temporary file mapped
+ * into memory, in the directory set with setSpillDirectory().  Such a
+ * column is used like any other, through the same pointers and views,
+ * and the operating system pages its values in and out as they are
+ * read; the file is deleted with the column.  If a file cannot be
+ * mapped, the column is allocated in memory.
+ */
+
+#ifndef SedResults_h
+#define SedResults_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+/**
+ * The alignment, in bytes, of the columns of a SedResults.
+ */
+#define SED_RESULTS_ALIGNMENT 64
+
+
+/**
+ * A read-only view of a column of a SedResults; @c data is @c NULL and
+ * @c length is 0 if there is no such column.
+ */
+typedef struct
+{
+  const double *data;
+  size_t        length;
+} SedColumnView;
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+class SedDataSet;
+class SedCurve;
+class SedSurface;
+
+
+class LIBSEDML_EXTERN SedResults
+{
+public:
+
+  /**
+   * Creates a new, empty SedResults.
+   */
+  SedResults ();
+
+
+  /**
+   * Copy constructor; copies the values of all columns, and the memory
+   * budget and spill directory of @p orig.
+   */
+  SedResults (const SedResults& orig);
+
+
+  /**
+   * Assignment operator; copies the values of all columns, within the
+   * memory budget of this SedResults.
+   */
+  SedResults& operator= (const SedResults& rhs);
+
+
+  /**
+   * Destroys this SedResults and its columns.
+   */
+  virtual ~SedResults ();
+
+
+  /**
+   * Creates the column @p id with room for @p length values, all zero.
+   * An existing column of that id is resized and cleared; its buffer is
+   * reused if it is large enough.
+   *
+   * @return the values of the column, or @c NULL if @p id is empty or
+   * memory could not be allocated.
+   */
+  double* addColumn (const std::string& id, size_t length);
+
+
+  /**
+   * Creates the column for @p dg with room for @p length values.
+   *
+   * @see addColumn(const std::string&, size_t)
+   */
+  double* addColumn (const SedDataGenerator* dg, size_t length);
+
+
+  /**
+   * Makes the column @p id hold @p length values, keeping those it has:
+   * values beyond its old length are zero.  A column that does not exist
+   * is created as by addColumn(), and an alias is copied first.  The
+   * buffer moves if it is not large enough; getting a column shorter
+   * never moves it.
+   *
+   * @return the values of the column, or @c NULL if @p id is empty or
+   * memory could not be allocated, in which case the column is unchanged.
+   */
+  double* resizeColumn (const std::string& id, size_t length);
+
+
+  /**
+   * Sets the column @p id to a copy of the @p length @p values.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p id is empty, or @p values is @c NULL though @p length is not 0
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if memory could not be allocated
+   */
+  int setColumn (const std::string& id, const double* values, size_t length);
+
+
+  /**
+   * Sets the column @p id to the @p length @p values themselves, which are
+   * not copied: they must stay valid, and are read but never written, for
+   * as long as the column is not removed or changed.  getColumn() on an
+   * alias gives the column values of its own first.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p id is empty, or @p values is @c NULL though @p length is not 0
+   */
+  int setColumnAlias (const std::string& id, const double* values,
+                      size_t length);
+
+
+  /**
+   * @return @c true if the column @p id is an alias set with
+   * setColumnAlias().
+   */
+  bool isColumnAlias (const std::string& id) const;
+
+
+  /**
+   * @return the values of the column @p id, or @c NULL if there is none
+   * or an alias could not be copied.
+   */
+  double* getColumn (const std::string& id);
+
+
+  /**
+   * @return the values of the column @p id, or @c NULL if there is none.
+   */
+  const double* getColumn (const std::string& id) const;
+
+
+  /**
+   * @return the number of values of the column @p id, or 0 if there is
+   * none.
+   */
+  size_t getColumnLength (const std::string& id) const;
+
+
+  /**
+   * @return @c true if there is a column @p id.
+   */
+  bool hasColumn (const std::string& id) const;
+
+
+  /**
+   * @return the number of columns.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the id of the n-th column, in the order the columns were
+   * added, or an empty string if @p n is out of range.
+   */
+  const std::string& getColumnId (unsigned int n) const;
+
+
+  /**
+   * Removes the column @p id.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if there is no column @p id
+   */
+  int removeColumn (const std::string& id);
+
+
+  /**
+   * Removes all columns.
+   */
+  void clear ();
+
+
+  /**
+   * Sets the number of bytes the columns may take in memory: columns
+   * allocated once they take more are backed by temporary files mapped
+   * into memory.  Zero, the default, keeps all columns in memory.  The
+   * columns allocated before are not moved.
+   */
+  void setMemoryBudget (size_t bytes);
+
+
+  /**
+   * @return the number of bytes the columns may take in memory, or 0 if
+   * there is no limit.
+   */
+  size_t getMemoryBudget () const;
+
+
+  /**
+   * Sets the directory the temporary files of spilled columns are created
+   * in; an empty string, the default, uses the directory named by the
+   * @c TMPDIR environment variable, or the temporary directory of the
+   * system.
+   */
+  void setSpillDirectory (const std::string& directory);
+
+
+  /**
+   * @return the directory the temporary files of spilled columns are
+   * created in, or an empty string for the default.
+   */
+  const std::string& getSpillDirectory () const;
+
+
+  /**
+   * @return @c true if the column @p id is backed by a temporary file.
+   */
+  bool isColumnSpilled (const std::string& id) const;
+
+
+  /**
+   * @return the number of bytes the columns allocated in memory take.
+   */
+  size_t getMemoryBytes () const;
+
+
+  /**
+   * @return the number of bytes of the temporary files of the spilled
+   * columns.
+   */
+  size_t getSpilledBytes () const;
+
+
+  /**
+   * @return a view of the column @p id.
+   */
+  SedColumnView getView (const std::string& id) const;
+
+
+  /**
+   * @return a view of the column the data reference of @p ds names.
+   */
+  SedColumnView getView (const SedDataSet* ds) const;
+
+
+  /**
+   * @return a view of the column the x data reference of @p curve names.
+   */
+  SedColumnView getXView (const SedCurve* curve) const;
+
+
+  /**
+   * @return a view of the column the y data reference of @p curve names.
+   */
+  SedColumnView getYView (const SedCurve* curve) const;
+
+
+  /**
+   * @return a view of the column the z data reference of @p surface names.
+   */
+  SedColumnView getZView (const SedSurface* surface) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Column
+  {
+    std::string id;
+    void*       block;
+    double*     data;
+    size_t      length;
+    size_t      capacity;
+    size_t      mapped;
+  };
+
+  Column* findColumn (const std::string& id);
+
+  const Column* findColumn (const std::string& id) const;
+
+  bool allocate (Column& column, size_t length);
+
+  void release (Column& column);
+
+  void* mapFile (size_t size) const;
+
+  void copyColumns (const SedResults& orig);
+
+
+  std::vector<Column>                 mColumns;
+  std::map<std::string, unsigned int> mIndex;
+
+  size_t                              mMemoryBudget;
+  size_t                              mMemoryBytes;
+  size_t                              mSpilledBytes;
+  std::string                         mSpillDirectory;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedResults and returns it.
+ */
+LIBSEDML_EXTERN
+SedResults_t *
+SedResults_create ();
+
+
+/**
+ * Frees the given SedResults.
+ */
+LIBSEDML_EXTERN
+void
+SedResults_free (SedResults_t *sr);
+
+
+/**
+ * Creates the column @p id with room for @p length values, all zero, and
+ * returns its values.
+ */
+LIBSEDML_EXTERN
+double *
+SedResults_addColumn (SedResults_t *sr, const char *id, size_t length);
+
+
+/**
+ * Sets the column @p id to a copy of the @p length @p values.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setColumn (SedResults_t *sr, const char *id,
+                      const double *values, size_t length);
+
+
+/**
+ * Sets the column @p id to the @p length @p values themselves, without
+ * copying them.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setColumnAlias (SedResults_t *sr, const char *id,
+                           const double *values, size_t length);
+
+
+/**
+ * Returns 1 if the column @p id is an alias, 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_isColumnAlias (const SedResults_t *sr, const char *id);
+
+
+/**
+ * Returns the values of the column @p id, or @c NULL if there is none.
+ */
+LIBSEDML_EXTERN
+const double *
+SedResults_getColumn (const SedResults_t *sr, const char *id);
+
+
+/**
+ * Returns the number of values of the column @p id.
+ */
+LIBSEDML_EXTERN
+size_t
+SedResults_getColumnLength (const SedResults_t *sr, const char *id);
+
+
+/**
+ * Returns the number of columns of the given SedResults.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedResults_getNumColumns (const SedResults_t *sr);
+
+
+/**
+ * Removes the column @p id.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_removeColumn (SedResults_t *sr, const char *id);
+
+
+/**
+ * Sets the number of bytes the columns of the given SedResults may take
+ * in memory before columns are spilled to temporary files; 0 means no
+ * limit.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setMemoryBudget (SedResults_t *sr, size_t bytes);
+
+
+/**
+ * Sets the directory the temporary files of spilled columns are created
+ * in; @c NULL uses the default.
+ */
+LIBSEDML_EXTERN
+int
+SedResults_setSpillDirectory (SedResults_t *sr, const char *directory);
+
+
+/**
+ * Returns a view of the column the data reference of @p ds names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getDataSetView (const SedResults_t *sr, const SedDataSet_t *ds);
+
+
+/**
+ * Returns a view of the column the x data reference of @p curve names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getXView (const SedResults_t *sr, const SedCurve_t *curve);
+
+
+/**
+ * Returns a view of the column the y data reference of @p curve names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getYView (const SedResults_t *sr, const SedCurve_t *curve);
+
+
+/**
+ * Returns a view of the column the z data reference of @p surface names.
+ */
+LIBSEDML_EXTERN
+SedColumnView
+SedResults_getZView (const SedResults_t *sr, const SedSurface_t *surface);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedResults_h */
@@ -0,0 +1,728 @@
+/**
+ * @file    SedResultsComparison.cpp
+ * @brief   Compares results or reports against reference values
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedResultsComparison.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedNumber.h>
+#include <sedml/common/common.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define SED_COMPARISON_SSE2
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of values compared by one pass of the kernel.
+ */
+static const size_t SED_COMPARISON_BLOCK = 256;
+
+
+/*
+ * Compares the length values of expected and actual, adding the number
+ * that do not match to numFailed and raising maxAbs and maxRel to their
+ * errors.  Every value is treated alike, without branches: two at a time
+ * with SSE2 where it is available, then the rest one by one.
+ */
+static void
+compareBlock (const double* expected, const double* actual, size_t length,
+              double absTol, double relTol, size_t& numFailed,
+              double& maxAbs, double& maxRel)
+{
+  size_t i = 0;
+  double failed   = 0;
+  double blockAbs = 0;
+  double blockRel = 0;
+
+#ifdef SED_COMPARISON_SSE2
+  const __m128d sign  = _mm_set1_pd(-0.0);
+  const __m128d zero  = _mm_setzero_pd();
+  const __m128d one   = _mm_set1_pd(1.0);
+  const __m128d inf   = _mm_set1_pd(HUGE_VAL);
+  const __m128d atol  = _mm_set1_pd(absTol);
+  const __m128d rtol  = _mm_set1_pd(relTol);
+
+  __m128d vfailed = zero;
+  __m128d vabs    = zero;
+  __m128d vrel    = zero;
+
+  for (; i + 2 <= length; i += 2)
+  {
+    const __m128d e = _mm_loadu_pd(expected + i);
+    const __m128d a = _mm_loadu_pd(actual + i);
+    const __m128d d = _mm_andnot_pd(sign, _mm_sub_pd(a, e));
+    const __m128d scale = _mm_andnot_pd(sign, e);
+
+    const __m128d same = _mm_or_pd(_mm_cmpeq_pd(a, e),
+      _mm_and_pd(_mm_cmpunord_pd(a, a), _mm_cmpunord_pd(e, e)));
+    const __m128d near = _mm_cmple_pd(d, _mm_add_pd(atol,
+                                                    _mm_mul_pd(rtol, scale)));
+    vfailed = _mm_add_pd(vfailed, _mm_andnot_pd(_mm_or_pd(same, near), one));
+
+    const __m128d err = _mm_and_pd(_mm_cmplt_pd(d, inf), d);
+    const __m128d scaled = _mm_cmpgt_pd(scale, zero);
+    const __m128d rel = _mm_div_pd(_mm_and_pd(scaled, err),
+      _mm_or_pd(_mm_and_pd(scaled, scale), _mm_andnot_pd(scaled, one)));
+    vabs = _mm_max_pd(vabs, err);
+    vrel = _mm_max_pd(vrel, rel);
+  }
+
+  double lanes[2];
+  _mm_storeu_pd(lanes, vfailed);
+  failed = lanes[0] + lanes[1];
+  _mm_storeu_pd(lanes, vabs);
+  blockAbs = (lanes[0] > lanes[1]) ? lanes[0] : lanes[1];
+  _mm_storeu_pd(lanes, vrel);
+  blockRel = (lanes[0] > lanes[1]) ? lanes[0] : lanes[1];
+#endif
+
+  for (; i < length; ++i)
+  {
+    const double e = expected[i];
+    const double a = actual[i];
+    const double d = fabs(a - e);
+    const double scale = fabs(e);
+
+    // equal infinities give a NaN difference, as does a NaN on one side
+    const bool same = (a == e) | ((a != a) & (e != e));
+    const bool near = d <= absTol + relTol * scale;
+    failed += (same | near) ? 0 : 1;
+
+    // NaN and infinite differences leave the maxima as they are
+    const double err = (d < HUGE_VAL) ? d : 0;
+    const double rel = (scale > 0) ? err / scale : 0;
+    blockAbs = (err > blockAbs) ? err : blockAbs;
+    blockRel = (rel > blockRel) ? rel : blockRel;
+  }
+
+  numFailed += (size_t)failed;
+  if (blockAbs > maxAbs) maxAbs = blockAbs;
+  if (blockRel > maxRel) maxRel = blockRel;
+}
+
+
+/*
+ * Returns the index of the first value of a block with a mismatch that
+ * does not match.
+ */
+static size_t
+findFailure (const double* expected, const double* actual, size_t length,
+             double absTol, double relTol)
+{
+  for (size_t i = 0; i < length; ++i)
+  {
+    const double e = expected[i];
+    const double a = actual[i];
+    if (a == e || (a != a && e != e)) continue;
+    if (!(fabs(a - e) <= absTol + relTol * fabs(e))) return i;
+  }
+  return length;
+}
+
+
+/*
+ * Splits the CSV line of text starting at pos into fields, moving pos past
+ * it; fields may be quoted, with doubled quotes inside.
+ */
+static bool
+readLine (const std::string& text, size_t& pos,
+          std::vector<std::string>& fields)
+{
+  fields.clear();
+  if (pos >= text.size()) return false;
+
+  std::string field;
+  bool quoted = false;
+
+  for (; pos < text.size(); ++pos)
+  {
+    const char c = text[pos];
+    if (quoted)
+    {
+      if (c != '"')
+      {
+        field += c;
+      }
+      else if (pos + 1 < text.size() && text[pos + 1] == '"')
+      {
+        field += '"';
+        ++pos;
+      }
+      else
+      {
+        quoted = false;
+      }
+    }
+    else if (c == '"')
+    {
+      quoted = true;
+    }
+    else if (c == ',')
+    {
+      fields.push_back(field);
+      field.erase();
+    }
+    else if (c == '\n')
+    {
+      ++pos;
+      break;
+    }
+    else if (c != '\r')
+    {
+      field += c;
+    }
+  }
+
+  fields.push_back(field);
+  return true;
+}
+
+
+/*
+ * Reads a CSV field as written by SedReportWriter; empty fields are NaN.
+ */
+static bool
+parseValue (const std::string& field, double& value)
+{
+  if (field.empty() || field == "NaN")
+  {
+    value = numeric_limits<double>::quiet_NaN();
+    return true;
+  }
+  if (field == "INF")
+  {
+    value = HUGE_VAL;
+    return true;
+  }
+  if (field == "-INF")
+  {
+    value = -HUGE_VAL;
+    return true;
+  }
+  return SedNumber::parse(field, value);
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedResultsComparison with the given tolerances.
+ */
+SedResultsComparison::SedResultsComparison (double absoluteTolerance,
+                                            double relativeTolerance)
+  : mAbsoluteTolerance (absoluteTolerance)
+  , mRelativeTolerance (relativeTolerance)
+  , mNumMismatches (0)
+{
+}
+
+
+/*
+ * Destroys this SedResultsComparison.
+ */
+SedResultsComparison::~SedResultsComparison ()
+{
+}
+
+
+/*
+ * Sets the tolerance on the absolute difference of two values.
+ */
+void
+SedResultsComparison::setAbsoluteTolerance (double tolerance)
+{
+  mAbsoluteTolerance = tolerance;
+}
+
+
+/*
+ * Returns the tolerance on the absolute difference of two values.
+ */
+double
+SedResultsComparison::getAbsoluteTolerance () const
+{
+  return mAbsoluteTolerance;
+}
+
+
+/*
+ * Sets the tolerance on the relative difference of two values.
+ */
+void
+SedResultsComparison::setRelativeTolerance (double tolerance)
+{
+  mRelativeTolerance = tolerance;
+}
+
+
+/*
+ * Returns the tolerance on the relative difference of two values.
+ */
+double
+SedResultsComparison::getRelativeTolerance () const
+{
+  return mRelativeTolerance;
+}
+
+
+/*
+ * Compares the columns of actual with those of expected.
+ */
+int
+SedResultsComparison::compare (const SedResults& expected,
+                               const SedResults& actual)
+{
+  mColumns.clear();
+  mNumMismatches = 0;
+
+  // the columns of expected in their order, then those only actual has
+  for (unsigned int i = 0; i < expected.getNumColumns(); ++i)
+  {
+    Column column;
+    column.id = expected.getColumnId(i);
+
+    const double* values = actual.getColumn(column.id);
+    const size_t length = expected.getColumnLength(column.id);
+
+    if (values == NULL && !actual.hasColumn(column.id))
+    {
+      column.status       = SED_COMPARISON_MISSING;
+      column.numValues    = 0;
+      column.numFailed    = length;
+      column.firstFailure = 0;
+      column.maxAbsError  = 0;
+      column.maxRelError  = 0;
+    }
+    else
+    {
+      const size_t other = actual.getColumnLength(column.id);
+      compareColumn(column, expected.getColumn(column.id), values,
+                    (length < other) ? length : other);
+      if (length != other) column.status = SED_COMPARISON_LENGTH_MISMATCH;
+    }
+
+    if (column.status != SED_COMPARISON_MATCH) ++mNumMismatches;
+    mColumns.push_back(column);
+  }
+
+  for (unsigned int i = 0; i < actual.getNumColumns(); ++i)
+  {
+    const std::string& id = actual.getColumnId(i);
+    if (expected.hasColumn(id)) continue;
+
+    Column column;
+    column.id           = id;
+    column.status       = SED_COMPARISON_UNEXPECTED;
+    column.numValues    = 0;
+    column.numFailed    = actual.getColumnLength(id);
+    column.firstFailure = 0;
+    column.maxAbsError  = 0;
+    column.maxRelError  = 0;
+
+    ++mNumMismatches;
+    mColumns.push_back(column);
+  }
+
+  return isMatch() ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * Compares the columns of two CSV reports.
+ */
+int
+SedResultsComparison::compareReports (const std::string& expectedFile,
+                                      const std::string& actualFile)
+{
+  SedResults expected;
+  SedResults actual;
+
+  if (readReport(expectedFile, expected) != LIBSEDML_OPERATION_SUCCESS
+      || readReport(actualFile, actual) != LIBSEDML_OPERATION_SUCCESS)
+  {
+    mColumns.clear();
+    mNumMismatches = 0;
+    return LIBSEDML_INVALID_OBJECT;
+  }
+
+  return compare(expected, actual);
+}
+
+
+/*
+ * Reads the CSV report filename into results.
+ */
+int
+SedResultsComparison::readReport (const std::string& filename,
+                                  SedResults& results)
+{
+  FILE* file = fopen(filename.c_str(), "rb");
+  if (file == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  std::string text;
+  char block[65536];
+  for (size_t n; (n = fread(block, 1, sizeof(block), file)) > 0; )
+  {
+    text.append(block, n);
+  }
+  const bool ok = ferror(file) == 0;
+  fclose(file);
+  if (!ok) return LIBSEDML_OPERATION_FAILED;
+
+  size_t pos = 0;
+  std::vector<std::string> header;
+  if (!readLine(text, pos, header)) return LIBSEDML_OPERATION_FAILED;
+
+  // the rows are counted first, so that every column is allocated once
+  size_t numRows = 0;
+  for (size_t i = pos; i < text.size(); ++i)
+  {
+    if (text[i] == '\n') ++numRows;
+  }
+  if (!text.empty() && text[text.size() - 1] != '\n') ++numRows;
+
+  results.clear();
+  std::vector<double*> columns(header.size());
+  for (size_t j = 0; j < header.size(); ++j)
+  {
+    columns[j] = results.addColumn(header[j], numRows);
+    if (columns[j] == NULL) return LIBSEDML_OPERATION_FAILED;
+  }
+
+  std::vector<std::string> fields;
+  size_t row = 0;
+  for (; row < numRows && readLine(text, pos, fields); ++row)
+  {
+    for (size_t j = 0; j < header.size(); ++j)
+    {
+      double value = 0;
+      if (!parseValue((j < fields.size()) ? fields[j] : "", value))
+      {
+        return LIBSEDML_OPERATION_FAILED;
+      }
+      columns[j][row] = value;
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if every column of the last comparison matched.
+ */
+bool
+SedResultsComparison::isMatch () const
+{
+  return mNumMismatches == 0;
+}
+
+
+/*
+ * Returns the number of columns of the last comparison.
+ */
+unsigned int
+SedResultsComparison::getNumColumns () const
+{
+  return (unsigned int)mColumns.size();
+}
+
+
+/*
+ * Returns the number of columns that did not match.
+ */
+unsigned int
+SedResultsComparison::getNumMismatches () const
+{
+  return mNumMismatches;
+}
+
+
+/*
+ * Returns the id of the n-th column.
+ */
+const std::string&
+SedResultsComparison::getColumnId (unsigned int n) const
+{
+  static const std::string empty;
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->id : empty;
+}
+
+
+/*
+ * Returns the status of the n-th column.
+ */
+int
+SedResultsComparison::getColumnStatus (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->status : SED_COMPARISON_MISSING;
+}
+
+
+/*
+ * Returns the number of values of the n-th column compared.
+ */
+size_t
+SedResultsComparison::getNumValues (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->numValues : 0;
+}
+
+
+/*
+ * Returns the number of values of the n-th column that did not match.
+ */
+size_t
+SedResultsComparison::getNumFailedValues (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->numFailed : 0;
+}
+
+
+/*
+ * Returns the index of the first value of the n-th column that did not
+ * match.
+ */
+size_t
+SedResultsComparison::getFirstFailure (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->firstFailure : 0;
+}
+
+
+/*
+ * Returns the largest absolute error of the n-th column.
+ */
+double
+SedResultsComparison::getMaxAbsoluteError (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->maxAbsError : 0;
+}
+
+
+/*
+ * Returns the largest relative error of the n-th column.
+ */
+double
+SedResultsComparison::getMaxRelativeError (unsigned int n) const
+{
+  const Column* column = getColumn(n);
+  return (column != NULL) ? column->maxRelError : 0;
+}
+
+
+/*
+ * Returns a description of the columns that did not match, and the
+ * totals.
+ */
+std::string
+SedResultsComparison::getSummary () const
+{
+  std::string summary;
+  size_t numValues = 0;
+  size_t numFailed = 0;
+
+  for (size_t i = 0; i < mColumns.size(); ++i)
+  {
+    const Column& column = mColumns[i];
+    numValues += column.numValues;
+    numFailed += column.numFailed;
+
+    char line[256];
+    switch (column.status)
+    {
+    case SED_COMPARISON_MATCH:
+      continue;
+
+    case SED_COMPARISON_MISSING:
+      summary += column.id + ": missing\n";
+      continue;
+
+    case SED_COMPARISON_UNEXPECTED:
+      summary += column.id + ": unexpected\n";
+      continue;
+
+    default:
+      sprintf(line, ": %lu of %lu differ from %lu, max abs %.3g, max rel "
+              "%.3g%s\n", (unsigned long)column.numFailed,
+              (unsigned long)column.numValues,
+              (unsigned long)column.firstFailure, column.maxAbsError,
+              column.maxRelError,
+              (column.status == SED_COMPARISON_LENGTH_MISMATCH)
+                ? ", lengths differ" : "");
+      summary += column.id + line;
+    }
+  }
+
+  char line[256];
+  sprintf(line, "%u of %u columns and %lu of %lu values differ\n",
+          mNumMismatches, (unsigned int)mColumns.size(),
+          (unsigned long)numFailed, (unsigned long)numValues);
+  return summary + line;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Compares the first length values of a column of both sides into column.
+ */
+void
+SedResultsComparison::compareColumn (Column& column, const double* expected,
+                                     const double* actual,
+                                     size_t length) const
+{
+  column.numValues    = length;
+  column.numFailed    = 0;
+  column.firstFailure = length;
+  column.maxAbsError  = 0;
+  column.maxRelError  = 0;
+
+  for (size_t start = 0; start < length; start += SED_COMPARISON_BLOCK)
+  {
+    const size_t n = (length - start < SED_COMPARISON_BLOCK)
+                   ? length - start : SED_COMPARISON_BLOCK;
+    const size_t before = column.numFailed;
+
+    compareBlock(expected + start, actual + start, n, mAbsoluteTolerance,
+                 mRelativeTolerance, column.numFailed, column.maxAbsError,
+                 column.maxRelError);
+
+    if (column.numFailed != before && column.firstFailure == length)
+    {
+      column.firstFailure = start
+        + findFailure(expected + start, actual + start, n,
+                      mAbsoluteTolerance, mRelativeTolerance);
+    }
+  }
+
+  column.status = (column.numFailed == 0) ? SED_COMPARISON_MATCH
+                                          : SED_COMPARISON_MISMATCH;
+}
+
+
+/*
+ * Returns the n-th column, or NULL.
+ */
+const SedResultsComparison::Column*
+SedResultsComparison::getColumn (unsigned int n) const
+{
+  return (n < mColumns.size()) ? &mColumns[n] : NULL;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedResultsComparison with the given tolerances and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedResultsComparison_t *
+SedResultsComparison_create (double absoluteTolerance,
+                             double relativeTolerance)
+{
+  return new (nothrow) SedResultsComparison(absoluteTolerance,
+                                            relativeTolerance);
+}
+
+
+/**
+ * Frees the given SedResultsComparison.
+ */
+LIBSEDML_EXTERN
+void
+SedResultsComparison_free (SedResultsComparison_t *src)
+{
+  delete src;
+}
+
+
+/**
+ * Compares the columns of actual with those of expected that have the
+ * same ids.
+ */
+LIBSEDML_EXTERN
+int
+SedResultsComparison_compare (SedResultsComparison_t *src,
+                              const SedResults_t *expected,
+                              const SedResults_t *actual)
+{
+  if (src == NULL || expected == NULL || actual == NULL)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  return src->compare(*expected, *actual);
+}
+
+
+/**
+ * Compares the columns of two CSV reports that have the same header.
+ */
+LIBSEDML_EXTERN
+int
+SedResultsComparison_compareReports (SedResultsComparison_t *src,
+                                     const char *expectedFile,
+                                     const char *actualFile)
+{
+  if (src == NULL || expectedFile == NULL || actualFile == NULL)
+  {
+    return LIBSEDML_INVALID_OBJECT;
+  }
+  return src->compareReports(expectedFile, actualFile);
+}
+
+
+/**
+ * Returns the summary of the last comparison, which the caller owns.
+ */
+LIBSEDML_EXTERN
+char *
+SedResultsComparison_getSummary (const SedResultsComparison_t *src)
+{
+  return (src != NULL) ? safe_strdup(src->getSummary().c_str()) : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,340 @@
+/**
+ * @file    SedResultsComparison.h
+ * @brief   Compares results or reports against reference values
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedResultsComparison
+ * @ingroup Core
+ * @brief Checks the columns of results against those of reference results.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * compare() aligns the columns of two SedResults by id, that is by the id
+ * of the SedDataGenerator each holds, and compareReports() those of two
+ * CSV files written by a SedReportWriter by their header.  A value
+ * matches its reference if both are NaN, if both are the same infinity,
+ * or if
+ *
+ * <code>|actual - expected| <= absolute + relative * |expected|</code>
+ *
+ * for the tolerances of the comparison.  For every column the number of
+ * values that do not match, the first of them and the largest absolute
+ * and relative errors are kept; a column only one side has, or whose
+ * lengths differ, does not match either.  getSummary() then describes
+ * the columns that do not match, one line each, and the totals.
+ *
+ * The values are compared in blocks, without branches or early exits,
+ * two at a time with SSE2 instructions where the compiler targets them;
+ * only a block with a mismatch is looked at again, for the index of the
+ * first.
+ */
+
+#ifndef SedResultsComparison_h
+#define SedResultsComparison_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+/**
+ * How the columns of a SedResultsComparison compare.
+ */
+typedef enum
+{
+    SED_COMPARISON_MATCH           = 0 /*!< Every value matches */
+  , SED_COMPARISON_MISMATCH        = 1 /*!< Some values do not match */
+  , SED_COMPARISON_LENGTH_MISMATCH = 2 /*!< The columns differ in length */
+  , SED_COMPARISON_MISSING         = 3 /*!< Only the expected results have the column */
+  , SED_COMPARISON_UNEXPECTED      = 4 /*!< Only the actual results have the column */
+} SedComparisonStatus_t;
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedResults;
+
+
+class LIBSEDML_EXTERN SedResultsComparison
+{
+public:
+
+  /**
+   * Creates a new SedResultsComparison with the given tolerances.
+   */
+  SedResultsComparison (double absoluteTolerance = 1e-12,
+                        double relativeTolerance = 1e-9);
+
+
+  /**
+   * Destroys this SedResultsComparison.
+   */
+  virtual ~SedResultsComparison ();
+
+
+  /**
+   * Sets the tolerance on the absolute difference of two values.
+   */
+  void setAbsoluteTolerance (double tolerance);
+
+
+  /**
+   * @return the tolerance on the absolute difference of two values.
+   */
+  double getAbsoluteTolerance () const;
+
+
+  /**
+   * Sets the tolerance on the difference of two values relative to the
+   * expected one.
+   */
+  void setRelativeTolerance (double tolerance);
+
+
+  /**
+   * @return the tolerance on the difference of two values relative to the
+   * expected one.
+   */
+  double getRelativeTolerance () const;
+
+
+  /**
+   * Compares the columns of @p actual with those of @p expected that have
+   * the same ids, replacing what an earlier comparison found.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if every column matches
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any does not
+   */
+  int compare (const SedResults& expected, const SedResults& actual);
+
+
+  /**
+   * Reads the CSV reports @p expectedFile and @p actualFile, as written by
+   * a SedReportWriter, and compares their columns that have the same
+   * header, replacing what an earlier comparison found.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * if every column matches
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any does not
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a file cannot be read, in which case nothing is compared
+   */
+  int compareReports (const std::string& expectedFile,
+                      const std::string& actualFile);
+
+
+  /**
+   * Reads the CSV report @p filename, as written by a SedReportWriter,
+   * into @p results, one column per header field; empty fields are NaN.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be read or a field is not a number
+   */
+  static int readReport (const std::string& filename, SedResults& results);
+
+
+  /**
+   * @return @c true if every column of the last comparison matched.
+   */
+  bool isMatch () const;
+
+
+  /**
+   * @return the number of columns of the last comparison, those of both
+   * sides.
+   */
+  unsigned int getNumColumns () const;
+
+
+  /**
+   * @return the number of columns of the last comparison that did not
+   * match.
+   */
+  unsigned int getNumMismatches () const;
+
+
+  /**
+   * @return the id of the n-th column, or an empty string if @p n is out
+   * of range.
+   */
+  const std::string& getColumnId (unsigned int n) const;
+
+
+  /**
+   * @return the #SedComparisonStatus_t of the n-th column.
+   */
+  int getColumnStatus (unsigned int n) const;
+
+
+  /**
+   * @return the number of values of the n-th column compared.
+   */
+  size_t getNumValues (unsigned int n) const;
+
+
+  /**
+   * @return the number of values of the n-th column that did not match.
+   */
+  size_t getNumFailedValues (unsigned int n) const;
+
+
+  /**
+   * @return the index of the first value of the n-th column that did not
+   * match, or the number of values compared if all did.
+   */
+  size_t getFirstFailure (unsigned int n) const;
+
+
+  /**
+   * @return the largest absolute difference of two finite values of the
+   * n-th column.
+   */
+  double getMaxAbsoluteError (unsigned int n) const;
+
+
+  /**
+   * @return the largest difference of two finite values of the n-th
+   * column relative to the expected one, where that is not 0.
+   */
+  double getMaxRelativeError (unsigned int n) const;
+
+
+  /**
+   * @return a line for every column that did not match, and one with the
+   * numbers of columns and values compared and of those that did not
+   * match.
+   */
+  std::string getSummary () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Column
+  {
+    std::string  id;
+    int          status;
+    size_t       numValues;
+    size_t       numFailed;
+    size_t       firstFailure;
+    double       maxAbsError;
+    double       maxRelError;
+  };
+
+  void compareColumn (Column& column, const double* expected,
+                      const double* actual, size_t length) const;
+
+  const Column* getColumn (unsigned int n) const;
+
+
+  double               mAbsoluteTolerance;
+  double               mRelativeTolerance;
+  std::vector<Column>  mColumns;
+  unsigned int         mNumMismatches;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedResultsComparison with the given tolerances and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedResultsComparison_t *
+SedResultsComparison_create (double absoluteTolerance,
+                             double relativeTolerance);
+
+
+/**
+ * Frees the given SedResultsComparison.
+ */
+LIBSEDML_EXTERN
+void
+SedResultsComparison_free (SedResultsComparison_t *src);
+
+
+/**
+ * Compares the columns of @p actual with those of @p expected that have
+ * the same ids.
+ */
+LIBSEDML_EXTERN
+int
+SedResultsComparison_compare (SedResultsComparison_t *src,
+                              const SedResults_t *expected,
+                              const SedResults_t *actual);
+
+
+/**
+ * Compares the columns of the CSV reports @p expectedFile and
+ * @p actualFile that have the same header.
+ */
+LIBSEDML_EXTERN
+int
+SedResultsComparison_compareReports (SedResultsComparison_t *src,
+                                     const char *expectedFile,
+                                     const char *actualFile);
+
+
+/**
+ * Returns the summary of the last comparison of the given
+ * SedResultsComparison, which the caller owns.
+ */
+LIBSEDML_EXTERN
+char *
+SedResultsComparison_getSummary (const SedResultsComparison_t *src);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedResultsComparison_h */
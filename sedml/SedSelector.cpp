@@ -0,0 +1,929 @@
+/**
+ * @file    SedSelector.cpp
+ * @brief   Compiled queries selecting the objects of a SED-ML document
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSelector.h>
+#include <sedml/SedTypes.h>
+#include <sedml/SedElementIterator.h>
+#include <sedml/SedNumber.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cctype>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The attributes a predicate can test.
+ */
+enum
+{
+    SED_SELECTOR_ID
+  , SED_SELECTOR_NAME
+  , SED_SELECTOR_METAID
+  , SED_SELECTOR_TARGET
+  , SED_SELECTOR_SYMBOL
+  , SED_SELECTOR_TASK_REFERENCE
+  , SED_SELECTOR_MODEL_REFERENCE
+  , SED_SELECTOR_SIMULATION_REFERENCE
+  , SED_SELECTOR_LANGUAGE
+  , SED_SELECTOR_SOURCE
+  , SED_SELECTOR_LABEL
+  , SED_SELECTOR_DATA_REFERENCE
+  , SED_SELECTOR_X_DATA_REFERENCE
+  , SED_SELECTOR_Y_DATA_REFERENCE
+  , SED_SELECTOR_Z_DATA_REFERENCE
+  , SED_SELECTOR_LOG_X
+  , SED_SELECTOR_LOG_Y
+  , SED_SELECTOR_LOG_Z
+  , SED_SELECTOR_KISAO_ID
+  , SED_SELECTOR_VALUE
+  , SED_SELECTOR_INITIAL_TIME
+  , SED_SELECTOR_OUTPUT_START_TIME
+  , SED_SELECTOR_OUTPUT_END_TIME
+  , SED_SELECTOR_NUMBER_OF_POINTS
+};
+
+
+struct SedSelectorName
+{
+  const char* name;
+  int         code;
+};
+
+
+static const SedSelectorName SED_SELECTOR_TYPES[] =
+{
+    { "sedML",             SEDML_DOCUMENT                     }
+  , { "model",             SEDML_MODEL                        }
+  , { "change",            SEDML_CHANGE                       }
+  , { "changeAttribute",   SEDML_CHANGE_ATTRIBUTE             }
+  , { "removeXML",         SEDML_CHANGE_REMOVEXML             }
+  , { "computeChange",     SEDML_CHANGE_COMPUTECHANGE         }
+  , { "dataGenerator",     SEDML_DATAGENERATOR                }
+  , { "variable",          SEDML_VARIABLE                     }
+  , { "parameter",         SEDML_PARAMETER                    }
+  , { "task",              SEDML_TASK                         }
+  , { "output",            SEDML_OUTPUT                       }
+  , { "dataSet",           SEDML_OUTPUT_DATASET               }
+  , { "curve",             SEDML_OUTPUT_CURVE                 }
+  , { "surface",           SEDML_OUTPUT_SURFACE               }
+  , { "report",            SEDML_OUTPUT_REPORT                }
+  , { "plot2D",            SEDML_OUTPUT_PLOT2D                }
+  , { "plot3D",            SEDML_OUTPUT_PLOT3D                }
+  , { "simulation",        SEDML_SIMULATION                   }
+  , { "algorithm",         SEDML_SIMULATION_ALGORITHM         }
+  , { "uniformTimeCourse", SEDML_SIMULATION_UNIFORMTIMECOURSE }
+  , { NULL,                SEDML_UNKNOWN                      }
+};
+
+
+static const SedSelectorName SED_SELECTOR_ATTRIBUTES[] =
+{
+    { "id",                  SED_SELECTOR_ID                   }
+  , { "name",                SED_SELECTOR_NAME                 }
+  , { "metaid",              SED_SELECTOR_METAID               }
+  , { "target",              SED_SELECTOR_TARGET               }
+  , { "symbol",              SED_SELECTOR_SYMBOL               }
+  , { "taskReference",       SED_SELECTOR_TASK_REFERENCE       }
+  , { "modelReference",      SED_SELECTOR_MODEL_REFERENCE      }
+  , { "simulationReference", SED_SELECTOR_SIMULATION_REFERENCE }
+  , { "language",            SED_SELECTOR_LANGUAGE             }
+  , { "source",              SED_SELECTOR_SOURCE               }
+  , { "label",               SED_SELECTOR_LABEL                }
+  , { "dataReference",       SED_SELECTOR_DATA_REFERENCE       }
+  , { "xDataReference",      SED_SELECTOR_X_DATA_REFERENCE     }
+  , { "yDataReference",      SED_SELECTOR_Y_DATA_REFERENCE     }
+  , { "zDataReference",      SED_SELECTOR_Z_DATA_REFERENCE     }
+  , { "logX",                SED_SELECTOR_LOG_X                }
+  , { "logY",                SED_SELECTOR_LOG_Y                }
+  , { "logZ",                SED_SELECTOR_LOG_Z                }
+  , { "kisaoID",             SED_SELECTOR_KISAO_ID             }
+  , { "value",               SED_SELECTOR_VALUE                }
+  , { "initialTime",         SED_SELECTOR_INITIAL_TIME         }
+  , { "outputStartTime",     SED_SELECTOR_OUTPUT_START_TIME    }
+  , { "outputEndTime",       SED_SELECTOR_OUTPUT_END_TIME      }
+  , { "numberOfPoints",      SED_SELECTOR_NUMBER_OF_POINTS     }
+  , { NULL,                  -1                                }
+};
+
+
+/*
+ * Returns the code of name in table, or the code its end has.
+ */
+static int
+findName (const SedSelectorName* table, const std::string& name)
+{
+  for (; table->name != NULL; ++table)
+  {
+    if (name == table->name) break;
+  }
+  return table->code;
+}
+
+
+/*
+ * Sets value to text if isSet, and returns isSet.
+ */
+static bool
+assign (std::string& value, bool isSet, const std::string& text)
+{
+  if (isSet) value = text;
+  return isSet;
+}
+
+
+static bool
+assign (std::string& value, bool isSet, double number)
+{
+  if (!isSet) return false;
+
+  char buffer[SedNumber::BUFFER_SIZE];
+  value.assign(buffer, SedNumber::format(number, buffer));
+  return true;
+}
+
+
+static bool
+assign (std::string& value, bool isSet, int number)
+{
+  if (!isSet) return false;
+
+  char buffer[SedNumber::BUFFER_SIZE];
+  value.assign(buffer, SedNumber::format(number, buffer));
+  return true;
+}
+
+
+static bool
+assign (std::string& value, bool isSet, bool flag)
+{
+  if (isSet) value = flag ? "true" : "false";
+  return isSet;
+}
+
+
+/*
+ * Sets value to the given attribute of element, and returns true if the
+ * element has it and it is set.
+ */
+static bool
+getAttribute (const SedBase* element, int attribute, std::string& value)
+{
+  const int type = element->getTypeCode();
+
+  // the classes most attributes belong to, or NULL
+  const SedCurve* curve =
+    SedElementIterator::isOfType(type, SEDML_OUTPUT_CURVE)
+      ? static_cast<const SedCurve*>(element) : NULL;
+  const SedVariable* variable = (type == SEDML_VARIABLE)
+      ? static_cast<const SedVariable*>(element) : NULL;
+  const SedTask* task = (type == SEDML_TASK)
+      ? static_cast<const SedTask*>(element) : NULL;
+  const SedModel* model = (type == SEDML_MODEL)
+      ? static_cast<const SedModel*>(element) : NULL;
+  const SedDataSet* dataSet = (type == SEDML_OUTPUT_DATASET)
+      ? static_cast<const SedDataSet*>(element) : NULL;
+  const SedUniformTimeCourse* course =
+    (type == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+      ? static_cast<const SedUniformTimeCourse*>(element) : NULL;
+
+  switch (attribute)
+  {
+  case SED_SELECTOR_ID:
+    return assign(value, element->isSetId(), element->getId());
+  case SED_SELECTOR_NAME:
+    return assign(value, element->isSetName(), element->getName());
+  case SED_SELECTOR_METAID:
+    return assign(value, element->isSetMetaId(), element->getMetaId());
+
+  case SED_SELECTOR_TARGET:
+    if (variable != NULL)
+      return assign(value, variable->isSetTarget(), variable->getTarget());
+    if (SedElementIterator::isOfType(type, SEDML_CHANGE))
+    {
+      const SedChange* change = static_cast<const SedChange*>(element);
+      return assign(value, change->isSetTarget(), change->getTarget());
+    }
+    return false;
+  case SED_SELECTOR_SYMBOL:
+    return variable != NULL
+        && assign(value, variable->isSetSymbol(), variable->getSymbol());
+  case SED_SELECTOR_TASK_REFERENCE:
+    return variable != NULL
+        && assign(value, variable->isSetTaskReference(),
+                  variable->getTaskReference());
+  case SED_SELECTOR_MODEL_REFERENCE:
+    if (variable != NULL)
+      return assign(value, variable->isSetModelReference(),
+                    variable->getModelReference());
+    return task != NULL
+        && assign(value, task->isSetModelReference(),
+                  task->getModelReference());
+  case SED_SELECTOR_SIMULATION_REFERENCE:
+    return task != NULL
+        && assign(value, task->isSetSimulationReference(),
+                  task->getSimulationReference());
+
+  case SED_SELECTOR_LANGUAGE:
+    return model != NULL
+        && assign(value, model->isSetLanguage(), model->getLanguage());
+  case SED_SELECTOR_SOURCE:
+    return model != NULL
+        && assign(value, model->isSetSource(), model->getSource());
+
+  case SED_SELECTOR_LABEL:
+    return dataSet != NULL
+        && assign(value, dataSet->isSetLabel(), dataSet->getLabel());
+  case SED_SELECTOR_DATA_REFERENCE:
+    return dataSet != NULL
+        && assign(value, dataSet->isSetDataReference(),
+                  dataSet->getDataReference());
+
+  case SED_SELECTOR_X_DATA_REFERENCE:
+    return curve != NULL
+        && assign(value, curve->isSetXDataReference(),
+                  curve->getXDataReference());
+  case SED_SELECTOR_Y_DATA_REFERENCE:
+    return curve != NULL
+        && assign(value, curve->isSetYDataReference(),
+                  curve->getYDataReference());
+  case SED_SELECTOR_LOG_X:
+    return curve != NULL
+        && assign(value, curve->isSetLogX(), curve->getLogX());
+  case SED_SELECTOR_LOG_Y:
+    return curve != NULL
+        && assign(value, curve->isSetLogY(), curve->getLogY());
+  case SED_SELECTOR_Z_DATA_REFERENCE:
+  case SED_SELECTOR_LOG_Z:
+    if (type != SEDML_OUTPUT_SURFACE) return false;
+    {
+      const SedSurface* surface = static_cast<const SedSurface*>(element);
+      if (attribute == SED_SELECTOR_LOG_Z)
+        return assign(value, surface->isSetLogZ(), surface->getLogZ());
+      return assign(value, surface->isSetZDataReference(),
+                    surface->getZDataReference());
+    }
+
+  case SED_SELECTOR_KISAO_ID:
+    if (type != SEDML_SIMULATION_ALGORITHM) return false;
+    {
+      const SedAlgorithm* algorithm = static_cast<const SedAlgorithm*>(element);
+      return assign(value, algorithm->isSetKisaoID(), algorithm->getKisaoID());
+    }
+  case SED_SELECTOR_VALUE:
+    if (type != SEDML_PARAMETER) return false;
+    {
+      const SedParameter* parameter = static_cast<const SedParameter*>(element);
+      return assign(value, parameter->isSetValue(), parameter->getValue());
+    }
+
+  case SED_SELECTOR_INITIAL_TIME:
+    return course != NULL
+        && assign(value, course->isSetInitialTime(), course->getInitialTime());
+  case SED_SELECTOR_OUTPUT_START_TIME:
+    return course != NULL
+        && assign(value, course->isSetOutputStartTime(),
+                  course->getOutputStartTime());
+  case SED_SELECTOR_OUTPUT_END_TIME:
+    return course != NULL
+        && assign(value, course->isSetOutputEndTime(),
+                  course->getOutputEndTime());
+  case SED_SELECTOR_NUMBER_OF_POINTS:
+    return course != NULL
+        && assign(value, course->isSetNumberOfPoints(),
+                  course->getNumberOfPoints());
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * Returns the object whose child element is parent, leaving out a
+ * SedListOf between them.
+ */
+static const SedBase*
+getParent (const SedBase* element)
+{
+  const SedBase* parent = element->getParentSedObject();
+  if (parent != NULL && parent->getTypeCode() == SEDML_LIST_OF)
+  {
+    parent = parent->getParentSedObject();
+  }
+  return parent;
+}
+
+
+/*
+ * Adds element to found unless it is NULL or already in seen.
+ */
+static void
+addFound (const SedBase* element, std::vector<const SedBase*>& found,
+          std::set<const SedBase*>& seen)
+{
+  if (element != NULL && seen.insert(element).second)
+  {
+    found.push_back(element);
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedSelector that selects nothing.
+ */
+SedSelector::SedSelector ()
+  : mSelector ()
+  , mPaths ()
+  , mCompiled (false)
+  , mErrorPosition (0)
+{
+}
+
+
+/*
+ * Creates a new SedSelector and compiles selector.
+ */
+SedSelector::SedSelector (const std::string& selector)
+  : mSelector ()
+  , mPaths ()
+  , mCompiled (false)
+  , mErrorPosition (0)
+{
+  compile(selector);
+}
+
+
+/*
+ * Destroys this SedSelector.
+ */
+SedSelector::~SedSelector ()
+{
+}
+
+
+/*
+ * Parses selector into the plan select() runs.
+ */
+int
+SedSelector::compile (const std::string& selector)
+{
+  mSelector = selector;
+  mPaths.clear();
+  mCompiled = false;
+
+  size_t pos = 0;
+  while (true)
+  {
+    Path path;
+    if (!parsePath(pos, path))
+    {
+      mPaths.clear();
+      mErrorPosition = pos;
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+    mPaths.push_back(path);
+
+    if (pos == mSelector.size()) break;
+    ++pos;   // the comma parsePath() stopped at
+  }
+
+  mCompiled      = true;
+  mErrorPosition = mSelector.size();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if the last compile() succeeded.
+ */
+bool
+SedSelector::isCompiled () const
+{
+  return mCompiled;
+}
+
+
+/*
+ * Returns the selector compiled last.
+ */
+const std::string&
+SedSelector::getSelector () const
+{
+  return mSelector;
+}
+
+
+/*
+ * Returns the position at which the last compile() failed.
+ */
+size_t
+SedSelector::getErrorPosition () const
+{
+  return mErrorPosition;
+}
+
+
+/*
+ * Sets matches to the objects at or below root that the selector matches.
+ */
+int
+SedSelector::select (const SedBase* root,
+                     std::vector<const SedBase*>& matches) const
+{
+  matches.clear();
+  if (root == NULL) return LIBSEDML_INVALID_OBJECT;
+  if (!mCompiled) return LIBSEDML_OPERATION_FAILED;
+
+  std::set<const SedBase*> selected;
+  std::vector<const SedBase*> context;
+  std::vector<const SedBase*> found;
+  std::set<const SedBase*> seen;
+
+  for (size_t i = 0; i < mPaths.size(); ++i)
+  {
+    // every step moves the objects found so far on to those it matches
+    context.assign(1, root);
+    for (size_t j = 0; j < mPaths[i].size() && !context.empty(); ++j)
+    {
+      found.clear();
+      seen.clear();
+      for (size_t k = 0; k < context.size(); ++k)
+      {
+        selectStep(context[k], mPaths[i][j], found, seen);
+      }
+      context.swap(found);
+    }
+
+    for (size_t k = 0; k < context.size(); ++k)
+    {
+      addFound(context[k], matches, selected);
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the first object at or below root that the selector matches.
+ */
+const SedBase*
+SedSelector::selectFirst (const SedBase* root) const
+{
+  std::vector<const SedBase*> matches;
+  select(root, matches);
+  return matches.empty() ? NULL : matches[0];
+}
+
+
+/*
+ * Returns true if the selector matches element.
+ */
+bool
+SedSelector::matches (const SedBase* element) const
+{
+  if (element == NULL) return false;
+
+  const SedBase* root = element;
+  while (root->getParentSedObject() != NULL)
+  {
+    root = root->getParentSedObject();
+  }
+
+  std::vector<const SedBase*> found;
+  select(root, found);
+  for (size_t i = 0; i < found.size(); ++i)
+  {
+    if (found[i] == element) return true;
+  }
+  return false;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Parses the steps of a selector up to a comma or the end, and returns
+ * false if they are not valid.
+ */
+bool
+SedSelector::parsePath (size_t& pos, Path& path)
+{
+  skipSpace(pos);
+
+  int axis = SELF_OR_DESCENDANT;
+  while (true)
+  {
+    Step step;
+    step.axis = axis;
+    if (!parseStep(pos, step)) return false;
+    path.push_back(step);
+
+    const size_t before = pos;
+    skipSpace(pos);
+    if (pos == mSelector.size() || mSelector[pos] == ',') return true;
+
+    if (mSelector[pos] == '>' || mSelector[pos] == '<')
+    {
+      axis = (mSelector[pos] == '>') ? CHILD : PARENT;
+      ++pos;
+      skipSpace(pos);
+    }
+    else if (pos > before)
+    {
+      axis = DESCENDANT;
+    }
+    else
+    {
+      return false;
+    }
+  }
+}
+
+
+/*
+ * Parses a type and its predicates.
+ */
+bool
+SedSelector::parseStep (size_t& pos, Step& step)
+{
+  step.any      = false;
+  step.typeCode = SEDML_UNKNOWN;
+
+  if (pos < mSelector.size() && mSelector[pos] == '*')
+  {
+    step.any = true;
+    ++pos;
+  }
+  else
+  {
+    const size_t start = pos;
+    std::string name;
+    if (!parseName(pos, name)) return false;
+
+    step.typeCode = findName(SED_SELECTOR_TYPES, name);
+    if (step.typeCode == SEDML_UNKNOWN)
+    {
+      pos = start;
+      return false;
+    }
+  }
+
+  while (pos < mSelector.size() && mSelector[pos] == '[')
+  {
+    Predicate predicate;
+    if (!parsePredicate(pos, predicate)) return false;
+
+    // an id is looked up in the index rather than tested on every object,
+    // unless it can be local to the object holding it
+    if (step.axis == SELF_OR_DESCENDANT && step.id.empty() && !step.any
+        && step.typeCode != SEDML_VARIABLE && step.typeCode != SEDML_PARAMETER
+        && predicate.attribute == SED_SELECTOR_ID && predicate.op == EQUALS
+        && !predicate.value.empty())
+    {
+      step.id = predicate.value;
+      continue;
+    }
+
+    step.predicates.push_back(predicate);
+  }
+
+  return true;
+}
+
+
+/*
+ * Parses a predicate in brackets.
+ */
+bool
+SedSelector::parsePredicate (size_t& pos, Predicate& predicate)
+{
+  ++pos;
+  skipSpace(pos);
+
+  const size_t start = pos;
+  std::string name;
+  if (!parseName(pos, name)) return false;
+
+  predicate.attribute = findName(SED_SELECTOR_ATTRIBUTES, name);
+  if (predicate.attribute < 0)
+  {
+    pos = start;
+    return false;
+  }
+
+  skipSpace(pos);
+  if (pos < mSelector.size() && mSelector[pos] == ']')
+  {
+    predicate.op = IS_SET;
+    ++pos;
+    return true;
+  }
+
+  if (pos >= mSelector.size()) return false;
+
+  switch (mSelector[pos])
+  {
+  case '=': predicate.op = EQUALS;      break;
+  case '!': predicate.op = NOT_EQUALS;  break;
+  case '^': predicate.op = STARTS_WITH; break;
+  case '$': predicate.op = ENDS_WITH;   break;
+  case '*': predicate.op = CONTAINS;    break;
+  default:
+    return false;
+  }
+
+  if (predicate.op != EQUALS)
+  {
+    ++pos;
+    if (pos >= mSelector.size() || mSelector[pos] != '=') return false;
+  }
+  ++pos;
+
+  skipSpace(pos);
+  if (!parseValue(pos, predicate.value)) return false;
+
+  skipSpace(pos);
+  if (pos >= mSelector.size() || mSelector[pos] != ']') return false;
+  ++pos;
+  return true;
+}
+
+
+/*
+ * Parses a name of letters and digits starting with a letter.
+ */
+bool
+SedSelector::parseName (size_t& pos, std::string& name)
+{
+  const size_t start = pos;
+  while (pos < mSelector.size()
+         && (isalpha((unsigned char)mSelector[pos])
+             || (pos > start && isdigit((unsigned char)mSelector[pos]))))
+  {
+    ++pos;
+  }
+
+  name = mSelector.substr(start, pos - start);
+  return !name.empty();
+}
+
+
+/*
+ * Parses a quoted value, or one that runs up to white space or a bracket.
+ */
+bool
+SedSelector::parseValue (size_t& pos, std::string& value)
+{
+  if (pos >= mSelector.size()) return false;
+
+  const char quote = mSelector[pos];
+  if (quote == '"' || quote == '\'')
+  {
+    const size_t end = mSelector.find(quote, pos + 1);
+    if (end == std::string::npos) return false;
+
+    value = mSelector.substr(pos + 1, end - pos - 1);
+    pos = end + 1;
+    return true;
+  }
+
+  const size_t start = pos;
+  while (pos < mSelector.size() && mSelector[pos] != ']'
+         && !isspace((unsigned char)mSelector[pos]))
+  {
+    ++pos;
+  }
+
+  value = mSelector.substr(start, pos - start);
+  return !value.empty();
+}
+
+
+void
+SedSelector::skipSpace (size_t& pos) const
+{
+  while (pos < mSelector.size() && isspace((unsigned char)mSelector[pos]))
+  {
+    ++pos;
+  }
+}
+
+
+/*
+ * Returns true if element is of the type of step and has all its
+ * predicates.
+ */
+bool
+SedSelector::isMatch (const SedBase* element, const Step& step) const
+{
+  const int type = element->getTypeCode();
+  if (step.any ? type == SEDML_LIST_OF
+               : !SedElementIterator::isOfType(type, step.typeCode))
+    return false;
+
+  if (!step.id.empty() && (!element->isSetId() || element->getId() != step.id))
+    return false;
+
+  std::string value;
+  for (size_t i = 0; i < step.predicates.size(); ++i)
+  {
+    const Predicate& predicate = step.predicates[i];
+    if (!getAttribute(element, predicate.attribute, value)) return false;
+
+    const std::string& wanted = predicate.value;
+    bool result = true;
+    switch (predicate.op)
+    {
+    case EQUALS:
+      result = value == wanted;
+      break;
+    case NOT_EQUALS:
+      result = value != wanted;
+      break;
+    case STARTS_WITH:
+      result = value.compare(0, wanted.size(), wanted) == 0;
+      break;
+    case ENDS_WITH:
+      result = value.size() >= wanted.size()
+            && value.compare(value.size() - wanted.size(), wanted.size(),
+                             wanted) == 0;
+      break;
+    case CONTAINS:
+      result = value.find(wanted) != std::string::npos;
+      break;
+    default:
+      break;
+    }
+
+    if (!result) return false;
+  }
+
+  return true;
+}
+
+
+/*
+ * Adds the objects step moves to from context, and that it matches, to
+ * found.
+ */
+void
+SedSelector::selectStep (const SedBase* context, const Step& step,
+                         std::vector<const SedBase*>& found,
+                         std::set<const SedBase*>& seen) const
+{
+  switch (step.axis)
+  {
+  case PARENT:
+  {
+    const SedBase* parent = getParent(context);
+    if (parent != NULL && isMatch(parent, step)) addFound(parent, found, seen);
+    return;
+  }
+
+  case CHILD:
+    for (unsigned int i = 0; i < context->getNumChildElements(); ++i)
+    {
+      const SedBase* child = context->getChildElement(i);
+      if (child == NULL) continue;
+
+      if (child->getTypeCode() != SEDML_LIST_OF)
+      {
+        if (isMatch(child, step)) addFound(child, found, seen);
+        continue;
+      }
+
+      for (unsigned int j = 0; j < child->getNumChildElements(); ++j)
+      {
+        const SedBase* item = child->getChildElement(j);
+        if (item != NULL && isMatch(item, step)) addFound(item, found, seen);
+      }
+    }
+    return;
+
+  default:
+    break;
+  }
+
+  if (!step.id.empty())
+  {
+    // the id index of the document answers without a walk; the object
+    // selected from itself is not in it
+    const SedBase* element = context;
+    if (!element->isSetId() || element->getId() != step.id)
+    {
+      element = const_cast<SedBase*>(context)->getElementBySId(step.id);
+    }
+
+    if (element != NULL && isMatch(element, step))
+    {
+      addFound(element, found, seen);
+    }
+    return;
+  }
+
+  SedElementIterator it = context->beginOfType(step.any ? SEDML_UNKNOWN
+                                                        : step.typeCode);
+  for (; it != context->end(); ++it)
+  {
+    if (&*it == context && step.axis == DESCENDANT) continue;
+    if (isMatch(&*it, step)) addFound(&*it, found, seen);
+  }
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedSelector compiled from selector and returns it.
+ */
+LIBSEDML_EXTERN
+SedSelector_t *
+SedSelector_create (const char *selector)
+{
+  if (selector == NULL) return NULL;
+
+  SedSelector* result = new (nothrow) SedSelector(selector);
+  if (result != NULL && !result->isCompiled())
+  {
+    delete result;
+    result = NULL;
+  }
+  return result;
+}
+
+
+/**
+ * Frees the given SedSelector.
+ */
+LIBSEDML_EXTERN
+void
+SedSelector_free (SedSelector_t *ss)
+{
+  delete ss;
+}
+
+
+/**
+ * Stores up to size of the objects the given SedSelector matches.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSelector_select (const SedSelector_t *ss, const SedBase_t *root,
+                    const SedBase_t **matches, unsigned int size)
+{
+  if (ss == NULL) return 0;
+
+  std::vector<const SedBase*> found;
+  ss->select(root, found);
+
+  for (unsigned int i = 0; matches != NULL && i < size && i < found.size(); ++i)
+  {
+    matches[i] = found[i];
+  }
+  return (unsigned int)found.size();
+}
+
+
+/**
+ * Returns the first object the given SedSelector matches.
+ */
+LIBSEDML_EXTERN
+const SedBase_t *
+SedSelector_selectFirst (const SedSelector_t *ss, const SedBase_t *root)
+{
+  return (ss != NULL) ? ss->selectFirst(root) : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,304 @@
+/**
+ * @file    SedSelector.h
+ * @brief   Compiled queries selecting the objects of a SED-ML document
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSelector
+ * @ingroup Core
+ * @brief Finds the objects of a document that match a selector.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A selector names the objects to find the way a CSS selector names the
+ * elements of a page:
+ *
+ * @code{.cpp}
+SedSelector variables("variable[taskReference=task1][target*=\"'S1'\"]");
+SedSelector curves("curve[xDataReference=dg1], curve[yDataReference=dg1]");
+SedSelector plots("curve[yDataReference=dg1] < plot2D");
+@endcode
+ *
+ * A step is the element name of a SED-ML object (@c variable, @c task,
+ * @c plot2D, ...), the name of an abstract class (@c change, @c output,
+ * @c simulation), matching the objects of every class derived from it, or
+ * @c * for any object.  It is followed by any number of predicates on the
+ * attributes of the object, all of which must hold:
+ *
+ * @li <code>[a]</code>: the attribute @em a is set;
+ * @li <code>[a=v]</code> and <code>[a!=v]</code>: it is set and is, or is
+ * not, @em v;
+ * @li <code>[a^=v]</code>, <code>[a$=v]</code> and <code>[a*=v]</code>: it
+ * is set and starts with, ends with or contains @em v.
+ *
+ * Values can be quoted with single or double quotes; numbers and booleans
+ * compare as they would be written to a file.  The attributes are those of
+ * SED-ML: @c id, @c name, @c metaid, @c target, @c symbol,
+ * @c taskReference, @c modelReference, @c simulationReference,
+ * @c language, @c source, @c label, @c dataReference, @c xDataReference,
+ * @c yDataReference, @c zDataReference, @c logX, @c logY, @c logZ,
+ * @c kisaoID, @c value, @c initialTime, @c outputStartTime,
+ * @c outputEndTime and @c numberOfPoints.  An object that has no such
+ * attribute matches no predicate on it.
+ *
+ * The first step matches the object selected from or any object below it.
+ * Every further step moves from the objects matched so far: after white
+ * space to the objects below them, after @c > to their children and after
+ * @c < to their parents, the SedListOf objects between them left out.
+ * Selectors separated by commas select the objects any of them matches.
+ *
+ * compile() parses a selector once into a plan, which select() then runs
+ * on any number of documents.  A first step with an <code>[id=v]</code>
+ * predicate looks @em v up in the id index of the document (see
+ * SedDocument::getElementBySId()) rather than walking it, unless it names
+ * variables or parameters, whose ids can be local to their parent.  Other
+ * steps walk only the parts of the document that can hold the objects
+ * they name (see SedBase::beginOfType()).  The objects selected are
+ * listed once each, in the order they were found.
+ */
+
+#ifndef SedSelector_h
+#define SedSelector_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <set>
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+
+
+class LIBSEDML_EXTERN SedSelector
+{
+public:
+
+  /**
+   * Creates a new SedSelector that selects nothing until compile() is
+   * called.
+   */
+  SedSelector ();
+
+
+  /**
+   * Creates a new SedSelector and compiles @p selector; isCompiled() says
+   * whether it could be.
+   */
+  explicit SedSelector (const std::string& selector);
+
+
+  /**
+   * Destroys this SedSelector.
+   */
+  virtual ~SedSelector ();
+
+
+  /**
+   * Parses @p selector into the plan select() runs, replacing the one
+   * compiled before.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p selector is not a valid selector, in which case
+   * getErrorPosition() says where parsing stopped
+   */
+  int compile (const std::string& selector);
+
+
+  /**
+   * @return @c true if the last compile() succeeded.
+   */
+  bool isCompiled () const;
+
+
+  /**
+   * @return the selector compiled last.
+   */
+  const std::string& getSelector () const;
+
+
+  /**
+   * @return the position in the selector at which the last compile()
+   * failed, or the length of the selector if it succeeded.
+   */
+  size_t getErrorPosition () const;
+
+
+  /**
+   * Sets @p matches to the objects at or below @p root that the selector
+   * matches.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p root is @c NULL
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if no selector has been compiled
+   */
+  int select (const SedBase* root,
+              std::vector<const SedBase*>& matches) const;
+
+
+  /**
+   * @return the first object at or below @p root that the selector
+   * matches, or @c NULL if there is none.
+   */
+  const SedBase* selectFirst (const SedBase* root) const;
+
+
+  /**
+   * @return @c true if the selector matches @p element, that is, if
+   * selecting from the root of its document finds it.
+   */
+  bool matches (const SedBase* element) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  enum Axis
+  {
+      SELF_OR_DESCENDANT
+    , DESCENDANT
+    , CHILD
+    , PARENT
+  };
+
+  enum Operator
+  {
+      IS_SET
+    , EQUALS
+    , NOT_EQUALS
+    , STARTS_WITH
+    , ENDS_WITH
+    , CONTAINS
+  };
+
+  struct Predicate
+  {
+    int          attribute;
+    int          op;
+    std::string  value;
+  };
+
+  struct Step
+  {
+    int                     axis;
+    int                     typeCode;
+    bool                    any;
+    std::vector<Predicate>  predicates;
+    std::string             id;
+  };
+
+  typedef std::vector<Step> Path;
+
+  bool parsePath (size_t& pos, Path& path);
+
+  bool parseStep (size_t& pos, Step& step);
+
+  bool parsePredicate (size_t& pos, Predicate& predicate);
+
+  bool parseName (size_t& pos, std::string& name);
+
+  bool parseValue (size_t& pos, std::string& value);
+
+  void skipSpace (size_t& pos) const;
+
+  bool isMatch (const SedBase* element, const Step& step) const;
+
+  void selectStep (const SedBase* context, const Step& step,
+                   std::vector<const SedBase*>& found,
+                   std::set<const SedBase*>& seen) const;
+
+
+  std::string        mSelector;
+  std::vector<Path>  mPaths;
+  bool               mCompiled;
+  size_t             mErrorPosition;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedSelector compiled from @p selector and returns it, or
+ * @c NULL if @p selector is not a valid selector.
+ */
+LIBSEDML_EXTERN
+SedSelector_t *
+SedSelector_create (const char *selector);
+
+
+/**
+ * Frees the given SedSelector.
+ */
+LIBSEDML_EXTERN
+void
+SedSelector_free (SedSelector_t *ss);
+
+
+/**
+ * Stores up to @p size of the objects at or below @p root that the given
+ * SedSelector matches in @p matches, and returns how many it matches.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSelector_select (const SedSelector_t *ss, const SedBase_t *root,
+                    const SedBase_t **matches, unsigned int size);
+
+
+/**
+ * Returns the first object at or below @p root that the given SedSelector
+ * matches, or @c NULL if there is none.
+ */
+LIBSEDML_EXTERN
+const SedBase_t *
+SedSelector_selectFirst (const SedSelector_t *ss, const SedBase_t *root);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedSelector_h */
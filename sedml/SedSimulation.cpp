@@ -180,7 +180,8 @@ SedSimulation::getAlgorithm() const
 SedAlgorithm*
 SedSimulation::createAlgorithm()
 {
-	mAlgorithm = new SedAlgorithm();
+	if (isFrozen()) return NULL;
+	mAlgorithm = new (getArena()) SedAlgorithm();
 	return mAlgorithm;
 }
 
@@ -221,7 +222,11 @@ SedSimulation::isSetAlgorithm() const
 int
 SedSimulation::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -231,6 +236,8 @@ SedSimulation::setId(const std::string& id)
 int
 SedSimulation::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -249,19 +256,19 @@ SedSimulation::setName(const std::string& name)
 int
 SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (mAlgorithm == algorithm)
 	{
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 	else if (algorithm == NULL)
 	{
-		delete mAlgorithm;
-		mAlgorithm = NULL;
-		return LIBSEDML_OPERATION_SUCCESS;
+		return unsetAlgorithm();
 	}
 	else
 	{
-		delete mAlgorithm;
+		unsetAlgorithm();
 		mAlgorithm = (algorithm != NULL) ?
 			static_cast<SedAlgorithm*>(algorithm->clone()) : NULL;
 		if (mAlgorithm != NULL)
@@ -279,7 +286,10 @@ SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 int
 SedSimulation::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -298,6 +308,8 @@ SedSimulation::unsetId()
 int
 SedSimulation::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -317,20 +329,28 @@ SedSimulation::unsetName()
 int
 SedSimulation::unsetAlgorithm()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	delete mAlgorithm;
 	mAlgorithm = NULL;
+
+	SedDocument* doc = getRootDocument();
+	if (doc != NULL) doc->invalidateElementIndex();
+
 	return LIBSEDML_OPERATION_SUCCESS;
 }
 
 
+static const std::string sSedSimulationName("simulation");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedSimulation::getElementName () const
 {
-	static const string name = "simulation";
-	return name;
+	return sSedSimulationName;
 }
 
 
@@ -344,11 +364,9 @@ SedSimulation::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
 	if (name == "algorithm")
 	{
-		mAlgorithm= new SedAlgorithm();
+		mAlgorithm= new (getArena()) SedAlgorithm();
 		object = mAlgorithm;
 	}
 
@@ -367,6 +385,41 @@ SedSimulation::connectToChild ()
 }
 
 
+/*
+ * Returns a List of all child SedBase objects, including those nested to
+ * an arbitrary depth.
+ */
+List*
+SedSimulation::getAllElements()
+{
+	List* ret = new List();
+
+	addAllElements(ret, mAlgorithm);
+
+	return ret;
+}
+
+
+/*
+ * Returns the number of elements directly contained in this Simulation.
+ */
+unsigned int
+SedSimulation::getNumChildElements () const
+{
+	return (mAlgorithm != NULL) ? 1 : 0;
+}
+
+
+/*
+ * Returns the nth element directly contained in this Simulation.
+ */
+const SedBase*
+SedSimulation::getChildElement (unsigned int n) const
+{
+	return (n == 0) ? mAlgorithm : NULL;
+}
+
+
 /*
  * Returns the libSEDML type code for this SEDML object.
  */
@@ -426,13 +479,12 @@ SedSimulation::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedSimulation::accept (SedVisitor& v) const
+SedSimulation::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -485,10 +537,19 @@ SedSimulation::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u }
+	};
+	int index[2];
+	findAttributes(attributes, names, 2, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -507,7 +568,7 @@ SedSimulation::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -525,6 +586,10 @@ SedSimulation::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -535,11 +600,33 @@ SedSimulation::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		stream.writeAttribute(sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		stream.writeAttribute(sNameAttribute, prefix, mName);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedSimulation::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		addAttribute(attributes, sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		addAttribute(attributes, sNameAttribute, prefix, mName);
 
 }
 
@@ -615,10 +702,7 @@ SedListOfSimulations::get(const std::string& sid)
 const SedSimulation*
 SedListOfSimulations::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedSimulation>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedSimulation*> (*result);
+	return static_cast <const SedSimulation*> (getItemById(sid));
 }
 
 
@@ -643,6 +727,17 @@ SedListOfSimulations::addSimulation(const SedSimulation* ss)
 }
 
 
+/*
+ * Adds the given SedSimulation to this SedListOfSimulations, which takes ownership of it.
+ */
+int
+SedListOfSimulations::addSimulationAndOwn(SedSimulation* ss)
+{
+	if(ss == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(ss);
+}
+
+
 /**
  * Get the number of SedSimulation objects in this SedListOfSimulations.
  *
@@ -665,7 +760,8 @@ SedListOfSimulations::getNumSimulations() const
 SedUniformTimeCourse* 
 SedListOfSimulations::createUniformTimeCourse()
 {
-	SedUniformTimeCourse *temp = new SedUniformTimeCourse();
+	if (isFrozen()) return NULL;
+	SedUniformTimeCourse *temp = new (getArena()) SedUniformTimeCourse();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -686,19 +782,11 @@ SedListOfSimulations::remove(unsigned int n)
 SedSimulation*
 SedListOfSimulations::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedSimulation>(sid) );
+	return static_cast <SedSimulation*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedSimulation*> (item);
-}
+static const std::string sSedListOfSimulationsName("listOfSimulations");
 
 
 /*
@@ -707,8 +795,7 @@ SedListOfSimulations::remove(const std::string& sid)
 const std::string&
 SedListOfSimulations::getElementName () const
 {
-	static const string name = "listOfSimulations";
-	return name;
+	return sSedListOfSimulationsName;
 }
 
 
@@ -745,7 +832,7 @@ SedListOfSimulations::createObject(XMLInputStream& stream)
 
 	if (name == "uniformTimeCourse")
 	{
-		object = new SedUniformTimeCourse(getSedNamespaces());
+		object = new (getArena()) SedUniformTimeCourse(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -770,7 +857,8 @@ SedListOfSimulations::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -838,6 +926,20 @@ SedSimulation_getId(SedSimulation_t * ss)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedSimulation_getIdView(const SedSimulation_t * ss)
+{
+	if (ss == NULL)
+		return NULL;
+
+	return ss->getId().empty() ? NULL : ss->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -852,6 +954,20 @@ SedSimulation_getName(SedSimulation_t * ss)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedSimulation_getNameView(const SedSimulation_t * ss)
+{
+	if (ss == NULL)
+		return NULL;
+
+	return ss->getName().empty() ? NULL : ss->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -62,8 +62,8 @@ class LIBSEDML_EXTERN SedSimulation : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	SedAlgorithm*      mAlgorithm;
 
 
@@ -267,6 +267,33 @@ public:
 	virtual int unsetAlgorithm();
 
 
+	/**
+	 * Returns a List of all child SedBase objects, including those nested to
+	 * an arbitrary depth.
+	 *
+	 * @return a List of pointers to all child objects.
+	 */
+	virtual List* getAllElements();
+
+
+	/**
+	 * Returns the number of elements directly contained in this SedSimulation.
+	 *
+	 * @return the number of child elements.
+	 */
+	virtual unsigned int getNumChildElements () const;
+
+
+	/**
+	 * Returns the <i>n</i>th element directly contained in this SedSimulation.
+	 *
+	 * @param n the index of the child, counted from 0.
+	 *
+	 * @return the child, or @c NULL if @p n is out of range.
+	 */
+	virtual const SedBase* getChildElement (unsigned int n) const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedSimulation, is
 	 * always @c "sedSimulation".
@@ -350,9 +377,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -424,6 +451,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -538,6 +572,25 @@ public:
 	int addSimulation(const SedSimulation* s);
 
 
+	/**
+	 * Adds the given "SedSimulation" to this SedListOfSimulations without copying it; this
+	 * SedListOfSimulations takes ownership of @p s and will delete it.
+	 *
+	 * @param s the SedSimulation object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p s is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addSimulation(const SedSimulation* s)
+	 */
+	int addSimulationAndOwn(SedSimulation* s);
+
+
 	/**
 	 * Get the number of Simulation objects in this SedListOfSimulations.
 	 *
@@ -720,11 +773,21 @@ char *
 SedSimulation_getId(SedSimulation_t * ss);
 
 
+LIBSEDML_EXTERN
+const char *
+SedSimulation_getIdView(const SedSimulation_t * ss);
+
+
 LIBSEDML_EXTERN
 char *
 SedSimulation_getName(SedSimulation_t * ss);
 
 
+LIBSEDML_EXTERN
+const char *
+SedSimulation_getNameView(const SedSimulation_t * ss);
+
+
 LIBSEDML_EXTERN
 SedAlgorithm_t*
 SedSimulation_getAlgorithm(SedSimulation_t * ss);
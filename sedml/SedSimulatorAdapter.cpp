@@ -0,0 +1,547 @@
+/**
+ * @file    SedSimulatorAdapter.cpp
+ * @brief   Simulators that push their output into SedResults in chunks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSimulatorAdapter.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstring>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of time points columns without an expected length start
+ * with.
+ */
+static const size_t SED_CHUNK_MIN_CAPACITY = 64;
+
+
+/*
+ * A simulator adapter calling a C function, used by
+ * SedExecutor_setSimulatorAdapter().
+ */
+class SedCallbackSimulatorAdapter : public SedSimulatorAdapter
+{
+public:
+
+  SedCallbackSimulatorAdapter (SedSimulatorAdapter_runFunc func,
+                               void* userData)
+    : mFunc (func)
+    , mUserData (userData)
+  {
+  }
+
+  virtual int run (const SedTask* task, const SedModel* model,
+                   const SedSimulation* simulation,
+                   const SedAlgorithm* algorithm,
+                   SedChunkWriter& writer)
+  {
+    return mFunc(task, model, simulation, algorithm, &writer, mUserData);
+  }
+
+private:
+
+  SedSimulatorAdapter_runFunc mFunc;
+  void*                       mUserData;
+};
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedChunkListener.
+ */
+SedChunkListener::~SedChunkListener ()
+{
+}
+
+
+/*
+ * Creates a new SedChunkWriter binding a column of results to each of
+ * variables.
+ */
+SedChunkWriter::SedChunkWriter (SedResults& results,
+                                const std::vector<const SedVariable*>& variables,
+                                size_t numPoints)
+  : mResults (results)
+  , mVariables (variables)
+  , mColumns (variables.size(), (double*)NULL)
+  , mNumPoints (0)
+  , mNumWritten (0)
+  , mCapacity (numPoints)
+  , mBound (true)
+  , mListener (NULL)
+  , mKeepPoints (true)
+{
+  for (unsigned int n = 0; n < mVariables.size(); ++n)
+  {
+    mColumns[n] = mResults.addColumn(mVariables[n]->getId(), mCapacity);
+    if (mColumns[n] == NULL) mBound = false;
+  }
+}
+
+
+/*
+ * Returns the number of variables.
+ */
+unsigned int
+SedChunkWriter::getNumVariables () const
+{
+  return (unsigned int)mVariables.size();
+}
+
+
+/*
+ * Returns the n-th variable.
+ */
+const SedVariable*
+SedChunkWriter::getVariable (unsigned int n) const
+{
+  return (n < mVariables.size()) ? mVariables[n] : NULL;
+}
+
+
+/*
+ * Returns the number of time points written so far.
+ */
+size_t
+SedChunkWriter::getNumPoints () const
+{
+  return mNumPoints;
+}
+
+
+/*
+ * Returns the number of time points written so far, kept or not.
+ */
+size_t
+SedChunkWriter::getNumPointsWritten () const
+{
+  return mNumWritten;
+}
+
+
+/*
+ * Returns the number of time points the columns have room for.
+ */
+size_t
+SedChunkWriter::getCapacity () const
+{
+  return mCapacity;
+}
+
+
+/*
+ * Sets the listener told about every chunk written from now on.
+ */
+void
+SedChunkWriter::setListener (SedChunkListener* listener, bool keepPoints)
+{
+  mListener   = listener;
+  mKeepPoints = (listener == NULL || keepPoints);
+}
+
+
+/*
+ * Appends numPoints time points, one pointer to values per variable.
+ */
+int
+SedChunkWriter::writeChunk (const double* const* values, size_t numPoints)
+{
+  if (values == NULL && !mVariables.empty())
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  return append(values, NULL, 0, numPoints);
+}
+
+
+/*
+ * Appends numPoints time points kept row after row.
+ */
+int
+SedChunkWriter::writeRows (const double* values, size_t numPoints,
+                           size_t stride)
+{
+  if (stride == 0) stride = mVariables.size();
+
+  if ((values == NULL && !mVariables.empty()) || stride < mVariables.size())
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  return append(NULL, values, stride, numPoints);
+}
+
+
+/*
+ * Appends one time point.
+ */
+int
+SedChunkWriter::writePoint (const double* values)
+{
+  return writeRows(values, 1, mVariables.size());
+}
+
+
+/*
+ * Makes room for numPoints time points after those written.
+ */
+int
+SedChunkWriter::reserve (size_t numPoints)
+{
+  if (!mBound) return LIBSEDML_OPERATION_FAILED;
+  if (numPoints <= mCapacity - mNumPoints) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (numPoints > (size_t)-1 - mNumPoints) return LIBSEDML_OPERATION_FAILED;
+  const size_t needed = mNumPoints + numPoints;
+
+  // the capacity doubles, so that growing point by point stays linear
+  size_t capacity = (mCapacity < SED_CHUNK_MIN_CAPACITY)
+                  ? SED_CHUNK_MIN_CAPACITY : mCapacity;
+  while (capacity < needed)
+  {
+    capacity = (capacity > (size_t)-1 / 2) ? needed : 2 * capacity;
+  }
+
+  return resize(capacity);
+}
+
+
+/*
+ * Returns the column of the n-th variable.
+ */
+double*
+SedChunkWriter::getColumn (unsigned int n)
+{
+  return (n < mColumns.size()) ? mColumns[n] : NULL;
+}
+
+
+/*
+ * Returns the column of the n-th variable.
+ */
+const double*
+SedChunkWriter::getColumn (unsigned int n) const
+{
+  return (n < mColumns.size()) ? mColumns[n] : NULL;
+}
+
+
+/*
+ * Counts numPoints time points written through getColumn().
+ */
+int
+SedChunkWriter::commit (size_t numPoints)
+{
+  if (!mBound) return LIBSEDML_OPERATION_FAILED;
+  if (numPoints > mCapacity - mNumPoints)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  return written(numPoints);
+}
+
+
+/*
+ * Cuts the columns to the time points written.
+ */
+int
+SedChunkWriter::finish ()
+{
+  if (!mBound) return LIBSEDML_OPERATION_FAILED;
+  if (mCapacity == mNumPoints) return LIBSEDML_OPERATION_SUCCESS;
+
+  return resize(mNumPoints);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Makes every column hold capacity values, keeping those written.
+ */
+int
+SedChunkWriter::resize (size_t capacity)
+{
+  for (unsigned int n = 0; n < mVariables.size(); ++n)
+  {
+    double* column = mResults.resizeColumn(mVariables[n]->getId(), capacity);
+    if (column == NULL)
+    {
+      // the columns grown so far keep their room, but those that could
+      // not are not written past the old capacity
+      return LIBSEDML_OPERATION_FAILED;
+    }
+    mColumns[n] = column;
+  }
+
+  mCapacity = capacity;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Appends numPoints time points, taken from columns if it is not NULL
+ * and from rows, stride values apart, otherwise.
+ */
+int
+SedChunkWriter::append (const double* const* columns, const double* rows,
+                        size_t stride, size_t numPoints)
+{
+  size_t done = 0;
+
+  while (done < numPoints || numPoints == 0)
+  {
+    // points that are not kept are passed on a capacity at a time, so
+    // that the columns do not grow past it
+    size_t length = numPoints - done;
+    if (!mKeepPoints && mCapacity > 0 && length > mCapacity - mNumPoints)
+    {
+      length = mCapacity - mNumPoints;
+    }
+
+    const int result = reserve(length);
+    if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+    for (unsigned int n = 0; n < mColumns.size(); ++n)
+    {
+      double* column = mColumns[n] + mNumPoints;
+
+      if (columns == NULL)
+      {
+        // column after column, so that each is written in order
+        const double* value = rows + done * stride + n;
+        for (size_t i = 0; i < length; ++i, value += stride)
+        {
+          column[i] = *value;
+        }
+      }
+      else if (length == 0)
+      {
+        continue;
+      }
+      else if (columns[n] != NULL)
+      {
+        memcpy(column, columns[n] + done, length * sizeof(double));
+      }
+      else
+      {
+        // rewound columns hold the values of the chunk before
+        memset(column, 0, length * sizeof(double));
+      }
+    }
+
+    const int status = written(length);
+    if (status != LIBSEDML_OPERATION_SUCCESS) return status;
+
+    done += length;
+    if (numPoints == 0) break;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Counts numPoints time points written after those before, and tells the
+ * listener about them.
+ */
+int
+SedChunkWriter::written (size_t numPoints)
+{
+  mNumPoints  += numPoints;
+  mNumWritten += numPoints;
+
+  if (mListener == NULL || numPoints == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+  const int result =
+    mListener->chunkWritten(*this, mNumPoints - numPoints, numPoints);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  if (!mKeepPoints) mNumPoints = 0;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+/** @endcond */
+
+
+/*
+ * Destroys this SedSimulatorAdapter.
+ */
+SedSimulatorAdapter::~SedSimulatorAdapter ()
+{
+}
+
+
+/*
+ * Binds the columns of variables in results and runs the task into them.
+ */
+int
+SedSimulatorAdapter::simulate (const SedTask* task, const SedModel* model,
+                               const SedSimulation* simulation,
+                               const std::vector<const SedVariable*>& variables,
+                               SedResults& results)
+{
+  SedChunkWriter writer(results, variables, getNumPoints(simulation));
+
+  const SedAlgorithm* algorithm = (simulation != NULL)
+                                ? simulation->getAlgorithm() : NULL;
+
+  const int result = run(task, model, simulation, algorithm, writer);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return writer.finish();
+}
+
+
+/*
+ * Returns the number of time points simulation is expected to output.
+ */
+size_t
+SedSimulatorAdapter::getNumPoints (const SedSimulation* simulation) const
+{
+  if (simulation == NULL
+      || simulation->getTypeCode() != SEDML_SIMULATION_UNIFORMTIMECOURSE)
+  {
+    return 0;
+  }
+
+  const SedTimeGrid* grid =
+    static_cast<const SedUniformTimeCourse*>(simulation)->getTimeGrid();
+  return (grid != NULL) ? grid->getNumOutputTimes() : 0;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Registers func, run by a SedSimulatorAdapter, as the simulator for
+ * models in language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSimulatorAdapter (SedExecutor_t *se, const char *language,
+                                 SedSimulatorAdapter_runFunc func,
+                                 void *userData)
+{
+  if (se == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const std::string lang = (language != NULL) ? language : "";
+  if (func == NULL)
+  {
+    se->setSimulator(lang, NULL);
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+  SedSimulator* simulator =
+    new (nothrow) SedCallbackSimulatorAdapter(func, userData);
+  if (simulator == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  se->adoptSimulator(lang, simulator);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Returns the number of variables the given SedChunkWriter writes.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedChunkWriter_getNumVariables (const SedChunkWriter_t *scw)
+{
+  return (scw != NULL) ? scw->getNumVariables() : 0;
+}
+
+
+/**
+ * Returns the n-th variable the given SedChunkWriter writes.
+ */
+LIBSEDML_EXTERN
+const SedVariable_t *
+SedChunkWriter_getVariable (const SedChunkWriter_t *scw, unsigned int n)
+{
+  return (scw != NULL) ? scw->getVariable(n) : NULL;
+}
+
+
+/**
+ * Returns the number of time points written so far.
+ */
+LIBSEDML_EXTERN
+size_t
+SedChunkWriter_getNumPoints (const SedChunkWriter_t *scw)
+{
+  return (scw != NULL) ? scw->getNumPoints() : 0;
+}
+
+
+/**
+ * Appends numPoints time points, one pointer to values per variable.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writeChunk (SedChunkWriter_t *scw,
+                           const double *const *values, size_t numPoints)
+{
+  if (scw == NULL) return LIBSEDML_INVALID_OBJECT;
+  return scw->writeChunk(values, numPoints);
+}
+
+
+/**
+ * Appends numPoints time points kept row after row.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writeRows (SedChunkWriter_t *scw, const double *values,
+                          size_t numPoints, size_t stride)
+{
+  if (scw == NULL) return LIBSEDML_INVALID_OBJECT;
+  return scw->writeRows(values, numPoints, stride);
+}
+
+
+/**
+ * Appends one time point.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writePoint (SedChunkWriter_t *scw, const double *values)
+{
+  if (scw == NULL) return LIBSEDML_INVALID_OBJECT;
+  return scw->writePoint(values);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
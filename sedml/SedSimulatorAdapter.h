@@ -0,0 +1,461 @@
+/**
+ * @file    SedSimulatorAdapter.h
+ * @brief   Simulators that push their output into SedResults in chunks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSimulatorAdapter
+ * @ingroup Core
+ * @brief A SedSimulator that pushes its output, a chunk of time points at
+ * a time, into the columns of the task results.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A solver adapted with a SedSimulator has to fill a SedResults with the
+ * columns of the variables itself, which usually means collecting its
+ * whole output and copying the columns wanted out of it.  A
+ * SedSimulatorAdapter does that part: for every task it binds one column
+ * of the results to each variable the data generators want from the task,
+ * and calls run() with the resolved task, model, simulation and algorithm
+ * and a SedChunkWriter over those columns.  run() steps the solver and
+ * hands every chunk of time points to the writer as soon as it has it,
+ * with the values of only the variables asked for, which the writer
+ * stores straight into their columns.
+ *
+ * The columns are allocated once for getNumPoints() time points, the
+ * output times of a SedUniformTimeCourse by default; a simulation that
+ * outputs more, or whose number of points is not known beforehand, makes
+ * them grow, and the columns are cut to the points written when run()
+ * returns.
+ *
+ * Of several variables referring to the same target or symbol of a
+ * task, only the first is bound; SedExecutor gives the others the column
+ * of the first as an alias.  Sweep points are run like tasks, on the copy
+ * of the model SedSimulator::simulatePoint() makes.
+ *
+ * @class SedChunkWriter
+ * @ingroup Core
+ * @brief The columns a SedSimulatorAdapter writes the output of a task
+ * into.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedChunkWriter holds one column per variable, in the order of
+ * getVariable(), and the number of time points written to them so far.
+ * writeChunk() and writePoint() append time points to all columns at
+ * once; getColumn() lets a solver that keeps its values in place write
+ * them itself, before commit().
+ *
+ * A SedChunkListener set with setListener() is told about every chunk
+ * once it is in the columns, so that what depends on the values can be
+ * computed while the solver runs; SedPipeline evaluates data generators
+ * and writes reports that way.  If the points are not kept, the columns
+ * are rewound once the listener has seen them, so that they only ever
+ * hold one chunk, of at most getCapacity() points.
+ *
+ * @class SedChunkListener
+ * @ingroup Core
+ * @brief Told about every chunk of time points a SedChunkWriter is given.
+ *
+ * @htmlinclude not-sbml-warning.html
+ */
+
+#ifndef SedSimulatorAdapter_h
+#define SedSimulatorAdapter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedExecutor.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedAlgorithm;
+class SedChunkWriter;
+
+
+class LIBSEDML_EXTERN SedChunkListener
+{
+public:
+
+  /**
+   * Destroys this SedChunkListener.
+   */
+  virtual ~SedChunkListener ();
+
+
+  /**
+   * Called once the time points @p offset to @p offset + @p length - 1 of
+   * the columns of @p writer have been written; see
+   * SedChunkWriter::getColumn().  The values may not be kept: the
+   * columns may be rewound and written over once this returns.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value is returned by the write, which fails the
+   * task.
+   */
+  virtual int chunkWritten (const SedChunkWriter& writer, size_t offset,
+                            size_t length) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedChunkWriter
+{
+public:
+
+  /**
+   * Creates a new SedChunkWriter binding a column of @p results, keyed by
+   * SedVariable::getId(), to each of @p variables, with room for
+   * @p numPoints time points.
+   */
+  SedChunkWriter (SedResults& results,
+                  const std::vector<const SedVariable*>& variables,
+                  size_t numPoints);
+
+
+  /**
+   * @return the number of variables, and so of columns, written.
+   */
+  unsigned int getNumVariables () const;
+
+
+  /**
+   * @return the <em>n</em>th variable, or @c NULL if @p n is out of range.
+   * Its SedVariable::getTarget() or SedVariable::getSymbol() tells what
+   * the solver has to report in the <em>n</em>th column.
+   */
+  const SedVariable* getVariable (unsigned int n) const;
+
+
+  /**
+   * @return the number of time points the columns hold: those written so
+   * far, or, if they are not kept, those of the chunk being written.
+   */
+  size_t getNumPoints () const;
+
+
+  /**
+   * @return the number of time points written so far, kept or not.
+   */
+  size_t getNumPointsWritten () const;
+
+
+  /**
+   * @return the number of time points the columns have room for.
+   */
+  size_t getCapacity () const;
+
+
+  /**
+   * Sets the listener, which this writer does not own, told about every
+   * chunk written from now on; @c NULL, the default, removes it.
+   *
+   * @param listener the listener.
+   * @param keepPoints if @c false, the columns are rewound after every
+   * chunk the listener has seen, and chunks larger than getCapacity()
+   * are passed to it in parts, so that the columns never grow past it;
+   * the columns then end up empty.
+   */
+  void setListener (SedChunkListener* listener, bool keepPoints = true);
+
+
+  /**
+   * Appends @p numPoints time points: @p values holds getNumVariables()
+   * pointers, the <em>n</em>th of which points to the @p numPoints values
+   * of the <em>n</em>th variable.  A @c NULL pointer leaves the points of
+   * its column zero.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p values is @c NULL though there are variables
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the columns could not grow
+   */
+  int writeChunk (const double* const* values, size_t numPoints);
+
+
+  /**
+   * Appends @p numPoints time points kept row after row: the value of the
+   * <em>n</em>th variable at the <em>i</em>th point is
+   * <code>values[i * stride + n]</code>, so that the state a solver
+   * reports at each point can be written as it is, with the variables in
+   * its first getNumVariables() entries.  A @p stride of 0 is taken to
+   * be getNumVariables().
+   *
+   * @return as writeChunk(), also failing with
+   * @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p stride is less than getNumVariables().
+   */
+  int writeRows (const double* values, size_t numPoints, size_t stride = 0);
+
+
+  /**
+   * Appends one time point, with the <em>n</em>th variable at
+   * <code>values[n]</code>.
+   *
+   * @return as writeChunk().
+   */
+  int writePoint (const double* values);
+
+
+  /**
+   * Makes room for @p numPoints time points after those written, so that
+   * they can be written through getColumn().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the columns could not grow
+   */
+  int reserve (size_t numPoints);
+
+
+  /**
+   * @return the column of the <em>n</em>th variable, whose getCapacity()
+   * values stay put until the columns grow, or @c NULL if @p n is out of
+   * range.  Values written past getNumPoints() count once commit() is
+   * called.
+   */
+  double* getColumn (unsigned int n);
+
+
+  /**
+   * @return the column of the <em>n</em>th variable, or @c NULL if @p n
+   * is out of range.
+   */
+  const double* getColumn (unsigned int n) const;
+
+
+  /**
+   * Counts @p numPoints time points written through getColumn() after
+   * those written before.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the columns do not have room for them
+   */
+  int commit (size_t numPoints);
+
+
+  /**
+   * Cuts the columns to the time points written.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a column could not be bound
+   */
+  int finish ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  int resize (size_t capacity);
+
+  int append (const double* const* columns, const double* rows,
+              size_t stride, size_t numPoints);
+
+  int written (size_t numPoints);
+
+  SedResults&                      mResults;
+  std::vector<const SedVariable*>  mVariables;
+  std::vector<double*>             mColumns;
+  size_t                           mNumPoints;
+  size_t                           mNumWritten;
+  size_t                           mCapacity;
+  bool                             mBound;
+  SedChunkListener*                mListener;
+  bool                             mKeepPoints;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedChunkWriter (const SedChunkWriter& orig);
+  SedChunkWriter& operator= (const SedChunkWriter& rhs);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedSimulatorAdapter : public SedSimulator
+{
+public:
+
+  /**
+   * Destroys this SedSimulatorAdapter.
+   */
+  virtual ~SedSimulatorAdapter ();
+
+
+  /**
+   * Binds the columns of @p variables in @p results and calls run() to
+   * fill them.
+   *
+   * @see SedSimulator::simulate()
+   */
+  virtual int simulate (const SedTask* task, const SedModel* model,
+                        const SedSimulation* simulation,
+                        const std::vector<const SedVariable*>& variables,
+                        SedResults& results);
+
+
+  /**
+   * Runs @p task and writes the values of the variables of @p writer with
+   * it, as the solver outputs them.
+   *
+   * @param task the task to run.
+   * @param model the model of the task.
+   * @param simulation the simulation of the task.
+   * @param algorithm the algorithm of @p simulation, or @c NULL.
+   * @param writer the columns of the variables the data generators want
+   * from the task, with no time points written.
+   *
+   * @return @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * on success; any other value fails the task.
+   */
+  virtual int run (const SedTask* task, const SedModel* model,
+                   const SedSimulation* simulation,
+                   const SedAlgorithm* algorithm,
+                   SedChunkWriter& writer) = 0;
+
+
+  /**
+   * @return the number of time points @p simulation is expected to
+   * output, that the columns are allocated for: the number of output
+   * times of a SedUniformTimeCourse, and 0, for columns that grow as
+   * they are written, otherwise.
+   */
+  virtual size_t getNumPoints (const SedSimulation* simulation) const;
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Function running a task for a SedSimulatorAdapter; it writes the values
+ * of the variables of @p writer with it and returns
+ * LIBSEDML_OPERATION_SUCCESS on success.
+ */
+typedef int (*SedSimulatorAdapter_runFunc) (const SedTask_t *task,
+                                            const SedModel_t *model,
+                                            const SedSimulation_t *simulation,
+                                            const SedAlgorithm_t *algorithm,
+                                            SedChunkWriter_t *writer,
+                                            void *userData);
+
+
+/**
+ * Registers @p func, run by a SedSimulatorAdapter, as the simulator for
+ * models in @p language.
+ */
+LIBSEDML_EXTERN
+int
+SedExecutor_setSimulatorAdapter (SedExecutor_t *se, const char *language,
+                                 SedSimulatorAdapter_runFunc func,
+                                 void *userData);
+
+
+/**
+ * Returns the number of variables the given SedChunkWriter writes.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedChunkWriter_getNumVariables (const SedChunkWriter_t *scw);
+
+
+/**
+ * Returns the <em>n</em>th variable the given SedChunkWriter writes.
+ */
+LIBSEDML_EXTERN
+const SedVariable_t *
+SedChunkWriter_getVariable (const SedChunkWriter_t *scw, unsigned int n);
+
+
+/**
+ * Returns the number of time points written so far.
+ */
+LIBSEDML_EXTERN
+size_t
+SedChunkWriter_getNumPoints (const SedChunkWriter_t *scw);
+
+
+/**
+ * Appends @p numPoints time points, @p values holding one pointer to the
+ * values of each variable.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writeChunk (SedChunkWriter_t *scw,
+                           const double *const *values, size_t numPoints);
+
+
+/**
+ * Appends @p numPoints time points kept row after row, @p stride values
+ * apart.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writeRows (SedChunkWriter_t *scw, const double *values,
+                          size_t numPoints, size_t stride);
+
+
+/**
+ * Appends one time point, with one value per variable.
+ */
+LIBSEDML_EXTERN
+int
+SedChunkWriter_writePoint (SedChunkWriter_t *scw, const double *values);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedSimulatorAdapter_h */
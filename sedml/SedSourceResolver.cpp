@@ -0,0 +1,944 @@
+/**
+ * @file    SedSourceResolver.cpp
+ * @brief   Resolves and caches the sources of SED-ML models
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSourceResolver.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/common/threads.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <set>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The lock of a SedSourceResolver, and the condition its threads wait on
+ * for locations being fetched by another thread.
+ */
+struct SedSourceResolverLock
+{
+  SedMutex     mutex;
+  SedCondition condition;
+};
+
+
+static bool
+startsWith (const std::string& text, const char* prefix)
+{
+  return text.compare(0, strlen(prefix), prefix) == 0;
+}
+
+
+static bool
+readFile (const std::string& path, std::string& contents)
+{
+  std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+  if (!file) return false;
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff length = file.tellg();
+  if (length < 0) return false;
+  file.seekg(0, std::ios::beg);
+
+  contents.resize((size_t)length);
+  if (length > 0 && !file.read(&contents[0], (std::streamsize)length))
+  {
+    contents.clear();
+    return false;
+  }
+
+  return true;
+}
+
+
+static bool
+writeFile (const std::string& path, const std::string& contents)
+{
+  std::ofstream file(path.c_str(), std::ios::out | std::ios::binary
+                                 | std::ios::trunc);
+  if (!file) return false;
+
+  file.write(contents.data(), (std::streamsize)contents.size());
+  return !file.fail();
+}
+
+
+/*
+ * A fetcher calling a C function, used by SedSourceResolver_create().
+ */
+class SedCallbackSourceFetcher : public SedSourceFetcher
+{
+public:
+
+  SedCallbackSourceFetcher (SedSourceResolver_fetchFunc fetch,
+                            void* userData)
+    : mFetch (fetch)
+    , mUserData (userData)
+  {
+  }
+
+  virtual SedFetchStatus_t fetch (const std::string& url,
+                                  const std::string& etag,
+                                  std::string& contents,
+                                  std::string& newEtag)
+  {
+    char*  data   = NULL;
+    size_t length = 0;
+    char*  tag    = NULL;
+
+    SedFetchStatus_t status = mFetch(url.c_str(), etag.c_str(), &data,
+                                     &length, &tag, mUserData);
+
+    if (data != NULL) contents.assign(data, length);
+    if (tag != NULL) newEtag = tag;
+    free(data);
+    free(tag);
+
+    return status;
+  }
+
+private:
+
+  SedSourceResolver_fetchFunc mFetch;
+  void*                       mUserData;
+};
+
+
+/*
+ * A resolver owning its fetcher, returned by SedSourceResolver_create().
+ */
+class SedCallbackSourceResolver : public SedSourceResolver
+{
+public:
+
+  SedCallbackSourceResolver (SedSourceResolver_fetchFunc fetch,
+                             void* userData, unsigned int numThreads)
+    : SedSourceResolver (NULL, numThreads)
+    , mCallback (fetch, userData)
+  {
+    if (fetch != NULL) setFetcher(&mCallback);
+  }
+
+private:
+
+  SedCallbackSourceFetcher mCallback;
+};
+
+
+/*
+ * State shared by the threads of one prefetch().  Locations are claimed
+ * one at a time through next.
+ */
+struct SedSourceJob
+{
+  SedSourceResolver*              resolver;
+  const std::vector<std::string>* locations;
+  unsigned int                    next;
+  unsigned int                    numLoaded;
+  SedMutex                        mutex;
+
+  static void run (SedSourceJob* job);
+};
+
+
+void
+SedSourceJob::run (SedSourceJob* job)
+{
+  const unsigned int size = (unsigned int)job->locations->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int index = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (index >= size) break;
+
+    bool loaded = false;
+    try
+    {
+      loaded = job->resolver->getLocationContents((*job->locations)[index],
+                                                  NULL);
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the location is not loaded
+      loaded = false;
+    }
+
+    if (loaded)
+    {
+      mutexLock(&job->mutex);
+      job->numLoaded++;
+      mutexUnlock(&job->mutex);
+    }
+  }
+}
+
+
+/*
+ * Entry point of the worker threads.
+ */
+static void
+sourceThreadMain (void* arg)
+{
+  SedSourceJob::run(static_cast<SedSourceJob*>(arg));
+}
+
+/** @endcond */
+
+
+/*
+ * Destroys this SedSourceFetcher.
+ */
+SedSourceFetcher::~SedSourceFetcher ()
+{
+}
+
+
+/*
+ * Creates a new, empty SedSourceResolver.
+ */
+SedSourceResolver::SedSourceResolver (SedSourceFetcher* fetcher,
+                                      unsigned int numThreads)
+  : mFetcher (fetcher)
+  , mNumThreads (numThreads)
+  , mMemoryLimit (64 * 1024 * 1024)
+  , mMemoryUsed (0)
+  , mCacheDirectory ()
+  , mUrnPrefixes ()
+  , mEntries ()
+  , mRecent ()
+  , mNumHits (0)
+  , mNumMisses (0)
+  , mLock (NULL)
+{
+  SedSourceResolverLock* lock = new SedSourceResolverLock;
+  mutexInit(&lock->mutex);
+  conditionInit(&lock->condition);
+  mLock = lock;
+
+  addUrnPrefix("urn:miriam:biomodels.db:",
+    "https://www.ebi.ac.uk/biomodels/model/download/{id}"
+    "?filename={id}_url.xml");
+}
+
+
+/*
+ * Destroys this SedSourceResolver.
+ */
+SedSourceResolver::~SedSourceResolver ()
+{
+  SedSourceResolverLock* lock = static_cast<SedSourceResolverLock*>(mLock);
+  conditionFree(&lock->condition);
+  mutexFree(&lock->mutex);
+  delete lock;
+}
+
+
+/*
+ * Sets the fetcher for URLs.
+ */
+void
+SedSourceResolver::setFetcher (SedSourceFetcher* fetcher)
+{
+  mFetcher = fetcher;
+}
+
+
+/*
+ * Sets the number of threads prefetch() uses.
+ */
+void
+SedSourceResolver::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next prefetch() will use at most.
+ */
+unsigned int
+SedSourceResolver::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Sets the number of bytes of contents kept in memory.
+ */
+void
+SedSourceResolver::setMemoryLimit (size_t bytes)
+{
+  SedSourceResolverLock* lock = static_cast<SedSourceResolverLock*>(mLock);
+  mutexLock(&lock->mutex);
+  mMemoryLimit = bytes;
+  evict();
+  mutexUnlock(&lock->mutex);
+}
+
+
+/*
+ * Returns the number of bytes of contents kept in memory at most.
+ */
+size_t
+SedSourceResolver::getMemoryLimit () const
+{
+  return mMemoryLimit;
+}
+
+
+/*
+ * Sets the directory fetched URLs are kept in.
+ */
+void
+SedSourceResolver::setCacheDirectory (const std::string& directory)
+{
+  mCacheDirectory = directory;
+}
+
+
+/*
+ * Returns the directory fetched URLs are kept in.
+ */
+const std::string&
+SedSourceResolver::getCacheDirectory () const
+{
+  return mCacheDirectory;
+}
+
+
+/*
+ * Maps the URNs starting with prefix to url.
+ */
+void
+SedSourceResolver::addUrnPrefix (const std::string& prefix,
+                                 const std::string& url)
+{
+  for (unsigned int i = 0; i < mUrnPrefixes.size(); i++)
+  {
+    if (mUrnPrefixes[i].first == prefix)
+    {
+      mUrnPrefixes[i].second = url;
+      return;
+    }
+  }
+
+  mUrnPrefixes.push_back(std::make_pair(prefix, url));
+}
+
+
+/*
+ * Returns the location of source for a document read from base.
+ */
+std::string
+SedSourceResolver::getLocation (const std::string& source,
+                                const std::string& base) const
+{
+  if (source.empty() || source[0] == '#') return "";
+
+  if (startsWith(source, "urn:"))
+  {
+    for (unsigned int i = 0; i < mUrnPrefixes.size(); i++)
+    {
+      const std::string& prefix = mUrnPrefixes[i].first;
+      if (!startsWith(source, prefix.c_str())) continue;
+
+      const std::string id = source.substr(prefix.size());
+      std::string url = mUrnPrefixes[i].second;
+      for (size_t pos = url.find("{id}"); pos != std::string::npos;
+           pos = url.find("{id}", pos + id.size()))
+      {
+        url.replace(pos, 4, id);
+      }
+      return url;
+    }
+    return "";
+  }
+
+  if (isUrl(source)) return source;
+  if (startsWith(source, "file://")) return source.substr(7);
+
+  // absolute paths, also those of Windows, are used as they are
+  const bool absolute = source[0] == '/' || source[0] == '\\'
+                     || (source.size() > 1 && source[1] == ':');
+  if (absolute) return source;
+
+  const size_t slash = base.find_last_of("/\\");
+  if (slash == std::string::npos) return source;
+
+  std::string directory = base.substr(0, slash + 1);
+  if (startsWith(directory, "file://")) directory.erase(0, 7);
+
+  return directory + source;
+}
+
+
+/*
+ * Fetches the sources of all models of document.
+ */
+unsigned int
+SedSourceResolver::prefetch (const SedDocument* document,
+                             const std::string& base)
+{
+  std::vector<const SedDocument*> documents(1, document);
+  std::vector<std::string>        bases(1, base);
+  return prefetch(documents, bases);
+}
+
+
+/*
+ * Fetches the sources of all models of documents.
+ */
+unsigned int
+SedSourceResolver::prefetch (const std::vector<const SedDocument*>& documents,
+                             const std::vector<std::string>& bases)
+{
+  // each location once, in the order the models first use them
+  std::vector<std::string> locations;
+  std::set<std::string>    seen;
+
+  for (unsigned int i = 0; i < documents.size(); i++)
+  {
+    const SedDocument* document = documents[i];
+    if (document == NULL) continue;
+
+    const std::string base = (i < bases.size()) ? bases[i] : "";
+    for (unsigned int n = 0; n < document->getNumModels(); n++)
+    {
+      const SedModel* model = document->getModel(n);
+      const std::string& source = model->getSource();
+
+      // a source naming another model is resolved by SedModelCache
+      const SedModel* other = document->getModel(source);
+      if (other != NULL && other != model) continue;
+
+      const std::string location = getLocation(source, base);
+      if (location.empty()) continue;
+
+      if (seen.insert(location).second) locations.push_back(location);
+    }
+  }
+
+  if (locations.empty()) return 0;
+
+  unsigned int numThreads = getNumThreads();
+  if (numThreads > locations.size())
+  {
+    numThreads = (unsigned int)locations.size();
+  }
+
+  SedSourceJob job;
+  job.resolver  = this;
+  job.locations = &locations;
+  job.next      = 0;
+  job.numLoaded = 0;
+  mutexInit(&job.mutex);
+
+  // the calling thread is one of the workers, as in SedBatchReader
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, sourceThreadMain, &job)) break;
+    threads.push_back(thread);
+  }
+
+  SedSourceJob::run(&job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+
+  mutexFree(&job.mutex);
+
+  return job.numLoaded;
+}
+
+
+/*
+ * Copies the contents of source into contents.
+ */
+bool
+SedSourceResolver::getContents (const std::string& source,
+                                const std::string& base,
+                                std::string& contents)
+{
+  const std::string location = getLocation(source, base);
+  if (location.empty()) return false;
+
+  return getLocationContents(location, &contents);
+}
+
+
+/*
+ * Keeps contents in memory as the contents of location.
+ */
+void
+SedSourceResolver::addContents (const std::string& location,
+                                const std::string& contents)
+{
+  if (location.empty()) return;
+
+  SedSourceResolverLock* lock = static_cast<SedSourceResolverLock*>(mLock);
+  mutexLock(&lock->mutex);
+
+  std::map<std::string, Entry>::iterator it = mEntries.find(location);
+  if (it == mEntries.end())
+  {
+    Entry& entry = mEntries[location];
+    entry.contents = contents;
+    entry.ready    = true;
+    mRecent.push_front(location);
+    entry.position = mRecent.begin();
+    mMemoryUsed   += contents.size();
+    evict();
+  }
+  else if (it->second.ready)
+  {
+    Entry& entry = it->second;
+    mMemoryUsed   -= entry.contents.size();
+    entry.contents = contents;
+    mMemoryUsed   += contents.size();
+    mRecent.splice(mRecent.begin(), mRecent, entry.position);
+    evict();
+  }
+
+  mutexUnlock(&lock->mutex);
+}
+
+
+/*
+ * Returns the number of locations whose contents are in memory.
+ */
+unsigned int
+SedSourceResolver::getNumEntries () const
+{
+  return (unsigned int)mRecent.size();
+}
+
+
+/*
+ * Returns how many times contents were found in memory.
+ */
+unsigned int
+SedSourceResolver::getNumHits () const
+{
+  return mNumHits;
+}
+
+
+/*
+ * Returns how many times contents had to be read or fetched.
+ */
+unsigned int
+SedSourceResolver::getNumMisses () const
+{
+  return mNumMisses;
+}
+
+
+/*
+ * Drops all contents kept in memory.
+ */
+void
+SedSourceResolver::clear ()
+{
+  SedSourceResolverLock* lock = static_cast<SedSourceResolverLock*>(mLock);
+  mutexLock(&lock->mutex);
+
+  // entries being fetched stay, their threads fill them in
+  std::map<std::string, Entry>::iterator it = mEntries.begin();
+  while (it != mEntries.end())
+  {
+    if (it->second.ready)
+      mEntries.erase(it++);
+    else
+      ++it;
+  }
+
+  mRecent.clear();
+  mMemoryUsed = 0;
+  mNumHits    = 0;
+  mNumMisses  = 0;
+
+  mutexUnlock(&lock->mutex);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Copies the contents of location into contents, if it is not NULL,
+ * loading them outside of the lock if they are not in memory.
+ */
+bool
+SedSourceResolver::getLocationContents (const std::string& location,
+                                        std::string* contents)
+{
+  SedSourceResolverLock* lock = static_cast<SedSourceResolverLock*>(mLock);
+  mutexLock(&lock->mutex);
+
+  for (;;)
+  {
+    std::map<std::string, Entry>::iterator it = mEntries.find(location);
+    if (it == mEntries.end()) break;
+
+    Entry& entry = it->second;
+    if (entry.ready)
+    {
+      mNumHits++;
+      mRecent.splice(mRecent.begin(), mRecent, entry.position);
+      if (contents != NULL) *contents = entry.contents;
+      mutexUnlock(&lock->mutex);
+      return true;
+    }
+
+    // another thread is loading it; it may also fail, and then this one
+    // tries in its turn
+    conditionWait(&lock->condition, &lock->mutex);
+  }
+
+  mNumMisses++;
+  mEntries[location].ready = false;
+  mutexUnlock(&lock->mutex);
+
+  std::string loaded;
+  bool valid = false;
+  try
+  {
+    valid = load(location, loaded);
+  }
+  catch (...)
+  {
+    valid = false;
+  }
+
+  mutexLock(&lock->mutex);
+
+  std::map<std::string, Entry>::iterator it = mEntries.find(location);
+  if (valid)
+  {
+    if (contents != NULL) *contents = loaded;
+
+    Entry& entry = it->second;
+    entry.contents.swap(loaded);
+    entry.ready    = true;
+    mRecent.push_front(location);
+    entry.position = mRecent.begin();
+    mMemoryUsed   += entry.contents.size();
+    evict();
+  }
+  else
+  {
+    mEntries.erase(it);
+  }
+
+  conditionBroadcast(&lock->condition);
+  mutexUnlock(&lock->mutex);
+
+  return valid;
+}
+
+
+/*
+ * Reads a file, or fetches a URL, into contents.
+ */
+bool
+SedSourceResolver::load (const std::string& location,
+                         std::string& contents) const
+{
+  if (isUrl(location)) return fetchUrl(location, contents);
+
+  return readFile(location, contents);
+}
+
+
+/*
+ * Fetches url, revalidating the copy in the cache directory if there
+ * is one.
+ */
+bool
+SedSourceResolver::fetchUrl (const std::string& url,
+                             std::string& contents) const
+{
+  std::string dataPath;
+  std::string tagPath;
+  std::string cached;
+  std::string etag;
+  bool        hasCached = false;
+
+  if (!mCacheDirectory.empty())
+  {
+    char name[32];
+    sprintf(name, "%08lx", (unsigned long)SedModelCache::getHash(url));
+
+    std::string directory = mCacheDirectory;
+    const char last = directory[directory.size() - 1];
+    if (last != '/' && last != '\\') directory += '/';
+
+    dataPath = directory + name + ".data";
+    tagPath  = directory + name + ".etag";
+
+    // the tag file holds the URL on its first line, so that two URLs
+    // with one hash do not take each other's contents
+    std::string tag;
+    if (readFile(tagPath, tag) && readFile(dataPath, cached))
+    {
+      const size_t newline = tag.find('\n');
+      if (newline != std::string::npos && tag.compare(0, newline, url) == 0)
+      {
+        etag      = tag.substr(newline + 1);
+        hasCached = true;
+      }
+    }
+  }
+
+  SedFetchStatus_t status = SED_FETCH_FAILED;
+  std::string      fetched;
+  std::string      newEtag;
+  if (mFetcher != NULL)
+  {
+    status = mFetcher->fetch(url, hasCached ? etag : "", fetched, newEtag);
+  }
+
+  if (status == SED_FETCH_OK)
+  {
+    contents.swap(fetched);
+    if (!dataPath.empty() && writeFile(dataPath, contents))
+    {
+      writeFile(tagPath, url + "\n" + newEtag);
+    }
+    return true;
+  }
+
+  // not modified, or the server could not be reached: the copy on disk
+  // is all there is
+  if (hasCached)
+  {
+    contents.swap(cached);
+    return true;
+  }
+
+  return false;
+}
+
+
+/*
+ * Drops the least recently used contents beyond the memory limit, keeping
+ * the most recent; called with the lock held.
+ */
+void
+SedSourceResolver::evict ()
+{
+  while (mMemoryUsed > mMemoryLimit && mRecent.size() > 1)
+  {
+    std::map<std::string, Entry>::iterator it = mEntries.find(mRecent.back());
+    mMemoryUsed -= it->second.contents.size();
+    mEntries.erase(it);
+    mRecent.pop_back();
+  }
+}
+
+
+/*
+ * Returns true if location is a URL fetched by the fetcher.
+ */
+bool
+SedSourceResolver::isUrl (const std::string& location)
+{
+  return startsWith(location, "http://") || startsWith(location, "https://")
+      || startsWith(location, "ftp://");
+}
+/** @endcond */
+
+
+/*
+ * Creates a new SedSourcePreparer.
+ */
+SedSourcePreparer::SedSourcePreparer (SedSourceResolver& resolver,
+                                      SedModelPreparer& preparer,
+                                      const std::string& base)
+  : mResolver (resolver)
+  , mPreparer (preparer)
+  , mBase (base)
+{
+}
+
+
+/*
+ * Destroys this SedSourcePreparer.
+ */
+SedSourcePreparer::~SedSourcePreparer ()
+{
+}
+
+
+/*
+ * Loads source from the contents the resolver has for it.
+ */
+void*
+SedSourcePreparer::loadSource (const std::string& source,
+                               const std::string& language)
+{
+  const std::string location = mResolver.getLocation(source, mBase);
+  if (location.empty()) return mPreparer.loadSource(source, language);
+
+  std::string contents;
+  if (!mResolver.getContents(source, mBase, contents)) return NULL;
+
+  return mPreparer.loadContents(contents, location, language);
+}
+
+
+/*
+ * Applies the changes with the preparer wrapped.
+ */
+void*
+SedSourcePreparer::applyChanges (const void* model, const SedModel* sedModel)
+{
+  return mPreparer.applyChanges(model, sedModel);
+}
+
+
+/*
+ * Releases model with the preparer wrapped.
+ */
+void
+SedSourcePreparer::freeModel (void* model)
+{
+  mPreparer.freeModel(model);
+}
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedSourceResolver and returns it.
+ */
+LIBSEDML_EXTERN
+SedSourceResolver_t *
+SedSourceResolver_create (SedSourceResolver_fetchFunc fetch, void *userData,
+                          unsigned int numThreads)
+{
+  return new (nothrow) SedCallbackSourceResolver(fetch, userData, numThreads);
+}
+
+
+/**
+ * Frees the given SedSourceResolver.
+ */
+LIBSEDML_EXTERN
+void
+SedSourceResolver_free (SedSourceResolver_t *ssr)
+{
+  delete ssr;
+}
+
+
+/**
+ * Sets the directory fetched URLs are kept in.
+ */
+LIBSEDML_EXTERN
+int
+SedSourceResolver_setCacheDirectory (SedSourceResolver_t *ssr,
+                                     const char *directory)
+{
+  if (ssr == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  ssr->setCacheDirectory(directory != NULL ? directory : "");
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Sets the number of bytes of contents kept in memory.
+ */
+LIBSEDML_EXTERN
+int
+SedSourceResolver_setMemoryLimit (SedSourceResolver_t *ssr, size_t bytes)
+{
+  if (ssr == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  ssr->setMemoryLimit(bytes);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/**
+ * Fetches the sources of all models of document.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSourceResolver_prefetch (SedSourceResolver_t *ssr,
+                            const SedDocument_t *document, const char *base)
+{
+  if (ssr == NULL || document == NULL) return 0;
+
+  return ssr->prefetch(document, base != NULL ? base : "");
+}
+
+
+/**
+ * Returns the contents of source.
+ */
+LIBSEDML_EXTERN
+char *
+SedSourceResolver_getContents (SedSourceResolver_t *ssr, const char *source,
+                               const char *base, size_t *length)
+{
+  if (length != NULL) *length = 0;
+  if (ssr == NULL || source == NULL) return NULL;
+
+  std::string contents;
+  if (!ssr->getContents(source, base != NULL ? base : "", contents))
+  {
+    return NULL;
+  }
+
+  char* result = (char*)malloc(contents.size() + 1);
+  if (result == NULL) return NULL;
+
+  memcpy(result, contents.data(), contents.size());
+  result[contents.size()] = '\0';
+  if (length != NULL) *length = contents.size();
+
+  return result;
+}
+
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
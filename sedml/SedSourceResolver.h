@@ -0,0 +1,471 @@
+/**
+ * @file    SedSourceResolver.h
+ * @brief   Resolves and caches the sources of SED-ML models
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSourceResolver
+ * @ingroup Core
+ * @brief Fetches the sources of the models of many documents once each.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The source of a SedModel may be a path relative to the SED-ML file, a
+ * URL, a <code>urn:miriam:</code> identifier or the id of another model
+ * of the document.  A SedSourceResolver turns each source into a
+ * location, a path or a URL: relative paths are taken relative to the
+ * directory of the SED-ML file, and URNs are mapped to URLs by the
+ * prefixes given to addUrnPrefix().  Sources naming another model are
+ * left to SedModelCache.
+ *
+ * prefetch() collects the locations of all models of one or more
+ * documents, so that each location is fetched once however many models
+ * use it.  The locations are fetched on a pool of threads like that of
+ * SedBatchReader.  Files are read directly.  libSEDML has no HTTP client
+ * of its own, so URLs are fetched by a SedSourceFetcher supplied by the
+ * application.  The contents are kept in memory, the least recently used
+ * ones being dropped beyond setMemoryLimit().  With setCacheDirectory(),
+ * fetched URLs are also kept on disk with their ETag.  The first fetch
+ * of a URL in a later run sends that ETag, so that a server answering
+ * "not modified" need not send the contents again.  An unreachable
+ * server falls back to the copy on disk.
+ *
+ * getContents() may be called by several threads at once.  A location
+ * being fetched by one thread is waited for, not fetched again, by the
+ * others.  A SedSourcePreparer gives the contents to
+ * SedModelPreparer::loadContents(), so that a SedModelCache loads its
+ * models through the resolver.
+ */
+
+#ifndef SedSourceResolver_h
+#define SedSourceResolver_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedModelCache.h>
+
+#include <stddef.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * @enum  SedFetchStatus_t
+ * @brief The outcome of SedSourceFetcher::fetch().
+ */
+typedef enum
+{
+    SED_FETCH_OK           = 0 /*!< The contents were fetched. */
+  , SED_FETCH_NOT_MODIFIED = 1 /*!< The contents did not change since the ETag given. */
+  , SED_FETCH_FAILED       = 2 /*!< The contents could not be fetched. */
+} SedFetchStatus_t;
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedSourceFetcher
+{
+public:
+
+  /**
+   * Destroys this SedSourceFetcher.
+   */
+  virtual ~SedSourceFetcher ();
+
+
+  /**
+   * Fetches @p url into @p contents, and its ETag, if the server gave
+   * one, into @p newEtag.  If @p etag is not empty, the contents are only
+   * needed if they no longer have that ETag, as with an
+   * <code>If-None-Match</code> request.  This may be called by several
+   * threads at once.
+   *
+   * @return @c SED_FETCH_OK, @c SED_FETCH_NOT_MODIFIED or
+   * @c SED_FETCH_FAILED.
+   */
+  virtual SedFetchStatus_t fetch (const std::string& url,
+                                  const std::string& etag,
+                                  std::string& contents,
+                                  std::string& newEtag) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedSourceResolver
+{
+public:
+
+  /**
+   * Creates a new, empty SedSourceResolver fetching URLs with
+   * @p fetcher, which it does not own, on @p numThreads threads; zero
+   * uses one thread per available processor.  Without a fetcher only
+   * files and URLs in the cache directory can be resolved.
+   */
+  SedSourceResolver (SedSourceFetcher* fetcher = NULL,
+                     unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedSourceResolver.
+   */
+  virtual ~SedSourceResolver ();
+
+
+  /**
+   * Sets the fetcher for URLs, which is not owned.
+   */
+  void setFetcher (SedSourceFetcher* fetcher);
+
+
+  /**
+   * Sets the number of threads prefetch() uses; zero means one per
+   * processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next prefetch() will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Sets the number of bytes of contents kept in memory; beyond it the
+   * least recently used contents are dropped.  The default is 64 MB.
+   */
+  void setMemoryLimit (size_t bytes);
+
+
+  /**
+   * @return the number of bytes of contents kept in memory at most.
+   */
+  size_t getMemoryLimit () const;
+
+
+  /**
+   * Sets the existing directory fetched URLs are kept in, or none if
+   * @p directory is empty, the default.
+   */
+  void setCacheDirectory (const std::string& directory);
+
+
+  /**
+   * @return the directory fetched URLs are kept in.
+   */
+  const std::string& getCacheDirectory () const;
+
+
+  /**
+   * Maps the URNs starting with @p prefix to @p url, in which each
+   * <code>{id}</code> is replaced by the rest of the URN.  A mapping for
+   * <code>urn:miriam:biomodels.db:</code> to BioModels is there by default
+   * and can be replaced.
+   */
+  void addUrnPrefix (const std::string& prefix, const std::string& url);
+
+
+  /**
+   * Returns the location of @p source, a path or a URL, for a document
+   * read from @p base, a path or a URL; relative sources are relative to
+   * the directory of @p base, or to the working directory if it is empty.
+   *
+   * @return the location, or an empty string if @p source is empty,
+   * names a model by <code>#id</code> or is a URN no prefix maps.
+   */
+  std::string getLocation (const std::string& source,
+                           const std::string& base = "") const;
+
+
+  /**
+   * Fetches the sources of all models of @p document, read from @p base,
+   * that are not in memory yet.
+   *
+   * @return the number of distinct sources that are now in memory.
+   */
+  unsigned int prefetch (const SedDocument* document,
+                         const std::string& base = "");
+
+
+  /**
+   * Fetches the sources of all models of @p documents, the <em>i</em>th
+   * of which was read from the <em>i</em>th of @p bases, if given, each
+   * distinct location once.
+   *
+   * @return the number of distinct sources that are now in memory.
+   */
+  unsigned int prefetch (const std::vector<const SedDocument*>& documents,
+                         const std::vector<std::string>& bases);
+
+
+  /**
+   * Copies the contents of @p source, for a document read from @p base,
+   * into @p contents, fetching them if they are not in memory.
+   *
+   * @return @c true if the contents could be had.
+   */
+  bool getContents (const std::string& source, const std::string& base,
+                    std::string& contents);
+
+
+  /**
+   * Keeps @p contents in memory as the contents of @p location, as if
+   * they had been fetched from it; contents being fetched by another
+   * thread are left to it.  A process that is sent the sources of its
+   * models, such as a remote worker of a SedRemoteSimulator, uses this so
+   * that it does not fetch them again.
+   */
+  void addContents (const std::string& location, const std::string& contents);
+
+
+  /**
+   * @return the number of locations whose contents are in memory.
+   */
+  unsigned int getNumEntries () const;
+
+
+  /**
+   * @return how many times contents were found in memory.
+   */
+  unsigned int getNumHits () const;
+
+
+  /**
+   * @return how many times contents had to be read or fetched.
+   */
+  unsigned int getNumMisses () const;
+
+
+  /**
+   * Drops all contents kept in memory; the cache directory is kept.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Entry
+  {
+    std::string                      contents;
+    bool                             ready;
+    std::list<std::string>::iterator position;
+  };
+
+  bool getLocationContents (const std::string& location,
+                            std::string* contents);
+
+  bool load (const std::string& location, std::string& contents) const;
+
+  bool fetchUrl (const std::string& url, std::string& contents) const;
+
+  void evict ();
+
+  static bool isUrl (const std::string& location);
+
+  friend struct SedSourceJob;
+
+  SedSourceFetcher*                                mFetcher;
+  unsigned int                                     mNumThreads;
+  size_t                                           mMemoryLimit;
+  size_t                                           mMemoryUsed;
+  std::string                                      mCacheDirectory;
+  std::vector<std::pair<std::string, std::string> > mUrnPrefixes;
+  std::map<std::string, Entry>                     mEntries;
+  std::list<std::string>                           mRecent;
+  unsigned int                                     mNumHits;
+  unsigned int                                     mNumMisses;
+  void*                                            mLock;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedSourceResolver (const SedSourceResolver&);
+  SedSourceResolver& operator= (const SedSourceResolver&);
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedSourcePreparer : public SedModelPreparer
+{
+public:
+
+  /**
+   * Creates a SedSourcePreparer loading the sources of the models of a
+   * document read from @p base through @p resolver and
+   * SedModelPreparer::loadContents() of @p preparer.  Sources the
+   * resolver has no location for are loaded by @p preparer itself.
+   * Neither argument is owned.
+   */
+  SedSourcePreparer (SedSourceResolver& resolver, SedModelPreparer& preparer,
+                     const std::string& base = "");
+
+
+  /**
+   * Destroys this SedSourcePreparer.
+   */
+  virtual ~SedSourcePreparer ();
+
+
+  /**
+   * Loads @p source from the contents the resolver has for it.
+   */
+  virtual void* loadSource (const std::string& source,
+                            const std::string& language);
+
+
+  /**
+   * Applies the changes with the preparer wrapped.
+   */
+  virtual void* applyChanges (const void* model, const SedModel* sedModel);
+
+
+  /**
+   * Releases @p model with the preparer wrapped.
+   */
+  virtual void freeModel (void* model);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedSourceResolver& mResolver;
+  SedModelPreparer&  mPreparer;
+  std::string        mBase;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedSourcePreparer (const SedSourcePreparer&);
+  SedSourcePreparer& operator= (const SedSourcePreparer&);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * The function a SedSourceResolver created by
+ * SedSourceResolver_create() fetches URLs with, as
+ * SedSourceFetcher::fetch().  It sets @p contents and @p newEtag to
+ * strings allocated with @c malloc(), which libSEDML frees, or to
+ * @c NULL, and @p length to the length of the contents.
+ */
+typedef SedFetchStatus_t (*SedSourceResolver_fetchFunc) (const char *url,
+                                                         const char *etag,
+                                                         char **contents,
+                                                         size_t *length,
+                                                         char **newEtag,
+                                                         void *userData);
+
+
+/**
+ * Creates a new SedSourceResolver fetching URLs with @p fetch, if it is
+ * not @c NULL, on @p numThreads threads, and returns it.
+ */
+LIBSEDML_EXTERN
+SedSourceResolver_t *
+SedSourceResolver_create (SedSourceResolver_fetchFunc fetch, void *userData,
+                          unsigned int numThreads);
+
+
+/**
+ * Frees the given SedSourceResolver.
+ */
+LIBSEDML_EXTERN
+void
+SedSourceResolver_free (SedSourceResolver_t *ssr);
+
+
+/**
+ * Sets the directory fetched URLs are kept in, or none if @p directory
+ * is @c NULL or empty.
+ */
+LIBSEDML_EXTERN
+int
+SedSourceResolver_setCacheDirectory (SedSourceResolver_t *ssr,
+                                     const char *directory);
+
+
+/**
+ * Sets the number of bytes of contents kept in memory.
+ */
+LIBSEDML_EXTERN
+int
+SedSourceResolver_setMemoryLimit (SedSourceResolver_t *ssr, size_t bytes);
+
+
+/**
+ * Fetches the sources of all models of @p document, read from @p base.
+ *
+ * @return the number of distinct sources that are now in memory.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSourceResolver_prefetch (SedSourceResolver_t *ssr,
+                            const SedDocument_t *document, const char *base);
+
+
+/**
+ * Returns the contents of @p source, for a document read from @p base,
+ * as a string allocated with @c malloc() that the caller must free, and
+ * sets @p length to their length.
+ *
+ * @return the contents, or @c NULL if they could not be had.
+ */
+LIBSEDML_EXTERN
+char *
+SedSourceResolver_getContents (SedSourceResolver_t *ssr, const char *source,
+                               const char *base, size_t *length);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedSourceResolver_h */
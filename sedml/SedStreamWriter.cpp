@@ -0,0 +1,887 @@
+/**
+ * @file    SedStreamWriter.cpp
+ * @brief   Writes SED-ML element by element, without building a document
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedStreamWriter.h>
+#include <sedml/SedOutputSink.h>
+#include <sedml/SedNamespaces.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedMathCache.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/xml/XMLNamespaces.h>
+
+#include <ostream>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const std::string sSedMLElement("sedML");
+static const std::string sListOfSimulationsElement("listOfSimulations");
+static const std::string sUniformTimeCourseElement("uniformTimeCourse");
+static const std::string sAlgorithmElement("algorithm");
+static const std::string sListOfModelsElement("listOfModels");
+static const std::string sModelElement("model");
+static const std::string sListOfChangesElement("listOfChanges");
+static const std::string sChangeAttributeElement("changeAttribute");
+static const std::string sRemoveXMLElement("removeXML");
+static const std::string sListOfTasksElement("listOfTasks");
+static const std::string sTaskElement("task");
+static const std::string sListOfDataGeneratorsElement("listOfDataGenerators");
+static const std::string sDataGeneratorElement("dataGenerator");
+static const std::string sListOfVariablesElement("listOfVariables");
+static const std::string sVariableElement("variable");
+static const std::string sListOfParametersElement("listOfParameters");
+static const std::string sParameterElement("parameter");
+static const std::string sListOfOutputsElement("listOfOutputs");
+static const std::string sReportElement("report");
+static const std::string sListOfDataSetsElement("listOfDataSets");
+static const std::string sDataSetElement("dataSet");
+static const std::string sPlot2DElement("plot2D");
+static const std::string sListOfCurvesElement("listOfCurves");
+static const std::string sCurveElement("curve");
+static const std::string sPlot3DElement("plot3D");
+static const std::string sListOfSurfacesElement("listOfSurfaces");
+static const std::string sSurfaceElement("surface");
+
+static const std::string sLevelAttribute("level");
+static const std::string sVersionAttribute("version");
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sInitialTimeAttribute("initialTime");
+static const std::string sOutputStartTimeAttribute("outputStartTime");
+static const std::string sOutputEndTimeAttribute("outputEndTime");
+static const std::string sNumberOfPointsAttribute("numberOfPoints");
+static const std::string sKisaoIDAttribute("kisaoID");
+static const std::string sLanguageAttribute("language");
+static const std::string sSourceAttribute("source");
+static const std::string sTargetAttribute("target");
+static const std::string sNewValueAttribute("newValue");
+static const std::string sModelReferenceAttribute("modelReference");
+static const std::string sSimulationReferenceAttribute("simulationReference");
+static const std::string sTaskReferenceAttribute("taskReference");
+static const std::string sSymbolAttribute("symbol");
+static const std::string sValueAttribute("value");
+static const std::string sLabelAttribute("label");
+static const std::string sDataReferenceAttribute("dataReference");
+static const std::string sLogXAttribute("logX");
+static const std::string sLogYAttribute("logY");
+static const std::string sLogZAttribute("logZ");
+static const std::string sXDataReferenceAttribute("xDataReference");
+static const std::string sYDataReferenceAttribute("yDataReference");
+static const std::string sZDataReferenceAttribute("zDataReference");
+
+
+/*
+ * Returns the name of the top-level list of section.
+ */
+static const std::string&
+getListName (int section)
+{
+  switch (section)
+  {
+  case 1:  return sListOfSimulationsElement;
+  case 2:  return sListOfModelsElement;
+  case 3:  return sListOfTasksElement;
+  case 4:  return sListOfDataGeneratorsElement;
+  default: return sListOfOutputsElement;
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedStreamWriter writing to stream.
+ */
+SedStreamWriter::SedStreamWriter (std::ostream& stream, unsigned int level,
+                                  unsigned int version)
+  : mStream (&stream)
+  , mSink (NULL)
+  , mBuffer (NULL)
+  , mBufferStream (NULL)
+  , mXOS (NULL)
+  , mLevel (level)
+  , mVersion (version)
+  , mCompact (false)
+  , mState (BEFORE_DOCUMENT)
+  , mSection (NO_SECTION)
+  , mInList (false)
+  , mElement (NULL)
+  , mChildList (NULL)
+  , mChildRank (0)
+{
+}
+
+
+/*
+ * Creates a new SedStreamWriter writing to sink in chunks of chunkSize
+ * bytes.
+ */
+SedStreamWriter::SedStreamWriter (SedOutputSink& sink, unsigned int level,
+                                  unsigned int version, size_t chunkSize)
+  : mStream (NULL)
+  , mSink (&sink)
+  , mBuffer (new SedSinkStreamBuf(sink, chunkSize))
+  , mBufferStream (NULL)
+  , mXOS (NULL)
+  , mLevel (level)
+  , mVersion (version)
+  , mCompact (false)
+  , mState (BEFORE_DOCUMENT)
+  , mSection (NO_SECTION)
+  , mInList (false)
+  , mElement (NULL)
+  , mChildList (NULL)
+  , mChildRank (0)
+{
+  mBufferStream = new std::ostream(mBuffer);
+  mStream       = mBufferStream;
+}
+
+
+/*
+ * Destroys this SedStreamWriter.
+ */
+SedStreamWriter::~SedStreamWriter ()
+{
+  delete mXOS;
+  delete mBufferStream;
+  delete mBuffer;
+}
+
+
+/*
+ * Sets the name of the program written at the top of the document.
+ */
+int
+SedStreamWriter::setProgramName (const std::string& name)
+{
+  if (mState != BEFORE_DOCUMENT) return LIBSEDML_INVALID_XML_OPERATION;
+
+  mProgramName = name;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the version of the program written at the top of the document.
+ */
+int
+SedStreamWriter::setProgramVersion (const std::string& version)
+{
+  if (mState != BEFORE_DOCUMENT) return LIBSEDML_INVALID_XML_OPERATION;
+
+  mProgramVersion = version;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets whether the document is written without indentation.
+ */
+int
+SedStreamWriter::setCompact (bool compact)
+{
+  if (mState != BEFORE_DOCUMENT) return LIBSEDML_INVALID_XML_OPERATION;
+
+  mCompact = compact;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Writes the XML declaration and opens the sedML element.
+ */
+int
+SedStreamWriter::beginDocument ()
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != BEFORE_DOCUMENT) return LIBSEDML_INVALID_XML_OPERATION;
+
+  // as SedWriter::writeSedML() sets up its stream
+  mXOS = new XMLOutputStream(*mStream, "UTF-8", true, mProgramName,
+                             mProgramVersion);
+  if (mCompact) mXOS->setAutoIndent(false);
+
+  mState = IN_DOCUMENT;
+
+  mXOS->startElement(sSedMLElement, "");
+
+  XMLNamespaces xmlns;
+  xmlns.add(SedNamespaces::getSedNamespaceURI(mLevel, mVersion));
+  *mXOS << xmlns;
+
+  mXOS->writeAttribute(sLevelAttribute, "", SedNumber::toString(mLevel));
+  mXOS->writeAttribute(sVersionAttribute, "", SedNumber::toString(mVersion));
+
+  return done();
+}
+
+
+/*
+ * Closes what is open and ends the document.
+ */
+int
+SedStreamWriter::endDocument ()
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != IN_DOCUMENT) return LIBSEDML_INVALID_XML_OPERATION;
+
+  if (mElement != NULL)
+  {
+    closeChildList();
+    mXOS->endElement(*mElement, "");
+    mElement = NULL;
+  }
+  if (mInList)
+  {
+    mXOS->endElement(getListName(mSection), "");
+    mInList = false;
+  }
+  mXOS->endElement(sSedMLElement, "");
+
+  delete mXOS;
+  mXOS = NULL;
+
+  *mStream << endl;
+
+  int result = done();
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mState = AFTER_DOCUMENT;
+
+  if (mSink != NULL)
+  {
+    const bool flushed = mBuffer->flushChunk();
+
+    // the sink may release what it holds even after a failure
+    if (!mSink->finish() || !flushed)
+    {
+      mState = FAILED;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  }
+  else
+  {
+    mStream->flush();
+    if (!mStream->good())
+    {
+      mState = FAILED;
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+int
+SedStreamWriter::beginListOfSimulations ()
+{
+  return beginList(SIMULATIONS);
+}
+
+
+/*
+ * Writes a uniformTimeCourse.
+ */
+int
+SedStreamWriter::uniformTimeCourse (const std::string& id,
+                                    double initialTime,
+                                    double outputStartTime,
+                                    double outputEndTime,
+                                    int numberOfPoints,
+                                    const std::string& kisaoID)
+{
+  int result = check(SIMULATIONS, NULL);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mXOS->startElement(sUniformTimeCourseElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sInitialTimeAttribute, "",
+                       SedNumber::toString(initialTime));
+  mXOS->writeAttribute(sOutputStartTimeAttribute, "",
+                       SedNumber::toString(outputStartTime));
+  mXOS->writeAttribute(sOutputEndTimeAttribute, "",
+                       SedNumber::toString(outputEndTime));
+  mXOS->writeAttribute(sNumberOfPointsAttribute, "",
+                       SedNumber::toString(numberOfPoints));
+
+  if (!kisaoID.empty())
+  {
+    mXOS->startElement(sAlgorithmElement, "");
+    mXOS->writeAttribute(sKisaoIDAttribute, "", kisaoID);
+    mXOS->endElement(sAlgorithmElement, "");
+  }
+
+  mXOS->endElement(sUniformTimeCourseElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endListOfSimulations ()
+{
+  return endList(SIMULATIONS);
+}
+
+
+int
+SedStreamWriter::beginListOfModels ()
+{
+  return beginList(MODELS);
+}
+
+
+/*
+ * Writes a model without changes.
+ */
+int
+SedStreamWriter::model (const std::string& id, const std::string& language,
+                        const std::string& source)
+{
+  int result = beginModel(id, language, source);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return endModel();
+}
+
+
+/*
+ * Opens a model.
+ */
+int
+SedStreamWriter::beginModel (const std::string& id,
+                             const std::string& language,
+                             const std::string& source)
+{
+  int result = beginElement(MODELS, &sModelElement, id, "");
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mXOS->writeAttribute(sLanguageAttribute, "", language);
+  mXOS->writeAttribute(sSourceAttribute, "", source);
+  return done();
+}
+
+
+/*
+ * Writes a changeAttribute of the open model.
+ */
+int
+SedStreamWriter::changeAttribute (const std::string& target,
+                                  const std::string& newValue)
+{
+  int result = checkChild(&sModelElement, &sListOfChangesElement, 1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfChangesElement, 1);
+  mXOS->startElement(sChangeAttributeElement, "");
+  mXOS->writeAttribute(sTargetAttribute, "", target);
+  mXOS->writeAttribute(sNewValueAttribute, "", newValue);
+  mXOS->endElement(sChangeAttributeElement, "");
+  return done();
+}
+
+
+/*
+ * Writes a removeXML of the open model.
+ */
+int
+SedStreamWriter::removeXML (const std::string& target)
+{
+  int result = checkChild(&sModelElement, &sListOfChangesElement, 1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfChangesElement, 1);
+  mXOS->startElement(sRemoveXMLElement, "");
+  mXOS->writeAttribute(sTargetAttribute, "", target);
+  mXOS->endElement(sRemoveXMLElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endModel ()
+{
+  return endElement(&sModelElement);
+}
+
+
+int
+SedStreamWriter::endListOfModels ()
+{
+  return endList(MODELS);
+}
+
+
+int
+SedStreamWriter::beginListOfTasks ()
+{
+  return beginList(TASKS);
+}
+
+
+/*
+ * Writes a task.
+ */
+int
+SedStreamWriter::task (const std::string& id,
+                       const std::string& modelReference,
+                       const std::string& simulationReference)
+{
+  int result = check(TASKS, NULL);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mXOS->startElement(sTaskElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sModelReferenceAttribute, "", modelReference);
+  mXOS->writeAttribute(sSimulationReferenceAttribute, "",
+                       simulationReference);
+  mXOS->endElement(sTaskElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endListOfTasks ()
+{
+  return endList(TASKS);
+}
+
+
+int
+SedStreamWriter::beginListOfDataGenerators ()
+{
+  return beginList(DATA_GENERATORS);
+}
+
+
+int
+SedStreamWriter::beginDataGenerator (const std::string& id,
+                                     const std::string& name)
+{
+  int result = beginElement(DATA_GENERATORS, &sDataGeneratorElement, id,
+                            name);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return done();
+}
+
+
+/*
+ * Writes a variable of the open data generator.
+ */
+int
+SedStreamWriter::variable (const std::string& id,
+                           const std::string& taskReference,
+                           const std::string& target,
+                           const std::string& symbol)
+{
+  int result = checkChild(&sDataGeneratorElement, &sListOfVariablesElement,
+                          1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfVariablesElement, 1);
+  mXOS->startElement(sVariableElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  if (!symbol.empty())
+  {
+    mXOS->writeAttribute(sSymbolAttribute, "", symbol);
+  }
+  if (!target.empty())
+  {
+    mXOS->writeAttribute(sTargetAttribute, "", target);
+  }
+  mXOS->writeAttribute(sTaskReferenceAttribute, "", taskReference);
+  mXOS->endElement(sVariableElement, "");
+  return done();
+}
+
+
+/*
+ * Writes a parameter of the open data generator.
+ */
+int
+SedStreamWriter::parameter (const std::string& id, double value)
+{
+  int result = checkChild(&sDataGeneratorElement, &sListOfParametersElement,
+                          2);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfParametersElement, 2);
+  mXOS->startElement(sParameterElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sValueAttribute, "", SedNumber::toString(value));
+  mXOS->endElement(sParameterElement, "");
+  return done();
+}
+
+
+/*
+ * Writes the math of the open data generator.
+ */
+int
+SedStreamWriter::math (const ASTNode* math)
+{
+  if (math == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  int result = checkChild(&sDataGeneratorElement, NULL, 3);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  closeChildList();
+  mChildRank = 3;
+
+  SedMathCache::write(math, *mXOS);
+  return done();
+}
+
+
+int
+SedStreamWriter::endDataGenerator ()
+{
+  return endElement(&sDataGeneratorElement);
+}
+
+
+int
+SedStreamWriter::endListOfDataGenerators ()
+{
+  return endList(DATA_GENERATORS);
+}
+
+
+int
+SedStreamWriter::beginListOfOutputs ()
+{
+  return beginList(OUTPUTS);
+}
+
+
+int
+SedStreamWriter::beginReport (const std::string& id, const std::string& name)
+{
+  int result = beginElement(OUTPUTS, &sReportElement, id, name);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return done();
+}
+
+
+/*
+ * Writes a dataSet of the open report.
+ */
+int
+SedStreamWriter::dataSet (const std::string& id, const std::string& label,
+                          const std::string& dataReference)
+{
+  int result = checkChild(&sReportElement, &sListOfDataSetsElement, 1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfDataSetsElement, 1);
+  mXOS->startElement(sDataSetElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sLabelAttribute, "", label);
+  mXOS->writeAttribute(sDataReferenceAttribute, "", dataReference);
+  mXOS->endElement(sDataSetElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endReport ()
+{
+  return endElement(&sReportElement);
+}
+
+
+int
+SedStreamWriter::beginPlot2D (const std::string& id, const std::string& name)
+{
+  int result = beginElement(OUTPUTS, &sPlot2DElement, id, name);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return done();
+}
+
+
+/*
+ * Writes a curve of the open 2D plot.
+ */
+int
+SedStreamWriter::curve (const std::string& id, bool logX, bool logY,
+                        const std::string& xDataReference,
+                        const std::string& yDataReference)
+{
+  int result = checkChild(&sPlot2DElement, &sListOfCurvesElement, 1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfCurvesElement, 1);
+  mXOS->startElement(sCurveElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sLogXAttribute, "", logX);
+  mXOS->writeAttribute(sLogYAttribute, "", logY);
+  mXOS->writeAttribute(sXDataReferenceAttribute, "", xDataReference);
+  mXOS->writeAttribute(sYDataReferenceAttribute, "", yDataReference);
+  mXOS->endElement(sCurveElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endPlot2D ()
+{
+  return endElement(&sPlot2DElement);
+}
+
+
+int
+SedStreamWriter::beginPlot3D (const std::string& id, const std::string& name)
+{
+  int result = beginElement(OUTPUTS, &sPlot3DElement, id, name);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  return done();
+}
+
+
+/*
+ * Writes a surface of the open 3D plot.
+ */
+int
+SedStreamWriter::surface (const std::string& id, bool logX, bool logY,
+                          bool logZ, const std::string& xDataReference,
+                          const std::string& yDataReference,
+                          const std::string& zDataReference)
+{
+  int result = checkChild(&sPlot3DElement, &sListOfSurfacesElement, 1);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  openChildList(&sListOfSurfacesElement, 1);
+  mXOS->startElement(sSurfaceElement, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  mXOS->writeAttribute(sLogXAttribute, "", logX);
+  mXOS->writeAttribute(sLogYAttribute, "", logY);
+  mXOS->writeAttribute(sLogZAttribute, "", logZ);
+  mXOS->writeAttribute(sXDataReferenceAttribute, "", xDataReference);
+  mXOS->writeAttribute(sYDataReferenceAttribute, "", yDataReference);
+  mXOS->writeAttribute(sZDataReferenceAttribute, "", zDataReference);
+  mXOS->endElement(sSurfaceElement, "");
+  return done();
+}
+
+
+int
+SedStreamWriter::endPlot3D ()
+{
+  return endElement(&sPlot3DElement);
+}
+
+
+int
+SedStreamWriter::endListOfOutputs ()
+{
+  return endList(OUTPUTS);
+}
+
+
+/*
+ * Returns true once the output has failed.
+ */
+bool
+SedStreamWriter::hasFailed () const
+{
+  return mState == FAILED;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns success if the list of section is open and the element given,
+ * or none if element is NULL, is open in it.
+ */
+int
+SedStreamWriter::check (Section section, const std::string* element) const
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != IN_DOCUMENT || !mInList || mSection != section
+    || mElement != element)
+  {
+    return LIBSEDML_INVALID_XML_OPERATION;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns success if element is open and a child of list, the list of its
+ * children of the given rank, may be written now: list is open already,
+ * or no list of the same or a later rank has been.
+ */
+int
+SedStreamWriter::checkChild (const std::string* element,
+                             const std::string* list,
+                             unsigned int rank) const
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != IN_DOCUMENT || !mInList || mElement != element)
+  {
+    return LIBSEDML_INVALID_XML_OPERATION;
+  }
+
+  if (list != NULL && mChildList == list) return LIBSEDML_OPERATION_SUCCESS;
+  if (rank <= mChildRank) return LIBSEDML_INVALID_XML_OPERATION;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Opens the top-level list of section.
+ */
+int
+SedStreamWriter::beginList (Section section)
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != IN_DOCUMENT || mInList || section <= mSection)
+  {
+    return LIBSEDML_INVALID_XML_OPERATION;
+  }
+
+  mXOS->startElement(getListName(section), "");
+  mSection = section;
+  mInList  = true;
+  return done();
+}
+
+
+/*
+ * Closes the top-level list of section.
+ */
+int
+SedStreamWriter::endList (Section section)
+{
+  int result = check(section, NULL);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mXOS->endElement(getListName(section), "");
+  mInList = false;
+  return done();
+}
+
+
+/*
+ * Opens element in the top-level list of section and writes its id and,
+ * if not empty, its name; the caller writes the other attributes.
+ */
+int
+SedStreamWriter::beginElement (Section section, const std::string* element,
+                               const std::string& id,
+                               const std::string& name)
+{
+  int result = check(section, NULL);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mXOS->startElement(*element, "");
+  mXOS->writeAttribute(sIdAttribute, "", id);
+  if (!name.empty())
+  {
+    mXOS->writeAttribute(sNameAttribute, "", name);
+  }
+
+  mElement   = element;
+  mChildList = NULL;
+  mChildRank = 0;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Closes element, and the list of its children that is open.
+ */
+int
+SedStreamWriter::endElement (const std::string* element)
+{
+  if (mState == FAILED) return LIBSEDML_OPERATION_FAILED;
+  if (mState != IN_DOCUMENT || mElement != element)
+  {
+    return LIBSEDML_INVALID_XML_OPERATION;
+  }
+
+  closeChildList();
+  mXOS->endElement(*element, "");
+  mElement = NULL;
+  return done();
+}
+
+
+/*
+ * Makes list, of the given rank, the open list of children.
+ */
+void
+SedStreamWriter::openChildList (const std::string* list, unsigned int rank)
+{
+  if (mChildList == list) return;
+
+  closeChildList();
+  mXOS->startElement(*list, "");
+  mChildList = list;
+  mChildRank = rank;
+}
+
+
+/*
+ * Closes the open list of children, if any.
+ */
+void
+SedStreamWriter::closeChildList ()
+{
+  if (mChildList == NULL) return;
+
+  mXOS->endElement(*mChildList, "");
+  mChildList = NULL;
+}
+
+
+/*
+ * Returns success, or marks the writer failed if the stream has.
+ */
+int
+SedStreamWriter::done ()
+{
+  if (mStream->fail())
+  {
+    mState = FAILED;
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
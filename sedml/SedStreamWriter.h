@@ -0,0 +1,577 @@
+/**
+ * @file    SedStreamWriter.h
+ * @brief   Writes SED-ML element by element, without building a document
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedStreamWriter
+ * @ingroup Core
+ * @brief Writes a SED-ML document as it is described, one element at a
+ * time.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedStreamWriter writes the XML of every element as soon as it is
+ * given, to a std::ostream or, in chunks, to a SedOutputSink, and keeps
+ * nothing of it: generating a sweep of a million tasks takes as little
+ * memory as generating one, where a SedDocument would hold every task
+ * until SedWriter::writeSedML() is called.
+ *
+ * @code{.cpp}
+ * SedFileSink file("sweep.sedml");
+ * SedStreamWriter out(file);
+ * out.beginDocument();
+ * out.beginListOfSimulations();
+ * out.uniformTimeCourse("sim", 0, 0, 10, 100, "KISAO:0000019");
+ * out.endListOfSimulations();
+ * out.beginListOfModels();
+ * out.model("model", "urn:sedml:language:sbml", "model.xml");
+ * out.endListOfModels();
+ * out.beginListOfTasks();
+ * for (unsigned int i = 0; i < n; ++i)
+ *   out.task("task" + SedNumber::toString(i), "model", "sim");
+ * out.endListOfTasks();
+ * out.endDocument();
+ * @endcode
+ *
+ * The top-level lists must be written in the order of the schema,
+ * simulations, models, tasks, data generators and outputs, each at most
+ * once; any of them may be left out.  Within an element, the lists of
+ * its children are opened and closed as needed, and must also be written
+ * in order: the variables of a data generator before its parameters, and
+ * both before its math.  A call made out of order writes nothing and
+ * returns @c LIBSEDML_INVALID_XML_OPERATION, leaving the writer as it
+ * was.  Once the output has failed, every call returns
+ * @c LIBSEDML_OPERATION_FAILED.
+ *
+ * Attribute values are formatted as SedWriter formats those of the
+ * objects of a SedDocument, with SedNumber::toString() for numbers, and
+ * math is written with SedMathCache::write(), so that a document written
+ * here reads back into the SedDocument that would write the same XML.
+ *
+ * Nothing is checked but the order of the elements: ids are not checked
+ * to be unique, nor references to exist.
+ */
+
+#ifndef SedStreamWriter_h
+#define SedStreamWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/math/ASTNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedOutputSink;
+class SedSinkStreamBuf;
+
+
+class LIBSEDML_EXTERN SedStreamWriter
+{
+public:
+
+  /**
+   * Creates a new SedStreamWriter writing a document of the given
+   * @p level and @p version to @p stream, which it does not own.
+   */
+  SedStreamWriter (std::ostream& stream, unsigned int level = 1,
+                   unsigned int version = 1);
+
+
+  /**
+   * Creates a new SedStreamWriter writing a document of the given
+   * @p level and @p version to @p sink, which it does not own, in chunks
+   * of @p chunkSize bytes.  endDocument() finishes the sink.
+   */
+  SedStreamWriter (SedOutputSink& sink, unsigned int level = 1,
+                   unsigned int version = 1, size_t chunkSize = 64 * 1024);
+
+
+  /**
+   * Destroys this SedStreamWriter.  A document not ended with
+   * endDocument() is left unfinished.
+   */
+  virtual ~SedStreamWriter ();
+
+
+  /**
+   * Sets the name of the program written in the comment at the top of the
+   * document, as SedWriter::setProgramName(); only before beginDocument().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_XML_OPERATION LIBSEDML_INVALID_XML_OPERATION @endlink
+   */
+  int setProgramName (const std::string& name);
+
+
+  /**
+   * Sets the version of the program written in the comment at the top of
+   * the document, as SedWriter::setProgramVersion(); only before
+   * beginDocument().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_XML_OPERATION LIBSEDML_INVALID_XML_OPERATION @endlink
+   */
+  int setProgramVersion (const std::string& version);
+
+
+  /**
+   * Sets whether the document is written without indentation, as
+   * SedWriter::setCompact(); only before beginDocument().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_XML_OPERATION LIBSEDML_INVALID_XML_OPERATION @endlink
+   */
+  int setCompact (bool compact);
+
+
+  /**
+   * Writes the XML declaration and opens the <code>&lt;sedML&gt;</code>
+   * element.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_XML_OPERATION LIBSEDML_INVALID_XML_OPERATION @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int beginDocument ();
+
+
+  /**
+   * Closes what is open, ends the document and, writing to a sink,
+   * passes the rest of the output on and finishes the sink.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_XML_OPERATION LIBSEDML_INVALID_XML_OPERATION @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  int endDocument ();
+
+
+  /**
+   * Opens the <code>&lt;listOfSimulations&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginListOfSimulations ();
+
+
+  /**
+   * Writes a <code>&lt;uniformTimeCourse&gt;</code> simulating with the
+   * algorithm @p kisaoID, if it is not empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int uniformTimeCourse (const std::string& id, double initialTime,
+                         double outputStartTime, double outputEndTime,
+                         int numberOfPoints, const std::string& kisaoID);
+
+
+  /**
+   * Closes the <code>&lt;listOfSimulations&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endListOfSimulations ();
+
+
+  /**
+   * Opens the <code>&lt;listOfModels&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginListOfModels ();
+
+
+  /**
+   * Writes a <code>&lt;model&gt;</code> without changes.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int model (const std::string& id, const std::string& language,
+             const std::string& source);
+
+
+  /**
+   * Opens a <code>&lt;model&gt;</code>, whose changes follow.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginModel (const std::string& id, const std::string& language,
+                  const std::string& source);
+
+
+  /**
+   * Writes a <code>&lt;changeAttribute&gt;</code> of the open model.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int changeAttribute (const std::string& target,
+                       const std::string& newValue);
+
+
+  /**
+   * Writes a <code>&lt;removeXML&gt;</code> of the open model.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int removeXML (const std::string& target);
+
+
+  /**
+   * Closes the open <code>&lt;model&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endModel ();
+
+
+  /**
+   * Closes the <code>&lt;listOfModels&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endListOfModels ();
+
+
+  /**
+   * Opens the <code>&lt;listOfTasks&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginListOfTasks ();
+
+
+  /**
+   * Writes a <code>&lt;task&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int task (const std::string& id, const std::string& modelReference,
+            const std::string& simulationReference);
+
+
+  /**
+   * Closes the <code>&lt;listOfTasks&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endListOfTasks ();
+
+
+  /**
+   * Opens the <code>&lt;listOfDataGenerators&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginListOfDataGenerators ();
+
+
+  /**
+   * Opens a <code>&lt;dataGenerator&gt;</code>, whose variables,
+   * parameters and math follow.  @p name is left out if empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginDataGenerator (const std::string& id,
+                          const std::string& name = "");
+
+
+  /**
+   * Writes a <code>&lt;variable&gt;</code> of the open data generator;
+   * @p target and @p symbol are left out if empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int variable (const std::string& id, const std::string& taskReference,
+                const std::string& target, const std::string& symbol = "");
+
+
+  /**
+   * Writes a <code>&lt;parameter&gt;</code> of the open data generator.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int parameter (const std::string& id, double value);
+
+
+  /**
+   * Writes the <code>&lt;math&gt;</code> of the open data generator.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_OBJECT if @p math is @c NULL,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int math (const ASTNode* math);
+
+
+  /**
+   * Closes the open <code>&lt;dataGenerator&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endDataGenerator ();
+
+
+  /**
+   * Closes the <code>&lt;listOfDataGenerators&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endListOfDataGenerators ();
+
+
+  /**
+   * Opens the <code>&lt;listOfOutputs&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginListOfOutputs ();
+
+
+  /**
+   * Opens a <code>&lt;report&gt;</code>, whose data sets follow.
+   * @p name is left out if empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginReport (const std::string& id, const std::string& name = "");
+
+
+  /**
+   * Writes a <code>&lt;dataSet&gt;</code> of the open report.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int dataSet (const std::string& id, const std::string& label,
+               const std::string& dataReference);
+
+
+  /**
+   * Closes the open <code>&lt;report&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endReport ();
+
+
+  /**
+   * Opens a <code>&lt;plot2D&gt;</code>, whose curves follow.  @p name is
+   * left out if empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginPlot2D (const std::string& id, const std::string& name = "");
+
+
+  /**
+   * Writes a <code>&lt;curve&gt;</code> of the open 2D plot.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int curve (const std::string& id, bool logX, bool logY,
+             const std::string& xDataReference,
+             const std::string& yDataReference);
+
+
+  /**
+   * Closes the open <code>&lt;plot2D&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endPlot2D ();
+
+
+  /**
+   * Opens a <code>&lt;plot3D&gt;</code>, whose surfaces follow.  @p name
+   * is left out if empty.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int beginPlot3D (const std::string& id, const std::string& name = "");
+
+
+  /**
+   * Writes a <code>&lt;surface&gt;</code> of the open 3D plot.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int surface (const std::string& id, bool logX, bool logY, bool logZ,
+               const std::string& xDataReference,
+               const std::string& yDataReference,
+               const std::string& zDataReference);
+
+
+  /**
+   * Closes the open <code>&lt;plot3D&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endPlot3D ();
+
+
+  /**
+   * Closes the <code>&lt;listOfOutputs&gt;</code>.
+   *
+   * @return @c LIBSEDML_OPERATION_SUCCESS,
+   * @c LIBSEDML_INVALID_XML_OPERATION or @c LIBSEDML_OPERATION_FAILED.
+   */
+  int endListOfOutputs ();
+
+
+  /**
+   * @return @c true once the output has failed.
+   */
+  bool hasFailed () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  /*
+   * Where the writer is: before the document, in it, after it, or failed.
+   */
+  enum State
+  {
+    BEFORE_DOCUMENT,
+    IN_DOCUMENT,
+    AFTER_DOCUMENT,
+    FAILED
+  };
+
+  /*
+   * The top-level lists, in the order they must be written in.
+   */
+  enum Section
+  {
+    NO_SECTION,
+    SIMULATIONS,
+    MODELS,
+    TASKS,
+    DATA_GENERATORS,
+    OUTPUTS
+  };
+
+  int check (Section section, const std::string* element) const;
+
+  int checkChild (const std::string* element, const std::string* list,
+                  unsigned int rank) const;
+
+  int beginList (Section section);
+
+  int endList (Section section);
+
+  int beginElement (Section section, const std::string* element,
+                    const std::string& id, const std::string& name);
+
+  int endElement (const std::string* element);
+
+  void openChildList (const std::string* list, unsigned int rank);
+
+  void closeChildList ();
+
+  int done ();
+
+
+  std::ostream*       mStream;
+  SedOutputSink*      mSink;
+  SedSinkStreamBuf*   mBuffer;
+  std::ostream*       mBufferStream;
+  XMLOutputStream*    mXOS;
+
+  unsigned int        mLevel;
+  unsigned int        mVersion;
+  std::string         mProgramName;
+  std::string         mProgramVersion;
+  bool                mCompact;
+
+  State               mState;
+  Section             mSection;
+  bool                mInList;
+  const std::string*  mElement;
+  const std::string*  mChildList;
+  unsigned int        mChildRank;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedStreamWriter (const SedStreamWriter& orig);
+  SedStreamWriter& operator= (const SedStreamWriter& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedStreamWriter_h */
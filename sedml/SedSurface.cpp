@@ -52,6 +52,7 @@ SedSurface::SedSurface (unsigned int level, unsigned int version)
 	, mLogZ (false)
 	, mIsSetLogZ (false)
 	, mZDataReference ("")
+	, mReferencedZDataGenerator (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -67,6 +68,7 @@ SedSurface::SedSurface (SedNamespaces* sedns)
 	, mLogZ (false)
 	, mIsSetLogZ (false)
 	, mZDataReference ("")
+	, mReferencedZDataGenerator (NULL)
 
 {
 	// set the element namespace of this object
@@ -89,6 +91,7 @@ SedSurface::SedSurface (const SedSurface& orig)
 		mLogZ  = orig.mLogZ;
 		mIsSetLogZ  = orig.mIsSetLogZ;
 		mZDataReference  = orig.mZDataReference;
+		mReferencedZDataGenerator  = NULL;
 	}
 }
 
@@ -109,6 +112,7 @@ SedSurface::operator=(const SedSurface& rhs)
 		mLogZ  = rhs.mLogZ;
 		mIsSetLogZ  = rhs.mIsSetLogZ;
 		mZDataReference  = rhs.mZDataReference;
+		mReferencedZDataGenerator  = NULL;
 	}
 	return *this;
 }
@@ -178,6 +182,8 @@ SedSurface::isSetZDataReference() const
 int
 SedSurface::setLogZ(bool logZ)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogZ = logZ;
 	mIsSetLogZ = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -190,6 +196,8 @@ SedSurface::setLogZ(bool logZ)
 int
 SedSurface::setZDataReference(const std::string& zDataReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(zDataReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -201,6 +209,7 @@ SedSurface::setZDataReference(const std::string& zDataReference)
 	else
 	{
 		mZDataReference = zDataReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -212,6 +221,8 @@ SedSurface::setZDataReference(const std::string& zDataReference)
 int
 SedSurface::unsetLogZ()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mLogZ = false;
 	mIsSetLogZ = false;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -224,7 +235,10 @@ SedSurface::unsetLogZ()
 int
 SedSurface::unsetZDataReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mZDataReference.erase();
+	notifyReferencesChanged();
 
 	if (mZDataReference.empty() == true)
 	{
@@ -237,14 +251,45 @@ SedSurface::unsetZDataReference()
 }
 
 
+/*
+ * Returns the SedDataGenerator referenced by the "zDataReference" attribute.
+ */
+SedDataGenerator*
+SedSurface::getReferencedZDataGenerator()
+{
+	updateReferences();
+	return mReferencedZDataGenerator;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Resolves the reference attributes of this SedSurface against the document.
+ */
+void
+SedSurface::lookupReferences(SedDocument* doc)
+{
+	SedCurve::lookupReferences(doc);
+
+	mReferencedZDataGenerator = (doc != NULL && isSetZDataReference())
+		? doc->getDataGenerator(mZDataReference) : NULL;
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sSedSurfaceName("surface");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedSurface::getElementName () const
 {
-	static const string name = "surface";
-	return name;
+	return sSedSurfaceName;
 }
 
 
@@ -258,8 +303,6 @@ SedSurface::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedCurve::connectToChild();
-
 	return object;
 }
 
@@ -310,13 +353,12 @@ SedSurface::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedSurface::accept (SedVisitor& v) const
+SedSurface::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -369,15 +411,24 @@ SedSurface::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "logZ", 0xb8029451u },
+		{ "zDataReference", 0x40ab6a42u }
+	};
+	int index[2];
+	findAttributes(attributes, names, 2, index);
+
 	//
 	// logZ bool   ( use = "required" )
 	//
-	mIsSetLogZ = attributes.readInto("logZ", mLogZ, getErrorLog(), true);
+	mIsSetLogZ = readAttribute(attributes, index[0], "logZ", mLogZ, true);
 
 	//
 	// zDataReference SIdRef   ( use = "required" )
 	//
-	assigned = attributes.readInto("zDataReference", mZDataReference, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[1], "zDataReference", mZDataReference, true);
 
 	if (assigned == true)
 	{
@@ -399,6 +450,10 @@ SedSurface::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sLogZAttribute("logZ");
+static const std::string sZDataReferenceAttribute("zDataReference");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -409,11 +464,33 @@ SedSurface::writeAttributes (XMLOutputStream& stream) const
 {
 	SedCurve::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetLogZ() == true)
-		stream.writeAttribute("logZ", getPrefix(), mLogZ);
+		stream.writeAttribute(sLogZAttribute, prefix, mLogZ);
 
 	if (isSetZDataReference() == true)
-		stream.writeAttribute("zDataReference", getPrefix(), mZDataReference);
+		stream.writeAttribute(sZDataReferenceAttribute, prefix, mZDataReference);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedSurface::addAttributes (XMLAttributes& attributes) const
+{
+	SedCurve::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetLogZ() == true)
+		addAttribute(attributes, sLogZAttribute, prefix, mLogZ ? "true" : "false");
+
+	if (isSetZDataReference() == true)
+		addAttribute(attributes, sZDataReferenceAttribute, prefix, mZDataReference);
 
 }
 
@@ -489,10 +566,7 @@ SedListOfSurfaces::get(const std::string& sid)
 const SedSurface*
 SedListOfSurfaces::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedSurface>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedSurface*> (*result);
+	return static_cast <const SedSurface*> (getItemById(sid));
 }
 
 
@@ -517,6 +591,17 @@ SedListOfSurfaces::addSurface(const SedSurface* ss)
 }
 
 
+/*
+ * Adds the given SedSurface to this SedListOfSurfaces, which takes ownership of it.
+ */
+int
+SedListOfSurfaces::addSurfaceAndOwn(SedSurface* ss)
+{
+	if(ss == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(ss);
+}
+
+
 /**
  * Get the number of SedSurface objects in this SedListOfSurfaces.
  *
@@ -539,7 +624,8 @@ SedListOfSurfaces::getNumSurfaces() const
 SedSurface* 
 SedListOfSurfaces::createSurface()
 {
-	SedSurface *temp = new SedSurface();
+	if (isFrozen()) return NULL;
+	SedSurface *temp = new (getArena()) SedSurface();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -560,19 +646,11 @@ SedListOfSurfaces::remove(unsigned int n)
 SedSurface*
 SedListOfSurfaces::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
+	return static_cast <SedSurface*> (removeItemById(sid));
+}
 
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedSurface>(sid) );
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
-
-	return static_cast <SedSurface*> (item);
-}
+static const std::string sSedListOfSurfacesName("listOfSurfaces");
 
 
 /*
@@ -581,8 +659,7 @@ SedListOfSurfaces::remove(const std::string& sid)
 const std::string&
 SedListOfSurfaces::getElementName () const
 {
-	static const string name = "listOfSurfaces";
-	return name;
+	return sSedListOfSurfacesName;
 }
 
 
@@ -619,7 +696,7 @@ SedListOfSurfaces::createObject(XMLInputStream& stream)
 
 	if (name == "surface")
 	{
-		object = new SedSurface(getSedNamespaces());
+		object = new (getArena()) SedSurface(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -644,7 +721,8 @@ SedListOfSurfaces::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -723,6 +801,20 @@ SedSurface_getZDataReference(SedSurface_t * ss)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedSurface_getZDataReferenceView(const SedSurface_t * ss)
+{
+	if (ss == NULL)
+		return NULL;
+
+	return ss->getZDataReference().empty() ? NULL : ss->getZDataReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -789,6 +881,17 @@ SedSurface_unsetZDataReference(SedSurface_t * ss)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedSurface_getReferencedZDataGenerator(SedSurface_t * ss)
+{
+	return (ss != NULL) ? ss->getReferencedZDataGenerator() : NULL;
+}
+
+
 /**
  * write comments
  */
@@ -64,8 +64,9 @@ class LIBSEDML_EXTERN SedSurface : public SedCurve
 protected:
 
 	bool          mLogZ;
-	bool          mIsSetLogZ;
-	std::string   mZDataReference;
+	bool          mIsSetLogZ : 1;
+	SedSymbol   mZDataReference;
+	SedDataGenerator*   mReferencedZDataGenerator;
 
 
 public:
@@ -214,6 +215,18 @@ public:
 	virtual int unsetZDataReference();
 
 
+	/**
+	 * Returns the SedDataGenerator that the "zDataReference" attribute of this SedSurface
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedDataGenerator.
+	 */
+	SedDataGenerator* getReferencedZDataGenerator();
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedSurface, is
 	 * always @c "sedSurface".
@@ -286,9 +299,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -307,6 +320,17 @@ public:
 
 protected:
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Resolves the reference attributes of this SedSurface against @p doc.
+	 */
+	virtual void lookupReferences(SedDocument* doc);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 /** @cond doxygen-libsbml-internal */
 
 	/**
@@ -349,6 +373,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -463,6 +494,25 @@ public:
 	int addSurface(const SedSurface* s);
 
 
+	/**
+	 * Adds the given "SedSurface" to this SedListOfSurfaces without copying it; this
+	 * SedListOfSurfaces takes ownership of @p s and will delete it.
+	 *
+	 * @param s the SedSurface object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p s is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addSurface(const SedSurface* s)
+	 */
+	int addSurfaceAndOwn(SedSurface* s);
+
+
 	/**
 	 * Get the number of Surface objects in this SedListOfSurfaces.
 	 *
@@ -650,6 +700,11 @@ char *
 SedSurface_getZDataReference(SedSurface_t * ss);
 
 
+LIBSEDML_EXTERN
+const char *
+SedSurface_getZDataReferenceView(const SedSurface_t * ss);
+
+
 LIBSEDML_EXTERN
 int
 SedSurface_isSetLogZ(SedSurface_t * ss);
@@ -680,6 +735,11 @@ int
 SedSurface_unsetZDataReference(SedSurface_t * ss);
 
 
+LIBSEDML_EXTERN
+SedDataGenerator_t *
+SedSurface_getReferencedZDataGenerator(SedSurface_t * ss);
+
+
 LIBSEDML_EXTERN
 int
 SedSurface_hasRequiredAttributes(SedSurface_t * ss);
@@ -0,0 +1,476 @@
+/**
+ * @file    SedSurfaceGrid.cpp
+ * @brief   Arranges the values of a surface into a tiled grid
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSurfaceGrid.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedSurface.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Returns true if value is neither NaN nor infinite.
+ */
+static bool
+isFinite (double value)
+{
+  return value - value == 0;
+}
+
+
+/*
+ * Sets values to the distinct finite values of the length values, in
+ * increasing order.
+ */
+static void
+getDistinct (const double* data, size_t length, std::vector<double>& values)
+{
+  values.clear();
+  values.reserve(length);
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (isFinite(data[i])) values.push_back(data[i]);
+  }
+
+  sort(values.begin(), values.end());
+  values.erase(unique(values.begin(), values.end()), values.end());
+}
+
+
+/*
+ * Returns the position of value, which is among values.
+ */
+static size_t
+getPosition (const std::vector<double>& values, double value)
+{
+  return (size_t)(lower_bound(values.begin(), values.end(), value)
+                  - values.begin());
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedSurfaceGrid.
+ */
+SedSurfaceGrid::SedSurfaceGrid (unsigned int tileSize)
+  : mTileSize ((tileSize == 0) ? 1 : tileSize)
+  , mLogZ (false)
+  , mX ()
+  , mY ()
+  , mLevels ()
+{
+}
+
+
+/*
+ * Destroys this SedSurfaceGrid.
+ */
+SedSurfaceGrid::~SedSurfaceGrid ()
+{
+}
+
+
+/*
+ * Returns the number of cells a side of a tile.
+ */
+unsigned int
+SedSurfaceGrid::getTileSize () const
+{
+  return mTileSize;
+}
+
+
+/*
+ * Arranges the columns of surface into the grid.
+ */
+int
+SedSurfaceGrid::build (const SedResults& results, const SedSurface* surface,
+                       unsigned int numLevels)
+{
+  clear();
+  if (surface == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  const SedColumnView xs = results.getXView(surface);
+  const SedColumnView ys = results.getYView(surface);
+  const SedColumnView zs = results.getZView(surface);
+  if (xs.data == NULL || ys.data == NULL || zs.data == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  size_t length = (xs.length < ys.length) ? xs.length : ys.length;
+  if (zs.length < length) length = zs.length;
+
+  return build(xs.data, ys.data, zs.data, length, surface->getLogZ(),
+               numLevels);
+}
+
+
+/*
+ * Arranges the length points (x[i], y[i], z[i]) into the grid.
+ */
+int
+SedSurfaceGrid::build (const double* x, const double* y, const double* z,
+                       size_t length, bool logZ, unsigned int numLevels)
+{
+  clear();
+  if (length != 0 && (x == NULL || y == NULL || z == NULL))
+    return LIBSEDML_INVALID_OBJECT;
+
+  mLogZ = logZ;
+  getDistinct(x, length, mX);
+  getDistinct(y, length, mY);
+  if (mX.empty() || mY.empty()) return LIBSEDML_OPERATION_SUCCESS;
+
+  size_t numColumns = mX.size();
+  size_t numRows    = mY.size();
+  std::vector<double> cells(numColumns * numRows,
+                            numeric_limits<double>::quiet_NaN());
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (!isFinite(x[i]) || !isFinite(y[i])) continue;
+    cells[getPosition(mY, y[i]) * numColumns + getPosition(mX, x[i])] = z[i];
+  }
+
+  addLevel(cells, numColumns, numRows);
+
+  // every further level halves the one before, until one fits into a tile
+  // or there are as many as were asked for
+  std::vector<double> coarse;
+  while ((numColumns > mTileSize || numRows > mTileSize)
+         && (numLevels == 0 || mLevels.size() < numLevels))
+  {
+    const size_t columns = (numColumns + 1) / 2;
+    const size_t rows    = (numRows + 1) / 2;
+    coarse.assign(columns * rows, numeric_limits<double>::quiet_NaN());
+
+    for (size_t r = 0; r < rows; ++r)
+    {
+      for (size_t c = 0; c < columns; ++c)
+      {
+        double sum   = 0;
+        size_t count = 0;
+        for (size_t row = 2 * r; row < 2 * r + 2 && row < numRows; ++row)
+        {
+          for (size_t column = 2 * c;
+               column < 2 * c + 2 && column < numColumns; ++column)
+          {
+            const double value = cells[row * numColumns + column];
+            if (!isFinite(value) || (mLogZ && value <= 0)) continue;
+            sum += mLogZ ? log10(value) : value;
+            ++count;
+          }
+        }
+
+        if (count == 0) continue;
+        coarse[r * columns + c] = mLogZ ? pow(10.0, sum / count) : sum / count;
+      }
+    }
+
+    cells.swap(coarse);
+    numColumns = columns;
+    numRows    = rows;
+    addLevel(cells, numColumns, numRows);
+  }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Empties this SedSurfaceGrid.
+ */
+void
+SedSurfaceGrid::clear ()
+{
+  mLogZ = false;
+  mX.clear();
+  mY.clear();
+  mLevels.clear();
+}
+
+
+/*
+ * Returns the number of levels of the grid.
+ */
+unsigned int
+SedSurfaceGrid::getNumLevels () const
+{
+  return (unsigned int)mLevels.size();
+}
+
+
+/*
+ * Returns the number of columns of cells of the given level.
+ */
+size_t
+SedSurfaceGrid::getNumColumns (unsigned int level) const
+{
+  const Level* grid = getLevel(level);
+  return (grid != NULL) ? grid->numColumns : 0;
+}
+
+
+/*
+ * Returns the number of rows of cells of the given level.
+ */
+size_t
+SedSurfaceGrid::getNumRows (unsigned int level) const
+{
+  const Level* grid = getLevel(level);
+  return (grid != NULL) ? grid->numRows : 0;
+}
+
+
+/*
+ * Returns the number of columns of tiles of the given level.
+ */
+size_t
+SedSurfaceGrid::getNumTileColumns (unsigned int level) const
+{
+  const Level* grid = getLevel(level);
+  return (grid != NULL) ? grid->numTileColumns : 0;
+}
+
+
+/*
+ * Returns the number of rows of tiles of the given level.
+ */
+size_t
+SedSurfaceGrid::getNumTileRows (unsigned int level) const
+{
+  const Level* grid = getLevel(level);
+  return (grid != NULL) ? grid->numTileRows : 0;
+}
+
+
+/*
+ * Returns the values of a tile of the given level.
+ */
+const double*
+SedSurfaceGrid::getTile (unsigned int level, size_t tileColumn,
+                         size_t tileRow) const
+{
+  const Level* grid = getLevel(level);
+  if (grid == NULL || tileColumn >= grid->numTileColumns
+      || tileRow >= grid->numTileRows)
+    return NULL;
+
+  const size_t tileCells = (size_t)mTileSize * mTileSize;
+  return &grid->tiles[(tileRow * grid->numTileColumns + tileColumn)
+                      * tileCells];
+}
+
+
+/*
+ * Returns the value of a cell of the given level.
+ */
+double
+SedSurfaceGrid::getValue (unsigned int level, size_t column,
+                          size_t row) const
+{
+  const Level* grid = getLevel(level);
+  if (grid == NULL || column >= grid->numColumns || row >= grid->numRows)
+    return numeric_limits<double>::quiet_NaN();
+
+  const double* tile = getTile(level, column / mTileSize, row / mTileSize);
+  return tile[(row % mTileSize) * mTileSize + column % mTileSize];
+}
+
+
+/*
+ * Returns the x value of the given column of the first level.
+ */
+double
+SedSurfaceGrid::getX (size_t column) const
+{
+  return (column < mX.size()) ? mX[column]
+                              : numeric_limits<double>::quiet_NaN();
+}
+
+
+/*
+ * Returns the y value of the given row of the first level.
+ */
+double
+SedSurfaceGrid::getY (size_t row) const
+{
+  return (row < mY.size()) ? mY[row] : numeric_limits<double>::quiet_NaN();
+}
+
+
+/*
+ * Returns true if the levels average the logarithms of the values.
+ */
+bool
+SedSurfaceGrid::isLogZ () const
+{
+  return mLogZ;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Adds a level holding the numColumns * numRows cells, row after row,
+ * copied into tiles.
+ */
+void
+SedSurfaceGrid::addLevel (const std::vector<double>& cells,
+                          size_t numColumns, size_t numRows)
+{
+  mLevels.push_back(Level());
+  Level& grid = mLevels.back();
+
+  const size_t size = mTileSize;
+  grid.numColumns     = numColumns;
+  grid.numRows        = numRows;
+  grid.numTileColumns = (numColumns + size - 1) / size;
+  grid.numTileRows    = (numRows + size - 1) / size;
+  grid.tiles.assign(grid.numTileColumns * grid.numTileRows * size * size,
+                    numeric_limits<double>::quiet_NaN());
+
+  // copies a row of a tile at a time
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    const size_t tileRow = row / size;
+    for (size_t tileColumn = 0; tileColumn < grid.numTileColumns;
+         ++tileColumn)
+    {
+      const size_t first = tileColumn * size;
+      const size_t count = (first + size <= numColumns)
+                           ? size : numColumns - first;
+      double* out = &grid.tiles[((tileRow * grid.numTileColumns + tileColumn)
+                                 * size + row % size) * size];
+      copy(cells.begin() + row * numColumns + first,
+           cells.begin() + row * numColumns + first + count, out);
+    }
+  }
+}
+
+
+/*
+ * Returns the given level, or NULL if there is none.
+ */
+const SedSurfaceGrid::Level*
+SedSurfaceGrid::getLevel (unsigned int level) const
+{
+  return (level < mLevels.size()) ? &mLevels[level] : NULL;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new, empty SedSurfaceGrid and returns it.
+ */
+LIBSEDML_EXTERN
+SedSurfaceGrid_t *
+SedSurfaceGrid_create (unsigned int tileSize)
+{
+  return new (nothrow) SedSurfaceGrid(tileSize);
+}
+
+
+/**
+ * Frees the given SedSurfaceGrid.
+ */
+LIBSEDML_EXTERN
+void
+SedSurfaceGrid_free (SedSurfaceGrid_t *ssg)
+{
+  delete ssg;
+}
+
+
+/**
+ * Arranges the columns of surface into the given SedSurfaceGrid.
+ */
+LIBSEDML_EXTERN
+int
+SedSurfaceGrid_build (SedSurfaceGrid_t *ssg, const SedResults_t *results,
+                      const SedSurface_t *surface, unsigned int numLevels)
+{
+  if (ssg == NULL || results == NULL) return LIBSEDML_INVALID_OBJECT;
+  return ssg->build(*results, surface, numLevels);
+}
+
+
+/**
+ * Returns the number of levels of the given SedSurfaceGrid.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSurfaceGrid_getNumLevels (const SedSurfaceGrid_t *ssg)
+{
+  return (ssg != NULL) ? ssg->getNumLevels() : 0;
+}
+
+
+/**
+ * Returns the number of columns of cells of the given level.
+ */
+LIBSEDML_EXTERN
+size_t
+SedSurfaceGrid_getNumColumns (const SedSurfaceGrid_t *ssg,
+                              unsigned int level)
+{
+  return (ssg != NULL) ? ssg->getNumColumns(level) : 0;
+}
+
+
+/**
+ * Returns the number of rows of cells of the given level.
+ */
+LIBSEDML_EXTERN
+size_t
+SedSurfaceGrid_getNumRows (const SedSurfaceGrid_t *ssg, unsigned int level)
+{
+  return (ssg != NULL) ? ssg->getNumRows(level) : 0;
+}
+
+
+/**
+ * Returns the values of a tile of the given level.
+ */
+LIBSEDML_EXTERN
+const double *
+SedSurfaceGrid_getTile (const SedSurfaceGrid_t *ssg, unsigned int level,
+                        size_t tileColumn, size_t tileRow)
+{
+  return (ssg != NULL) ? ssg->getTile(level, tileColumn, tileRow) : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,298 @@
+/**
+ * @file    SedSurfaceGrid.h
+ * @brief   Arranges the values of a surface into a tiled grid
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSurfaceGrid
+ * @ingroup Core
+ * @brief Holds the z values of a SedSurface as a grid of tiles.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The surfaces of a SedPlot3D are mostly the results of a scan over two
+ * parameters: every point (x, y, z) of their columns is a cell of a grid,
+ * but in the order the scan ran.  build() puts the distinct x values of a
+ * surface in increasing order as the columns of the grid, the distinct y
+ * values as its rows, and every z value in its cell; a cell no point falls
+ * in is NaN, and of two points in the same cell the later is kept.
+ *
+ * The grid is kept in square tiles of getTileSize() cells a side, each
+ * stored row after row in one block, so that a viewer drawing part of the
+ * grid reads contiguous memory.  The tiles at the right and bottom edges
+ * are filled up with NaN.
+ *
+ * Every level after the first halves the columns and rows of the one
+ * before: a cell of level @em n holds the mean of the values of the up to
+ * four cells of level @em n - 1 it covers, that is columns 2c and 2c + 1
+ * and rows 2r and 2r + 1, leaving out NaN.  For a surface with a
+ * logarithmic z axis (see SedSurface::getLogZ()) it is the geometric mean
+ * of their positive values instead.  Column @em c of level @em n thus
+ * covers the columns from <code>c * 2^n</code> of the first level.
+ */
+
+#ifndef SedSurfaceGrid_h
+#define SedSurfaceGrid_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedResults;
+class SedSurface;
+
+
+class LIBSEDML_EXTERN SedSurfaceGrid
+{
+public:
+
+  /**
+   * Creates a new, empty SedSurfaceGrid whose tiles have @p tileSize cells
+   * a side; a size of 0 is taken to be 1.
+   */
+  SedSurfaceGrid (unsigned int tileSize = 64);
+
+
+  /**
+   * Destroys this SedSurfaceGrid.
+   */
+  virtual ~SedSurfaceGrid ();
+
+
+  /**
+   * @return the number of cells a side of a tile.
+   */
+  unsigned int getTileSize () const;
+
+
+  /**
+   * Arranges the columns of @p surface, taken from @p results, into the
+   * grid, replacing what it held, with at most @p numLevels levels; with
+   * 0, levels are added until one fits into a single tile.  The points of
+   * a surface whose columns differ in length go as far as the shortest.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p surface is @c NULL or @p results lacks one of its columns
+   */
+  int build (const SedResults& results, const SedSurface* surface,
+             unsigned int numLevels = 0);
+
+
+  /**
+   * Arranges the @p length points (@p x[i], @p y[i], @p z[i]) into the
+   * grid, replacing what it held, averaging @p z logarithmically where
+   * @p logZ says; points with a NaN or infinite x or y are left out.
+   *
+   * @copydetails build(const SedResults&, const SedSurface*, unsigned int)
+   */
+  int build (const double* x, const double* y, const double* z,
+             size_t length, bool logZ, unsigned int numLevels = 0);
+
+
+  /**
+   * Empties this SedSurfaceGrid.
+   */
+  void clear ();
+
+
+  /**
+   * @return the number of levels of the grid, 0 if it is empty.
+   */
+  unsigned int getNumLevels () const;
+
+
+  /**
+   * @return the number of columns of cells of the given level.
+   */
+  size_t getNumColumns (unsigned int level = 0) const;
+
+
+  /**
+   * @return the number of rows of cells of the given level.
+   */
+  size_t getNumRows (unsigned int level = 0) const;
+
+
+  /**
+   * @return the number of columns of tiles of the given level.
+   */
+  size_t getNumTileColumns (unsigned int level = 0) const;
+
+
+  /**
+   * @return the number of rows of tiles of the given level.
+   */
+  size_t getNumTileRows (unsigned int level = 0) const;
+
+
+  /**
+   * @return the getTileSize() * getTileSize() values of the tile in
+   * column @p tileColumn and row @p tileRow of the given level, row after
+   * row, or @c NULL if there is no such tile.
+   */
+  const double* getTile (unsigned int level, size_t tileColumn,
+                         size_t tileRow) const;
+
+
+  /**
+   * @return the value of the cell in column @p column and row @p row of
+   * the given level, or NaN if there is no such cell.
+   */
+  double getValue (unsigned int level, size_t column, size_t row) const;
+
+
+  /**
+   * @return the x value of the given column of the first level, or NaN if
+   * there is no such column.
+   */
+  double getX (size_t column) const;
+
+
+  /**
+   * @return the y value of the given row of the first level, or NaN if
+   * there is no such row.
+   */
+  double getY (size_t row) const;
+
+
+  /**
+   * @return @c true if the levels average the logarithms of the values.
+   */
+  bool isLogZ () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Level
+  {
+    size_t               numColumns;
+    size_t               numRows;
+    size_t               numTileColumns;
+    size_t               numTileRows;
+    std::vector<double>  tiles;
+  };
+
+  void addLevel (const std::vector<double>& cells, size_t numColumns,
+                 size_t numRows);
+
+  const Level* getLevel (unsigned int level) const;
+
+
+  unsigned int         mTileSize;
+  bool                 mLogZ;
+  std::vector<double>  mX;
+  std::vector<double>  mY;
+  std::vector<Level>   mLevels;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedSurfaceGrid whose tiles have @p tileSize cells
+ * a side, and returns it.
+ */
+LIBSEDML_EXTERN
+SedSurfaceGrid_t *
+SedSurfaceGrid_create (unsigned int tileSize);
+
+
+/**
+ * Frees the given SedSurfaceGrid.
+ */
+LIBSEDML_EXTERN
+void
+SedSurfaceGrid_free (SedSurfaceGrid_t *ssg);
+
+
+/**
+ * Arranges the columns of @p surface into the given SedSurfaceGrid, with
+ * at most @p numLevels levels, or as many as are needed with 0.
+ */
+LIBSEDML_EXTERN
+int
+SedSurfaceGrid_build (SedSurfaceGrid_t *ssg, const SedResults_t *results,
+                      const SedSurface_t *surface, unsigned int numLevels);
+
+
+/**
+ * Returns the number of levels of the given SedSurfaceGrid.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSurfaceGrid_getNumLevels (const SedSurfaceGrid_t *ssg);
+
+
+/**
+ * Returns the number of columns of cells of the given level.
+ */
+LIBSEDML_EXTERN
+size_t
+SedSurfaceGrid_getNumColumns (const SedSurfaceGrid_t *ssg,
+                              unsigned int level);
+
+
+/**
+ * Returns the number of rows of cells of the given level.
+ */
+LIBSEDML_EXTERN
+size_t
+SedSurfaceGrid_getNumRows (const SedSurfaceGrid_t *ssg, unsigned int level);
+
+
+/**
+ * Returns the values of a tile of the given level, row after row, or
+ * @c NULL if there is no such tile.
+ */
+LIBSEDML_EXTERN
+const double *
+SedSurfaceGrid_getTile (const SedSurfaceGrid_t *ssg, unsigned int level,
+                        size_t tileColumn, size_t tileRow);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedSurfaceGrid_h */
@@ -0,0 +1,389 @@
+/**
+ * @file    SedSweep.cpp
+ * @brief   Parameter scans over one task, expanded lazily
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSweep.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cmath>
+#include <limits>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates point index of sweep.
+ */
+SedSweepPoint::SedSweepPoint (const SedSweep* sweep, size_t index)
+  : mSweep (sweep)
+  , mIndex (index)
+{
+}
+
+
+/*
+ * Returns the sweep of this point.
+ */
+const SedSweep*
+SedSweepPoint::getSweep () const
+{
+  return mSweep;
+}
+
+
+/*
+ * Returns the index of this point in its sweep.
+ */
+size_t
+SedSweepPoint::getIndex () const
+{
+  return mIndex;
+}
+
+
+/*
+ * Returns the number of targets changed at this point.
+ */
+unsigned int
+SedSweepPoint::getNumChanges () const
+{
+  return (mSweep != NULL) ? mSweep->getNumDimensions() : 0;
+}
+
+
+/*
+ * Returns the target of the n-th change.
+ */
+const std::string&
+SedSweepPoint::getTarget (unsigned int n) const
+{
+  static const std::string empty;
+  return (mSweep != NULL) ? mSweep->getTarget(n) : empty;
+}
+
+
+/*
+ * Returns the value of the n-th target at this point.
+ */
+double
+SedSweepPoint::getValue (unsigned int n) const
+{
+  if (mSweep == NULL || n >= mSweep->getNumDimensions())
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  return mSweep->getValue(n, getValueIndex(n));
+}
+
+
+/*
+ * Returns the index of the value of the n-th target in its dimension.
+ */
+size_t
+SedSweepPoint::getValueIndex (unsigned int n) const
+{
+  if (mSweep == NULL || n >= mSweep->getNumDimensions()) return 0;
+
+  const SedSweep::Dimension& dimension = mSweep->mDimensions[n];
+  return (mIndex / dimension.stride) % dimension.numValues;
+}
+
+
+/*
+ * Creates a new SedSweep over task.
+ */
+SedSweep::SedSweep (const SedTask* task)
+  : mTask (task)
+  , mNumPoints (1)
+{
+}
+
+
+/*
+ * Destroys this SedSweep.
+ */
+SedSweep::~SedSweep ()
+{
+}
+
+
+/*
+ * Returns the task the points of this sweep are variants of.
+ */
+const SedTask*
+SedSweep::getTask () const
+{
+  return mTask;
+}
+
+
+/*
+ * Adds a dimension setting target to a range of values.
+ */
+int
+SedSweep::addRange (const std::string& target, double start, double end,
+                    size_t numValues, bool logarithmic)
+{
+  if (logarithmic && !(start > 0 && end > 0))
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  Dimension dimension;
+  dimension.target      = target;
+  dimension.start       = start;
+  dimension.end         = end;
+  dimension.numValues   = numValues;
+  dimension.logarithmic = logarithmic;
+  dimension.stride      = 1;
+
+  return addDimension(dimension);
+}
+
+
+/*
+ * Adds a dimension setting target to each of the given values.
+ */
+int
+SedSweep::addValues (const std::string& target, const double* values,
+                     size_t numValues)
+{
+  if (values == NULL) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  Dimension dimension;
+  dimension.target      = target;
+  dimension.start       = 0;
+  dimension.end         = 0;
+  dimension.numValues   = numValues;
+  dimension.logarithmic = false;
+  dimension.stride      = 1;
+  dimension.values.assign(values, values + numValues);
+
+  return addDimension(dimension);
+}
+
+
+/*
+ * Returns the number of dimensions of this sweep.
+ */
+unsigned int
+SedSweep::getNumDimensions () const
+{
+  return (unsigned int)mDimensions.size();
+}
+
+
+/*
+ * Returns the target of the n-th dimension.
+ */
+const std::string&
+SedSweep::getTarget (unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mDimensions.size()) ? mDimensions[n].target : empty;
+}
+
+
+/*
+ * Returns the number of values of the n-th dimension.
+ */
+size_t
+SedSweep::getNumValues (unsigned int n) const
+{
+  return (n < mDimensions.size()) ? mDimensions[n].numValues : 0;
+}
+
+
+/*
+ * Returns the value index of the n-th dimension.
+ */
+double
+SedSweep::getValue (unsigned int n, size_t index) const
+{
+  if (n >= mDimensions.size() || index >= mDimensions[n].numValues)
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  const Dimension& dimension = mDimensions[n];
+  if (!dimension.values.empty()) return dimension.values[index];
+
+  // the ends are given exactly, and every value is computed from its own
+  // index, so that no error accumulates along the range
+  if (index == 0) return dimension.start;
+  if (index + 1 == dimension.numValues) return dimension.end;
+
+  const double fraction = (double)index / (double)(dimension.numValues - 1);
+  if (dimension.logarithmic)
+  {
+    const double first = log(dimension.start);
+    return exp(first + (log(dimension.end) - first) * fraction);
+  }
+
+  return dimension.start + (dimension.end - dimension.start) * fraction;
+}
+
+
+/*
+ * Returns the number of points.
+ */
+size_t
+SedSweep::getNumPoints () const
+{
+  return mNumPoints;
+}
+
+
+/*
+ * Returns the point index.
+ */
+SedSweepPoint
+SedSweep::getPoint (size_t index) const
+{
+  return SedSweepPoint(this, index);
+}
+
+
+/*
+ * Removes all dimensions.
+ */
+void
+SedSweep::clear ()
+{
+  mDimensions.clear();
+  mNumPoints = 1;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Adds dimension as the fastest varying one.
+ */
+int
+SedSweep::addDimension (const Dimension& dimension)
+{
+  if (dimension.target.empty() || dimension.numValues == 0)
+  {
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  if (mNumPoints > (size_t)-1 / dimension.numValues)
+  {
+    return LIBSEDML_OPERATION_FAILED;
+  }
+
+  for (unsigned int i = 0; i < mDimensions.size(); ++i)
+  {
+    mDimensions[i].stride *= dimension.numValues;
+  }
+
+  mDimensions.push_back(dimension);
+  mDimensions.back().stride = 1;
+  mNumPoints *= dimension.numValues;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedSweep_t *
+SedSweep_create (const SedTask_t *task)
+{
+  return new (nothrow) SedSweep(task);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+void
+SedSweep_free (SedSweep_t *ss)
+{
+  delete ss;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedSweep_addRange (SedSweep_t *ss, const char *target, double start,
+                   double end, size_t numValues, int logarithmic)
+{
+  if (ss == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return ss->addRange((target != NULL) ? target : "", start, end, numValues,
+                      logarithmic != 0);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+int
+SedSweep_addValues (SedSweep_t *ss, const char *target,
+                    const double *values, size_t numValues)
+{
+  if (ss == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return ss->addValues((target != NULL) ? target : "", values, numValues);
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+size_t
+SedSweep_getNumPoints (const SedSweep_t *ss)
+{
+  return (ss != NULL) ? ss->getNumPoints() : 0;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+double
+SedSweep_getPointValue (const SedSweep_t *ss, size_t index, unsigned int n)
+{
+  if (ss == NULL) return numeric_limits<double>::quiet_NaN();
+
+  return ss->getPoint(index).getValue(n);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
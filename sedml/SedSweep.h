@@ -0,0 +1,321 @@
+/**
+ * @file    SedSweep.h
+ * @brief   Parameter scans over one task, expanded lazily
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSweep
+ * @ingroup Core
+ * @brief A scan of the values of model targets, on top of one SedTask.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedSweep describes a batch of virtual tasks: every combination of the
+ * values of its dimensions, each of which is a range or a list of values
+ * for one XPath target of the model of its base task.  The points of the
+ * sweep are not stored, nor are SED-ML elements created for them: a
+ * SedSweepPoint is an index into the sweep, and its values are computed
+ * when they are asked for.  The last dimension added varies fastest.
+ *
+ * Registered with SedExecutor::addSweep(), every point is run as a task
+ * of its own, with the SedModel and SedSimulation of the base task, by
+ * SedSimulator::simulatePoint().  A simulator that does not override it
+ * is given a temporary copy of the model with one SedChangeAttribute per
+ * target instead, while the point is simulated.
+ *
+ * A SedSweep must not be changed while an executor runs it.
+ */
+
+#ifndef SedSweep_h
+#define SedSweep_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedTask;
+class SedSweep;
+
+
+class LIBSEDML_EXTERN SedSweepPoint
+{
+public:
+
+  /**
+   * Creates point @p index of @p sweep.
+   */
+  SedSweepPoint (const SedSweep* sweep = NULL, size_t index = 0);
+
+
+  /**
+   * @return the sweep of this point.
+   */
+  const SedSweep* getSweep () const;
+
+
+  /**
+   * @return the index of this point in its sweep.
+   */
+  size_t getIndex () const;
+
+
+  /**
+   * @return the number of targets changed at this point, the number of
+   * dimensions of its sweep.
+   */
+  unsigned int getNumChanges () const;
+
+
+  /**
+   * @return the target of the n-th change, or an empty string if @p n is
+   * out of range.
+   */
+  const std::string& getTarget (unsigned int n) const;
+
+
+  /**
+   * @return the value of the n-th target at this point, or NaN if @p n is
+   * out of range.
+   */
+  double getValue (unsigned int n) const;
+
+
+  /**
+   * @return the index of the value of the n-th target in its dimension.
+   */
+  size_t getValueIndex (unsigned int n) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  const SedSweep* mSweep;
+  size_t          mIndex;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedSweep
+{
+public:
+
+  /**
+   * Creates a new SedSweep over @p task, which it does not own; the
+   * sweep has one point, the task itself, until dimensions are added.
+   */
+  SedSweep (const SedTask* task);
+
+
+  /**
+   * Destroys this SedSweep.
+   */
+  virtual ~SedSweep ();
+
+
+  /**
+   * @return the task the points of this sweep are variants of.
+   */
+  const SedTask* getTask () const;
+
+
+  /**
+   * Adds a dimension setting @p target to @p numValues values from
+   * @p start to @p end, both included, evenly spaced or, if
+   * @p logarithmic is @c true, evenly spaced on a logarithmic scale.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p target is empty, @p numValues is 0, or @p logarithmic is
+   * @c true and @p start and @p end are not both positive
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the number of points would not fit in a @c size_t
+   */
+  int addRange (const std::string& target, double start, double end,
+                size_t numValues, bool logarithmic = false);
+
+
+  /**
+   * Adds a dimension setting @p target to each of the @p numValues
+   * @p values in turn.
+   *
+   * @return integer value indicating success/failure of the
+   * function, as for addRange(); @p values must not be @c NULL and
+   * @p numValues must not be 0.
+   */
+  int addValues (const std::string& target, const double* values,
+                 size_t numValues);
+
+
+  /**
+   * @return the number of dimensions of this sweep.
+   */
+  unsigned int getNumDimensions () const;
+
+
+  /**
+   * @return the target of the n-th dimension, or an empty string if
+   * @p n is out of range.
+   */
+  const std::string& getTarget (unsigned int n) const;
+
+
+  /**
+   * @return the number of values of the n-th dimension, or 0 if @p n is
+   * out of range.
+   */
+  size_t getNumValues (unsigned int n) const;
+
+
+  /**
+   * @return the value @p index of the n-th dimension, or NaN if either
+   * is out of range.
+   */
+  double getValue (unsigned int n, size_t index) const;
+
+
+  /**
+   * @return the number of points, the product of the numbers of values of
+   * the dimensions.
+   */
+  size_t getNumPoints () const;
+
+
+  /**
+   * @return the point @p index; it is only valid if @p index is less than
+   * getNumPoints().
+   */
+  SedSweepPoint getPoint (size_t index) const;
+
+
+  /**
+   * Removes all dimensions.
+   */
+  void clear ();
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  friend class SedSweepPoint;
+
+  struct Dimension
+  {
+    std::string          target;
+    double               start;
+    double               end;
+    size_t               numValues;
+    bool                 logarithmic;
+    std::vector<double>  values;
+    size_t               stride;
+  };
+
+  int addDimension (const Dimension& dimension);
+
+
+  const SedTask*          mTask;
+  std::vector<Dimension>  mDimensions;
+  size_t                  mNumPoints;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedSweep over @p task and returns it.
+ */
+LIBSEDML_EXTERN
+SedSweep_t *
+SedSweep_create (const SedTask_t *task);
+
+
+/**
+ * Frees the given SedSweep.
+ */
+LIBSEDML_EXTERN
+void
+SedSweep_free (SedSweep_t *ss);
+
+
+/**
+ * Adds a dimension setting @p target to @p numValues values from @p start
+ * to @p end; a non-zero @p logarithmic spaces them logarithmically.
+ */
+LIBSEDML_EXTERN
+int
+SedSweep_addRange (SedSweep_t *ss, const char *target, double start,
+                   double end, size_t numValues, int logarithmic);
+
+
+/**
+ * Adds a dimension setting @p target to each of the @p numValues
+ * @p values in turn.
+ */
+LIBSEDML_EXTERN
+int
+SedSweep_addValues (SedSweep_t *ss, const char *target,
+                    const double *values, size_t numValues);
+
+
+/**
+ * Returns the number of points of the given SedSweep.
+ */
+LIBSEDML_EXTERN
+size_t
+SedSweep_getNumPoints (const SedSweep_t *ss);
+
+
+/**
+ * Returns the value of the n-th target at point @p index of the given
+ * SedSweep.
+ */
+LIBSEDML_EXTERN
+double
+SedSweep_getPointValue (const SedSweep_t *ss, size_t index, unsigned int n);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedSweep_h */
@@ -0,0 +1,385 @@
+/**
+ * @file    SedSymbol.cpp
+ * @brief   Interned storage for ids and the references to them
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedSymbol.h>
+#include <sedml/common/threads.h>
+
+#include <map>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of tables the interned values are spread over, so that
+ * threads working on different values seldom contend for one lock.
+ */
+static const unsigned int NUM_SHARDS = 32;
+
+
+/*
+ * One table of interned values, with the number of symbols holding each;
+ * a symbol points to the entry of its value in the map.
+ */
+struct SedSymbolShard
+{
+  std::map<std::string, SedSymbol::Refs> entries;
+  SedMutex                               mutex;
+};
+
+
+/*
+ * The tables, which are never freed: objects destroyed at exit, after they
+ * would have been, still release their symbols into them.
+ */
+static SedSymbolShard* sShards = NULL;
+
+
+static SedSymbolShard*
+getShards ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sShards == NULL)
+  {
+    sShards = new SedSymbolShard[NUM_SHARDS];
+    for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+    {
+      mutexInit(&sShards[i].mutex);
+    }
+  }
+  return sShards;
+}
+
+
+/*
+ * Creates the tables before main() rather than on first use, when several
+ * threads could be creating them at once.
+ */
+static SedSymbolShard* const sShardsCreated = getShards();
+
+
+/*
+ * The value of empty symbols, which is never freed, as the tables are not.
+ */
+static const std::string* sEmpty = NULL;
+
+
+static const std::string*
+getEmpty ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sEmpty == NULL) sEmpty = new std::string();
+  return sEmpty;
+}
+
+
+/*
+ * Creates the empty value before main() rather than on first use, when
+ * several threads could be creating it at once.
+ */
+static const std::string* const sEmptyCreated = getEmpty();
+
+
+/*
+ * Returns the shard the value belongs to.
+ */
+static unsigned int
+getShardIndex (const std::string& value)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < value.size(); ++i)
+  {
+    hash = (hash ^ (unsigned char)value[i]) * 16777619u;
+  }
+  return hash % NUM_SHARDS;
+}
+
+
+/*
+ * Returns the entry of value with one more reference, adding it if needed.
+ */
+SedSymbol::Entry*
+SedSymbol::acquire (const std::string& value)
+{
+  if (value.empty()) return NULL;
+
+  const unsigned int index = getShardIndex(value);
+  SedSymbolShard& shard = getShards()[index];
+  mutexLock(&shard.mutex);
+
+  // entries of a std::map stay where they are as others come and go
+  Refs refs = { 0, index };
+  Entry* entry = &*shard.entries.insert(
+    std::map<std::string, Refs>::value_type(value, refs)).first;
+  ++entry->second.count;
+
+  mutexUnlock(&shard.mutex);
+  return entry;
+}
+
+
+/*
+ * Adds a reference to entry.
+ */
+void
+SedSymbol::retain (Entry* entry)
+{
+  if (entry == NULL) return;
+
+  SedSymbolShard& shard = getShards()[entry->second.shard];
+  mutexLock(&shard.mutex);
+  ++entry->second.count;
+  mutexUnlock(&shard.mutex);
+}
+
+
+/*
+ * Drops a reference to entry, removing it with the last one.
+ */
+void
+SedSymbol::release (Entry* entry)
+{
+  if (entry == NULL) return;
+
+  SedSymbolShard& shard = getShards()[entry->second.shard];
+  mutexLock(&shard.mutex);
+  if (--entry->second.count == 0)
+  {
+    shard.entries.erase(shard.entries.find(entry->first));
+  }
+  mutexUnlock(&shard.mutex);
+}
+
+/** @endcond */
+
+
+/*
+ * Creates an empty SedSymbol.
+ */
+SedSymbol::SedSymbol ()
+  : mEntry (NULL)
+{
+}
+
+
+/*
+ * Creates a SedSymbol holding value.
+ */
+SedSymbol::SedSymbol (const char* value)
+  : mEntry ((value != NULL && *value != '\0') ? acquire(value) : NULL)
+{
+}
+
+
+/*
+ * Creates a SedSymbol holding value.
+ */
+SedSymbol::SedSymbol (const std::string& value)
+  : mEntry (acquire(value))
+{
+}
+
+
+/*
+ * Copy constructor.
+ */
+SedSymbol::SedSymbol (const SedSymbol& orig)
+  : mEntry (orig.mEntry)
+{
+  retain(mEntry);
+}
+
+
+/*
+ * Destroys this SedSymbol.
+ */
+SedSymbol::~SedSymbol ()
+{
+  release(mEntry);
+}
+
+
+/*
+ * Assignment operator.
+ */
+SedSymbol&
+SedSymbol::operator= (const SedSymbol& rhs)
+{
+  if (rhs.mEntry != mEntry)
+  {
+    retain(rhs.mEntry);
+    release(mEntry);
+    mEntry = rhs.mEntry;
+  }
+  return *this;
+}
+
+
+/*
+ * Assigns value.
+ */
+SedSymbol&
+SedSymbol::operator= (const std::string& value)
+{
+  // acquired first, as value may be the text of this symbol
+  Entry* entry = acquire(value);
+  release(mEntry);
+  mEntry = entry;
+  return *this;
+}
+
+
+/*
+ * Assigns value.
+ */
+SedSymbol&
+SedSymbol::operator= (const char* value)
+{
+  if (value == NULL || *value == '\0')
+  {
+    erase();
+    return *this;
+  }
+
+  return *this = std::string(value);
+}
+
+
+/*
+ * Returns true if the value is empty.
+ */
+bool
+SedSymbol::empty () const
+{
+  return mEntry == NULL;
+}
+
+
+/*
+ * Empties the value.
+ */
+void
+SedSymbol::erase ()
+{
+  release(mEntry);
+  mEntry = NULL;
+}
+
+
+/*
+ * Returns the value.
+ */
+const std::string&
+SedSymbol::str () const
+{
+  return (mEntry != NULL) ? mEntry->first : *getEmpty();
+}
+
+
+/*
+ * Returns the value.
+ */
+SedSymbol::operator const std::string& () const
+{
+  return str();
+}
+
+
+/*
+ * Returns true if this symbol and rhs have the same value.
+ */
+bool
+SedSymbol::operator== (const SedSymbol& rhs) const
+{
+  return mEntry == rhs.mEntry;
+}
+
+
+/*
+ * Returns true if this symbol and rhs have different values.
+ */
+bool
+SedSymbol::operator!= (const SedSymbol& rhs) const
+{
+  return mEntry != rhs.mEntry;
+}
+
+
+/*
+ * Returns true if this symbol has the value rhs.
+ */
+bool
+SedSymbol::operator== (const std::string& rhs) const
+{
+  // the interned text is the string itself when rhs comes from a symbol
+  return (mEntry != NULL) ? (&mEntry->first == &rhs || mEntry->first == rhs)
+                          : rhs.empty();
+}
+
+
+/*
+ * Returns true if this symbol does not have the value rhs.
+ */
+bool
+SedSymbol::operator!= (const std::string& rhs) const
+{
+  return !(*this == rhs);
+}
+
+
+/*
+ * Returns true if this symbol has the value rhs.
+ */
+bool
+SedSymbol::operator== (const char* rhs) const
+{
+  if (rhs == NULL) return mEntry == NULL;
+  return (mEntry != NULL) ? mEntry->first == rhs : *rhs == '\0';
+}
+
+
+/*
+ * Returns true if this symbol does not have the value rhs.
+ */
+bool
+SedSymbol::operator!= (const char* rhs) const
+{
+  return !(*this == rhs);
+}
+
+
+/*
+ * Returns the number of distinct values interned in the process.
+ */
+unsigned int
+SedSymbol::getNumEntries ()
+{
+  SedSymbolShard* shards = getShards();
+  unsigned int size = 0;
+  for (unsigned int i = 0; i < NUM_SHARDS; ++i)
+  {
+    mutexLock(&shards[i].mutex);
+    size += (unsigned int)shards[i].entries.size();
+    mutexUnlock(&shards[i].mutex);
+  }
+  return size;
+}
+
+LIBSEDML_CPP_NAMESPACE_END
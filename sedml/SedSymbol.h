@@ -0,0 +1,176 @@
+/**
+ * @file    SedSymbol.h
+ * @brief   Interned storage for ids and the references to them
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedSymbol
+ * @ingroup Core
+ * @brief A string that shares its text with every equal SedSymbol.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The same ids are spelled out over and over in a document: the id of a
+ * data generator in the curves and data sets plotting it, the id of a task
+ * in every variable taken from it, the id of a model in every task running
+ * it.  The generated classes keep their ids and references in SedSymbol
+ * objects, which hold a pointer to one interned copy of the text shared by
+ * all equal symbols of the process, and count the references to it; the
+ * copy goes away with the last one.
+ *
+ * A SedSymbol converts to <code>const std::string&</code>, so that the
+ * accessors return it as before, and equal symbols return the very same
+ * string.  Two symbols are compared by their pointers.  Empty symbols hold
+ * no text at all.  All methods may be called by several threads at once;
+ * the values are spread over several separately locked tables by their
+ * hash, so that threads reading or copying different ids seldom wait for
+ * each other.
+ */
+
+#ifndef SedSymbol_h
+#define SedSymbol_h
+
+
+#include <sedml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <utility>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedSymbol
+{
+public:
+
+  /**
+   * Creates an empty SedSymbol.
+   */
+  SedSymbol ();
+
+
+  /**
+   * Creates a SedSymbol holding @p value, interning it unless an equal
+   * symbol exists.
+   */
+  SedSymbol (const char* value);
+
+  SedSymbol (const std::string& value);
+
+
+  /**
+   * Copy constructor; the copy shares the text of @p orig.
+   */
+  SedSymbol (const SedSymbol& orig);
+
+
+  /**
+   * Destroys this SedSymbol, dropping its reference to the text.
+   */
+  ~SedSymbol ();
+
+
+  /**
+   * Assignment operators.
+   */
+  SedSymbol& operator= (const SedSymbol& rhs);
+
+  SedSymbol& operator= (const std::string& value);
+
+  SedSymbol& operator= (const char* value);
+
+
+  /**
+   * @return @c true if the value is empty.
+   */
+  bool empty () const;
+
+
+  /**
+   * Empties the value, dropping its reference to the text.
+   */
+  void erase ();
+
+
+  /**
+   * @return the value, an empty string shared by all empty values if it
+   * is empty.
+   */
+  const std::string& str () const;
+
+  operator const std::string& () const;
+
+
+  /**
+   * @return @c true if this symbol and @p rhs have the same value, which
+   * for two symbols is comparing two pointers.
+   */
+  bool operator== (const SedSymbol& rhs) const;
+
+  bool operator!= (const SedSymbol& rhs) const;
+
+  bool operator== (const std::string& rhs) const;
+
+  bool operator!= (const std::string& rhs) const;
+
+  bool operator== (const char* rhs) const;
+
+  bool operator!= (const char* rhs) const;
+
+
+  /**
+   * @return the number of distinct values interned in the process.
+   */
+  static unsigned int getNumEntries ();
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  friend struct SedSymbolShard;
+
+  /*
+   * The number of symbols holding a value, and the shard of the table
+   * its entry is in.
+   */
+  struct Refs
+  {
+    unsigned int count;
+    unsigned int shard;
+  };
+
+  typedef std::pair<const std::string, Refs> Entry;
+
+  static Entry* acquire (const std::string& value);
+
+  static void retain (Entry* entry);
+
+  static void release (Entry* entry);
+
+  Entry* mEntry;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedSymbol_h */
@@ -0,0 +1,561 @@
+/**
+ * @file    SedTargetValidator.cpp
+ * @brief   Checks that the XPath targets of a document resolve in its models
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedTargetValidator.h>
+#include <sedml/SedTypes.h>
+#include <sedml/SedModelCache.h>
+#include <sedml/SedXPathCache.h>
+#include <sedml/common/threads.h>
+
+#include <sbml/xml/XMLNode.h>
+
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The number of consecutive targets a thread claims at once.
+ */
+static const unsigned int SED_TARGET_RUN = 64;
+
+
+/*
+ * A model to prepare: the SedModel, and whether it is wanted before its
+ * own changes are applied.
+ */
+struct SedTargetModel
+{
+  const SedModel*  model;
+  bool             base;
+  const XMLNode*   root;
+};
+
+
+/*
+ * A target to resolve: the element it belongs to, the model it resolves
+ * in, as an index into the models, and its place in document order.
+ */
+struct SedTarget
+{
+  const SedBase*      element;
+  const std::string*  target;
+  unsigned int        model;
+  unsigned int        order;
+};
+
+
+/*
+ * State shared by the threads of one validation.  Models, then runs of
+ * targets, are claimed one at a time through next; each thread only
+ * writes the roots of the models and the results of the targets it
+ * claimed.
+ */
+struct SedTargetJob
+{
+  const SedDocument*                           doc;
+  SedModelCache*                               cache;
+  const std::map<std::string, std::string>*    namespaces;
+  std::vector<SedTargetModel>*                 models;
+  const std::vector<SedTarget>*                targets;
+  std::vector<char>*                           resolved;
+  unsigned int                                 next;
+  SedMutex                                     mutex;
+};
+
+
+/*
+ * Returns the index of model among models, adding it if it is not there.
+ */
+static unsigned int
+addModel (std::vector<SedTargetModel>& models, const SedModel* model,
+          bool base)
+{
+  for (unsigned int i = 0; i < models.size(); ++i)
+  {
+    if (models[i].model == model && models[i].base == base) return i;
+  }
+
+  SedTargetModel entry;
+  entry.model = model;
+  entry.base  = base;
+  entry.root  = NULL;
+  models.push_back(entry);
+  return (unsigned int)models.size() - 1;
+}
+
+
+/*
+ * Adds the target of element, resolving in the model with index model,
+ * to targets, unless it has none.
+ */
+template <typename Element>
+static void
+addTarget (std::vector<SedTarget>& targets, const Element* element,
+           unsigned int model)
+{
+  if (element == NULL || !element->isSetTarget()) return;
+
+  SedTarget target;
+  target.element = element;
+  target.target  = &element->getTarget();
+  target.model   = model;
+  target.order   = (unsigned int)targets.size();
+  targets.push_back(target);
+}
+
+
+/*
+ * Returns the model variable refers to, directly or through its task, or
+ * NULL.
+ */
+static const SedModel*
+getModelOf (const SedDocument* doc, const SedVariable* variable)
+{
+  if (variable->isSetModelReference())
+  {
+    return doc->getModel(variable->getModelReference());
+  }
+
+  if (variable->isSetTaskReference())
+  {
+    const SedTask* task = doc->getTask(variable->getTaskReference());
+    if (task != NULL && task->isSetModelReference())
+    {
+      return doc->getModel(task->getModelReference());
+    }
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Adds the targets of doc, in document order, and the models they resolve
+ * in.
+ */
+static void
+gatherTargets (const SedDocument* doc, std::vector<SedTargetModel>& models,
+               std::vector<SedTarget>& targets)
+{
+  for (unsigned int i = 0; i < doc->getNumModels(); ++i)
+  {
+    const SedModel* model = doc->getModel(i);
+    if (model == NULL || model->getNumChanges() == 0) continue;
+
+    const unsigned int base = addModel(models, model, true);
+    for (unsigned int j = 0; j < model->getNumChanges(); ++j)
+    {
+      const SedChange* change = model->getChange(j);
+      addTarget(targets, change, base);
+
+      if (change == NULL
+        || change->getTypeCode() != SEDML_CHANGE_COMPUTECHANGE) continue;
+
+      const SedComputeChange* cc =
+        static_cast<const SedComputeChange*>(change);
+      for (unsigned int k = 0; k < cc->getNumVariables(); ++k)
+      {
+        const SedVariable* variable = cc->getVariable(k);
+        if (variable == NULL || !variable->isSetModelReference())
+        {
+          addTarget(targets, variable, base);
+          continue;
+        }
+
+        const SedModel* other = getModelOf(doc, variable);
+        if (other != NULL)
+        {
+          addTarget(targets, variable, addModel(models, other, false));
+        }
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < doc->getNumDataGenerators(); ++i)
+  {
+    const SedDataGenerator* dg = doc->getDataGenerator(i);
+    if (dg == NULL) continue;
+
+    for (unsigned int j = 0; j < dg->getNumVariables(); ++j)
+    {
+      const SedVariable* variable = dg->getVariable(j);
+      const SedModel* model =
+        (variable != NULL) ? getModelOf(doc, variable) : NULL;
+      if (model != NULL)
+      {
+        addTarget(targets, variable, addModel(models, model, false));
+      }
+    }
+  }
+}
+
+
+/*
+ * Returns true if target selects an element of the model last set on
+ * xpath, and the attribute it names if it names one.  A target xpath
+ * cannot compile counts as resolved.
+ */
+static bool
+resolves (SedXPathCache& xpath, const std::string& target)
+{
+  const int n = xpath.compile(target);
+  if (n < 0) return true;
+
+  const XMLNode* node = xpath.resolve(n);
+  if (node == NULL) return false;
+
+  const std::string& attribute = xpath.getAttributeName(n);
+  return attribute.empty() || node->getAttrIndex(attribute) >= 0;
+}
+
+
+/*
+ * Prepares the models claimed.
+ */
+static void
+runModelJob (SedTargetJob* job)
+{
+  const unsigned int numModels = (unsigned int)job->models->size();
+
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int n = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (n >= numModels) break;
+
+    SedTargetModel& model = (*job->models)[n];
+    try
+    {
+      const void* prepared = model.base
+        ? job->cache->getBaseModel(job->doc, model.model)
+        : job->cache->getModel(job->doc, model.model);
+      model.root = static_cast<const XMLNode*>(prepared);
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the model is not checked
+      model.root = NULL;
+    }
+  }
+}
+
+
+/*
+ * Resolves the runs of targets claimed.
+ */
+static void
+runTargetJob (SedTargetJob* job)
+{
+  const unsigned int numTargets = (unsigned int)job->targets->size();
+  const unsigned int numRuns =
+    (numTargets + SED_TARGET_RUN - 1) / SED_TARGET_RUN;
+
+  SedXPathCache xpath;
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = job->namespaces->begin(); it != job->namespaces->end(); ++it)
+  {
+    xpath.addNamespace(it->first, it->second);
+  }
+
+  const XMLNode* current = NULL;
+  for (;;)
+  {
+    mutexLock(&job->mutex);
+    unsigned int run = job->next++;
+    mutexUnlock(&job->mutex);
+
+    if (run >= numRuns) break;
+
+    const unsigned int first = run * SED_TARGET_RUN;
+    const unsigned int last  = std::min(numTargets, first + SED_TARGET_RUN);
+
+    try
+    {
+      for (unsigned int i = first; i < last; ++i)
+      {
+        const SedTarget& target = (*job->targets)[i];
+        const XMLNode* root = (*job->models)[target.model].root;
+        if (root == NULL) continue;
+
+        // the targets of one model are consecutive, so what is resolved
+        // in it is kept across them, and across runs of the same model
+        if (root != current)
+        {
+          xpath.setDocument(root);
+          current = root;
+        }
+
+        (*job->resolved)[target.order] = resolves(xpath, *target.target);
+      }
+    }
+    catch (...)
+    {
+      // nothing may escape a worker thread; the rest of the run counts
+      // as resolved
+    }
+  }
+}
+
+
+static void
+modelThreadMain (void* arg)
+{
+  runModelJob(static_cast<SedTargetJob*>(arg));
+}
+
+
+static void
+targetThreadMain (void* arg)
+{
+  runTargetJob(static_cast<SedTargetJob*>(arg));
+}
+
+
+/*
+ * Runs func on numThreads threads, the calling thread being one of them.
+ */
+static void
+runThreads (SedThreadFunc func, SedTargetJob* job, unsigned int numThreads)
+{
+  job->next = 0;
+
+  // if some threads cannot be started the remaining ones do their share
+  std::vector<SedThread> threads;
+  for (unsigned int i = 1; i < numThreads; i++)
+  {
+    SedThread thread;
+    if (!startThread(&thread, func, job)) break;
+    threads.push_back(thread);
+  }
+
+  func(job);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    joinThread(threads[i]);
+  }
+}
+
+
+/*
+ * Orders targets by the model they resolve in, then document order.
+ */
+static bool
+byModel (const SedTarget& a, const SedTarget& b)
+{
+  if (a.model != b.model) return a.model < b.model;
+  return a.order < b.order;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedTargetValidator.
+ */
+SedTargetValidator::SedTargetValidator (SedModelCache& cache,
+                                        unsigned int numThreads)
+  : mCache (cache)
+  , mNumThreads (numThreads)
+{
+}
+
+
+/*
+ * Destroys this SedTargetValidator.
+ */
+SedTargetValidator::~SedTargetValidator ()
+{
+}
+
+
+/*
+ * Declares the namespace uri for prefix in targets.
+ */
+int
+SedTargetValidator::addNamespace (const std::string& prefix,
+                                  const std::string& uri)
+{
+  if (prefix.empty()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mNamespaces[prefix] = uri;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the number of threads used.
+ */
+void
+SedTargetValidator::setNumThreads (unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+/*
+ * Returns the number of threads the next validation will use at most.
+ */
+unsigned int
+SedTargetValidator::getNumThreads () const
+{
+  return (mNumThreads == 0) ? getNumProcessors() : mNumThreads;
+}
+
+
+/*
+ * Checks the targets of doc and logs those that do not resolve.
+ */
+unsigned int
+SedTargetValidator::validate (SedDocument* doc) const
+{
+  if (doc == NULL) return 0;
+
+  std::vector<SedTargetModel> models;
+  std::vector<SedTarget>      targets;
+  gatherTargets(doc, models, targets);
+
+  if (targets.empty()) return 0;
+
+  std::vector<SedTarget> grouped(targets);
+  std::sort(grouped.begin(), grouped.end(), byModel);
+
+  std::vector<char> resolved(targets.size(), 1);
+
+  SedTargetJob job;
+  job.doc        = doc;
+  job.cache      = &mCache;
+  job.namespaces = &mNamespaces;
+  job.models     = &models;
+  job.targets    = &grouped;
+  job.resolved   = &resolved;
+  job.next       = 0;
+  mutexInit(&job.mutex);
+
+  const unsigned int numThreads = getNumThreads();
+  const unsigned int numRuns =
+    ((unsigned int)targets.size() + SED_TARGET_RUN - 1) / SED_TARGET_RUN;
+
+  runThreads(modelThreadMain, &job,
+             std::min(numThreads, (unsigned int)models.size()));
+  runThreads(targetThreadMain, &job, std::min(numThreads, numRuns));
+
+  mutexFree(&job.mutex);
+
+  unsigned int numErrors = 0;
+  SedErrorLog* log = doc->getErrorLog();
+  for (unsigned int i = 0; i < targets.size(); ++i)
+  {
+    if (resolved[i]) continue;
+
+    const SedTarget& target = targets[i];
+    const SedBase* element = target.element;
+    const SedModel* model = models[target.model].model;
+
+    std::string details = "The target '" + *target.target + "' of the <"
+      + element->getElementName() + "> element";
+    if (element->isSetId())
+    {
+      details += " with id '" + element->getId() + "'";
+    }
+    details += " selects nothing in the model '" + model->getId() + "'";
+    if (models[target.model].base)
+    {
+      details += " before its changes";
+    }
+    details += ".";
+
+    log->add(SedError(UnresolvedSedTarget, doc->getLevel(),
+                      doc->getVersion(), details, element->getLine(),
+                      element->getColumn()));
+    ++numErrors;
+  }
+
+  return numErrors;
+}
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * Creates a new SedTargetValidator and returns it.
+ */
+LIBSEDML_EXTERN
+SedTargetValidator_t *
+SedTargetValidator_create (SedModelCache_t *cache, unsigned int numThreads)
+{
+  if (cache == NULL) return NULL;
+  return new (nothrow) SedTargetValidator(*cache, numThreads);
+}
+
+
+/**
+ * Frees the given SedTargetValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedTargetValidator_free (SedTargetValidator_t *stv)
+{
+  delete stv;
+}
+
+
+/**
+ * Declares the namespace uri for prefix in targets.
+ */
+LIBSEDML_EXTERN
+int
+SedTargetValidator_addNamespace (SedTargetValidator_t *stv,
+                                 const char *prefix, const char *uri)
+{
+  if (stv == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return stv->addNamespace(prefix != NULL ? prefix : "",
+                           uri != NULL ? uri : "");
+}
+
+
+/**
+ * Checks the targets of doc, logging those that do not resolve, and
+ * returns their number.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedTargetValidator_validate (const SedTargetValidator_t *stv,
+                             SedDocument_t *doc)
+{
+  return (stv != NULL) ? stv->validate(doc) : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
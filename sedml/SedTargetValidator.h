@@ -0,0 +1,213 @@
+/**
+ * @file    SedTargetValidator.h
+ * @brief   Checks that the XPath targets of a document resolve in its models
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTargetValidator
+ * @ingroup Core
+ * @brief Checks the targets of the variables and changes of a SedDocument
+ * against its models, on a pool of threads.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * validate() resolves the target of
+ *
+ * @li every SedChange of a SedModel, and every SedVariable of a
+ * SedComputeChange without a model reference of its own, in the model as
+ * it is before the changes of that SedModel are applied;
+ * @li every SedVariable of a SedDataGenerator in the model it refers to,
+ * directly or through the model of its task, with all changes applied;
+ * @li every other SedVariable of a SedComputeChange in the model it
+ * refers to, with all changes applied;
+ *
+ * and logs an @c UnresolvedSedTarget error, with the line and column of
+ * the variable or change, for each target that selects no element, or an
+ * attribute the element selected does not have.
+ *
+ * The models are XMLNode trees prepared by a SedModelCache, such as one
+ * using a SedXMLModelPreparer, so that every distinct model is read and
+ * changed only once, however many targets refer to it; the cache is
+ * shared by the threads, which prepare different models at the same time.
+ * The targets are then grouped by the model they resolve in and split
+ * into runs of consecutive targets that the threads claim one at a time.
+ * Each thread resolves its runs with a SedXPathCache of its own, which
+ * keeps what it resolved in a model for as long as it resolves in the
+ * same model.  The errors are logged in document order, whatever the
+ * number of threads.
+ *
+ * Targets are not checked if the model they resolve in is not in the
+ * document or cannot be prepared, or if they are not XPath expressions a
+ * SedXPathCache supports: the other validators report missing models,
+ * and the targets they cannot resolve are not necessarily wrong.
+ *
+ * @section target-validator-threads Thread safety
+ *
+ * The threads only read the document, through the const accessors of its
+ * elements, and the prepared models, which are shared between them.
+ * Neither the document nor its error log may be used by other threads
+ * while it is validated.
+ */
+
+#ifndef SedTargetValidator_h
+#define SedTargetValidator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedModelCache;
+
+
+class LIBSEDML_EXTERN SedTargetValidator
+{
+public:
+
+  /**
+   * Creates a new SedTargetValidator preparing models with @p cache,
+   * whose models must be XMLNode trees, and using @p numThreads threads.
+   * A value of zero uses one thread per available processor.  The cache
+   * is not owned and must outlive the validator.
+   */
+  SedTargetValidator (SedModelCache& cache, unsigned int numThreads = 0);
+
+
+  /**
+   * Destroys this SedTargetValidator.
+   */
+  virtual ~SedTargetValidator ();
+
+
+  /**
+   * Declares the namespace @p uri for @p prefix in targets, as
+   * SedXPathCache::addNamespace().
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p prefix is empty
+   */
+  int addNamespace (const std::string& prefix, const std::string& uri);
+
+
+  /**
+   * Sets the number of threads used; zero means one per processor.
+   */
+  void setNumThreads (unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads the next validation will use at most.
+   */
+  unsigned int getNumThreads () const;
+
+
+  /**
+   * Checks the targets of @p doc and logs those that do not resolve in
+   * its SedErrorLog, after the errors already there.
+   *
+   * @return the number of errors found, 0 if @p doc is @c NULL.
+   */
+  unsigned int validate (SedDocument* doc) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedModelCache&                      mCache;
+  std::map<std::string, std::string>  mNamespaces;
+  unsigned int                        mNumThreads;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedTargetValidator (const SedTargetValidator& orig);
+  SedTargetValidator& operator= (const SedTargetValidator& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedTargetValidator preparing models with @p cache and
+ * using @p numThreads threads, zero meaning one per processor, and
+ * returns it.
+ */
+LIBSEDML_EXTERN
+SedTargetValidator_t *
+SedTargetValidator_create (SedModelCache_t *cache, unsigned int numThreads);
+
+
+/**
+ * Frees the given SedTargetValidator.
+ */
+LIBSEDML_EXTERN
+void
+SedTargetValidator_free (SedTargetValidator_t *stv);
+
+
+/**
+ * Declares the namespace @p uri for @p prefix in targets.
+ */
+LIBSEDML_EXTERN
+int
+SedTargetValidator_addNamespace (SedTargetValidator_t *stv,
+                                 const char *prefix, const char *uri);
+
+
+/**
+ * Checks the targets of @p doc, logging those that do not resolve in its
+ * error log, and returns their number.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedTargetValidator_validate (const SedTargetValidator_t *stv,
+                             SedDocument_t *doc);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedTargetValidator_h */
@@ -53,6 +53,8 @@ SedTask::SedTask (unsigned int level, unsigned int version)
 	, mName ("")
 	, mModelReference ("")
 	, mSimulationReference ("")
+	, mReferencedModel (NULL)
+	, mReferencedSimulation (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -72,6 +74,8 @@ SedTask::SedTask (SedNamespaces* sedns)
 	, mName ("")
 	, mModelReference ("")
 	, mSimulationReference ("")
+	, mReferencedModel (NULL)
+	, mReferencedSimulation (NULL)
 
 {
 	// set the element namespace of this object
@@ -97,7 +101,9 @@ SedTask::SedTask (const SedTask& orig)
 		mId  = orig.mId;
 		mName  = orig.mName;
 		mModelReference  = orig.mModelReference;
+		mReferencedModel  = NULL;
 		mSimulationReference  = orig.mSimulationReference;
+		mReferencedSimulation  = NULL;
 
 		// connect to child objects
 		connectToChild();
@@ -121,7 +127,9 @@ SedTask::operator=(const SedTask& rhs)
 		mId  = rhs.mId;
 		mName  = rhs.mName;
 		mModelReference  = rhs.mModelReference;
+		mReferencedModel  = NULL;
 		mSimulationReference  = rhs.mSimulationReference;
+		mReferencedSimulation  = NULL;
 
 		// connect to child objects
 		connectToChild();
@@ -234,7 +242,11 @@ SedTask::isSetSimulationReference() const
 int
 SedTask::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -244,6 +256,8 @@ SedTask::setId(const std::string& id)
 int
 SedTask::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -262,6 +276,8 @@ SedTask::setName(const std::string& name)
 int
 SedTask::setModelReference(const std::string& modelReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(modelReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -273,6 +289,7 @@ SedTask::setModelReference(const std::string& modelReference)
 	else
 	{
 		mModelReference = modelReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -284,6 +301,8 @@ SedTask::setModelReference(const std::string& modelReference)
 int
 SedTask::setSimulationReference(const std::string& simulationReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(simulationReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -295,6 +314,7 @@ SedTask::setSimulationReference(const std::string& simulationReference)
 	else
 	{
 		mSimulationReference = simulationReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -306,7 +326,10 @@ SedTask::setSimulationReference(const std::string& simulationReference)
 int
 SedTask::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -325,6 +348,8 @@ SedTask::unsetId()
 int
 SedTask::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -344,7 +369,10 @@ SedTask::unsetName()
 int
 SedTask::unsetModelReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mModelReference.erase();
+	notifyReferencesChanged();
 
 	if (mModelReference.empty() == true)
 	{
@@ -363,7 +391,10 @@ SedTask::unsetModelReference()
 int
 SedTask::unsetSimulationReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mSimulationReference.erase();
+	notifyReferencesChanged();
 
 	if (mSimulationReference.empty() == true)
 	{
@@ -376,14 +407,56 @@ SedTask::unsetSimulationReference()
 }
 
 
+/*
+ * Returns the SedModel referenced by the "modelReference" attribute.
+ */
+SedModel*
+SedTask::getReferencedModel()
+{
+	updateReferences();
+	return mReferencedModel;
+}
+
+
+/*
+ * Returns the SedSimulation referenced by the "simulationReference" attribute.
+ */
+SedSimulation*
+SedTask::getReferencedSimulation()
+{
+	updateReferences();
+	return mReferencedSimulation;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Resolves the reference attributes of this SedTask against the document.
+ */
+void
+SedTask::lookupReferences(SedDocument* doc)
+{
+	mReferencedModel = (doc != NULL && isSetModelReference())
+		? doc->getModel(mModelReference) : NULL;
+	mReferencedSimulation = (doc != NULL && isSetSimulationReference())
+		? doc->getSimulation(mSimulationReference) : NULL;
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sSedTaskName("task");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedTask::getElementName () const
 {
-	static const string name = "task";
-	return name;
+	return sSedTaskName;
 }
 
 
@@ -397,8 +470,6 @@ SedTask::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedBase::connectToChild();
-
 	return object;
 }
 
@@ -469,13 +540,12 @@ SedTask::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedTask::accept (SedVisitor& v) const
+SedTask::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -530,10 +600,21 @@ SedTask::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u },
+		{ "modelReference", 0x8e1cb58fu },
+		{ "simulationReference", 0x7a8f14a3u }
+	};
+	int index[4];
+	findAttributes(attributes, names, 4, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -552,7 +633,7 @@ SedTask::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -567,7 +648,7 @@ SedTask::readAttributes (const XMLAttributes& attributes,
 	//
 	// modelReference SIdRef   ( use = "optional" )
 	//
-	assigned = attributes.readInto("modelReference", mModelReference, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[2], "modelReference", mModelReference, false);
 
 	if (assigned == true)
 	{
@@ -586,7 +667,7 @@ SedTask::readAttributes (const XMLAttributes& attributes,
 	//
 	// simulationReference SIdRef   ( use = "optional" )
 	//
-	assigned = attributes.readInto("simulationReference", mSimulationReference, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[3], "simulationReference", mSimulationReference, false);
 
 	if (assigned == true)
 	{
@@ -608,6 +689,12 @@ SedTask::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sModelReferenceAttribute("modelReference");
+static const std::string sSimulationReferenceAttribute("simulationReference");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -618,17 +705,45 @@ SedTask::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		stream.writeAttribute(sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		stream.writeAttribute(sNameAttribute, prefix, mName);
 
 	if (isSetModelReference() == true)
-		stream.writeAttribute("modelReference", getPrefix(), mModelReference);
+		stream.writeAttribute(sModelReferenceAttribute, prefix, mModelReference);
 
 	if (isSetSimulationReference() == true)
-		stream.writeAttribute("simulationReference", getPrefix(), mSimulationReference);
+		stream.writeAttribute(sSimulationReferenceAttribute, prefix, mSimulationReference);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedTask::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		addAttribute(attributes, sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		addAttribute(attributes, sNameAttribute, prefix, mName);
+
+	if (isSetModelReference() == true)
+		addAttribute(attributes, sModelReferenceAttribute, prefix, mModelReference);
+
+	if (isSetSimulationReference() == true)
+		addAttribute(attributes, sSimulationReferenceAttribute, prefix, mSimulationReference);
 
 }
 
@@ -704,10 +819,7 @@ SedListOfTasks::get(const std::string& sid)
 const SedTask*
 SedListOfTasks::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedTask>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedTask*> (*result);
+	return static_cast <const SedTask*> (getItemById(sid));
 }
 
 
@@ -732,6 +844,17 @@ SedListOfTasks::addTask(const SedTask* st)
 }
 
 
+/*
+ * Adds the given SedTask to this SedListOfTasks, which takes ownership of it.
+ */
+int
+SedListOfTasks::addTaskAndOwn(SedTask* st)
+{
+	if(st == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(st);
+}
+
+
 /**
  * Get the number of SedTask objects in this SedListOfTasks.
  *
@@ -754,7 +877,8 @@ SedListOfTasks::getNumTasks() const
 SedTask* 
 SedListOfTasks::createTask()
 {
-	SedTask *temp = new SedTask();
+	if (isFrozen()) return NULL;
+	SedTask *temp = new (getArena()) SedTask();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -775,19 +899,11 @@ SedListOfTasks::remove(unsigned int n)
 SedTask*
 SedListOfTasks::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedTask>(sid) );
+	return static_cast <SedTask*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedTask*> (item);
-}
+static const std::string sSedListOfTasksName("listOfTasks");
 
 
 /*
@@ -796,8 +912,7 @@ SedListOfTasks::remove(const std::string& sid)
 const std::string&
 SedListOfTasks::getElementName () const
 {
-	static const string name = "listOfTasks";
-	return name;
+	return sSedListOfTasksName;
 }
 
 
@@ -834,7 +949,7 @@ SedListOfTasks::createObject(XMLInputStream& stream)
 
 	if (name == "task")
 	{
-		object = new SedTask(getSedNamespaces());
+		object = new (getArena()) SedTask(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -859,7 +974,8 @@ SedListOfTasks::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -927,6 +1043,20 @@ SedTask_getId(SedTask_t * st)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedTask_getIdView(const SedTask_t * st)
+{
+	if (st == NULL)
+		return NULL;
+
+	return st->getId().empty() ? NULL : st->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -941,6 +1071,20 @@ SedTask_getName(SedTask_t * st)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedTask_getNameView(const SedTask_t * st)
+{
+	if (st == NULL)
+		return NULL;
+
+	return st->getName().empty() ? NULL : st->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -955,6 +1099,20 @@ SedTask_getModelReference(SedTask_t * st)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedTask_getModelReferenceView(const SedTask_t * st)
+{
+	if (st == NULL)
+		return NULL;
+
+	return st->getModelReference().empty() ? NULL : st->getModelReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -969,6 +1127,20 @@ SedTask_getSimulationReference(SedTask_t * st)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedTask_getSimulationReferenceView(const SedTask_t * st)
+{
+	if (st == NULL)
+		return NULL;
+
+	return st->getSimulationReference().empty() ? NULL : st->getSimulationReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1101,6 +1273,28 @@ SedTask_unsetSimulationReference(SedTask_t * st)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedModel_t *
+SedTask_getReferencedModel(SedTask_t * st)
+{
+	return (st != NULL) ? st->getReferencedModel() : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedSimulation_t *
+SedTask_getReferencedSimulation(SedTask_t * st)
+{
+	return (st != NULL) ? st->getReferencedSimulation() : NULL;
+}
+
+
 /**
  * write comments
  */
@@ -62,10 +62,12 @@ class LIBSEDML_EXTERN SedTask : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
-	std::string   mModelReference;
-	std::string   mSimulationReference;
+	SedSymbol   mId;
+	SedOptionalString   mName;
+	SedSymbol   mModelReference;
+	SedSymbol   mSimulationReference;
+	SedModel*   mReferencedModel;
+	SedSimulation*   mReferencedSimulation;
 
 
 public:
@@ -306,6 +308,30 @@ public:
 	virtual int unsetSimulationReference();
 
 
+	/**
+	 * Returns the SedModel that the "modelReference" attribute of this SedTask
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedModel.
+	 */
+	SedModel* getReferencedModel();
+
+
+	/**
+	 * Returns the SedSimulation that the "simulationReference" attribute of this SedTask
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedSimulation.
+	 */
+	SedSimulation* getReferencedSimulation();
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedTask, is
 	 * always @c "sedTask".
@@ -389,9 +415,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -421,6 +447,17 @@ public:
 
 protected:
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Resolves the reference attributes of this SedTask against @p doc.
+	 */
+	virtual void lookupReferences(SedDocument* doc);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 /** @cond doxygen-libsbml-internal */
 
 	/**
@@ -463,6 +500,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -577,6 +621,25 @@ public:
 	int addTask(const SedTask* t);
 
 
+	/**
+	 * Adds the given "SedTask" to this SedListOfTasks without copying it; this
+	 * SedListOfTasks takes ownership of @p t and will delete it.
+	 *
+	 * @param t the SedTask object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p t is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addTask(const SedTask* t)
+	 */
+	int addTaskAndOwn(SedTask* t);
+
+
 	/**
 	 * Get the number of Task objects in this SedListOfTasks.
 	 *
@@ -759,21 +822,41 @@ char *
 SedTask_getId(SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+const char *
+SedTask_getIdView(const SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 char *
 SedTask_getName(SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+const char *
+SedTask_getNameView(const SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 char *
 SedTask_getModelReference(SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+const char *
+SedTask_getModelReferenceView(const SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 char *
 SedTask_getSimulationReference(SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+const char *
+SedTask_getSimulationReferenceView(const SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 int
 SedTask_isSetId(SedTask_t * st);
@@ -834,6 +917,16 @@ int
 SedTask_unsetSimulationReference(SedTask_t * st);
 
 
+LIBSEDML_EXTERN
+SedModel_t *
+SedTask_getReferencedModel(SedTask_t * st);
+
+
+LIBSEDML_EXTERN
+SedSimulation_t *
+SedTask_getReferencedSimulation(SedTask_t * st);
+
+
 LIBSEDML_EXTERN
 int
 SedTask_hasRequiredAttributes(SedTask_t * st);
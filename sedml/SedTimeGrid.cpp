@@ -0,0 +1,449 @@
+/**
+ * @file    SedTimeGrid.cpp
+ * @brief   Shared output times of uniform time courses
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedResults.h>
+#include <sedml/common/threads.h>
+
+#include <cstdlib>
+#include <map>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * The parameters a grid is looked up by.
+ */
+struct SedTimeGridKey
+{
+  double initialTime;
+  double outputStartTime;
+  double outputEndTime;
+  int    numberOfPoints;
+
+  bool operator< (const SedTimeGridKey& rhs) const
+  {
+    if (initialTime     != rhs.initialTime)
+      return initialTime < rhs.initialTime;
+    if (outputStartTime != rhs.outputStartTime)
+      return outputStartTime < rhs.outputStartTime;
+    if (outputEndTime   != rhs.outputEndTime)
+      return outputEndTime < rhs.outputEndTime;
+    return numberOfPoints < rhs.numberOfPoints;
+  }
+};
+
+
+/*
+ * The grids held by time courses of the process.
+ */
+struct SedTimeGridTable
+{
+  std::map<SedTimeGridKey, SedTimeGrid*>  grids;
+  SedMutex                                mutex;
+};
+
+
+static SedTimeGridTable*
+createTable ()
+{
+  SedTimeGridTable* table = new SedTimeGridTable;
+  mutexInit(&table->mutex);
+  return table;
+}
+
+
+/*
+ * The table, which is never freed: time courses destroyed at exit,
+ * after it would have been, still release their grids into it.
+ */
+static SedTimeGridTable* sTable = NULL;
+
+
+static SedTimeGridTable*
+getTable ()
+{
+  // only NULL while static objects are constructed, on one thread
+  if (sTable == NULL) sTable = createTable();
+  return sTable;
+}
+
+
+/*
+ * Creates the table before main() rather than on first use, when several
+ * threads could be creating it at once.
+ */
+static SedTimeGridTable* const sTableCreated = getTable();
+
+
+static bool
+isFinite (double value)
+{
+  return value == value && value - value == 0;
+}
+
+
+/*
+ * Returns the key of the given parameters, false if they have no grid.
+ */
+static bool
+makeKey (SedTimeGridKey& key, double initialTime, double outputStartTime,
+         double outputEndTime, int numberOfPoints)
+{
+  if (initialTime != initialTime) initialTime = outputStartTime;
+
+  if (numberOfPoints < 0 || !isFinite(initialTime)
+      || !isFinite(outputStartTime) || !isFinite(outputEndTime)
+      || outputEndTime < outputStartTime
+      || (size_t)numberOfPoints + 2 >
+         ((size_t)-1 - SED_RESULTS_ALIGNMENT) / sizeof(double))
+  {
+    return false;
+  }
+
+  key.initialTime     = initialTime;
+  key.outputStartTime = outputStartTime;
+  key.outputEndTime   = outputEndTime;
+  key.numberOfPoints  = numberOfPoints;
+  return true;
+}
+
+/** @endcond */
+
+
+/*
+ * Returns the grid of the given parameters, adding a reference to it.
+ */
+const SedTimeGrid*
+SedTimeGrid::acquire (double initialTime, double outputStartTime,
+                      double outputEndTime, int numberOfPoints)
+{
+  SedTimeGridKey key;
+  if (!makeKey(key, initialTime, outputStartTime, outputEndTime,
+               numberOfPoints))
+  {
+    return NULL;
+  }
+
+  SedTimeGridTable* table = getTable();
+  mutexLock(&table->mutex);
+
+  SedTimeGrid* grid = NULL;
+
+  std::map<SedTimeGridKey, SedTimeGrid*>::iterator it =
+    table->grids.find(key);
+  if (it != table->grids.end())
+  {
+    grid = it->second;
+    ++grid->mRefs;
+  }
+  else
+  {
+    grid = new SedTimeGrid(key.initialTime, key.outputStartTime,
+                           key.outputEndTime, key.numberOfPoints);
+    if (grid->mBlock == NULL)
+    {
+      delete grid;
+      grid = NULL;
+    }
+    else
+    {
+      table->grids[key] = grid;
+    }
+  }
+
+  mutexUnlock(&table->mutex);
+
+  return grid;
+}
+
+
+/*
+ * Drops a reference to grid.
+ */
+void
+SedTimeGrid::release (const SedTimeGrid* grid)
+{
+  if (grid == NULL) return;
+
+  SedTimeGrid* held = const_cast<SedTimeGrid*>(grid);
+
+  SedTimeGridTable* table = getTable();
+  mutexLock(&table->mutex);
+
+  const bool last = (--held->mRefs == 0);
+  if (last)
+  {
+    SedTimeGridKey key;
+    key.initialTime     = held->mInitialTime;
+    key.outputStartTime = held->mOutputStartTime;
+    key.outputEndTime   = held->mOutputEndTime;
+    key.numberOfPoints  = held->mNumberOfPoints;
+    table->grids.erase(key);
+  }
+
+  mutexUnlock(&table->mutex);
+
+  if (last) delete held;
+}
+
+
+/*
+ * Makes grid the grid of the given parameters.
+ */
+const SedTimeGrid*
+SedTimeGrid::update (const SedTimeGrid*& grid, double initialTime,
+                     double outputStartTime, double outputEndTime,
+                     int numberOfPoints)
+{
+  SedTimeGridTable* table = getTable();
+
+  // the check is made under the lock, as several threads may ask the same
+  // time course for its grid at once
+  mutexLock(&table->mutex);
+  const SedTimeGrid* current = grid;
+  const bool valid = (current != NULL
+                      && current->matches(initialTime, outputStartTime,
+                                          outputEndTime, numberOfPoints));
+  mutexUnlock(&table->mutex);
+
+  if (valid) return current;
+
+  const SedTimeGrid* replacement =
+    acquire(initialTime, outputStartTime, outputEndTime, numberOfPoints);
+
+  mutexLock(&table->mutex);
+  const SedTimeGrid* previous = grid;
+  const bool raced = (previous != current);
+  if (!raced) grid = replacement;
+  mutexUnlock(&table->mutex);
+
+  // another thread got there first, with the same parameters
+  if (raced)
+  {
+    release(replacement);
+    return previous;
+  }
+
+  release(previous);
+  return replacement;
+}
+
+
+/*
+ * Returns the number of grids held.
+ */
+unsigned int
+SedTimeGrid::getNumEntries ()
+{
+  SedTimeGridTable* table = getTable();
+  mutexLock(&table->mutex);
+  const unsigned int numEntries = (unsigned int)table->grids.size();
+  mutexUnlock(&table->mutex);
+
+  return numEntries;
+}
+
+
+double
+SedTimeGrid::getInitialTime () const
+{
+  return mInitialTime;
+}
+
+
+double
+SedTimeGrid::getOutputStartTime () const
+{
+  return mOutputStartTime;
+}
+
+
+double
+SedTimeGrid::getOutputEndTime () const
+{
+  return mOutputEndTime;
+}
+
+
+int
+SedTimeGrid::getNumberOfPoints () const
+{
+  return mNumberOfPoints;
+}
+
+
+const double*
+SedTimeGrid::getOutputTimes () const
+{
+  return mStepTimes + mFirstOutputStep;
+}
+
+
+size_t
+SedTimeGrid::getNumOutputTimes () const
+{
+  return (size_t)mNumberOfPoints + 1;
+}
+
+
+const double*
+SedTimeGrid::getStepTimes () const
+{
+  return mStepTimes;
+}
+
+
+size_t
+SedTimeGrid::getNumSteps () const
+{
+  return mNumSteps;
+}
+
+
+size_t
+SedTimeGrid::getFirstOutputStep () const
+{
+  return mFirstOutputStep;
+}
+
+
+/*
+ * Returns the index of the output time step is, or -1.
+ */
+long
+SedTimeGrid::getOutputIndex (size_t step) const
+{
+  if (step < mFirstOutputStep || step >= mNumSteps) return -1;
+  return (long)(step - mFirstOutputStep);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Computes the times of a grid; mBlock is NULL if they do not fit in
+ * memory.
+ */
+SedTimeGrid::SedTimeGrid (double initialTime, double outputStartTime,
+                          double outputEndTime, int numberOfPoints)
+  : mInitialTime (initialTime)
+  , mOutputStartTime (outputStartTime)
+  , mOutputEndTime (outputEndTime)
+  , mNumberOfPoints (numberOfPoints)
+  , mBlock (NULL)
+  , mStepTimes (NULL)
+  , mNumSteps (0)
+  , mFirstOutputStep ((initialTime < outputStartTime) ? 1 : 0)
+  , mRefs (1)
+{
+  mNumSteps = mFirstOutputStep + (size_t)numberOfPoints + 1;
+
+  // the time buffer of the first output is aligned, as SedResults columns
+  // are, so that the output times can be handed on as a column
+  const size_t extra = mFirstOutputStep * sizeof(double);
+  mBlock = malloc(mNumSteps * sizeof(double) + SED_RESULTS_ALIGNMENT);
+  if (mBlock == NULL) return;
+
+  const size_t address = (size_t)mBlock + extra;
+  const size_t offset  = (SED_RESULTS_ALIGNMENT
+                          - address % SED_RESULTS_ALIGNMENT)
+                         % SED_RESULTS_ALIGNMENT;
+
+  double* times = (double*)((char*)mBlock + offset);
+  mStepTimes = times;
+
+  if (mFirstOutputStep > 0) times[0] = initialTime;
+
+  double* output = times + mFirstOutputStep;
+  const double span = outputEndTime - outputStartTime;
+  for (int i = 0; i < numberOfPoints; ++i)
+  {
+    // each time from its own index, so that errors do not accumulate
+    output[i] = outputStartTime + span * ((double)i / numberOfPoints);
+  }
+  output[numberOfPoints] = outputEndTime;
+}
+
+
+SedTimeGrid::~SedTimeGrid ()
+{
+  free(mBlock);
+}
+
+
+/*
+ * Returns true if the grid is the grid of the given parameters.
+ */
+bool
+SedTimeGrid::matches (double initialTime, double outputStartTime,
+                      double outputEndTime, int numberOfPoints) const
+{
+  if (initialTime != initialTime) initialTime = outputStartTime;
+
+  return mInitialTime == initialTime
+      && mOutputStartTime == outputStartTime
+      && mOutputEndTime == outputEndTime
+      && mNumberOfPoints == numberOfPoints;
+}
+
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const double *
+SedTimeGrid_getOutputTimes (const SedTimeGrid_t *grid, size_t *length)
+{
+  if (length != NULL) *length = (grid != NULL) ? grid->getNumOutputTimes() : 0;
+  return (grid != NULL) ? grid->getOutputTimes() : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const double *
+SedTimeGrid_getStepTimes (const SedTimeGrid_t *grid, size_t *length)
+{
+  if (length != NULL) *length = (grid != NULL) ? grid->getNumSteps() : 0;
+  return (grid != NULL) ? grid->getStepTimes() : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+long
+SedTimeGrid_getOutputIndex (const SedTimeGrid_t *grid, size_t step)
+{
+  return (grid != NULL) ? grid->getOutputIndex(step) : -1;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
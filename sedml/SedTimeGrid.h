@@ -0,0 +1,234 @@
+/**
+ * @file    SedTimeGrid.h
+ * @brief   Shared output times of uniform time courses
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTimeGrid
+ * @ingroup Core
+ * @brief The output times of a SedUniformTimeCourse, computed once.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A SedTimeGrid holds the @c numberOfPoints + 1 output times of a uniform
+ * time course, from @c outputStartTime to @c outputEndTime, in a buffer
+ * aligned to SED_RESULTS_ALIGNMENT bytes that can be used directly as
+ * the time column of a SedResults.  The first time is the start and the
+ * last one the end exactly; the others are the start plus a multiple of
+ * the step, each computed once.
+ *
+ * A solver reporting at the output times steps through getStepTimes():
+ * @c initialTime, when it comes before @c outputStartTime, and then the
+ * output times.  getOutputIndex() maps a step to the output time it is,
+ * so that results can be stored without comparing times.
+ *
+ * Grids are immutable and shared: every time course of the process with
+ * the same four parameters gets the same grid from
+ * SedUniformTimeCourse::getTimeGrid(), however many tasks and documents
+ * use it.  All methods may be called by several threads at once.
+ */
+
+#ifndef SedTimeGrid_h
+#define SedTimeGrid_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedTimeGrid
+{
+public:
+
+  /**
+   * Returns the grid of the given parameters, adding a reference to it;
+   * an unset (NaN) @p initialTime is taken to be @p outputStartTime.
+   *
+   * @return the grid, or @c NULL if @p numberOfPoints is negative, a time
+   * is not finite or @p outputEndTime comes before @p outputStartTime.
+   */
+  static const SedTimeGrid* acquire (double initialTime,
+                                     double outputStartTime,
+                                     double outputEndTime,
+                                     int numberOfPoints);
+
+
+  /**
+   * Drops a reference to @p grid, which may be @c NULL.
+   */
+  static void release (const SedTimeGrid* grid);
+
+
+  /**
+   * Makes @p grid the grid of the given parameters, unless it is already:
+   * the grid it held, if any, is released and the new one acquired.
+   *
+   * @return the grid now held, or @c NULL.
+   */
+  static const SedTimeGrid* update (const SedTimeGrid*& grid,
+                                    double initialTime,
+                                    double outputStartTime,
+                                    double outputEndTime,
+                                    int numberOfPoints);
+
+
+  /**
+   * @return the number of grids held by any time course.
+   */
+  static unsigned int getNumEntries ();
+
+
+  /** @return the initial time of the grid. */
+  double getInitialTime () const;
+
+  /** @return the output start time of the grid. */
+  double getOutputStartTime () const;
+
+  /** @return the output end time of the grid. */
+  double getOutputEndTime () const;
+
+  /** @return the number of points of the grid, one less than its times. */
+  int getNumberOfPoints () const;
+
+
+  /**
+   * @return the getNumOutputTimes() output times, aligned to
+   * SED_RESULTS_ALIGNMENT bytes.
+   */
+  const double* getOutputTimes () const;
+
+
+  /**
+   * @return the number of output times, @c numberOfPoints + 1.
+   */
+  size_t getNumOutputTimes () const;
+
+
+  /**
+   * @return the getNumSteps() times a solver reports at: the initial time
+   * if it comes before the output start time, then the output times.
+   */
+  const double* getStepTimes () const;
+
+
+  /**
+   * @return the number of step times.
+   */
+  size_t getNumSteps () const;
+
+
+  /**
+   * @return the step of the first output time, 1 if the initial time
+   * comes before the output start time and 0 otherwise.
+   */
+  size_t getFirstOutputStep () const;
+
+
+  /**
+   * @return the index in getOutputTimes() of step @p step, or -1 if the
+   * step is not an output time.
+   */
+  long getOutputIndex (size_t step) const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  SedTimeGrid (double initialTime, double outputStartTime,
+               double outputEndTime, int numberOfPoints);
+
+  ~SedTimeGrid ();
+
+  bool matches (double initialTime, double outputStartTime,
+                double outputEndTime, int numberOfPoints) const;
+
+
+  double        mInitialTime;
+  double        mOutputStartTime;
+  double        mOutputEndTime;
+  int           mNumberOfPoints;
+
+  void*         mBlock;
+  const double* mStepTimes;
+  size_t        mNumSteps;
+  size_t        mFirstOutputStep;
+
+  unsigned int  mRefs;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedTimeGrid (const SedTimeGrid& orig);
+  SedTimeGrid& operator= (const SedTimeGrid& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Returns the output times of @p grid, storing their number in
+ * @p length.
+ */
+LIBSEDML_EXTERN
+const double *
+SedTimeGrid_getOutputTimes (const SedTimeGrid_t *grid, size_t *length);
+
+
+/**
+ * Returns the step times of @p grid, storing their number in @p length.
+ */
+LIBSEDML_EXTERN
+const double *
+SedTimeGrid_getStepTimes (const SedTimeGrid_t *grid, size_t *length);
+
+
+/**
+ * Returns the index of the output time step @p step of @p grid is, or -1.
+ */
+LIBSEDML_EXTERN
+long
+SedTimeGrid_getOutputIndex (const SedTimeGrid_t *grid, size_t step);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedTimeGrid_h */
@@ -0,0 +1,337 @@
+/**
+ * @file    SedTypeTraits.h
+ * @brief   Compile-time type codes and checked downcasts for Sed objects
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedTypeTraits
+ * @ingroup Core
+ * @brief Maps each Sed class to its type code at compile time.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SedTypeTraits<T>::typeCode is the type code (see #SedTypeCode_t) of
+ * the objects of class @p T, and SedTypeTraits<T>::is() tells whether an
+ * object is a @p T, comparing type codes rather than using run-time type
+ * information.  For a base class such as SedChange, SedOutput,
+ * SedSimulation or SedCurve, is() accepts the type codes of the derived
+ * classes as well; the lists are told apart by the type code of their
+ * items (see SedListOf::getItemTypeCode()).  Classes that are not Sed
+ * objects have no SedTypeTraits, so using them is a compile error.
+ *
+ * sedml_cast<T>() builds on it: it returns its argument as a @p T, or
+ * @c NULL if it is not one, like @c dynamic_cast but with a virtual call
+ * and a comparison:
+ *
+ * @code{.cpp}
+if (const SedTask* task = sedml_cast<SedTask>(element))
+{
+  ...
+}
+@endcode
+ *
+ * sedml_visitByType() calls the overload of a function object for the
+ * concrete class of an object, through one switch on its type code, which
+ * compilers turn into a jump table:
+ *
+ * @code{.cpp}
+struct CountTasks
+{
+  unsigned int count;
+  template <class T> void operator() (const T&) { }
+  void operator() (const SedTask&) { ++count; }
+};
+
+CountTasks counter = { 0 };
+sedml_visitByType(*element, counter);
+@endcode
+ */
+
+#ifndef SedTypeTraits_h
+#define SedTypeTraits_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedTypeCodes.h>
+
+
+#ifdef __cplusplus
+
+
+#include <sedml/SedBase.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedModel.h>
+#include <sedml/SedChange.h>
+#include <sedml/SedParameter.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedRemoveXML.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedSimulation.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedOutput.h>
+#include <sedml/SedCurve.h>
+#include <sedml/SedSurface.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+template <class T> struct SedTypeTraits;
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Traits of a class whose objects all have the one type code CODE.
+ */
+#define SEDML_TYPE_TRAITS(CLASS, CODE)                                 \
+template <> struct SedTypeTraits<CLASS>                                \
+{                                                                      \
+  enum { typeCode = CODE };                                            \
+  static bool is (const SedBase* x)                                    \
+  { return x != NULL && x->getTypeCode() == CODE; }                    \
+};
+
+/*
+ * Traits of a list class, whose items have the type code ITEM.
+ */
+#define SEDML_LIST_TYPE_TRAITS(CLASS, ITEM)                            \
+template <> struct SedTypeTraits<CLASS>                                \
+{                                                                      \
+  enum { typeCode = SEDML_LIST_OF, itemTypeCode = ITEM };              \
+  static bool is (const SedBase* x)                                    \
+  {                                                                    \
+    return x != NULL && x->getTypeCode() == SEDML_LIST_OF              \
+      && static_cast<const SedListOf*>(x)->getItemTypeCode() == ITEM;  \
+  }                                                                    \
+};
+
+/** @endcond */
+
+
+template <> struct SedTypeTraits<SedBase>
+{
+  enum { typeCode = SEDML_UNKNOWN };
+  static bool is (const SedBase* x) { return x != NULL; }
+};
+
+
+template <> struct SedTypeTraits<SedListOf>
+{
+  enum { typeCode = SEDML_LIST_OF };
+  static bool is (const SedBase* x)
+  { return x != NULL && x->getTypeCode() == SEDML_LIST_OF; }
+};
+
+
+template <> struct SedTypeTraits<SedChange>
+{
+  enum { typeCode = SEDML_CHANGE };
+  static bool is (const SedBase* x)
+  {
+    if (x == NULL) return false;
+    const int tc = x->getTypeCode();
+    return tc == SEDML_CHANGE
+        || tc == SEDML_CHANGE_ATTRIBUTE
+        || tc == SEDML_CHANGE_REMOVEXML
+        || tc == SEDML_CHANGE_COMPUTECHANGE;
+  }
+};
+
+
+template <> struct SedTypeTraits<SedSimulation>
+{
+  enum { typeCode = SEDML_SIMULATION };
+  static bool is (const SedBase* x)
+  {
+    if (x == NULL) return false;
+    const int tc = x->getTypeCode();
+    return tc == SEDML_SIMULATION
+        || tc == SEDML_SIMULATION_UNIFORMTIMECOURSE;
+  }
+};
+
+
+template <> struct SedTypeTraits<SedOutput>
+{
+  enum { typeCode = SEDML_OUTPUT };
+  static bool is (const SedBase* x)
+  {
+    if (x == NULL) return false;
+    const int tc = x->getTypeCode();
+    return tc == SEDML_OUTPUT
+        || tc == SEDML_OUTPUT_REPORT
+        || tc == SEDML_OUTPUT_PLOT2D
+        || tc == SEDML_OUTPUT_PLOT3D;
+  }
+};
+
+
+template <> struct SedTypeTraits<SedCurve>
+{
+  enum { typeCode = SEDML_OUTPUT_CURVE };
+  static bool is (const SedBase* x)
+  {
+    if (x == NULL) return false;
+    const int tc = x->getTypeCode();
+    return tc == SEDML_OUTPUT_CURVE
+        || tc == SEDML_OUTPUT_SURFACE;
+  }
+};
+
+
+SEDML_TYPE_TRAITS(SedDocument,          SEDML_DOCUMENT)
+SEDML_TYPE_TRAITS(SedModel,             SEDML_MODEL)
+SEDML_TYPE_TRAITS(SedParameter,         SEDML_PARAMETER)
+SEDML_TYPE_TRAITS(SedVariable,          SEDML_VARIABLE)
+SEDML_TYPE_TRAITS(SedChangeAttribute,   SEDML_CHANGE_ATTRIBUTE)
+SEDML_TYPE_TRAITS(SedRemoveXML,         SEDML_CHANGE_REMOVEXML)
+SEDML_TYPE_TRAITS(SedComputeChange,     SEDML_CHANGE_COMPUTECHANGE)
+SEDML_TYPE_TRAITS(SedUniformTimeCourse, SEDML_SIMULATION_UNIFORMTIMECOURSE)
+SEDML_TYPE_TRAITS(SedAlgorithm,         SEDML_SIMULATION_ALGORITHM)
+SEDML_TYPE_TRAITS(SedTask,              SEDML_TASK)
+SEDML_TYPE_TRAITS(SedDataGenerator,     SEDML_DATAGENERATOR)
+SEDML_TYPE_TRAITS(SedSurface,           SEDML_OUTPUT_SURFACE)
+SEDML_TYPE_TRAITS(SedDataSet,           SEDML_OUTPUT_DATASET)
+SEDML_TYPE_TRAITS(SedReport,            SEDML_OUTPUT_REPORT)
+SEDML_TYPE_TRAITS(SedPlot2D,            SEDML_OUTPUT_PLOT2D)
+SEDML_TYPE_TRAITS(SedPlot3D,            SEDML_OUTPUT_PLOT3D)
+
+SEDML_LIST_TYPE_TRAITS(SedListOfModels,          SEDML_MODEL)
+SEDML_LIST_TYPE_TRAITS(SedListOfChanges,         SEDML_CHANGE)
+SEDML_LIST_TYPE_TRAITS(SedListOfParameters,      SEDML_PARAMETER)
+SEDML_LIST_TYPE_TRAITS(SedListOfVariables,       SEDML_VARIABLE)
+SEDML_LIST_TYPE_TRAITS(SedListOfSimulations,     SEDML_SIMULATION)
+SEDML_LIST_TYPE_TRAITS(SedListOfTasks,           SEDML_TASK)
+SEDML_LIST_TYPE_TRAITS(SedListOfDataGenerators,  SEDML_DATAGENERATOR)
+SEDML_LIST_TYPE_TRAITS(SedListOfOutputs,         SEDML_OUTPUT)
+SEDML_LIST_TYPE_TRAITS(SedListOfCurves,          SEDML_OUTPUT_CURVE)
+SEDML_LIST_TYPE_TRAITS(SedListOfSurfaces,        SEDML_OUTPUT_SURFACE)
+SEDML_LIST_TYPE_TRAITS(SedListOfDataSets,        SEDML_OUTPUT_DATASET)
+
+#undef SEDML_TYPE_TRAITS
+#undef SEDML_LIST_TYPE_TRAITS
+
+
+/**
+ * Returns @p x as a @p T, or @c NULL if it is not one.
+ */
+template <class T>
+inline T*
+sedml_cast (SedBase* x)
+{
+  return SedTypeTraits<T>::is(x) ? static_cast<T*>(x) : NULL;
+}
+
+
+/**
+ * Returns @p x as a @p T, or @c NULL if it is not one.
+ */
+template <class T>
+inline const T*
+sedml_cast (const SedBase* x)
+{
+  return SedTypeTraits<T>::is(x) ? static_cast<const T*>(x) : NULL;
+}
+
+
+/**
+ * Calls @p f with @p x as an object of its concrete class, chosen by its
+ * type code.  Lists are passed as SedListOf, and objects of unknown type
+ * codes as SedBase.
+ *
+ * @return what @p f returns.
+ */
+template <class R, class F>
+inline R
+sedml_visitByType (const SedBase& x, F& f)
+{
+  switch (x.getTypeCode())
+  {
+  case SEDML_DOCUMENT:
+    return f(static_cast<const SedDocument&>(x));
+  case SEDML_MODEL:
+    return f(static_cast<const SedModel&>(x));
+  case SEDML_CHANGE:
+    return f(static_cast<const SedChange&>(x));
+  case SEDML_PARAMETER:
+    return f(static_cast<const SedParameter&>(x));
+  case SEDML_VARIABLE:
+    return f(static_cast<const SedVariable&>(x));
+  case SEDML_CHANGE_ATTRIBUTE:
+    return f(static_cast<const SedChangeAttribute&>(x));
+  case SEDML_CHANGE_REMOVEXML:
+    return f(static_cast<const SedRemoveXML&>(x));
+  case SEDML_CHANGE_COMPUTECHANGE:
+    return f(static_cast<const SedComputeChange&>(x));
+  case SEDML_SIMULATION:
+    return f(static_cast<const SedSimulation&>(x));
+  case SEDML_SIMULATION_UNIFORMTIMECOURSE:
+    return f(static_cast<const SedUniformTimeCourse&>(x));
+  case SEDML_SIMULATION_ALGORITHM:
+    return f(static_cast<const SedAlgorithm&>(x));
+  case SEDML_TASK:
+    return f(static_cast<const SedTask&>(x));
+  case SEDML_DATAGENERATOR:
+    return f(static_cast<const SedDataGenerator&>(x));
+  case SEDML_OUTPUT:
+    return f(static_cast<const SedOutput&>(x));
+  case SEDML_OUTPUT_CURVE:
+    return f(static_cast<const SedCurve&>(x));
+  case SEDML_OUTPUT_SURFACE:
+    return f(static_cast<const SedSurface&>(x));
+  case SEDML_OUTPUT_DATASET:
+    return f(static_cast<const SedDataSet&>(x));
+  case SEDML_OUTPUT_REPORT:
+    return f(static_cast<const SedReport&>(x));
+  case SEDML_OUTPUT_PLOT2D:
+    return f(static_cast<const SedPlot2D&>(x));
+  case SEDML_OUTPUT_PLOT3D:
+    return f(static_cast<const SedPlot3D&>(x));
+  case SEDML_LIST_OF:
+    return f(static_cast<const SedListOf&>(x));
+  default:
+    return f(x);
+  }
+}
+
+
+/**
+ * Calls @p f with @p x as an object of its concrete class, chosen by its
+ * type code, for function objects returning nothing.
+ */
+template <class F>
+inline void
+sedml_visitByType (const SedBase& x, F& f)
+{
+  sedml_visitByType<void>(x, f);
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedTypeTraits_h */
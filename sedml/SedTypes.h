@@ -54,9 +54,54 @@
 
 #include <sedml/SedBase.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedVisitor.h>
+#include <sedml/SedElementIterator.h>
 
 
 #include <sedml/SedReader.h>
+#include <sedml/SedEventReader.h>
+#include <sedml/SedArchive.h>
+#include <sedml/SedBatchReader.h>
+#include <sedml/SedCompiledMath.h>
+#include <sedml/SedResults.h>
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedExecutor.h>
+#include <sedml/SedSweep.h>
+#include <sedml/SedResultCache.h>
+#include <sedml/SedCheckpoint.h>
+#include <sedml/SedModelCache.h>
+#include <sedml/SedSourceResolver.h>
+#include <sedml/SedRemoteSimulator.h>
+#include <sedml/SedSimulatorAdapter.h>
+#include <sedml/SedPipeline.h>
+#include <sedml/SedXPathCache.h>
+#include <sedml/SedChangeApplier.h>
+#include <sedml/SedMathCache.h>
+#include <sedml/SedTimeGrid.h>
+#include <sedml/SedNumber.h>
+#include <sedml/SedDocumentPatch.h>
+#include <sedml/SedBinaryCodec.h>
+#include <sedml/SedDocumentView.h>
+#include <sedml/SedOutputSink.h>
+#include <sedml/SedProfiler.h>
+#include <sedml/SedCostModel.h>
+#include <sedml/SedKisao.h>
+#include <sedml/SedRandomStream.h>
+#include <sedml/SedResultsComparison.h>
+#include <sedml/SedPlotDecimator.h>
+#include <sedml/SedSurfaceGrid.h>
+#include <sedml/SedSelector.h>
+#include <sedml/SedIncrementalValidator.h>
+#include <sedml/SedParallelValidator.h>
+#include <sedml/SedTargetValidator.h>
+#include <sedml/SedStreamWriter.h>
+#include <sedml/SedDocumentTemplate.h>
+#include <sedml/SedBatchWriter.h>
+#include <sedml/SedDocumentMerger.h>
+#include <sedml/SedAnnotationIndex.h>
+#include <sedml/SedTypeTraits.h>
+#include <sedml/SedXMLTree.h>
+#include <sedml/SedMemoryUsage.h>
 #include <sedml/SedWriter.h>
 
 #include <sbml/xml/XMLError.h>
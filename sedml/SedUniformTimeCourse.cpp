@@ -50,13 +50,14 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 SedUniformTimeCourse::SedUniformTimeCourse (unsigned int level, unsigned int version)
 	: SedSimulation(level, version)
 	, mInitialTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetInitialTime (false)
 	, mOutputStartTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetOutputStartTime (false)
 	, mOutputEndTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetOutputEndTime (false)
 	, mNumberOfPoints (SEDML_INT_MAX)
+	, mIsSetInitialTime (false)
+	, mIsSetOutputStartTime (false)
+	, mIsSetOutputEndTime (false)
 	, mIsSetNumberOfPoints (false)
+	, mTimeGrid (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -70,13 +71,14 @@ SedUniformTimeCourse::SedUniformTimeCourse (unsigned int level, unsigned int ver
 SedUniformTimeCourse::SedUniformTimeCourse (SedNamespaces* sedns)
 	: SedSimulation(sedns)
 	, mInitialTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetInitialTime (false)
 	, mOutputStartTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetOutputStartTime (false)
 	, mOutputEndTime (numeric_limits<double>::quiet_NaN())
-	, mIsSetOutputEndTime (false)
 	, mNumberOfPoints (SEDML_INT_MAX)
+	, mIsSetInitialTime (false)
+	, mIsSetOutputStartTime (false)
+	, mIsSetOutputEndTime (false)
 	, mIsSetNumberOfPoints (false)
+	, mTimeGrid (NULL)
 
 {
 	// set the element namespace of this object
@@ -89,6 +91,7 @@ SedUniformTimeCourse::SedUniformTimeCourse (SedNamespaces* sedns)
  */
 SedUniformTimeCourse::SedUniformTimeCourse (const SedUniformTimeCourse& orig)
 	: SedSimulation(orig)
+	, mTimeGrid (NULL)
 {
 	if (&orig == NULL)
 	{
@@ -149,6 +152,7 @@ SedUniformTimeCourse::clone () const
  */
 SedUniformTimeCourse::~SedUniformTimeCourse ()
 {
+	SedTimeGrid::release(mTimeGrid);
 }
 
 
@@ -238,6 +242,8 @@ SedUniformTimeCourse::isSetNumberOfPoints() const
 int
 SedUniformTimeCourse::setInitialTime(double initialTime)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mInitialTime = initialTime;
 	mIsSetInitialTime = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -250,6 +256,8 @@ SedUniformTimeCourse::setInitialTime(double initialTime)
 int
 SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mOutputStartTime = outputStartTime;
 	mIsSetOutputStartTime = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -262,6 +270,8 @@ SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 int
 SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mOutputEndTime = outputEndTime;
 	mIsSetOutputEndTime = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -274,6 +284,8 @@ SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 int
 SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mNumberOfPoints = numberOfPoints;
 	mIsSetNumberOfPoints = true;
 	return LIBSEDML_OPERATION_SUCCESS;
@@ -286,6 +298,8 @@ SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 int
 SedUniformTimeCourse::unsetInitialTime()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mInitialTime = numeric_limits<double>::quiet_NaN();
 	mIsSetInitialTime = false;
 
@@ -306,6 +320,8 @@ SedUniformTimeCourse::unsetInitialTime()
 int
 SedUniformTimeCourse::unsetOutputStartTime()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mOutputStartTime = numeric_limits<double>::quiet_NaN();
 	mIsSetOutputStartTime = false;
 
@@ -326,6 +342,8 @@ SedUniformTimeCourse::unsetOutputStartTime()
 int
 SedUniformTimeCourse::unsetOutputEndTime()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mOutputEndTime = numeric_limits<double>::quiet_NaN();
 	mIsSetOutputEndTime = false;
 
@@ -346,6 +364,8 @@ SedUniformTimeCourse::unsetOutputEndTime()
 int
 SedUniformTimeCourse::unsetNumberOfPoints()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mNumberOfPoints = SEDML_INT_MAX;
 	mIsSetNumberOfPoints = false;
 
@@ -360,14 +380,55 @@ SedUniformTimeCourse::unsetNumberOfPoints()
 }
 
 
+/*
+ * Returns the shared time grid of the attributes, or NULL.
+ */
+const SedTimeGrid*
+SedUniformTimeCourse::getTimeGrid() const
+{
+	if (!isSetOutputStartTime() || !isSetOutputEndTime()
+		|| !isSetNumberOfPoints())
+	{
+		return NULL;
+	}
+
+	return SedTimeGrid::update(mTimeGrid, mInitialTime, mOutputStartTime,
+	                           mOutputEndTime, mNumberOfPoints);
+}
+
+
+/*
+ * Returns the output times, or NULL.
+ */
+const double*
+SedUniformTimeCourse::getOutputTimes() const
+{
+	const SedTimeGrid* grid = getTimeGrid();
+	return (grid != NULL) ? grid->getOutputTimes() : NULL;
+}
+
+
+/*
+ * Returns the number of output times, or 0.
+ */
+size_t
+SedUniformTimeCourse::getNumOutputTimes() const
+{
+	const SedTimeGrid* grid = getTimeGrid();
+	return (grid != NULL) ? grid->getNumOutputTimes() : 0;
+}
+
+
+static const std::string sSedUniformTimeCourseName("uniformTimeCourse");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedUniformTimeCourse::getElementName () const
 {
-	static const string name = "uniformTimeCourse";
-	return name;
+	return sSedUniformTimeCourseName;
 }
 
 
@@ -381,8 +442,6 @@ SedUniformTimeCourse::createObject(XMLInputStream& stream)
 
 	const string& name   = stream.peek().getName();
 
-	SedSimulation::connectToChild();
-
 	return object;
 }
 
@@ -439,13 +498,12 @@ SedUniformTimeCourse::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedUniformTimeCourse::accept (SedVisitor& v) const
+SedUniformTimeCourse::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -500,25 +558,36 @@ SedUniformTimeCourse::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "initialTime", 0x7b69725au },
+		{ "outputStartTime", 0xe6750bc1u },
+		{ "outputEndTime", 0x98bbbc30u },
+		{ "numberOfPoints", 0x7725cceau }
+	};
+	int index[4];
+	findAttributes(attributes, names, 4, index);
+
 	//
 	// initialTime double   ( use = "required" )
 	//
-	mIsSetInitialTime = attributes.readInto("initialTime", mInitialTime, getErrorLog(), true);
+	mIsSetInitialTime = readAttribute(attributes, index[0], "initialTime", mInitialTime, true);
 
 	//
 	// outputStartTime double   ( use = "required" )
 	//
-	mIsSetOutputStartTime = attributes.readInto("outputStartTime", mOutputStartTime, getErrorLog(), true);
+	mIsSetOutputStartTime = readAttribute(attributes, index[1], "outputStartTime", mOutputStartTime, true);
 
 	//
 	// outputEndTime double   ( use = "required" )
 	//
-	mIsSetOutputEndTime = attributes.readInto("outputEndTime", mOutputEndTime, getErrorLog(), true);
+	mIsSetOutputEndTime = readAttribute(attributes, index[2], "outputEndTime", mOutputEndTime, true);
 
 	//
 	// numberOfPoints int   ( use = "required" )
 	//
-	mIsSetNumberOfPoints = attributes.readInto("numberOfPoints", mNumberOfPoints, getErrorLog(), true);
+	mIsSetNumberOfPoints = readAttribute(attributes, index[3], "numberOfPoints", mNumberOfPoints, true);
 
 }
 
@@ -526,6 +595,12 @@ SedUniformTimeCourse::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sInitialTimeAttribute("initialTime");
+static const std::string sOutputStartTimeAttribute("outputStartTime");
+static const std::string sOutputEndTimeAttribute("outputEndTime");
+static const std::string sNumberOfPointsAttribute("numberOfPoints");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -536,17 +611,45 @@ SedUniformTimeCourse::writeAttributes (XMLOutputStream& stream) const
 {
 	SedSimulation::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
+	if (isSetInitialTime() == true)
+		stream.writeAttribute(sInitialTimeAttribute, prefix, SedNumber::toString(mInitialTime));
+
+	if (isSetOutputStartTime() == true)
+		stream.writeAttribute(sOutputStartTimeAttribute, prefix, SedNumber::toString(mOutputStartTime));
+
+	if (isSetOutputEndTime() == true)
+		stream.writeAttribute(sOutputEndTimeAttribute, prefix, SedNumber::toString(mOutputEndTime));
+
+	if (isSetNumberOfPoints() == true)
+		stream.writeAttribute(sNumberOfPointsAttribute, prefix, SedNumber::toString(mNumberOfPoints));
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedUniformTimeCourse::addAttributes (XMLAttributes& attributes) const
+{
+	SedSimulation::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
 	if (isSetInitialTime() == true)
-		stream.writeAttribute("initialTime", getPrefix(), mInitialTime);
+		addAttribute(attributes, sInitialTimeAttribute, prefix, SedNumber::toString(mInitialTime));
 
 	if (isSetOutputStartTime() == true)
-		stream.writeAttribute("outputStartTime", getPrefix(), mOutputStartTime);
+		addAttribute(attributes, sOutputStartTimeAttribute, prefix, SedNumber::toString(mOutputStartTime));
 
 	if (isSetOutputEndTime() == true)
-		stream.writeAttribute("outputEndTime", getPrefix(), mOutputEndTime);
+		addAttribute(attributes, sOutputEndTimeAttribute, prefix, SedNumber::toString(mOutputEndTime));
 
 	if (isSetNumberOfPoints() == true)
-		stream.writeAttribute("numberOfPoints", getPrefix(), mNumberOfPoints);
+		addAttribute(attributes, sNumberOfPointsAttribute, prefix, SedNumber::toString(mNumberOfPoints));
 
 }
 
@@ -683,6 +786,17 @@ SedUniformTimeCourse_isSetNumberOfPoints(SedUniformTimeCourse_t * sutc)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const SedTimeGrid_t *
+SedUniformTimeCourse_getTimeGrid(SedUniformTimeCourse_t * sutc)
+{
+	return (sutc != NULL) ? sutc->getTimeGrid() : NULL;
+}
+
+
 /**
  * write comments
  */
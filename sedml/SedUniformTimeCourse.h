@@ -56,6 +56,7 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 
 
 #include <sedml/SedSimulation.h>
+#include <sedml/SedTimeGrid.h>
 
 
 class LIBSEDML_EXTERN SedUniformTimeCourse : public SedSimulation
@@ -64,13 +65,16 @@ class LIBSEDML_EXTERN SedUniformTimeCourse : public SedSimulation
 protected:
 
 	double        mInitialTime;
-	bool          mIsSetInitialTime;
 	double        mOutputStartTime;
-	bool          mIsSetOutputStartTime;
 	double        mOutputEndTime;
-	bool          mIsSetOutputEndTime;
 	int           mNumberOfPoints;
-	bool          mIsSetNumberOfPoints;
+	bool          mIsSetInitialTime : 1;
+	bool          mIsSetOutputStartTime : 1;
+	bool          mIsSetOutputEndTime : 1;
+	bool          mIsSetNumberOfPoints : 1;
+
+	// the shared grid of the attributes, updated when it is asked for
+	mutable const SedTimeGrid* mTimeGrid;
 
 
 public:
@@ -311,6 +315,40 @@ public:
 	virtual int unsetNumberOfPoints();
 
 
+	/**
+	 * Returns the output times of this SedUniformTimeCourse, and the steps
+	 * a solver reports at, computed once and shared with every time course
+	 * with the same attributes.
+	 *
+	 * The grid is valid until an attribute of this SedUniformTimeCourse is
+	 * changed or it is destroyed.
+	 *
+	 * @return the SedTimeGrid of the attributes, or @c NULL if they are
+	 * not set or do not describe a time course.
+	 */
+	const SedTimeGrid* getTimeGrid() const;
+
+
+	/**
+	 * Returns the @c numberOfPoints + 1 output times of this
+	 * SedUniformTimeCourse, from its output start to its output end time,
+	 * in a buffer aligned to SED_RESULTS_ALIGNMENT bytes.
+	 *
+	 * @return the output times, or @c NULL if there is no time grid.
+	 *
+	 * @see getTimeGrid()
+	 */
+	const double* getOutputTimes() const;
+
+
+	/**
+	 * Returns the number of output times of this SedUniformTimeCourse.
+	 *
+	 * @return @c numberOfPoints + 1, or 0 if there is no time grid.
+	 */
+	size_t getNumOutputTimes() const;
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedUniformTimeCourse, is
 	 * always @c "sedUniformTimeCourse".
@@ -385,9 +423,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -448,6 +486,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -520,6 +565,11 @@ int
 SedUniformTimeCourse_isSetNumberOfPoints(SedUniformTimeCourse_t * sutc);
 
 
+LIBSEDML_EXTERN
+const SedTimeGrid_t *
+SedUniformTimeCourse_getTimeGrid(SedUniformTimeCourse_t * sutc);
+
+
 LIBSEDML_EXTERN
 int
 SedUniformTimeCourse_setInitialTime(SedUniformTimeCourse_t * sutc, double initialTime);
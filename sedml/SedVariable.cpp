@@ -55,6 +55,8 @@ SedVariable::SedVariable (unsigned int level, unsigned int version)
 	, mTarget ("")
 	, mTaskReference ("")
 	, mModelReference ("")
+	, mReferencedTask (NULL)
+	, mReferencedModel (NULL)
 
 {
 	// set an SedNamespaces derived object of this package
@@ -73,6 +75,8 @@ SedVariable::SedVariable (SedNamespaces* sedns)
 	, mTarget ("")
 	, mTaskReference ("")
 	, mModelReference ("")
+	, mReferencedTask (NULL)
+	, mReferencedModel (NULL)
 
 {
 	// set the element namespace of this object
@@ -97,7 +101,9 @@ SedVariable::SedVariable (const SedVariable& orig)
 		mSymbol  = orig.mSymbol;
 		mTarget  = orig.mTarget;
 		mTaskReference  = orig.mTaskReference;
+		mReferencedTask  = NULL;
 		mModelReference  = orig.mModelReference;
+		mReferencedModel  = NULL;
 	}
 }
 
@@ -120,7 +126,9 @@ SedVariable::operator=(const SedVariable& rhs)
 		mSymbol  = rhs.mSymbol;
 		mTarget  = rhs.mTarget;
 		mTaskReference  = rhs.mTaskReference;
+		mReferencedTask  = NULL;
 		mModelReference  = rhs.mModelReference;
+		mReferencedModel  = NULL;
 	}
 	return *this;
 }
@@ -270,7 +278,11 @@ SedVariable::isSetModelReference() const
 int
 SedVariable::setId(const std::string& id)
 {
-	return SyntaxChecker::checkAndSetSId(id, mId);
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
+	int result = checkAndSetSId(id, mId);
+	notifyIdChanged();
+	return result;
 }
 
 
@@ -280,6 +292,8 @@ SedVariable::setId(const std::string& id)
 int
 SedVariable::setName(const std::string& name)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(name) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -298,6 +312,8 @@ SedVariable::setName(const std::string& name)
 int
 SedVariable::setSymbol(const std::string& symbol)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(symbol) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -316,6 +332,8 @@ SedVariable::setSymbol(const std::string& symbol)
 int
 SedVariable::setTarget(const std::string& target)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(target) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -334,6 +352,8 @@ SedVariable::setTarget(const std::string& target)
 int
 SedVariable::setTaskReference(const std::string& taskReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(taskReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -345,6 +365,7 @@ SedVariable::setTaskReference(const std::string& taskReference)
 	else
 	{
 		mTaskReference = taskReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -356,6 +377,8 @@ SedVariable::setTaskReference(const std::string& taskReference)
 int
 SedVariable::setModelReference(const std::string& modelReference)
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	if (&(modelReference) == NULL)
 	{
 		return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
@@ -367,6 +390,7 @@ SedVariable::setModelReference(const std::string& modelReference)
 	else
 	{
 		mModelReference = modelReference;
+		notifyReferencesChanged();
 		return LIBSEDML_OPERATION_SUCCESS;
 	}
 }
@@ -378,7 +402,10 @@ SedVariable::setModelReference(const std::string& modelReference)
 int
 SedVariable::unsetId()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mId.erase();
+	notifyIdChanged();
 
 	if (mId.empty() == true)
 	{
@@ -397,6 +424,8 @@ SedVariable::unsetId()
 int
 SedVariable::unsetName()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mName.erase();
 
 	if (mName.empty() == true)
@@ -416,6 +445,8 @@ SedVariable::unsetName()
 int
 SedVariable::unsetSymbol()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mSymbol.erase();
 
 	if (mSymbol.empty() == true)
@@ -435,6 +466,8 @@ SedVariable::unsetSymbol()
 int
 SedVariable::unsetTarget()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mTarget.erase();
 
 	if (mTarget.empty() == true)
@@ -454,7 +487,10 @@ SedVariable::unsetTarget()
 int
 SedVariable::unsetTaskReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mTaskReference.erase();
+	notifyReferencesChanged();
 
 	if (mTaskReference.empty() == true)
 	{
@@ -473,7 +509,10 @@ SedVariable::unsetTaskReference()
 int
 SedVariable::unsetModelReference()
 {
+	if (isFrozen()) return LIBSEDML_OPERATION_FAILED;
+	markDirty();
 	mModelReference.erase();
+	notifyReferencesChanged();
 
 	if (mModelReference.empty() == true)
 	{
@@ -486,14 +525,56 @@ SedVariable::unsetModelReference()
 }
 
 
+/*
+ * Returns the SedTask referenced by the "taskReference" attribute.
+ */
+SedTask*
+SedVariable::getReferencedTask()
+{
+	updateReferences();
+	return mReferencedTask;
+}
+
+
+/*
+ * Returns the SedModel referenced by the "modelReference" attribute.
+ */
+SedModel*
+SedVariable::getReferencedModel()
+{
+	updateReferences();
+	return mReferencedModel;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Resolves the reference attributes of this SedVariable against the document.
+ */
+void
+SedVariable::lookupReferences(SedDocument* doc)
+{
+	mReferencedTask = (doc != NULL && isSetTaskReference())
+		? doc->getTask(mTaskReference) : NULL;
+	mReferencedModel = (doc != NULL && isSetModelReference())
+		? doc->getModel(mModelReference) : NULL;
+}
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
+static const std::string sSedVariableName("variable");
+
+
 /*
  * Returns the XML element name of this object
  */
 const std::string&
 SedVariable::getElementName () const
 {
-	static const string name = "variable";
-	return name;
+	return sSedVariableName;
 }
 
 
@@ -540,13 +621,12 @@ SedVariable::writeElements (XMLOutputStream& stream) const
 /** @cond doxygen-libsbml-internal */
 
 /*
- * Accepts the given SedVisitor.
+ * Shows this object to the given SedVisitor.
  */
 bool
-SedVariable::accept (SedVisitor& v) const
+SedVariable::dispatch (SedVisitor& v) const
 {
-	return false;
-
+	return v.visit(*this);
 }
 
 
@@ -603,10 +683,23 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 
 	bool assigned = false;
 
+	// look for all attributes in one pass
+	static const AttributeName names[] =
+	{
+		{ "id", 0x37386ae0u },
+		{ "name", 0x8d39bde6u },
+		{ "symbol", 0xf3fb51d1u },
+		{ "target", 0x32608848u },
+		{ "taskReference", 0x031ec161u },
+		{ "modelReference", 0x8e1cb58fu }
+	};
+	int index[6];
+	findAttributes(attributes, names, 6, index);
+
 	//
 	// id SId  ( use = "required" )
 	//
-	assigned = attributes.readInto("id", mId, getErrorLog(), true);
+	assigned = readAttribute(attributes, index[0], "id", mId, true);
 
 	if (assigned == true)
 	{
@@ -625,7 +718,7 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 	//
 	// name string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("name", mName, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[1], "name", mName, false);
 
 	if (assigned == true)
 	{
@@ -640,7 +733,7 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 	//
 	// symbol string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("symbol", mSymbol, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[2], "symbol", mSymbol, false);
 
 	if (assigned == true)
 	{
@@ -655,7 +748,7 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 	//
 	// target string   ( use = "optional" )
 	//
-	assigned = attributes.readInto("target", mTarget, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[3], "target", mTarget, false);
 
 	if (assigned == true)
 	{
@@ -670,7 +763,7 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 	//
 	// taskReference SIdRef   ( use = "optional" )
 	//
-	assigned = attributes.readInto("taskReference", mTaskReference, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[4], "taskReference", mTaskReference, false);
 
 	if (assigned == true)
 	{
@@ -689,7 +782,7 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 	//
 	// modelReference SIdRef   ( use = "optional" )
 	//
-	assigned = attributes.readInto("modelReference", mModelReference, getErrorLog(), false);
+	assigned = readAttribute(attributes, index[5], "modelReference", mModelReference, false);
 
 	if (assigned == true)
 	{
@@ -711,6 +804,14 @@ SedVariable::readAttributes (const XMLAttributes& attributes,
 /** @endcond doxygen-libsbml-internal */
 
 
+static const std::string sIdAttribute("id");
+static const std::string sNameAttribute("name");
+static const std::string sSymbolAttribute("symbol");
+static const std::string sTargetAttribute("target");
+static const std::string sTaskReferenceAttribute("taskReference");
+static const std::string sModelReferenceAttribute("modelReference");
+
+
 /** @cond doxygen-libsbml-internal */
 
 /*
@@ -721,23 +822,57 @@ SedVariable::writeAttributes (XMLOutputStream& stream) const
 {
 	SedBase::writeAttributes(stream);
 
+	const std::string prefix = getPrefix();
+
 	if (isSetId() == true)
-		stream.writeAttribute("id", getPrefix(), mId);
+		stream.writeAttribute(sIdAttribute, prefix, mId);
 
 	if (isSetName() == true)
-		stream.writeAttribute("name", getPrefix(), mName);
+		stream.writeAttribute(sNameAttribute, prefix, mName);
 
 	if (isSetSymbol() == true)
-		stream.writeAttribute("symbol", getPrefix(), mSymbol);
+		stream.writeAttribute(sSymbolAttribute, prefix, mSymbol);
 
 	if (isSetTarget() == true)
-		stream.writeAttribute("target", getPrefix(), mTarget);
+		stream.writeAttribute(sTargetAttribute, prefix, mTarget);
 
 	if (isSetTaskReference() == true)
-		stream.writeAttribute("taskReference", getPrefix(), mTaskReference);
+		stream.writeAttribute(sTaskReferenceAttribute, prefix, mTaskReference);
 
 	if (isSetModelReference() == true)
-		stream.writeAttribute("modelReference", getPrefix(), mModelReference);
+		stream.writeAttribute(sModelReferenceAttribute, prefix, mModelReference);
+
+}
+
+
+/*
+ * Adds the values of the attributes, as writeAttributes() writes them, to
+ * attributes.
+ */
+void
+SedVariable::addAttributes (XMLAttributes& attributes) const
+{
+	SedBase::addAttributes(attributes);
+
+	const std::string prefix = getPrefix();
+
+	if (isSetId() == true)
+		addAttribute(attributes, sIdAttribute, prefix, mId);
+
+	if (isSetName() == true)
+		addAttribute(attributes, sNameAttribute, prefix, mName);
+
+	if (isSetSymbol() == true)
+		addAttribute(attributes, sSymbolAttribute, prefix, mSymbol);
+
+	if (isSetTarget() == true)
+		addAttribute(attributes, sTargetAttribute, prefix, mTarget);
+
+	if (isSetTaskReference() == true)
+		addAttribute(attributes, sTaskReferenceAttribute, prefix, mTaskReference);
+
+	if (isSetModelReference() == true)
+		addAttribute(attributes, sModelReferenceAttribute, prefix, mModelReference);
 
 }
 
@@ -813,10 +948,7 @@ SedListOfVariables::get(const std::string& sid)
 const SedVariable*
 SedListOfVariables::get(const std::string& sid) const
 {
-	vector<SedBase*>::const_iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedVariable>(sid) );
-	return (result == mItems.end()) ? 0 : static_cast <SedVariable*> (*result);
+	return static_cast <const SedVariable*> (getItemById(sid));
 }
 
 
@@ -841,6 +973,17 @@ SedListOfVariables::addVariable(const SedVariable* sv)
 }
 
 
+/*
+ * Adds the given SedVariable to this SedListOfVariables, which takes ownership of it.
+ */
+int
+SedListOfVariables::addVariableAndOwn(SedVariable* sv)
+{
+	if(sv == NULL) return LIBSEDML_INVALID_OBJECT;
+	return appendAndOwn(sv);
+}
+
+
 /**
  * Get the number of SedVariable objects in this SedListOfVariables.
  *
@@ -863,7 +1006,8 @@ SedListOfVariables::getNumVariables() const
 SedVariable* 
 SedListOfVariables::createVariable()
 {
-	SedVariable *temp = new SedVariable();
+	if (isFrozen()) return NULL;
+	SedVariable *temp = new (getArena()) SedVariable();
 	if (temp != NULL) appendAndOwn(temp);
 	return temp;
 }
@@ -884,19 +1028,11 @@ SedListOfVariables::remove(unsigned int n)
 SedVariable*
 SedListOfVariables::remove(const std::string& sid)
 {
-	SedBase* item = NULL;
-	vector<SedBase*>::iterator result;
-
-	result = find_if( mItems.begin(), mItems.end(), IdEq<SedVariable>(sid) );
+	return static_cast <SedVariable*> (removeItemById(sid));
+}
 
-	if (result != mItems.end())
-	{
-		item = *result;
-		mItems.erase(result);
-	}
 
-	return static_cast <SedVariable*> (item);
-}
+static const std::string sSedListOfVariablesName("listOfVariables");
 
 
 /*
@@ -905,8 +1041,7 @@ SedListOfVariables::remove(const std::string& sid)
 const std::string&
 SedListOfVariables::getElementName () const
 {
-	static const string name = "listOfVariables";
-	return name;
+	return sSedListOfVariablesName;
 }
 
 
@@ -932,6 +1067,16 @@ SedListOfVariables::getItemTypeCode () const
 
 /** @cond doxygen-libsbml-internal */
 
+/*
+ * Returns the size of a SedVariable.
+ */
+size_t
+SedListOfVariables::getItemSize () const
+{
+	return sizeof(SedVariable);
+}
+
+
 /*
  * Creates a new SedVariable in this SedListOfVariables
  */
@@ -943,7 +1088,7 @@ SedListOfVariables::createObject(XMLInputStream& stream)
 
 	if (name == "variable")
 	{
-		object = new SedVariable(getSedNamespaces());
+		object = new (getArena()) SedVariable(getSedNamespaces());
 		appendAndOwn(object);
 	}
 
@@ -968,7 +1113,8 @@ SedListOfVariables::writeXMLNS(XMLOutputStream& stream) const
 
 	if (prefix.empty())
 	{
-		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1))
+		if (getNamespaces() != NULL && !getNamespaces()->hasURI(SEDML_XMLNS_L1)
+		    && !isDeclaredByDocument(SEDML_XMLNS_L1, prefix))
 		{
 			xmlns.add(SEDML_XMLNS_L1,prefix);
 		}
@@ -1036,6 +1182,20 @@ SedVariable_getId(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getIdView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getId().empty() ? NULL : sv->getId().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1050,6 +1210,20 @@ SedVariable_getName(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getNameView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getName().empty() ? NULL : sv->getName().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1064,6 +1238,20 @@ SedVariable_getSymbol(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getSymbolView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getSymbol().empty() ? NULL : sv->getSymbol().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1078,6 +1266,20 @@ SedVariable_getTarget(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getTargetView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getTarget().empty() ? NULL : sv->getTarget().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1092,6 +1294,20 @@ SedVariable_getTaskReference(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getTaskReferenceView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getTaskReference().empty() ? NULL : sv->getTaskReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1106,6 +1322,20 @@ SedVariable_getModelReference(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+const char *
+SedVariable_getModelReferenceView(const SedVariable_t * sv)
+{
+	if (sv == NULL)
+		return NULL;
+
+	return sv->getModelReference().empty() ? NULL : sv->getModelReference().c_str();
+}
+
+
 /**
  * write comments
  */
@@ -1304,6 +1534,28 @@ SedVariable_unsetModelReference(SedVariable_t * sv)
 }
 
 
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedTask_t *
+SedVariable_getReferencedTask(SedVariable_t * sv)
+{
+	return (sv != NULL) ? sv->getReferencedTask() : NULL;
+}
+
+
+/**
+ * write comments
+ */
+LIBSEDML_EXTERN
+SedModel_t *
+SedVariable_getReferencedModel(SedVariable_t * sv)
+{
+	return (sv != NULL) ? sv->getReferencedModel() : NULL;
+}
+
+
 /**
  * write comments
  */
@@ -62,12 +62,14 @@ class LIBSEDML_EXTERN SedVariable : public SedBase
 
 protected:
 
-	std::string   mId;
-	std::string   mName;
+	SedSymbol   mId;
+	SedOptionalString   mName;
 	std::string   mSymbol;
 	std::string   mTarget;
-	std::string   mTaskReference;
-	std::string   mModelReference;
+	SedSymbol   mTaskReference;
+	SedSymbol   mModelReference;
+	SedTask*   mReferencedTask;
+	SedModel*   mReferencedModel;
 
 
 public:
@@ -400,6 +402,30 @@ public:
 	virtual int unsetModelReference();
 
 
+	/**
+	 * Returns the SedTask that the "taskReference" attribute of this SedVariable
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedTask.
+	 */
+	SedTask* getReferencedTask();
+
+
+	/**
+	 * Returns the SedModel that the "modelReference" attribute of this SedVariable
+	 * refers to, or @c NULL if it is unset or does not resolve.
+	 *
+	 * The link is resolved once and cached until the containing SedDocument
+	 * changes.
+	 *
+	 * @return the referenced SedModel.
+	 */
+	SedModel* getReferencedModel();
+
+
 	/**
 	 * Returns the XML element name of this object, which for SedVariable, is
 	 * always @c "sedVariable".
@@ -471,9 +497,9 @@ public:
 /** @cond doxygen-libsbml-internal */
 
 	/**
-	 * Accepts the given SedVisitor.
+	 * Shows this object, but not its children, to the given SedVisitor.
 	 */
-	virtual bool accept (SedVisitor& v) const;
+	virtual bool dispatch (SedVisitor& v) const;
 
 
 /** @endcond doxygen-libsbml-internal */
@@ -492,6 +518,17 @@ public:
 
 protected:
 
+/** @cond doxygen-libsbml-internal */
+
+	/**
+	 * Resolves the reference attributes of this SedVariable against @p doc.
+	 */
+	virtual void lookupReferences(SedDocument* doc);
+
+
+/** @endcond doxygen-libsbml-internal */
+
+
 /** @cond doxygen-libsbml-internal */
 
 	/**
@@ -523,6 +560,13 @@ protected:
 	virtual void writeAttributes (XMLOutputStream& stream) const;
 
 
+	/**
+	 * Adds the values of the attributes to attributes, as writeAttributes()
+	 * writes them.
+	 */
+	virtual void addAttributes (XMLAttributes& attributes) const;
+
+
 /** @endcond doxygen-libsbml-internal */
 
 
@@ -637,6 +681,25 @@ public:
 	int addVariable(const SedVariable* v);
 
 
+	/**
+	 * Adds the given "SedVariable" to this SedListOfVariables without copying it; this
+	 * SedListOfVariables takes ownership of @p v and will delete it.
+	 *
+	 * @param v the SedVariable object to add.
+	 *
+	 * @return integer value indicating success/failure of the
+	 * function.  @if clike The value is drawn from the
+	 * enumeration #OperationReturnValues_t. @endif The possible values
+	 * returned by this function are:
+	 * @li LIBSEDML_OPERATION_SUCCESS
+	 * @li LIBSEDML_INVALID_OBJECT if @p v is @c NULL, already has a parent
+	 * or cannot be added, in which case the caller still owns it
+	 *
+	 * @see addVariable(const SedVariable* v)
+	 */
+	int addVariableAndOwn(SedVariable* v);
+
+
 	/**
 	 * Get the number of Variable objects in this SedListOfVariables.
 	 *
@@ -771,6 +834,12 @@ protected:
 	virtual SedBase* createObject(XMLInputStream& stream);
 
 
+	/**
+	 * Returns the size of a SedVariable, the type of all items of this list.
+	 */
+	virtual size_t getItemSize () const;
+
+
 	/** @endcond doxygen-libsbml-internal */
 
 
@@ -819,31 +888,61 @@ char *
 SedVariable_getId(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getIdView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 char *
 SedVariable_getName(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getNameView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 char *
 SedVariable_getSymbol(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getSymbolView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 char *
 SedVariable_getTarget(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getTargetView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 char *
 SedVariable_getTaskReference(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getTaskReferenceView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 char *
 SedVariable_getModelReference(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+const char *
+SedVariable_getModelReferenceView(const SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 int
 SedVariable_isSetId(SedVariable_t * sv);
@@ -934,6 +1033,16 @@ int
 SedVariable_unsetModelReference(SedVariable_t * sv);
 
 
+LIBSEDML_EXTERN
+SedTask_t *
+SedVariable_getReferencedTask(SedVariable_t * sv);
+
+
+LIBSEDML_EXTERN
+SedModel_t *
+SedVariable_getReferencedModel(SedVariable_t * sv);
+
+
 LIBSEDML_EXTERN
 int
 SedVariable_hasRequiredAttributes(SedVariable_t * sv);
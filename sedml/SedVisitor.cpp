@@ -53,7 +53,140 @@ SedVisitor::visit (const SedListOf& x, int type)
 bool
 SedVisitor::visit (const SedBase& sb)
 {
-  return false;
+  return true;
+}
+
+
+bool
+SedVisitor::visit (const SedModel& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedChange& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedChangeAttribute& x)
+{
+  return visit( static_cast<const SedChange&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedComputeChange& x)
+{
+  return visit( static_cast<const SedChange&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedRemoveXML& x)
+{
+  return visit( static_cast<const SedChange&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedVariable& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedParameter& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedSimulation& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedUniformTimeCourse& x)
+{
+  return visit( static_cast<const SedSimulation&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedAlgorithm& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedTask& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedDataGenerator& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedOutput& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedReport& x)
+{
+  return visit( static_cast<const SedOutput&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedPlot2D& x)
+{
+  return visit( static_cast<const SedOutput&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedPlot3D& x)
+{
+  return visit( static_cast<const SedOutput&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedDataSet& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedCurve& x)
+{
+  return visit( static_cast<const SedBase&>(x) );
+}
+
+
+bool
+SedVisitor::visit (const SedSurface& x)
+{
+  return visit( static_cast<const SedCurve&>(x) );
 }
 
 
@@ -65,6 +65,25 @@ class SedBase;
 
 class SedDocument;
 class SedListOf;
+class SedModel;
+class SedChange;
+class SedChangeAttribute;
+class SedComputeChange;
+class SedRemoveXML;
+class SedVariable;
+class SedParameter;
+class SedSimulation;
+class SedUniformTimeCourse;
+class SedAlgorithm;
+class SedTask;
+class SedDataGenerator;
+class SedOutput;
+class SedReport;
+class SedPlot2D;
+class SedPlot3D;
+class SedDataSet;
+class SedCurve;
+class SedSurface;
 
 
 class SedVisitor
@@ -102,10 +121,244 @@ public:
    * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
    * Pattern</i></a> to perform operations on SedBase objects.
    *
+   * The overloads for the individual classes below fall back to this
+   * method, through those of their base classes, unless overridden.
+   *
    * @param x the SedBase object to visit.
+   *
+   * @return whether the children of @p x are to be visited; @c true by
+   * default.
    */
   virtual bool visit (const SedBase                    &x);
 
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedModel objects.
+   *
+   * @param x the SedModel object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedModel             &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedChange objects.
+   *
+   * @param x the SedChange object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedChange            &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedChangeAttribute objects.
+   *
+   * @param x the SedChangeAttribute object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedChange.
+   */
+  virtual bool visit (const SedChangeAttribute   &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedComputeChange objects.
+   *
+   * @param x the SedComputeChange object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedChange.
+   */
+  virtual bool visit (const SedComputeChange     &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedRemoveXML objects.
+   *
+   * @param x the SedRemoveXML object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedChange.
+   */
+  virtual bool visit (const SedRemoveXML         &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedVariable objects.
+   *
+   * @param x the SedVariable object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedVariable          &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedParameter objects.
+   *
+   * @param x the SedParameter object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedParameter         &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedSimulation objects.
+   *
+   * @param x the SedSimulation object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedSimulation        &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedUniformTimeCourse objects.
+   *
+   * @param x the SedUniformTimeCourse object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedSimulation.
+   */
+  virtual bool visit (const SedUniformTimeCourse &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedAlgorithm objects.
+   *
+   * @param x the SedAlgorithm object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedAlgorithm         &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedTask objects.
+   *
+   * @param x the SedTask object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedTask              &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedDataGenerator objects.
+   *
+   * @param x the SedDataGenerator object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedDataGenerator     &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedOutput objects.
+   *
+   * @param x the SedOutput object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedOutput            &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedReport objects.
+   *
+   * @param x the SedReport object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedOutput.
+   */
+  virtual bool visit (const SedReport            &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedPlot2D objects.
+   *
+   * @param x the SedPlot2D object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedOutput.
+   */
+  virtual bool visit (const SedPlot2D            &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedPlot3D objects.
+   *
+   * @param x the SedPlot3D object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedOutput.
+   */
+  virtual bool visit (const SedPlot3D            &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedDataSet objects.
+   *
+   * @param x the SedDataSet object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedDataSet           &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedCurve objects.
+   *
+   * @param x the SedCurve object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedBase.
+   */
+  virtual bool visit (const SedCurve             &x);
+
+  /**
+   * Interface method for using the <a target="_blank" 
+   * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
+   * Pattern</i></a> to perform operations on SedSurface objects.
+   *
+   * @param x the SedSurface object to visit.
+   *
+   * @return whether the children of @p x are to be visited; by default
+   * the result of visiting it as a SedCurve.
+   */
+  virtual bool visit (const SedSurface           &x);
+
   /**
    * Interface method for using the <a target="_blank" 
    * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
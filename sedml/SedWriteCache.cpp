@@ -0,0 +1,145 @@
+/**
+ * @file    SedWriteCache.cpp
+ * @brief   Output buffer of incremental SedWriter calls
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedWriteCache.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates an empty SedWriteCache.
+ */
+SedWriteCache::SedWriteCache (bool compact)
+  : mCompact (compact)
+  , mDepth (0)
+{
+  // without a put area every write reaches mData at once, so that the
+  // output of an element can be taken out as soon as it is written
+  setp(NULL, NULL);
+}
+
+
+/*
+ * Returns true if the output is written without indentation.
+ */
+bool
+SedWriteCache::getCompact () const
+{
+  return mCompact;
+}
+
+
+/*
+ * Returns the depth of the innermost element being written.
+ */
+unsigned int
+SedWriteCache::getDepth () const
+{
+  return mDepth;
+}
+
+
+/*
+ * Tells this SedWriteCache that an element is about to be written.
+ */
+size_t
+SedWriteCache::beginElement ()
+{
+  ++mDepth;
+  return mData.size();
+}
+
+
+/*
+ * Tells this SedWriteCache that the element begun last has been written.
+ */
+void
+SedWriteCache::endElement ()
+{
+  if (mDepth > 0) --mDepth;
+}
+
+
+/*
+ * Returns the XML of the element just written.
+ */
+std::string
+SedWriteCache::extract (size_t start) const
+{
+  return mData.substr(findStartTag(start));
+}
+
+
+/*
+ * Replaces the element just written by xml.
+ */
+void
+SedWriteCache::replace (size_t start, const std::string& xml)
+{
+  mData.erase(findStartTag(start));
+  mData += xml;
+}
+
+
+/*
+ * Returns the output written so far.
+ */
+const std::string&
+SedWriteCache::getData () const
+{
+  return mData;
+}
+
+
+/** @cond doxygen-libsbml-internal */
+
+SedWriteCache::int_type
+SedWriteCache::overflow (int_type c)
+{
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    mData += traits_type::to_char_type(c);
+  }
+  return traits_type::not_eof(c);
+}
+
+
+std::streamsize
+SedWriteCache::xsputn (const char* s, std::streamsize n)
+{
+  mData.append(s, (size_t)n);
+  return n;
+}
+
+
+/*
+ * Returns the position of the start tag of the element written since
+ * start.
+ */
+size_t
+SedWriteCache::findStartTag (size_t start) const
+{
+  const size_t pos = mData.find('<', start);
+  return (pos == std::string::npos) ? mData.size() : pos;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,138 @@
+/**
+ * @file    SedWriteCache.h
+ * @brief   Output buffer of incremental SedWriter calls
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedWriteCache
+ * @ingroup Core
+ * @brief Collects the output of an incremental SedWriter call.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * While SedWriter writes a document incrementally (see
+ * SedWriter::setIncremental()), the XMLOutputStream writes into a
+ * SedWriteCache, which keeps the whole output in memory.  Each element
+ * written takes its own XML out of it with extract() to reuse next time,
+ * and an element that has not changed since then writes itself as an
+ * empty element, which keeps the stream's indentation right, and has
+ * replace() put the XML kept in its place.
+ *
+ * SedWriteCache objects are created by SedWriter for the duration of one
+ * call; they are not meant to be used directly.
+ */
+
+#ifndef SedWriteCache_h
+#define SedWriteCache_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <streambuf>
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedWriteCache : public std::streambuf
+{
+public:
+
+  /**
+   * Creates an empty SedWriteCache for output that is compact, without
+   * indentation, if @p compact is @c true.
+   */
+  SedWriteCache (bool compact);
+
+
+  /**
+   * @return @c true if the output is written without indentation.
+   */
+  bool getCompact () const;
+
+
+  /**
+   * @return the number of elements being written, that is the depth of
+   * the innermost of them; the root element is at depth 1.
+   */
+  unsigned int getDepth () const;
+
+
+  /**
+   * Tells this SedWriteCache that an element is about to be written.
+   *
+   * @return the position the element's output starts after.
+   */
+  size_t beginElement ();
+
+
+  /**
+   * Tells this SedWriteCache that the element begun last has been
+   * written.
+   */
+  void endElement ();
+
+
+  /**
+   * @return the XML of the element that has just been written, from its
+   * start tag on; @p start is the value beginElement() returned for it.
+   */
+  std::string extract (size_t start) const;
+
+
+  /**
+   * Replaces the element that has just been written, from its start tag
+   * on, by @p xml; @p start is the value beginElement() returned for it.
+   */
+  void replace (size_t start, const std::string& xml);
+
+
+  /**
+   * @return the output written so far.
+   */
+  const std::string& getData () const;
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  virtual int_type overflow (int_type c);
+
+  virtual std::streamsize xsputn (const char* s, std::streamsize n);
+
+  /*
+   * Returns the position of the start tag of the element written since
+   * start: anything before it closes the parent's start tag or indents.
+   */
+  size_t findStartTag (size_t start) const;
+
+
+  std::string   mData;
+  bool          mCompact;
+  unsigned int  mDepth;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* SedWriteCache_h */
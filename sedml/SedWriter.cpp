@@ -25,10 +25,14 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstdlib>
+#include <cstring>
 #include <ios>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <streambuf>
+#include <vector>
 
 #include <sedml/common/common.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -37,6 +41,8 @@
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedWriteCache.h>
+#include <sedml/SedProfiler.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/OutputCompressor.h>
@@ -49,10 +55,85 @@ using namespace std;
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
+/** @cond doxygen-libsbml-internal */
+
+/*
+ * Sink collecting the output in a malloc'd string, which becomes the
+ * result of writeToString() without a further copy.
+ */
+class SedMallocStringSink : public SedOutputSink
+{
+public:
+
+  SedMallocStringSink ()
+    : mData (NULL)
+    , mLength (0)
+    , mCapacity (0)
+  {
+  }
+
+  virtual ~SedMallocStringSink ()
+  {
+    free(mData);
+  }
+
+  virtual bool write (const char* data, size_t length)
+  {
+    if (mLength + length + 1 > mCapacity)
+    {
+      size_t capacity = (mCapacity > 0) ? mCapacity : 1024;
+      while (capacity < mLength + length + 1) capacity *= 2;
+
+      char* grown = static_cast<char*>(realloc(mData, capacity));
+      if (grown == NULL) return false;
+
+      mData     = grown;
+      mCapacity = capacity;
+    }
+
+    memcpy(mData + mLength, data, length);
+    mLength += length;
+    mData[mLength] = '\0';
+    return true;
+  }
+
+  char* release ()
+  {
+    char* result = (mData != NULL) ? mData : safe_strdup("");
+    mData     = NULL;
+    mLength   = 0;
+    mCapacity = 0;
+    return result;
+  }
+
+private:
+
+  char*  mData;
+  size_t mLength;
+  size_t mCapacity;
+};
+
+
+/*
+ * Returns the error log failures to write d go to, or NULL if d is
+ * frozen, as several threads may then be writing it at once.
+ */
+static SedErrorLog*
+getWriteErrorLog (const SedDocument* d)
+{
+  return d->isFrozen() ? NULL : const_cast<SedDocument*>(d)->getErrorLog();
+}
+
+/** @endcond */
+
+
 /*
  * Creates a new SedWriter.
  */
 SedWriter::SedWriter ()
+  : mCompact (false)
+  , mIncremental (false)
+  , mProfiler (NULL)
 {
 }
 
@@ -113,6 +194,68 @@ SedWriter::setProgramVersion (const std::string& version)
 }
 
 
+/*
+ * Sets whether documents are written without indentation.
+ */
+int
+SedWriter::setCompact (bool compact)
+{
+  mCompact = compact;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if documents are written without indentation.
+ */
+bool
+SedWriter::getCompact () const
+{
+  return mCompact;
+}
+
+
+/*
+ * Sets whether documents are written incrementally.
+ */
+int
+SedWriter::setIncremental (bool incremental)
+{
+  mIncremental = incremental;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if documents are written incrementally.
+ */
+bool
+SedWriter::getIncremental () const
+{
+  return mIncremental;
+}
+
+
+/*
+ * Sets the SedProfiler documents written are counted by.
+ */
+void
+SedWriter::setProfiler (SedProfiler* profiler)
+{
+  mProfiler = profiler;
+}
+
+
+/*
+ * Returns the SedProfiler of this SedWriter.
+ */
+SedProfiler*
+SedWriter::getProfiler () const
+{
+  return mProfiler;
+}
+
+
 /*
  * Writes the given Sed document to filename.
  *
@@ -141,6 +284,43 @@ SedWriter::setProgramVersion (const std::string& version)
 bool
 SedWriter::writeSedML (const SedDocument* d, const std::string& filename)
 {
+  // gzip and zstd files are compressed directly into the file, one chunk
+  // at a time, where the library is available
+  const bool isGzip =
+    string::npos != filename.find(".gz", filename.length() - 3);
+  const bool isZstd =
+    string::npos != filename.find(".zst", filename.length() - 4);
+
+  if ((isGzip && SedGzipSink::isAvailable()) || isZstd)
+  {
+    if (isZstd && !SedZstdSink::isAvailable())
+    {
+      SedErrorLog *log = getWriteErrorLog(d);
+      std::ostringstream oss;
+      oss << "Tried to write " << filename << ". Writing a zstd file is not enabled because "
+          << "underlying libSed is not linked with zstd.";
+      if (log != NULL) log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
+      return false;
+    }
+
+    SedFileSink file(filename);
+    if (!file.isOpen())
+    {
+      SedErrorLog *log = getWriteErrorLog(d);
+      if (log != NULL) log->logError(XMLFileUnwritable);
+      return false;
+    }
+
+    if (isGzip)
+    {
+      SedGzipSink gzip(file);
+      return writeSedML(d, gzip);
+    }
+
+    SedZstdSink zstd(file);
+    return writeSedML(d, zstd);
+  }
+
   std::ostream* stream = NULL;
 
   try
@@ -195,29 +375,29 @@ SedWriter::writeSedML (const SedDocument* d, const std::string& filename)
   catch ( ZlibNotLinked& )
   {
     // libSed is not linked with zlib.
-    XMLErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+    SedErrorLog *log = getWriteErrorLog(d);
     std::ostringstream oss;
     oss << "Tried to write " << filename << ". Writing a gzip/zip file is not enabled because "
         << "underlying libSed is not linked with zlib."; 
-    log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
+    if (log != NULL) log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
     return false;
   } 
   catch ( Bzip2NotLinked& )
   {
     // libSed is not linked with bzip2.
-    XMLErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+    SedErrorLog *log = getWriteErrorLog(d);
     std::ostringstream oss;
     oss << "Tried to write " << filename << ". Writing a bzip2 file is not enabled because "
         << "underlying libSed is not linked with bzip2."; 
-    log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
+    if (log != NULL) log->add(XMLError( XMLFileUnwritable, oss.str(), 0, 0) );
     return false;
   } 
 
 
   if ( stream == NULL || stream->fail() || stream->bad())
   {
-    SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
-    log->logError(XMLFileUnwritable);
+    SedErrorLog *log = getWriteErrorLog(d);
+    if (log != NULL) log->logError(XMLFileUnwritable);
     return false;
   }
 
@@ -240,26 +420,113 @@ SedWriter::writeSedML (const SedDocument* d, std::ostream& stream)
 {
   bool result = false;
 
+  // a frozen document may be written by several threads at once, so
+  // nothing is kept in it: no XML, no counters and no errors
+  const bool frozen = d->isFrozen();
+
+#ifdef USE_PROFILING
+  // the elements count into recorder while they are written
+  SedProfileRecorder recorder;
+  const std::streampos begin = (mProfiler != NULL) ? stream.tellp()
+                                                   : std::streampos(-1);
+  if (mProfiler != NULL && !frozen)
+  {
+    const_cast<SedDocument*>(d)->setProfileRecorder(&recorder);
+  }
+#endif
+
   try
   {
     stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
-    XMLOutputStream xos(stream, "UTF-8", true, mProgramName, 
-                                               mProgramVersion);
-    d->write(xos);
+
+    if (mIncremental && !frozen)
+    {
+      // the objects take their XML out of the output, so it is built in
+      // memory first
+      SedWriteCache cache(mCompact);
+      std::ostream buffered(&cache);
+
+      SedDocument* doc = const_cast<SedDocument*>(d);
+      doc->setWriteCache(&cache);
+      {
+        XMLOutputStream xos(buffered, "UTF-8", true, mProgramName,
+                                                     mProgramVersion);
+        if (mCompact) xos.setAutoIndent(false);
+
+        d->write(xos);
+      }
+      doc->setWriteCache(NULL);
+
+      stream.write(cache.getData().data(), cache.getData().size());
+    }
+    else
+    {
+      XMLOutputStream xos(stream, "UTF-8", true, mProgramName, 
+                                                 mProgramVersion);
+      if (mCompact) xos.setAutoIndent(false);
+
+      d->write(xos);
+    }
     stream << endl;
 
     result = true;
   }
   catch (ios_base::failure&)
   {
-    SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
-    log->logError(XMLFileOperationError);
+    SedErrorLog *log = getWriteErrorLog(d);
+    if (log != NULL) log->logError(XMLFileOperationError);
+  }
+
+#ifdef USE_PROFILING
+  if (mProfiler != NULL)
+  {
+    if (!frozen) const_cast<SedDocument*>(d)->setProfileRecorder(NULL);
+
+    const std::streampos end = result ? stream.tellp() : std::streampos(-1);
+    if (begin != std::streampos(-1) && end != std::streampos(-1))
+    {
+      recorder.mCounters.bytesWritten = (size_t)(end - begin);
+    }
+    mProfiler->record(recorder.mCounters);
   }
+#endif
 
   return result;
 }
 
 
+/*
+ * Writes the given Sed document to sink in chunks of chunkSize bytes.
+ *
+ * @return true on success and false if the sink reported a failure.
+ */
+bool
+SedWriter::writeSedML (const SedDocument* d, SedOutputSink& sink,
+                       size_t chunkSize)
+{
+  SedSinkStreamBuf buffer(sink, chunkSize);
+  std::ostream stream(&buffer);
+
+  bool result = writeSedML(d, stream) && buffer.flushChunk();
+
+  if (!result)
+  {
+    // still give the sink the chance to release what it holds
+    sink.finish();
+    return false;
+  }
+
+  if (!sink.finish())
+  {
+    SedErrorLog *log = getWriteErrorLog(d);
+    if (log != NULL) log->logError(XMLFileOperationError);
+    return false;
+  }
+
+  return true;
+}
+
+
 /** @cond doxygen-libsbml-internal */
 /*
  * Writes the given Sed document to an in-memory string and returns a
@@ -273,10 +540,10 @@ LIBSEDML_EXTERN
 char*
 SedWriter::writeToString (const SedDocument* d)
 {
-  ostringstream stream;
-  writeSedML(d, stream);
+  SedMallocStringSink sink;
+  writeSedML(d, sink);
 
-  return safe_strdup( stream.str().c_str() );
+  return sink.release();
 }
 
 
@@ -399,6 +666,67 @@ SedWriter_setProgramVersion (SedWriter_t *sw, const char *version)
 }
 
 
+/**
+ * Sets whether the given SedWriter writes compact output.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCompact (SedWriter_t *sw, int compact)
+{
+  if (sw != NULL)
+    return sw->setCompact(compact != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if the given SedWriter writes compact output.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getCompact (const SedWriter_t *sw)
+{
+  return (sw != NULL) ? static_cast<int>( sw->getCompact() ) : 0;
+}
+
+
+/**
+ * Sets whether the given SedWriter writes incrementally.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setIncremental (SedWriter_t *sw, int incremental)
+{
+  if (sw != NULL)
+    return sw->setIncremental(incremental != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if the given SedWriter writes incrementally.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getIncremental (const SedWriter_t *sw)
+{
+  return (sw != NULL) ? static_cast<int>( sw->getIncremental() ) : 0;
+}
+
+
+/**
+ * Sets the SedProfiler documents written are counted by.
+ */
+LIBSEDML_EXTERN
+void
+SedWriter_setProfiler (SedWriter_t *sw, SedProfiler_t *profiler)
+{
+  if (sw != NULL) sw->setProfiler(profiler);
+}
+
+
 /**
  * Writes the given Sed document to filename.
  *
@@ -492,6 +820,26 @@ SedWriter_writeSedMLToString (SedWriter_t *sw, const SedDocument_t *d)
 }
 
 
+/**
+ * Writes the given Sed document by passing it, in chunks, to func.
+ *
+ * @return non-zero on success and zero if func reported a failure.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_writeSedMLToCallback (SedWriter_t *sw, const SedDocument_t *d,
+                                SedOutputSink_writeFunc func,
+                                void *userData, size_t chunkSize)
+{
+  if (sw == NULL || d == NULL || func == NULL)
+    return 0;
+
+  SedCallbackSink sink(func, userData);
+  return (chunkSize > 0) ? static_cast<int>( sw->writeSedML(d, sink, chunkSize) )
+                         : static_cast<int>( sw->writeSedML(d, sink) );
+}
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * libSed is linked with zlib at compile time.
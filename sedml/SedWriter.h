@@ -75,6 +75,7 @@
 
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
+#include <sedml/SedOutputSink.h>
 
 
 #ifdef __cplusplus
@@ -165,6 +166,81 @@ public:
   int setProgramVersion (const std::string& version);
 
 
+  /**
+   * Sets whether documents are written in compact form.
+   *
+   * Compact output has no indentation and no line breaks between
+   * elements, which makes it smaller and faster to produce; it is meant
+   * for exchange between programs rather than for reading.  The default
+   * is @c false.
+   *
+   * @param compact @c true to write compact output.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setCompact (bool compact);
+
+
+  /**
+   * @return @c true if this SedWriter writes compact output.
+   *
+   * @see setCompact(bool compact)
+   */
+  bool getCompact () const;
+
+
+  /**
+   * Sets whether documents are written incrementally.
+   *
+   * An incremental SedWriter keeps the XML of every object it writes with
+   * the object, and the next time writes only the objects that are dirty
+   * (see SedBase::isDirty()) anew, copying the XML kept for the others.
+   * Re-saving a large document after a small edit thus only renders the
+   * branches leading to the edit.  The XML kept takes memory, up to a few
+   * times the size of the document, for as long as the objects live.  An
+   * incremental SedWriter builds the output in memory before passing it
+   * on, and a document must not be written by two incremental SedWriter
+   * objects at the same time.  Frozen documents (see SedDocument::freeze())
+   * are always written in full, keeping nothing, so that any number of
+   * writers can write them at once.  The default is @c false.
+   *
+   * @param incremental @c true to write incrementally.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setIncremental (bool incremental);
+
+
+  /**
+   * @return @c true if this SedWriter writes incrementally.
+   *
+   * @see setIncremental(bool incremental)
+   */
+  bool getIncremental () const;
+
+
+  /**
+   * Sets the SedProfiler the counters of every document written by this
+   * SedWriter are recorded by, or @c NULL, the default, for none.  The
+   * profiler is not owned, and is only used if SedProfiler::isEnabled().
+   * Bytes are counted where the output stream tells its position, which
+   * compressed files do not.
+   */
+  void setProfiler (SedProfiler* profiler);
+
+
+  /**
+   * @return the SedProfiler of this SedWriter, or @c NULL.
+   */
+  SedProfiler* getProfiler () const;
+
+
   /**
    * Writes the given Sed document to filename.
    *
@@ -202,6 +278,32 @@ public:
   bool writeSedML (const SedDocument* d, std::ostream& stream);
 
 
+  /**
+   * Writes the given Sed document to @p sink, in chunks of @p chunkSize
+   * bytes that are handed over as soon as they are full.
+   *
+   * Only one chunk of the output is ever held in memory, so this is the
+   * method to use for large documents that go to a socket or through a
+   * compressing sink such as SedGzipSink.  SedOutputSink::finish() is
+   * called on @p sink once the document has been written.
+   *
+   * @param d the Sed document to be written
+   *
+   * @param sink the destination of the output
+   *
+   * @param chunkSize the number of bytes passed to each
+   * SedOutputSink::write() call, except the last
+   *
+   * @return @c true on success and @c false if the sink reported a
+   * failure.
+   *
+   * @see setProgramVersion(const std::string& version)
+   * @see setProgramName(const std::string& name)
+   */
+  bool writeSedML (const SedDocument* d, SedOutputSink& sink,
+                   size_t chunkSize = 64 * 1024);
+
+
   /** @cond doxygen-libsbml-internal */
 
   /**
@@ -313,6 +415,9 @@ public:
 
   std::string mProgramName;
   std::string mProgramVersion;
+  bool        mCompact;
+  bool        mIncremental;
+  SedProfiler* mProfiler;
 
   /** @endcond */
 };
@@ -369,6 +474,44 @@ LIBSEDML_EXTERN
 int
 SedWriter_setProgramVersion (SedWriter_t *sw, const char *version);
 
+/**
+ * Sets whether the given SedWriter writes compact output, without
+ * indentation.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCompact (SedWriter_t *sw, int compact);
+
+/**
+ * Returns non-zero if the given SedWriter writes compact output.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getCompact (const SedWriter_t *sw);
+
+/**
+ * Sets whether the given SedWriter writes incrementally, copying the XML
+ * of objects that have not changed since it last wrote them.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setIncremental (SedWriter_t *sw, int incremental);
+
+/**
+ * Returns non-zero if the given SedWriter writes incrementally.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getIncremental (const SedWriter_t *sw);
+
+/**
+ * Sets the SedProfiler the documents written by the given SedWriter are
+ * counted by, or @c NULL for none.
+ */
+LIBSEDML_EXTERN
+void
+SedWriter_setProfiler (SedWriter_t *sw, SedProfiler_t *profiler);
+
 /**
  * Writes the given Sed document to filename.
  *
@@ -415,6 +558,19 @@ char *
 SedWriter_writeSedMLToString (SedWriter_t *sw, const SedDocument_t *d);
 
 
+/**
+ * Writes the given Sed document by passing it, in chunks of @p chunkSize
+ * bytes (zero for the default), to @p func along with @p userData.
+ *
+ * @return non-zero on success and zero if @p func reported a failure.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_writeSedMLToCallback (SedWriter_t *sw, const SedDocument_t *d,
+                                SedOutputSink_writeFunc func,
+                                void *userData, size_t chunkSize);
+
+
 /**
  * Predicate returning @c non-zero or @c zero depending on whether
  * libSed is linked with zlib at compile time.
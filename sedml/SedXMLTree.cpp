@@ -0,0 +1,184 @@
+/**
+ * @file    SedXMLTree.cpp
+ * @brief   Reads and writes XMLNode trees without recursion
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedXMLTree.h>
+
+#include <vector>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+const unsigned int SedXMLTree::DEFAULT_MAX_DEPTH;
+
+
+/*
+ * Reads the element at the head of stream into a new XMLNode.
+ */
+XMLNode*
+SedXMLTree::read (XMLInputStream& stream, unsigned int maxDepth)
+{
+  const XMLToken element = stream.next();
+  XMLNode* root = new XMLNode(element);
+
+  if (!element.isStart() || element.isEnd()) return root;
+
+  // the open elements, innermost last; each child is added to its parent
+  // before its own children are read, so that no finished subtree is
+  // copied, and only the innermost element gains children
+  std::vector<XMLNode*> open;
+  open.push_back(root);
+
+  while (!open.empty() && stream.isGood())
+  {
+    const XMLToken next = stream.next();
+    if (next.isEOF()) break;
+
+    if (next.isStart())
+    {
+      if (maxDepth != 0 && open.size() >= maxDepth)
+      {
+        // the whole tree is dropped: the element that is too deep and
+        // every element it is in are skipped to their ends
+        stream.skipPastEnd(next);
+        for (size_t i = open.size(); i-- > 0; )
+        {
+          stream.skipPastEnd(*open[i]);
+        }
+        delete root;
+        return NULL;
+      }
+
+      XMLNode* parent = open.back();
+      parent->addChild(XMLNode(next));
+      if (!next.isEnd())
+      {
+        open.push_back(&parent->getChild(parent->getNumChildren() - 1));
+      }
+    }
+    else if (next.isEnd())
+    {
+      open.pop_back();
+    }
+    else
+    {
+      open.back()->addChild(XMLNode(next));
+    }
+  }
+
+  return root;
+}
+
+
+/*
+ * Writes node, with everything in it, to stream.
+ */
+void
+SedXMLTree::write (const XMLNode& node, XMLOutputStream& stream)
+{
+  struct Frame
+  {
+    const XMLNode* node;
+    unsigned int   next;
+    bool           haveText;
+  };
+
+  std::vector<Frame> open;
+
+  const XMLNode* current = &node;
+  for (;;)
+  {
+    // the element itself: its start tag, or its text
+    current->XMLToken::write(stream);
+
+    if (current->getNumChildren() > 0)
+    {
+      Frame frame = { current, 0, false };
+      open.push_back(frame);
+    }
+    else if (current->isStart() && !current->isEnd())
+    {
+      stream.endElement(current->getName(), current->getPrefix());
+    }
+
+    // the next child to write, closing the elements that have none left
+    current = NULL;
+    while (!open.empty())
+    {
+      Frame& top = open.back();
+      if (top.next < top.node->getNumChildren())
+      {
+        current = &top.node->getChild(top.next++);
+        top.haveText = top.haveText || current->isText();
+        break;
+      }
+
+      if (!top.node->getName().empty())
+      {
+        // an element with text between its children would otherwise get
+        // a hanging indent, as the stream operator of XMLNode avoids
+        if (top.node->getNumChildren() > 1 && top.haveText)
+        {
+          stream.downIndent();
+        }
+        stream.endElement(top.node->getName(), top.node->getPrefix());
+      }
+      open.pop_back();
+    }
+
+    if (current == NULL) break;
+  }
+}
+
+
+/*
+ * Returns the number of levels of elements in node.
+ */
+unsigned int
+SedXMLTree::getDepth (const XMLNode& node)
+{
+  std::vector<std::pair<const XMLNode*, unsigned int> > pending;
+  pending.push_back(std::make_pair(&node, 1u));
+
+  unsigned int depth = 0;
+  while (!pending.empty())
+  {
+    const XMLNode*     current = pending.back().first;
+    const unsigned int level   = pending.back().second;
+    pending.pop_back();
+
+    if (!current->isElement()) continue;
+    if (level > depth) depth = level;
+
+    for (unsigned int i = 0; i < current->getNumChildren(); i++)
+    {
+      pending.push_back(std::make_pair(&current->getChild(i), level + 1));
+    }
+  }
+
+  return depth;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
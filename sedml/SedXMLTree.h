@@ -0,0 +1,100 @@
+/**
+ * @file    SedXMLTree.h
+ * @brief   Reads and writes XMLNode trees without recursion
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedXMLTree
+ * @ingroup Core
+ * @brief Reads and writes notes, annotations and other XML iteratively.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The elements of SED-ML itself nest only as deep as the schema allows, a
+ * handful of levels, and SedBase::read() recurses over them.  The XML in
+ * notes and annotations, however, may nest arbitrarily, and reading it
+ * with the XMLNode constructor, or writing it with the stream operator,
+ * takes one call per level.  read() and write() walk such trees with an
+ * explicit stack instead, and read() refuses trees nested more deeply
+ * than a limit, skipping them in the stream, so that hostile input costs
+ * an error in the log rather than the stack of the process.
+ *
+ * SedDocument::setMaxXMLDepth() sets the limit notes, annotations and
+ * the deferred raw XML of a document are read with.
+ */
+
+#ifndef SedXMLTree_h
+#define SedXMLTree_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLOutputStream.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedXMLTree
+{
+public:
+
+  /**
+   * The nesting depth documents allow by default.
+   */
+  static const unsigned int DEFAULT_MAX_DEPTH = 256;
+
+
+  /**
+   * Reads the element at the head of @p stream, with everything in it,
+   * into a new XMLNode.
+   *
+   * @param stream the stream, positioned at a start tag.
+   * @param maxDepth the number of levels of elements the tree may have,
+   * counting the element read as one, or 0 for no limit.
+   *
+   * @return the tree read, owned by the caller, or @c NULL if it nests
+   * more deeply than @p maxDepth, in which case it has been skipped in
+   * the stream.
+   */
+  static XMLNode* read (XMLInputStream& stream, unsigned int maxDepth);
+
+
+  /**
+   * Writes @p node, with everything in it, to @p stream, as the stream
+   * operator of XMLOutputStream does.
+   */
+  static void write (const XMLNode& node, XMLOutputStream& stream);
+
+
+  /**
+   * @return the number of levels of elements in @p node, counting
+   * @p node itself as one if it is an element.
+   */
+  static unsigned int getDepth (const XMLNode& node);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedXMLTree_h */
@@ -0,0 +1,619 @@
+/**
+ * @file    SedXPathCache.cpp
+ * @brief   Compiles the XPath targets of variables and changes once
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedXPathCache.h>
+#include <sedml/SedVariable.h>
+#include <sedml/SedChange.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <cstdio>
+#include <new>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsbml-internal */
+
+static const std::string EMPTY_STRING;
+
+
+static bool
+isSpace (char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+
+static void
+skipSpace (const std::string& s, size_t& pos)
+{
+  while (pos < s.size() && isSpace(s[pos])) ++pos;
+}
+
+
+/*
+ * Reads a name, stopping at the characters that end one in a location
+ * path; returns false if there is none.
+ */
+static bool
+readName (const std::string& s, size_t& pos, std::string& name)
+{
+  const size_t start = pos;
+  while (pos < s.size())
+  {
+    const char c = s[pos];
+    if (c == '/' || c == '[' || c == ']' || c == '=' || c == '@' ||
+        c == '\'' || c == '"' || c == '(' || c == ')' || isSpace(c))
+    {
+      break;
+    }
+    ++pos;
+  }
+
+  name = s.substr(start, pos - start);
+  return !name.empty();
+}
+
+
+/*
+ * Splits a qualified name into its prefix and local name.
+ */
+static void
+splitName (const std::string& qname, std::string& prefix, std::string& name)
+{
+  const size_t colon = qname.find(':');
+  if (colon == std::string::npos)
+  {
+    prefix.clear();
+    name = qname;
+  }
+  else
+  {
+    prefix = qname.substr(0, colon);
+    name   = qname.substr(colon + 1);
+  }
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedXPathCache.
+ */
+SedXPathCache::SedXPathCache ()
+  : mRoot (NULL)
+{
+}
+
+
+/*
+ * Destroys this SedXPathCache.
+ */
+SedXPathCache::~SedXPathCache ()
+{
+}
+
+
+/*
+ * Declares the namespace uri for prefix.
+ */
+int
+SedXPathCache::addNamespace (const std::string& prefix, const std::string& uri)
+{
+  if (prefix.empty()) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mNamespaces[prefix] = uri;
+
+  // steps resolved with the previous meaning of prefix are stale
+  setDocument(mRoot);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Compiles target.
+ */
+int
+SedXPathCache::compile (const std::string& target)
+{
+  std::map<std::string, int>::const_iterator found = mTargetIndex.find(target);
+  if (found != mTargetIndex.end()) return found->second;
+
+  // an absolute location path of child steps, optionally ending in an
+  // attribute step
+  size_t pos = 0;
+  skipSpace(target, pos);
+  if (pos >= target.size() || target[pos] != '/') return -1;
+
+  Target compiled;
+  compiled.step = -1;
+
+  while (pos < target.size() && target[pos] == '/')
+  {
+    ++pos;
+    if (pos < target.size() && target[pos] == '@')
+    {
+      std::string prefix;
+      ++pos;
+      if (!readName(target, pos, compiled.attribute)) return -1;
+      splitName(compiled.attribute, prefix, compiled.attribute);
+      break;
+    }
+
+    Step step;
+    step.parent = compiled.step;
+    if (!parseStep(target, pos, step)) return -1;
+    compiled.step = internStep(step);
+  }
+
+  skipSpace(target, pos);
+  if (pos != target.size() || compiled.step < 0) return -1;
+
+  const int n = (int)mTargets.size();
+  mTargets.push_back(compiled);
+  mTargetIndex[target] = n;
+  return n;
+}
+
+
+/*
+ * Compiles the target of variable.
+ */
+int
+SedXPathCache::compile (const SedVariable* variable)
+{
+  if (variable == NULL) return -1;
+  return compile(variable->getTarget());
+}
+
+
+/*
+ * Compiles the target of change.
+ */
+int
+SedXPathCache::compile (const SedChange* change)
+{
+  if (change == NULL) return -1;
+  return compile(change->getTarget());
+}
+
+
+/*
+ * Returns the number of distinct targets compiled.
+ */
+unsigned int
+SedXPathCache::getNumTargets () const
+{
+  return (unsigned int)mTargets.size();
+}
+
+
+/*
+ * Returns the number of distinct steps.
+ */
+unsigned int
+SedXPathCache::getNumSteps () const
+{
+  return (unsigned int)mSteps.size();
+}
+
+
+/*
+ * Returns the name of the attribute target n selects.
+ */
+const std::string&
+SedXPathCache::getAttributeName (int n) const
+{
+  if (n < 0 || n >= (int)mTargets.size()) return EMPTY_STRING;
+  return mTargets[n].attribute;
+}
+
+
+/*
+ * Sets the model targets are resolved in.
+ */
+void
+SedXPathCache::setDocument (const XMLNode* root)
+{
+  mRoot = root;
+  mResolved.clear();
+  mIsResolved.clear();
+  mChildIndex.clear();
+}
+
+
+/*
+ * Returns the element target n selects.
+ */
+const XMLNode*
+SedXPathCache::resolve (int n)
+{
+  if (n < 0 || n >= (int)mTargets.size()) return NULL;
+  return resolveStep(mTargets[n].step);
+}
+
+
+/*
+ * Compiles target and resolves it.
+ */
+const XMLNode*
+SedXPathCache::resolve (const std::string& target)
+{
+  return resolve(compile(target));
+}
+
+
+/*
+ * Returns the parent of the element target n selects.
+ */
+const XMLNode*
+SedXPathCache::resolveParent (int n)
+{
+  if (n < 0 || n >= (int)mTargets.size()) return NULL;
+
+  const int step = mTargets[n].step;
+  const XMLNode* node = resolveStep(step);
+  if (node == NULL) return NULL;
+
+  // the first step is resolved in the node set with setDocument(), so
+  // the root element has that node as its parent unless it is the node
+  const int parent = mSteps[step].parent;
+  if (parent >= 0) return resolveStep(parent);
+
+  return (node != mRoot) ? mRoot : NULL;
+}
+
+
+/*
+ * Returns the value of the attribute target n selects.
+ */
+std::string
+SedXPathCache::getAttributeValue (int n)
+{
+  const XMLNode* node = resolve(n);
+  if (node == NULL || mTargets[n].attribute.empty()) return "";
+  return node->getAttrValue(mTargets[n].attribute);
+}
+
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Parses the step at pos, after its '/': a name and its predicates.
+ */
+bool
+SedXPathCache::parseStep (const std::string& target, size_t& pos,
+                          Step& step) const
+{
+  std::string qname;
+  if (!readName(target, pos, qname)) return false;
+  splitName(qname, step.prefix, step.name);
+  if (step.name.empty() || step.name.find(':') != std::string::npos)
+  {
+    return false;
+  }
+
+  step.position = 0;
+
+  while (pos < target.size() && target[pos] == '[')
+  {
+    ++pos;
+    skipSpace(target, pos);
+    if (pos >= target.size()) return false;
+
+    if (target[pos] >= '0' && target[pos] <= '9')
+    {
+      // a position, counted from one among the matching children
+      unsigned int position = 0;
+      while (pos < target.size() && target[pos] >= '0' && target[pos] <= '9')
+      {
+        position = position * 10 + (unsigned int)(target[pos] - '0');
+        ++pos;
+      }
+      if (position == 0 || step.position != 0) return false;
+      step.position = position;
+    }
+    else
+    {
+      for (;;)
+      {
+        Predicate predicate;
+        std::string prefix;
+
+        if (target[pos] != '@') return false;
+        ++pos;
+        if (!readName(target, pos, predicate.attribute)) return false;
+        splitName(predicate.attribute, prefix, predicate.attribute);
+
+        skipSpace(target, pos);
+        if (pos >= target.size() || target[pos] != '=') return false;
+        ++pos;
+        skipSpace(target, pos);
+        if (pos >= target.size()) return false;
+
+        const char quote = target[pos];
+        if (quote != '\'' && quote != '"') return false;
+        const size_t end = target.find(quote, pos + 1);
+        if (end == std::string::npos) return false;
+        predicate.value = target.substr(pos + 1, end - pos - 1);
+        pos = end + 1;
+
+        step.predicates.push_back(predicate);
+
+        skipSpace(target, pos);
+        if (target.compare(pos, 3, "and") != 0) break;
+        pos += 3;
+        skipSpace(target, pos);
+        if (pos >= target.size()) return false;
+      }
+    }
+
+    skipSpace(target, pos);
+    if (pos >= target.size() || target[pos] != ']') return false;
+    ++pos;
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns the index of step, adding it if no equal step with the same
+ * parent exists.
+ */
+int
+SedXPathCache::internStep (const Step& step)
+{
+  char number[32];
+  sprintf(number, "%d\x1f%u\x1f", step.parent, step.position);
+
+  std::string key = number;
+  key += step.prefix;
+  key += '\x1f';
+  key += step.name;
+  for (size_t i = 0; i < step.predicates.size(); ++i)
+  {
+    key += '\x1f';
+    key += step.predicates[i].attribute;
+    key += '\x1f';
+    key += step.predicates[i].value;
+  }
+
+  std::map<std::string, int>::const_iterator found = mStepIndex.find(key);
+  if (found != mStepIndex.end()) return found->second;
+
+  const int n = (int)mSteps.size();
+  mSteps.push_back(step);
+  mStepIndex[key] = n;
+  return n;
+}
+
+
+/*
+ * Returns whether node matches the name of step and, if withPredicates,
+ * its predicates.
+ */
+bool
+SedXPathCache::matches (const XMLNode& node, const Step& step,
+                        bool withPredicates) const
+{
+  if (!node.isElement()) return false;
+  if (step.name != "*" && node.getName() != step.name) return false;
+
+  if (!step.prefix.empty())
+  {
+    std::map<std::string, std::string>::const_iterator uri =
+      mNamespaces.find(step.prefix);
+    if (uri != mNamespaces.end() && node.getURI() != uri->second)
+    {
+      return false;
+    }
+  }
+
+  if (withPredicates)
+  {
+    for (size_t i = 0; i < step.predicates.size(); ++i)
+    {
+      const Predicate& predicate = step.predicates[i];
+      if (!node.hasAttr(predicate.attribute) ||
+          node.getAttrValue(predicate.attribute) != predicate.value)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns the child of parent step n selects.
+ */
+const XMLNode*
+SedXPathCache::findChild (const XMLNode& parent, int n)
+{
+  const Step& step = mSteps[n];
+
+  if (step.predicates.size() == 1 && step.position == 0)
+  {
+    // the children selected by an attribute are indexed by its value the
+    // first time one of them is looked up; the steps of all targets
+    // differing only in that value share the index
+    char number[16];
+    sprintf(number, "%d\x1f", step.parent);
+
+    std::string key = number;
+    key += step.prefix;
+    key += '\x1f';
+    key += step.name;
+    key += '\x1f';
+    key += step.predicates[0].attribute;
+
+    std::map<std::string, std::map<std::string, const XMLNode*> >::iterator
+      index = mChildIndex.find(key);
+
+    if (index == mChildIndex.end())
+    {
+      index = mChildIndex.insert(std::make_pair(key,
+                std::map<std::string, const XMLNode*>())).first;
+
+      const std::string& attribute = step.predicates[0].attribute;
+      for (unsigned int i = 0; i < parent.getNumChildren(); ++i)
+      {
+        const XMLNode& child = parent.getChild(i);
+        if (matches(child, step, false) && child.hasAttr(attribute))
+        {
+          // the first child with a value is the one selected
+          index->second.insert(std::make_pair(child.getAttrValue(attribute),
+                                              &child));
+        }
+      }
+    }
+
+    std::map<std::string, const XMLNode*>::const_iterator child =
+      index->second.find(step.predicates[0].value);
+    return (child != index->second.end()) ? child->second : NULL;
+  }
+
+  unsigned int count = 0;
+  for (unsigned int i = 0; i < parent.getNumChildren(); ++i)
+  {
+    const XMLNode& child = parent.getChild(i);
+    if (!matches(child, step, true)) continue;
+
+    ++count;
+    if (step.position == 0 || count == step.position) return &child;
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Returns the element step n selects, resolving it once per document.
+ */
+const XMLNode*
+SedXPathCache::resolveStep (int n)
+{
+  if (mRoot == NULL || n < 0) return NULL;
+
+  if (mIsResolved.size() < mSteps.size())
+  {
+    mIsResolved.resize(mSteps.size(), false);
+    mResolved.resize(mSteps.size(), NULL);
+  }
+
+  if (mIsResolved[n]) return mResolved[n];
+
+  const Step& step = mSteps[n];
+  const XMLNode* result = NULL;
+
+  if (step.parent < 0)
+  {
+    // the first step selects the root element, which is either the node
+    // set or one of its children
+    if (matches(*mRoot, step, true) && step.position <= 1)
+    {
+      result = mRoot;
+    }
+    else
+    {
+      result = findChild(*mRoot, n);
+    }
+  }
+  else
+  {
+    const XMLNode* parent = resolveStep(step.parent);
+    if (parent != NULL) result = findChild(*parent, n);
+  }
+
+  mResolved[n]   = result;
+  mIsResolved[n] = true;
+  return result;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new, empty SedXPathCache and returns it.
+ */
+LIBSEDML_EXTERN
+SedXPathCache_t *
+SedXPathCache_create ()
+{
+  return new (nothrow) SedXPathCache();
+}
+
+
+/**
+ * Frees the given SedXPathCache.
+ */
+LIBSEDML_EXTERN
+void
+SedXPathCache_free (SedXPathCache_t *sxc)
+{
+  delete sxc;
+}
+
+
+/**
+ * Compiles target and returns its index, or -1.
+ */
+LIBSEDML_EXTERN
+int
+SedXPathCache_compile (SedXPathCache_t *sxc, const char *target)
+{
+  if (sxc == NULL || target == NULL) return -1;
+  return sxc->compile(std::string(target));
+}
+
+
+/**
+ * Sets the model targets are resolved in.
+ */
+LIBSEDML_EXTERN
+void
+SedXPathCache_setDocument (SedXPathCache_t *sxc, const XMLNode_t *root)
+{
+  if (sxc != NULL) sxc->setDocument(root);
+}
+
+
+/**
+ * Returns the element compiled target n selects, or NULL.
+ */
+LIBSEDML_EXTERN
+const XMLNode_t *
+SedXPathCache_resolve (SedXPathCache_t *sxc, int n)
+{
+  return (sxc != NULL) ? sxc->resolve(n) : NULL;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,316 @@
+/**
+ * @file    SedXPathCache.h
+ * @brief   Compiles the XPath targets of variables and changes once
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SedXPathCache
+ * @ingroup Core
+ * @brief Resolves the targets of SedVariable and SedChange objects in a
+ * model.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * The target of a SedVariable or a SedChange is an XPath expression
+ * selecting an element, or an attribute of an element, of the model, for
+ * instance
+ * <code>/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']</code>.
+ * compile() parses a target once into a list of steps.  Steps are
+ * interned: all targets beginning with the same steps share them, so the
+ * thousands of variables of an experiment that differ only in their last
+ * step share one compiled prefix.
+ *
+ * resolve() finds the element a compiled target selects in the model set
+ * with setDocument(), an XMLNode tree.  Every step is resolved at most
+ * once per document and remembered, and the children of an element
+ * selected by an attribute, such as the species of a listOfSpecies by
+ * their id, are indexed by that attribute the first time one of them is
+ * looked up.  Resolving a target whose prefix has been resolved before
+ * therefore costs one lookup, not a walk over the model.
+ *
+ * Supported are absolute location paths of child steps, each a name,
+ * optionally with a namespace prefix, or <code>*</code>, followed by any
+ * number of predicates <code>[@attr='value']</code> (also joined with
+ * @em and) or <code>[n]</code>, and optionally ending in an attribute step
+ * <code>/@attr</code>.  Other XPath expressions fail to compile.  A prefix
+ * is matched against the namespace URI of an element if it has been
+ * declared with addNamespace(), and ignored otherwise.
+ *
+ * Compiling and resolving change the cache, so one cache must not be
+ * used by several threads at the same time.
+ */
+
+#ifndef SedXPathCache_h
+#define SedXPathCache_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedVariable;
+class SedChange;
+
+
+class LIBSEDML_EXTERN SedXPathCache
+{
+public:
+
+  /**
+   * Creates a new, empty SedXPathCache.
+   */
+  SedXPathCache ();
+
+
+  /**
+   * Destroys this SedXPathCache.
+   */
+  virtual ~SedXPathCache ();
+
+
+  /**
+   * Declares the namespace @p uri for the @p prefix used in targets.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p prefix is empty
+   */
+  int addNamespace (const std::string& prefix, const std::string& uri);
+
+
+  /**
+   * Compiles @p target, or finds it compiled before.
+   *
+   * @return the index of the compiled target, or -1 if @p target is not
+   * a supported XPath expression.
+   */
+  int compile (const std::string& target);
+
+
+  /**
+   * Compiles the target of @p variable.
+   *
+   * @return the index of the compiled target, or -1.
+   */
+  int compile (const SedVariable* variable);
+
+
+  /**
+   * Compiles the target of @p change.
+   *
+   * @return the index of the compiled target, or -1.
+   */
+  int compile (const SedChange* change);
+
+
+  /**
+   * @return the number of distinct targets compiled.
+   */
+  unsigned int getNumTargets () const;
+
+
+  /**
+   * @return the number of distinct steps the targets compiled consist
+   * of; steps shared by several targets are counted once.
+   */
+  unsigned int getNumSteps () const;
+
+
+  /**
+   * @return the name of the attribute compiled target @p n selects, or an
+   * empty string if it selects an element.
+   */
+  const std::string& getAttributeName (int n) const;
+
+
+  /**
+   * Sets the model targets are resolved in, forgetting everything
+   * resolved in the previous one; @p root, which this cache does not own,
+   * is the top-level element, or a node containing it.  @p root must not
+   * be changed while it is set.
+   */
+  void setDocument (const XMLNode* root);
+
+
+  /**
+   * @return the element compiled target @p n selects in the document, or,
+   * for a target ending in an attribute step, the element that attribute
+   * belongs to; @c NULL if there is none.
+   */
+  const XMLNode* resolve (int n);
+
+
+  /**
+   * Compiles @p target and resolves it.
+   *
+   * @return the element selected, or @c NULL.
+   */
+  const XMLNode* resolve (const std::string& target);
+
+
+  /**
+   * @return the parent of the element compiled target @p n selects, or
+   * @c NULL if that element is the root or there is none.
+   */
+  const XMLNode* resolveParent (int n);
+
+
+  /**
+   * @return the value of the attribute compiled target @p n selects, or an
+   * empty string if the target does not select an attribute or it does not
+   * exist.
+   */
+  std::string getAttributeValue (int n);
+
+
+protected:
+  /** @cond doxygen-libsbml-internal */
+
+  struct Predicate
+  {
+    std::string attribute;
+    std::string value;
+  };
+
+  /*
+   * A step; steps are interned, so that the parent of each is the step
+   * before it, shared by all targets beginning with the same steps.
+   */
+  struct Step
+  {
+    int                     parent;
+    std::string             prefix;
+    std::string             name;
+    std::vector<Predicate>  predicates;
+    unsigned int            position;
+  };
+
+  struct Target
+  {
+    int          step;
+    std::string  attribute;
+  };
+
+  bool parseStep (const std::string& target, size_t& pos, Step& step) const;
+
+  int internStep (const Step& step);
+
+  bool matches (const XMLNode& node, const Step& step,
+                bool withPredicates) const;
+
+  const XMLNode* findChild (const XMLNode& parent, int n);
+
+  const XMLNode* resolveStep (int n);
+
+
+  std::map<std::string, std::string>  mNamespaces;
+
+  std::vector<Step>                   mSteps;
+  std::map<std::string, int>          mStepIndex;
+  std::vector<Target>                 mTargets;
+  std::map<std::string, int>          mTargetIndex;
+
+  const XMLNode*                      mRoot;
+  std::vector<const XMLNode*>         mResolved;
+  std::vector<bool>                   mIsResolved;
+  std::map<std::string,
+           std::map<std::string, const XMLNode*> >  mChildIndex;
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygen-libsbml-internal */
+
+  SedXPathCache (const SedXPathCache& orig);
+  SedXPathCache& operator= (const SedXPathCache& rhs);
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new, empty SedXPathCache and returns it.
+ */
+LIBSEDML_EXTERN
+SedXPathCache_t *
+SedXPathCache_create ();
+
+
+/**
+ * Frees the given SedXPathCache.
+ */
+LIBSEDML_EXTERN
+void
+SedXPathCache_free (SedXPathCache_t *sxc);
+
+
+/**
+ * Compiles @p target and returns its index, or -1.
+ */
+LIBSEDML_EXTERN
+int
+SedXPathCache_compile (SedXPathCache_t *sxc, const char *target);
+
+
+/**
+ * Sets the model targets are resolved in.
+ */
+LIBSEDML_EXTERN
+void
+SedXPathCache_setDocument (SedXPathCache_t *sxc, const XMLNode_t *root);
+
+
+/**
+ * Returns the element compiled target @p n selects, or @c NULL.
+ */
+LIBSEDML_EXTERN
+const XMLNode_t *
+SedXPathCache_resolve (SedXPathCache_t *sxc, int n);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* SedXPathCache_h */
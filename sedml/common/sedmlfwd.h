@@ -68,6 +68,246 @@ typedef CLASS_OR_STRUCT SedBase                     SedBase_t;
  */
 typedef CLASS_OR_STRUCT SedReader                     SedReader_t;
 
+/**
+ * @var typedef class SedEventReader SedEventReader_t
+ * @copydoc SedEventReader
+ */
+typedef CLASS_OR_STRUCT SedEventReader                     SedEventReader_t;
+
+/**
+ * @var typedef class SedArchive SedArchive_t
+ * @copydoc SedArchive
+ */
+typedef CLASS_OR_STRUCT SedArchive                         SedArchive_t;
+
+/**
+ * @var typedef class SedBatchReader SedBatchReader_t
+ * @copydoc SedBatchReader
+ */
+typedef CLASS_OR_STRUCT SedBatchReader                     SedBatchReader_t;
+
+/**
+ * @var typedef class SedCompiledMath SedCompiledMath_t
+ * @copydoc SedCompiledMath
+ */
+typedef CLASS_OR_STRUCT SedCompiledMath                     SedCompiledMath_t;
+
+/**
+ * @var typedef class SedCompiledMathSet SedCompiledMathSet_t
+ * @copydoc SedCompiledMathSet
+ */
+typedef CLASS_OR_STRUCT SedCompiledMathSet                  SedCompiledMathSet_t;
+
+/**
+ * @var typedef class SedResults SedResults_t
+ * @copydoc SedResults
+ */
+typedef CLASS_OR_STRUCT SedResults                     SedResults_t;
+
+/**
+ * @var typedef class SedReportWriter SedReportWriter_t
+ * @copydoc SedReportWriter
+ */
+typedef CLASS_OR_STRUCT SedReportWriter                     SedReportWriter_t;
+
+/**
+ * @var typedef class SedExecutor SedExecutor_t
+ * @copydoc SedExecutor
+ */
+typedef CLASS_OR_STRUCT SedExecutor                     SedExecutor_t;
+
+/**
+ * @var typedef class SedSweep SedSweep_t
+ * @copydoc SedSweep
+ */
+typedef CLASS_OR_STRUCT SedSweep                        SedSweep_t;
+
+/**
+ * @var typedef class SedResultCache SedResultCache_t
+ * @copydoc SedResultCache
+ */
+typedef CLASS_OR_STRUCT SedResultCache                  SedResultCache_t;
+
+/**
+ * @var typedef class SedCheckpoint SedCheckpoint_t
+ * @copydoc SedCheckpoint
+ */
+typedef CLASS_OR_STRUCT SedCheckpoint                   SedCheckpoint_t;
+
+/**
+ * @var typedef class SedProfiler SedProfiler_t
+ * @copydoc SedProfiler
+ */
+typedef CLASS_OR_STRUCT SedProfiler                     SedProfiler_t;
+
+/**
+ * @var typedef class SedMemoryUsage SedMemoryUsage_t
+ * @copydoc SedMemoryUsage
+ */
+typedef CLASS_OR_STRUCT SedMemoryUsage                  SedMemoryUsage_t;
+
+/**
+ * @var typedef class SedModelCache SedModelCache_t
+ * @copydoc SedModelCache
+ */
+typedef CLASS_OR_STRUCT SedModelCache                   SedModelCache_t;
+
+/**
+ * @var typedef class SedSourceResolver SedSourceResolver_t
+ * @copydoc SedSourceResolver
+ */
+typedef CLASS_OR_STRUCT SedSourceResolver               SedSourceResolver_t;
+
+/**
+ * @var typedef class SedRemoteSimulator SedRemoteSimulator_t
+ * @copydoc SedRemoteSimulator
+ */
+typedef CLASS_OR_STRUCT SedRemoteSimulator              SedRemoteSimulator_t;
+
+/**
+ * @var typedef class SedRemoteWorker SedRemoteWorker_t
+ * @copydoc SedRemoteWorker
+ */
+typedef CLASS_OR_STRUCT SedRemoteWorker                 SedRemoteWorker_t;
+
+/**
+ * @var typedef class SedSimulatorAdapter SedSimulatorAdapter_t
+ * @copydoc SedSimulatorAdapter
+ */
+typedef CLASS_OR_STRUCT SedSimulatorAdapter             SedSimulatorAdapter_t;
+
+/**
+ * @var typedef class SedChunkWriter SedChunkWriter_t
+ * @copydoc SedChunkWriter
+ */
+typedef CLASS_OR_STRUCT SedChunkWriter                  SedChunkWriter_t;
+
+/**
+ * @var typedef class SedPipeline SedPipeline_t
+ * @copydoc SedPipeline
+ */
+typedef CLASS_OR_STRUCT SedPipeline                     SedPipeline_t;
+
+/**
+ * @var typedef class SedCostModel SedCostModel_t
+ * @copydoc SedCostModel
+ */
+typedef CLASS_OR_STRUCT SedCostModel                    SedCostModel_t;
+
+/**
+ * @var typedef class SedRandomStream SedRandomStream_t
+ * @copydoc SedRandomStream
+ */
+typedef CLASS_OR_STRUCT SedRandomStream                 SedRandomStream_t;
+
+/**
+ * @var typedef class SedResultsComparison SedResultsComparison_t
+ * @copydoc SedResultsComparison
+ */
+typedef CLASS_OR_STRUCT SedResultsComparison            SedResultsComparison_t;
+
+/**
+ * @var typedef class SedPlotDecimator SedPlotDecimator_t
+ * @copydoc SedPlotDecimator
+ */
+typedef CLASS_OR_STRUCT SedPlotDecimator                SedPlotDecimator_t;
+
+/**
+ * @var typedef class SedSurfaceGrid SedSurfaceGrid_t
+ * @copydoc SedSurfaceGrid
+ */
+typedef CLASS_OR_STRUCT SedSurfaceGrid                  SedSurfaceGrid_t;
+
+/**
+ * @var typedef class SedSelector SedSelector_t
+ * @copydoc SedSelector
+ */
+typedef CLASS_OR_STRUCT SedSelector                     SedSelector_t;
+
+/**
+ * @var typedef class SedIncrementalValidator SedIncrementalValidator_t
+ * @copydoc SedIncrementalValidator
+ */
+typedef CLASS_OR_STRUCT SedIncrementalValidator         SedIncrementalValidator_t;
+
+/**
+ * @var typedef class SedParallelValidator SedParallelValidator_t
+ * @copydoc SedParallelValidator
+ */
+typedef CLASS_OR_STRUCT SedParallelValidator            SedParallelValidator_t;
+
+/**
+ * @var typedef class SedTargetValidator SedTargetValidator_t
+ * @copydoc SedTargetValidator
+ */
+typedef CLASS_OR_STRUCT SedTargetValidator              SedTargetValidator_t;
+
+/**
+ * @var typedef class SedDocumentTemplate SedDocumentTemplate_t
+ * @copydoc SedDocumentTemplate
+ */
+typedef CLASS_OR_STRUCT SedDocumentTemplate             SedDocumentTemplate_t;
+
+/**
+ * @var typedef class SedBatchWriter SedBatchWriter_t
+ * @copydoc SedBatchWriter
+ */
+typedef CLASS_OR_STRUCT SedBatchWriter                  SedBatchWriter_t;
+
+/**
+ * @var typedef class SedDocumentMerger SedDocumentMerger_t
+ * @copydoc SedDocumentMerger
+ */
+typedef CLASS_OR_STRUCT SedDocumentMerger               SedDocumentMerger_t;
+
+/**
+ * @var typedef class SedAnnotationIndex SedAnnotationIndex_t
+ * @copydoc SedAnnotationIndex
+ */
+typedef CLASS_OR_STRUCT SedAnnotationIndex              SedAnnotationIndex_t;
+
+/**
+ * @var typedef class SedXPathCache SedXPathCache_t
+ * @copydoc SedXPathCache
+ */
+typedef CLASS_OR_STRUCT SedXPathCache                   SedXPathCache_t;
+
+/**
+ * @var typedef class SedChangeApplier SedChangeApplier_t
+ * @copydoc SedChangeApplier
+ */
+typedef CLASS_OR_STRUCT SedChangeApplier                SedChangeApplier_t;
+
+/**
+ * @var typedef class SedMathCache SedMathCache_t
+ * @copydoc SedMathCache
+ */
+typedef CLASS_OR_STRUCT SedMathCache                    SedMathCache_t;
+
+/**
+ * @var typedef class SedTimeGrid SedTimeGrid_t
+ * @copydoc SedTimeGrid
+ */
+typedef CLASS_OR_STRUCT SedTimeGrid                     SedTimeGrid_t;
+
+/**
+ * @var typedef class SedDocumentPatch SedDocumentPatch_t
+ * @copydoc SedDocumentPatch
+ */
+typedef CLASS_OR_STRUCT SedDocumentPatch                SedDocumentPatch_t;
+
+/**
+ * @var typedef class SedBinaryCodec SedBinaryCodec_t
+ * @copydoc SedBinaryCodec
+ */
+typedef CLASS_OR_STRUCT SedBinaryCodec                  SedBinaryCodec_t;
+
+/**
+ * @var typedef class SedDocumentView SedDocumentView_t
+ * @copydoc SedDocumentView
+ */
+typedef CLASS_OR_STRUCT SedDocumentView                 SedDocumentView_t;
+
 /**
  * @var typedef class SedWriter SedWriter_t
  * @copydoc SedWriter
@@ -0,0 +1,170 @@
+/**
+ * @file    threads.h
+ * @brief   Minimal threads, mutexes and condition variables for libSEDML
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * Used only by the implementation files of libSEDML that run work on
+ * several threads; it is not part of the public API.  Windows threads are
+ * used on Windows and POSIX threads everywhere else.
+ */
+
+#ifndef libsedml_threads_h
+#define libsedml_threads_h
+
+/** @cond doxygen-libsbml-internal */
+
+#include <sedml/common/extern.h>
+
+#include <new>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#endif
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+#ifdef _WIN32
+typedef HANDLE             SedThread;
+typedef CRITICAL_SECTION   SedMutex;
+typedef CONDITION_VARIABLE SedCondition;
+
+inline void mutexInit   (SedMutex* m) { InitializeCriticalSection(m); }
+inline void mutexLock   (SedMutex* m) { EnterCriticalSection(m);      }
+inline void mutexUnlock (SedMutex* m) { LeaveCriticalSection(m);      }
+inline void mutexFree   (SedMutex* m) { DeleteCriticalSection(m);     }
+
+inline void conditionInit      (SedCondition* c) { InitializeConditionVariable(c); }
+inline void conditionWait      (SedCondition* c, SedMutex* m)
+                               { SleepConditionVariableCS(c, m, INFINITE); }
+inline void conditionBroadcast (SedCondition* c) { WakeAllConditionVariable(c); }
+inline void conditionFree      (SedCondition*)   { }
+#else
+typedef pthread_t          SedThread;
+typedef pthread_mutex_t    SedMutex;
+typedef pthread_cond_t     SedCondition;
+
+inline void mutexInit   (SedMutex* m) { pthread_mutex_init(m, NULL); }
+inline void mutexLock   (SedMutex* m) { pthread_mutex_lock(m);       }
+inline void mutexUnlock (SedMutex* m) { pthread_mutex_unlock(m);     }
+inline void mutexFree   (SedMutex* m) { pthread_mutex_destroy(m);    }
+
+inline void conditionInit      (SedCondition* c) { pthread_cond_init(c, NULL); }
+inline void conditionWait      (SedCondition* c, SedMutex* m)
+                               { pthread_cond_wait(c, m); }
+inline void conditionBroadcast (SedCondition* c) { pthread_cond_broadcast(c); }
+inline void conditionFree      (SedCondition* c) { pthread_cond_destroy(c); }
+#endif
+
+
+/*
+ * @return the number of processors available, at least 1.
+ */
+inline unsigned int
+getNumProcessors ()
+{
+#ifdef _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  long n = (long)info.dwNumberOfProcessors;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  return (n > 0) ? (unsigned int)n : 1;
+}
+
+
+/*
+ * The function a thread started by startThread() runs.
+ */
+typedef void (*SedThreadFunc) (void* arg);
+
+struct SedThreadStart
+{
+  SedThreadFunc func;
+  void*         arg;
+};
+
+
+#ifdef _WIN32
+inline DWORD WINAPI
+sedThreadMain (LPVOID arg)
+{
+  SedThreadStart start = *static_cast<SedThreadStart*>(arg);
+  delete static_cast<SedThreadStart*>(arg);
+  start.func(start.arg);
+  return 0;
+}
+#else
+inline void*
+sedThreadMain (void* arg)
+{
+  SedThreadStart start = *static_cast<SedThreadStart*>(arg);
+  delete static_cast<SedThreadStart*>(arg);
+  start.func(start.arg);
+  return NULL;
+}
+#endif
+
+
+/*
+ * Starts a thread running func(arg).
+ *
+ * @return false if the thread could not be started.
+ */
+inline bool
+startThread (SedThread* thread, SedThreadFunc func, void* arg)
+{
+  SedThreadStart* start = new (std::nothrow) SedThreadStart;
+  if (start == NULL) return false;
+
+  start->func = func;
+  start->arg  = arg;
+
+#ifdef _WIN32
+  *thread = CreateThread(NULL, 0, sedThreadMain, start, 0, NULL);
+  if (*thread != NULL) return true;
+#else
+  if (pthread_create(thread, NULL, sedThreadMain, start) == 0) return true;
+#endif
+
+  delete start;
+  return false;
+}
+
+
+/*
+ * Waits for the given thread to end.
+ */
+inline void
+joinThread (SedThread thread)
+{
+#ifdef _WIN32
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#else
+  pthread_join(thread, NULL);
+#endif
+}
+
+LIBSEDML_CPP_NAMESPACE_END
+
+/** @endcond */
+
+#endif  /* libsedml_threads_h */
@@ -0,0 +1,191 @@
+/**
+ * @file    TestFrozenDocument.cpp
+ * @brief   Reads a frozen SedDocument from several threads at once
+ *
+ * Built with WITH_THREAD_SANITIZER, ThreadSanitizer reports any write a
+ * lookup or a SedWriter makes to the shared document.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedTypes.h>
+#include <sedml/common/threads.h>
+
+#include <cstdlib>
+#include <string>
+
+#include <check.h>
+
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+static const unsigned int sNumTasks   = 8;
+static const unsigned int sNumThreads = 8;
+static const unsigned int sNumRounds  = 20;
+
+
+/*
+ * Returns id followed by n.
+ */
+static std::string
+numbered (const std::string& id, unsigned int n)
+{
+  return id + SedNumber::toString(n);
+}
+
+
+/*
+ * Creates a document whose tasks each have two data generators referring
+ * to them.
+ */
+static SedDocument*
+createDocument ()
+{
+  SedDocument* doc = new SedDocument(1, 1);
+
+  SedModel* model = doc->createModel();
+  model->setId("model1");
+  model->setSource("file.xml");
+  model->setLanguage("urn:sedml:sbml");
+
+  SedUniformTimeCourse* tc = doc->createUniformTimeCourse();
+  tc->setId("sim1");
+  tc->setInitialTime(0.0);
+  tc->setOutputStartTime(0.0);
+  tc->setOutputEndTime(10.0);
+  tc->setNumberOfPoints(100);
+  tc->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int i = 0; i < sNumTasks; ++i)
+  {
+    SedTask* task = doc->createTask();
+    task->setId(numbered("task", i));
+    task->setModelReference("model1");
+    task->setSimulationReference("sim1");
+
+    for (unsigned int j = 0; j < 2; ++j)
+    {
+      SedDataGenerator* dg = doc->createDataGenerator();
+      dg->setId(numbered("dg", 2 * i + j));
+
+      SedVariable* var = dg->createVariable();
+      var->setId(numbered("v", 2 * i + j));
+      var->setTaskReference(task->getId());
+      var->setSymbol("urn:sedml:symbol:time");
+    }
+  }
+
+  return doc;
+}
+
+
+/*
+ * What each thread reads, and the number of reads that differed from
+ * what was read before the threads started.
+ */
+struct ReaderState
+{
+  SedDocument*       doc;
+  const std::string* expected;
+  unsigned int       numWrong;
+};
+
+
+static void
+readDocument (void* arg)
+{
+  ReaderState* state = static_cast<ReaderState*>(arg);
+  SedDocument* doc   = state->doc;
+  SedWriter    writer;
+
+  for (unsigned int round = 0; round < sNumRounds; ++round)
+  {
+    for (unsigned int i = 0; i < sNumTasks; ++i)
+    {
+      const std::string id = numbered("task", i);
+
+      SedBase* task = doc->getElementBySId(id);
+      if (task == NULL || task->getTypeCode() != SEDML_TASK)
+        state->numWrong++;
+
+      if (doc->getNumReferrers(id) != 2)
+        state->numWrong++;
+
+      SedBase* referrer = doc->getReferrer(id, 1);
+      if (referrer == NULL || referrer->getId() != numbered("v", 2 * i + 1))
+        state->numWrong++;
+    }
+
+    char* written = writer.writeSedMLToString(doc);
+    if (written == NULL || *state->expected != written)
+      state->numWrong++;
+    free(written);
+  }
+}
+
+
+START_TEST (test_FrozenDocument_concurrentReads)
+{
+  SedDocument* doc = createDocument();
+  fail_unless(doc->freeze() == LIBSEDML_OPERATION_SUCCESS);
+
+  SedWriter writer;
+  char* written = writer.writeSedMLToString(doc);
+  fail_unless(written != NULL);
+  const std::string expected(written);
+  free(written);
+
+  ReaderState states[sNumThreads];
+  SedThread   threads[sNumThreads];
+  unsigned int numStarted = 0;
+
+  for (unsigned int i = 0; i < sNumThreads; ++i)
+  {
+    states[i].doc      = doc;
+    states[i].expected = &expected;
+    states[i].numWrong = 0;
+
+    if (startThread(&threads[i], readDocument, &states[i])) numStarted++;
+    else break;
+  }
+
+  for (unsigned int i = 0; i < numStarted; ++i)
+  {
+    joinThread(threads[i]);
+  }
+
+  fail_unless(numStarted == sNumThreads);
+  for (unsigned int i = 0; i < numStarted; ++i)
+  {
+    fail_unless(states[i].numWrong == 0);
+  }
+
+  delete doc;
+}
+END_TEST
+
+
+Suite *
+create_suite_FrozenDocument (void)
+{
+  Suite *suite = suite_create("FrozenDocument");
+  TCase *tcase = tcase_create("FrozenDocument");
+
+  tcase_add_test(tcase, test_FrozenDocument_concurrentReads);
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
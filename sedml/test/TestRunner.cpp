@@ -0,0 +1,39 @@
+/**
+ * @file    TestRunner.cpp
+ * @brief   Runs the libSEDML unit tests
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <check.h>
+
+
+Suite *create_suite_SedNumber (void);
+Suite *create_suite_FrozenDocument (void);
+
+
+int
+main (void)
+{
+  SRunner *runner = srunner_create(create_suite_SedNumber());
+  srunner_add_suite(runner, create_suite_FrozenDocument());
+
+  srunner_run_all(runner, CK_NORMAL);
+  const int num_failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return (num_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file    TestSedNumber.cpp
+ * @brief   Round-trip tests of the SedNumber conversions
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML, and the latest version of libSEDML.
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EBML-EBI), Hinxton, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sedml/SedNumber.h>
+
+#include <cfloat>
+#include <cstring>
+
+#include <check.h>
+
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/*
+ * Whether value is written and read back bit for bit.
+ */
+static bool
+roundTrips (double value)
+{
+  double read = 0;
+  if (!SedNumber::parse(SedNumber::toString(value), read)) return false;
+
+  return memcmp(&read, &value, sizeof(double)) == 0;
+}
+
+
+START_TEST (test_SedNumber_roundTrip)
+{
+  fail_unless(roundTrips(0.1));
+  fail_unless(roundTrips(-1.5e-7));
+  fail_unless(roundTrips(1.0 / 3.0));
+  fail_unless(roundTrips(-0.0));
+}
+END_TEST
+
+
+START_TEST (test_SedNumber_roundTrip_subnormal)
+{
+  // the smallest subnormal, which strtod() reads with a range error
+  fail_unless(roundTrips(4.9406564584124654e-324));
+  fail_unless(roundTrips(-4.9406564584124654e-324));
+  fail_unless(roundTrips(1e-310));
+  fail_unless(roundTrips(DBL_MIN));
+
+  double value = 0;
+  fail_unless(SedNumber::parse("4.9406564584124654e-324", value));
+  fail_unless(value == 4.9406564584124654e-324);
+}
+END_TEST
+
+
+START_TEST (test_SedNumber_roundTrip_max)
+{
+  fail_unless(roundTrips(DBL_MAX));
+  fail_unless(roundTrips(-DBL_MAX));
+}
+END_TEST
+
+
+START_TEST (test_SedNumber_parse_outOfRange)
+{
+  double value = 42;
+
+  fail_unless(!SedNumber::parse("1.8e308", value));
+  fail_unless(!SedNumber::parse("-1e400", value));
+  fail_unless(!SedNumber::parse("1e-400", value));
+  fail_unless(!SedNumber::parse("2e-324", value));
+  fail_unless(value == 42);
+
+  // a zero mantissa is zero whatever its exponent
+  fail_unless(SedNumber::parse("0e-400", value));
+  fail_unless(value == 0);
+}
+END_TEST
+
+
+Suite *
+create_suite_SedNumber (void)
+{
+  Suite *suite = suite_create("SedNumber");
+  TCase *tcase = tcase_create("SedNumber");
+
+  tcase_add_test(tcase, test_SedNumber_roundTrip);
+  tcase_add_test(tcase, test_SedNumber_roundTrip_subnormal);
+  tcase_add_test(tcase, test_SedNumber_roundTrip_max);
+  tcase_add_test(tcase, test_SedNumber_parse_outOfRange);
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}